@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/indexed_asset_bundle.h"
+#include "flutter/assets/indexed_asset_bundle_writer.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+constexpr char kBundleFileName[] = "assets.bundle";
+
+// A directory of |asset_count| small assets spread over a few subdirectories
+// like the assets of an app, and the same assets packed into a bundle file.
+class AssetsFixture {
+ public:
+  explicit AssetsFixture(size_t asset_count) {
+    assets_dir_ = fml::CreateDirectory(temp_dir_.fd(), {"assets"},
+                                       fml::FilePermission::kReadWrite);
+    FML_CHECK(assets_dir_.is_valid());
+    std::vector<fml::UniqueFD> subdirs;
+    for (int i = 0; i < 8; i++) {
+      subdirs.push_back(fml::CreateDirectory(assets_dir_,
+                                             {"packages" + std::to_string(i)},
+                                             fml::FilePermission::kReadWrite));
+    }
+    const fml::DataMapping contents(std::string(512, 'x'));
+    for (size_t i = 0; i < asset_count; i++) {
+      const std::string name = "asset" + std::to_string(i) + ".png";
+      FML_CHECK(fml::WriteAtomically(subdirs[i % subdirs.size()], name.c_str(),
+                                     contents));
+      asset_names_.push_back("packages" + std::to_string(i % subdirs.size()) +
+                             "/" + name);
+    }
+
+    IndexedAssetBundleWriter writer;
+    FML_CHECK(writer.AddAssetsFromDirectory(assets_dir_));
+    auto bundle = writer.Finish();
+    FML_CHECK(bundle);
+    FML_CHECK(fml::WriteAtomically(temp_dir_.fd(), kBundleFileName, *bundle));
+  }
+
+  const fml::UniqueFD& GetAssetsDirectory() const { return assets_dir_; }
+
+  fml::UniqueFD OpenBundleFile() {
+    return fml::OpenFile(temp_dir_.fd(), kBundleFileName, false,
+                         fml::FilePermission::kRead);
+  }
+
+  const std::vector<std::string>& GetAssetNames() const {
+    return asset_names_;
+  }
+
+ private:
+  fml::ScopedTemporaryDirectory temp_dir_;
+  fml::UniqueFD assets_dir_;
+  std::vector<std::string> asset_names_;
+};
+
+void LookUpAllAssets(benchmark::State& state,
+                     const AssetManager& asset_manager,
+                     const std::vector<std::string>& asset_names) {
+  for (const auto& name : asset_names) {
+    auto mapping = asset_manager.GetAsMapping(name);
+    if (!mapping) {
+      state.SkipWithError("Asset not found.");
+      return;
+    }
+    benchmark::DoNotOptimize(mapping->GetMapping()[0]);
+  }
+}
+}  // namespace
+
+// Sets up an asset manager like the engine does at startup and reads every
+// asset once.
+static void BM_DirectoryAssetBundleStartup(benchmark::State& state) {
+  AssetsFixture fixture(state.range(0));
+  for (auto _ : state) {
+    AssetManager asset_manager;
+    asset_manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+        fml::Duplicate(fixture.GetAssetsDirectory().get()), false));
+    LookUpAllAssets(state, asset_manager, fixture.GetAssetNames());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_IndexedAssetBundleStartup(benchmark::State& state) {
+  AssetsFixture fixture(state.range(0));
+  for (auto _ : state) {
+    AssetManager asset_manager;
+    asset_manager.PushBack(std::make_unique<IndexedAssetBundle>(
+        fml::FileMapping::CreateReadOnly(fixture.OpenBundleFile()), false));
+    LookUpAllAssets(state, asset_manager, fixture.GetAssetNames());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_DirectoryAssetBundleStartup)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IndexedAssetBundleStartup)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
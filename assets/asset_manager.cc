@@ -4,21 +4,85 @@
 
 #include "flutter/assets/asset_manager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/trace_event.h"
 
+#if FML_OS_POSIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // FML_OS_POSIX
+
 namespace flutter {
 
-AssetManager::AssetManager() = default;
+namespace {
+size_t GetPageSize() {
+#if FML_OS_POSIX
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  return page_size;
+#else
+  return 4096u;
+#endif  // FML_OS_POSIX
+}
+
+// Pages in the contents of |mapping| on the calling thread.
+void PageIn(const fml::Mapping& mapping) {
+  const uint8_t* data = mapping.GetMapping();
+  const size_t size = mapping.GetSize();
+  if (data == nullptr || size == 0) {
+    return;
+  }
+  const size_t page_size = GetPageSize();
+#if FML_OS_POSIX
+  // Start the reads of all pages at once, where the mapping is file backed.
+  const uintptr_t start =
+      reinterpret_cast<uintptr_t>(data) / page_size * page_size;
+  const uintptr_t end = reinterpret_cast<uintptr_t>(data) + size;
+  ::madvise(reinterpret_cast<void*>(start), end - start, MADV_WILLNEED);
+#endif  // FML_OS_POSIX
+  volatile uint8_t sink = 0;
+  for (size_t offset = 0; offset < size; offset += page_size) {
+    sink = sink + data[offset];
+  }
+  sink = sink + data[size - 1];
+}
+}  // namespace
+
+struct AssetManager::PrefetchState {
+  std::mutex mutex;
+  std::condition_variable running_changed;
+  // Reset once the asset manager is destroyed.
+  AssetManager* asset_manager = nullptr;
+  size_t running_tasks = 0;
+};
+
+AssetManager::AssetManager()
+    : resolvers_mutex_(fml::SharedMutex::Create()),
+      prefetch_state_(std::make_shared<PrefetchState>()) {
+  prefetch_state_->asset_manager = this;
+}
 
-AssetManager::~AssetManager() = default;
+AssetManager::~AssetManager() {
+  // Prefetch tasks that are still queued skip their reads, and the ones that
+  // are running use the resolvers until they are done.
+  std::unique_lock lock(prefetch_state_->mutex);
+  prefetch_state_->asset_manager = nullptr;
+  prefetch_state_->running_changed.wait(
+      lock, [this]() { return prefetch_state_->running_tasks == 0; });
+}
 
 bool AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
   if (resolver == nullptr || !resolver->IsValid()) {
     return false;
   }
 
+  fml::UniqueLock lock(*resolvers_mutex_);
   resolvers_.push_front(std::move(resolver));
+  OnResolversChanged();
   return true;
 }
 
@@ -27,7 +91,9 @@ bool AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
     return false;
   }
 
+  fml::UniqueLock lock(*resolvers_mutex_);
   resolvers_.push_back(std::move(resolver));
+  OnResolversChanged();
   return true;
 }
 
@@ -37,6 +103,7 @@ void AssetManager::UpdateResolverByType(
   if (updated_asset_resolver == nullptr) {
     return;
   }
+  fml::UniqueLock lock(*resolvers_mutex_);
   bool updated = false;
   std::deque<std::unique_ptr<AssetResolver>> new_resolvers;
   for (auto& old_resolver : resolvers_) {
@@ -53,12 +120,115 @@ void AssetManager::UpdateResolverByType(
     new_resolvers.push_back(std::move(updated_asset_resolver));
   }
   resolvers_.swap(new_resolvers);
+  OnResolversChanged();
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  fml::UniqueLock lock(*resolvers_mutex_);
+  OnResolversChanged();
   return std::move(resolvers_);
 }
 
+void AssetManager::OnResolversChanged() {
+  std::scoped_lock lock(prefetched_mutex_);
+  resolvers_generation_++;
+  prefetched_.clear();
+  prefetched_bytes_ = 0;
+}
+
+void AssetManager::Prefetch(
+    const std::vector<std::string>& asset_names,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+    const fml::closure& on_done) {
+  FML_DCHECK(task_runner);
+  TRACE_EVENT0("flutter", "AssetManager::Prefetch");
+  uint64_t generation;
+  {
+    std::scoped_lock lock(prefetched_mutex_);
+    generation = resolvers_generation_;
+  }
+
+  const size_t task_count =
+      (asset_names.size() + kAssetsPerPrefetchTask - 1) /
+      kAssetsPerPrefetchTask;
+  if (task_count == 0) {
+    if (on_done) {
+      on_done();
+    }
+    return;
+  }
+
+  auto remaining_tasks = std::make_shared<std::atomic<size_t>>(task_count);
+  for (size_t first = 0; first < asset_names.size();
+       first += kAssetsPerPrefetchTask) {
+    const size_t last =
+        std::min(first + kAssetsPerPrefetchTask, asset_names.size());
+    std::vector<std::string> batch(asset_names.begin() + first,
+                                   asset_names.begin() + last);
+    task_runner->PostTask([state = prefetch_state_, batch = std::move(batch),
+                           generation, remaining_tasks, on_done]() {
+      AssetManager* asset_manager = nullptr;
+      {
+        std::scoped_lock lock(state->mutex);
+        asset_manager = state->asset_manager;
+        if (asset_manager) {
+          state->running_tasks++;
+        }
+      }
+      if (asset_manager) {
+        TRACE_EVENT0("flutter", "AssetManager::PrefetchBatch");
+        for (const auto& asset_name : batch) {
+          asset_manager->PrefetchAsset(asset_name, generation);
+        }
+        {
+          std::scoped_lock lock(state->mutex);
+          state->running_tasks--;
+        }
+        state->running_changed.notify_all();
+      }
+      if (remaining_tasks->fetch_sub(1) == 1 && on_done) {
+        on_done();
+      }
+    });
+  }
+}
+
+void AssetManager::PrefetchAsset(const std::string& asset_name,
+                                 uint64_t generation) {
+  {
+    std::scoped_lock lock(prefetched_mutex_);
+    if (generation != resolvers_generation_ ||
+        prefetched_.count(asset_name) > 0) {
+      return;
+    }
+  }
+
+  std::unique_ptr<fml::Mapping> mapping;
+  {
+    fml::SharedLock lock(*resolvers_mutex_);
+    mapping = FindAsset(asset_name);
+  }
+  if (!mapping) {
+    return;
+  }
+  PageIn(*mapping);
+
+  std::scoped_lock lock(prefetched_mutex_);
+  if (generation != resolvers_generation_ ||
+      prefetched_bytes_ + mapping->GetSize() > kMaxPrefetchedBytes) {
+    return;
+  }
+  const size_t size = mapping->GetSize();
+  if (prefetched_.emplace(asset_name, std::move(mapping)).second) {
+    prefetched_bytes_ += size;
+  }
+}
+
+size_t AssetManager::GetPrefetchedAssetCount() const {
+  std::scoped_lock lock(prefetched_mutex_);
+  return prefetched_.size();
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -67,13 +237,32 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  {
+    std::scoped_lock lock(prefetched_mutex_);
+    auto found = prefetched_.find(asset_name);
+    if (found != prefetched_.end()) {
+      std::unique_ptr<fml::Mapping> mapping = std::move(found->second);
+      prefetched_bytes_ -= mapping->GetSize();
+      prefetched_.erase(found);
+      return mapping;
+    }
+  }
+  fml::SharedLock lock(*resolvers_mutex_);
+  auto mapping = FindAsset(asset_name);
+  if (mapping == nullptr) {
+    FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
+  }
+  return mapping;
+}
+
+std::unique_ptr<fml::Mapping> AssetManager::FindAsset(
+    const std::string& asset_name) const {
   for (const auto& resolver : resolvers_) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
       return mapping;
     }
   }
-  FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
   return nullptr;
 }
 
@@ -87,6 +276,7 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMappings", "pattern",
                asset_pattern.c_str());
+  fml::SharedLock lock(*resolvers_mutex_);
   for (const auto& resolver : resolvers_) {
     auto resolver_mappings = resolver->GetAsMappings(asset_pattern, subdir);
     mappings.insert(mappings.end(),
@@ -98,6 +288,7 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
 
 // |AssetResolver|
 bool AssetManager::IsValid() const {
+  fml::SharedLock lock(*resolvers_mutex_);
   return !resolvers_.empty();
 }
 
@@ -7,12 +7,18 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/synchronization/shared_mutex.h"
+#include "flutter/fml/task_runner.h"
 
 namespace flutter {
 
@@ -70,6 +76,38 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  /// The number of bytes of prefetched assets that are kept until they are
+  /// read by |GetAsMapping|.
+  static constexpr size_t kMaxPrefetchedBytes = 16u * 1024u * 1024u;
+
+  /// The number of assets that are read by every task of |Prefetch|.
+  static constexpr size_t kAssetsPerPrefetchTask = 4u;
+
+  //--------------------------------------------------------------------------
+  /// @brief      Reads the given assets in parallel on `task_runner`, ahead
+  ///             of their first use. The pages of mapped assets are paged in
+  ///             on the workers so that reading them later doesn't block on
+  ///             storage.
+  ///
+  ///             Prefetched assets are kept until the next |GetAsMapping|
+  ///             call for them, up to |kMaxPrefetchedBytes| in total. They
+  ///             are dropped when the resolvers change.
+  ///
+  /// @param[in]  asset_names  The names of the assets to read.
+  /// @param[in]  task_runner  The task runner the assets are read on,
+  ///                          usually a concurrent task runner.
+  /// @param[in]  on_done      An optional callback invoked on one of the
+  ///                          workers once all assets have been read, or
+  ///                          their reads were skipped because the asset
+  ///                          manager was destroyed.
+  ///
+  void Prefetch(const std::vector<std::string>& asset_names,
+                const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+                const fml::closure& on_done = nullptr);
+
+  /// The number of prefetched assets that have not been read yet.
+  size_t GetPrefetchedAssetCount() const;
+
   // |AssetResolver|
   bool IsValid() const override;
 
@@ -89,8 +127,31 @@ class AssetManager final : public AssetResolver {
       const std::optional<std::string>& subdir) const override;
 
  private:
+  struct PrefetchState;
+
+  // Guards |resolvers_|, which prefetching reads from other threads.
+  std::unique_ptr<fml::SharedMutex> resolvers_mutex_;
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
+  // Guards the prefetched assets and |resolvers_generation_|.
+  mutable std::mutex prefetched_mutex_;
+  mutable std::unordered_map<std::string, std::unique_ptr<fml::Mapping>>
+      prefetched_;
+  mutable size_t prefetched_bytes_ = 0;
+  // Incremented whenever the resolvers change, so that the results of
+  // prefetches that were started before are dropped.
+  uint64_t resolvers_generation_ = 0;
+
+  std::shared_ptr<PrefetchState> prefetch_state_;
+
+  // Must be called with |resolvers_mutex_| held.
+  std::unique_ptr<fml::Mapping> FindAsset(const std::string& asset_name) const;
+
+  void PrefetchAsset(const std::string& asset_name, uint64_t generation);
+
+  // Must be called with |resolvers_mutex_| held exclusively.
+  void OnResolversChanged();
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
 
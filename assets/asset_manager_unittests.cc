@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_manager.h"
+
+#include <atomic>
+#include <deque>
+#include <map>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+// Serves fixed assets and counts how often they are looked up.
+class CountingAssetResolver : public AssetResolver {
+ public:
+  CountingAssetResolver(std::map<std::string, std::string> assets,
+                        std::shared_ptr<std::atomic<int>> lookups)
+      : assets_(std::move(assets)), lookups_(std::move(lookups)) {}
+
+  // |AssetResolver|
+  bool IsValid() const override { return true; }
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override { return true; }
+
+  // |AssetResolver|
+  AssetResolverType GetType() const override {
+    return AssetResolverType::kDirectoryAssetBundle;
+  }
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    (*lookups_)++;
+    auto found = assets_.find(asset_name);
+    if (found == assets_.end()) {
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(found->second);
+  }
+
+ private:
+  const std::map<std::string, std::string> assets_;
+  std::shared_ptr<std::atomic<int>> lookups_;
+};
+
+// Queues the posted tasks until the test runs them.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  size_t GetTaskCount() const { return tasks_.size(); }
+
+  void RunAllTasks() {
+    while (!tasks_.empty()) {
+      auto task = tasks_.front();
+      tasks_.pop_front();
+      task();
+    }
+  }
+
+ private:
+  std::deque<fml::closure> tasks_;
+};
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+}  // namespace
+
+TEST(AssetManagerTest, PrefetchedAssetsAreReadOnce) {
+  auto lookups = std::make_shared<std::atomic<int>>(0);
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "asset a"}, {"b", "asset b"}},
+      lookups)));
+
+  auto runner = std::make_shared<ManualTaskRunner>();
+  bool done = false;
+  asset_manager.Prefetch({"a", "b", "missing", "a", "c", "d"}, runner,
+                         [&done]() { done = true; });
+  // The assets are read in batches.
+  EXPECT_EQ(runner->GetTaskCount(), 2u);
+  EXPECT_EQ(*lookups, 0);
+  runner->RunAllTasks();
+  EXPECT_TRUE(done);
+  EXPECT_EQ(asset_manager.GetPrefetchedAssetCount(), 2u);
+  const int prefetch_lookups = *lookups;
+
+  auto a = asset_manager.GetAsMapping("a");
+  ASSERT_TRUE(a);
+  EXPECT_EQ(ToString(a), "asset a");
+  EXPECT_EQ(*lookups, prefetch_lookups);
+  EXPECT_EQ(asset_manager.GetPrefetchedAssetCount(), 1u);
+
+  // Prefetched assets are only served once.
+  a = asset_manager.GetAsMapping("a");
+  ASSERT_TRUE(a);
+  EXPECT_EQ(ToString(a), "asset a");
+  EXPECT_EQ(*lookups, prefetch_lookups + 1);
+}
+
+TEST(AssetManagerTest, ChangingResolversDropsPrefetchedAssets) {
+  auto lookups = std::make_shared<std::atomic<int>>(0);
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "old"}}, lookups)));
+
+  auto runner = std::make_shared<ManualTaskRunner>();
+  asset_manager.Prefetch({"a"}, runner);
+  runner->RunAllTasks();
+  EXPECT_EQ(asset_manager.GetPrefetchedAssetCount(), 1u);
+
+  // Prefetches that were started before the change are dropped as well.
+  asset_manager.Prefetch({"a"}, runner);
+  ASSERT_TRUE(asset_manager.PushFront(std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "new"}}, lookups)));
+  EXPECT_EQ(asset_manager.GetPrefetchedAssetCount(), 0u);
+  runner->RunAllTasks();
+  EXPECT_EQ(asset_manager.GetPrefetchedAssetCount(), 0u);
+
+  auto a = asset_manager.GetAsMapping("a");
+  ASSERT_TRUE(a);
+  EXPECT_EQ(ToString(a), "new");
+}
+
+TEST(AssetManagerTest, PrefetchesAreSkippedAfterTheAssetManagerIsDestroyed) {
+  auto lookups = std::make_shared<std::atomic<int>>(0);
+  auto asset_manager = std::make_unique<AssetManager>();
+  ASSERT_TRUE(asset_manager->PushBack(std::make_unique<CountingAssetResolver>(
+      std::map<std::string, std::string>{{"a", "asset a"}}, lookups)));
+
+  auto runner = std::make_shared<ManualTaskRunner>();
+  bool done = false;
+  asset_manager->Prefetch({"a"}, runner, [&done]() { done = true; });
+  asset_manager.reset();
+  runner->RunAllTasks();
+  EXPECT_TRUE(done);
+  EXPECT_EQ(*lookups, 0);
+}
+
+}  // namespace testing
+}  // namespace flutter
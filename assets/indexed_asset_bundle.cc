@@ -0,0 +1,206 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/indexed_asset_bundle.h"
+
+#include <cstring>
+#include <regex>
+#include <utility>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+uint64_t IndexedAssetBundle::HashAssetName(std::string_view name) {
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+IndexedAssetBundle::IndexedAssetBundle(
+    std::shared_ptr<const fml::Mapping> bundle,
+    bool is_valid_after_asset_manager_change)
+    : bundle_(std::move(bundle)) {
+  TRACE_EVENT0("flutter", "IndexedAssetBundle::IndexedAssetBundle");
+  if (!ValidateBundle()) {
+    entries_ = nullptr;
+    entry_count_ = 0;
+    names_ = nullptr;
+    return;
+  }
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+}
+
+IndexedAssetBundle::~IndexedAssetBundle() = default;
+
+bool IndexedAssetBundle::ValidateBundle() {
+  if (!bundle_ || bundle_->GetMapping() == nullptr ||
+      bundle_->GetSize() < sizeof(Header)) {
+    FML_LOG(ERROR) << "Asset bundle is too small.";
+    return false;
+  }
+  const uint8_t* data = bundle_->GetMapping();
+  const uint64_t size = bundle_->GetSize();
+
+  Header header;
+  std::memcpy(&header, data, sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      fml::LittleEndianToArch(header.version) != kVersion) {
+    FML_LOG(ERROR) << "Asset bundle has an unsupported format.";
+    return false;
+  }
+
+  const uint64_t entry_count = fml::LittleEndianToArch(header.entry_count);
+  const uint64_t names_offset = fml::LittleEndianToArch(header.names_offset);
+  const uint64_t names_size = fml::LittleEndianToArch(header.names_size);
+  // Bound the entry count before computing the end of the entries, so that
+  // the product cannot overflow.
+  if (entry_count > (size - sizeof(Header)) / sizeof(Entry)) {
+    FML_LOG(ERROR) << "Asset bundle index is out of bounds.";
+    return false;
+  }
+  const uint64_t entries_end = sizeof(Header) + entry_count * sizeof(Entry);
+  if (names_offset < entries_end || names_offset > size ||
+      names_size > size - names_offset) {
+    FML_LOG(ERROR) << "Asset bundle index is out of bounds.";
+    return false;
+  }
+
+  entries_ = reinterpret_cast<const Entry*>(data + sizeof(Header));
+  entry_count_ = entry_count;
+  names_ = reinterpret_cast<const char*>(data + names_offset);
+
+  // The hashes themselves are not verified, so that opening the bundle only
+  // touches its index. Lookups compare the names as well.
+  std::optional<Entry> previous;
+  for (size_t i = 0; i < entry_count_; i++) {
+    const Entry entry = GetEntry(i);
+    if (uint64_t{entry.name_offset} + entry.name_size > names_size ||
+        entry.data_offset % kBlobAlignment != 0 || entry.data_offset > size ||
+        entry.data_size > size - entry.data_offset) {
+      FML_LOG(ERROR) << "Asset bundle entry " << i << " is out of bounds.";
+      return false;
+    }
+    if (previous.has_value() &&
+        (previous->name_hash > entry.name_hash ||
+         (previous->name_hash == entry.name_hash &&
+          GetName(previous.value()) >= GetName(entry)))) {
+      FML_LOG(ERROR) << "Asset bundle index is not sorted.";
+      return false;
+    }
+    previous = entry;
+  }
+  return true;
+}
+
+IndexedAssetBundle::Entry IndexedAssetBundle::GetEntry(size_t index) const {
+  FML_DCHECK(index < entry_count_);
+  Entry entry;
+  std::memcpy(&entry, entries_ + index, sizeof(Entry));
+  entry.name_hash = fml::LittleEndianToArch(entry.name_hash);
+  entry.name_offset = fml::LittleEndianToArch(entry.name_offset);
+  entry.name_size = fml::LittleEndianToArch(entry.name_size);
+  entry.data_offset = fml::LittleEndianToArch(entry.data_offset);
+  entry.data_size = fml::LittleEndianToArch(entry.data_size);
+  return entry;
+}
+
+std::string_view IndexedAssetBundle::GetName(const Entry& entry) const {
+  return std::string_view(names_ + entry.name_offset, entry.name_size);
+}
+
+std::unique_ptr<fml::Mapping> IndexedAssetBundle::MapEntry(
+    const Entry& entry) const {
+  // The mapping keeps the bundle alive, since it may outlive the resolver
+  // when the asset manager changes.
+  return std::make_unique<fml::NonOwnedMapping>(
+      bundle_->GetMapping() + entry.data_offset, entry.data_size,
+      [bundle = bundle_](const uint8_t* data, size_t size) {});
+}
+
+// |AssetResolver|
+bool IndexedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool IndexedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType IndexedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kIndexedAssetBundle;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> IndexedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  const uint64_t hash = HashAssetName(asset_name);
+  size_t low = 0;
+  size_t high = entry_count_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const Entry entry = GetEntry(middle);
+    if (entry.name_hash < hash ||
+        (entry.name_hash == hash && GetName(entry) < asset_name)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == entry_count_) {
+    return nullptr;
+  }
+  const Entry entry = GetEntry(low);
+  if (entry.name_hash != hash || GetName(entry) != asset_name) {
+    return nullptr;
+  }
+  return MapEntry(entry);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> IndexedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  // Like |DirectoryAssetBundle|, the pattern is matched against the file
+  // names of all assets, or only of the assets directly in |subdir|.
+  std::regex asset_regex(asset_pattern);
+  for (size_t i = 0; i < entry_count_; i++) {
+    const Entry entry = GetEntry(i);
+    const std::string_view name = GetName(entry);
+    const size_t separator = name.rfind('/');
+    const std::string_view directory =
+        separator == std::string_view::npos ? std::string_view()
+                                            : name.substr(0, separator);
+    const std::string_view filename =
+        separator == std::string_view::npos ? name : name.substr(separator + 1);
+    if (subdir.has_value() && directory != subdir.value()) {
+      continue;
+    }
+    if (std::regex_match(filename.begin(), filename.end(), asset_regex)) {
+      mappings.push_back(MapEntry(entry));
+    }
+  }
+  return mappings;
+}
+
+}  // namespace flutter
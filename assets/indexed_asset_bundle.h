@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_INDEXED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_INDEXED_ASSET_BUNDLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An asset resolver for a bundle that packs all assets into a
+///             single file, so that the assets can be looked up with one
+///             mapping of the file instead of opening each of them.
+///
+///             The bundle starts with a |Header|, followed by one |Entry| per
+///             asset sorted by the hash of the asset name and then by the
+///             name itself, and the table of asset names. The contents of
+///             each asset start at a multiple of |kBlobAlignment|. All
+///             integers are little endian. Bundles are created with an
+///             |IndexedAssetBundleWriter|.
+///
+///             The mappings returned by the bundle share the mapping of the
+///             whole bundle, which stays alive as long as any of them does.
+///
+class IndexedAssetBundle : public AssetResolver {
+ public:
+  static constexpr uint8_t kMagic[8] = {'F', 'L', 'T', 'A',
+                                        'S', 'S', 'E', 'T'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kBlobAlignment = 4096;
+
+  struct Header {
+    uint8_t magic[8];
+    uint32_t version;
+    uint32_t entry_count;
+    uint64_t names_offset;
+    uint64_t names_size;
+  };
+
+  struct Entry {
+    /// The |HashAssetName| of the asset name.
+    uint64_t name_hash;
+    /// The offset of the name relative to |Header::names_offset|.
+    uint32_t name_offset;
+    uint32_t name_size;
+    uint64_t data_offset;
+    uint64_t data_size;
+  };
+
+  static_assert(sizeof(Header) == 32);
+  static_assert(sizeof(Entry) == 32);
+
+  /// The 64-bit FNV-1a hash of |name|, which is stable across platforms.
+  static uint64_t HashAssetName(std::string_view name);
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  bundle  The mapping of the bundle file, usually a
+  ///                     |fml::FileMapping|. The bundle is invalid if the
+  ///                     mapping is not a well formed bundle.
+  ///
+  IndexedAssetBundle(std::shared_ptr<const fml::Mapping> bundle,
+                     bool is_valid_after_asset_manager_change);
+
+  ~IndexedAssetBundle() override;
+
+  /// The number of assets in the bundle.
+  size_t GetAssetCount() const { return entry_count_; }
+
+ private:
+  std::shared_ptr<const fml::Mapping> bundle_;
+  const Entry* entries_ = nullptr;
+  size_t entry_count_ = 0;
+  const char* names_ = nullptr;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  bool ValidateBundle();
+
+  Entry GetEntry(size_t index) const;
+
+  std::string_view GetName(const Entry& entry) const;
+
+  std::unique_ptr<fml::Mapping> MapEntry(const Entry& entry) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IndexedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_INDEXED_ASSET_BUNDLE_H_
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/indexed_asset_bundle.h"
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/indexed_asset_bundle_writer.h"
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+std::shared_ptr<const fml::Mapping> MakeMapping(const std::string& contents) {
+  return std::make_shared<fml::DataMapping>(contents);
+}
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+std::unique_ptr<AssetResolver> MakeBundle(
+    const IndexedAssetBundleWriter& writer) {
+  std::shared_ptr<const fml::Mapping> bundle = writer.Finish();
+  return std::make_unique<IndexedAssetBundle>(bundle, false);
+}
+}  // namespace
+
+TEST(IndexedAssetBundleTest, LooksUpPackedAssets) {
+  IndexedAssetBundleWriter writer;
+  ASSERT_TRUE(writer.AddAsset("AssetManifest.json", MakeMapping("{}")));
+  ASSERT_TRUE(writer.AddAsset("fonts/Roboto.ttf", MakeMapping("font")));
+  ASSERT_TRUE(writer.AddAsset("images/empty.png", MakeMapping("")));
+  ASSERT_FALSE(writer.AddAsset("fonts/Roboto.ttf", MakeMapping("other")));
+  auto bundle = MakeBundle(writer);
+  ASSERT_TRUE(bundle->IsValid());
+  EXPECT_EQ(bundle->GetType(),
+            AssetResolver::AssetResolverType::kIndexedAssetBundle);
+  EXPECT_EQ(static_cast<IndexedAssetBundle*>(bundle.get())->GetAssetCount(),
+            3u);
+
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(bundle)));
+  auto manifest = asset_manager.GetAsMapping("AssetManifest.json");
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ(ToString(manifest), "{}");
+  auto font = asset_manager.GetAsMapping("fonts/Roboto.ttf");
+  ASSERT_TRUE(font);
+  EXPECT_EQ(ToString(font), "font");
+  auto image = asset_manager.GetAsMapping("images/empty.png");
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetSize(), 0u);
+  EXPECT_FALSE(asset_manager.GetAsMapping("fonts"));
+  EXPECT_FALSE(asset_manager.GetAsMapping("Roboto.ttf"));
+}
+
+TEST(IndexedAssetBundleTest, AssetsArePageAligned) {
+  IndexedAssetBundleWriter writer;
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(writer.AddAsset("asset" + std::to_string(i),
+                                MakeMapping(std::string(i * 1000 + 1, 'x'))));
+  }
+  std::shared_ptr<const fml::Mapping> mapping = writer.Finish();
+  ASSERT_TRUE(mapping);
+  IndexedAssetBundle bundle(mapping, false);
+  const AssetResolver& resolver = bundle;
+  ASSERT_TRUE(resolver.IsValid());
+  for (int i = 0; i < 10; i++) {
+    auto asset = resolver.GetAsMapping("asset" + std::to_string(i));
+    ASSERT_TRUE(asset);
+    EXPECT_EQ(asset->GetSize(), static_cast<size_t>(i * 1000 + 1));
+    EXPECT_EQ((asset->GetMapping() - mapping->GetMapping()) %
+                  IndexedAssetBundle::kBlobAlignment,
+              0);
+  }
+}
+
+TEST(IndexedAssetBundleTest, AssetsOutliveTheBundle) {
+  IndexedAssetBundleWriter writer;
+  ASSERT_TRUE(writer.AddAsset("asset", MakeMapping("contents")));
+  auto bundle = MakeBundle(writer);
+  auto asset = bundle->GetAsMapping("asset");
+  bundle.reset();
+  ASSERT_TRUE(asset);
+  EXPECT_EQ(ToString(asset), "contents");
+}
+
+TEST(IndexedAssetBundleTest, MatchesFileNamesInSubdirectories) {
+  IndexedAssetBundleWriter writer;
+  ASSERT_TRUE(writer.AddAsset("a.json", MakeMapping("a")));
+  ASSERT_TRUE(writer.AddAsset("shaders/b.json", MakeMapping("b")));
+  ASSERT_TRUE(writer.AddAsset("shaders/c.frag", MakeMapping("c")));
+  ASSERT_TRUE(writer.AddAsset("shaders/nested/d.json", MakeMapping("d")));
+  auto bundle = MakeBundle(writer);
+  ASSERT_TRUE(bundle->IsValid());
+
+  EXPECT_EQ(bundle->GetAsMappings(".*\\.json", std::nullopt).size(), 3u);
+  auto in_subdir = bundle->GetAsMappings(".*\\.json", "shaders");
+  ASSERT_EQ(in_subdir.size(), 1u);
+  EXPECT_EQ(ToString(in_subdir[0]), "b");
+  EXPECT_TRUE(bundle->GetAsMappings(".*", "fonts").empty());
+}
+
+TEST(IndexedAssetBundleTest, PacksDirectories) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto nested = fml::CreateDirectory(temp_dir.fd(), {"fonts", "nested"},
+                                     fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(nested.is_valid());
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "AssetManifest.json",
+                                   fml::DataMapping("{}")));
+  ASSERT_TRUE(
+      fml::WriteAtomically(nested, "Roboto.ttf", fml::DataMapping("font")));
+
+  IndexedAssetBundleWriter writer;
+  ASSERT_TRUE(writer.AddAssetsFromDirectory(temp_dir.fd()));
+  EXPECT_EQ(writer.GetAssetCount(), 2u);
+  auto bundle = MakeBundle(writer);
+  ASSERT_TRUE(bundle->IsValid());
+  auto font = bundle->GetAsMapping("fonts/nested/Roboto.ttf");
+  ASSERT_TRUE(font);
+  EXPECT_EQ(ToString(font), "font");
+}
+
+TEST(IndexedAssetBundleTest, RejectsMalformedBundles) {
+  IndexedAssetBundleWriter writer;
+  ASSERT_TRUE(writer.AddAsset("asset", MakeMapping("contents")));
+  auto packed = writer.Finish();
+  ASSERT_TRUE(packed);
+  const std::vector<uint8_t> valid(packed->GetMapping(),
+                                   packed->GetMapping() + packed->GetSize());
+  auto is_valid = [](std::vector<uint8_t> data) {
+    IndexedAssetBundle bundle(
+        std::make_shared<fml::DataMapping>(std::move(data)), false);
+    return static_cast<const AssetResolver&>(bundle).IsValid();
+  };
+  EXPECT_TRUE(is_valid(valid));
+
+  // Truncated.
+  EXPECT_FALSE(is_valid(std::vector<uint8_t>(valid.begin(), valid.end() - 1)));
+
+  // Wrong magic.
+  std::vector<uint8_t> wrong_magic = valid;
+  wrong_magic[0] = 'X';
+  EXPECT_FALSE(is_valid(wrong_magic));
+
+  // More entries than fit into the bundle.
+  std::vector<uint8_t> too_many_entries = valid;
+  const uint32_t entry_count = fml::LittleEndianToArch(uint32_t{1000});
+  std::memcpy(too_many_entries.data() +
+                  offsetof(IndexedAssetBundle::Header, entry_count),
+              &entry_count, sizeof(entry_count));
+  EXPECT_FALSE(is_valid(too_many_entries));
+
+  // The largest entry count, whose entries are far larger than the bundle.
+  std::vector<uint8_t> huge_entry_count = valid;
+  const uint32_t max_entry_count =
+      fml::LittleEndianToArch(std::numeric_limits<uint32_t>::max());
+  std::memcpy(huge_entry_count.data() +
+                  offsetof(IndexedAssetBundle::Header, entry_count),
+              &max_entry_count, sizeof(max_entry_count));
+  EXPECT_FALSE(is_valid(huge_entry_count));
+
+  EXPECT_FALSE(is_valid({}));
+}
+
+}  // namespace testing
+}  // namespace flutter
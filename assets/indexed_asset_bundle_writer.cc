@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/indexed_asset_bundle_writer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "flutter/assets/indexed_asset_bundle.h"
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+uint64_t AlignBlobOffset(uint64_t offset) {
+  constexpr uint64_t alignment = IndexedAssetBundle::kBlobAlignment;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+IndexedAssetBundleWriter::IndexedAssetBundleWriter() = default;
+
+IndexedAssetBundleWriter::~IndexedAssetBundleWriter() = default;
+
+bool IndexedAssetBundleWriter::AddAsset(
+    const std::string& name,
+    std::shared_ptr<const fml::Mapping> contents) {
+  if (!contents) {
+    return false;
+  }
+  return assets_.emplace(name, std::move(contents)).second;
+}
+
+bool IndexedAssetBundleWriter::AddAssetsFromDirectory(
+    const fml::UniqueFD& directory) {
+  std::string prefix;
+  fml::FileVisitor visitor = [&](const fml::UniqueFD& parent,
+                                 const std::string& filename) {
+    const std::string name = prefix + filename;
+    if (fml::IsDirectory(parent, filename.c_str())) {
+      fml::UniqueFD subdir =
+          fml::OpenDirectoryReadOnly(parent, filename.c_str());
+      const size_t prefix_size = prefix.size();
+      prefix = name + "/";
+      const bool result = fml::VisitFiles(subdir, visitor);
+      prefix.resize(prefix_size);
+      return result;
+    }
+    std::shared_ptr<const fml::Mapping> mapping =
+        fml::FileMapping::CreateReadOnly(parent, filename);
+    if (!mapping || !AddAsset(name, mapping)) {
+      FML_LOG(ERROR) << "Could not add asset " << name;
+      return false;
+    }
+    return true;
+  };
+  return fml::VisitFiles(directory, visitor);
+}
+
+std::unique_ptr<fml::Mapping> IndexedAssetBundleWriter::Finish() const {
+  using Entry = IndexedAssetBundle::Entry;
+  using Header = IndexedAssetBundle::Header;
+
+  if (assets_.size() > std::numeric_limits<uint32_t>::max()) {
+    FML_LOG(ERROR) << "Too many assets for an asset bundle.";
+    return nullptr;
+  }
+
+  struct Asset {
+    uint64_t hash;
+    const std::string* name;
+    const fml::Mapping* contents;
+  };
+  std::vector<Asset> assets;
+  assets.reserve(assets_.size());
+  for (const auto& [name, contents] : assets_) {
+    assets.push_back({
+        .hash = IndexedAssetBundle::HashAssetName(name),
+        .name = &name,
+        .contents = contents.get(),
+    });
+  }
+  std::sort(assets.begin(), assets.end(),
+            [](const Asset& a, const Asset& b) {
+              return a.hash < b.hash || (a.hash == b.hash && *a.name < *b.name);
+            });
+
+  std::vector<Entry> entries;
+  entries.reserve(assets.size());
+  std::string names;
+  for (const auto& asset : assets) {
+    if (names.size() + asset.name->size() >
+        std::numeric_limits<uint32_t>::max()) {
+      FML_LOG(ERROR) << "Asset names are too long for an asset bundle.";
+      return nullptr;
+    }
+    entries.push_back({
+        .name_hash = asset.hash,
+        .name_offset = static_cast<uint32_t>(names.size()),
+        .name_size = static_cast<uint32_t>(asset.name->size()),
+    });
+    names += *asset.name;
+  }
+
+  const uint64_t names_offset =
+      sizeof(Header) + entries.size() * sizeof(Entry);
+  uint64_t size = names_offset + names.size();
+  for (size_t i = 0; i < assets.size(); i++) {
+    entries[i].data_offset = AlignBlobOffset(size);
+    entries[i].data_size = assets[i].contents->GetSize();
+    size = entries[i].data_offset + entries[i].data_size;
+  }
+
+  std::vector<uint8_t> bundle(size, 0);
+  Header header = {
+      .version = fml::LittleEndianToArch(IndexedAssetBundle::kVersion),
+      .entry_count =
+          fml::LittleEndianToArch(static_cast<uint32_t>(entries.size())),
+      .names_offset = fml::LittleEndianToArch(names_offset),
+      .names_size = fml::LittleEndianToArch(uint64_t{names.size()}),
+  };
+  std::memcpy(header.magic, IndexedAssetBundle::kMagic, sizeof(header.magic));
+  std::memcpy(bundle.data(), &header, sizeof(Header));
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    const Entry& entry = entries[i];
+    if (entry.data_size > 0) {
+      std::memcpy(bundle.data() + entry.data_offset,
+                  assets[i].contents->GetMapping(), entry.data_size);
+    }
+    const Entry stored = {
+        .name_hash = fml::LittleEndianToArch(entry.name_hash),
+        .name_offset = fml::LittleEndianToArch(entry.name_offset),
+        .name_size = fml::LittleEndianToArch(entry.name_size),
+        .data_offset = fml::LittleEndianToArch(entry.data_offset),
+        .data_size = fml::LittleEndianToArch(entry.data_size),
+    };
+    std::memcpy(bundle.data() + sizeof(Header) + i * sizeof(Entry), &stored,
+                sizeof(Entry));
+  }
+  std::memcpy(bundle.data() + names_offset, names.data(), names.size());
+
+  return std::make_unique<fml::DataMapping>(std::move(bundle));
+}
+
+}  // namespace flutter
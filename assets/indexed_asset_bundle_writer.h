@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_INDEXED_ASSET_BUNDLE_WRITER_H_
+#define FLUTTER_ASSETS_INDEXED_ASSET_BUNDLE_WRITER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Packs assets into the single file format read by
+///             |IndexedAssetBundle|.
+///
+class IndexedAssetBundleWriter {
+ public:
+  IndexedAssetBundleWriter();
+
+  ~IndexedAssetBundleWriter();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an asset to the bundle.
+  ///
+  /// @param[in]  name      The name the asset is looked up by, relative to
+  ///                       the root of the bundle with '/' as separator.
+  /// @param[in]  contents  The contents of the asset.
+  ///
+  /// @return     Whether the asset was added. Fails if an asset with the
+  ///             same name was already added.
+  ///
+  bool AddAsset(const std::string& name,
+                std::shared_ptr<const fml::Mapping> contents);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds all files in |directory| and its subdirectories, named
+  ///             by their path relative to |directory|.
+  ///
+  /// @return     Whether all files could be mapped and added.
+  ///
+  bool AddAssetsFromDirectory(const fml::UniqueFD& directory);
+
+  /// The number of assets added so far.
+  size_t GetAssetCount() const { return assets_.size(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Packs the added assets.
+  ///
+  /// @return     The contents of the bundle file, or nullptr if the assets
+  ///             don't fit into the format.
+  ///
+  std::unique_ptr<fml::Mapping> Finish() const;
+
+ private:
+  std::map<std::string, std::shared_ptr<const fml::Mapping>> assets_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IndexedAssetBundleWriter);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_INDEXED_ASSET_BUNDLE_WRITER_H_
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Packs a directory of assets into a single file that can be loaded with an
+// |IndexedAssetBundle|.
+//
+// Usage: pack_asset_bundle --output=<bundle file> <assets directory>
+
+#include <iostream>
+#include <string>
+
+#include "flutter/assets/indexed_asset_bundle_writer.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+
+int main(int argc, char const* argv[]) {
+  auto command_line = fml::CommandLineFromArgcArgv(argc, argv);
+
+  std::string output;
+  if (!command_line.GetOptionValue("output", &output) || output.empty() ||
+      command_line.positional_args().size() != 1) {
+    std::cerr << "Usage: " << command_line.argv0()
+              << " --output=<bundle file> <assets directory>" << std::endl;
+    return 1;
+  }
+
+  const std::string& input = command_line.positional_args()[0];
+  auto input_directory = fml::OpenDirectory(input.c_str(), false,
+                                            fml::FilePermission::kRead);
+  if (!input_directory.is_valid()) {
+    std::cerr << "Could not open assets directory " << input << std::endl;
+    return 1;
+  }
+
+  flutter::IndexedAssetBundleWriter writer;
+  if (!writer.AddAssetsFromDirectory(input_directory)) {
+    std::cerr << "Could not read the assets in " << input << std::endl;
+    return 1;
+  }
+
+  auto bundle = writer.Finish();
+  if (!bundle) {
+    std::cerr << "Could not pack the assets in " << input << std::endl;
+    return 1;
+  }
+
+  const std::string output_path = fml::paths::AbsolutePath(output);
+  const std::string output_directory_path =
+      fml::paths::GetDirectoryName(output_path);
+  const std::string output_name =
+      output_path.substr(output_path.find_last_of("/\\") + 1);
+  auto output_directory = fml::OpenDirectory(
+      output_directory_path.c_str(), false, fml::FilePermission::kReadWrite);
+  if (!fml::WriteAtomically(output_directory, output_name.c_str(), *bundle)) {
+    std::cerr << "Could not write " << output << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -292,6 +292,29 @@ bool PersistentCache::IsValid() const {
   return cache_directory_ && cache_directory_->is_valid();
 }
 
+std::shared_ptr<fml::UniqueFD> PersistentCache::GetFontFallbackCacheDirectory()
+    const {
+  return OpenCacheSubdirectory(kFontFallbackSubdirName);
+}
+
+std::shared_ptr<fml::UniqueFD> PersistentCache::GetRasterCacheDirectory()
+    const {
+  return OpenCacheSubdirectory(kRasterCacheSubdirName);
+}
+
+std::shared_ptr<fml::UniqueFD> PersistentCache::OpenCacheSubdirectory(
+    const char* name) const {
+  if (is_read_only_ || !IsValid()) {
+    return nullptr;
+  }
+  fml::UniqueFD directory = fml::OpenDirectory(
+      *cache_directory_, name, true, fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    return nullptr;
+  }
+  return std::make_shared<fml::UniqueFD>(std::move(directory));
+}
+
 PersistentCache::SkSLCache PersistentCache::LoadFile(
     const fml::UniqueFD& dir,
     const std::string& file_name,
@@ -113,6 +113,25 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the directory of the font fallback cache, next to the
+  ///             shader caches so that it is versioned and purged with them.
+  ///
+  /// @return     The directory, or nullptr if the cache is read only or has no
+  ///             directory.
+  ///
+  std::shared_ptr<fml::UniqueFD> GetFontFallbackCacheDirectory() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the directory that rasterized display lists are saved
+  ///             in across launches, next to the shader caches so that it is
+  ///             versioned and purged with them.
+  ///
+  /// @return     The directory, or nullptr if the cache is read only or has no
+  ///             directory.
+  ///
+  std::shared_ptr<fml::UniqueFD> GetRasterCacheDirectory() const;
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -130,6 +149,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   static void MarkStrategySet() { strategy_set_ = true; }
 
   static constexpr char kSkSLSubdirName[] = "sksl";
+  static constexpr char kFontFallbackSubdirName[] = "fonts";
+  static constexpr char kRasterCacheSubdirName[] = "raster_cache";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
 
  private:
@@ -165,6 +186,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   bool IsValid() const;
 
+  std::shared_ptr<fml::UniqueFD> OpenCacheSubdirectory(const char* name) const;
+
   explicit PersistentCache(bool read_only = false);
 
   // |GrContextOptions::PersistentCache|
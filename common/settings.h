@@ -7,6 +7,7 @@
 
 #include <fcntl.h>
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <memory>
@@ -14,8 +15,10 @@
 #include <string>
 #include <vector>
 
+#include "flutter/fml/allocation_profiler.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/frame_cost_ledger.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
@@ -38,7 +41,7 @@ class FrameTiming {
       kVsyncStart,  kBuildStart,   kBuildFinish,
       kRasterStart, kRasterFinish, kRasterFinishWallTime};
 
-  static constexpr int kStatisticsCount = kCount + 5;
+  static constexpr int kStatisticsCount = kCount + 7;
 
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
@@ -60,6 +63,37 @@ class FrameTiming {
     picture_cache_count_ = picture_cache_count;
     picture_cache_bytes_ = picture_cache_bytes;
   }
+  /// The number of frames the rasterizer dropped since the previous frame
+  /// that was rasterized, for example because the GPU was backlogged.
+  uint64_t GetDroppedFrameCount() const { return dropped_frame_count_; }
+  void SetDroppedFrameCount(size_t dropped_frame_count) {
+    dropped_frame_count_ = dropped_frame_count;
+  }
+  /// The time the GPU spent executing the frame, or zero if it was not
+  /// measured.
+  fml::TimeDelta GetGpuDuration() const { return gpu_duration_; }
+  void SetGpuDuration(fml::TimeDelta gpu_duration) {
+    gpu_duration_ = gpu_duration;
+  }
+  /// The time the rasterization of the frame spent in well-known expensive
+  /// operations.
+  fml::TimeDelta GetCost(fml::FrameCostLedger::Category category) const {
+    return costs_[static_cast<size_t>(category)];
+  }
+  void SetCosts(
+      const std::array<fml::TimeDelta, fml::FrameCostLedger::kCategoryCount>&
+          costs) {
+    costs_ = costs;
+  }
+  /// The heap allocations of the raster thread during the rasterization of
+  /// the frame, if they were profiled.
+  const std::optional<fml::AllocationProfiler::Stats>& GetAllocationStats()
+      const {
+    return allocation_stats_;
+  }
+  void SetAllocationStats(const fml::AllocationProfiler::Stats& stats) {
+    allocation_stats_ = stats;
+  }
 
  private:
   fml::TimePoint data_[kCount];
@@ -68,6 +102,10 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  size_t dropped_frame_count_ = 0;
+  fml::TimeDelta gpu_duration_;
+  std::array<fml::TimeDelta, fml::FrameCostLedger::kCategoryCount> costs_ = {};
+  std::optional<fml::AllocationProfiler::Stats> allocation_stats_;
 };
 
 using TaskObserverAdd =
@@ -117,6 +155,14 @@ struct Settings {
   std::string isolate_snapshot_instr_path;  // deprecated
   MappingCallback isolate_snapshot_instr;
 
+  // Path to a profile of the snapshot pages that are needed during startup.
+  // The recorded pages are read ahead at launch and the others are released
+  // once the first frame has been rasterized.
+  std::string snapshot_residency_profile_path;
+  // Instead of using the profile, record it after the first frame. The page
+  // cache should be cold when recording, for example right after a reboot.
+  bool record_snapshot_residency_profile = false;
+
   std::string route;
 
   // Returns the Mapping to a kernel buffer which contains sources for dart:*
@@ -148,6 +194,11 @@ struct Settings {
   bool trace_systrace = false;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
+  // The directory that rasterized frames are written to as SKPs, or empty to
+  // not capture frames.
+  std::string capture_frames_directory;
+  // The number of frames to capture into |capture_frames_directory|.
+  size_t capture_frames_count = 100;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
   bool endless_trace_buffer = false;
@@ -209,6 +260,12 @@ struct Settings {
   // Enable the rendering of colors outside of the sRGB gamut.
   bool enable_wide_gamut = false;
 
+  // Whether save layers and filters are also rendered in wide gamut when
+  // |enable_wide_gamut| is set. An 8-bit sRGB offscreen takes half the memory
+  // and bandwidth of an extended range one, but clamps the colors drawn into
+  // it. Only used by Impeller on iOS.
+  bool enable_wide_gamut_offscreens = true;
+
   // Enable the Impeller renderer on supported platforms. Ignored if Impeller is
   // not supported on the platform.
 #if FML_OS_IOS || FML_OS_IOS_SIMULATOR
@@ -220,10 +277,29 @@ struct Settings {
   // Requests a particular backend to be used (ex "opengles" or "vulkan")
   std::optional<std::string> impeller_backend;
 
+  // Decode still JPEG and HEIF images with the image decoder of the platform,
+  // which may be hardware accelerated, instead of the builtin decoders. Only
+  // supported on iOS.
+  bool enable_platform_image_decoder = false;
+
   // Enable Vulkan validation on backends that support it. The validation layers
   // must be available to the application.
   bool enable_vulkan_validation = false;
 
+  // The present mode of the swapchains of Impeller on Vulkan: "fifo",
+  // "fifo-relaxed" or "mailbox". Surfaces that don't support the mode use
+  // "fifo".
+  std::optional<std::string> impeller_vulkan_present_mode;
+
+  // The number of images of the swapchains of Impeller on Vulkan, clamped to
+  // what the surface supports. Zero uses one more than the minimum of the
+  // surface.
+  uint32_t impeller_vulkan_swapchain_image_count = 0;
+
+  // How long the raster thread may wait for a swapchain image of Impeller on
+  // Vulkan before it drops the frame. Zero keeps the default of the backend.
+  int64_t impeller_vulkan_acquire_timeout_ms = 0;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -322,6 +398,72 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // The number of frames that the raster cache keeps an entry for after the
+  // last frame that used it.
+  size_t raster_cache_max_unused_frames = 0;
+
+  // The percentage of the resource cache limit computed by the shell's
+  // ResourceCacheLimitCalculator that raster cache images may use, or 0 for
+  // unlimited.
+  size_t raster_cache_max_bytes_percentage = 0;
+
+  // Cache layers and display lists in the raster cache when rendering with
+  // Impeller, which otherwise rasterizes every frame uncached. Experimental.
+  bool enable_impeller_raster_cache = false;
+
+  // Place the contents that Impeller records for each frame in a frame arena,
+  // a linear allocator that is reused by later frames. Experimental.
+  bool enable_impeller_frame_arena = false;
+
+  // The number of frames after which the Impeller images of the raster cache
+  // are compressed to save memory, or 0 to never compress them.
+  size_t raster_cache_compress_after_frames = 0;
+
+  // Save the compressed images of static display lists in the persistent
+  // cache directory, and cache them from there on later launches instead of
+  // rasterizing them. Only used along with raster_cache_compress_after_frames.
+  bool enable_raster_cache_disk_store = false;
+
+  // Preroll the children of containers on the concurrent worker threads when
+  // a frame has no platform views. Experimental.
+  bool enable_concurrent_preroll = false;
+
+  // Cache the display lists that scrolling is about to bring into view before
+  // they are visible, in the time that is left in the frame budget once the
+  // visible ones are cached.
+  bool enable_raster_cache_warm_up = false;
+
+  // Let the rasterizer deepen the layer tree pipeline up to three frames while
+  // frames occasionally take longer than the frame budget to rasterize, and
+  // shrink it to a single frame while frames are built and rasterized within
+  // one frame budget. Has no effect when the platform and raster threads are
+  // the same.
+  bool enable_adaptive_frame_pipeline_depth = false;
+
+  // Start building a frame after its vsync, as late as the build and raster
+  // durations of the recent frames allow while still meeting the target time
+  // of the vsync, so that the frame uses more recent input.
+  bool enable_predictive_frame_start = false;
+
+  // Drop stale frames on the raster thread instead of rendering them while
+  // the GPU is backlogged with previous frames. Only used with Impeller.
+  bool enable_gpu_backlog_frame_dropping = false;
+
+  // Measure the time the GPU spends executing each frame with GPU timestamp
+  // queries, and report it in the frame timings once the GPU has completed
+  // the frame. Only supported by Impeller on Metal and Vulkan.
+  bool enable_gpu_frame_timing = false;
+
+  // Run the UI and raster threads on the performance cores of heterogeneous
+  // CPUs while frames are being produced, and hint the CPU frequency governor
+  // with their deadlines. Only has an effect on Linux and Android.
+  bool enable_thread_qos_policy = false;
+
+  // Count the heap allocations of the raster thread in each frame by trace
+  // event scope. Only supported by engines built with the
+  // flutter_enable_allocation_profiler GN argument, and ignored otherwise.
+  bool profile_raster_allocations = false;
+
   /// The minimum number of samples to require in multipsampled anti-aliasing.
   ///
   /// Setting this value to 0 or 1 disables MSAA.
@@ -333,6 +475,13 @@ struct Settings {
   ///
   /// This is currently only used by iOS.
   bool enable_embedder_api = false;
+
+  /// Keep rasterizing on the raster thread when platform views are present,
+  /// instead of merging it with the platform thread. Only the changes to the
+  /// platform views are applied on the platform thread.
+  ///
+  /// This is currently only used by iOS.
+  bool enable_async_platform_view_composition = false;
 };
 
 }  // namespace flutter
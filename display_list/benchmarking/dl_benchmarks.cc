@@ -4,8 +4,10 @@
 
 #include "flutter/display_list/benchmarking/dl_benchmarks.h"
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/display_list/dl_op_flags.h"
 #include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -79,6 +81,7 @@ constexpr size_t kDRRectsToDraw = 2000;
 constexpr size_t kArcSweepSetsToDraw = 1000;
 constexpr size_t kImagesToDraw = 500;
 constexpr size_t kFixedCanvasSize = 1024;
+constexpr size_t kRectsToDispatch = 10000;
 
 // Draw a series of diagonal lines across a square canvas of width/height of
 // the length requested. The lines will start from the top left corner to the
@@ -1338,6 +1341,49 @@ void BM_SaveLayer(benchmark::State& state,
   surface_provider->Snapshot(filename);
 }
 
+// Counts the rects it receives and ignores everything else, so that playing
+// a DisplayList back to it mostly measures the cost of dispatching the ops.
+class RectCountingReceiver final : public IgnoreAttributeDispatchHelper,
+                                   public IgnoreClipDispatchHelper,
+                                   public IgnoreTransformDispatchHelper,
+                                   public IgnoreDrawDispatchHelper {
+ public:
+  void drawRect(const SkRect& rect) override { rect_count_++; }
+
+  size_t rect_count() const { return rect_count_; }
+
+ private:
+  size_t rect_count_ = 0;
+};
+
+// Plays back a list of 10,000 rects that alternate between two colors,
+// either through the DlOpReceiver vtable or inlined into the dispatch loop.
+static void BM_DispatchDisplayList(benchmark::State& state,
+                                   bool dispatch_inline) {
+  DlPaint paints[] = {DlPaint(DlColor::kRed()), DlPaint(DlColor::kBlue())};
+  DisplayListBuilder builder;
+  for (size_t i = 0; i < kRectsToDispatch; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i % 100, i / 100, 1, 1), paints[i % 2]);
+  }
+  auto display_list = builder.Build();
+  state.counters["OpCount"] = display_list->op_count();
+
+  RectCountingReceiver receiver;
+  for ([[maybe_unused]] auto _ : state) {
+    if (dispatch_inline) {
+      display_list->DispatchInline(receiver);
+    } else {
+      display_list->Dispatch(receiver);
+    }
+  }
+  benchmark::DoNotOptimize(receiver.rect_count());
+}
+
+BENCHMARK_CAPTURE(BM_DispatchDisplayList, Virtual, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DispatchDisplayList, Inline, true)
+    ->Unit(benchmark::kMicrosecond);
+
 #ifdef ENABLE_SOFTWARE_BENCHMARKS
 RUN_DISPLAYLIST_BENCHMARKS(Software)
 #endif
@@ -149,6 +149,49 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   }
 }
 
+// Records a long list of items that alternate between two colors, like a
+// scrolled list, through a cull rect that only shows a screenful of them.
+// The Bytes counter shows how much of the recording is left by the items
+// that were culled.
+static void BM_DisplayListBuilderWithCulledItems(
+    benchmark::State& state,
+    DisplayListBuilderBenchmarkType type) {
+  const int kItemCount = 1000;
+  const SkScalar kItemHeight = 50;
+  SkRect cull_rect = SkRect::MakeXYWH(0, 20000, 400, 800);
+  DlPaint paints[] = {DlPaint(DlColor::kRed()), DlPaint(DlColor::kBlue())};
+  bool prepare_rtree = NeedPrepareRTree(type);
+  size_t bytes = 0;
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder(cull_rect, prepare_rtree);
+    for (int i = 0; i < kItemCount; i++) {
+      builder.DrawRect(SkRect::MakeXYWH(0, i * kItemHeight, 400, kItemHeight),
+                       paints[i % 2]);
+    }
+    auto display_list = builder.Build();
+    bytes = display_list->bytes();
+  }
+  state.counters["Bytes"] = bytes;
+}
+
+// Records a single long list of rects, such as a chart with many data
+// points, to measure how the cost of growing the storage of the builder
+// scales with the length of the recording.
+static void BM_DisplayListBuilderWithManyOps(benchmark::State& state) {
+  const int op_count = state.range(0);
+  DlPaint paint(DlColor::kRed());
+  size_t bytes = 0;
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder;
+    for (int i = 0; i < op_count; i++) {
+      builder.DrawRect(SkRect::MakeXYWH(i % 100, i / 100, 1, 1), paint);
+    }
+    auto display_list = builder.Build();
+    bytes = display_list->bytes();
+  }
+  state.counters["Bytes"] = bytes;
+}
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -251,4 +294,18 @@ BENCHMARK_CAPTURE(BM_DisplayListBuilderWithSaveLayerAndImageFilter,
                   DisplayListBuilderBenchmarkType::kBoundsAndRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithCulledItems,
+                  kDefault,
+                  DisplayListBuilderBenchmarkType::kDefault)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithCulledItems,
+                  kRtree,
+                  DisplayListBuilderBenchmarkType::kRtree)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_DisplayListBuilderWithManyOps)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -3,12 +3,20 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/benchmarking/dl_complexity.h"
+
+#include <atomic>
+
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
 #include "flutter/display_list/display_list.h"
 
 namespace flutter {
 
+static uint32_t NextCalculatorId() {
+  static std::atomic<uint32_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
 DisplayListNaiveComplexityCalculator*
     DisplayListNaiveComplexityCalculator::instance_ = nullptr;
 
@@ -20,6 +28,28 @@ DisplayListNaiveComplexityCalculator::GetInstance() {
   return instance_;
 }
 
+DisplayListComplexityCalculator::DisplayListComplexityCalculator()
+    : id_(NextCalculatorId()) {}
+
+void DisplayListComplexityCalculator::InvalidateCachedScores() {
+  id_ = NextCalculatorId();
+}
+
+unsigned int DisplayListComplexityCalculator::ComputeCached(
+    const DisplayList* display_list) {
+  static_assert(sizeof(unsigned int) <= sizeof(uint32_t));
+  // A list that was never scored holds an id of 0, which no calculator has.
+  uint64_t cached = display_list->complexity_score_.load(
+      std::memory_order_relaxed);
+  if (static_cast<uint32_t>(cached >> 32) == id_) {
+    return static_cast<unsigned int>(cached);
+  }
+  unsigned int score = Compute(display_list);
+  display_list->complexity_score_.store(
+      (static_cast<uint64_t>(id_) << 32) | score, std::memory_order_relaxed);
+  return score;
+}
+
 DisplayListComplexityCalculator* DisplayListComplexityCalculator::GetForBackend(
     GrBackendApi backend) {
   switch (backend) {
@@ -21,6 +21,13 @@ class DisplayListComplexityCalculator {
   // Returns a calculated complexity score for a given DisplayList object
   virtual unsigned int Compute(const DisplayList* display_list) = 0;
 
+  // Returns the score Compute would return for a given DisplayList object,
+  // computing it only the first time this calculator is asked about the
+  // DisplayList. DisplayLists never change once built, so the raster cache
+  // can ask about a retained picture on every frame without measuring it
+  // again.
+  unsigned int ComputeCached(const DisplayList* display_list);
+
   // Returns whether a given complexity score meets the threshold for
   // cacheability for this particular ComplexityCalculator
   virtual bool ShouldBeCached(unsigned int complexity_score) = 0;
@@ -31,6 +38,16 @@ class DisplayListComplexityCalculator {
   // This setting has no effect on non-accumulator based scorers such as
   // the Naive calculator.
   virtual void SetComplexityCeiling(unsigned int ceiling) = 0;
+
+ protected:
+  DisplayListComplexityCalculator();
+
+  // Makes ComputeCached forget the scores computed so far, for calculators
+  // whose scores depend on settings that have changed.
+  void InvalidateCachedScores();
+
+ private:
+  uint32_t id_;
 };
 
 class DisplayListNaiveComplexityCalculator
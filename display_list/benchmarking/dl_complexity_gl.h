@@ -27,6 +27,7 @@ class DisplayListGLComplexityCalculator
 
   void SetComplexityCeiling(unsigned int ceiling) override {
     ceiling_ = ceiling;
+    InvalidateCachedScores();
   }
 
  private:
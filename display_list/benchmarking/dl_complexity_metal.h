@@ -27,6 +27,7 @@ class DisplayListMetalComplexityCalculator
 
   void SetComplexityCeiling(unsigned int ceiling) override {
     ceiling_ = ceiling;
+    InvalidateCachedScores();
   }
 
  private:
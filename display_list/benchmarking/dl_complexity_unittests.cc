@@ -64,6 +64,36 @@ TEST(DisplayListComplexity, DisplayListCeiling) {
   }
 }
 
+TEST(DisplayListComplexity, CachedScoreMatchesComputedScore) {
+  auto display_list = GetSampleDisplayList();
+
+  auto calculators = Calculators();
+  for (auto calculator : calculators) {
+    unsigned int score = calculator->Compute(display_list.get());
+    ASSERT_EQ(calculator->ComputeCached(display_list.get()), score);
+    ASSERT_EQ(calculator->ComputeCached(display_list.get()), score);
+  }
+  // Each calculator replaced the score cached by the one before it.
+  for (auto calculator : calculators) {
+    ASSERT_EQ(calculator->ComputeCached(display_list.get()),
+              calculator->Compute(display_list.get()));
+  }
+}
+
+TEST(DisplayListComplexity, CachedScoreFollowsCeiling) {
+  auto display_list = GetSampleDisplayList();
+
+  auto calculators = AccumulatorCalculators();
+  for (auto calculator : calculators) {
+    unsigned int score = calculator->ComputeCached(display_list.get());
+    ASSERT_GT(score, 1u);
+    calculator->SetComplexityCeiling(score - 1);
+    ASSERT_EQ(calculator->ComputeCached(display_list.get()), score - 1);
+    calculator->SetComplexityCeiling(std::numeric_limits<unsigned int>::max());
+    ASSERT_EQ(calculator->ComputeCached(display_list.get()), score);
+  }
+}
+
 TEST(DisplayListComplexity, NestedDisplayList) {
   auto display_list = GetSampleNestedDisplayList();
 
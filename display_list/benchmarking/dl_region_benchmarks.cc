@@ -48,6 +48,28 @@ SkIRect RandomSubRect(RNG& rng, const SkIRect& rect, double size_factor) {
                            width, height);
 }
 
+// Damage of a scrolling list where every row has a leading icon, a title, a
+// subtitle and a trailing icon. The list has 300 rows, which results in 1200
+// rectangles.
+std::vector<SkIRect> GenerateScrollingListDamage(int32_t scroll_offset) {
+  constexpr int32_t kRowCount = 300;
+  constexpr int32_t kRowHeight = 72;
+
+  std::vector<SkIRect> rects;
+  rects.reserve(kRowCount * 4);
+  for (int32_t row = 0; row < kRowCount; ++row) {
+    int32_t top = row * kRowHeight - scroll_offset;
+    rects.push_back(SkIRect::MakeXYWH(16, top + 12, 48, 48));
+    rects.push_back(SkIRect::MakeXYWH(80, top + 12, 600 - (row % 5) * 40, 24));
+    rects.push_back(SkIRect::MakeXYWH(80, top + 40, 800 - (row % 3) * 60, 20));
+    rects.push_back(SkIRect::MakeXYWH(1000, top + 24, 48, 24));
+  }
+  return rects;
+}
+
+// The distance the list scrolls between two frames.
+const int32_t kScrollDelta = 17;
+
 class SkRegionAdapter {
  public:
   explicit SkRegionAdapter(const std::vector<SkIRect>& rects) {
@@ -86,6 +108,9 @@ class SkRegionAdapter {
     return rects;
   }
 
+  // SkRegion already coalesces identical adjacent bands.
+  std::vector<SkIRect> getDebandedRects() { return getRects(); }
+
  private:
   SkRegion region_;
 };
@@ -117,6 +142,8 @@ class DlRegionAdapter {
 
   std::vector<SkIRect> getRects() { return region_.getRects(false); }
 
+  std::vector<SkIRect> getDebandedRects() { return region_.getRects(true); }
+
  private:
   explicit DlRegionAdapter(flutter::DlRegion&& region)
       : region_(std::move(region)) {}
@@ -253,6 +280,36 @@ void RunIntersectsSingleRectBenchmark(benchmark::State& state, int maxSize) {
   }
 }
 
+template <typename Region>
+void RunScrollingRegionOpBenchmark(benchmark::State& state, RegionOp op) {
+  Region previous_frame(GenerateScrollingListDamage(0));
+  Region current_frame(GenerateScrollingListDamage(kScrollDelta));
+
+  switch (op) {
+    case kUnion:
+      while (state.KeepRunning()) {
+        Region::unionRegions(previous_frame, current_frame);
+      }
+      break;
+    case kIntersection:
+      while (state.KeepRunning()) {
+        Region::intersectRegions(previous_frame, current_frame);
+      }
+      break;
+  }
+}
+
+template <typename Region>
+void RunScrollingGetRectsBenchmark(benchmark::State& state) {
+  Region damage = Region::unionRegions(
+      Region(GenerateScrollingListDamage(0)),
+      Region(GenerateScrollingListDamage(kScrollDelta)));
+
+  while (state.KeepRunning()) {
+    auto rects = damage.getDebandedRects();
+  }
+}
+
 }  // namespace
 
 namespace flutter {
@@ -313,6 +370,24 @@ static void BM_SkRegion_IntersectsSingleRect(benchmark::State& state,
   RunIntersectsSingleRectBenchmark<SkRegionAdapter>(state, maxSize);
 }
 
+static void BM_DlRegion_ScrollingOperation(benchmark::State& state,
+                                           RegionOp op) {
+  RunScrollingRegionOpBenchmark<DlRegionAdapter>(state, op);
+}
+
+static void BM_SkRegion_ScrollingOperation(benchmark::State& state,
+                                           RegionOp op) {
+  RunScrollingRegionOpBenchmark<SkRegionAdapter>(state, op);
+}
+
+static void BM_DlRegion_ScrollingGetRects(benchmark::State& state) {
+  RunScrollingGetRectsBenchmark<DlRegionAdapter>(state);
+}
+
+static void BM_SkRegion_ScrollingGetRects(benchmark::State& state) {
+  RunScrollingGetRectsBenchmark<SkRegionAdapter>(state);
+}
+
 const double kSizeFactorSmall = 0.3;
 
 BENCHMARK_CAPTURE(BM_DlRegion_IntersectsSingleRect, Tiny, 30)
@@ -709,4 +784,19 @@ BENCHMARK_CAPTURE(BM_DlRegion_GetRects, Large, 1500)
 BENCHMARK_CAPTURE(BM_SkRegion_GetRects, Large, 1500)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DlRegion_ScrollingOperation, Union, RegionOp::kUnion)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_ScrollingOperation, Union, RegionOp::kUnion)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_ScrollingOperation,
+                  Intersection,
+                  RegionOp::kIntersection)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_ScrollingOperation,
+                  Intersection,
+                  RegionOp::kIntersection)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DlRegion_ScrollingGetRects)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SkRegion_ScrollingGetRects)->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
\ No newline at end of file
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/geometry/dl_rtree.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+#include <algorithm>
+#include <random>
+
+namespace flutter {
+
+namespace {
+
+enum class RectLayout {
+  // Rows of cells recorded from top to bottom, like a scrolling list.
+  kPage,
+  // Rects recorded in no spatial order, like the features of a map or the
+  // points of a scatter chart.
+  kScattered,
+};
+
+const int kColumns = 12;
+const SkScalar kCellSize = 64;
+
+std::vector<SkRect> GenerateRects(RectLayout layout, int count) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<SkScalar> size(8, kCellSize);
+
+  int rows = (count + kColumns - 1) / kColumns;
+  std::uniform_real_distribution<SkScalar> pos_x(0, kColumns * kCellSize);
+  std::uniform_real_distribution<SkScalar> pos_y(0, rows * kCellSize);
+
+  std::vector<SkRect> rects;
+  rects.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    switch (layout) {
+      case RectLayout::kPage:
+        rects.push_back(SkRect::MakeXYWH((i % kColumns) * kCellSize,
+                                         (i / kColumns) * kCellSize,
+                                         size(rng), size(rng)));
+        break;
+      case RectLayout::kScattered:
+        rects.push_back(
+            SkRect::MakeXYWH(pos_x(rng), pos_y(rng), size(rng), size(rng)));
+        break;
+    }
+  }
+  return rects;
+}
+
+}  // namespace
+
+static void BM_DlRTree_Build(benchmark::State& state, RectLayout layout) {
+  auto rects = GenerateRects(layout, state.range(0));
+
+  while (state.KeepRunning()) {
+    DlRTree tree(rects.data(), rects.size());
+    benchmark::DoNotOptimize(tree.node_count());
+  }
+}
+
+static void BM_DlRTree_Search(benchmark::State& state, RectLayout layout) {
+  auto rects = GenerateRects(layout, state.range(0));
+  DlRTree tree(rects.data(), rects.size());
+
+  // Screen sized cull rects at random positions within the tree.
+  const SkScalar kQueryWidth = 400;
+  const SkScalar kQueryHeight = 800;
+  std::seed_seq seed{3, 1, 2};
+  std::mt19937 rng(seed);
+  const SkRect& bounds = tree.bounds();
+  std::uniform_real_distribution<SkScalar> pos_x(
+      bounds.fLeft, std::max(bounds.fLeft, bounds.fRight - kQueryWidth));
+  std::uniform_real_distribution<SkScalar> pos_y(
+      bounds.fTop, std::max(bounds.fTop, bounds.fBottom - kQueryHeight));
+  std::vector<SkRect> queries;
+  for (int i = 0; i < 100; ++i) {
+    queries.push_back(SkRect::MakeXYWH(pos_x(rng), pos_y(rng), kQueryWidth,
+                                       kQueryHeight));
+  }
+
+  std::vector<int> results;
+  while (state.KeepRunning()) {
+    for (const auto& query : queries) {
+      results.clear();
+      tree.search(query, &results);
+    }
+  }
+}
+
+BENCHMARK_CAPTURE(BM_DlRTree_Build, Page, RectLayout::kPage)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Build, Scattered, RectLayout::kScattered)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Page, RectLayout::kPage)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Scattered, RectLayout::kScattered)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/display_list/dl_op_records.h"
 #include "flutter/fml/trace_event.h"
 
@@ -23,7 +24,8 @@ DisplayList::DisplayList()
       bounds_({0, 0, 0, 0}),
       can_apply_group_opacity_(true),
       is_ui_thread_safe_(true),
-      modifies_transparent_black_(false) {}
+      modifies_transparent_black_(false),
+      has_backdrop_filter_(false) {}
 
 DisplayList::DisplayList(DisplayListStorage&& storage,
                          size_t byte_count,
@@ -34,6 +36,7 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
                          bool can_apply_group_opacity,
                          bool is_ui_thread_safe,
                          bool modifies_transparent_black,
+                         bool has_backdrop_filter,
                          sk_sp<const DlRTree> rtree)
     : storage_(std::move(storage)),
       byte_count_(byte_count),
@@ -45,6 +48,7 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       can_apply_group_opacity_(can_apply_group_opacity),
       is_ui_thread_safe_(is_ui_thread_safe),
       modifies_transparent_black_(modifies_transparent_black),
+      has_backdrop_filter_(has_backdrop_filter),
       rtree_(std::move(rtree)) {}
 
 DisplayList::~DisplayList() {
@@ -61,152 +65,73 @@ uint32_t DisplayList::next_unique_id() {
   return id;
 }
 
-class Culler {
- public:
-  virtual ~Culler() = default;
-  virtual bool init(DispatchContext& context) = 0;
-  virtual void update(DispatchContext& context) = 0;
-};
-class NopCuller final : public Culler {
- public:
-  static NopCuller instance;
-
-  ~NopCuller() = default;
-
-  bool init(DispatchContext& context) override {
-    // Setting next_render_index to 0 means that
-    // all rendering ops will be at or after that
-    // index so they will execute and all restore
-    // indices will be after it as well so all
-    // clip and transform operations will execute.
-    context.next_render_index = 0;
-    return true;
-  }
-  void update(DispatchContext& context) override {}
-};
-NopCuller NopCuller::instance = NopCuller();
-class VectorCuller final : public Culler {
- public:
-  VectorCuller(const DlRTree* rtree, const std::vector<int>& rect_indices)
-      : rtree_(rtree), cur_(rect_indices.begin()), end_(rect_indices.end()) {}
-
-  ~VectorCuller() = default;
-
-  bool init(DispatchContext& context) override {
-    if (cur_ < end_) {
-      context.next_render_index = rtree_->id(*cur_++);
-      return true;
-    } else {
-      // Setting next_render_index to MAX_INT means that
-      // all rendering ops will be "before" that index and
-      // they will skip themselves and all clip and transform
-      // ops will see that the next render index is not
-      // before the next restore index (even if both are MAX_INT)
-      // and so they will also not execute.
-      // None of this really matters because returning false
-      // here should cause the Dispatch operation to abort,
-      // but this value is conceptually correct if that short
-      // circuit optimization isn't used.
-      context.next_render_index = std::numeric_limits<int>::max();
-      return false;
-    }
-  }
-  void update(DispatchContext& context) override {
-    if (++context.cur_index > context.next_render_index) {
-      while (cur_ < end_) {
-        context.next_render_index = rtree_->id(*cur_++);
-        if (context.next_render_index >= context.cur_index) {
-          // It should be rare that we have duplicate indices
-          // but if we do, then having a while loop is a cheap
-          // insurance for those cases.
-          // The main cause of duplicate indices is when a
-          // DrawDisplayListOp was added to this DisplayList and
-          // both are computing an R-Tree, in which case the
-          // builder method will forward all of the child
-          // DisplayList's rects to this R-Tree with the same
-          // op_index.
-          return;
-        }
-      }
-      context.next_render_index = std::numeric_limits<int>::max();
-    }
-  }
-
- private:
-  const DlRTree* rtree_;
-  std::vector<int>::const_iterator cur_;
-  std::vector<int>::const_iterator end_;
-};
-
 void DisplayList::Dispatch(DlOpReceiver& receiver) const {
-  uint8_t* ptr = storage_.get();
-  Dispatch(receiver, ptr, ptr + byte_count_, NopCuller::instance);
+  DispatchInline(receiver);
 }
 
 void DisplayList::Dispatch(DlOpReceiver& receiver,
                            const SkIRect& cull_rect) const {
-  Dispatch(receiver, SkRect::Make(cull_rect));
+  DispatchInline(receiver, cull_rect);
 }
 
 void DisplayList::Dispatch(DlOpReceiver& receiver,
                            const SkRect& cull_rect) const {
-  if (cull_rect.isEmpty()) {
-    return;
-  }
-  if (cull_rect.contains(bounds())) {
-    Dispatch(receiver);
-    return;
-  }
-  const DlRTree* rtree = this->rtree().get();
-  FML_DCHECK(rtree != nullptr);
-  if (rtree == nullptr) {
-    FML_LOG(ERROR) << "dispatched with culling rect on DL with no rtree";
-    Dispatch(receiver);
-    return;
-  }
-  uint8_t* ptr = storage_.get();
-  std::vector<int> rect_indices;
-  rtree->search(cull_rect, &rect_indices);
-  VectorCuller culler(rtree, rect_indices);
-  Dispatch(receiver, ptr, ptr + byte_count_, culler);
+  DispatchInline(receiver, cull_rect);
 }
 
-void DisplayList::Dispatch(DlOpReceiver& receiver,
-                           uint8_t* ptr,
-                           uint8_t* end,
-                           Culler& culler) const {
-  DispatchContext context = {
-      .receiver = receiver,
-      .cur_index = 0,
-      // next_render_index will be initialized by culler.init()
-      .next_restore_index = std::numeric_limits<int>::max(),
-  };
-  if (!culler.init(context)) {
-    return;
-  }
+std::vector<int> DisplayList::GetDispatchPartitions(size_t max_count) const {
+  std::vector<int> boundaries = {0};
+  uint8_t* start = storage_.get();
+  uint8_t* end = start + byte_count_;
+  uint8_t* ptr = start;
+  // Whether each of the open saves is a saveLayer.
+  std::vector<bool> saves_are_layers;
+  int layer_depth = 0;
+  int index = 0;
+  size_t next_partition = 1;
   while (ptr < end) {
+    size_t offset = ptr - start;
+    if (layer_depth == 0 && next_partition < max_count &&
+        offset * max_count >= next_partition * byte_count_ &&
+        index > boundaries.back()) {
+      boundaries.push_back(index);
+      // Skip the partitions that ended inside of the layer that was just
+      // closed, rather than cutting slivers after it.
+      while (next_partition < max_count &&
+             offset * max_count >= next_partition * byte_count_) {
+        next_partition++;
+      }
+    }
     auto op = reinterpret_cast<const DLOp*>(ptr);
-    ptr += op->size;
-    FML_DCHECK(ptr <= end);
     switch (op->type) {
-#define DL_OP_DISPATCH(name)                             \
-  case DisplayListOpType::k##name:                       \
-    static_cast<const name##Op*>(op)->dispatch(context); \
-    break;
-
-      FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
-#ifdef IMPELLER_ENABLE_3D
-      DL_OP_DISPATCH(SetSceneColorSource)
-#endif  // IMPELLER_ENABLE_3D
-
-#undef DL_OP_DISPATCH
-
+      case DisplayListOpType::kSave:
+        saves_are_layers.push_back(false);
+        break;
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+      case DisplayListOpType::kSaveLayerBackdrop:
+      case DisplayListOpType::kSaveLayerBackdropBounds:
+        saves_are_layers.push_back(true);
+        layer_depth++;
+        break;
+      case DisplayListOpType::kRestore:
+        if (!saves_are_layers.empty()) {
+          if (saves_are_layers.back()) {
+            layer_depth--;
+          }
+          saves_are_layers.pop_back();
+        }
+        break;
       default:
-        FML_DCHECK(false);
-        return;
+        break;
     }
-    culler.update(context);
+    ptr += op->size;
+    index++;
+  }
+  if (index > boundaries.back()) {
+    boundaries.push_back(index);
   }
+  return boundaries;
 }
 
 void DisplayList::DisposeOps(uint8_t* ptr, uint8_t* end) {
@@ -5,11 +5,14 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
+#include <atomic>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/display_list/dl_sampling_options.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
+#include "flutter/fml/host_allocator.h"
 #include "flutter/fml/logging.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
@@ -202,27 +205,35 @@ class SaveLayerOptions {
   };
 };
 
-// Manages a buffer allocated with malloc.
+// Manages a buffer allocated with the fml::HostAllocator.
 class DisplayListStorage {
  public:
   DisplayListStorage() = default;
-  DisplayListStorage(DisplayListStorage&&) = default;
+  DisplayListStorage(DisplayListStorage&& other)
+      : ptr_(other.ptr_), size_(other.size_) {
+    other.ptr_ = nullptr;
+    other.size_ = 0;
+  }
+
+  ~DisplayListStorage() {
+    fml::HostFree(ptr_, size_, fml::HostAllocationCategory::kDisplayList);
+  }
 
-  uint8_t* get() const { return ptr_.get(); }
+  uint8_t* get() const { return ptr_; }
 
   void realloc(size_t count) {
-    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
+    ptr_ = static_cast<uint8_t*>(fml::HostReallocate(
+        ptr_, size_, count, fml::HostAllocationCategory::kDisplayList));
     FML_CHECK(ptr_);
+    size_ = count;
   }
 
  private:
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
-};
+  uint8_t* ptr_ = nullptr;
+  size_t size_ = 0;
 
-class Culler;
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStorage);
+};
 
 // The base class that contains a sequence of rendering operations
 // for dispatch to a DlOpReceiver. These objects must be instantiated
@@ -237,6 +248,39 @@ class DisplayList : public SkRefCnt {
   void Dispatch(DlOpReceiver& ctx, const SkRect& cull_rect) const;
   void Dispatch(DlOpReceiver& ctx, const SkIRect& cull_rect) const;
 
+  // Dispatches the ops like |Dispatch|, but through the static type of the
+  // receiver rather than through the DlOpReceiver vtable, so that calls to
+  // a receiver whose class is final can be devirtualized and inlined into
+  // the loop over the ops. This is worth it for the few receivers that play
+  // back every frame, and is defined in dl_inline_dispatch.h to keep the op
+  // records out of the headers of every other client.
+  template <typename Receiver>
+  void DispatchInline(Receiver& receiver) const;
+  template <typename Receiver>
+  void DispatchInline(Receiver& receiver, const SkRect& cull_rect) const;
+  template <typename Receiver>
+  void DispatchInline(Receiver& receiver, const SkIRect& cull_rect) const {
+    DispatchInline(receiver, SkRect::Make(cull_rect));
+  }
+
+  // Dispatches the rendering ops whose indices are in the range
+  // [start_index, end_index) and inside |cull_rect|, along with the
+  // attribute, save, transform and clip ops that set up their state. Used
+  // with the boundaries returned by |GetDispatchPartitions|, this lets the
+  // partitions of a list be recorded concurrently by separate receivers.
+  template <typename Receiver>
+  void DispatchInline(Receiver& receiver,
+                      int start_index,
+                      int end_index,
+                      const SkRect& cull_rect) const;
+
+  // Returns the op indices that split the list into at most |max_count|
+  // partitions of similar byte size, starting with 0 and ending with the
+  // number of ops. The boundaries only fall between ops outside of any
+  // saveLayer, so that drawing the recordings of the partitions in order
+  // renders the same as a recording of the whole list.
+  std::vector<int> GetDispatchPartitions(size_t max_count) const;
+
   // From historical behavior, SkPicture always included nested bytes,
   // but nested ops are only included if requested. The defaults used
   // here for these accessors follow that pattern.
@@ -278,6 +322,14 @@ class DisplayList : public SkRefCnt {
     return modifies_transparent_black_;
   }
 
+  /// @brief     Indicates if any saveLayer in this DisplayList, or in the
+  ///            DisplayLists it draws, has a backdrop filter.
+  ///
+  /// A backdrop filter reads the pixels that were already rendered around
+  /// the layer, so such a DisplayList can't be rendered in separate pieces
+  /// that are each unaware of the pixels in the others.
+  bool has_backdrop_filter() const { return has_backdrop_filter_; }
+
  private:
   DisplayList(DisplayListStorage&& ptr,
               size_t byte_count,
@@ -288,6 +340,7 @@ class DisplayList : public SkRefCnt {
               bool can_apply_group_opacity,
               bool is_ui_thread_safe,
               bool modifies_transparent_black,
+              bool has_backdrop_filter,
               sk_sp<const DlRTree> rtree);
 
   static uint32_t next_unique_id();
@@ -307,15 +360,27 @@ class DisplayList : public SkRefCnt {
   const bool can_apply_group_opacity_;
   const bool is_ui_thread_safe_;
   const bool modifies_transparent_black_;
+  const bool has_backdrop_filter_;
 
   const sk_sp<const DlRTree> rtree_;
 
-  void Dispatch(DlOpReceiver& ctx,
-                uint8_t* ptr,
-                uint8_t* end,
-                Culler& culler) const;
+  // The last score a complexity calculator computed for this list, with the
+  // id of that calculator in the upper 32 bits.
+  // See DisplayListComplexityCalculator::ComputeCached.
+  mutable std::atomic<uint64_t> complexity_score_ = 0;
+
+  class NopCuller;
+  class VectorCuller;
+  class RangeCuller;
+
+  template <typename Receiver, typename Culler>
+  void DispatchOps(Receiver& receiver,
+                   uint8_t* ptr,
+                   uint8_t* end,
+                   Culler& culler) const;
 
   friend class DisplayListBuilder;
+  friend class DisplayListComplexityCalculator;
 };
 
 }  // namespace flutter
@@ -11,6 +11,7 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/display_list/dl_paint.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
@@ -1136,6 +1137,63 @@ TEST_F(DisplayListTest, OverlappingOpsDoNotSupportGroupOpacity) {
   EXPECT_FALSE(display_list->can_apply_group_opacity());
 }
 
+TEST_F(DisplayListTest, NonOverlappingOpsSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  for (int i = 0; i < 10; i++) {
+    receiver.drawRect(SkRect::MakeXYWH(i * 10, 0, 10, 10));
+  }
+  receiver.drawOval(SkRect::MakeXYWH(0, 20, 100, 10));
+  auto display_list = builder.Build();
+  EXPECT_TRUE(display_list->can_apply_group_opacity());
+}
+
+TEST_F(DisplayListTest, OpsOverlappingInDeviceSpaceDoNotSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.drawRect({0, 0, 10, 10});
+  receiver.save();
+  receiver.translate(20, 0);
+  receiver.drawRect({0, 0, 10, 10});
+  receiver.restore();
+  {
+    auto display_list = builder.Build();
+    EXPECT_TRUE(display_list->can_apply_group_opacity());
+  }
+
+  receiver.drawRect({0, 0, 10, 10});
+  receiver.save();
+  receiver.translate(5, 0);
+  receiver.drawRect({0, 0, 10, 10});
+  receiver.restore();
+  {
+    auto display_list = builder.Build();
+    EXPECT_FALSE(display_list->can_apply_group_opacity());
+  }
+}
+
+TEST_F(DisplayListTest, OpsAbuttingInsidePixelsDoNotSupportGroupOpacity) {
+  // The rects abut at 10.5 on the device, so both of them blend into the
+  // pixels at that column.
+  DisplayListBuilder builder;
+  builder.Scale(1.5, 1.5);
+  builder.DrawRect({0, 0, 7, 7}, DlPaint());
+  builder.DrawRect({7, 0, 14, 7}, DlPaint());
+  {
+    auto display_list = builder.Build();
+    EXPECT_FALSE(display_list->can_apply_group_opacity());
+  }
+
+  // Rects that abut on pixel boundaries don't share any pixels.
+  builder.Scale(2, 2);
+  builder.DrawRect({0, 0, 7, 7}, DlPaint());
+  builder.DrawRect({7, 0, 14, 7}, DlPaint());
+  {
+    auto display_list = builder.Build();
+    EXPECT_TRUE(display_list->can_apply_group_opacity());
+  }
+}
+
 TEST_F(DisplayListTest, SaveLayerFalseSupportsGroupOpacityOverlappingChidren) {
   DisplayListBuilder builder;
   DlOpReceiver& receiver = ToReceiver(builder);
@@ -1290,6 +1348,40 @@ TEST_F(DisplayListTest, SaveLayerTwoOverlappingOpsDoesNotInheritOpacity) {
   EXPECT_EQ(expector.save_layer_count(), 1);
 }
 
+TEST_F(DisplayListTest, SaveLayerOpsAbuttingInsidePixelsDoNotInheritOpacity) {
+  SaveLayerOptions expected = SaveLayerOptions::kWithAttributes;
+  SaveLayerOptionsExpector expector(expected);
+
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.setColor(SkColorSetARGB(127, 255, 255, 255));
+  receiver.saveLayer(nullptr, SaveLayerOptions::kWithAttributes);
+  receiver.scale(1.5, 1.5);
+  receiver.drawRect({0, 0, 7, 7});
+  receiver.drawRect({7, 0, 14, 7});
+  receiver.restore();
+
+  builder.Build()->Dispatch(expector);
+  EXPECT_EQ(expector.save_layer_count(), 1);
+}
+
+TEST_F(DisplayListTest, SaveLayerTwoSeparateOpsInheritOpacity) {
+  SaveLayerOptions expected =
+      SaveLayerOptions::kWithAttributes.with_can_distribute_opacity();
+  SaveLayerOptionsExpector expector(expected);
+
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.setColor(SkColorSetARGB(127, 255, 255, 255));
+  receiver.saveLayer(nullptr, SaveLayerOptions::kWithAttributes);
+  receiver.drawRect({10, 10, 20, 20});
+  receiver.drawImage(TestImage1, {30, 10}, kNearestSampling, false);
+  receiver.restore();
+
+  builder.Build()->Dispatch(expector);
+  EXPECT_EQ(expector.save_layer_count(), 1);
+}
+
 TEST_F(DisplayListTest, NestedSaveLayersMightInheritOpacity) {
   SaveLayerOptions expected1 =
       SaveLayerOptions::kWithAttributes.with_can_distribute_opacity();
@@ -3030,6 +3122,29 @@ TEST_F(DisplayListTest, DrawSaveDrawCannotInheritOpacity) {
   ASSERT_FALSE(display_list->can_apply_group_opacity());
 }
 
+TEST_F(DisplayListTest, BackdropFilterIsTrackedThroughNestedDisplayLists) {
+  auto filter = DlBlurImageFilter(5.0, 5.0, DlTileMode::kClamp);
+  DisplayListBuilder plain_builder;
+  plain_builder.SaveLayer(nullptr, nullptr);
+  plain_builder.DrawRect({5, 5, 15, 15}, DlPaint());
+  plain_builder.Restore();
+  auto plain = plain_builder.Build();
+  ASSERT_FALSE(plain->has_backdrop_filter());
+
+  DisplayListBuilder backdrop_builder;
+  backdrop_builder.SaveLayer(nullptr, nullptr, &filter);
+  backdrop_builder.DrawRect({5, 5, 15, 15}, DlPaint());
+  backdrop_builder.Restore();
+  auto backdrop = backdrop_builder.Build();
+  ASSERT_TRUE(backdrop->has_backdrop_filter());
+
+  DisplayListBuilder outer_builder;
+  outer_builder.DrawDisplayList(plain);
+  ASSERT_FALSE(outer_builder.Build()->has_backdrop_filter());
+  outer_builder.DrawDisplayList(backdrop);
+  ASSERT_TRUE(outer_builder.Build()->has_backdrop_filter());
+}
+
 TEST_F(DisplayListTest, DrawUnorderedRect) {
   auto renderer = [](DlCanvas& canvas, DlPaint& paint, SkRect& rect) {
     canvas.DrawRect(rect, paint);
@@ -3242,5 +3357,137 @@ TEST_F(DisplayListTest, NopOperationsOmittedFromRecords) {
             });
 }
 
+TEST_F(DisplayListTest, OverriddenAttributesOmittedFromRecords) {
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.setColor(DlColor::kRed());
+  receiver.setStrokeWidth(5.0f);
+  receiver.setColorSource(&kTestSource1);
+  receiver.setColor(DlColor::kBlue());
+  receiver.setColorSource(kTestSource2.get());
+  receiver.drawRect({10, 10, 20, 20});
+  receiver.setColor(DlColor::kGreen());
+  receiver.drawRect({20, 20, 30, 30});
+  auto list = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  DlOpReceiver& expected_receiver = ToReceiver(expected_builder);
+  expected_receiver.setStrokeWidth(5.0f);
+  expected_receiver.setColor(DlColor::kBlue());
+  expected_receiver.setColorSource(kTestSource2.get());
+  expected_receiver.drawRect({10, 10, 20, 20});
+  expected_receiver.setColor(DlColor::kGreen());
+  expected_receiver.drawRect({20, 20, 30, 30});
+  auto expected = expected_builder.Build();
+
+  EXPECT_EQ(list->bytes(), expected->bytes());
+  EXPECT_TRUE(DisplayListsEQ_Verbose(list, expected));
+}
+
+TEST_F(DisplayListTest, CulledDrawAttributesOmittedFromRecords) {
+  SkRect cull_rect = SkRect::MakeWH(100, 100);
+  DlPaint red_paint(DlColor::kRed());
+  DlPaint blue_paint(DlColor::kBlue());
+
+  DlPaint green_paint(DlColor::kGreen());
+
+  DisplayListBuilder builder(cull_rect);
+  builder.DrawRect({200, 200, 250, 250}, red_paint);
+  builder.DrawRect({10, 10, 50, 50}, blue_paint);
+  builder.Translate(500, 0);
+  builder.DrawRect({10, 10, 50, 50}, red_paint);
+  builder.Translate(-500, 0);
+  builder.DrawRect({50, 50, 90, 90}, green_paint);
+  auto list = builder.Build();
+
+  DisplayListBuilder expected_builder(cull_rect);
+  expected_builder.DrawRect({10, 10, 50, 50}, blue_paint);
+  expected_builder.Translate(500, 0);
+  expected_builder.Translate(-500, 0);
+  expected_builder.DrawRect({50, 50, 90, 90}, green_paint);
+  auto expected = expected_builder.Build();
+
+  EXPECT_EQ(list->op_count(), 2u);
+  EXPECT_EQ(list->bytes(), expected->bytes());
+  EXPECT_TRUE(DisplayListsEQ_Verbose(list, expected));
+}
+
+TEST_F(DisplayListTest, PartitionedDispatchDrawsEveryOpOnceInItsState) {
+  // Records where each rect lands and how many layers are opened.
+  class Receiver final : public IgnoreAttributeDispatchHelper,
+                         public IgnoreClipDispatchHelper,
+                         public IgnoreTransformDispatchHelper,
+                         public IgnoreDrawDispatchHelper {
+   public:
+    void translate(SkScalar tx, SkScalar ty) override { tx_ += tx; }
+    void save() override { saved_tx_.push_back(tx_); }
+    void saveLayer(const SkRect* bounds,
+                   const SaveLayerOptions options,
+                   const DlImageFilter* backdrop) override {
+      saved_tx_.push_back(tx_);
+      layer_count++;
+      rect_count_at_layer = rect_lefts.size();
+    }
+    void restore() override {
+      tx_ = saved_tx_.back();
+      saved_tx_.pop_back();
+    }
+    void drawRect(const SkRect& rect) override {
+      rect_lefts.push_back(rect.fLeft + tx_);
+    }
+
+    std::vector<SkScalar> rect_lefts;
+    int layer_count = 0;
+    size_t rect_count_at_layer = 0;
+
+   private:
+    SkScalar tx_ = 0;
+    std::vector<SkScalar> saved_tx_;
+  };
+
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlPaint paint;
+  for (int i = 0; i < 30; i++) {
+    if (i == 10) {
+      builder.SaveLayer(nullptr, nullptr);
+    }
+    builder.Translate(1, 0);
+    builder.DrawRect(SkRect::MakeXYWH(i * 10, 0, 5, 5), paint);
+    if (i == 19) {
+      builder.Restore();
+    }
+  }
+  auto display_list = builder.Build();
+
+  auto boundaries = display_list->GetDispatchPartitions(6);
+  ASSERT_GT(boundaries.size(), 2u);
+  EXPECT_EQ(boundaries.front(), 0);
+
+  std::vector<SkScalar> rect_lefts;
+  int layer_count = 0;
+  for (size_t i = 0; i + 1 < boundaries.size(); i++) {
+    EXPECT_LT(boundaries[i], boundaries[i + 1]);
+    Receiver receiver;
+    display_list->DispatchInline(receiver, boundaries[i], boundaries[i + 1],
+                                 DisplayListBuilder::kMaxCullRect);
+    if (receiver.layer_count > 0) {
+      // The layer isn't split, so all of its rects come after it opens.
+      EXPECT_EQ(receiver.rect_lefts.size(),
+                receiver.rect_count_at_layer + 10);
+    }
+    layer_count += receiver.layer_count;
+    rect_lefts.insert(rect_lefts.end(), receiver.rect_lefts.begin(),
+                      receiver.rect_lefts.end());
+  }
+
+  EXPECT_EQ(layer_count, 1);
+  ASSERT_EQ(rect_lefts.size(), 30u);
+  for (int i = 0; i < 30; i++) {
+    // The translations inside of the layer are undone when it is restored.
+    int translation = i < 20 ? i + 1 : i - 9;
+    EXPECT_EQ(rect_lefts[i], i * 10 + translation);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
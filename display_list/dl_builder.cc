@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/dl_builder.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_flags.h"
@@ -39,15 +41,93 @@ static constexpr inline bool is_power_of_two(int value) {
   return (value & (value - 1)) == 0;
 }
 
+// Attribute ops that set the same property share a group so that a later
+// op can replace an earlier one that was never rendered with.
+static constexpr int kUsesAttributes = -1;
+static constexpr int kIgnoresAttributes = -2;
+
+static constexpr int AttributeGroup(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSetAntiAlias:
+      return 0;
+    case DisplayListOpType::kSetDither:
+      return 1;
+    case DisplayListOpType::kSetInvertColors:
+      return 2;
+    case DisplayListOpType::kSetStrokeCap:
+      return 3;
+    case DisplayListOpType::kSetStrokeJoin:
+      return 4;
+    case DisplayListOpType::kSetStyle:
+      return 5;
+    case DisplayListOpType::kSetStrokeWidth:
+      return 6;
+    case DisplayListOpType::kSetStrokeMiter:
+      return 7;
+    case DisplayListOpType::kSetColor:
+      return 8;
+    case DisplayListOpType::kSetBlendMode:
+      return 9;
+    case DisplayListOpType::kSetPodPathEffect:
+    case DisplayListOpType::kClearPathEffect:
+      return 10;
+    case DisplayListOpType::kClearColorFilter:
+    case DisplayListOpType::kSetPodColorFilter:
+      return 11;
+    case DisplayListOpType::kClearColorSource:
+    case DisplayListOpType::kSetPodColorSource:
+    case DisplayListOpType::kSetImageColorSource:
+    case DisplayListOpType::kSetRuntimeEffectColorSource:
+#ifdef IMPELLER_ENABLE_3D
+    case DisplayListOpType::kSetSceneColorSource:
+#endif  // IMPELLER_ENABLE_3D
+      return 12;
+    case DisplayListOpType::kClearImageFilter:
+    case DisplayListOpType::kSetPodImageFilter:
+    case DisplayListOpType::kSetSharedImageFilter:
+      return 13;
+    case DisplayListOpType::kClearMaskFilter:
+    case DisplayListOpType::kSetPodMaskFilter:
+      return 14;
+    // Transforms and clips neither read the attributes nor have their
+    // index or offset recorded anywhere, so they can be moved as well.
+    case DisplayListOpType::kTranslate:
+    case DisplayListOpType::kScale:
+    case DisplayListOpType::kRotate:
+    case DisplayListOpType::kSkew:
+    case DisplayListOpType::kTransform2DAffine:
+    case DisplayListOpType::kTransformFullPerspective:
+    case DisplayListOpType::kTransformReset:
+    case DisplayListOpType::kClipIntersectRect:
+    case DisplayListOpType::kClipIntersectRRect:
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferenceRect:
+    case DisplayListOpType::kClipDifferenceRRect:
+    case DisplayListOpType::kClipDifferencePath:
+      return kIgnoresAttributes;
+    // Rendering ops use the attributes and save and restore ops have their
+    // offsets and indices recorded for the matching restore.
+    default:
+      return kUsesAttributes;
+  }
+}
+
 template <typename T, typename... Args>
 void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
+  constexpr int attribute_group = AttributeGroup(T::kType);
+  if (attribute_group >= 0) {
+    discardPendingAttribute(attribute_group);
+  }
   size_t size = SkAlignPtr(sizeof(T) + pod);
   FML_DCHECK(size < (1 << 24));
   if (used_ + size > allocated_) {
     static_assert(is_power_of_two(DL_BUILDER_PAGE),
                   "This math needs updating for non-pow2.");
+    // Grow geometrically so that the ops of a long recording are only
+    // copied a logarithmic number of times. |Build| trims the slack.
+    size_t needed = std::max(used_ + size, allocated_ * 2);
     // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
+    allocated_ = (needed + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
     storage_.realloc(allocated_);
     FML_DCHECK(storage_.get());
     memset(storage_.get() + used_, 0, allocated_ - used_);
@@ -60,9 +140,36 @@ void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
   op->size = size;
   render_op_count_ += render_op_inc;
   op_index_++;
+  if (attribute_group == kUsesAttributes) {
+    pending_attributes_offset_ = used_;
+  }
   return op + 1;
 }
 
+void DisplayListBuilder::discardPendingAttribute(int attribute_group) {
+  // The attribute ops recorded since the last op that uses them have not
+  // been used by anything yet, so an earlier value of the same attribute can
+  // be dropped. It is always the only one, since it would have dropped its
+  // own predecessor, and none of the ops that follow it have an index that
+  // was recorded anywhere, so they can be moved down to close the gap the
+  // same way that |storage_.realloc| moves every op.
+  uint8_t* ptr = storage_.get() + pending_attributes_offset_;
+  uint8_t* end = storage_.get() + used_;
+  while (ptr < end) {
+    auto op = reinterpret_cast<DLOp*>(ptr);
+    size_t size = op->size;
+    if (AttributeGroup(op->type) == attribute_group) {
+      DisplayList::DisposeOps(ptr, ptr + size);
+      memmove(ptr, ptr + size, end - (ptr + size));
+      memset(end - size, 0, size);
+      used_ -= size;
+      op_index_--;
+      return;
+    }
+    ptr += size;
+  }
+}
+
 sk_sp<DisplayList> DisplayListBuilder::Build() {
   while (layer_stack_.size() > 1) {
     restore();
@@ -75,10 +182,14 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   bool compatible = current_layer_->is_group_opacity_compatible();
   bool is_safe = is_ui_thread_safe_;
   bool affects_transparency = current_layer_->affects_transparent_layer();
+  bool has_backdrop = has_backdrop_filter_;
 
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
+  op_bounds_index_ = -1;
+  pending_attributes_offset_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
   is_ui_thread_safe_ = true;
+  has_backdrop_filter_ = false;
   storage_.realloc(bytes);
   layer_stack_.pop_back();
   layer_stack_.emplace_back();
@@ -87,7 +198,7 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
 
   return sk_sp<DisplayList>(new DisplayList(
       std::move(storage_), bytes, count, nested_bytes, nested_count, bounds(),
-      compatible, is_safe, affects_transparency, rtree()));
+      compatible, is_safe, affects_transparency, has_backdrop, rtree()));
 }
 
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
@@ -469,7 +580,7 @@ void DisplayListBuilder::Restore() {
       if (layer_info.cannot_inherit_opacity()) {
         current_layer_->mark_incompatible();
       } else if (layer_info.has_compatible_op()) {
-        current_layer_->add_compatible_op();
+        current_layer_->add_compatible_op(layer_info.compatible_op_bounds());
       }
     }
   }
@@ -511,11 +622,14 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
       [[maybe_unused]] bool unclipped = AccumulateUnbounded();
       FML_DCHECK(unclipped);
     }
-    CheckLayerOpacityCompatibility(true);
+    // The content of the layer is not known yet, so it is assumed to
+    // cover the whole clip.
+    UpdateLayerOpacityCompatibility(current_opacity_compatibility_,
+                                    tracker_.device_cull_rect());
     layer_stack_.emplace_back(save_layer_offset, true,
                               current_.getImageFilter());
   } else {
-    CheckLayerOpacityCompatibility(false);
+    UpdateLayerOpacityCompatibility(true, tracker_.device_cull_rect());
     layer_stack_.emplace_back(save_layer_offset, true, nullptr);
   }
   current_layer_ = &layer_stack_.back();
@@ -530,6 +644,7 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
     // when we tested the PaintResult.
     [[maybe_unused]] bool unclipped = AccumulateUnbounded();
     FML_DCHECK(unclipped);
+    has_backdrop_filter_ = true;
     bounds  //
         ? Push<SaveLayerBackdropBoundsOp>(0, 1, options, *bounds, backdrop)
         : Push<SaveLayerBackdropOp>(0, 1, options, backdrop);
@@ -1247,6 +1362,8 @@ void DisplayListBuilder::DrawDisplayList(const sk_sp<DisplayList> display_list,
   Push<DrawDisplayListOp>(0, 1, display_list,
                           opacity < SK_Scalar1 ? opacity : SK_Scalar1);
   is_ui_thread_safe_ = is_ui_thread_safe_ && display_list->isUIThreadSafe();
+  has_backdrop_filter_ =
+      has_backdrop_filter_ || display_list->has_backdrop_filter();
   // Not really necessary if the developer is interacting with us via
   // our attribute-state-less DlCanvas methods, but this avoids surprises
   // for those who may have been using the stateful Dispatcher methods.
@@ -1395,6 +1512,7 @@ bool DisplayListBuilder::AccumulateUnbounded() {
     return false;
   }
   accumulator()->accumulate(clip, op_index_);
+  RecordOpBounds(clip);
   return true;
 }
 
@@ -1411,6 +1529,7 @@ bool DisplayListBuilder::AccumulateBounds(SkRect& bounds) {
     tracker_.mapRect(&bounds);
     if (bounds.intersect(tracker_.device_cull_rect())) {
       accumulator()->accumulate(bounds, op_index_);
+      RecordOpBounds(bounds);
       return true;
     }
   }
@@ -240,7 +240,8 @@ class DisplayListBuilder final : public virtual DlCanvas,
   // This method exposes the internal stateful DlOpReceiver implementation
   // of the DisplayListBuilder, primarily for testing purposes. Its use
   // is obsolete and forbidden in every other case and is only shared to a
-  // pair of "friend" accessors in the benchmark/unittest files.
+  // pair of "friend" accessors in the benchmark/unittest files and to the
+  // reader of serialized records, which replays them as receiver calls.
   DlOpReceiver& asReceiver() { return *this; }
 
   friend DlOpReceiver& DisplayListBuilderBenchmarkAccessor(
@@ -249,6 +250,7 @@ class DisplayListBuilder final : public virtual DlCanvas,
       DisplayListBuilder& builder);
   friend DlPaint DisplayListBuilderTestingAttributes(
       DisplayListBuilder& builder);
+  friend class DlSerializedDisplayList;
 
   void SetAttributesFromPaint(const DlPaint& paint,
                               const DisplayListAttributeFlags flags);
@@ -486,16 +488,25 @@ class DisplayListBuilder final : public virtual DlCanvas,
   size_t allocated_ = 0;
   int render_op_count_ = 0;
   int op_index_ = 0;
+  // The offset of the ops that were recorded after the last rendering,
+  // save or restore op. Only attribute, transform and clip ops follow it.
+  size_t pending_attributes_offset_ = 0;
 
   // bytes and ops from |drawPicture| and |drawDisplayList|
   size_t nested_bytes_ = 0;
   int nested_op_count_ = 0;
 
   bool is_ui_thread_safe_ = true;
+  bool has_backdrop_filter_ = false;
 
   template <typename T, typename... Args>
   void* Push(size_t extra, int op_inc, Args&&... args);
 
+  // Removes a pending attribute op of the given group that is about to be
+  // overridden before any op could use it, such as the paint attributes of a
+  // draw call that was culled.
+  void discardPendingAttribute(int attribute_group);
+
   void intersect(const SkRect& rect);
 
   // kInvalidSigma is used to indicate that no MaskBlur is currently set.
@@ -535,21 +546,31 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
     void mark_incompatible() { cannot_inherit_opacity_ = true; }
 
-    // For now this only allows a single compatible op to mark the
-    // layer as being compatible with group opacity. If we start
-    // computing bounds of ops in the Builder methods then we
-    // can upgrade this to checking for overlapping ops.
+    // Compatible ops can only share a group opacity if no two of them
+    // overlap, so each op is tested against the union of the device
+    // |bounds| of the compatible ops before it. The union makes this a
+    // conservative test for ops that are not laid out in a row or column.
+    // The bounds are rounded out to the pixels they touch first, since ops
+    // that abut at a fractional coordinate both blend into the pixel there.
     // See https://github.com/flutter/flutter/issues/93899
-    void add_compatible_op() {
+    void add_compatible_op(const SkRect& bounds) {
       if (!cannot_inherit_opacity_) {
-        if (has_compatible_op_) {
+        SkRect pixel_bounds = SkRect::Make(bounds.roundOut());
+        if (has_compatible_op_ &&
+            SkRect::Intersects(compatible_op_bounds_, pixel_bounds)) {
           cannot_inherit_opacity_ = true;
         } else {
+          compatible_op_bounds_.join(pixel_bounds);
           has_compatible_op_ = true;
         }
       }
     }
 
+    // The device bounds of all of the compatible ops in this layer.
+    const SkRect& compatible_op_bounds() const {
+      return compatible_op_bounds_;
+    }
+
     // Records that the current layer contains an op that produces visible
     // output on a transparent surface.
     void add_visible_op() {
@@ -592,6 +613,7 @@ class DisplayListBuilder final : public virtual DlCanvas,
     bool has_layer_;
     bool cannot_inherit_opacity_ = false;
     bool has_compatible_op_ = false;
+    SkRect compatible_op_bounds_ = SkRect::MakeEmpty();
     std::shared_ptr<const DlImageFilter> filter_;
     bool is_unbounded_ = false;
     bool has_deferred_save_op_ = false;
@@ -628,16 +650,41 @@ class DisplayListBuilder final : public virtual DlCanvas,
         IsOpacityCompatible(current_.getBlendMode());
   }
 
+  // The device bounds accumulated for the op at |op_bounds_index_|, which
+  // are used to check whether it overlaps other ops in its layer.
+  int op_bounds_index_ = -1;
+  SkRect op_bounds_;
+
+  void RecordOpBounds(const SkRect& bounds) {
+    if (op_bounds_index_ == op_index_) {
+      op_bounds_.join(bounds);
+    } else {
+      op_bounds_index_ = op_index_;
+      op_bounds_ = bounds;
+    }
+  }
+
   // Update the opacity compatibility flags of the current layer for an op
-  // that has determined its compatibility as indicated by |compatible|.
-  void UpdateLayerOpacityCompatibility(bool compatible) {
+  // covering the device |bounds| that has determined its compatibility as
+  // indicated by |compatible|.
+  void UpdateLayerOpacityCompatibility(bool compatible, const SkRect& bounds) {
     if (compatible) {
-      current_layer_->add_compatible_op();
+      current_layer_->add_compatible_op(bounds);
     } else {
       current_layer_->mark_incompatible();
     }
   }
 
+  // Update the opacity compatibility flags of the current layer for the op
+  // that was just recorded. If no bounds were accumulated for the op, it is
+  // assumed to cover the whole clip.
+  void UpdateLayerOpacityCompatibility(bool compatible) {
+    UpdateLayerOpacityCompatibility(compatible,
+                                    op_bounds_index_ == op_index_ - 1
+                                        ? op_bounds_
+                                        : tracker_.device_cull_rect());
+  }
+
   // Check for opacity compatibility for an op that may or may not use the
   // current rendering attributes as indicated by |uses_blend_attribute|.
   // If the flag is false then the rendering op will be able to substitute
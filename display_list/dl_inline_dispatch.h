@@ -0,0 +1,203 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_INLINE_DISPATCH_H_
+#define FLUTTER_DISPLAY_LIST_DL_INLINE_DISPATCH_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+class DisplayList::NopCuller {
+ public:
+  bool init(DispatchState& context) {
+    // Setting next_render_index to 0 means that
+    // all rendering ops will be at or after that
+    // index so they will execute and all restore
+    // indices will be after it as well so all
+    // clip and transform operations will execute.
+    context.next_render_index = 0;
+    return true;
+  }
+  void update(DispatchState& context) {}
+};
+
+class DisplayList::VectorCuller {
+ public:
+  VectorCuller(const DlRTree* rtree, const std::vector<int>& rect_indices)
+      : rtree_(rtree), cur_(rect_indices.begin()), end_(rect_indices.end()) {}
+
+  bool init(DispatchState& context) {
+    if (cur_ < end_) {
+      context.next_render_index = rtree_->id(*cur_++);
+      return true;
+    } else {
+      // Setting next_render_index to MAX_INT means that
+      // all rendering ops will be "before" that index and
+      // they will skip themselves and all clip and transform
+      // ops will see that the next render index is not
+      // before the next restore index (even if both are MAX_INT)
+      // and so they will also not execute.
+      // None of this really matters because returning false
+      // here should cause the Dispatch operation to abort,
+      // but this value is conceptually correct if that short
+      // circuit optimization isn't used.
+      context.next_render_index = std::numeric_limits<int>::max();
+      return false;
+    }
+  }
+  void update(DispatchState& context) {
+    if (++context.cur_index > context.next_render_index) {
+      while (cur_ < end_) {
+        context.next_render_index = rtree_->id(*cur_++);
+        if (context.next_render_index >= context.cur_index) {
+          // It should be rare that we have duplicate indices
+          // but if we do, then having a while loop is a cheap
+          // insurance for those cases.
+          // The main cause of duplicate indices is when a
+          // DrawDisplayListOp was added to this DisplayList and
+          // both are computing an R-Tree, in which case the
+          // builder method will forward all of the child
+          // DisplayList's rects to this R-Tree with the same
+          // op_index.
+          return;
+        }
+      }
+      context.next_render_index = std::numeric_limits<int>::max();
+    }
+  }
+
+ private:
+  const DlRTree* rtree_;
+  std::vector<int>::const_iterator cur_;
+  std::vector<int>::const_iterator end_;
+};
+
+// Renders the ops in a range of indices, with every op before the range
+// treated as culled.
+class DisplayList::RangeCuller {
+ public:
+  RangeCuller(int start_index, int end_index)
+      : start_index_(start_index), end_index_(end_index) {}
+
+  bool init(DispatchState& context) {
+    context.next_render_index = start_index_;
+    return start_index_ < end_index_;
+  }
+  void update(DispatchState& context) {
+    if (++context.cur_index >= end_index_) {
+      // As with the VectorCuller, the ops after the range skip themselves
+      // but the restores of the saves that were needed still execute.
+      context.next_render_index = std::numeric_limits<int>::max();
+    }
+  }
+
+ private:
+  const int start_index_;
+  const int end_index_;
+};
+
+template <typename Receiver>
+void DisplayList::DispatchInline(Receiver& receiver) const {
+  uint8_t* ptr = storage_.get();
+  NopCuller culler;
+  DispatchOps(receiver, ptr, ptr + byte_count_, culler);
+}
+
+template <typename Receiver>
+void DisplayList::DispatchInline(Receiver& receiver,
+                                 const SkRect& cull_rect) const {
+  if (cull_rect.isEmpty()) {
+    return;
+  }
+  if (cull_rect.contains(bounds())) {
+    DispatchInline(receiver);
+    return;
+  }
+  const DlRTree* rtree = this->rtree().get();
+  FML_DCHECK(rtree != nullptr);
+  if (rtree == nullptr) {
+    FML_LOG(ERROR) << "dispatched with culling rect on DL with no rtree";
+    DispatchInline(receiver);
+    return;
+  }
+  uint8_t* ptr = storage_.get();
+  std::vector<int> rect_indices;
+  rtree->search(cull_rect, &rect_indices);
+  VectorCuller culler(rtree, rect_indices);
+  DispatchOps(receiver, ptr, ptr + byte_count_, culler);
+}
+
+template <typename Receiver>
+void DisplayList::DispatchInline(Receiver& receiver,
+                                 int start_index,
+                                 int end_index,
+                                 const SkRect& cull_rect) const {
+  if (cull_rect.isEmpty()) {
+    return;
+  }
+  uint8_t* ptr = storage_.get();
+  const DlRTree* rtree = this->rtree().get();
+  if (cull_rect.contains(bounds()) || rtree == nullptr) {
+    RangeCuller culler(start_index, end_index);
+    DispatchOps(receiver, ptr, ptr + byte_count_, culler);
+    return;
+  }
+  std::vector<int> rect_indices;
+  rtree->search(cull_rect, &rect_indices);
+  rect_indices.erase(
+      std::remove_if(rect_indices.begin(), rect_indices.end(),
+                     [rtree, start_index, end_index](int rect_index) {
+                       int id = rtree->id(rect_index);
+                       return id < start_index || id >= end_index;
+                     }),
+      rect_indices.end());
+  VectorCuller culler(rtree, rect_indices);
+  DispatchOps(receiver, ptr, ptr + byte_count_, culler);
+}
+
+template <typename Receiver, typename Culler>
+void DisplayList::DispatchOps(Receiver& receiver,
+                              uint8_t* ptr,
+                              uint8_t* end,
+                              Culler& culler) const {
+  DispatchContext<Receiver> context(receiver,
+                                    std::numeric_limits<int>::max());
+  if (!culler.init(context)) {
+    return;
+  }
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+    switch (op->type) {
+#define DL_OP_DISPATCH(name)                             \
+  case DisplayListOpType::k##name:                       \
+    static_cast<const name##Op*>(op)->dispatch(context); \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
+#ifdef IMPELLER_ENABLE_3D
+      DL_OP_DISPATCH(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_DISPATCH
+
+      default:
+        FML_DCHECK(false);
+        return;
+    }
+    culler.update(context);
+  }
+}
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_INLINE_DISPATCH_H_
@@ -37,9 +37,7 @@ namespace flutter {
 // Attribute ops always execute as they are too numerous and
 // cheap to deal with a complicated "lifetime" tracking to
 // determine if they will be used.
-struct DispatchContext {
-  DlOpReceiver& receiver;
-
+struct DispatchState {
   int cur_index;
   int next_render_index;
 
@@ -57,6 +55,20 @@ struct DispatchContext {
   std::vector<SaveInfo> save_infos;
 };
 
+// The receiver is typed so that ops dispatched to a receiver whose class
+// is known and final call its methods directly instead of through the
+// DlOpReceiver vtable. See |DisplayList::DispatchInline|.
+template <typename Receiver>
+struct DispatchContext : DispatchState {
+  DispatchContext(Receiver& receiver, int next_restore_index)
+      : DispatchState{.cur_index = 0,
+                      .next_render_index = 0,
+                      .next_restore_index = next_restore_index},
+        receiver(receiver) {}
+
+  Receiver& receiver;
+};
+
 // Most Ops can be bulk compared using memcmp because they contain
 // only numeric values or constructs that are constructed from numeric
 // values.
@@ -111,7 +123,8 @@ struct DLOp {
                                                              \
     const bool value;                                        \
                                                              \
-    void dispatch(DispatchContext& ctx) const {              \
+    template <typename Receiver>                             \
+    void dispatch(DispatchContext<Receiver>& ctx) const {    \
       ctx.receiver.set##name(value);                         \
     }                                                        \
   };
@@ -129,7 +142,8 @@ DEFINE_SET_BOOL_OP(InvertColors)
                                                                          \
     const DlStroke##name value;                                          \
                                                                          \
-    void dispatch(DispatchContext& ctx) const {                          \
+    template <typename Receiver>                                         \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                \
       ctx.receiver.setStroke##name(value);                               \
     }                                                                    \
   };
@@ -145,7 +159,8 @@ struct SetStyleOp final : DLOp {
 
   const DlDrawStyle style;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     ctx.receiver.setDrawStyle(style);
   }
 };
@@ -157,7 +172,8 @@ struct SetStrokeWidthOp final : DLOp {
 
   const float width;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     ctx.receiver.setStrokeWidth(width);
   }
 };
@@ -169,7 +185,8 @@ struct SetStrokeMiterOp final : DLOp {
 
   const float limit;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     ctx.receiver.setStrokeMiter(limit);
   }
 };
@@ -182,7 +199,10 @@ struct SetColorOp final : DLOp {
 
   const DlColor color;
 
-  void dispatch(DispatchContext& ctx) const { ctx.receiver.setColor(color); }
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
+    ctx.receiver.setColor(color);
+  }
 };
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 struct SetBlendModeOp final : DLOp {
@@ -192,7 +212,8 @@ struct SetBlendModeOp final : DLOp {
 
   const DlBlendMode mode;
 
-  void dispatch(DispatchContext& ctx) const {  //
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {  //
     ctx.receiver.setBlendMode(mode);
   }
 };
@@ -209,7 +230,8 @@ struct SetBlendModeOp final : DLOp {
                                                                             \
     Clear##name##Op() {}                                                    \
                                                                             \
-    void dispatch(DispatchContext& ctx) const {                             \
+    template <typename Receiver>                                            \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                   \
       ctx.receiver.set##name(nullptr);                                      \
     }                                                                       \
   };                                                                        \
@@ -218,7 +240,8 @@ struct SetBlendModeOp final : DLOp {
                                                                             \
     SetPod##name##Op() {}                                                   \
                                                                             \
-    void dispatch(DispatchContext& ctx) const {                             \
+    template <typename Receiver>                                            \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                   \
       const Dl##name* filter = reinterpret_cast<const Dl##name*>(this + 1); \
       ctx.receiver.set##name(filter);                                       \
     }                                                                       \
@@ -244,7 +267,8 @@ struct SetImageColorSourceOp : DLOp {
 
   const DlImageColorSource source;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     ctx.receiver.setColorSource(&source);
   }
 };
@@ -261,7 +285,8 @@ struct SetRuntimeEffectColorSourceOp : DLOp {
 
   const DlRuntimeEffectColorSource source;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     ctx.receiver.setColorSource(&source);
   }
 
@@ -280,7 +305,8 @@ struct SetSceneColorSourceOp : DLOp {
 
   const DlSceneColorSource source;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     ctx.receiver.setColorSource(&source);
   }
 
@@ -300,7 +326,8 @@ struct SetSharedImageFilterOp : DLOp {
 
   const std::shared_ptr<DlImageFilter> filter;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     ctx.receiver.setImageFilter(filter.get());
   }
 
@@ -324,7 +351,7 @@ struct SaveOpBase : DLOp {
   SaveLayerOptions options;
   int restore_index;
 
-  inline bool save_needed(DispatchContext& ctx) const {
+  inline bool save_needed(DispatchState& ctx) const {
     bool needed = ctx.next_render_index <= restore_index;
     ctx.save_infos.emplace_back(ctx.next_restore_index, needed);
     ctx.next_restore_index = restore_index;
@@ -337,7 +364,8 @@ struct SaveOp final : SaveOpBase {
 
   SaveOp() : SaveOpBase() {}
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (save_needed(ctx)) {
       ctx.receiver.save();
     }
@@ -349,7 +377,8 @@ struct SaveLayerOp final : SaveOpBase {
 
   explicit SaveLayerOp(const SaveLayerOptions options) : SaveOpBase(options) {}
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (save_needed(ctx)) {
       ctx.receiver.saveLayer(nullptr, options);
     }
@@ -364,7 +393,8 @@ struct SaveLayerBoundsOp final : SaveOpBase {
 
   const SkRect rect;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (save_needed(ctx)) {
       ctx.receiver.saveLayer(&rect, options);
     }
@@ -380,7 +410,8 @@ struct SaveLayerBackdropOp final : SaveOpBase {
 
   const std::shared_ptr<DlImageFilter> backdrop;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (save_needed(ctx)) {
       ctx.receiver.saveLayer(nullptr, options, backdrop.get());
     }
@@ -404,7 +435,8 @@ struct SaveLayerBackdropBoundsOp final : SaveOpBase {
   const SkRect rect;
   const std::shared_ptr<DlImageFilter> backdrop;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (save_needed(ctx)) {
       ctx.receiver.saveLayer(&rect, options, backdrop.get());
     }
@@ -423,8 +455,9 @@ struct RestoreOp final : DLOp {
 
   RestoreOp() {}
 
-  void dispatch(DispatchContext& ctx) const {
-    DispatchContext::SaveInfo& info = ctx.save_infos.back();
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
+    DispatchState::SaveInfo& info = ctx.save_infos.back();
     if (info.save_was_needed) {
       ctx.receiver.restore();
     }
@@ -434,7 +467,7 @@ struct RestoreOp final : DLOp {
 };
 
 struct TransformClipOpBase : DLOp {
-  inline bool op_needed(const DispatchContext& context) const {
+  inline bool op_needed(const DispatchState& context) const {
     return context.next_render_index <= context.next_restore_index;
   }
 };
@@ -448,7 +481,8 @@ struct TranslateOp final : TransformClipOpBase {
   const SkScalar tx;
   const SkScalar ty;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.translate(tx, ty);
     }
@@ -464,7 +498,8 @@ struct ScaleOp final : TransformClipOpBase {
   const SkScalar sx;
   const SkScalar sy;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.scale(sx, sy);
     }
@@ -478,7 +513,8 @@ struct RotateOp final : TransformClipOpBase {
 
   const SkScalar degrees;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.rotate(degrees);
     }
@@ -494,7 +530,8 @@ struct SkewOp final : TransformClipOpBase {
   const SkScalar sx;
   const SkScalar sy;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.skew(sx, sy);
     }
@@ -514,7 +551,8 @@ struct Transform2DAffineOp final : TransformClipOpBase {
   const SkScalar mxx, mxy, mxt;
   const SkScalar myx, myy, myt;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.transform2DAffine(mxx, mxy, mxt,  //
                                      myx, myy, myt);
@@ -543,7 +581,8 @@ struct TransformFullPerspectiveOp final : TransformClipOpBase {
   const SkScalar mzx, mzy, mzz, mzt;
   const SkScalar mwx, mwy, mwz, mwt;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.transformFullPerspective(mxx, mxy, mxz, mxt,  //
                                             myx, myy, myz, myt,  //
@@ -559,7 +598,8 @@ struct TransformResetOp final : TransformClipOpBase {
 
   TransformResetOp() = default;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.transformReset();
     }
@@ -586,7 +626,8 @@ struct TransformResetOp final : TransformClipOpBase {
     const bool is_aa;                                                      \
     const Sk##shapetype shape;                                             \
                                                                            \
-    void dispatch(DispatchContext& ctx) const {                            \
+    template <typename Receiver>                                           \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                  \
       if (op_needed(ctx)) {                                                \
         ctx.receiver.clip##shapetype(shape, DlCanvas::ClipOp::k##clipop,   \
                                      is_aa);                               \
@@ -609,7 +650,8 @@ DEFINE_CLIP_SHAPE_OP(RRect, Difference)
     const bool is_aa;                                                    \
     const SkPath path;                                                   \
                                                                          \
-    void dispatch(DispatchContext& ctx) const {                          \
+    template <typename Receiver>                                         \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                \
       if (op_needed(ctx)) {                                              \
         ctx.receiver.clipPath(path, DlCanvas::ClipOp::k##clipop, is_aa); \
       }                                                                  \
@@ -626,7 +668,7 @@ DEFINE_CLIP_PATH_OP(Difference)
 #undef DEFINE_CLIP_PATH_OP
 
 struct DrawOpBase : DLOp {
-  inline bool op_needed(const DispatchContext& ctx) const {
+  inline bool op_needed(const DispatchState& ctx) const {
     return ctx.cur_index >= ctx.next_render_index;
   }
 };
@@ -637,7 +679,8 @@ struct DrawPaintOp final : DrawOpBase {
 
   DrawPaintOp() {}
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.drawPaint();
     }
@@ -653,7 +696,8 @@ struct DrawColorOp final : DrawOpBase {
   const DlColor color;
   const DlBlendMode mode;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.drawColor(color, mode);
     }
@@ -673,7 +717,8 @@ struct DrawColorOp final : DrawOpBase {
                                                                           \
     const arg_type arg_name;                                              \
                                                                           \
-    void dispatch(DispatchContext& ctx) const {                           \
+    template <typename Receiver>                                          \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                 \
       if (op_needed(ctx)) {                                               \
         ctx.receiver.draw##op_name(arg_name);                             \
       }                                                                   \
@@ -693,7 +738,8 @@ struct DrawPathOp final : DrawOpBase {
 
   const SkPath path;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.drawPath(path);
     }
@@ -721,7 +767,8 @@ struct DrawPathOp final : DrawOpBase {
     const type1 name1;                                           \
     const type2 name2;                                           \
                                                                  \
-    void dispatch(DispatchContext& ctx) const {                  \
+    template <typename Receiver>                                 \
+    void dispatch(DispatchContext<Receiver>& ctx) const {        \
       if (op_needed(ctx)) {                                      \
         ctx.receiver.draw##op_name(name1, name2);                \
       }                                                          \
@@ -744,7 +791,8 @@ struct DrawArcOp final : DrawOpBase {
   const SkScalar sweep;
   const bool center;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.drawArc(bounds, start, sweep, center);
     }
@@ -765,7 +813,8 @@ struct DrawArcOp final : DrawOpBase {
                                                                          \
     const uint32_t count;                                                \
                                                                          \
-    void dispatch(DispatchContext& ctx) const {                          \
+    template <typename Receiver>                                         \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                \
       if (op_needed(ctx)) {                                              \
         const SkPoint* pts = reinterpret_cast<const SkPoint*>(this + 1); \
         ctx.receiver.drawPoints(DlCanvas::PointMode::mode, count, pts);  \
@@ -791,7 +840,8 @@ struct DrawVerticesOp final : DrawOpBase {
 
   const DlBlendMode mode;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       const DlVertices* vertices =
           reinterpret_cast<const DlVertices*>(this + 1);
@@ -815,7 +865,8 @@ struct DrawVerticesOp final : DrawOpBase {
     const DlImageSampling sampling;                                      \
     const sk_sp<DlImage> image;                                          \
                                                                          \
-    void dispatch(DispatchContext& ctx) const {                          \
+    template <typename Receiver>                                         \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                \
       if (op_needed(ctx)) {                                              \
         ctx.receiver.drawImage(image, point, sampling, with_attributes); \
       }                                                                  \
@@ -857,7 +908,8 @@ struct DrawImageRectOp final : DrawOpBase {
   const DlCanvas::SrcRectConstraint constraint;
   const sk_sp<DlImage> image;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.drawImageRect(image, src, dst, sampling,
                                  render_with_attributes, constraint);
@@ -890,7 +942,8 @@ struct DrawImageRectOp final : DrawOpBase {
     const DlFilterMode mode;                                               \
     const sk_sp<DlImage> image;                                            \
                                                                            \
-    void dispatch(DispatchContext& ctx) const {                            \
+    template <typename Receiver>                                           \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                  \
       if (op_needed(ctx)) {                                                \
         ctx.receiver.drawImageNine(image, center, dst, mode,               \
                                    render_with_attributes);                \
@@ -972,7 +1025,8 @@ struct DrawAtlasOp final : DrawAtlasBaseOp {
                         has_colors,
                         render_with_attributes) {}
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       const SkRSXform* xform = reinterpret_cast<const SkRSXform*>(this + 1);
       const SkRect* tex = reinterpret_cast<const SkRect*>(xform + count);
@@ -1017,7 +1071,8 @@ struct DrawAtlasCulledOp final : DrawAtlasBaseOp {
 
   const SkRect cull_rect;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       const SkRSXform* xform = reinterpret_cast<const SkRSXform*>(this + 1);
       const SkRect* tex = reinterpret_cast<const SkRect*>(xform + count);
@@ -1051,7 +1106,8 @@ struct DrawDisplayListOp final : DrawOpBase {
   SkScalar opacity;
   const sk_sp<DisplayList> display_list;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.drawDisplayList(display_list, opacity);
     }
@@ -1077,7 +1133,8 @@ struct DrawTextBlobOp final : DrawOpBase {
   const SkScalar y;
   const sk_sp<SkTextBlob> blob;
 
-  void dispatch(DispatchContext& ctx) const {
+  template <typename Receiver>
+  void dispatch(DispatchContext<Receiver>& ctx) const {
     if (op_needed(ctx)) {
       ctx.receiver.drawTextBlob(blob, x, y);
     }
@@ -1100,7 +1157,8 @@ struct DrawTextBlobOp final : DrawOpBase {
     const SkScalar dpr;                                                       \
     const SkPath path;                                                        \
                                                                               \
-    void dispatch(DispatchContext& ctx) const {                               \
+    template <typename Receiver>                                              \
+    void dispatch(DispatchContext<Receiver>& ctx) const {                     \
       if (op_needed(ctx)) {                                                   \
         ctx.receiver.drawShadow(path, color, elevation, transparent_occluder, \
                                 dpr);                                         \
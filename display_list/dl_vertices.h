@@ -228,6 +228,12 @@ class DlVertices {
     return static_cast<const uint16_t*>(pod(indices_offset_));
   }
 
+  /// Returns an ID that is shared by this object and the copies of it
+  /// that are recorded into display lists, and by no other vertices.
+  /// Renderers can use it to keep the conversion of the vertices across
+  /// the frames that draw them, as the data never changes once built.
+  uint32_t unique_id() const { return unique_id_; }
+
   bool operator==(DlVertices const& other) const;
 
   bool operator!=(DlVertices const& other) const { return !(*this == other); }
@@ -259,7 +265,10 @@ class DlVertices {
   // in the display list buffer.
   explicit DlVertices(const DlVertices* other);
 
+  static uint32_t next_unique_id();
+
   DlVertexMode mode_;
+  uint32_t unique_id_;
 
   int vertex_count_;
   size_t vertices_offset_;
@@ -6,6 +6,7 @@
 #include "flutter/display_list/dl_vertices.h"
 #include "flutter/display_list/testing/dl_test_equality.h"
 #include "flutter/display_list/utils/dl_comparable.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "gtest/gtest.h"
 
 namespace flutter {
@@ -977,5 +978,44 @@ TEST(DisplayListVertices, TestNotEquals) {
   }
 }
 
+TEST(DisplayListVertices, RecordedCopiesShareUniqueId) {
+  SkPoint coords[3] = {
+      SkPoint::Make(2, 3),
+      SkPoint::Make(5, 6),
+      SkPoint::Make(15, 20),
+  };
+  std::shared_ptr<const DlVertices> vertices1 = DlVertices::Make(
+      DlVertexMode::kTriangles, 3, coords, nullptr, nullptr);
+  std::shared_ptr<const DlVertices> vertices2 = DlVertices::Make(
+      DlVertexMode::kTriangles, 3, coords, nullptr, nullptr);
+  EXPECT_NE(vertices1->unique_id(), 0u);
+  EXPECT_NE(vertices1->unique_id(), vertices2->unique_id());
+
+  class Receiver final : public IgnoreAttributeDispatchHelper,
+                         public IgnoreClipDispatchHelper,
+                         public IgnoreTransformDispatchHelper,
+                         public IgnoreDrawDispatchHelper {
+   public:
+    void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+      unique_ids.push_back(vertices->unique_id());
+    }
+
+    std::vector<uint32_t> unique_ids;
+  };
+
+  Receiver receiver;
+  for (int i = 0; i < 2; i++) {
+    DisplayListBuilder builder;
+    builder.DrawVertices(vertices1, DlBlendMode::kSrcOver, DlPaint());
+    builder.DrawVertices(vertices2, DlBlendMode::kSrcOver, DlPaint());
+    builder.Build()->Dispatch(receiver);
+  }
+  EXPECT_EQ(receiver.unique_ids,
+            std::vector<uint32_t>({vertices1->unique_id(),
+                                   vertices2->unique_id(),
+                                   vertices1->unique_id(),
+                                   vertices2->unique_id()}));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -189,6 +189,57 @@ bool DlMatrixColorFilter::can_commute_with_opacity() const {
   return true;
 }
 
+bool DlMatrixColorFilter::can_compose_with_outer() const {
+  // The alpha must pass through unchanged, A' = A.
+  if (!(matrix_[15] == 0 && matrix_[16] == 0 && matrix_[17] == 0 &&
+        matrix_[18] == 1 && matrix_[19] == 0)) {
+    return false;
+  }
+  for (int row = 0; row < 3; row++) {
+    const float* m = matrix_ + row * 5;
+    // Without an offset, transparent black stays transparent black. With
+    // no negative coefficients and a sum of at most 1, each component stays
+    // within [0, 1] for all valid input colors, so the clamping that would
+    // happen between two filters never changes anything. The sums of common
+    // matrices, such as for luminance, are allowed to be off by a rounding
+    // error.
+    //
+    // The tests are written to fail for NaN values.
+    if (!(m[4] == 0)) {
+      return false;
+    }
+    float sum = 0;
+    for (int column = 0; column < 4; column++) {
+      if (!(m[column] >= 0)) {
+        return false;
+      }
+      sum += m[column];
+    }
+    if (!(sum <= 1 + SK_ScalarNearlyZero)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<DlColorFilter> DlMatrixColorFilter::compose_with_outer(
+    const DlMatrixColorFilter& outer) const {
+  FML_DCHECK(can_compose_with_outer());
+  // The filters are affine maps, so the product is computed as for 5x5
+  // matrices whose last row is [0 0 0 0 1].
+  float product[20];
+  for (int row = 0; row < 4; row++) {
+    for (int column = 0; column < 5; column++) {
+      float sum = column == 4 ? outer[row * 5 + 4] : 0;
+      for (int k = 0; k < 4; k++) {
+        sum += outer[row * 5 + k] * matrix_[k * 5 + column];
+      }
+      product[row * 5 + column] = sum;
+    }
+  }
+  return Make(product);
+}
+
 const std::shared_ptr<DlSrgbToLinearGammaColorFilter>
     DlSrgbToLinearGammaColorFilter::instance =
         std::make_shared<DlSrgbToLinearGammaColorFilter>();
@@ -129,6 +129,17 @@ class DlMatrixColorFilter final : public DlColorFilter {
   bool modifies_transparent_black() const override;
   bool can_commute_with_opacity() const override;
 
+  // Whether applying another matrix filter to the output of this filter
+  // gives the same result as applying the product of their matrices once.
+  // That holds when this filter preserves alpha, maps transparent black to
+  // transparent black, and never produces a color that would be clamped.
+  bool can_compose_with_outer() const;
+
+  // Returns a filter equivalent to applying this filter and then |outer|.
+  // Only valid if |can_compose_with_outer| is true.
+  std::shared_ptr<DlColorFilter> compose_with_outer(
+      const DlMatrixColorFilter& outer) const;
+
   std::shared_ptr<DlColorFilter> shared() const override {
     return std::make_shared<DlMatrixColorFilter>(this);
   }
@@ -121,6 +121,71 @@ TEST(DisplayListColorFilter, NopMatrixShouldNotCrash) {
   ASSERT_FALSE(filter.modifies_transparent_black());
 }
 
+TEST(DisplayListColorFilter, MatrixCanComposeWithOuter) {
+  float identity[20] = {
+      1, 0, 0, 0, 0,  //
+      0, 1, 0, 0, 0,  //
+      0, 0, 1, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+  ASSERT_TRUE(DlMatrixColorFilter(identity).can_compose_with_outer());
+
+  float grayscale[20] = {
+      0.25, 0.5, 0.25, 0, 0,  //
+      0.25, 0.5, 0.25, 0, 0,  //
+      0.25, 0.5, 0.25, 0, 0,  //
+      0,    0,   0,    1, 0,  //
+  };
+  ASSERT_TRUE(DlMatrixColorFilter(grayscale).can_compose_with_outer());
+
+  float matrix[20];
+  memcpy(matrix, identity, sizeof(matrix));
+  matrix[4] = 0.1;
+  ASSERT_FALSE(DlMatrixColorFilter(matrix).can_compose_with_outer())
+      << "Offset color";
+
+  memcpy(matrix, identity, sizeof(matrix));
+  matrix[1] = 0.5;
+  ASSERT_FALSE(DlMatrixColorFilter(matrix).can_compose_with_outer())
+      << "Color can be clamped";
+
+  memcpy(matrix, identity, sizeof(matrix));
+  matrix[1] = -0.5;
+  ASSERT_FALSE(DlMatrixColorFilter(matrix).can_compose_with_outer())
+      << "Color can be negative";
+
+  memcpy(matrix, identity, sizeof(matrix));
+  matrix[18] = 0.5;
+  ASSERT_FALSE(DlMatrixColorFilter(matrix).can_compose_with_outer())
+      << "Alpha changes";
+}
+
+TEST(DisplayListColorFilter, MatrixComposeWithOuter) {
+  float inner_matrix[20] = {
+      0.5, 0,   0,   0, 0,  //
+      0,   0.5, 0,   0, 0,  //
+      0,   0,   0.5, 0, 0,  //
+      0,   0,   0,   1, 0,  //
+  };
+  float outer_matrix[20] = {
+      0, 1, 0, 0, 0.1,  //
+      1, 0, 0, 0, 0,    //
+      0, 0, 1, 0, 0,    //
+      0, 0, 0, 1, 0,    //
+  };
+  float expected_matrix[20] = {
+      0,   0.5, 0,   0, 0.1,  //
+      0.5, 0,   0,   0, 0,    //
+      0,   0,   0.5, 0, 0,    //
+      0,   0,   0,   1, 0,    //
+  };
+  DlMatrixColorFilter inner(inner_matrix);
+  DlMatrixColorFilter outer(outer_matrix);
+  auto composed = inner.compose_with_outer(outer);
+  ASSERT_NE(composed, nullptr);
+  ASSERT_EQ(*composed, DlMatrixColorFilter(expected_matrix));
+}
+
 TEST(DisplayListColorFilter, SrgbToLinearConstructor) {
   DlSrgbToLinearGammaColorFilter filter;
 }
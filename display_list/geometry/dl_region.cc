@@ -166,11 +166,28 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
   const Span *begin2, *end2;
   b_buffer.getSpans(b_handle, begin2, end2);
 
-  size_t min_size = (end1 - begin1) + (end2 - begin2);
+  size_t size1 = end1 - begin1;
+  size_t size2 = end2 - begin2;
+  size_t min_size = size1 + size2;
   if (res.size() < min_size) {
     res.resize(min_size);
   }
 
+  // Damage from consecutive frames usually repeats the same spans, or adds
+  // spans to one side of the existing ones. Neither case needs a merge.
+  if (size1 == size2 && memcmp(begin1, begin2, size1 * sizeof(Span)) == 0) {
+    std::copy(begin1, end1, res.begin());
+    return size1;
+  }
+  if ((end1 - 1)->right < begin2->left) {
+    std::copy(begin2, end2, std::copy(begin1, end1, res.begin()));
+    return min_size;
+  }
+  if ((end2 - 1)->right < begin1->left) {
+    std::copy(begin1, end1, std::copy(begin2, end2, res.begin()));
+    return min_size;
+  }
+
   OrderedSpanAccumulator accumulator(res);
 
   while (true) {
@@ -222,6 +239,19 @@ size_t DlRegion::intersectLineSpans(std::vector<Span>& res,
     res.resize(min_size);
   }
 
+  // A single span covering all of the other line leaves that line unchanged,
+  // which is the common case of clipping damage to a layer's bounds.
+  if (end1 - begin1 == 1 && begin1->left <= begin2->left &&
+      begin1->right >= (end2 - 1)->right) {
+    std::copy(begin2, end2, res.begin());
+    return end2 - begin2;
+  }
+  if (end2 - begin2 == 1 && begin2->left <= begin1->left &&
+      begin2->right >= (end1 - 1)->right) {
+    std::copy(begin1, end1, res.begin());
+    return end1 - begin1;
+  }
+
   // Pointer to the next span to be written.
   Span* new_span = res.data();
 
@@ -570,41 +600,61 @@ std::vector<SkIRect> DlRegion::getRects(bool deband) const {
   }
 
   size_t rect_count = 0;
-  size_t previous_span_end = 0;
   for (const auto& line : lines_) {
     rect_count += span_buffer_.getChunkSize(line.chunk_handle);
   }
   rects.reserve(rect_count);
 
+  if (!deband) {
+    for (const auto& line : lines_) {
+      const Span *span_begin, *span_end;
+      span_buffer_.getSpans(line.chunk_handle, span_begin, span_end);
+      for (const auto* span = span_begin; span < span_end; ++span) {
+        rects.push_back({span->left, line.top, span->right, line.bottom});
+      }
+    }
+    return rects;
+  }
+
+  // Rectangles of the previous span line that may still be continued by the
+  // current one, ordered by their left edge. Rectangles are only appended to
+  // |rects| once they can no longer grow, so the result is ordered by the
+  // bottom edge first and the left edge second.
+  std::vector<SkIRect> open_rects;
+  std::vector<SkIRect> next_open_rects;
+  open_rects.reserve(rect_count);
+  next_open_rects.reserve(rect_count);
+  int32_t previous_bottom = std::numeric_limits<int32_t>::min();
+
   for (const auto& line : lines_) {
     const Span *span_begin, *span_end;
     span_buffer_.getSpans(line.chunk_handle, span_begin, span_end);
+    if (previous_bottom != line.top) {
+      rects.insert(rects.end(), open_rects.begin(), open_rects.end());
+      open_rects.clear();
+    }
+    // Both the open rectangles and the spans are sorted and don't overlap,
+    // so a single pass over both finds every vertical continuation.
+    auto open = open_rects.begin();
     for (const auto* span = span_begin; span < span_end; ++span) {
       SkIRect rect{span->left, line.top, span->right, line.bottom};
-      if (deband) {
-        auto iter = rects.begin() + previous_span_end;
-        // If there is rectangle previously in rects on which this one is a
-        // vertical continuation, remove the previous rectangle and expand
-        // this one vertically to cover the area.
-        while (iter != rects.begin()) {
-          --iter;
-          if (iter->bottom() < rect.top()) {
-            // Went all the way to previous span line.
-            break;
-          } else if (iter->left() == rect.left() &&
-                     iter->right() == rect.right()) {
-            FML_DCHECK(iter->bottom() == rect.top());
-            rect.fTop = iter->fTop;
-            rects.erase(iter);
-            --previous_span_end;
-            break;
-          }
-        }
+      while (open != open_rects.end() && open->left() < rect.left()) {
+        rects.push_back(*open++);
+      }
+      if (open != open_rects.end() && open->left() == rect.left() &&
+          open->right() == rect.right()) {
+        FML_DCHECK(open->bottom() == rect.top());
+        rect.fTop = open->fTop;
+        ++open;
       }
-      rects.push_back(rect);
+      next_open_rects.push_back(rect);
     }
-    previous_span_end = rects.size();
+    rects.insert(rects.end(), open, open_rects.end());
+    open_rects.clear();
+    std::swap(open_rects, next_open_rects);
+    previous_bottom = line.bottom;
   }
+  rects.insert(rects.end(), open_rects.begin(), open_rects.end());
   return rects;
 }
 
@@ -151,6 +151,26 @@ TEST(DisplayListRegion, Deband) {
   EXPECT_EQ(rects_without_deband, expected_without_deband);
 }
 
+TEST(DisplayListRegion, DebandAcrossLines) {
+  DlRegion region({
+      SkIRect::MakeXYWH(0, 0, 10, 30),
+      SkIRect::MakeXYWH(20, 0, 10, 10),
+      SkIRect::MakeXYWH(20, 20, 10, 10),
+      SkIRect::MakeXYWH(0, 40, 10, 10),
+  });
+
+  // Rectangles are ordered by the span line they end on. Lines that don't
+  // touch are never merged.
+  auto rects = region.getRects(true);
+  std::vector<SkIRect> expected{
+      SkIRect::MakeXYWH(20, 0, 10, 10),
+      SkIRect::MakeXYWH(0, 0, 10, 30),
+      SkIRect::MakeXYWH(20, 20, 10, 10),
+      SkIRect::MakeXYWH(0, 40, 10, 10),
+  };
+  EXPECT_EQ(rects, expected);
+}
+
 TEST(DisplayListRegion, Intersects1) {
   DlRegion region1({
       SkIRect::MakeXYWH(0, 0, 20, 20),
@@ -247,6 +267,26 @@ TEST(DisplayListRegion, Intersection3) {
   EXPECT_EQ(rects, expected);
 }
 
+TEST(DisplayListRegion, IntersectionWithCoveringSpan) {
+  DlRegion region1({
+      SkIRect::MakeXYWH(0, 0, 10, 10),
+      SkIRect::MakeXYWH(30, 0, 10, 10),
+  });
+  DlRegion region2({
+      SkIRect::MakeXYWH(-5, 0, 100, 5),
+      SkIRect::MakeXYWH(0, 5, 5, 10),
+  });
+
+  DlRegion i = DlRegion::MakeIntersection(region1, region2);
+  EXPECT_EQ(i.bounds(), SkIRect::MakeXYWH(0, 0, 40, 10));
+  std::vector<SkIRect> expected{
+      SkIRect::MakeXYWH(0, 0, 10, 5),
+      SkIRect::MakeXYWH(30, 0, 10, 5),
+      SkIRect::MakeXYWH(0, 5, 5, 5),
+  };
+  EXPECT_EQ(i.getRects(), expected);
+}
+
 TEST(DisplayListRegion, Union1) {
   DlRegion region1({
       SkIRect::MakeXYWH(0, 0, 20, 20),
@@ -305,6 +345,30 @@ TEST(DisplayListRegion, Union3) {
   EXPECT_EQ(rects, expected);
 }
 
+TEST(DisplayListRegion, UnionIdenticalAndDisjointLines) {
+  DlRegion region1({
+      SkIRect::MakeXYWH(0, 0, 10, 10),
+      SkIRect::MakeXYWH(30, 0, 10, 10),
+  });
+  DlRegion region2({
+      SkIRect::MakeXYWH(50, 0, 10, 10),
+      SkIRect::MakeXYWH(70, 0, 10, 10),
+  });
+
+  DlRegion same = DlRegion::MakeUnion(region1, region1);
+  EXPECT_EQ(same.bounds(), region1.bounds());
+  EXPECT_EQ(same.getRects(), region1.getRects());
+
+  std::vector<SkIRect> expected{
+      SkIRect::MakeXYWH(0, 0, 10, 10),
+      SkIRect::MakeXYWH(30, 0, 10, 10),
+      SkIRect::MakeXYWH(50, 0, 10, 10),
+      SkIRect::MakeXYWH(70, 0, 10, 10),
+  };
+  EXPECT_EQ(DlRegion::MakeUnion(region1, region2).getRects(), expected);
+  EXPECT_EQ(DlRegion::MakeUnion(region2, region1).getRects(), expected);
+}
+
 TEST(DisplayListRegion, UnionEmpty) {
   {
     DlRegion region1(std::vector<SkIRect>{});
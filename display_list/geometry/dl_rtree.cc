@@ -5,10 +5,33 @@
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "flutter/fml/logging.h"
 
 namespace flutter {
 
+namespace {
+
+// Rearranges [begin, end) so that every run of |run_size| elements holds
+// the same elements that a full sort would place there, without sorting
+// the elements within each run.
+template <typename Iterator>
+void PartitionIntoRuns(Iterator begin, Iterator end, size_t run_size) {
+  size_t count = end - begin;
+  if (count <= run_size) {
+    return;
+  }
+  size_t run_count = (count + run_size - 1) / run_size;
+  Iterator middle = begin + (run_count / 2) * run_size;
+  std::nth_element(begin, middle, end);
+  PartitionIntoRuns(begin, middle, run_size);
+  PartitionIntoRuns(middle, end, run_size);
+}
+
+}  // namespace
+
 DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
@@ -53,9 +76,10 @@ DlRTree::DlRTree(const SkRect rects[],
   for (int i = 0; i < N; i++) {
     if (!rects[i].isEmpty()) {
       if (ids == nullptr || p(id = ids[i])) {
-        Node& node = nodes_[leaf_index++];
+        Node& node = nodes_[leaf_index];
         node.bounds = rects[i];
-        node.id = id;
+        node.leaf.id = id;
+        node.leaf.index = leaf_index++;
       }
     }
   }
@@ -70,14 +94,21 @@ DlRTree::DlRTree(const SkRect rects[],
   // costing 17% performance in bulk loading the rects into the R-Tree:
   // https://github.com/google/skia/blob/12b6bd042f7cdffb9012c90c3b4885601fc7be95/src/core/SkRTree.cpp#L96
   //
-  // Given that this class will most often be used to track rendering
-  // operations that were drawn in an app that performs a type of
-  // "page layout" with rendering proceeding in a linear fashion from
-  // top to bottom (and left to right or right to left), the rectangles
-  // are likely nearly sorted when they are delivered to this constructor
-  // so leaving them in their original order should show similar results
-  // to what Skia found in their empirical browser tests.
+  // That holds for apps that perform a type of "page layout", where the
+  // rectangles arrive nearly sorted and consecutive rectangles already
+  // make compact families. Maps and charts instead draw layers or series
+  // that each span the whole picture, so families in insertion order
+  // span it as well and every query has to visit most of the tree.
+  //
+  // When |shouldPack| detects the latter, each generation of nodes is
+  // ordered with the Sort-Tile-Recursive algorithm before it is grouped:
+  // the nodes are split into vertical slices by their horizontal center
+  // and every slice is split into families by vertical center. Packing
+  // reorders the leaf nodes, which keep the index of their rectangle in
+  // the constructor arguments, and |search| restores that order in its
+  // results.
   // ---
+  packed_ = shouldPack();
 
   // Continually process the previous level (generation) of nodes,
   // combining them into a new generation of parent groups each grouping
@@ -86,6 +117,8 @@ DlRTree::DlRTree(const SkRect rects[],
   // Each generation will end up reduced by a factor of up to kMaxChildren
   // until there is just one node left, which is the root node of
   // the R-Tree.
+  std::vector<uint32_t> order;
+  std::vector<Node> generation;
   uint32_t gen_start = 0;
   gen_count = leaf_count;
   while (gen_count > 1) {
@@ -94,49 +127,102 @@ DlRTree::DlRTree(const SkRect rects[],
     uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
     FML_DCHECK(gen_end + family_count <= total_node_count);
 
-    // D here is similar to the variable in a Bresenham line algorithm where
-    // we want to slowly move |family_count| steps along the minor axis as
-    // we move |gen_count| steps along the major axis.
-    //
-    // Each inner loop increments D by family_count.
-    // The inner loop executes a total of gen_count times.
-    // Every time D exceeds 0 we subtract gen_count and move to a new parent.
-    // All told we will increment D by family_count a total of gen_count times.
-    // All told we will decrement D by gen_count a total of family_count times.
-    // This leaves D back at its starting value.
-    //
-    // We could bias/balance where the extra children are placed by varying
-    // the initial count of D from 0 to (1 - family_count), but we aren't
-    // looking at this process aesthetically so we just use 0 as an initial
-    // value. Using 0 provides a "greedy" allocation of the extra children.
-    // Bresenham also uses double the size of the steps we use here also to
-    // have better rounding of when the minor axis steps occur, but again we
-    // don't care about the distribution of the extra children.
-    int D = 0;
+    // A single family doesn't need to be packed. The children of the
+    // nodes in this generation are already in place, so the nodes can
+    // be reordered freely.
+    if (packed_ && family_count > 1) {
+      sortTileRecursive(gen_start, gen_count, order);
+      generation.assign(nodes_.begin() + gen_start, nodes_.begin() + gen_end);
+      for (uint32_t i = 0; i < gen_count; i++) {
+        nodes_[gen_start + i] = generation[order[i]];
+      }
+    }
 
     uint32_t sibling_index = gen_start;
-    uint32_t parent_index = gen_end;
-    Node* parent = nullptr;
-    while (sibling_index < gen_end) {
-      if ((D += family_count) > 0) {
-        D -= gen_count;
-        FML_DCHECK(parent_index < gen_end + family_count);
-        parent = &nodes_[parent_index++];
-        parent->bounds.setEmpty();
-        parent->child.index = sibling_index;
-        parent->child.count = 0;
+    for (uint32_t parent_index = gen_end;
+         parent_index < gen_end + family_count; parent_index++) {
+      Node& parent = nodes_[parent_index];
+      parent.bounds.setEmpty();
+      parent.child.index = sibling_index;
+      parent.child.count = std::min(gen_end - sibling_index,
+                                    static_cast<uint32_t>(kMaxChildren));
+      for (uint32_t i = 0; i < parent.child.count; i++) {
+        parent.bounds.join(nodes_[sibling_index++].bounds);
       }
-      FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
-      parent->child.count++;
     }
-    FML_DCHECK(D == 0);
     FML_DCHECK(sibling_index == gen_end);
-    FML_DCHECK(parent_index == gen_end + family_count);
     gen_start = gen_end;
     gen_count = family_count;
   }
   FML_DCHECK(gen_start + gen_count == total_node_count);
+
+  if (packed_) {
+    leaf_nodes_.resize(leaf_count);
+    for (int i = 0; i < leaf_count; i++) {
+      leaf_nodes_[nodes_[i].leaf.index] = i;
+    }
+  }
+}
+
+bool DlRTree::shouldPack() const {
+  if (leaf_count_ <= kMaxChildren) {
+    return false;
+  }
+  // At best the families tile the bounds of the tree, unless the leaves
+  // overlap so much that they cover more area than that themselves.
+  double leaf_area = 0.0;
+  double family_area = 0.0;
+  SkRect bounds = SkRect::MakeEmpty();
+  SkRect family_bounds = SkRect::MakeEmpty();
+  for (int i = 0; i < leaf_count_; i++) {
+    const SkRect& leaf = nodes_[i].bounds;
+    leaf_area += static_cast<double>(leaf.width()) * leaf.height();
+    bounds.join(leaf);
+    family_bounds.join(leaf);
+    if ((i + 1) % kMaxChildren == 0 || i + 1 == leaf_count_) {
+      family_area +=
+          static_cast<double>(family_bounds.width()) * family_bounds.height();
+      family_bounds.setEmpty();
+    }
+  }
+  double tiled_area = std::max(
+      static_cast<double>(bounds.width()) * bounds.height(), leaf_area);
+  return family_area > tiled_area * kPackingThreshold;
+}
+
+void DlRTree::sortTileRecursive(uint32_t start,
+                                uint32_t count,
+                                std::vector<uint32_t>& order) const {
+  // Partitioning the centers along with the node offsets keeps the
+  // comparisons in contiguous memory. Centers are kept at twice their
+  // value.
+  std::vector<std::pair<float, uint32_t>> keys(count);
+  for (uint32_t i = 0; i < count; i++) {
+    const SkRect& bounds = nodes_[start + i].bounds;
+    keys[i] = {bounds.fLeft + bounds.fRight, i};
+  }
+
+  uint32_t family_count = (count + kMaxChildren - 1u) / kMaxChildren;
+  uint32_t slice_count = std::ceil(std::sqrt(family_count));
+  uint32_t slice_size =
+      (family_count + slice_count - 1u) / slice_count * kMaxChildren;
+
+  // Only the membership of the slices and of the families within them
+  // matters, so neither needs to be fully sorted.
+  PartitionIntoRuns(keys.begin(), keys.end(), slice_size);
+  for (auto& key : keys) {
+    const SkRect& bounds = nodes_[start + key.second].bounds;
+    key.first = bounds.fTop + bounds.fBottom;
+  }
+  for (uint32_t slice = 0; slice < count; slice += slice_size) {
+    auto slice_end = keys.begin() + std::min(slice + slice_size, count);
+    PartitionIntoRuns(keys.begin() + slice, slice_end, kMaxChildren);
+  }
+
+  order.resize(count);
+  for (uint32_t i = 0; i < count; i++) {
+    order[i] = keys[i].second;
+  }
 }
 
 void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
@@ -149,13 +235,36 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
     return;
   }
   const Node& root = nodes_.back();
-  if (root.bounds.intersects(query)) {
-    if (nodes_.size() == 1) {
-      FML_DCHECK(leaf_count_ == 1);
-      // The root node is the only node and it is a leaf node
-      results->push_back(0);
+  if (!root.bounds.intersects(query)) {
+    return;
+  }
+  if (nodes_.size() == 1) {
+    FML_DCHECK(leaf_count_ == 1);
+    // The root node is the only node and it is a leaf node
+    results->push_back(0);
+    return;
+  }
+
+  size_t first_result = results->size();
+  search(root, query, results);
+
+  if (packed_) {
+    // Restore the order of the constructor arguments. Queries that hit a
+    // large part of the tree are cheaper to rebuild from a bitmap.
+    size_t hit_count = results->size() - first_result;
+    if (hit_count * 8 > static_cast<size_t>(leaf_count_)) {
+      std::vector<bool> hit_leaves(leaf_count_);
+      for (size_t i = first_result; i < results->size(); i++) {
+        hit_leaves[(*results)[i]] = true;
+      }
+      results->resize(first_result);
+      for (int i = 0; i < leaf_count_; i++) {
+        if (hit_leaves[i]) {
+          results->push_back(i);
+        }
+      }
     } else {
-      search(root, query, results);
+      std::sort(results->begin() + first_result, results->end());
     }
   }
 }
@@ -193,7 +302,7 @@ void DlRTree::search(const Node& parent,
     const Node& node = nodes_[i];
     if (node.bounds.intersects(query)) {
       if (i < leaf_count_) {
-        results->push_back(i);
+        results->push_back(node.leaf.index);
       } else {
         search(node, query, results);
       }
@@ -29,7 +29,12 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr int kMaxChildren = 11;
 
-  // Leaf nodes at start of vector have an ID,
+  // Leaves are packed spatially when the families they form in their
+  // original order cover this many times more area than tiles would.
+  static constexpr double kPackingThreshold = 4.0;
+
+  // Leaf nodes at start of vector have an ID and the index of their
+  // rectangle in the constructor arguments,
   // Internal nodes after that have child index and count.
   struct Node {
     SkRect bounds;
@@ -38,7 +43,10 @@ class DlRTree : public SkRefCnt {
         uint32_t index;
         uint32_t count;
       } child;
-      int id;
+      struct {
+        int id;
+        int index;
+      } leaf;
     };
   };
 
@@ -83,7 +91,7 @@ class DlRTree : public SkRefCnt {
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
     return (result_index >= 0 && result_index < leaf_count_)
-               ? nodes_[result_index].id
+               ? leafNode(result_index).leaf.id
                : invalid_id_;
   }
 
@@ -95,13 +103,14 @@ class DlRTree : public SkRefCnt {
   /// or an empty rect if the index is not a valid leaf node index.
   const SkRect& bounds(int result_index) const {
     return (result_index >= 0 && result_index < leaf_count_)
-               ? nodes_[result_index].bounds
+               ? leafNode(result_index).bounds
                : empty_;
   }
 
   /// Returns the bytes used by the object and all of its node data.
   size_t bytes_used() const {
-    return sizeof(DlRTree) + sizeof(Node) * nodes_.size();
+    return sizeof(DlRTree) + sizeof(Node) * nodes_.size() +
+           sizeof(uint32_t) * leaf_nodes_.size();
   }
 
   /// Returns the number of leaf nodes corresponding to non-empty
@@ -142,7 +151,31 @@ class DlRTree : public SkRefCnt {
               const SkRect& query,
               std::vector<int>* results) const;
 
+  // Whether the leaves group so poorly in the order of the constructor
+  // arguments that they are worth packing spatially. Packing repeats a
+  // partial sort for every generation of the tree, which is wasted on
+  // rectangles that arrive in layout order.
+  bool shouldPack() const;
+
+  // Orders the |count| nodes that start at |start| with the
+  // Sort-Tile-Recursive algorithm so that every run of |kMaxChildren|
+  // nodes covers a compact tile. The new order is stored in |order| as
+  // offsets from |start|.
+  void sortTileRecursive(uint32_t start,
+                         uint32_t count,
+                         std::vector<uint32_t>& order) const;
+
+  // The leaf node of the rectangle at |index| in the constructor
+  // arguments.
+  const Node& leafNode(int index) const {
+    return nodes_[packed_ ? leaf_nodes_[index] : index];
+  }
+
   std::vector<Node> nodes_;
+  // Whether packing reordered the leaf nodes, in which case
+  // |leaf_nodes_| maps the rectangles passed to the constructor to them.
+  bool packed_ = false;
+  std::vector<uint32_t> leaf_nodes_;
   int leaf_count_;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
@@ -122,6 +122,48 @@ TEST(DisplayListRTree, HugeSize) {
   }
 }
 
+TEST(DisplayListRTree, ScatteredRects) {
+  // A 100x100 grid of 10x10 rectangles spaced 20 pixels apart, added
+  // in a scattered order so that the tree needs to pack them.
+  const int ROWS = 100;
+  const int COLS = 100;
+  const int N = ROWS * COLS;
+  std::vector<SkRect> rects(N);
+  std::vector<int> ids(N);
+  for (int i = 0; i < N; i++) {
+    int cell = (i * 7919) % N;
+    rects[i].setXYWH((cell % COLS) * 20, (cell / COLS) * 20, 10, 10);
+    ids[i] = i + 42;
+  }
+  DlRTree tree(rects.data(), N, ids.data());
+  EXPECT_EQ(tree.leaf_count(), N);
+  EXPECT_EQ(tree.bounds(), SkRect::MakeLTRB(0, 0, COLS * 20 - 10,
+                                            ROWS * 20 - 10));
+
+  std::vector<int> results;
+  for (int row = 0; row < ROWS; row += 7) {
+    for (int col = 0; col < COLS; col += 13) {
+      auto desc =
+          "row " + std::to_string(row) + ", col " + std::to_string(col);
+      SkRect query = SkRect::MakeXYWH(col * 20 + 5, row * 20 + 5, 50, 30);
+      results.clear();
+      tree.search(query, &results);
+      std::vector<int> expected;
+      for (int i = 0; i < N; i++) {
+        if (rects[i].intersects(query)) {
+          expected.push_back(i);
+        }
+      }
+      // Results are in the order of the constructor arguments.
+      EXPECT_EQ(results, expected) << desc;
+      for (int index : results) {
+        EXPECT_EQ(tree.id(index), ids[index]) << desc;
+        EXPECT_EQ(tree.bounds(index), rects[index]) << desc;
+      }
+    }
+  }
+}
+
 TEST(DisplayListRTree, Grid) {
   // Non-overlapping 10 x 10 rectangles starting at 5, 5 with
   // 10 pixels between them.
@@ -14,7 +14,9 @@
 #include "third_party/skia/include/core/SkRefCnt.h"
 
 namespace impeller {
+class FilterContents;
 class Texture;
+struct SamplerDescriptor;
 }  // namespace impeller
 
 namespace flutter {
@@ -54,6 +56,22 @@ class DlImage : public SkRefCnt {
   ///
   virtual std::shared_ptr<impeller::Texture> impeller_texture() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      If this display list image is an Impeller image made of
+  ///             separate planes, like the frames of a video, a new filter
+  ///             that samples those planes with `sampler` while it is drawn.
+  ///             Null otherwise.
+  ///
+  ///             Drawing the filter avoids the conversion of the planes into
+  ///             the texture returned by |impeller_texture|.
+  ///
+  /// @return     An Impeller filter instance or null.
+  ///
+  virtual std::shared_ptr<impeller::FilterContents> impeller_planar_filter(
+      const impeller::SamplerDescriptor& sampler) const {
+    return nullptr;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      If the pixel format of this image ignores alpha, this returns
   ///             true. This method might conservatively return false when it
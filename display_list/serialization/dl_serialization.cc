@@ -0,0 +1,1538 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/serialization/dl_serialization.h"
+
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// "DLSF" in memory.
+constexpr uint32_t kMagic = 0x46534c44;
+
+// Display lists nested deeper than this are rejected by the reader.
+constexpr int kMaxNestingDepth = 64;
+
+// The values are part of the format and must not change. New records get
+// new values.
+enum class SerializedOp : uint32_t {
+  kSetAntiAlias = 1,
+  kSetDither = 2,
+  kSetInvertColors = 3,
+  kSetStrokeCap = 4,
+  kSetStrokeJoin = 5,
+  kSetDrawStyle = 6,
+  kSetStrokeWidth = 7,
+  kSetStrokeMiter = 8,
+  kSetColor = 9,
+  kSetBlendMode = 10,
+  kSetColorSource = 11,
+  kSetColorFilter = 12,
+  kSetImageFilter = 13,
+  kSetPathEffect = 14,
+  kSetMaskFilter = 15,
+
+  kSave = 16,
+  kSaveLayer = 17,
+  kRestore = 18,
+
+  kTranslate = 19,
+  kScale = 20,
+  kRotate = 21,
+  kSkew = 22,
+  kTransform2DAffine = 23,
+  kTransformFullPerspective = 24,
+  kTransformReset = 25,
+
+  kClipRect = 26,
+  kClipRRect = 27,
+  kClipPath = 28,
+
+  kDrawColor = 29,
+  kDrawPaint = 30,
+  kDrawLine = 31,
+  kDrawRect = 32,
+  kDrawOval = 33,
+  kDrawCircle = 34,
+  kDrawRRect = 35,
+  kDrawDRRect = 36,
+  kDrawPath = 37,
+  kDrawArc = 38,
+  kDrawPoints = 39,
+  kDrawVertices = 40,
+  kDrawImage = 41,
+  kDrawImageRect = 42,
+  kDrawImageNine = 43,
+  kDrawAtlas = 44,
+  kDrawDisplayList = 45,
+  kDrawTextBlob = 46,
+  kDrawShadow = 47,
+};
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  SkRect bounds;
+  uint32_t records_size;
+  uint32_t reserved;
+};
+
+struct RecordHeader {
+  SerializedOp op;
+  // The size of the record including this header.
+  uint32_t size;
+};
+
+// Every record is made of 4 byte values so that records packed one after
+// the other stay aligned.
+
+// Booleans and enums.
+struct ValueRecord {
+  uint32_t value;
+};
+
+struct ScalarRecord {
+  float value;
+};
+
+// The index of an object in the resource tables, or -1 for nullptr.
+struct ResourceRecord {
+  int32_t index;
+};
+
+struct PairRecord {
+  float x;
+  float y;
+};
+
+struct Transform2DAffineRecord {
+  float mxx, mxy, mxt;
+  float myx, myy, myt;
+};
+
+struct TransformFullPerspectiveRecord {
+  float mxx, mxy, mxz, mxt;
+  float myx, myy, myz, myt;
+  float mzx, mzy, mzz, mzt;
+  float mwx, mwy, mwz, mwt;
+};
+
+struct RRectRecord {
+  SkRect rect;
+  SkVector radii[4];
+
+  static RRectRecord Make(const SkRRect& rrect) {
+    return {
+        rrect.rect(),
+        {
+            rrect.radii(SkRRect::kUpperLeft_Corner),
+            rrect.radii(SkRRect::kUpperRight_Corner),
+            rrect.radii(SkRRect::kLowerRight_Corner),
+            rrect.radii(SkRRect::kLowerLeft_Corner),
+        },
+    };
+  }
+
+  SkRRect rrect() const {
+    SkRRect rrect;
+    rrect.setRectRadii(rect, radii);
+    return rrect;
+  }
+};
+
+struct SaveLayerRecord {
+  uint32_t has_bounds;
+  SkRect bounds;
+  uint32_t renders_with_attributes;
+  uint32_t can_distribute_opacity;
+  int32_t backdrop;
+};
+
+struct ClipRectRecord {
+  SkRect rect;
+  uint32_t clip_op;
+  uint32_t is_aa;
+};
+
+struct ClipRRectRecord {
+  RRectRecord rrect;
+  uint32_t clip_op;
+  uint32_t is_aa;
+};
+
+struct ClipPathRecord {
+  int32_t path;
+  uint32_t clip_op;
+  uint32_t is_aa;
+};
+
+struct DrawColorRecord {
+  uint32_t color;
+  uint32_t mode;
+};
+
+struct DrawLineRecord {
+  SkPoint p0;
+  SkPoint p1;
+};
+
+struct RectRecord {
+  SkRect rect;
+};
+
+struct DrawCircleRecord {
+  SkPoint center;
+  float radius;
+};
+
+struct DrawDRRectRecord {
+  RRectRecord outer;
+  RRectRecord inner;
+};
+
+struct DrawArcRecord {
+  SkRect oval_bounds;
+  float start_degrees;
+  float sweep_degrees;
+  uint32_t use_center;
+};
+
+// Followed by |count| points.
+struct DrawPointsRecord {
+  uint32_t mode;
+  uint32_t count;
+};
+
+// Followed by the vertices, the texture coordinates and colors if there
+// are any, then the indices.
+struct DrawVerticesRecord {
+  uint32_t blend_mode;
+  uint32_t vertex_mode;
+  uint32_t vertex_count;
+  uint32_t index_count;
+  uint32_t has_texture_coordinates;
+  uint32_t has_colors;
+};
+
+struct DrawImageRecord {
+  int32_t image;
+  SkPoint point;
+  uint32_t sampling;
+  uint32_t render_with_attributes;
+};
+
+struct DrawImageRectRecord {
+  int32_t image;
+  SkRect src;
+  SkRect dst;
+  uint32_t sampling;
+  uint32_t render_with_attributes;
+  uint32_t constraint;
+};
+
+struct DrawImageNineRecord {
+  int32_t image;
+  SkIRect center;
+  SkRect dst;
+  uint32_t filter;
+  uint32_t render_with_attributes;
+};
+
+// Followed by |count| transforms, |count| texture rects and, if there are
+// any, |count| colors.
+struct DrawAtlasRecord {
+  int32_t atlas;
+  uint32_t count;
+  uint32_t mode;
+  uint32_t sampling;
+  uint32_t has_cull_rect;
+  SkRect cull_rect;
+  uint32_t render_with_attributes;
+  uint32_t has_colors;
+};
+
+// Followed by the header and records of the nested display list.
+struct DrawDisplayListRecord {
+  float opacity;
+};
+
+struct DrawTextBlobRecord {
+  int32_t blob;
+  float x;
+  float y;
+};
+
+struct DrawShadowRecord {
+  int32_t path;
+  uint32_t color;
+  float elevation;
+  uint32_t transparent_occluder;
+  float dpr;
+};
+
+constexpr size_t Align4(size_t size) {
+  return (size + 3) & ~static_cast<size_t>(3);
+}
+
+template <typename T>
+const T& RecordAt(const uint8_t* payload) {
+  static_assert(alignof(T) <= 4);
+  return *reinterpret_cast<const T*>(payload);
+}
+
+class SerializingReceiver final : public virtual DlOpReceiver {
+ public:
+  explicit SerializingReceiver(DlSerializationResources& resources)
+      : resources_(resources) {}
+
+  void WriteHeader(const SkRect& bounds) {
+    Header header = {
+        .magic = kMagic,
+        .version = DlSerializer::kVersion,
+        .bounds = bounds,
+    };
+    Write(&header, sizeof(header));
+  }
+
+  void Serialize(const DisplayList& display_list) {
+    size_t header_offset = buffer_.size();
+    WriteHeader(display_list.bounds());
+    display_list.Dispatch(*this);
+    uint32_t records_size = buffer_.size() - header_offset - sizeof(Header);
+    memcpy(buffer_.data() + header_offset + offsetof(Header, records_size),
+           &records_size, sizeof(records_size));
+  }
+
+  std::vector<uint8_t> TakeBuffer() { return std::move(buffer_); }
+
+  void setAntiAlias(bool aa) override {
+    Push(SerializedOp::kSetAntiAlias, ValueRecord{aa});
+  }
+  void setDither(bool dither) override {
+    Push(SerializedOp::kSetDither, ValueRecord{dither});
+  }
+  void setInvertColors(bool invert) override {
+    Push(SerializedOp::kSetInvertColors, ValueRecord{invert});
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    Push(SerializedOp::kSetStrokeCap,
+         ValueRecord{static_cast<uint32_t>(cap)});
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    Push(SerializedOp::kSetStrokeJoin,
+         ValueRecord{static_cast<uint32_t>(join)});
+  }
+  void setDrawStyle(DlDrawStyle style) override {
+    Push(SerializedOp::kSetDrawStyle,
+         ValueRecord{static_cast<uint32_t>(style)});
+  }
+  void setStrokeWidth(float width) override {
+    Push(SerializedOp::kSetStrokeWidth, ScalarRecord{width});
+  }
+  void setStrokeMiter(float limit) override {
+    Push(SerializedOp::kSetStrokeMiter, ScalarRecord{limit});
+  }
+  void setColor(DlColor color) override {
+    Push(SerializedOp::kSetColor, ValueRecord{color.argb});
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    Push(SerializedOp::kSetBlendMode,
+         ValueRecord{static_cast<uint32_t>(mode)});
+  }
+  void setColorSource(const DlColorSource* source) override {
+    Push(SerializedOp::kSetColorSource,
+         ResourceRecord{AddShared(resources_.color_sources, source)});
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    Push(SerializedOp::kSetColorFilter,
+         ResourceRecord{AddShared(resources_.color_filters, filter)});
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    Push(SerializedOp::kSetImageFilter,
+         ResourceRecord{AddShared(resources_.image_filters, filter)});
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    Push(SerializedOp::kSetPathEffect,
+         ResourceRecord{AddShared(resources_.path_effects, effect)});
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    Push(SerializedOp::kSetMaskFilter,
+         ResourceRecord{AddShared(resources_.mask_filters, filter)});
+  }
+
+  void save() override { Push(SerializedOp::kSave); }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    Push(SerializedOp::kSaveLayer,
+         SaveLayerRecord{
+             .has_bounds = bounds != nullptr,
+             .bounds = bounds ? *bounds : SkRect::MakeEmpty(),
+             .renders_with_attributes = options.renders_with_attributes(),
+             .can_distribute_opacity = options.can_distribute_opacity(),
+             .backdrop = AddShared(resources_.image_filters, backdrop),
+         });
+  }
+  void restore() override { Push(SerializedOp::kRestore); }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    Push(SerializedOp::kTranslate, PairRecord{tx, ty});
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    Push(SerializedOp::kScale, PairRecord{sx, sy});
+  }
+  void rotate(SkScalar degrees) override {
+    Push(SerializedOp::kRotate, ScalarRecord{degrees});
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    Push(SerializedOp::kSkew, PairRecord{sx, sy});
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    Push(SerializedOp::kTransform2DAffine,
+         Transform2DAffineRecord{mxx, mxy, mxt,
+                                 myx, myy, myt});
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    Push(SerializedOp::kTransformFullPerspective,
+         TransformFullPerspectiveRecord{mxx, mxy, mxz, mxt,
+                                        myx, myy, myz, myt,
+                                        mzx, mzy, mzz, mzt,
+                                        mwx, mwy, mwz, mwt});
+  }
+  // clang-format on
+  void transformReset() override { Push(SerializedOp::kTransformReset); }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    Push(SerializedOp::kClipRect,
+         ClipRectRecord{rect, static_cast<uint32_t>(clip_op), is_aa});
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    Push(SerializedOp::kClipRRect,
+         ClipRRectRecord{RRectRecord::Make(rrect),
+                         static_cast<uint32_t>(clip_op), is_aa});
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    Push(SerializedOp::kClipPath,
+         ClipPathRecord{AddPath(path), static_cast<uint32_t>(clip_op), is_aa});
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    Push(SerializedOp::kDrawColor,
+         DrawColorRecord{color.argb, static_cast<uint32_t>(mode)});
+  }
+  void drawPaint() override { Push(SerializedOp::kDrawPaint); }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    Push(SerializedOp::kDrawLine, DrawLineRecord{p0, p1});
+  }
+  void drawRect(const SkRect& rect) override {
+    Push(SerializedOp::kDrawRect, RectRecord{rect});
+  }
+  void drawOval(const SkRect& bounds) override {
+    Push(SerializedOp::kDrawOval, RectRecord{bounds});
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    Push(SerializedOp::kDrawCircle, DrawCircleRecord{center, radius});
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    Push(SerializedOp::kDrawRRect, RRectRecord::Make(rrect));
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    Push(SerializedOp::kDrawDRRect,
+         DrawDRRectRecord{RRectRecord::Make(outer), RRectRecord::Make(inner)});
+  }
+  void drawPath(const SkPath& path) override {
+    Push(SerializedOp::kDrawPath, ResourceRecord{AddPath(path)});
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    Push(SerializedOp::kDrawArc,
+         DrawArcRecord{oval_bounds, start_degrees, sweep_degrees, use_center});
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    uint8_t* data =
+        Push(SerializedOp::kDrawPoints,
+             DrawPointsRecord{static_cast<uint32_t>(mode), count},
+             count * sizeof(SkPoint));
+    memcpy(data, points, count * sizeof(SkPoint));
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    size_t vertex_count = vertices->vertex_count();
+    size_t index_count = vertices->index_count();
+    bool has_texture_coordinates = vertices->texture_coordinates() != nullptr;
+    bool has_colors = vertices->colors() != nullptr;
+    size_t points_size = vertex_count * sizeof(SkPoint);
+    size_t colors_size = has_colors ? vertex_count * sizeof(DlColor) : 0;
+    size_t extra_size = points_size * (has_texture_coordinates ? 2 : 1) +
+                        colors_size + index_count * sizeof(uint16_t);
+    uint8_t* data = Push(SerializedOp::kDrawVertices,
+                         DrawVerticesRecord{
+                             static_cast<uint32_t>(mode),
+                             static_cast<uint32_t>(vertices->mode()),
+                             static_cast<uint32_t>(vertex_count),
+                             static_cast<uint32_t>(index_count),
+                             has_texture_coordinates,
+                             has_colors,
+                         },
+                         extra_size);
+    memcpy(data, vertices->vertices(), points_size);
+    data += points_size;
+    if (has_texture_coordinates) {
+      memcpy(data, vertices->texture_coordinates(), points_size);
+      data += points_size;
+    }
+    if (has_colors) {
+      memcpy(data, vertices->colors(), colors_size);
+      data += colors_size;
+    }
+    if (index_count > 0) {
+      memcpy(data, vertices->indices(), index_count * sizeof(uint16_t));
+    }
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    Push(SerializedOp::kDrawImage,
+         DrawImageRecord{AddImage(image), point,
+                         static_cast<uint32_t>(sampling),
+                         render_with_attributes});
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    Push(SerializedOp::kDrawImageRect,
+         DrawImageRectRecord{AddImage(image), src, dst,
+                             static_cast<uint32_t>(sampling),
+                             render_with_attributes,
+                             static_cast<uint32_t>(constraint)});
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    Push(SerializedOp::kDrawImageNine,
+         DrawImageNineRecord{AddImage(image), center, dst,
+                             static_cast<uint32_t>(filter),
+                             render_with_attributes});
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    size_t xforms_size = count * sizeof(SkRSXform);
+    size_t tex_size = count * sizeof(SkRect);
+    size_t colors_size = colors ? count * sizeof(DlColor) : 0;
+    uint8_t* data =
+        Push(SerializedOp::kDrawAtlas,
+             DrawAtlasRecord{
+                 .atlas = AddImage(atlas),
+                 .count = static_cast<uint32_t>(count),
+                 .mode = static_cast<uint32_t>(mode),
+                 .sampling = static_cast<uint32_t>(sampling),
+                 .has_cull_rect = cull_rect != nullptr,
+                 .cull_rect = cull_rect ? *cull_rect : SkRect::MakeEmpty(),
+                 .render_with_attributes = render_with_attributes,
+                 .has_colors = colors != nullptr,
+             },
+             xforms_size + tex_size + colors_size);
+    memcpy(data, xform, xforms_size);
+    memcpy(data + xforms_size, tex, tex_size);
+    if (colors) {
+      memcpy(data + xforms_size + tex_size, colors, colors_size);
+    }
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    size_t record_offset = buffer_.size();
+    Push(SerializedOp::kDrawDisplayList, DrawDisplayListRecord{opacity});
+    Serialize(*display_list);
+    uint32_t record_size = buffer_.size() - record_offset;
+    memcpy(buffer_.data() + record_offset + offsetof(RecordHeader, size),
+           &record_size, sizeof(record_size));
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    Push(SerializedOp::kDrawTextBlob,
+         DrawTextBlobRecord{AddTextBlob(blob), x, y});
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    Push(SerializedOp::kDrawShadow,
+         DrawShadowRecord{AddPath(path), color.argb, elevation,
+                          transparent_occluder, dpr});
+  }
+
+ private:
+  DlSerializationResources& resources_;
+  std::vector<uint8_t> buffer_;
+  std::unordered_map<const DlImage*, int32_t> image_indices_;
+  std::unordered_map<const SkTextBlob*, int32_t> text_blob_indices_;
+
+  void Write(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+  }
+
+  // Appends a record with room for |extra_size| more bytes after it, and
+  // returns a pointer to that room. The pointer is only valid until the
+  // next record is pushed.
+  template <typename T>
+  uint8_t* Push(SerializedOp op, const T& record, size_t extra_size = 0) {
+    static_assert(sizeof(T) % 4 == 0);
+    return Push(op, &record, sizeof(T), extra_size);
+  }
+
+  void Push(SerializedOp op) { Push(op, nullptr, 0, 0); }
+
+  uint8_t* Push(SerializedOp op,
+                const void* record,
+                size_t record_size,
+                size_t extra_size) {
+    size_t size = sizeof(RecordHeader) + record_size + Align4(extra_size);
+    FML_CHECK(size <= std::numeric_limits<uint32_t>::max());
+    RecordHeader header = {op, static_cast<uint32_t>(size)};
+    size_t offset = buffer_.size();
+    buffer_.resize(offset + size);
+    memcpy(buffer_.data() + offset, &header, sizeof(header));
+    if (record_size > 0) {
+      memcpy(buffer_.data() + offset + sizeof(header), record, record_size);
+    }
+    return buffer_.data() + offset + sizeof(header) + record_size;
+  }
+
+  template <typename T, typename S>
+  static int32_t AddShared(std::vector<std::shared_ptr<const T>>& table,
+                           const S* object) {
+    if (!object) {
+      return -1;
+    }
+    table.push_back(object->shared());
+    return table.size() - 1;
+  }
+
+  int32_t AddPath(const SkPath& path) {
+    resources_.paths.push_back(path);
+    return resources_.paths.size() - 1;
+  }
+
+  int32_t AddImage(const sk_sp<DlImage>& image) {
+    auto result = image_indices_.emplace(image.get(), resources_.images.size());
+    if (result.second) {
+      resources_.images.push_back(image);
+    }
+    return result.first->second;
+  }
+
+  int32_t AddTextBlob(const sk_sp<SkTextBlob>& blob) {
+    auto result =
+        text_blob_indices_.emplace(blob.get(), resources_.text_blobs.size());
+    if (result.second) {
+      resources_.text_blobs.push_back(blob);
+    }
+    return result.first->second;
+  }
+};
+
+// Every record is checked before dispatching any of them, so the values
+// here can be assumed to be valid.
+class RecordValidator {
+ public:
+  RecordValidator(const DlSerializationResources& resources,
+                  const uint8_t* payload,
+                  size_t payload_size)
+      : resources_(resources), payload_(payload), payload_size_(payload_size) {}
+
+  template <typename T>
+  const T* Record(size_t extra_size = 0) {
+    if (payload_size_ != sizeof(T) + Align4(extra_size)) {
+      return nullptr;
+    }
+    return &RecordAt<T>(payload_);
+  }
+
+  // For the records that are followed by arrays, whose size depends on the
+  // record itself.
+  template <typename T>
+  const T* RecordPrefix() {
+    if (payload_size_ < sizeof(T)) {
+      return nullptr;
+    }
+    return &RecordAt<T>(payload_);
+  }
+
+  bool IsEmpty() const { return payload_size_ == 0; }
+
+  const uint8_t* extra() const { return payload_; }
+
+  static bool IsBool(uint32_t value) { return value <= 1; }
+
+  bool IsImage(int32_t index) const {
+    return index >= 0 &&
+           static_cast<size_t>(index) < resources_.images.size() &&
+           resources_.images[index] != nullptr;
+  }
+
+  bool IsTextBlob(int32_t index) const {
+    return index >= 0 &&
+           static_cast<size_t>(index) < resources_.text_blobs.size() &&
+           resources_.text_blobs[index] != nullptr;
+  }
+
+  bool IsPath(int32_t index) const {
+    return index >= 0 && static_cast<size_t>(index) < resources_.paths.size();
+  }
+
+  // Indices of -1 stand for nullptr.
+  template <typename T>
+  static bool IsResource(const std::vector<T>& table, int32_t index) {
+    return index == -1 ||
+           (index >= 0 && static_cast<size_t>(index) < table.size() &&
+            table[index] != nullptr);
+  }
+
+ private:
+  const DlSerializationResources& resources_;
+  const uint8_t* payload_;
+  size_t payload_size_;
+};
+
+template <typename T>
+const T* ResourceAt(const std::vector<std::shared_ptr<const T>>& table,
+                    int32_t index) {
+  return index < 0 ? nullptr : table[index].get();
+}
+
+// 64-bit FNV-1a, which unlike std::hash is the same in every process.
+class StableHasher {
+ public:
+  void Add(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ = (hash_ ^ bytes[i]) * 0x100000001b3;
+    }
+  }
+
+  template <typename T>
+  void Add(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    Add(&value, sizeof(T));
+  }
+
+  void Add(const SkMatrix& matrix) {
+    SkScalar values[9];
+    matrix.get9(values);
+    Add(values, sizeof(values));
+  }
+
+  void Add(const SkPath& path) {
+    std::vector<uint8_t> data(path.writeToMemory(nullptr));
+    path.writeToMemory(data.data());
+    Add(static_cast<uint64_t>(data.size()));
+    Add(data.data(), data.size());
+  }
+
+  bool Add(const DlColorSource* source) {
+    if (!source) {
+      Add(-1);
+      return true;
+    }
+    Add(static_cast<int>(source->type()));
+    if (const DlColorColorSource* color = source->asColor()) {
+      Add(color->color().argb);
+      return true;
+    }
+    if (!source->isGradient()) {
+      return false;
+    }
+    const auto* gradient =
+        static_cast<const DlGradientColorSourceBase*>(source);
+    Add(gradient->tile_mode());
+    Add(gradient->matrix());
+    Add(gradient->stop_count());
+    Add(gradient->colors(), gradient->stop_count() * sizeof(DlColor));
+    Add(gradient->stops(), gradient->stop_count() * sizeof(float));
+    if (const auto* linear = source->asLinearGradient()) {
+      Add(linear->start_point());
+      Add(linear->end_point());
+    } else if (const auto* radial = source->asRadialGradient()) {
+      Add(radial->center());
+      Add(radial->radius());
+    } else if (const auto* conical = source->asConicalGradient()) {
+      Add(conical->start_center());
+      Add(conical->start_radius());
+      Add(conical->end_center());
+      Add(conical->end_radius());
+    } else if (const auto* sweep = source->asSweepGradient()) {
+      Add(sweep->center());
+      Add(sweep->start());
+      Add(sweep->end());
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  void Add(const DlColorFilter* filter) {
+    if (!filter) {
+      Add(-1);
+      return;
+    }
+    Add(static_cast<int>(filter->type()));
+    if (const DlBlendColorFilter* blend = filter->asBlend()) {
+      Add(blend->color().argb);
+      Add(blend->mode());
+    } else if (const DlMatrixColorFilter* matrix = filter->asMatrix()) {
+      float values[20];
+      matrix->get_matrix(values);
+      Add(values, sizeof(values));
+    }
+    // The gamma conversion filters have no parameters.
+  }
+
+  void Add(const DlMaskFilter* filter) {
+    if (!filter) {
+      Add(-1);
+      return;
+    }
+    const DlBlurMaskFilter* blur = filter->asBlur();
+    FML_DCHECK(blur);
+    Add(blur->style());
+    Add(blur->sigma());
+    Add(blur->respectCTM());
+  }
+
+  uint64_t hash() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 0xcbf29ce484222325;
+};
+
+}  // namespace
+
+std::unique_ptr<fml::Mapping> DlSerializer::Serialize(
+    const DisplayList& display_list,
+    DlSerializationResources& resources) {
+  SerializingReceiver receiver(resources);
+  receiver.Serialize(display_list);
+  return std::make_unique<fml::DataMapping>(receiver.TakeBuffer());
+}
+
+std::optional<uint64_t> DlSerializer::ComputeStableHash(
+    const DisplayList& display_list) {
+  DlSerializationResources resources;
+  auto records = Serialize(display_list, resources);
+  if (!resources.images.empty() || !resources.text_blobs.empty() ||
+      !resources.image_filters.empty() || !resources.path_effects.empty()) {
+    return std::nullopt;
+  }
+
+  // The records only refer to the resources by index, so the hash takes in
+  // their contents in the same order.
+  StableHasher hasher;
+  hasher.Add(records->GetMapping(), records->GetSize());
+  for (const SkPath& path : resources.paths) {
+    hasher.Add(path);
+  }
+  for (const auto& source : resources.color_sources) {
+    if (!hasher.Add(source.get())) {
+      return std::nullopt;
+    }
+  }
+  for (const auto& filter : resources.color_filters) {
+    hasher.Add(filter.get());
+  }
+  for (const auto& filter : resources.mask_filters) {
+    hasher.Add(filter.get());
+  }
+  return hasher.hash();
+}
+
+DlSerializedDisplayList::DlSerializedDisplayList(
+    std::shared_ptr<const fml::Mapping> mapping,
+    std::shared_ptr<const DlSerializationResources> resources,
+    const uint8_t* records,
+    size_t records_size,
+    const SkRect& bounds)
+    : mapping_(std::move(mapping)),
+      resources_(std::move(resources)),
+      records_(records),
+      records_size_(records_size),
+      bounds_(bounds) {}
+
+DlSerializedDisplayList::~DlSerializedDisplayList() = default;
+
+std::unique_ptr<DlSerializedDisplayList> DlSerializedDisplayList::Make(
+    std::shared_ptr<const fml::Mapping> mapping,
+    std::shared_ptr<const DlSerializationResources> resources) {
+  if (!mapping || !mapping->GetMapping() || !resources) {
+    return nullptr;
+  }
+  return Make(mapping, resources, mapping->GetMapping(), mapping->GetSize(),
+              0);
+}
+
+std::unique_ptr<DlSerializedDisplayList> DlSerializedDisplayList::Make(
+    const std::shared_ptr<const fml::Mapping>& mapping,
+    const std::shared_ptr<const DlSerializationResources>& resources,
+    const uint8_t* data,
+    size_t size,
+    int depth) {
+  if ((reinterpret_cast<uintptr_t>(data) & 3) != 0) {
+    FML_LOG(ERROR) << "Serialized DisplayList is not 4 byte aligned.";
+    return nullptr;
+  }
+  if (size < sizeof(Header)) {
+    FML_LOG(ERROR) << "Serialized DisplayList is too small.";
+    return nullptr;
+  }
+  const Header& header = RecordAt<Header>(data);
+  if (header.magic != kMagic) {
+    FML_LOG(ERROR) << "Not a serialized DisplayList.";
+    return nullptr;
+  }
+  if (header.version != DlSerializer::kVersion) {
+    FML_LOG(ERROR) << "Serialized DisplayList version " << header.version
+                   << " is not supported.";
+    return nullptr;
+  }
+  if (header.records_size != size - sizeof(Header)) {
+    FML_LOG(ERROR) << "Serialized DisplayList size does not match.";
+    return nullptr;
+  }
+  std::unique_ptr<DlSerializedDisplayList> display_list(
+      new DlSerializedDisplayList(mapping, resources, data + sizeof(Header),
+                                  header.records_size, header.bounds));
+  if (!display_list->ValidateRecords(depth)) {
+    return nullptr;
+  }
+  return display_list;
+}
+
+bool DlSerializedDisplayList::ValidateRecords(int depth) {
+  const DlSerializationResources& resources = *resources_;
+  const uint8_t* ptr = records_;
+  const uint8_t* end = records_ + records_size_;
+  while (ptr < end) {
+    if (static_cast<size_t>(end - ptr) < sizeof(RecordHeader)) {
+      FML_LOG(ERROR) << "Truncated serialized DisplayList record.";
+      return false;
+    }
+    const RecordHeader& header = RecordAt<RecordHeader>(ptr);
+    if (header.size < sizeof(RecordHeader) || (header.size & 3) != 0 ||
+        header.size > static_cast<size_t>(end - ptr)) {
+      FML_LOG(ERROR) << "Invalid serialized DisplayList record size.";
+      return false;
+    }
+    RecordValidator validator(resources, ptr + sizeof(RecordHeader),
+                              header.size - sizeof(RecordHeader));
+    bool valid = false;
+    switch (header.op) {
+      case SerializedOp::kSetAntiAlias:
+      case SerializedOp::kSetDither:
+      case SerializedOp::kSetInvertColors: {
+        auto record = validator.Record<ValueRecord>();
+        valid = record && RecordValidator::IsBool(record->value);
+        break;
+      }
+      case SerializedOp::kSetStrokeCap: {
+        auto record = validator.Record<ValueRecord>();
+        valid = record && record->value <= static_cast<uint32_t>(
+                                               DlStrokeCap::kLastCap);
+        break;
+      }
+      case SerializedOp::kSetStrokeJoin: {
+        auto record = validator.Record<ValueRecord>();
+        valid = record && record->value <= static_cast<uint32_t>(
+                                               DlStrokeJoin::kLastJoin);
+        break;
+      }
+      case SerializedOp::kSetDrawStyle: {
+        auto record = validator.Record<ValueRecord>();
+        valid = record && record->value <= static_cast<uint32_t>(
+                                               DlDrawStyle::kLastStyle);
+        break;
+      }
+      case SerializedOp::kSetStrokeWidth:
+      case SerializedOp::kSetStrokeMiter:
+      case SerializedOp::kRotate:
+        valid = validator.Record<ScalarRecord>() != nullptr;
+        break;
+      case SerializedOp::kSetColor:
+        valid = validator.Record<ValueRecord>() != nullptr;
+        break;
+      case SerializedOp::kSetBlendMode: {
+        auto record = validator.Record<ValueRecord>();
+        valid = record && record->value <= static_cast<uint32_t>(
+                                               DlBlendMode::kLastMode);
+        break;
+      }
+      case SerializedOp::kSetColorSource: {
+        auto record = validator.Record<ResourceRecord>();
+        valid = record && RecordValidator::IsResource(resources.color_sources,
+                                                      record->index);
+        break;
+      }
+      case SerializedOp::kSetColorFilter: {
+        auto record = validator.Record<ResourceRecord>();
+        valid = record && RecordValidator::IsResource(resources.color_filters,
+                                                      record->index);
+        break;
+      }
+      case SerializedOp::kSetImageFilter: {
+        auto record = validator.Record<ResourceRecord>();
+        valid = record && RecordValidator::IsResource(resources.image_filters,
+                                                      record->index);
+        break;
+      }
+      case SerializedOp::kSetPathEffect: {
+        auto record = validator.Record<ResourceRecord>();
+        valid = record && RecordValidator::IsResource(resources.path_effects,
+                                                      record->index);
+        break;
+      }
+      case SerializedOp::kSetMaskFilter: {
+        auto record = validator.Record<ResourceRecord>();
+        valid = record && RecordValidator::IsResource(resources.mask_filters,
+                                                      record->index);
+        break;
+      }
+      case SerializedOp::kSave:
+      case SerializedOp::kRestore:
+      case SerializedOp::kTransformReset:
+      case SerializedOp::kDrawPaint:
+        valid = validator.IsEmpty();
+        break;
+      case SerializedOp::kSaveLayer: {
+        auto record = validator.Record<SaveLayerRecord>();
+        valid = record && RecordValidator::IsBool(record->has_bounds) &&
+                RecordValidator::IsBool(record->renders_with_attributes) &&
+                RecordValidator::IsBool(record->can_distribute_opacity) &&
+                RecordValidator::IsResource(resources.image_filters,
+                                            record->backdrop);
+        break;
+      }
+      case SerializedOp::kTranslate:
+      case SerializedOp::kScale:
+      case SerializedOp::kSkew:
+        valid = validator.Record<PairRecord>() != nullptr;
+        break;
+      case SerializedOp::kTransform2DAffine:
+        valid = validator.Record<Transform2DAffineRecord>() != nullptr;
+        break;
+      case SerializedOp::kTransformFullPerspective:
+        valid = validator.Record<TransformFullPerspectiveRecord>() != nullptr;
+        break;
+      case SerializedOp::kClipRect: {
+        auto record = validator.Record<ClipRectRecord>();
+        valid = record && RecordValidator::IsBool(record->clip_op) &&
+                RecordValidator::IsBool(record->is_aa);
+        break;
+      }
+      case SerializedOp::kClipRRect: {
+        auto record = validator.Record<ClipRRectRecord>();
+        valid = record && RecordValidator::IsBool(record->clip_op) &&
+                RecordValidator::IsBool(record->is_aa);
+        break;
+      }
+      case SerializedOp::kClipPath: {
+        auto record = validator.Record<ClipPathRecord>();
+        valid = record && validator.IsPath(record->path) &&
+                RecordValidator::IsBool(record->clip_op) &&
+                RecordValidator::IsBool(record->is_aa);
+        break;
+      }
+      case SerializedOp::kDrawColor: {
+        auto record = validator.Record<DrawColorRecord>();
+        valid = record &&
+                record->mode <= static_cast<uint32_t>(DlBlendMode::kLastMode);
+        break;
+      }
+      case SerializedOp::kDrawLine:
+        valid = validator.Record<DrawLineRecord>() != nullptr;
+        break;
+      case SerializedOp::kDrawRect:
+      case SerializedOp::kDrawOval:
+        valid = validator.Record<RectRecord>() != nullptr;
+        break;
+      case SerializedOp::kDrawCircle:
+        valid = validator.Record<DrawCircleRecord>() != nullptr;
+        break;
+      case SerializedOp::kDrawRRect:
+        valid = validator.Record<RRectRecord>() != nullptr;
+        break;
+      case SerializedOp::kDrawDRRect:
+        valid = validator.Record<DrawDRRectRecord>() != nullptr;
+        break;
+      case SerializedOp::kDrawPath: {
+        auto record = validator.Record<ResourceRecord>();
+        valid = record && validator.IsPath(record->index);
+        break;
+      }
+      case SerializedOp::kDrawArc: {
+        auto record = validator.Record<DrawArcRecord>();
+        valid = record && RecordValidator::IsBool(record->use_center);
+        break;
+      }
+      case SerializedOp::kDrawPoints: {
+        auto prefix = validator.RecordPrefix<DrawPointsRecord>();
+        if (!prefix || prefix->mode > static_cast<uint32_t>(
+                                          DlCanvas::PointMode::kPolygon) ||
+            prefix->count > DlOpReceiver::kMaxDrawPointsCount) {
+          break;
+        }
+        valid = validator.Record<DrawPointsRecord>(prefix->count *
+                                                   sizeof(SkPoint)) != nullptr;
+        break;
+      }
+      case SerializedOp::kDrawVertices: {
+        auto prefix = validator.RecordPrefix<DrawVerticesRecord>();
+        if (!prefix ||
+            prefix->blend_mode >
+                static_cast<uint32_t>(DlBlendMode::kLastMode) ||
+            prefix->vertex_mode >
+                static_cast<uint32_t>(DlVertexMode::kTriangleFan) ||
+            !RecordValidator::IsBool(prefix->has_texture_coordinates) ||
+            !RecordValidator::IsBool(prefix->has_colors) ||
+            prefix->vertex_count > std::numeric_limits<int32_t>::max() /
+                                       (2 * sizeof(SkPoint)) ||
+            prefix->index_count > std::numeric_limits<int32_t>::max() /
+                                      sizeof(uint16_t)) {
+          break;
+        }
+        size_t points_size = prefix->vertex_count * sizeof(SkPoint);
+        size_t extra_size =
+            points_size * (prefix->has_texture_coordinates ? 2 : 1) +
+            (prefix->has_colors ? prefix->vertex_count * sizeof(DlColor) : 0) +
+            prefix->index_count * sizeof(uint16_t);
+        auto record = validator.Record<DrawVerticesRecord>(extra_size);
+        if (!record) {
+          break;
+        }
+        const uint8_t* data = validator.extra() + sizeof(DrawVerticesRecord);
+        const SkPoint* points = reinterpret_cast<const SkPoint*>(data);
+        data += points_size;
+        const SkPoint* texture_coordinates = nullptr;
+        if (record->has_texture_coordinates) {
+          texture_coordinates = reinterpret_cast<const SkPoint*>(data);
+          data += points_size;
+        }
+        const DlColor* colors = nullptr;
+        if (record->has_colors) {
+          colors = reinterpret_cast<const DlColor*>(data);
+          data += record->vertex_count * sizeof(DlColor);
+        }
+        const uint16_t* indices = reinterpret_cast<const uint16_t*>(data);
+        for (uint32_t i = 0; i < record->index_count; i++) {
+          if (indices[i] >= record->vertex_count) {
+            indices = nullptr;
+            break;
+          }
+        }
+        if (!indices) {
+          break;
+        }
+        vertices_.push_back(DlVertices::Make(
+            static_cast<DlVertexMode>(record->vertex_mode),
+            record->vertex_count, points, texture_coordinates, colors,
+            record->index_count, indices));
+        valid = true;
+        break;
+      }
+      case SerializedOp::kDrawImage: {
+        auto record = validator.Record<DrawImageRecord>();
+        valid = record && validator.IsImage(record->image) &&
+                record->sampling <=
+                    static_cast<uint32_t>(DlImageSampling::kCubic) &&
+                RecordValidator::IsBool(record->render_with_attributes);
+        break;
+      }
+      case SerializedOp::kDrawImageRect: {
+        auto record = validator.Record<DrawImageRectRecord>();
+        valid = record && validator.IsImage(record->image) &&
+                record->sampling <=
+                    static_cast<uint32_t>(DlImageSampling::kCubic) &&
+                RecordValidator::IsBool(record->render_with_attributes) &&
+                RecordValidator::IsBool(record->constraint);
+        break;
+      }
+      case SerializedOp::kDrawImageNine: {
+        auto record = validator.Record<DrawImageNineRecord>();
+        valid = record && validator.IsImage(record->image) &&
+                record->filter <= static_cast<uint32_t>(DlFilterMode::kLast) &&
+                RecordValidator::IsBool(record->render_with_attributes);
+        break;
+      }
+      case SerializedOp::kDrawAtlas: {
+        auto prefix = validator.RecordPrefix<DrawAtlasRecord>();
+        if (!prefix || !validator.IsImage(prefix->atlas) ||
+            prefix->mode > static_cast<uint32_t>(DlBlendMode::kLastMode) ||
+            prefix->sampling >
+                static_cast<uint32_t>(DlImageSampling::kCubic) ||
+            !RecordValidator::IsBool(prefix->has_cull_rect) ||
+            !RecordValidator::IsBool(prefix->render_with_attributes) ||
+            !RecordValidator::IsBool(prefix->has_colors) ||
+            prefix->count > std::numeric_limits<int32_t>::max() /
+                                (sizeof(SkRSXform) + sizeof(SkRect) +
+                                 sizeof(DlColor))) {
+          break;
+        }
+        size_t extra_size =
+            prefix->count * (sizeof(SkRSXform) + sizeof(SkRect) +
+                             (prefix->has_colors ? sizeof(DlColor) : 0));
+        valid = validator.Record<DrawAtlasRecord>(extra_size) != nullptr;
+        break;
+      }
+      case SerializedOp::kDrawDisplayList: {
+        auto prefix = validator.RecordPrefix<DrawDisplayListRecord>();
+        if (!prefix || depth >= kMaxNestingDepth) {
+          break;
+        }
+        const uint8_t* nested_data =
+            validator.extra() + sizeof(DrawDisplayListRecord);
+        size_t nested_size =
+            header.size - sizeof(RecordHeader) - sizeof(DrawDisplayListRecord);
+        auto nested = Make(mapping_, resources_, nested_data, nested_size,
+                           depth + 1);
+        if (!nested) {
+          break;
+        }
+        display_lists_.push_back(nested->Build());
+        valid = true;
+        break;
+      }
+      case SerializedOp::kDrawTextBlob: {
+        auto record = validator.Record<DrawTextBlobRecord>();
+        valid = record && validator.IsTextBlob(record->blob);
+        break;
+      }
+      case SerializedOp::kDrawShadow: {
+        auto record = validator.Record<DrawShadowRecord>();
+        valid = record && validator.IsPath(record->path) &&
+                RecordValidator::IsBool(record->transparent_occluder);
+        break;
+      }
+    }
+    if (!valid) {
+      FML_LOG(ERROR) << "Invalid serialized DisplayList record of type "
+                     << static_cast<uint32_t>(header.op) << ".";
+      return false;
+    }
+    ptr += header.size;
+  }
+  return true;
+}
+
+void DlSerializedDisplayList::Dispatch(DlOpReceiver& receiver) const {
+  const DlSerializationResources& resources = *resources_;
+  size_t display_list_index = 0;
+  size_t vertices_index = 0;
+  const uint8_t* ptr = records_;
+  const uint8_t* end = records_ + records_size_;
+  while (ptr < end) {
+    const RecordHeader& header = RecordAt<RecordHeader>(ptr);
+    const uint8_t* payload = ptr + sizeof(RecordHeader);
+    ptr += header.size;
+    switch (header.op) {
+      case SerializedOp::kSetAntiAlias:
+        receiver.setAntiAlias(RecordAt<ValueRecord>(payload).value);
+        break;
+      case SerializedOp::kSetDither:
+        receiver.setDither(RecordAt<ValueRecord>(payload).value);
+        break;
+      case SerializedOp::kSetInvertColors:
+        receiver.setInvertColors(RecordAt<ValueRecord>(payload).value);
+        break;
+      case SerializedOp::kSetStrokeCap:
+        receiver.setStrokeCap(
+            static_cast<DlStrokeCap>(RecordAt<ValueRecord>(payload).value));
+        break;
+      case SerializedOp::kSetStrokeJoin:
+        receiver.setStrokeJoin(
+            static_cast<DlStrokeJoin>(RecordAt<ValueRecord>(payload).value));
+        break;
+      case SerializedOp::kSetDrawStyle:
+        receiver.setDrawStyle(
+            static_cast<DlDrawStyle>(RecordAt<ValueRecord>(payload).value));
+        break;
+      case SerializedOp::kSetStrokeWidth:
+        receiver.setStrokeWidth(RecordAt<ScalarRecord>(payload).value);
+        break;
+      case SerializedOp::kSetStrokeMiter:
+        receiver.setStrokeMiter(RecordAt<ScalarRecord>(payload).value);
+        break;
+      case SerializedOp::kSetColor:
+        receiver.setColor(RecordAt<ValueRecord>(payload).value);
+        break;
+      case SerializedOp::kSetBlendMode:
+        receiver.setBlendMode(
+            static_cast<DlBlendMode>(RecordAt<ValueRecord>(payload).value));
+        break;
+      case SerializedOp::kSetColorSource:
+        receiver.setColorSource(
+            ResourceAt(resources.color_sources,
+                       RecordAt<ResourceRecord>(payload).index));
+        break;
+      case SerializedOp::kSetColorFilter:
+        receiver.setColorFilter(
+            ResourceAt(resources.color_filters,
+                       RecordAt<ResourceRecord>(payload).index));
+        break;
+      case SerializedOp::kSetImageFilter:
+        receiver.setImageFilter(
+            ResourceAt(resources.image_filters,
+                       RecordAt<ResourceRecord>(payload).index));
+        break;
+      case SerializedOp::kSetPathEffect:
+        receiver.setPathEffect(
+            ResourceAt(resources.path_effects,
+                       RecordAt<ResourceRecord>(payload).index));
+        break;
+      case SerializedOp::kSetMaskFilter:
+        receiver.setMaskFilter(
+            ResourceAt(resources.mask_filters,
+                       RecordAt<ResourceRecord>(payload).index));
+        break;
+
+      case SerializedOp::kSave:
+        receiver.save();
+        break;
+      case SerializedOp::kSaveLayer: {
+        auto& record = RecordAt<SaveLayerRecord>(payload);
+        SaveLayerOptions options;
+        if (record.renders_with_attributes) {
+          options = options.with_renders_with_attributes();
+        }
+        if (record.can_distribute_opacity) {
+          options = options.with_can_distribute_opacity();
+        }
+        receiver.saveLayer(record.has_bounds ? &record.bounds : nullptr,
+                           options,
+                           ResourceAt(resources.image_filters,
+                                      record.backdrop));
+        break;
+      }
+      case SerializedOp::kRestore:
+        receiver.restore();
+        break;
+
+      case SerializedOp::kTranslate: {
+        auto& record = RecordAt<PairRecord>(payload);
+        receiver.translate(record.x, record.y);
+        break;
+      }
+      case SerializedOp::kScale: {
+        auto& record = RecordAt<PairRecord>(payload);
+        receiver.scale(record.x, record.y);
+        break;
+      }
+      case SerializedOp::kRotate:
+        receiver.rotate(RecordAt<ScalarRecord>(payload).value);
+        break;
+      case SerializedOp::kSkew: {
+        auto& record = RecordAt<PairRecord>(payload);
+        receiver.skew(record.x, record.y);
+        break;
+      }
+      case SerializedOp::kTransform2DAffine: {
+        auto& m = RecordAt<Transform2DAffineRecord>(payload);
+        // clang-format off
+        receiver.transform2DAffine(m.mxx, m.mxy, m.mxt,
+                                   m.myx, m.myy, m.myt);
+        // clang-format on
+        break;
+      }
+      case SerializedOp::kTransformFullPerspective: {
+        auto& m = RecordAt<TransformFullPerspectiveRecord>(payload);
+        // clang-format off
+        receiver.transformFullPerspective(m.mxx, m.mxy, m.mxz, m.mxt,
+                                          m.myx, m.myy, m.myz, m.myt,
+                                          m.mzx, m.mzy, m.mzz, m.mzt,
+                                          m.mwx, m.mwy, m.mwz, m.mwt);
+        // clang-format on
+        break;
+      }
+      case SerializedOp::kTransformReset:
+        receiver.transformReset();
+        break;
+
+      case SerializedOp::kClipRect: {
+        auto& record = RecordAt<ClipRectRecord>(payload);
+        receiver.clipRect(record.rect,
+                          static_cast<DlCanvas::ClipOp>(record.clip_op),
+                          record.is_aa);
+        break;
+      }
+      case SerializedOp::kClipRRect: {
+        auto& record = RecordAt<ClipRRectRecord>(payload);
+        receiver.clipRRect(record.rrect.rrect(),
+                           static_cast<DlCanvas::ClipOp>(record.clip_op),
+                           record.is_aa);
+        break;
+      }
+      case SerializedOp::kClipPath: {
+        auto& record = RecordAt<ClipPathRecord>(payload);
+        receiver.clipPath(resources.paths[record.path],
+                          static_cast<DlCanvas::ClipOp>(record.clip_op),
+                          record.is_aa);
+        break;
+      }
+
+      case SerializedOp::kDrawColor: {
+        auto& record = RecordAt<DrawColorRecord>(payload);
+        receiver.drawColor(record.color,
+                           static_cast<DlBlendMode>(record.mode));
+        break;
+      }
+      case SerializedOp::kDrawPaint:
+        receiver.drawPaint();
+        break;
+      case SerializedOp::kDrawLine: {
+        auto& record = RecordAt<DrawLineRecord>(payload);
+        receiver.drawLine(record.p0, record.p1);
+        break;
+      }
+      case SerializedOp::kDrawRect:
+        receiver.drawRect(RecordAt<RectRecord>(payload).rect);
+        break;
+      case SerializedOp::kDrawOval:
+        receiver.drawOval(RecordAt<RectRecord>(payload).rect);
+        break;
+      case SerializedOp::kDrawCircle: {
+        auto& record = RecordAt<DrawCircleRecord>(payload);
+        receiver.drawCircle(record.center, record.radius);
+        break;
+      }
+      case SerializedOp::kDrawRRect:
+        receiver.drawRRect(RecordAt<RRectRecord>(payload).rrect());
+        break;
+      case SerializedOp::kDrawDRRect: {
+        auto& record = RecordAt<DrawDRRectRecord>(payload);
+        receiver.drawDRRect(record.outer.rrect(), record.inner.rrect());
+        break;
+      }
+      case SerializedOp::kDrawPath:
+        receiver.drawPath(
+            resources.paths[RecordAt<ResourceRecord>(payload).index]);
+        break;
+      case SerializedOp::kDrawArc: {
+        auto& record = RecordAt<DrawArcRecord>(payload);
+        receiver.drawArc(record.oval_bounds, record.start_degrees,
+                         record.sweep_degrees, record.use_center);
+        break;
+      }
+      case SerializedOp::kDrawPoints: {
+        auto& record = RecordAt<DrawPointsRecord>(payload);
+        receiver.drawPoints(static_cast<DlCanvas::PointMode>(record.mode),
+                            record.count,
+                            reinterpret_cast<const SkPoint*>(
+                                payload + sizeof(DrawPointsRecord)));
+        break;
+      }
+      case SerializedOp::kDrawVertices: {
+        auto& record = RecordAt<DrawVerticesRecord>(payload);
+        receiver.drawVertices(vertices_[vertices_index++].get(),
+                              static_cast<DlBlendMode>(record.blend_mode));
+        break;
+      }
+      case SerializedOp::kDrawImage: {
+        auto& record = RecordAt<DrawImageRecord>(payload);
+        receiver.drawImage(resources.images[record.image], record.point,
+                           static_cast<DlImageSampling>(record.sampling),
+                           record.render_with_attributes);
+        break;
+      }
+      case SerializedOp::kDrawImageRect: {
+        auto& record = RecordAt<DrawImageRectRecord>(payload);
+        receiver.drawImageRect(
+            resources.images[record.image], record.src, record.dst,
+            static_cast<DlImageSampling>(record.sampling),
+            record.render_with_attributes,
+            static_cast<DlCanvas::SrcRectConstraint>(record.constraint));
+        break;
+      }
+      case SerializedOp::kDrawImageNine: {
+        auto& record = RecordAt<DrawImageNineRecord>(payload);
+        receiver.drawImageNine(resources.images[record.image], record.center,
+                               record.dst,
+                               static_cast<DlFilterMode>(record.filter),
+                               record.render_with_attributes);
+        break;
+      }
+      case SerializedOp::kDrawAtlas: {
+        auto& record = RecordAt<DrawAtlasRecord>(payload);
+        const uint8_t* data = payload + sizeof(DrawAtlasRecord);
+        auto xforms = reinterpret_cast<const SkRSXform*>(data);
+        auto tex = reinterpret_cast<const SkRect*>(
+            data + record.count * sizeof(SkRSXform));
+        auto colors = record.has_colors
+                          ? reinterpret_cast<const DlColor*>(
+                                data + record.count * (sizeof(SkRSXform) +
+                                                       sizeof(SkRect)))
+                          : nullptr;
+        receiver.drawAtlas(
+            resources.images[record.atlas], xforms, tex, colors, record.count,
+            static_cast<DlBlendMode>(record.mode),
+            static_cast<DlImageSampling>(record.sampling),
+            record.has_cull_rect ? &record.cull_rect : nullptr,
+            record.render_with_attributes);
+        break;
+      }
+      case SerializedOp::kDrawDisplayList:
+        receiver.drawDisplayList(display_lists_[display_list_index++],
+                                 RecordAt<DrawDisplayListRecord>(payload).opacity);
+        break;
+      case SerializedOp::kDrawTextBlob: {
+        auto& record = RecordAt<DrawTextBlobRecord>(payload);
+        receiver.drawTextBlob(resources.text_blobs[record.blob], record.x,
+                              record.y);
+        break;
+      }
+      case SerializedOp::kDrawShadow: {
+        auto& record = RecordAt<DrawShadowRecord>(payload);
+        receiver.drawShadow(resources.paths[record.path], record.color,
+                            record.elevation, record.transparent_occluder,
+                            record.dpr);
+        break;
+      }
+    }
+  }
+}
+
+sk_sp<DisplayList> DlSerializedDisplayList::Build() const {
+  DisplayListBuilder builder;
+  Dispatch(builder.asReceiver());
+  return builder.Build();
+}
+
+}  // namespace flutter
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_SERIALIZATION_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_SERIALIZATION_DL_SERIALIZATION_H_
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+/// The objects that a serialized DisplayList refers to by their index in
+/// these tables instead of encoding them in the serialized records.
+///
+/// The serializer appends every object it encounters, reusing the index of
+/// an image or text blob that was already added. Whoever persists or ships
+/// the serialized records is responsible for making the same tables
+/// available to the reader.
+struct DlSerializationResources {
+  std::vector<sk_sp<DlImage>> images;
+  std::vector<sk_sp<SkTextBlob>> text_blobs;
+  std::vector<SkPath> paths;
+  std::vector<std::shared_ptr<const DlColorSource>> color_sources;
+  std::vector<std::shared_ptr<const DlColorFilter>> color_filters;
+  std::vector<std::shared_ptr<const DlImageFilter>> image_filters;
+  std::vector<std::shared_ptr<const DlMaskFilter>> mask_filters;
+  std::vector<std::shared_ptr<const DlPathEffect>> path_effects;
+};
+
+/// Writes the operations of a DisplayList in a versioned binary format that
+/// doesn't depend on its in-memory records.
+///
+/// The format is a header followed by a stream of records, one for each
+/// method call on a |DlOpReceiver|. Every record is a multiple of 4 bytes
+/// and starts on a 4 byte boundary, so arrays such as the points of
+/// |drawPoints| can be handed to a receiver straight out of the buffer.
+/// Values are stored in the native byte order of the writer. Nested
+/// display lists are serialized inline, everything else that is held by
+/// reference in a DisplayList goes in the |DlSerializationResources|.
+class DlSerializer {
+ public:
+  static constexpr uint32_t kVersion = 1;
+
+  /// Serializes |display_list| and appends the objects it refers to into
+  /// |resources|.
+  static std::unique_ptr<fml::Mapping> Serialize(
+      const DisplayList& display_list,
+      DlSerializationResources& resources);
+
+  /// A hash of the contents of |display_list| that stays the same across
+  /// runs of the same build, such as for caching its rendering on disk.
+  ///
+  /// @return     The hash, or std::nullopt if |display_list| refers to
+  ///             objects whose contents can't be hashed that way: images,
+  ///             text, image filters, path effects, and color sources other
+  ///             than colors and gradients.
+  static std::optional<uint64_t> ComputeStableHash(
+      const DisplayList& display_list);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(DlSerializer);
+};
+
+/// Dispatches the records written by |DlSerializer| directly from the
+/// mapping that holds them, such as an |fml::FileMapping|.
+///
+/// All of the records are validated once by |Make|, so that dispatching
+/// them doesn't need to check them again. The display lists nested in the
+/// records and their vertices are built at that time as well, since the
+/// receiver methods take them as objects.
+class DlSerializedDisplayList {
+ public:
+  /// Validates the serialized records in |mapping| against |resources|.
+  ///
+  /// @return     The reader, or nullptr if |mapping| holds a different
+  ///             version of the format or any of its records are invalid.
+  static std::unique_ptr<DlSerializedDisplayList> Make(
+      std::shared_ptr<const fml::Mapping> mapping,
+      std::shared_ptr<const DlSerializationResources> resources);
+
+  ~DlSerializedDisplayList();
+
+  /// The bounds of the DisplayList that was serialized.
+  const SkRect& bounds() const { return bounds_; }
+
+  void Dispatch(DlOpReceiver& receiver) const;
+
+  /// Builds a DisplayList from the records, for uses that need the culling
+  /// and bounds information the serialized records don't carry.
+  sk_sp<DisplayList> Build() const;
+
+ private:
+  DlSerializedDisplayList(
+      std::shared_ptr<const fml::Mapping> mapping,
+      std::shared_ptr<const DlSerializationResources> resources,
+      const uint8_t* records,
+      size_t records_size,
+      const SkRect& bounds);
+
+  static std::unique_ptr<DlSerializedDisplayList> Make(
+      const std::shared_ptr<const fml::Mapping>& mapping,
+      const std::shared_ptr<const DlSerializationResources>& resources,
+      const uint8_t* data,
+      size_t size,
+      int depth);
+
+  bool ValidateRecords(int depth);
+
+  const std::shared_ptr<const fml::Mapping> mapping_;
+  const std::shared_ptr<const DlSerializationResources> resources_;
+  const uint8_t* const records_;
+  const size_t records_size_;
+  const SkRect bounds_;
+
+  // In the order in which their records appear.
+  std::vector<sk_sp<DisplayList>> display_lists_;
+  std::vector<std::shared_ptr<DlVertices>> vertices_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlSerializedDisplayList);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_SERIALIZATION_DL_SERIALIZATION_H_
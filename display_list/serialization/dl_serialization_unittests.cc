@@ -0,0 +1,194 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/serialization/dl_serialization.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static std::vector<DisplayListInvocationGroup> allGroups = CreateAllGroups();
+
+static sk_sp<DisplayList> Build(DisplayListInvocation& invocation) {
+  DisplayListBuilder builder;
+  invocation.Invoke(DisplayListBuilderTestingAccessor(builder));
+  return builder.Build();
+}
+
+static std::unique_ptr<DlSerializedDisplayList> Reserialize(
+    const DisplayList& display_list) {
+  auto resources = std::make_shared<DlSerializationResources>();
+  std::shared_ptr<fml::Mapping> mapping =
+      DlSerializer::Serialize(display_list, *resources);
+  return DlSerializedDisplayList::Make(mapping, resources);
+}
+
+// Returns a copy of the serialized records of |display_list| that can be
+// edited before handing it to the reader.
+static std::vector<uint8_t> SerializeToVector(
+    const DisplayList& display_list,
+    DlSerializationResources& resources) {
+  auto mapping = DlSerializer::Serialize(display_list, resources);
+  return std::vector<uint8_t>(mapping->GetMapping(),
+                              mapping->GetMapping() + mapping->GetSize());
+}
+
+static std::unique_ptr<DlSerializedDisplayList> Read(
+    std::vector<uint8_t> data,
+    DlSerializationResources resources) {
+  return DlSerializedDisplayList::Make(
+      std::make_shared<fml::DataMapping>(std::move(data)),
+      std::make_shared<DlSerializationResources>(std::move(resources)));
+}
+
+TEST(DisplayListSerialization, EmptyDisplayListRoundTrips) {
+  auto display_list = DisplayListBuilder().Build();
+  auto serialized = Reserialize(*display_list);
+  ASSERT_NE(serialized, nullptr);
+  ASSERT_EQ(serialized->bounds(), display_list->bounds());
+  ASSERT_TRUE(serialized->Build()->Equals(*display_list));
+}
+
+TEST(DisplayListSerialization, SingleOpDisplayListsRoundTrip) {
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      sk_sp<DisplayList> display_list = Build(group.variants[i]);
+      auto desc =
+          group.op_name + "(variant " + std::to_string(i + 1) + " == copy)";
+      auto serialized = Reserialize(*display_list);
+      ASSERT_NE(serialized, nullptr) << desc;
+      ASSERT_EQ(serialized->bounds(), display_list->bounds()) << desc;
+
+      sk_sp<DisplayList> copy = serialized->Build();
+      ASSERT_EQ(copy->op_count(true), display_list->op_count(true)) << desc;
+      ASSERT_EQ(copy->bytes(true), display_list->bytes(true)) << desc;
+      ASSERT_EQ(copy->bounds(), display_list->bounds()) << desc;
+      ASSERT_TRUE(copy->Equals(*display_list)) << desc;
+    }
+  }
+}
+
+TEST(DisplayListSerialization, DispatchesDirectlyFromMapping) {
+  DisplayListBuilder nested_builder;
+  nested_builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20),
+                          DlPaint(DlColor::kBlue()));
+  auto nested = nested_builder.Build();
+
+  DisplayListBuilder builder;
+  DlPaint paint(DlColor::kRed());
+  builder.Save();
+  builder.Translate(5, 5);
+  builder.ClipRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  builder.DrawCircle({25, 25}, 10, paint);
+  SkPoint points[] = {{0, 0}, {10, 10}, {20, 0}};
+  builder.DrawPoints(DlCanvas::PointMode::kPolygon, 3, points, paint);
+  builder.DrawDisplayList(nested, 0.5f);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  auto serialized = Reserialize(*display_list);
+  ASSERT_NE(serialized, nullptr);
+  DisplayListBuilder copy_builder;
+  serialized->Dispatch(DisplayListBuilderTestingAccessor(copy_builder));
+  ASSERT_TRUE(copy_builder.Build()->Equals(*display_list));
+}
+
+TEST(DisplayListSerialization, ImagesAndTextBlobsAreShared) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, {0, 0}, DlImageSampling::kLinear);
+  builder.DrawImage(TestImage1, {50, 0}, DlImageSampling::kLinear);
+  builder.DrawTextBlob(TestBlob1, 0, 50, DlPaint());
+  builder.DrawTextBlob(TestBlob1, 0, 100, DlPaint());
+  auto display_list = builder.Build();
+
+  DlSerializationResources resources;
+  DlSerializer::Serialize(*display_list, resources);
+  ASSERT_EQ(resources.images.size(), 1u);
+  ASSERT_EQ(resources.text_blobs.size(), 1u);
+}
+
+TEST(DisplayListSerialization, RejectsInvalidData) {
+  DisplayListBuilder builder;
+  builder.DrawPath(SkPath().addCircle(10, 10, 5), DlPaint());
+  auto display_list = builder.Build();
+
+  DlSerializationResources resources;
+  auto data = SerializeToVector(*display_list, resources);
+  ASSERT_NE(Read(data, resources), nullptr);
+
+  {
+    auto bad_magic = data;
+    bad_magic[0] ^= 0xff;
+    ASSERT_EQ(Read(bad_magic, resources), nullptr);
+  }
+  {
+    auto truncated = data;
+    truncated.resize(truncated.size() - 4);
+    ASSERT_EQ(Read(truncated, resources), nullptr);
+  }
+  {
+    // The path is missing from the resources.
+    ASSERT_EQ(Read(data, DlSerializationResources()), nullptr);
+  }
+  {
+    // The last 4 bytes are the index of the path.
+    auto bad_index = data;
+    int32_t index = 1;
+    memcpy(bad_index.data() + bad_index.size() - sizeof(index), &index,
+           sizeof(index));
+    ASSERT_EQ(Read(bad_index, resources), nullptr);
+  }
+}
+
+static sk_sp<DisplayList> BuildGradientPath(DlColor end_color) {
+  const DlColor colors[] = {DlColor::kRed(), end_color};
+  const float stops[] = {0.0f, 1.0f};
+  DlPaint paint;
+  paint.setColorSource(DlColorSource::MakeLinear(
+      {0, 0}, {20, 20}, 2, colors, stops, DlTileMode::kClamp));
+  paint.setMaskFilter(DlBlurMaskFilter::Make(DlBlurStyle::kNormal, 2.0f));
+  DisplayListBuilder builder;
+  builder.DrawPath(SkPath().addCircle(10, 10, 5), paint);
+  return builder.Build();
+}
+
+TEST(DisplayListSerialization, StableHashFollowsContents) {
+  auto blue = BuildGradientPath(DlColor::kBlue());
+  auto hash = DlSerializer::ComputeStableHash(*blue);
+  ASSERT_TRUE(hash.has_value());
+  // The hash is of the contents, not of the objects they are made of.
+  auto blue_copy = BuildGradientPath(DlColor::kBlue());
+  EXPECT_EQ(DlSerializer::ComputeStableHash(*blue_copy), hash);
+  auto green = BuildGradientPath(DlColor::kGreen());
+  EXPECT_NE(DlSerializer::ComputeStableHash(*green), hash);
+
+  DisplayListBuilder builder;
+  builder.DrawPath(SkPath().addCircle(10, 10, 6), DlPaint());
+  EXPECT_NE(DlSerializer::ComputeStableHash(*builder.Build()), hash);
+}
+
+TEST(DisplayListSerialization, StableHashRejectsImagesAndText) {
+  {
+    DisplayListBuilder builder;
+    builder.DrawImage(TestImage1, {0, 0}, DlImageSampling::kLinear);
+    auto display_list = builder.Build();
+    EXPECT_FALSE(DlSerializer::ComputeStableHash(*display_list).has_value());
+  }
+  {
+    DisplayListBuilder builder;
+    builder.DrawTextBlob(TestBlob1, 0, 50, DlPaint());
+    auto display_list = builder.Build();
+    EXPECT_FALSE(DlSerializer::ComputeStableHash(*display_list).has_value());
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
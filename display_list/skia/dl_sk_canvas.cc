@@ -4,6 +4,7 @@
 
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/display_list/skia/dl_sk_conversions.h"
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/fml/trace_event.h"
@@ -310,9 +311,9 @@ void DlSkCanvasAdapter::DrawDisplayList(const sk_sp<DisplayList> display_list,
 
   DlSkCanvasDispatcher dispatcher(delegate_, opacity);
   if (display_list->has_rtree()) {
-    display_list->Dispatch(dispatcher, delegate_->getLocalClipBounds());
+    display_list->DispatchInline(dispatcher, delegate_->getLocalClipBounds());
   } else {
-    display_list->Dispatch(dispatcher);
+    display_list->DispatchInline(dispatcher);
   }
 
   delegate_->restoreToCount(restore_count);
@@ -5,6 +5,7 @@
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 
 #include "flutter/display_list/dl_blend_mode.h"
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/display_list/skia/dl_sk_conversions.h"
 #include "flutter/display_list/skia/dl_sk_types.h"
 #include "flutter/fml/trace_event.h"
@@ -256,9 +257,9 @@ void DlSkCanvasDispatcher::drawDisplayList(
   // display_list from the current environment.
   DlSkCanvasDispatcher dispatcher(canvas_, combined_opacity);
   if (display_list->rtree()) {
-    display_list->Dispatch(dispatcher, canvas_->getLocalClipBounds());
+    display_list->DispatchInline(dispatcher, canvas_->getLocalClipBounds());
   } else {
-    display_list->Dispatch(dispatcher);
+    display_list->DispatchInline(dispatcher);
   }
 
   // Restore canvas state to what it was before dispatching.
@@ -17,8 +17,8 @@ namespace flutter {
 /// @brief      Backend implementation of |DlOpReceiver| for |SkCanvas|.
 ///
 /// @see       DlOpReceiver
-class DlSkCanvasDispatcher : public virtual DlOpReceiver,
-                             public DlSkPaintDispatchHelper {
+class DlSkCanvasDispatcher final : public virtual DlOpReceiver,
+                                   public DlSkPaintDispatchHelper {
  public:
   explicit DlSkCanvasDispatcher(SkCanvas* canvas, SkScalar opacity = SK_Scalar1)
       : DlSkPaintDispatchHelper(opacity),
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/diff_context.h"
@@ -16,6 +17,7 @@
 #include "flutter/flow/stopwatch.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -205,12 +207,25 @@ class CompositorContext {
 
   LayerSnapshotStore& snapshot_store() { return layer_snapshot_store_; }
 
+  // The runner of the tasks that preroll independent subtrees of the layer
+  // trees concurrently, if they may be. See |PrerollContext|.
+  const std::shared_ptr<fml::BasicTaskRunner>& concurrent_preroll_task_runner()
+      const {
+    return concurrent_preroll_task_runner_;
+  }
+
+  void SetConcurrentPrerollTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+    concurrent_preroll_task_runner_ = std::move(task_runner);
+  }
+
  private:
   RasterCache raster_cache_;
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
   LayerSnapshotStore layer_snapshot_store_;
+  std::shared_ptr<fml::BasicTaskRunner> concurrent_preroll_task_runner_;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
@@ -0,0 +1,312 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_tile_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "flutter/flow/layers/layer.h"
+#include "flutter/flow/paint_utils.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// Scales just above a power of two don't need the next bucket.
+static constexpr SkScalar kScaleBucketTolerance = 1e-3f;
+
+// Keeps the bucket scales, and the size of the tiles in logical
+// coordinates, within a sensible range.
+static constexpr int32_t kMinScaleBucket = -16;
+static constexpr int32_t kMaxScaleBucket = 16;
+
+static const auto* flow_type = "RasterCacheFlow::DisplayListTile";
+
+static SkRect ScaleRect(const SkRect& rect, SkScalar scale) {
+  return SkRect::MakeLTRB(rect.fLeft * scale, rect.fTop * scale,
+                          rect.fRight * scale, rect.fBottom * scale);
+}
+
+DisplayListTileCache::DisplayListTileCache() = default;
+
+DisplayListTileCache::~DisplayListTileCache() = default;
+
+void DisplayListTileCache::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+  if (!enabled_) {
+    Clear();
+  }
+}
+
+void DisplayListTileCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+}
+
+void DisplayListTileCache::SetMaxTilesRasterizedPerFrame(size_t max_tiles) {
+  max_tiles_rasterized_per_frame_ = max_tiles;
+}
+
+int32_t DisplayListTileCache::GetScaleBucket(SkScalar scale) {
+  FML_DCHECK(scale > 0);
+  auto bucket = static_cast<int32_t>(
+      std::ceil(std::log2(scale) - kScaleBucketTolerance));
+  return std::clamp(bucket, kMinScaleBucket, kMaxScaleBucket);
+}
+
+SkScalar DisplayListTileCache::GetBucketScale(int32_t scale_bucket) {
+  return std::ldexp(1.0f, scale_bucket);
+}
+
+bool DisplayListTileCache::ShouldDrawTiled(const DisplayList& display_list,
+                                           const SkMatrix& ctm,
+                                           const SkRect& device_clip) const {
+  if (!enabled_ || !ctm.isScaleTranslate() || ctm.getScaleX() <= 0 ||
+      ctm.getScaleY() <= 0 || device_clip.isEmpty()) {
+    return false;
+  }
+  SkRect device_bounds = ctm.mapRect(display_list.bounds());
+  return device_bounds.width() * device_bounds.height() >=
+         kMinAreaRatio * device_clip.width() * device_clip.height();
+}
+
+bool DisplayListTileCache::Draw(const PaintContext& context,
+                                const sk_sp<DisplayList>& display_list,
+                                SkScalar opacity) {
+  FML_DCHECK(context.canvas && context.raster_cache);
+  DlCanvas& canvas = *context.canvas;
+  SkMatrix ctm = canvas.GetTransform();
+  if (!ctm.isScaleTranslate() || ctm.getScaleX() <= 0 ||
+      ctm.getScaleY() <= 0) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "DisplayListTileCache::Draw");
+
+  SkRect visible = canvas.GetLocalClipBounds();
+  if (!visible.intersect(display_list->bounds())) {
+    return true;
+  }
+
+  SkScalar scale = std::max(ctm.getScaleX(), ctm.getScaleY());
+  uint64_t id = display_list->unique_id();
+  auto state = display_lists_.find(id);
+  bool scale_changed = state != display_lists_.end() &&
+                       state->second.last_used_frame + 1 == frame_ &&
+                       state->second.scale != scale;
+  display_lists_[id] = {scale, frame_};
+
+  int32_t bucket = GetScaleBucket(scale);
+  SkScalar bucket_scale = GetBucketScale(bucket);
+  SkRect bucket_bounds = ScaleRect(display_list->bounds(), bucket_scale);
+  bucket_bounds.roundOut(&bucket_bounds);
+  SkRect bucket_visible = ScaleRect(visible, bucket_scale);
+  auto left =
+      static_cast<int32_t>(std::floor(bucket_visible.fLeft / kTileSize));
+  auto top =
+      static_cast<int32_t>(std::floor(bucket_visible.fTop / kTileSize));
+  auto right =
+      static_cast<int32_t>(std::ceil(bucket_visible.fRight / kTileSize));
+  auto bottom =
+      static_cast<int32_t>(std::ceil(bucket_visible.fBottom / kTileSize));
+
+  DlPaint paint;
+  paint.setOpacity(opacity);
+
+  // Adjacent tiles of a row that are drawn directly from the display list
+  // share a single clip.
+  SkRect direct_rect = SkRect::MakeEmpty();
+  auto flush_direct = [&]() {
+    if (direct_rect.isEmpty()) {
+      return;
+    }
+    DlAutoCanvasRestore restore(&canvas, true);
+    canvas.ClipRect(ScaleRect(direct_rect, 1.0f / bucket_scale));
+    canvas.DrawDisplayList(display_list, opacity);
+    direct_rect.setEmpty();
+  };
+
+  for (int32_t y = top; y < bottom; y++) {
+    for (int32_t x = left; x < right; x++) {
+      Key key = {id, bucket, x, y};
+      SkRect bucket_rect = SkRect::MakeXYWH(x * kTileSize, y * kTileSize,
+                                            kTileSize, kTileSize);
+      if (!bucket_rect.intersect(bucket_bounds)) {
+        continue;
+      }
+      const Tile* tile = FindTile(key);
+      if (!tile &&
+          tiles_rasterized_this_frame_ < max_tiles_rasterized_per_frame_) {
+        tile = RasterizeTile(context, display_list, key, bucket_rect);
+      }
+      if (tile) {
+        flush_direct();
+        DrawTile(canvas, *tile, bucket_scale, paint);
+        continue;
+      }
+      if (scale_changed && DrawFallback(canvas, key, bucket_rect, paint)) {
+        flush_direct();
+        continue;
+      }
+      direct_rect.join(bucket_rect);
+    }
+    flush_direct();
+  }
+  return true;
+}
+
+const DisplayListTileCache::Tile* DisplayListTileCache::FindTile(
+    const Key& key) {
+  auto it = tiles_.find(key);
+  if (it == tiles_.end()) {
+    return nullptr;
+  }
+  it->second.last_used_frame = frame_;
+  return &it->second;
+}
+
+const DisplayListTileCache::Tile* DisplayListTileCache::RasterizeTile(
+    const PaintContext& context,
+    const sk_sp<DisplayList>& display_list,
+    const Key& key,
+    const SkRect& bucket_rect) {
+  // Failed attempts count against the budget too, so that a frame never
+  // spends more than the budget on rasterizing tiles.
+  tiles_rasterized_this_frame_++;
+  size_t bytes = static_cast<size_t>(bucket_rect.width()) *
+                 static_cast<size_t>(bucket_rect.height()) * 4u;
+  if (!EvictToFit(bytes)) {
+    return nullptr;
+  }
+
+  SkScalar bucket_scale = GetBucketScale(key.scale_bucket);
+  SkMatrix matrix = SkMatrix::Scale(bucket_scale, bucket_scale);
+  SkRect logical_rect = ScaleRect(bucket_rect, 1.0f / bucket_scale);
+  RasterCache::Context r_context = {
+      // clang-format off
+      .gr_context         = context.gr_context,
+      .aiks_context       = context.aiks_context,
+      .dst_color_space    = context.dst_color_space,
+      .matrix             = matrix,
+      .logical_rect       = logical_rect,
+      .flow_type          = flow_type,
+      // clang-format on
+  };
+  auto result = context.raster_cache->Rasterize(
+      r_context, nullptr,
+      [&display_list](DlCanvas* canvas) {
+        canvas->DrawDisplayList(display_list);
+      },
+      DrawCheckerboard);
+  if (!result || !result->image()) {
+    return nullptr;
+  }
+
+  Tile& tile = tiles_[key];
+  tile.image = result->image();
+  tile.bucket_rect = bucket_rect;
+  tile.bytes = bytes;
+  tile.last_used_frame = frame_;
+  byte_size_ += tile.bytes;
+  return &tile;
+}
+
+bool DisplayListTileCache::DrawFallback(DlCanvas& canvas,
+                                        const Key& key,
+                                        const SkRect& bucket_rect,
+                                        const DlPaint& paint) {
+  SkRect logical_rect =
+      ScaleRect(bucket_rect, 1.0f / GetBucketScale(key.scale_bucket));
+  for (int32_t level = 1; level <= kMaxFallbackBuckets; level++) {
+    // Tile grids are aligned across buckets, so a single tile of a coarser
+    // bucket covers the whole tile.
+    Key coarse_key = {key.display_list_id, key.scale_bucket - level,
+                      key.x >> level, key.y >> level};
+    const Tile* tile = FindTile(coarse_key);
+    if (!tile) {
+      continue;
+    }
+    SkRect src =
+        ScaleRect(logical_rect, GetBucketScale(coarse_key.scale_bucket));
+    if (!src.intersect(tile->bucket_rect)) {
+      continue;
+    }
+    src.offset(-tile->bucket_rect.fLeft, -tile->bucket_rect.fTop);
+    canvas.DrawImageRect(tile->image, src, logical_rect,
+                         DlImageSampling::kLinear, &paint);
+    return true;
+  }
+  return false;
+}
+
+void DisplayListTileCache::DrawTile(DlCanvas& canvas,
+                                    const Tile& tile,
+                                    SkScalar bucket_scale,
+                                    const DlPaint& paint) const {
+  canvas.DrawImageRect(tile.image, SkRect::Make(tile.image->bounds()),
+                       ScaleRect(tile.bucket_rect, 1.0f / bucket_scale),
+                       DlImageSampling::kLinear, &paint);
+}
+
+void DisplayListTileCache::BeginFrame() {
+  frame_++;
+  tiles_rasterized_this_frame_ = 0;
+}
+
+void DisplayListTileCache::EvictUnusedTiles() {
+  for (auto it = tiles_.begin(); it != tiles_.end();) {
+    if (frame_ - it->second.last_used_frame > kMaxUnusedFrames) {
+      byte_size_ -= it->second.bytes;
+      it = tiles_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = display_lists_.begin(); it != display_lists_.end();) {
+    if (frame_ - it->second.last_used_frame > kMaxUnusedFrames) {
+      it = display_lists_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // The budget may have shrunk since the tiles were cached.
+  EvictToFit(0u);
+}
+
+bool DisplayListTileCache::EvictToFit(size_t bytes) {
+  if (bytes > max_bytes_) {
+    return false;
+  }
+  if (byte_size_ + bytes <= max_bytes_) {
+    return true;
+  }
+
+  // The tiles used in this frame may still be drawn by other layers.
+  std::vector<TileMap::iterator> candidates;
+  for (auto it = tiles_.begin(); it != tiles_.end(); ++it) {
+    if (it->second.last_used_frame != frame_) {
+      candidates.push_back(it);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const TileMap::iterator& a, const TileMap::iterator& b) {
+              return a->second.last_used_frame < b->second.last_used_frame;
+            });
+  for (auto it : candidates) {
+    if (byte_size_ + bytes <= max_bytes_) {
+      break;
+    }
+    byte_size_ -= it->second.bytes;
+    tiles_.erase(it);
+  }
+  return byte_size_ + bytes <= max_bytes_;
+}
+
+void DisplayListTileCache::Clear() {
+  tiles_.clear();
+  display_lists_.clear();
+  byte_size_ = 0;
+}
+
+}  // namespace flutter
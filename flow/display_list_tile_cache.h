@@ -0,0 +1,209 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_TILE_CACHE_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_TILE_CACHE_H_
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+struct PaintContext;
+
+/**
+ * DisplayListTileCache draws display lists that are much larger than the
+ * screen, such as zoomable documents and maps, from fixed size tiles rather
+ * than caching them in one image like the RasterCache does.
+ *
+ * Tiles are kTileSize device pixels square and keyed by the display list,
+ * the scale bucket and the tile position. Scale buckets are powers of two,
+ * rounded up from the scale of the transform, so the tiles of a bucket are
+ * reused while panning and across the scales of a pinch-zoom that fall in
+ * the same octave. Only the visible tiles are rasterized, and at most
+ * |max_tiles_rasterized_per_frame| of them per frame.
+ *
+ * While the scale of a display list changes from one frame to the next, the
+ * tiles that still need to be rasterized are drawn from the tiles of coarser
+ * buckets when there are any. Once the scale settles, or when there is no
+ * such tile, they are drawn directly from the display list, so a still frame
+ * is never left with low resolution tiles.
+ *
+ * Tiles are evicted once they go unused for kMaxUnusedFrames frames, or
+ * least recently used first when the cache grows past its byte budget.
+ *
+ * The cache is disabled by default.
+ */
+class DisplayListTileCache {
+ public:
+  static constexpr int kTileSize = 256;
+  static constexpr size_t kDefaultMaxBytes = 64u * 1024u * 1024u;
+  static constexpr size_t kDefaultMaxTilesRasterizedPerFrame = 8u;
+  static constexpr size_t kMaxUnusedFrames = 120u;
+
+  /**
+   * The number of coarser buckets that are searched for a replacement of a
+   * tile that isn't rasterized yet.
+   */
+  static constexpr int kMaxFallbackBuckets = 3;
+
+  /**
+   * Display lists are only drawn from tiles if their device bounds are at
+   * least this many times the area of the device clip.
+   */
+  static constexpr SkScalar kMinAreaRatio = 2.0f;
+
+  struct Key {
+    uint64_t display_list_id;
+    int32_t scale_bucket;
+    int32_t x;
+    int32_t y;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        return fml::HashCombine(key.display_list_id, key.scale_bucket, key.x,
+                                key.y);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.display_list_id == rhs.display_list_id &&
+               lhs.scale_bucket == rhs.scale_bucket && lhs.x == rhs.x &&
+               lhs.y == rhs.y;
+      }
+    };
+  };
+
+  DisplayListTileCache();
+
+  ~DisplayListTileCache();
+
+  void SetEnabled(bool enabled);
+
+  bool enabled() const { return enabled_; }
+
+  /**
+   * @brief Limit the size of all cached tiles to |max_bytes|.
+   */
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  void SetMaxTilesRasterizedPerFrame(size_t max_tiles);
+
+  /**
+   * @brief The scale bucket of a transform scale, the smallest power of two
+   * exponent whose scale is at least |scale|.
+   */
+  static int32_t GetScaleBucket(SkScalar scale);
+
+  static SkScalar GetBucketScale(int32_t scale_bucket);
+
+  /**
+   * @brief Whether a display list drawn with |ctm| into a canvas whose clip
+   * is |device_clip| should be drawn from tiles.
+   *
+   * This is the case for display lists that are much larger than the clip
+   * and drawn with a scale and translate transform.
+   */
+  bool ShouldDrawTiled(const DisplayList& display_list,
+                       const SkMatrix& ctm,
+                       const SkRect& device_clip) const;
+
+  /**
+   * @brief Draw the visible part of |display_list| into the canvas of
+   * |context| from tiles, rasterizing the tiles that are missing.
+   *
+   * @return true unless the transform of the canvas can't be drawn from
+   * tiles, in which case nothing is drawn.
+   */
+  bool Draw(const PaintContext& context,
+            const sk_sp<DisplayList>& display_list,
+            SkScalar opacity);
+
+  void BeginFrame();
+
+  /**
+   * @brief Evict the tiles that haven't been used for more than
+   * kMaxUnusedFrames frames, then the least recently used tiles until the
+   * cache fits in its byte budget.
+   */
+  void EvictUnusedTiles();
+
+  void Clear();
+
+  size_t GetTileCount() const { return tiles_.size(); }
+
+  size_t GetByteSize() const { return byte_size_; }
+
+  /**
+   * @brief The number of tiles rasterized in the current frame.
+   */
+  size_t tiles_rasterized_this_frame() const {
+    return tiles_rasterized_this_frame_;
+  }
+
+ private:
+  struct Tile {
+    sk_sp<DlImage> image;
+    // The area of the tile in the space of the scale bucket, that is the
+    // device space of a transform scaled by the bucket scale.
+    SkRect bucket_rect;
+    size_t bytes = 0;
+    uint64_t last_used_frame = 0;
+  };
+
+  struct DisplayListState {
+    SkScalar scale;
+    uint64_t last_used_frame;
+  };
+
+  using TileMap = std::unordered_map<Key, Tile, Key::Hash, Key::Equal>;
+
+  const Tile* FindTile(const Key& key);
+
+  const Tile* RasterizeTile(const PaintContext& context,
+                            const sk_sp<DisplayList>& display_list,
+                            const Key& key,
+                            const SkRect& bucket_rect);
+
+  // Draws the tiles of the coarser buckets that cover |key|, returning
+  // false if there are none.
+  bool DrawFallback(DlCanvas& canvas,
+                    const Key& key,
+                    const SkRect& bucket_rect,
+                    const DlPaint& paint);
+
+  void DrawTile(DlCanvas& canvas,
+                const Tile& tile,
+                SkScalar bucket_scale,
+                const DlPaint& paint) const;
+
+  bool EvictToFit(size_t bytes);
+
+  bool enabled_ = false;
+  size_t max_bytes_ = kDefaultMaxBytes;
+  size_t max_tiles_rasterized_per_frame_ = kDefaultMaxTilesRasterizedPerFrame;
+  uint64_t frame_ = 0;
+  size_t tiles_rasterized_this_frame_ = 0;
+  size_t byte_size_ = 0;
+  TileMap tiles_;
+  // The scale each display list was last drawn at, keyed by its unique id.
+  std::unordered_map<uint64_t, DisplayListState> display_lists_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListTileCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_TILE_CACHE_H_
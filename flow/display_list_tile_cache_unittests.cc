@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_tile_cache.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/flow/testing/mock_raster_cache.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<DisplayList> MakeDocument() {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlPaint paint(DlColor::kBlue());
+  for (int y = 0; y < 4096; y += 128) {
+    for (int x = 0; x < 4096; x += 128) {
+      builder.DrawRect(SkRect::MakeXYWH(x, y, 64, 64), paint);
+    }
+  }
+  return builder.Build();
+}
+
+class DisplayListTileCacheTest : public ::testing::Test {
+ public:
+  DisplayListTileCacheTest()
+      : paint_context_holder_(GetSamplePaintContextHolder(state_stack_,
+                                                          &raster_cache_,
+                                                          &raster_time_,
+                                                          &ui_time_)) {
+    tile_cache().SetEnabled(true);
+  }
+
+  DisplayListTileCache& tile_cache() { return raster_cache_.tile_cache(); }
+
+  // Draws |display_list| into a 512x512 canvas and returns what was drawn.
+  sk_sp<DisplayList> Draw(const sk_sp<DisplayList>& display_list,
+                          const SkMatrix& matrix) {
+    raster_cache_.BeginFrame();
+    DisplayListBuilder builder(SkRect::MakeWH(512, 512));
+    builder.Transform(matrix);
+    paint_context_holder_.paint_context.canvas = &builder;
+    EXPECT_TRUE(tile_cache().Draw(paint_context_holder_.paint_context,
+                                  display_list, SK_Scalar1));
+    paint_context_holder_.paint_context.canvas = nullptr;
+    raster_cache_.EvictUnusedCacheEntries();
+    raster_cache_.EndFrame();
+    return builder.Build();
+  }
+
+ private:
+  RasterCache raster_cache_;
+  LayerStateStack state_stack_;
+  FixedRefreshRateStopwatch raster_time_;
+  FixedRefreshRateStopwatch ui_time_;
+  PaintContextHolder paint_context_holder_;
+};
+
+}  // namespace
+
+TEST(DisplayListTileCache, ScaleBuckets) {
+  EXPECT_EQ(DisplayListTileCache::GetScaleBucket(1.0f), 0);
+  EXPECT_EQ(DisplayListTileCache::GetScaleBucket(1.5f), 1);
+  EXPECT_EQ(DisplayListTileCache::GetScaleBucket(2.0f), 1);
+  EXPECT_EQ(DisplayListTileCache::GetScaleBucket(0.5f), -1);
+  EXPECT_EQ(DisplayListTileCache::GetScaleBucket(0.3f), -1);
+  EXPECT_EQ(DisplayListTileCache::GetBucketScale(-1), 0.5f);
+  EXPECT_EQ(DisplayListTileCache::GetBucketScale(2), 4.0f);
+}
+
+TEST(DisplayListTileCache, OnlyOversizedDisplayListsAreTiled) {
+  DisplayListTileCache cache;
+  auto document = MakeDocument();
+  SkRect clip = SkRect::MakeWH(512, 512);
+  EXPECT_FALSE(cache.ShouldDrawTiled(*document, SkMatrix::I(), clip));
+
+  cache.SetEnabled(true);
+  EXPECT_TRUE(cache.ShouldDrawTiled(*document, SkMatrix::I(), clip));
+  EXPECT_FALSE(
+      cache.ShouldDrawTiled(*document, SkMatrix::RotateDeg(10), clip));
+  EXPECT_FALSE(cache.ShouldDrawTiled(*document, SkMatrix::I(),
+                                     SkRect::MakeWH(4096, 4096)));
+}
+
+TEST_F(DisplayListTileCacheTest, RasterizesVisibleTilesOnce) {
+  auto document = MakeDocument();
+  Draw(document, SkMatrix::I());
+  EXPECT_EQ(tile_cache().tiles_rasterized_this_frame(), 4u);
+  EXPECT_EQ(tile_cache().GetTileCount(), 4u);
+  EXPECT_EQ(tile_cache().GetByteSize(), 4u * 256u * 256u * 4u);
+
+  // Panning by half a tile only needs the next row and column.
+  Draw(document, SkMatrix::Translate(-128, -128));
+  EXPECT_EQ(tile_cache().tiles_rasterized_this_frame(), 5u);
+  EXPECT_EQ(tile_cache().GetTileCount(), 9u);
+
+  Draw(document, SkMatrix::Translate(-128, -128));
+  EXPECT_EQ(tile_cache().tiles_rasterized_this_frame(), 0u);
+}
+
+TEST_F(DisplayListTileCacheTest, ScalesInABucketShareTiles) {
+  auto document = MakeDocument();
+  Draw(document, SkMatrix::Scale(1.5f, 1.5f));
+  size_t tile_count = tile_cache().GetTileCount();
+  EXPECT_GT(tile_count, 0u);
+
+  Draw(document, SkMatrix::Scale(1.8f, 1.8f));
+  EXPECT_EQ(tile_cache().tiles_rasterized_this_frame(), 0u);
+  EXPECT_EQ(tile_cache().GetTileCount(), tile_count);
+}
+
+TEST_F(DisplayListTileCacheTest, RasterizesALimitedNumberOfTilesPerFrame) {
+  tile_cache().SetMaxTilesRasterizedPerFrame(1u);
+  auto document = MakeDocument();
+  auto drawn = Draw(document, SkMatrix::I());
+  EXPECT_EQ(tile_cache().GetTileCount(), 1u);
+  // The tiles that weren't rasterized are drawn directly.
+  EXPECT_GT(drawn->op_count(), 1u);
+
+  Draw(document, SkMatrix::I());
+  EXPECT_EQ(tile_cache().GetTileCount(), 2u);
+}
+
+TEST_F(DisplayListTileCacheTest, StaysWithinTheByteBudget) {
+  tile_cache().SetMaxBytes(2u * 256u * 256u * 4u);
+  auto document = MakeDocument();
+  Draw(document, SkMatrix::I());
+  EXPECT_EQ(tile_cache().GetTileCount(), 2u);
+
+  // Tiles that are no longer visible make room for the visible ones.
+  Draw(document, SkMatrix::Translate(-1024, 0));
+  EXPECT_EQ(tile_cache().GetTileCount(), 2u);
+  EXPECT_LE(tile_cache().GetByteSize(), tile_cache().max_bytes());
+}
+
+TEST_F(DisplayListTileCacheTest, EvictsTilesThatAreNoLongerUsed) {
+  auto document = MakeDocument();
+  Draw(document, SkMatrix::I());
+  EXPECT_EQ(tile_cache().GetTileCount(), 4u);
+
+  auto other = MakeDocument();
+  for (size_t i = 0; i < DisplayListTileCache::kMaxUnusedFrames; i++) {
+    Draw(other, SkMatrix::Translate(-2048, -2048));
+  }
+  EXPECT_EQ(tile_cache().GetTileCount(), 8u);
+  Draw(other, SkMatrix::Translate(-2048, -2048));
+  EXPECT_EQ(tile_cache().GetTileCount(), 4u);
+}
+
+}  // namespace testing
+}  // namespace flutter
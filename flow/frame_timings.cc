@@ -200,6 +200,7 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetCosts(cost_ledger_.GetCosts());
   return timing_;
 }
 
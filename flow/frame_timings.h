@@ -9,6 +9,7 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/fml/frame_cost_ledger.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/status.h"
 #include "flutter/fml/time/time_delta.h"
@@ -116,6 +117,10 @@ class FrameTimingsRecorder {
   /// Returns the recorded time from when `RecordRasterEnd` is called.
   FrameTiming GetRecordedTime() const;
 
+  /// The ledger to make current while the frame is rasterized. Its costs are
+  /// summarized by `RecordRasterEnd`.
+  fml::FrameCostLedger* GetCostLedger() { return &cost_ledger_; }
+
  private:
   FML_FRIEND_TEST(FrameTimingsRecorderTest, ThrowWhenRecordBuildBeforeVsync);
   FML_FRIEND_TEST(FrameTimingsRecorderTest,
@@ -148,6 +153,8 @@ class FrameTimingsRecorder {
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
 
+  fml::FrameCostLedger cost_ledger_;
+
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
 
@@ -75,6 +75,27 @@ TEST(FrameTimingsRecorderTest, RecordRasterTimes) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), 0u);
 }
 
+TEST(FrameTimingsRecorderTest, RecordRasterEndReportsCosts) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto st = fml::TimePoint::Now();
+  const auto en = st + fml::TimeDelta::FromMillisecondsF(16);
+  recorder->RecordVsync(st, en);
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+
+  const auto upload = fml::TimeDelta::FromMilliseconds(3);
+  recorder->GetCostLedger()->AddCost(
+      fml::FrameCostLedger::Category::kTextureUpload, upload);
+  const auto timing = recorder->RecordRasterEnd();
+
+  ASSERT_EQ(timing.GetCost(fml::FrameCostLedger::Category::kTextureUpload),
+            upload);
+  ASSERT_EQ(timing.GetCost(fml::FrameCostLedger::Category::kPipelineCompile),
+            fml::TimeDelta::Zero());
+}
+
 TEST(FrameTimingsRecorderTest, RecordRasterTimesWithCache) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
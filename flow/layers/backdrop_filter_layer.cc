@@ -45,6 +45,7 @@ void BackdropFilterLayer::Preroll(PrerollContext* context) {
   if (filter_ && context->view_embedder != nullptr) {
     context->view_embedder->PushFilterToVisitedPlatformViews(
         filter_, context->state_stack.device_cull_rect());
+    context->preroll_is_reusable = false;
   }
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, &child_paint_bounds);
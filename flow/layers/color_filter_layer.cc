@@ -50,12 +50,19 @@ void ColorFilterLayer::Preroll(PrerollContext* context) {
   // those attributes with our saveLayer normally.
   // However, some color filters can commute themselves with an opacity
   // modulation so in that case we can apply the opacity on behalf of our
-  // ancestors - otherwise we can apply no attributes.
+  // ancestors. Some matrix color filters can also be composed with a matrix
+  // color filter of an ancestor, so that both are applied by a single
+  // saveLayer - otherwise we can apply no attributes.
   if (filter_) {
     context->renderable_state_flags =
         filter_->can_commute_with_opacity()
             ? LayerStateStack::kCallerCanApplyOpacity
             : 0;
+    const DlMatrixColorFilter* matrix_filter = filter_->asMatrix();
+    if (matrix_filter && matrix_filter->can_compose_with_outer()) {
+      context->renderable_state_flags |=
+          LayerStateStack::kCallerCanApplyMatrixColorFilter;
+    }
   }
   // else - we can apply whatever our children can apply.
 }
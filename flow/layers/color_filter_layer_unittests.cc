@@ -234,6 +234,49 @@ TEST_F(ColorFilterLayerTest, Nested) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_display_list));
 }
 
+TEST_F(ColorFilterLayerTest, NestedMatrixFiltersShareSaveLayer) {
+  // clang-format off
+  float outer_matrix[20] = {
+    0, 1, 0, 0, 0,
+    0, 0, 1, 0, 0,
+    1, 0, 0, 0, 0,
+    0, 0, 0, 1, 0,
+  };
+  float inner_matrix[20] = {
+    0.5, 0,   0,   0, 0,
+    0,   0.5, 0,   0, 0,
+    0,   0,   0.5, 0, 0,
+    0,   0,   0,   1, 0,
+  };
+  // clang-format on
+  auto outer_filter = std::make_shared<DlMatrixColorFilter>(outer_matrix);
+  auto inner_filter = std::make_shared<DlMatrixColorFilter>(inner_matrix);
+  const SkPath child_path = SkPath().addRect(SkRect::MakeLTRB(5, 6, 15, 16));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto inner_layer = std::make_shared<ColorFilterLayer>(inner_filter);
+  inner_layer->Add(mock_layer);
+  auto outer_layer = std::make_shared<ColorFilterLayer>(outer_filter);
+  outer_layer->Add(inner_layer);
+
+  outer_layer->Preroll(preroll_context());
+
+  DisplayListBuilder expected_builder;
+  /* ColorFilterLayer::Paint() */ {
+    /* ColorFilterLayer::Paint() */ {
+      DlPaint dl_paint;
+      dl_paint.setColorFilter(inner_filter->compose_with_outer(*outer_filter));
+      expected_builder.SaveLayer(&child_path.getBounds(), &dl_paint);
+      /* MockLayer::Paint() */ {
+        expected_builder.DrawPath(child_path, DlPaint(0xFF000000));
+      }
+      expected_builder.Restore();
+    }
+  }
+
+  outer_layer->Paint(display_list_paint_context());
+  EXPECT_TRUE(DisplayListsEQ_Verbose(expected_builder.Build(), display_list()));
+}
+
 TEST_F(ColorFilterLayerTest, Readback) {
   auto initial_transform = SkMatrix();
 
@@ -456,9 +499,11 @@ TEST_F(ColorFilterLayerTest, OpacityInheritance) {
   context->state_stack.set_preroll_delegate(initial_transform);
   color_filter_layer->Preroll(preroll_context());
   // ColorFilterLayer can always inherit opacity whether or not their
-  // children are compatible.
+  // children are compatible. This filter can also be composed with an
+  // outer matrix filter.
   EXPECT_EQ(context->renderable_state_flags,
-            LayerStateStack::kCallerCanApplyOpacity);
+            LayerStateStack::kCallerCanApplyOpacity |
+                LayerStateStack::kCallerCanApplyMatrixColorFilter);
 
   int opacity_alpha = 0x7F;
   SkPoint offset = SkPoint::Make(10, 10);
@@ -4,10 +4,121 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <optional>
+#include <thread>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
 
 namespace flutter {
 
+namespace {
+
+// A task has to preroll at least this many children to be worth posting.
+constexpr size_t kMinChildrenPerTask = 4;
+
+// The preroll of a child on its own copy of the context of its container, so
+// that the children can be prerolled concurrently.
+struct ChildPreroll {
+  ChildPreroll(Layer* p_layer, const PrerollContext& parent)
+      : layer(p_layer),
+        context{
+            // clang-format off
+            .raster_cache                  = parent.raster_cache,
+            .gr_context                    = parent.gr_context,
+            .view_embedder                 = parent.view_embedder,
+            .state_stack                   = state_stack,
+            .dst_color_space               = parent.dst_color_space,
+            .surface_needs_readback        = parent.surface_needs_readback,
+            .raster_time                   = parent.raster_time,
+            .ui_time                       = parent.ui_time,
+            .texture_registry              = parent.texture_registry,
+            .impeller_enabled              = parent.impeller_enabled,
+            .raster_cached_entries         = parent.raster_cached_entries
+                                                 ? &raster_cached_entries
+                                                 : nullptr,
+            .pointer_late_latch_offset     = parent.pointer_late_latch_offset,
+            .reuse_retained_prerolls       = parent.reuse_retained_prerolls,
+            .raster_cache_warm_up_offset   = parent.raster_cache_warm_up_offset,
+            // clang-format on
+        } {
+    // Prerolls only read the transform and the cull rect of the stack, as
+    // long as there is no view embedder to give the mutators to.
+    state_stack.set_preroll_delegate(parent.state_stack.device_cull_rect(),
+                                     parent.state_stack.transform_4x4());
+    if (parent.raster_cache) {
+      raster_cache_seen_recorder.emplace(*parent.raster_cache);
+      context.raster_cache_seen_recorder = &raster_cache_seen_recorder.value();
+    }
+  }
+
+  Layer* const layer;
+  LayerStateStack state_stack;
+  std::vector<RasterCacheItem*> raster_cached_entries;
+  std::optional<RasterCache::SeenRecorder> raster_cache_seen_recorder;
+  // Children of the child are prerolled on this thread, as it isn't given the
+  // concurrent task runner.
+  PrerollContext context;
+};
+
+// Shared with the tasks, which may only start after the children are
+// prerolled. They then find no child left to preroll and don't touch them.
+struct ConcurrentPreroll {
+  ConcurrentPreroll(const std::vector<std::shared_ptr<Layer>>& layers,
+                    const PrerollContext& context)
+      : remaining(layers.size()) {
+    children.reserve(layers.size());
+    for (const auto& layer : layers) {
+      children.push_back(std::make_unique<ChildPreroll>(layer.get(), context));
+    }
+  }
+
+  void PrerollChildren() {
+    const size_t count = children.size();
+    for (size_t i = next_index++; i < count; i = next_index++) {
+      children[i]->layer->PrerollOrReuse(&children[i]->context);
+      remaining.CountDown();
+    }
+  }
+
+  std::vector<std::unique_ptr<ChildPreroll>> children;
+  std::atomic<size_t> next_index = 0;
+  fml::CountDownLatch remaining;
+};
+
+// Prerolls |layers| on copies of |context| on tasks posted to its concurrent
+// task runner as well as on this thread, or returns nullptr if they should be
+// prerolled one after the other instead.
+std::shared_ptr<ConcurrentPreroll> PrerollConcurrently(
+    const std::vector<std::shared_ptr<Layer>>& layers,
+    const PrerollContext& context) {
+  const size_t task_count =
+      context.concurrent_task_runner
+          ? std::min<size_t>(std::thread::hardware_concurrency(),
+                             layers.size() / kMinChildrenPerTask)
+          : 0;
+  if (task_count == 0) {
+    return nullptr;
+  }
+  FML_DCHECK(!context.view_embedder);
+  FML_DCHECK(!context.raster_cache_seen_recorder);
+  TRACE_EVENT0("flutter", "PrerollChildrenConcurrently");
+
+  auto preroll = std::make_shared<ConcurrentPreroll>(layers, context);
+  for (size_t i = 0; i < task_count; i++) {
+    context.concurrent_task_runner->PostTask([preroll]() {
+      TRACE_EVENT0("flutter", "PrerollChildrenTask");
+      preroll->PrerollChildren();
+    });
+  }
+  preroll->PrerollChildren();
+  preroll->remaining.Wait();
+  return preroll;
+}
+
+}  // namespace
+
 ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
 
 void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
@@ -136,21 +247,50 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  // Whether this layer's own |Preroll| allowed it to be reused so far.
+  bool preroll_is_reusable = context->preroll_is_reusable;
+
+  // The children prerolled concurrently, whose results are merged into
+  // |context| below in the order of the children, so that they are the same
+  // as if the children had been prerolled one after the other.
+  std::shared_ptr<ConcurrentPreroll> concurrent_preroll =
+      PrerollConcurrently(layers_, *context);
+
+  for (size_t i = 0; i < layers_.size(); i++) {
+    const auto& layer = layers_[i];
+    PrerollContext* child_context = context;
+    if (concurrent_preroll) {
+      ChildPreroll& child = *concurrent_preroll->children[i];
+      child_context = &child.context;
+      context->surface_needs_readback =
+          context->surface_needs_readback ||
+          child_context->surface_needs_readback;
+      if (context->raster_cached_entries) {
+        context->raster_cached_entries->insert(
+            context->raster_cached_entries->end(),
+            child.raster_cached_entries.begin(),
+            child.raster_cached_entries.end());
+      }
+      if (child.raster_cache_seen_recorder) {
+        child.raster_cache_seen_recorder->Apply();
+      }
+    } else {
+      // Reset context->has_platform_view and context->has_texture_layer to
+      // false so that layers aren't treated as if they have a platform view or
+      // texture layer based on one being previously found in a sibling tree.
+      context->has_platform_view = false;
+      context->has_texture_layer = false;
 
-  for (auto& layer : layers_) {
-    // Reset context->has_platform_view and context->has_texture_layer to false
-    // so that layers aren't treated as if they have a platform view or texture
-    // layer based on one being previously found in a sibling tree.
-    context->has_platform_view = false;
-    context->has_texture_layer = false;
-
-    // Initialize the renderable state flags to false to force the layer to
-    // opt-in to applying state attributes during its |Preroll|
-    context->renderable_state_flags = 0;
+      // Initialize the renderable state flags to false to force the layer to
+      // opt-in to applying state attributes during its |Preroll|
+      context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+      layer->PrerollOrReuse(context);
+    }
+    preroll_is_reusable =
+        preroll_is_reusable && child_context->preroll_is_reusable;
 
-    all_renderable_state_flags &= context->renderable_state_flags;
+    all_renderable_state_flags &= child_context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
       // This will allow inheritance by a linear sequence of non-overlapping
       // children, but will fail with a grid or other arbitrary 2D layout.
@@ -160,14 +300,15 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     child_paint_bounds->join(layer->paint_bounds());
 
     child_has_platform_view =
-        child_has_platform_view || context->has_platform_view;
+        child_has_platform_view || child_context->has_platform_view;
     child_has_texture_layer =
-        child_has_texture_layer || context->has_texture_layer;
+        child_has_texture_layer || child_context->has_texture_layer;
   }
 
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   context->renderable_state_flags = all_renderable_state_flags;
+  context->preroll_is_reusable = preroll_is_reusable;
   set_subtree_has_platform_view(child_has_platform_view);
   set_children_renderable_state_flags(all_renderable_state_flags);
   set_child_paint_bounds(*child_paint_bounds);
@@ -189,7 +330,7 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
     if (layer->needs_painting(context)) {
-      layer->Paint(context);
+      layer->PaintOrReplay(context);
     }
   }
 }
@@ -9,6 +9,7 @@
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "gtest/gtest.h"
 #include "include/core/SkMatrix.h"
@@ -254,6 +255,88 @@ TEST_F(ContainerLayerTest, NeedsSystemComposite) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
 }
 
+TEST_F(ContainerLayerTest, ReusesPrerollOfRetainedLayers) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  mock_layer->set_fake_opacity_compatible(true);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  preroll_context()->reuse_retained_prerolls = true;
+  preroll_context()->state_stack.set_preroll_delegate(SkMatrix::I());
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->preroll_is_reusable);
+  EXPECT_FALSE(preroll_context()->surface_needs_readback);
+
+  // The mock layer would now report a readback if it was prerolled again.
+  mock_layer->set_fake_reads_surface(true);
+  preroll_context()->renderable_state_flags = 0;
+  layer->Preroll(preroll_context());
+  EXPECT_FALSE(preroll_context()->surface_needs_readback);
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+
+  // A different transform prerolls the subtree again.
+  preroll_context()->state_stack.set_preroll_delegate(
+      SkMatrix::Translate(10.0f, 0.0f));
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+}
+
+TEST_F(ContainerLayerTest, DoesNotReusePrerollOfPlatformViews) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  mock_layer->set_fake_has_platform_view(true);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  preroll_context()->reuse_retained_prerolls = true;
+  preroll_context()->state_stack.set_preroll_delegate(SkMatrix::I());
+  layer->Preroll(preroll_context());
+  EXPECT_FALSE(preroll_context()->preroll_is_reusable);
+
+  mock_layer->set_fake_reads_surface(true);
+  preroll_context()->has_platform_view = false;
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+}
+
+TEST_F(ContainerLayerTest, ReplaysPaintOfRetainedLayers) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  DlPaint child_paint = DlPaint(DlColor::kGreen());
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  preroll_context()->reuse_retained_prerolls = true;
+  preroll_context()->state_stack.set_preroll_delegate(SkMatrix::I());
+  display_list_paint_context().replay_retained_paints = true;
+
+  // The first frame paints the child as it hasn't been retained yet.
+  layer->Preroll(preroll_context());
+  layer->Paint(display_list_paint_context());
+  DisplayListBuilder expected_builder;
+  expected_builder.DrawPath(child_path, child_paint);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
+
+  // Later frames record the child once and replay that recording.
+  reset_display_list();
+  layer->Preroll(preroll_context());
+  layer->Paint(display_list_paint_context());
+  layer->Preroll(preroll_context());
+  layer->Paint(display_list_paint_context());
+  DisplayListBuilder recording_builder(kDlBounds);
+  recording_builder.DrawPath(child_path, child_paint);
+  auto recording = recording_builder.Build();
+  expected_builder.DrawDisplayList(recording);
+  expected_builder.DrawDisplayList(recording);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
+}
+
 TEST_F(ContainerLayerTest, RasterCacheTest) {
   // LTRB
   const SkPath child_path1 = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
@@ -560,6 +643,141 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+namespace {
+
+// What the preroll of a frame of the tree of |PrerollConcurrentFrames| left in
+// its layers, its context and the raster cache.
+struct PrerollFrame {
+  std::vector<SkRect> paint_bounds;
+  std::vector<SkMatrix> leaf_matrices;
+  std::vector<SkRect> leaf_cull_rects;
+  std::vector<std::optional<RasterCacheKeyID>> cached_ids;
+  std::vector<RasterCacheItem::CacheState> cache_states;
+  int renderable_state_flags;
+  bool surface_needs_readback;
+  size_t cached_layer_count;
+};
+
+}  // namespace
+
+// Prerolls several frames of a row of cells, each made of a cacheable layer and
+// an opacity compatible layer in a cacheable container, with |task_runner| as
+// the concurrent task runner of the preroll context.
+static std::vector<PrerollFrame> PrerollConcurrentFrames(
+    LayerTest& test,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+    bool use_raster_cache) {
+  std::vector<std::shared_ptr<Layer>> layers;
+  std::vector<std::shared_ptr<MockLayer>> leaves;
+  auto root = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < 12; i++) {
+    auto cell = MockCacheableContainerLayer::CacheLayerOrChildren();
+    auto cacheable = std::make_shared<MockCacheableLayer>(
+        SkPath().addRect(i * 10.0f, 0.0f, i * 10.0f + 4.0f, 8.0f), DlPaint(),
+        i % 3);
+    auto opaque = MockLayer::MakeOpacityCompatible(
+        SkPath().addRect(i * 10.0f + 5.0f, 0.0f, i * 10.0f + 9.0f, 8.0f));
+    // One of the cells reads the surface, and the last ones are culled.
+    opaque->set_fake_reads_surface(i == 5);
+    cell->Add(cacheable);
+    cell->Add(opaque);
+    root->Add(cell);
+    layers.insert(layers.end(), {cell, cacheable, opaque});
+    leaves.insert(leaves.end(), {cacheable, opaque});
+  }
+
+  if (use_raster_cache) {
+    test.use_mock_raster_cache();
+  } else {
+    test.use_null_raster_cache();
+  }
+  PrerollContext* context = test.preroll_context();
+  context->concurrent_task_runner = task_runner;
+  context->state_stack.set_preroll_delegate(SkRect::MakeLTRB(0, 0, 200, 20),
+                                            SkMatrix::Scale(2.0f, 2.0f));
+  std::vector<PrerollFrame> frames;
+  for (int frame = 0; frame < 5; frame++) {
+    if (context->raster_cache) {
+      context->raster_cache->BeginFrame();
+    }
+    context->raster_cached_entries->clear();
+    context->surface_needs_readback = false;
+    root->Preroll(context);
+    if (context->raster_cache) {
+      context->raster_cache->EvictUnusedCacheEntries();
+      LayerTree::TryToRasterCache(*context->raster_cached_entries,
+                                  &test.paint_context());
+      context->raster_cache->EndFrame();
+    }
+
+    PrerollFrame result = {
+        .renderable_state_flags = root->children_renderable_state_flags(),
+        .surface_needs_readback = context->surface_needs_readback,
+        .cached_layer_count =
+            context->raster_cache
+                ? context->raster_cache->GetLayerCachedEntriesCount()
+                : 0u,
+    };
+    for (const auto& layer : layers) {
+      result.paint_bounds.push_back(layer->paint_bounds());
+    }
+    for (const auto& leaf : leaves) {
+      result.leaf_matrices.push_back(leaf->parent_matrix());
+      result.leaf_cull_rects.push_back(leaf->parent_cull_rect());
+    }
+    for (const RasterCacheItem* item : *context->raster_cached_entries) {
+      result.cached_ids.push_back(item->GetId());
+      result.cache_states.push_back(item->cache_state());
+    }
+    frames.push_back(std::move(result));
+  }
+  context->concurrent_task_runner = nullptr;
+  return frames;
+}
+
+TEST_F(ContainerLayerTest, ConcurrentPrerollMatchesSequentialPreroll) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  for (bool use_raster_cache : {false, true}) {
+    std::vector<PrerollFrame> sequential =
+        PrerollConcurrentFrames(*this, nullptr, use_raster_cache);
+    std::vector<PrerollFrame> concurrent = PrerollConcurrentFrames(
+        *this, loop->GetTaskRunner(), use_raster_cache);
+    ASSERT_EQ(sequential.size(), concurrent.size());
+    for (size_t i = 0; i < sequential.size(); i++) {
+      EXPECT_EQ(sequential[i].paint_bounds, concurrent[i].paint_bounds);
+      EXPECT_EQ(sequential[i].leaf_matrices, concurrent[i].leaf_matrices);
+      EXPECT_EQ(sequential[i].leaf_cull_rects, concurrent[i].leaf_cull_rects);
+      EXPECT_EQ(sequential[i].cached_ids, concurrent[i].cached_ids);
+      EXPECT_EQ(sequential[i].cache_states, concurrent[i].cache_states);
+      EXPECT_EQ(sequential[i].renderable_state_flags,
+                concurrent[i].renderable_state_flags);
+      EXPECT_EQ(sequential[i].surface_needs_readback,
+                concurrent[i].surface_needs_readback);
+      EXPECT_EQ(sequential[i].cached_layer_count,
+                concurrent[i].cached_layer_count);
+    }
+    // The cells are cached once they have been prerolled for long enough.
+    EXPECT_GT(concurrent.back().cached_layer_count, 0u);
+    EXPECT_TRUE(concurrent.back().surface_needs_readback);
+  }
+}
+
+TEST_F(ContainerLayerTest, ConcurrentPrerollIsRepeatable) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  std::vector<PrerollFrame> first =
+      PrerollConcurrentFrames(*this, loop->GetTaskRunner(), true);
+  for (int i = 0; i < 10; i++) {
+    std::vector<PrerollFrame> again =
+        PrerollConcurrentFrames(*this, loop->GetTaskRunner(), true);
+    ASSERT_EQ(first.size(), again.size());
+    for (size_t j = 0; j < first.size(); j++) {
+      EXPECT_EQ(first[j].paint_bounds, again[j].paint_bounds);
+      EXPECT_EQ(first[j].cached_ids, again[j].cached_ids);
+      EXPECT_EQ(first[j].cache_states, again[j].cache_states);
+    }
+  }
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
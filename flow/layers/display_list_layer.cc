@@ -137,6 +137,18 @@ void DisplayListLayer::Paint(PaintContext& context) const {
         return;
       }
     }
+
+    // Display lists much larger than the screen are drawn from tiles that
+    // are reused while panning and zooming.
+    auto& tile_cache = context.raster_cache->tile_cache();
+    const DlCanvas& canvas = *context.canvas;
+    if (!will_change_ &&
+        tile_cache.ShouldDrawTiled(*display_list_, canvas.GetTransform(),
+                                   canvas.GetDestinationClipBounds()) &&
+        tile_cache.Draw(context, display_list_,
+                        context.state_stack.outstanding_opacity())) {
+      return;
+    }
   }
 
   SkScalar opacity = context.state_stack.outstanding_opacity();
@@ -9,6 +9,7 @@
 
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/serialization/dl_serialization.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/raster_cache_item.h"
@@ -22,7 +23,8 @@ static bool IsDisplayListWorthRasterizing(
     const DisplayList* display_list,
     bool will_change,
     bool is_complex,
-    DisplayListComplexityCalculator* complexity_calculator) {
+    DisplayListComplexityCalculator* complexity_calculator,
+    std::optional<unsigned int>& complexity_score) {
   if (will_change) {
     // If the display list is going to change in the future, there is no point
     // in doing to extra work to rasterize.
@@ -42,8 +44,8 @@ static bool IsDisplayListWorthRasterizing(
     return true;
   }
 
-  unsigned int complexity_score = complexity_calculator->Compute(display_list);
-  return complexity_calculator->ShouldBeCached(complexity_score);
+  complexity_score = complexity_calculator->ComputeCached(display_list);
+  return complexity_calculator->ShouldBeCached(complexity_score.value());
 }
 
 DisplayListRasterCacheItem::DisplayListRasterCacheItem(
@@ -71,13 +73,16 @@ std::unique_ptr<DisplayListRasterCacheItem> DisplayListRasterCacheItem::Make(
 void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
+  warming_up_ = false;
+  complexity_score_ = std::nullopt;
   DisplayListComplexityCalculator* complexity_calculator =
       context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
                                 context->gr_context->backend())
                           : DisplayListComplexityCalculator::GetForSoftware();
 
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
-                                     complexity_calculator)) {
+                                     complexity_calculator,
+                                     complexity_score_)) {
     // We only deal with display lists that are worthy of rasterization.
     return;
   }
@@ -97,6 +102,19 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
   return;
 }
 
+// Whether |bounds| come into view while the content is scrolled by the warm-up
+// offset of |context|.
+static bool IsScrollingIntoView(const PrerollContext& context,
+                                const SkRect& bounds) {
+  const SkVector& offset = context.raster_cache_warm_up_offset;
+  if (offset.isZero()) {
+    return false;
+  }
+  SkRect device_bounds = context.state_stack.transform_3x3().mapRect(bounds);
+  device_bounds.join(device_bounds.makeOffset(offset.fX, offset.fY));
+  return device_bounds.intersects(context.state_stack.device_cull_rect());
+}
+
 void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
                                                  const SkMatrix& matrix) {
   if (cache_state_ == CacheState::kNone || !context->raster_cache ||
@@ -106,9 +124,12 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   auto* raster_cache = context->raster_cache;
   SkRect bounds = display_list_->bounds().makeOffset(offset_.x(), offset_.y());
   bool visible = !context->state_stack.content_culled(bounds);
-  RasterCache::CacheInfo cache_info =
-      raster_cache->MarkSeen(key_id_, matrix, visible);
-  if (!visible ||
+  // Display lists about to scroll into view are counted as if they were
+  // visible, so that they are cached by the time they are.
+  bool warming_up = !visible && IsScrollingIntoView(*context, bounds);
+  RasterCache::CacheInfo cache_info = context->MarkRasterCacheEntrySeen(
+      key_id_, matrix, visible || warming_up);
+  if (!(visible || warming_up) ||
       cache_info.accesses_since_visible <= raster_cache->access_threshold()) {
     cache_state_ = kNone;
   } else {
@@ -117,6 +138,7 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
           LayerStateStack::kCallerCanApplyOpacity;
     }
     cache_state_ = kCurrent;
+    warming_up_ = warming_up;
   }
   return;
 }
@@ -156,14 +178,21 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       !context.raster_cache->GenerateNewCacheInThisFrame() || !id.has_value()) {
     return false;
   }
+  if (context.raster_cache->disk_store() && !content_hash_computed_) {
+    content_hash_ = DlSerializer::ComputeStableHash(*display_list_);
+    content_hash_computed_ = true;
+  }
   SkRect bounds = display_list_->bounds().makeOffset(offset_.x(), offset_.y());
   RasterCache::Context r_context = {
       // clang-format off
       .gr_context         = context.gr_context,
+      .aiks_context       = context.aiks_context,
       .dst_color_space    = context.dst_color_space,
       .matrix             = transformation_matrix_,
       .logical_rect       = bounds,
       .flow_type          = flow_type,
+      .complexity_score   = complexity_score_,
+      .content_hash       = content_hash_,
       // clang-format on
   };
   return context.raster_cache->UpdateCacheEntry(
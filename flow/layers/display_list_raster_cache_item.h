@@ -55,6 +55,11 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  // Only computed when caching isn't forced by |is_complex_|.
+  std::optional<unsigned int> complexity_score_;
+  // Only computed for raster caches with a disk store.
+  mutable std::optional<uint64_t> content_hash_;
+  mutable bool content_hash_computed_ = false;
 };
 
 }  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/layer.h"
 
+#include "flutter/display_list/dl_builder.h"
 #include "flutter/flow/paint_utils.h"
 
 namespace flutter {
@@ -16,6 +17,102 @@ Layer::Layer()
 
 Layer::~Layer() = default;
 
+void Layer::PrerollOrReuse(PrerollContext* context) {
+  PrerollResult result = {
+      .transform = context->state_stack.transform_4x4(),
+      .device_cull_rect = context->state_stack.device_cull_rect(),
+      .has_raster_cache = context->raster_cache != nullptr,
+      .surface_needed_readback = context->surface_needs_readback,
+      .pointer_late_latch_offset = context->pointer_late_latch_offset,
+  };
+  if (context->reuse_retained_prerolls && last_preroll_.has_value() &&
+      last_preroll_->transform == result.transform &&
+      last_preroll_->device_cull_rect == result.device_cull_rect &&
+      last_preroll_->has_raster_cache == result.has_raster_cache &&
+      last_preroll_->surface_needed_readback ==
+          result.surface_needed_readback &&
+      last_preroll_->pointer_late_latch_offset ==
+          result.pointer_late_latch_offset) {
+    context->renderable_state_flags = last_preroll_->renderable_state_flags;
+    context->surface_needs_readback = last_preroll_->surface_needs_readback;
+    context->preroll_is_reusable = true;
+    preroll_was_reused_ = true;
+    return;
+  }
+
+  last_preroll_.reset();
+  preroll_was_reused_ = false;
+  const size_t raster_cached_entry_count =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0u;
+  context->preroll_is_reusable = true;
+  Preroll(context);
+
+  // Raster cache entries must be registered again every frame.
+  const bool registered_raster_cache_entries =
+      context->raster_cached_entries &&
+      context->raster_cached_entries->size() != raster_cached_entry_count;
+  context->preroll_is_reusable =
+      context->preroll_is_reusable && !registered_raster_cache_entries &&
+      !context->has_platform_view && !context->has_texture_layer;
+  if (context->preroll_is_reusable) {
+    result.renderable_state_flags = context->renderable_state_flags;
+    result.surface_needs_readback = context->surface_needs_readback;
+    last_preroll_ = result;
+  }
+}
+
+void Layer::PaintOrReplay(PaintContext& context) const {
+  // Outstanding filters would have to be applied to the recording with a
+  // saveLayer that the subtree might have avoided.
+  if (!context.replay_retained_paints || !preroll_was_reused_ ||
+      context.state_stack.outstanding_color_filter() ||
+      context.state_stack.outstanding_image_filter()) {
+    last_paint_.reset();
+    Paint(context);
+    return;
+  }
+
+  const SkM44 transform = context.state_stack.transform_4x4();
+  const SkRect device_cull_rect = context.state_stack.device_cull_rect();
+  if (!last_paint_.has_value() || last_paint_->transform != transform ||
+      last_paint_->device_cull_rect != device_cull_rect) {
+    TRACE_EVENT0("flutter", "Layer::RecordPaint");
+    DisplayListBuilder builder(context.state_stack.local_cull_rect());
+    LayerStateStack state_stack;
+    state_stack.set_delegate(&builder);
+    PaintContext recording_context = {
+        // clang-format off
+        .state_stack                   = state_stack,
+        .canvas                        = &builder,
+        .gr_context                    = context.gr_context,
+        .dst_color_space               = context.dst_color_space,
+        .view_embedder                 = context.view_embedder,
+        .raster_time                   = context.raster_time,
+        .ui_time                       = context.ui_time,
+        .texture_registry              = context.texture_registry,
+        .raster_cache                  = context.raster_cache,
+        .impeller_enabled              = context.impeller_enabled,
+        .aiks_context                  = context.aiks_context,
+        // clang-format on
+    };
+    Paint(recording_context);
+    last_paint_ = {
+        .transform = transform,
+        .device_cull_rect = device_cull_rect,
+        .display_list = builder.Build(),
+    };
+  }
+
+  const SkScalar opacity = context.state_stack.outstanding_opacity();
+  if (opacity < SK_Scalar1 &&
+      !last_paint_->display_list->can_apply_group_opacity()) {
+    Paint(context);
+    return;
+  }
+  context.canvas->DrawDisplayList(last_paint_->display_list, opacity);
+}
+
 uint64_t Layer::NextUniqueID() {
   static std::atomic<uint64_t> next_id(1);
   uint64_t id;
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -22,6 +23,7 @@
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -84,6 +86,45 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // How far, in physical pixels, the late latched pointer moved since the
+  // frame was built. Applied by the layers that are late latched.
+  SkVector pointer_late_latch_offset = SkVector::Make(0, 0);
+
+  // Whether |Layer::PrerollOrReuse| may restore the results of the last
+  // |Preroll| of a layer retained from a previous frame instead of prerolling
+  // its subtree again.
+  bool reuse_retained_prerolls = false;
+
+  // Whether the |Preroll| of the subtree that was just visited only updated
+  // state kept by its layers, so that it can be skipped when the subtree is
+  // prerolled again under the same conditions. Layers whose |Preroll| has
+  // other effects, like notifying the view embedder, clear it.
+  bool preroll_is_reusable = true;
+
+  // Set when the children of containers may be prerolled concurrently on
+  // tasks posted to this runner. See |ContainerLayer::PrerollChildren|.
+  std::shared_ptr<fml::BasicTaskRunner> concurrent_task_runner;
+
+  // Set while a subtree is prerolled concurrently with its siblings, when the
+  // raster cache may only be read.
+  RasterCache::SeenRecorder* raster_cache_seen_recorder = nullptr;
+
+  // How far, in device pixels, the content being prerolled is expected to
+  // scroll before the display lists that start to come into view are cached.
+  // See |RasterCache::PredictScrollOffset|.
+  SkVector raster_cache_warm_up_offset = SkVector::Make(0, 0);
+
+  // Marks a raster cache entry as seen, through |raster_cache_seen_recorder|
+  // if it is set. See |RasterCache::MarkSeen|.
+  RasterCache::CacheInfo MarkRasterCacheEntrySeen(const RasterCacheKeyID& id,
+                                                  const SkMatrix& matrix,
+                                                  bool visible) const {
+    if (raster_cache_seen_recorder) {
+      return raster_cache_seen_recorder->MarkSeen(id, matrix, visible);
+    }
+    return raster_cache->MarkSeen(id, matrix, visible);
+  }
 };
 
 struct PaintContext {
@@ -120,7 +161,13 @@ struct PaintContext {
   LayerSnapshotStore* layer_snapshot_store = nullptr;
   bool enable_leaf_layer_tracing = false;
   bool impeller_enabled = false;
-  impeller::AiksContext* aiks_context;
+  impeller::AiksContext* aiks_context = nullptr;
+
+  // Whether |Layer::PaintOrReplay| may draw a recording of the last |Paint|
+  // of a layer whose preroll was reused instead of painting its subtree
+  // again. Only valid when nothing the layers paint depends on the raster
+  // cache or on state that isn't kept in the recording.
+  bool replay_retained_paints = false;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -169,6 +216,12 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Calls |Preroll|, unless the layer was last prerolled with the same
+  // transform, cull rect and context settings and its whole subtree only
+  // updated state that the layers keep. Retained layers are immutable, so the
+  // results of that |Preroll| are restored to |context| instead.
+  void PrerollOrReuse(PrerollContext* context);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -197,6 +250,12 @@ class Layer {
 
   virtual void Paint(PaintContext& context) const = 0;
 
+  // Calls |Paint|, unless the preroll of the layer was reused and
+  // |context.replay_retained_paints| is set. The subtree is then recorded
+  // into a display list once and that display list is drawn instead, as
+  // long as the layer is painted with the same transform and cull rect.
+  void PaintOrReplay(PaintContext& context) const;
+
   virtual void PaintChildren(PaintContext& context) const { FML_DCHECK(false); }
 
   bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
@@ -265,10 +324,32 @@ class Layer {
   virtual const testing::MockLayer* as_mock_layer() const { return nullptr; }
 
  private:
+  // The conditions of a |Preroll| and the results it left in the context.
+  struct PrerollResult {
+    SkM44 transform;
+    SkRect device_cull_rect;
+    bool has_raster_cache;
+    bool surface_needed_readback;
+    SkVector pointer_late_latch_offset;
+
+    int renderable_state_flags;
+    bool surface_needs_readback;
+  };
+
+  // A recording of the subtree and the conditions it was painted under.
+  struct PaintRecording {
+    SkM44 transform;
+    SkRect device_cull_rect;
+    sk_sp<DisplayList> display_list;
+  };
+
   SkRect paint_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_;
+  std::optional<PrerollResult> last_preroll_;
+  bool preroll_was_reused_ = false;
+  mutable std::optional<PaintRecording> last_paint_;
 
   static uint64_t NextUniqueID();
 
@@ -54,7 +54,7 @@ void LayerRasterCacheItem::PrerollFinalize(PrerollContext* context,
   if (num_cache_attempts_ >= layer_cached_threshold_) {
     // the layer can be cached
     cache_state_ = CacheState::kCurrent;
-    context->raster_cache->MarkSeen(key_id_, matrix_, true);
+    context->MarkRasterCacheEntrySeen(key_id_, matrix_, true);
   } else {
     num_cache_attempts_++;
     // access current layer
@@ -68,8 +68,8 @@ void LayerRasterCacheItem::PrerollFinalize(PrerollContext* context,
                                    RasterCacheKeyType::kLayerChildren);
       }
       cache_state_ = CacheState::kChildren;
-      context->raster_cache->MarkSeen(layer_children_id_.value(), matrix_,
-                                      true);
+      context->MarkRasterCacheEntrySeen(layer_children_id_.value(), matrix_,
+                                        true);
     }
   }
 }
@@ -118,6 +118,8 @@ bool Rasterize(RasterCacheItem::CacheState cache_state,
       .ui_time                       = paint_context.ui_time,
       .texture_registry              = paint_context.texture_registry,
       .raster_cache                  = paint_context.raster_cache,
+      .impeller_enabled              = paint_context.impeller_enabled,
+      .aiks_context                  = paint_context.aiks_context,
       // clang-format on
   };
 
@@ -149,6 +151,7 @@ bool LayerRasterCacheItem::TryToPrepareRasterCache(const PaintContext& context,
       RasterCache::Context r_context = {
           // clang-format off
           .gr_context         = context.gr_context,
+          .aiks_context       = context.aiks_context,
           .dst_color_space    = context.dst_color_space,
           .matrix             = matrix_,
           .logical_rect       = *paint_bounds,
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/layer_state_stack.h"
 
+#include <variant>
+
 #include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
@@ -137,6 +139,8 @@ class PrerollDelegate : public LayerStateStack::Delegate {
  public:
   PrerollDelegate(const SkRect& cull_rect, const SkMatrix& matrix)
       : tracker_(cull_rect, matrix) {}
+  PrerollDelegate(const SkRect& cull_rect, const SkM44& matrix)
+      : tracker_(cull_rect, matrix) {}
 
   void decommission() override {}
 
@@ -194,33 +198,44 @@ class PrerollDelegate : public LayerStateStack::Delegate {
 // StateEntry subclasses
 // ==============================================================
 
-class SaveEntry : public LayerStateStack::StateEntry {
+// Supplies the behavior shared by most entries. The entries are stored by
+// value in a std::variant, so they are dispatched statically and only need
+// to hide the methods they implement differently.
+template <typename Entry>
+class BasicStateEntry {
+ public:
+  void reapply(LayerStateStack* stack) const {
+    static_cast<const Entry*>(this)->apply(stack);
+  }
+  void restore(LayerStateStack* stack) const {}
+  void update_mutators(MutatorsStack* mutators_stack) const {}
+};
+
+class SaveEntry : public BasicStateEntry<SaveEntry> {
  public:
   SaveEntry() = default;
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->save();
   }
-  void restore(LayerStateStack* stack) const override {
+  void restore(LayerStateStack* stack) const {
     stack->delegate_->restore();
   }
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(SaveEntry);
 };
 
-class SaveLayerEntry : public LayerStateStack::StateEntry {
+class SaveLayerEntry : public BasicStateEntry<SaveLayerEntry> {
  public:
   SaveLayerEntry(const SkRect& bounds,
                  DlBlendMode blend_mode,
                  const LayerStateStack::RenderingAttributes& prev)
       : bounds_(bounds), blend_mode_(blend_mode), old_attributes_(prev) {}
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->saveLayer(bounds_, stack->outstanding_, blend_mode_,
                                 nullptr);
     stack->outstanding_ = {};
   }
-  void restore(LayerStateStack* stack) const override {
+  void restore(LayerStateStack* stack) const {
     if (stack->checkerboard_func_) {
       DlCanvas* canvas = stack->canvas_delegate();
       if (canvas != nullptr) {
@@ -232,14 +247,12 @@ class SaveLayerEntry : public LayerStateStack::StateEntry {
   }
 
  protected:
-  const SkRect bounds_;
-  const DlBlendMode blend_mode_;
-  const LayerStateStack::RenderingAttributes old_attributes_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(SaveLayerEntry);
+  SkRect bounds_;
+  DlBlendMode blend_mode_;
+  LayerStateStack::RenderingAttributes old_attributes_;
 };
 
-class OpacityEntry : public LayerStateStack::StateEntry {
+class OpacityEntry : public BasicStateEntry<OpacityEntry> {
  public:
   OpacityEntry(const SkRect& bounds,
                SkScalar opacity,
@@ -249,28 +262,26 @@ class OpacityEntry : public LayerStateStack::StateEntry {
         old_opacity_(prev.opacity),
         old_bounds_(prev.save_layer_bounds) {}
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->outstanding_.save_layer_bounds = bounds_;
     stack->outstanding_.opacity *= opacity_;
   }
-  void restore(LayerStateStack* stack) const override {
+  void restore(LayerStateStack* stack) const {
     stack->outstanding_.save_layer_bounds = old_bounds_;
     stack->outstanding_.opacity = old_opacity_;
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
+  void update_mutators(MutatorsStack* mutators_stack) const {
     mutators_stack->PushOpacity(DlColor::toAlpha(opacity_));
   }
 
  private:
-  const SkRect bounds_;
-  const SkScalar opacity_;
-  const SkScalar old_opacity_;
-  const SkRect old_bounds_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(OpacityEntry);
+  SkRect bounds_;
+  SkScalar opacity_;
+  SkScalar old_opacity_;
+  SkRect old_bounds_;
 };
 
-class ImageFilterEntry : public LayerStateStack::StateEntry {
+class ImageFilterEntry : public BasicStateEntry<ImageFilterEntry> {
  public:
   ImageFilterEntry(const SkRect& bounds,
                    const std::shared_ptr<const DlImageFilter>& filter,
@@ -279,30 +290,27 @@ class ImageFilterEntry : public LayerStateStack::StateEntry {
         filter_(filter),
         old_filter_(prev.image_filter),
         old_bounds_(prev.save_layer_bounds) {}
-  ~ImageFilterEntry() override = default;
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->outstanding_.save_layer_bounds = bounds_;
     stack->outstanding_.image_filter = filter_;
   }
-  void restore(LayerStateStack* stack) const override {
+  void restore(LayerStateStack* stack) const {
     stack->outstanding_.save_layer_bounds = old_bounds_;
     stack->outstanding_.image_filter = old_filter_;
   }
 
   // There is no ImageFilter mutator currently
-  // void update_mutators(MutatorsStack* mutators_stack) const override;
+  // void update_mutators(MutatorsStack* mutators_stack) const;
 
  private:
-  const SkRect bounds_;
-  const std::shared_ptr<const DlImageFilter> filter_;
-  const std::shared_ptr<const DlImageFilter> old_filter_;
-  const SkRect old_bounds_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(ImageFilterEntry);
+  SkRect bounds_;
+  std::shared_ptr<const DlImageFilter> filter_;
+  std::shared_ptr<const DlImageFilter> old_filter_;
+  SkRect old_bounds_;
 };
 
-class ColorFilterEntry : public LayerStateStack::StateEntry {
+class ColorFilterEntry : public BasicStateEntry<ColorFilterEntry> {
  public:
   ColorFilterEntry(const SkRect& bounds,
                    const std::shared_ptr<const DlColorFilter>& filter,
@@ -311,27 +319,24 @@ class ColorFilterEntry : public LayerStateStack::StateEntry {
         filter_(filter),
         old_filter_(prev.color_filter),
         old_bounds_(prev.save_layer_bounds) {}
-  ~ColorFilterEntry() override = default;
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->outstanding_.save_layer_bounds = bounds_;
     stack->outstanding_.color_filter = filter_;
   }
-  void restore(LayerStateStack* stack) const override {
+  void restore(LayerStateStack* stack) const {
     stack->outstanding_.save_layer_bounds = old_bounds_;
     stack->outstanding_.color_filter = old_filter_;
   }
 
   // There is no ColorFilter mutator currently
-  // void update_mutators(MutatorsStack* mutators_stack) const override;
+  // void update_mutators(MutatorsStack* mutators_stack) const;
 
  private:
-  const SkRect bounds_;
-  const std::shared_ptr<const DlColorFilter> filter_;
-  const std::shared_ptr<const DlColorFilter> old_filter_;
-  const SkRect old_bounds_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(ColorFilterEntry);
+  SkRect bounds_;
+  std::shared_ptr<const DlColorFilter> filter_;
+  std::shared_ptr<const DlColorFilter> old_filter_;
+  SkRect old_bounds_;
 };
 
 class BackdropFilterEntry : public SaveLayerEntry {
@@ -341,15 +346,14 @@ class BackdropFilterEntry : public SaveLayerEntry {
                       DlBlendMode blend_mode,
                       const LayerStateStack::RenderingAttributes& prev)
       : SaveLayerEntry(bounds, blend_mode, prev), filter_(filter) {}
-  ~BackdropFilterEntry() override = default;
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->saveLayer(bounds_, stack->outstanding_, blend_mode_,
                                 filter_.get());
     stack->outstanding_ = {};
   }
 
-  void reapply(LayerStateStack* stack) const override {
+  void reapply(LayerStateStack* stack) const {
     // On the reapply for subsequent overlay layers, we do not
     // want to reapply the backdrop filter, but we do need to
     // do a saveLayer to encapsulate the contents and match the
@@ -361,134 +365,155 @@ class BackdropFilterEntry : public SaveLayerEntry {
   }
 
  private:
-  const std::shared_ptr<const DlImageFilter> filter_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(BackdropFilterEntry);
+  std::shared_ptr<const DlImageFilter> filter_;
 };
 
-class TranslateEntry : public LayerStateStack::StateEntry {
+class TranslateEntry : public BasicStateEntry<TranslateEntry> {
  public:
   TranslateEntry(SkScalar tx, SkScalar ty) : tx_(tx), ty_(ty) {}
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->translate(tx_, ty_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
+  void update_mutators(MutatorsStack* mutators_stack) const {
     mutators_stack->PushTransform(SkMatrix::Translate(tx_, ty_));
   }
 
  private:
-  const SkScalar tx_;
-  const SkScalar ty_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TranslateEntry);
+  SkScalar tx_;
+  SkScalar ty_;
 };
 
-class TransformMatrixEntry : public LayerStateStack::StateEntry {
+class TransformMatrixEntry : public BasicStateEntry<TransformMatrixEntry> {
  public:
   explicit TransformMatrixEntry(const SkMatrix& matrix) : matrix_(matrix) {}
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->transform(matrix_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
+  void update_mutators(MutatorsStack* mutators_stack) const {
     mutators_stack->PushTransform(matrix_);
   }
 
  private:
-  const SkMatrix matrix_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TransformMatrixEntry);
+  SkMatrix matrix_;
 };
 
-class TransformM44Entry : public LayerStateStack::StateEntry {
+class TransformM44Entry : public BasicStateEntry<TransformM44Entry> {
  public:
   explicit TransformM44Entry(const SkM44& m44) : m44_(m44) {}
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->transform(m44_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
+  void update_mutators(MutatorsStack* mutators_stack) const {
     mutators_stack->PushTransform(m44_.asM33());
   }
 
  private:
-  const SkM44 m44_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TransformM44Entry);
+  SkM44 m44_;
 };
 
-class IntegralTransformEntry : public LayerStateStack::StateEntry {
+class IntegralTransformEntry : public BasicStateEntry<IntegralTransformEntry> {
  public:
   IntegralTransformEntry() = default;
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->integralTransform();
   }
-
- private:
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(IntegralTransformEntry);
 };
 
-class ClipRectEntry : public LayerStateStack::StateEntry {
+class ClipRectEntry : public BasicStateEntry<ClipRectEntry> {
  public:
   ClipRectEntry(const SkRect& clip_rect, bool is_aa)
       : clip_rect_(clip_rect), is_aa_(is_aa) {}
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->clipRect(clip_rect_, DlCanvas::ClipOp::kIntersect,
                                is_aa_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
+  void update_mutators(MutatorsStack* mutators_stack) const {
     mutators_stack->PushClipRect(clip_rect_);
   }
 
  private:
-  const SkRect clip_rect_;
-  const bool is_aa_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(ClipRectEntry);
+  SkRect clip_rect_;
+  bool is_aa_;
 };
 
-class ClipRRectEntry : public LayerStateStack::StateEntry {
+class ClipRRectEntry : public BasicStateEntry<ClipRRectEntry> {
  public:
   ClipRRectEntry(const SkRRect& clip_rrect, bool is_aa)
       : clip_rrect_(clip_rrect), is_aa_(is_aa) {}
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->clipRRect(clip_rrect_, DlCanvas::ClipOp::kIntersect,
                                 is_aa_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
+  void update_mutators(MutatorsStack* mutators_stack) const {
     mutators_stack->PushClipRRect(clip_rrect_);
   }
 
  private:
-  const SkRRect clip_rrect_;
-  const bool is_aa_;
-
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(ClipRRectEntry);
+  SkRRect clip_rrect_;
+  bool is_aa_;
 };
 
-class ClipPathEntry : public LayerStateStack::StateEntry {
+class ClipPathEntry : public BasicStateEntry<ClipPathEntry> {
  public:
   ClipPathEntry(const SkPath& clip_path, bool is_aa)
       : clip_path_(clip_path), is_aa_(is_aa) {}
-  ~ClipPathEntry() override = default;
 
-  void apply(LayerStateStack* stack) const override {
+  void apply(LayerStateStack* stack) const {
     stack->delegate_->clipPath(clip_path_, DlCanvas::ClipOp::kIntersect,
                                is_aa_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
+  void update_mutators(MutatorsStack* mutators_stack) const {
     mutators_stack->PushClipPath(clip_path_);
   }
 
  private:
-  const SkPath clip_path_;
-  const bool is_aa_;
+  SkPath clip_path_;
+  bool is_aa_;
+};
+
+class LayerStateStack::StateEntry {
+ public:
+  template <typename Entry>
+  explicit StateEntry(Entry entry) : entry_(std::move(entry)) {}
+
+  void apply(LayerStateStack* stack) const {
+    std::visit([stack](const auto& entry) { entry.apply(stack); }, entry_);
+  }
+  void reapply(LayerStateStack* stack) const {
+    std::visit([stack](const auto& entry) { entry.reapply(stack); }, entry_);
+  }
+  void restore(LayerStateStack* stack) const {
+    std::visit([stack](const auto& entry) { entry.restore(stack); }, entry_);
+  }
+  void update_mutators(MutatorsStack* mutators_stack) const {
+    std::visit(
+        [mutators_stack](const auto& entry) {
+          entry.update_mutators(mutators_stack);
+        },
+        entry_);
+  }
 
-  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(ClipPathEntry);
+ private:
+  std::variant<SaveEntry,
+               SaveLayerEntry,
+               OpacityEntry,
+               ImageFilterEntry,
+               ColorFilterEntry,
+               BackdropFilterEntry,
+               TranslateEntry,
+               TransformMatrixEntry,
+               TransformM44Entry,
+               IntegralTransformEntry,
+               ClipRectEntry,
+               ClipRRectEntry,
+               ClipPathEntry>
+      entry_;
 };
 
 // ==============================================================
@@ -614,7 +639,27 @@ void MutatorContext::clipPath(const SkPath& path, bool is_aa) {
 // LayerStateStack methods
 // ==============================================================
 
-LayerStateStack::LayerStateStack() : delegate_(DummyDelegate::kInstance) {}
+// Deep enough for most layer trees, so that their stacks don't need to grow
+// while they are painted.
+static constexpr size_t kStateStackReserve = 16;
+
+LayerStateStack::LayerStateStack() : delegate_(DummyDelegate::kInstance) {
+  state_stack_.reserve(kStateStackReserve);
+}
+
+LayerStateStack::~LayerStateStack() = default;
+
+bool LayerStateStack::is_empty() const {
+  return state_stack_.empty();
+}
+
+size_t LayerStateStack::stack_count() const {
+  return state_stack_.size();
+}
+
+void LayerStateStack::apply_last_entry() {
+  state_stack_.back().apply(this);
+}
 
 void LayerStateStack::clear_delegate() {
   delegate_->decommission();
@@ -646,6 +691,12 @@ void LayerStateStack::set_preroll_delegate(const SkRect& cull_rect,
   delegate_ = std::make_shared<PrerollDelegate>(cull_rect, matrix);
   reapply_all();
 }
+void LayerStateStack::set_preroll_delegate(const SkRect& cull_rect,
+                                           const SkM44& matrix) {
+  clear_delegate();
+  delegate_ = std::make_shared<PrerollDelegate>(cull_rect, matrix);
+  reapply_all();
+}
 
 void LayerStateStack::reapply_all() {
   // We use a local RenderingAttributes instance so that it can track the
@@ -656,20 +707,20 @@ void LayerStateStack::reapply_all() {
   RenderingAttributes attributes = outstanding_;
   outstanding_ = {};
   for (auto& state : state_stack_) {
-    state->reapply(this);
+    state.reapply(this);
   }
   FML_DCHECK(attributes == outstanding_);
 }
 
 void LayerStateStack::fill(MutatorsStack* mutators) {
   for (auto& state : state_stack_) {
-    state->update_mutators(mutators);
+    state.update_mutators(mutators);
   }
 }
 
 void LayerStateStack::restore_to_count(size_t restore_count) {
   while (state_stack_.size() > restore_count) {
-    state_stack_.back()->restore(this);
+    state_stack_.back().restore(this);
     state_stack_.pop_back();
   }
 }
@@ -677,16 +728,19 @@ void LayerStateStack::restore_to_count(size_t restore_count) {
 void LayerStateStack::push_opacity(const SkRect& bounds, SkScalar opacity) {
   maybe_save_layer(opacity);
   state_stack_.emplace_back(
-      std::make_unique<OpacityEntry>(bounds, opacity, outstanding_));
+      OpacityEntry(bounds, opacity, outstanding_));
   apply_last_entry();
 }
 
 void LayerStateStack::push_color_filter(
     const SkRect& bounds,
     const std::shared_ptr<const DlColorFilter>& filter) {
-  maybe_save_layer(filter);
+  std::shared_ptr<const DlColorFilter> composed = compose_color_filter(filter);
+  if (!composed) {
+    maybe_save_layer(filter);
+  }
   state_stack_.emplace_back(
-      std::make_unique<ColorFilterEntry>(bounds, filter, outstanding_));
+      ColorFilterEntry(bounds, composed ? composed : filter, outstanding_));
   apply_last_entry();
 }
 
@@ -695,7 +749,7 @@ void LayerStateStack::push_image_filter(
     const std::shared_ptr<const DlImageFilter>& filter) {
   maybe_save_layer(filter);
   state_stack_.emplace_back(
-      std::make_unique<ImageFilterEntry>(bounds, filter, outstanding_));
+      ImageFilterEntry(bounds, filter, outstanding_));
   apply_last_entry();
 }
 
@@ -703,46 +757,54 @@ void LayerStateStack::push_backdrop(
     const SkRect& bounds,
     const std::shared_ptr<const DlImageFilter>& filter,
     DlBlendMode blend_mode) {
-  state_stack_.emplace_back(std::make_unique<BackdropFilterEntry>(
+  state_stack_.emplace_back(BackdropFilterEntry(
       bounds, filter, blend_mode, outstanding_));
   apply_last_entry();
 }
 
 void LayerStateStack::push_translate(SkScalar tx, SkScalar ty) {
-  state_stack_.emplace_back(std::make_unique<TranslateEntry>(tx, ty));
+  state_stack_.emplace_back(TranslateEntry(tx, ty));
   apply_last_entry();
 }
 
 void LayerStateStack::push_transform(const SkM44& m44) {
-  state_stack_.emplace_back(std::make_unique<TransformM44Entry>(m44));
+  state_stack_.emplace_back(TransformM44Entry(m44));
   apply_last_entry();
 }
 
 void LayerStateStack::push_transform(const SkMatrix& matrix) {
-  state_stack_.emplace_back(std::make_unique<TransformMatrixEntry>(matrix));
+  state_stack_.emplace_back(TransformMatrixEntry(matrix));
   apply_last_entry();
 }
 
 void LayerStateStack::push_integral_transform() {
-  state_stack_.emplace_back(std::make_unique<IntegralTransformEntry>());
+  state_stack_.emplace_back(IntegralTransformEntry());
   apply_last_entry();
 }
 
 void LayerStateStack::push_clip_rect(const SkRect& rect, bool is_aa) {
-  state_stack_.emplace_back(std::make_unique<ClipRectEntry>(rect, is_aa));
+  state_stack_.emplace_back(ClipRectEntry(rect, is_aa));
   apply_last_entry();
 }
 
 void LayerStateStack::push_clip_rrect(const SkRRect& rrect, bool is_aa) {
-  state_stack_.emplace_back(std::make_unique<ClipRRectEntry>(rrect, is_aa));
+  state_stack_.emplace_back(ClipRRectEntry(rrect, is_aa));
   apply_last_entry();
 }
 
 void LayerStateStack::push_clip_path(const SkPath& path, bool is_aa) {
-  state_stack_.emplace_back(std::make_unique<ClipPathEntry>(path, is_aa));
+  state_stack_.emplace_back(ClipPathEntry(path, is_aa));
   apply_last_entry();
 }
 
+// Whether |filter| can be composed with a matrix color filter applied
+// before it. The composed filter is then applied by a saveLayer with the
+// bounds of the inner filter, which is only the same if the outer filter
+// leaves the transparent pixels around those bounds alone.
+static bool IsComposableOuterColorFilter(const DlColorFilter& filter) {
+  return filter.asMatrix() != nullptr && !filter.modifies_transparent_black();
+}
+
 bool LayerStateStack::needs_save_layer(int flags) const {
   if (outstanding_.opacity < SK_Scalar1 &&
       (flags & LayerStateStack::kCallerCanApplyOpacity) == 0) {
@@ -753,19 +815,21 @@ bool LayerStateStack::needs_save_layer(int flags) const {
     return true;
   }
   if (outstanding_.color_filter &&
-      (flags & LayerStateStack::kCallerCanApplyColorFilter) == 0) {
+      (flags & LayerStateStack::kCallerCanApplyColorFilter) == 0 &&
+      !((flags & LayerStateStack::kCallerCanApplyMatrixColorFilter) != 0 &&
+        IsComposableOuterColorFilter(*outstanding_.color_filter))) {
     return true;
   }
   return false;
 }
 
 void LayerStateStack::do_save() {
-  state_stack_.emplace_back(std::make_unique<SaveEntry>());
+  state_stack_.emplace_back(SaveEntry());
   apply_last_entry();
 }
 
 void LayerStateStack::save_layer(const SkRect& bounds) {
-  state_stack_.emplace_back(std::make_unique<SaveLayerEntry>(
+  state_stack_.emplace_back(SaveLayerEntry(
       bounds, DlBlendMode::kSrcOver, outstanding_));
   apply_last_entry();
 }
@@ -812,6 +876,23 @@ void LayerStateStack::maybe_save_layer(
   }
 }
 
+std::shared_ptr<const DlColorFilter> LayerStateStack::compose_color_filter(
+    const std::shared_ptr<const DlColorFilter>& filter) const {
+  if (!outstanding_.color_filter || outstanding_.image_filter ||
+      !IsComposableOuterColorFilter(*outstanding_.color_filter)) {
+    return nullptr;
+  }
+  if (outstanding_.opacity < SK_Scalar1 &&
+      !filter->can_commute_with_opacity()) {
+    return nullptr;
+  }
+  const DlMatrixColorFilter* inner = filter->asMatrix();
+  if (inner == nullptr || !inner->can_compose_with_outer()) {
+    return nullptr;
+  }
+  return inner->compose_with_outer(*outstanding_.color_filter->asMatrix());
+}
+
 void LayerStateStack::maybe_save_layer(
     const std::shared_ptr<const DlImageFilter>& filter) {
   if (outstanding_.image_filter) {
@@ -105,6 +105,7 @@ namespace flutter {
 class LayerStateStack {
  public:
   LayerStateStack();
+  ~LayerStateStack();
 
   // Clears out any old delegate to make room for a new one.
   void clear_delegate();
@@ -124,6 +125,7 @@ class LayerStateStack {
   // that only one delegate - either a DlCanvas or a preroll accumulator -
   // is present at any one time.
   void set_preroll_delegate(const SkRect& cull_rect, const SkMatrix& matrix);
+  void set_preroll_delegate(const SkRect& cull_rect, const SkM44& matrix);
   void set_preroll_delegate(const SkRect& cull_rect);
   void set_preroll_delegate(const SkMatrix& matrix);
 
@@ -233,9 +235,12 @@ class LayerStateStack {
   static constexpr int kCallerCanApplyOpacity = 0x1;
   static constexpr int kCallerCanApplyColorFilter = 0x2;
   static constexpr int kCallerCanApplyImageFilter = 0x4;
+  // The caller can fold an outstanding matrix color filter into its own
+  // matrix color filter, rather than any color filter.
+  static constexpr int kCallerCanApplyMatrixColorFilter = 0x8;
   static constexpr int kCallerCanApplyAnything =
       (kCallerCanApplyOpacity | kCallerCanApplyColorFilter |
-       kCallerCanApplyImageFilter);
+       kCallerCanApplyImageFilter | kCallerCanApplyMatrixColorFilter);
 
   // Apply the outstanding state via saveLayer if necessary,
   // respecting the flags representing which potentially
@@ -322,14 +327,14 @@ class LayerStateStack {
 
   // Returns true if the state stack is in, or has returned to,
   // its initial state.
-  bool is_empty() const { return state_stack_.empty(); }
+  bool is_empty() const;
 
  private:
-  size_t stack_count() const { return state_stack_.size(); }
+  size_t stack_count() const;
   void restore_to_count(size_t restore_count);
   void reapply_all();
 
-  void apply_last_entry() { state_stack_.back()->apply(this); }
+  void apply_last_entry();
 
   // The push methods simply push an associated StateEntry on the stack
   // and then apply it to the current canvas and builder.
@@ -371,6 +376,11 @@ class LayerStateStack {
   void maybe_save_layer(const std::shared_ptr<const DlImageFilter>& filter);
   // ---------------------
 
+  // Returns the outstanding color filter followed by |filter| as a single
+  // filter, or nullptr if they can't be combined without a saveLayer.
+  std::shared_ptr<const DlColorFilter> compose_color_filter(
+      const std::shared_ptr<const DlColorFilter>& filter) const;
+
   struct RenderingAttributes {
     // We need to record the last bounds we received for the last
     // attribute that we recorded so that we can perform a saveLayer
@@ -398,20 +408,10 @@ class LayerStateStack {
     }
   };
 
-  class StateEntry {
-   public:
-    virtual ~StateEntry() = default;
-
-    virtual void apply(LayerStateStack* stack) const = 0;
-    virtual void reapply(LayerStateStack* stack) const { apply(stack); }
-    virtual void restore(LayerStateStack* stack) const {}
-    virtual void update_mutators(MutatorsStack* mutators_stack) const {}
-
-   protected:
-    StateEntry() = default;
-
-    FML_DISALLOW_COPY_ASSIGN_AND_MOVE(StateEntry);
-  };
+  // Holds one of the entry types defined in layer_state_stack.cc by value,
+  // so that pushing state doesn't allocate once the stack has grown to the
+  // depth of the layer tree.
+  class StateEntry;
   friend class SaveEntry;
   friend class SaveLayerEntry;
   friend class BackdropFilterEntry;
@@ -471,7 +471,7 @@ class LayerStateStack {
   friend class DlCanvasDelegate;
   friend class PrerollDelegate;
 
-  std::vector<std::unique_ptr<StateEntry>> state_stack_;
+  std::vector<StateEntry> state_stack_;
   friend class MutatorContext;
 
   std::shared_ptr<Delegate> delegate_;
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <functional>
+
 #include "gtest/gtest.h"
 
 #include "flutter/display_list/effects/dl_color_filter.h"
@@ -549,5 +551,33 @@ TEST(LayerStateStack, ColorFilterAndImageFilterInteraction) {
   ASSERT_EQ(state_stack.outstanding_color_filter(), nullptr);
 }
 
+TEST(LayerStateStack, DeepStacksAreRestored) {
+  // Deeper than the stack reserves up front, so that the entries are moved
+  // when it grows.
+  constexpr int kDepth = 100;
+  LayerStateStack state_stack;
+  state_stack.set_preroll_delegate(kGiantRect, SkMatrix::I());
+
+  std::function<void(int)> push_translates = [&](int depth) {
+    if (depth == kDepth) {
+      ASSERT_EQ(state_stack.transform_3x3(), SkMatrix::Translate(kDepth, 0));
+      MutatorsStack mutators;
+      state_stack.fill(&mutators);
+      ASSERT_EQ(std::distance(mutators.Begin(), mutators.End()), 2 * kDepth);
+      return;
+    }
+    auto mutator = state_stack.save();
+    mutator.translate(1, 0);
+    mutator.applyOpacity(SkRect::MakeWH(10, 10), 0.5);
+    push_translates(depth + 1);
+    ASSERT_EQ(state_stack.transform_3x3(), SkMatrix::Translate(depth + 1, 0));
+  };
+  push_translates(0);
+
+  ASSERT_TRUE(state_stack.is_empty());
+  ASSERT_EQ(state_stack.transform_3x3(), SkMatrix::I());
+  ASSERT_EQ(state_stack.outstanding_opacity(), SK_Scalar1);
+}
+
 }  // namespace testing
 }  // namespace flutter
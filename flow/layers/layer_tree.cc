@@ -62,6 +62,14 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .texture_registry              = frame.context().texture_registry(),
       .impeller_enabled              = !frame.gr_context(),
       .raster_cached_entries         = &raster_cache_items_,
+      .pointer_late_latch_offset     = pointer_late_latch_offset_,
+      .reuse_retained_prerolls       = true,
+      // The view embedder has to be told about the platform views in the
+      // order of the tree.
+      .concurrent_task_runner        =
+          frame.view_embedder()
+              ? nullptr
+              : frame.context().concurrent_preroll_task_runner(),
       // clang-format on
   };
 
@@ -70,15 +78,26 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
   return context.surface_needs_readback;
 }
 
+void LayerTree::LatchPointer() {
+  if (pointer_late_latch_) {
+    pointer_late_latch_offset_ =
+        pointer_late_latch_->GetOffsetSince(pointer_late_latch_sample_);
+  }
+}
+
 void LayerTree::TryToRasterCache(
     const std::vector<RasterCacheItem*>& raster_cached_items,
     const PaintContext* paint_context,
     bool ignore_raster_cache) {
+  std::vector<RasterCacheItem*> warm_up_items;
   unsigned i = 0;
   const auto item_size = raster_cached_items.size();
   while (i < item_size) {
     auto* item = raster_cached_items[i];
-    if (item->need_caching()) {
+    if (item->need_caching() && item->warming_up()) {
+      // Cached after the visible items, if the frame has time left.
+      warm_up_items.push_back(item);
+    } else if (item->need_caching()) {
       // try to cache current layer
       // If parent failed to cache, just proceed to the next entry
       // cache current entry, this entry's parent must not cache
@@ -96,6 +115,14 @@ void LayerTree::TryToRasterCache(
     }
     i++;
   }
+
+  for (auto* item : warm_up_items) {
+    if (!paint_context->raster_cache ||
+        !paint_context->raster_cache->HasWarmUpTime()) {
+      break;
+    }
+    item->TryToPrepareRasterCache(*paint_context, false);
+  }
 }
 
 void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
@@ -142,6 +169,10 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       .enable_leaf_layer_tracing     = enable_leaf_layer_tracing_,
       .impeller_enabled              = !!frame.aiks_context(),
       .aiks_context                  = frame.aiks_context(),
+      // Impeller has no raster cache, so retained subtrees are replayed from
+      // display lists instead.
+      .replay_retained_paints        = !!frame.aiks_context() && !cache &&
+                                       !enable_leaf_layer_tracing_,
       // clang-format on
   };
 
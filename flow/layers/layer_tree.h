@@ -11,6 +11,7 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/pointer_late_latch.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
@@ -79,6 +80,24 @@ class LayerTree {
     return enable_leaf_layer_tracing_;
   }
 
+  /// Makes the late latched layers of the tree follow the pointer that
+  /// |latch| tracks, from where the framework saw it when the tree was built.
+  void set_pointer_late_latch(std::shared_ptr<const PointerLateLatch> latch,
+                              PointerLateLatch::Sample framework_sample) {
+    pointer_late_latch_ = std::move(latch);
+    pointer_late_latch_sample_ = framework_sample;
+  }
+
+  /// Reads how far the latched pointer moved since the tree was built. Must
+  /// be called on the raster thread right before the tree is rasterized.
+  void LatchPointer();
+
+  /// The offset applied to the late latched layers, as of the last call to
+  /// |LatchPointer|.
+  const SkVector& pointer_late_latch_offset() const {
+    return pointer_late_latch_offset_;
+  }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
@@ -86,6 +105,9 @@ class LayerTree {
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
   bool enable_leaf_layer_tracing_ = false;
+  std::shared_ptr<const PointerLateLatch> pointer_late_latch_;
+  PointerLateLatch::Sample pointer_late_latch_sample_;
+  SkVector pointer_late_latch_offset_ = SkVector::Make(0, 0);
 
   PaintRegionMap paint_region_map_;
 
@@ -39,7 +39,10 @@ class PerformanceOverlayLayer : public Layer {
   explicit PerformanceOverlayLayer(uint64_t options,
                                    const char* font_path = nullptr);
 
-  void Preroll(PrerollContext* context) override {}
+  // The overlay paints new timings every frame.
+  void Preroll(PrerollContext* context) override {
+    context->preroll_is_reusable = false;
+  }
   void Paint(PaintContext& context) const override;
 
  private:
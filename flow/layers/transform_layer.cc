@@ -8,7 +8,8 @@
 
 namespace flutter {
 
-TransformLayer::TransformLayer(const SkM44& transform) : transform_(transform) {
+TransformLayer::TransformLayer(const SkM44& transform)
+    : transform_(transform), latched_transform_(transform) {
   // Checks (in some degree) that SkM44 transform_ is valid and initialized.
   //
   // If transform_ is uninitialized, this assert may look flaky as it doesn't
@@ -22,6 +23,7 @@ TransformLayer::TransformLayer(const SkM44& transform) : transform_(transform) {
   if (!transform_.isFinite()) {
     FML_LOG(ERROR) << "TransformLayer is constructed with an invalid matrix.";
     transform_.setIdentity();
+    latched_transform_.setIdentity();
   }
 }
 
@@ -40,11 +42,37 @@ void TransformLayer::Diff(DiffContext* context, const Layer* old_layer) {
 }
 
 void TransformLayer::Preroll(PrerollContext* context) {
+  latched_transform_ = transform_;
+  const SkVector& pointer_offset = context->pointer_late_latch_offset;
+  SkMatrix inverse_parent_transform;
+  if (pointer_late_latched_ && !pointer_offset.isZero() &&
+      context->state_stack.transform_3x3().invert(&inverse_parent_transform)) {
+    // The offset is in physical pixels, while the transform of this layer is
+    // in the coordinates of its parent.
+    const SkVector local_offset = inverse_parent_transform.mapVector(
+        pointer_offset.fX, pointer_offset.fY);
+    latched_transform_ =
+        SkM44::Translate(local_offset.fX, local_offset.fY) * transform_;
+  }
+
   auto mutator = context->state_stack.save();
-  mutator.transform(transform_);
+  mutator.transform(latched_transform_);
+
+  // Lets the raster cache warm up for the display lists that the movement of
+  // this layer, such as scrolling, is about to bring into view.
+  const SkVector warm_up_offset = context->raster_cache_warm_up_offset;
+  if (context->raster_cache && context->raster_cache->warm_up_enabled()) {
+    const SkMatrix matrix = context->state_stack.transform_3x3();
+    const SkVector offset = context->raster_cache->PredictScrollOffset(
+        original_layer_id(), {matrix.getTranslateX(), matrix.getTranslateY()});
+    if (!offset.isZero()) {
+      context->raster_cache_warm_up_offset = offset;
+    }
+  }
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, &child_paint_bounds);
+  context->raster_cache_warm_up_offset = warm_up_offset;
 
   // We convert to a 3x3 matrix here primarily because the SkM44 object
   // does not support a mapRect operation.
@@ -61,7 +89,7 @@ void TransformLayer::Preroll(PrerollContext* context) {
   // is otherwise optimal for non-perspective matrices. If SkM44 ever exposes
   // a mapRect operation, or if SkMatrix ever optimizes its handling of
   // the perspective elements, this issue will become moot.
-  transform_.asM33().mapRect(&child_paint_bounds);
+  latched_transform_.asM33().mapRect(&child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
 }
 
@@ -69,7 +97,7 @@ void TransformLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   auto mutator = context.state_stack.save();
-  mutator.transform(transform_);
+  mutator.transform(latched_transform_);
 
   PaintChildren(context);
 }
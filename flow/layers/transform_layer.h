@@ -23,8 +23,21 @@ class TransformLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  /// Whether the layer also moves by the distance the latched pointer moved
+  /// between the build of the frame and its rasterization.
+  ///
+  /// @see |PointerLateLatch|
+  bool pointer_late_latched() const { return pointer_late_latched_; }
+  void set_pointer_late_latched(bool late_latched) {
+    pointer_late_latched_ = late_latched;
+  }
+
  private:
   SkM44 transform_;
+  bool pointer_late_latched_ = false;
+  // The transform including the late latched pointer offset of the frame
+  // being rasterized.
+  SkM44 latched_transform_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TransformLayer);
 };
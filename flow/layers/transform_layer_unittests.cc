@@ -119,6 +119,52 @@ TEST_F(TransformLayerTest, Simple) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
 }
 
+TEST_F(TransformLayerTest, LateLatchedPointerOffset) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkMatrix initial_transform = SkMatrix::Scale(2.0f, 2.0f);
+  SkMatrix layer_transform = SkMatrix::Translate(2.5f, 2.5f);
+  // The pointer offset is in physical pixels, so it is halved by the scale
+  // above the layer.
+  SkMatrix latched_transform =
+      SkMatrix::Concat(SkMatrix::Translate(5.0f, 2.0f), layer_transform);
+
+  auto mock_layer = std::make_shared<MockLayer>(child_path, DlPaint());
+  auto layer = std::make_shared<TransformLayer>(layer_transform);
+  layer->set_pointer_late_latched(true);
+  layer->Add(mock_layer);
+
+  preroll_context()->state_stack.set_preroll_delegate(kGiantRect,
+                                                      initial_transform);
+  preroll_context()->pointer_late_latch_offset = SkVector::Make(10.0f, 4.0f);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(layer->paint_bounds(),
+            latched_transform.mapRect(mock_layer->paint_bounds()));
+  EXPECT_EQ(mock_layer->parent_matrix(),
+            SkMatrix::Concat(initial_transform, latched_transform));
+
+  layer->Paint(display_list_paint_context());
+  DisplayListBuilder expected_builder;
+  /* (Transform)layer::Paint */ {
+    expected_builder.Save();
+    {
+      expected_builder.Transform(latched_transform);
+      /* mock_layer::Paint */ {
+        expected_builder.DrawPath(child_path, DlPaint());
+      }
+    }
+    expected_builder.Restore();
+  }
+  EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
+
+  // Layers that aren't late latched ignore the offset.
+  auto other_layer = std::make_shared<TransformLayer>(layer_transform);
+  other_layer->Add(std::make_shared<MockLayer>(child_path, DlPaint()));
+  other_layer->Preroll(preroll_context());
+  EXPECT_EQ(other_layer->paint_bounds(),
+            layer_transform.mapRect(child_path.getBounds()));
+}
+
 TEST_F(TransformLayerTest, SimpleM44) {
   SkPath child_path;
   child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
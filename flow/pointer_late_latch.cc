@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/pointer_late_latch.h"
+
+namespace flutter {
+
+PointerLateLatch::PointerLateLatch() = default;
+
+PointerLateLatch::~PointerLateLatch() = default;
+
+void PointerLateLatch::Tracker::AddPointerEvent(Phase phase,
+                                                int64_t event_device,
+                                                SkPoint event_position) {
+  switch (phase) {
+    case Phase::kDown:
+      if (!device.has_value()) {
+        stroke++;
+        device = event_device;
+        position = event_position;
+      }
+      break;
+    case Phase::kMove:
+      if (device == event_device) {
+        position = event_position;
+      }
+      break;
+    case Phase::kUp:
+      if (device == event_device) {
+        device.reset();
+      }
+      break;
+  }
+}
+
+void PointerLateLatch::AddPointerEvent(Source source,
+                                       Phase phase,
+                                       int64_t device,
+                                       SkPoint position) {
+  std::scoped_lock lock(mutex_);
+  Tracker& tracker = source == Source::kPlatform ? platform_ : framework_;
+  tracker.AddPointerEvent(phase, device, position);
+}
+
+std::optional<PointerLateLatch::Sample> PointerLateLatch::GetFrameworkSample()
+    const {
+  std::scoped_lock lock(mutex_);
+  if (!framework_.device.has_value()) {
+    return std::nullopt;
+  }
+  return Sample{.stroke = framework_.stroke, .position = framework_.position};
+}
+
+SkVector PointerLateLatch::GetOffsetSince(const Sample& sample) const {
+  std::scoped_lock lock(mutex_);
+  if (!platform_.device.has_value() || platform_.stroke != sample.stroke) {
+    return SkVector::Make(0, 0);
+  }
+  return platform_.position - sample.position;
+}
+
+}  // namespace flutter
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_POINTER_LATE_LATCH_H_
+#define FLUTTER_FLOW_POINTER_LATE_LATCH_H_
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPoint.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Tracks how far a pointer moved between the events the framework
+///             saw when it built a frame and the newest events the platform
+///             delivered, so that the raster thread can move late latched
+///             layers by that distance right before the frame is drawn.
+///
+///             The first pointer that goes down is latched until it goes up.
+///             Both the platform and the framework side see the same pointer
+///             events in the same order, so the strokes they count match.
+///
+///             Events are added on the platform and UI threads, and the
+///             offset is read on the raster thread.
+///
+class PointerLateLatch {
+ public:
+  enum class Source {
+    /// The event was received from the platform.
+    kPlatform,
+    /// The event was delivered to the framework.
+    kFramework,
+  };
+
+  enum class Phase {
+    kDown,
+    kMove,
+    kUp,
+  };
+
+  /// The position of the latched pointer, in physical pixels, during a
+  /// stroke.
+  struct Sample {
+    uint64_t stroke = 0;
+    SkPoint position = SkPoint::Make(0, 0);
+  };
+
+  PointerLateLatch();
+
+  ~PointerLateLatch();
+
+  void AddPointerEvent(Source source,
+                       Phase phase,
+                       int64_t device,
+                       SkPoint position);
+
+  /// The position of the latched pointer that was last delivered to the
+  /// framework, or nullopt if no pointer is latched.
+  std::optional<Sample> GetFrameworkSample() const;
+
+  /// How far the latched pointer moved on the platform since |sample|. Zero
+  /// once the stroke of |sample| ended.
+  SkVector GetOffsetSince(const Sample& sample) const;
+
+ private:
+  struct Tracker {
+    uint64_t stroke = 0;
+    std::optional<int64_t> device;
+    SkPoint position = SkPoint::Make(0, 0);
+
+    void AddPointerEvent(Phase phase, int64_t device, SkPoint position);
+  };
+
+  mutable std::mutex mutex_;
+  Tracker platform_;
+  Tracker framework_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerLateLatch);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_POINTER_LATE_LATCH_H_
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/pointer_late_latch.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+using Phase = PointerLateLatch::Phase;
+using Source = PointerLateLatch::Source;
+
+namespace {
+// Adds the event on the platform side, and optionally on the framework side.
+void AddEvent(PointerLateLatch& latch,
+              Phase phase,
+              int64_t device,
+              SkPoint position,
+              bool delivered) {
+  latch.AddPointerEvent(Source::kPlatform, phase, device, position);
+  if (delivered) {
+    latch.AddPointerEvent(Source::kFramework, phase, device, position);
+  }
+}
+}  // namespace
+
+TEST(PointerLateLatchTest, OffsetFollowsUndeliveredMoves) {
+  PointerLateLatch latch;
+  EXPECT_FALSE(latch.GetFrameworkSample().has_value());
+
+  AddEvent(latch, Phase::kDown, 1, {10, 10}, true);
+  AddEvent(latch, Phase::kMove, 1, {15, 12}, true);
+  auto sample = latch.GetFrameworkSample();
+  ASSERT_TRUE(sample.has_value());
+  EXPECT_EQ(sample->position, SkPoint::Make(15, 12));
+  EXPECT_EQ(latch.GetOffsetSince(*sample), SkVector::Make(0, 0));
+
+  AddEvent(latch, Phase::kMove, 1, {20, 14}, false);
+  AddEvent(latch, Phase::kMove, 1, {25, 20}, false);
+  EXPECT_EQ(latch.GetOffsetSince(*sample), SkVector::Make(10, 8));
+
+  // Other pointers are ignored.
+  AddEvent(latch, Phase::kDown, 2, {90, 90}, false);
+  AddEvent(latch, Phase::kMove, 2, {95, 95}, false);
+  EXPECT_EQ(latch.GetOffsetSince(*sample), SkVector::Make(10, 8));
+}
+
+TEST(PointerLateLatchTest, OffsetIsZeroOnceTheStrokeEnded) {
+  PointerLateLatch latch;
+  AddEvent(latch, Phase::kDown, 1, {10, 10}, true);
+  auto sample = latch.GetFrameworkSample();
+  ASSERT_TRUE(sample.has_value());
+
+  AddEvent(latch, Phase::kMove, 1, {20, 10}, false);
+  AddEvent(latch, Phase::kUp, 1, {20, 10}, false);
+  EXPECT_EQ(latch.GetOffsetSince(*sample), SkVector::Make(0, 0));
+
+  // A new stroke doesn't move the content of the old one.
+  AddEvent(latch, Phase::kDown, 1, {50, 50}, false);
+  AddEvent(latch, Phase::kMove, 1, {60, 50}, false);
+  EXPECT_EQ(latch.GetOffsetSince(*sample), SkVector::Make(0, 0));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,15 +4,20 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <vector>
 
 #include "flutter/common/constants.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/frame_cost_ledger.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -22,8 +27,35 @@
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/aiks/aiks_context.h"               // nogncheck
+#include "flutter/impeller/aiks/picture.h"                    // nogncheck
+#include "flutter/impeller/display_list/dl_dispatcher.h"      // nogncheck
+#include "flutter/impeller/display_list/dl_image_impeller.h"  // nogncheck
+#include "flutter/impeller/renderer/texture_compressor.h"     // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
+// The complexity score per byte of image. Entries without a score are
+// treated as the most valuable.
+static double GetEvictionWeight(std::optional<unsigned int> complexity_score,
+                                size_t bytes) {
+  if (!complexity_score.has_value()) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return static_cast<double>(complexity_score.value()) /
+         std::max(bytes, static_cast<size_t>(1u));
+}
+
+static size_t EstimateImageBytes(const RasterCache::Context& context) {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  return static_cast<size_t>(dest_rect.width()) *
+         static_cast<size_t>(dest_rect.height()) * 4u;
+}
+
 RasterCacheResult::RasterCacheResult(sk_sp<DlImage> image,
                                      const SkRect& logical_rect,
                                      const char* type,
@@ -85,6 +117,13 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   SkRect dest_rect =
       RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
 
+#if IMPELLER_SUPPORTS_RENDERING
+  if (context.aiks_context) {
+    return RasterizeImpeller(context, dest_rect, matrix, std::move(rtree),
+                             draw_function);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   const SkImageInfo image_info =
       SkImageInfo::MakeN32Premul(dest_rect.width(), dest_rect.height(),
                                  sk_ref_sp(context.dst_color_space));
@@ -115,6 +154,72 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
       image, context.logical_rect, context.flow_type, std::move(rtree));
 }
 
+#if IMPELLER_SUPPORTS_RENDERING
+std::unique_ptr<RasterCacheResult> RasterCache::RasterizeImpeller(
+    const RasterCache::Context& context,
+    const SkRect& dest_rect,
+    const SkMatrix& matrix,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& draw_function) const {
+  auto size = impeller::ISize(dest_rect.width(), dest_rect.height());
+  if (size.IsEmpty()) {
+    return nullptr;
+  }
+
+  DisplayListBuilder builder(SkRect::MakeWH(size.width, size.height));
+  builder.Translate(-dest_rect.left(), -dest_rect.top());
+  builder.Transform(matrix);
+  draw_function(&builder);
+  // DrawCheckerboard is not supported on Impeller.
+  auto display_list = builder.Build();
+
+  impeller::DlDispatcher dispatcher(impeller::IRect::MakeSize(size));
+  display_list->DispatchInline(dispatcher);
+  auto picture = dispatcher.EndRecordingAsPicture();
+
+  // The picture is rendered into a texture of its own rather than one from
+  // the render target cache, as the entry outlives the frame.
+  auto image = picture.ToImage(*context.aiks_context, size);
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(
+      impeller::DlImageImpeller::Make(image->GetTexture(),
+                                      DlImage::OwningContext::kRaster),
+      context.logical_rect, context.flow_type, std::move(rtree));
+}
+
+std::unique_ptr<RasterCacheResult> RasterCache::LoadFromDiskStore(
+    const RasterCache::Context& context,
+    uint64_t disk_key,
+    sk_sp<const DlRTree> rtree) const {
+  std::optional<RasterCacheDiskStore::Image> saved =
+      disk_store_->Find(disk_key);
+  if (!saved.has_value()) {
+    return nullptr;
+  }
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  if (saved->size != SkISize::Make(dest_rect.width(), dest_rect.height())) {
+    return nullptr;
+  }
+
+  TRACE_EVENT0("flutter", "RasterCache::LoadFromDiskStore");
+  auto texture = impeller::TextureCompressor::Upload(
+      context.aiks_context->GetContext(),
+      impeller::ISize(saved->size.width(), saved->size.height()),
+      *saved->data);
+  if (!texture) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(
+      impeller::DlImageImpeller::Make(std::move(texture),
+                                      DlImage::OwningContext::kRaster),
+      context.logical_rect, context.flow_type, std::move(rtree));
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 bool RasterCache::UpdateCacheEntry(
     const RasterCacheKeyID& id,
     const Context& raster_cache_context,
@@ -123,7 +228,39 @@ bool RasterCache::UpdateCacheEntry(
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
   if (!entry.image) {
+#if IMPELLER_SUPPORTS_RENDERING
+    if (compress_after_frames_ > 0 && raster_cache_context.aiks_context) {
+      impeller_context_ = raster_cache_context.aiks_context->GetContext();
+    }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+    entry.complexity_score = raster_cache_context.complexity_score;
+    size_t bytes = EstimateImageBytes(raster_cache_context);
+    // Entries without a score may only take room from retained entries.
+    double weight = entry.complexity_score.has_value()
+                        ? GetEvictionWeight(entry.complexity_score, bytes)
+                        : 0.0;
+    if (!EvictToFit(bytes, weight)) {
+      return false;
+    }
+#if IMPELLER_SUPPORTS_RENDERING
+    if (disk_store_ && compress_after_frames_ > 0 &&
+        raster_cache_context.aiks_context &&
+        raster_cache_context.content_hash.has_value()) {
+      uint64_t disk_key = RasterCacheDiskStore::MakeKey(
+          raster_cache_context.content_hash.value(),
+          raster_cache_context.matrix);
+      entry.image = LoadFromDiskStore(raster_cache_context, disk_key, rtree);
+      if (entry.image) {
+        // Saved images are compressed already.
+        entry.compression_started = true;
+        return true;
+      }
+      entry.disk_key = disk_key;
+    }
+#endif  // IMPELLER_SUPPORTS_RENDERING
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
+    fml::ScopedFrameCost cost(
+        fml::FrameCostLedger::Category::kRasterCacheUpdate);
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
     if (entry.image != nullptr) {
@@ -144,7 +281,11 @@ bool RasterCache::UpdateCacheEntry(
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
-  RasterCacheKey key = RasterCacheKey(id, matrix);
+  return MarkSeen(RasterCacheKey(id, matrix), visible);
+}
+
+RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKey& key,
+                                             bool visible) const {
   Entry& entry = cache_[key];
   entry.encountered_this_frame = true;
   entry.visible_this_frame = visible;
@@ -154,7 +295,59 @@ RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
   return {entry.accesses_since_visible, entry.image != nullptr};
 }
 
-int RasterCache::GetAccessCount(const RasterCacheKeyID& id,
+RasterCache::SeenRecorder::SeenRecorder(const RasterCache& cache)
+    : cache_(cache) {}
+
+RasterCache::SeenRecorder::~SeenRecorder() = default;
+
+RasterCache::CacheInfo RasterCache::SeenRecorder::MarkSeen(
+    const RasterCacheKeyID& id,
+    const SkMatrix& matrix,
+    bool visible) {
+  RasterCacheKey key = RasterCacheKey(id, matrix);
+  auto access = accesses_.find(key);
+  if (access == accesses_.end()) {
+    Access cached = {0u, false};
+    auto entry = cache_.cache_.find(key);
+    if (entry != cache_.cache_.end()) {
+      cached = {entry->second.accesses_since_visible,
+                entry->second.image != nullptr};
+    }
+    access = accesses_.emplace(key, cached).first;
+  }
+  if (visible || access->second.accesses_since_visible > 0) {
+    access->second.accesses_since_visible++;
+  }
+  seen_.emplace_back(std::move(key), visible);
+  return {access->second.accesses_since_visible, access->second.has_image};
+}
+
+void RasterCache::SeenRecorder::Apply() const {
+  for (const auto& [key, visible] : seen_) {
+    cache_.MarkSeen(key, visible);
+  }
+}
+
+bool RasterCache::HasWarmUpTime() const {
+  return warm_up_deadline_.has_value() &&
+         fml::TimePoint::Now() < warm_up_deadline_.value();
+}
+
+SkVector RasterCache::PredictScrollOffset(uint64_t layer_id,
+                                          const SkVector& translation) const {
+  std::scoped_lock lock(scroll_translations_mutex_);
+  scroll_translations_[layer_id] = translation;
+  auto last = last_scroll_translations_.find(layer_id);
+  if (last == last_scroll_translations_.end()) {
+    return SkVector::Make(0, 0);
+  }
+  // Long enough for the display lists to be seen access_threshold_ + 1
+  // times, and so cached, a frame before they come into view.
+  const SkScalar frames = access_threshold_ + 2;
+  return (translation - last->second) * frames;
+}
+
+const RasterCacheKeyID& id,
                                 const SkMatrix& matrix) const {
   RasterCacheKey key = RasterCacheKey(id, matrix);
   auto entry = cache_.find(key);
@@ -194,41 +387,202 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
 void RasterCache::BeginFrame() {
   display_list_cached_this_frame_ = 0;
+  {
+    std::scoped_lock lock(scroll_translations_mutex_);
+    last_scroll_translations_ = std::move(scroll_translations_);
+    scroll_translations_.clear();
+  }
   picture_metrics_ = {};
   layer_metrics_ = {};
+  tile_cache_.BeginFrame();
 }
 
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    FML_DCHECK(entry.encountered_this_frame);
+    FML_DCHECK(entry.encountered_this_frame ||
+               entry.unused_frames <= max_unused_frames_);
     if (entry.image) {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.in_use_count++;
-      metrics.in_use_bytes += entry.image->image_bytes();
+      if (entry.encountered_this_frame) {
+        metrics.in_use_count++;
+        metrics.in_use_bytes += entry.image->image_bytes();
+      } else {
+        metrics.retained_count++;
+        metrics.retained_bytes += entry.image->image_bytes();
+      }
     }
     entry.encountered_this_frame = false;
   }
 }
 
 void RasterCache::EvictUnusedCacheEntries() {
-  std::vector<RasterCacheKey::Map<Entry>::iterator> dead;
+  std::vector<EntryIterator> dead;
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    if (!entry.encountered_this_frame) {
+    if (entry.encountered_this_frame) {
+      entry.unused_frames = 0;
+    } else if (++entry.unused_frames > max_unused_frames_) {
       dead.push_back(it);
     }
   }
 
   for (auto it : dead) {
-    if (it->second.image) {
-      RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.eviction_count++;
-      metrics.eviction_bytes += it->second.image->image_bytes();
+    Evict(it);
+  }
+
+  // The budget may have shrunk since the retained entries were cached.
+  EvictToFit(0u, 0.0);
+
+  tile_cache_.EvictUnusedTiles();
+
+  CompressCacheEntries();
+}
+
+void RasterCache::SetTextureCompression(
+    size_t compress_after_frames,
+    fml::RefPtr<fml::TaskRunner> encode_task_runner) {
+  compress_after_frames_ = encode_task_runner ? compress_after_frames : 0u;
+  compression_task_runner_ = std::move(encode_task_runner);
+}
+
+void RasterCache::SetDiskStore(
+    std::shared_ptr<RasterCacheDiskStore> disk_store) {
+  disk_store_ = std::move(disk_store);
+}
+
+void RasterCache::CompressCacheEntries() {
+#if IMPELLER_SUPPORTS_RENDERING
+  std::vector<CompressedImages::Image> compressed;
+  {
+    std::scoped_lock lock(compressed_images_->mutex);
+    compressed.swap(compressed_images_->images);
+  }
+  for (CompressedImages::Image& image : compressed) {
+    auto it = cache_.find(image.key);
+    // The entry may have been evicted, and cached again, in the meantime.
+    if (it != cache_.end() && it->second.image &&
+        it->second.image->image() == image.original) {
+      it->second.image->set_image(std::move(image.compressed));
     }
-    cache_.erase(it);
   }
+
+  if (compress_after_frames_ == 0 || !impeller_context_) {
+    return;
+  }
+  for (auto& [key, entry] : cache_) {
+    if (!entry.image || entry.compression_started ||
+        ++entry.frames_cached < compress_after_frames_) {
+      continue;
+    }
+    entry.compression_started = true;
+    const sk_sp<DlImage>& original = entry.image->image();
+    auto texture = original ? original->impeller_texture() : nullptr;
+    if (!texture ||
+        !impeller::TextureCompressor::CanCompress(*impeller_context_,
+                                                  *texture)) {
+      continue;
+    }
+    TRACE_EVENT0("flutter", "RasterCache::CompressCacheEntry");
+    const impeller::ISize size = texture->GetSize();
+    std::shared_ptr<RasterCacheDiskStore> disk_store =
+        entry.disk_key.has_value() ? disk_store_ : nullptr;
+    impeller::TextureCompressor::EncodeAsync(
+        impeller_context_, texture, compression_task_runner_,
+        [key = key, original, images = compressed_images_,
+         context = impeller_context_, size, disk_store,
+         disk_key = entry.disk_key](
+            const std::shared_ptr<fml::Mapping>& blocks) {
+          if (!blocks) {
+            return;
+          }
+          if (disk_store) {
+            disk_store->Store(disk_key.value(),
+                              SkISize::Make(size.width, size.height), blocks);
+          }
+          auto compressed_texture =
+              impeller::TextureCompressor::Upload(context, size, *blocks);
+          if (!compressed_texture) {
+            return;
+          }
+          std::scoped_lock lock(images->mutex);
+          images->images.push_back(
+              {key, original,
+               impeller::DlImageImpeller::Make(
+                   std::move(compressed_texture),
+                   DlImage::OwningContext::kRaster)});
+        });
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+bool RasterCache::EvictToFit(size_t bytes, double weight) const {
+  if (max_bytes_ == 0) {
+    return true;
+  }
+  if (bytes > max_bytes_) {
+    return false;
+  }
+
+  size_t cached_bytes = 0;
+  size_t evictable_bytes = 0;
+  std::vector<EntryIterator> candidates;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    const Entry& entry = it->second;
+    if (!entry.image) {
+      continue;
+    }
+    size_t image_bytes = entry.image->image_bytes();
+    cached_bytes += image_bytes;
+    if (!entry.encountered_this_frame ||
+        GetEvictionWeight(entry.complexity_score, image_bytes) < weight) {
+      candidates.push_back(it);
+      evictable_bytes += image_bytes;
+    }
+  }
+  if (cached_bytes + bytes <= max_bytes_) {
+    return true;
+  }
+  if (bytes > 0 && cached_bytes - evictable_bytes + bytes > max_bytes_) {
+    return false;
+  }
+
+  // Retained entries go first, then the least valuable and the oldest.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const EntryIterator& a, const EntryIterator& b) {
+              const Entry& a_entry = a->second;
+              const Entry& b_entry = b->second;
+              if (a_entry.encountered_this_frame !=
+                  b_entry.encountered_this_frame) {
+                return !a_entry.encountered_this_frame;
+              }
+              double a_weight = GetEvictionWeight(a_entry.complexity_score,
+                                                  a_entry.image->image_bytes());
+              double b_weight = GetEvictionWeight(b_entry.complexity_score,
+                                                  b_entry.image->image_bytes());
+              if (a_weight != b_weight) {
+                return a_weight < b_weight;
+              }
+              return a_entry.unused_frames > b_entry.unused_frames;
+            });
+  for (auto it : candidates) {
+    if (cached_bytes + bytes <= max_bytes_) {
+      break;
+    }
+    cached_bytes -= it->second.image->image_bytes();
+    Evict(it);
+  }
+  return cached_bytes + bytes <= max_bytes_;
+}
+
+void RasterCache::Evict(EntryIterator it) const {
+  if (it->second.image) {
+    RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
+    metrics.eviction_count++;
+    metrics.eviction_bytes += it->second.image->image_bytes();
+  }
+  cache_.erase(it);
 }
 
 void RasterCache::EndFrame() {
@@ -238,6 +592,7 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  tile_cache_.Clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -278,6 +633,14 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+void RasterCache::SetMaxUnusedFrames(size_t max_unused_frames) {
+  max_unused_frames_ = max_unused_frames;
+}
+
+void RasterCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+}
+
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER(
@@ -313,7 +676,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
@@ -6,13 +6,21 @@
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/display_list/dl_canvas.h"
+#include "flutter/flow/display_list_tile_cache.h"
+#include "flutter/flow/raster_cache_disk_store.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -20,6 +28,11 @@
 class GrDirectContext;
 class SkColorSpace;
 
+namespace impeller {
+class AiksContext;
+class Context;
+}  // namespace impeller
+
 namespace flutter {
 
 enum class RasterCacheLayerStrategy { kLayer, kLayerChildren };
@@ -45,6 +58,12 @@ class RasterCacheResult {
     return image_ ? image_->GetApproximateByteSize() : 0;
   };
 
+  const sk_sp<DlImage>& image() const { return image_; }
+
+  // Replaces the image with one of the same contents, such as a compressed
+  // copy.
+  void set_image(sk_sp<DlImage> image) { image_ = std::move(image); }
+
  private:
   sk_sp<DlImage> image_;
   SkRect logical_rect_;
@@ -78,15 +97,26 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries with images that were not used in this frame
+   * but are retained for later frames.
+   */
+  size_t retained_count = 0;
+
+  /**
+   * The size of all of the images retained for later frames.
+   */
+  size_t retained_bytes = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
-  size_t total_count() const { return in_use_count; }
+  size_t total_count() const { return in_use_count + retained_count; }
 
   /**
    * The size of all of the cached images during this frame.
    */
-  size_t total_bytes() const { return in_use_bytes; }
+  size_t total_bytes() const { return in_use_bytes + retained_bytes; }
 };
 
 /**
@@ -117,10 +147,20 @@ class RasterCache {
  public:
   struct Context {
     GrDirectContext* gr_context;
+    // When set, entries are rasterized into Impeller textures instead of
+    // Skia surfaces.
+    impeller::AiksContext* aiks_context = nullptr;
     const SkColorSpace* dst_color_space;
     const SkMatrix& matrix;
     const SkRect& logical_rect;
     const char* flow_type;
+    // The rasterization cost reported by a DisplayListComplexityCalculator,
+    // if known. Entries without a cost are never displaced by other entries
+    // while they are in use, and only displace retained entries.
+    std::optional<unsigned int> complexity_score = std::nullopt;
+    // The stable hash of the contents, if they may be saved in the disk
+    // store.
+    std::optional<uint64_t> content_hash = std::nullopt;
   };
   struct CacheInfo {
     const size_t accesses_since_visible;
@@ -160,6 +200,11 @@ class RasterCache {
 
   void BeginFrame();
 
+  /**
+   * @brief Evict the entries that haven't been used for more frames than
+   * |max_unused_frames|, then the retained entries that are least valuable
+   * per byte until the cached images fit in the byte budget.
+   */
   void EvictUnusedCacheEntries();
 
   void EndFrame();
@@ -168,6 +213,62 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  /**
+   * @brief Keep entries for up to |max_unused_frames| frames after the last
+   * frame that used them. Zero, the default, evicts entries as soon as a frame
+   * doesn't use them.
+   */
+  void SetMaxUnusedFrames(size_t max_unused_frames);
+
+  size_t max_unused_frames() const { return max_unused_frames_; }
+
+  /**
+   * @brief Limit the size of all cached images to |max_bytes|, or zero for no
+   * limit.
+   *
+   * Once the limit is reached, new entries first displace the retained
+   * entries, then the entries in use that have a lower complexity score per
+   * byte. Entries that can't be made to fit aren't cached.
+   */
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief Compress the Impeller images of entries that have been cached for
+   * |compress_after_frames| frames, or zero, the default, to never compress
+   * them.
+   *
+   * Cached images never change, so once an entry has lasted that long its
+   * image is read back, encoded as ETC2 on |encode_task_runner|, and replaced
+   * by the compressed copy at the start of a later frame. That takes a quarter
+   * of the memory, at the cost of some quality. Entries whose images can't be
+   * compressed on the device are left alone.
+   */
+  void SetTextureCompression(size_t compress_after_frames,
+                             fml::RefPtr<fml::TaskRunner> encode_task_runner);
+
+  size_t compress_after_frames() const { return compress_after_frames_; }
+
+  /**
+   * @brief Save the compressed images of entries with a content hash in
+   * |disk_store|, and cache entries from the images saved there instead of
+   * rasterizing them, such as on later launches of the app. Only takes effect
+   * along with texture compression, and null, the default, disables it.
+   */
+  void SetDiskStore(std::shared_ptr<RasterCacheDiskStore> disk_store);
+
+  const std::shared_ptr<RasterCacheDiskStore>& disk_store() const {
+    return disk_store_;
+  }
+
+  /**
+   * @brief The cache of tiles for display lists that are too large to cache
+   * as a whole. It follows the frames of this cache and is disabled by
+   * default.
+   */
+  DisplayListTileCache& tile_cache() const { return tile_cache_; }
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -215,6 +316,39 @@ class RasterCache {
    */
   size_t access_threshold() const { return access_threshold_; }
 
+  /**
+   * @brief Lets the display lists that are about to scroll into view be cached
+   * before they are visible, while the frame has time left before |deadline|.
+   * The display lists are only cached once those that are visible are. Setting
+   * no deadline, as is the default, disables warming up the cache.
+   */
+  void SetWarmUpDeadline(std::optional<fml::TimePoint> deadline) {
+    warm_up_deadline_ = deadline;
+  }
+
+  bool warm_up_enabled() const { return warm_up_deadline_.has_value(); }
+
+  /**
+   * @brief Whether the frame still has time to cache the display lists that
+   * are about to scroll into view.
+   */
+  bool HasWarmUpTime() const;
+
+  /**
+   * @brief How far, in device pixels, the children of the transform layer
+   * with |layer_id| are expected to move before the display lists that start
+   * to come into view are cached, given that their device translation is
+   * |translation| in this frame.
+   *
+   * The children are expected to keep moving as they did since the last frame,
+   * for long enough for the display lists to be seen access_threshold times
+   * and cached one frame before they come into view. Layers that were not seen
+   * in the last frame are not expected to move. May be called by concurrent
+   * prerolls.
+   */
+  SkVector PredictScrollOffset(uint64_t layer_id,
+                               const SkVector& translation) const;
+
   bool GenerateNewCacheInThisFrame() const {
     // Disabling caching when access_threshold is zero is historic behavior.
     return access_threshold_ != 0 && display_list_cached_this_frame_ <
@@ -235,6 +369,40 @@ class RasterCache {
                      const SkMatrix& matrix,
                      bool visible) const;
 
+  /**
+   * @brief Records the MarkSeen calls of a subtree that is prerolled
+   * concurrently with its siblings, which may only read the cache.
+   *
+   * The calls see the accesses recorded before them by the same recorder, but
+   * not those of the other subtrees. Apply makes the recorded calls on the
+   * cache once the subtrees are prerolled, in the order of the subtrees, so
+   * that the cache ends up as if they had been prerolled one after the other.
+   */
+  class SeenRecorder {
+   public:
+    explicit SeenRecorder(const RasterCache& cache);
+
+    ~SeenRecorder();
+
+    CacheInfo MarkSeen(const RasterCacheKeyID& id,
+                       const SkMatrix& matrix,
+                       bool visible);
+
+    void Apply() const;
+
+   private:
+    struct Access {
+      size_t accesses_since_visible;
+      bool has_image;
+    };
+
+    const RasterCache& cache_;
+    std::vector<std::pair<RasterCacheKey, bool>> seen_;
+    RasterCacheKey::Map<Access> accesses_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(SeenRecorder);
+  };
+
   /**
    * Returns the access count (i.e. accesses_since_visible) for the given
    * entry in the cache, or -1 if no such entry exists.
@@ -251,19 +419,90 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    // The number of frames since the last frame that encountered the entry.
+    size_t unused_frames = 0;
+    std::optional<unsigned int> complexity_score;
     std::unique_ptr<RasterCacheResult> image;
+    // The number of frames since the image was cached.
+    size_t frames_cached = 0;
+    bool compression_started = false;
+    // The key of the image in the disk store, if it should be saved there
+    // once it is compressed.
+    std::optional<uint64_t> disk_key;
   };
 
+  // The images compressed in the background, to be swapped into their entries
+  // on the raster thread.
+  struct CompressedImages {
+    struct Image {
+      RasterCacheKey key;
+      // The image that was compressed, which the entry must still hold.
+      sk_sp<DlImage> original;
+      sk_sp<DlImage> compressed;
+    };
+
+    std::mutex mutex;
+    std::vector<Image> images;
+  };
+
+  using EntryIterator = RasterCacheKey::Map<Entry>::iterator;
+
+#if IMPELLER_SUPPORTS_RENDERING
+  // Makes the image of an entry from the disk store, if there is one of the
+  // right size there.
+  std::unique_ptr<RasterCacheResult> LoadFromDiskStore(
+      const RasterCache::Context& context,
+      uint64_t disk_key,
+      sk_sp<const DlRTree> rtree) const;
+
+  std::unique_ptr<RasterCacheResult> RasterizeImpeller(
+      const RasterCache::Context& context,
+      const SkRect& dest_rect,
+      const SkMatrix& matrix,
+      sk_sp<const DlRTree> rtree,
+      const std::function<void(DlCanvas*)>& draw_function) const;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  // Evicts entries until |bytes| more fit in the byte budget. Entries that
+  // were encountered this frame are only evicted if their complexity score per
+  // byte is below |weight|. When a new entry of |bytes| can't be made to fit,
+  // nothing is evicted.
+  bool EvictToFit(size_t bytes, double weight) const;
+
+  void Evict(EntryIterator it) const;
+
+  CacheInfo MarkSeen(const RasterCacheKey& key, bool visible) const;
+
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
+
+  // Swaps in the images compressed since the last frame, and starts
+  // compressing the entries that have been cached for long enough.
+  void CompressCacheEntries();
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  size_t max_unused_frames_ = 0;
+  size_t max_bytes_ = 0;
+  size_t compress_after_frames_ = 0;
+  fml::RefPtr<fml::TaskRunner> compression_task_runner_;
+  std::shared_ptr<RasterCacheDiskStore> disk_store_;
+  // The context of the Impeller images, which are only compressed if set.
+  mutable std::shared_ptr<impeller::Context> impeller_context_;
+  std::shared_ptr<CompressedImages> compressed_images_ =
+      std::make_shared<CompressedImages>();
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
+  mutable DisplayListTileCache tile_cache_;
+  std::optional<fml::TimePoint> warm_up_deadline_;
+  // The device translations of the children of the transform layers in this
+  // frame and the last one, by their original layer ids.
+  mutable std::mutex scroll_translations_mutex_;
+  mutable std::unordered_map<uint64_t, SkVector> scroll_translations_;
+  std::unordered_map<uint64_t, SkVector> last_scroll_translations_;
   bool checkerboard_images_;
 
   void TraceStatsToTimeline() const;
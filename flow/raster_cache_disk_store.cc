@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_disk_store.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kFileMagic = 0x52434453;  // "RCDS"
+constexpr uint32_t kFileVersion = 1u;
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t version;
+  int32_t width;
+  int32_t height;
+  uint64_t key;
+  uint64_t data_size;
+};
+
+static_assert(sizeof(FileHeader) == 32u);
+
+std::string GetFileName(uint64_t key) {
+  char name[32];
+  snprintf(name, sizeof(name), "%016" PRIx64 ".rci", key);
+  return name;
+}
+
+// 64-bit FNV-1a, so that keys are the same in every process.
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3;
+  }
+  return hash;
+}
+
+}  // namespace
+
+RasterCacheDiskStore::RasterCacheDiskStore(
+    std::shared_ptr<fml::UniqueFD> directory,
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    size_t max_bytes)
+    : directory_(std::move(directory)),
+      io_task_runner_(std::move(io_task_runner)),
+      max_bytes_(max_bytes) {
+  FML_DCHECK(directory_ && directory_->is_valid());
+  FML_DCHECK(io_task_runner_);
+}
+
+RasterCacheDiskStore::~RasterCacheDiskStore() = default;
+
+uint64_t RasterCacheDiskStore::MakeKey(uint64_t content_hash,
+                                       const SkMatrix& matrix) {
+  SkScalar values[9];
+  matrix.get9(values);
+  values[SkMatrix::kMTransX] = 0;
+  values[SkMatrix::kMTransY] = 0;
+  uint64_t hash = HashBytes(0xcbf29ce484222325, &content_hash,
+                            sizeof(content_hash));
+  return HashBytes(hash, values, sizeof(values));
+}
+
+void RasterCacheDiskStore::LoadAsync() {
+  io_task_runner_->PostTask([directory = directory_, state = state_,
+                             max_bytes = max_bytes_]() {
+    TRACE_EVENT0("flutter", "RasterCacheDiskStore::Load");
+    std::vector<std::string> unusable;
+    fml::VisitFiles(*directory, [&](const fml::UniqueFD& dir,
+                                    const std::string& filename) {
+      std::shared_ptr<fml::FileMapping> file =
+          fml::FileMapping::CreateReadOnly(dir, filename);
+      FileHeader header;
+      if (!file || file->GetSize() < sizeof(header)) {
+        unusable.push_back(filename);
+        return true;
+      }
+      memcpy(&header, file->GetMapping(), sizeof(header));
+      if (header.magic != kFileMagic || header.version != kFileVersion ||
+          header.width <= 0 || header.height <= 0 ||
+          header.data_size != file->GetSize() - sizeof(header) ||
+          filename != GetFileName(header.key)) {
+        unusable.push_back(filename);
+        return true;
+      }
+
+      std::scoped_lock lock(state->mutex);
+      if (state->images.count(header.key) > 0) {
+        return true;
+      }
+      if (state->bytes + header.data_size > max_bytes) {
+        // The images that no longer fit, such as those of content that has
+        // since changed, are removed to make room for new ones.
+        unusable.push_back(filename);
+        return true;
+      }
+      auto data = std::make_shared<fml::NonOwnedMapping>(
+          file->GetMapping() + sizeof(header), header.data_size,
+          // Keeps the file mapped for as long as the image is used.
+          [file](const uint8_t*, size_t) {});
+      state->images[header.key] = {
+          SkISize::Make(header.width, header.height), std::move(data)};
+      state->bytes += header.data_size;
+      return true;
+    });
+    for (const std::string& filename : unusable) {
+      fml::UnlinkFile(*directory, filename.c_str());
+    }
+  });
+}
+
+std::optional<RasterCacheDiskStore::Image> RasterCacheDiskStore::Find(
+    uint64_t key) const {
+  std::scoped_lock lock(state_->mutex);
+  auto it = state_->images.find(key);
+  if (it == state_->images.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void RasterCacheDiskStore::Store(uint64_t key,
+                                 SkISize size,
+                                 std::shared_ptr<fml::Mapping> data) {
+  if (!data || size.isEmpty()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(state_->mutex);
+    if (state_->images.count(key) > 0 ||
+        state_->bytes + data->GetSize() > max_bytes_) {
+      return;
+    }
+    state_->images[key] = {size, data};
+    state_->bytes += data->GetSize();
+  }
+
+  io_task_runner_->PostTask([directory = directory_, key, size, data]() {
+    TRACE_EVENT0("flutter", "RasterCacheDiskStore::Store");
+    FileHeader header = {
+        .magic = kFileMagic,
+        .version = kFileVersion,
+        .width = size.width(),
+        .height = size.height(),
+        .key = key,
+        .data_size = data->GetSize(),
+    };
+    std::vector<uint8_t> contents(sizeof(header) + data->GetSize());
+    memcpy(contents.data(), &header, sizeof(header));
+    memcpy(contents.data() + sizeof(header), data->GetMapping(),
+           data->GetSize());
+    fml::DataMapping mapping(std::move(contents));
+    if (!fml::WriteAtomically(*directory, GetFileName(key).c_str(), mapping)) {
+      FML_LOG(WARNING) << "Could not save a raster cache image.";
+    }
+  });
+}
+
+size_t RasterCacheDiskStore::GetImageCount() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->images.size();
+}
+
+}  // namespace flutter
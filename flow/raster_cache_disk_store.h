@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
+#define FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+/**
+ * RasterCacheDiskStore keeps the compressed images of raster cache entries in
+ * a directory, so that static content that is expensive to rasterize, such as
+ * complex vector illustrations, is only rasterized on the first launch of the
+ * app.
+ *
+ * Images are keyed by a stable hash of the contents of their display list,
+ * from DlSerializer::ComputeStableHash, and the transform they were rasterized
+ * with. The saved images are mapped on |io_task_runner| by LoadAsync, so the
+ * entries that are cached before they have been mapped are rasterized as
+ * usual. New images are written on |io_task_runner| too, until the images in
+ * the directory reach |max_bytes|.
+ *
+ * The store doesn't know the format of the images. The directory is expected
+ * to be purged when the engine, and so the format, changes.
+ */
+class RasterCacheDiskStore {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 32u * 1024u * 1024u;
+
+  struct Image {
+    SkISize size;
+    std::shared_ptr<const fml::Mapping> data;
+  };
+
+  RasterCacheDiskStore(std::shared_ptr<fml::UniqueFD> directory,
+                       fml::RefPtr<fml::TaskRunner> io_task_runner,
+                       size_t max_bytes = kDefaultMaxBytes);
+
+  ~RasterCacheDiskStore();
+
+  /**
+   * @brief The key of the image of a display list with the stable hash
+   * |content_hash| rasterized with |matrix|. Like RasterCacheKey, it ignores
+   * the translation of the matrix.
+   */
+  static uint64_t MakeKey(uint64_t content_hash, const SkMatrix& matrix);
+
+  /**
+   * @brief Starts mapping the images saved in the directory.
+   */
+  void LoadAsync();
+
+  /**
+   * @brief The image saved or stored for |key|, if any.
+   */
+  std::optional<Image> Find(uint64_t key) const;
+
+  /**
+   * @brief Saves |data|, an image of |size|, for |key| unless there is
+   * already one, or the store is full. May be called on any thread.
+   */
+  void Store(uint64_t key, SkISize size, std::shared_ptr<fml::Mapping> data);
+
+  /**
+   * @brief The number of images that can be found.
+   */
+  size_t GetImageCount() const;
+
+ private:
+  // Shared with the tasks on the IO task runner, which may outlive the store.
+  struct State {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, Image> images;
+    size_t bytes = 0;
+  };
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const fml::RefPtr<fml::TaskRunner> io_task_runner_;
+  const size_t max_bytes_;
+  const std::shared_ptr<State> state_ = std::make_shared<State>();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheDiskStore);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
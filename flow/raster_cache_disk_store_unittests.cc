@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_disk_store.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/thread_test.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+class RasterCacheDiskStoreTest : public ThreadTest {
+ public:
+  RasterCacheDiskStoreTest()
+      : io_task_runner_(CreateNewThread("io")),
+        directory_(std::make_shared<fml::UniqueFD>(
+            fml::OpenDirectory(temp_dir_.path().c_str(),
+                               false,
+                               fml::FilePermission::kReadWrite))) {}
+
+  std::unique_ptr<RasterCacheDiskStore> MakeStore(size_t max_bytes = 1024u) {
+    return std::make_unique<RasterCacheDiskStore>(directory_, io_task_runner_,
+                                                  max_bytes);
+  }
+
+  // Waits for the tasks posted to the IO task runner so far.
+  void FlushIO() {
+    fml::AutoResetWaitableEvent latch;
+    io_task_runner_->PostTask([&latch]() { latch.Signal(); });
+    latch.Wait();
+  }
+
+  const fml::UniqueFD& directory() const { return *directory_; }
+
+ private:
+  fml::ScopedTemporaryDirectory temp_dir_;
+  fml::RefPtr<fml::TaskRunner> io_task_runner_;
+  std::shared_ptr<fml::UniqueFD> directory_;
+};
+
+static std::shared_ptr<fml::Mapping> MakeData(size_t size, uint8_t value) {
+  return std::make_shared<fml::DataMapping>(std::vector<uint8_t>(size, value));
+}
+
+TEST_F(RasterCacheDiskStoreTest, KeysIgnoreTranslation) {
+  SkMatrix matrix = SkMatrix::Scale(2, 2);
+  uint64_t key = RasterCacheDiskStore::MakeKey(1u, matrix);
+  EXPECT_EQ(RasterCacheDiskStore::MakeKey(1u, matrix), key);
+  SkMatrix translated = SkMatrix::Scale(2, 2).postTranslate(10.5, 20);
+  EXPECT_EQ(RasterCacheDiskStore::MakeKey(1u, translated), key);
+  EXPECT_NE(RasterCacheDiskStore::MakeKey(2u, matrix), key);
+  EXPECT_NE(RasterCacheDiskStore::MakeKey(1u, SkMatrix::Scale(3, 3)), key);
+}
+
+TEST_F(RasterCacheDiskStoreTest, ImagesAreLoadedByLaterStores) {
+  {
+    auto store = MakeStore();
+    store->Store(1u, SkISize::Make(8, 4), MakeData(32u, 0xab));
+    auto image = store->Find(1u);
+    ASSERT_TRUE(image.has_value());
+    EXPECT_EQ(image->size, SkISize::Make(8, 4));
+    // Images are only stored once.
+    store->Store(1u, SkISize::Make(4, 4), MakeData(16u, 0xcd));
+    EXPECT_EQ(store->Find(1u)->size, SkISize::Make(8, 4));
+    FlushIO();
+  }
+
+  auto store = MakeStore();
+  EXPECT_FALSE(store->Find(1u).has_value());
+  store->LoadAsync();
+  FlushIO();
+  auto image = store->Find(1u);
+  ASSERT_TRUE(image.has_value());
+  EXPECT_EQ(image->size, SkISize::Make(8, 4));
+  ASSERT_EQ(image->data->GetSize(), 32u);
+  EXPECT_EQ(image->data->GetMapping()[0], 0xab);
+  EXPECT_EQ(image->data->GetMapping()[31], 0xab);
+  EXPECT_FALSE(store->Find(2u).has_value());
+}
+
+TEST_F(RasterCacheDiskStoreTest, StoresStayWithinTheirBudget) {
+  {
+    auto store = MakeStore(64u);
+    store->Store(1u, SkISize::Make(8, 8), MakeData(48u, 1));
+    store->Store(2u, SkISize::Make(8, 8), MakeData(48u, 2));
+    EXPECT_EQ(store->GetImageCount(), 1u);
+    FlushIO();
+  }
+
+  // Images that no longer fit aren't loaded.
+  auto store = MakeStore(16u);
+  store->LoadAsync();
+  FlushIO();
+  EXPECT_EQ(store->GetImageCount(), 0u);
+}
+
+TEST_F(RasterCacheDiskStoreTest, IgnoresInvalidFiles) {
+  {
+    auto store = MakeStore();
+    store->Store(1u, SkISize::Make(8, 8), MakeData(32u, 1));
+    FlushIO();
+  }
+  fml::DataMapping garbage(std::vector<uint8_t>(64, 0xff));
+  ASSERT_TRUE(fml::WriteAtomically(directory(), "garbage.rci", garbage));
+
+  auto store = MakeStore();
+  store->LoadAsync();
+  FlushIO();
+  EXPECT_EQ(store->GetImageCount(), 1u);
+  EXPECT_FALSE(fml::FileExists(directory(), "garbage.rci"));
+}
+
+}  // namespace testing
+}  // namespace flutter
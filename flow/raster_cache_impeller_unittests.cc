@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/flow/raster_cache_key.h"
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+// Collects the images that a display list draws.
+class ImageCollector : public flutter::IgnoreAttributeDispatchHelper,
+                       public flutter::IgnoreClipDispatchHelper,
+                       public flutter::IgnoreTransformDispatchHelper,
+                       public flutter::IgnoreDrawDispatchHelper {
+ public:
+  void drawImage(const sk_sp<flutter::DlImage> image,
+                 const SkPoint point,
+                 flutter::DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    images.push_back(image);
+    points.push_back(point);
+  }
+
+  std::vector<sk_sp<flutter::DlImage>> images;
+  std::vector<SkPoint> points;
+};
+
+void DrawSampleContents(flutter::DlCanvas* canvas) {
+  canvas->DrawRect(SkRect::MakeLTRB(10, 10, 90, 50),
+                   flutter::DlPaint(flutter::DlColor::kRed()));
+  canvas->DrawCircle({50, 60}, 20,
+                     flutter::DlPaint(flutter::DlColor::kBlue()));
+}
+
+}  // namespace
+
+using RasterCacheImpellerTest = PlaygroundTest;
+INSTANTIATE_PLAYGROUND_SUITE(RasterCacheImpellerTest);
+
+TEST_P(RasterCacheImpellerTest, RasterizesEntriesIntoTextures) {
+  AiksContext aiks_context(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(aiks_context.IsValid());
+
+  flutter::RasterCache cache;
+  const flutter::RasterCacheKeyID id(1,
+                                     flutter::RasterCacheKeyType::kDisplayList);
+  const SkMatrix matrix = SkMatrix::Translate(5, 10);
+  const SkRect logical_rect = SkRect::MakeLTRB(10, 10, 90, 80);
+  flutter::RasterCache::Context context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .aiks_context       = &aiks_context,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = logical_rect,
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      // clang-format on
+  };
+
+  cache.BeginFrame();
+  cache.MarkSeen(id, matrix, true);
+  ASSERT_TRUE(cache.UpdateCacheEntry(id, context, DrawSampleContents));
+
+  // The entry is drawn back as a single image at its integral device bounds.
+  flutter::DisplayListBuilder builder;
+  builder.Transform(matrix);
+  ASSERT_TRUE(cache.Draw(id, builder, nullptr));
+  cache.EndFrame();
+
+  auto display_list = builder.Build();
+  ImageCollector collector;
+  display_list->Dispatch(collector);
+  ASSERT_EQ(collector.images.size(), 1u);
+  EXPECT_EQ(collector.points[0], SkPoint::Make(15, 20));
+
+  auto texture = collector.images[0]->impeller_texture();
+  ASSERT_NE(texture, nullptr);
+  EXPECT_EQ(texture->GetSize(), ISize(80, 70));
+  EXPECT_TRUE(texture->IsValid());
+
+  const auto& metrics = cache.picture_metrics();
+  EXPECT_EQ(metrics.in_use_count, 1u);
+  EXPECT_EQ(metrics.retained_count, 0u);
+  EXPECT_EQ(metrics.total_bytes(),
+            collector.images[0]->GetApproximateByteSize());
+  EXPECT_GE(metrics.total_bytes(),
+            texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel());
+  EXPECT_EQ(cache.layer_metrics().total_count(), 0u);
+
+  // The texture can be rendered from like any other Impeller image.
+  DlDispatcher dispatcher(IRect::MakeSize(ISize(100, 100)));
+  display_list->Dispatch(dispatcher);
+  auto picture = dispatcher.EndRecordingAsPicture();
+  EXPECT_NE(picture.ToImage(aiks_context, ISize(100, 100)), nullptr);
+}
+
+TEST_P(RasterCacheImpellerTest, DoesNotRasterizeEmptyEntries) {
+  AiksContext aiks_context(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(aiks_context.IsValid());
+
+  flutter::RasterCache cache;
+  const flutter::RasterCacheKeyID id(1,
+                                     flutter::RasterCacheKeyType::kDisplayList);
+  const SkMatrix matrix = SkMatrix::I();
+  const SkRect logical_rect = SkRect::MakeEmpty();
+  flutter::RasterCache::Context context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .aiks_context       = &aiks_context,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = logical_rect,
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      // clang-format on
+  };
+
+  cache.BeginFrame();
+  cache.MarkSeen(id, matrix, true);
+  EXPECT_FALSE(cache.UpdateCacheEntry(id, context, DrawSampleContents));
+
+  flutter::DisplayListBuilder builder;
+  EXPECT_FALSE(cache.Draw(id, builder, nullptr));
+  cache.EndFrame();
+  EXPECT_EQ(cache.picture_metrics().total_count(), 0u);
+  EXPECT_EQ(cache.picture_metrics().total_bytes(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -63,6 +63,10 @@ class RasterCacheItem {
 
   bool need_caching() const { return cache_state_ != CacheState::kNone; }
 
+  // Whether the item is cached ahead of coming into view, once the visible
+  // items are. See |RasterCache::SetWarmUpDeadline|.
+  bool warming_up() const { return warming_up_; }
+
   virtual ~RasterCacheItem() = default;
 
  protected:
@@ -71,6 +75,7 @@ class RasterCacheItem {
   CacheState cache_state_ = CacheState::kNone;
   mutable SkMatrix matrix_;
   unsigned child_items_;
+  bool warming_up_ = false;
 };
 
 }  // namespace flutter
@@ -359,6 +359,190 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+// An 80x80 display list that the naive complexity calculator scores with
+// |op_count|.
+static sk_sp<DisplayList> GetDisplayListWithOpCount(int op_count) {
+  DisplayListBuilder builder(SkRect::MakeWH(80, 80));
+  for (int i = 0; i < op_count; i++) {
+    builder.DrawRect(SkRect::MakeWH(80, 80), DlPaint(DlColor::kRed()));
+  }
+  return builder.Build();
+}
+
+TEST(RasterCache, KeepsUnusedEntriesForMaxUnusedFrames) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxUnusedFrames(2);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPrerollAndTryToRasterCache(display_list_item,
+                                              preroll_context, paint_context,
+                                              matrix);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+
+  // Two frames without the display list.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    cache.EvictUnusedCacheEntries();
+    cache.EndFrame();
+    ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+    ASSERT_EQ(cache.picture_metrics().in_use_count, 0u);
+    ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+    ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
+  }
+
+  // The retained entry is drawn as soon as the display list comes back.
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+
+  for (int i = 0; i < 3; i++) {
+    cache.BeginFrame();
+    cache.EvictUnusedCacheEntries();
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, RetainedEntriesMakeRoomWithinMaxBytes) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxUnusedFrames(10);
+  // Room for one sample display list image.
+  cache.SetMaxBytes(30000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  // Both display lists are in use, so only the first one fits.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_1, paint_context);
+    RasterCacheItemTryToRasterCache(display_list_item_2, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_FALSE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+
+  // Once the first display list is unused, its image makes room for the
+  // second one.
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item_2, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_FALSE(cache.HasEntry(display_list_item_1.GetId().value(), matrix));
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+}
+
+TEST(RasterCache, ComplexEntriesDisplaceSimpleEntriesWithinMaxBytes) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxBytes(30000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto simple_display_list = GetDisplayListWithOpCount(10);
+  auto complex_display_list = GetDisplayListWithOpCount(100);
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  // Not marked as complex, so the complexity calculator scores them.
+  DisplayListRasterCacheItem simple_item(simple_display_list, SkPoint(), false,
+                                         false);
+  DisplayListRasterCacheItem complex_item(complex_display_list, SkPoint(),
+                                          false, false);
+
+  for (int i = 0; i < 3; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(simple_item, preroll_context, matrix);
+    RasterCacheItemPreroll(complex_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(simple_item, paint_context);
+    RasterCacheItemTryToRasterCache(complex_item, paint_context);
+    cache.EndFrame();
+  }
+
+  ASSERT_FALSE(simple_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(complex_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_LE(cache.EstimatePictureCacheByteSize(), 30000u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -660,6 +844,102 @@ TEST(RasterCache, RasterCacheKeyHashFunction) {
   ASSERT_EQ(layer_children_hash_code, layer_children_cache_key_id.GetHash());
 }
 
+TEST(RasterCache, PredictsScrollOffsetsFromTheLastFrame) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+  const SkVector zero = SkVector::Make(0, 0);
+
+  cache.BeginFrame();
+  EXPECT_EQ(cache.PredictScrollOffset(1, SkVector::Make(0, 100)), zero);
+  cache.EndFrame();
+
+  // Moves by the distance since the last frame for threshold + 2 frames.
+  cache.BeginFrame();
+  EXPECT_EQ(cache.PredictScrollOffset(1, SkVector::Make(0, 90)),
+            SkVector::Make(0, -40));
+  EXPECT_EQ(cache.PredictScrollOffset(2, SkVector::Make(0, 90)), zero);
+  cache.EndFrame();
+
+  // Layers that weren't seen in the last frame haven't moved.
+  cache.BeginFrame();
+  cache.EndFrame();
+  cache.BeginFrame();
+  EXPECT_EQ(cache.PredictScrollOffset(1, SkVector::Make(0, 50)), zero);
+  cache.EndFrame();
+}
+
+TEST(RasterCache, WarmsUpDisplayListsScrollingIntoView) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(SkRect::MakeWH(100, 100), matrix);
+  LayerStateStack paint_state_stack;
+  paint_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  // Below the cull rect, and about to be scrolled up into it.
+  DisplayListRasterCacheItem display_list_item(
+      display_list, SkPoint::Make(0, 150), true, false);
+  preroll_context.raster_cache_warm_up_offset = SkVector::Make(0, -100);
+  std::vector<RasterCacheItem*> items = {&display_list_item};
+
+  // Not warmed up without a deadline.
+  for (int i = 0; i < 3; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    LayerTree::TryToRasterCache(items, &paint_context);
+    cache.EndFrame();
+  }
+  EXPECT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+
+  // Not warmed up once the frame has no time left.
+  cache.SetWarmUpDeadline(fml::TimePoint::Now());
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  EXPECT_TRUE(display_list_item.warming_up());
+  cache.EvictUnusedCacheEntries();
+  LayerTree::TryToRasterCache(items, &paint_context);
+  cache.EndFrame();
+  EXPECT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+
+  cache.SetWarmUpDeadline(fml::TimePoint::Max());
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  EXPECT_TRUE(display_list_item.warming_up());
+  cache.EvictUnusedCacheEntries();
+  LayerTree::TryToRasterCache(items, &paint_context);
+  cache.EndFrame();
+  EXPECT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+
+  // Display lists that aren't about to come into view aren't warmed up.
+  DisplayListRasterCacheItem other_item(display_list, SkPoint::Make(0, 300),
+                                        true, false);
+  for (int i = 0; i < 4; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(other_item, preroll_context, matrix);
+    EXPECT_FALSE(other_item.warming_up());
+    EXPECT_FALSE(other_item.need_caching());
+    cache.EndFrame();
+  }
+}
+
 TEST(RasterCache, RasterCacheKeySameID) {
   RasterCacheKey::Map<int> map;
   SkMatrix matrix = SkMatrix::I();
@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/allocation_profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace fml {
+
+namespace {
+
+struct ThreadCounters {
+  uint64_t allocation_count = 0;
+  uint64_t allocated_bytes = 0;
+  std::array<AllocationProfiler::ScopeStats, AllocationProfiler::kMaxScopeCount>
+      scopes = {};
+  size_t scope_count = 0;
+  // The indices of the open scopes in |scopes|, or |kMaxScopeCount| for the
+  // scopes that did not get counters.
+  std::array<size_t, AllocationProfiler::kMaxScopeDepth> scope_stack = {};
+  // May exceed |kMaxScopeDepth|.
+  size_t scope_depth = 0;
+};
+
+// Allocated when the thread enables the profiler, and leaked.
+thread_local ThreadCounters* tCounters = nullptr;
+
+size_t FindOrAddScope(ThreadCounters& counters, const char* name) {
+  for (size_t i = 0; i < counters.scope_count; i++) {
+    // The same name may have several addresses across translation units.
+    if (counters.scopes[i].name == name ||
+        std::strcmp(counters.scopes[i].name, name) == 0) {
+      return i;
+    }
+  }
+  if (counters.scope_count == AllocationProfiler::kMaxScopeCount) {
+    return AllocationProfiler::kMaxScopeCount;
+  }
+  counters.scopes[counters.scope_count].name = name;
+  return counters.scope_count++;
+}
+
+}  // namespace
+
+bool AllocationProfiler::IsSupported() {
+#if FLUTTER_ALLOCATION_PROFILER
+  return true;
+#else
+  return false;
+#endif  // FLUTTER_ALLOCATION_PROFILER
+}
+
+void AllocationProfiler::EnableForCurrentThread() {
+  if (!tCounters) {
+    tCounters = new ThreadCounters();
+  }
+}
+
+bool AllocationProfiler::IsEnabledForCurrentThread() {
+  return tCounters != nullptr;
+}
+
+void AllocationProfiler::RecordAllocation(size_t bytes) {
+  ThreadCounters* counters = tCounters;
+  if (!counters) {
+    return;
+  }
+  counters->allocation_count++;
+  counters->allocated_bytes += bytes;
+  if (counters->scope_depth == 0) {
+    return;
+  }
+  const size_t depth = std::min(counters->scope_depth, kMaxScopeDepth);
+  const size_t index = counters->scope_stack[depth - 1];
+  if (index < kMaxScopeCount) {
+    counters->scopes[index].allocation_count++;
+    counters->scopes[index].allocated_bytes += bytes;
+  }
+}
+
+void AllocationProfiler::PushScope(const char* name) {
+  ThreadCounters* counters = tCounters;
+  if (!counters || !name) {
+    return;
+  }
+  if (counters->scope_depth < kMaxScopeDepth) {
+    counters->scope_stack[counters->scope_depth] =
+        FindOrAddScope(*counters, name);
+  }
+  counters->scope_depth++;
+}
+
+void AllocationProfiler::PopScope() {
+  ThreadCounters* counters = tCounters;
+  // The scopes that were open when the thread enabled the profiler end
+  // without having been pushed.
+  if (!counters || counters->scope_depth == 0) {
+    return;
+  }
+  counters->scope_depth--;
+}
+
+AllocationProfiler::Stats AllocationProfiler::TakeStats() {
+  Stats stats;
+  ThreadCounters* counters = tCounters;
+  if (!counters) {
+    return stats;
+  }
+  stats.allocation_count = counters->allocation_count;
+  stats.allocated_bytes = counters->allocated_bytes;
+  counters->allocation_count = 0;
+  counters->allocated_bytes = 0;
+
+  // The scopes stay registered, since open scopes refer to them.
+  auto& top_scopes = stats.top_scopes;
+  for (size_t i = 0; i < counters->scope_count; i++) {
+    ScopeStats& scope = counters->scopes[i];
+    if (scope.allocation_count == 0) {
+      continue;
+    }
+    // Insert the scope into the top scopes, which are sorted.
+    size_t position = stats.top_scope_count;
+    while (position > 0 &&
+           top_scopes[position - 1].allocated_bytes < scope.allocated_bytes) {
+      position--;
+    }
+    if (position < kTopScopeCount) {
+      for (size_t j = std::min(stats.top_scope_count, kTopScopeCount - 1);
+           j > position; j--) {
+        top_scopes[j] = top_scopes[j - 1];
+      }
+      top_scopes[position] = scope;
+      stats.top_scope_count =
+          std::min(stats.top_scope_count + 1, kTopScopeCount);
+    }
+    scope.allocation_count = 0;
+    scope.allocated_bytes = 0;
+  }
+  return stats;
+}
+
+}  // namespace fml
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_ALLOCATION_PROFILER_H_
+#define FLUTTER_FML_ALLOCATION_PROFILER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Counts the heap allocations of the threads that enable it, and
+///             attributes each one to the innermost trace event scope that is
+///             open on the thread, so that the frames of the raster thread
+///             can be checked for allocation churn in release builds.
+///
+///             Allocations are only counted in builds with the
+///             `flutter_enable_allocation_profiler` GN argument, which
+///             replaces the global `operator new`. The trace event macros
+///             open and close the scopes. Neither counting nor opening a scope
+///             allocates.
+///
+///             All methods apply to the calling thread only. Frees are not
+///             counted.
+///
+class AllocationProfiler {
+ public:
+  /// The number of distinct scopes a thread keeps counters for. Allocations
+  /// in the scopes that are opened past this count are only counted in the
+  /// totals.
+  static constexpr size_t kMaxScopeCount = 256;
+
+  /// The number of nested scopes that are tracked. Allocations in deeper
+  /// scopes are attributed to the deepest one that is tracked.
+  static constexpr size_t kMaxScopeDepth = 64;
+
+  /// The number of scopes reported by |TakeStats|.
+  static constexpr size_t kTopScopeCount = 8;
+
+  struct ScopeStats {
+    /// The name of the trace event, which outlives the profiler.
+    const char* name = nullptr;
+    uint64_t allocation_count = 0;
+    uint64_t allocated_bytes = 0;
+  };
+
+  struct Stats {
+    uint64_t allocation_count = 0;
+    uint64_t allocated_bytes = 0;
+    /// The scopes that allocated the most bytes, in decreasing order. Only the
+    /// first |top_scope_count| are valid.
+    std::array<ScopeStats, kTopScopeCount> top_scopes = {};
+    size_t top_scope_count = 0;
+  };
+
+  /// Whether this build counts allocations.
+  static bool IsSupported();
+
+  /// Starts counting the allocations of the calling thread. The counters are
+  /// never released, so this is meant for long lived threads.
+  static void EnableForCurrentThread();
+
+  static bool IsEnabledForCurrentThread();
+
+  static void RecordAllocation(size_t bytes);
+
+  static void PushScope(const char* name);
+
+  static void PopScope();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns what was allocated on the calling thread since the
+  ///             previous call, and resets the counts.
+  ///
+  static Stats TakeStats();
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(AllocationProfiler);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_ALLOCATION_PROFILER_H_
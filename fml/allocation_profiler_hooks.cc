@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replaces the global allocation functions to count allocations with the
+// |AllocationProfiler|. Only linked in builds with the
+// `flutter_enable_allocation_profiler` GN argument.
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "flutter/fml/allocation_profiler.h"
+#include "flutter/fml/build_config.h"
+
+#if defined(FML_OS_WIN)
+#include <malloc.h>
+#endif  // defined(FML_OS_WIN)
+
+#if !FLUTTER_ALLOCATION_PROFILER
+#error "Only build the allocation hooks with the allocation profiler."
+#endif  // !FLUTTER_ALLOCATION_PROFILER
+
+namespace {
+
+void* Allocate(size_t size) {
+  fml::AllocationProfiler::RecordAllocation(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* AllocateAligned(size_t size, std::align_val_t alignment) {
+  fml::AllocationProfiler::RecordAllocation(size);
+  const size_t align = static_cast<size_t>(alignment);
+#if defined(FML_OS_WIN)
+  return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+  void* result = nullptr;
+  if (posix_memalign(&result, std::max(align, sizeof(void*)),
+                     size == 0 ? 1 : size) != 0) {
+    return nullptr;
+  }
+  return result;
+#endif  // defined(FML_OS_WIN)
+}
+
+void FreeAligned(void* pointer) {
+#if defined(FML_OS_WIN)
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif  // defined(FML_OS_WIN)
+}
+
+void* AllocateOrAbort(void* result) {
+  // The engine is built without exceptions, so there is no std::bad_alloc.
+  if (!result) {
+    std::abort();
+  }
+  return result;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  return AllocateOrAbort(Allocate(size));
+}
+
+void* operator new[](size_t size) {
+  return AllocateOrAbort(Allocate(size));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return AllocateOrAbort(AllocateAligned(size, alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return AllocateOrAbort(AllocateAligned(size, alignment));
+}
+
+void* operator new(size_t size,
+                   std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size,
+                     std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
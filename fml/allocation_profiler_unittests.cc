@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/allocation_profiler.h"
+
+#include <iterator>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+using Stats = AllocationProfiler::Stats;
+
+// The profiler can't be disabled again, so every test enables it on its own
+// thread. The threads don't allocate between enabling the profiler and taking
+// the stats, so the counts are exact even in builds that count allocations.
+template <typename Callback>
+Stats RunOnProfiledThread(Callback callback) {
+  Stats stats;
+  std::thread thread([&stats, &callback]() {
+    AllocationProfiler::EnableForCurrentThread();
+    AllocationProfiler::TakeStats();
+    callback();
+    stats = AllocationProfiler::TakeStats();
+  });
+  thread.join();
+  return stats;
+}
+
+TEST(AllocationProfilerTest, OnlyCountsThreadsThatEnableIt) {
+  std::thread thread([]() {
+    AllocationProfiler::RecordAllocation(16);
+    EXPECT_FALSE(AllocationProfiler::IsEnabledForCurrentThread());
+    EXPECT_EQ(AllocationProfiler::TakeStats().allocation_count, 0u);
+  });
+  thread.join();
+}
+
+TEST(AllocationProfilerTest, AttributesAllocationsToTheInnermostScope) {
+  Stats stats = RunOnProfiledThread([]() {
+    AllocationProfiler::RecordAllocation(1);
+    AllocationProfiler::PushScope("Outer");
+    AllocationProfiler::RecordAllocation(10);
+    AllocationProfiler::PushScope("Inner");
+    AllocationProfiler::RecordAllocation(100);
+    AllocationProfiler::RecordAllocation(100);
+    AllocationProfiler::PopScope();
+    AllocationProfiler::RecordAllocation(10);
+    AllocationProfiler::PopScope();
+  });
+
+  EXPECT_EQ(stats.allocation_count, 5u);
+  EXPECT_EQ(stats.allocated_bytes, 221u);
+  ASSERT_EQ(stats.top_scope_count, 2u);
+  EXPECT_STREQ(stats.top_scopes[0].name, "Inner");
+  EXPECT_EQ(stats.top_scopes[0].allocation_count, 2u);
+  EXPECT_EQ(stats.top_scopes[0].allocated_bytes, 200u);
+  EXPECT_STREQ(stats.top_scopes[1].name, "Outer");
+  EXPECT_EQ(stats.top_scopes[1].allocation_count, 2u);
+  EXPECT_EQ(stats.top_scopes[1].allocated_bytes, 20u);
+}
+
+TEST(AllocationProfilerTest, TakingStatsResetsThemAndKeepsOpenScopes) {
+  Stats stats = RunOnProfiledThread([]() {
+    AllocationProfiler::PushScope("Frame");
+    AllocationProfiler::RecordAllocation(64);
+    AllocationProfiler::TakeStats();
+    AllocationProfiler::RecordAllocation(8);
+    AllocationProfiler::PopScope();
+  });
+
+  EXPECT_EQ(stats.allocation_count, 1u);
+  EXPECT_EQ(stats.allocated_bytes, 8u);
+  ASSERT_EQ(stats.top_scope_count, 1u);
+  EXPECT_STREQ(stats.top_scopes[0].name, "Frame");
+  EXPECT_EQ(stats.top_scopes[0].allocated_bytes, 8u);
+}
+
+TEST(AllocationProfilerTest, ReportsOnlyTheScopesThatAllocatedTheMost) {
+  static const char* kNames[] = {"A", "B", "C", "D", "E",
+                                 "F", "G", "H", "I", "J"};
+  Stats stats = RunOnProfiledThread([]() {
+    for (size_t i = 0; i < std::size(kNames); i++) {
+      AllocationProfiler::PushScope(kNames[i]);
+      AllocationProfiler::RecordAllocation(i + 1);
+      AllocationProfiler::PopScope();
+    }
+  });
+
+  ASSERT_EQ(stats.top_scope_count, AllocationProfiler::kTopScopeCount);
+  for (size_t i = 0; i < AllocationProfiler::kTopScopeCount; i++) {
+    EXPECT_STREQ(stats.top_scopes[i].name, kNames[std::size(kNames) - 1 - i]);
+  }
+}
+
+TEST(AllocationProfilerTest, ScopesOpenedBeforeEnablingAreIgnored) {
+  Stats stats = RunOnProfiledThread([]() {
+    // Closes a scope that was opened before the profiler was enabled.
+    AllocationProfiler::PopScope();
+    AllocationProfiler::RecordAllocation(4);
+  });
+
+  EXPECT_EQ(stats.allocation_count, 1u);
+  EXPECT_EQ(stats.top_scope_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -7,30 +7,83 @@
 #include <algorithm>
 
 #include "flutter/fml/thread.h"
-#include "flutter/fml/trace_event.h"
 
 namespace fml {
 
+namespace {
+
+// Workers check the shared queue before their own deque at this interval so
+// that a worker that keeps posting tasks to itself does not starve the tasks
+// posted by other threads.
+constexpr size_t kSharedQueueCheckInterval = 61;
+
+void RunTaskOnCallerThread(const fml::closure& task) {
+  FML_DLOG(WARNING)
+      << "Tried to post to a concurrent message loop that has already died. "
+         "Executing the task on the callers thread.";
+  task();
+}
+
+}  // namespace
+
+thread_local ConcurrentMessageLoop::Worker*
+    ConcurrentMessageLoop::current_worker_ = nullptr;
+
+void ConcurrentMessageLoop::SharedQueue::Push(const fml::closure& task) {
+  std::scoped_lock lock(mutex);
+  tasks.push_back(task);
+  size.store(tasks.size(), std::memory_order_relaxed);
+}
+
+bool ConcurrentMessageLoop::SharedQueue::TryPop(fml::closure* task) {
+  // Avoid contending on the mutex of empty queues while looking for work.
+  if (size.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  std::scoped_lock lock(mutex);
+  if (tasks.empty()) {
+    return false;
+  }
+  *task = std::move(tasks.front());
+  tasks.pop_front();
+  size.store(tasks.size(), std::memory_order_relaxed);
+  return true;
+}
+
+ConcurrentMessageLoop::Worker::Worker(ConcurrentMessageLoop* p_loop,
+                                      size_t p_index)
+    : loop(p_loop), index(p_index) {}
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  // All the workers must exist before any of them starts looking for tasks to
+  // steal.
   for (size_t i = 0; i < worker_count_; ++i) {
-    workers_.emplace_back([i, this]() {
-      fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
-          std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
-    });
+    workers_.emplace_back(std::make_unique<Worker>(this, i));
   }
 
   for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
+    worker->thread = std::thread([worker = worker.get(), this]() {
+      fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
+          std::string{"io.worker." + std::to_string(worker->index + 1)}));
+      WorkerMain(worker);
+    });
   }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
   Terminate();
   for (auto& worker : workers_) {
-    FML_DCHECK(worker.joinable());
-    worker.join();
+    FML_DCHECK(worker->thread.joinable());
+    worker->thread.join();
+  }
+
+  // The workers are gone so their deques can be drained on this thread.
+  for (auto& worker : workers_) {
+    fml::closure* task = nullptr;
+    while (worker->local_tasks.Pop(&task)) {
+      delete task;
+    }
   }
 }
 
@@ -42,74 +95,149 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
 
+bool ConcurrentMessageLoop::ExecuteTaskIfShutdown(const fml::closure& task) {
+  // Don't just drop tasks on the floor in case of shutdown.
+  if (!shutdown_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  FML_DLOG(WARNING) << "Tried to post a task to shutdown concurrent message "
+                       "loop. The task will be executed on the callers thread.";
+  ExecuteTask(task);
+  return true;
+}
+
 void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
-  if (!task) {
+  if (!task || ExecuteTaskIfShutdown(task)) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
+  // Tasks posted by a worker, usually to split up its own work, stay on the
+  // worker unless an idle worker steals them.
+  if (Worker* worker = GetCurrentWorker()) {
+    worker->local_tasks.Push(new fml::closure(task));
+  } else {
+    tasks_.Push(task);
+  }
+  OnTaskPosted();
+}
 
-  // Don't just drop tasks on the floor in case of shutdown.
-  if (shutdown_) {
-    FML_DLOG(WARNING)
-        << "Tried to post a task to shutdown concurrent message "
-           "loop. The task will be executed on the callers thread.";
-    lock.unlock();
-    ExecuteTask(task);
+void ConcurrentMessageLoop::PostHighPriorityTask(const fml::closure& task) {
+  if (!task || ExecuteTaskIfShutdown(task)) {
     return;
   }
 
-  tasks_.push(task);
+  high_priority_tasks_.Push(task);
+  OnTaskPosted();
+}
+
+void ConcurrentMessageLoop::PostTaskToWorker(size_t worker_index,
+                                             const fml::closure& task) {
+  if (!task || ExecuteTaskIfShutdown(task)) {
+    return;
+  }
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  Worker* worker = workers_[worker_index % worker_count_].get();
+  if (worker == GetCurrentWorker()) {
+    worker->local_tasks.Push(new fml::closure(task));
+  } else {
+    worker->affine_tasks.Push(task);
+  }
+  OnTaskPosted();
+}
 
+void ConcurrentMessageLoop::OnTaskPosted() {
+  // Pairs with the idle worker count being incremented before the pending
+  // task count is checked in |WorkerMain|: either the worker sees the task or
+  // this sees the idle worker.
+  pending_task_count_.fetch_add(1, std::memory_order_seq_cst);
+  if (idle_worker_count_.load(std::memory_order_seq_cst) == 0) {
+    return;
+  }
+
+  // Acquire the mutex so that the idle worker is either waiting on the
+  // condition variable or yet to check for the task. Notify with the mutex
+  // unlocked since it has to be acquired on the other thread anyway.
+  { std::scoped_lock lock(tasks_mutex_); }
   tasks_condition_.notify_one();
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
+void ConcurrentMessageLoop::WorkerMain(Worker* worker) {
+  current_worker_ = worker;
+
+  for (size_t tick = 0; !shutdown_.load(std::memory_order_acquire); ++tick) {
+    if (worker->has_thread_tasks.load(std::memory_order_acquire)) {
+      for (const auto& thread_task : GetThreadTasks(worker)) {
+        ExecuteTask(thread_task);
+      }
+    }
+
+    fml::closure task;
+    if (FindTask(worker, tick, &task)) {
+      pending_task_count_.fetch_sub(1, std::memory_order_relaxed);
+      ExecuteTask(task);
+      continue;
+    }
+
+    // There may be a pending task that could not be found because another
+    // worker was taking it at the same time. The wait returns immediately in
+    // that case and the worker looks again.
     std::unique_lock lock(tasks_mutex_);
+    idle_worker_count_.fetch_add(1, std::memory_order_seq_cst);
     tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
+      return pending_task_count_.load(std::memory_order_seq_cst) > 0 ||
+             shutdown_.load(std::memory_order_relaxed) ||
+             worker->has_thread_tasks.load(std::memory_order_relaxed);
     });
+    idle_worker_count_.fetch_sub(1, std::memory_order_relaxed);
+  }
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+  current_worker_ = nullptr;
+}
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
-    }
+bool ConcurrentMessageLoop::FindTask(Worker* worker,
+                                     size_t tick,
+                                     fml::closure* task) {
+  if (high_priority_tasks_.TryPop(task)) {
+    return true;
+  }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
-    }
+  if (tick % kSharedQueueCheckInterval == kSharedQueueCheckInterval - 1 &&
+      tasks_.TryPop(task)) {
+    return true;
+  }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+  // The tasks the worker posted last are the most likely to still be in its
+  // caches.
+  fml::closure* local_task = nullptr;
+  if (worker->local_tasks.Pop(&local_task)) {
+    *task = std::move(*local_task);
+    delete local_task;
+    return true;
+  }
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      ExecuteTask(task);
-    }
+  if (worker->affine_tasks.TryPop(task) || tasks_.TryPop(task)) {
+    return true;
+  }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
-    }
+  return StealTask(worker, task);
+}
 
-    if (shutdown_now) {
-      break;
+bool ConcurrentMessageLoop::StealTask(Worker* worker, fml::closure* task) {
+  for (size_t i = 1; i < worker_count_; ++i) {
+    Worker* victim = workers_[(worker->index + i) % worker_count_].get();
+    // Steal the oldest tasks, they are the least likely to be in the caches
+    // of the victim and usually the largest chunks of work.
+    fml::closure* stolen_task = nullptr;
+    if (victim->local_tasks.Steal(&stolen_task)) {
+      *task = std::move(*stolen_task);
+      delete stolen_task;
+      return true;
+    }
+    if (victim->affine_tasks.TryPop(task)) {
+      return true;
     }
   }
+  return false;
 }
 
 void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
@@ -118,7 +246,7 @@ void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
 
 void ConcurrentMessageLoop::Terminate() {
   std::scoped_lock lock(tasks_mutex_);
-  shutdown_ = true;
+  shutdown_.store(true, std::memory_order_release);
   tasks_condition_.notify_all();
 }
 
@@ -128,25 +256,34 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
   }
 
   std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (const auto& worker : workers_) {
+    worker->thread_tasks.emplace_back(task);
+    worker->has_thread_tasks.store(true, std::memory_order_release);
   }
   tasks_condition_.notify_all();
 }
 
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
+std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasks(
+    Worker* worker) {
+  std::scoped_lock lock(tasks_mutex_);
   std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
+  std::swap(pending_tasks, worker->thread_tasks);
+  worker->has_thread_tasks.store(false, std::memory_order_relaxed);
   return pending_tasks;
 }
 
+ConcurrentMessageLoop::Worker* ConcurrentMessageLoop::GetCurrentWorker()
+    const {
+  if (current_worker_ && current_worker_->loop == this) {
+    return current_worker_;
+  }
+  return nullptr;
+}
+
+bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
+  return GetCurrentWorker() != nullptr;
+}
+
 ConcurrentTaskRunner::ConcurrentTaskRunner(
     std::weak_ptr<ConcurrentMessageLoop> weak_loop)
     : weak_loop_(std::move(weak_loop)) {}
@@ -163,20 +300,34 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
     return;
   }
 
-  FML_DLOG(WARNING)
-      << "Tried to post to a concurrent message loop that has already died. "
-         "Executing the task on the callers thread.";
-  task();
+  RunTaskOnCallerThread(task);
 }
 
-bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
+void ConcurrentTaskRunner::PostHighPriorityTask(const fml::closure& task) {
+  if (!task) {
+    return;
   }
-  return false;
+
+  if (auto loop = weak_loop_.lock()) {
+    loop->PostHighPriorityTask(task);
+    return;
+  }
+
+  RunTaskOnCallerThread(task);
+}
+
+void ConcurrentTaskRunner::PostTaskToWorker(size_t worker_index,
+                                            const fml::closure& task) {
+  if (!task) {
+    return;
+  }
+
+  if (auto loop = weak_loop_.lock()) {
+    loop->PostTaskToWorker(worker_index, task);
+    return;
+  }
+
+  RunTaskOnCallerThread(task);
 }
 
 }  // namespace fml
@@ -5,19 +5,33 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/work_stealing_deque.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+//------------------------------------------------------------------------------
+/// @brief      A pool of worker threads that schedules its tasks by work
+///             stealing.
+///
+///             Tasks posted from a worker go to the worker's own lock-free
+///             deque and tasks posted from other threads go to a shared
+///             queue. Idle workers steal from the deques of busy ones. Latency
+///             sensitive tasks can be posted to a priority lane that is
+///             drained before any other task.
+///
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -43,22 +57,69 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  // A queue that may be pushed to from any thread.
+  struct SharedQueue {
+    std::mutex mutex;
+    std::deque<fml::closure> tasks;
+    std::atomic<size_t> size = 0;
+
+    void Push(const fml::closure& task);
+
+    bool TryPop(fml::closure* task);
+  };
+
+  struct Worker {
+    ConcurrentMessageLoop* const loop;
+    const size_t index;
+    std::thread thread;
+    // Tasks posted by the worker itself. Only the worker pushes and pops,
+    // others steal.
+    WorkStealingDeque<fml::closure*> local_tasks;
+    // Tasks posted by other threads with an affinity for this worker. They may
+    // still be stolen.
+    SharedQueue affine_tasks;
+    // Tasks that must be run by this worker. Guarded by |tasks_mutex_|.
+    std::vector<fml::closure> thread_tasks;
+    std::atomic<bool> has_thread_tasks = false;
+
+    Worker(ConcurrentMessageLoop* loop, size_t index);
+  };
+
+  // The worker running on the current thread, if any.
+  static thread_local Worker* current_worker_;
+
   size_t worker_count_ = 0;
-  std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  SharedQueue tasks_;
+  SharedQueue high_priority_tasks_;
+  // The number of tasks in all the queues, including the deques of the
+  // workers.
+  std::atomic<size_t> pending_task_count_ = 0;
+  std::atomic<size_t> idle_worker_count_ = 0;
+  std::atomic<bool> shutdown_ = false;
+  // Guards the idle workers and |Worker::thread_tasks|.
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
 
-  void WorkerMain();
+  void WorkerMain(Worker* worker);
 
   void PostTask(const fml::closure& task);
 
-  bool HasThreadTasksLocked() const;
+  void PostHighPriorityTask(const fml::closure& task);
+
+  void PostTaskToWorker(size_t worker_index, const fml::closure& task);
+
+  bool ExecuteTaskIfShutdown(const fml::closure& task);
+
+  void OnTaskPosted();
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  bool FindTask(Worker* worker, size_t tick, fml::closure* task);
+
+  bool StealTask(Worker* worker, fml::closure* task);
+
+  std::vector<fml::closure> GetThreadTasks(Worker* worker);
+
+  Worker* GetCurrentWorker() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
@@ -71,6 +132,21 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   void PostTask(const fml::closure& task) override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Posts a latency sensitive task, for example one the raster
+  ///             thread is blocked on. It runs before any task posted with
+  ///             |PostTask|.
+  ///
+  void PostHighPriorityTask(const fml::closure& task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Posts a task that should preferably run on the worker at
+  ///             |worker_index| modulo the number of workers, for example to
+  ///             keep its data in that worker's caches. Other workers may
+  ///             still run it if they are idle.
+  ///
+  void PostTaskToWorker(size_t worker_index, const fml::closure& task);
+
  private:
   friend ConcurrentMessageLoop;
 
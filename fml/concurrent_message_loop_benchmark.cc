@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// Spins for a while to simulate a small amount of work.
+void DoWork(size_t iterations) {
+  std::atomic<size_t> sink = 0;
+  for (size_t i = 0; i < iterations; i++) {
+    sink.fetch_add(i, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+// Tasks posted from several threads that are not workers, such as image
+// decodes requested by the UI and IO threads.
+static void BM_ConcurrentMessageLoopPostFromThreads(  // NOLINT
+    benchmark::State& state) {
+  auto loop = ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  const size_t num_threads = 4;
+  const size_t num_tasks_per_thread = 250;
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(num_threads * num_tasks_per_thread);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; i++) {
+      threads.emplace_back([&]() {
+        for (size_t j = 0; j < num_tasks_per_thread; j++) {
+          task_runner->PostTask([&tasks_done]() {
+            DoWork(100);
+            tasks_done.CountDown();
+          });
+        }
+      });
+    }
+    tasks_done.Wait();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+}
+
+// A task that splits its work into smaller tasks, such as the tiles of a
+// display list dispatched in parallel. The subtasks land on the deque of the
+// worker and are stolen by the others.
+static void BM_ConcurrentMessageLoopFanOut(benchmark::State& state) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  const size_t num_tasks = 1000;
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(num_tasks + 1);
+    task_runner->PostTask([&]() {
+      for (size_t i = 0; i < num_tasks; i++) {
+        task_runner->PostTask([&tasks_done]() {
+          DoWork(100);
+          tasks_done.CountDown();
+        });
+      }
+      tasks_done.CountDown();
+    });
+    tasks_done.Wait();
+  }
+}
+
+// The time for a latency sensitive task to start while the workers are
+// saturated with normal tasks.
+static void BM_ConcurrentMessageLoopHighPriorityLatency(  // NOLINT
+    benchmark::State& state) {
+  auto loop = ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  const size_t num_background_tasks = 100;
+
+  while (state.KeepRunning()) {
+    CountDownLatch background_done(num_background_tasks);
+    for (size_t i = 0; i < num_background_tasks; i++) {
+      task_runner->PostTask([&background_done]() {
+        DoWork(1000);
+        background_done.CountDown();
+      });
+    }
+
+    CountDownLatch high_priority_done(1);
+    const auto start = TimePoint::Now();
+    TimePoint end;
+    task_runner->PostHighPriorityTask([&high_priority_done, &end]() {
+      end = TimePoint::Now();
+      high_priority_done.CountDown();
+    });
+    high_priority_done.Wait();
+    state.SetIterationTime((end - start).ToSecondsF());
+    background_done.Wait();
+  }
+}
+
+BENCHMARK(BM_ConcurrentMessageLoopPostFromThreads)->Arg(1)->Arg(4)->Arg(8);
+BENCHMARK(BM_ConcurrentMessageLoopFanOut)->Arg(1)->Arg(4)->Arg(8);
+BENCHMARK(BM_ConcurrentMessageLoopHighPriorityLatency)
+    ->Arg(1)
+    ->Arg(4)
+    ->Iterations(1000)
+    ->UseManualTime();
+
+}  // namespace benchmarking
+}  // namespace fml
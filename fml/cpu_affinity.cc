@@ -0,0 +1,174 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fml {
+
+CpuSpeedTracker::CpuSpeedTracker(std::vector<CpuIndexAndSpeed> data) {
+  if (data.empty()) {
+    return;
+  }
+  const auto [min, max] = std::minmax_element(
+      data.begin(), data.end(), [](const auto& a, const auto& b) {
+        return a.speed < b.speed;
+      });
+  const int64_t min_speed = min->speed;
+  const int64_t max_speed = max->speed;
+  valid_ = min_speed != max_speed;
+
+  for (const auto& cpu : data) {
+    all_.push_back(cpu.index);
+    if (cpu.speed == max_speed) {
+      performance_.push_back(cpu.index);
+    } else {
+      not_performance_.push_back(cpu.index);
+    }
+    if (cpu.speed == min_speed) {
+      efficiency_.push_back(cpu.index);
+    }
+  }
+}
+
+bool CpuSpeedTracker::IsValid() const {
+  return valid_;
+}
+
+const std::vector<size_t>& CpuSpeedTracker::GetIndices(
+    CpuAffinity affinity) const {
+  switch (affinity) {
+    case CpuAffinity::kPerformance:
+      return performance_;
+    case CpuAffinity::kEfficiency:
+      return efficiency_;
+    case CpuAffinity::kNotPerformance:
+      return not_performance_;
+    case CpuAffinity::kAll:
+      return all_;
+  }
+  FML_UNREACHABLE();
+}
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+namespace {
+
+std::optional<int64_t> ReadCpuMaxFrequency(size_t index) {
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(index) +
+                     "/cpufreq/cpuinfo_max_freq");
+  int64_t frequency = 0;
+  if (!(file >> frequency)) {
+    return std::nullopt;
+  }
+  return frequency;
+}
+
+std::unique_ptr<CpuSpeedTracker> CreateCpuSpeedTracker() {
+  const long cpu_count = sysconf(_SC_NPROCESSORS_CONF);
+  if (cpu_count <= 0) {
+    return nullptr;
+  }
+  std::vector<CpuIndexAndSpeed> data;
+  for (size_t i = 0; i < static_cast<size_t>(cpu_count); i++) {
+    // Offline cores have no frequency, leave them out.
+    if (auto frequency = ReadCpuMaxFrequency(i)) {
+      data.push_back({.index = i, .speed = frequency.value()});
+    }
+  }
+  if (data.empty()) {
+    return nullptr;
+  }
+  return std::make_unique<CpuSpeedTracker>(std::move(data));
+}
+
+// The layout of the kernel's struct sched_attr, which libc does not declare.
+struct SchedAttr {
+  uint32_t size;
+  uint32_t sched_policy;
+  uint64_t sched_flags;
+  int32_t sched_nice;
+  uint32_t sched_priority;
+  uint64_t sched_runtime;
+  uint64_t sched_deadline;
+  uint64_t sched_period;
+  uint32_t sched_util_min;
+  uint32_t sched_util_max;
+};
+
+constexpr uint64_t kSchedFlagKeepPolicy = 0x08;
+constexpr uint64_t kSchedFlagKeepParams = 0x10;
+constexpr uint64_t kSchedFlagUtilClampMin = 0x20;
+constexpr uint64_t kSchedFlagUtilClampMax = 0x40;
+
+}  // namespace
+
+const CpuSpeedTracker* GetCpuSpeedTracker() {
+  static const CpuSpeedTracker* tracker = CreateCpuSpeedTracker().release();
+  return tracker;
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+  const CpuSpeedTracker* tracker = GetCpuSpeedTracker();
+  if (!tracker || !tracker->IsValid()) {
+    return false;
+  }
+  const auto& indices = tracker->GetIndices(affinity);
+  if (indices.empty()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t index : indices) {
+    CPU_SET(index, &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+bool RequestUtilizationClamp(uint32_t min_util, uint32_t max_util) {
+#if defined(__NR_sched_setattr)
+  FML_DCHECK(min_util <= max_util && max_util <= 1024u);
+  SchedAttr attr = {};
+  attr.size = sizeof(attr);
+  attr.sched_flags = kSchedFlagKeepPolicy | kSchedFlagKeepParams |
+                     kSchedFlagUtilClampMin | kSchedFlagUtilClampMax;
+  attr.sched_util_min = min_util;
+  attr.sched_util_max = max_util;
+  return syscall(__NR_sched_setattr, 0, &attr, 0) == 0;
+#else
+  return false;
+#endif  // defined(__NR_sched_setattr)
+}
+
+#else  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+const CpuSpeedTracker* GetCpuSpeedTracker() {
+  return nullptr;
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+  return false;
+}
+
+bool RequestUtilizationClamp(uint32_t min_util, uint32_t max_util) {
+  return false;
+}
+
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+}  // namespace fml
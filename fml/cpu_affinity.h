@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_CPU_AFFINITY_H_
+#define FLUTTER_FML_CPU_AFFINITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fml {
+
+/// The kind of cores a thread may run on.
+enum class CpuAffinity {
+  /// Only the fastest cores.
+  kPerformance,
+  /// Only the slowest cores.
+  kEfficiency,
+  /// Every core but the fastest ones.
+  kNotPerformance,
+  /// Every core.
+  kAll,
+};
+
+struct CpuIndexAndSpeed {
+  // The index of the core.
+  size_t index;
+  // The maximum frequency of the core, in an arbitrary unit.
+  int64_t speed;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Classifies the cores of a heterogeneous (big.LITTLE) CPU by
+///             their maximum frequency.
+///
+class CpuSpeedTracker {
+ public:
+  explicit CpuSpeedTracker(std::vector<CpuIndexAndSpeed> data);
+
+  /// Whether the cores have different speeds. If they don't, restricting the
+  /// affinity of a thread has no benefit.
+  bool IsValid() const;
+
+  /// The indices of the cores matching |affinity|.
+  const std::vector<size_t>& GetIndices(CpuAffinity affinity) const;
+
+ private:
+  bool valid_ = false;
+  std::vector<size_t> performance_;
+  std::vector<size_t> efficiency_;
+  std::vector<size_t> not_performance_;
+  std::vector<size_t> all_;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The core classification of this device, read once from
+///             `/sys/devices/system/cpu`. Only available on Linux and Android.
+///
+/// @return     The tracker, or nullptr if the core speeds are unknown.
+///
+const CpuSpeedTracker* GetCpuSpeedTracker();
+
+//------------------------------------------------------------------------------
+/// @brief      Restricts the calling thread to the cores matching |affinity|.
+///
+/// @return     Whether the affinity was applied. Fails on platforms other than
+///             Linux and Android and on CPUs with cores of a single speed.
+///
+bool RequestAffinity(CpuAffinity affinity);
+
+//------------------------------------------------------------------------------
+/// @brief      Clamps the utilization the scheduler assumes for the calling
+///             thread to [min_util, max_util] out of 1024, with the Linux
+///             uclamp attributes. A minimum makes the CPU frequency governor
+///             ramp up as soon as the thread runs instead of after it has
+///             been busy for a while.
+///
+/// @return     Whether the clamp was applied. It requires Linux 5.3 or later
+///             built with uclamp support.
+///
+bool RequestUtilizationClamp(uint32_t min_util, uint32_t max_util);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_CPU_AFFINITY_H_
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FML_DELAYED_TASK_H_
 #define FLUTTER_FML_DELAYED_TASK_H_
 
+#include <algorithm>
 #include <queue>
 
 #include "flutter/fml/closure.h"
@@ -16,16 +17,26 @@ namespace fml {
 class DelayedTask {
  public:
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::closure task,
               fml::TimePoint target_time,
               fml::TaskSourceGrade task_source_grade);
 
   DelayedTask(const DelayedTask& other);
 
+  DelayedTask(DelayedTask&& other);
+
+  DelayedTask& operator=(const DelayedTask& other);
+
+  DelayedTask& operator=(DelayedTask&& other);
+
   ~DelayedTask();
 
   const fml::closure& GetTask() const;
 
+  /// Moves the task out, leaving an empty closure. The task is no longer
+  /// needed to order the delayed tasks.
+  fml::closure TakeTask();
+
   fml::TimePoint GetTargetTime() const;
 
   fml::TaskSourceGrade GetTaskSourceGrade() const;
@@ -39,9 +50,21 @@ class DelayedTask {
   fml::TaskSourceGrade task_source_grade_;
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+/// A heap of delayed tasks, soonest first. The tasks are moved in and out of
+/// the heap, so their closures are not copied, which would allocate for the
+/// closures that capture more than fits in a |std::function|.
+class DelayedTaskQueue : public std::priority_queue<DelayedTask,
+                                                    std::deque<DelayedTask>,
+                                                    std::greater<DelayedTask>> {
+ public:
+  /// Removes the top task and returns its closure.
+  fml::closure PopTask() {
+    std::pop_heap(c.begin(), c.end(), comp);
+    fml::closure task = c.back().TakeTask();
+    c.pop_back();
+    return task;
+  }
+};
 
 }  // namespace fml
 
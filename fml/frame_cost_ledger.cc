@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/frame_cost_ledger.h"
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+thread_local FrameCostLedger* tCurrentLedger = nullptr;
+thread_local ScopedFrameCost* tCurrentCost = nullptr;
+}  // namespace
+
+const char* FrameCostLedger::GetCategoryName(Category category) {
+  switch (category) {
+    case Category::kPipelineCompile:
+      return "pipelineCompile";
+    case Category::kGlyphAtlasUpdate:
+      return "glyphAtlasUpdate";
+    case Category::kTextureUpload:
+      return "textureUpload";
+    case Category::kTextureAllocation:
+      return "textureAllocation";
+    case Category::kRasterCacheUpdate:
+      return "rasterCacheUpdate";
+    case Category::kDisplayListDispatch:
+      return "displayListDispatch";
+  }
+  FML_UNREACHABLE();
+}
+
+FrameCostLedger* FrameCostLedger::GetCurrent() {
+  return tCurrentLedger;
+}
+
+FrameCostLedger::ScopedCurrent::ScopedCurrent(FrameCostLedger* ledger)
+    : previous_(tCurrentLedger) {
+  tCurrentLedger = ledger;
+}
+
+FrameCostLedger::ScopedCurrent::~ScopedCurrent() {
+  tCurrentLedger = previous_;
+}
+
+FrameCostLedger::FrameCostLedger() = default;
+
+FrameCostLedger::~FrameCostLedger() = default;
+
+void FrameCostLedger::AddCost(Category category, TimeDelta cost) {
+  cost_nanos_[static_cast<size_t>(category)].fetch_add(
+      cost.ToNanoseconds(), std::memory_order_relaxed);
+}
+
+TimeDelta FrameCostLedger::GetCost(Category category) const {
+  return TimeDelta::FromNanoseconds(
+      cost_nanos_[static_cast<size_t>(category)].load(
+          std::memory_order_relaxed));
+}
+
+std::array<TimeDelta, FrameCostLedger::kCategoryCount>
+FrameCostLedger::GetCosts() const {
+  std::array<TimeDelta, kCategoryCount> costs;
+  for (size_t i = 0; i < kCategoryCount; i++) {
+    costs[i] = GetCost(static_cast<Category>(i));
+  }
+  return costs;
+}
+
+ScopedFrameCost::ScopedFrameCost(FrameCostLedger::Category category)
+    : category_(category),
+      ledger_(FrameCostLedger::GetCurrent()),
+      parent_(ledger_ ? tCurrentCost : nullptr) {
+  if (!ledger_) {
+    return;
+  }
+  start_ = TimePoint::Now();
+  tCurrentCost = this;
+}
+
+ScopedFrameCost::~ScopedFrameCost() {
+  if (!ledger_) {
+    return;
+  }
+  FML_DCHECK(tCurrentCost == this);
+  const TimeDelta duration = TimePoint::Now() - start_;
+  ledger_->AddCost(category_, duration - nested_duration_);
+  if (parent_) {
+    parent_->nested_duration_ = parent_->nested_duration_ + duration;
+  }
+  tCurrentCost = parent_;
+}
+
+}  // namespace fml
@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_FRAME_COST_LEDGER_H_
+#define FLUTTER_FML_FRAME_COST_LEDGER_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      The time a frame spent in well-known expensive operations, so
+///             that it can be told why a frame missed its deadline.
+///
+///             The rasterizer makes the ledger of a frame current on the
+///             raster thread while it is drawn, and the expensive operations
+///             record their duration with a |ScopedFrameCost|. Operations that
+///             run while no ledger is current, for example on other threads,
+///             are not recorded.
+///
+class FrameCostLedger {
+ public:
+  enum class Category {
+    /// Waiting for a pipeline that was not compiled yet.
+    kPipelineCompile,
+    /// Rebuilding or growing a glyph atlas.
+    kGlyphAtlasUpdate,
+    /// Uploading the contents of a texture from the host.
+    kTextureUpload,
+    /// Allocating the device memory of a new texture.
+    kTextureAllocation,
+    /// Rasterizing the entries of the raster cache.
+    kRasterCacheUpdate,
+    /// The rest of the time spent painting the layer tree and dispatching its
+    /// display lists to the rendering backend.
+    kDisplayListDispatch,
+  };
+
+  static constexpr size_t kCategoryCount =
+      static_cast<size_t>(Category::kDisplayListDispatch) + 1;
+
+  /// The lower camel case name of |category|, as used by the service protocol.
+  static const char* GetCategoryName(Category category);
+
+  /// The ledger that is current on the calling thread, if any.
+  static FrameCostLedger* GetCurrent();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes a ledger current on the calling thread for the lifetime
+  ///             of this object.
+  ///
+  class ScopedCurrent {
+   public:
+    explicit ScopedCurrent(FrameCostLedger* ledger);
+
+    ~ScopedCurrent();
+
+   private:
+    FrameCostLedger* const previous_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedCurrent);
+  };
+
+  FrameCostLedger();
+
+  ~FrameCostLedger();
+
+  void AddCost(Category category, TimeDelta cost);
+
+  TimeDelta GetCost(Category category) const;
+
+  std::array<TimeDelta, kCategoryCount> GetCosts() const;
+
+ private:
+  std::array<std::atomic<int64_t>, kCategoryCount> cost_nanos_ = {};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameCostLedger);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Records its lifetime into the current ledger, if any. Costs are
+///             exclusive: the time spent in nested costs is only attributed
+///             to the innermost one.
+///
+class ScopedFrameCost {
+ public:
+  explicit ScopedFrameCost(FrameCostLedger::Category category);
+
+  ~ScopedFrameCost();
+
+ private:
+  const FrameCostLedger::Category category_;
+  FrameCostLedger* const ledger_;
+  ScopedFrameCost* const parent_;
+  TimePoint start_;
+  TimeDelta nested_duration_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrameCost);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_FRAME_COST_LEDGER_H_
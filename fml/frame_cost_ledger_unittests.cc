@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/frame_cost_ledger.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+using Category = FrameCostLedger::Category;
+
+TEST(FrameCostLedgerTest, RecordsOnlyIntoTheCurrentLedger) {
+  FrameCostLedger ledger;
+  { ScopedFrameCost cost(Category::kTextureUpload); }
+  EXPECT_EQ(ledger.GetCost(Category::kTextureUpload), TimeDelta::Zero());
+
+  {
+    FrameCostLedger::ScopedCurrent current(&ledger);
+    EXPECT_EQ(FrameCostLedger::GetCurrent(), &ledger);
+    ScopedFrameCost cost(Category::kTextureUpload);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(FrameCostLedger::GetCurrent(), nullptr);
+  EXPECT_GT(ledger.GetCost(Category::kTextureUpload), TimeDelta::Zero());
+  EXPECT_EQ(ledger.GetCost(Category::kPipelineCompile), TimeDelta::Zero());
+}
+
+TEST(FrameCostLedgerTest, NestedCostsAreExclusive) {
+  FrameCostLedger ledger;
+  FrameCostLedger::ScopedCurrent current(&ledger);
+  {
+    ScopedFrameCost dispatch(Category::kDisplayListDispatch);
+    {
+      ScopedFrameCost compile(Category::kPipelineCompile);
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto costs = ledger.GetCosts();
+  const auto compile = costs[static_cast<size_t>(Category::kPipelineCompile)];
+  const auto dispatch =
+      costs[static_cast<size_t>(Category::kDisplayListDispatch)];
+  EXPECT_GE(compile, TimeDelta::FromMilliseconds(50));
+  EXPECT_GE(dispatch, TimeDelta::FromMilliseconds(1));
+  EXPECT_LT(dispatch, TimeDelta::FromMilliseconds(50));
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,179 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/host_allocator.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+void* MallocAllocate(void* user_data,
+                     size_t size,
+                     HostAllocationCategory category) {
+  return std::malloc(size);
+}
+
+void* MallocReallocate(void* user_data,
+                       void* allocation,
+                       size_t old_size,
+                       size_t new_size,
+                       HostAllocationCategory category) {
+  return std::realloc(allocation, new_size);
+}
+
+void MallocFree(void* user_data,
+                void* allocation,
+                size_t size,
+                HostAllocationCategory category) {
+  std::free(allocation);
+}
+
+constexpr HostAllocator kMallocAllocator = {nullptr, MallocAllocate,
+                                           MallocReallocate, MallocFree};
+
+struct CategoryCounters {
+  std::atomic<uint64_t> allocation_count = 0;
+  std::atomic<uint64_t> allocated_bytes = 0;
+  std::atomic<uint64_t> peak_allocated_bytes = 0;
+};
+
+CategoryCounters gCounters[kHostAllocationCategoryCount];
+
+std::mutex gAllocatorMutex;
+// Only replaced while there are no live allocations, so the routines never
+// see an allocation of another allocator.
+HostAllocator gCustomAllocator;
+std::atomic<const HostAllocator*> gAllocator = &kMallocAllocator;
+
+CategoryCounters& CountersFor(HostAllocationCategory category) {
+  const size_t index = static_cast<size_t>(category);
+  FML_DCHECK(index < kHostAllocationCategoryCount);
+  return gCounters[index];
+}
+
+void RecordAllocated(HostAllocationCategory category, size_t size) {
+  CategoryCounters& counters = CountersFor(category);
+  counters.allocation_count.fetch_add(1, std::memory_order_relaxed);
+  const uint64_t allocated =
+      counters.allocated_bytes.fetch_add(size, std::memory_order_relaxed) +
+      size;
+  uint64_t peak = counters.peak_allocated_bytes.load(std::memory_order_relaxed);
+  while (peak < allocated &&
+         !counters.peak_allocated_bytes.compare_exchange_weak(
+             peak, allocated, std::memory_order_relaxed)) {
+  }
+}
+
+void RecordFreed(HostAllocationCategory category, size_t size) {
+  CategoryCounters& counters = CountersFor(category);
+  counters.allocation_count.fetch_sub(1, std::memory_order_relaxed);
+  counters.allocated_bytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+bool HasLiveAllocations() {
+  for (const CategoryCounters& counters : gCounters) {
+    if (counters.allocation_count.load(std::memory_order_relaxed) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsSameAllocator(const HostAllocator& a, const HostAllocator& b) {
+  return a.user_data == b.user_data && a.allocate == b.allocate &&
+         a.reallocate == b.reallocate && a.free == b.free;
+}
+
+}  // namespace
+
+bool SetHostAllocator(const HostAllocator* allocator) {
+  if (allocator && (!allocator->allocate || !allocator->reallocate ||
+                    !allocator->free)) {
+    FML_LOG(ERROR) << "The host allocator is missing routines.";
+    return false;
+  }
+
+  std::scoped_lock lock(gAllocatorMutex);
+  const HostAllocator& current = *gAllocator.load();
+  const HostAllocator& requested = allocator ? *allocator : kMallocAllocator;
+  if (IsSameAllocator(current, requested)) {
+    return true;
+  }
+  if (HasLiveAllocations()) {
+    FML_LOG(ERROR) << "The host allocator can't be replaced while it has live "
+                      "allocations.";
+    return false;
+  }
+  if (allocator) {
+    gCustomAllocator = *allocator;
+    gAllocator = &gCustomAllocator;
+  } else {
+    gAllocator = &kMallocAllocator;
+  }
+  return true;
+}
+
+bool IsUsingCustomHostAllocator() {
+  return gAllocator.load() != &kMallocAllocator;
+}
+
+void* HostAllocate(size_t size, HostAllocationCategory category) {
+  const HostAllocator& allocator = *gAllocator.load();
+  void* allocation = allocator.allocate(allocator.user_data, size, category);
+  if (allocation) {
+    RecordAllocated(category, size);
+  }
+  return allocation;
+}
+
+void* HostReallocate(void* allocation,
+                     size_t old_size,
+                     size_t new_size,
+                     HostAllocationCategory category) {
+  if (!allocation) {
+    return HostAllocate(new_size, category);
+  }
+  const HostAllocator& allocator = *gAllocator.load();
+  void* reallocation = allocator.reallocate(allocator.user_data, allocation,
+                                            old_size, new_size, category);
+  if (reallocation) {
+    RecordFreed(category, old_size);
+    RecordAllocated(category, new_size);
+  }
+  return reallocation;
+}
+
+void HostFree(void* allocation, size_t size, HostAllocationCategory category) {
+  if (!allocation) {
+    return;
+  }
+  const HostAllocator& allocator = *gAllocator.load();
+  allocator.free(allocator.user_data, allocation, size, category);
+  RecordFreed(category, size);
+}
+
+void HostForget(size_t size, HostAllocationCategory category) {
+  FML_DCHECK(!IsUsingCustomHostAllocator());
+  RecordFreed(category, size);
+}
+
+HostAllocationStats GetHostAllocationStats(HostAllocationCategory category) {
+  const CategoryCounters& counters = CountersFor(category);
+  HostAllocationStats stats;
+  stats.allocation_count =
+      counters.allocation_count.load(std::memory_order_relaxed);
+  stats.allocated_bytes =
+      counters.allocated_bytes.load(std::memory_order_relaxed);
+  stats.peak_allocated_bytes =
+      counters.peak_allocated_bytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace fml
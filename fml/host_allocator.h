@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_HOST_ALLOCATOR_H_
+#define FLUTTER_FML_HOST_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fml {
+
+/// The engine's large host memory allocations, which are accounted for
+/// separately.
+enum class HostAllocationCategory {
+  /// The buffers of |MallocMapping|s. Mostly assets and platform messages.
+  kMapping,
+  /// The op buffers of display lists.
+  kDisplayList,
+  /// The host buffers of Impeller, such as the staging of uniform and vertex
+  /// data.
+  kImpeller,
+  /// The pixels of decoded images before they are uploaded.
+  kImageDecode,
+};
+
+constexpr size_t kHostAllocationCategoryCount = 4;
+
+//------------------------------------------------------------------------------
+/// @brief      The routines the allocation sites of the categories above get
+///             their memory from, so that the embedder can provide its own
+///             allocator and budget. The sizes are passed back on reallocation
+///             and free, so the allocator does not need to track them.
+///
+///             The routines may be called on any thread.
+///
+struct HostAllocator {
+  void* user_data = nullptr;
+  /// Returns nullptr on failure.
+  void* (*allocate)(void* user_data,
+                    size_t size,
+                    HostAllocationCategory category) = nullptr;
+  /// Returns nullptr on failure, in which case the allocation is unchanged.
+  void* (*reallocate)(void* user_data,
+                      void* allocation,
+                      size_t old_size,
+                      size_t new_size,
+                      HostAllocationCategory category) = nullptr;
+  void (*free)(void* user_data,
+               void* allocation,
+               size_t size,
+               HostAllocationCategory category) = nullptr;
+};
+
+struct HostAllocationStats {
+  /// The number of live allocations.
+  uint64_t allocation_count = 0;
+  /// The size of the live allocations.
+  uint64_t allocated_bytes = 0;
+  /// The most the live allocations have ever added up to.
+  uint64_t peak_allocated_bytes = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Replaces the process wide allocator, which defaults to malloc.
+///
+///             Allocations may not move between allocators, so this fails
+///             unless there are no live allocations, or the allocator is the
+///             one already in use.
+///
+/// @param[in]  allocator  The allocator, or nullptr to go back to malloc. All
+///                        three routines must be set.
+///
+/// @return     Whether the allocator is in use.
+///
+bool SetHostAllocator(const HostAllocator* allocator);
+
+/// Whether an allocator other than malloc is in use.
+bool IsUsingCustomHostAllocator();
+
+/// Returns nullptr on failure.
+void* HostAllocate(size_t size, HostAllocationCategory category);
+
+/// Behaves like realloc: a nullptr |allocation| allocates, and a failure
+/// returns nullptr and leaves |allocation| alone.
+void* HostReallocate(void* allocation,
+                     size_t old_size,
+                     size_t new_size,
+                     HostAllocationCategory category);
+
+/// Ignores nullptr.
+void HostFree(void* allocation, size_t size, HostAllocationCategory category);
+
+/// Stops accounting for an allocation of the default allocator, when its
+/// ownership is handed to code that will `free()` it.
+void HostForget(size_t size, HostAllocationCategory category);
+
+HostAllocationStats GetHostAllocationStats(HostAllocationCategory category);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_HOST_ALLOCATOR_H_
@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/host_allocator.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+struct CountingAllocator {
+  size_t allocations = 0;
+  size_t frees = 0;
+  size_t live_bytes = 0;
+  HostAllocationCategory last_category = HostAllocationCategory::kMapping;
+};
+
+void* CountingAllocate(void* user_data,
+                       size_t size,
+                       HostAllocationCategory category) {
+  auto* counter = static_cast<CountingAllocator*>(user_data);
+  counter->allocations++;
+  counter->live_bytes += size;
+  counter->last_category = category;
+  return std::malloc(size);
+}
+
+void* CountingReallocate(void* user_data,
+                         void* allocation,
+                         size_t old_size,
+                         size_t new_size,
+                         HostAllocationCategory category) {
+  auto* counter = static_cast<CountingAllocator*>(user_data);
+  counter->live_bytes += new_size - old_size;
+  counter->last_category = category;
+  return std::realloc(allocation, new_size);
+}
+
+void CountingFree(void* user_data,
+                  void* allocation,
+                  size_t size,
+                  HostAllocationCategory category) {
+  auto* counter = static_cast<CountingAllocator*>(user_data);
+  counter->frees++;
+  counter->live_bytes -= size;
+  std::free(allocation);
+}
+
+HostAllocator MakeCountingAllocator(CountingAllocator* counter) {
+  HostAllocator allocator;
+  allocator.user_data = counter;
+  allocator.allocate = CountingAllocate;
+  allocator.reallocate = CountingReallocate;
+  allocator.free = CountingFree;
+  return allocator;
+}
+
+}  // namespace
+
+TEST(HostAllocatorTest, TracksTheLiveAllocationsOfEachCategory) {
+  const HostAllocationStats before =
+      GetHostAllocationStats(HostAllocationCategory::kDisplayList);
+
+  void* allocation = HostAllocate(16, HostAllocationCategory::kDisplayList);
+  ASSERT_NE(allocation, nullptr);
+  allocation =
+      HostReallocate(allocation, 16, 64, HostAllocationCategory::kDisplayList);
+  ASSERT_NE(allocation, nullptr);
+
+  HostAllocationStats stats =
+      GetHostAllocationStats(HostAllocationCategory::kDisplayList);
+  EXPECT_EQ(stats.allocation_count, before.allocation_count + 1);
+  EXPECT_EQ(stats.allocated_bytes, before.allocated_bytes + 64);
+  EXPECT_GE(stats.peak_allocated_bytes, stats.allocated_bytes);
+
+  HostFree(allocation, 64, HostAllocationCategory::kDisplayList);
+  stats = GetHostAllocationStats(HostAllocationCategory::kDisplayList);
+  EXPECT_EQ(stats.allocation_count, before.allocation_count);
+  EXPECT_EQ(stats.allocated_bytes, before.allocated_bytes);
+}
+
+TEST(HostAllocatorTest, UsesTheCustomAllocator) {
+  CountingAllocator counter;
+  const HostAllocator allocator = MakeCountingAllocator(&counter);
+  ASSERT_TRUE(SetHostAllocator(&allocator));
+  EXPECT_TRUE(IsUsingCustomHostAllocator());
+
+  {
+    const char data[] = "Hello";
+    MallocMapping mapping = MallocMapping::Copy(data, sizeof(data));
+    EXPECT_EQ(counter.allocations, 1u);
+    EXPECT_EQ(counter.live_bytes, sizeof(data));
+    EXPECT_EQ(counter.last_category, HostAllocationCategory::kMapping);
+    EXPECT_EQ(std::memcmp(mapping.GetMapping(), data, sizeof(data)), 0);
+  }
+  EXPECT_EQ(counter.frees, 1u);
+  EXPECT_EQ(counter.live_bytes, 0u);
+
+  ASSERT_TRUE(SetHostAllocator(nullptr));
+  EXPECT_FALSE(IsUsingCustomHostAllocator());
+}
+
+TEST(HostAllocatorTest, ReleasedMappingsCanBeFreed) {
+  CountingAllocator counter;
+  const HostAllocator allocator = MakeCountingAllocator(&counter);
+  ASSERT_TRUE(SetHostAllocator(&allocator));
+
+  const char data[] = "Hello";
+  MallocMapping mapping = MallocMapping::Copy(data, sizeof(data));
+  uint8_t* released = mapping.Release();
+  EXPECT_EQ(counter.live_bytes, 0u);
+  EXPECT_EQ(std::memcmp(released, data, sizeof(data)), 0);
+  std::free(released);
+
+  ASSERT_TRUE(SetHostAllocator(nullptr));
+}
+
+TEST(HostAllocatorTest, CanNotBeReplacedWithLiveAllocations) {
+  CountingAllocator counter;
+  const HostAllocator allocator = MakeCountingAllocator(&counter);
+
+  void* allocation = HostAllocate(8, HostAllocationCategory::kImageDecode);
+  EXPECT_FALSE(SetHostAllocator(&allocator));
+  EXPECT_FALSE(IsUsingCustomHostAllocator());
+  HostFree(allocation, 8, HostAllocationCategory::kImageDecode);
+
+  EXPECT_TRUE(SetHostAllocator(&allocator));
+  EXPECT_TRUE(SetHostAllocator(&allocator));
+  EXPECT_TRUE(SetHostAllocator(nullptr));
+}
+
+TEST(HostAllocatorTest, RejectsIncompleteAllocators) {
+  HostAllocator allocator;
+  allocator.allocate = CountingAllocate;
+  EXPECT_FALSE(SetHostAllocator(&allocator));
+  EXPECT_FALSE(IsUsingCustomHostAllocator());
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -9,6 +9,8 @@
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/host_allocator.h"
+
 namespace fml {
 
 // FileMapping
@@ -122,20 +124,30 @@ MallocMapping::MallocMapping(uint8_t* data, size_t size)
     : data_(data), size_(size) {}
 
 MallocMapping::MallocMapping(fml::MallocMapping&& mapping)
-    : data_(mapping.data_), size_(mapping.size_) {
+    : data_(mapping.data_),
+      size_(mapping.size_),
+      host_allocated_(mapping.host_allocated_) {
   mapping.data_ = nullptr;
   mapping.size_ = 0;
+  mapping.host_allocated_ = false;
 }
 
 MallocMapping::~MallocMapping() {
-  free(data_);
+  if (host_allocated_) {
+    HostFree(data_, size_, HostAllocationCategory::kMapping);
+  } else {
+    free(data_);
+  }
   data_ = nullptr;
 }
 
 MallocMapping MallocMapping::Copy(const void* begin, size_t length) {
-  auto result =
-      MallocMapping(reinterpret_cast<uint8_t*>(malloc(length)), length);
+  auto result = MallocMapping(
+      static_cast<uint8_t*>(
+          HostAllocate(length, HostAllocationCategory::kMapping)),
+      length);
   FML_CHECK(result.GetMapping() != nullptr);
+  result.host_allocated_ = true;
   memcpy(const_cast<uint8_t*>(result.GetMapping()), begin, length);
   return result;
 }
@@ -154,6 +166,18 @@ bool MallocMapping::IsDontNeedSafe() const {
 
 uint8_t* MallocMapping::Release() {
   uint8_t* result = data_;
+  if (host_allocated_) {
+    if (IsUsingCustomHostAllocator() && data_) {
+      result = static_cast<uint8_t*>(malloc(size_));
+      FML_CHECK(result != nullptr);
+      memcpy(result, data_, size_);
+      HostFree(data_, size_, HostAllocationCategory::kMapping);
+    } else {
+      // The buffer is from malloc, and the caller takes over its accounting.
+      HostForget(size_, HostAllocationCategory::kMapping);
+    }
+    host_allocated_ = false;
+  }
   data_ = nullptr;
   size_ = 0;
   return result;
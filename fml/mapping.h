@@ -165,8 +165,9 @@ class MallocMapping final : public Mapping {
     return Copy(begin, length);
   }
 
-  /// Copies a region of memory into a MallocMapping.
-  /// The function will `abort()` if the malloc fails.
+  /// Copies a region of memory into a MallocMapping, allocated with the
+  /// |HostAllocator| in the |HostAllocationCategory::kMapping| category.
+  /// The function will `abort()` if the allocation fails.
   /// @param begin The starting address of where we will copy.
   /// @param length The length of the region to copy in bytes.
   static MallocMapping Copy(const void* begin, size_t length);
@@ -180,13 +181,16 @@ class MallocMapping final : public Mapping {
   // |Mapping|
   bool IsDontNeedSafe() const override;
 
-  /// Removes ownership of the data buffer.
+  /// Removes ownership of the data buffer, which must be freed with `free()`.
+  /// A buffer from a custom |HostAllocator| is copied into one that can be.
   /// After this is called; the mapping will point to nullptr.
   [[nodiscard]] uint8_t* Release();
 
  private:
   uint8_t* data_;
   size_t size_;
+  // Whether |data_| is from |HostAllocate| rather than adopted.
+  bool host_allocated_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(MallocMapping);
 };
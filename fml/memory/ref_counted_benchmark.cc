@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/ref_counted.h"
+
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/memory/weak_ptr.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+class Frame : public fml::RefCountedThreadSafe<Frame> {
+ public:
+  int value = 0;
+
+ private:
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(Frame);
+  FML_FRIEND_MAKE_REF_COUNTED(Frame);
+
+  Frame() = default;
+  ~Frame() = default;
+};
+
+}  // namespace
+
+// The common life of an object that is handed to another thread: it is
+// created and released by its producer and consumer, and then destroyed by
+// whichever releases it last.
+static void BM_RefPtrHandoff(benchmark::State& state) {  // NOLINT
+  std::vector<fml::RefPtr<Frame>> frames(state.range(0));
+  while (state.KeepRunning()) {
+    for (auto& frame : frames) {
+      frame = fml::MakeRefCounted<Frame>();
+    }
+    std::thread consumer([&frames] {
+      for (auto& frame : frames) {
+        fml::RefPtr<Frame> consumed = frame;
+        consumed->value++;
+      }
+    });
+    consumer.join();
+    for (auto& frame : frames) {
+      frame = nullptr;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Copying and checking a weak pointer, as done for every task that is bound
+// to an object on its own thread.
+static void BM_WeakPtrCopyAndCheck(benchmark::State& state) {  // NOLINT
+  int target = 0;
+  fml::WeakPtrFactory<int> factory(&target);
+  auto weak = factory.GetWeakPtr();
+  while (state.KeepRunning()) {
+    auto copy = weak;
+    if (copy) {
+      (*copy)++;
+    }
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+BENCHMARK(BM_RefPtrHandoff)->Arg(1)->Arg(1000);
+BENCHMARK(BM_WeakPtrCopyAndCheck);
+
+}  // namespace benchmarking
+}  // namespace fml
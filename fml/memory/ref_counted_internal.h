@@ -43,18 +43,17 @@ class RefCountedThreadSafeBase {
     FML_DCHECK(!destruction_started_);
 #endif
     FML_DCHECK(ref_count_.load(std::memory_order_acquire) != 0u);
-    // TODO(vtl): We could add the following:
-    //     if (ref_count_.load(std::memory_order_relaxed) == 1u) {
-    // #ifndef NDEBUG
-    //       destruction_started_= true;
-    // #endif
-    //       return true;
-    //     }
-    // This would be correct. On ARM (an Nexus 4), in *single-threaded* tests,
-    // this seems to make the destruction case marginally faster (barely
-    // measurable), and while the non-destruction case remains about the same
-    // (possibly marginally slower, but my measurements aren't good enough to
-    // have any confidence in that). I should try multithreaded/multicore tests.
+    // The last reference is usually released by the thread that the object
+    // was handed to, after every other thread released theirs. Nobody else
+    // can add a reference then, so the read-modify-write can be skipped.
+    // The acquire makes the writes of the threads that released their
+    // references before visible to the destructor.
+    if (ref_count_.load(std::memory_order_acquire) == 1u) {
+#ifndef NDEBUG
+      destruction_started_ = true;
+#endif
+      return true;
+    }
     if (ref_count_.fetch_sub(1u, std::memory_order_release) == 1u) {
       std::atomic_thread_fence(std::memory_order_acquire);
 #ifndef NDEBUG
@@ -81,24 +81,24 @@ class WeakPtr {
 
   explicit operator bool() const {
     CheckThreadSafety();
-    return flag_ && flag_->is_valid();
+    return is_valid();
   }
 
   T* get() const {
     CheckThreadSafety();
-    return *this ? ptr_ : nullptr;
+    return is_valid() ? ptr_ : nullptr;
   }
 
   T& operator*() const {
     CheckThreadSafety();
-    FML_DCHECK(*this);
-    return *get();
+    FML_DCHECK(is_valid());
+    return *ptr_;
   }
 
   T* operator->() const {
     CheckThreadSafety();
-    FML_DCHECK(*this);
-    return get();
+    FML_DCHECK(is_valid());
+    return ptr_;
   }
 
  protected:
@@ -119,6 +119,11 @@ class WeakPtr {
                    fml::RefPtr<fml::internal::WeakPtrFlag>&& flag,
                    DebugThreadChecker checker)
       : ptr_(ptr), flag_(std::move(flag)), checker_(checker) {}
+
+  // Checking the thread is much more expensive than checking the flag in
+  // debug builds, so this is only done once per access.
+  bool is_valid() const { return flag_ && flag_->is_valid(); }
+
   T* ptr_;
   fml::RefPtr<fml::internal::WeakPtrFlag> flag_;
   DebugThreadChecker checker_;
@@ -170,24 +175,24 @@ class TaskRunnerAffineWeakPtr {
 
   explicit operator bool() const {
     CheckThreadSafety();
-    return flag_ && flag_->is_valid();
+    return is_valid();
   }
 
   T* get() const {
     CheckThreadSafety();
-    return *this ? ptr_ : nullptr;
+    return is_valid() ? ptr_ : nullptr;
   }
 
   T& operator*() const {
     CheckThreadSafety();
-    FML_DCHECK(*this);
-    return *get();
+    FML_DCHECK(is_valid());
+    return *ptr_;
   }
 
   T* operator->() const {
     CheckThreadSafety();
-    FML_DCHECK(*this);
-    return get();
+    FML_DCHECK(is_valid());
+    return ptr_;
   }
 
  protected:
@@ -206,6 +211,9 @@ class TaskRunnerAffineWeakPtr {
       DebugTaskRunnerChecker checker)
       : ptr_(ptr), flag_(std::move(flag)), checker_(checker) {}
 
+  // See |WeakPtr::is_valid|.
+  bool is_valid() const { return flag_ && flag_->is_valid(); }
+
   T* ptr_;
   fml::RefPtr<fml::internal::WeakPtrFlag> flag_;
   DebugTaskRunnerChecker checker_;
@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_impl.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/build_config.h"
@@ -53,15 +54,14 @@ MessageLoopImpl::~MessageLoopImpl() {
   task_queue_->Dispose(queue_id_);
 }
 
-void MessageLoopImpl::PostTask(const fml::closure& task,
-                               fml::TimePoint target_time) {
+void MessageLoopImpl::PostTask(fml::closure task, fml::TimePoint target_time) {
   FML_DCHECK(task != nullptr);
   if (terminated_) {
     // If the message loop has already been terminated, PostTask should destruct
     // |task| synchronously within this function.
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, std::move(task), target_time);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key,
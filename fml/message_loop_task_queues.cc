@@ -10,6 +10,7 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <utility>
 
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_source.h"
@@ -35,6 +36,26 @@ class TaskSourceGradeHolder {
 FML_THREAD_LOCAL ThreadLocalUniquePtr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
+/// Locks the entry of a queue and the entries of the queues it owns, owner
+/// first. The meta mutex must be held shared for the merged state not to
+/// change. This and the entry of a subsumed queue being only ever locked on
+/// its own, without acquiring other entries, make the order deadlock free.
+class MessageLoopTaskQueues::QueueGroupLock {
+ public:
+  QueueGroupLock(const MessageLoopTaskQueues* queues, TaskQueueId owner)
+      : owner_lock_(queues->queue_entries_.at(owner)->mutex) {
+    for (const auto& subsumed : queues->queue_entries_.at(owner)->owner_of) {
+      subsumed_locks_.emplace_back(queues->queue_entries_.at(subsumed)->mutex);
+    }
+  }
+
+ private:
+  std::unique_lock<std::mutex> owner_lock_;
+  std::vector<std::unique_lock<std::mutex>> subsumed_locks_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(QueueGroupLock);
+};
+
 TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
     : subsumed_by(_kUnmerged), created_for(created_for_arg) {
   wakeable = NULL;
@@ -48,7 +69,7 @@ MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
@@ -56,7 +77,9 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues()
-    : task_queue_id_counter_(0), order_(0) {
+    : queue_meta_mutex_(fml::SharedMutex::Create()),
+      task_queue_id_counter_(0),
+      order_(0) {
   tls_task_source_grade.reset(
       new TaskSourceGradeHolder{TaskSourceGrade::kUnspecified});
 }
@@ -64,7 +87,7 @@ MessageLoopTaskQueues::MessageLoopTaskQueues()
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -76,7 +99,8 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  QueueGroupLock group_lock(this, queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -92,19 +116,24 @@ TaskSourceGrade MessageLoopTaskQueues::GetCurrentTaskSourceGrade() {
 
 void MessageLoopTaskQueues::RegisterTask(
     TaskQueueId queue_id,
-    const fml::closure& task,
+    fml::closure task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
-  size_t order = order_++;
+  fml::SharedLock lock(*queue_meta_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != _kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
   }
 
+  // The group of the loop to wake includes this queue. The wake up has to be
+  // computed and delivered under the same lock as the registration so that
+  // concurrent registrations cannot deliver stale wake times out of order.
+  QueueGroupLock group_lock(this, loop_to_wake);
+  size_t order = order_++;
+  queue_entry->task_source->RegisterTask(
+      {order, std::move(task), target_time, task_source_grade});
+
   // This can happen when the secondary tasks are paused.
   if (HasPendingTasksUnlocked(loop_to_wake)) {
     WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
@@ -112,13 +141,15 @@ void MessageLoopTaskQueues::RegisterTask(
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  QueueGroupLock group_lock(this, queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  QueueGroupLock group_lock(this, queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
@@ -133,10 +164,11 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
-  fml::closure invocation = top.task.GetTask();
-  queue_entries_.at(top.task_queue_id)
-      ->task_source->PopTask(top.task.GetTaskSourceGrade());
   const auto task_source_grade = top.task.GetTaskSourceGrade();
+  // Pops |top.task|, so it's not used after this.
+  fml::closure invocation =
+      queue_entries_.at(top.task_queue_id)
+          ->task_source->PopTask(task_source_grade);
   tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
   return invocation;
 }
@@ -149,7 +181,8 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  QueueGroupLock group_lock(this, queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != _kUnmerged) {
     return 0;
@@ -169,20 +202,25 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  QueueGroupLock group_lock(this, queue_id);
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
@@ -205,7 +243,7 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_meta_mutex_);
   FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
       << "Wakeable can only be set once.";
   queue_entries_.at(queue_id)->wakeable = wakeable;
@@ -215,7 +253,8 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  // Holding the meta mutex exclusively, no entry can be locked.
+  fml::UniqueLock lock(*queue_meta_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
   auto& subsumed_set = owner_entry->owner_of;
@@ -263,7 +302,8 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
+  // Holding the meta mutex exclusively, no entry can be locked.
+  fml::UniqueLock lock(*queue_meta_mutex_);
   const auto& owner_entry = queue_entries_.at(owner);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
@@ -307,7 +347,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
   if (owner == _kUnmerged || subsumed == _kUnmerged) {
     return false;
   }
@@ -317,17 +357,20 @@ bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
   return queue_entries_.at(owner)->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->PauseSecondary();
+  fml::SharedLock lock(*queue_meta_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_meta_mutex_);
+  QueueGroupLock group_lock(this, queue_id);
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
   if (HasPendingTasksUnlocked(queue_id)) {
@@ -32,6 +32,11 @@ static const TaskQueueId _kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 class TaskQueueEntry {
  public:
   using TaskObservers = std::map<intptr_t, fml::closure>;
+
+  /// Guards |task_observers| and |task_source|. The other members are guarded
+  /// by the meta mutex of |MessageLoopTaskQueues|.
+  std::mutex mutex;
+
   Wakeable* wakeable;
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
@@ -61,6 +66,11 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// Each queue has its own lock so that the threads of different loops do not
+/// contend with each other. The set of queues and their merged state are
+/// guarded by a separate reader/writer lock that is only acquired exclusively
+/// to create, dispose, merge and unmerge queues.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues {
@@ -78,7 +88,7 @@ class MessageLoopTaskQueues {
   // Tasks methods.
 
   void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
+                    fml::closure task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
                         fml::TaskSourceGrade::kUnspecified);
@@ -139,6 +149,7 @@ class MessageLoopTaskQueues {
 
  private:
   class MergedQueuesRunner;
+  class QueueGroupLock;
 
   MessageLoopTaskQueues();
 
@@ -152,7 +163,10 @@ class MessageLoopTaskQueues {
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  // Guards |queue_entries_| and the merged state of the entries. The locks of
+  // the entries are only acquired while holding it, shared or exclusively.
+  // Holding it exclusively is enough to access the entries.
+  std::unique_ptr<fml::SharedMutex> queue_meta_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 #include <utility>
@@ -63,6 +64,41 @@ TEST(MessageLoopTaskQueue, RegisterTwoTasksAndCount) {
   ASSERT_TRUE(task_queue->GetNumPendingTasks(queue_id) == 2);
 }
 
+TEST(MessageLoopTaskQueue, RegisteringAndRunningTasksDoesNotCopyThem) {
+  // Large enough not to be stored inline by std::function, like the captures
+  // that copying allocates for.
+  struct CopyCounter {
+    explicit CopyCounter(int* copies) : copies(copies) {}
+    CopyCounter(const CopyCounter& other) : copies(other.copies) {
+      (*copies)++;
+    }
+    CopyCounter(CopyCounter&& other) = default;
+
+    int* copies;
+    char padding[64] = {};
+  };
+
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  int copies = 0;
+  int run_count = 0;
+  // In reverse order of their target times, so that the heap moves them.
+  for (int i = 0; i < 8; i++) {
+    auto delay = fml::TimeDelta::FromMilliseconds(8 - i);
+    task_queue->RegisterTask(
+        queue_id,
+        [counter = CopyCounter(&copies), &run_count] { run_count++; },
+        fml::TimePoint::FromEpochDelta(delay));
+  }
+  while (task_queue->HasPendingTasks(queue_id)) {
+    auto task = task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Max());
+    ASSERT_TRUE(task);
+    task();
+  }
+  EXPECT_EQ(run_count, 8);
+  EXPECT_EQ(copies, 0);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesAndCount) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
@@ -413,6 +449,57 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+//------------------------------------------------------------------------------
+/// Verifies that tasks can be registered and run concurrently while other
+/// queues are merged and unmerged.
+///
+TEST(MessageLoopTaskQueue, ConcurrentTasksWhileMergingAndUnmerging) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kThreadTaskCount = 500;
+
+  std::vector<TaskQueueId> task_queue_ids;
+  for (size_t i = 0; i < kThreadCount; ++i) {
+    task_queue_ids.emplace_back(task_queues->CreateTaskQueue());
+  }
+
+  std::atomic<size_t> run_count = 0;
+  auto thread_main = [&](TaskQueueId queue_id) {
+    for (size_t i = 0; i < kThreadTaskCount; i++) {
+      task_queues->RegisterTask(
+          queue_id, [&run_count]() { run_count++; }, ChronoTicksSinceEpoch());
+      // A merged queue has no tasks of its own to run.
+      if (auto task = task_queues->GetNextTaskToRun(
+              queue_id, fml::TimePoint::Max())) {
+        task();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back(thread_main, task_queue_ids[i]);
+  }
+
+  for (size_t i = 0; i < kThreadTaskCount; i++) {
+    ASSERT_TRUE(task_queues->Merge(task_queue_ids[0], task_queue_ids[1]));
+    ASSERT_TRUE(task_queues->Unmerge(task_queue_ids[0], task_queue_ids[1]));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& queue_id : task_queue_ids) {
+    while (auto task =
+               task_queues->GetNextTaskToRun(queue_id, fml::TimePoint::Max())) {
+      task();
+    }
+  }
+  ASSERT_EQ(run_count.load(), kThreadCount * kThreadTaskCount);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
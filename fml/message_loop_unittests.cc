@@ -6,8 +6,11 @@
 
 #include "flutter/fml/message_loop.h"
 
+#include <atomic>
 #include <iostream>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
@@ -345,3 +348,74 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedByWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 100;
+  // Also wait for the posting task so that the loop is not collected on a
+  // worker.
+  fml::CountDownLatch latch(kCount + 1);
+  std::atomic<size_t> on_worker_count = 0;
+  task_runner->PostTask([&]() {
+    for (size_t i = 0; i < kCount; ++i) {
+      task_runner->PostTask([&]() {
+        if (loop->RunsTasksOnCurrentThread()) {
+          on_worker_count++;
+        }
+        latch.CountDown();
+      });
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(on_worker_count.load(), kCount);
+  ASSERT_FALSE(loop->RunsTasksOnCurrentThread());
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsHighPriorityTasksFirst) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::AutoResetWaitableEvent unblock;
+  fml::CountDownLatch latch(3);
+  std::vector<int> order;
+  task_runner->PostTask([&]() {
+    blocked.Signal();
+    unblock.Wait();
+  });
+  blocked.Wait();
+  task_runner->PostTask([&]() {
+    order.push_back(1);
+    latch.CountDown();
+  });
+  task_runner->PostTaskToWorker(0, [&]() {
+    order.push_back(2);
+    latch.CountDown();
+  });
+  task_runner->PostHighPriorityTask([&]() {
+    order.push_back(0);
+    latch.CountDown();
+  });
+  unblock.Signal();
+  latch.Wait();
+  ASSERT_EQ(order.size(), 3u);
+  ASSERT_EQ(order[0], 0);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsThreadTasksOnEveryWorker) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/performance_hint.h"
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(FML_OS_ANDROID)
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "flutter/fml/native_library.h"
+#endif  // defined(FML_OS_ANDROID)
+
+namespace fml {
+
+#if defined(FML_OS_ANDROID)
+
+namespace {
+
+// The NDK declares these in android/performance_hint.h for API 33 and later
+// only, so they are resolved at runtime.
+struct PerformanceHintProcs {
+  void* (*GetManager)();
+  APerformanceHintSession* (*CreateSession)(void* manager,
+                                            const int32_t* thread_ids,
+                                            size_t size,
+                                            int64_t target_nanos);
+  int (*UpdateTargetWorkDuration)(APerformanceHintSession* session,
+                                  int64_t target_nanos);
+  int (*ReportActualWorkDuration)(APerformanceHintSession* session,
+                                  int64_t actual_nanos);
+  void (*CloseSession)(APerformanceHintSession* session);
+  void* manager;
+};
+
+const PerformanceHintProcs* CreatePerformanceHintProcs() {
+  auto library = NativeLibrary::Create("libandroid.so");
+  if (!library) {
+    return nullptr;
+  }
+  auto get_manager = library->ResolveFunction<decltype(
+      PerformanceHintProcs::GetManager)>("APerformanceHint_getManager");
+  auto create_session = library->ResolveFunction<decltype(
+      PerformanceHintProcs::CreateSession)>("APerformanceHint_createSession");
+  auto update_target = library->ResolveFunction<decltype(
+      PerformanceHintProcs::UpdateTargetWorkDuration)>(
+      "APerformanceHint_updateTargetWorkDuration");
+  auto report_actual = library->ResolveFunction<decltype(
+      PerformanceHintProcs::ReportActualWorkDuration)>(
+      "APerformanceHint_reportActualWorkDuration");
+  auto close_session = library->ResolveFunction<decltype(
+      PerformanceHintProcs::CloseSession)>("APerformanceHint_closeSession");
+  if (!get_manager || !create_session || !update_target || !report_actual ||
+      !close_session) {
+    return nullptr;
+  }
+  void* manager = get_manager.value()();
+  if (!manager) {
+    return nullptr;
+  }
+  // libandroid.so is never unloaded, the procs outlive |library|.
+  return new PerformanceHintProcs{
+      .GetManager = get_manager.value(),
+      .CreateSession = create_session.value(),
+      .UpdateTargetWorkDuration = update_target.value(),
+      .ReportActualWorkDuration = report_actual.value(),
+      .CloseSession = close_session.value(),
+      .manager = manager,
+  };
+}
+
+const PerformanceHintProcs* GetPerformanceHintProcs() {
+  static const PerformanceHintProcs* procs = CreatePerformanceHintProcs();
+  return procs;
+}
+
+}  // namespace
+
+std::unique_ptr<PerformanceHintSession> PerformanceHintSession::Create(
+    const std::vector<int32_t>& thread_ids,
+    TimeDelta target_work_duration) {
+  const PerformanceHintProcs* procs = GetPerformanceHintProcs();
+  if (!procs || thread_ids.empty()) {
+    return nullptr;
+  }
+  APerformanceHintSession* session = procs->CreateSession(
+      procs->manager, thread_ids.data(), thread_ids.size(),
+      target_work_duration.ToNanoseconds());
+  if (!session) {
+    // The system may refuse sessions, for example if hints are disabled.
+    return nullptr;
+  }
+  return std::unique_ptr<PerformanceHintSession>(
+      new PerformanceHintSession(session, target_work_duration));
+}
+
+int32_t PerformanceHintSession::GetCurrentThreadId() {
+  return static_cast<int32_t>(::syscall(SYS_gettid));
+}
+
+PerformanceHintSession::~PerformanceHintSession() {
+  GetPerformanceHintProcs()->CloseSession(session_);
+}
+
+void PerformanceHintSession::ReportActualWorkDuration(TimeDelta duration) {
+  if (duration <= TimeDelta::Zero()) {
+    return;
+  }
+  GetPerformanceHintProcs()->ReportActualWorkDuration(
+      session_, duration.ToNanoseconds());
+}
+
+void PerformanceHintSession::UpdateTargetWorkDuration(
+    TimeDelta target_work_duration) {
+  if (target_work_duration == target_work_duration_ ||
+      target_work_duration <= TimeDelta::Zero()) {
+    return;
+  }
+  target_work_duration_ = target_work_duration;
+  GetPerformanceHintProcs()->UpdateTargetWorkDuration(
+      session_, target_work_duration.ToNanoseconds());
+}
+
+#else  // defined(FML_OS_ANDROID)
+
+std::unique_ptr<PerformanceHintSession> PerformanceHintSession::Create(
+    const std::vector<int32_t>& thread_ids,
+    TimeDelta target_work_duration) {
+  return nullptr;
+}
+
+int32_t PerformanceHintSession::GetCurrentThreadId() {
+  return -1;
+}
+
+PerformanceHintSession::~PerformanceHintSession() = default;
+
+void PerformanceHintSession::ReportActualWorkDuration(TimeDelta duration) {}
+
+void PerformanceHintSession::UpdateTargetWorkDuration(
+    TimeDelta target_work_duration) {}
+
+#endif  // defined(FML_OS_ANDROID)
+
+PerformanceHintSession::PerformanceHintSession(
+    APerformanceHintSession* session,
+    TimeDelta target_work_duration)
+    : session_(session), target_work_duration_(target_work_duration) {
+  FML_DCHECK(session_);
+}
+
+}  // namespace fml
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PERFORMANCE_HINT_H_
+#define FLUTTER_FML_PERFORMANCE_HINT_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+// The opaque session type of the NDK.
+struct APerformanceHintSession;
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A session of the Android performance hint API (API 33 and
+///             later) for a group of threads that work towards a recurring
+///             deadline, such as the rasterization of a frame.
+///
+///             The duration of each round of work is reported to the system,
+///             which ramps the CPU frequency up when the work is about to
+///             miss the target instead of waiting for the load to rise.
+///
+///             The session is not thread safe and must be used by the thread
+///             that created it.
+///
+class PerformanceHintSession {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a session for the threads in |thread_ids|.
+  ///
+  /// @return     The session, or nullptr if the platform does not support
+  ///             performance hints.
+  ///
+  static std::unique_ptr<PerformanceHintSession> Create(
+      const std::vector<int32_t>& thread_ids,
+      TimeDelta target_work_duration);
+
+  /// The kernel identifier of the calling thread, or -1 on platforms without
+  /// performance hints.
+  static int32_t GetCurrentThreadId();
+
+  ~PerformanceHintSession();
+
+  void ReportActualWorkDuration(TimeDelta duration);
+
+  /// Updates the target if it differs from the current one, for example
+  /// because the refresh rate of the display changed.
+  void UpdateTargetWorkDuration(TimeDelta target_work_duration);
+
+ private:
+  PerformanceHintSession(APerformanceHintSession* session,
+                         TimeDelta target_work_duration);
+
+  APerformanceHintSession* const session_;
+  TimeDelta target_work_duration_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PerformanceHintSession);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PERFORMANCE_HINT_H_
@@ -18,22 +18,50 @@ SyncSwitch::Handlers& SyncSwitch::Handlers::SetIfFalse(
   return *this;
 }
 
-SyncSwitch::SyncSwitch(bool value)
-    : mutex_(std::unique_ptr<fml::SharedMutex>(fml::SharedMutex::Create())),
-      value_(value) {}
+SyncSwitch::SyncSwitch(bool value) : value_(value) {}
 
 void SyncSwitch::Execute(const SyncSwitch::Handlers& handlers) const {
-  fml::SharedLock lock(*mutex_);
-  if (value_) {
+  // The sequentially consistent increment and check pair with the ones in
+  // |SetSwitch|: either the setter sees this execution, or this execution
+  // sees the setter.
+  executions_.fetch_add(1);
+  while (is_setting_.load()) {
+    // Get out of the way of the setter and wait for it to finish.
+    FinishExecution();
+    {
+      std::unique_lock lock(mutex_);
+      cv_.wait(lock, [this] { return !is_setting_.load(); });
+    }
+    executions_.fetch_add(1);
+  }
+  if (value_.load(std::memory_order_relaxed)) {
     handlers.true_handler();
   } else {
     handlers.false_handler();
   }
+  FinishExecution();
+}
+
+void SyncSwitch::FinishExecution() const {
+  if (executions_.fetch_sub(1) == 1 && is_setting_.load()) {
+    // Taking the lock makes sure the setter is waiting before it is notified.
+    std::scoped_lock lock(mutex_);
+    cv_.notify_all();
+  }
 }
 
 void SyncSwitch::SetSwitch(bool value) {
-  fml::UniqueLock lock(*mutex_);
-  value_ = value;
+  {
+    std::unique_lock lock(mutex_);
+    // Setters release the lock while they wait, so wait for any other one.
+    cv_.wait(lock, [this] { return !is_setting_.load(); });
+    is_setting_.store(true);
+    cv_.wait(lock, [this] { return executions_.load() == 0; });
+    value_.store(value, std::memory_order_relaxed);
+    // Publishes |value_| to the executions that see the setter is done.
+    is_setting_.store(false);
+  }
+  cv_.notify_all();
 }
 
 }  // namespace fml
@@ -5,12 +5,12 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_SYNC_SWITCH_H_
 #define FLUTTER_FML_SYNCHRONIZATION_SYNC_SWITCH_H_
 
-#include <forward_list>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
-#include <memory>
+#include <mutex>
 
 #include "flutter/fml/macros.h"
-#include "flutter/fml/synchronization/shared_mutex.h"
 
 namespace fml {
 
@@ -18,7 +18,8 @@ namespace fml {
 /// execution paths.
 ///
 /// Execution and setting the switch is exclusive, i.e. only one will happen
-/// at a time.
+/// at a time. Executions only touch a couple of atomics unless the switch is
+/// being set, since they are far more frequent than setting it.
 class SyncSwitch {
  public:
   /// Represents the 2 code paths available when calling |SyncSwitch::Execute|.
@@ -54,8 +55,17 @@ class SyncSwitch {
   void SetSwitch(bool value);
 
  private:
-  mutable std::unique_ptr<fml::SharedMutex> mutex_;
-  bool value_;
+  // The number of calls to |Execute| that passed the check for a setter and
+  // haven't returned yet.
+  mutable std::atomic<size_t> executions_ = 0;
+  // True while |SetSwitch| waits for |executions_| to drop to zero.
+  std::atomic<bool> is_setting_ = false;
+  std::atomic<bool> value_;
+  // Only used by executions and setters that have to block.
+  mutable std::mutex mutex_;
+  mutable std::condition_variable cv_;
+
+  void FinishExecution() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SyncSwitch);
 };
@@ -4,8 +4,10 @@
 
 #include "flutter/fml/synchronization/sync_switch.h"
 
+#include <atomic>
 #include <thread>
 
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "gtest/gtest.h"
 
 using fml::SyncSwitch;
@@ -57,3 +59,29 @@ TEST(SyncSwitchTest, SharedLock) {
   EXPECT_TRUE(switch_value1);
   EXPECT_TRUE(switch_value2);
 }
+
+TEST(SyncSwitchTest, SetSwitchWaitsForExecute) {
+  SyncSwitch sync_switch;
+  fml::AutoResetWaitableEvent executing;
+  fml::AutoResetWaitableEvent finish;
+  std::atomic<bool> finished = false;
+
+  std::thread thread([&] {
+    sync_switch.Execute(SyncSwitch::Handlers().SetIfFalse([&] {
+      executing.Signal();
+      finish.Wait();
+      finished = true;
+    }));
+  });
+  executing.Wait();
+  std::thread setter([&] { sync_switch.SetSwitch(true); });
+  finish.Signal();
+  setter.join();
+  EXPECT_TRUE(finished);
+  thread.join();
+
+  bool switch_value = false;
+  sync_switch.Execute(
+      SyncSwitch::Handlers().SetIfTrue([&] { switch_value = true; }));
+  EXPECT_TRUE(switch_value);
+}
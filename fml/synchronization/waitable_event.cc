@@ -56,6 +56,24 @@ bool WaitWithTimeoutImpl(std::unique_lock<std::mutex>* locker,
   }
 }
 
+// Events are often signaled very soon after they are waited on, for instance
+// when a task is handed to another thread and its result waited for. Checking
+// the event for a little while before blocking on the condition variable saves
+// that thread from being put to sleep and woken up again in that case.
+static constexpr size_t kSpinCount = 1000u;
+
+// Returns true as soon as |condition()| does, or false if it didn't within
+// |kSpinCount| checks. The condition is checked without any lock held.
+template <typename ConditionFn>
+bool SpinUntil(ConditionFn condition) {
+  for (size_t i = 0; i < kSpinCount; i++) {
+    if (condition()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // AutoResetWaitableEvent ------------------------------------------------------
 
 void AutoResetWaitableEvent::Signal() {
@@ -70,18 +88,25 @@ void AutoResetWaitableEvent::Reset() {
 }
 
 void AutoResetWaitableEvent::Wait() {
+  // Only try to consume the signal once it is seen, so that spinning doesn't
+  // keep taking the cache line away from the signaling thread.
+  if (SpinUntil([this] {
+        return signaled_.load(std::memory_order_relaxed) &&
+               signaled_.exchange(false, std::memory_order_acquire);
+      })) {
+    return;
+  }
+
   std::unique_lock<std::mutex> locker(mutex_);
-  while (!signaled_) {
+  while (!signaled_.exchange(false)) {
     cv_.wait(locker);
   }
-  signaled_ = false;
 }
 
 bool AutoResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
   std::unique_lock<std::mutex> locker(mutex_);
 
-  if (signaled_) {
-    signaled_ = false;
+  if (signaled_.exchange(false)) {
     return false;
   }
 
@@ -96,8 +121,8 @@ bool AutoResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
     }
 
     // We may have been awoken.
-    if (signaled_) {
-      break;
+    if (signaled_.exchange(false)) {
+      return false;
     }
 
     // Or the wakeup may have been spurious.
@@ -112,9 +137,6 @@ bool AutoResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
     // Otherwise, recalculate the amount that we have left to wait.
     wait_remaining = timeout - elapsed;
   }
-
-  signaled_ = false;
-  return false;
 }
 
 bool AutoResetWaitableEvent::IsSignaledForTest() {
@@ -137,22 +159,26 @@ void ManualResetWaitableEvent::Reset() {
 }
 
 void ManualResetWaitableEvent::Wait() {
-  std::unique_lock<std::mutex> locker(mutex_);
-
-  if (signaled_) {
+  // A signal that is reset again before this thread sees |signaled_| still
+  // unblocks it, since it changes |signal_id_|.
+  const auto last_signal_id = signal_id_.load();
+  const auto is_signaled = [this, last_signal_id] {
+    return signaled_.load() || signal_id_.load() != last_signal_id;
+  };
+  if (SpinUntil(is_signaled)) {
     return;
   }
 
-  auto last_signal_id = signal_id_;
-  do {
+  std::unique_lock<std::mutex> locker(mutex_);
+  while (!is_signaled()) {
     cv_.wait(locker);
-  } while (signal_id_ == last_signal_id);
+  }
 }
 
 bool ManualResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
   std::unique_lock<std::mutex> locker(mutex_);
 
-  auto last_signal_id = signal_id_;
+  auto last_signal_id = signal_id_.load();
   // Disable thread-safety analysis for the lambda: We could annotate it with
   // |FML_EXCLUSIVE_LOCKS_REQUIRED(mutex_)|, but then the analyzer currently
   // isn't able to figure out that |WaitWithTimeoutImpl()| calls it while
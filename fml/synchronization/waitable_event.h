@@ -10,6 +10,7 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 #define FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 
@@ -65,8 +66,9 @@ class AutoResetWaitableEvent final {
   std::condition_variable cv_;
   std::mutex mutex_;
 
-  // True if this event is in the signaled state.
-  bool signaled_ = false;
+  // True if this event is in the signaled state. Only set with |mutex_| held,
+  // but may be consumed without it by a waiter that hasn't blocked yet.
+  std::atomic<bool> signaled_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AutoResetWaitableEvent);
 };
@@ -107,8 +109,9 @@ class ManualResetWaitableEvent final {
   std::condition_variable cv_;
   std::mutex mutex_;
 
-  // True if this event is in the signaled state.
-  bool signaled_ = false;
+  // True if this event is in the signaled state. Only written with |mutex_|
+  // held, but may be read without it by a waiter that hasn't blocked yet.
+  std::atomic<bool> signaled_ = false;
 
   // While |std::condition_variable::notify_all()| (|pthread_cond_broadcast()|)
   // will wake all waiting threads, one has to deal with spurious wake-ups.
@@ -117,7 +120,7 @@ class ManualResetWaitableEvent final {
   // incremented in |Signal()| before calling
   // |std::condition_variable::notify_all()|. A waiting thread knows it was
   // awoken if |signal_id_| is different from when it started waiting.
-  unsigned signal_id_ = 0u;
+  std::atomic<unsigned> signal_id_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ManualResetWaitableEvent);
 };
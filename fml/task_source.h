@@ -49,10 +49,11 @@ class TaskSource {
 
   /// Adds a task to the corresponding task heap as dictated by the
   /// `TaskSourceGrade` of the `DelayedTask`.
-  void RegisterTask(const DelayedTask& task);
+  void RegisterTask(DelayedTask task);
 
-  /// Pops the task heap corresponding to the `TaskSourceGrade`.
-  void PopTask(TaskSourceGrade grade);
+  /// Pops the task heap corresponding to the `TaskSourceGrade` and returns the
+  /// closure of the popped task.
+  fml::closure PopTask(TaskSourceGrade grade);
 
   /// Returns the number of pending tasks. Excludes the tasks from the secondary
   /// heap if it's paused.
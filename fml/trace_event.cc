@@ -8,25 +8,32 @@
 #include <atomic>
 #include <utility>
 
+#include "flutter/fml/allocation_profiler.h"
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_flight_recorder.h"
 
 namespace fml {
 namespace tracing {
 
-#if FLUTTER_TIMELINE_ENABLED
-
 namespace {
 
 int64_t DefaultMicrosSource() {
   return -1;
 }
 
+#if FLUTTER_TIMELINE_ENABLED
 AsciiTrie gAllowlist;
 std::atomic<TimelineEventHandler> gTimelineEventHandler;
+#endif  // FLUTTER_TIMELINE_ENABLED
+
+// Only set when the timeline is enabled. The flight recorder uses its own
+// clock otherwise.
 std::atomic<TimelineMicrosSource> gTimelineMicrosSource = DefaultMicrosSource;
 
+// The events are always recorded by the flight recorder, if it is enabled,
+// and sent to the Dart timeline if it is enabled in this build.
 inline void FlutterTimelineEvent(const char* label,
                                  int64_t timestamp0,
                                  int64_t timestamp1_or_async_id,
@@ -36,15 +43,31 @@ inline void FlutterTimelineEvent(const char* label,
                                  intptr_t argument_count,
                                  const char** argument_names,
                                  const char** argument_values) {
+#if FLUTTER_ALLOCATION_PROFILER
+  if (type == Dart_Timeline_Event_Begin) {
+    AllocationProfiler::PushScope(label);
+  } else if (type == Dart_Timeline_Event_End) {
+    AllocationProfiler::PopScope();
+  }
+#endif  // FLUTTER_ALLOCATION_PROFILER
+  if (TraceFlightRecorder* recorder = TraceGetFlightRecorder()) {
+    recorder->Record(label, timestamp0, timestamp1_or_async_id, flow_id_count,
+                     flow_ids, type, argument_count, argument_names,
+                     argument_values);
+  }
+#if FLUTTER_TIMELINE_ENABLED
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
   if (handler && gAllowlist.Query(label)) {
     handler(label, timestamp0, timestamp1_or_async_id, flow_id_count, flow_ids,
             type, argument_count, argument_names, argument_values);
   }
+#endif  // FLUTTER_TIMELINE_ENABLED
 }
 }  // namespace
 
+#if FLUTTER_TIMELINE_ENABLED
+
 void TraceSetAllowlist(const std::vector<std::string>& allowlist) {
   gAllowlist.Fill(allowlist);
 }
@@ -71,6 +94,33 @@ size_t TraceNonce() {
   return ++last_item;
 }
 
+#else  // FLUTTER_TIMELINE_ENABLED
+
+void TraceSetAllowlist(const std::vector<std::string>& allowlist) {}
+
+void TraceSetTimelineEventHandler(TimelineEventHandler handler) {}
+
+bool TraceHasTimelineEventHandler() {
+  return false;
+}
+
+int64_t TraceGetTimelineMicros() {
+  return -1;
+}
+
+void TraceSetTimelineMicrosSource(TimelineMicrosSource source) {}
+
+size_t TraceNonce() {
+  return 0;
+}
+
+void TraceEventAsyncComplete(TraceArg category_group,
+                             TraceArg name,
+                             TimePoint begin,
+                             TimePoint end) {}
+
+#endif  // FLUTTER_TIMELINE_ENABLED
+
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         int64_t timestamp_micros,
@@ -366,130 +416,5 @@ void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
   );
 }
 
-#else  // FLUTTER_TIMELINE_ENABLED
-
-void TraceSetAllowlist(const std::vector<std::string>& allowlist) {}
-
-void TraceSetTimelineEventHandler(TimelineEventHandler handler) {}
-
-bool TraceHasTimelineEventHandler() {
-  return false;
-}
-
-int64_t TraceGetTimelineMicros() {
-  return -1;
-}
-
-void TraceSetTimelineMicrosSource(TimelineMicrosSource source) {}
-
-size_t TraceNonce() {
-  return 0;
-}
-
-void TraceTimelineEvent(TraceArg category_group,
-                        TraceArg name,
-                        int64_t timestamp_micros,
-                        TraceIDArg identifier,
-                        size_t flow_id_count,
-                        const uint64_t* flow_ids,
-                        Dart_Timeline_Event_Type type,
-                        const std::vector<const char*>& c_names,
-                        const std::vector<std::string>& values) {}
-
-void TraceTimelineEvent(TraceArg category_group,
-                        TraceArg name,
-                        TraceIDArg identifier,
-                        size_t flow_id_count,
-                        const uint64_t* flow_ids,
-                        Dart_Timeline_Event_Type type,
-                        const std::vector<const char*>& c_names,
-                        const std::vector<std::string>& values) {}
-
-void TraceEvent0(TraceArg category_group,
-                 TraceArg name,
-                 size_t flow_id_count,
-                 const uint64_t* flow_ids) {}
-
-void TraceEvent1(TraceArg category_group,
-                 TraceArg name,
-                 size_t flow_id_count,
-                 const uint64_t* flow_ids,
-                 TraceArg arg1_name,
-                 TraceArg arg1_val) {}
-
-void TraceEvent2(TraceArg category_group,
-                 TraceArg name,
-                 size_t flow_id_count,
-                 const uint64_t* flow_ids,
-                 TraceArg arg1_name,
-                 TraceArg arg1_val,
-                 TraceArg arg2_name,
-                 TraceArg arg2_val) {}
-
-void TraceEventEnd(TraceArg name) {}
-
-void TraceEventAsyncComplete(TraceArg category_group,
-                             TraceArg name,
-                             TimePoint begin,
-                             TimePoint end) {}
-
-void TraceEventAsyncBegin0(TraceArg category_group,
-                           TraceArg name,
-                           TraceIDArg id,
-                           size_t flow_id_count,
-                           const uint64_t* flow_ids) {}
-
-void TraceEventAsyncEnd0(TraceArg category_group,
-                         TraceArg name,
-                         TraceIDArg id) {}
-
-void TraceEventAsyncBegin1(TraceArg category_group,
-                           TraceArg name,
-                           TraceIDArg id,
-                           size_t flow_id_count,
-                           const uint64_t* flow_ids,
-                           TraceArg arg1_name,
-                           TraceArg arg1_val) {}
-
-void TraceEventAsyncEnd1(TraceArg category_group,
-                         TraceArg name,
-                         TraceIDArg id,
-                         TraceArg arg1_name,
-                         TraceArg arg1_val) {}
-
-void TraceEventInstant0(TraceArg category_group,
-                        TraceArg name,
-                        size_t flow_id_count,
-                        const uint64_t* flow_ids) {}
-
-void TraceEventInstant1(TraceArg category_group,
-                        TraceArg name,
-                        size_t flow_id_count,
-                        const uint64_t* flow_ids,
-                        TraceArg arg1_name,
-                        TraceArg arg1_val) {}
-
-void TraceEventInstant2(TraceArg category_group,
-                        TraceArg name,
-                        size_t flow_id_count,
-                        const uint64_t* flow_ids,
-                        TraceArg arg1_name,
-                        TraceArg arg1_val,
-                        TraceArg arg2_name,
-                        TraceArg arg2_val) {}
-
-void TraceEventFlowBegin0(TraceArg category_group,
-                          TraceArg name,
-                          TraceIDArg id) {}
-
-void TraceEventFlowStep0(TraceArg category_group,
-                         TraceArg name,
-                         TraceIDArg id) {}
-
-void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
-}
-
-#endif  // FLUTTER_TIMELINE_ENABLED
-
 }  // namespace tracing
 }  // namespace fml
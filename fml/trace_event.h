@@ -321,6 +321,11 @@ void TraceCounterNopHACK(TraceArg category,
                          TraceIDArg identifier,
                          Args... args) {}
 
+void TraceEvent0(TraceArg category_group,
+                 TraceArg name,
+                 size_t flow_id_count,
+                 const uint64_t* flow_ids);
+
 template <typename... Args>
 void TraceEvent(TraceArg category,
                 TraceArg name,
@@ -331,14 +336,13 @@ void TraceEvent(TraceArg category,
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, 0, flow_id_count, flow_ids,
                      Dart_Timeline_Event_Begin, split.first, split.second);
+#else   // FLUTTER_TIMELINE_ENABLED
+  // Skip formatting the arguments, but still begin the event for the flight
+  // recorder since it is ended by |ScopedInstantEnd|.
+  TraceEvent0(category, name, flow_id_count, flow_ids);
 #endif  // FLUTTER_TIMELINE_ENABLED
 }
 
-void TraceEvent0(TraceArg category_group,
-                 TraceArg name,
-                 size_t flow_id_count,
-                 const uint64_t* flow_ids);
-
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
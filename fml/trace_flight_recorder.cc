@@ -0,0 +1,550 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_flight_recorder.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string_view>
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/time/time_point.h"
+
+#if defined(FML_OS_WIN)
+#include <windows.h>
+#elif defined(FML_OS_POSIX)
+#include <pthread.h>
+#include <unistd.h>
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+std::atomic<TraceFlightRecorder*> gFlightRecorder;
+
+int64_t GetCurrentProcessID() {
+#if defined(FML_OS_WIN)
+  return ::GetCurrentProcessId();
+#elif defined(FML_OS_POSIX)
+  return ::getpid();
+#else
+  return 0;
+#endif
+}
+
+int64_t GetCurrentThreadID() {
+#if defined(FML_OS_WIN)
+  return ::GetCurrentThreadId();
+#elif defined(FML_OS_MACOSX)
+  uint64_t thread_id = 0;
+  ::pthread_threadid_np(nullptr, &thread_id);
+  return static_cast<int64_t>(thread_id);
+#elif defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  return ::syscall(SYS_gettid);
+#else
+  return 0;
+#endif
+}
+
+std::string GetCurrentThreadName() {
+  char name[64] = {};
+#if defined(FML_OS_MACOSX)
+  ::pthread_getname_np(::pthread_self(), name, sizeof(name));
+#elif defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  // PR_GET_NAME writes at most 16 bytes.
+  ::prctl(PR_GET_NAME, name);
+#endif
+  return name;
+}
+
+// The ID of the recorder whose buffer the calling thread caches. IDs are not
+// reused so that a recorder never finds the buffer of a destroyed one.
+std::atomic<uint64_t> gNextRecorderID = 1;
+
+// The field numbers and enum values come from the protos in
+// https://github.com/google/perfetto/tree/master/protos/perfetto/trace.
+constexpr uint32_t kTracePacketField = 1;
+
+constexpr uint32_t kPacketTimestampField = 8;
+constexpr uint32_t kPacketSequenceIDField = 10;
+constexpr uint32_t kPacketTrackEventField = 11;
+constexpr uint32_t kPacketSequenceFlagsField = 13;
+constexpr uint32_t kPacketTimestampClockIDField = 58;
+constexpr uint32_t kPacketTrackDescriptorField = 60;
+
+constexpr uint32_t kTrackUUIDField = 1;
+constexpr uint32_t kTrackNameField = 2;
+constexpr uint32_t kTrackProcessField = 3;
+constexpr uint32_t kTrackThreadField = 4;
+constexpr uint32_t kTrackParentUUIDField = 5;
+constexpr uint32_t kTrackCounterField = 8;
+
+constexpr uint32_t kProcessPIDField = 1;
+constexpr uint32_t kThreadPIDField = 1;
+constexpr uint32_t kThreadTIDField = 2;
+constexpr uint32_t kThreadNameField = 5;
+
+constexpr uint32_t kEventDebugAnnotationsField = 4;
+constexpr uint32_t kEventTypeField = 9;
+constexpr uint32_t kEventTrackUUIDField = 11;
+constexpr uint32_t kEventNameField = 23;
+constexpr uint32_t kEventDoubleCounterValueField = 44;
+constexpr uint32_t kEventFlowIDsField = 47;
+constexpr uint32_t kEventTerminatingFlowIDsField = 48;
+
+constexpr uint32_t kAnnotationStringValueField = 6;
+constexpr uint32_t kAnnotationNameField = 10;
+
+constexpr uint64_t kEventTypeSliceBegin = 1;
+constexpr uint64_t kEventTypeSliceEnd = 2;
+constexpr uint64_t kEventTypeInstant = 3;
+constexpr uint64_t kEventTypeCounter = 4;
+
+constexpr uint64_t kSequenceIncrementalStateCleared = 1;
+constexpr uint64_t kBuiltinClockMonotonic = 3;
+constexpr uint64_t kSequenceID = 1;
+
+// Track UUIDs. Thread tracks are numbered after the process track, async
+// tracks are keyed by the async ID and counter tracks by their index.
+constexpr uint64_t kProcessTrackUUID = 1;
+constexpr uint64_t kCounterTrackUUIDBit = uint64_t{1} << 62;
+constexpr uint64_t kAsyncTrackUUIDBit = uint64_t{1} << 63;
+
+// A minimal encoder of the protobuf wire format.
+class ProtoWriter {
+ public:
+  void AppendVarInt(uint32_t field, uint64_t value) {
+    AppendRawVarInt((static_cast<uint64_t>(field) << 3) | kWireTypeVarInt);
+    AppendRawVarInt(value);
+  }
+
+  void AppendFixed64(uint32_t field, uint64_t value) {
+    AppendRawVarInt((static_cast<uint64_t>(field) << 3) | kWireTypeFixed64);
+    for (size_t i = 0; i < sizeof(value); i++) {
+      data_.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+  }
+
+  void AppendDouble(uint32_t field, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    AppendFixed64(field, bits);
+  }
+
+  void AppendString(uint32_t field, std::string_view value) {
+    AppendRawVarInt((static_cast<uint64_t>(field) << 3) |
+                    kWireTypeLengthDelimited);
+    AppendRawVarInt(value.size());
+    data_.insert(data_.end(), value.begin(), value.end());
+  }
+
+  void AppendMessage(uint32_t field, const ProtoWriter& message) {
+    AppendRawVarInt((static_cast<uint64_t>(field) << 3) |
+                    kWireTypeLengthDelimited);
+    AppendRawVarInt(message.data_.size());
+    data_.insert(data_.end(), message.data_.begin(), message.data_.end());
+  }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+ private:
+  static constexpr uint64_t kWireTypeVarInt = 0;
+  static constexpr uint64_t kWireTypeFixed64 = 1;
+  static constexpr uint64_t kWireTypeLengthDelimited = 2;
+
+  std::vector<uint8_t> data_;
+
+  void AppendRawVarInt(uint64_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<uint8_t>(value));
+  }
+};
+
+}  // namespace
+
+class TraceFlightRecorder::ThreadBuffer {
+ public:
+  struct Event {
+    static constexpr uint8_t kHasFlowID = 1 << 0;
+
+    int64_t timestamp_micros = 0;
+    const char* name = nullptr;
+    const char* argument_name = nullptr;
+    // The async ID, the counter ID or the flow ID, depending on the type.
+    int64_t id = 0;
+    uint8_t type = 0;
+    uint8_t flags = 0;
+    char argument_value[22] = {};
+  };
+
+  ThreadBuffer(size_t capacity, int64_t thread_id, std::string thread_name)
+      : capacity_(capacity),
+        thread_id_(thread_id),
+        thread_name_(std::move(thread_name)),
+        slots_(new Slot[capacity]) {}
+
+  int64_t GetThreadID() const { return thread_id_; }
+
+  const std::string& GetThreadName() const { return thread_name_; }
+
+  // May only be called on the thread of the buffer.
+  void Write(const Event& event) {
+    const uint64_t index = write_index_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[index % capacity_];
+    // Readers skip the slot while its sequence is 0.
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.event = event;
+    slot.sequence.store(index + 1, std::memory_order_release);
+    write_index_.store(index + 1, std::memory_order_release);
+  }
+
+  // May be called on any thread. The events are in the order they were
+  // written in.
+  std::vector<Event> Read() const {
+    const uint64_t end = write_index_.load(std::memory_order_acquire);
+    const uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+    std::vector<Event> events;
+    events.reserve(end - begin);
+    for (uint64_t index = begin; index < end; index++) {
+      const Slot& slot = slots_[index % capacity_];
+      if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+        continue;
+      }
+      Event event = slot.event;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != index + 1) {
+        // Overwritten while it was being copied.
+        continue;
+      }
+      events.push_back(event);
+    }
+    return events;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence = 0;
+    Event event;
+  };
+
+  const size_t capacity_;
+  const int64_t thread_id_;
+  const std::string thread_name_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> write_index_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+TraceFlightRecorder::TraceFlightRecorder(size_t records_per_thread)
+    : id_(gNextRecorderID++),
+      records_per_thread_(std::max<size_t>(records_per_thread, 1)) {}
+
+TraceFlightRecorder::~TraceFlightRecorder() = default;
+
+TraceFlightRecorder::ThreadBuffer* TraceFlightRecorder::GetThreadBuffer() {
+  struct CachedBuffer {
+    uint64_t recorder_id = 0;
+    ThreadBuffer* buffer = nullptr;
+  };
+  thread_local CachedBuffer tCachedBuffer;
+  if (tCachedBuffer.recorder_id == id_) {
+    return tCachedBuffer.buffer;
+  }
+
+  ThreadBuffer* buffer = nullptr;
+  const int64_t thread_id = GetCurrentThreadID();
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    for (const auto& existing : buffers_) {
+      if (existing->GetThreadID() == thread_id) {
+        buffer = existing.get();
+        break;
+      }
+    }
+    if (!buffer && buffers_.size() < kMaxThreadCount) {
+      buffers_.push_back(std::make_unique<ThreadBuffer>(
+          records_per_thread_, thread_id, GetCurrentThreadName()));
+      buffer = buffers_.back().get();
+    }
+  }
+  tCachedBuffer = {.recorder_id = id_, .buffer = buffer};
+  return buffer;
+}
+
+void TraceFlightRecorder::Record(const char* name,
+                                 int64_t timestamp_micros,
+                                 int64_t timestamp1_or_async_id,
+                                 intptr_t flow_id_count,
+                                 const int64_t* flow_ids,
+                                 Dart_Timeline_Event_Type type,
+                                 intptr_t argument_count,
+                                 const char** argument_names,
+                                 const char** argument_values) {
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (!buffer) {
+    return;
+  }
+
+  ThreadBuffer::Event event;
+  // The timeline has no clock when the Dart VM isn't running.
+  event.timestamp_micros =
+      timestamp_micros >= 0
+          ? timestamp_micros
+          : TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  event.name = name;
+  event.type = static_cast<uint8_t>(type);
+  event.id = timestamp1_or_async_id;
+  if (type == Dart_Timeline_Event_Begin && flow_id_count > 0 && flow_ids) {
+    event.id = flow_ids[0];
+    event.flags |= ThreadBuffer::Event::kHasFlowID;
+  }
+  if (argument_count > 0 && argument_names && argument_values &&
+      argument_values[0]) {
+    event.argument_name = argument_names[0];
+    std::strncpy(event.argument_value, argument_values[0],
+                 sizeof(event.argument_value) - 1);
+  }
+  buffer->Write(event);
+}
+
+std::vector<uint8_t> TraceFlightRecorder::Dump() const {
+  using Event = ThreadBuffer::Event;
+
+  struct ThreadEvents {
+    uint64_t track_uuid;
+    int64_t thread_id;
+    std::string thread_name;
+    std::vector<Event> events;
+  };
+  std::vector<ThreadEvents> threads;
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    threads.reserve(buffers_.size());
+    for (const auto& buffer : buffers_) {
+      threads.push_back({
+          .track_uuid = kProcessTrackUUID + 1 + threads.size(),
+          .thread_id = buffer->GetThreadID(),
+          .thread_name = buffer->GetThreadName(),
+          .events = buffer->Read(),
+      });
+    }
+  }
+
+  // Async events and counters get tracks of their own.
+  std::map<int64_t, const char*> async_tracks;
+  std::map<std::pair<const char*, const char*>, uint64_t> counter_tracks;
+  for (const auto& thread : threads) {
+    for (const auto& event : thread.events) {
+      switch (event.type) {
+        case Dart_Timeline_Event_Async_Begin:
+        case Dart_Timeline_Event_Async_Instant:
+          async_tracks.emplace(event.id, event.name);
+          break;
+        case Dart_Timeline_Event_Counter:
+          if (event.argument_name) {
+            counter_tracks.emplace(
+                std::make_pair(event.name, event.argument_name),
+                kCounterTrackUUIDBit | counter_tracks.size());
+          }
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  ProtoWriter trace;
+  auto append_track = [&trace](const ProtoWriter& track, bool first) {
+    ProtoWriter packet;
+    packet.AppendVarInt(kPacketSequenceIDField, kSequenceID);
+    if (first) {
+      packet.AppendVarInt(kPacketSequenceFlagsField,
+                          kSequenceIncrementalStateCleared);
+    }
+    packet.AppendMessage(kPacketTrackDescriptorField, track);
+    trace.AppendMessage(kTracePacketField, packet);
+  };
+
+  const int64_t pid = GetCurrentProcessID();
+  {
+    ProtoWriter process;
+    process.AppendVarInt(kProcessPIDField, pid);
+    ProtoWriter track;
+    track.AppendVarInt(kTrackUUIDField, kProcessTrackUUID);
+    track.AppendMessage(kTrackProcessField, process);
+    append_track(track, true);
+  }
+  for (const auto& thread : threads) {
+    ProtoWriter descriptor;
+    descriptor.AppendVarInt(kThreadPIDField, pid);
+    descriptor.AppendVarInt(kThreadTIDField, thread.thread_id);
+    if (!thread.thread_name.empty()) {
+      descriptor.AppendString(kThreadNameField, thread.thread_name);
+    }
+    ProtoWriter track;
+    track.AppendVarInt(kTrackUUIDField, thread.track_uuid);
+    track.AppendVarInt(kTrackParentUUIDField, kProcessTrackUUID);
+    track.AppendMessage(kTrackThreadField, descriptor);
+    append_track(track, false);
+  }
+  for (const auto& [id, name] : async_tracks) {
+    ProtoWriter track;
+    track.AppendVarInt(kTrackUUIDField,
+                       kAsyncTrackUUIDBit | static_cast<uint64_t>(id));
+    track.AppendVarInt(kTrackParentUUIDField, kProcessTrackUUID);
+    track.AppendString(kTrackNameField, name);
+    append_track(track, false);
+  }
+  for (const auto& [names, uuid] : counter_tracks) {
+    ProtoWriter track;
+    track.AppendVarInt(kTrackUUIDField, uuid);
+    track.AppendVarInt(kTrackParentUUIDField, kProcessTrackUUID);
+    track.AppendString(kTrackNameField,
+                       std::string{names.first} + " " + names.second);
+    track.AppendMessage(kTrackCounterField, ProtoWriter{});
+    append_track(track, false);
+  }
+
+  auto append_event = [&trace](const Event& event, uint64_t track_uuid,
+                               uint64_t type, ProtoWriter& track_event) {
+    track_event.AppendVarInt(kEventTypeField, type);
+    track_event.AppendVarInt(kEventTrackUUIDField, track_uuid);
+    ProtoWriter packet;
+    packet.AppendVarInt(kPacketTimestampField,
+                        static_cast<uint64_t>(event.timestamp_micros) * 1000u);
+    packet.AppendVarInt(kPacketTimestampClockIDField, kBuiltinClockMonotonic);
+    packet.AppendVarInt(kPacketSequenceIDField, kSequenceID);
+    packet.AppendMessage(kPacketTrackEventField, track_event);
+    trace.AppendMessage(kTracePacketField, packet);
+  };
+  auto append_named_event = [&append_event](const Event& event,
+                                            uint64_t track_uuid,
+                                            uint64_t type) {
+    ProtoWriter track_event;
+    track_event.AppendString(kEventNameField, event.name);
+    if (event.argument_name) {
+      ProtoWriter annotation;
+      annotation.AppendString(kAnnotationNameField, event.argument_name);
+      annotation.AppendString(kAnnotationStringValueField,
+                              event.argument_value);
+      track_event.AppendMessage(kEventDebugAnnotationsField, annotation);
+    }
+    if (event.flags & Event::kHasFlowID) {
+      track_event.AppendFixed64(kEventFlowIDsField, event.id);
+    }
+    append_event(event, track_uuid, type, track_event);
+  };
+
+  // The oldest records may have been overwritten, so slices whose beginning
+  // is no longer recorded are left out.
+  std::map<int64_t, size_t> async_depths;
+  for (const auto& thread : threads) {
+    size_t depth = 0;
+    for (const auto& event : thread.events) {
+      const uint64_t async_uuid =
+          kAsyncTrackUUIDBit | static_cast<uint64_t>(event.id);
+      switch (event.type) {
+        case Dart_Timeline_Event_Begin:
+          depth++;
+          append_named_event(event, thread.track_uuid, kEventTypeSliceBegin);
+          break;
+        case Dart_Timeline_Event_End:
+          if (depth > 0) {
+            depth--;
+            ProtoWriter track_event;
+            append_event(event, thread.track_uuid, kEventTypeSliceEnd,
+                         track_event);
+          }
+          break;
+        case Dart_Timeline_Event_Instant:
+          append_named_event(event, thread.track_uuid, kEventTypeInstant);
+          break;
+        case Dart_Timeline_Event_Async_Begin:
+          async_depths[event.id]++;
+          append_named_event(event, async_uuid, kEventTypeSliceBegin);
+          break;
+        case Dart_Timeline_Event_Async_End: {
+          auto found = async_depths.find(event.id);
+          if (found != async_depths.end() && found->second > 0) {
+            found->second--;
+            ProtoWriter track_event;
+            append_event(event, async_uuid, kEventTypeSliceEnd, track_event);
+          }
+          break;
+        }
+        case Dart_Timeline_Event_Async_Instant:
+          append_named_event(event, async_uuid, kEventTypeInstant);
+          break;
+        case Dart_Timeline_Event_Counter: {
+          if (!event.argument_name) {
+            break;
+          }
+          char* end = nullptr;
+          const double value = std::strtod(event.argument_value, &end);
+          if (end == event.argument_value) {
+            break;
+          }
+          ProtoWriter track_event;
+          track_event.AppendDouble(kEventDoubleCounterValueField, value);
+          append_event(
+              event,
+              counter_tracks[std::make_pair(event.name, event.argument_name)],
+              kEventTypeCounter, track_event);
+          break;
+        }
+        case Dart_Timeline_Event_Flow_Begin:
+        case Dart_Timeline_Event_Flow_Step:
+        case Dart_Timeline_Event_Flow_End: {
+          ProtoWriter track_event;
+          track_event.AppendString(kEventNameField, event.name);
+          track_event.AppendFixed64(event.type == Dart_Timeline_Event_Flow_End
+                                        ? kEventTerminatingFlowIDsField
+                                        : kEventFlowIDsField,
+                                    event.id);
+          append_event(event, thread.track_uuid, kEventTypeInstant,
+                       track_event);
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+
+  return trace.TakeData();
+}
+
+void TraceEnableFlightRecorder(size_t records_per_thread) {
+  if (gFlightRecorder.load()) {
+    return;
+  }
+  // The recorder lives as long as the process since events may be recorded
+  // on any thread at any time.
+  auto recorder = new TraceFlightRecorder(records_per_thread);
+  TraceFlightRecorder* expected = nullptr;
+  if (!gFlightRecorder.compare_exchange_strong(expected, recorder)) {
+    delete recorder;
+  }
+}
+
+TraceFlightRecorder* TraceGetFlightRecorder() {
+  return gFlightRecorder.load(std::memory_order_acquire);
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
+#define FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      An always-on recorder of the most recent trace events of every
+///             thread, that can be dumped as a Perfetto trace when something
+///             went wrong in the field, for example when a frame was janky.
+///
+///             Every thread records into a ring buffer of fixed-size records
+///             that only it writes to, so recording neither locks nor
+///             allocates once the buffer of the thread has been created. The
+///             names of the events and of their arguments are recorded as
+///             pointers and must be string literals, like for the rest of the
+///             trace macros. The value of the first argument of an event is
+///             copied and may be truncated.
+///
+///             Dumping may happen on any thread while the other threads keep
+///             recording. Records that are overwritten while they are being
+///             read are left out of the dump.
+///
+class TraceFlightRecorder {
+ public:
+  static constexpr size_t kDefaultRecordsPerThread = 2048;
+
+  /// The number of threads that get a buffer. The events of the threads
+  /// created after that are not recorded.
+  static constexpr size_t kMaxThreadCount = 256;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Constructs a recorder that keeps the last
+  ///             `records_per_thread` events of every thread.
+  ///
+  explicit TraceFlightRecorder(
+      size_t records_per_thread = kDefaultRecordsPerThread);
+
+  ~TraceFlightRecorder();
+
+  size_t GetRecordsPerThread() const { return records_per_thread_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records an event on the buffer of the calling thread. The
+  ///             arguments are those of the Dart timeline. Only the first
+  ///             argument and the first flow ID are recorded.
+  ///
+  void Record(const char* name,
+              int64_t timestamp_micros,
+              int64_t timestamp1_or_async_id,
+              intptr_t flow_id_count,
+              const int64_t* flow_ids,
+              Dart_Timeline_Event_Type type,
+              intptr_t argument_count,
+              const char** argument_names,
+              const char** argument_values);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes the events that are currently recorded as a trace in
+  ///             the protobuf format of Perfetto, with a track per thread.
+  ///             Timestamps are on the monotonic clock.
+  ///
+  std::vector<uint8_t> Dump() const;
+
+ private:
+  class ThreadBuffer;
+
+  const uint64_t id_;
+  const size_t records_per_thread_;
+  mutable std::mutex buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+  ThreadBuffer* GetThreadBuffer();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceFlightRecorder);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Starts recording the trace events of the process in a flight
+///             recorder, whether the Dart timeline is enabled or not. Only the
+///             first call creates the recorder, the later ones are ignored.
+///
+void TraceEnableFlightRecorder(
+    size_t records_per_thread = TraceFlightRecorder::kDefaultRecordsPerThread);
+
+/// The flight recorder of the process, or nullptr if it is not enabled.
+TraceFlightRecorder* TraceGetFlightRecorder();
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
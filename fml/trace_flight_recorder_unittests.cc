@@ -0,0 +1,196 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_flight_recorder.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+// A minimal decoder of the protobuf wire format.
+class ProtoReader {
+ public:
+  ProtoReader(const uint8_t* data, size_t size)
+      : data_(data), end_(data + size) {}
+
+  bool Next(uint32_t* field, uint64_t* value, ProtoReader* message) {
+    if (data_ >= end_) {
+      return false;
+    }
+    const uint64_t tag = ReadVarInt();
+    *field = static_cast<uint32_t>(tag >> 3);
+    switch (tag & 7) {
+      case 0:
+        *value = ReadVarInt();
+        break;
+      case 1:
+        *value = 0;
+        for (size_t i = 0; i < 8; i++) {
+          *value |= static_cast<uint64_t>(data_[i]) << (i * 8);
+        }
+        data_ += 8;
+        break;
+      case 2: {
+        const uint64_t size = ReadVarInt();
+        *message = ProtoReader(data_, size);
+        data_ += size;
+        break;
+      }
+      default:
+        ADD_FAILURE() << "Unexpected wire type " << (tag & 7);
+        return false;
+    }
+    return true;
+  }
+
+  std::string ToString() const {
+    return std::string{reinterpret_cast<const char*>(data_),
+                       static_cast<size_t>(end_ - data_)};
+  }
+
+ private:
+  const uint8_t* data_;
+  const uint8_t* end_;
+
+  uint64_t ReadVarInt() {
+    uint64_t value = 0;
+    for (size_t shift = 0; data_ < end_; shift += 7) {
+      const uint8_t byte = *data_++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        break;
+      }
+    }
+    return value;
+  }
+};
+
+struct TrackEvent {
+  uint64_t type = 0;
+  uint64_t track_uuid = 0;
+  std::string name;
+};
+
+// Decodes the track events of a trace dumped by the recorder.
+std::vector<TrackEvent> ParseTrackEvents(const std::vector<uint8_t>& data) {
+  std::vector<TrackEvent> events;
+  ProtoReader reader(data.data(), data.size());
+  uint32_t field;
+  uint64_t value;
+  ProtoReader packet(nullptr, 0);
+  while (reader.Next(&field, &value, &packet)) {
+    EXPECT_EQ(field, 1u);
+    ProtoReader message(nullptr, 0);
+    while (packet.Next(&field, &value, &message)) {
+      if (field == 11) {
+        TrackEvent event;
+        ProtoReader name(nullptr, 0);
+        while (message.Next(&field, &value, &name)) {
+          if (field == 9) {
+            event.type = value;
+          } else if (field == 11) {
+            event.track_uuid = value;
+          } else if (field == 23) {
+            event.name = name.ToString();
+          }
+        }
+        events.push_back(event);
+      }
+    }
+  }
+  return events;
+}
+
+constexpr uint64_t kSliceBegin = 1;
+constexpr uint64_t kSliceEnd = 2;
+constexpr uint64_t kInstant = 3;
+constexpr uint64_t kCounter = 4;
+
+void RecordEvent(TraceFlightRecorder& recorder,
+                 const char* name,
+                 Dart_Timeline_Event_Type type,
+                 int64_t id = 0) {
+  recorder.Record(name, -1, id, 0, nullptr, type, 0, nullptr, nullptr);
+}
+
+}  // namespace
+
+TEST(TraceFlightRecorderTest, RecordsTheEventsOfEveryThread) {
+  TraceFlightRecorder recorder;
+  RecordEvent(recorder, "Main", Dart_Timeline_Event_Begin);
+  std::thread thread([&recorder]() {
+    RecordEvent(recorder, "Other", Dart_Timeline_Event_Instant);
+  });
+  thread.join();
+  RecordEvent(recorder, "Main", Dart_Timeline_Event_End);
+
+  const auto events = ParseTrackEvents(recorder.Dump());
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].type, kSliceBegin);
+  EXPECT_EQ(events[0].name, "Main");
+  EXPECT_EQ(events[1].type, kSliceEnd);
+  EXPECT_EQ(events[1].track_uuid, events[0].track_uuid);
+  EXPECT_EQ(events[2].type, kInstant);
+  EXPECT_EQ(events[2].name, "Other");
+  EXPECT_NE(events[2].track_uuid, events[0].track_uuid);
+}
+
+TEST(TraceFlightRecorderTest, KeepsTheLatestRecords) {
+  TraceFlightRecorder recorder(3);
+  const char* names[] = {"A", "B", "C", "D", "E"};
+  for (const char* name : names) {
+    RecordEvent(recorder, name, Dart_Timeline_Event_Instant);
+  }
+
+  const auto events = ParseTrackEvents(recorder.Dump());
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].name, "C");
+  EXPECT_EQ(events[1].name, "D");
+  EXPECT_EQ(events[2].name, "E");
+}
+
+TEST(TraceFlightRecorderTest, SkipsSlicesThatBeganBeforeTheRecords) {
+  TraceFlightRecorder recorder(4);
+  RecordEvent(recorder, "Outer", Dart_Timeline_Event_Begin);
+  RecordEvent(recorder, "Inner", Dart_Timeline_Event_Begin);
+  RecordEvent(recorder, "Inner", Dart_Timeline_Event_End);
+  RecordEvent(recorder, "Outer", Dart_Timeline_Event_End);
+  RecordEvent(recorder, "Async", Dart_Timeline_Event_Async_End, 1);
+
+  const auto events = ParseTrackEvents(recorder.Dump());
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, kSliceBegin);
+  EXPECT_EQ(events[0].name, "Inner");
+  EXPECT_EQ(events[1].type, kSliceEnd);
+}
+
+TEST(TraceFlightRecorderTest, RecordsAsyncEventsAndCounters) {
+  TraceFlightRecorder recorder;
+  const char* names[] = {"count"};
+  const char* values[] = {"42"};
+  RecordEvent(recorder, "Frame", Dart_Timeline_Event_Async_Begin, 7);
+  recorder.Record("Layers", -1, 0, 0, nullptr, Dart_Timeline_Event_Counter, 1,
+                  names, values);
+  RecordEvent(recorder, "Frame", Dart_Timeline_Event_Async_End, 7);
+
+  const auto events = ParseTrackEvents(recorder.Dump());
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].type, kSliceBegin);
+  EXPECT_EQ(events[1].type, kCounter);
+  EXPECT_EQ(events[2].type, kSliceEnd);
+  EXPECT_EQ(events[2].track_uuid, events[0].track_uuid);
+  EXPECT_NE(events[1].track_uuid, events[0].track_uuid);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,178 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_WORK_STEALING_DEQUE_H_
+#define FLUTTER_FML_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A lock-free Chase-Lev work stealing deque.
+///
+///             A single owner thread pushes and pops items at the bottom of
+///             the deque while any number of other threads steal items from
+///             its top. The memory orderings follow "Correct and Efficient
+///             Work-Stealing for Weak Memory Models" (Le et al., 2013).
+///
+///             The deque grows when full. Buffers that have been outgrown are
+///             kept alive until the deque is destroyed since thieves may still
+///             be reading from them.
+///
+/// @tparam     T     The type of the items. It must be trivially copyable,
+///                   usually a pointer.
+///
+template <typename T>
+class WorkStealingDeque {
+ public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "The items of a work stealing deque must be trivially "
+                "copyable.");
+
+  explicit WorkStealingDeque(size_t initial_capacity = 64)
+      : buffer_(new Buffer(RoundUpToPowerOfTwo(initial_capacity))) {
+    buffers_.emplace_back(buffer_.load(std::memory_order_relaxed));
+  }
+
+  ~WorkStealingDeque() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Pushes an item at the bottom of the deque. Must only be called
+  ///             on the owner thread.
+  ///
+  void Push(T item) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(buffer->mask)) {
+      buffer = Grow(buffer, top, bottom);
+    }
+    buffer->Store(bottom, item);
+    // A release store rather than the release fence of the paper, which
+    // sanitizers do not model.
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Pops the item that was pushed last. Must only be called on the
+  ///             owner thread.
+  ///
+  /// @return     If an item was popped into |item|.
+  ///
+  bool Pop(T* item) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      // The deque was empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    *item = buffer->Load(bottom);
+    if (top == bottom) {
+      // This is the last item, race the thieves for it.
+      const bool won = top_.compare_exchange_strong(
+          top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Steals the oldest item of the deque. May be called on any
+  ///             thread.
+  ///
+  /// @return     If an item was stolen into |item|. This may spuriously fail
+  ///             when racing other threads for the same item.
+  ///
+  bool Steal(T* item) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return false;
+    }
+
+    // Consume ordering is promoted to acquire by every compiler anyway.
+    Buffer* buffer = buffer_.load(std::memory_order_acquire);
+    const T stolen = buffer->Load(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    *item = stolen;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      An estimate of the number of items in the deque. It is only
+  ///             exact when called on the owner thread with no thieves.
+  ///
+  size_t GetSizeApprox() const {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0u;
+  }
+
+ private:
+  struct Buffer {
+    const size_t mask;
+    std::unique_ptr<std::atomic<T>[]> items;
+
+    explicit Buffer(size_t capacity)
+        : mask(capacity - 1), items(new std::atomic<T>[capacity]) {}
+
+    T Load(int64_t index) const {
+      return items[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void Store(int64_t index, T item) {
+      items[index & mask].store(item, std::memory_order_relaxed);
+    }
+  };
+
+  std::atomic<int64_t> top_ = 0;
+  std::atomic<int64_t> bottom_ = 0;
+  std::atomic<Buffer*> buffer_;
+  // Every buffer ever used by the deque. Only accessed on the owner thread.
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+
+  static size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t capacity = 1;
+    while (capacity < value) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom) {
+    auto grown = std::make_unique<Buffer>((buffer->mask + 1) * 2);
+    for (int64_t i = top; i < bottom; i++) {
+      grown->Store(i, buffer->Load(i));
+    }
+    Buffer* result = grown.get();
+    buffers_.emplace_back(std::move(grown));
+    buffer_.store(result, std::memory_order_release);
+    return result;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_WORK_STEALING_DEQUE_H_
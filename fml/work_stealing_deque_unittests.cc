@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(WorkStealingDequeTest, OwnerPopsInReverseOrder) {
+  WorkStealingDeque<size_t> deque;
+  deque.Push(1);
+  deque.Push(2);
+  deque.Push(3);
+  ASSERT_EQ(deque.GetSizeApprox(), 3u);
+
+  size_t item = 0;
+  ASSERT_TRUE(deque.Pop(&item));
+  EXPECT_EQ(item, 3u);
+  ASSERT_TRUE(deque.Steal(&item));
+  EXPECT_EQ(item, 1u);
+  ASSERT_TRUE(deque.Pop(&item));
+  EXPECT_EQ(item, 2u);
+  EXPECT_FALSE(deque.Pop(&item));
+  EXPECT_FALSE(deque.Steal(&item));
+  EXPECT_EQ(deque.GetSizeApprox(), 0u);
+}
+
+TEST(WorkStealingDequeTest, GrowsWhenFull) {
+  WorkStealingDeque<size_t> deque(2);
+  for (size_t i = 0; i < 100; i++) {
+    deque.Push(i);
+  }
+  ASSERT_EQ(deque.GetSizeApprox(), 100u);
+  for (size_t i = 0; i < 100; i++) {
+    size_t item = 0;
+    ASSERT_TRUE(deque.Steal(&item));
+    EXPECT_EQ(item, i);
+  }
+}
+
+TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnce) {
+  constexpr size_t kItemCount = 100000;
+  constexpr size_t kThiefCount = 4;
+  WorkStealingDeque<size_t> deque(8);
+  std::vector<std::atomic<int>> taken(kItemCount);
+  std::atomic<bool> done = false;
+
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < kThiefCount; i++) {
+    thieves.emplace_back([&]() {
+      size_t item = 0;
+      while (!done.load()) {
+        if (deque.Steal(&item)) {
+          taken[item]++;
+        }
+      }
+    });
+  }
+
+  size_t item = 0;
+  for (size_t i = 0; i < kItemCount; i++) {
+    deque.Push(i);
+    if (i % 3 == 0 && deque.Pop(&item)) {
+      taken[item]++;
+    }
+  }
+  while (deque.Pop(&item)) {
+    taken[item]++;
+  }
+  done = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  for (size_t i = 0; i < kItemCount; i++) {
+    ASSERT_EQ(taken[i].load(), 1) << "Item " << i;
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -4,11 +4,26 @@
 
 #include "impeller/aiks/aiks_context.h"
 
+#include <map>
+#include <thread>
+
 #include "impeller/aiks/picture.h"
+#include "impeller/base/thread.h"
+#include "impeller/base/validation.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/typographer/typographer_context.h"
 
 namespace impeller {
 
+// The content contexts hold on to their context, so a live entry can't be for
+// a different context that reused the address of a collected one.
+using SharedContentContextKey = std::pair<const Context*, std::thread::id>;
+static Mutex g_shared_content_contexts_mutex;
+static std::map<SharedContentContextKey, std::weak_ptr<ContentContext>>
+    g_shared_content_contexts IPLR_GUARDED_BY(g_shared_content_contexts_mutex);
+
 AiksContext::AiksContext(
     std::shared_ptr<Context> context,
     std::shared_ptr<TypographerContext> typographer_context)
@@ -17,7 +32,7 @@ AiksContext::AiksContext(
     return;
   }
 
-  content_context_ = std::make_unique<ContentContext>(
+  content_context_ = std::make_shared<ContentContext>(
       context_, std::move(typographer_context));
   if (!content_context_->IsValid()) {
     return;
@@ -26,6 +41,39 @@ AiksContext::AiksContext(
   is_valid_ = true;
 }
 
+AiksContext::AiksContext(std::shared_ptr<ContentContext> content_context)
+    : context_(content_context->GetContext()),
+      content_context_(std::move(content_context)) {
+  is_valid_ = content_context_->IsValid();
+}
+
+std::shared_ptr<AiksContext> AiksContext::MakeShared(
+    std::shared_ptr<Context> context,
+    std::shared_ptr<TypographerContext> typographer_context) {
+  if (!context || !context->IsValid()) {
+    return std::make_shared<AiksContext>(std::move(context),
+                                         std::move(typographer_context));
+  }
+
+  const SharedContentContextKey key(context.get(), std::this_thread::get_id());
+  Lock lock(g_shared_content_contexts_mutex);
+  if (auto content_context = g_shared_content_contexts[key].lock()) {
+    return std::shared_ptr<AiksContext>(
+        new AiksContext(std::move(content_context)));
+  }
+  auto aiks_context = std::make_shared<AiksContext>(
+      std::move(context), std::move(typographer_context));
+  if (aiks_context->IsValid()) {
+    for (auto it = g_shared_content_contexts.begin();
+         it != g_shared_content_contexts.end();) {
+      it = it->second.expired() ? g_shared_content_contexts.erase(it)
+                                : std::next(it);
+    }
+    g_shared_content_contexts[key] = aiks_context->content_context_;
+  }
+  return aiks_context;
+}
+
 AiksContext::~AiksContext() = default;
 
 bool AiksContext::IsValid() const {
@@ -40,16 +88,150 @@ ContentContext& AiksContext::GetContentContext() const {
   return *content_context_;
 }
 
+size_t AiksContext::GetContentContextShareCount() const {
+  return content_context_.use_count();
+}
+
 bool AiksContext::Render(const Picture& picture, RenderTarget& render_target) {
   if (!IsValid()) {
     return false;
   }
 
+  if (frame_arena_) {
+    // The picture of the previous frame is gone by now, so its blocks can be
+    // reused. The blocks of |picture| are kept until a later frame.
+    frame_arena_->Reset();
+  }
+
+  bool result = true;
   if (picture.pass) {
-    return picture.pass->Render(*content_context_, render_target);
+    picture.pass->MergeNestedSubpasses();
+    if (is_occlusion_culling_enabled_) {
+      culled_draw_count_ = picture.pass->CullOccludedElements();
+    }
+    if (is_draw_reordering_enabled_) {
+      draw_reordering_statistics_ = picture.pass->ReorderElements();
+    }
+    result = picture.pass->Render(*content_context_, render_target);
+  }
+
+  if (variant_manifest_directory_.is_valid() &&
+      ++frames_rendered_ == kPersistVariantsAfterFrameCount) {
+    if (auto manifest = content_context_->GetCapturedVariants()) {
+      manifest->WriteToDirectory(variant_manifest_directory_);
+    }
+  }
+
+  return result;
+}
+
+bool AiksContext::RenderToRegion(const Picture& picture,
+                                 RenderTarget& render_target,
+                                 IRect region) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  auto target_bounds = IRect::MakeSize(render_target.GetRenderTargetSize());
+  auto clipped_region = target_bounds.Intersection(region);
+  if (!clipped_region.has_value()) {
+    // Nothing visible changed.
+    return true;
+  }
+
+  if (!context_->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    VALIDATION_LOG << "Rendering to a region requires texture to texture "
+                      "blits.";
+    return false;
+  }
+
+  // The render target cache is reset by each render, so the offscreen target
+  // can't come from it without being handed out again to a subpass.
+  RenderTargetAllocator allocator(context_->GetResourceAllocator());
+  auto offscreen_target =
+      content_context_->ShouldUseOffscreenMSAA()
+          ? RenderTarget::CreateOffscreenMSAA(*context_, allocator,
+                                              region.size,
+                                              "Partial Repaint MSAA")
+          : RenderTarget::CreateOffscreen(*context_, allocator, region.size,
+                                          "Partial Repaint");
+  if (!offscreen_target.IsValid()) {
+    VALIDATION_LOG << "Could not create the partial repaint render target.";
+    return false;
+  }
+
+  if (!Render(picture, offscreen_target)) {
+    return false;
   }
 
+  auto command_buffer = context_->CreateCommandBuffer();
+  command_buffer->SetLabel("Partial Repaint Command Buffer");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  blit_pass->AddCopy(
+      offscreen_target.GetRenderTargetTexture(),
+      render_target.GetRenderTargetTexture(),
+      IRect(clipped_region->origin - region.origin, clipped_region->size),
+      clipped_region->origin);
+  if (!blit_pass->EncodeCommands(context_->GetResourceAllocator())) {
+    VALIDATION_LOG << "Could not encode the partial repaint blit.";
+    return false;
+  }
+  if (!command_buffer->SubmitCommands()) {
+    VALIDATION_LOG << "Could not submit the partial repaint blit.";
+    return false;
+  }
   return true;
 }
 
+void AiksContext::SetFrameArenaEnabled(bool enabled) {
+  if (!enabled) {
+    frame_arena_ = nullptr;
+  } else if (!frame_arena_) {
+    frame_arena_ = std::make_shared<FrameArena>();
+  }
+}
+
+const std::shared_ptr<FrameArena>& AiksContext::GetFrameArena() const {
+  return frame_arena_;
+}
+
+void AiksContext::SetOcclusionCullingEnabled(bool enabled) {
+  is_occlusion_culling_enabled_ = enabled;
+}
+
+bool AiksContext::IsOcclusionCullingEnabled() const {
+  return is_occlusion_culling_enabled_;
+}
+
+size_t AiksContext::GetCulledDrawCount() const {
+  return culled_draw_count_;
+}
+
+void AiksContext::SetDrawReorderingEnabled(bool enabled) {
+  is_draw_reordering_enabled_ = enabled;
+}
+
+bool AiksContext::IsDrawReorderingEnabled() const {
+  return is_draw_reordering_enabled_;
+}
+
+const EntityPass::DrawReorderingStatistics&
+AiksContext::GetDrawReorderingStatistics() const {
+  return draw_reordering_statistics_;
+}
+
+void AiksContext::EnablePipelineVariantManifest(fml::UniqueFD directory) {
+  if (!IsValid() || !directory.is_valid()) {
+    return;
+  }
+  // Enable capture first so that the precompiled variants are carried over
+  // into the next manifest even if this run does not use them.
+  content_context_->SetVariantCaptureEnabled(true);
+  if (auto manifest = PipelineVariantManifest::ReadFromDirectory(directory)) {
+    content_context_->PrecompileVariants(*manifest);
+  }
+  variant_manifest_directory_ = std::move(directory);
+  frames_rendered_ = 0u;
+}
+
 }  // namespace impeller
@@ -5,9 +5,13 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity_pass.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/typographer/typographer_context.h"
@@ -31,6 +35,25 @@ class AiksContext {
   AiksContext(std::shared_ptr<Context> context,
               std::shared_ptr<TypographerContext> typographer_context);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create an AiksContext that shares its content context, and so
+  ///             its pipelines, glyph atlas and render target cache, with the
+  ///             other shared AiksContexts that were created for `context` on
+  ///             the calling thread and are still alive.
+  ///
+  ///             Content contexts are not thread safe, so they are only shared
+  ///             among AiksContexts used on the same thread, such as those of
+  ///             shells spawned from each other, which share a raster thread.
+  ///             `typographer_context` is only used when no content context
+  ///             can be shared.
+  ///
+  ///             The per-frame state of each AiksContext, such as its frame
+  ///             arena and statistics, is not shared.
+  ///
+  static std::shared_ptr<AiksContext> MakeShared(
+      std::shared_ptr<Context> context,
+      std::shared_ptr<TypographerContext> typographer_context);
+
   ~AiksContext();
 
   bool IsValid() const;
@@ -39,11 +62,98 @@ class AiksContext {
 
   ContentContext& GetContentContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of AiksContexts, including this one, that use this
+  ///             context's content context.
+  ///
+  size_t GetContentContextShareCount() const;
+
   bool Render(const Picture& picture, RenderTarget& render_target);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Render a picture that only covers one region of the render
+  ///             target, such as the damaged area of a partial repaint.
+  ///
+  ///             The picture is recorded in the coordinate space of the
+  ///             region. It is rendered into an offscreen texture the size of
+  ///             the region, which is then copied into place. Pixels outside
+  ///             of the region keep their previous contents.
+  ///
+  ///             The context must support texture to texture blits.
+  ///
+  bool RenderToRegion(const Picture& picture,
+                      RenderTarget& render_target,
+                      IRect region);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opt in to placing per-frame contents in a linear allocator.
+  ///             The arena is reset at the start of each call to |Render|,
+  ///             which reuses the blocks of the pictures that are gone.
+  ///
+  void SetFrameArenaEnabled(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The frame arena that canvases recording for this context
+  ///             should allocate from, or `nullptr` if it is not enabled.
+  ///
+  const std::shared_ptr<FrameArena>& GetFrameArena() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opt in to reordering the draws of each picture before it is
+  ///             rendered so that draws of the same kind that don't overlap
+  ///             are drawn together.
+  ///
+  /// @see        `EntityPass::ReorderElements`
+  ///
+  void SetDrawReorderingEnabled(bool enabled);
+
+  bool IsDrawReorderingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The pipeline switches of the last picture rendered with draw
+  ///             reordering, before and after reordering it.
+  ///
+  const EntityPass::DrawReorderingStatistics& GetDrawReorderingStatistics()
+      const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opt in to removing the draws of each picture that are hidden
+  ///             by opaque draws over them before it is rendered.
+  ///
+  /// @see        `EntityPass::CullOccludedElements`
+  ///
+  void SetOcclusionCullingEnabled(bool enabled);
+
+  bool IsOcclusionCullingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of draws removed from the last picture rendered
+  ///             with occlusion culling.
+  ///
+  size_t GetCulledDrawCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompile the pipeline variants that a previous run recorded
+  ///             in |directory| and record the variants used by this run.
+  ///             The recorded manifest is written back to |directory| once
+  ///             |kPersistVariantsAfterFrameCount| frames have been rendered.
+  ///
+  void EnablePipelineVariantManifest(fml::UniqueFD directory);
+
+  static constexpr size_t kPersistVariantsAfterFrameCount = 50u;
+
  private:
+  explicit AiksContext(std::shared_ptr<ContentContext> content_context);
+
   std::shared_ptr<Context> context_;
-  std::unique_ptr<ContentContext> content_context_;
+  std::shared_ptr<ContentContext> content_context_;
+  std::shared_ptr<FrameArena> frame_arena_;
+  fml::UniqueFD variant_manifest_directory_;
+  size_t frames_rendered_ = 0u;
+  bool is_occlusion_culling_enabled_ = false;
+  size_t culled_draw_count_ = 0u;
+  bool is_draw_reordering_enabled_ = false;
+  EntityPass::DrawReorderingStatistics draw_reordering_statistics_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AiksContext);
@@ -40,6 +40,38 @@ const std::optional<Picture>& AiksInspector::RenderInspector(
     aiks_context.GetContentContext().SetWireframe(wireframe_);
   }
 
+  if (ImGui::IsKeyPressed(ImGuiKey_A)) {
+    auto& content_context = aiks_context.GetContentContext();
+    content_context.SetCoverageAntiAliasingEnabled(
+        !content_context.IsCoverageAntiAliasingEnabled());
+  }
+
+  if (ImGui::IsKeyPressed(ImGuiKey_O)) {
+    aiks_context.SetOcclusionCullingEnabled(
+        !aiks_context.IsOcclusionCullingEnabled());
+  }
+
+  if (aiks_context.IsOcclusionCullingEnabled()) {
+    ImGui::Begin("Occlusion Culling");
+    ImGui::Text("Culled draws: %zu", aiks_context.GetCulledDrawCount());
+    ImGui::End();
+  }
+
+  if (ImGui::IsKeyPressed(ImGuiKey_R)) {
+    aiks_context.SetDrawReorderingEnabled(
+        !aiks_context.IsDrawReorderingEnabled());
+  }
+
+  if (aiks_context.IsDrawReorderingEnabled()) {
+    const auto& statistics = aiks_context.GetDrawReorderingStatistics();
+    ImGui::Begin("Draw Reordering");
+    ImGui::Text("Pipeline switches before: %zu",
+                statistics.pipeline_switches_before);
+    ImGui::Text("Pipeline switches after: %zu",
+                statistics.pipeline_switches_after);
+    ImGui::End();
+  }
+
   if (ImGui::IsKeyPressed(ImGuiKey_C)) {
     capturing_ = !capturing_;
     if (capturing_) {
@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -25,6 +26,7 @@
 #include "impeller/entity/contents/scene_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
+#include "impeller/entity/entity_pass.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/geometry_asserts.h"
@@ -1020,6 +1022,33 @@ TEST_P(AiksTest, CanPictureConvertToImage) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, FrameArenaReusesBlocksAcrossFrames) {
+  AiksContext renderer(GetContext(), nullptr);
+  renderer.SetFrameArenaEnabled(true);
+  const auto& arena = renderer.GetFrameArena();
+  ASSERT_TRUE(arena);
+
+  auto render_frame = [&]() {
+    Canvas canvas;
+    canvas.SetFrameArena(arena);
+    canvas.ClipRRect(Rect::MakeXYWH(0, 0, 100, 100), 10);
+    canvas.DrawRect(Rect::MakeXYWH(0, 0, 100, 100), {.color = Color::Red()});
+    Picture picture = canvas.EndRecordingAsPicture();
+    return picture.ToImage(renderer, ISize{100, 100}) != nullptr;
+  };
+
+  // Each frame is recorded while the picture of the previous one is still
+  // held, so the frames alternate between the blocks of two frames.
+  ASSERT_TRUE(render_frame());
+  ASSERT_TRUE(render_frame());
+  const auto block_count = arena->GetBlockCount();
+  ASSERT_GT(block_count, 0u);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(render_frame());
+  }
+  EXPECT_EQ(arena->GetBlockCount(), block_count);
+}
+
 TEST_P(AiksTest, BlendModeShouldCoverWholeScreen) {
   Canvas canvas;
   Paint paint;
@@ -2551,6 +2580,47 @@ TEST_P(AiksTest, TranslucentSaveLayerWithColorAndImageFilterDrawsCorrectly) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, NestedTranslucentSaveLayersDrawCorrectly) {
+  Canvas canvas;
+
+  canvas.DrawRect(Rect::MakeXYWH(100, 100, 300, 300), {.color = Color::Blue()});
+
+  // The inner layer is merged into the outer one, which must look the same as
+  // drawing both.
+  canvas.SaveLayer({
+      .color = Color::Black().WithAlpha(0.75),
+      .color_filter =
+          ColorFilter::MakeBlend(BlendMode::kDestinationOver, Color::Red()),
+  });
+  canvas.SaveLayer({.color = Color::Black().WithAlpha(0.5)});
+  canvas.DrawRect(Rect::MakeXYWH(200, 200, 300, 300), {.color = Color::Blue()});
+  canvas.DrawCircle({500, 500}, 100, {.color = Color::Green()});
+  canvas.Restore();
+  canvas.Restore();
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
+TEST_P(AiksTest, AdvancedBlendsOnlyChangeTheSourceBounds) {
+  Canvas canvas;
+
+  canvas.DrawPaint({.color = Color::CornflowerBlue()});
+  canvas.DrawCircle({300, 300}, 200, {.color = Color::Yellow()});
+  // Only the pixels under each source are blended, and the rest of the pass
+  // must stay as it was.
+  canvas.DrawRect(Rect::MakeXYWH(150.5, 150.5, 100, 100),
+                  {.color = Color::Red(), .blend_mode = BlendMode::kMultiply});
+  canvas.DrawCircle(
+      {400, 400}, 75,
+      {.color = Color::Green(), .blend_mode = BlendMode::kColorDodge});
+  canvas.ClipRect(Rect::MakeXYWH(250, 100, 100, 400));
+  canvas.DrawRect(
+      Rect::MakeXYWH(200, 250, 200, 100),
+      {.color = Color::White(), .blend_mode = BlendMode::kDifference});
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
 TEST_P(AiksTest, TranslucentSaveLayerImageDrawsCorrectly) {
   Canvas canvas;
 
@@ -2798,6 +2868,35 @@ TEST_P(AiksTest, CanRenderBackdropBlur) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, CanRenderBackdropBlursOfIncreasingSigma) {
+  Canvas canvas;
+  for (int i = 0; i < 8; i++) {
+    canvas.DrawRect(Rect::MakeXYWH(i * 100, 0, 50, 400),
+                    {.color = Color::CornflowerBlue()});
+  }
+  canvas.DrawCircle({400, 200}, 150, {.color = Color::OrangeRed()});
+
+  // The larger sigmas sample a downsampled copy of the backdrop.
+  Scalar sigmas[] = {5, 15, 30, 60};
+  for (size_t i = 0; i < 4; i++) {
+    canvas.Save();
+    canvas.ClipRect(Rect::MakeXYWH(i * 200, 50, 180, 300));
+    canvas.SaveLayer({.blend_mode = BlendMode::kSource}, std::nullopt,
+                     [sigma = sigmas[i]](const FilterInput::Ref& input,
+                                         const Matrix& effect_transform,
+                                         bool is_subpass) {
+                       return FilterContents::MakeGaussianBlur(
+                           input, Sigma(sigma), Sigma(sigma),
+                           FilterContents::BlurStyle::kNormal,
+                           Entity::TileMode::kClamp, effect_transform);
+                     });
+    canvas.Restore();
+    canvas.Restore();
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
 TEST_P(AiksTest, CanRenderBackdropBlurHugeSigma) {
   Canvas canvas;
   canvas.DrawCircle({400, 400}, 300, {.color = Color::Green()});
@@ -3417,5 +3516,61 @@ TEST_P(AiksTest, CaptureInactivatedByDefault) {
   ASSERT_FALSE(GetContext()->capture.IsActive());
 }
 
+#ifdef IMPELLER_ENABLE_CAPTURE
+TEST_P(AiksTest, CaptureRecordsEntityCommands) {
+  Canvas canvas;
+  canvas.DrawRect(Rect::MakeXYWH(10, 10, 100, 100), {.color = Color::Red()});
+  Picture picture = canvas.EndRecordingAsPicture();
+
+  auto context = GetContext();
+  context->capture =
+      CaptureContext::MakeAllowlist({EntityPass::kCaptureDocumentName});
+  AiksContext renderer(context, nullptr);
+  auto image = picture.ToImage(renderer, ISize(200, 200));
+  auto document =
+      context->capture.GetDocument(EntityPass::kCaptureDocumentName);
+  context->capture = CaptureContext::MakeInactive();
+  ASSERT_NE(image, nullptr);
+
+  auto entity = document.GetElement()->children.FindFirstByLabel("Entity");
+  ASSERT_NE(entity, nullptr);
+  auto pipelines = entity->properties.FindFirstByLabel("Pipelines");
+  ASSERT_NE(pipelines, nullptr);
+  EXPECT_FALSE(pipelines->AsString().value_or("").empty());
+  auto draw_count = entity->properties.FindFirstByLabel("Draw Count");
+  ASSERT_NE(draw_count, nullptr);
+  EXPECT_EQ(draw_count->AsInteger(), 1);
+  auto render_target = entity->properties.FindFirstByLabel("Render Target");
+  ASSERT_NE(render_target, nullptr);
+  EXPECT_EQ(render_target->AsRect(), Rect::MakeSize(ISize(200, 200)));
+  auto encode_time = entity->properties.FindFirstByLabel("Encode Time (us)");
+  ASSERT_NE(encode_time, nullptr);
+  EXPECT_GE(encode_time->AsScalar().value_or(-1), 0);
+}
+#endif  // IMPELLER_ENABLE_CAPTURE
+
+TEST_P(AiksTest, SharesContentContextsOnTheSameThread) {
+  auto first = AiksContext::MakeShared(GetContext(), nullptr);
+  auto second = AiksContext::MakeShared(GetContext(), nullptr);
+  ASSERT_TRUE(first->IsValid());
+  ASSERT_TRUE(second->IsValid());
+  EXPECT_EQ(&first->GetContentContext(), &second->GetContentContext());
+  EXPECT_EQ(first->GetContentContextShareCount(), 2u);
+
+  // Content contexts aren't thread safe, so other threads get their own.
+  std::shared_ptr<AiksContext> other_thread;
+  std::thread thread([&]() {
+    other_thread = AiksContext::MakeShared(GetContext(), nullptr);
+  });
+  thread.join();
+  ASSERT_TRUE(other_thread->IsValid());
+  EXPECT_NE(&other_thread->GetContentContext(), &first->GetContentContext());
+  EXPECT_EQ(other_thread->GetContentContextShareCount(), 1u);
+
+  // Contexts created directly don't share.
+  AiksContext unshared(GetContext(), nullptr);
+  EXPECT_NE(&unshared.GetContentContext(), &first->GetContentContext());
+}
+
 }  // namespace testing
 }  // namespace impeller
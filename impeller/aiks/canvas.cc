@@ -45,10 +45,15 @@ void Canvas::Initialize(std::optional<Rect> cull_rect) {
   FML_DCHECK(base_pass_->GetSubpassesDepth() == 1u);
 }
 
+void Canvas::SetFrameArena(std::shared_ptr<FrameArena> frame_arena) {
+  frame_arena_ = std::move(frame_arena);
+}
+
 void Canvas::Reset() {
   base_pass_ = nullptr;
   current_pass_ = nullptr;
   xformation_stack_ = {};
+  image_rect_batch_ = {};
 }
 
 void Canvas::Save() {
@@ -62,6 +67,7 @@ void Canvas::Save(bool create_subpass,
   entry.xformation = xformation_stack_.back().xformation;
   entry.cull_rect = xformation_stack_.back().cull_rect;
   entry.stencil_depth = xformation_stack_.back().stencil_depth;
+  entry.scissor = xformation_stack_.back().scissor;
   if (create_subpass) {
     entry.is_subpass = true;
     auto subpass = std::make_unique<EntityPass>();
@@ -72,6 +78,7 @@ void Canvas::Save(bool create_subpass,
     current_pass_ = GetCurrentPass().AddSubpass(std::move(subpass));
     current_pass_->SetTransformation(xformation_stack_.back().xformation);
     current_pass_->SetStencilDepth(xformation_stack_.back().stencil_depth);
+    current_pass_->SetScissor(xformation_stack_.back().scissor);
   }
   xformation_stack_.emplace_back(entry);
 }
@@ -164,7 +171,7 @@ void Canvas::DrawPath(const Path& path, const Paint& paint) {
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(paint.WithFilters(paint.CreateContentsForEntity(path)));
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawPaint(const Paint& paint) {
@@ -174,7 +181,7 @@ void Canvas::DrawPaint(const Paint& paint) {
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(paint.CreateContentsForEntity({}, true));
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
@@ -195,7 +202,7 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
   // For symmetrically mask blurred solid RRects, absorb the mask blur and use
   // a faster SDF approximation.
 
-  auto contents = std::make_shared<SolidRRectBlurContents>();
+  auto contents = MakeContents<SolidRRectBlurContents>();
   contents->SetColor(new_paint.color);
   contents->SetSigma(new_paint.mask_blur_descriptor->sigma);
   contents->SetRRect(rect, corner_radius);
@@ -208,7 +215,7 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
   entity.SetBlendMode(new_paint.blend_mode);
   entity.SetContents(new_paint.WithFilters(std::move(contents)));
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 
   return true;
 }
@@ -230,7 +237,7 @@ void Canvas::DrawRect(Rect rect, const Paint& paint) {
   entity.SetContents(paint.WithFilters(
       paint.CreateContentsForGeometry(Geometry::MakeRect(rect))));
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint) {
@@ -249,7 +256,7 @@ void Canvas::DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint) {
     entity.SetContents(paint.WithFilters(
         paint.CreateContentsForGeometry(Geometry::MakeFillPath(path))));
 
-    GetCurrentPass().AddEntity(entity);
+    AddEntityToCurrentPass(std::move(entity));
     return;
   }
   DrawPath(path, paint);
@@ -288,6 +295,15 @@ void Canvas::ClipRect(const Rect& rect, Entity::ClipOperation clip_op) {
     return;  // This clip will do nothing, so skip it.
   }
 
+  // Rects that stay axis-aligned on screen don't need the stencil. Scissoring
+  // the draws after them saves drawing the clip and restoring it.
+  if (clip_op == Entity::ClipOperation::kIntersect &&
+      GetCurrentTransformation().IsTranslationScaleOnly()) {
+    IntersectScissor(rect.TransformBounds(GetCurrentTransformation()));
+    IntersectCulling(rect);
+    return;
+  }
+
   ClipGeometry(std::move(geometry), clip_op);
   switch (clip_op) {
     case Entity::ClipOperation::kIntersect:
@@ -351,7 +367,7 @@ void Canvas::ClipRRect(const Rect& rect,
 
 void Canvas::ClipGeometry(std::unique_ptr<Geometry> geometry,
                           Entity::ClipOperation clip_op) {
-  auto contents = std::make_shared<ClipContents>();
+  auto contents = MakeContents<ClipContents>();
   contents->SetGeometry(std::move(geometry));
   contents->SetClipOperation(clip_op);
 
@@ -360,12 +376,21 @@ void Canvas::ClipGeometry(std::unique_ptr<Geometry> geometry,
   entity.SetContents(std::move(contents));
   entity.SetStencilDepth(GetStencilDepth());
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 
   ++xformation_stack_.back().stencil_depth;
   xformation_stack_.back().contains_clips = true;
 }
 
+void Canvas::IntersectScissor(Rect scissor) {
+  std::optional<Rect>& current = xformation_stack_.back().scissor;
+  if (current.has_value()) {
+    current = current->Intersection(scissor).value_or(Rect{});
+  } else {
+    current = scissor;
+  }
+}
+
 void Canvas::IntersectCulling(Rect clip_rect) {
   clip_rect = clip_rect.TransformBounds(GetCurrentTransformation());
   std::optional<Rect>& cull_rect = xformation_stack_.back().cull_rect;
@@ -396,10 +421,10 @@ void Canvas::RestoreClip() {
   entity.SetTransformation(GetCurrentTransformation());
   // This path is empty because ClipRestoreContents just generates a quad that
   // takes up the full render target.
-  entity.SetContents(std::make_shared<ClipRestoreContents>());
+  entity.SetContents(MakeContents<ClipRestoreContents>());
   entity.SetStencilDepth(GetStencilDepth());
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawPoints(std::vector<Point> points,
@@ -418,7 +443,7 @@ void Canvas::DrawPoints(std::vector<Point> points,
       Geometry::MakePointField(std::move(points), radius,
                                /*round=*/point_style == PointStyle::kRound))));
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawPicture(const Picture& picture) {
@@ -429,17 +454,38 @@ void Canvas::DrawPicture(const Picture& picture) {
   // Clone the base pass and account for the CTM updates.
   auto pass = picture.pass->Clone();
 
+  // The scissors of the picture are transformed to the screen like its draws.
+  // Only transforms that keep rects axis-aligned keep them exact, like for
+  // ClipRect. Otherwise they are widened to their bounds, and the stencil
+  // clips the draws to the transformed scissors instead.
+  if (!GetCurrentTransformation().IsTranslationScaleOnly()) {
+    pass->ClipToScissors();
+  }
+  auto transform_scissor = [&](const std::optional<Rect>& scissor) {
+    std::optional<Rect> result = GetScissor();
+    if (scissor.has_value()) {
+      auto transformed = scissor->TransformBounds(GetCurrentTransformation());
+      result = result.has_value()
+                   ? result->Intersection(transformed).value_or(Rect{})
+                   : transformed;
+    }
+    return result;
+  };
+
   pass->IterateAllElements([&](auto& element) -> bool {
     if (auto entity = std::get_if<Entity>(&element)) {
       entity->IncrementStencilDepth(GetStencilDepth());
       entity->SetTransformation(GetCurrentTransformation() *
                                 entity->GetTransformation());
+      entity->SetScissor(transform_scissor(entity->GetScissor()));
       return true;
     }
 
     if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
       subpass->get()->SetStencilDepth(subpass->get()->GetStencilDepth() +
                                       GetStencilDepth());
+      subpass->get()->SetScissor(
+          transform_scissor(subpass->get()->GetScissor()));
       return true;
     }
 
@@ -481,6 +527,14 @@ void Canvas::DrawImageRect(const std::shared_ptr<Image>& image,
     return;
   }
 
+  // Filters apply to everything the contents draw, so only images drawn
+  // without them are batched.
+  const bool can_batch =
+      !paint.color_filter && !paint.image_filter && !paint.invert_colors;
+  if (can_batch && AttemptBatchImageRect(image, source, dest, paint, sampler)) {
+    return;
+  }
+
   auto contents = TextureContents::MakeRect(dest);
   contents->SetTexture(image->GetTexture());
   contents->SetSourceRect(source);
@@ -494,7 +548,64 @@ void Canvas::DrawImageRect(const std::shared_ptr<Image>& image,
   entity.SetContents(paint.WithFilters(contents));
   entity.SetTransformation(GetCurrentTransformation());
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
+
+  image_rect_batch_ = {};
+  if (can_batch) {
+    image_rect_batch_.contents = std::move(contents);
+    image_rect_batch_.pass = &GetCurrentPass();
+    image_rect_batch_.element_count = GetCurrentPass().GetElementCount();
+    image_rect_batch_.transform = GetCurrentTransformation();
+    image_rect_batch_.stencil_depth = GetStencilDepth();
+    image_rect_batch_.scissor = GetScissor();
+    image_rect_batch_.blend_mode = paint.blend_mode;
+  }
+}
+
+bool Canvas::AttemptBatchImageRect(const std::shared_ptr<Image>& image,
+                                   Rect source,
+                                   Rect dest,
+                                   const Paint& paint,
+                                   const SamplerDescriptor& sampler) {
+  const auto& batch = image_rect_batch_;
+  // Anything added to the pass since, including clips and their restores,
+  // changes its element count.
+  if (!batch.contents || batch.pass != &GetCurrentPass() ||
+      batch.element_count != GetCurrentPass().GetElementCount()) {
+    return false;
+  }
+  if (batch.contents->GetTexture() != image->GetTexture() ||
+      !batch.contents->GetSamplerDescriptor().IsEqual(sampler) ||
+      batch.contents->GetOpacity() != paint.color.alpha ||
+      batch.blend_mode != paint.blend_mode ||
+      batch.stencil_depth != GetStencilDepth() ||
+      batch.scissor != GetScissor() ||
+      batch.transform != GetCurrentTransformation()) {
+    return false;
+  }
+  batch.contents->AddRect(source, dest);
+  return true;
+}
+
+void Canvas::DrawFilterRect(std::shared_ptr<FilterContents> filter,
+                            Rect source,
+                            Rect dest,
+                            const Paint& paint) {
+  if (!filter || source.size.IsEmpty() || dest.size.IsEmpty()) {
+    return;
+  }
+
+  Entity entity;
+  entity.SetBlendMode(paint.blend_mode);
+  entity.SetStencilDepth(GetStencilDepth());
+  entity.SetContents(paint.WithFilters(std::move(filter)));
+  entity.SetTransformation(
+      GetCurrentTransformation() * Matrix::MakeTranslation(dest.origin) *
+      Matrix::MakeScale(Vector2(dest.size.width / source.size.width,
+                                dest.size.height / source.size.height)) *
+      Matrix::MakeTranslation(-source.origin));
+
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 Picture Canvas::EndRecordingAsPicture() {
@@ -512,10 +623,19 @@ EntityPass& Canvas::GetCurrentPass() {
   return *current_pass_;
 }
 
+void Canvas::AddEntityToCurrentPass(Entity entity) {
+  entity.SetScissor(GetScissor());
+  GetCurrentPass().AddEntity(std::move(entity));
+}
+
 size_t Canvas::GetStencilDepth() const {
   return xformation_stack_.back().stencil_depth;
 }
 
+const std::optional<Rect>& Canvas::GetScissor() const {
+  return xformation_stack_.back().scissor;
+}
+
 void Canvas::SaveLayer(const Paint& paint,
                        std::optional<Rect> bounds,
                        const Paint::ImageFilterProc& backdrop_filter) {
@@ -540,7 +660,7 @@ void Canvas::DrawTextFrame(const TextFrame& text_frame,
   entity.SetStencilDepth(GetStencilDepth());
   entity.SetBlendMode(paint.blend_mode);
 
-  auto text_contents = std::make_shared<TextContents>();
+  auto text_contents = MakeContents<TextContents>();
   text_contents->SetTextFrame(TextFrame(text_frame));
   text_contents->SetColor(paint.color);
 
@@ -556,7 +676,7 @@ void Canvas::DrawTextFrame(const TextFrame& text_frame,
   entity.SetContents(
       paint.WithFilters(paint.WithMaskBlur(std::move(text_contents), true)));
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 static bool UseColorSourceContents(
@@ -596,7 +716,7 @@ void Canvas::DrawVertices(const std::shared_ptr<VerticesGeometry>& vertices,
   if (UseColorSourceContents(vertices, paint)) {
     auto contents = paint.CreateContentsForGeometry(vertices);
     entity.SetContents(paint.WithFilters(std::move(contents)));
-    GetCurrentPass().AddEntity(entity);
+    AddEntityToCurrentPass(std::move(entity));
     return;
   }
 
@@ -627,14 +747,14 @@ void Canvas::DrawVertices(const std::shared_ptr<VerticesGeometry>& vertices,
         src_paint.CreateContentsForGeometry(Geometry::MakeRect(src_coverage));
   }
 
-  auto contents = std::make_shared<VerticesContents>();
+  auto contents = MakeContents<VerticesContents>();
   contents->SetAlpha(paint.color.alpha);
   contents->SetBlendMode(blend_mode);
   contents->SetGeometry(vertices);
   contents->SetSourceContents(std::move(src_contents));
   entity.SetContents(paint.WithFilters(std::move(contents)));
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 void Canvas::DrawAtlas(const std::shared_ptr<Image>& atlas,
@@ -649,7 +769,7 @@ void Canvas::DrawAtlas(const std::shared_ptr<Image>& atlas,
     return;
   }
 
-  std::shared_ptr<AtlasContents> contents = std::make_shared<AtlasContents>();
+  std::shared_ptr<AtlasContents> contents = MakeContents<AtlasContents>();
   contents->SetColors(std::move(colors));
   contents->SetTransforms(std::move(transforms));
   contents->SetTextureCoordinates(std::move(texture_coordinates));
@@ -665,7 +785,7 @@ void Canvas::DrawAtlas(const std::shared_ptr<Image>& atlas,
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(paint.WithFilters(contents));
 
-  GetCurrentPass().AddEntity(entity);
+  AddEntityToCurrentPass(std::move(entity));
 }
 
 }  // namespace impeller
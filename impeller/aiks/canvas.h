@@ -14,6 +14,7 @@
 #include "impeller/aiks/image.h"
 #include "impeller/aiks/paint.h"
 #include "impeller/aiks/picture.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/entity_pass.h"
 #include "impeller/entity/geometry/geometry.h"
@@ -28,12 +29,16 @@
 namespace impeller {
 
 class Entity;
+class TextureContents;
 
 struct CanvasStackEntry {
   Matrix xformation;
   // |cull_rect| is conservative screen-space bounds of the clipped output area
   std::optional<Rect> cull_rect;
   size_t stencil_depth = 0u;
+  // |scissor| is the screen-space intersection of the axis-aligned rect clips,
+  // which are applied as a scissor instead of through the stencil
+  std::optional<Rect> scissor;
   bool is_subpass = false;
   bool contains_clips = false;
 };
@@ -124,6 +129,18 @@ class Canvas {
                      const Paint& paint,
                      SamplerDescriptor sampler = {});
 
+  //----------------------------------------------------------------------------
+  /// @brief      Draws the output of `filter`, whose coverage in its local
+  ///             space is `source`, scaled and translated into `dest`.
+  ///
+  ///             Used to sample images without converting them into a
+  ///             texture first, like images made of separate YUV planes.
+  ///
+  void DrawFilterRect(std::shared_ptr<FilterContents> filter,
+                      Rect source,
+                      Rect dest,
+                      const Paint& paint);
+
   void ClipPath(
       const Path& path,
       Entity::ClipOperation clip_op = Entity::ClipOperation::kIntersect);
@@ -158,11 +175,40 @@ class Canvas {
 
   Picture EndRecordingAsPicture();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Allocate the contents recorded by this canvas from the given
+  ///             frame arena. Passing `nullptr` reverts to the heap.
+  ///
+  void SetFrameArena(std::shared_ptr<FrameArena> frame_arena);
+
  private:
   std::unique_ptr<EntityPass> base_pass_;
   EntityPass* current_pass_ = nullptr;
   std::deque<CanvasStackEntry> xformation_stack_;
   std::optional<Rect> initial_cull_rect_;
+  std::shared_ptr<FrameArena> frame_arena_;
+
+  // The contents of the last image drawn by `DrawImageRect`, which the next
+  // image rect is added to if it has the same texture and state, and nothing
+  // else was drawn in between.
+  struct ImageRectBatch {
+    std::shared_ptr<TextureContents> contents;
+    const EntityPass* pass = nullptr;
+    size_t element_count = 0u;
+    Matrix transform;
+    size_t stencil_depth = 0u;
+    std::optional<Rect> scissor;
+    BlendMode blend_mode = BlendMode::kSourceOver;
+  };
+  ImageRectBatch image_rect_batch_;
+
+  template <class T>
+  std::shared_ptr<T> MakeContents() {
+    if (frame_arena_) {
+      return frame_arena_->MakeShared<T>();
+    }
+    return std::make_shared<T>();
+  }
 
   void Initialize(std::optional<Rect> cull_rect);
 
@@ -170,11 +216,17 @@ class Canvas {
 
   EntityPass& GetCurrentPass();
 
+  void AddEntityToCurrentPass(Entity entity);
+
   size_t GetStencilDepth() const;
 
+  const std::optional<Rect>& GetScissor() const;
+
   void ClipGeometry(std::unique_ptr<Geometry> geometry,
                     Entity::ClipOperation clip_op);
 
+  void IntersectScissor(Rect scissor);
+
   void IntersectCulling(Rect clip_bounds);
   void SubtractCulling(Rect clip_bounds);
 
@@ -184,6 +236,12 @@ class Canvas {
 
   void RestoreClip();
 
+  bool AttemptBatchImageRect(const std::shared_ptr<Image>& image,
+                             Rect source,
+                             Rect dest,
+                             const Paint& paint,
+                             const SamplerDescriptor& sampler);
+
   bool AttemptDrawBlurredRRect(const Rect& rect,
                                Scalar corner_radius,
                                const Paint& paint);
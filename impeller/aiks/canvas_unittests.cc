@@ -4,7 +4,10 @@
 
 #include "flutter/testing/testing.h"
 #include "impeller/aiks/canvas.h"
+#include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/contents/texture_contents.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/testing/mocks.h"
 
 // TODO(zanderso): https://github.com/flutter/flutter/issues/127701
 // NOLINTBEGIN(bugprone-unchecked-optional-access)
@@ -336,6 +339,217 @@ TEST(AiksCanvasTest, PathClipDiffAgainstFullyCoveredCullRect) {
   ASSERT_EQ(canvas.GetCurrentLocalCullingBounds().value(), result_cull);
 }
 
+static std::shared_ptr<Image> MakeMockImage(ISize size) {
+  TextureDescriptor desc;
+  desc.size = size;
+  auto texture = std::make_shared<::testing::NiceMock<MockTexture>>(desc);
+  ON_CALL(*texture, GetSize).WillByDefault(::testing::Return(size));
+  return std::make_shared<Image>(texture);
+}
+
+static std::vector<size_t> GetTextureRectCounts(const Picture& picture) {
+  std::vector<size_t> counts;
+  picture.pass->IterateAllEntities([&counts](Entity& entity) {
+    auto contents =
+        std::static_pointer_cast<TextureContents>(entity.GetContents());
+    counts.push_back(contents->GetRectCount());
+    return true;
+  });
+  return counts;
+}
+
+TEST(AiksCanvasTest, ConsecutiveImageRectsAreBatched) {
+  auto image = MakeMockImage(ISize(30, 30));
+
+  Canvas canvas;
+  Paint paint;
+  canvas.DrawImageRect(image, Rect::MakeXYWH(0, 0, 10, 10),
+                       Rect::MakeXYWH(0, 0, 10, 10), paint);
+  canvas.DrawImageRect(image, Rect::MakeXYWH(10, 0, 10, 10),
+                       Rect::MakeXYWH(10, 0, 50, 10), paint);
+  canvas.DrawImageRect(image, Rect::MakeXYWH(20, 0, 10, 10),
+                       Rect::MakeXYWH(60, 0, 10, 10), paint);
+
+  auto picture = canvas.EndRecordingAsPicture();
+  ASSERT_EQ(GetTextureRectCounts(picture), std::vector<size_t>{3u});
+}
+
+TEST(AiksCanvasTest, ImageRectsWithDifferentStateAreNotBatched) {
+  auto image = MakeMockImage(ISize(30, 30));
+  auto other_image = MakeMockImage(ISize(30, 30));
+  auto source = Rect::MakeXYWH(0, 0, 10, 10);
+  auto dest = Rect::MakeXYWH(0, 0, 10, 10);
+
+  Canvas canvas;
+  Paint paint;
+  canvas.DrawImageRect(image, source, dest, paint);
+  canvas.DrawImageRect(other_image, source, dest, paint);
+  canvas.Translate({10, 0});
+  canvas.DrawImageRect(other_image, source, dest, paint);
+  canvas.DrawImageRect(other_image, source, dest,
+                       {.blend_mode = BlendMode::kMultiply});
+  canvas.DrawImageRect(other_image, source, dest, {.invert_colors = true});
+
+  auto picture = canvas.EndRecordingAsPicture();
+  ASSERT_EQ(picture.pass->GetElementCount(), 5u);
+}
+
+TEST(AiksCanvasTest, ClipContentsAreAllocatedFromFrameArena) {
+  auto arena = std::make_shared<FrameArena>();
+
+  Canvas canvas;
+  canvas.SetFrameArena(arena);
+  canvas.ClipRRect(Rect::MakeXYWH(0, 0, 10, 10), 2);
+  ASSERT_GT(arena->GetAllocatedBytes(), 0u);
+
+  auto picture = canvas.EndRecordingAsPicture();
+  arena->Reset();
+  // The recorded picture keeps its arena block alive after the reset.
+  ASSERT_EQ(arena->GetAllocatedBytes(), 0u);
+  ASSERT_TRUE(picture.pass);
+}
+
+TEST(AiksCanvasTest, AxisAlignedRectClipsAreAppliedAsScissors) {
+  Canvas canvas;
+  canvas.Translate({10, 20});
+  canvas.Save();
+  canvas.ClipRect(Rect::MakeXYWH(0, 0, 100, 100));
+  canvas.ClipRect(Rect::MakeXYWH(50, 50, 100, 100));
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 200, 200), {.color = Color::Red()});
+  canvas.Restore();
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 200, 200), {.color = Color::Blue()});
+
+  auto picture = canvas.EndRecordingAsPicture();
+  std::vector<std::optional<Rect>> scissors;
+  picture.pass->IterateAllEntities([&scissors](Entity& entity) {
+    scissors.push_back(entity.GetScissor());
+    return true;
+  });
+  // Neither the clips nor their restore are recorded as entities.
+  ASSERT_EQ(scissors.size(), 2u);
+  ASSERT_EQ(scissors[0], Rect::MakeXYWH(60, 70, 50, 50));
+  ASSERT_FALSE(scissors[1].has_value());
+}
+
+TEST(AiksCanvasTest, RotatedRectClipsUseTheStencil) {
+  Canvas canvas;
+  canvas.Save();
+  canvas.Rotate(Degrees(45));
+  canvas.ClipRect(Rect::MakeXYWH(0, 0, 100, 100));
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 200, 200), {.color = Color::Red()});
+  canvas.Restore();
+
+  auto picture = canvas.EndRecordingAsPicture();
+  // The clip, the draw and the clip restore.
+  ASSERT_EQ(picture.pass->GetElementCount(), 3u);
+  picture.pass->IterateAllEntities([](Entity& entity) {
+    EXPECT_FALSE(entity.GetScissor().has_value());
+    return true;
+  });
+}
+
+namespace {
+Picture MakePictureWithRectClip() {
+  Canvas canvas;
+  canvas.Save();
+  canvas.ClipRect(Rect::MakeXYWH(0, 0, 50, 50));
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 100, 100), {.color = Color::Red()});
+  canvas.Restore();
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 100, 100), {.color = Color::Blue()});
+  return canvas.EndRecordingAsPicture();
+}
+}  // namespace
+
+TEST(AiksCanvasTest, PictureScissorsAreTranslatedWithThePicture) {
+  Canvas canvas;
+  canvas.Translate({10, 20});
+  canvas.DrawPicture(MakePictureWithRectClip());
+
+  auto picture = canvas.EndRecordingAsPicture();
+  std::vector<Entity> entities;
+  picture.pass->IterateAllEntities([&entities](Entity& entity) {
+    entities.push_back(entity);
+    return true;
+  });
+  // The two draws and the restore of the picture.
+  ASSERT_EQ(entities.size(), 3u);
+  ASSERT_EQ(entities[0].GetScissor(), Rect::MakeXYWH(10, 20, 50, 50));
+  ASSERT_EQ(entities[0].GetStencilDepth(), 0u);
+  ASSERT_FALSE(entities[1].GetScissor().has_value());
+}
+
+TEST(AiksCanvasTest, PictureScissorsAreClippedWithTheStencilUnderRotation) {
+  Canvas canvas;
+  canvas.Rotate(Degrees(45));
+  canvas.DrawPicture(MakePictureWithRectClip());
+
+  auto picture = canvas.EndRecordingAsPicture();
+  std::vector<Entity> entities;
+  picture.pass->IterateAllEntities([&entities](Entity& entity) {
+    entities.push_back(entity);
+    return true;
+  });
+  // The scissor is widened to its bounds on screen, and the clip, the draw in
+  // it and its restore keep the draw to the rotated rect.
+  ASSERT_EQ(entities.size(), 5u);
+  const Matrix rotation = Matrix::MakeRotationZ(Degrees(45));
+  const Rect bounds = Rect::MakeXYWH(0, 0, 50, 50).TransformBounds(rotation);
+
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<ClipContents>(entities[0].GetContents()));
+  ASSERT_EQ(entities[0].GetTransformation(), rotation);
+  ASSERT_EQ(entities[0].GetStencilDepth(), 0u);
+  ASSERT_EQ(entities[0].GetScissor(), bounds);
+
+  ASSERT_EQ(entities[1].GetStencilDepth(), 1u);
+  ASSERT_EQ(entities[1].GetScissor(), bounds);
+
+  ASSERT_TRUE(std::dynamic_pointer_cast<ClipRestoreContents>(
+      entities[2].GetContents()));
+  ASSERT_EQ(entities[2].GetStencilDepth(), 0u);
+
+  // The draw outside of the clip is left alone.
+  ASSERT_EQ(entities[3].GetStencilDepth(), 0u);
+  ASSERT_FALSE(entities[3].GetScissor().has_value());
+}
+
+TEST(AiksCanvasTest, NestedOpacityLayersAreMerged) {
+  Canvas canvas;
+  canvas.SaveLayer({.color = Color::Black().WithAlpha(0.5),
+                    .color_filter = ColorFilter::MakeBlend(
+                        BlendMode::kSourceOver, Color::Red())});
+  canvas.SaveLayer({.color = Color::Black().WithAlpha(0.5)});
+  canvas.SaveLayer({.color = Color::Black().WithAlpha(0.5)});
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), {.color = Color::Blue()});
+  canvas.DrawRect(Rect::MakeXYWH(5, 5, 10, 10), {.color = Color::Blue()});
+  canvas.Restore();
+  canvas.Restore();
+  canvas.Restore();
+
+  auto picture = canvas.EndRecordingAsPicture();
+  ASSERT_EQ(picture.pass->GetSubpassesDepth(), 4u);
+  ASSERT_EQ(picture.pass->MergeNestedSubpasses(), 2u);
+  ASSERT_EQ(picture.pass->GetSubpassesDepth(), 2u);
+  ASSERT_EQ(picture.pass->MergeNestedSubpasses(), 0u);
+}
+
+TEST(AiksCanvasTest, LayersWithImageFiltersAbsorbNoOpacity) {
+  Canvas canvas;
+  canvas.SaveLayer({.image_filter = [](const FilterInput::Ref& input,
+                                       const Matrix& effect_transform,
+                                       bool is_subpass) {
+    return FilterContents::MakeGaussianBlur(input, Sigma(5), Sigma(5));
+  }});
+  canvas.SaveLayer({.color = Color::Black().WithAlpha(0.5)});
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), {.color = Color::Blue()});
+  canvas.Restore();
+  canvas.Restore();
+
+  auto picture = canvas.EndRecordingAsPicture();
+  ASSERT_EQ(picture.pass->MergeNestedSubpasses(), 0u);
+  ASSERT_EQ(picture.pass->GetSubpassesDepth(), 3u);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -14,6 +14,28 @@
 
 namespace impeller {
 
+static std::optional<Scalar> GetPaintPlainOpacity(const Paint& paint) {
+  if (paint.blend_mode != BlendMode::kSourceOver || paint.image_filter ||
+      paint.color_filter) {
+    return std::nullopt;
+  }
+  return paint.color.alpha;
+}
+
+/// Returns `paint` with its opacity multiplied by `opacity`, unless it has an
+/// image filter. The opacity of the pass texture is applied before color
+/// filters, like the opacity of the layers it absorbs, but image filters may
+/// not commute with it.
+static std::optional<Paint> PaintWithOpacity(const Paint& paint,
+                                             Scalar opacity) {
+  if (paint.image_filter) {
+    return std::nullopt;
+  }
+  Paint result = paint;
+  result.color = paint.color.WithAlpha(paint.color.alpha * opacity);
+  return result;
+}
+
 /// PaintPassDelegate
 /// ----------------------------------------------
 
@@ -47,6 +69,21 @@ std::shared_ptr<Contents> PaintPassDelegate::CreateContentsForSubpassTarget(
                                             effect_transform);
 }
 
+// |EntityPassDelgate|
+std::optional<Scalar> PaintPassDelegate::GetPlainOpacity() {
+  return GetPaintPlainOpacity(paint_);
+}
+
+// |EntityPassDelgate|
+std::shared_ptr<EntityPassDelegate> PaintPassDelegate::MakeWithOpacity(
+    Scalar opacity) {
+  auto paint = PaintWithOpacity(paint_, opacity);
+  if (!paint.has_value()) {
+    return nullptr;
+  }
+  return std::make_shared<PaintPassDelegate>(paint.value());
+}
+
 /// OpacityPeepholePassDelegate
 /// ----------------------------------------------
 
@@ -140,4 +177,19 @@ OpacityPeepholePassDelegate::CreateContentsForSubpassTarget(
                                             effect_transform);
 }
 
+// |EntityPassDelgate|
+std::optional<Scalar> OpacityPeepholePassDelegate::GetPlainOpacity() {
+  return GetPaintPlainOpacity(paint_);
+}
+
+// |EntityPassDelgate|
+std::shared_ptr<EntityPassDelegate>
+OpacityPeepholePassDelegate::MakeWithOpacity(Scalar opacity) {
+  auto paint = PaintWithOpacity(paint_, opacity);
+  if (!paint.has_value()) {
+    return nullptr;
+  }
+  return std::make_shared<OpacityPeepholePassDelegate>(paint.value());
+}
+
 }  // namespace impeller
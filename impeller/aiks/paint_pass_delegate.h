@@ -32,6 +32,12 @@ class PaintPassDelegate final : public EntityPassDelegate {
       std::shared_ptr<Texture> target,
       const Matrix& effect_transform) override;
 
+  // |EntityPassDelgate|
+  std::optional<Scalar> GetPlainOpacity() override;
+
+  // |EntityPassDelgate|
+  std::shared_ptr<EntityPassDelegate> MakeWithOpacity(Scalar opacity) override;
+
  private:
   const Paint paint_;
 
@@ -61,6 +67,12 @@ class OpacityPeepholePassDelegate final : public EntityPassDelegate {
       std::shared_ptr<Texture> target,
       const Matrix& effect_transform) override;
 
+  // |EntityPassDelgate|
+  std::optional<Scalar> GetPlainOpacity() override;
+
+  // |EntityPassDelgate|
+  std::shared_ptr<EntityPassDelegate> MakeWithOpacity(Scalar opacity) override;
+
  private:
   const Paint paint_;
 
@@ -59,7 +59,7 @@ std::shared_ptr<Texture> Picture::RenderToTexture(
   RenderTargetAllocator render_target_allocator =
       RenderTargetAllocator(impeller_context->GetResourceAllocator());
   RenderTarget target;
-  if (impeller_context->GetCapabilities()->SupportsOffscreenMSAA()) {
+  if (context.GetContentContext().ShouldUseOffscreenMSAA()) {
     target = RenderTarget::CreateOffscreenMSAA(
         *impeller_context,        // context
         render_target_allocator,  // allocator
@@ -6,6 +6,7 @@
 
 #include <iterator>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "impeller/archivist/archive_class_registration.h"
 #include "impeller/archivist/archive_database.h"
@@ -42,9 +43,12 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  auto statement = registration->CreateInsertStatement();
+  auto statement = registration->TakeInsertStatement();
+  fml::ScopedCleanupClosure return_statement([&]() {
+    registration->ReturnInsertStatement(std::move(statement));
+  });
 
-  if (!statement.IsValid() || !statement.Reset()) {
+  if (!statement->IsValid() || !statement->Reset()) {
     /*
      *  Must be able to reset the statement for a new write
      */
@@ -59,14 +63,14 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
    *  for its members to be references. It does not manage the lifetimes of
    *  anything.
    */
-  ArchiveLocation item(*this, statement, *registration, primary_key);
+  ArchiveLocation item(*this, *statement, *registration, primary_key);
 
   /*
    *  If the item provides its own primary key, we need to bind it now.
    * Otherwise, one will be automatically assigned to it.
    */
   if (primary_key.has_value() &&
-      !statement.WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
+      !statement->WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
                             primary_key.value())) {
     return std::nullopt;
   }
@@ -75,7 +79,7 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  if (statement.Execute() != ArchiveStatement::Result::kDone) {
+  if (statement->Execute() != ArchiveStatement::Result::kDone) {
     return std::nullopt;
   }
 
@@ -95,6 +99,30 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
   return lastInsert;
 }
 
+size_t Archive::ArchiveInstances(
+    const std::vector<PendingInstance>& instances) {
+  if (!IsValid() || instances.empty()) {
+    return 0u;
+  }
+
+  /*
+   *  Transactions nest, and only the outermost one commits. So the whole batch
+   *  is committed at once instead of once per instance.
+   */
+  auto transaction = database_->CreateTransaction(transaction_count_);
+
+  size_t written = 0u;
+  for (const auto& [definition, archivable] : instances) {
+    if (ArchiveInstance(*definition, *archivable).has_value()) {
+      written++;
+    }
+  }
+
+  transaction.MarkWritesAsReadyForCommit();
+
+  return written;
+}
+
 bool Archive::UnarchiveInstance(const ArchiveDef& definition,
                                 PrimaryKey name,
                                 Archivable& archivable) {
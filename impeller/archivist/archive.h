@@ -9,6 +9,7 @@
 #include <optional>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -55,11 +56,19 @@ class Archive {
   int64_t transaction_count_ = 0;
 
   friend class ArchiveLocation;
+  friend class ArchiveWriter;
+
+  using PendingInstance = std::pair<const ArchiveDef*, const Archivable*>;
 
   std::optional<int64_t /* row id */> ArchiveInstance(
       const ArchiveDef& definition,
       const Archivable& archivable);
 
+  // Writes the instances in a single transaction and returns the number that
+  // were written. The instances that fail to write may leave the rows of the
+  // archivables they nest behind.
+  size_t ArchiveInstances(const std::vector<PendingInstance>& instances);
+
   bool UnarchiveInstance(const ArchiveDef& definition,
                          PrimaryKey name,
                          Archivable& archivable);
@@ -121,4 +121,21 @@ ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
   return database_.CreateStatement(stream.str());
 }
 
+std::unique_ptr<ArchiveStatement>
+ArchiveClassRegistration::TakeInsertStatement() const {
+  if (insert_statements_.empty()) {
+    return std::make_unique<ArchiveStatement>(CreateInsertStatement());
+  }
+  auto statement = std::move(insert_statements_.back());
+  insert_statements_.pop_back();
+  return statement;
+}
+
+void ArchiveClassRegistration::ReturnInsertStatement(
+    std::unique_ptr<ArchiveStatement> statement) const {
+  if (statement && statement->IsValid()) {
+    insert_statements_.push_back(std::move(statement));
+  }
+}
+
 }  // namespace impeller
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/archivist/archive.h"
@@ -27,6 +29,16 @@ class ArchiveClassRegistration {
 
   ArchiveStatement CreateInsertStatement() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes a prepared insert statement for the class. Since
+  ///             statements are expensive to create, they are kept for the
+  ///             writes that follow once given back with
+  ///             `ReturnInsertStatement`.
+  ///
+  std::unique_ptr<ArchiveStatement> TakeInsertStatement() const;
+
+  void ReturnInsertStatement(std::unique_ptr<ArchiveStatement> statement) const;
+
   ArchiveStatement CreateQueryStatement(bool single) const;
 
  private:
@@ -42,6 +54,8 @@ class ArchiveClassRegistration {
   const ArchiveDef definition_;
   MemberColumnMap column_map_;
   bool is_valid_ = false;
+  // Nested writes of instances of the same class each take a statement.
+  mutable std::vector<std::unique_ptr<ArchiveStatement>> insert_statements_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ArchiveClassRegistration);
 };
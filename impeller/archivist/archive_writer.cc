@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/archivist/archive_writer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/archivist/archive.h"
+
+namespace impeller {
+
+ArchiveWriter::ArchiveWriter(const std::string& path, size_t max_batch_size)
+    : archive_(std::make_unique<Archive>(path)),
+      max_batch_size_(std::max<size_t>(max_batch_size, 1u)) {
+  // Start the thread once the members it uses are initialized.
+  writer_ = std::thread([&]() { Main(); });
+}
+
+ArchiveWriter::~ArchiveWriter() {
+  {
+    std::scoped_lock lock(pending_mutex_);
+    should_exit_ = true;
+  }
+  pending_cv_.notify_one();
+  writer_.join();
+}
+
+bool ArchiveWriter::IsValid() const {
+  return archive_->IsValid();
+}
+
+void ArchiveWriter::Enqueue(const ArchiveDef& definition,
+                            std::unique_ptr<const Archivable> archivable) {
+  if (!archivable) {
+    return;
+  }
+  {
+    std::scoped_lock lock(pending_mutex_);
+    pending_.push_back({&definition, std::move(archivable)});
+    enqueued_count_++;
+  }
+  pending_cv_.notify_one();
+}
+
+void ArchiveWriter::Flush() {
+  std::unique_lock lock(pending_mutex_);
+  const size_t enqueued_count = enqueued_count_;
+  written_cv_.wait(lock,
+                   [&]() { return processed_count_ >= enqueued_count; });
+}
+
+size_t ArchiveWriter::GetWrittenCount() const {
+  std::scoped_lock lock(pending_mutex_);
+  return written_count_;
+}
+
+void ArchiveWriter::Main() {
+  fml::Thread::SetCurrentThreadName(
+      fml::Thread::ThreadConfig{"io.flutter.impeller.archive_writer"});
+
+  while (true) {
+    std::vector<PendingWrite> batch;
+    {
+      std::unique_lock lock(pending_mutex_);
+      pending_cv_.wait(lock,
+                       [&]() { return !pending_.empty() || should_exit_; });
+      if (pending_.empty()) {
+        // Only exit once everything queued has been written.
+        return;
+      }
+      if (pending_.size() <= max_batch_size_) {
+        std::swap(batch, pending_);
+      } else {
+        auto end = pending_.begin() + max_batch_size_;
+        std::move(pending_.begin(), end, std::back_inserter(batch));
+        pending_.erase(pending_.begin(), end);
+      }
+    }
+
+    // Write without holding the lock so that callers never wait on the
+    // database.
+    size_t written = 0u;
+    {
+      TRACE_EVENT0("impeller", "ArchiveWriter::WriteBatch");
+      std::vector<Archive::PendingInstance> instances;
+      instances.reserve(batch.size());
+      for (const PendingWrite& write : batch) {
+        instances.emplace_back(write.definition, write.archivable.get());
+      }
+      written = archive_->ArchiveInstances(instances);
+    }
+    const size_t processed = batch.size();
+    batch.clear();
+
+    {
+      std::scoped_lock lock(pending_mutex_);
+      processed_count_ += processed;
+      written_count_ += written;
+    }
+    written_cv_.notify_all();
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/archivist/archivable.h"
+
+namespace impeller {
+
+class Archive;
+
+//------------------------------------------------------------------------------
+/// @brief      Writes archivables to an archive on a thread of its own, so
+///             that callers such as captures taken during real use of an app
+///             don't wait on the database.
+///
+///             Callers hand over snapshots that are written in the order they
+///             were given, in batches of up to `max_batch_size` per
+///             transaction. Committing a transaction is what makes writes to
+///             the archive slow, so batches are much cheaper than writing
+///             each archivable on its own, and get larger as writes come in
+///             faster than the writer can keep up.
+///
+class ArchiveWriter {
+ public:
+  static constexpr size_t kDefaultMaxBatchSize = 512u;
+
+  explicit ArchiveWriter(const std::string& path,
+                         size_t max_batch_size = kDefaultMaxBatchSize);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the remaining archivables before returning.
+  ///
+  ~ArchiveWriter();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Queues `archivable` to be written. Returns right away.
+  ///
+  template <class T,
+            class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
+  void Write(std::unique_ptr<T> archivable) {
+    Enqueue(T::kArchiveDefinition, std::move(archivable));
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits until the archivables queued so far have been written.
+  ///
+  void Flush();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of archivables that were written successfully.
+  ///
+  size_t GetWrittenCount() const;
+
+ private:
+  struct PendingWrite {
+    const ArchiveDef* definition;
+    std::unique_ptr<const Archivable> archivable;
+  };
+
+  std::unique_ptr<Archive> archive_;
+  const size_t max_batch_size_;
+  std::thread writer_;
+  mutable std::mutex pending_mutex_;
+  std::condition_variable pending_cv_;
+  std::condition_variable written_cv_;
+  std::vector<PendingWrite> pending_;
+  size_t enqueued_count_ = 0u;
+  size_t processed_count_ = 0u;
+  size_t written_count_ = 0u;
+  bool should_exit_ = false;
+
+  void Enqueue(const ArchiveDef& definition,
+               std::unique_ptr<const Archivable> archivable);
+
+  void Main();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ArchiveWriter);
+};
+
+}  // namespace impeller
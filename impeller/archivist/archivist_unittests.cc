@@ -9,6 +9,7 @@
 #include "flutter/testing/testing.h"
 #include "impeller/archivist/archive.h"
 #include "impeller/archivist/archive_location.h"
+#include "impeller/archivist/archive_writer.h"
 #include "impeller/archivist/archivist_fixture.h"
 
 // TODO(zanderso): https://github.com/flutter/flutter/issues/127701
@@ -199,6 +200,58 @@ TEST_F(ArchiveTest, CanReadWriteVectorOfArchivables) {
   ASSERT_TRUE(read_success);
 }
 
+TEST_F(ArchiveTest, WriterWritesQueuedArchivablesInBatches) {
+  size_t count = 100;
+
+  std::vector<PrimaryKey::value_type> keys;
+  std::vector<uint64_t> values;
+  {
+    ArchiveWriter writer(GetArchiveFileName(), /*max_batch_size=*/16u);
+    ASSERT_TRUE(writer.IsValid());
+    for (size_t i = 0; i < count; i++) {
+      auto sample = std::make_unique<Sample>(i + 1);
+      keys.push_back(sample->GetPrimaryKey().value());
+      values.push_back(sample->GetSomeData());
+      writer.Write(std::move(sample));
+    }
+    writer.Write(std::make_unique<SampleWithVector>());
+    writer.Flush();
+    ASSERT_EQ(writer.GetWrittenCount(), count + 1);
+  }
+
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+  for (size_t i = 0; i < count; i++) {
+    Sample sample;
+    ASSERT_TRUE(archive.Read(keys[i], sample));
+    ASSERT_EQ(values[i], sample.GetSomeData());
+  }
+  bool read_success = false;
+  ASSERT_EQ(
+      archive.Read<SampleWithVector>([&](ArchiveLocation& location) -> bool {
+        SampleWithVector other_sample_with_vector;
+        read_success = other_sample_with_vector.Read(location);
+        return true;
+      }),
+      1u);
+  ASSERT_TRUE(read_success);
+}
+
+TEST_F(ArchiveTest, WriterWritesRemainingArchivablesWhenDestroyed) {
+  PrimaryKey::value_type key;
+  {
+    ArchiveWriter writer(GetArchiveFileName());
+    auto sample = std::make_unique<Sample>(1234);
+    key = sample->GetPrimaryKey().value();
+    writer.Write(std::move(sample));
+  }
+
+  Archive archive(GetArchiveFileName().c_str());
+  Sample sample;
+  ASSERT_TRUE(archive.Read(key, sample));
+  ASSERT_EQ(sample.GetSomeData(), 1234u);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
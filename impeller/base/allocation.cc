@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstring>
 
+#include "flutter/fml/host_allocator.h"
 #include "flutter/fml/logging.h"
 #include "impeller/base/validation.h"
 
@@ -15,7 +16,7 @@ namespace impeller {
 Allocation::Allocation() = default;
 
 Allocation::~Allocation() {
-  ::free(buffer_);
+  fml::HostFree(buffer_, reserved_, fml::HostAllocationCategory::kImpeller);
 }
 
 uint8_t* Allocation::GetBuffer() const {
@@ -66,7 +67,8 @@ bool Allocation::Reserve(size_t reserved) {
     return true;
   }
 
-  auto new_allocation = ::realloc(buffer_, reserved);
+  auto new_allocation = fml::HostReallocate(
+      buffer_, reserved_, reserved, fml::HostAllocationCategory::kImpeller);
   if (!new_allocation) {
     // If new length is zero, a minimum non-zero sized allocation is returned.
     // So this check will not trip and this routine will indicate success as
@@ -2,7 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <array>
+#include <string>
+
 #include "flutter/testing/testing.h"
+#include "impeller/base/frame_arena.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/thread.h"
 
@@ -76,5 +80,61 @@ TEST(StringsTest, CanSPrintF) {
   ASSERT_EQ(SPrintF("%sx%.2f", "Hello", 12.122222), "Hellox12.12");
 }
 
+TEST(FrameArenaTest, AllocatesFromBlocks) {
+  FrameArena arena(1024u);
+  auto a = arena.MakeShared<int>(42);
+  auto b = arena.MakeShared<double>(3.5);
+  ASSERT_EQ(*a, 42);
+  ASSERT_EQ(*b, 3.5);
+  ASSERT_EQ(arena.GetBlockCount(), 1u);
+  ASSERT_GT(arena.GetAllocatedBytes(), sizeof(int) + sizeof(double));
+}
+
+TEST(FrameArenaTest, ResetReusesIdleBlocks) {
+  FrameArena arena(1024u);
+  for (int i = 0; i < 64; i++) {
+    arena.MakeShared<std::array<char, 64>>();
+  }
+  auto block_count = arena.GetBlockCount();
+  ASSERT_GT(block_count, 1u);
+  arena.Reset();
+  ASSERT_EQ(arena.GetAllocatedBytes(), 0u);
+  ASSERT_EQ(arena.GetBlockCount(), block_count);
+  for (int i = 0; i < 64; i++) {
+    arena.MakeShared<std::array<char, 64>>();
+  }
+  ASSERT_EQ(arena.GetBlockCount(), block_count);
+}
+
+TEST(FrameArenaTest, ObjectsOutliveReset) {
+  FrameArena arena(1024u);
+  auto retained = arena.MakeShared<std::string>("Hello, world!");
+  arena.Reset();
+  // The block holding |retained| is not reused while it is alive.
+  auto other = arena.MakeShared<std::string>("Goodbye");
+  ASSERT_EQ(arena.GetBlockCount(), 2u);
+  ASSERT_EQ(*retained, "Hello, world!");
+  ASSERT_EQ(*other, "Goodbye");
+}
+
+TEST(FrameArenaTest, ReusesBlocksOnceTheirObjectsAreGone) {
+  FrameArena arena(1024u);
+  // Each frame is reset while its objects are still alive, like a picture
+  // that is held until after it has been rendered, so the frames alternate
+  // between two blocks.
+  for (int frame = 0; frame < 4; frame++) {
+    auto contents = arena.MakeShared<std::array<char, 64>>();
+    arena.Reset();
+    ASSERT_EQ(arena.GetBlockCount(), frame == 0 ? 1u : 2u);
+  }
+}
+
+TEST(FrameArenaTest, OversizedAllocationsGetTheirOwnBlock) {
+  FrameArena arena(128u);
+  auto big = arena.MakeShared<std::array<char, 4096>>();
+  ASSERT_TRUE(big);
+  ASSERT_EQ(arena.GetBlockCount(), 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/base/frame_arena.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+FrameArena::Block::Block(size_t size)
+    : buffer_(static_cast<uint8_t*>(::operator new(size))), size_(size) {}
+
+FrameArena::Block::~Block() {
+  ::operator delete(buffer_);
+}
+
+void* FrameArena::Block::Allocate(size_t size, size_t alignment) {
+  const auto base = reinterpret_cast<uintptr_t>(buffer_);
+  const uintptr_t aligned =
+      (base + offset_ + alignment - 1u) & ~(uintptr_t{alignment} - 1u);
+  const size_t new_offset = (aligned - base) + size;
+  if (new_offset > size_) {
+    return nullptr;
+  }
+  offset_ = new_offset;
+  return reinterpret_cast<void*>(aligned);
+}
+
+bool FrameArena::Block::Contains(const void* ptr) const {
+  const auto* byte = static_cast<const uint8_t*>(ptr);
+  return byte >= buffer_ && byte < buffer_ + size_;
+}
+
+size_t FrameArena::Block::GetRemaining() const {
+  return size_ - offset_;
+}
+
+size_t FrameArena::Block::GetUsed() const {
+  return offset_;
+}
+
+void FrameArena::Block::Rewind() {
+  offset_ = 0u;
+}
+
+FrameArena::FrameArena(size_t block_size) : block_size_(block_size) {}
+
+FrameArena::~FrameArena() = default;
+
+std::shared_ptr<FrameArena::Block> FrameArena::AcquireBlock(size_t size) {
+  if (current_ && current_->GetRemaining() >= size) {
+    return current_;
+  }
+  if (current_) {
+    retired_bytes_ += current_->GetUsed();
+    full_.emplace_back(std::move(current_));
+  }
+  if (size <= block_size_ && !free_.empty()) {
+    current_ = std::move(free_.back());
+    free_.pop_back();
+  } else {
+    current_ = std::make_shared<Block>(std::max(size, block_size_));
+  }
+  return current_;
+}
+
+void FrameArena::Reset() {
+  if (current_) {
+    full_.emplace_back(std::move(current_));
+  }
+  std::vector<std::shared_ptr<Block>> in_use;
+  for (auto& block : full_) {
+    // Blocks referenced by live objects, such as the contents of a picture
+    // that is still held, are checked again by the next reset.
+    if (block.use_count() == 1) {
+      block->Rewind();
+      free_.emplace_back(std::move(block));
+    } else {
+      in_use.emplace_back(std::move(block));
+    }
+  }
+  full_ = std::move(in_use);
+  retired_bytes_ = 0u;
+}
+
+size_t FrameArena::GetAllocatedBytes() const {
+  return retired_bytes_ + (current_ ? current_->GetUsed() : 0u);
+}
+
+size_t FrameArena::GetBlockCount() const {
+  return full_.size() + free_.size() + (current_ ? 1u : 0u);
+}
+
+}  // namespace impeller
@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A linear allocator for objects that live for about one frame.
+///
+///             Objects created with |MakeShared| are placed, together with
+///             their shared_ptr control block, in a large block owned by the
+///             arena. Freeing them is a no-op. Each control block keeps a
+///             reference to the block it was allocated from, so objects that
+///             outlive the frame (for instance a retained Picture) stay
+///             valid. |Reset| rewinds the blocks that no longer have live
+///             objects and keeps the rest until a later |Reset| finds them
+///             idle, so the blocks of a frame are reused once its picture is
+///             gone.
+///
+///             The arena is not thread-safe and must only be used from the
+///             thread that records and renders the frame. Objects allocated
+///             from it may be released on any thread.
+///
+class FrameArena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64u * 1024u;
+
+  explicit FrameArena(size_t block_size = kDefaultBlockSize);
+
+  ~FrameArena();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocate and construct an object in the arena.
+  ///
+  template <class T, class... Args>
+  std::shared_ptr<T> MakeShared(Args&&... args) {
+    // The allocation rounds the control block and the object up together, so
+    // reserve generous headroom for the control block.
+    constexpr size_t kControlBlockHeadroom = 64u;
+    auto block = AcquireBlock(sizeof(T) + alignof(T) + kControlBlockHeadroom);
+    return std::allocate_shared<T>(Allocator<T>(std::move(block)),
+                                   std::forward<Args>(args)...);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start a new frame. Blocks without live objects are rewound and
+  ///             reused; blocks still referenced are not handed out again
+  ///             until their objects are gone.
+  ///
+  void Reset();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes handed out since the last |Reset|.
+  ///
+  size_t GetAllocatedBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of blocks currently owned by the arena.
+  ///
+  size_t GetBlockCount() const;
+
+ private:
+  class Block {
+   public:
+    explicit Block(size_t size);
+
+    ~Block();
+
+    void* Allocate(size_t size, size_t alignment);
+
+    bool Contains(const void* ptr) const;
+
+    size_t GetRemaining() const;
+
+    size_t GetUsed() const;
+
+    void Rewind();
+
+   private:
+    uint8_t* buffer_ = nullptr;
+    const size_t size_;
+    size_t offset_ = 0u;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Block);
+  };
+
+  template <class T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<Block> block)
+        : block_(std::move(block)) {}
+
+    template <class U>
+    Allocator(const Allocator<U>& other)  // NOLINT(google-explicit-constructor)
+        : block_(other.block_) {}
+
+    T* allocate(size_t count) {
+      void* result = block_->Allocate(sizeof(T) * count, alignof(T));
+      if (!result) {
+        result = ::operator new(sizeof(T) * count);
+      }
+      return static_cast<T*>(result);
+    }
+
+    void deallocate(T* ptr, size_t count) {
+      if (!block_->Contains(ptr)) {
+        ::operator delete(ptr);
+      }
+    }
+
+    template <class U>
+    bool operator==(const Allocator<U>& other) const {
+      return block_ == other.block_;
+    }
+
+    template <class U>
+    bool operator!=(const Allocator<U>& other) const {
+      return block_ != other.block_;
+    }
+
+   private:
+    template <class U>
+    friend class Allocator;
+
+    std::shared_ptr<Block> block_;
+  };
+
+  const size_t block_size_;
+  std::shared_ptr<Block> current_;
+  // Blocks that are full or were still in use at the last |Reset|.
+  std::vector<std::shared_ptr<Block>> full_;
+  std::vector<std::shared_ptr<Block>> free_;
+  size_t retired_bytes_ = 0u;
+
+  std::shared_ptr<Block> AcquireBlock(size_t size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameArena);
+};
+
+}  // namespace impeller
@@ -39,6 +39,17 @@ struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader {
   // The generator used to prepare these bindings. Metal generators may be used
   // by GLES backends but GLES generators are unsuitable for the metal backend.
   static constexpr std::string_view kGeneratorName = "{{get_generator_name()}}";
+{% if length(specialization_constants) > 0 %}
+
+  // ===========================================================================
+  // Specialization Constants ==================================================
+  // ===========================================================================
+  // The index of each constant in the values set on the pipeline descriptor.
+{% for constant in specialization_constants %}
+  static constexpr size_t kSpecializationConstant{{camel_case(constant.name)}} = {{constant.constant_id}}u; // default {{constant.default_value}}
+{% endfor %}
+{% endif %}
+  static constexpr size_t kSpecializationConstantCount = {{length(specialization_constants)}}u;
 {% if length(struct_definitions) > 0 %}
   // ===========================================================================
   // Struct Definitions ========================================================
@@ -231,23 +231,9 @@ static CompilerBackend CreateCompiler(const spirv_cross::ParsedIR& ir,
   return compiler;
 }
 
-Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
-                   const SourceOptions& source_options,
-                   Reflector::Options reflector_options)
-    : options_(source_options) {
-  if (!source_mapping || source_mapping->GetMapping() == nullptr) {
-    COMPILER_ERROR(error_stream_)
-        << "Could not read shader source or shader source was empty.";
-    return;
-  }
-
-  if (source_options.target_platform == TargetPlatform::kUnknown) {
-    COMPILER_ERROR(error_stream_) << "Target platform not specified.";
-    return;
-  }
-
-  SPIRVCompilerOptions spirv_options;
-
+bool Compiler::BuildSPIRVCompilerOptions(
+    SPIRVCompilerOptions& spirv_options,
+    std::vector<std::string>& included_file_names) {
   // Make sure reflection is as effective as possible. The generated shaders
   // will be processed later by backend specific compilers.
   spirv_options.generate_debug_info = true;
@@ -269,15 +255,15 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
       break;
     case SourceLanguage::kUnknown:
       COMPILER_ERROR(error_stream_) << "Source language invalid.";
-      return;
+      return false;
   }
 
-  switch (source_options.target_platform) {
+  switch (options_.target_platform) {
     case TargetPlatform::kMetalDesktop:
     case TargetPlatform::kMetalIOS: {
       SPIRVCompilerTargetEnv target;
 
-      if (source_options.use_half_textures) {
+      if (options_.use_half_textures) {
         target.env = shaderc_target_env::shaderc_target_env_opengl;
         target.version = shaderc_env_version::shaderc_env_version_opengl_4_5;
         target.spirv_version = shaderc_spirv_version::shaderc_spirv_version_1_0;
@@ -330,22 +316,44 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
     } break;
     case TargetPlatform::kUnknown:
       COMPILER_ERROR(error_stream_) << "Target platform invalid.";
-      return;
+      return false;
   }
 
   // Implicit definition that indicates that this compilation is for the device
   // (instead of the host).
   spirv_options.macro_definitions.push_back("IMPELLER_DEVICE");
-  for (const auto& define : source_options.defines) {
+  for (const auto& define : options_.defines) {
     spirv_options.macro_definitions.push_back(define);
   }
 
-  std::vector<std::string> included_file_names;
   spirv_options.includer = std::make_shared<Includer>(
       options_.working_directory, options_.include_dirs,
       [&included_file_names](auto included_name) {
         included_file_names.emplace_back(std::move(included_name));
       });
+  return true;
+}
+
+Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
+                   const SourceOptions& source_options,
+                   Reflector::Options reflector_options)
+    : options_(source_options) {
+  if (!source_mapping || source_mapping->GetMapping() == nullptr) {
+    COMPILER_ERROR(error_stream_)
+        << "Could not read shader source or shader source was empty.";
+    return;
+  }
+
+  if (source_options.target_platform == TargetPlatform::kUnknown) {
+    COMPILER_ERROR(error_stream_) << "Target platform not specified.";
+    return;
+  }
+
+  SPIRVCompilerOptions spirv_options;
+  std::vector<std::string> included_file_names;
+  if (!BuildSPIRVCompilerOptions(spirv_options, included_file_names)) {
+    return;
+  }
 
   // SPIRV Generation.
   SPIRVCompiler spv_compiler(source_options, source_mapping);
@@ -418,6 +426,25 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
 
 Compiler::~Compiler() = default;
 
+Compiler::Compiler(const SourceOptions& options) : options_(options) {}
+
+std::shared_ptr<fml::Mapping> Compiler::Preprocess(
+    const std::shared_ptr<const fml::Mapping>& source_mapping,
+    const SourceOptions& options,
+    std::stringstream& error_stream) {
+  Compiler compiler(options);
+  SPIRVCompilerOptions spirv_options;
+  std::vector<std::string> included_file_names;
+  if (!compiler.BuildSPIRVCompilerOptions(spirv_options,
+                                          included_file_names)) {
+    error_stream << compiler.GetErrorMessages();
+    return nullptr;
+  }
+  SPIRVCompiler spv_compiler(options, source_mapping);
+  return spv_compiler.Preprocess(error_stream,
+                                 spirv_options.BuildShadercOptions());
+}
+
 std::shared_ptr<fml::Mapping> Compiler::GetSPIRVAssembly() const {
   return spirv_assembly_;
 }
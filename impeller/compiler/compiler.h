@@ -29,6 +29,19 @@ class Compiler {
 
   ~Compiler();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Runs only the preprocessor on the source, with the includes
+  ///             and macros the compilation for `options` would use.
+  ///
+  ///             Two sources that preprocess to the same text compile to the
+  ///             same outputs, which makes the result usable as the key of a
+  ///             cache of outputs.
+  ///
+  static std::shared_ptr<fml::Mapping> Preprocess(
+      const std::shared_ptr<const fml::Mapping>& source_mapping,
+      const SourceOptions& options,
+      std::stringstream& error_stream);
+
   bool IsValid() const;
 
   std::shared_ptr<fml::Mapping> GetSPIRVAssembly() const;
@@ -53,6 +66,11 @@ class Compiler {
   std::vector<std::string> included_file_names_;
   bool is_valid_ = false;
 
+  explicit Compiler(const SourceOptions& options);
+
+  bool BuildSPIRVCompilerOptions(SPIRVCompilerOptions& spirv_options,
+                                 std::vector<std::string>& included_file_names);
+
   std::string GetSourcePrefix() const;
 
   std::string GetDependencyNames(const std::string& separator) const;
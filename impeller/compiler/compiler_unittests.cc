@@ -123,6 +123,28 @@ TEST_P(CompilerTest, UniformsHaveBindingAndSet) {
   ASSERT_EQ(vert_uniform_binding.binding, 17u);
 }
 
+TEST_P(CompilerTest, ReflectsSpecializationConstants) {
+  ASSERT_TRUE(CanCompileAndReflect("specialization_constants.frag",
+                                   SourceType::kFragmentShader));
+
+  auto json_fd = GetReflectionJson("specialization_constants.frag");
+  nlohmann::json shader_json = nlohmann::json::parse(json_fd->GetMapping());
+  const auto& constants = shader_json["specialization_constants"];
+  ASSERT_EQ(constants.size(), 2u);
+  ASSERT_EQ(constants[0]["name"].get<std::string>(), "supports_decal");
+  ASSERT_EQ(constants[0]["constant_id"].get<uint32_t>(), 0u);
+  ASSERT_EQ(constants[0]["default_value"].get<float>(), 1.0f);
+  ASSERT_EQ(constants[1]["name"].get<std::string>(), "scale");
+  ASSERT_EQ(constants[1]["constant_id"].get<uint32_t>(), 1u);
+  ASSERT_EQ(constants[1]["default_value"].get<float>(), 2.0f);
+}
+
+TEST_P(CompilerTest, MustFailDueToNonContiguousSpecializationConstantIDs) {
+  ScopedValidationDisable disable_validation;
+  ASSERT_FALSE(CanCompileAndReflect("specialization_constants_bad_id.frag",
+                                    SourceType::kFragmentShader));
+}
+
 #define INSTANTIATE_TARGET_PLATFORM_TEST_SUITE_P(suite_name)              \
   INSTANTIATE_TEST_SUITE_P(                                               \
       suite_name, CompilerTest,                                           \
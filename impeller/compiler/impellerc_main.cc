@@ -3,15 +3,20 @@
 // found in the LICENSE file.
 
 #include <filesystem>
+#include <memory>
+#include <sstream>
 #include <system_error>
+#include <vector>
 
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
 #include "impeller/base/strings.h"
 #include "impeller/compiler/compiler.h"
+#include "impeller/compiler/shader_cache.h"
 #include "impeller/compiler/source_options.h"
 #include "impeller/compiler/switches.h"
 #include "impeller/compiler/types.h"
@@ -36,6 +41,132 @@ static bool SetPermissiveAccess(const std::filesystem::path& p) {
   return true;
 }
 
+struct OutputFile {
+  // The name of the output in the shader cache.
+  std::string cache_name;
+  std::filesystem::path path;
+};
+
+static std::filesystem::path AbsolutePath(const std::string& path) {
+  return std::filesystem::absolute(std::filesystem::current_path() / path);
+}
+
+// The files written by a successful invocation with these switches.
+static std::vector<OutputFile> GetOutputFiles(const Switches& switches) {
+  std::vector<OutputFile> files = {
+      {"spirv", AbsolutePath(switches.spirv_file_name)},
+      {"sl", AbsolutePath(switches.sl_file_name)},
+  };
+  if (TargetPlatformNeedsReflection(switches.target_platform)) {
+    if (!switches.reflection_json_name.empty()) {
+      files.push_back({"json", AbsolutePath(switches.reflection_json_name)});
+    }
+    if (!switches.reflection_header_name.empty()) {
+      files.push_back({"h", AbsolutePath(switches.reflection_header_name)});
+    }
+    if (!switches.reflection_cc_name.empty()) {
+      files.push_back({"cc", AbsolutePath(switches.reflection_cc_name)});
+    }
+  }
+  if (!switches.depfile_path.empty()) {
+    files.push_back({"d", AbsolutePath(switches.depfile_path)});
+  }
+  return files;
+}
+
+// Opens the shader cache entry for this invocation. The key covers
+// everything the outputs depend on: the compiler itself, the arguments it
+// was called with and the sources after preprocessing, which is cheap next to
+// compiling them.
+static std::unique_ptr<ShaderCache> OpenShaderCache(
+    const fml::CommandLine& command_line,
+    const Switches& switches,
+    const std::shared_ptr<const fml::Mapping>& source_mapping,
+    const std::vector<SourceOptions>& source_options) {
+  auto executable_path = fml::paths::GetExecutablePath();
+  if (!executable_path.first) {
+    return nullptr;
+  }
+  std::shared_ptr<const fml::Mapping> executable =
+      fml::FileMapping::CreateReadOnly(executable_path.second);
+  if (!executable) {
+    return nullptr;
+  }
+
+  std::stringstream invocation;
+  invocation << Utf8FromPath(std::filesystem::current_path()) << '\n';
+  for (const auto& option : command_line.options()) {
+    invocation << option.name << '=' << option.value << '\n';
+  }
+  for (const auto& arg : command_line.positional_args()) {
+    invocation << arg << '\n';
+  }
+
+  std::vector<std::shared_ptr<const fml::Mapping>> inputs = {
+      executable, std::make_shared<fml::DataMapping>(invocation.str())};
+  for (const auto& options : source_options) {
+    std::stringstream errors;
+    auto preprocessed = Compiler::Preprocess(source_mapping, options, errors);
+    if (!preprocessed) {
+      // Let the compiler report the error.
+      return nullptr;
+    }
+    inputs.push_back(std::move(preprocessed));
+  }
+
+  auto directory = fml::OpenDirectory(switches.cache_directory.c_str(),
+                                      true,  // create if necessary
+                                      fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    std::cerr << "Could not open the shader cache directory "
+              << switches.cache_directory << std::endl;
+    return nullptr;
+  }
+  auto cache = std::make_unique<ShaderCache>(std::move(directory),
+                                             ShaderCache::MakeKey(inputs));
+  return cache->IsValid() ? std::move(cache) : nullptr;
+}
+
+// Writes the outputs stored in the cache, if all of them are there.
+static bool RestoreFromShaderCache(const ShaderCache& cache,
+                                   const Switches& switches) {
+  const auto files = GetOutputFiles(switches);
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  for (const auto& file : files) {
+    auto mapping = cache.Load(file.cache_name);
+    if (!mapping) {
+      return false;
+    }
+    mappings.push_back(std::move(mapping));
+  }
+  for (size_t i = 0; i < files.size(); i++) {
+    if (!fml::WriteAtomically(*switches.working_directory,
+                              Utf8FromPath(files[i].path).c_str(),
+                              *mappings[i])) {
+      return false;
+    }
+  }
+  // Tools that consume the runtime stage data expect the access mode to be
+  // 0644.
+  if (switches.iplr &&
+      !SetPermissiveAccess(AbsolutePath(switches.sl_file_name))) {
+    return false;
+  }
+  return true;
+}
+
+static void StoreInShaderCache(const ShaderCache& cache,
+                               const Switches& switches) {
+  for (const auto& file : GetOutputFiles(switches)) {
+    auto mapping = fml::FileMapping::CreateReadOnly(Utf8FromPath(file.path));
+    if (!mapping || !cache.Store(file.cache_name, *mapping)) {
+      std::cerr << "Could not store " << Utf8FromPath(file.path)
+                << " in the shader cache." << std::endl;
+      return;
+    }
+  }
+}
+
 bool Main(const fml::CommandLine& command_line) {
   fml::InstallCrashHandler();
   if (command_line.HasOption("help")) {
@@ -85,11 +216,27 @@ bool Main(const fml::CommandLine& command_line) {
   reflector_options.header_file_name = Utf8FromPath(
       std::filesystem::path{switches.reflection_header_name}.filename());
 
+  const bool bundles_sksl =
+      switches.iplr && TargetPlatformBundlesSkSL(switches.target_platform);
+  SourceOptions sksl_options = options;
+  sksl_options.target_platform = TargetPlatform::kSkSL;
+
+  std::unique_ptr<ShaderCache> shader_cache;
+  if (!switches.cache_directory.empty()) {
+    std::vector<SourceOptions> source_options = {options};
+    if (bundles_sksl) {
+      source_options.push_back(sksl_options);
+    }
+    shader_cache = OpenShaderCache(command_line, switches,
+                                   source_file_mapping, source_options);
+    if (shader_cache && RestoreFromShaderCache(*shader_cache, switches)) {
+      return true;
+    }
+  }
+
   // Generate SkSL if needed.
   std::shared_ptr<fml::Mapping> sksl_mapping;
-  if (switches.iplr && TargetPlatformBundlesSkSL(switches.target_platform)) {
-    SourceOptions sksl_options = options;
-    sksl_options.target_platform = TargetPlatform::kSkSL;
+  if (bundles_sksl) {
 
     Reflector::Options sksl_reflector_options = reflector_options;
     sksl_reflector_options.target_platform = TargetPlatform::kSkSL;
@@ -238,6 +385,10 @@ bool Main(const fml::CommandLine& command_line) {
     }
   }
 
+  if (shader_cache) {
+    StoreInShaderCache(*shader_cache, switches);
+  }
+
   return true;
 }
 
@@ -6,6 +6,7 @@
 
 #include "impeller/compiler/reflector.h"
 
+#include <algorithm>
 #include <atomic>
 #include <optional>
 #include <set>
@@ -198,6 +199,13 @@ std::optional<nlohmann::json> Reflector::GenerateTemplateArguments() const {
     root["header_file_name"] = options_.header_file_name;
   }
 
+  if (auto constants = ReflectSpecializationConstants();
+      constants.has_value()) {
+    root["specialization_constants"] = std::move(constants.value());
+  } else {
+    return std::nullopt;
+  }
+
   const auto shader_resources = compiler_->get_shader_resources();
 
   // Uniform and storage buffers.
@@ -518,6 +526,41 @@ std::optional<nlohmann::json::array_t> Reflector::ReflectResources(
   return result;
 }
 
+std::optional<nlohmann::json::array_t>
+Reflector::ReflectSpecializationConstants() const {
+  auto constants = compiler_->get_specialization_constants();
+  std::sort(constants.begin(), constants.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.constant_id < rhs.constant_id;
+            });
+  nlohmann::json::array_t result;
+  for (size_t i = 0; i < constants.size(); i++) {
+    const auto& constant = compiler_->get_constant(constants[i].id);
+    const auto& name = compiler_->get_name(constants[i].id);
+    // The runtime passes the values of the constants of a pipeline as a list
+    // of floats whose index is the constant ID.
+    if (constants[i].constant_id != i) {
+      VALIDATION_LOG << "Specialization constant " << name << " has ID "
+                     << constants[i].constant_id << " but expected " << i
+                     << ". The IDs of specialization constants must start at "
+                        "zero and be contiguous.";
+      return std::nullopt;
+    }
+    const auto& type = compiler_->get_type(constant.constant_type);
+    if (type.basetype != spirv_cross::SPIRType::BaseType::Float ||
+        type.vecsize != 1 || type.columns != 1) {
+      VALIDATION_LOG << "Specialization constant " << name
+                     << " must be a float.";
+      return std::nullopt;
+    }
+    auto& item = result.emplace_back(nlohmann::json::object_t{});
+    item["name"] = name;
+    item["constant_id"] = constants[i].constant_id;
+    item["default_value"] = constant.scalar_f32();
+  }
+  return result;
+}
+
 static std::string TypeNameWithPaddingOfSize(size_t size) {
   std::stringstream stream;
   stream << "Padding<" << size << ">";
@@ -123,6 +123,9 @@ class Reflector {
   std::vector<size_t> ComputeOffsets(
       const spirv_cross::SmallVector<spirv_cross::Resource>& resources) const;
 
+  std::optional<nlohmann::json::array_t> ReflectSpecializationConstants()
+      const;
+
   std::optional<nlohmann::json::object_t> ReflectType(
       const spirv_cross::TypeID& type_id) const;
 
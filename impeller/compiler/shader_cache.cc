@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/compiler/shader_cache.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+
+namespace impeller {
+namespace compiler {
+
+// FNV-1a. Two differently seeded hashes make accidental collisions between
+// the handful of shaders in a build directory practically impossible.
+static uint64_t HashBytes(uint64_t hash, const uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+std::string ShaderCache::MakeKey(
+    const std::vector<std::shared_ptr<const fml::Mapping>>& inputs) {
+  uint64_t hashes[] = {0xcbf29ce484222325u, 0x84222325cbf29ce4u};
+  for (auto& hash : hashes) {
+    for (const auto& input : inputs) {
+      const uint64_t size = input ? input->GetSize() : 0u;
+      // Hash the size first so that the boundaries between inputs matter.
+      hash = HashBytes(hash, reinterpret_cast<const uint8_t*>(&size),
+                       sizeof(size));
+      if (size > 0u) {
+        hash = HashBytes(hash, input->GetMapping(), size);
+      }
+    }
+  }
+  std::stringstream stream;
+  for (auto hash : hashes) {
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+  }
+  return stream.str();
+}
+
+ShaderCache::ShaderCache(fml::UniqueFD directory, std::string key)
+    : directory_(std::move(directory)), key_(std::move(key)) {}
+
+ShaderCache::~ShaderCache() = default;
+
+bool ShaderCache::IsValid() const {
+  return directory_.is_valid() && !key_.empty();
+}
+
+std::string ShaderCache::GetFileName(const std::string& name) const {
+  return key_ + "." + name;
+}
+
+std::unique_ptr<fml::Mapping> ShaderCache::Load(const std::string& name) const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+  return fml::FileMapping::CreateReadOnly(directory_, GetFileName(name));
+}
+
+bool ShaderCache::Store(const std::string& name,
+                        const fml::Mapping& mapping) const {
+  if (!IsValid()) {
+    return false;
+  }
+  // Concurrent invocations may store the same outputs. Writing atomically
+  // means readers only ever see complete files.
+  return fml::WriteAtomically(directory_, GetFileName(name).c_str(), mapping);
+}
+
+}  // namespace compiler
+}  // namespace impeller
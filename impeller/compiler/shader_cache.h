@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace impeller {
+namespace compiler {
+
+//------------------------------------------------------------------------------
+/// @brief      A directory of impellerc outputs keyed by the inputs that
+///             produced them.
+///
+///             The key covers the compiler binary, the command line and the
+///             preprocessed sources. Touching a shader or one of its includes
+///             without changing what the compiler sees, or building the same
+///             shader in another output directory, reuses the earlier
+///             outputs instead of compiling again.
+///
+class ShaderCache {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a key naming the outputs produced by `inputs`.
+  ///
+  static std::string MakeKey(
+      const std::vector<std::shared_ptr<const fml::Mapping>>& inputs);
+
+  ShaderCache(fml::UniqueFD directory, std::string key);
+
+  ~ShaderCache();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the output called `name` stored for the key, or
+  ///             nullptr if there is none.
+  ///
+  std::unique_ptr<fml::Mapping> Load(const std::string& name) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores `mapping` as the output called `name` for the key.
+  ///
+  bool Store(const std::string& name, const fml::Mapping& mapping) const;
+
+ private:
+  const fml::UniqueFD directory_;
+  const std::string key_;
+
+  std::string GetFileName(const std::string& name) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShaderCache);
+};
+
+}  // namespace compiler
+}  // namespace impeller
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/compiler/shader_cache.h"
+
+namespace impeller {
+namespace compiler {
+namespace testing {
+
+static std::shared_ptr<const fml::Mapping> MakeMapping(
+    const std::string& contents) {
+  return std::make_shared<fml::DataMapping>(contents);
+}
+
+TEST(ShaderCacheTest, KeyDependsOnAllInputs) {
+  auto key = ShaderCache::MakeKey({MakeMapping("a"), MakeMapping("b")});
+  ASSERT_EQ(key, ShaderCache::MakeKey({MakeMapping("a"), MakeMapping("b")}));
+  ASSERT_NE(key, ShaderCache::MakeKey({MakeMapping("a"), MakeMapping("c")}));
+  ASSERT_NE(key, ShaderCache::MakeKey({MakeMapping("b"), MakeMapping("a")}));
+  // Moving bytes between inputs changes the key.
+  ASSERT_NE(key, ShaderCache::MakeKey({MakeMapping("ab"), MakeMapping("")}));
+}
+
+TEST(ShaderCacheTest, LoadsStoredOutputs) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto key = ShaderCache::MakeKey({MakeMapping("shader")});
+  ShaderCache cache(fml::Duplicate(temp_dir.fd().get()), key);
+  ASSERT_TRUE(cache.IsValid());
+  ASSERT_EQ(cache.Load("sl"), nullptr);
+
+  ASSERT_TRUE(cache.Store("sl", fml::DataMapping(std::string("contents"))));
+  auto loaded = cache.Load("sl");
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(loaded->GetMapping()),
+                        loaded->GetSize()),
+            "contents");
+
+  // Outputs of other invocations are not visible.
+  ShaderCache other_cache(fml::Duplicate(temp_dir.fd().get()),
+                          ShaderCache::MakeKey({MakeMapping("other")}));
+  ASSERT_EQ(other_cache.Load("sl"), nullptr);
+}
+
+}  // namespace testing
+}  // namespace compiler
+}  // namespace impeller
@@ -83,6 +83,50 @@ std::shared_ptr<fml::Mapping> SPIRVCompiler::CompileToSPV(
   );
 }
 
+std::shared_ptr<fml::Mapping> SPIRVCompiler::Preprocess(
+    std::stringstream& stream,
+    const shaderc::CompileOptions& spirv_options) const {
+  if (!sources_ || sources_->GetMapping() == nullptr) {
+    COMPILER_ERROR(stream) << "Invalid sources for SPIRV Compiler.";
+    return nullptr;
+  }
+
+  shaderc::Compiler spv_compiler;
+  if (!spv_compiler.IsValid()) {
+    COMPILER_ERROR(stream) << "Could not initialize the "
+                           << SourceLanguageToString(options_.source_language)
+                           << " preprocessor.";
+    return nullptr;
+  }
+
+  auto result = std::make_shared<shaderc::PreprocessedSourceCompilationResult>(
+      spv_compiler.PreprocessGlsl(
+          reinterpret_cast<const char*>(sources_->GetMapping()),  // source_text
+          sources_->GetSize(),                 // source_text_size
+          ToShaderCShaderKind(options_.type),  // shader_kind
+          options_.file_name.c_str(),          // input_file_name
+          spirv_options                        // options
+          ));
+  if (result->GetCompilationStatus() !=
+      shaderc_compilation_status::shaderc_compilation_status_success) {
+    COMPILER_ERROR(stream) << SourceLanguageToString(options_.source_language)
+                           << " preprocessing failed; "
+                           << ShaderCErrorToString(
+                                  result->GetCompilationStatus())
+                           << ". " << result->GetNumErrors() << " error(s).";
+    if (!result->GetErrorMessage().empty()) {
+      COMPILER_ERROR_NO_PREFIX(stream) << result->GetErrorMessage();
+    }
+    return nullptr;
+  }
+
+  return std::make_unique<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(result->cbegin()),  //
+      result->cend() - result->cbegin(),                   //
+      [result](auto, auto) {}                              //
+  );
+}
+
 std::string SPIRVCompiler::GetSourcePrefix() const {
   std::stringstream stream;
   stream << options_.file_name << ": ";
@@ -75,6 +75,9 @@ void Switches::PrintHelp(std::ostream& stream) {
   stream << "[optional] --use-half-textures (force openGL semantics when "
             "targeting metal)"
          << std::endl;
+  stream << "[optional] --cache-dir=<cache_directory> (reuse the outputs of "
+            "identical earlier invocations)"
+         << std::endl;
 }
 
 Switches::Switches() = default;
@@ -136,7 +139,9 @@ Switches::Switches(const fml::CommandLine& command_line)
           command_line.GetOptionValueWithDefault("metal-version", "1.2")),
       entry_point(
           command_line.GetOptionValueWithDefault("entry-point", "main")),
-      use_half_textures(command_line.HasOption("use-half-textures")) {
+      use_half_textures(command_line.HasOption("use-half-textures")),
+      cache_directory(
+          command_line.GetOptionValueWithDefault("cache-dir", "")) {
   auto language =
       command_line.GetOptionValueWithDefault("source-language", "glsl");
   std::transform(language.begin(), language.end(), language.begin(),
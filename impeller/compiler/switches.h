@@ -37,6 +37,7 @@ struct Switches {
   std::string metal_version = "";
   std::string entry_point = "";
   bool use_half_textures = false;
+  std::string cache_directory = "";
 
   Switches();
 
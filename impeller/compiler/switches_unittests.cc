@@ -69,6 +69,12 @@ TEST(SwitchesTest, EntryPointCanBeSetForHLSL) {
   ASSERT_EQ(switches.entry_point, "CustomEntryPoint");
 }
 
+TEST(SwitchesTest, CacheDirectoryIsOptional) {
+  ASSERT_EQ(MakeSwitchesDesktopGL().cache_directory, "");
+  ASSERT_EQ(MakeSwitchesDesktopGL({"--cache-dir=shader_cache"}).cache_directory,
+            "shader_cache");
+}
+
 TEST(SwitchesTEst, ConvertToEntrypointName) {
   ASSERT_EQ(ConvertToEntrypointName("mandelbrot_unrolled"),
             "mandelbrot_unrolled");
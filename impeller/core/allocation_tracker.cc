@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/allocation_tracker.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/texture_descriptor.h"
+
+namespace impeller {
+
+static constexpr size_t kKiloByteSizeInBytes = 1024u;
+
+AllocationTracker::AllocationTracker() = default;
+
+AllocationTracker::~AllocationTracker() = default;
+
+size_t AllocationTracker::EstimateByteSize(const TextureDescriptor& desc) {
+  size_t byte_size = 0u;
+  auto size = desc.size;
+  for (size_t mip = 0; mip < desc.mip_count; mip++) {
+    byte_size += BytesPerImageForPixelFormat(desc.format, size);
+    size = ISize(std::max<int64_t>(size.width / 2, 1),
+                 std::max<int64_t>(size.height / 2, 1));
+  }
+  byte_size *= static_cast<size_t>(desc.sample_count);
+  if (desc.type == TextureType::kTextureCube) {
+    byte_size *= 6u;
+  }
+  return byte_size;
+}
+
+void AllocationTracker::Add(AllocationTag tag, size_t bytes) {
+  Lock lock(mutex_);
+  for (auto* usage : {&usages_[static_cast<size_t>(tag)], &total_usage_}) {
+    usage->bytes += bytes;
+    usage->peak_bytes = std::max(usage->peak_bytes, usage->bytes);
+    usage->count++;
+  }
+  TraceUsage();
+}
+
+void AllocationTracker::Remove(AllocationTag tag, size_t bytes) {
+  Lock lock(mutex_);
+  for (auto* usage : {&usages_[static_cast<size_t>(tag)], &total_usage_}) {
+    FML_DCHECK(usage->bytes >= bytes && usage->count > 0u);
+    usage->bytes -= bytes;
+    usage->count--;
+  }
+  TraceUsage();
+}
+
+AllocationTracker::Usage AllocationTracker::GetUsage(AllocationTag tag) const {
+  Lock lock(mutex_);
+  return usages_[static_cast<size_t>(tag)];
+}
+
+AllocationTracker::Usage AllocationTracker::GetTotalUsage() const {
+  Lock lock(mutex_);
+  return total_usage_;
+}
+
+void AllocationTracker::TraceUsage() const {
+  const auto kilobytes = [this](AllocationTag tag) {
+    return usages_[static_cast<size_t>(tag)].bytes / kKiloByteSizeInBytes;
+  };
+  FML_TRACE_COUNTER("impeller",                                             //
+                    "DeviceMemory", reinterpret_cast<int64_t>(this),        //
+                    "UnknownKB", kilobytes(AllocationTag::kUnknown),        //
+                    "ImageKB", kilobytes(AllocationTag::kImage),            //
+                    "GlyphAtlasKB", kilobytes(AllocationTag::kGlyphAtlas),  //
+                    "OffscreenKB", kilobytes(AllocationTag::kOffscreen),    //
+                    "HostBufferKB", kilobytes(AllocationTag::kHostBuffer),  //
+                    "SceneKB", kilobytes(AllocationTag::kScene),            //
+                    "CompressedKB", kilobytes(AllocationTag::kCompressed));
+}
+
+}  // namespace impeller
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/formats.h"
+
+namespace impeller {
+
+struct TextureDescriptor;
+
+//------------------------------------------------------------------------------
+/// @brief      Running totals of the device memory created by an allocator,
+///             by the subsystem each allocation was tagged for.
+///
+///             An allocation is added when the allocator creates it and
+///             removed when the texture or buffer is destroyed, which may be
+///             after the allocator is gone. Every change is also reported to
+///             the timeline as a counter.
+///
+///             All methods are thread safe.
+///
+class AllocationTracker {
+ public:
+  struct Usage {
+    /// The size of the live allocations in bytes.
+    size_t bytes = 0u;
+    /// The largest `bytes` has been since the tracker was created.
+    size_t peak_bytes = 0u;
+    /// The number of live allocations.
+    size_t count = 0u;
+  };
+
+  AllocationTracker();
+
+  ~AllocationTracker();
+
+  //----------------------------------------------------------------------------
+  /// @brief      An estimate of the device memory used by a texture with
+  ///             this descriptor, including its mip levels and samples.
+  ///             Drivers may pad or compress the actual allocation.
+  ///
+  static size_t EstimateByteSize(const TextureDescriptor& desc);
+
+  void Add(AllocationTag tag, size_t bytes);
+
+  void Remove(AllocationTag tag, size_t bytes);
+
+  Usage GetUsage(AllocationTag tag) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The usage summed over all tags. Its peak is the largest
+  ///             the sum has been, which may be less than the sum of the
+  ///             peaks of each tag.
+  ///
+  Usage GetTotalUsage() const;
+
+ private:
+  mutable Mutex mutex_;
+  std::array<Usage, kAllocationTagCount> usages_ IPLR_GUARDED_BY(mutex_);
+  Usage total_usage_ IPLR_GUARDED_BY(mutex_);
+
+  void TraceUsage() const IPLR_REQUIRES(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AllocationTracker);
+};
+
+}  // namespace impeller
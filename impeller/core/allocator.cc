@@ -4,6 +4,7 @@
 
 #include "impeller/core/allocator.h"
 
+#include "flutter/fml/frame_cost_ledger.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
@@ -11,16 +12,19 @@
 
 namespace impeller {
 
-Allocator::Allocator() = default;
+Allocator::Allocator()
+    : allocation_tracker_(std::make_shared<AllocationTracker>()) {}
 
 Allocator::~Allocator() = default;
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
     const uint8_t* buffer,
-    size_t length) {
+    size_t length,
+    AllocationTag tag) {
   DeviceBufferDescriptor desc;
   desc.size = length;
   desc.storage_mode = StorageMode::kHostVisible;
+  desc.tag = tag;
   auto new_buffer = CreateBuffer(desc);
 
   if (!new_buffer) {
@@ -37,13 +41,21 @@ std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
 }
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
-    const fml::Mapping& mapping) {
-  return CreateBufferWithCopy(mapping.GetMapping(), mapping.GetSize());
+    const fml::Mapping& mapping,
+    AllocationTag tag) {
+  return CreateBufferWithCopy(mapping.GetMapping(), mapping.GetSize(), tag);
 }
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBuffer(
     const DeviceBufferDescriptor& desc) {
-  return OnCreateBuffer(desc);
+  auto buffer = OnCreateBuffer(desc);
+  if (!buffer) {
+    return nullptr;
+  }
+  const auto& buffer_desc = buffer->GetDeviceBufferDescriptor();
+  allocation_tracker_->Add(buffer_desc.tag, buffer_desc.size);
+  buffer->allocation_tracker_ = allocation_tracker_;
+  return buffer;
 }
 
 std::shared_ptr<Texture> Allocator::CreateTexture(
@@ -55,11 +67,27 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
     return nullptr;
   }
 
-  return OnCreateTexture(desc);
+  // Frames that create textures show up in their frame cost ledger, since
+  // those allocations could often be avoided by reusing textures.
+  fml::ScopedFrameCost cost(fml::FrameCostLedger::Category::kTextureAllocation);
+  auto texture = OnCreateTexture(desc);
+  if (!texture) {
+    return nullptr;
+  }
+  const auto& texture_desc = texture->GetTextureDescriptor();
+  texture->allocation_byte_size_ =
+      AllocationTracker::EstimateByteSize(texture_desc);
+  allocation_tracker_->Add(texture_desc.tag, texture->allocation_byte_size_);
+  texture->allocation_tracker_ = allocation_tracker_;
+  return texture;
 }
 
 void Allocator::DidAcquireSurfaceFrame() {}
 
+const AllocationTracker& Allocator::GetAllocationTracker() const {
+  return *allocation_tracker_;
+}
+
 uint16_t Allocator::MinimumBytesPerRow(PixelFormat format) const {
   return BytesPerPixelForPixelFormat(format);
 }
@@ -8,6 +8,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "impeller/core/allocation_tracker.h"
 #include "impeller/core/device_buffer_descriptor.h"
 #include "impeller/core/texture.h"
 #include "impeller/core/texture_descriptor.h"
@@ -39,11 +40,14 @@ class Allocator {
   ///
   virtual uint16_t MinimumBytesPerRow(PixelFormat format) const;
 
-  std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(const uint8_t* buffer,
-                                                     size_t length);
+  std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(
+      const uint8_t* buffer,
+      size_t length,
+      AllocationTag tag = AllocationTag::kUnknown);
 
   std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(
-      const fml::Mapping& mapping);
+      const fml::Mapping& mapping,
+      AllocationTag tag = AllocationTag::kUnknown);
 
   virtual ISize GetMaxTextureSizeSupported() const = 0;
 
@@ -51,6 +55,12 @@ class Allocator {
   /// allocation pools.
   virtual void DidAcquireSurfaceFrame();
 
+  //------------------------------------------------------------------------------
+  /// @brief      The device memory used by the live textures and buffers
+  ///             created by this allocator, by the tag of their descriptors.
+  ///
+  const AllocationTracker& GetAllocationTracker() const;
+
  protected:
   Allocator();
 
@@ -61,6 +71,9 @@ class Allocator {
       const TextureDescriptor& desc) = 0;
 
  private:
+  // Shared with the allocations, which may outlive the allocator.
+  const std::shared_ptr<AllocationTracker> allocation_tracker_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Allocator);
 };
 
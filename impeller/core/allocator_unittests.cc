@@ -5,6 +5,7 @@
 #include <memory>
 #include "flutter/testing/testing.h"
 #include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/geometry/size.h"
@@ -79,5 +80,85 @@ TEST(AllocatorTest, TextureDescriptorCompatibility) {
   }
 }
 
+TEST(AllocatorTest, TextureDescriptorByteSizeOfCompressedFormats) {
+  TextureDescriptor desc = {.format = PixelFormat::kASTC4x4UNormInt,
+                            .size = ISize(64, 32)};
+  ASSERT_EQ(desc.GetBytesPerRow(), 16u * 16u);
+  ASSERT_EQ(desc.GetByteSizeOfBaseMipLevel(), 16u * 8u * 16u);
+
+  // Partial blocks at the edges still take up a whole block.
+  desc.size = ISize(65, 30);
+  ASSERT_EQ(desc.GetBytesPerRow(), 17u * 16u);
+  ASSERT_EQ(desc.GetByteSizeOfBaseMipLevel(), 17u * 8u * 16u);
+
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  ASSERT_EQ(desc.GetBytesPerRow(), 65u * 4u);
+  ASSERT_EQ(desc.GetByteSizeOfBaseMipLevel(), 65u * 30u * 4u);
+}
+
+class TrackedTestAllocator : public Allocator {
+ public:
+  TrackedTestAllocator() = default;
+
+  ~TrackedTestAllocator() = default;
+
+  ISize GetMaxTextureSizeSupported() const override {
+    return ISize(1024, 1024);
+  };
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return std::make_shared<MockDeviceBuffer>(desc);
+  };
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return std::make_shared<MockTexture>(desc);
+  };
+};
+
+TEST(AllocatorTest, TracksAllocationsByTag) {
+  TrackedTestAllocator allocator;
+  const auto& tracker = allocator.GetAllocationTracker();
+
+  TextureDescriptor texture_desc = {.format = PixelFormat::kR8G8B8A8UNormInt,
+                                    .size = ISize(16, 16),
+                                    .tag = AllocationTag::kImage};
+  auto first = allocator.CreateTexture(texture_desc);
+  auto second = allocator.CreateTexture(texture_desc);
+  DeviceBufferDescriptor buffer_desc = {.size = 100u,
+                                        .tag = AllocationTag::kHostBuffer};
+  auto buffer = allocator.CreateBuffer(buffer_desc);
+
+  EXPECT_EQ(tracker.GetUsage(AllocationTag::kImage).bytes, 2u * 1024u);
+  EXPECT_EQ(tracker.GetUsage(AllocationTag::kImage).count, 2u);
+  EXPECT_EQ(tracker.GetUsage(AllocationTag::kHostBuffer).bytes, 100u);
+  EXPECT_EQ(tracker.GetUsage(AllocationTag::kOffscreen).count, 0u);
+  EXPECT_EQ(tracker.GetTotalUsage().bytes, 2u * 1024u + 100u);
+
+  // Destroying an allocation keeps the high-water mark.
+  first.reset();
+  buffer.reset();
+  EXPECT_EQ(tracker.GetUsage(AllocationTag::kImage).bytes, 1024u);
+  EXPECT_EQ(tracker.GetUsage(AllocationTag::kImage).peak_bytes, 2u * 1024u);
+  EXPECT_EQ(tracker.GetUsage(AllocationTag::kHostBuffer).bytes, 0u);
+  EXPECT_EQ(tracker.GetTotalUsage().peak_bytes, 2u * 1024u + 100u);
+}
+
+TEST(AllocatorTest, EstimatesTextureByteSizes) {
+  TextureDescriptor desc = {.format = PixelFormat::kR8G8B8A8UNormInt,
+                            .size = ISize(4, 2)};
+  EXPECT_EQ(AllocationTracker::EstimateByteSize(desc), 32u);
+
+  // 4x2, 2x1 and 1x1.
+  desc.mip_count = 3u;
+  EXPECT_EQ(AllocationTracker::EstimateByteSize(desc), 44u);
+
+  desc.mip_count = 1u;
+  desc.type = TextureType::kTexture2DMultisample;
+  desc.sample_count = SampleCount::kCount4;
+  EXPECT_EQ(AllocationTracker::EstimateByteSize(desc), 128u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -102,6 +102,14 @@ Capture Capture::MakeInactive() {
   return Capture();
 }
 
+bool Capture::IsActive() const {
+#ifdef IMPELLER_ENABLE_CAPTURE
+  return active_;
+#else
+  return false;
+#endif
+}
+
 std::shared_ptr<CaptureElement> Capture::GetElement() const {
 #ifdef IMPELLER_ENABLE_CAPTURE
   return element_;
@@ -231,6 +231,8 @@ class Capture {
 
   static Capture MakeInactive();
 
+  bool IsActive() const;
+
   inline Capture CreateChild(const std::string& label) {
 #ifdef IMPELLER_ENABLE_CAPTURE
     if (!active_) {
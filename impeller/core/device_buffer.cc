@@ -4,11 +4,17 @@
 
 #include "impeller/core/device_buffer.h"
 
+#include "impeller/core/allocation_tracker.h"
+
 namespace impeller {
 
 DeviceBuffer::DeviceBuffer(DeviceBufferDescriptor desc) : desc_(desc) {}
 
-DeviceBuffer::~DeviceBuffer() = default;
+DeviceBuffer::~DeviceBuffer() {
+  if (allocation_tracker_) {
+    allocation_tracker_->Remove(desc_.tag, desc_.size);
+  }
+}
 
 // |Buffer|
 std::shared_ptr<const DeviceBuffer> DeviceBuffer::GetDeviceBuffer(
@@ -55,6 +55,12 @@ class DeviceBuffer : public Buffer,
                                 size_t offset) = 0;
 
  private:
+  // Set by the allocator that created the buffer, to be told when it is
+  // destroyed.
+  std::shared_ptr<AllocationTracker> allocation_tracker_;
+
+  friend class Allocator;
+
   FML_DISALLOW_COPY_AND_ASSIGN(DeviceBuffer);
 };
 
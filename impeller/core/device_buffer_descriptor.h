@@ -13,6 +13,7 @@ namespace impeller {
 struct DeviceBufferDescriptor {
   StorageMode storage_mode = StorageMode::kDeviceTransient;
   size_t size = 0u;
+  AllocationTag tag = AllocationTag::kUnknown;
 };
 
 }  // namespace impeller
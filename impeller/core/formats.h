@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -64,6 +65,49 @@ constexpr const char* StorageModeToString(StorageMode mode) {
   FML_UNREACHABLE();
 }
 
+//------------------------------------------------------------------------------
+/// @brief      The subsystem that a texture or buffer is allocated for, so
+///             that the allocator can account for the device memory used by
+///             each of them.
+///
+enum class AllocationTag {
+  kUnknown,
+  /// Decoded images and textures created from the framework.
+  kImage,
+  kGlyphAtlas,
+  /// Render targets of offscreen passes.
+  kOffscreen,
+  /// Buffers of the per-frame host buffer.
+  kHostBuffer,
+  /// Meshes, skins and textures of 3D scenes.
+  kScene,
+  /// Textures that were compressed at runtime once they stopped changing.
+  kCompressed,
+};
+
+constexpr size_t kAllocationTagCount =
+    static_cast<size_t>(AllocationTag::kCompressed) + 1;
+
+constexpr const char* AllocationTagToString(AllocationTag tag) {
+  switch (tag) {
+    case AllocationTag::kUnknown:
+      return "Unknown";
+    case AllocationTag::kImage:
+      return "Image";
+    case AllocationTag::kGlyphAtlas:
+      return "GlyphAtlas";
+    case AllocationTag::kOffscreen:
+      return "Offscreen";
+    case AllocationTag::kHostBuffer:
+      return "HostBuffer";
+    case AllocationTag::kScene:
+      return "Scene";
+    case AllocationTag::kCompressed:
+      return "Compressed";
+  }
+  FML_UNREACHABLE();
+}
+
 //------------------------------------------------------------------------------
 /// @brief      The Pixel formats supported by Impeller. The naming convention
 ///             denotes the usage of the component, the bit width of that
@@ -109,6 +153,13 @@ enum class PixelFormat {
   kS8UInt,
   kD24UnormS8Uint,
   kD32FloatS8UInt,
+  // Block compressed formats, which store 4x4 blocks of pixels in 16 bytes.
+  // Textures of these formats can only be sampled from and written to with
+  // blits, and only on devices that pass the
+  // `Capabilities.SupportsCompressedPixelFormat` check.
+  kETC2R8G8B8A8UNormInt,
+  kASTC4x4UNormInt,
+  kBC7UNormInt,
 };
 
 constexpr const char* PixelFormatToString(PixelFormat format) {
@@ -145,6 +196,12 @@ constexpr const char* PixelFormatToString(PixelFormat format) {
       return "D24UnormS8Uint";
     case PixelFormat::kD32FloatS8UInt:
       return "D32FloatS8UInt";
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return "ETC2R8G8B8A8UNormInt";
+    case PixelFormat::kASTC4x4UNormInt:
+      return "ASTC4x4UNormInt";
+    case PixelFormat::kBC7UNormInt:
+      return "BC7UNormInt";
   }
   FML_UNREACHABLE();
 }
@@ -422,10 +479,58 @@ constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
       return 8u;
     case PixelFormat::kR32G32B32A32Float:
       return 16u;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
+      // On average. Use |BytesPerRowForPixelFormat| and
+      // |BytesPerImageForPixelFormat| to size the blocks of these formats.
+      return 1u;
   }
   return 0u;
 }
 
+constexpr bool IsBlockCompressedPixelFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC7UNormInt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// @brief  The width and height in pixels of the blocks that |format| stores
+///         pixels in, which is one pixel for the uncompressed formats.
+constexpr int64_t BlockSizeForPixelFormat(PixelFormat format) {
+  return IsBlockCompressedPixelFormat(format) ? 4 : 1;
+}
+
+constexpr size_t BytesPerBlockForPixelFormat(PixelFormat format) {
+  return IsBlockCompressedPixelFormat(format)
+             ? 16u
+             : BytesPerPixelForPixelFormat(format);
+}
+
+/// @brief  The size of a tightly packed row of blocks that covers |width|
+///         pixels.
+constexpr size_t BytesPerRowForPixelFormat(PixelFormat format, int64_t width) {
+  const auto block_size = BlockSizeForPixelFormat(format);
+  const auto blocks =
+      (std::max<int64_t>(width, 0) + block_size - 1) / block_size;
+  return static_cast<size_t>(blocks) * BytesPerBlockForPixelFormat(format);
+}
+
+/// @brief  The size of the tightly packed rows of blocks that cover an image
+///         of |size| pixels.
+constexpr size_t BytesPerImageForPixelFormat(PixelFormat format, ISize size) {
+  const auto block_size = BlockSizeForPixelFormat(format);
+  const auto rows =
+      (std::max<int64_t>(size.height, 0) + block_size - 1) / block_size;
+  return static_cast<size_t>(rows) *
+         BytesPerRowForPixelFormat(format, size.width);
+}
+
 //------------------------------------------------------------------------------
 /// @brief      Describe the color attachment that will be used with this
 ///             pipeline.
@@ -77,8 +77,21 @@ std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
   if (generation_ == device_buffer_generation_) {
     return device_buffer_;
   }
-  auto new_buffer = allocator.CreateBufferWithCopy(GetBuffer(), GetLength());
+  RetainDeviceBuffer();
+  const auto length = GetLength();
+  auto new_buffer = TakeRetainedDeviceBuffer(length);
   if (!new_buffer) {
+    // Round up so that the buffer fits the contents of later frames too.
+    DeviceBufferDescriptor desc;
+    desc.size = Allocation::NextPowerOfTwoSize(length);
+    desc.storage_mode = StorageMode::kHostVisible;
+    desc.tag = AllocationTag::kHostBuffer;
+    new_buffer = allocator.CreateBuffer(desc);
+    if (!new_buffer) {
+      return nullptr;
+    }
+  }
+  if (!new_buffer->CopyHostBuffer(GetBuffer(), Range{0, length})) {
     return nullptr;
   }
   new_buffer->SetLabel(label_);
@@ -87,15 +100,47 @@ std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
   return device_buffer_;
 }
 
+void HostBuffer::RetainDeviceBuffer() const {
+  if (!device_buffer_) {
+    return;
+  }
+  if (retained_device_buffers_.size() == kMaxRetainedDeviceBuffers) {
+    retained_device_buffers_.erase(retained_device_buffers_.begin());
+  }
+  retained_device_buffers_.push_back(std::move(device_buffer_));
+  device_buffer_ = nullptr;
+}
+
+std::shared_ptr<DeviceBuffer> HostBuffer::TakeRetainedDeviceBuffer(
+    size_t length) const {
+  for (auto it = retained_device_buffers_.begin();
+       it != retained_device_buffers_.end(); ++it) {
+    if (it->use_count() == 1 &&
+        (*it)->GetDeviceBufferDescriptor().size >= length) {
+      auto buffer = std::move(*it);
+      retained_device_buffers_.erase(it);
+      return buffer;
+    }
+  }
+  return nullptr;
+}
+
 void HostBuffer::Reset() {
   generation_ += 1;
-  device_buffer_ = nullptr;
+  RetainDeviceBuffer();
   bool did_truncate = Truncate(0);
   FML_CHECK(did_truncate);
 }
 
 size_t HostBuffer::GetSize() const {
-  return GetReservedLength();
+  size_t size = GetReservedLength();
+  if (device_buffer_) {
+    size += device_buffer_->GetDeviceBufferDescriptor().size;
+  }
+  for (const auto& buffer : retained_device_buffers_) {
+    size += buffer->GetDeviceBufferDescriptor().size;
+  }
+  return size;
 }
 
 }  // namespace impeller
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/allocation.h"
@@ -114,15 +115,27 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
   //----------------------------------------------------------------------------
   /// @brief Resets the contents of the HostBuffer to nothing so it can be
   ///        reused.
+  ///
+  ///        The device buffer of the previous contents is kept, and the
+  ///        contents are uploaded into it again once the GPU is done with it.
   void Reset();
 
   //----------------------------------------------------------------------------
-  /// @brief Returns the size of the HostBuffer in memory in bytes.
+  /// @brief Returns the size of the HostBuffer in memory in bytes, including
+  ///        the device buffers it keeps for reuse.
   size_t GetSize() const;
 
+  /// The number of device buffers kept for reuse, one for each frame that can
+  /// be in flight.
+  static constexpr size_t kMaxRetainedDeviceBuffers = 3u;
+
  private:
   mutable std::shared_ptr<DeviceBuffer> device_buffer_;
   mutable size_t device_buffer_generation_ = 0u;
+  // The device buffers of earlier contents, oldest first. A backend holds on
+  // to a device buffer until the commands that read it are done, so one
+  // referenced only by this HostBuffer can be written again.
+  mutable std::vector<std::shared_ptr<DeviceBuffer>> retained_device_buffers_;
   size_t generation_ = 1u;
   std::string label_;
 
@@ -132,6 +145,10 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
 
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
+  void RetainDeviceBuffer() const;
+
+  std::shared_ptr<DeviceBuffer> TakeRetainedDeviceBuffer(size_t length) const;
+
   HostBuffer();
 
   FML_DISALLOW_COPY_AND_ASSIGN(HostBuffer);
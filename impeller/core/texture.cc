@@ -4,13 +4,19 @@
 
 #include "impeller/core/texture.h"
 
+#include "flutter/fml/frame_cost_ledger.h"
 #include "impeller/base/validation.h"
+#include "impeller/core/allocation_tracker.h"
 
 namespace impeller {
 
 Texture::Texture(TextureDescriptor desc) : desc_(desc) {}
 
-Texture::~Texture() = default;
+Texture::~Texture() {
+  if (allocation_tracker_) {
+    allocation_tracker_->Remove(desc_.tag, allocation_byte_size_);
+  }
+}
 
 bool Texture::SetContents(const uint8_t* contents,
                           size_t length,
@@ -20,6 +26,7 @@ bool Texture::SetContents(const uint8_t* contents,
     VALIDATION_LOG << "Invalid slice for texture.";
     return false;
   }
+  fml::ScopedFrameCost cost(fml::FrameCostLedger::Category::kTextureUpload);
   if (!OnSetContents(contents, length, slice)) {
     return false;
   }
@@ -38,6 +45,7 @@ bool Texture::SetContents(std::shared_ptr<const fml::Mapping> mapping,
   if (!mapping) {
     return false;
   }
+  fml::ScopedFrameCost cost(fml::FrameCostLedger::Category::kTextureUpload);
   if (!OnSetContents(std::move(mapping), slice)) {
     return false;
   }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string_view>
 
 #include "flutter/fml/macros.h"
@@ -14,6 +15,8 @@
 
 namespace impeller {
 
+class AllocationTracker;
+
 class Texture {
  public:
   virtual ~Texture();
@@ -65,6 +68,12 @@ class Texture {
       TextureCoordinateSystem::kRenderToTexture;
   const TextureDescriptor desc_;
   bool is_opaque_ = false;
+  // Set by the allocator that created the texture, to be told when it is
+  // destroyed.
+  std::shared_ptr<AllocationTracker> allocation_tracker_;
+  size_t allocation_byte_size_ = 0u;
+
+  friend class Allocator;
 
   bool IsSliceValid(size_t slice) const;
 
@@ -46,19 +46,22 @@ struct TextureDescriptor {
       static_cast<TextureUsageMask>(TextureUsage::kShaderRead);
   SampleCount sample_count = SampleCount::kCount1;
   CompressionType compression_type = CompressionType::kLossless;
+  /// Only used to account for the allocation. Textures with different tags
+  /// are otherwise interchangeable, so it doesn't take part in comparisons.
+  AllocationTag tag = AllocationTag::kUnknown;
 
   constexpr size_t GetByteSizeOfBaseMipLevel() const {
     if (!IsValid()) {
       return 0u;
     }
-    return size.Area() * BytesPerPixelForPixelFormat(format);
+    return BytesPerImageForPixelFormat(format, size);
   }
 
   constexpr size_t GetBytesPerRow() const {
     if (!IsValid()) {
       return 0u;
     }
-    return size.width * BytesPerPixelForPixelFormat(format);
+    return BytesPerRowForPixelFormat(format, size.width);
   }
 
   constexpr bool SamplingOptionsAreValid() const {
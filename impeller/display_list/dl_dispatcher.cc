@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/aiks/color_filter.h"
@@ -19,6 +20,7 @@
 #include "impeller/display_list/dl_image_impeller.h"
 #include "impeller/display_list/dl_vertices_geometry.h"
 #include "impeller/display_list/nine_patch_converter.h"
+#include "impeller/display_list/path_conversion_cache.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/entity/contents/conical_gradient_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
@@ -53,6 +55,10 @@ DlDispatcher::DlDispatcher(IRect cull_rect) : canvas_(cull_rect) {}
 
 DlDispatcher::~DlDispatcher() = default;
 
+void DlDispatcher::SetFrameArena(std::shared_ptr<FrameArena> frame_arena) {
+  canvas_.SetFrameArena(std::move(frame_arena));
+}
+
 static BlendMode ToBlendMode(flutter::DlBlendMode mode) {
   switch (mode) {
     case flutter::DlBlendMode::kClear:
@@ -824,7 +830,8 @@ void DlDispatcher::clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) {
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) {
-  canvas_.ClipPath(skia_conversions::ToPath(path), ToClipOperation(clip_op));
+  canvas_.ClipPath(*PathConversionCache::GetShared().Convert(path),
+                   ToClipOperation(clip_op));
 }
 
 // |flutter::DlOpReceiver|
@@ -909,7 +916,7 @@ void DlDispatcher::drawPath(const SkPath& path) {
     canvas_.DrawCircle(skia_conversions::ToPoint(oval.center()),
                        oval.width() * 0.5, paint_);
   } else {
-    canvas_.DrawPath(skia_conversions::ToPath(path), paint_);
+    canvas_.DrawPath(*PathConversionCache::GetShared().Convert(path), paint_);
   }
 }
 
@@ -967,7 +974,8 @@ void DlDispatcher::drawPoints(PointMode mode,
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawVertices(const flutter::DlVertices* vertices,
                                 flutter::DlBlendMode dl_mode) {
-  canvas_.DrawVertices(MakeVertices(vertices), ToBlendMode(dl_mode), paint_);
+  canvas_.DrawVertices(VerticesConversionCache::GetShared().Convert(vertices),
+                       ToBlendMode(dl_mode), paint_);
 }
 
 // |flutter::DlOpReceiver|
@@ -1006,11 +1014,26 @@ void DlDispatcher::drawImageRect(
     flutter::DlImageSampling sampling,
     bool render_with_attributes,
     SrcRectConstraint constraint = SrcRectConstraint::kFast) {
+  // Images made of planes are sampled directly when they are drawn whole and
+  // the paint doesn't need the opacity that only textures can apply.
+  const Paint& paint = render_with_attributes ? paint_ : Paint();
+  if (src == SkRect::Make(image->bounds()) && paint.color.alpha == 1.0) {
+    if (auto filter =
+            image->impeller_planar_filter(ToSamplerDescriptor(sampling))) {
+      canvas_.DrawFilterRect(std::move(filter),              // filter
+                             skia_conversions::ToRect(src),  // source rect
+                             skia_conversions::ToRect(dst),  // destination rect
+                             paint                           // paint
+      );
+      return;
+    }
+  }
+
   canvas_.DrawImageRect(
       std::make_shared<Image>(image->impeller_texture()),  // image
       skia_conversions::ToRect(src),                       // source rect
       skia_conversions::ToRect(dst),                       // destination rect
-      render_with_attributes ? paint_ : Paint(),           // paint
+      paint,                                               // paint
       ToSamplerDescriptor(sampling)                        // sampling
   );
 }
@@ -1089,14 +1112,14 @@ void DlDispatcher::drawDisplayList(
     auto cull_bounds = canvas_.GetCurrentLocalCullingBounds();
     if (cull_bounds.has_value()) {
       Rect cull_rect = cull_bounds.value();
-      display_list->Dispatch(
+      display_list->DispatchInline(
           *this, SkRect::MakeLTRB(cull_rect.GetLeft(), cull_rect.GetTop(),
                                   cull_rect.GetRight(), cull_rect.GetBottom()));
     } else {
-      display_list->Dispatch(*this);
+      display_list->DispatchInline(*this);
     }
   } else {
-    display_list->Dispatch(*this);
+    display_list->DispatchInline(*this);
   }
 
   // Restore all saved state back to what it was before we interpreted
@@ -1196,7 +1219,7 @@ void DlDispatcher::drawShadow(const SkPath& path,
     canvas_.DrawCircle(skia_conversions::ToPoint(oval.center()),
                        oval.width() * 0.5, paint);
   } else {
-    canvas_.DrawPath(skia_conversions::ToPath(path), paint);
+    canvas_.DrawPath(*PathConversionCache::GetShared().Convert(path), paint);
   }
 
   canvas_.Restore();
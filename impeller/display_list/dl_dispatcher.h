@@ -23,6 +23,12 @@ class DlDispatcher final : public flutter::DlOpReceiver {
 
   Picture EndRecordingAsPicture();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record contents into the given frame arena, usually the one
+  ///             owned by the |AiksContext| that will render the picture.
+  ///
+  void SetFrameArena(std::shared_ptr<FrameArena> frame_arena);
+
   // |flutter::DlOpReceiver|
   void setAntiAlias(bool aa) override;
 
@@ -0,0 +1,225 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <random>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_color_source.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/display_list/dl_tiled_dispatch.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr int kCanvasSize = 4096;
+
+/// A large static canvas along the lines of a map: many small scattered
+/// shapes recorded in no spatial order.
+sk_sp<flutter::DisplayList> CreateMapDisplayList(int count) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<SkScalar> pos(0, kCanvasSize - 64);
+  std::uniform_real_distribution<SkScalar> size(4, 64);
+
+  flutter::DisplayListBuilder builder(
+      SkRect::MakeWH(kCanvasSize, kCanvasSize), /*prepare_rtree=*/true);
+  flutter::DlPaint fill(flutter::DlColor::kBlue());
+  flutter::DlPaint stroke(flutter::DlColor::kRed());
+  stroke.setDrawStyle(flutter::DlDrawStyle::kStroke);
+  stroke.setStrokeWidth(2);
+  for (int i = 0; i < count; i++) {
+    SkRect rect = SkRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng));
+    switch (i % 3) {
+      case 0:
+        builder.DrawRect(rect, fill);
+        break;
+      case 1:
+        builder.DrawOval(rect, stroke);
+        break;
+      case 2:
+        builder.DrawPath(SkPath().moveTo(rect.fLeft, rect.fTop)
+                             .lineTo(rect.fRight, rect.fTop)
+                             .lineTo(rect.centerX(), rect.fBottom)
+                             .close(),
+                         stroke);
+        break;
+    }
+  }
+  return builder.Build();
+}
+
+constexpr int kSceneWidth = 1080;
+constexpr int kSceneHeight = 2400;
+
+/// A scrolling list of cards: clipped rounded rects with shadows and text
+/// sized placeholder bars.
+sk_sp<flutter::DisplayList> CreateCardListDisplayList() {
+  flutter::DisplayListBuilder builder(
+      SkRect::MakeWH(kSceneWidth, kSceneHeight));
+  flutter::DlPaint card(flutter::DlColor::kWhite());
+  flutter::DlPaint line(flutter::DlColor::kDarkGrey());
+  for (int i = 0; i < 20; i++) {
+    SkRect bounds = SkRect::MakeXYWH(32, 32 + i * 120, kSceneWidth - 64, 100);
+    SkRRect rrect = SkRRect::MakeRectXY(bounds, 16, 16);
+    builder.DrawShadow(SkPath().addRRect(rrect), flutter::DlColor::kBlack(),
+                       4, false, 2.625);
+    builder.DrawRRect(rrect, card);
+    builder.Save();
+    builder.ClipRRect(rrect, flutter::DlCanvas::ClipOp::kIntersect, true);
+    for (int j = 0; j < 3; j++) {
+      builder.DrawRect(SkRect::MakeXYWH(bounds.fLeft + 24,
+                                        bounds.fTop + 20 + j * 24,
+                                        bounds.width() - 48 - j * 120, 12),
+                       line);
+    }
+    builder.Restore();
+  }
+  return builder.Build();
+}
+
+/// Nested translucent and blurred layers, as used by dialogs and frosted
+/// app bars.
+sk_sp<flutter::DisplayList> CreateLayersDisplayList() {
+  flutter::DisplayListBuilder builder(
+      SkRect::MakeWH(kSceneWidth, kSceneHeight));
+  flutter::DlPaint fill(flutter::DlColor::kBlue());
+  flutter::DlPaint translucent;
+  translucent.setOpacity(0.5);
+  flutter::DlBlurImageFilter blur(8, 8, flutter::DlTileMode::kClamp);
+  flutter::DlPaint blurred;
+  blurred.setImageFilter(&blur);
+  for (int i = 0; i < 8; i++) {
+    SkRect bounds = SkRect::MakeXYWH(i * 40, i * 80, kSceneWidth - i * 80,
+                                     kSceneHeight - i * 160);
+    builder.SaveLayer(&bounds, i % 2 == 0 ? &translucent : &blurred);
+    builder.DrawRect(bounds.makeInset(20, 20), fill);
+    builder.DrawCircle(SkPoint::Make(bounds.centerX(), bounds.fTop + 60), 40,
+                       fill);
+  }
+  builder.RestoreToCount(1);
+  return builder.Build();
+}
+
+/// Full width bands filled with linear and radial gradients.
+sk_sp<flutter::DisplayList> CreateGradientsDisplayList() {
+  flutter::DisplayListBuilder builder(
+      SkRect::MakeWH(kSceneWidth, kSceneHeight));
+  const flutter::DlColor colors[] = {flutter::DlColor::kRed(),
+                                     flutter::DlColor::kGreen(),
+                                     flutter::DlColor::kBlue()};
+  const float stops[] = {0.0, 0.5, 1.0};
+  for (int i = 0; i < 24; i++) {
+    SkRect bounds = SkRect::MakeXYWH(0, i * 100, kSceneWidth, 100);
+    flutter::DlPaint paint;
+    if (i % 2 == 0) {
+      paint.setColorSource(flutter::DlColorSource::MakeLinear(
+          SkPoint::Make(bounds.fLeft, bounds.fTop),
+          SkPoint::Make(bounds.fRight, bounds.fBottom), 3, colors, stops,
+          flutter::DlTileMode::kClamp));
+    } else {
+      paint.setColorSource(flutter::DlColorSource::MakeRadial(
+          SkPoint::Make(bounds.centerX(), bounds.centerY()), 200, 3, colors,
+          stops, flutter::DlTileMode::kMirror));
+    }
+    builder.DrawRect(bounds, paint);
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+/// Dispatches a canned scene and reports the shape of the resulting entity
+/// tree, so that changes in how the dispatcher splits work show up next to
+/// its timings.
+static void BM_DispatchScene(benchmark::State& state,
+                             sk_sp<flutter::DisplayList> display_list) {
+  auto cull_rect = IRect::MakeXYWH(0, 0, kSceneWidth, kSceneHeight);
+
+  Picture picture;
+  while (state.KeepRunning()) {
+    DlDispatcher dispatcher(cull_rect);
+    display_list->Dispatch(dispatcher,
+                           SkIRect::MakeWH(kSceneWidth, kSceneHeight));
+    picture = dispatcher.EndRecordingAsPicture();
+    benchmark::DoNotOptimize(picture.pass.get());
+  }
+
+  size_t entity_count = 0u;
+  picture.pass->IterateAllEntities([&entity_count](const Entity&) {
+    entity_count++;
+    return true;
+  });
+  state.counters["Ops"] = display_list->op_count(true);
+  state.counters["Entities"] = entity_count;
+  state.counters["Elements"] = picture.pass->GetElementCount();
+  state.counters["SubpassDepth"] = picture.pass->GetSubpassesDepth();
+}
+
+static void BM_DispatchSerial(benchmark::State& state) {
+  auto display_list = CreateMapDisplayList(state.range(0));
+  auto cull_rect = IRect::MakeXYWH(0, 0, kCanvasSize, kCanvasSize);
+
+  while (state.KeepRunning()) {
+    DlDispatcher dispatcher(cull_rect);
+    display_list->Dispatch(dispatcher, SkIRect::MakeWH(kCanvasSize,
+                                                       kCanvasSize));
+    auto picture = dispatcher.EndRecordingAsPicture();
+    benchmark::DoNotOptimize(picture.pass.get());
+  }
+}
+
+static void BM_DispatchTiled(benchmark::State& state) {
+  auto display_list = CreateMapDisplayList(state.range(0));
+  auto cull_rect = IRect::MakeXYWH(0, 0, kCanvasSize, kCanvasSize);
+  auto loop = fml::ConcurrentMessageLoop::Create();
+
+  while (state.KeepRunning()) {
+    auto picture = DispatchDisplayListTiled(*display_list, cull_rect,
+                                            kDefaultDispatchTileSize,
+                                            loop->GetTaskRunner());
+    benchmark::DoNotOptimize(picture.pass.get());
+  }
+  state.counters["Workers"] = loop->GetWorkerCount();
+}
+
+static void BM_DispatchPartitioned(benchmark::State& state) {
+  auto display_list = CreateMapDisplayList(state.range(0));
+  auto cull_rect = IRect::MakeXYWH(0, 0, kCanvasSize, kCanvasSize);
+  auto loop = fml::ConcurrentMessageLoop::Create();
+
+  while (state.KeepRunning()) {
+    auto picture = DispatchDisplayListPartitioned(
+        *display_list, cull_rect, loop->GetWorkerCount(),
+        loop->GetTaskRunner());
+    benchmark::DoNotOptimize(picture.pass.get());
+  }
+  state.counters["Workers"] = loop->GetWorkerCount();
+}
+
+BENCHMARK(BM_DispatchSerial)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DispatchTiled)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DispatchPartitioned)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_DispatchScene, card_list, CreateCardListDisplayList())
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DispatchScene, layers, CreateLayersDisplayList())
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DispatchScene, gradients, CreateGradientsDisplayList())
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace impeller
@@ -26,27 +26,24 @@ sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
   if (!aiks_context || !y_texture || !uv_texture) {
     return nullptr;
   }
-  auto yuv_to_rgb_filter_contents = FilterContents::MakeYUVToRGBFilter(
-      std::move(y_texture), std::move(uv_texture), yuv_color_space);
-  impeller::Entity entity;
-  entity.SetBlendMode(impeller::BlendMode::kSource);
-  auto snapshot = yuv_to_rgb_filter_contents->RenderToSnapshot(
-      aiks_context->GetContentContext(),  // renderer
-      entity,                             // entity
-      std::nullopt,                       // coverage_limit
-      std::nullopt,                       // sampler_descriptor
-      true,                               // msaa_enabled
-      "MakeYUVToRGBFilter Snapshot");     // label
-  if (!snapshot.has_value()) {
-    return nullptr;
-  }
-  return impeller::DlImageImpeller::Make(snapshot->texture);
+  YUVPlanes yuv_planes = {
+      .aiks_context = aiks_context,
+      .y_texture = std::move(y_texture),
+      .uv_texture = std::move(uv_texture),
+      .yuv_color_space = yuv_color_space,
+  };
+  return sk_sp<DlImageImpeller>(
+      new DlImageImpeller(std::move(yuv_planes), OwningContext::kIO));
 }
 
 DlImageImpeller::DlImageImpeller(std::shared_ptr<Texture> texture,
                                  OwningContext owning_context)
     : texture_(std::move(texture)), owning_context_(owning_context) {}
 
+DlImageImpeller::DlImageImpeller(YUVPlanes yuv_planes,
+                                 OwningContext owning_context)
+    : yuv_planes_(std::move(yuv_planes)), owning_context_(owning_context) {}
+
 // |DlImage|
 DlImageImpeller::~DlImageImpeller() = default;
 
@@ -57,9 +54,38 @@ sk_sp<SkImage> DlImageImpeller::skia_image() const {
 
 // |DlImage|
 std::shared_ptr<impeller::Texture> DlImageImpeller::impeller_texture() const {
+  Lock lock(texture_mutex_);
+  if (texture_ || !yuv_planes_.has_value()) {
+    return texture_;
+  }
+
+  auto yuv_to_rgb_filter_contents = impeller_planar_filter({});
+  impeller::Entity entity;
+  entity.SetBlendMode(impeller::BlendMode::kSource);
+  auto snapshot = yuv_to_rgb_filter_contents->RenderToSnapshot(
+      yuv_planes_->aiks_context->GetContentContext(),  // renderer
+      entity,                                          // entity
+      std::nullopt,                                    // coverage_limit
+      std::nullopt,                                    // sampler_descriptor
+      true,                                            // msaa_enabled
+      "MakeYUVToRGBFilter Snapshot");                  // label
+  if (snapshot.has_value()) {
+    texture_ = snapshot->texture;
+  }
   return texture_;
 }
 
+// |DlImage|
+std::shared_ptr<FilterContents> DlImageImpeller::impeller_planar_filter(
+    const SamplerDescriptor& sampler) const {
+  if (!yuv_planes_.has_value()) {
+    return nullptr;
+  }
+  return FilterContents::MakeYUVToRGBFilter(
+      yuv_planes_->y_texture, yuv_planes_->uv_texture,
+      yuv_planes_->yuv_color_space, sampler);
+}
+
 // |DlImage|
 bool DlImageImpeller::isOpaque() const {
   // Impeller doesn't currently implement opaque alpha types.
@@ -80,6 +106,11 @@ bool DlImageImpeller::isUIThreadSafe() const {
 
 // |DlImage|
 SkISize DlImageImpeller::dimensions() const {
+  if (yuv_planes_.has_value()) {
+    const auto size = yuv_planes_->y_texture->GetSize();
+    return SkISize::Make(size.width, size.height);
+  }
+  Lock lock(texture_mutex_);
   const auto size = texture_ ? texture_->GetSize() : ISize{};
   return SkISize::Make(size.width, size.height);
 }
@@ -87,6 +118,13 @@ SkISize DlImageImpeller::dimensions() const {
 // |DlImage|
 size_t DlImageImpeller::GetApproximateByteSize() const {
   auto size = sizeof(*this);
+  if (yuv_planes_.has_value()) {
+    size += yuv_planes_->y_texture->GetTextureDescriptor()
+                .GetByteSizeOfBaseMipLevel() +
+            yuv_planes_->uv_texture->GetTextureDescriptor()
+                .GetByteSizeOfBaseMipLevel();
+  }
+  Lock lock(texture_mutex_);
   if (texture_) {
     size += texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
   }
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <optional>
+
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/core/texture.h"
+#include "impeller/geometry/color.h"
 
 namespace impeller {
 
@@ -18,6 +22,13 @@ class DlImageImpeller final : public flutter::DlImage {
       std::shared_ptr<Texture> texture,
       OwningContext owning_context = OwningContext::kIO);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes an image from the Y and UV planes of a video frame.
+  ///
+  ///             Drawing the image samples the planes directly. They are only
+  ///             converted into an RGBA texture, once, if the texture of the
+  ///             image is needed. The image must not outlive `aiks_context`.
+  ///
   static sk_sp<DlImageImpeller> MakeFromYUVTextures(
       AiksContext* aiks_context,
       std::shared_ptr<Texture> y_texture,
@@ -33,6 +44,10 @@ class DlImageImpeller final : public flutter::DlImage {
   // |DlImage|
   std::shared_ptr<impeller::Texture> impeller_texture() const override;
 
+  // |DlImage|
+  std::shared_ptr<FilterContents> impeller_planar_filter(
+      const SamplerDescriptor& sampler) const override;
+
   // |DlImage|
   bool isOpaque() const override;
 
@@ -52,12 +67,23 @@ class DlImageImpeller final : public flutter::DlImage {
   OwningContext owning_context() const override { return owning_context_; }
 
  private:
-  std::shared_ptr<Texture> texture_;
+  struct YUVPlanes {
+    AiksContext* aiks_context;
+    std::shared_ptr<Texture> y_texture;
+    std::shared_ptr<Texture> uv_texture;
+    YUVColorSpace yuv_color_space;
+  };
+
+  mutable Mutex texture_mutex_;
+  mutable std::shared_ptr<Texture> texture_ IPLR_GUARDED_BY(texture_mutex_);
+  const std::optional<YUVPlanes> yuv_planes_;
   OwningContext owning_context_;
 
   explicit DlImageImpeller(std::shared_ptr<Texture> texture,
                            OwningContext owning_context = OwningContext::kIO);
 
+  DlImageImpeller(YUVPlanes yuv_planes, OwningContext owning_context);
+
   FML_DISALLOW_COPY_AND_ASSIGN(DlImageImpeller);
 };
 
@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/dl_tiled_dispatch.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/display_list/dl_inline_dispatch.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/aiks/canvas.h"
+#include "impeller/display_list/dl_dispatcher.h"
+
+namespace impeller {
+
+static SkIRect ToSkIRect(const IRect& rect) {
+  return SkIRect::MakeLTRB(rect.GetLeft(), rect.GetTop(), rect.GetRight(),
+                           rect.GetBottom());
+}
+
+static Picture DispatchTile(const flutter::DisplayList& display_list,
+                            const IRect& tile) {
+  TRACE_EVENT0("impeller", "DispatchTile");
+  DlDispatcher dispatcher(tile);
+  // Draws that span several tiles are recorded by each of them, so every tile
+  // must only touch its own pixels.
+  dispatcher.save();
+  dispatcher.clipRect(SkRect::Make(ToSkIRect(tile)),
+                      flutter::DlCanvas::ClipOp::kIntersect, false);
+  display_list.DispatchInline(dispatcher, ToSkIRect(tile));
+  dispatcher.restore();
+  return dispatcher.EndRecordingAsPicture();
+}
+
+Picture DispatchDisplayListTiled(
+    const flutter::DisplayList& display_list,
+    IRect cull_rect,
+    ISize tile_size,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", "DispatchDisplayListTiled");
+  FML_DCHECK(!tile_size.IsEmpty());
+
+  std::vector<IRect> tiles;
+  if (display_list.has_rtree() && worker_task_runner && !tile_size.IsEmpty()) {
+    for (auto y = cull_rect.GetTop(); y < cull_rect.GetBottom();
+         y += tile_size.height) {
+      for (auto x = cull_rect.GetLeft(); x < cull_rect.GetRight();
+           x += tile_size.width) {
+        tiles.push_back(
+            IRect::MakeLTRB(x, y, std::min(x + tile_size.width,
+                                           cull_rect.GetRight()),
+                            std::min(y + tile_size.height,
+                                     cull_rect.GetBottom())));
+      }
+    }
+  }
+
+  if (tiles.size() <= 1) {
+    DlDispatcher dispatcher(cull_rect);
+    display_list.DispatchInline(dispatcher, ToSkIRect(cull_rect));
+    return dispatcher.EndRecordingAsPicture();
+  }
+
+  std::vector<Picture> pictures(tiles.size());
+  fml::CountDownLatch latch(tiles.size());
+  // The raster thread is blocked on the tiles.
+  for (size_t i = 0; i < tiles.size(); i++) {
+    worker_task_runner->PostHighPriorityTask(
+        [&display_list, &tile = tiles[i], &picture = pictures[i], &latch]() {
+          picture = DispatchTile(display_list, tile);
+          latch.CountDown();
+        });
+  }
+  latch.Wait();
+
+  Canvas canvas(cull_rect);
+  for (const auto& picture : pictures) {
+    canvas.DrawPicture(picture);
+  }
+  return canvas.EndRecordingAsPicture();
+}
+
+Picture DispatchDisplayListPartitioned(
+    const flutter::DisplayList& display_list,
+    IRect cull_rect,
+    size_t partition_count,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", "DispatchDisplayListPartitioned");
+  const SkRect sk_cull_rect = SkRect::Make(ToSkIRect(cull_rect));
+
+  std::vector<int> boundaries;
+  if (worker_task_runner) {
+    boundaries = display_list.GetDispatchPartitions(partition_count);
+  }
+
+  if (boundaries.size() <= 2) {
+    DlDispatcher dispatcher(cull_rect);
+    display_list.DispatchInline(dispatcher, sk_cull_rect);
+    return dispatcher.EndRecordingAsPicture();
+  }
+
+  std::vector<Picture> pictures(boundaries.size() - 1);
+  fml::CountDownLatch latch(pictures.size());
+  // The raster thread is blocked on the partitions.
+  for (size_t i = 0; i < pictures.size(); i++) {
+    worker_task_runner->PostHighPriorityTask(
+        [&display_list, cull_rect, &sk_cull_rect, start = boundaries[i],
+         end = boundaries[i + 1], &picture = pictures[i], &latch]() {
+          TRACE_EVENT0("impeller", "DispatchPartition");
+          DlDispatcher dispatcher(cull_rect);
+          display_list.DispatchInline(dispatcher, start, end, sk_cull_rect);
+          picture = dispatcher.EndRecordingAsPicture();
+          latch.CountDown();
+        });
+  }
+  latch.Wait();
+
+  Canvas canvas(cull_rect);
+  for (const auto& picture : pictures) {
+    canvas.DrawPicture(picture);
+  }
+  return canvas.EndRecordingAsPicture();
+}
+
+}  // namespace impeller
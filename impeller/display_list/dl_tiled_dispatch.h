@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "impeller/aiks/picture.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+static constexpr ISize kDefaultDispatchTileSize = {512, 512};
+
+//------------------------------------------------------------------------------
+/// @brief      Record a display list into a picture by splitting the cull rect
+///             into tiles that are dispatched concurrently on the worker task
+///             runner.
+///
+///             Every tile is culled with the rtree of the display list,
+///             clipped to its bounds and recorded by its own |DlDispatcher|.
+///             The tile pictures are then drawn into the returned picture in
+///             order. This pays off for large, mostly static display lists
+///             such as maps or document pages, where the cost of recording
+///             dominates.
+///
+///             Content that reads pixels outside of its own tile, such as
+///             backdrop filters or blurs applied to layers, is clipped at
+///             the tile edges and may render differently than with a serial
+///             dispatch. The tiles don't use a frame arena since the arena
+///             is not thread-safe.
+///
+///             Display lists without an rtree, cull rects that fit in a
+///             single tile, or a missing task runner fall back to a serial
+///             dispatch on the calling thread. The calling thread blocks
+///             until every tile is recorded, so it must not be one of the
+///             workers of |worker_task_runner|.
+///
+/// @param[in]  display_list        The display list to record.
+/// @param[in]  cull_rect           The area of the display list to record.
+/// @param[in]  tile_size           The size of each tile.
+/// @param[in]  worker_task_runner  The task runner the tiles are recorded on.
+///
+/// @return     The picture of the whole cull rect.
+///
+Picture DispatchDisplayListTiled(
+    const flutter::DisplayList& display_list,
+    IRect cull_rect,
+    ISize tile_size,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner);
+
+//------------------------------------------------------------------------------
+/// @brief      Record a display list into a picture by splitting its ops into
+///             consecutive partitions that are dispatched concurrently on the
+///             worker task runner.
+///
+///             Every partition is recorded by its own |DlDispatcher|, which
+///             first replays the attribute, transform and clip ops that come
+///             before the partition without drawing anything, and the
+///             partition pictures are then drawn into the returned picture in
+///             order. Partitions never split a saveLayer, so unlike
+///             |DispatchDisplayListTiled| the result is the same as a serial
+///             dispatch. This suits long lists whose ops cover the same area,
+///             such as map tiles with many overlapping features, where tiling
+///             would record most ops several times.
+///
+///             A list that can't be split or a missing task runner fall back
+///             to a serial dispatch on the calling thread. The calling thread
+///             blocks until every partition is recorded, so it must not be
+///             one of the workers of |worker_task_runner|.
+///
+/// @param[in]  display_list        The display list to record.
+/// @param[in]  cull_rect           The area of the display list to record.
+/// @param[in]  partition_count     The maximum number of partitions.
+/// @param[in]  worker_task_runner  The task runner the partitions are
+///                                 recorded on.
+///
+/// @return     The picture of the whole cull rect.
+///
+Picture DispatchDisplayListPartitioned(
+    const flutter::DisplayList& display_list,
+    IRect cull_rect,
+    size_t partition_count,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner);
+
+}  // namespace impeller
@@ -16,11 +16,14 @@
 #include "flutter/display_list/effects/dl_color_source.h"
 #include "flutter/display_list/effects/dl_image_filter.h"
 #include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/display_list/dl_image_impeller.h"
 #include "impeller/display_list/dl_playground.h"
+#include "impeller/display_list/dl_tiled_dispatch.h"
+#include "impeller/display_list/dl_vertices_geometry.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/geometry/constants.h"
@@ -917,6 +920,75 @@ TEST_P(DisplayListTest,
   EXPECT_TRUE(found);
 }
 
+TEST_P(DisplayListTest, TiledDispatchRecordsEachTileOnce) {
+  flutter::DisplayListBuilder builder(SkRect::MakeWH(1024, 1024),
+                                      /*prepare_rtree=*/true);
+  builder.DrawRect(SkRect::MakeXYWH(100, 100, 50, 50),
+                   flutter::DlPaint(flutter::DlColor::kRed()));
+  builder.DrawRect(SkRect::MakeXYWH(600, 600, 50, 50),
+                   flutter::DlPaint(flutter::DlColor::kBlue()));
+  // Spans all four tiles.
+  builder.DrawRect(SkRect::MakeXYWH(400, 400, 200, 200),
+                   flutter::DlPaint(flutter::DlColor::kGreen()));
+  auto display_list = builder.Build();
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto picture = DispatchDisplayListTiled(
+      *display_list, IRect::MakeXYWH(0, 0, 1024, 1024), ISize(512, 512),
+      loop->GetTaskRunner());
+
+  int red = 0;
+  int blue = 0;
+  int green = 0;
+  picture.pass->IterateAllEntities([&](Entity& entity) {
+    auto contents =
+        std::dynamic_pointer_cast<SolidColorContents>(entity.GetContents());
+    if (contents) {
+      red += contents->GetColor() == Color::Red();
+      blue += contents->GetColor() == Color::Blue();
+      green += contents->GetColor() == Color::Green();
+    }
+    return true;
+  });
+  EXPECT_EQ(red, 1);
+  EXPECT_EQ(blue, 1);
+  EXPECT_EQ(green, 4);
+}
+
+TEST_P(DisplayListTest, PartitionedDispatchRecordsEachOpOnceInOrder) {
+  flutter::DisplayListBuilder builder(SkRect::MakeWH(1024, 1024),
+                                      /*prepare_rtree=*/true);
+  const flutter::DlColor colors[] = {flutter::DlColor::kRed(),
+                                     flutter::DlColor::kGreen(),
+                                     flutter::DlColor::kBlue()};
+  for (int i = 0; i < 30; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i * 10, i * 10, 50, 50),
+                     flutter::DlPaint(colors[i % 3]));
+  }
+  auto display_list = builder.Build();
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto picture = DispatchDisplayListPartitioned(
+      *display_list, IRect::MakeXYWH(0, 0, 1024, 1024), 4,
+      loop->GetTaskRunner());
+
+  std::vector<Color> drawn_colors;
+  picture.pass->IterateAllEntities([&](Entity& entity) {
+    auto contents =
+        std::dynamic_pointer_cast<SolidColorContents>(entity.GetContents());
+    if (contents) {
+      drawn_colors.push_back(contents->GetColor());
+    }
+    return true;
+  });
+  const Color expected_colors[] = {Color::Red(), Color::Green(),
+                                   Color::Blue()};
+  ASSERT_EQ(drawn_colors.size(), 30u);
+  for (int i = 0; i < 30; i++) {
+    EXPECT_EQ(drawn_colors[i], expected_colors[i % 3]);
+  }
+}
+
 TEST_P(DisplayListTest, TransparentShadowProducesCorrectColor) {
   DlDispatcher dispatcher;
   dispatcher.save();
@@ -1372,6 +1444,37 @@ TEST_P(DisplayListTest, DrawVerticesSolidColorTrianglesWithoutIndices) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+TEST(VerticesConversionCacheTest, ReusesConversionsOfTheSameVertices) {
+  std::vector<SkPoint> positions = {SkPoint::Make(100, 300),
+                                    SkPoint::Make(200, 100),
+                                    SkPoint::Make(300, 300)};
+  auto make_vertices = [&positions]() {
+    return flutter::DlVertices::Make(flutter::DlVertexMode::kTriangles, 3,
+                                     positions.data(),
+                                     /*texture_coordinates=*/nullptr,
+                                     /*colors=*/nullptr);
+  };
+  auto vertices = make_vertices();
+
+  // Room for two entries of this size.
+  VerticesConversionCache cache(/*byte_budget=*/vertices->size() * 2);
+  auto geometry = cache.Convert(vertices.get());
+  ASSERT_EQ(cache.Convert(vertices.get()), geometry);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+
+  // Vertices with the same data are still different vertices.
+  auto other_vertices = make_vertices();
+  ASSERT_NE(cache.Convert(other_vertices.get()), geometry);
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+
+  // The least recently used entry is evicted first.
+  ASSERT_EQ(cache.Convert(vertices.get()), geometry);
+  auto third_vertices = make_vertices();
+  cache.Convert(third_vertices.get());
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_EQ(cache.Convert(vertices.get()), geometry);
+}
+
 TEST_P(DisplayListTest, DrawVerticesLinearGradientWithoutIndices) {
   std::vector<SkPoint> positions = {SkPoint::Make(100, 300),
                                     SkPoint::Make(200, 100),
@@ -5,6 +5,7 @@
 #include "impeller/display_list/dl_vertices_geometry.h"
 
 #include "display_list/dl_vertices.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/entity/geometry/vertices_geometry.h"
 #include "impeller/geometry/point.h"
@@ -62,4 +63,67 @@ std::shared_ptr<impeller::VerticesGeometry> MakeVertices(
       positions, indices, texture_coordinates, colors, bounds, mode);
 }
 
+// static
+VerticesConversionCache& VerticesConversionCache::GetShared() {
+  static VerticesConversionCache* cache = new VerticesConversionCache();
+  return *cache;
+}
+
+VerticesConversionCache::VerticesConversionCache(size_t byte_budget)
+    : byte_budget_(byte_budget) {}
+
+VerticesConversionCache::~VerticesConversionCache() = default;
+
+std::shared_ptr<VerticesGeometry> VerticesConversionCache::Convert(
+    const flutter::DlVertices* vertices) {
+  const uint32_t key = vertices->unique_id();
+  {
+    Lock lock(mutex_);
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      // Vertices that are drawn more than once are likely to be drawn every
+      // frame, and are worth keeping on the GPU.
+      found->second->geometry->SetReuseUploads(true);
+      return found->second->geometry;
+    }
+  }
+
+  TRACE_EVENT0("impeller", "VerticesConversionCache::Convert");
+  auto converted = MakeVertices(vertices);
+  const size_t byte_size = vertices->size();
+  if (byte_size > byte_budget_ / 2) {
+    return converted;
+  }
+
+  Lock lock(mutex_);
+  // Another thread may have converted the same vertices in the meantime.
+  if (index_.find(key) != index_.end()) {
+    return converted;
+  }
+  EvictToFit(byte_size);
+  entries_.push_front(Entry{
+      .key = key,
+      .geometry = converted,
+      .byte_size = byte_size,
+  });
+  index_[key] = entries_.begin();
+  byte_size_ += byte_size;
+  return converted;
+}
+
+size_t VerticesConversionCache::GetEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+void VerticesConversionCache::EvictToFit(size_t byte_size) {
+  while (!entries_.empty() && byte_size_ + byte_size > byte_budget_) {
+    const auto& oldest = entries_.back();
+    byte_size_ -= oldest.byte_size;
+    index_.erase(oldest.key);
+    entries_.pop_back();
+  }
+}
+
 }  // namespace impeller
@@ -4,8 +4,14 @@
 
 #pragma once
 
-#include "flutter/display_list/dl_vertices.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
 
+#include "flutter/display_list/dl_vertices.h"
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/entity/geometry/vertices_geometry.h"
 
 namespace impeller {
@@ -13,4 +19,63 @@ namespace impeller {
 std::shared_ptr<VerticesGeometry> MakeVertices(
     const flutter::DlVertices* vertices);
 
+//------------------------------------------------------------------------------
+/// @brief      A cache of DlVertices to VerticesGeometry conversions that
+///             lives across frames and display lists.
+///
+///             Display lists record a copy of the vertices they draw, which
+///             keeps the unique ID of the original, so a mesh that is drawn
+///             every frame is only converted once. Once the same geometry is
+///             drawn a second time, the content context it is drawn with
+///             keeps its uploaded buffers in device memory as well; the
+///             geometries held here only own host memory. The least recently
+///             used entries are evicted once the cache holds more bytes of
+///             vertex data than its budget.
+///
+///             All methods are thread safe.
+///
+class VerticesConversionCache {
+ public:
+  static constexpr size_t kDefaultByteBudget = 4u * 1024u * 1024u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache shared by every dispatcher in the process.
+  ///
+  static VerticesConversionCache& GetShared();
+
+  explicit VerticesConversionCache(size_t byte_budget = kDefaultByteBudget);
+
+  ~VerticesConversionCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Converts `vertices` with `MakeVertices`, reusing an earlier
+  ///             conversion of the same vertices if there is one.
+  ///
+  std::shared_ptr<VerticesGeometry> Convert(
+      const flutter::DlVertices* vertices);
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    uint32_t key = 0u;
+    std::shared_ptr<VerticesGeometry> geometry;
+    size_t byte_size = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t byte_budget_;
+  mutable Mutex mutex_;
+  size_t byte_size_ IPLR_GUARDED_BY(mutex_) = 0u;
+  // Ordered from the most to the least recently used.
+  EntryList entries_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<uint32_t, EntryList::iterator> index_
+      IPLR_GUARDED_BY(mutex_);
+
+  void EvictToFit(size_t byte_size) IPLR_REQUIRES(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VerticesConversionCache);
+};
+
 }  // namespace impeller
@@ -82,8 +82,8 @@ void NinePatchConverter::DrawNinePatch(const std::shared_ptr<Image>& image,
       auto dstX0 = hSlices[xi + 1];
       auto srcX1 = hSlices[xi + 2];
       auto dstX1 = hSlices[xi + 3];
-      // TODO(jonahwilliams): consider converting this into a single call to
-      // DrawImageAtlas.
+      // Consecutive image rects of the same image are batched by the canvas,
+      // so the slices are drawn with a single draw call.
       canvas->DrawImageRect(image, Rect::MakeLTRB(srcX0, srcY0, srcX1, srcY1),
                             Rect::MakeLTRB(dstX0, dstY0, dstX1, dstY1), *paint,
                             sampler);
@@ -15,7 +15,8 @@
 
 namespace impeller {
 
-// Converts a call to draw a nine patch image into a draw atlas call.
+// Converts a call to draw a nine patch image into a draw image rect call for
+// each of its slices, which the canvas batches into a single draw.
 class NinePatchConverter {
  public:
   NinePatchConverter();
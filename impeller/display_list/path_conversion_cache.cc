@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/path_conversion_cache.h"
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/display_list/skia_conversions.h"
+
+namespace impeller {
+
+// static
+PathConversionCache& PathConversionCache::GetShared() {
+  static PathConversionCache* cache = new PathConversionCache();
+  return *cache;
+}
+
+PathConversionCache::PathConversionCache(size_t point_budget)
+    : point_budget_(point_budget) {}
+
+PathConversionCache::~PathConversionCache() = default;
+
+std::shared_ptr<const Path> PathConversionCache::Convert(const SkPath& path) {
+  if (path.isVolatile()) {
+    return std::make_shared<const Path>(skia_conversions::ToPath(path));
+  }
+  const uint64_t key = (static_cast<uint64_t>(path.getGenerationID()) << 8) |
+                       static_cast<uint64_t>(path.getFillType());
+  {
+    Lock lock(mutex_);
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      return found->second->path;
+    }
+  }
+
+  TRACE_EVENT0("impeller", "PathConversionCache::Convert");
+  auto converted =
+      std::make_shared<const Path>(skia_conversions::ToPath(path));
+  const size_t point_count = path.countPoints();
+  if (point_count > point_budget_ / 2) {
+    return converted;
+  }
+
+  Lock lock(mutex_);
+  // Another thread may have converted the same path in the meantime.
+  if (index_.find(key) != index_.end()) {
+    return converted;
+  }
+  EvictToFit(point_count);
+  entries_.push_front(Entry{
+      .key = key,
+      .path = converted,
+      .point_count = point_count,
+  });
+  index_[key] = entries_.begin();
+  point_count_ += point_count;
+  return converted;
+}
+
+size_t PathConversionCache::GetEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+void PathConversionCache::EvictToFit(size_t point_count) {
+  while (!entries_.empty() && point_count_ + point_count > point_budget_) {
+    const auto& oldest = entries_.back();
+    point_count_ -= oldest.point_count;
+    index_.erase(oldest.key);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/geometry/path.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of SkPath to impeller::Path conversions that lives
+///             across frames and display lists.
+///
+///             The framework marks paths as volatile while it is still
+///             editing them, and clears the flag once they have stayed the
+///             same for a few frames. Only the conversions of paths that
+///             aren't volatile are cached, keyed on their generation ID and
+///             fill type, so that a path which is drawn every frame is only
+///             converted once per mutation. The least recently used entries
+///             are evicted once the cache holds more points than its budget.
+///
+///             All methods are thread safe.
+///
+class PathConversionCache {
+ public:
+  static constexpr size_t kDefaultPointBudget = 256u * 1024u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache shared by every dispatcher in the process.
+  ///
+  static PathConversionCache& GetShared();
+
+  explicit PathConversionCache(size_t point_budget = kDefaultPointBudget);
+
+  ~PathConversionCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Converts `path` with `skia_conversions::ToPath`, reusing an
+  ///             earlier conversion of the same path if there is one.
+  ///
+  ///             Cached conversions are shared with the caller instead of
+  ///             copied, and stay valid after they are evicted.
+  ///
+  std::shared_ptr<const Path> Convert(const SkPath& path);
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    uint64_t key = 0u;
+    std::shared_ptr<const Path> path;
+    size_t point_count = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t point_budget_;
+  mutable Mutex mutex_;
+  size_t point_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+  // Ordered from the most to the least recently used.
+  EntryList entries_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<uint64_t, EntryList::iterator> index_
+      IPLR_GUARDED_BY(mutex_);
+
+  void EvictToFit(size_t point_count) IPLR_REQUIRES(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PathConversionCache);
+};
+
+}  // namespace impeller
@@ -122,6 +122,11 @@ Path ToPath(const SkPath& path, Point shift) {
   builder.SetConvexity(path.isConvex() ? Convexity::kConvex
                                        : Convexity::kUnknown);
   builder.Shift(shift);
+  // Volatile paths are still being edited by the framework, and shifted paths
+  // no longer match their source. Neither is worth caching derived data for.
+  if (!path.isVolatile() && shift.IsZero()) {
+    builder.SetGenerationId(path.getGenerationID());
+  }
   auto sk_bounds = path.getBounds().makeOutset(shift.x, shift.y);
   builder.SetBounds(ToRect(sk_bounds));
   return builder.TakePath(fill_type);
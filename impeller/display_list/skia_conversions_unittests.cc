@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/testing/testing.h"
+#include "impeller/display_list/path_conversion_cache.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/geometry/scalar.h"
 
@@ -23,5 +24,65 @@ TEST(SkiaConversionsTest, ToColor) {
   ASSERT_TRUE(ScalarNearlyEqual(converted_color.blue, 0x20 * (1.0f / 255)));
 }
 
+TEST(SkiaConversionsTest, ToPathKeepsGenerationIdOfStablePaths) {
+  SkPath sk_path;
+  sk_path.moveTo(0, 0);
+  sk_path.lineTo(10, 0);
+  sk_path.lineTo(10, 10);
+  sk_path.close();
+
+  auto path = skia_conversions::ToPath(sk_path);
+  ASSERT_TRUE(path.GetGenerationId().has_value());
+  ASSERT_EQ(path.GetGenerationId().value(), sk_path.getGenerationID());
+
+  auto shifted = skia_conversions::ToPath(sk_path, Point(1, 1));
+  ASSERT_FALSE(shifted.GetGenerationId().has_value());
+
+  sk_path.setIsVolatile(true);
+  auto volatile_path = skia_conversions::ToPath(sk_path);
+  ASSERT_FALSE(volatile_path.GetGenerationId().has_value());
+}
+
+TEST(SkiaConversionsTest, PathConversionCacheOnlyKeepsStablePaths) {
+  PathConversionCache cache(/*point_budget=*/12u);
+  SkPath sk_path;
+  sk_path.moveTo(0, 0);
+  sk_path.lineTo(10, 0);
+  sk_path.lineTo(10, 10);
+  sk_path.close();
+
+  sk_path.setIsVolatile(true);
+  cache.Convert(sk_path);
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+
+  sk_path.setIsVolatile(false);
+  auto path = cache.Convert(sk_path);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_EQ(path->GetGenerationId().value(), sk_path.getGenerationID());
+
+  // A copy shares the generation ID, and so the cached conversion.
+  SkPath copy = sk_path;
+  ASSERT_EQ(cache.Convert(copy), path);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+
+  // Editing the path gives it a new generation ID. It now has five points,
+  // including the move that starts a new contour after the close.
+  sk_path.lineTo(5, 5);
+  auto edited = cache.Convert(sk_path);
+  ASSERT_EQ(edited->GetGenerationId().value(), sk_path.getGenerationID());
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+
+  // The least recently used entry is evicted once the points of all entries
+  // no longer fit in the budget.
+  SkPath other;
+  other.moveTo(0, 0);
+  other.lineTo(5, 0);
+  other.lineTo(5, 5);
+  other.lineTo(0, 5);
+  other.lineTo(0, 2);
+  cache.Convert(other);
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
 #include <optional>
 #include <unordered_map>
 #include <utility>
@@ -23,7 +24,6 @@
 #include "impeller/geometry/color.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
-#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
@@ -221,30 +221,44 @@ bool AtlasContents::Render(const ContentContext& renderer,
     using VS = PorterDuffBlendPipeline::VertexShader;
     using FS = PorterDuffBlendPipeline::FragmentShader;
 
-    VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-    vtx_builder.Reserve(texture_coords_.size() * 6);
+    if (texture_coords_.empty()) {
+      return true;
+    }
     const auto texture_size = texture_->GetSize();
     auto& host_buffer = pass.GetTransientsBuffer();
 
-    for (size_t i = 0; i < texture_coords_.size(); i++) {
-      auto sample_rect = texture_coords_[i];
-      auto matrix = transforms_[i];
-      auto transformed_points =
-          Rect::MakeSize(sample_rect.size).GetTransformedPoints(matrix);
-      auto color = colors_[i].Premultiply();
-      for (size_t j = 0; j < 6; j++) {
-        VS::PerVertexData data;
-        data.vertices = transformed_points[indices[j]];
-        data.texture_coords =
-            (sample_rect.origin + Point(sample_rect.size.width * width[j],
-                                        sample_rect.size.height * height[j])) /
-            texture_size;
-        data.color = color;
-        vtx_builder.AppendVertex(data);
-      }
-    }
-
-    auto vtx_buffer = vtx_builder.CreateVertexBuffer(host_buffer);
+    // The vertices are written straight into the transients buffer, as
+    // atlases commonly draw thousands of sprites and a staging copy of
+    // them would be as large as the buffer itself.
+    const size_t vertex_count = texture_coords_.size() * 6;
+    auto vertex_view = host_buffer.Emplace(
+        vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+        [&](uint8_t* contents) {
+          auto* vertices = reinterpret_cast<VS::PerVertexData*>(contents);
+          for (size_t i = 0; i < texture_coords_.size(); i++) {
+            const auto& sample_rect = texture_coords_[i];
+            auto transformed_points = Rect::MakeSize(sample_rect.size)
+                                          .GetTransformedPoints(transforms_[i]);
+            auto color = colors_[i].Premultiply();
+            for (size_t j = 0; j < 6; j++) {
+              VS::PerVertexData data;
+              data.vertices = transformed_points[indices[j]];
+              data.texture_coords =
+                  (sample_rect.origin +
+                   Point(sample_rect.size.width * width[j],
+                         sample_rect.size.height * height[j])) /
+                  texture_size;
+              data.color = color;
+              std::memcpy(vertices++, &data, sizeof(VS::PerVertexData));
+            }
+          }
+        });
+    VertexBuffer vtx_buffer = {
+        .vertex_buffer = vertex_view,
+        .index_buffer = {},
+        .vertex_count = vertex_count,
+        .index_type = IndexType::kNone,
+    };
 
     Command cmd;
     DEBUG_COMMAND_INFO(
@@ -373,50 +387,53 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
+  // The sprites are referenced rather than copied, as there can be many.
+  const std::vector<Rect>* texture_coords;
+  const std::vector<Matrix>* transforms;
   if (subatlas_) {
-    texture_coords = use_destination_ ? subatlas_->result_texture_coords
-                                      : subatlas_->sub_texture_coords;
-    transforms = use_destination_ ? subatlas_->result_transforms
-                                  : subatlas_->sub_transforms;
+    texture_coords = use_destination_ ? &subatlas_->result_texture_coords
+                                      : &subatlas_->sub_texture_coords;
+    transforms = use_destination_ ? &subatlas_->result_transforms
+                                  : &subatlas_->sub_transforms;
   } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
+    texture_coords = &parent_.GetTextureCoordinates();
+    transforms = &parent_.GetTransforms();
+  }
+
+  if (texture_coords->empty()) {
+    return true;
   }
 
   const Size texture_size(texture->GetSize());
-  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-  vertex_builder.Reserve(texture_coords.size() * 6);
   constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
   constexpr Scalar width[6] = {0, 1, 0, 1, 0, 1};
   constexpr Scalar height[6] = {0, 0, 1, 0, 1, 1};
-  for (size_t i = 0; i < texture_coords.size(); i++) {
-    auto sample_rect = texture_coords[i];
-    auto matrix = transforms[i];
-    auto transformed_points =
-        Rect::MakeSize(sample_rect.size).GetTransformedPoints(matrix);
-
-    for (size_t j = 0; j < 6; j++) {
-      VS::PerVertexData data;
-      data.position = transformed_points[indices[j]];
-      data.texture_coords =
-          (sample_rect.origin + Point(sample_rect.size.width * width[j],
-                                      sample_rect.size.height * height[j])) /
-          texture_size;
-      vertex_builder.AppendVertex(data);
-    }
-  }
-
-  if (!vertex_builder.HasVertices()) {
-    return true;
-  }
+  auto& host_buffer = pass.GetTransientsBuffer();
+  const size_t vertex_count = texture_coords->size() * 6;
+  auto vertex_view = host_buffer.Emplace(
+      vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+      [&](uint8_t* contents) {
+        auto* vertices = reinterpret_cast<VS::PerVertexData*>(contents);
+        for (size_t i = 0; i < texture_coords->size(); i++) {
+          const auto& sample_rect = (*texture_coords)[i];
+          auto transformed_points = Rect::MakeSize(sample_rect.size)
+                                        .GetTransformedPoints((*transforms)[i]);
+          for (size_t j = 0; j < 6; j++) {
+            VS::PerVertexData data;
+            data.position = transformed_points[indices[j]];
+            data.texture_coords =
+                (sample_rect.origin +
+                 Point(sample_rect.size.width * width[j],
+                       sample_rect.size.height * height[j])) /
+                texture_size;
+            std::memcpy(vertices++, &data, sizeof(VS::PerVertexData));
+          }
+        }
+      });
 
   Command cmd;
   DEBUG_COMMAND_INFO(cmd, "AtlasTexture");
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation();
@@ -426,7 +443,12 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   auto options = OptionsFromPassAndEntity(pass, entity);
   cmd.pipeline = renderer.GetTexturePipeline(options);
   cmd.stencil_reference = entity.GetStencilDepth();
-  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+  cmd.BindVertices({
+      .vertex_buffer = vertex_view,
+      .index_buffer = {},
+      .vertex_count = vertex_count,
+      .index_type = IndexType::kNone,
+  });
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
   FS::BindTextureSampler(cmd, texture,
                          renderer.GetContext()->GetSamplerLibrary()->GetSampler(
@@ -466,45 +488,46 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   using VS = GeometryColorPipeline::VertexShader;
   using FS = GeometryColorPipeline::FragmentShader;
 
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
-  std::vector<Color> colors;
+  const std::vector<Rect>* texture_coords;
+  const std::vector<Matrix>* transforms;
+  const std::vector<Color>* colors;
   if (subatlas_) {
-    texture_coords = subatlas_->sub_texture_coords;
-    colors = subatlas_->sub_colors;
-    transforms = subatlas_->sub_transforms;
+    texture_coords = &subatlas_->sub_texture_coords;
+    colors = &subatlas_->sub_colors;
+    transforms = &subatlas_->sub_transforms;
   } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
-    colors = parent_.GetColors();
+    texture_coords = &parent_.GetTextureCoordinates();
+    transforms = &parent_.GetTransforms();
+    colors = &parent_.GetColors();
   }
 
-  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-  vertex_builder.Reserve(texture_coords.size() * 6);
-  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
-  for (size_t i = 0; i < texture_coords.size(); i++) {
-    auto sample_rect = texture_coords[i];
-    auto matrix = transforms[i];
-    auto transformed_points =
-        Rect::MakeSize(sample_rect.size).GetTransformedPoints(matrix);
-
-    for (size_t j = 0; j < 6; j++) {
-      VS::PerVertexData data;
-      data.position = transformed_points[indices[j]];
-      data.color = colors[i].Premultiply();
-      vertex_builder.AppendVertex(data);
-    }
-  }
-
-  if (!vertex_builder.HasVertices()) {
+  if (texture_coords->empty()) {
     return true;
   }
 
+  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
+  auto& host_buffer = pass.GetTransientsBuffer();
+  const size_t vertex_count = texture_coords->size() * 6;
+  auto vertex_view = host_buffer.Emplace(
+      vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+      [&](uint8_t* contents) {
+        auto* vertices = reinterpret_cast<VS::PerVertexData*>(contents);
+        for (size_t i = 0; i < texture_coords->size(); i++) {
+          auto transformed_points =
+              Rect::MakeSize((*texture_coords)[i].size)
+                  .GetTransformedPoints((*transforms)[i]);
+          VS::PerVertexData data;
+          data.color = (*colors)[i].Premultiply();
+          for (size_t j = 0; j < 6; j++) {
+            data.position = transformed_points[indices[j]];
+            std::memcpy(vertices++, &data, sizeof(VS::PerVertexData));
+          }
+        }
+      });
+
   Command cmd;
   DEBUG_COMMAND_INFO(cmd, "AtlasColors");
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation();
@@ -516,7 +539,12 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   opts.blend_mode = BlendMode::kSourceOver;
   cmd.pipeline = renderer.GetGeometryColorPipeline(opts);
   cmd.stencil_reference = entity.GetStencilDepth();
-  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+  cmd.BindVertices({
+      .vertex_buffer = vertex_view,
+      .index_buffer = {},
+      .vertex_count = vertex_count,
+      .index_type = IndexType::kNone,
+  });
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
   FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
   return pass.AddCommand(std::move(cmd));
@@ -30,6 +30,11 @@ void ClipContents::SetClipOperation(Entity::ClipOperation clip_op) {
   clip_op_ = clip_op;
 }
 
+bool ClipContents::IsEquivalentTo(const ClipContents& other) const {
+  return clip_op_ == other.clip_op_ && geometry_ && other.geometry_ &&
+         geometry_->IsEquivalentTo(*other.geometry_);
+}
+
 std::optional<Rect> ClipContents::GetCoverage(const Entity& entity) const {
   return std::nullopt;
 };
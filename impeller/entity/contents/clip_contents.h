@@ -25,6 +25,12 @@ class ClipContents final : public Contents {
 
   void SetClipOperation(Entity::ClipOperation clip_op);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether `other` is known to apply the same clip when drawn
+  ///             with the same entity transformation.
+  ///
+  bool IsEquivalentTo(const ClipContents& other) const;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -47,6 +47,16 @@ std::optional<Rect> ColorSourceContents::GetCoverage(
   return geometry_->GetCoverage(entity.GetTransformation());
 };
 
+bool ColorSourceContents::IsOpaqueOver(const Entity& entity,
+                                       const Rect& rect) const {
+  return geometry_ && IsOpaque() &&
+         geometry_->CoversArea(entity.GetTransformation(), rect);
+}
+
+bool ColorSourceContents::MayWriteStencil() const {
+  return !geometry_ || geometry_->PreventsOverdraw();
+}
+
 bool ColorSourceContents::CanInheritOpacity(const Entity& entity) const {
   return true;
 }
@@ -95,6 +95,12 @@ class ColorSourceContents : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  bool IsOpaqueOver(const Entity& entity, const Rect& rect) const override;
+
+  // |Contents|
+  bool MayWriteStencil() const override;
+
   // |Contents|
   bool CanInheritOpacity(const Entity& entity) const override;
 
@@ -7,10 +7,15 @@
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/render_target_cache.h"
+#include "impeller/entity/gradient_texture_cache.h"
+#include "impeller/entity/tessellation_cache.h"
+#include "impeller/entity/vertices_upload_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_pass.h"
@@ -145,18 +150,29 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
 }
 
 template <typename PipelineT>
-static std::unique_ptr<PipelineT> CreateDefaultPipeline(
-    const Context& context) {
+std::unique_ptr<PipelineT> ContentContext::CreateDefaultPipeline(
+    const Context& context,
+    const std::vector<Scalar>& constants) {
   auto desc = PipelineT::Builder::MakeDefaultPipelineDescriptor(context);
   if (!desc.has_value()) {
     return nullptr;
   }
+  if (!constants.empty()) {
+    std::stringstream label;
+    label << desc->GetLabel() << " S";
+    for (const auto& constant : constants) {
+      label << " " << constant;
+    }
+    desc->SetLabel(label.str());
+    desc->SetSpecializationConstants(constants);
+  }
   // Apply default ContentContextOptions to the descriptor.
   const auto default_color_format =
       context.GetCapabilities()->GetDefaultColorFormat();
   ContentContextOptions{.sample_count = SampleCount::kCount4,
                         .color_attachment_pixel_format = default_color_format}
       .ApplyToPipelineDescriptor(*desc);
+  RegisterPrototype(*desc);
   return std::make_unique<PipelineT>(context, desc);
 }
 
@@ -167,6 +183,12 @@ ContentContext::ContentContext(
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
       tessellator_(std::make_shared<Tessellator>()),
+      tessellation_cache_(std::make_shared<TessellationCache>(
+          context_->GetResourceAllocator())),
+      gradient_texture_cache_(std::make_shared<GradientTextureCache>(
+          context_->GetResourceAllocator())),
+      vertices_upload_cache_(std::make_shared<VerticesUploadCache>(
+          context_->GetResourceAllocator())),
 #if IMPELLER_ENABLE_3D
       scene_context_(std::make_shared<scene::SceneContext>(context_)),
 #endif  // IMPELLER_ENABLE_3D
@@ -283,13 +305,15 @@ ContentContext::ContentContext(
   tiled_texture_pipelines_[default_options_] =
       CreateDefaultPipeline<TiledTexturePipeline>(*context_);
   gaussian_blur_alpha_decal_pipelines_[default_options_] =
-      CreateDefaultPipeline<GaussianBlurAlphaDecalPipeline>(*context_);
+      CreateDefaultPipeline<GaussianBlurAlphaPipeline>(*context_,
+                                                       {/*decal=*/1.0});
   gaussian_blur_alpha_nodecal_pipelines_[default_options_] =
-      CreateDefaultPipeline<GaussianBlurAlphaPipeline>(*context_);
+      CreateDefaultPipeline<GaussianBlurAlphaPipeline>(*context_,
+                                                       {/*decal=*/0.0});
   gaussian_blur_noalpha_decal_pipelines_[default_options_] =
-      CreateDefaultPipeline<GaussianBlurDecalPipeline>(*context_);
+      CreateDefaultPipeline<GaussianBlurPipeline>(*context_, {/*decal=*/1.0});
   gaussian_blur_noalpha_nodecal_pipelines_[default_options_] =
-      CreateDefaultPipeline<GaussianBlurPipeline>(*context_);
+      CreateDefaultPipeline<GaussianBlurPipeline>(*context_, {/*decal=*/0.0});
   border_mask_blur_pipelines_[default_options_] =
       CreateDefaultPipeline<BorderMaskBlurPipeline>(*context_);
   morphology_filter_pipelines_[default_options_] =
@@ -304,6 +328,8 @@ ContentContext::ContentContext(
       CreateDefaultPipeline<GlyphAtlasPipeline>(*context_);
   glyph_atlas_color_pipelines_[default_options_] =
       CreateDefaultPipeline<GlyphAtlasColorPipeline>(*context_);
+  glyph_atlas_sdf_pipelines_[default_options_] =
+      CreateDefaultPipeline<GlyphAtlasSdfPipeline>(*context_);
   geometry_color_pipelines_[default_options_] =
       CreateDefaultPipeline<GeometryColorPipeline>(*context_);
   yuv_to_rgb_filter_pipelines_[default_options_] =
@@ -327,6 +353,14 @@ ContentContext::ContentContext(
         UvComputeShaderPipeline::MakeDefaultPipelineDescriptor(*context_);
     uv_compute_pipelines_ =
         context_->GetPipelineLibrary()->GetPipeline(uv_pipeline_desc).Get();
+
+    auto polyline_stroke_pipeline_desc =
+        PolylineStrokeComputeShaderPipeline::MakeDefaultPipelineDescriptor(
+            *context_);
+    polyline_stroke_compute_pipelines_ =
+        context_->GetPipelineLibrary()
+            ->GetPipeline(polyline_stroke_pipeline_desc)
+            .Get();
   }
 
   /// Setup default clip pipeline.
@@ -350,6 +384,7 @@ ContentContext::ContentContext(
   }
   clip_pipeline_descriptor->SetColorAttachmentDescriptors(
       std::move(clip_color_attachments));
+  RegisterPrototype(*clip_pipeline_descriptor);
   clip_pipelines_[default_options_] =
       std::make_unique<ClipPipeline>(*context_, clip_pipeline_descriptor);
 
@@ -369,27 +404,30 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
     bool msaa_enabled) const {
   auto context = GetContext();
 
+  // Reduce PSO variants for Vulkan.
+#ifdef FML_OS_ANDROID
+  std::optional<RenderTarget::AttachmentConfig> stencil_attachment_config =
+      RenderTarget::kDefaultStencilAttachmentConfig;
+#else
+  std::optional<RenderTarget::AttachmentConfig> stencil_attachment_config =
+      std::nullopt;
+#endif  // FML_OS_ANDROID
+  const PixelFormat color_format =
+      GetDeviceCapabilities().GetDefaultOffscreenColorFormat();
+
   RenderTarget subpass_target;
-  if (context->GetCapabilities()->SupportsOffscreenMSAA() && msaa_enabled) {
+  if (ShouldUseOffscreenMSAA() && msaa_enabled) {
     subpass_target = RenderTarget::CreateOffscreenMSAA(
         *context, *GetRenderTargetCache(), texture_size,
         SPrintF("%s Offscreen", label.c_str()),
-        RenderTarget::kDefaultColorAttachmentConfigMSAA  //
-#ifndef FML_OS_ANDROID  // Reduce PSO variants for Vulkan.
-        ,
-        std::nullopt  // stencil_attachment_config
-#endif                // FML_OS_ANDROID
-    );
+        RenderTarget::kDefaultColorAttachmentConfigMSAA,
+        stencil_attachment_config, color_format);
   } else {
     subpass_target = RenderTarget::CreateOffscreen(
         *context, *GetRenderTargetCache(), texture_size,
         SPrintF("%s Offscreen", label.c_str()),
-        RenderTarget::kDefaultColorAttachmentConfig  //
-#ifndef FML_OS_ANDROID  // Reduce PSO variants for Vulkan.
-        ,
-        std::nullopt  // stencil_attachment_config
-#endif                // FML_OS_ANDROID
-    );
+        RenderTarget::kDefaultColorAttachmentConfig, stencil_attachment_config,
+        color_format);
   }
   auto subpass_texture = subpass_target.GetRenderTargetTexture();
   if (!subpass_texture) {
@@ -429,6 +467,29 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+std::shared_ptr<TessellationCache> ContentContext::GetTessellationCache()
+    const {
+  return tessellation_cache_;
+}
+
+std::shared_ptr<GradientTextureCache> ContentContext::GetGradientTextureCache()
+    const {
+  return gradient_texture_cache_;
+}
+
+std::shared_ptr<VerticesUploadCache> ContentContext::GetVerticesUploadCache()
+    const {
+  return vertices_upload_cache_;
+}
+
+void ContentContext::PurgeCaches() const {
+  TRACE_EVENT0("impeller", "ContentContext::PurgeCaches");
+  tessellation_cache_->Purge();
+  gradient_texture_cache_->Purge();
+  vertices_upload_cache_->Purge();
+  render_target_cache_->Purge();
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
@@ -441,4 +502,95 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetCoverageAntiAliasingEnabled(bool enabled) {
+  coverage_anti_aliasing_ = enabled;
+}
+
+bool ContentContext::IsCoverageAntiAliasingEnabled() const {
+  return coverage_anti_aliasing_;
+}
+
+bool ContentContext::ShouldUseOffscreenMSAA() const {
+  return context_->GetCapabilities()->SupportsOffscreenMSAA() &&
+         !coverage_anti_aliasing_;
+}
+
+void ContentContext::SetVariantCaptureEnabled(bool enabled) {
+  if (!enabled) {
+    captured_variants_.reset();
+  } else if (!captured_variants_) {
+    captured_variants_ = std::make_unique<PipelineVariantManifest>();
+  }
+}
+
+const PipelineVariantManifest* ContentContext::GetCapturedVariants() const {
+  return captured_variants_.get();
+}
+
+size_t ContentContext::PrecompileVariants(
+    const PipelineVariantManifest& manifest) {
+  if (!IsValid()) {
+    return 0u;
+  }
+  auto library = context_->GetPipelineLibrary();
+  size_t scheduled = 0u;
+  for (const auto& entry : manifest.GetEntries()) {
+    auto prototype = prototype_descriptors_.find(entry.pipeline_label);
+    if (prototype == prototype_descriptors_.end() ||
+        !prototype->second.has_value()) {
+      continue;
+    }
+    if (ContentContextOptions::Equal{}(entry.options, default_options_)) {
+      continue;
+    }
+    auto& variants = precompiled_variants_[entry.pipeline_label];
+    if (variants.find(entry.options) != variants.end()) {
+      continue;
+    }
+    PipelineDescriptor desc = prototype->second.value();
+    entry.options.ApplyToPipelineDescriptor(desc);
+    desc.SetLabel(
+        SPrintF("%s V#P%zu", desc.GetLabel().c_str(), variants.size()));
+    variants[entry.options] = library->GetPipeline(std::move(desc));
+    RecordVariant(entry.pipeline_label, entry.options);
+    scheduled++;
+  }
+  return scheduled;
+}
+
+void ContentContext::RegisterPrototype(const PipelineDescriptor& desc) {
+  auto found = prototype_descriptors_.find(desc.GetLabel());
+  if (found == prototype_descriptors_.end()) {
+    prototype_descriptors_[desc.GetLabel()] = desc;
+    return;
+  }
+  if (found->second.has_value() && !found->second->IsEqual(desc)) {
+    found->second.reset();
+  }
+}
+
+void ContentContext::RecordVariant(const std::string& prototype_label,
+                                   const ContentContextOptions& opts) const {
+  if (captured_variants_) {
+    captured_variants_->Record(prototype_label, opts);
+  }
+}
+
+std::optional<PipelineFuture<PipelineDescriptor>>
+ContentContext::TakePrecompiledVariant(
+    const std::string& prototype_label,
+    const ContentContextOptions& opts) const {
+  auto variants = precompiled_variants_.find(prototype_label);
+  if (variants == precompiled_variants_.end()) {
+    return std::nullopt;
+  }
+  auto found = variants->second.find(opts);
+  if (found == variants->second.end()) {
+    return std::nullopt;
+  }
+  auto future = std::move(found->second);
+  variants->second.erase(found);
+  return future;
+}
+
 }  // namespace impeller
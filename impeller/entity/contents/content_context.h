@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
 
 #include "flutter/fml/build_config.h"
@@ -37,6 +38,7 @@
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/glyph_atlas_color.frag.h"
+#include "impeller/entity/glyph_atlas_sdf.frag.h"
 #include "impeller/entity/gradient_fill.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
@@ -44,6 +46,7 @@
 #include "impeller/entity/morphology_filter.frag.h"
 #include "impeller/entity/morphology_filter.vert.h"
 #include "impeller/entity/points.comp.h"
+#include "impeller/entity/polyline_stroke.comp.h"
 #include "impeller/entity/porter_duff_blend.frag.h"
 #include "impeller/entity/porter_duff_blend.vert.h"
 #include "impeller/entity/radial_gradient_fill.frag.h"
@@ -63,10 +66,8 @@
 #include "impeller/entity/yuv_to_rgb_filter.vert.h"
 
 #include "impeller/entity/gaussian_blur.vert.h"
-#include "impeller/entity/gaussian_blur_alpha_decal.frag.h"
-#include "impeller/entity/gaussian_blur_alpha_nodecal.frag.h"
-#include "impeller/entity/gaussian_blur_noalpha_decal.frag.h"
-#include "impeller/entity/gaussian_blur_noalpha_nodecal.frag.h"
+#include "impeller/entity/gaussian_blur_alpha.frag.h"
+#include "impeller/entity/gaussian_blur_noalpha.frag.h"
 
 #include "impeller/entity/position_color.vert.h"
 
@@ -158,18 +159,13 @@ using PositionUVPipeline =
     RenderPipelineT<TextureFillVertexShader, TiledTextureFillFragmentShader>;
 using TiledTexturePipeline =
     RenderPipelineT<TextureFillVertexShader, TiledTextureFillFragmentShader>;
-using GaussianBlurAlphaDecalPipeline =
-    RenderPipelineT<GaussianBlurVertexShader,
-                    GaussianBlurAlphaDecalFragmentShader>;
+// The decal variants of the gaussian blur pipelines are specialized on the
+// `enable_decal_specialization` constant of the fragment shader.
 using GaussianBlurAlphaPipeline =
-    RenderPipelineT<GaussianBlurVertexShader,
-                    GaussianBlurAlphaNodecalFragmentShader>;
-using GaussianBlurDecalPipeline =
-    RenderPipelineT<GaussianBlurVertexShader,
-                    GaussianBlurNoalphaDecalFragmentShader>;
+    RenderPipelineT<GaussianBlurVertexShader, GaussianBlurAlphaFragmentShader>;
 using GaussianBlurPipeline =
     RenderPipelineT<GaussianBlurVertexShader,
-                    GaussianBlurNoalphaNodecalFragmentShader>;
+                    GaussianBlurNoalphaFragmentShader>;
 using BorderMaskBlurPipeline =
     RenderPipelineT<BorderMaskBlurVertexShader, BorderMaskBlurFragmentShader>;
 using MorphologyFilterPipeline =
@@ -188,6 +184,8 @@ using GlyphAtlasPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using GlyphAtlasColorPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasColorFragmentShader>;
+using GlyphAtlasSdfPipeline =
+    RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasSdfFragmentShader>;
 using PorterDuffBlendPipeline =
     RenderPipelineT<PorterDuffBlendVertexShader, PorterDuffBlendFragmentShader>;
 // Instead of requiring new shaders for clips, the solid fill stages are used
@@ -291,6 +289,8 @@ using FramebufferBlendSoftLightPipeline =
 /// Geometry Pipelines
 using PointsComputeShaderPipeline = ComputePipelineBuilder<PointsComputeShader>;
 using UvComputeShaderPipeline = ComputePipelineBuilder<UvComputeShader>;
+using PolylineStrokeComputeShaderPipeline =
+    ComputePipelineBuilder<PolylineStrokeComputeShader>;
 
 #ifdef IMPELLER_ENABLE_OPENGLES
 using TextureExternalPipeline =
@@ -345,7 +345,11 @@ struct ContentContextOptions {
 };
 
 class Tessellator;
+class GradientTextureCache;
+class TessellationCache;
 class RenderTargetCache;
+class VerticesUploadCache;
+class PipelineVariantManifest;
 
 class ContentContext {
  public:
@@ -363,6 +367,34 @@ class ContentContext {
 
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of path tessellations that are reused across
+  ///             frames.
+  ///
+  std::shared_ptr<TessellationCache> GetTessellationCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of gradient textures that are reused across
+  ///             frames.
+  ///
+  std::shared_ptr<GradientTextureCache> GetGradientTextureCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of the device buffers that vertices geometries are
+  ///             uploaded to when they are drawn in every frame.
+  ///
+  std::shared_ptr<VerticesUploadCache> GetVerticesUploadCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Release the resources that are cached across frames and can
+  ///             be recreated on demand: tessellations, gradient textures,
+  ///             vertices uploads and unused render target textures.
+  ///             Pipelines are kept.
+  ///
+  ///             Must be called between frames.
+  ///
+  void PurgeCaches() const;
+
 #ifdef IMPELLER_DEBUG
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetCheckerboardPipeline(
       ContentContextOptions opts) const {
@@ -375,28 +407,35 @@ class ContentContext {
     return GetPipeline(linear_gradient_fill_pipelines_, opts);
   }
 
+  // The SSBO gradient pipelines return `nullptr` instead of waiting for a
+  // variant that is still compiling when `wait` is false, so that the
+  // gradient can be drawn with the texture pipelines in the meantime.
   std::shared_ptr<Pipeline<PipelineDescriptor>>
-  GetLinearGradientSSBOFillPipeline(ContentContextOptions opts) const {
+  GetLinearGradientSSBOFillPipeline(ContentContextOptions opts,
+                                    bool wait = true) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
-    return GetPipeline(linear_gradient_ssbo_fill_pipelines_, opts);
+    return GetPipeline(linear_gradient_ssbo_fill_pipelines_, opts, wait);
   }
 
   std::shared_ptr<Pipeline<PipelineDescriptor>>
-  GetRadialGradientSSBOFillPipeline(ContentContextOptions opts) const {
+  GetRadialGradientSSBOFillPipeline(ContentContextOptions opts,
+                                    bool wait = true) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
-    return GetPipeline(radial_gradient_ssbo_fill_pipelines_, opts);
+    return GetPipeline(radial_gradient_ssbo_fill_pipelines_, opts, wait);
   }
 
   std::shared_ptr<Pipeline<PipelineDescriptor>>
-  GetConicalGradientSSBOFillPipeline(ContentContextOptions opts) const {
+  GetConicalGradientSSBOFillPipeline(ContentContextOptions opts,
+                                    bool wait = true) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
-    return GetPipeline(conical_gradient_ssbo_fill_pipelines_, opts);
+    return GetPipeline(conical_gradient_ssbo_fill_pipelines_, opts, wait);
   }
 
   std::shared_ptr<Pipeline<PipelineDescriptor>>
-  GetSweepGradientSSBOFillPipeline(ContentContextOptions opts) const {
+  GetSweepGradientSSBOFillPipeline(ContentContextOptions opts,
+                                    bool wait = true) const {
     FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
-    return GetPipeline(sweep_gradient_ssbo_fill_pipelines_, opts);
+    return GetPipeline(sweep_gradient_ssbo_fill_pipelines_, opts, wait);
   }
 
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetRadialGradientFillPipeline(
@@ -513,6 +552,11 @@ class ContentContext {
     return GetPipeline(glyph_atlas_color_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasSdfPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(glyph_atlas_sdf_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGeometryColorPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(geometry_color_pipelines_, opts);
@@ -708,12 +752,63 @@ class ContentContext {
     return uv_compute_pipelines_;
   }
 
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+  GetPolylineStrokeComputePipeline() const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsCompute());
+    return polyline_stroke_compute_pipelines_;
+  }
+
   std::shared_ptr<Context> GetContext() const;
 
   const Capabilities& GetDeviceCapabilities() const;
 
   void SetWireframe(bool wireframe);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Anti-alias solid fills by estimating the coverage of their
+  ///             edge pixels instead of multisampling offscreen passes. Fills
+  ///             that can't estimate their coverage are drawn aliased.
+  ///
+  ///             Saves the bandwidth of MSAA textures and resolves on GPUs
+  ///             where it matters more than the quality of the other draws.
+  ///
+  void SetCoverageAntiAliasingEnabled(bool enabled);
+
+  bool IsCoverageAntiAliasingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether offscreen passes should be multisampled, which is the
+  ///             case when the device supports it and coverage anti-aliasing
+  ///             is disabled.
+  ///
+  bool ShouldUseOffscreenMSAA() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record every pipeline variant created from now on. The
+  ///             recorded variants can be persisted and precompiled on the
+  ///             next launch with |PrecompileVariants|.
+  ///
+  void SetVariantCaptureEnabled(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The variants recorded since capture was enabled, or `nullptr`
+  ///             if capture is disabled.
+  ///
+  const PipelineVariantManifest* GetCapturedVariants() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start building the variants listed in the manifest. Backends
+  ///             that compile pipelines asynchronously (Vulkan and Metal) do
+  ///             so on their concurrent worker pool. A later request for one
+  ///             of these variants picks up the pending pipeline instead of
+  ///             creating it on the raster thread. Entries for unknown
+  ///             pipelines are ignored. Scheduled variants are recorded if
+  ///             capture is enabled.
+  ///
+  /// @return     The number of variants that were scheduled.
+  ///
+  size_t PrecompileVariants(const PipelineVariantManifest& manifest);
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -772,11 +867,11 @@ class ContentContext {
 #endif  // IMPELLER_ENABLE_OPENGLES
   mutable Variants<PositionUVPipeline> position_uv_pipelines_;
   mutable Variants<TiledTexturePipeline> tiled_texture_pipelines_;
-  mutable Variants<GaussianBlurAlphaDecalPipeline>
+  mutable Variants<GaussianBlurAlphaPipeline>
       gaussian_blur_alpha_decal_pipelines_;
   mutable Variants<GaussianBlurAlphaPipeline>
       gaussian_blur_alpha_nodecal_pipelines_;
-  mutable Variants<GaussianBlurDecalPipeline>
+  mutable Variants<GaussianBlurPipeline>
       gaussian_blur_noalpha_decal_pipelines_;
   mutable Variants<GaussianBlurPipeline>
       gaussian_blur_noalpha_nodecal_pipelines_;
@@ -789,6 +884,7 @@ class ContentContext {
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<GlyphAtlasColorPipeline> glyph_atlas_color_pipelines_;
+  mutable Variants<GlyphAtlasSdfPipeline> glyph_atlas_sdf_pipelines_;
   mutable Variants<GeometryColorPipeline> geometry_color_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
@@ -843,6 +939,8 @@ class ContentContext {
       point_field_compute_pipelines_;
   mutable std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
       uv_compute_pipelines_;
+  mutable std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+      polyline_stroke_compute_pipelines_;
   // The values for the default context options must be cached on
   // initial creation. In the presence of wide gamut and platform views,
   // it is possible that secondary surfaces will have a different default
@@ -850,10 +948,46 @@ class ContentContext {
   // below to fail.
   ContentContextOptions default_options_;
 
+  using PrecompiledVariants =
+      std::unordered_map<ContentContextOptions,
+                         PipelineFuture<PipelineDescriptor>,
+                         ContentContextOptions::Hash,
+                         ContentContextOptions::Equal>;
+
+  // The descriptors of the prototype pipelines, keyed by label. The value is
+  // empty if two different prototypes share a label, in which case their
+  // variants are never precompiled.
+  std::unordered_map<std::string, std::optional<PipelineDescriptor>>
+      prototype_descriptors_;
+  mutable std::unordered_map<std::string, PrecompiledVariants>
+      precompiled_variants_;
+  mutable std::unique_ptr<PipelineVariantManifest> captured_variants_;
+
+  /// Creates the prototype of a pipeline. Prototypes with specialization
+  /// `constants` get a label of their own, so that they can be told apart
+  /// from the prototypes of the same shaders with other constants.
+  template <class PipelineT>
+  std::unique_ptr<PipelineT> CreateDefaultPipeline(
+      const Context& context,
+      const std::vector<Scalar>& constants = {});
+
+  void RegisterPrototype(const PipelineDescriptor& desc);
+
+  void RecordVariant(const std::string& prototype_label,
+                     const ContentContextOptions& opts) const;
+
+  std::optional<PipelineFuture<PipelineDescriptor>> TakePrecompiledVariant(
+      const std::string& prototype_label,
+      const ContentContextOptions& opts) const;
+
+  /// If `wait` is false, returns `nullptr` instead of blocking when the
+  /// variant, or the prototype it is derived from, is still compiling. The
+  /// compilation of the variant is started either way.
   template <class TypedPipeline>
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetPipeline(
       Variants<TypedPipeline>& container,
-      ContentContextOptions opts) const {
+      ContentContextOptions opts,
+      bool wait = true) const {
     if (!IsValid()) {
       return nullptr;
     }
@@ -863,6 +997,9 @@ class ContentContext {
     }
 
     if (auto found = container.find(opts); found != container.end()) {
+      if (!wait && !found->second->IsReady()) {
+        return nullptr;
+      }
       return found->second->WaitAndGet();
     }
 
@@ -871,30 +1008,49 @@ class ContentContext {
     // The prototype must always be initialized in the constructor.
     FML_CHECK(prototype != container.end());
 
+    if (!wait && !prototype->second->IsReady()) {
+      return nullptr;
+    }
+
     auto pipeline = prototype->second->WaitAndGet();
     if (!pipeline) {
       return nullptr;
     }
 
-    auto variant_future = pipeline->CreateVariant(
-        [&opts, variants_count = container.size()](PipelineDescriptor& desc) {
-          opts.ApplyToPipelineDescriptor(desc);
-          desc.SetLabel(
-              SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
-        });
-    auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
-    auto variant_pipeline = variant->WaitAndGet();
-    container[opts] = std::move(variant);
-    return variant_pipeline;
+    const auto& prototype_label = pipeline->GetDescriptor().GetLabel();
+    RecordVariant(prototype_label, opts);
+
+    std::unique_ptr<TypedPipeline> variant;
+    if (auto precompiled = TakePrecompiledVariant(prototype_label, opts)) {
+      variant = std::make_unique<TypedPipeline>(std::move(precompiled.value()));
+    } else {
+      auto variant_future = pipeline->CreateVariant(
+          [&opts, variants_count = container.size()](PipelineDescriptor& desc) {
+            opts.ApplyToPipelineDescriptor(desc);
+            desc.SetLabel(
+                SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
+          });
+      variant = std::make_unique<TypedPipeline>(std::move(variant_future));
+    }
+    auto& stored_variant = container[opts];
+    stored_variant = std::move(variant);
+    if (!wait && !stored_variant->IsReady()) {
+      return nullptr;
+    }
+    return stored_variant->WaitAndGet();
   }
 
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
+  std::shared_ptr<GradientTextureCache> gradient_texture_cache_;
+  std::shared_ptr<VerticesUploadCache> vertices_upload_cache_;
 #if IMPELLER_ENABLE_3D
   std::shared_ptr<scene::SceneContext> scene_context_;
 #endif  // IMPELLER_ENABLE_3D
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   bool wireframe_ = false;
+  bool coverage_anti_aliasing_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContentContext);
 };
@@ -49,6 +49,14 @@ bool Contents::IsOpaque() const {
   return false;
 }
 
+bool Contents::IsOpaqueOver(const Entity& entity, const Rect& rect) const {
+  return false;
+}
+
+bool Contents::MayWriteStencil() const {
+  return true;
+}
+
 Contents::StencilCoverage Contents::GetStencilCoverage(
     const Entity& entity,
     const std::optional<Rect>& current_stencil_coverage) const {
@@ -123,6 +131,18 @@ std::optional<Color> Contents::AsBackgroundColor(const Entity& entity,
   return {};
 }
 
+const TextContents* Contents::AsTextContents() const {
+  return nullptr;
+}
+
+const SolidColorContents* Contents::AsSolidColorContents() const {
+  return nullptr;
+}
+
+Contents::DrawKind Contents::GetDrawKind() const {
+  return DrawKind::kOther;
+}
+
 bool Contents::ApplyColorFilter(
     const Contents::ColorFilterProc& color_filter_proc) {
   return false;
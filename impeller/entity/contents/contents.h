@@ -23,6 +23,8 @@ struct ContentContextOptions;
 class Entity;
 class Surface;
 class RenderPass;
+class SolidColorContents;
+class TextContents;
 
 ContentContextOptions OptionsFromPass(const RenderPass& pass);
 
@@ -87,6 +89,20 @@ class Contents {
   ///
   virtual bool IsOpaque() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Whether drawing these contents with the given entity is
+  ///        guaranteed to replace every pixel of `rect` with an opaque color,
+  ///        so that the draws beneath them in `rect` don't contribute to the
+  ///        frame. This value does not account for the blend mode or clips.
+  ///
+  virtual bool IsOpaqueOver(const Entity& entity, const Rect& rect) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief Whether drawing these contents may write to the stencil buffer,
+  ///        like clips and strokes that prevent overdraw do.
+  ///
+  virtual bool MayWriteStencil() const;
+
   //----------------------------------------------------------------------------
   /// @brief Given the current screen space bounding rectangle of the stencil,
   ///        return the expected stencil coverage after this draw call. This
@@ -155,6 +171,39 @@ class Contents {
   virtual std::optional<Color> AsBackgroundColor(const Entity& entity,
                                                  ISize target_size) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Returns these contents if they draw text from the glyph atlas.
+  ///
+  ///        This allows runs of text to be drawn with a single command.
+  ///
+  virtual const TextContents* AsTextContents() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief Returns these contents if they fill their geometry with a solid
+  ///        color.
+  ///
+  ///        This allows runs of solid color fills to be drawn with a single
+  ///        command.
+  ///
+  virtual const SolidColorContents* AsSolidColorContents() const;
+
+  /// The kinds of draws that usually bind the same pipeline.
+  enum class DrawKind {
+    kOther,
+    kSolidColor,
+    kTexture,
+    kText,
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief Returns the kind of draw these contents make.
+  ///
+  ///        Entity passes can reorder draws that don't overlap to group the
+  ///        draws of a kind together. Contents of `DrawKind::kOther` are
+  ///        never moved.
+  ///
+  virtual DrawKind GetDrawKind() const;
+
   //----------------------------------------------------------------------------
   /// @brief      If possible, applies a color filter to this contents inputs on
   ///             the CPU.
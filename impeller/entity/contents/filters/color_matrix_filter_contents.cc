@@ -4,7 +4,9 @@
 
 #include "impeller/entity/contents/filters/color_matrix_filter_contents.h"
 
+#include <algorithm>
 #include <optional>
+#include <variant>
 
 #include "impeller/entity/contents/anonymous_contents.h"
 #include "impeller/entity/contents/content_context.h"
@@ -24,6 +26,57 @@ void ColorMatrixFilterContents::SetMatrix(const ColorMatrix& matrix) {
   matrix_ = matrix;
 }
 
+std::optional<ColorMatrix> ColorMatrixFilterContents::Fold(
+    const ColorMatrix& first,
+    const ColorMatrix& second) {
+  const float* a = first.array;
+  const float* b = second.array;
+
+  // The output of `first` must stay within [0, 1] for every input, so that
+  // clamping it is a no-op. The matrix is affine, so each channel's extremes
+  // are reached at corners of the unit hypercube.
+  Scalar min_alpha = 0;
+  for (int row = 0; row < 4; row++) {
+    Scalar min = a[row * 5 + 4];
+    Scalar max = a[row * 5 + 4];
+    for (int column = 0; column < 4; column++) {
+      min += std::min(a[row * 5 + column], 0.0f);
+      max += std::max(a[row * 5 + column], 0.0f);
+    }
+    if (min < 0 || max > 1) {
+      return std::nullopt;
+    }
+    if (row == 3) {
+      min_alpha = min;
+    }
+  }
+
+  // Pixels that `first` makes fully transparent reach `second` as transparent
+  // black, so `second` must either never see them or leave them transparent
+  // regardless of their color.
+  if (min_alpha <= 0 &&
+      (b[15] != 0 || b[16] != 0 || b[17] != 0 || b[19] != 0)) {
+    return std::nullopt;
+  }
+
+  ColorMatrix result;
+  for (int row = 0; row < 4; row++) {
+    for (int column = 0; column < 5; column++) {
+      Scalar value = column == 4 ? b[row * 5 + 4] : 0;
+      for (int k = 0; k < 4; k++) {
+        value += b[row * 5 + k] * a[k * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
+const ColorMatrixFilterContents*
+ColorMatrixFilterContents::AsColorMatrixFilter() const {
+  return this;
+}
+
 std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -42,7 +95,35 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  auto input_snapshot = inputs[0]->GetSnapshot("ColorMatrix", renderer, entity);
+  // Render the color matrix filters this one is applied to in the same pass
+  // instead of snapshotting each of them. They have no local transform, so
+  // their inputs are snapshotted with the same entity.
+  auto input = inputs[0];
+  auto color_matrix = matrix_;
+  auto absorb_opacity = GetAbsorbOpacity();
+  while (true) {
+    auto variant = input->GetInput();
+    auto filter = std::get_if<std::shared_ptr<FilterContents>>(&variant);
+    if (!filter || !*filter) {
+      break;
+    }
+    auto color_matrix_filter = (*filter)->AsColorMatrixFilter();
+    if (!color_matrix_filter ||
+        color_matrix_filter->GetInputs().size() != 1) {
+      break;
+    }
+    auto folded = Fold(color_matrix_filter->matrix_, color_matrix);
+    if (!folded.has_value()) {
+      break;
+    }
+    color_matrix = folded.value();
+    // The snapshot of the inner filter has an opacity of 1, so only the
+    // inner filter's setting applies.
+    absorb_opacity = color_matrix_filter->GetAbsorbOpacity();
+    input = color_matrix_filter->GetInputs()[0];
+  }
+
+  auto input_snapshot = input->GetSnapshot("ColorMatrix", renderer, entity);
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -50,8 +131,8 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
   //----------------------------------------------------------------------------
   /// Create AnonymousContents for rendering.
   ///
-  RenderProc render_proc = [input_snapshot, color_matrix = matrix_,
-                            absorb_opacity = GetAbsorbOpacity()](
+  RenderProc render_proc = [input_snapshot, color_matrix,
+                            absorb_opacity](
                                const ContentContext& renderer,
                                const Entity& entity, RenderPass& pass) -> bool {
     Command cmd;
@@ -22,6 +22,21 @@ class ColorMatrixFilterContents final : public ColorFilterContents {
 
   void SetMatrix(const ColorMatrix& matrix);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a matrix that applies `first` and then `second` in a
+  ///             single pass, or `std::nullopt` if the result could differ
+  ///             from applying them one after the other.
+  ///
+  ///             Each pass clamps its output and drops the color of pixels
+  ///             it makes fully transparent, so this only succeeds when
+  ///             neither can affect what `second` sees.
+  ///
+  static std::optional<ColorMatrix> Fold(const ColorMatrix& first,
+                                         const ColorMatrix& second);
+
+  // |FilterContents|
+  const ColorMatrixFilterContents* AsColorMatrixFilter() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -137,11 +137,13 @@ std::shared_ptr<FilterContents> FilterContents::MakeLocalMatrixFilter(
 std::shared_ptr<FilterContents> FilterContents::MakeYUVToRGBFilter(
     std::shared_ptr<Texture> y_texture,
     std::shared_ptr<Texture> uv_texture,
-    YUVColorSpace yuv_color_space) {
+    YUVColorSpace yuv_color_space,
+    SamplerDescriptor sampler_descriptor) {
   auto filter = std::make_shared<impeller::YUVToRGBFilterContents>();
   filter->SetInputs({impeller::FilterInput::Make(y_texture),
                      impeller::FilterInput::Make(uv_texture)});
   filter->SetYUVColorSpace(yuv_color_space);
+  filter->SetSamplerDescriptor(std::move(sampler_descriptor));
   return filter;
 }
 
@@ -153,6 +155,10 @@ void FilterContents::SetInputs(FilterInput::Vector inputs) {
   inputs_ = std::move(inputs);
 }
 
+const FilterInput::Vector& FilterContents::GetInputs() const {
+  return inputs_;
+}
+
 void FilterContents::SetEffectTransform(Matrix effect_transform) {
   effect_transform_ = effect_transform;
 }
@@ -201,6 +207,35 @@ void FilterContents::PopulateGlyphAtlas(
   }
 }
 
+std::optional<Rect> FilterContents::GetSourceCoverage(
+    const Matrix& entity_transform,
+    const Rect& output_limit) const {
+  auto transform = GetTransform(entity_transform);
+  auto filter_source_coverage =
+      GetFilterSourceCoverage(transform * effect_transform_, output_limit);
+  if (!filter_source_coverage.has_value()) {
+    return std::nullopt;
+  }
+
+  std::optional<Rect> result;
+  for (const auto& input : inputs_) {
+    auto source_coverage =
+        input->GetSourceCoverage(transform, filter_source_coverage.value());
+    if (!source_coverage.has_value()) {
+      return std::nullopt;
+    }
+    result = result.has_value() ? result->Union(source_coverage.value())
+                                : source_coverage;
+  }
+  return result.has_value() ? result : filter_source_coverage;
+}
+
+std::optional<Rect> FilterContents::GetFilterSourceCoverage(
+    const Matrix& effect_transform,
+    const Rect& output_limit) const {
+  return std::nullopt;
+}
+
 std::optional<Rect> FilterContents::GetFilterCoverage(
     const FilterInput::Vector& inputs,
     const Entity& entity,
@@ -296,4 +331,8 @@ void FilterContents::SetLeafInputs(const FilterInput::Vector& inputs) {
   }
 }
 
+const ColorMatrixFilterContents* FilterContents::AsColorMatrixFilter() const {
+  return nullptr;
+}
+
 }  // namespace impeller
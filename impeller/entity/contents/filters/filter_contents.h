@@ -10,12 +10,15 @@
 #include <vector>
 
 #include "impeller/core/formats.h"
+#include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/entity.h"
 #include "impeller/geometry/sigma.h"
 
 namespace impeller {
 
+class ColorMatrixFilterContents;
+
 class FilterContents : public Contents {
  public:
   enum class BlurStyle {
@@ -84,7 +87,8 @@ class FilterContents : public Contents {
   static std::shared_ptr<FilterContents> MakeYUVToRGBFilter(
       std::shared_ptr<Texture> y_texture,
       std::shared_ptr<Texture> uv_texture,
-      YUVColorSpace yuv_color_space);
+      YUVColorSpace yuv_color_space,
+      SamplerDescriptor sampler_descriptor = {});
 
   FilterContents();
 
@@ -97,6 +101,8 @@ class FilterContents : public Contents {
   ///         particular filter's implementation.
   void SetInputs(FilterInput::Vector inputs);
 
+  const FilterInput::Vector& GetInputs() const;
+
   /// @brief  Sets the transform which gets appended to the effect of this
   ///         filter. Note that this is in addition to the entity's transform.
   void SetEffectTransform(Matrix effect_transform);
@@ -133,6 +139,13 @@ class FilterContents : public Contents {
 
   Matrix GetTransform(const Matrix& parent_transform) const;
 
+  /// @brief  Returns the region of the leaf inputs that rendering the filter
+  ///         reads in order to produce `output_limit`, or `std::nullopt` if
+  ///         it isn't known. Both rects are in the space the entity with the
+  ///         given `entity_transform` is drawn to.
+  std::optional<Rect> GetSourceCoverage(const Matrix& entity_transform,
+                                        const Rect& output_limit) const;
+
   /// @brief  Returns `true` if this filter does not have any `FilterInput`
   ///         children.
   bool IsLeaf() const;
@@ -142,7 +155,19 @@ class FilterContents : public Contents {
   /// @see    `FilterContents::IsLeaf`
   void SetLeafInputs(const FilterInput::Vector& inputs);
 
+  /// @brief  Returns this filter if it is a `ColorMatrixFilterContents`, so
+  ///         that a chain of color matrices can be rendered in one pass.
+  virtual const ColorMatrixFilterContents* AsColorMatrixFilter() const;
+
  private:
+  /// @brief  Returns the region of this filter's inputs that producing
+  ///         `output_limit` reads, given the entity transform combined with
+  ///         the effect transform. Filters that don't know it return
+  ///         `std::nullopt`, which is the default.
+  virtual std::optional<Rect> GetFilterSourceCoverage(
+      const Matrix& effect_transform,
+      const Rect& output_limit) const;
+
   virtual std::optional<Rect> GetFilterCoverage(
       const FilterInput::Vector& inputs,
       const Entity& entity,
@@ -14,6 +14,8 @@
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/entity.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/geometry/scalar.h"
 #include "impeller/renderer/command_buffer.h"
@@ -23,12 +25,70 @@
 
 namespace impeller {
 
+namespace {
+
+/// Renders `input` at half its resolution. The linear sampler averages each
+/// 2x2 block of texels.
+std::optional<Snapshot> Downsample(const ContentContext& renderer,
+                                   const Snapshot& input) {
+  ISize size = input.texture->GetSize();
+  ISize half_size((size.width + 1) / 2, (size.height + 1) / 2);
+
+  SamplerDescriptor sampler_desc;
+  sampler_desc.min_filter = MinMagFilter::kLinear;
+  sampler_desc.mag_filter = MinMagFilter::kLinear;
+
+  auto contents = TextureContents::MakeRect(Rect::MakeSize(half_size));
+  contents->SetTexture(input.texture);
+  contents->SetSourceRect(Rect::MakeSize(size));
+  contents->SetSamplerDescriptor(sampler_desc);
+
+  auto texture = renderer.MakeSubpass(
+      "Gaussian Blur Downsample", half_size,
+      [&contents](const ContentContext& renderer, RenderPass& pass) {
+        Entity entity;
+        entity.SetBlendMode(BlendMode::kSource);
+        return contents->Render(renderer, entity, pass);
+      },
+      /*msaa_enabled=*/false);
+  if (!texture) {
+    return std::nullopt;
+  }
+
+  return Snapshot{
+      .texture = texture,
+      .transform = input.transform *
+                   Matrix::MakeScale(Vector2(Size(size) / Size(half_size))),
+      .sampler_descriptor = input.sampler_descriptor,
+      .opacity = input.opacity};
+}
+
+/// The scale that a blur pass of the given radius, in pixels, is rendered at.
+Scalar GetPassScale(Scalar radius) {
+  constexpr Scalar decay = 4.0;   // Larger is more gradual.
+  constexpr Scalar limit = 0.95;  // The maximum percentage of the scaledown.
+  const Scalar curve =
+      std::min(1.0, decay / (std::max(1.0f, radius) + decay - 1.0));
+  return (curve - 1) * limit + 1;
+}
+
+}  // namespace
+
 DirectionalGaussianBlurFilterContents::DirectionalGaussianBlurFilterContents() =
     default;
 
 DirectionalGaussianBlurFilterContents::
     ~DirectionalGaussianBlurFilterContents() = default;
 
+Scalar DirectionalGaussianBlurFilterContents::GetSampleStride(
+    Scalar blur_radius) {
+  Scalar stride = 1;
+  while (blur_radius / stride > kMaxUnscaledBlurRadius) {
+    stride *= 2;
+  }
+  return stride;
+}
+
 void DirectionalGaussianBlurFilterContents::SetSigma(Sigma sigma) {
   blur_sigma_ = sigma;
 }
@@ -88,8 +148,8 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     const Matrix& effect_transform,
     const Rect& coverage,
     const std::optional<Rect>& coverage_hint) const {
-  using VS = GaussianBlurAlphaDecalPipeline::VertexShader;
-  using FS = GaussianBlurAlphaDecalPipeline::FragmentShader;
+  using VS = GaussianBlurAlphaPipeline::VertexShader;
+  using FS = GaussianBlurAlphaPipeline::FragmentShader;
 
   bool is_first_pass = !source_override_;
 
@@ -142,6 +202,16 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
         entity.GetStencilDepth());  // No blur to render.
   }
 
+  // Sample large blurs from a downsampled input, whose texels are about as
+  // large as the distance between the samples.
+  auto sample_stride = GetSampleStride(transformed_blur_radius_length);
+  while (input_snapshot->transform.GetMaxBasisLength() * 2 <= sample_stride) {
+    input_snapshot = Downsample(renderer, input_snapshot.value());
+    if (!input_snapshot.has_value()) {
+      return std::nullopt;
+    }
+  }
+
   // A matrix that rotates the snapshot space such that the blur direction is
   // +X.
   auto texture_rotate = Matrix::MakeRotationZ(
@@ -209,15 +279,16 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     frame_info.alpha_mask_sampler_y_coord_scale =
         source_snapshot->texture->GetYCoordScale();
 
+    // The sigma, radius and offset are in units of the sample stride.
     FS::BlurInfo frag_info;
     auto r = Radius{transformed_blur_radius_length};
-    frag_info.blur_sigma = Sigma{r}.sigma;
-    frag_info.blur_radius = std::round(r.radius);
+    frag_info.blur_sigma = Sigma{r}.sigma / sample_stride;
+    frag_info.blur_radius = std::round(r.radius / sample_stride);
 
     // The blur direction is in input UV space.
     frag_info.blur_uv_offset =
         pass_transform.Invert().TransformDirection(Vector2(1, 0)).Normalize() /
-        Point(input_snapshot->GetCoverage().value().size);
+        Point(input_snapshot->GetCoverage().value().size) * sample_stride;
 
     Command cmd;
     DEBUG_COMMAND_INFO(cmd, SPrintF("Gaussian Blur Filter (Radius=%.2f)",
@@ -300,19 +371,12 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
   };
 
   Vector2 scale;
-  auto scale_curve = [](Scalar radius) {
-    constexpr Scalar decay = 4.0;   // Larger is more gradual.
-    constexpr Scalar limit = 0.95;  // The maximum percentage of the scaledown.
-    const Scalar curve =
-        std::min(1.0, decay / (std::max(1.0f, radius) + decay - 1.0));
-    return (curve - 1) * limit + 1;
-  };
   {
-    scale.x = scale_curve(transformed_blur_radius_length);
+    scale.x = GetPassScale(transformed_blur_radius_length);
 
     Scalar y_radius = std::abs(pass_transform.GetDirectionScale(
         Vector2(0, !is_first_pass ? Radius{secondary_blur_sigma_}.radius : 1)));
-    scale.y = scale_curve(y_radius);
+    scale.y = GetPassScale(y_radius);
   }
 
   Vector2 scaled_size = pass_texture_rect.size * scale;
@@ -342,6 +406,22 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
       entity.GetBlendMode(), entity.GetStencilDepth());
 }
 
+std::optional<Rect>
+DirectionalGaussianBlurFilterContents::GetFilterSourceCoverage(
+    const Matrix& effect_transform,
+    const Rect& output_limit) const {
+  auto radius = std::min(Radius{blur_sigma_}.radius, 500.0f);
+  auto blur_vector =
+      effect_transform.TransformDirection(blur_direction_ * radius).Abs();
+  auto blur_radius = blur_vector.GetLength();
+  // The output is upscaled from a smaller pass, and samples a downsampled
+  // input, so each pixel also depends on the texels around its samples.
+  auto margin =
+      2 / GetPassScale(blur_radius) + 2 * GetSampleStride(blur_radius);
+  return output_limit.Expand(blur_vector.x + margin, blur_vector.y + margin,
+                             blur_vector.x + margin, blur_vector.y + margin);
+}
+
 std::optional<Rect> DirectionalGaussianBlurFilterContents::GetFilterCoverage(
     const FilterInput::Vector& inputs,
     const Entity& entity,
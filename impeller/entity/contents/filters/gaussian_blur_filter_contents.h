@@ -17,6 +17,21 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
 
   ~DirectionalGaussianBlurFilterContents() override;
 
+  /// Blurs with a larger radius, in pixels, sample their input at a larger
+  /// stride so that the number of samples per pixel stays bounded.
+  static constexpr Scalar kMaxUnscaledBlurRadius = 16.0;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Returns the distance, in pixels, between the samples a blur of
+  ///         the given radius takes.
+  ///
+  ///         The stride is a power of two. When it is larger than one, the
+  ///         input is first downsampled by halves (like a mip chain) until its
+  ///         texels are about as large as the stride, so that the cost of the
+  ///         blur stays roughly constant as the sigma grows.
+  ///
+  static Scalar GetSampleStride(Scalar blur_radius);
+
   void SetSigma(Sigma sigma);
 
   void SetSecondarySigma(Sigma sigma);
@@ -36,6 +51,11 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
       const Matrix& effect_transform) const override;
 
  private:
+  // |FilterContents|
+  std::optional<Rect> GetFilterSourceCoverage(
+      const Matrix& effect_transform,
+      const Rect& output_limit) const override;
+
   // |FilterContents|
   std::optional<Entity> RenderFilter(
       const FilterInput::Vector& input_textures,
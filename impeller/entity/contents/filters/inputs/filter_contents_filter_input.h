@@ -25,6 +25,11 @@ class FilterContentsFilterInput final : public FilterInput {
   // |FilterInput|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |FilterInput|
+  std::optional<Rect> GetSourceCoverage(
+      const Matrix& entity_transform,
+      const Rect& output_limit) const override;
+
   // |FilterInput|
   Matrix GetLocalTransform(const Entity& entity) const override;
 
@@ -56,6 +56,12 @@ FilterInput::Vector FilterInput::Make(std::initializer_list<Variant> inputs) {
   return result;
 }
 
+std::optional<Rect> FilterInput::GetSourceCoverage(
+    const Matrix& entity_transform,
+    const Rect& output_limit) const {
+  return output_limit;
+}
+
 Matrix FilterInput::GetLocalTransform(const Entity& entity) const {
   return Matrix();
 }
@@ -56,6 +56,13 @@ class FilterInput {
 
   virtual std::optional<Rect> GetCoverage(const Entity& entity) const = 0;
 
+  /// @brief  Returns the region of this input that is read in order to
+  ///         produce `output_limit` of the filter using it, or `std::nullopt`
+  ///         if it isn't known. Inputs that aren't filters are read exactly
+  ///         where they are used.
+  virtual std::optional<Rect> GetSourceCoverage(const Matrix& entity_transform,
+                                                const Rect& output_limit) const;
+
   /// @brief  Get the local transform of this filter input. This transform is
   ///         relative to the `Entity` transform space.
   virtual Matrix GetLocalTransform(const Entity& entity) const;
@@ -156,6 +156,18 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
       entity.GetBlendMode(), entity.GetStencilDepth());
 }
 
+std::optional<Rect>
+DirectionalMorphologyFilterContents::GetFilterSourceCoverage(
+    const Matrix& effect_transform,
+    const Rect& output_limit) const {
+  // Both dilating and eroding read the radius around each pixel, plus the
+  // neighbors of the linearly filtered samples.
+  auto vector =
+      effect_transform.TransformDirection(direction_ * radius_.radius).Abs();
+  return output_limit.Expand(vector.x + 1, vector.y + 1, vector.x + 1,
+                             vector.y + 1);
+}
+
 std::optional<Rect> DirectionalMorphologyFilterContents::GetFilterCoverage(
     const FilterInput::Vector& inputs,
     const Entity& entity,
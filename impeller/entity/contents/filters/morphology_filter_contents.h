@@ -30,6 +30,11 @@ class DirectionalMorphologyFilterContents final : public FilterContents {
       const Matrix& effect_transform) const override;
 
  private:
+  // |FilterContents|
+  std::optional<Rect> GetFilterSourceCoverage(
+      const Matrix& effect_transform,
+      const Rect& output_limit) const override;
+
   // |FilterContents|
   std::optional<Entity> RenderFilter(
       const FilterInput::Vector& input_textures,
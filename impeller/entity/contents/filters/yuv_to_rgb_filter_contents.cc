@@ -37,6 +37,11 @@ void YUVToRGBFilterContents::SetYUVColorSpace(YUVColorSpace yuv_color_space) {
   yuv_color_space_ = yuv_color_space;
 }
 
+void YUVToRGBFilterContents::SetSamplerDescriptor(
+    SamplerDescriptor sampler_descriptor) {
+  sampler_descriptor_ = std::move(sampler_descriptor);
+}
+
 std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -70,7 +75,8 @@ std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
   /// Create AnonymousContents for rendering.
   ///
   RenderProc render_proc = [y_input_snapshot, uv_input_snapshot,
-                            yuv_color_space = yuv_color_space_](
+                            yuv_color_space = yuv_color_space_,
+                            sampler_descriptor = sampler_descriptor_](
                                const ContentContext& renderer,
                                const Entity& entity, RenderPass& pass) -> bool {
     Command cmd;
@@ -114,7 +120,8 @@ std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
         break;
     }
 
-    auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler({});
+    auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+        sampler_descriptor);
     FS::BindYTexture(cmd, y_input_snapshot->texture, sampler);
     FS::BindUvTexture(cmd, uv_input_snapshot->texture, sampler);
 
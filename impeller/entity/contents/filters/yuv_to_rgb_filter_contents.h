@@ -16,6 +16,10 @@ class YUVToRGBFilterContents final : public FilterContents {
 
   void SetYUVColorSpace(YUVColorSpace yuv_color_space);
 
+  /// Sets the sampler used for both planes. Filters that are drawn scaled
+  /// sample the planes directly, so they need the sampling of the draw.
+  void SetSamplerDescriptor(SamplerDescriptor sampler_descriptor);
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -27,6 +31,7 @@ class YUVToRGBFilterContents final : public FilterContents {
       const std::optional<Rect>& coverage_hint) const override;
 
   YUVColorSpace yuv_color_space_ = YUVColorSpace::kBT601LimitedRange;
+  SamplerDescriptor sampler_descriptor_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(YUVToRGBFilterContents);
 };
@@ -7,6 +7,7 @@
 #include "impeller/entity/contents/gradient_generator.h"
 
 #include "flutter/fml/logging.h"
+#include "impeller/core/allocator.h"
 #include "impeller/core/texture.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/renderer/context.h"
@@ -17,6 +18,13 @@ namespace impeller {
 std::shared_ptr<Texture> CreateGradientTexture(
     const GradientData& gradient_data,
     const std::shared_ptr<impeller::Context>& context) {
+  return CreateGradientTexture(gradient_data,
+                               *context->GetResourceAllocator());
+}
+
+std::shared_ptr<Texture> CreateGradientTexture(
+    const GradientData& gradient_data,
+    Allocator& allocator) {
   if (gradient_data.texture_size == 0) {
     FML_DLOG(ERROR) << "Invalid gradient data.";
     return nullptr;
@@ -26,8 +34,7 @@ std::shared_ptr<Texture> CreateGradientTexture(
   texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
   texture_descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
   texture_descriptor.size = {gradient_data.texture_size, 1};
-  auto texture =
-      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+  auto texture = allocator.CreateTexture(texture_descriptor);
   if (!texture) {
     FML_DLOG(ERROR) << "Could not create Impeller texture.";
     return nullptr;
@@ -18,6 +18,7 @@
 
 namespace impeller {
 
+class Allocator;
 class Context;
 
 /**
@@ -28,6 +29,14 @@ std::shared_ptr<Texture> CreateGradientTexture(
     const GradientData& gradient_data,
     const std::shared_ptr<impeller::Context>& context);
 
+/**
+ * @brief Create a host visible texture that contains the gradient defined
+ * by the provided gradient data, using the given allocator.
+ */
+std::shared_ptr<Texture> CreateGradientTexture(
+    const GradientData& gradient_data,
+    Allocator& allocator);
+
 struct StopData {
   Color color;
   Scalar stop;
@@ -10,6 +10,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_texture_cache.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
 
@@ -75,9 +76,8 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = LinearGradientFillPipeline::VertexShader;
   using FS = LinearGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
   auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+      renderer.GetGradientTextureCache()->GetTexture(colors_, stops_);
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -172,7 +172,13 @@ bool LinearGradientContents::RenderSSBO(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  cmd.pipeline = renderer.GetLinearGradientSSBOFillPipeline(options);
+  cmd.pipeline =
+      renderer.GetLinearGradientSSBOFillPipeline(options, /*wait=*/false);
+  if (!cmd.pipeline) {
+    // This variant is still compiling. Draw with the texture pipeline until
+    // it is ready instead of stalling the frame on it.
+    return RenderTexture(renderer, entity, pass);
+  }
 
   cmd.BindVertices(geometry_result.vertex_buffer);
   FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
+
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "impeller/base/validation.h"
+#include "impeller/entity/entity.h"
+
+namespace impeller {
+
+// Bump when the meaning or layout of an entry changes.
+static constexpr const char* kManifestHeader = "impeller-pipeline-variants 1";
+
+PipelineVariantManifest::PipelineVariantManifest() = default;
+
+PipelineVariantManifest::~PipelineVariantManifest() = default;
+
+PipelineVariantManifest::PipelineVariantManifest(PipelineVariantManifest&&) =
+    default;
+
+PipelineVariantManifest& PipelineVariantManifest::operator=(
+    PipelineVariantManifest&&) = default;
+
+std::optional<PipelineVariantManifest> PipelineVariantManifest::Parse(
+    const fml::Mapping& mapping) {
+  std::istringstream stream(
+      std::string{reinterpret_cast<const char*>(mapping.GetMapping()),
+                  mapping.GetSize()});
+
+  std::string line;
+  if (!std::getline(stream, line) || line != kManifestHeader) {
+    return std::nullopt;
+  }
+
+  PipelineVariantManifest manifest;
+  while (std::getline(stream, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::istringstream fields(line);
+    uint32_t sample_count = 0;
+    uint32_t blend_mode = 0;
+    uint32_t stencil_compare = 0;
+    uint32_t stencil_operation = 0;
+    uint32_t primitive_type = 0;
+    uint32_t pixel_format = 0;
+    uint32_t has_stencil_attachment = 0;
+    uint32_t wireframe = 0;
+    fields >> sample_count >> blend_mode >> stencil_compare >>
+        stencil_operation >> primitive_type >> pixel_format >>
+        has_stencil_attachment >> wireframe;
+    std::string label;
+    if (fields.fail() || !std::getline(fields >> std::ws, label) ||
+        label.empty()) {
+      return std::nullopt;
+    }
+    if ((sample_count != static_cast<uint32_t>(SampleCount::kCount1) &&
+         sample_count != static_cast<uint32_t>(SampleCount::kCount4)) ||
+        blend_mode > static_cast<uint32_t>(Entity::kLastPipelineBlendMode)) {
+      // Not a variant this version can build. Skip it.
+      continue;
+    }
+    manifest.Record(
+        label,
+        ContentContextOptions{
+            .sample_count = static_cast<SampleCount>(sample_count),
+            .blend_mode = static_cast<BlendMode>(blend_mode),
+            .stencil_compare = static_cast<CompareFunction>(stencil_compare),
+            .stencil_operation =
+                static_cast<StencilOperation>(stencil_operation),
+            .primitive_type = static_cast<PrimitiveType>(primitive_type),
+            .color_attachment_pixel_format =
+                static_cast<PixelFormat>(pixel_format),
+            .has_stencil_attachment = has_stencil_attachment != 0,
+            .wireframe = wireframe != 0,
+        });
+  }
+  return manifest;
+}
+
+std::optional<PipelineVariantManifest>
+PipelineVariantManifest::ReadFromDirectory(const fml::UniqueFD& directory) {
+  if (!directory.is_valid()) {
+    return std::nullopt;
+  }
+  auto mapping = fml::FileMapping::CreateReadOnly(directory, kFileName);
+  if (!mapping) {
+    return std::nullopt;
+  }
+  return Parse(*mapping);
+}
+
+std::shared_ptr<fml::Mapping> PipelineVariantManifest::Serialize() const {
+  std::stringstream stream;
+  stream << kManifestHeader << "\n";
+  for (const auto& entry : entries_) {
+    const auto& opts = entry.options;
+    stream << static_cast<uint32_t>(opts.sample_count) << " "
+           << static_cast<uint32_t>(opts.blend_mode) << " "
+           << static_cast<uint32_t>(opts.stencil_compare) << " "
+           << static_cast<uint32_t>(opts.stencil_operation) << " "
+           << static_cast<uint32_t>(opts.primitive_type) << " "
+           << static_cast<uint32_t>(opts.color_attachment_pixel_format) << " "
+           << opts.has_stencil_attachment << " " << opts.wireframe << " "
+           << entry.pipeline_label << "\n";
+  }
+  return std::make_shared<fml::DataMapping>(stream.str());
+}
+
+bool PipelineVariantManifest::WriteToDirectory(
+    const fml::UniqueFD& directory) const {
+  if (!directory.is_valid()) {
+    return false;
+  }
+  auto data = Serialize();
+  if (!fml::WriteAtomically(directory, kFileName, *data)) {
+    VALIDATION_LOG << "Could not write the pipeline variant manifest.";
+    return false;
+  }
+  return true;
+}
+
+bool PipelineVariantManifest::Record(const std::string& pipeline_label,
+                                     const ContentContextOptions& options) {
+  // Labels are written one per line.
+  if (pipeline_label.empty() ||
+      pipeline_label.find('\n') != std::string::npos) {
+    return false;
+  }
+  for (const auto& entry : entries_) {
+    if (entry.pipeline_label == pipeline_label &&
+        ContentContextOptions::Equal{}(entry.options, options)) {
+      return false;
+    }
+  }
+  entries_.push_back({pipeline_label, options});
+  return true;
+}
+
+const std::vector<PipelineVariantManifest::Entry>&
+PipelineVariantManifest::GetEntries() const {
+  return entries_;
+}
+
+}  // namespace impeller
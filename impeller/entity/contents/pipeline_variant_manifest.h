@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/entity/contents/content_context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A list of the pipeline variants an application needed, keyed by
+///             the label of the prototype pipeline they were derived from.
+///
+///             A manifest captured while the application runs can be written
+///             to disk and handed to |ContentContext::PrecompileVariants| on
+///             the next launch so that those variants are compiled before
+///             they are first used.
+///
+class PipelineVariantManifest {
+ public:
+  struct Entry {
+    std::string pipeline_label;
+    ContentContextOptions options;
+  };
+
+  static constexpr const char* kFileName = "flutter.impeller.variants";
+
+  PipelineVariantManifest();
+
+  ~PipelineVariantManifest();
+
+  PipelineVariantManifest(PipelineVariantManifest&&);
+
+  PipelineVariantManifest& operator=(PipelineVariantManifest&&);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parse a manifest previously created with |Serialize|.
+  ///
+  /// @return     The manifest or `std::nullopt` if the data is malformed or
+  ///             was written by an incompatible version.
+  ///
+  static std::optional<PipelineVariantManifest> Parse(
+      const fml::Mapping& mapping);
+
+  static std::optional<PipelineVariantManifest> ReadFromDirectory(
+      const fml::UniqueFD& directory);
+
+  std::shared_ptr<fml::Mapping> Serialize() const;
+
+  bool WriteToDirectory(const fml::UniqueFD& directory) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add a variant to the manifest.
+  ///
+  /// @return     If the variant was not already present.
+  ///
+  bool Record(const std::string& pipeline_label,
+              const ContentContextOptions& options);
+
+  const std::vector<Entry>& GetEntries() const;
+
+ private:
+  std::vector<Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineVariantManifest);
+};
+
+}  // namespace impeller
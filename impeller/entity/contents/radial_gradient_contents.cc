@@ -9,6 +9,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_texture_cache.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/gradient.h"
 #include "impeller/renderer/render_pass.h"
@@ -109,7 +110,13 @@ bool RadialGradientContents::RenderSSBO(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  cmd.pipeline = renderer.GetRadialGradientSSBOFillPipeline(options);
+  cmd.pipeline =
+      renderer.GetRadialGradientSSBOFillPipeline(options, /*wait=*/false);
+  if (!cmd.pipeline) {
+    // This variant is still compiling. Draw with the texture pipeline until
+    // it is ready instead of stalling the frame on it.
+    return RenderTexture(renderer, entity, pass);
+  }
 
   cmd.BindVertices(geometry_result.vertex_buffer);
   FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
@@ -134,9 +141,8 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = RadialGradientFillPipeline::VertexShader;
   using FS = RadialGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
   auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+      renderer.GetGradientTextureCache()->GetTexture(colors_, stops_);
   if (gradient_texture == nullptr) {
     return false;
   }
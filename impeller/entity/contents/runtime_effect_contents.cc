@@ -168,15 +168,17 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   /// Fragment stage uniforms.
   ///
 
+  // TODO(113715): Populate this metadata once GLES is able to handle
+  //               non-struct uniform names. Until then, every uniform binds
+  //               the same empty metadata. Bindings only keep a pointer to
+  //               it, so it must outlive the command.
+  static const ShaderMetadata* kEmptyMetadata = new ShaderMetadata();
+
   size_t minimum_sampler_index = 100000000;
   size_t buffer_index = 0;
   size_t buffer_offset = 0;
-  for (auto uniform : runtime_stage_->GetUniforms()) {
-    // TODO(113715): Populate this metadata once GLES is able to handle
-    //               non-struct uniform names.
-    std::shared_ptr<ShaderMetadata> metadata =
-        std::make_shared<ShaderMetadata>();
-
+  const auto& uniforms = runtime_stage_->GetUniforms();
+  for (const auto& uniform : uniforms) {
     switch (uniform.type) {
       case kSampledImage: {
         // Sampler uniforms are ordered in the IPLR according to their
@@ -201,7 +203,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
         ShaderUniformSlot uniform_slot;
         uniform_slot.name = uniform.name.c_str();
         uniform_slot.ext_res_0 = uniform.location;
-        cmd.BindResource(ShaderStage::kFragment, uniform_slot, metadata,
+        cmd.BindResource(ShaderStage::kFragment, uniform_slot, *kEmptyMetadata,
                          buffer_view);
         buffer_index++;
         buffer_offset += uniform.GetSize();
@@ -225,11 +227,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   }
 
   size_t sampler_index = 0;
-  for (auto uniform : runtime_stage_->GetUniforms()) {
-    // TODO(113715): Populate this metadata once GLES is able to handle
-    //               non-struct uniform names.
-    ShaderMetadata metadata;
-
+  for (const auto& uniform : uniforms) {
     switch (uniform.type) {
       case kSampledImage: {
         FML_DCHECK(sampler_index < texture_inputs_.size());
@@ -242,7 +240,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
         image_slot.name = uniform.name.c_str();
         image_slot.texture_index = uniform.location - minimum_sampler_index;
         image_slot.sampler_index = uniform.location - minimum_sampler_index;
-        cmd.BindResource(ShaderStage::kFragment, image_slot, metadata,
+        cmd.BindResource(ShaderStage::kFragment, image_slot, *kEmptyMetadata,
                          input.texture, sampler);
 
         sampler_index++;
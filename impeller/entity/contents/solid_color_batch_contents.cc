@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/solid_color_batch_contents.h"
+
+#include <limits>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+SolidColorBatchContents::SolidColorBatchContents() = default;
+
+SolidColorBatchContents::~SolidColorBatchContents() = default;
+
+bool SolidColorBatchContents::AddFill(const SolidColorContents& contents,
+                                      const Matrix& transform) {
+  const auto& geometry = contents.GetGeometry();
+  if (!geometry || geometry->PreventsOverdraw()) {
+    return false;
+  }
+  auto coverage = geometry->GetCoverage(transform);
+  if (!coverage.has_value()) {
+    return false;
+  }
+
+  auto vertex_count = positions_.size();
+  auto index_count = indices_.size();
+  if (!geometry->AppendTriangles(transform, positions_, indices_) ||
+      positions_.size() > std::numeric_limits<uint16_t>::max()) {
+    positions_.resize(vertex_count);
+    indices_.resize(index_count);
+    return false;
+  }
+
+  colors_.resize(positions_.size(), contents.GetColor().Premultiply());
+  coverage_ = coverage_.has_value() ? coverage_->Union(coverage.value())
+                                    : coverage.value();
+  fill_count_++;
+  return true;
+}
+
+size_t SolidColorBatchContents::GetFillCount() const {
+  return fill_count_;
+}
+
+size_t SolidColorBatchContents::GetVertexCount() const {
+  return positions_.size();
+}
+
+std::optional<Rect> SolidColorBatchContents::GetCoverage(
+    const Entity& entity) const {
+  if (!coverage_.has_value()) {
+    return std::nullopt;
+  }
+  return coverage_->TransformBounds(entity.GetTransformation());
+}
+
+bool SolidColorBatchContents::Render(const ContentContext& renderer,
+                                     const Entity& entity,
+                                     RenderPass& pass) const {
+  if (indices_.empty()) {
+    return true;
+  }
+
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  std::vector<VS::PerVertexData> vertex_data(positions_.size());
+  for (auto i = 0u; i < positions_.size(); i++) {
+    vertex_data[i] = {
+        .position = positions_[i],
+        .color = colors_[i],
+    };
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = host_buffer.Emplace(
+      vertex_data.data(), vertex_data.size() * sizeof(VS::PerVertexData),
+      alignof(VS::PerVertexData));
+  vertex_buffer.index_buffer =
+      host_buffer.Emplace(indices_.data(), indices_.size() * sizeof(uint16_t),
+                          alignof(uint16_t));
+  vertex_buffer.vertex_count = indices_.size();
+  vertex_buffer.index_type = IndexType::k16bit;
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "Solid Fill Batch");
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetGeometryColorPipeline(opts);
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(vertex_buffer);
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  // The colors are premultiplied and already have the opacity applied.
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
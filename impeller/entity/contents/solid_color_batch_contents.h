@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+class SolidColorContents;
+
+//------------------------------------------------------------------------------
+/// @brief Draws several solid color fills with a single command.
+///
+///        The fills are triangulated on the CPU with their transforms
+///        applied, and their colors are stored per vertex, so that a run of
+///        rects, rounded rects and circles of different colors costs one
+///        draw call instead of one per shape.
+///
+class SolidColorBatchContents final : public Contents {
+ public:
+  SolidColorBatchContents();
+
+  ~SolidColorBatchContents() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Adds a fill drawn with `transform` to the batch.
+  ///
+  /// @return `false` if the geometry of the fill can't be triangulated on the
+  ///         CPU or doesn't fit in the batch, in which case the batch is left
+  ///         unchanged.
+  ///
+  bool AddFill(const SolidColorContents& contents, const Matrix& transform);
+
+  size_t GetFillCount() const;
+
+  size_t GetVertexCount() const;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  std::vector<Point> positions_;
+  std::vector<Color> colors_;
+  std::vector<uint16_t> indices_;
+  std::optional<Rect> coverage_;
+  size_t fill_count_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SolidColorBatchContents);
+};
+
+}  // namespace impeller
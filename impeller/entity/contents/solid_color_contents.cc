@@ -32,6 +32,14 @@ bool SolidColorContents::IsOpaque() const {
   return GetColor().IsOpaque();
 }
 
+Contents::DrawKind SolidColorContents::GetDrawKind() const {
+  return DrawKind::kSolidColor;
+}
+
+const SolidColorContents* SolidColorContents::AsSolidColorContents() const {
+  return this;
+}
+
 std::optional<Rect> SolidColorContents::GetCoverage(
     const Entity& entity) const {
   if (GetColor().IsTransparent()) {
@@ -45,11 +53,83 @@ std::optional<Rect> SolidColorContents::GetCoverage(
   return geometry->GetCoverage(entity.GetTransformation());
 };
 
+/// Draws a fill whose vertex colors anti-alias its edges. The fringe of a
+/// fill that isn't convex is only drawn outside of the stencil marked by the
+/// fill, and only once where its strips overlap.
+static bool RenderCoverageAA(const ContentContext& renderer,
+                             const Entity& entity,
+                             RenderPass& pass,
+                             const CoverageAAGeometryResult& result,
+                             std::optional<Rect> coverage) {
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  auto frag_info_view = host_buffer.EmplaceUniform(frag_info);
+
+  auto add_command = [&](const GeometryResult& geometry_result) {
+    Command cmd;
+    DEBUG_COMMAND_INFO(cmd, "Solid Fill (Coverage AA)");
+    cmd.stencil_reference = entity.GetStencilDepth();
+
+    auto options = OptionsFromPassAndEntity(pass, entity);
+    if (geometry_result.prevent_overdraw) {
+      options.stencil_compare = CompareFunction::kEqual;
+      options.stencil_operation = StencilOperation::kIncrementClamp;
+    }
+    options.primitive_type = geometry_result.type;
+    cmd.pipeline = renderer.GetGeometryColorPipeline(options);
+    cmd.BindVertices(geometry_result.vertex_buffer);
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = geometry_result.transform;
+    VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    FS::BindFragInfo(cmd, frag_info_view);
+    return pass.AddCommand(std::move(cmd));
+  };
+
+  if (!add_command(result.fill)) {
+    return false;
+  }
+  if (result.fringe.has_value() && !add_command(result.fringe.value())) {
+    return false;
+  }
+
+  if (result.fill.prevent_overdraw) {
+    auto restore = ClipRestoreContents();
+    // The fringe reaches half a pixel past the coverage of the fill.
+    if (coverage.has_value()) {
+      coverage = coverage->Expand(1);
+    }
+    restore.SetRestoreCoverage(coverage);
+    return restore.Render(renderer, entity, pass);
+  }
+  return true;
+}
+
 bool SolidColorContents::Render(const ContentContext& renderer,
                                 const Entity& entity,
                                 RenderPass& pass) const {
   auto capture = entity.GetCapture().CreateChild("SolidColorContents");
 
+  // Multisampled passes are already anti-aliased.
+  if (renderer.IsCoverageAntiAliasingEnabled() &&
+      pass.GetRenderTarget().GetSampleCount() == SampleCount::kCount1) {
+    auto result = GetGeometry()->GetCoverageAABuffers(
+        renderer, entity, pass, GetColor().Premultiply());
+    // Fringes need the stencil to stay outside of the fill.
+    bool can_render =
+        result.has_value() &&
+        (!result->fill.prevent_overdraw ||
+         pass.GetRenderTarget().GetStencilAttachment().has_value());
+    if (can_render) {
+      return RenderCoverageAA(renderer, entity, pass, result.value(),
+                              GetCoverage(entity));
+    }
+  }
+
   using VS = SolidFillPipeline::VertexShader;
 
   Command cmd;
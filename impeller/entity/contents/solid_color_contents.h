@@ -40,6 +40,12 @@ class SolidColorContents final : public ColorSourceContents {
   // |Contents|
   bool IsOpaque() const override;
 
+  // |Contents|
+  DrawKind GetDrawKind() const override;
+
+  // |Contents|
+  const SolidColorContents* AsSolidColorContents() const override;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -9,6 +9,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_texture_cache.h"
 #include "impeller/geometry/gradient.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
@@ -115,7 +116,13 @@ bool SweepGradientContents::RenderSSBO(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  cmd.pipeline = renderer.GetSweepGradientSSBOFillPipeline(options);
+  cmd.pipeline =
+      renderer.GetSweepGradientSSBOFillPipeline(options, /*wait=*/false);
+  if (!cmd.pipeline) {
+    // This variant is still compiling. Draw with the texture pipeline until
+    // it is ready instead of stalling the frame on it.
+    return RenderTexture(renderer, entity, pass);
+  }
 
   cmd.BindVertices(geometry_result.vertex_buffer);
   FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
@@ -140,9 +147,8 @@ bool SweepGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = SweepGradientFillPipeline::VertexShader;
   using FS = SweepGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
   auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+      renderer.GetGradientTextureCache()->GetTexture(colors_, stops_);
   if (gradient_texture == nullptr) {
     return false;
   }
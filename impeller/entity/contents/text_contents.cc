@@ -26,6 +26,7 @@ TextContents::~TextContents() = default;
 
 void TextContents::SetTextFrame(TextFrame&& frame) {
   frame_ = std::move(frame);
+  atlas_type_ = frame_.GetAtlasType();
 }
 
 std::shared_ptr<GlyphAtlas> TextContents::ResolveAtlas(
@@ -61,13 +62,86 @@ void TextContents::SetOffset(Vector2 offset) {
 }
 
 std::optional<Rect> TextContents::GetCoverage(const Entity& entity) const {
-  return frame_.GetBounds().TransformBounds(entity.GetTransformation());
+  if (batch_.empty()) {
+    return frame_.GetBounds().TransformBounds(entity.GetTransformation());
+  }
+  std::optional<Rect> bounds;
+  for (const BatchedText& text : batch_) {
+    Rect text_bounds = text.contents->frame_.GetBounds().Shift(text.offset);
+    bounds = bounds.has_value() ? bounds->Union(text_bounds) : text_bounds;
+  }
+  return bounds->TransformBounds(entity.GetTransformation());
+}
+
+std::optional<Vector2> TextContents::GetBatchOffset(
+    const Entity& entity,
+    const TextContents& other,
+    const Entity& other_entity) const {
+  if (entity.GetBlendMode() != other_entity.GetBlendMode() ||
+      entity.GetStencilDepth() != other_entity.GetStencilDepth() ||
+      atlas_type_ != other.atlas_type_ ||
+      scale_ != other.scale_ || !(GetColor() == other.GetColor())) {
+    return std::nullopt;
+  }
+
+  const Matrix& transform = entity.GetTransformation();
+  const Matrix& other_transform = other_entity.GetTransformation();
+  if (transform.HasPerspective() || other_transform.HasPerspective()) {
+    return std::nullopt;
+  }
+  Matrix basis = transform.Basis();
+  if (!(basis == other_transform.Basis()) || basis.GetDeterminant() == 0) {
+    return std::nullopt;
+  }
+
+  // The other transform is `transform * Matrix::MakeTranslation(offset)`.
+  Vector3 translation(other_transform.m[12] - transform.m[12],
+                      other_transform.m[13] - transform.m[13],
+                      other_transform.m[14] - transform.m[14]);
+  Vector3 offset = basis.Invert() * translation;
+  if (!ScalarNearlyZero(offset.z)) {
+    return std::nullopt;
+  }
+  return Vector2(offset.x, offset.y);
+}
+
+std::shared_ptr<TextContents> TextContents::MakeBatch(
+    std::vector<BatchedText> batch) {
+  FML_DCHECK(!batch.empty());
+  auto contents = std::make_shared<TextContents>();
+  contents->color_ = batch.front().contents->GetColor();
+  contents->batch_ = std::move(batch);
+  return contents;
+}
+
+const TextContents* TextContents::AsTextContents() const {
+  return this;
+}
+
+Contents::DrawKind TextContents::GetDrawKind() const {
+  return DrawKind::kText;
+}
+
+bool TextContents::MayWriteStencil() const {
+  return false;
+}
+
+void TextContents::ForEachTextFrame(
+    const std::function<void(const TextContents& text, Vector2 offset)>&
+        callback) const {
+  if (batch_.empty()) {
+    callback(*this, offset_);
+    return;
+  }
+  for (const BatchedText& text : batch_) {
+    callback(*text.contents, text.contents->offset_ + text.offset);
+  }
 }
 
 void TextContents::PopulateGlyphAtlas(
     const std::shared_ptr<LazyGlyphAtlas>& lazy_glyph_atlas,
     Scalar scale) {
-  lazy_glyph_atlas->AddTextFrame(frame_, scale);
+  atlas_type_ = lazy_glyph_atlas->AddTextFrame(frame_, scale);
   scale_ = scale;
 }
 
@@ -79,7 +153,8 @@ bool TextContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  auto type = frame_.GetAtlasType();
+  auto type =
+      batch_.empty() ? atlas_type_ : batch_.front().contents->atlas_type_;
   auto atlas =
       ResolveAtlas(*renderer.GetContext(), type, renderer.GetLazyGlyphAtlas());
 
@@ -93,15 +168,23 @@ bool TextContents::Render(const ContentContext& renderer,
   DEBUG_COMMAND_INFO(cmd, "TextFrame");
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  if (type == GlyphAtlas::Type::kAlphaBitmap) {
-    cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
-  } else {
-    cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      cmd.pipeline = renderer.GetGlyphAtlasSdfPipeline(opts);
+      break;
   }
   cmd.stencil_reference = entity.GetStencilDepth();
 
   using VS = GlyphAtlasPipeline::VertexShader;
   using FS = GlyphAtlasPipeline::FragmentShader;
+  using SdfFS = GlyphAtlasSdfPipeline::FragmentShader;
+  const bool is_sdf = type == GlyphAtlas::Type::kSignedDistanceField;
 
   // Common vertex uniforms for all glyphs.
   VS::FrameInfo frame_info;
@@ -109,7 +192,6 @@ bool TextContents::Render(const ContentContext& renderer,
   frame_info.atlas_size =
       Vector2{static_cast<Scalar>(atlas->GetTexture()->GetSize().width),
               static_cast<Scalar>(atlas->GetTexture()->GetSize().height)};
-  frame_info.offset = offset_;
   frame_info.is_translation_scale =
       entity.GetTransformation().IsTranslationScaleOnly();
   frame_info.entity_transform = entity.GetTransformation();
@@ -118,7 +200,7 @@ bool TextContents::Render(const ContentContext& renderer,
   VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
 
   SamplerDescriptor sampler_desc;
-  if (frame_info.is_translation_scale) {
+  if (frame_info.is_translation_scale && !is_sdf) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -131,13 +213,20 @@ bool TextContents::Render(const ContentContext& renderer,
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
   sampler_desc.mip_filter = MipFilter::kNearest;
-
-  FS::BindGlyphAtlasSampler(
-      cmd,                  // command
-      atlas->GetTexture(),  // texture
-      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-          sampler_desc)  // sampler
-  );
+  const auto& sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
+
+  if (is_sdf) {
+    // Signed distance fields are always sampled linearly, the outline is
+    // found between the texels.
+    SdfFS::FragInfo frag_info;
+    frag_info.spread = GlyphAtlas::kSignedDistanceFieldSpread;
+    SdfFS::BindFragInfo(cmd,
+                        pass.GetTransientsBuffer().EmplaceUniform(frag_info));
+    SdfFS::BindGlyphAtlasSampler(cmd, atlas->GetTexture(), sampler);
+  } else {
+    FS::BindGlyphAtlasSampler(cmd, atlas->GetTexture(), sampler);
+  }
 
   // Common vertex information for all glyphs.
   // All glyphs are given the same vertex information in the form of a
@@ -152,9 +241,11 @@ bool TextContents::Render(const ContentContext& renderer,
 
   auto& host_buffer = pass.GetTransientsBuffer();
   size_t vertex_count = 0;
-  for (const auto& run : frame_.GetRuns()) {
-    vertex_count += run.GetGlyphPositions().size();
-  }
+  ForEachTextFrame([&vertex_count](const TextContents& text, Vector2 offset) {
+    for (const auto& run : text.frame_.GetRuns()) {
+      vertex_count += run.GetGlyphPositions().size();
+    }
+  });
   vertex_count *= 6;
 
   auto buffer_view = host_buffer.Emplace(
@@ -163,41 +254,51 @@ bool TextContents::Render(const ContentContext& renderer,
         VS::PerVertexData vtx;
         VS::PerVertexData* vtx_contents =
             reinterpret_cast<VS::PerVertexData*>(contents);
-        for (const TextRun& run : frame_.GetRuns()) {
-          const Font& font = run.GetFont();
-          Scalar rounded_scale = TextFrame::RoundScaledFontSize(
-              scale_, font.GetMetrics().point_size);
-          const FontGlyphAtlas* font_atlas =
-              atlas->GetFontGlyphAtlas(font, rounded_scale);
-          if (!font_atlas) {
-            VALIDATION_LOG << "Could not find font in the atlas.";
-            continue;
-          }
-
-          for (const TextRun::GlyphPosition& glyph_position :
-               run.GetGlyphPositions()) {
-            std::optional<Rect> maybe_atlas_glyph_bounds =
-                font_atlas->FindGlyphBounds(glyph_position.glyph);
-            if (!maybe_atlas_glyph_bounds.has_value()) {
-              VALIDATION_LOG << "Could not find glyph position in the atlas.";
+        ForEachTextFrame([&](const TextContents& text, Vector2 offset) {
+          vtx.text_offset = offset;
+          for (const TextRun& run : text.frame_.GetRuns()) {
+            const Font& font = run.GetFont();
+            Scalar rounded_scale = TextFrame::GetAtlasScale(
+                type, text.scale_, font.GetMetrics().point_size);
+            const FontGlyphAtlas* font_atlas =
+                atlas->GetFontGlyphAtlas(font, rounded_scale);
+            if (!font_atlas) {
+              VALIDATION_LOG << "Could not find font in the atlas.";
               continue;
             }
-            const Rect& atlas_glyph_bounds = maybe_atlas_glyph_bounds.value();
-            vtx.atlas_glyph_bounds = Vector4(
-                atlas_glyph_bounds.origin.x, atlas_glyph_bounds.origin.y,
-                atlas_glyph_bounds.size.width, atlas_glyph_bounds.size.height);
-            vtx.glyph_bounds = Vector4(glyph_position.glyph.bounds.origin.x,
-                                       glyph_position.glyph.bounds.origin.y,
-                                       glyph_position.glyph.bounds.size.width,
-                                       glyph_position.glyph.bounds.size.height);
-            vtx.glyph_position = glyph_position.position;
-
-            for (const Point& point : unit_points) {
-              vtx.unit_position = point;
-              std::memcpy(vtx_contents++, &vtx, sizeof(VS::PerVertexData));
+            // The field around the glyphs of a signed distance field atlas
+            // is drawn too.
+            Scalar spread =
+                is_sdf ? GlyphAtlas::kSignedDistanceFieldSpread / rounded_scale
+                       : 0.0f;
+
+            for (const TextRun::GlyphPosition& glyph_position :
+                 run.GetGlyphPositions()) {
+              std::optional<Rect> maybe_atlas_glyph_bounds =
+                  font_atlas->FindGlyphBounds(glyph_position.glyph);
+              if (!maybe_atlas_glyph_bounds.has_value()) {
+                VALIDATION_LOG << "Could not find glyph position in the atlas.";
+                continue;
+              }
+              const Rect& atlas_glyph_bounds = maybe_atlas_glyph_bounds.value();
+              vtx.atlas_glyph_bounds = Vector4(
+                  atlas_glyph_bounds.origin.x, atlas_glyph_bounds.origin.y,
+                  atlas_glyph_bounds.size.width,
+                  atlas_glyph_bounds.size.height);
+              const Rect glyph_bounds =
+                  glyph_position.glyph.bounds.Expand(spread);
+              vtx.glyph_bounds = Vector4(
+                  glyph_bounds.origin.x, glyph_bounds.origin.y,
+                  glyph_bounds.size.width, glyph_bounds.size.height);
+              vtx.glyph_position = glyph_position.position;
+
+              for (const Point& point : unit_points) {
+                vtx.unit_position = point;
+                std::memcpy(vtx_contents++, &vtx, sizeof(VS::PerVertexData));
+              }
             }
           }
-        }
+        });
       });
 
   cmd.BindVertices({
@@ -22,6 +22,12 @@ class Context;
 
 class TextContents final : public Contents {
  public:
+  /// Text drawn by a batch, at an offset from the text of the first element.
+  struct BatchedText {
+    std::shared_ptr<const TextContents> contents;
+    Vector2 offset;
+  };
+
   TextContents();
 
   ~TextContents();
@@ -42,6 +48,39 @@ class TextContents final : public Contents {
 
   std::optional<Rect> GetTextFrameBounds() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the offset, in the local space of |entity|, at which
+  ///             the text of |other| drawn with |other_entity| is drawn, if
+  ///             the two can be drawn with a single command.
+  ///
+  ///             That is the case if they use the same glyph atlas, color,
+  ///             blend mode and stencil depth, and if their transforms only
+  ///             differ by a translation.
+  ///
+  std::optional<Vector2> GetBatchOffset(const Entity& entity,
+                                        const TextContents& other,
+                                        const Entity& other_entity) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates contents that draw the text of all of |batch|, in
+  ///             order, with the entity of the first element and a single
+  ///             command.
+  ///
+  ///             Each element must be batchable with the first, see
+  ///             `GetBatchOffset`.
+  ///
+  static std::shared_ptr<TextContents> MakeBatch(
+      std::vector<BatchedText> batch);
+
+  // |Contents|
+  const TextContents* AsTextContents() const override;
+
+  // |Contents|
+  DrawKind GetDrawKind() const override;
+
+  // |Contents|
+  bool MayWriteStencil() const override;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -61,6 +100,16 @@ class TextContents final : public Contents {
   Color color_;
   Scalar inherited_opacity_ = 1.0;
   Vector2 offset_;
+  // The atlas the glyphs are drawn from, chosen when populating the atlas.
+  GlyphAtlas::Type atlas_type_ = GlyphAtlas::Type::kAlphaBitmap;
+  // Only set for the contents made with `MakeBatch`, which draw this text
+  // instead of |frame_|.
+  std::vector<BatchedText> batch_;
+
+  // Calls |callback| with each text frame to draw and its offset.
+  void ForEachTextFrame(
+      const std::function<void(const TextContents& text, Vector2 offset)>&
+          callback) const;
 
   std::shared_ptr<GlyphAtlas> ResolveAtlas(
       Context& context,
@@ -56,6 +56,19 @@ void TextureContents::SetStencilEnabled(bool enabled) {
 }
 
 bool TextureContents::CanInheritOpacity(const Entity& entity) const {
+  // Opacity applied to overlapping regions would show the one drawn below
+  // through the one drawn above.
+  for (size_t i = 0; i < added_rects_.size(); i++) {
+    const auto& destination = added_rects_[i].second;
+    if (destination.IntersectsWithRect(destination_rect_)) {
+      return false;
+    }
+    for (size_t j = 0; j < i; j++) {
+      if (destination.IntersectsWithRect(added_rects_[j].second)) {
+        return false;
+      }
+    }
+  }
   return true;
 }
 
@@ -67,13 +80,29 @@ Scalar TextureContents::GetOpacity() const {
   return opacity_ * inherited_opacity_;
 }
 
+Contents::DrawKind TextureContents::GetDrawKind() const {
+  return DrawKind::kTexture;
+}
+
+bool TextureContents::MayWriteStencil() const {
+  return false;
+}
+
 std::optional<Rect> TextureContents::GetCoverage(const Entity& entity) const {
   if (GetOpacity() == 0) {
     return std::nullopt;
   }
-  return destination_rect_.TransformBounds(entity.GetTransformation());
+  return GetDestinationBounds().TransformBounds(entity.GetTransformation());
 };
 
+Rect TextureContents::GetDestinationBounds() const {
+  auto bounds = destination_rect_;
+  for (const auto& [source, destination] : added_rects_) {
+    bounds = bounds.Union(destination);
+  }
+  return bounds;
+}
+
 std::optional<Snapshot> TextureContents::RenderToSnapshot(
     const ContentContext& renderer,
     const Entity& entity,
@@ -85,7 +114,8 @@ std::optional<Snapshot> TextureContents::RenderToSnapshot(
   // rects.
   auto bounds = destination_rect_;
   auto opacity = GetOpacity();
-  if (source_rect_ == Rect::MakeSize(texture_->GetSize()) &&
+  if (added_rects_.empty() &&
+      source_rect_ == Rect::MakeSize(texture_->GetSize()) &&
       (opacity >= 1 - kEhCloseEnough || defer_applying_opacity_)) {
     auto scale = Vector2(bounds.size / Size(texture_->GetSize()));
     return Snapshot{
@@ -122,22 +152,40 @@ bool TextureContents::Render(const ContentContext& renderer,
   bool is_external_texture =
       texture_->GetTextureDescriptor().type == TextureType::kTextureExternalOES;
 
-  // Expand the source rect by half a texel, which aligns sampled texels to the
-  // pixel grid if the source rect is the same size as the destination rect.
-  auto texture_coords =
-      Rect::MakeSize(texture_->GetSize())
-          .Project(capture.AddRect("Source rect", source_rect_).Expand(0.5));
-
+  // A single region is drawn as a strip. Batched regions are drawn as a list
+  // of triangles, so that they don't need to be joined with degenerate ones.
+  const bool is_strip = added_rects_.empty();
+  const auto texture_bounds = Rect::MakeSize(texture_->GetSize());
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-
-  auto destination_rect =
-      capture.AddRect("Destination rect", destination_rect_);
-  vertex_builder.AddVertices({
-      {destination_rect.GetLeftTop(), texture_coords.GetLeftTop()},
-      {destination_rect.GetRightTop(), texture_coords.GetRightTop()},
-      {destination_rect.GetLeftBottom(), texture_coords.GetLeftBottom()},
-      {destination_rect.GetRightBottom(), texture_coords.GetRightBottom()},
-  });
+  const auto add_quad = [&](Rect source_rect, Rect destination_rect) {
+    // Expand the source rect by half a texel, which aligns sampled texels to
+    // the pixel grid if the source rect is the same size as the destination
+    // rect.
+    auto texture_coords = texture_bounds.Project(source_rect.Expand(0.5));
+    VS::PerVertexData left_top = {destination_rect.GetLeftTop(),
+                                  texture_coords.GetLeftTop()};
+    VS::PerVertexData right_top = {destination_rect.GetRightTop(),
+                                   texture_coords.GetRightTop()};
+    VS::PerVertexData left_bottom = {destination_rect.GetLeftBottom(),
+                                     texture_coords.GetLeftBottom()};
+    VS::PerVertexData right_bottom = {destination_rect.GetRightBottom(),
+                                      texture_coords.GetRightBottom()};
+    if (is_strip) {
+      vertex_builder.AddVertices(
+          {left_top, right_top, left_bottom, right_bottom});
+    } else {
+      vertex_builder.AddVertices({left_top, right_top, left_bottom, right_top,
+                                  left_bottom, right_bottom});
+    }
+  };
+
+  add_quad(capture.AddRect("Source rect", source_rect_),
+           capture.AddRect("Destination rect", destination_rect_));
+  for (const auto& [source, destination] : added_rects_) {
+    if (!source.IsEmpty() && !destination.size.IsEmpty()) {
+      add_quad(source, destination);
+    }
+  }
 
   auto& host_buffer = pass.GetTransientsBuffer();
 
@@ -158,7 +206,8 @@ bool TextureContents::Render(const ContentContext& renderer,
   if (!stencil_enabled_) {
     pipeline_options.stencil_compare = CompareFunction::kAlways;
   }
-  pipeline_options.primitive_type = PrimitiveType::kTriangleStrip;
+  pipeline_options.primitive_type =
+      is_strip ? PrimitiveType::kTriangleStrip : PrimitiveType::kTriangle;
 
 #ifdef IMPELLER_ENABLE_OPENGLES
   if (is_external_texture) {
@@ -197,6 +246,14 @@ const Rect& TextureContents::GetSourceRect() const {
   return source_rect_;
 }
 
+void TextureContents::AddRect(Rect source_rect, Rect destination_rect) {
+  added_rects_.emplace_back(source_rect, destination_rect);
+}
+
+size_t TextureContents::GetRectCount() const {
+  return added_rects_.size() + 1;
+}
+
 void TextureContents::SetSamplerDescriptor(SamplerDescriptor desc) {
   sampler_descriptor_ = std::move(desc);
 }
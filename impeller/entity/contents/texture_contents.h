@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -44,6 +45,15 @@ class TextureContents final : public Contents {
 
   const Rect& GetSourceRect() const;
 
+  /// @brief  Draws another region of the texture in the same draw call as the
+  ///         source and destination rects. The regions share the sampler and
+  ///         opacity, and are drawn in the order they were added.
+  void AddRect(Rect source_rect, Rect destination_rect);
+
+  /// @brief  The number of regions of the texture that are drawn, including
+  ///         the source and destination rects.
+  size_t GetRectCount() const;
+
   void SetOpacity(Scalar opacity);
 
   Scalar GetOpacity() const;
@@ -53,6 +63,12 @@ class TextureContents final : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  DrawKind GetDrawKind() const override;
+
+  // |Contents|
+  bool MayWriteStencil() const override;
+
   // |Contents|
   std::optional<Snapshot> RenderToSnapshot(
       const ContentContext& renderer,
@@ -87,6 +103,10 @@ class TextureContents final : public Contents {
   Scalar opacity_ = 1.0f;
   Scalar inherited_opacity_ = 1.0f;
   bool defer_applying_opacity_ = false;
+  // (source, destination) pairs drawn after the source and destination rects.
+  std::vector<std::pair<Rect, Rect>> added_rects_;
+
+  Rect GetDestinationBounds() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TextureContents);
 };
@@ -59,7 +59,11 @@ std::optional<Rect> Entity::GetCoverage() const {
     return std::nullopt;
   }
 
-  return contents_->GetCoverage(*this);
+  auto coverage = contents_->GetCoverage(*this);
+  if (coverage.has_value() && scissor_.has_value()) {
+    return coverage->Intersection(scissor_.value());
+  }
+  return coverage;
 }
 
 Contents::StencilCoverage Entity::GetStencilCoverage(
@@ -102,6 +106,14 @@ BlendMode Entity::GetBlendMode() const {
   return blend_mode_;
 }
 
+void Entity::SetScissor(std::optional<Rect> scissor) {
+  scissor_ = scissor;
+}
+
+const std::optional<Rect>& Entity::GetScissor() const {
+  return scissor_;
+}
+
 bool Entity::CanInheritOpacity() const {
   if (!contents_) {
     return false;
@@ -125,6 +137,10 @@ bool Entity::SetInheritedOpacity(Scalar alpha) {
 }
 
 std::optional<Color> Entity::AsBackgroundColor(ISize target_size) const {
+  if (scissor_.has_value() &&
+      !scissor_->Contains(Rect::MakeSize(target_size))) {
+    return std::nullopt;
+  }
   return contents_->AsBackgroundColor(*this, target_size);
 }
 
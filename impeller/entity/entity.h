@@ -85,6 +85,13 @@ class Entity {
 
   BlendMode GetBlendMode() const;
 
+  /// @brief  Limit rendering to an axis-aligned rectangle, in the same space
+  ///         as the coverage of the entity. Rect clips are applied this way
+  ///         instead of through the stencil.
+  void SetScissor(std::optional<Rect> scissor);
+
+  const std::optional<Rect>& GetScissor() const;
+
   bool Render(const ContentContext& renderer, RenderPass& parent_pass) const;
 
   static bool IsBlendModeDestructive(BlendMode blend_mode);
@@ -106,6 +113,7 @@ class Entity {
   std::shared_ptr<Contents> contents_;
   BlendMode blend_mode_ = BlendMode::kSourceOver;
   uint32_t stencil_depth_ = 0u;
+  std::optional<Rect> scissor_;
   mutable Capture capture_;
 };
 
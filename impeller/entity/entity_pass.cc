@@ -6,13 +6,18 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <set>
+#include <string>
 #include <utility>
 #include <variant>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
@@ -24,6 +29,9 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/solid_color_batch_contents.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
@@ -51,6 +59,288 @@ std::tuple<std::optional<Color>, BlendMode> ElementAsBackgroundColor(
   }
   return {};
 }
+
+/// Merges the text drawn by the element at |index| with the text drawn by the
+/// elements right after it, if they can all be drawn with a single command.
+/// Paragraphs usually consist of many runs drawn with the same paint.
+///
+/// On success, |index| is advanced to the last merged element.
+std::optional<Entity> BatchTextElements(
+    const std::vector<EntityPass::Element>& elements,
+    size_t& index) {
+  const Entity* first = std::get_if<Entity>(&elements[index]);
+  const TextContents* first_text =
+      first ? first->GetContents()->AsTextContents() : nullptr;
+  if (!first_text) {
+    return std::nullopt;
+  }
+
+  std::vector<TextContents::BatchedText> batch;
+  for (size_t next = index + 1; next < elements.size(); next++) {
+    const Entity* entity = std::get_if<Entity>(&elements[next]);
+    const TextContents* text =
+        entity ? entity->GetContents()->AsTextContents() : nullptr;
+    if (!text || entity->GetScissor() != first->GetScissor()) {
+      break;
+    }
+    std::optional<Vector2> offset =
+        first_text->GetBatchOffset(*first, *text, *entity);
+    if (!offset.has_value()) {
+      break;
+    }
+    if (batch.empty()) {
+      batch.push_back(
+          {.contents = std::shared_ptr<const TextContents>(
+               first->GetContents(), first_text),
+           .offset = Vector2()});
+    }
+    batch.push_back({.contents = std::shared_ptr<const TextContents>(
+                         entity->GetContents(), text),
+                     .offset = offset.value()});
+  }
+  if (batch.empty()) {
+    return std::nullopt;
+  }
+
+  index += batch.size() - 1;
+  Entity entity = *first;
+  entity.SetContents(TextContents::MakeBatch(std::move(batch)));
+  return entity;
+}
+
+/// Returns the pixels of a pass of |size| inside of |scissor|. Like for stencil
+/// clips, a pixel is inside if its center is.
+std::optional<IRect> ToPassScissor(const Rect& scissor, ISize size) {
+  auto round = [](Scalar value) {
+    return static_cast<int64_t>(std::ceil(value - 0.5f));
+  };
+  return IRect::MakeLTRB(round(scissor.GetLeft()), round(scissor.GetTop()),
+                         round(scissor.GetRight()), round(scissor.GetBottom()))
+      .Intersection(IRect::MakeSize(size));
+}
+
+const SolidColorContents* GetBatchableSolidColor(
+    const EntityPass::Element& element) {
+  const Entity* entity = std::get_if<Entity>(&element);
+  if (!entity || !entity->GetContents() ||
+      entity->GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      entity->GetTransformation().HasPerspective() ||
+      entity->GetContents()->MayWriteStencil()) {
+    return nullptr;
+  }
+  return entity->GetContents()->AsSolidColorContents();
+}
+
+/// Combines the solid color fills starting at `index` that are drawn with the
+/// same blend mode, stencil depth and scissor into one entity, advancing
+/// `index` to the last fill combined.
+std::optional<Entity> BatchSolidColorElements(
+    const std::vector<EntityPass::Element>& elements,
+    size_t& index) {
+  const SolidColorContents* first_fill =
+      GetBatchableSolidColor(elements[index]);
+  if (!first_fill) {
+    return std::nullopt;
+  }
+  const Entity& first = std::get<Entity>(elements[index]);
+
+  auto batch = std::make_shared<SolidColorBatchContents>();
+  if (!batch->AddFill(*first_fill, first.GetTransformation())) {
+    return std::nullopt;
+  }
+  size_t next = index + 1;
+  for (; next < elements.size(); next++) {
+    const SolidColorContents* fill = GetBatchableSolidColor(elements[next]);
+    if (!fill) {
+      break;
+    }
+    const Entity& entity = std::get<Entity>(elements[next]);
+    if (entity.GetBlendMode() != first.GetBlendMode() ||
+        entity.GetStencilDepth() != first.GetStencilDepth() ||
+        entity.GetScissor() != first.GetScissor() ||
+        !batch->AddFill(*fill, entity.GetTransformation())) {
+      break;
+    }
+  }
+  if (batch->GetFillCount() < 2u) {
+    return std::nullopt;
+  }
+
+  index = next - 1;
+  Entity entity = first;
+  entity.SetTransformation(Matrix());
+  entity.SetContents(std::move(batch));
+  return entity;
+}
+
+/// What reordering needs to know about an element.
+struct ReorderInfo {
+  // Whether other draws can't be moved across the element.
+  bool is_barrier = true;
+  Contents::DrawKind kind = Contents::DrawKind::kOther;
+  BlendMode blend_mode = BlendMode::kSourceOver;
+  uint32_t stencil_depth = 0u;
+  Rect coverage;
+
+  bool IsMovable() const { return kind != Contents::DrawKind::kOther; }
+
+  bool IsSameDraw(const ReorderInfo& other) const {
+    return kind == other.kind && blend_mode == other.blend_mode &&
+           stencil_depth == other.stencil_depth;
+  }
+};
+
+ReorderInfo GetReorderInfo(const EntityPass::Element& element) {
+  ReorderInfo info;
+  const Entity* entity = std::get_if<Entity>(&element);
+  if (!entity || !entity->GetContents() ||
+      entity->GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      entity->GetStencilCoverage(std::nullopt).type !=
+          Contents::StencilCoverage::Type::kNoChange) {
+    return info;
+  }
+  auto coverage = entity->GetCoverage();
+  if (!coverage.has_value()) {
+    return info;
+  }
+  info.is_barrier = false;
+  info.kind = entity->GetContents()->GetDrawKind();
+  info.blend_mode = entity->GetBlendMode();
+  info.stencil_depth = entity->GetStencilDepth();
+  // Antialiasing and pixel rounding can touch the pixels around the coverage.
+  info.coverage = coverage->Expand(1);
+  return info;
+}
+
+bool CanBeOccluded(const Entity& entity) {
+  return entity.GetContents() &&
+         entity.GetBlendMode() <= Entity::kLastPipelineBlendMode &&
+         !entity.GetContents()->MayWriteStencil();
+}
+
+// Whether |entity| is hidden by an opaque draw in the elements after
+// |index|.
+bool IsOccluded(const std::vector<EntityPass::Element>& elements,
+                size_t index,
+                const Entity& entity) {
+  auto coverage = entity.GetCoverage();
+  if (!coverage.has_value()) {
+    return false;
+  }
+  // Antialiasing and pixel rounding can touch the pixels around the coverage.
+  const Rect hidden_rect = coverage->Expand(1);
+
+  const size_t end = std::min(elements.size(),
+                              index + 1 + EntityPass::kMaxOcclusionDistance);
+  for (size_t next = index + 1; next < end; next++) {
+    const Entity* next_entity = std::get_if<Entity>(&elements[next]);
+    if (!next_entity || !next_entity->GetContents()) {
+      return false;
+    }
+    const auto& contents = next_entity->GetContents();
+    if (next_entity->GetStencilCoverage(std::nullopt).type !=
+        Contents::StencilCoverage::Type::kNoChange) {
+      return false;
+    }
+    if ((next_entity->GetBlendMode() == BlendMode::kSource ||
+         next_entity->GetBlendMode() == BlendMode::kSourceOver) &&
+        next_entity->GetStencilDepth() == entity.GetStencilDepth() &&
+        (!next_entity->GetScissor().has_value() ||
+         next_entity->GetScissor()->Contains(hidden_rect)) &&
+        contents->IsOpaqueOver(*next_entity, hidden_rect)) {
+      return true;
+    }
+    // Draws that write to the stencil where the entity was drawn change what
+    // the draws after them cover.
+    if (contents->MayWriteStencil()) {
+      auto next_coverage = next_entity->GetCoverage();
+      if (!next_coverage.has_value() ||
+          next_coverage->IntersectsWithRect(hidden_rect)) {
+        return false;
+      }
+    }
+  }
+  return false;
+}
+
+size_t CountPipelineSwitches(const std::vector<ReorderInfo>& infos,
+                             const std::vector<size_t>& order) {
+  size_t count = 0u;
+  for (size_t i = 1; i < order.size(); i++) {
+    const auto& previous = infos[order[i - 1]];
+    const auto& current = infos[order[i]];
+    if (!current.IsMovable() || !current.IsSameDraw(previous)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+bool IsSameClip(const Entity& clip, const Entity& other) {
+  if (other.GetStencilCoverage(std::nullopt).type !=
+          Contents::StencilCoverage::Type::kAppend ||
+      other.GetStencilDepth() != clip.GetStencilDepth() ||
+      other.GetScissor() != clip.GetScissor() ||
+      other.GetTransformation() != clip.GetTransformation()) {
+    return false;
+  }
+  // Only clip contents append to the stencil.
+  return static_cast<const ClipContents&>(*clip.GetContents())
+      .IsEquivalentTo(static_cast<const ClipContents&>(*other.GetContents()));
+}
+
+/// Finds clip restores that are immediately followed by the clip they undo,
+/// like in lists whose items are all clipped to the same shape. Skipping both
+/// leaves the stencil as it was instead of erasing and redrawing the clip.
+class ClipReuseTracker {
+ public:
+  /// Returns whether both the element at `index` and the one after it should
+  /// be skipped. Must be called for every element of the pass in order.
+  bool ShouldSkipRestoreAndClip(
+      const std::vector<EntityPass::Element>& elements,
+      size_t index) {
+    const Entity* entity = std::get_if<Entity>(&elements[index]);
+    if (!entity) {
+      // Collapsed subpasses may clip the parent stencil.
+      clips_.clear();
+      return false;
+    }
+    if (!entity->GetContents()) {
+      return false;
+    }
+    const size_t depth = entity->GetStencilDepth();
+    switch (entity->GetStencilCoverage(std::nullopt).type) {
+      case Contents::StencilCoverage::Type::kNoChange:
+        return false;
+      case Contents::StencilCoverage::Type::kAppend:
+        clips_.resize(depth + 1, nullptr);
+        clips_[depth] = entity;
+        return false;
+      case Contents::StencilCoverage::Type::kRestore: {
+        // The restore must only undo the clip appended at its own depth.
+        // Deeper clips that weren't restored yet would be left behind.
+        const Entity* clip =
+            clips_.size() == depth + 1 ? clips_[depth] : nullptr;
+        clips_.resize(std::min(clips_.size(), depth));
+        if (!clip || index + 1 >= elements.size()) {
+          return false;
+        }
+        const Entity* next = std::get_if<Entity>(&elements[index + 1]);
+        if (!next || !next->GetContents() || !IsSameClip(*clip, *next)) {
+          return false;
+        }
+        clips_.resize(depth + 1, nullptr);
+        clips_[depth] = next;
+        return true;
+      }
+    }
+    FML_UNREACHABLE();
+  }
+
+ private:
+  // The clip that appended each stencil depth, if it's known.
+  std::vector<const Entity*> clips_;
+};
 }  // namespace
 
 const std::string EntityPass::kCaptureDocumentName = "EntityPass";
@@ -103,19 +393,51 @@ size_t EntityPass::GetSubpassesDepth() const {
 
 std::optional<Rect> EntityPass::GetElementsCoverage(
     std::optional<Rect> coverage_limit) const {
+  // The clips of the pass limit the coverage of the elements after them like
+  // the stencil does once they are rendered, so that a layer only needs to be
+  // as large as the clipped area its contents draw to.
+  StencilCoverageStack clip_stack = {StencilCoverageLayer{
+      .coverage = coverage_limit.value_or(Rect::MakeMaximum()),
+      .stencil_depth = stencil_depth_}};
+
   std::optional<Rect> result;
   for (const auto& element : elements_) {
     std::optional<Rect> coverage;
+    const std::optional<Rect> clip_coverage = clip_stack.back().coverage;
+    const bool is_clipped = coverage_limit.has_value() || clip_stack.size() > 1;
 
     if (auto entity = std::get_if<Entity>(&element)) {
+      auto stencil_coverage = entity->GetStencilCoverage(clip_coverage);
+      switch (stencil_coverage.type) {
+        case Contents::StencilCoverage::Type::kNoChange:
+          break;
+        case Contents::StencilCoverage::Type::kAppend:
+          clip_stack.push_back(StencilCoverageLayer{
+              .coverage = stencil_coverage.coverage,
+              .stencil_depth = entity->GetStencilDepth() + 1});
+          continue;
+        case Contents::StencilCoverage::Type::kRestore:
+          while (clip_stack.size() > 1 &&
+                 clip_stack.back().stencil_depth > entity->GetStencilDepth()) {
+            clip_stack.pop_back();
+          }
+          continue;
+      }
+      if (!clip_coverage.has_value()) {
+        continue;  // Everything is clipped out.
+      }
       coverage = entity->GetCoverage();
 
-      if (coverage.has_value() && coverage_limit.has_value()) {
-        coverage = coverage->Intersection(coverage_limit.value());
+      if (coverage.has_value() && is_clipped) {
+        coverage = coverage->Intersection(clip_coverage.value());
       }
     } else if (auto subpass =
                    std::get_if<std::unique_ptr<EntityPass>>(&element)) {
-      coverage = GetSubpassCoverage(*subpass->get(), coverage_limit);
+      if (!clip_coverage.has_value()) {
+        continue;
+      }
+      coverage = GetSubpassCoverage(
+          *subpass->get(), is_clipped ? clip_coverage : std::nullopt);
     } else {
       FML_UNREACHABLE();
     }
@@ -200,7 +522,8 @@ static RenderTarget::AttachmentConfig GetDefaultStencilConfig(bool readable) {
 static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
                                            ISize size,
                                            bool readable,
-                                           const Color& clear_color) {
+                                           const Color& clear_color,
+                                           PixelFormat color_format) {
   auto context = renderer.GetContext();
 
   /// All of the load/store actions are managed by `InlinePassContext` when
@@ -209,33 +532,35 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
   /// changed for the lifetime of the textures.
 
   RenderTarget target;
-  if (context->GetCapabilities()->SupportsOffscreenMSAA()) {
+  if (renderer.ShouldUseOffscreenMSAA()) {
     target = RenderTarget::CreateOffscreenMSAA(
-        *context,                          // context
-        *renderer.GetRenderTargetCache(),  // allocator
-        size,                              // size
-        "EntityPass",                      // label
+        *context,                           // context
+        *renderer.GetRenderTargetCache(),   // allocator
+        size,                               // size
+        "EntityPass",                       // label
         RenderTarget::AttachmentConfigMSAA{
             .storage_mode = StorageMode::kDeviceTransient,
             .resolve_storage_mode = StorageMode::kDevicePrivate,
             .load_action = LoadAction::kDontCare,
             .store_action = StoreAction::kMultisampleResolve,
-            .clear_color = clear_color},   // color_attachment_config
-        GetDefaultStencilConfig(readable)  // stencil_attachment_config
+            .clear_color = clear_color},    // color_attachment_config
+        GetDefaultStencilConfig(readable),  // stencil_attachment_config
+        color_format                        // color_format
     );
   } else {
     target = RenderTarget::CreateOffscreen(
-        *context,                          // context
-        *renderer.GetRenderTargetCache(),  // allocator
-        size,                              // size
-        "EntityPass",                      // label
+        *context,                           // context
+        *renderer.GetRenderTargetCache(),   // allocator
+        size,                               // size
+        "EntityPass",                       // label
         RenderTarget::AttachmentConfig{
             .storage_mode = StorageMode::kDevicePrivate,
             .load_action = LoadAction::kDontCare,
             .store_action = StoreAction::kDontCare,
             .clear_color = clear_color,
-        },                                 // color_attachment_config
-        GetDefaultStencilConfig(readable)  // stencil_attachment_config
+        },                                  // color_attachment_config
+        GetDefaultStencilConfig(readable),  // stencil_attachment_config
+        color_format                        // color_format
     );
   }
 
@@ -296,9 +621,11 @@ bool EntityPass::Render(ContentContext& renderer,
   // and then blit the results onto the onscreen texture. If using this branch,
   // there's no need to set up a stencil attachment on the root render target.
   if (!supports_onscreen_backdrop_reads && reads_from_onscreen_backdrop) {
+    // The offscreen is blitted to the root, so their formats must match.
     auto offscreen_target = CreateRenderTarget(
         renderer, root_render_target.GetRenderTargetSize(), true,
-        GetClearColor(render_target.GetRenderTargetSize()));
+        GetClearColor(render_target.GetRenderTargetSize()),
+        root_render_target.GetRenderTargetPixelFormat());
 
     if (!OnRender(renderer,  // renderer
                   capture,   // capture
@@ -449,6 +776,10 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       element_entity.SetTransformation(
           Matrix::MakeTranslation(Vector3(-global_pass_position)) *
           element_entity.GetTransformation());
+      if (auto scissor = element_entity.GetScissor(); scissor.has_value()) {
+        scissor->origin -= global_pass_position;
+        element_entity.SetScissor(scissor);
+      }
     }
   }
 
@@ -485,24 +816,12 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
         // cases.
         return EntityPass::EntityResult::Failure();
       }
+      // The collapsed elements were drawn to the parent pass without being
+      // tracked by it.
+      pass_context.MarkDrawnCoverageUnknown();
       return EntityPass::EntityResult::Skip();
     }
 
-    std::shared_ptr<Contents> subpass_backdrop_filter_contents = nullptr;
-    if (subpass->backdrop_filter_proc_) {
-      auto texture = pass_context.GetTexture();
-      // Render the backdrop texture before any of the pass elements.
-      const auto& proc = subpass->backdrop_filter_proc_;
-      subpass_backdrop_filter_contents = proc(
-          FilterInput::Make(std::move(texture)), subpass->xformation_.Basis(),
-          /*is_subpass*/ true);
-
-      // The subpass will need to read from the current pass texture when
-      // rendering the backdrop, so if there's an active pass, end it prior to
-      // rendering the subpass.
-      pass_context.EndPass();
-    }
-
     if (stencil_coverage_stack.empty()) {
       // The current clip is empty. This means the pass texture won't be
       // visible, so skip it.
@@ -529,13 +848,16 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
 
     coverage_limit =
         coverage_limit->Intersection(Rect::MakeSize(root_pass_size));
+    if (coverage_limit.has_value() && subpass->scissor_.has_value()) {
+      coverage_limit = coverage_limit->Intersection(subpass->scissor_.value());
+    }
     if (!coverage_limit.has_value()) {
       capture.CreateChild("Subpass Entity (Skipped: Empty coverage limit B)");
       return EntityPass::EntityResult::Skip();
     }
 
     auto subpass_coverage =
-        (subpass->flood_clip_ || subpass_backdrop_filter_contents)
+        (subpass->flood_clip_ || subpass->backdrop_filter_proc_)
             ? coverage_limit
             : GetSubpassCoverage(*subpass, coverage_limit);
     if (!subpass_coverage.has_value()) {
@@ -549,11 +871,47 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       return EntityPass::EntityResult::Skip();
     }
 
+    std::shared_ptr<Contents> subpass_backdrop_filter_contents = nullptr;
+    if (subpass->backdrop_filter_proc_) {
+      // Render the backdrop texture before any of the pass elements.
+      const auto& proc = subpass->backdrop_filter_proc_;
+      auto backdrop_filter =
+          proc(FilterInput::Make(pass_context.GetTexture()),
+               subpass->xformation_.Basis(), /*is_subpass*/ true);
+
+      // If the filter doesn't read anything drawn by the current pass, like
+      // the second of two backdrop filters that are far enough apart, it can
+      // read the texture the pass started with. Otherwise the subpass needs to
+      // read from the current pass texture, so end the active pass prior to
+      // rendering the subpass.
+      auto read_coverage =
+          backdrop_filter
+              ? backdrop_filter->GetSourceCoverage(
+                    Matrix(),
+                    Rect(subpass_coverage->origin - global_pass_position,
+                         subpass_coverage->size))
+              : std::nullopt;
+      auto undrawn_texture =
+          read_coverage.has_value()
+              ? pass_context.GetUndrawnTexture(read_coverage.value())
+              : nullptr;
+      if (undrawn_texture) {
+        backdrop_filter =
+            proc(FilterInput::Make(std::move(undrawn_texture)),
+                 subpass->xformation_.Basis(), /*is_subpass*/ true);
+      } else {
+        pass_context.EndPass();
+      }
+      subpass_backdrop_filter_contents = std::move(backdrop_filter);
+    }
+
     auto subpass_target = CreateRenderTarget(
         renderer,                                  // renderer
         subpass_size,                              // size
         subpass->GetTotalPassReads(renderer) > 0,  // readable
-        subpass->GetClearColor(subpass_size));     // clear_color
+        subpass->GetClearColor(subpass_size),      // clear_color
+        renderer.GetDeviceCapabilities()
+            .GetDefaultOffscreenColorFormat());    // color_format
 
     if (!subpass_target.IsValid()) {
       VALIDATION_LOG << "Subpass render target is invalid.";
@@ -611,6 +969,12 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
     element_entity.SetBlendMode(subpass->blend_mode_);
     element_entity.SetTransformation(Matrix::MakeTranslation(
         Vector3(subpass_coverage->origin - global_pass_position)));
+    // Filters applied to the subpass texture may draw outside of it.
+    if (subpass->scissor_.has_value()) {
+      element_entity.SetScissor(
+          Rect(subpass->scissor_->origin - global_pass_position,
+               subpass->scissor_->size));
+    }
   } else {
     FML_UNREACHABLE();
   }
@@ -618,6 +982,38 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
   return EntityPass::EntityResult::Success(element_entity);
 }
 
+#ifdef IMPELLER_ENABLE_CAPTURE
+/// Records the commands that rendering an entity added to `pass`, starting
+/// at `first_command`, and the CPU time it took to encode them.
+static void CaptureEntityCommands(Capture& capture,
+                                  const RenderPass& pass,
+                                  size_t first_command,
+                                  fml::TimeDelta encode_time) {
+  const auto& commands = pass.GetCommands();
+  std::set<std::string> labels;
+  std::string pipelines;
+  for (size_t i = first_command; i < commands.size(); i++) {
+    if (!commands[i].pipeline) {
+      continue;
+    }
+    const std::string& label =
+        commands[i].pipeline->GetDescriptor().GetLabel();
+    if (!labels.insert(label).second) {
+      continue;
+    }
+    pipelines += pipelines.empty() ? label : ", " + label;
+  }
+  capture.AddString("Pipelines", pipelines, {.readonly = true});
+  capture.AddInteger("Draw Count",
+                     static_cast<int>(commands.size() - first_command),
+                     {.readonly = true});
+  capture.AddRect("Render Target", Rect::MakeSize(pass.GetRenderTargetSize()),
+                  {.readonly = true});
+  capture.AddScalar("Encode Time (us)", encode_time.ToMicrosecondsF(),
+                    {.readonly = true});
+}
+#endif  // IMPELLER_ENABLE_CAPTURE
+
 bool EntityPass::OnRender(
     ContentContext& renderer,
     Capture& capture,
@@ -702,8 +1098,15 @@ bool EntityPass::OnRender(
     // The coverage hint tells the rendered Contents which portion of the
     // rendered output will actually be used, and so we set this to the current
     // stencil coverage (which is the max clip bounds). The contents may
-    // optionally use this hint to avoid unnecessary rendering work.
-    element_entity.GetContents()->SetCoverageHint(current_stencil_coverage);
+    // optionally use this hint to avoid unnecessary rendering work. Nothing
+    // outside of the scissor is used either.
+    auto coverage_hint = current_stencil_coverage;
+    if (coverage_hint.has_value() && element_entity.GetScissor().has_value()) {
+      coverage_hint =
+          coverage_hint->Intersection(element_entity.GetScissor().value())
+              .value_or(coverage_hint.value());
+    }
+    element_entity.GetContents()->SetCoverageHint(coverage_hint);
 
     switch (stencil_coverage.type) {
       case Contents::StencilCoverage::Type::kNoChange:
@@ -767,9 +1170,38 @@ bool EntityPass::OnRender(
     }
 #endif
 
+    std::optional<IRect> scissor;
+    if (element_entity.GetScissor().has_value()) {
+      scissor = ToPassScissor(element_entity.GetScissor().value(),
+                              result.pass->GetRenderTargetSize());
+      if (!scissor.has_value()) {
+        return true;  // Nothing to render.
+      }
+    }
+
+    if (auto coverage = element_entity.GetCoverage(); coverage.has_value()) {
+      pass_context.AddDrawnCoverage(coverage.value());
+    }
+
     element_entity.SetStencilDepth(element_entity.GetStencilDepth() -
                                    stencil_depth_floor);
-    if (!element_entity.Render(renderer, *result.pass)) {
+    result.pass->SetScissor(scissor);
+#ifdef IMPELLER_ENABLE_CAPTURE
+    const bool capturing = element_entity.GetCapture().IsActive();
+    const size_t first_command = result.pass->GetCommands().size();
+    const fml::TimePoint encode_start =
+        capturing ? fml::TimePoint::Now() : fml::TimePoint();
+#endif
+    bool rendered = element_entity.Render(renderer, *result.pass);
+#ifdef IMPELLER_ENABLE_CAPTURE
+    if (capturing) {
+      CaptureEntityCommands(element_entity.GetCapture(), *result.pass,
+                            first_command,
+                            fml::TimePoint::Now() - encode_start);
+    }
+#endif
+    result.pass->SetScissor(std::nullopt);
+    if (!rendered) {
       VALIDATION_LOG << "Failed to render entity.";
       return false;
     }
@@ -799,19 +1231,36 @@ bool EntityPass::OnRender(
                                     // Backdrop filters act as a entity before
                                     // everything and disrupt the optimization.
                                     !backdrop_filter_proc_;
-  for (const auto& element : elements_) {
+  ClipReuseTracker clip_reuse_tracker;
+  for (size_t index = 0; index < elements_.size(); index++) {
+    if (clip_reuse_tracker.ShouldSkipRestoreAndClip(elements_, index)) {
+      index++;
+      continue;
+    }
+    const Element* element = &elements_[index];
     // Skip elements that are incorporated into the clear color.
     if (is_collapsing_clear_colors) {
       auto [entity_color, _] =
-          ElementAsBackgroundColor(element, root_pass_size);
+          ElementAsBackgroundColor(*element, root_pass_size);
       if (entity_color.has_value()) {
         continue;
       }
       is_collapsing_clear_colors = false;
     }
 
+    // Draw runs of text that share the glyph atlas, and runs of solid color
+    // fills, with a single command.
+    Element batch;
+    if (auto batch_entity = BatchTextElements(elements_, index)) {
+      batch = std::move(batch_entity.value());
+      element = &batch;
+    } else if (auto fill_entity = BatchSolidColorElements(elements_, index)) {
+      batch = std::move(fill_entity.value());
+      element = &batch;
+    }
+
     EntityResult result =
-        GetEntityForElement(element,                 // element
+        GetEntityForElement(*element,                // element
                             renderer,                // renderer
                             capture,                 // capture
                             pass_context,            // pass_context
@@ -854,6 +1303,29 @@ bool EntityPass::OnRender(
         // to the render target texture so far need to execute before it's bound
         // for blending (otherwise the blend pass will end up executing before
         // all the previous commands in the active pass).
+        //
+        // Outside of the source, every advanced blend leaves the backdrop as
+        // it is. So the blend is scissored to the pixels the source covers,
+        // and only those are read from the backdrop and written back, rather
+        // than the whole pass texture.
+
+        auto src_coverage = result.entity.GetCoverage();
+        if (!src_coverage.has_value()) {
+          continue;
+        }
+        auto blend_scissor = std::optional<Rect>(Rect::MakeLTRB(
+            std::floor(src_coverage->GetLeft()),
+            std::floor(src_coverage->GetTop()),
+            std::ceil(src_coverage->GetRight()),
+            std::ceil(src_coverage->GetBottom())));
+        if (result.entity.GetScissor().has_value()) {
+          blend_scissor =
+              blend_scissor->Intersection(result.entity.GetScissor().value());
+          if (!blend_scissor.has_value()) {
+            continue;
+          }
+        }
+        result.entity.SetScissor(blend_scissor);
 
         if (!pass_context.EndPass()) {
           VALIDATION_LOG
@@ -921,6 +1393,113 @@ bool EntityPass::OnRender(
   return true;
 }
 
+EntityPass::DrawReorderingStatistics EntityPass::ReorderElements() {
+  DrawReorderingStatistics statistics;
+
+  std::vector<ReorderInfo> infos;
+  infos.reserve(elements_.size());
+  for (auto& element : elements_) {
+    infos.push_back(GetReorderInfo(element));
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      auto subpass_statistics = subpass->get()->ReorderElements();
+      statistics.pipeline_switches_before +=
+          subpass_statistics.pipeline_switches_before;
+      statistics.pipeline_switches_after +=
+          subpass_statistics.pipeline_switches_after;
+    }
+  }
+
+  // Each movable draw pulls the later draws of the same kind right behind it,
+  // as long as they don't overlap any of the draws they'd move ahead of.
+  std::vector<size_t> order;
+  order.reserve(elements_.size());
+  std::vector<bool> is_placed(elements_.size(), false);
+  std::vector<Rect> passed_coverage;
+  for (size_t index = 0; index < elements_.size(); index++) {
+    if (is_placed[index]) {
+      continue;
+    }
+    order.push_back(index);
+    is_placed[index] = true;
+    if (!infos[index].IsMovable()) {
+      continue;
+    }
+
+    passed_coverage.clear();
+    const size_t end =
+        std::min(elements_.size(), index + 1 + kMaxReorderDistance);
+    for (size_t next = index + 1; next < end; next++) {
+      if (is_placed[next]) {
+        continue;
+      }
+      const auto& info = infos[next];
+      if (info.is_barrier) {
+        break;
+      }
+      bool can_move = info.IsSameDraw(infos[index]);
+      for (size_t i = 0; can_move && i < passed_coverage.size(); i++) {
+        can_move = !passed_coverage[i].IntersectsWithRect(info.coverage);
+      }
+      if (can_move) {
+        order.push_back(next);
+        is_placed[next] = true;
+      } else {
+        passed_coverage.push_back(info.coverage);
+      }
+    }
+  }
+
+  std::vector<size_t> recorded_order(elements_.size());
+  for (size_t i = 0; i < recorded_order.size(); i++) {
+    recorded_order[i] = i;
+  }
+  statistics.pipeline_switches_before +=
+      CountPipelineSwitches(infos, recorded_order);
+  statistics.pipeline_switches_after += CountPipelineSwitches(infos, order);
+
+  if (order != recorded_order) {
+    std::vector<Element> elements;
+    elements.reserve(elements_.size());
+    for (auto index : order) {
+      elements.push_back(std::move(elements_[index]));
+    }
+    elements_ = std::move(elements);
+  }
+
+  return statistics;
+}
+
+size_t EntityPass::CullOccludedElements() {
+  size_t culled_count = 0u;
+  std::vector<bool> is_occluded(elements_.size(), false);
+  for (size_t index = 0; index < elements_.size(); index++) {
+    auto& element = elements_[index];
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      culled_count += subpass->get()->CullOccludedElements();
+      continue;
+    }
+    const auto& entity = std::get<Entity>(element);
+    if (CanBeOccluded(entity) && IsOccluded(elements_, index, entity)) {
+      is_occluded[index] = true;
+    }
+  }
+
+  size_t kept_count = 0u;
+  for (size_t index = 0; index < elements_.size(); index++) {
+    if (is_occluded[index]) {
+      culled_count++;
+      continue;
+    }
+    if (kept_count != index) {
+      elements_[kept_count] = std::move(elements_[index]);
+    }
+    kept_count++;
+  }
+  elements_.resize(kept_count);
+
+  return culled_count;
+}
+
 void EntityPass::IterateAllElements(
     const std::function<bool(Element&)>& iterator) {
   if (!iterator) {
@@ -1002,6 +1581,145 @@ size_t EntityPass::GetElementCount() const {
   return elements_.size();
 }
 
+size_t EntityPass::MergeNestedSubpasses() {
+  size_t merged_count = 0u;
+  for (auto& element : elements_) {
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      merged_count += subpass->get()->MergeNestedSubpasses();
+      while (subpass->get()->MergeOnlyChildSubpass()) {
+        merged_count++;
+      }
+    }
+  }
+  return merged_count;
+}
+
+void EntityPass::ClipToScissors() {
+  ClipToScissors(scissor_);
+}
+
+void EntityPass::ClipToScissors(const std::optional<Rect>& pass_scissor) {
+  std::vector<Element> elements;
+  elements.reserve(elements_.size());
+
+  // The scissor and stencil depth of the clip the elements are drawn in.
+  std::optional<std::pair<Rect, size_t>> clip;
+  auto restore_clip = [&elements, &clip]() {
+    if (!clip.has_value()) {
+      return;
+    }
+    Entity restore;
+    restore.SetContents(std::make_shared<ClipRestoreContents>());
+    restore.SetStencilDepth(clip->second);
+    restore.SetScissor(clip->first);
+    elements.push_back(std::move(restore));
+    clip.reset();
+  };
+
+  for (auto& element : elements_) {
+    auto entity = std::get_if<Entity>(&element);
+    auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element);
+    const std::optional<Rect>& scissor =
+        entity ? entity->GetScissor() : subpass->get()->GetScissor();
+    const size_t stencil_depth = entity ? entity->GetStencilDepth()
+                                        : subpass->get()->GetStencilDepth();
+
+    if (!clip.has_value() || scissor != clip->first) {
+      restore_clip();
+      if (scissor.has_value() && scissor != pass_scissor) {
+        auto contents = std::make_shared<ClipContents>();
+        contents->SetGeometry(Geometry::MakeRect(scissor.value()));
+        contents->SetClipOperation(Entity::ClipOperation::kIntersect);
+        Entity clip_entity;
+        clip_entity.SetContents(std::move(contents));
+        clip_entity.SetStencilDepth(stencil_depth);
+        clip_entity.SetScissor(scissor);
+        elements.push_back(std::move(clip_entity));
+        clip = std::make_pair(scissor.value(), stencil_depth);
+      }
+    }
+
+    if (clip.has_value()) {
+      if (entity) {
+        entity->IncrementStencilDepth(1);
+      } else {
+        // The depths of the elements of subpasses are those of their root.
+        subpass->get()->SetStencilDepth(subpass->get()->GetStencilDepth() + 1);
+        subpass->get()->IterateAllElements([](Element& nested) {
+          if (auto nested_entity = std::get_if<Entity>(&nested)) {
+            nested_entity->IncrementStencilDepth(1);
+          } else {
+            auto& nested_pass = std::get<std::unique_ptr<EntityPass>>(nested);
+            nested_pass->SetStencilDepth(nested_pass->GetStencilDepth() + 1);
+          }
+          return true;
+        });
+      }
+    }
+    if (subpass) {
+      subpass->get()->ClipToScissors(subpass->get()->GetScissor());
+    }
+    elements.push_back(std::move(element));
+  }
+  restore_clip();
+
+  elements_ = std::move(elements);
+}
+
+bool EntityPass::MergeOnlyChildSubpass() {
+  if (elements_.size() != 1u) {
+    return false;
+  }
+  auto child_pointer = std::get_if<std::unique_ptr<EntityPass>>(&elements_[0]);
+  if (!child_pointer) {
+    return false;
+  }
+  const EntityPass& child = **child_pointer;
+
+  // Backdrop filters read what is under the subpass, which merging changes.
+  if (backdrop_filter_proc_ || child.backdrop_filter_proc_ ||
+      child.blend_mode_ != BlendMode::kSourceOver ||
+      child.stencil_depth_ != stencil_depth_ || child.scissor_ != scissor_) {
+    return false;
+  }
+
+  std::optional<Rect> bounds_limit = bounds_limit_;
+  if (child.bounds_limit_.has_value()) {
+    // Bounds limits are in the local space of their pass.
+    if (child.xformation_ != xformation_) {
+      return false;
+    }
+    bounds_limit = bounds_limit.has_value()
+                       ? bounds_limit->Intersection(child.bounds_limit_.value())
+                             .value_or(Rect{})
+                       : child.bounds_limit_;
+  }
+
+  auto opacity = child.delegate_->GetPlainOpacity();
+  if (!opacity.has_value()) {
+    return false;
+  }
+  auto delegate = delegate_->MakeWithOpacity(opacity.value());
+  if (!delegate) {
+    return false;
+  }
+
+  std::unique_ptr<EntityPass> merged = std::move(*child_pointer);
+  elements_ = std::move(merged->elements_);
+  for (auto& element : elements_) {
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      subpass->get()->superpass_ = this;
+    }
+  }
+  delegate_ = std::move(delegate);
+  bounds_limit_ = bounds_limit;
+  advanced_blend_reads_from_pass_texture_ =
+      merged->advanced_blend_reads_from_pass_texture_;
+  backdrop_filter_reads_from_pass_texture_ =
+      merged->backdrop_filter_reads_from_pass_texture_;
+  return true;
+}
+
 std::unique_ptr<EntityPass> EntityPass::Clone() const {
   std::vector<Element> new_elements;
   new_elements.reserve(elements_.size());
@@ -1027,6 +1745,7 @@ std::unique_ptr<EntityPass> EntityPass::Clone() const {
   pass->backdrop_filter_proc_ = backdrop_filter_proc_;
   pass->blend_mode_ = blend_mode_;
   pass->delegate_ = delegate_;
+  pass->scissor_ = scissor_;
   // Note: I tried also adding flood clip and bounds limit but one of the
   // two caused rendering in wonderous to break. It's 10:51 PM, and I'm
   // ready to move on.
@@ -1045,6 +1764,14 @@ size_t EntityPass::GetStencilDepth() {
   return stencil_depth_;
 }
 
+void EntityPass::SetScissor(std::optional<Rect> scissor) {
+  scissor_ = scissor;
+}
+
+const std::optional<Rect>& EntityPass::GetScissor() const {
+  return scissor_;
+}
+
 void EntityPass::SetBlendMode(BlendMode blend_mode) {
   blend_mode_ = blend_mode;
   flood_clip_ = Entity::IsBlendModeDestructive(blend_mode);
@@ -133,6 +133,12 @@ class EntityPass {
 
   size_t GetStencilDepth();
 
+  /// @brief  Limit the texture of this pass, and the pass itself when drawn
+  ///         into its parent, to a rectangle in root pass space.
+  void SetScissor(std::optional<Rect> scissor);
+
+  const std::optional<Rect>& GetScissor() const;
+
   void SetBlendMode(BlendMode blend_mode);
 
   Color GetClearColor(ISize size = ISize::Infinite()) const;
@@ -148,6 +154,64 @@ class EntityPass {
   std::optional<Rect> GetElementsCoverage(
       std::optional<Rect> coverage_limit) const;
 
+  struct DrawReorderingStatistics {
+    /// The number of times consecutive elements switch between kinds of draws
+    /// (see `Contents::DrawKind`), which approximates the number of pipeline
+    /// changes, in the recorded order and in the reordered one.
+    size_t pipeline_switches_before = 0u;
+    size_t pipeline_switches_after = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief  Reorder the elements of this pass and of its subpasses so that
+  ///         draws of the same kind follow each other, without changing the
+  ///         rendered result.
+  ///
+  ///         A draw is only moved ahead of the draws it doesn't overlap, and
+  ///         never across subpasses, clips or advanced blends. It only looks
+  ///         a limited number of elements ahead.
+  ///
+  DrawReorderingStatistics ReorderElements();
+
+  static constexpr size_t kMaxReorderDistance = 32u;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Remove the draws of this pass and of its subpasses that are
+  ///         completely hidden by an opaque draw after them.
+  ///
+  ///         Only a limited number of elements after each draw are searched
+  ///         for an opaque draw that covers it, up to the next subpass or
+  ///         clip.
+  ///
+  /// @return The number of removed draws.
+  ///
+  size_t CullOccludedElements();
+
+  static constexpr size_t kMaxOcclusionDistance = 32u;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Merge the subpasses of this pass, and of its subpasses, whose
+  ///         only element is a subpass drawn with nothing but an opacity into
+  ///         that subpass, so that the chain renders to a single offscreen
+  ///         texture. The opacity is folded into the delegate of the parent.
+  ///
+  /// @return The number of removed subpasses.
+  ///
+  size_t MergeNestedSubpasses();
+
+  //----------------------------------------------------------------------------
+  /// @brief  Clip the elements of this pass and of its subpasses to their
+  ///         scissors with the stencil too, for drawing them under a
+  ///         transformation that doesn't keep the scissors axis-aligned.
+  ///
+  ///         The scissors can then be widened to their transformed bounds
+  ///         while the clips stay exact. Each run of elements with the same
+  ///         scissor, other than that of their pass, is drawn one stencil
+  ///         level deeper, between a rect clip and its restore. The clips are
+  ///         untransformed, like the scissors.
+  ///
+  void ClipToScissors();
+
  private:
   struct EntityResult {
     enum Status {
@@ -263,6 +327,7 @@ class EntityPass {
   bool flood_clip_ = false;
   bool enable_offscreen_debug_checkerboard_ = false;
   std::optional<Rect> bounds_limit_;
+  std::optional<Rect> scissor_;
 
   /// These values are incremented whenever something is added to the pass that
   /// requires reading from the backdrop texture. Currently, this can happen in
@@ -277,6 +342,14 @@ class EntityPass {
 
   uint32_t GetTotalPassReads(ContentContext& renderer) const;
 
+  /// Replaces the only element of this pass, if it is a subpass that can be
+  /// merged into it, with the elements of that subpass.
+  bool MergeOnlyChildSubpass();
+
+  /// Clips the elements whose scissor differs from `pass_scissor`, which the
+  /// pass itself is clipped to.
+  void ClipToScissors(const std::optional<Rect>& pass_scissor);
+
   BackdropFilterProc backdrop_filter_proc_ = nullptr;
 
   std::shared_ptr<EntityPassDelegate> delegate_ =
@@ -11,6 +11,15 @@ EntityPassDelegate::EntityPassDelegate() = default;
 
 EntityPassDelegate::~EntityPassDelegate() = default;
 
+std::optional<Scalar> EntityPassDelegate::GetPlainOpacity() {
+  return std::nullopt;
+}
+
+std::shared_ptr<EntityPassDelegate> EntityPassDelegate::MakeWithOpacity(
+    Scalar opacity) {
+  return nullptr;
+}
+
 class DefaultEntityPassDelegate final : public EntityPassDelegate {
  public:
   DefaultEntityPassDelegate() = default;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/texture.h"
@@ -32,6 +33,15 @@ class EntityPassDelegate {
       std::shared_ptr<Texture> target,
       const Matrix& effect_transform) = 0;
 
+  /// @brief  If all the delegate does to the pass texture is drawing it with a
+  ///         source over blend at some opacity, returns that opacity.
+  virtual std::optional<Scalar> GetPlainOpacity();
+
+  /// @brief  Returns a delegate that draws the pass texture like this one,
+  ///         with its opacity multiplied by `opacity`, or `nullptr` if there
+  ///         is no such delegate.
+  virtual std::shared_ptr<EntityPassDelegate> MakeWithOpacity(Scalar opacity);
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(EntityPassDelegate);
 };
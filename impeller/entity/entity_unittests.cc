@@ -19,11 +19,15 @@
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
+#include "impeller/entity/contents/filters/color_matrix_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
 #include "impeller/entity/contents/radial_gradient_contents.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
+#include "impeller/entity/contents/solid_color_batch_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/entity/contents/sweep_gradient_contents.h"
@@ -157,6 +161,131 @@ TEST_P(EntityTest, EntityPassCanMergeSubpassIntoParent) {
   ASSERT_TRUE(OpenPlaygroundHere(pass));
 }
 
+TEST_P(EntityTest, EntityPassReordersDrawsThatDontOverlap) {
+  auto make_solid = [](Rect rect) {
+    Entity entity;
+    entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddRect(rect).TakePath(), Color::Red()));
+    return entity;
+  };
+  auto make_texture = [](Rect rect) {
+    Entity entity;
+    entity.SetContents(TextureContents::MakeRect(rect));
+    return entity;
+  };
+
+  EntityPass pass;
+  pass.AddEntity(make_solid(Rect::MakeXYWH(0, 0, 10, 10)));
+  pass.AddEntity(make_texture(Rect::MakeXYWH(20, 0, 10, 10)));
+  pass.AddEntity(make_solid(Rect::MakeXYWH(40, 0, 10, 10)));
+  pass.AddEntity(make_texture(Rect::MakeXYWH(0, 0, 50, 10)));
+  // Overlaps the texture drawn before it, so it has to stay behind it.
+  pass.AddEntity(make_solid(Rect::MakeXYWH(25, 0, 10, 10)));
+
+  auto statistics = pass.ReorderElements();
+  ASSERT_EQ(statistics.pipeline_switches_before, 4u);
+  ASSERT_EQ(statistics.pipeline_switches_after, 2u);
+
+  std::vector<Rect> coverages;
+  pass.IterateAllEntities([&coverages](const Entity& entity) {
+    coverages.push_back(entity.GetCoverage().value());
+    return true;
+  });
+  ASSERT_EQ(coverages.size(), 5u);
+  ASSERT_RECT_NEAR(coverages[0], Rect::MakeXYWH(0, 0, 10, 10));
+  ASSERT_RECT_NEAR(coverages[1], Rect::MakeXYWH(40, 0, 10, 10));
+  ASSERT_RECT_NEAR(coverages[2], Rect::MakeXYWH(20, 0, 10, 10));
+  ASSERT_RECT_NEAR(coverages[3], Rect::MakeXYWH(0, 0, 50, 10));
+  ASSERT_RECT_NEAR(coverages[4], Rect::MakeXYWH(25, 0, 10, 10));
+}
+
+TEST_P(EntityTest, EntityPassCullsDrawsHiddenByOpaqueDraws) {
+  auto make_solid = [](std::unique_ptr<Geometry> geometry, Color color) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(std::move(geometry));
+    contents->SetColor(color);
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    return entity;
+  };
+
+  EntityPass pass;
+  pass.AddEntity(make_solid(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 100, 100)),
+                            Color::Red()));
+  Entity texture_entity;
+  texture_entity.SetContents(
+      TextureContents::MakeRect(Rect::MakeXYWH(10, 10, 10, 10)));
+  pass.AddEntity(texture_entity);
+  // Strokes write to the stencil, so they are never culled.
+  pass.AddEntity(make_solid(
+      Geometry::MakeStrokePath(
+          PathBuilder{}.AddRect(Rect::MakeXYWH(40, 40, 10, 10)).TakePath(), 2),
+      Color::Green()));
+  pass.AddEntity(make_solid(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 60, 60)),
+                            Color::Blue()));
+  // Translucent draws don't hide anything.
+  pass.AddEntity(make_solid(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 100, 100)),
+                            Color::Blue().WithAlpha(0.5)));
+
+  ASSERT_EQ(pass.CullOccludedElements(), 1u);
+  ASSERT_EQ(pass.GetElementCount(), 4u);
+
+  std::vector<Contents::DrawKind> kinds;
+  pass.IterateAllEntities([&kinds](const Entity& entity) {
+    kinds.push_back(entity.GetContents()->GetDrawKind());
+    return true;
+  });
+  ASSERT_EQ(kinds, std::vector<Contents::DrawKind>(
+                       4u, Contents::DrawKind::kSolidColor));
+}
+
+TEST_P(EntityTest, SolidColorBatchContentsCombinesConvexFills) {
+  auto make_fill = [](std::unique_ptr<Geometry> geometry, Color color) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(std::move(geometry));
+    contents->SetColor(color);
+    return contents;
+  };
+
+  SolidColorBatchContents batch;
+  ASSERT_TRUE(batch.AddFill(
+      *make_fill(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)),
+                 Color::Red()),
+      Matrix::MakeTranslation({10, 0})));
+  ASSERT_EQ(batch.GetVertexCount(), 4u);
+  ASSERT_TRUE(batch.AddFill(
+      *make_fill(Geometry::MakeFillPath(PathBuilder{}
+                                            .AddCircle({50, 50}, 10)
+                                            .SetConvexity(Convexity::kConvex)
+                                            .TakePath()),
+                 Color::Blue()),
+      Matrix()));
+  // Strokes and concave paths are left to their own draws.
+  ASSERT_FALSE(batch.AddFill(
+      *make_fill(Geometry::MakeStrokePath(
+                     PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 10, 10))
+                         .TakePath(),
+                     2),
+                 Color::Green()),
+      Matrix()));
+  ASSERT_FALSE(batch.AddFill(
+      *make_fill(Geometry::MakeFillPath(PathBuilder{}
+                                            .MoveTo({0, 0})
+                                            .LineTo({10, 0})
+                                            .LineTo({5, 5})
+                                            .LineTo({10, 10})
+                                            .Close()
+                                            .TakePath()),
+                 Color::Green()),
+      Matrix()));
+
+  ASSERT_EQ(batch.GetFillCount(), 2u);
+  ASSERT_GT(batch.GetVertexCount(), 4u);
+  Entity entity;
+  ASSERT_RECT_NEAR(batch.GetCoverage(entity).value(),
+                   Rect::MakeLTRB(10, 0, 60, 60));
+}
+
 TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   // Rect is drawn entirely in negative area.
   auto pass = CreatePassWithRectPath(Rect::MakeLTRB(-200, -200, -100, -100),
@@ -187,6 +316,38 @@ TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   }
 }
 
+TEST_P(EntityTest, EntityPassCoverageRespectsClips) {
+  EntityPass pass;
+
+  Entity clip;
+  auto clip_contents = std::make_shared<ClipContents>();
+  clip_contents->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddCircle({50, 50}, 50).TakePath()));
+  clip.SetContents(clip_contents);
+  pass.AddEntity(clip);
+
+  Entity clipped;
+  clipped.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddRect(Rect::MakeLTRB(-500, -500, 500, 500)).TakePath(),
+      Color::Red()));
+  clipped.SetStencilDepth(1);
+  pass.AddEntity(clipped);
+
+  Entity restore;
+  restore.SetContents(std::make_shared<ClipRestoreContents>());
+  pass.AddEntity(restore);
+
+  Entity unclipped;
+  unclipped.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddRect(Rect::MakeLTRB(500, 500, 600, 600)).TakePath(),
+      Color::Blue()));
+  pass.AddEntity(unclipped);
+
+  auto coverage = pass.GetElementsCoverage(std::nullopt);
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 600, 600));
+}
+
 TEST_P(EntityTest, FilterCoverageRespectsCropRect) {
   auto image = CreateTextureForFixture("boston.jpg");
   auto filter = ColorFilterContents::MakeBlend(BlendMode::kSoftLight,
@@ -979,6 +1140,54 @@ TEST_P(EntityTest, Filters) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, GaussianBlurSampleStrideBoundsTheSampleCount) {
+  using Blur = DirectionalGaussianBlurFilterContents;
+  ASSERT_EQ(Blur::GetSampleStride(1), 1);
+  ASSERT_EQ(Blur::GetSampleStride(Blur::kMaxUnscaledBlurRadius), 1);
+  ASSERT_EQ(Blur::GetSampleStride(Blur::kMaxUnscaledBlurRadius + 1), 2);
+  for (Scalar radius : {20.0f, 50.0f, 100.0f, 500.0f}) {
+    auto stride = Blur::GetSampleStride(radius);
+    ASSERT_LE(radius / stride, Blur::kMaxUnscaledBlurRadius);
+    ASSERT_GT(radius / stride, Blur::kMaxUnscaledBlurRadius / 2);
+  }
+}
+
+TEST_P(EntityTest, FilterSourceCoverageIncludesWhatTheFilterReads) {
+  auto fill = std::make_shared<SolidColorContents>();
+  fill->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 400, 400)));
+  fill->SetColor(Color::Red());
+  auto output_limit = Rect::MakeXYWH(100, 100, 100, 100);
+
+  // Color filters read each pixel where they write it.
+  ColorMatrix matrix = {
+      1, 0, 0, 0, 0,  //
+      0, 1, 0, 0, 0,  //
+      0, 0, 1, 0, 0,  //
+      0, 0, 0, 1, 0   //
+  };
+  auto color_filter =
+      ColorFilterContents::MakeColorMatrix(FilterInput::Make(fill), matrix);
+  auto color_coverage = color_filter->GetSourceCoverage(Matrix(), output_limit);
+  ASSERT_TRUE(color_coverage.has_value());
+  ASSERT_RECT_NEAR(color_coverage.value(), output_limit);
+
+  // Blurs read the pixels around, through both of their passes.
+  auto blur = FilterContents::MakeGaussianBlur(
+      FilterInput::Make(color_filter), Sigma(10), Sigma(20));
+  auto blur_coverage = blur->GetSourceCoverage(Matrix(), output_limit);
+  ASSERT_TRUE(blur_coverage.has_value());
+  ASSERT_TRUE(blur_coverage->Contains(output_limit.Expand(
+      Radius{Sigma(10)}.radius, Radius{Sigma(20)}.radius,
+      Radius{Sigma(10)}.radius, Radius{Sigma(20)}.radius)));
+
+  // Filters that don't know what they read can't tell.
+  auto matrix_filter = FilterContents::MakeMatrixFilter(
+      FilterInput::Make(fill), Matrix::MakeScale({2, 2, 1}), {}, Matrix(),
+      /*is_subpass=*/false);
+  ASSERT_FALSE(
+      matrix_filter->GetSourceCoverage(Matrix(), output_limit).has_value());
+}
+
 TEST_P(EntityTest, GaussianBlurFilter) {
   auto boston = CreateTextureForFixture("boston.jpg");
   ASSERT_TRUE(boston);
@@ -1761,6 +1970,48 @@ TEST_P(EntityTest, ColorMatrixFilterCoverageIsCorrect) {
   ASSERT_RECT_NEAR(actual.value(), expected);
 }
 
+TEST_P(EntityTest, ColorMatrixFilterFoldsMatricesThatDontClamp) {
+  ColorMatrix invert = {
+      -1, 0,  0,  0, 1,  //
+      0,  -1, 0,  0, 1,  //
+      0,  0,  -1, 0, 1,  //
+      0,  0,  0,  1, 0,  //
+  };
+  ColorMatrix half = {
+      0.5, 0,   0,   0, 0,  //
+      0,   0.5, 0,   0, 0,  //
+      0,   0,   0.5, 0, 0,  //
+      0,   0,   0,   1, 0,  //
+  };
+
+  auto folded = ColorMatrixFilterContents::Fold(invert, half);
+  ASSERT_TRUE(folded.has_value());
+  auto color = Color(0.2, 0.4, 0.6, 0.8);
+  ASSERT_COLOR_NEAR(
+      color.ApplyColorMatrix(folded.value()),
+      color.ApplyColorMatrix(invert).ApplyColorMatrix(half));
+
+  // Doubling a channel can push it past 1, which a separate pass clamps.
+  ColorMatrix twice = {
+      2, 0, 0, 0, 0,  //
+      0, 1, 0, 0, 0,  //
+      0, 0, 1, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+  ASSERT_FALSE(ColorMatrixFilterContents::Fold(twice, half).has_value());
+
+  // Transparent pixels lose their color before a separate pass makes them
+  // visible.
+  ColorMatrix show = {
+      1, 0, 0, 0,   0,    //
+      0, 1, 0, 0,   0,    //
+      0, 0, 1, 0,   0,    //
+      0, 0, 0, 0.5, 0.5,  //
+  };
+  ASSERT_FALSE(ColorMatrixFilterContents::Fold(invert, show).has_value());
+  ASSERT_TRUE(ColorMatrixFilterContents::Fold(show, invert).has_value());
+}
+
 TEST_P(EntityTest, ColorMatrixFilterEditable) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   ASSERT_TRUE(bay_bridge);
@@ -2435,6 +2686,113 @@ TEST_P(EntityTest, TextContentsCeilsGlyphScaleToDecimal) {
   ASSERT_EQ(TextFrame::RoundScaledFontSize(0.0f, 12), 0.0f);
 }
 
+TEST_P(EntityTest, TextContentsBatchesTextThatOnlyDiffersByTranslation) {
+  SkFont font;
+  font.setSize(30);
+  auto make_text = [&font](const char* string, Color color) {
+    auto blob = SkTextBlob::MakeFromString(string, font);
+    auto text_contents = std::make_shared<TextContents>();
+    text_contents->SetTextFrame(MakeTextFrameFromTextBlobSkia(blob).value());
+    text_contents->SetColor(color);
+    return text_contents;
+  };
+  auto first = make_text("A", Color::Blue());
+  auto second = make_text("B", Color::Blue());
+  auto red = make_text("C", Color::Red());
+
+  Entity first_entity;
+  first_entity.SetTransformation(Matrix::MakeScale({2, 2, 1}) *
+                                 Matrix::MakeTranslation({10, 20}));
+  Entity second_entity;
+  second_entity.SetTransformation(Matrix::MakeScale({2, 2, 1}) *
+                                  Matrix::MakeTranslation({110, 20}));
+
+  auto offset = first->GetBatchOffset(first_entity, *second, second_entity);
+  ASSERT_TRUE(offset.has_value());
+  ASSERT_POINT_NEAR(offset.value(), Vector2(100, 0));
+
+  // Text of another color or blend mode, or rotated, needs its own command.
+  ASSERT_FALSE(
+      first->GetBatchOffset(first_entity, *red, second_entity).has_value());
+  Entity rotated_entity;
+  rotated_entity.SetTransformation(second_entity.GetTransformation() *
+                                   Matrix::MakeRotationZ(Radians{kPiOver2}));
+  ASSERT_FALSE(
+      first->GetBatchOffset(first_entity, *second, rotated_entity).has_value());
+  Entity blended_entity = second_entity;
+  blended_entity.SetBlendMode(BlendMode::kPlus);
+  ASSERT_FALSE(
+      first->GetBatchOffset(first_entity, *second, blended_entity).has_value());
+
+  // The batch covers the text of both entities.
+  auto batch = TextContents::MakeBatch(
+      {{.contents = first, .offset = Vector2()},
+       {.contents = second, .offset = offset.value()}});
+  ASSERT_EQ(batch->AsTextContents(), batch.get());
+  auto coverage = batch->GetCoverage(first_entity);
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_TRUE(coverage->Contains(first->GetCoverage(first_entity).value()));
+  ASSERT_TRUE(coverage->Contains(second->GetCoverage(second_entity).value()));
+}
+
+TEST_P(EntityTest, PipelineVariantManifestRoundTrips) {
+  PipelineVariantManifest manifest;
+  ContentContextOptions opts{.sample_count = SampleCount::kCount1,
+                             .blend_mode = BlendMode::kSource,
+                             .stencil_compare = CompareFunction::kAlways,
+                             .primitive_type = PrimitiveType::kTriangleStrip,
+                             .color_attachment_pixel_format =
+                                 PixelFormat::kB8G8R8A8UNormInt,
+                             .has_stencil_attachment = false};
+  ASSERT_TRUE(manifest.Record("SolidFill Pipeline", opts));
+  ASSERT_FALSE(manifest.Record("SolidFill Pipeline", opts));
+  ASSERT_TRUE(manifest.Record("Texture Pipeline", {}));
+  ASSERT_FALSE(manifest.Record("Bad\nLabel", {}));
+
+  auto parsed = PipelineVariantManifest::Parse(*manifest.Serialize());
+  ASSERT_TRUE(parsed.has_value());
+  ASSERT_EQ(parsed->GetEntries().size(), 2u);
+  EXPECT_EQ(parsed->GetEntries()[0].pipeline_label, "SolidFill Pipeline");
+  EXPECT_TRUE(ContentContextOptions::Equal{}(parsed->GetEntries()[0].options,
+                                             opts));
+  EXPECT_EQ(parsed->GetEntries()[1].pipeline_label, "Texture Pipeline");
+
+  fml::DataMapping garbage(std::string{"not a manifest\n1 2 3"});
+  ASSERT_FALSE(PipelineVariantManifest::Parse(garbage).has_value());
+}
+
+TEST_P(EntityTest, ContentContextPrecompilesCapturedVariants) {
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount1,
+      .blend_mode = BlendMode::kSource,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat()};
+
+  PipelineVariantManifest captured;
+  {
+    ContentContext content_context(GetContext(), nullptr);
+    ASSERT_TRUE(content_context.IsValid());
+    content_context.SetVariantCaptureEnabled(true);
+    ASSERT_TRUE(content_context.GetSolidFillPipeline(opts));
+    ASSERT_NE(content_context.GetCapturedVariants(), nullptr);
+    auto parsed = PipelineVariantManifest::Parse(
+        *content_context.GetCapturedVariants()->Serialize());
+    ASSERT_TRUE(parsed.has_value());
+    captured = std::move(parsed.value());
+  }
+  ASSERT_EQ(captured.GetEntries().size(), 1u);
+  ASSERT_TRUE(captured.Record("No Such Pipeline", opts));
+
+  ContentContext content_context(GetContext(), nullptr);
+  ASSERT_TRUE(content_context.IsValid());
+  ASSERT_EQ(content_context.PrecompileVariants(captured), 1u);
+  // Scheduling is idempotent.
+  ASSERT_EQ(content_context.PrecompileVariants(captured), 0u);
+  auto pipeline = content_context.GetSolidFillPipeline(opts);
+  ASSERT_TRUE(pipeline);
+  EXPECT_EQ(pipeline->GetDescriptor().GetSampleCount(), SampleCount::kCount1);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -4,6 +4,10 @@
 
 #include "impeller/entity/geometry/fill_path_geometry.h"
 
+#include <limits>
+
+#include "impeller/entity/tessellation_cache.h"
+
 namespace impeller {
 
 FillPathGeometry::FillPathGeometry(const Path& path,
@@ -19,17 +23,48 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   auto& host_buffer = pass.GetTransientsBuffer();
   VertexBuffer vertex_buffer;
 
-  if (path_.GetFillType() == FillType::kNonZero &&  //
-      path_.IsConvex()) {
-    auto [points, indices] = TessellateConvex(
-        path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()));
+  // Paths with a generation ID are immutable, so their tessellation can be
+  // reused by later frames that draw them at a similar scale.
+  Scalar scale = entity.GetTransformation().GetMaxBasisLength();
+  auto& tessellation_cache = *renderer.GetTessellationCache();
+  auto cache_key = TessellationCache::MakeKey(path_, scale);
+  if (cache_key.has_value()) {
+    auto cached = tessellation_cache.Get(cache_key.value());
+    if (cached.has_value()) {
+      return GeometryResult{
+          .type = PrimitiveType::kTriangle,
+          .vertex_buffer = cached.value(),
+          .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                       entity.GetTransformation(),
+          .prevent_overdraw = false,
+      };
+    }
+    scale = TessellationCache::GetBucketScale(cache_key.value());
+  }
 
+  auto emplace_vertices = [&](const float* vertices, size_t vertices_count,
+                              const uint16_t* indices, size_t indices_count) {
+    if (cache_key.has_value()) {
+      auto cached = tessellation_cache.Insert(
+          cache_key.value(), vertices, vertices_count, indices, indices_count);
+      if (cached.has_value()) {
+        vertex_buffer = cached.value();
+        return;
+      }
+    }
     vertex_buffer.vertex_buffer = host_buffer.Emplace(
-        points.data(), points.size() * sizeof(Point), alignof(Point));
+        vertices, vertices_count * sizeof(float), alignof(float));
     vertex_buffer.index_buffer = host_buffer.Emplace(
-        indices.data(), indices.size() * sizeof(uint16_t), alignof(uint16_t));
-    vertex_buffer.vertex_count = indices.size();
+        indices, indices_count * sizeof(uint16_t), alignof(uint16_t));
+    vertex_buffer.vertex_count = indices_count;
     vertex_buffer.index_type = IndexType::k16bit;
+  };
+
+  if (path_.GetFillType() == FillType::kNonZero &&  //
+      path_.IsConvex()) {
+    auto [points, indices] = TessellateConvex(path_.CreatePolyline(scale));
+    emplace_vertices(reinterpret_cast<const float*>(points.data()),
+                     points.size() * 2, indices.data(), indices.size());
 
     return GeometryResult{
         .type = PrimitiveType::kTriangle,
@@ -41,17 +76,10 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   }
 
   auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
-      [&vertex_buffer, &host_buffer](
-          const float* vertices, size_t vertices_count, const uint16_t* indices,
-          size_t indices_count) {
-        vertex_buffer.vertex_buffer = host_buffer.Emplace(
-            vertices, vertices_count * sizeof(float), alignof(float));
-        vertex_buffer.index_buffer = host_buffer.Emplace(
-            indices, indices_count * sizeof(uint16_t), alignof(uint16_t));
-        vertex_buffer.vertex_count = indices_count;
-        vertex_buffer.index_type = IndexType::k16bit;
+      path_.GetFillType(), path_, scale,
+      [&emplace_vertices](const float* vertices, size_t vertices_count,
+                          const uint16_t* indices, size_t indices_count) {
+        emplace_vertices(vertices, vertices_count, indices, indices_count);
         return true;
       });
   if (tesselation_result != Tessellator::Result::kSuccess) {
@@ -107,8 +135,8 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
 
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
   auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
+      path_.GetFillType(), path_,
+      entity.GetTransformation().GetMaxBasisLength(),
       [&vertex_builder, &texture_coverage, &effect_transform](
           const float* vertices, size_t vertices_count, const uint16_t* indices,
           size_t indices_count) {
@@ -140,6 +168,100 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
   };
 }
 
+std::optional<CoverageAAGeometryResult>
+FillPathGeometry::GetCoverageAABuffers(const ContentContext& renderer,
+                                       const Entity& entity,
+                                       RenderPass& pass,
+                                       Color color) {
+  const auto& transform = entity.GetTransformation();
+  if (transform.HasPerspective()) {
+    return std::nullopt;
+  }
+  auto device_transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  Scalar scale = transform.GetMaxBasisLength();
+  auto polyline = path_.CreatePolyline(scale);
+  for (auto& point : polyline.points) {
+    point = transform * point;
+  }
+
+  // Convex paths are anti-aliased by their vertex colors alone. Other paths
+  // are tessellated as usual and drawn with a fringe outside of the stencil
+  // they mark.
+  CoverageAAVertexBuilder fill_builder;
+  CoverageAAVertexBuilder fringe_builder;
+  bool is_convex = path_.GetFillType() == FillType::kNonZero &&  //
+                   path_.IsConvex();
+  for (auto i = 0u; i < polyline.contours.size(); i++) {
+    auto [start, end] = polyline.GetContourPointBounds(i);
+    if (is_convex) {
+      AppendCoverageAAConvexPolygon(polyline.points.data() + start,
+                                    end - start, color, fill_builder);
+    } else {
+      AppendCoverageAAEdgeFringe(polyline.points.data() + start, end - start,
+                                 color, fringe_builder);
+    }
+  }
+
+  Matrix fill_transform = device_transform;
+  if (!is_convex) {
+    fill_transform = device_transform * transform;
+    auto tessellation_result = renderer.GetTessellator()->Tessellate(
+        path_.GetFillType(), path_, scale,
+        [&fill_builder, &color](const float* vertices, size_t vertices_count,
+                                const uint16_t* indices, size_t indices_count) {
+          for (auto i = 0u; i < vertices_count; i += 2) {
+            fill_builder.AppendVertex({
+                .position = {vertices[i], vertices[i + 1]},
+                .color = color,
+            });
+          }
+          for (auto i = 0u; i < indices_count; i++) {
+            fill_builder.AppendIndex(indices[i]);
+          }
+          return true;
+        });
+    if (tessellation_result != Tessellator::Result::kSuccess) {
+      return std::nullopt;
+    }
+  }
+
+  constexpr auto kMaxVertexCount = std::numeric_limits<uint16_t>::max();
+  if (!fill_builder.HasVertices() ||
+      fill_builder.GetVertexCount() > kMaxVertexCount ||
+      fringe_builder.GetVertexCount() > kMaxVertexCount) {
+    return std::nullopt;
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  CoverageAAGeometryResult result{
+      .fill =
+          {
+              .type = PrimitiveType::kTriangle,
+              .vertex_buffer = fill_builder.CreateVertexBuffer(host_buffer),
+              .transform = fill_transform,
+              .prevent_overdraw = !is_convex,
+          },
+  };
+  if (fringe_builder.HasVertices()) {
+    result.fringe = GeometryResult{
+        .type = PrimitiveType::kTriangle,
+        .vertex_buffer = fringe_builder.CreateVertexBuffer(host_buffer),
+        .transform = device_transform,
+        .prevent_overdraw = true,
+    };
+  }
+  return result;
+}
+
+bool FillPathGeometry::IsEquivalentTo(const Geometry& other) const {
+  auto other_path = other.AsFillPathGeometry();
+  return other_path && path_ == other_path->path_;
+}
+
+const FillPathGeometry* FillPathGeometry::AsFillPathGeometry() const {
+  return this;
+}
+
 GeometryVertexType FillPathGeometry::GetVertexType() const {
   return GeometryVertexType::kPosition;
 }
@@ -161,4 +283,24 @@ bool FillPathGeometry::CoversArea(const Matrix& transform,
   return coverage.Contains(rect);
 }
 
+bool FillPathGeometry::AppendTriangles(const Matrix& transform,
+                                       std::vector<Point>& vertices,
+                                       std::vector<uint16_t>& indices) const {
+  // Other paths need the tessellator, whose results are better kept in the
+  // tessellation cache.
+  if (path_.GetFillType() != FillType::kNonZero || !path_.IsConvex()) {
+    return false;
+  }
+  auto [points, convex_indices] = TessellateConvex(
+      path_.CreatePolyline(transform.GetMaxBasisLength()));
+  auto first = static_cast<uint16_t>(vertices.size());
+  for (const auto& point : points) {
+    vertices.push_back(transform * point);
+  }
+  for (auto index : convex_indices) {
+    indices.push_back(first + index);
+  }
+  return true;
+}
+
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/geometry/geometry.h"
 
+#include <algorithm>
 #include <optional>
 
 #include "impeller/entity/geometry/cover_geometry.h"
@@ -98,6 +99,128 @@ GeometryResult ComputeUVGeometryForRect(Rect source_rect,
   };
 }
 
+/// Copies the points of a closed contour without the repeated ones, including
+/// a closing point that repeats the first.
+static std::vector<Point> GetUniqueContourPoints(const Point* points,
+                                                 size_t point_count) {
+  std::vector<Point> unique_points;
+  unique_points.reserve(point_count);
+  for (auto i = 0u; i < point_count; i++) {
+    if (unique_points.empty() || unique_points.back() != points[i]) {
+      unique_points.push_back(points[i]);
+    }
+  }
+  while (unique_points.size() > 1 &&
+         unique_points.back() == unique_points.front()) {
+    unique_points.pop_back();
+  }
+  return unique_points;
+}
+
+void AppendCoverageAAConvexPolygon(const Point* points,
+                                   size_t point_count,
+                                   Color color,
+                                   CoverageAAVertexBuilder& vertex_builder) {
+  auto polygon = GetUniqueContourPoints(points, point_count);
+  const auto count = polygon.size();
+  if (count < 3) {
+    return;
+  }
+
+  Scalar area = 0;
+  Point min = polygon[0];
+  Point max = polygon[0];
+  for (auto i = 0u; i < count; i++) {
+    area += polygon[i].Cross(polygon[(i + 1) % count]);
+    min = min.Min(polygon[i]);
+    max = max.Max(polygon[i]);
+  }
+  if (ScalarNearlyZero(area)) {
+    return;
+  }
+  const Scalar orientation = area > 0 ? 1.0f : -1.0f;
+
+  // Polygons thinner than a pixel can't be inset by half of one. They are
+  // approximated by a fainter interior that is inset by less.
+  const Scalar thickness =
+      std::min({max.x - min.x, max.y - min.y, Scalar{1}});
+  const Scalar inset = thickness * 0.5f;
+  const Color interior_color = color * thickness;
+  const Color outer_color = Color::BlackTransparent();
+
+  auto get_outward_normal = [&polygon, count, orientation](size_t i) {
+    Point edge = polygon[(i + 1) % count] - polygon[i];
+    return Point(edge.y, -edge.x).Normalize() * orientation;
+  };
+
+  // Each point has an inner vertex at index 2i and an outer one at 2i + 1.
+  const auto first = static_cast<uint16_t>(vertex_builder.GetVertexCount());
+  for (auto i = 0u; i < count; i++) {
+    Point previous_normal = get_outward_normal((i + count - 1) % count);
+    Point next_normal = get_outward_normal(i);
+    // Moves both edges by a unit, up to a length of 4 for sharp corners.
+    Scalar cos_plus_one = 1 + previous_normal.Dot(next_normal);
+    Point miter = cos_plus_one > 0.125f
+                      ? (previous_normal + next_normal) / cos_plus_one
+                      : (previous_normal + next_normal).Normalize() * 4;
+    vertex_builder.AppendVertex({
+        .position = polygon[i] - miter * inset,
+        .color = interior_color,
+    });
+    vertex_builder.AppendVertex({
+        .position = polygon[i] + miter * 0.5f,
+        .color = outer_color,
+    });
+  }
+
+  for (auto i = 1u; i + 1 < count; i++) {
+    vertex_builder.AppendIndex(first);
+    vertex_builder.AppendIndex(first + 2 * i);
+    vertex_builder.AppendIndex(first + 2 * (i + 1));
+  }
+  for (auto i = 0u; i < count; i++) {
+    uint16_t inner = first + 2 * i;
+    uint16_t outer = inner + 1;
+    uint16_t next_inner = first + 2 * ((i + 1) % count);
+    uint16_t next_outer = next_inner + 1;
+    for (auto index :
+         {inner, outer, next_inner, next_inner, outer, next_outer}) {
+      vertex_builder.AppendIndex(index);
+    }
+  }
+}
+
+void AppendCoverageAAEdgeFringe(const Point* points,
+                                size_t point_count,
+                                Color color,
+                                CoverageAAVertexBuilder& vertex_builder) {
+  auto contour = GetUniqueContourPoints(points, point_count);
+  const auto count = contour.size();
+  if (count < 3) {
+    return;
+  }
+
+  const Color edge_color = color * 0.5f;
+  const Color outer_color = Color::BlackTransparent();
+  for (auto i = 0u; i < count; i++) {
+    const Point& a = contour[i];
+    const Point& b = contour[(i + 1) % count];
+    Point offset = Point(b.y - a.y, a.x - b.x).Normalize() * 0.5f;
+
+    const auto first = static_cast<uint16_t>(vertex_builder.GetVertexCount());
+    for (const auto& point : {a, b}) {
+      vertex_builder.AppendVertex(
+          {.position = point - offset, .color = outer_color});
+      vertex_builder.AppendVertex({.position = point, .color = edge_color});
+      vertex_builder.AppendVertex(
+          {.position = point + offset, .color = outer_color});
+    }
+    for (auto index : {0, 1, 3, 3, 1, 4, 1, 2, 4, 4, 2, 5}) {
+      vertex_builder.AppendIndex(first + index);
+    }
+  }
+}
+
 Geometry::Geometry() = default;
 
 Geometry::~Geometry() = default;
@@ -110,6 +233,14 @@ GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
   return {};
 }
 
+std::optional<CoverageAAGeometryResult> Geometry::GetCoverageAABuffers(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    Color color) {
+  return std::nullopt;
+}
+
 std::unique_ptr<Geometry> Geometry::MakeFillPath(
     const Path& path,
     std::optional<Rect> inner_rect) {
@@ -147,4 +278,26 @@ bool Geometry::CoversArea(const Matrix& transform, const Rect& rect) const {
   return false;
 }
 
+bool Geometry::IsEquivalentTo(const Geometry& other) const {
+  return false;
+}
+
+const RectGeometry* Geometry::AsRectGeometry() const {
+  return nullptr;
+}
+
+const FillPathGeometry* Geometry::AsFillPathGeometry() const {
+  return nullptr;
+}
+
+bool Geometry::PreventsOverdraw() const {
+  return false;
+}
+
+bool Geometry::AppendTriangles(const Matrix& transform,
+                               std::vector<Point>& vertices,
+                               std::vector<uint16_t>& indices) const {
+  return false;
+}
+
 }  // namespace impeller
@@ -10,9 +10,12 @@
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_fill.vert.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
+class FillPathGeometry;
+class RectGeometry;
 class Tessellator;
 
 struct GeometryResult {
@@ -22,6 +25,16 @@ struct GeometryResult {
   bool prevent_overdraw;
 };
 
+/// @brief A fill drawn with coverage based anti-aliasing. Both results hold
+/// `GeometryColorPipeline` vertices whose colors are the premultiplied fill
+/// color scaled by the estimated coverage of the pixel.
+struct CoverageAAGeometryResult {
+  GeometryResult fill;
+  /// Strips straddling the edges of fills that aren't convex. They must only
+  /// be drawn outside of `fill`, so `fill` has to mark the stencil.
+  std::optional<GeometryResult> fringe;
+};
+
 enum GeometryVertexType {
   kPosition,
   kColor,
@@ -51,6 +64,25 @@ GeometryResult ComputeUVGeometryForRect(Rect source_rect,
 std::pair<std::vector<Point>, std::vector<uint16_t>> TessellateConvex(
     Path::Polyline polyline);
 
+using CoverageAAVertexBuilder =
+    VertexBufferBuilder<GeometryColorPipeline::VertexShader::PerVertexData>;
+
+/// @brief Append a convex polygon, given in device space, that is anti-aliased
+/// by its vertex colors. The interior is inset by half a pixel at full
+/// coverage, and a fringe fades out to half a pixel outside of the edges.
+void AppendCoverageAAConvexPolygon(const Point* points,
+                                   size_t point_count,
+                                   Color color,
+                                   CoverageAAVertexBuilder& vertex_builder);
+
+/// @brief Append strips straddling the edges of a closed contour, given in
+/// device space, that fade from half coverage on the edge to none half a
+/// pixel away from it on either side.
+void AppendCoverageAAEdgeFringe(const Point* points,
+                                size_t point_count,
+                                Color color,
+                                CoverageAAVertexBuilder& vertex_builder);
+
 class Geometry {
  public:
   Geometry();
@@ -86,6 +118,17 @@ class Geometry {
                                              const Entity& entity,
                                              RenderPass& pass);
 
+  /// @brief    Creates vertices in device space that draw the geometry filled
+  ///           with `color`, anti-aliased without multisampling.
+  ///
+  /// @returns  `std::nullopt` if the geometry can't estimate its coverage, in
+  ///           which case it should be drawn with `GetPositionBuffer`.
+  virtual std::optional<CoverageAAGeometryResult> GetCoverageAABuffers(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass,
+      Color color);
+
   virtual GeometryVertexType GetVertexType() const = 0;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
@@ -101,6 +144,29 @@ class Geometry {
   ///           given `rect`. May return `false` in many undetected cases where
   ///           the transformed geometry does in fact cover the `rect`.
   virtual bool CoversArea(const Matrix& transform, const Rect& rect) const;
+
+  /// @brief    Whether `other` is known to produce the same vertices as this
+  ///           geometry. May return `false` for equivalent geometries.
+  virtual bool IsEquivalentTo(const Geometry& other) const;
+
+  virtual const RectGeometry* AsRectGeometry() const;
+
+  virtual const FillPathGeometry* AsFillPathGeometry() const;
+
+  /// @brief    Whether the geometry uses the stencil to avoid blending the
+  ///           parts of itself that overlap more than once, like the joins of
+  ///           a stroke.
+  virtual bool PreventsOverdraw() const;
+
+  /// @brief    Appends the triangles of the geometry, transformed by
+  ///           `transform`, to `vertices` and `indices`, so that several
+  ///           geometries can be drawn with a single command.
+  ///
+  /// @returns  `false` if the geometry can't be cheaply triangulated on the
+  ///           CPU, in which case nothing is appended.
+  virtual bool AppendTriangles(const Matrix& transform,
+                               std::vector<Point>& vertices,
+                               std::vector<uint16_t>& indices) const;
 };
 
 }  // namespace impeller
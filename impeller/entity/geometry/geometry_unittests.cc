@@ -3,7 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/testing/testing.h"
+#include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
 
 namespace impeller {
@@ -36,5 +39,140 @@ TEST(EntityGeometryTest, FillPathGeometryCoversAreaNoInnerRect) {
   ASSERT_FALSE(geometry->CoversArea({}, Rect()));
 }
 
+TEST(EntityGeometryTest, GeometryEquivalence) {
+  auto rect = Geometry::MakeRect(Rect::MakeLTRB(0, 0, 100, 100));
+  auto same_rect = Geometry::MakeRect(Rect::MakeLTRB(0, 0, 100, 100));
+  auto other_rect = Geometry::MakeRect(Rect::MakeLTRB(0, 0, 50, 100));
+  ASSERT_TRUE(rect->IsEquivalentTo(*same_rect));
+  ASSERT_FALSE(rect->IsEquivalentTo(*other_rect));
+
+  auto path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 100, 100)).TakePath();
+  auto fill = Geometry::MakeFillPath(path);
+  auto same_fill = Geometry::MakeFillPath(path);
+  ASSERT_TRUE(fill->IsEquivalentTo(*same_fill));
+  // Different kinds of geometry aren't compared, even if they would cover the
+  // same pixels.
+  ASSERT_FALSE(fill->IsEquivalentTo(*rect));
+  ASSERT_FALSE(rect->IsEquivalentTo(*fill));
+}
+
+TEST(EntityGeometryTest, ComputeStrokeOnlySupportsStraightCapsAndJoins) {
+  ASSERT_TRUE(StrokePathGeometry::SupportsComputeStroke(Cap::kButt,
+                                                        Join::kMiter));
+  ASSERT_TRUE(StrokePathGeometry::SupportsComputeStroke(Cap::kSquare,
+                                                        Join::kBevel));
+  ASSERT_FALSE(StrokePathGeometry::SupportsComputeStroke(Cap::kRound,
+                                                         Join::kMiter));
+  ASSERT_FALSE(StrokePathGeometry::SupportsComputeStroke(Cap::kButt,
+                                                         Join::kRound));
+}
+
+TEST(EntityGeometryTest, ComputeStrokeInputTagsPointsWithContours) {
+  auto path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({10, 0})
+                  .LineTo({10, 10})
+                  .MoveTo({20, 0})
+                  .LineTo({30, 0})
+                  .TakePath();
+  auto input = StrokePathGeometry::CreateComputeStrokeInput(
+      path.CreatePolyline(1.0), 2.0, Cap::kButt);
+
+  std::vector<Point> expected_points = {
+      {0, 0}, {10, 0}, {10, 10}, {20, 0}, {30, 0}};
+  std::vector<uint32_t> expected_contours = {0, 0, 0, 1, 1};
+  ASSERT_EQ(input.points, expected_points);
+  ASSERT_EQ(input.contours, expected_contours);
+}
+
+TEST(EntityGeometryTest, ComputeStrokeInputRepeatsStartOfClosedContours) {
+  auto path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({10, 0})
+                  .LineTo({10, 10})
+                  .Close()
+                  .TakePath();
+  auto input = StrokePathGeometry::CreateComputeStrokeInput(
+      path.CreatePolyline(1.0), 2.0, Cap::kButt);
+
+  // The first segment is revisited so the shader emits the closing join.
+  std::vector<Point> expected_points = {
+      {0, 0}, {10, 0}, {10, 10}, {0, 0}, {10, 0}};
+  ASSERT_EQ(input.points, expected_points);
+  ASSERT_EQ(input.contours.size(), expected_points.size());
+}
+
+TEST(EntityGeometryTest, ComputeStrokeInputExtendsSquareCaps) {
+  auto path = PathBuilder{}.MoveTo({0, 0}).LineTo({10, 0}).TakePath();
+  auto input = StrokePathGeometry::CreateComputeStrokeInput(
+      path.CreatePolyline(1.0), 4.0, Cap::kSquare);
+
+  std::vector<Point> expected_points = {{-2, 0}, {12, 0}};
+  ASSERT_EQ(input.points, expected_points);
+
+  auto butt_input = StrokePathGeometry::CreateComputeStrokeInput(
+      path.CreatePolyline(1.0), 4.0, Cap::kButt);
+  std::vector<Point> expected_butt_points = {{0, 0}, {10, 0}};
+  ASSERT_EQ(butt_input.points, expected_butt_points);
+}
+
+TEST(EntityGeometryTest, CoverageAAConvexPolygonFadesOutAcrossEdges) {
+  std::vector<Point> square = {{0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0}};
+  Color color = Color::Red();
+  CoverageAAVertexBuilder vertex_builder;
+  AppendCoverageAAConvexPolygon(square.data(), square.size(), color,
+                                vertex_builder);
+
+  // An inner and an outer vertex for each corner, ignoring the closing point.
+  ASSERT_EQ(vertex_builder.GetVertexCount(), 8u);
+  // Two interior triangles and two fringe triangles per edge.
+  ASSERT_EQ(vertex_builder.GetIndexCount(), 30u);
+
+  std::vector<GeometryColorPipeline::VertexShader::PerVertexData> vertices;
+  vertex_builder.IterateVertices(
+      [&vertices](auto& vertex) { vertices.push_back(vertex); });
+  ASSERT_POINT_NEAR(vertices[0].position, Point(0.5, 0.5));
+  ASSERT_POINT_NEAR(vertices[1].position, Point(-0.5, -0.5));
+  ASSERT_POINT_NEAR(vertices[4].position, Point(9.5, 9.5));
+  ASSERT_POINT_NEAR(vertices[5].position, Point(10.5, 10.5));
+  ASSERT_EQ(vertices[0].color, Vector4(color));
+  ASSERT_EQ(vertices[1].color, Vector4(Color::BlackTransparent()));
+}
+
+TEST(EntityGeometryTest, CoverageAAConvexPolygonThinnerThanAPixelIsFainter) {
+  std::vector<Point> line = {{0, 0}, {10, 0}, {10, 0.5}, {0, 0.5}};
+  CoverageAAVertexBuilder vertex_builder;
+  AppendCoverageAAConvexPolygon(line.data(), line.size(), Color::White(),
+                                vertex_builder);
+
+  std::vector<GeometryColorPipeline::VertexShader::PerVertexData> vertices;
+  vertex_builder.IterateVertices(
+      [&vertices](auto& vertex) { vertices.push_back(vertex); });
+  ASSERT_EQ(vertices.size(), 8u);
+  ASSERT_EQ(vertices[0].color, Vector4(Color::White() * 0.5));
+  ASSERT_POINT_NEAR(vertices[0].position, Point(0.25, 0.25));
+}
+
+TEST(EntityGeometryTest, CoverageAAEdgeFringeStraddlesEveryEdge) {
+  std::vector<Point> triangle = {{0, 0}, {10, 0}, {0, 10}};
+  Color color = Color::Blue();
+  CoverageAAVertexBuilder vertex_builder;
+  AppendCoverageAAEdgeFringe(triangle.data(), triangle.size(), color,
+                             vertex_builder);
+
+  ASSERT_EQ(vertex_builder.GetVertexCount(), 18u);
+  ASSERT_EQ(vertex_builder.GetIndexCount(), 36u);
+
+  std::vector<GeometryColorPipeline::VertexShader::PerVertexData> vertices;
+  vertex_builder.IterateVertices(
+      [&vertices](auto& vertex) { vertices.push_back(vertex); });
+  // The first edge runs along the x axis.
+  ASSERT_POINT_NEAR(vertices[0].position, Point(0, 0.5));
+  ASSERT_POINT_NEAR(vertices[1].position, Point(0, 0));
+  ASSERT_POINT_NEAR(vertices[2].position, Point(0, -0.5));
+  ASSERT_EQ(vertices[0].color, Vector4(Color::BlackTransparent()));
+  ASSERT_EQ(vertices[1].color, Vector4(color * 0.5));
+}
+
 }  // namespace testing
 }  // namespace impeller
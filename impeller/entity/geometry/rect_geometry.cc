@@ -39,6 +39,45 @@ GeometryResult RectGeometry::GetPositionUVBuffer(Rect texture_coverage,
                                   renderer, entity, pass);
 }
 
+std::optional<CoverageAAGeometryResult> RectGeometry::GetCoverageAABuffers(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    Color color) {
+  const auto& transform = entity.GetTransformation();
+  if (transform.HasPerspective()) {
+    return std::nullopt;
+  }
+  auto points = rect_.GetPoints();
+  std::array<Point, 4> polygon = {transform * points[0], transform * points[1],
+                                  transform * points[3], transform * points[2]};
+  CoverageAAVertexBuilder vertex_builder;
+  AppendCoverageAAConvexPolygon(polygon.data(), polygon.size(), color,
+                                vertex_builder);
+  if (!vertex_builder.HasVertices()) {
+    return std::nullopt;
+  }
+  return CoverageAAGeometryResult{
+      .fill =
+          {
+              .type = PrimitiveType::kTriangle,
+              .vertex_buffer = vertex_builder.CreateVertexBuffer(
+                  pass.GetTransientsBuffer()),
+              .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()),
+              .prevent_overdraw = false,
+          },
+  };
+}
+
+bool RectGeometry::IsEquivalentTo(const Geometry& other) const {
+  auto other_rect = other.AsRectGeometry();
+  return other_rect && rect_ == other_rect->rect_;
+}
+
+const RectGeometry* RectGeometry::AsRectGeometry() const {
+  return this;
+}
+
 GeometryVertexType RectGeometry::GetVertexType() const {
   return GeometryVertexType::kPosition;
 }
@@ -55,4 +94,17 @@ bool RectGeometry::CoversArea(const Matrix& transform, const Rect& rect) const {
   return coverage.Contains(rect);
 }
 
+bool RectGeometry::AppendTriangles(const Matrix& transform,
+                                   std::vector<Point>& vertices,
+                                   std::vector<uint16_t>& indices) const {
+  auto first = static_cast<uint16_t>(vertices.size());
+  for (const auto& point : rect_.GetPoints()) {
+    vertices.push_back(transform * point);
+  }
+  for (uint16_t index : {0, 1, 2, 1, 2, 3}) {
+    indices.push_back(first + index);
+  }
+  return true;
+}
+
 }  // namespace impeller
@@ -17,12 +17,30 @@ class RectGeometry : public Geometry {
   // |Geometry|
   bool CoversArea(const Matrix& transform, const Rect& rect) const override;
 
+  // |Geometry|
+  bool AppendTriangles(const Matrix& transform,
+                       std::vector<Point>& vertices,
+                       std::vector<uint16_t>& indices) const override;
+
+  // |Geometry|
+  bool IsEquivalentTo(const Geometry& other) const override;
+
+  // |Geometry|
+  const RectGeometry* AsRectGeometry() const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) override;
 
+  // |Geometry|
+  std::optional<CoverageAAGeometryResult> GetCoverageAABuffers(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass,
+      Color color) override;
+
   // |Geometry|
   GeometryVertexType GetVertexType() const override;
 
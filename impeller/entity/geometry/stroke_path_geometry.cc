@@ -5,6 +5,8 @@
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 
 #include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_command.h"
 
 namespace impeller {
 
@@ -226,15 +228,15 @@ StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
 
 // static
 VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
-StrokePathGeometry::CreateSolidStrokeVertices(
-    const Path& path,
-    Scalar stroke_width,
-    Scalar scaled_miter_limit,
-    const StrokePathGeometry::JoinProc& join_proc,
-    const StrokePathGeometry::CapProc& cap_proc,
-    Scalar scale) {
+StrokePathGeometry::CreateSolidStrokeVertices(const Path::Polyline& polyline,
+                                              Scalar stroke_width,
+                                              Scalar scaled_miter_limit,
+                                              Join stroke_join,
+                                              Cap stroke_cap,
+                                              Scalar scale) {
   VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-  auto polyline = path.CreatePolyline(scale);
+  auto join_proc = GetJoinProc(stroke_join);
+  auto cap_proc = GetCapProc(stroke_cap);
 
   VS::PerVertexData vtx;
 
@@ -343,6 +345,79 @@ StrokePathGeometry::CreateSolidStrokeVertices(
   return vtx_builder;
 }
 
+// static
+bool StrokePathGeometry::SupportsComputeStroke(Cap stroke_cap,
+                                               Join stroke_join) {
+  return stroke_cap != Cap::kRound && stroke_join != Join::kRound;
+}
+
+// static
+StrokePathGeometry::ComputeStrokeInput
+StrokePathGeometry::CreateComputeStrokeInput(const Path::Polyline& polyline,
+                                             Scalar stroke_width,
+                                             Cap stroke_cap) {
+  ComputeStrokeInput input;
+  input.points.reserve(polyline.points.size() + polyline.contours.size());
+  input.contours.reserve(polyline.points.size() + polyline.contours.size());
+
+  const Scalar half_width = stroke_width * 0.5;
+  const bool square_cap = stroke_cap == Cap::kSquare;
+  for (size_t contour_i = 0; contour_i < polyline.contours.size();
+       contour_i++) {
+    size_t contour_start_point_i, contour_end_point_i;
+    std::tie(contour_start_point_i, contour_end_point_i) =
+        polyline.GetContourPointBounds(contour_i);
+    const auto contour_id = static_cast<uint32_t>(contour_i);
+
+    switch (contour_end_point_i - contour_start_point_i) {
+      case 1: {
+        // A single point only renders with square caps. A vertical segment
+        // as long as the stroke is wide covers the same square.
+        if (square_cap) {
+          Point p = polyline.points[contour_start_point_i];
+          input.points.push_back(p - Point(0, half_width));
+          input.points.push_back(p + Point(0, half_width));
+          input.contours.insert(input.contours.end(), 2u, contour_id);
+        }
+        continue;
+      }
+      case 0:
+        continue;  // This contour has no renderable content.
+      default:
+        break;
+    }
+
+    const size_t first = input.points.size();
+    input.points.insert(input.points.end(),
+                        polyline.points.begin() + contour_start_point_i,
+                        polyline.points.begin() + contour_end_point_i);
+
+    if (polyline.contours[contour_i].is_closed) {
+      if (input.points.back() != input.points[first]) {
+        input.points.push_back(input.points[first]);
+      }
+      input.points.push_back(input.points[first + 1]);
+    } else if (square_cap) {
+      auto& start = input.points[first];
+      start = start - (input.points[first + 1] - start).Normalize() *
+                          half_width;
+      auto& end = input.points.back();
+      end = end + (end - input.points[input.points.size() - 2]).Normalize() *
+                      half_width;
+    }
+    input.contours.resize(input.points.size(), contour_id);
+  }
+  return input;
+}
+
+bool StrokePathGeometry::ShouldStrokeOnGPU(
+    const ContentContext& renderer,
+    const Path::Polyline& polyline) const {
+  return renderer.GetDeviceCapabilities().SupportsCompute() &&
+         SupportsComputeStroke(stroke_cap_, stroke_join_) &&
+         polyline.points.size() >= kComputeStrokePointThreshold;
+}
+
 GeometryResult StrokePathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
@@ -357,12 +432,18 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
 
   Scalar min_size = 1.0f / sqrt(std::abs(determinant));
   Scalar stroke_width = std::max(stroke_width_, min_size);
+  Scalar scale = entity.GetTransformation().GetMaxBasisLength();
+  auto polyline = path_.CreatePolyline(scale);
+
+  if (ShouldStrokeOnGPU(renderer, polyline)) {
+    return GetPositionBufferGPU(renderer, entity, pass, polyline,
+                                stroke_width);
+  }
 
   auto& host_buffer = pass.GetTransientsBuffer();
   auto vertex_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransformation().GetMaxBasisLength());
+      polyline, stroke_width, miter_limit_ * stroke_width_ * 0.5,
+      stroke_join_, stroke_cap_, scale);
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
@@ -389,12 +470,18 @@ GeometryResult StrokePathGeometry::GetPositionUVBuffer(
 
   Scalar min_size = 1.0f / sqrt(std::abs(determinant));
   Scalar stroke_width = std::max(stroke_width_, min_size);
+  Scalar scale = entity.GetTransformation().GetMaxBasisLength();
+  auto polyline = path_.CreatePolyline(scale);
+
+  if (ShouldStrokeOnGPU(renderer, polyline)) {
+    return GetPositionBufferGPU(renderer, entity, pass, polyline, stroke_width,
+                                texture_coverage, effect_transform);
+  }
 
   auto& host_buffer = pass.GetTransientsBuffer();
   auto stroke_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransformation().GetMaxBasisLength());
+      polyline, stroke_width, miter_limit_ * stroke_width_ * 0.5,
+      stroke_join_, stroke_cap_, scale);
   auto vertex_builder = ComputeUVGeometryCPU(
       stroke_builder, {0, 0}, texture_coverage.size, effect_transform);
 
@@ -407,10 +494,124 @@ GeometryResult StrokePathGeometry::GetPositionUVBuffer(
   };
 }
 
+GeometryResult StrokePathGeometry::GetPositionBufferGPU(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    const Path::Polyline& polyline,
+    Scalar stroke_width,
+    std::optional<Rect> texture_coverage,
+    std::optional<Matrix> effect_transform) {
+  FML_DCHECK(renderer.GetDeviceCapabilities().SupportsCompute());
+  auto input = CreateComputeStrokeInput(polyline, stroke_width, stroke_cap_);
+  if (input.points.size() < 2) {
+    return {};
+  }
+  // Two triangles for each segment and two more for the join that follows.
+  size_t total = (input.points.size() - 1) * 12;
+
+  auto cmd_buffer = renderer.GetContext()->CreateCommandBuffer();
+  auto compute_pass = cmd_buffer->CreateComputePass();
+  auto& host_buffer = compute_pass->GetTransientsBuffer();
+
+  auto points_data = host_buffer.Emplace(input.points.data(),
+                                         input.points.size() * sizeof(Point),
+                                         DefaultUniformAlignment());
+  auto contour_data = host_buffer.Emplace(
+      input.contours.data(), input.contours.size() * sizeof(uint32_t),
+      DefaultUniformAlignment());
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.size = total * sizeof(Point);
+  buffer_desc.storage_mode = StorageMode::kDevicePrivate;
+
+  auto geometry_buffer = renderer.GetContext()
+                             ->GetResourceAllocator()
+                             ->CreateBuffer(buffer_desc)
+                             ->AsBufferView();
+
+  BufferView output;
+  {
+    using PS = PolylineStrokeComputeShader;
+    ComputeCommand cmd;
+    DEBUG_COMMAND_INFO(cmd, "Polyline Stroke Geometry");
+    cmd.pipeline = renderer.GetPolylineStrokeComputePipeline();
+
+    PS::FrameInfo frame_info;
+    frame_info.count = input.points.size();
+    frame_info.half_width = stroke_width * 0.5;
+    frame_info.miter_limit =
+        stroke_join_ == Join::kMiter ? miter_limit_ * stroke_width_ * 0.5 : 0;
+
+    PS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    PS::BindPointData(cmd, points_data);
+    PS::BindContourData(cmd, contour_data);
+    PS::BindGeometryData(cmd, geometry_buffer);
+
+    if (!compute_pass->AddCommand(std::move(cmd))) {
+      return {};
+    }
+    output = geometry_buffer;
+  }
+
+  if (texture_coverage.has_value() && effect_transform.has_value()) {
+    DeviceBufferDescriptor buffer_desc;
+    buffer_desc.size = total * sizeof(Vector4);
+    buffer_desc.storage_mode = StorageMode::kDevicePrivate;
+
+    auto geometry_uv_buffer = renderer.GetContext()
+                                  ->GetResourceAllocator()
+                                  ->CreateBuffer(buffer_desc)
+                                  ->AsBufferView();
+
+    using UV = UvComputeShader;
+
+    ComputeCommand cmd;
+    DEBUG_COMMAND_INFO(cmd, "UV Geometry");
+    cmd.pipeline = renderer.GetUvComputePipeline();
+
+    UV::FrameInfo frame_info;
+    frame_info.count = total;
+    frame_info.effect_transform = effect_transform.value();
+    frame_info.texture_origin = {0, 0};
+    frame_info.texture_size = Vector2(texture_coverage.value().size);
+
+    UV::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    UV::BindGeometryData(cmd, geometry_buffer);
+    UV::BindGeometryUVData(cmd, geometry_uv_buffer);
+
+    if (!compute_pass->AddCommand(std::move(cmd))) {
+      return {};
+    }
+    output = geometry_uv_buffer;
+  }
+
+  compute_pass->SetGridSize(ISize(total, 1));
+  compute_pass->SetThreadGroupSize(ISize(total, 1));
+
+  if (!compute_pass->EncodeCommands() || !cmd_buffer->SubmitCommands()) {
+    return {};
+  }
+
+  return {
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer = {.vertex_buffer = output,
+                        .vertex_count = total,
+                        .index_type = IndexType::kNone},
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation(),
+      .prevent_overdraw = true,
+  };
+}
+
 GeometryVertexType StrokePathGeometry::GetVertexType() const {
   return GeometryVertexType::kPosition;
 }
 
+bool StrokePathGeometry::PreventsOverdraw() const {
+  return true;
+}
+
 std::optional<Rect> StrokePathGeometry::GetCoverage(
     const Matrix& transform) const {
   auto path_bounds = path_.GetBoundingBox();
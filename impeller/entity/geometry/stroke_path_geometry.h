@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "impeller/entity/geometry/geometry.h"
 
 namespace impeller {
@@ -27,6 +29,49 @@ class StrokePathGeometry : public Geometry {
 
   Join GetStrokeJoin() const;
 
+  /// The number of polyline points above which the stroke is expanded by a
+  /// compute shader, if the device supports compute.
+  static constexpr size_t kComputeStrokePointThreshold = 512u;
+
+  /// The input of the polyline stroke compute shader.
+  struct ComputeStrokeInput {
+    std::vector<Point> points;
+    /// The contour each point belongs to.
+    std::vector<uint32_t> contours;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether strokes with the given cap and join can be expanded by
+  ///             the compute shader. Round caps and joins produce a variable
+  ///             number of vertices per point and are always tessellated on
+  ///             the CPU.
+  ///
+  static bool SupportsComputeStroke(Cap stroke_cap, Join stroke_join);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prepare the input of the compute shader for a polyline.
+  ///
+  ///             Square caps are applied by extending the ends of open
+  ///             contours. Closed contours repeat their second point so that
+  ///             the shader emits the join at the closing point.
+  ///
+  static ComputeStrokeInput CreateComputeStrokeInput(
+      const Path::Polyline& polyline,
+      Scalar stroke_width,
+      Cap stroke_cap);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Tessellate the stroke of a polyline into a triangle strip on
+  ///             the CPU.
+  ///
+  static VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
+  CreateSolidStrokeVertices(const Path::Polyline& polyline,
+                            Scalar stroke_width,
+                            Scalar scaled_miter_limit,
+                            Join stroke_join,
+                            Cap stroke_cap,
+                            Scalar scale);
+
  private:
   using VS = SolidFillVertexShader;
 
@@ -62,22 +107,29 @@ class StrokePathGeometry : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool PreventsOverdraw() const override;
+
   bool SkipRendering() const;
 
+  bool ShouldStrokeOnGPU(const ContentContext& renderer,
+                         const Path::Polyline& polyline) const;
+
+  GeometryResult GetPositionBufferGPU(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass,
+      const Path::Polyline& polyline,
+      Scalar stroke_width,
+      std::optional<Rect> texture_coverage = std::nullopt,
+      std::optional<Matrix> effect_transform = std::nullopt);
+
   static Scalar CreateBevelAndGetDirection(
       VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& vtx_builder,
       const Point& position,
       const Point& start_offset,
       const Point& end_offset);
 
-  static VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
-  CreateSolidStrokeVertices(const Path& path,
-                            Scalar stroke_width,
-                            Scalar scaled_miter_limit,
-                            const JoinProc& join_proc,
-                            const CapProc& cap_proc,
-                            Scalar scale);
-
   static StrokePathGeometry::JoinProc GetJoinProc(Join stroke_join);
 
   static StrokePathGeometry::CapProc GetCapProc(Cap stroke_cap);
@@ -4,10 +4,11 @@
 
 #include "impeller/entity/geometry/vertices_geometry.h"
 
+#include <cstring>
 #include <utility>
 
-#include <utility>
 #include "impeller/core/formats.h"
+#include "impeller/entity/vertices_upload_cache.h"
 
 namespace impeller {
 
@@ -50,6 +51,11 @@ static std::vector<uint16_t> fromFanIndices(
   return unrolled_indices;
 }
 
+static uint64_t NextGeometryID() {
+  static std::atomic<uint64_t> next_id = 1u;
+  return next_id++;
+}
+
 /////// Vertices Geometry ///////
 
 VerticesGeometry::VerticesGeometry(std::vector<Point> vertices,
@@ -63,7 +69,8 @@ VerticesGeometry::VerticesGeometry(std::vector<Point> vertices,
       texture_coordinates_(std::move(texture_coordinates)),
       indices_(std::move(indices)),
       bounds_(bounds),
-      vertex_mode_(vertex_mode) {
+      vertex_mode_(vertex_mode),
+      id_(NextGeometryID()) {
   NormalizeIndices();
 }
 
@@ -110,111 +117,108 @@ std::optional<Rect> VerticesGeometry::GetTextureCoordinateCoverge() const {
                                texture_coordinates_.end());
 }
 
-GeometryResult VerticesGeometry::GetPositionBuffer(
+void VerticesGeometry::SetReuseUploads(bool reuse_uploads) {
+  reuse_uploads_ = reuse_uploads;
+}
+
+VertexBuffer VerticesGeometry::WriteBuffers(
     const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) {
+    RenderPass& pass,
+    size_t vertex_size,
+    size_t vertex_alignment,
+    const HostBuffer::EmplaceProc& write_vertices,
+    GeometryVertexType vertex_type,
+    Rect texture_coverage,
+    Matrix effect_transform) {
   auto index_count = indices_.size();
   auto vertex_count = vertices_.size();
-
-  size_t total_vtx_bytes = vertex_count * sizeof(float) * 2;
+  size_t total_vtx_bytes = vertex_count * vertex_size;
   size_t total_idx_bytes = index_count * sizeof(uint16_t);
 
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_count = index_count > 0 ? index_count : vertex_count;
+  vertex_buffer.index_type =
+      index_count > 0 ? IndexType::k16bit : IndexType::kNone;
+
+  if (!reuse_uploads_) {
+    // The vertices are written straight into the transients buffer in the
+    // layout of the pipeline, without a staging copy.
+    auto& host_buffer = pass.GetTransientsBuffer();
+    vertex_buffer.vertex_buffer =
+        host_buffer.Emplace(total_vtx_bytes, vertex_alignment, write_vertices);
+    if (index_count > 0) {
+      vertex_buffer.index_buffer = host_buffer.Emplace(
+          indices_.data(), total_idx_bytes, alignof(uint16_t));
+    }
+    return vertex_buffer;
+  }
 
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<const uint8_t*>(vertices_.data()),
-          Range{0, total_vtx_bytes}, 0)) {
-    return {};
+  auto& cache = *renderer.GetVerticesUploadCache();
+  const VerticesUploadCache::Key key = {
+      .geometry_id = id_,
+      .vertex_type = vertex_type,
+      .texture_coverage = texture_coverage,
+      .effect_transform = effect_transform,
+  };
+  if (auto cached = cache.Find(key); cached.has_value()) {
+    return cached.value();
   }
-  if (index_count > 0 &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+
+  std::vector<uint8_t> data(total_vtx_bytes + total_idx_bytes);
+  write_vertices(data.data());
+  if (index_count > 0) {
+    std::memcpy(data.data() + total_vtx_bytes, indices_.data(),
+                total_idx_bytes);
   }
+  return cache.Upload(key, data, total_vtx_bytes, vertex_buffer)
+      .value_or(VertexBuffer{});
+}
 
+GeometryResult VerticesGeometry::MakeResult(VertexBuffer vertex_buffer,
+                                            const Entity& entity,
+                                            RenderPass& pass) const {
   return GeometryResult{
       .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
+      .vertex_buffer = std::move(vertex_buffer),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = false,
   };
 }
 
+GeometryResult VerticesGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  auto vertex_buffer = WriteBuffers(
+      renderer, pass, sizeof(Point), alignof(Point),
+      [&](uint8_t* contents) {
+        std::memcpy(contents, vertices_.data(),
+                    vertices_.size() * sizeof(Point));
+      },
+      GeometryVertexType::kPosition);
+  return MakeResult(std::move(vertex_buffer), entity, pass);
+}
+
 GeometryResult VerticesGeometry::GetPositionColorBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
   using VS = GeometryColorPipeline::VertexShader;
 
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
-
-  std::vector<VS::PerVertexData> vertex_data(vertex_count);
-  {
-    for (auto i = 0u; i < vertex_count; i++) {
-      vertex_data[i] = {
-          .position = vertices_[i],
-          .color = colors_[i],
-      };
-    }
-  }
-
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0 &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
-  }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  auto vertex_buffer = WriteBuffers(
+      renderer, pass, sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+      [&](uint8_t* contents) {
+        auto* vertex_data = reinterpret_cast<VS::PerVertexData*>(contents);
+        for (auto i = 0u; i < vertices_.size(); i++) {
+          vertex_data[i] = {
+              .position = vertices_[i],
+              .color = colors_[i],
+          };
+        }
+      },
+      GeometryVertexType::kColor);
+  return MakeResult(std::move(vertex_buffer), entity, pass);
 }
 
 GeometryResult VerticesGeometry::GetPositionUVBuffer(
@@ -225,67 +229,30 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
     RenderPass& pass) {
   using VS = TexturePipeline::VertexShader;
 
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
   auto size = texture_coverage.size;
   auto origin = texture_coverage.origin;
-  std::vector<VS::PerVertexData> vertex_data(vertex_count);
-  {
-    for (auto i = 0u; i < vertex_count; i++) {
-      auto vertex = vertices_[i];
-      auto texture_coord = texture_coordinates_[i];
-      auto uv =
-          effect_transform * Point((texture_coord.x - origin.x) / size.width,
-                                   (texture_coord.y - origin.y) / size.height);
-      // From experimentation we need to clamp these values to < 1.0 or else
-      // there can be flickering.
-      vertex_data[i] = {
-          .position = vertex,
-          .texture_coords =
-              Point(std::clamp(uv.x, 0.0f, 1.0f - kEhCloseEnough),
-                    std::clamp(uv.y, 0.0f, 1.0f - kEhCloseEnough)),
-      };
-    }
-  }
-
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0u &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
-  }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  auto vertex_buffer = WriteBuffers(
+      renderer, pass, sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+      [&](uint8_t* contents) {
+        auto* vertex_data = reinterpret_cast<VS::PerVertexData*>(contents);
+        for (auto i = 0u; i < vertices_.size(); i++) {
+          auto vertex = vertices_[i];
+          auto texture_coord = texture_coordinates_[i];
+          auto uv = effect_transform *
+                    Point((texture_coord.x - origin.x) / size.width,
+                          (texture_coord.y - origin.y) / size.height);
+          // From experimentation we need to clamp these values to < 1.0 or
+          // else there can be flickering.
+          vertex_data[i] = {
+              .position = vertex,
+              .texture_coords =
+                  Point(std::clamp(uv.x, 0.0f, 1.0f - kEhCloseEnough),
+                        std::clamp(uv.y, 0.0f, 1.0f - kEhCloseEnough)),
+          };
+        }
+      },
+      GeometryVertexType::kUV, texture_coverage, effect_transform);
+  return MakeResult(std::move(vertex_buffer), entity, pass);
 }
 
 GeometryVertexType VerticesGeometry::GetVertexType() const {
@@ -4,6 +4,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "impeller/core/host_buffer.h"
 #include "impeller/entity/geometry/geometry.h"
 
 namespace impeller {
@@ -54,11 +60,42 @@ class VerticesGeometry : public Geometry {
 
   std::optional<Rect> GetTextureCoordinateCoverge() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Keep the buffers uploaded by the first draw in the vertices
+  ///             upload cache of the content context and reuse them for
+  ///             later draws, instead of writing the vertices into the host
+  ///             buffer of every pass.
+  ///
+  ///             This is worthwhile for geometries that are drawn again in
+  ///             later frames. The geometry itself holds no device buffers,
+  ///             so it may be shared by several contexts.
+  ///
+  void SetReuseUploads(bool reuse_uploads);
+
  private:
   void NormalizeIndices();
 
   PrimitiveType GetPrimitiveType() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the vertices with `write_vertices`, followed by the
+  ///             indices, into the transients buffer of the pass, or into
+  ///             a device buffer in the vertices upload cache if uploads are
+  ///             reused.
+  ///
+  VertexBuffer WriteBuffers(const ContentContext& renderer,
+                            RenderPass& pass,
+                            size_t vertex_size,
+                            size_t vertex_alignment,
+                            const HostBuffer::EmplaceProc& write_vertices,
+                            GeometryVertexType vertex_type,
+                            Rect texture_coverage = {},
+                            Matrix effect_transform = {});
+
+  GeometryResult MakeResult(VertexBuffer vertex_buffer,
+                            const Entity& entity,
+                            RenderPass& pass) const;
+
   std::vector<Point> vertices_;
   std::vector<Color> colors_;
   std::vector<Point> texture_coordinates_;
@@ -66,6 +103,10 @@ class VerticesGeometry : public Geometry {
   Rect bounds_;
   VerticesGeometry::VertexMode vertex_mode_ =
       VerticesGeometry::VertexMode::kTriangles;
+
+  // Identifies the uploads of this geometry in the vertices upload caches.
+  const uint64_t id_;
+  std::atomic_bool reuse_uploads_ = false;
 };
 
 }  // namespace impeller
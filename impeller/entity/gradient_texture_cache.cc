@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/gradient_texture_cache.h"
+
+#include <iterator>
+
+#include "flutter/fml/hash_combine.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/geometry/gradient.h"
+
+namespace impeller {
+
+GradientTextureCache::GradientTextureCache(
+    std::shared_ptr<Allocator> allocator,
+    size_t byte_budget)
+    : allocator_(std::move(allocator)), byte_budget_(byte_budget) {}
+
+GradientTextureCache::~GradientTextureCache() = default;
+
+// static
+std::size_t GradientTextureCache::Hash(const std::vector<Color>& colors,
+                                       const std::vector<Scalar>& stops) {
+  std::size_t hash = fml::HashCombine(colors.size());
+  for (const auto& color : colors) {
+    fml::HashCombineSeed(hash, color.red, color.green, color.blue,
+                         color.alpha);
+  }
+  for (auto stop : stops) {
+    fml::HashCombineSeed(hash, stop);
+  }
+  return hash;
+}
+
+std::shared_ptr<Texture> GradientTextureCache::GetTexture(
+    const std::vector<Color>& colors,
+    const std::vector<Scalar>& stops) {
+  if (!allocator_) {
+    return nullptr;
+  }
+  const auto hash = Hash(colors, stops);
+  auto range = index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto entry = it->second;
+    if (entry->colors == colors && entry->stops == stops) {
+      entries_.splice(entries_.begin(), entries_, entry);
+      return entry->texture;
+    }
+  }
+
+  auto gradient_data = CreateGradientBuffer(colors, stops);
+  auto texture = CreateGradientTexture(gradient_data, *allocator_);
+  if (!texture) {
+    return nullptr;
+  }
+  const size_t byte_size = gradient_data.color_bytes.size();
+  if (byte_size > byte_budget_ / 2) {
+    return texture;
+  }
+
+  EvictToFit(byte_size);
+  entries_.push_front(Entry{
+      .hash = hash,
+      .colors = colors,
+      .stops = stops,
+      .texture = texture,
+      .byte_size = byte_size,
+  });
+  index_.emplace(hash, entries_.begin());
+  byte_size_ += byte_size;
+  return texture;
+}
+
+void GradientTextureCache::Purge() {
+  entries_.clear();
+  index_.clear();
+  byte_size_ = 0u;
+}
+
+size_t GradientTextureCache::GetByteSize() const {
+  return byte_size_;
+}
+
+size_t GradientTextureCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+void GradientTextureCache::Erase(EntryList::iterator entry) {
+  auto range = index_.equal_range(entry->hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == entry) {
+      index_.erase(it);
+      break;
+    }
+  }
+  byte_size_ -= entry->byte_size;
+  entries_.erase(entry);
+}
+
+void GradientTextureCache::EvictToFit(size_t byte_size) {
+  while (!entries_.empty() && byte_size_ + byte_size > byte_budget_) {
+    Erase(std::prev(entries_.end()));
+  }
+}
+
+}  // namespace impeller
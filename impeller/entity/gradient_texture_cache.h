@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of the gradient textures that are sampled by gradient
+///             contents on devices without SSBO support.
+///
+///             Entries are keyed on the colors and stops of the gradient, so
+///             every gradient that is drawn with the same stops shares one
+///             texture across draws and frames. The least recently used
+///             entries are evicted once the cache grows past its byte budget.
+///
+class GradientTextureCache {
+ public:
+  static constexpr size_t kDefaultByteBudget = 1u * 1024u * 1024u;
+
+  explicit GradientTextureCache(std::shared_ptr<Allocator> allocator,
+                                size_t byte_budget = kDefaultByteBudget);
+
+  ~GradientTextureCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the texture of a gradient, or create and cache it if
+  ///             none was found. The entry is marked as the most recently
+  ///             used.
+  ///
+  ///             Textures larger than half of the byte budget are created but
+  ///             not cached.
+  ///
+  /// @return     The gradient texture, or nullptr if it could not be created.
+  ///
+  std::shared_ptr<Texture> GetTexture(const std::vector<Color>& colors,
+                                      const std::vector<Scalar>& stops);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop every entry, such as when the system is low on memory.
+  ///
+  void Purge();
+
+  size_t GetByteSize() const;
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    std::size_t hash = 0u;
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+    std::shared_ptr<Texture> texture;
+    size_t byte_size = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  std::shared_ptr<Allocator> allocator_;
+  const size_t byte_budget_;
+  size_t byte_size_ = 0u;
+  // Ordered from the most to the least recently used.
+  EntryList entries_;
+  // Entries by the hash of their colors and stops. Lookups compare the stops
+  // of the entries in place, so that hits don't copy them.
+  std::unordered_multimap<std::size_t, EntryList::iterator> index_;
+
+  static std::size_t Hash(const std::vector<Color>& colors,
+                          const std::vector<Scalar>& stops);
+
+  void Erase(EntryList::iterator entry);
+
+  void EvictToFit(size_t byte_size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GradientTextureCache);
+};
+
+}  // namespace impeller
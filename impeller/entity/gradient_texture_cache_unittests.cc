@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/entity/gradient_texture_cache.h"
+#include "impeller/entity/test_allocator.h"
+
+namespace impeller {
+namespace testing {
+
+// Two stops are drawn from a two texel texture, which takes 8 bytes.
+static const std::vector<Scalar> kTwoStops = {0.0, 1.0};
+
+TEST(GradientTextureCacheTest, ReturnsCachedTextures) {
+  auto allocator = std::make_shared<TestAllocator>();
+  GradientTextureCache cache(allocator);
+
+  auto texture = cache.GetTexture({Color::Red(), Color::Blue()}, kTwoStops);
+  ASSERT_TRUE(texture);
+  ASSERT_EQ(texture->GetTextureDescriptor().size, ISize(2, 1));
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_EQ(cache.GetByteSize(), 8u);
+
+  ASSERT_EQ(cache.GetTexture({Color::Red(), Color::Blue()}, kTwoStops),
+            texture);
+  ASSERT_NE(cache.GetTexture({Color::Red(), Color::Green()}, kTwoStops),
+            texture);
+  ASSERT_NE(cache.GetTexture({Color::Red(), Color::Blue()}, {0.0, 0.5}),
+            texture);
+  ASSERT_EQ(cache.GetEntryCount(), 3u);
+}
+
+TEST(GradientTextureCacheTest, EvictsLeastRecentlyUsedEntries) {
+  auto allocator = std::make_shared<TestAllocator>();
+  // Room for two entries.
+  GradientTextureCache cache(allocator, 20u);
+
+  auto red = cache.GetTexture({Color::Red(), Color::Red()}, kTwoStops);
+  auto green = cache.GetTexture({Color::Green(), Color::Green()}, kTwoStops);
+  // Using the first entry makes the second one the least recently used.
+  ASSERT_EQ(cache.GetTexture({Color::Red(), Color::Red()}, kTwoStops), red);
+  auto blue = cache.GetTexture({Color::Blue(), Color::Blue()}, kTwoStops);
+
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_LE(cache.GetByteSize(), 20u);
+  ASSERT_EQ(cache.GetTexture({Color::Red(), Color::Red()}, kTwoStops), red);
+  ASSERT_EQ(cache.GetTexture({Color::Blue(), Color::Blue()}, kTwoStops), blue);
+  ASSERT_NE(cache.GetTexture({Color::Green(), Color::Green()}, kTwoStops),
+            green);
+}
+
+TEST(GradientTextureCacheTest, DoesNotCacheTexturesLargerThanHalfTheBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  GradientTextureCache cache(allocator, 20u);
+
+  // Three evenly spaced stops take three texels, or 12 bytes.
+  auto texture = cache.GetTexture({Color::Red(), Color::Green(), Color::Blue()},
+                                  {0.0, 0.5, 1.0});
+  ASSERT_TRUE(texture);
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(GradientTextureCacheTest, PurgeDropsAllEntries) {
+  auto allocator = std::make_shared<TestAllocator>();
+  GradientTextureCache cache(allocator);
+
+  auto texture = cache.GetTexture({Color::Red(), Color::Blue()}, kTwoStops);
+  cache.GetTexture({Color::Red(), Color::Green()}, kTwoStops);
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+
+  cache.Purge();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+  ASSERT_NE(cache.GetTexture({Color::Red(), Color::Blue()}, kTwoStops),
+            texture);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
@@ -14,6 +15,40 @@
 
 namespace impeller {
 
+static bool WritesStencil(
+    const std::optional<StencilAttachmentDescriptor>& descriptor) {
+  if (!descriptor.has_value() || descriptor->write_mask == 0) {
+    return false;
+  }
+  return descriptor->stencil_failure != StencilOperation::kKeep ||
+         descriptor->depth_failure != StencilOperation::kKeep ||
+         descriptor->depth_stencil_pass != StencilOperation::kKeep;
+}
+
+static bool CommandsWriteStencil(const RenderPass& pass) {
+  for (const auto& command : pass.GetCommands()) {
+    if (!command.pipeline) {
+      continue;
+    }
+    const auto& descriptor = command.pipeline->GetDescriptor();
+    if (WritesStencil(descriptor.GetFrontStencilAttachmentDescriptor()) ||
+        WritesStencil(descriptor.GetBackStencilAttachmentDescriptor())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static size_t GetStencilByteSize(const RenderTarget& target) {
+  auto stencil = target.GetStencilAttachment();
+  if (!stencil.has_value() || !stencil->texture) {
+    return 0u;
+  }
+  const auto& descriptor = stencil->texture->GetTextureDescriptor();
+  return descriptor.GetByteSizeOfBaseMipLevel() *
+         static_cast<size_t>(descriptor.sample_count);
+}
+
 InlinePassContext::InlinePassContext(
     std::shared_ptr<Context> context,
     EntityPassTarget& pass_target,
@@ -32,6 +67,13 @@ InlinePassContext::~InlinePassContext() {
   if (!is_collapsed_) {
     EndPass();
   }
+#if !FLUTTER_RELEASE
+  if (skipped_stencil_bytes_ > 0u) {
+    FML_TRACE_COUNTER("impeller", "InlinePassContext",
+                      reinterpret_cast<int64_t>(this), "SkippedStencilBytes",
+                      skipped_stencil_bytes_);
+  }
+#endif  // !FLUTTER_RELEASE
 }
 
 bool InlinePassContext::IsValid() const {
@@ -55,6 +97,20 @@ bool InlinePassContext::EndPass() {
   }
 
   if (command_buffer_) {
+    // The stencil is only written by clips and overdraw prevention. As long as
+    // no pass of the target did either, it still holds the clear value, and
+    // the next pass can clear it again instead of storing and loading it.
+    if (stencil_is_clear_ && CommandsWriteStencil(*pass_)) {
+      stencil_is_clear_ = false;
+    }
+    if (stencil_is_clear_) {
+      const auto& stencil = pass_->GetRenderTarget().GetStencilAttachment();
+      if (stencil.has_value() &&
+          stencil->store_action != StoreAction::kDontCare) {
+        pass_->SetStencilStoreAction(StoreAction::kDontCare);
+        skipped_stencil_bytes_ += GetStencilByteSize(pass_->GetRenderTarget());
+      }
+    }
     if (!command_buffer_->SubmitCommandsAsync(std::move(pass_))) {
       VALIDATION_LOG
           << "Failed to encode and submit command buffer while ending "
@@ -65,6 +121,7 @@ bool InlinePassContext::EndPass() {
 
   pass_ = nullptr;
   command_buffer_ = nullptr;
+  pass_start_texture_ = nullptr;
 
   return true;
 }
@@ -141,15 +198,20 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
   }
 
   // Only clear the stencil if this is the very first pass of the
-  // layer.
-  stencil->load_action =
-      pass_count_ > 0 ? LoadAction::kLoad : LoadAction::kClear;
+  // layer, or if no previous pass wrote to it.
+  stencil->load_action = pass_count_ > 0 && !stencil_is_clear_
+                             ? LoadAction::kLoad
+                             : LoadAction::kClear;
   // If we're on the last pass of the layer, there's no need to store the
   // stencil because nothing needs to read it.
   stencil->store_action = pass_count_ == total_pass_reads_
                               ? StoreAction::kDontCare
                               : StoreAction::kStore;
   pass_target_.target_.SetStencilAttachment(stencil.value());
+  if (pass_count_ > 0 && stencil_is_clear_) {
+    skipped_stencil_bytes_ +=
+        GetStencilByteSize(pass_target_.GetRenderTarget());
+  }
 
   pass_target_.target_.SetColorAttachment(color0, 0);
 
@@ -165,6 +227,14 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
 
   result.pass = pass_;
 
+  // The first pass clears the target. Later passes start with what the
+  // previous passes stored, which MSAA targets move to the backdrop texture.
+  if (pass_count_ > 0) {
+    pass_start_texture_ = is_msaa ? result.backdrop_texture : color0.texture;
+  }
+  drawn_coverage_ = std::nullopt;
+  drawn_coverage_is_unknown_ = false;
+
   if (!context_->GetCapabilities()->SupportsReadFromResolve() &&
       result.backdrop_texture ==
           result.pass->GetRenderTarget().GetRenderTargetTexture()) {
@@ -180,4 +250,30 @@ uint32_t InlinePassContext::GetPassCount() const {
   return pass_count_;
 }
 
+size_t InlinePassContext::GetSkippedStencilBytes() const {
+  return skipped_stencil_bytes_;
+}
+
+void InlinePassContext::AddDrawnCoverage(const Rect& coverage) {
+  drawn_coverage_ = drawn_coverage_.has_value()
+                        ? drawn_coverage_->Union(coverage)
+                        : coverage;
+}
+
+void InlinePassContext::MarkDrawnCoverageUnknown() {
+  drawn_coverage_is_unknown_ = true;
+}
+
+std::shared_ptr<Texture> InlinePassContext::GetUndrawnTexture(
+    const Rect& read_coverage) const {
+  if (!IsActive() || is_collapsed_ || drawn_coverage_is_unknown_) {
+    return nullptr;
+  }
+  if (drawn_coverage_.has_value() &&
+      drawn_coverage_->IntersectsWithRect(read_coverage)) {
+    return nullptr;
+  }
+  return pass_start_texture_;
+}
+
 }  // namespace impeller
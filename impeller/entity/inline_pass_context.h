@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <optional>
+
 #include "impeller/entity/entity_pass_target.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
@@ -32,6 +35,38 @@ class InlinePassContext {
   EntityPassTarget& GetPassTarget() const;
   uint32_t GetPassCount() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of stencil bytes the passes so far didn't store or
+  ///             load because the stencil still held its clear value.
+  ///
+  size_t GetSkippedStencilBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that the current pass draws to `coverage` of the pass
+  ///             texture.
+  ///
+  void AddDrawnCoverage(const Rect& coverage);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that the current pass may draw anywhere in the pass
+  ///             texture.
+  ///
+  void MarkDrawnCoverageUnknown();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a texture holding what the pass target contained
+  ///             when the current pass began, if none of the draws of the
+  ///             current pass overlap `read_coverage`. Returns nullptr
+  ///             otherwise, or if there is no current pass.
+  ///
+  ///             Reading `read_coverage` of this texture gives the same result
+  ///             as ending the pass and reading the pass texture, so backdrop
+  ///             filters that don't overlap the draws before them, like the
+  ///             blurs of an app bar and of a navigation bar, can share one
+  ///             pass instead of each ending it.
+  ///
+  std::shared_ptr<Texture> GetUndrawnTexture(const Rect& read_coverage) const;
+
   RenderPassResult GetRenderPass(uint32_t pass_depth);
 
  private:
@@ -43,6 +78,13 @@ class InlinePassContext {
   uint32_t total_pass_reads_ = 0;
   // Whether this context is collapsed into a parent entity pass.
   bool is_collapsed_ = false;
+  // Whether no pass so far wrote to the stencil since it was cleared.
+  bool stencil_is_clear_ = true;
+  size_t skipped_stencil_bytes_ = 0u;
+  // The pass target contents when the current pass began, if they're known.
+  std::shared_ptr<Texture> pass_start_texture_;
+  std::optional<Rect> drawn_coverage_;
+  bool drawn_coverage_is_unknown_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(InlinePassContext);
 };
@@ -3,12 +3,17 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
-RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
-    : RenderTargetAllocator(std::move(allocator)) {}
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t max_unused_bytes)
+    : RenderTargetAllocator(std::move(allocator)),
+      max_unused_bytes_(max_unused_bytes) {}
 
 void RenderTargetCache::Start() {
   for (auto& td : texture_data_) {
@@ -17,16 +22,53 @@ void RenderTargetCache::Start() {
 }
 
 void RenderTargetCache::End() {
+  for (auto& td : texture_data_) {
+    td.unused_frames = td.used_this_frame ? 0u : td.unused_frames + 1u;
+  }
+  // Keep the most recently used of the unused textures within the budget.
+  std::stable_sort(texture_data_.begin(), texture_data_.end(),
+                   [](const TextureData& a, const TextureData& b) {
+                     return a.unused_frames < b.unused_frames;
+                   });
+
   std::vector<TextureData> retain;
+  size_t unused_bytes = 0;
+  statistics_.cached_bytes = 0;
+  for (const auto& td : texture_data_) {
+    if (!td.used_this_frame) {
+      if (td.unused_frames > kMaxUnusedFrames ||
+          unused_bytes + td.byte_size > max_unused_bytes_) {
+        statistics_.eviction_count++;
+        continue;
+      }
+      unused_bytes += td.byte_size;
+    }
+    statistics_.cached_bytes += td.byte_size;
+    retain.push_back(td);
+  }
+  texture_data_.swap(retain);
+}
 
+void RenderTargetCache::Purge() {
+  // Textures still referenced elsewhere belong to render targets or commands
+  // that haven't been released yet, so dropping them frees no memory.
+  std::vector<TextureData> retain;
+  statistics_.cached_bytes = 0;
   for (const auto& td : texture_data_) {
-    if (td.used_this_frame) {
-      retain.push_back(td);
+    if (td.texture.use_count() == 1) {
+      statistics_.eviction_count++;
+      continue;
     }
+    statistics_.cached_bytes += td.byte_size;
+    retain.push_back(td);
   }
   texture_data_.swap(retain);
 }
 
+const RenderTargetCache::Statistics& RenderTargetCache::GetStatistics() const {
+  return statistics_;
+}
+
 size_t RenderTargetCache::CachedTextureCount() const {
   return texture_data_.size();
 }
@@ -39,14 +81,30 @@ std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
 
   for (auto& td : texture_data_) {
     const auto other_desc = td.texture->GetTextureDescriptor();
-    if (!td.used_this_frame && desc == other_desc) {
+    // A texture only referenced by the cache is no longer part of a render
+    // target or of a command that samples it, so its memory can be reused by
+    // a later pass of the same frame, like the MSAA and stencil attachments of
+    // sibling save layers. The queue orders the passes that used it before
+    // the ones that reuse it.
+    const bool released = td.texture.use_count() == 1;
+    if ((!td.used_this_frame || released) && desc == other_desc) {
       td.used_this_frame = true;
+      statistics_.reuse_count++;
       return td.texture;
     }
   }
   auto result = RenderTargetAllocator::CreateTexture(desc);
-  texture_data_.push_back(
-      TextureData{.used_this_frame = true, .texture = result});
+  if (!result) {
+    return result;
+  }
+  const auto byte_size = desc.GetByteSizeOfBaseMipLevel() *
+                         static_cast<size_t>(desc.sample_count);
+  texture_data_.push_back(TextureData{.used_this_frame = true,
+                                      .unused_frames = 0u,
+                                      .byte_size = byte_size,
+                                      .texture = result});
+  statistics_.allocation_count++;
+  statistics_.cached_bytes += byte_size;
   return result;
 }
 
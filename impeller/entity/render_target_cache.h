@@ -8,13 +8,35 @@
 
 namespace impeller {
 
-/// @brief An implementation of the [RenderTargetAllocator] that caches all
-///        allocated texture data for one frame.
+/// @brief An implementation of the [RenderTargetAllocator] that caches
+///        allocated texture data across frames.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Textures are reused within a frame once nothing but the cache
+///        references them, so that passes whose lifetimes don't overlap share
+///        their attachments. Textures unused during a frame are kept for a few
+///        more frames as long as they fit in a byte budget, so that a layer
+///        whose bounds change back and forth doesn't allocate every frame.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
-  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
+  struct Statistics {
+    /// The number of textures created by the allocator.
+    size_t allocation_count = 0;
+    /// The number of requests served with a cached texture.
+    size_t reuse_count = 0;
+    /// The number of textures dropped from the cache.
+    size_t eviction_count = 0;
+    /// The size of the textures currently held by the cache.
+    size_t cached_bytes = 0;
+  };
+
+  /// The budget for textures kept while unused, 16MB by default.
+  static constexpr size_t kDefaultMaxUnusedBytes = 16u * 1024u * 1024u;
+
+  /// The number of frames a texture is kept while unused.
+  static constexpr size_t kMaxUnusedFrames = 3u;
+
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                             size_t max_unused_bytes = kDefaultMaxUnusedBytes);
 
   ~RenderTargetCache() = default;
 
@@ -24,20 +46,29 @@ class RenderTargetCache : public RenderTargetAllocator {
   // |RenderTargetAllocator|
   void End() override;
 
+  // |RenderTargetAllocator|
+  void Purge() override;
+
   // |RenderTargetAllocator|
   std::shared_ptr<Texture> CreateTexture(
       const TextureDescriptor& desc) override;
 
+  const Statistics& GetStatistics() const;
+
   // visible for testing.
   size_t CachedTextureCount() const;
 
  private:
   struct TextureData {
     bool used_this_frame;
+    size_t unused_frames;
+    size_t byte_size;
     std::shared_ptr<Texture> texture;
   };
 
+  const size_t max_unused_bytes_;
   std::vector<TextureData> texture_data_;
+  Statistics statistics_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetCache);
 };
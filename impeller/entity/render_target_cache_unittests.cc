@@ -5,38 +5,17 @@
 #include <memory>
 
 #include "flutter/testing/testing.h"
-#include "impeller/core/allocator.h"
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/entity/render_target_cache.h"
-#include "impeller/renderer/testing/mocks.h"
+#include "impeller/entity/test_allocator.h"
 
 namespace impeller {
 namespace testing {
 
-class TestAllocator : public Allocator {
- public:
-  TestAllocator() = default;
-
-  ~TestAllocator() = default;
-
-  ISize GetMaxTextureSizeSupported() const override {
-    return ISize(1024, 1024);
-  };
-
-  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
-      const DeviceBufferDescriptor& desc) override {
-    return std::make_shared<MockDeviceBuffer>(desc);
-  };
-
-  virtual std::shared_ptr<Texture> OnCreateTexture(
-      const TextureDescriptor& desc) override {
-    return std::make_shared<MockTexture>(desc);
-  };
-};
-
 TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   auto allocator = std::make_shared<TestAllocator>();
-  auto render_target_cache = RenderTargetCache(allocator);
+  // Without a budget for unused textures.
+  auto render_target_cache = RenderTargetCache(allocator, 0u);
   auto desc = TextureDescriptor{
       .format = PixelFormat::kR8G8B8A8UNormInt,
       .size = ISize(100, 100),
@@ -45,12 +24,14 @@ TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   render_target_cache.Start();
   // Create two textures of the same exact size/shape. Both should be marked
   // as used this frame, so the cached data set will contain two.
-  render_target_cache.CreateTexture(desc);
-  render_target_cache.CreateTexture(desc);
+  auto first = render_target_cache.CreateTexture(desc);
+  auto second = render_target_cache.CreateTexture(desc);
 
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
 
   render_target_cache.End();
+  first.reset();
+  second.reset();
   render_target_cache.Start();
 
   // Next frame, only create one texture. The set will still contain two,
@@ -62,5 +43,100 @@ TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
 }
 
+TEST(RenderTargetCacheTest, ReusesReleasedTexturesWithinAFrame) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto first = render_target_cache.CreateTexture(desc);
+  auto second = render_target_cache.CreateTexture(desc);
+  EXPECT_NE(first, second);
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  // Once a pass is done with a texture, a later pass of the same frame gets
+  // it back instead of a new allocation.
+  auto* released = first.get();
+  first.reset();
+  auto third = render_target_cache.CreateTexture(desc);
+  EXPECT_EQ(third.get(), released);
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  render_target_cache.End();
+}
+
+TEST(RenderTargetCacheTest, KeepsUnusedTexturesWithinTheBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto small = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+  auto large = small;
+  large.size = ISize(200, 200);
+  // Room for the small texture but not for both.
+  auto render_target_cache = RenderTargetCache(
+      allocator, small.GetByteSizeOfBaseMipLevel() +
+                     large.GetByteSizeOfBaseMipLevel() / 2);
+
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(small);
+  render_target_cache.CreateTexture(large);
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  // Neither is used for a frame. Only the one that fits is kept.
+  render_target_cache.Start();
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  EXPECT_EQ(render_target_cache.GetStatistics().eviction_count, 1u);
+  EXPECT_EQ(render_target_cache.GetStatistics().cached_bytes,
+            small.GetByteSizeOfBaseMipLevel());
+
+  // It is reused when the size comes back.
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(small);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.GetStatistics().allocation_count, 2u);
+  EXPECT_EQ(render_target_cache.GetStatistics().reuse_count, 1u);
+
+  // And dropped after a few frames without use.
+  for (size_t i = 0; i <= RenderTargetCache::kMaxUnusedFrames; i++) {
+    ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+    render_target_cache.Start();
+    render_target_cache.End();
+  }
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+  EXPECT_EQ(render_target_cache.GetStatistics().eviction_count, 2u);
+  EXPECT_EQ(render_target_cache.GetStatistics().cached_bytes, 0u);
+}
+
+TEST(RenderTargetCacheTest, PurgeKeepsTexturesInUse) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto in_use = render_target_cache.CreateTexture(desc);
+  render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  render_target_cache.Purge();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  EXPECT_EQ(render_target_cache.GetStatistics().eviction_count, 1u);
+  EXPECT_EQ(render_target_cache.GetStatistics().cached_bytes,
+            desc.GetByteSizeOfBaseMipLevel());
+
+  in_use.reset();
+  render_target_cache.Purge();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+  EXPECT_EQ(render_target_cache.GetStatistics().cached_bytes, 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
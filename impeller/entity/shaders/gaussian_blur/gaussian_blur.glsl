@@ -18,6 +18,10 @@
 #include <impeller/texture.glsl>
 #include <impeller/types.glsl>
 
+// Whether to emulate the decal sampler address mode, for backends that don't
+// support it.
+layout(constant_id = 0) const float enable_decal_specialization = 1.0;
+
 uniform f16sampler2D texture_sampler;
 
 uniform BlurInfo {
@@ -44,11 +48,10 @@ mask_info;
 #endif
 
 f16vec4 Sample(f16sampler2D tex, vec2 coords) {
-#if ENABLE_DECAL_SPECIALIZATION
-  return IPHalfSampleDecal(tex, coords);
-#else
+  if (enable_decal_specialization > 0.5) {
+    return IPHalfSampleDecal(tex, coords);
+  }
   return texture(tex, coords);
-#endif
 }
 
 in vec2 v_texture_coords;
@@ -9,7 +9,6 @@ uniform FrameInfo {
   mat4 mvp;
   mat4 entity_transform;
   vec2 atlas_size;
-  vec2 offset;
   f16vec4 text_color;
   float is_translation_scale;
 }
@@ -22,10 +21,15 @@ in vec4 glyph_bounds;
 
 in vec2 unit_position;
 in vec2 glyph_position;
+// The position of the text frame of the glyph, in the space of the entity.
+in vec2 text_offset;
 
 out vec2 v_uv;
 
 IMPELLER_MAYBE_FLAT out f16vec4 v_text_color;
+// The number of atlas texels one pixel on screen spans, which the fragment
+// shaders of signed distance fields use to antialias the outlines.
+IMPELLER_MAYBE_FLAT out float v_texels_per_pixel;
 
 mat4 basis(mat4 m) {
   return mat4(m[0][0], m[0][1], m[0][2], 0.0,  //
@@ -50,7 +54,7 @@ vec2 project(mat4 m, vec2 v) {
 
 void main() {
   vec2 screen_offset =
-      round(project(frame_info.entity_transform, frame_info.offset));
+      round(project(frame_info.entity_transform, text_offset));
 
   // For each glyph, we compute two rectangles. One for the vertex positions
   // and one for the texture coordinates (UVs).
@@ -74,12 +78,15 @@ void main() {
         0.0, 1.0);
   } else {
     position = frame_info.entity_transform *
-               vec4(frame_info.offset + glyph_position + glyph_bounds.xy +
+               vec4(text_offset + glyph_position + glyph_bounds.xy +
                         unit_position * glyph_bounds.zw,
                     0.0, 1.0);
   }
 
   gl_Position = frame_info.mvp * position;
   v_uv = uv_origin + unit_position * uv_size;
+  float screen_width =
+      length((basis_transform * vec4(glyph_bounds.z, 0.0, 0.0, 0.0)).xy);
+  v_texels_per_pixel = atlas_glyph_bounds.z / max(screen_width, 0.0001);
   v_text_color = frame_info.text_color;
 }
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision mediump float;
+
+#include <impeller/types.glsl>
+
+uniform f16sampler2D glyph_atlas_sampler;
+
+uniform FragInfo {
+  // The distance in atlas texels covered by the field on each side of the
+  // outline of a glyph.
+  float spread;
+}
+frag_info;
+
+in highp vec2 v_uv;
+
+IMPELLER_MAYBE_FLAT in f16vec4 v_text_color;
+IMPELLER_MAYBE_FLAT in float v_texels_per_pixel;
+
+out f16vec4 frag_color;
+
+void main() {
+  // The outline of the glyph is at 0.5.
+  float distance = texture(glyph_atlas_sampler, v_uv).a;
+  // Smooth the outline over one pixel on screen, whatever the scale.
+  float width = max(v_texels_per_pixel / (4.0 * frag_info.spread), 0.001);
+  float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+  frag_color = v_text_color * float16_t(alpha);
+}
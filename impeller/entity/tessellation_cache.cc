@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/tessellation_cache.h"
+
+#include <cmath>
+
+#include "flutter/fml/hash_combine.h"
+#include "impeller/base/validation.h"
+#include "impeller/core/formats.h"
+
+namespace impeller {
+
+std::size_t TessellationCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.generation_id, key.fill_type, key.scale_bucket);
+}
+
+bool TessellationCache::Key::Equal::operator()(const Key& lhs,
+                                               const Key& rhs) const {
+  return lhs.generation_id == rhs.generation_id &&
+         lhs.fill_type == rhs.fill_type &&
+         lhs.scale_bucket == rhs.scale_bucket;
+}
+
+TessellationCache::TessellationCache(std::shared_ptr<Allocator> allocator,
+                                     size_t byte_budget)
+    : allocator_(std::move(allocator)), byte_budget_(byte_budget) {}
+
+TessellationCache::~TessellationCache() = default;
+
+// static
+std::optional<TessellationCache::Key> TessellationCache::MakeKey(
+    const Path& path,
+    Scalar scale) {
+  auto generation_id = path.GetGenerationId();
+  if (!generation_id.has_value() || !std::isfinite(scale) || scale <= 0) {
+    return std::nullopt;
+  }
+  return Key{
+      .generation_id = generation_id.value(),
+      .fill_type = path.GetFillType(),
+      .scale_bucket = static_cast<int32_t>(
+          std::ceil(std::log2(scale) * kScaleBucketsPerOctave)),
+  };
+}
+
+// static
+Scalar TessellationCache::GetBucketScale(const Key& key) {
+  return std::exp2(key.scale_bucket / kScaleBucketsPerOctave);
+}
+
+std::optional<VertexBuffer> TessellationCache::Get(const Key& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return std::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->vertex_buffer;
+}
+
+std::optional<VertexBuffer> TessellationCache::Insert(
+    const Key& key,
+    const float* vertices,
+    size_t vertices_count,
+    const uint16_t* indices,
+    size_t indices_count) {
+  if (!allocator_ || indices_count == 0u) {
+    return std::nullopt;
+  }
+  const size_t vertices_size = vertices_count * sizeof(float);
+  const size_t indices_offset =
+      (vertices_size + alignof(uint16_t) - 1) & ~(alignof(uint16_t) - 1);
+  const size_t indices_size = indices_count * sizeof(uint16_t);
+  const size_t byte_size = indices_offset + indices_size;
+  if (byte_size > byte_budget_ / 2) {
+    return std::nullopt;
+  }
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = byte_size;
+  auto buffer = allocator_->CreateBuffer(desc);
+  if (!buffer) {
+    VALIDATION_LOG << "Could not allocate the tessellation cache entry.";
+    return std::nullopt;
+  }
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(vertices),
+                              Range{0, vertices_size}, 0u) ||
+      !buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(indices),
+                              Range{0, indices_size}, indices_offset)) {
+    VALIDATION_LOG << "Could not upload the tessellation cache entry.";
+    return std::nullopt;
+  }
+
+  auto view = buffer->AsBufferView();
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = view;
+  vertex_buffer.vertex_buffer.range = Range{0, vertices_size};
+  vertex_buffer.index_buffer = view;
+  vertex_buffer.index_buffer.range = Range{indices_offset, indices_size};
+  vertex_buffer.vertex_count = indices_count;
+  vertex_buffer.index_type = IndexType::k16bit;
+
+  // Inserting an existing key replaces the older entry.
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    byte_size_ -= found->second->byte_size;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+
+  EvictToFit(byte_size);
+  entries_.push_front(Entry{
+      .key = key,
+      .vertex_buffer = vertex_buffer,
+      .byte_size = byte_size,
+  });
+  index_[key] = entries_.begin();
+  byte_size_ += byte_size;
+  return vertex_buffer;
+}
+
+void TessellationCache::Purge() {
+  entries_.clear();
+  index_.clear();
+  byte_size_ = 0u;
+}
+
+size_t TessellationCache::GetByteSize() const {
+  return byte_size_;
+}
+
+size_t TessellationCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+void TessellationCache::EvictToFit(size_t byte_size) {
+  while (!entries_.empty() && byte_size_ + byte_size > byte_budget_) {
+    const auto& oldest = entries_.back();
+    byte_size_ -= oldest.byte_size;
+    index_.erase(oldest.key);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of path fill tessellations that lives across frames.
+///
+///             Entries are keyed on the generation ID of the path, its fill
+///             type and the transform scale rounded to a quarter octave. The
+///             vertices and indices of each entry live in a device buffer so
+///             that cache hits don't need to copy anything into the
+///             per-frame host buffer. The least recently used entries are
+///             evicted once the cache grows past its byte budget.
+///
+///             Only paths with a generation ID can be cached, which excludes
+///             the paths that the framework is still editing.
+///
+class TessellationCache {
+ public:
+  static constexpr size_t kDefaultByteBudget = 4u * 1024u * 1024u;
+
+  /// The number of scale buckets per doubling of the transform scale.
+  static constexpr Scalar kScaleBucketsPerOctave = 4.0f;
+
+  struct Key {
+    uint32_t generation_id = 0u;
+    FillType fill_type = FillType::kNonZero;
+    int32_t scale_bucket = 0;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const;
+    };
+  };
+
+  explicit TessellationCache(std::shared_ptr<Allocator> allocator,
+                             size_t byte_budget = kDefaultByteBudget);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache key of a path drawn at the given scale, or
+  ///             std::nullopt if the path can't be cached.
+  ///
+  static std::optional<Key> MakeKey(const Path& path, Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The scale that the path of the given key should be
+  ///             tessellated at. Every scale that falls in the same bucket
+  ///             shares this tessellation, so it is rounded up to avoid
+  ///             visibly flattened curves.
+  ///
+  static Scalar GetBucketScale(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find a cached tessellation, and mark it as the most recently
+  ///             used.
+  ///
+  std::optional<VertexBuffer> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Upload a tessellation to a device buffer and cache it.
+  ///
+  ///             Entries larger than half of the byte budget aren't cached.
+  ///
+  /// @return     The vertex buffer of the new entry, or std::nullopt if the
+  ///             tessellation was not cached.
+  ///
+  std::optional<VertexBuffer> Insert(const Key& key,
+                                     const float* vertices,
+                                     size_t vertices_count,
+                                     const uint16_t* indices,
+                                     size_t indices_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop every entry, such as when the system is low on memory.
+  ///
+  void Purge();
+
+  size_t GetByteSize() const;
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t byte_size = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  std::shared_ptr<Allocator> allocator_;
+  const size_t byte_budget_;
+  size_t byte_size_ = 0u;
+  // Ordered from the most to the least recently used.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash, Key::Equal> index_;
+
+  void EvictToFit(size_t byte_size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace impeller
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/entity/tessellation_cache.h"
+#include "impeller/entity/test_allocator.h"
+#include "impeller/geometry/path_builder.h"
+
+namespace impeller {
+namespace testing {
+
+static Path MakePath(uint32_t generation_id) {
+  return PathBuilder{}
+      .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
+      .SetGenerationId(generation_id)
+      .TakePath();
+}
+
+// Four vertices and six indices take 44 bytes.
+static std::optional<VertexBuffer> InsertQuad(
+    TessellationCache& cache,
+    const TessellationCache::Key& key) {
+  std::vector<float> vertices = {0, 0, 10, 0, 10, 10, 0, 10};
+  std::vector<uint16_t> indices = {0, 1, 2, 0, 2, 3};
+  return cache.Insert(key, vertices.data(), vertices.size(), indices.data(),
+                      indices.size());
+}
+
+TEST(TessellationCacheTest, OnlyPathsWithGenerationIdsHaveKeys) {
+  auto path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 10, 10)).TakePath();
+  ASSERT_FALSE(TessellationCache::MakeKey(path, 1.0).has_value());
+  ASSERT_TRUE(TessellationCache::MakeKey(MakePath(1), 1.0).has_value());
+  ASSERT_FALSE(TessellationCache::MakeKey(MakePath(1), 0.0).has_value());
+}
+
+TEST(TessellationCacheTest, SimilarScalesShareAKey) {
+  auto path = MakePath(1);
+  auto key = TessellationCache::MakeKey(path, 1.1).value();
+  auto similar = TessellationCache::MakeKey(path, 1.15).value();
+  auto doubled = TessellationCache::MakeKey(path, 2.2).value();
+
+  ASSERT_TRUE(TessellationCache::Key::Equal{}(key, similar));
+  ASSERT_FALSE(TessellationCache::Key::Equal{}(key, doubled));
+
+  // Tessellations are never coarser than the scale they are drawn at.
+  ASSERT_GE(TessellationCache::GetBucketScale(similar), 1.15f);
+  ASSERT_GE(TessellationCache::GetBucketScale(doubled), 2.2f);
+}
+
+TEST(TessellationCacheTest, ReturnsCachedTessellations) {
+  auto allocator = std::make_shared<TestAllocator>();
+  TessellationCache cache(allocator);
+  auto key = TessellationCache::MakeKey(MakePath(1), 1.0).value();
+
+  ASSERT_FALSE(cache.Get(key).has_value());
+  auto inserted = InsertQuad(cache, key);
+  ASSERT_TRUE(inserted.has_value());
+  ASSERT_EQ(inserted->vertex_count, 6u);
+  ASSERT_EQ(inserted->index_type, IndexType::k16bit);
+
+  auto cached = cache.Get(key);
+  ASSERT_TRUE(cached.has_value());
+  ASSERT_EQ(cached->vertex_buffer.buffer, inserted->vertex_buffer.buffer);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_EQ(cache.GetByteSize(), 44u);
+}
+
+TEST(TessellationCacheTest, EvictsLeastRecentlyUsedEntries) {
+  auto allocator = std::make_shared<TestAllocator>();
+  // Room for two entries.
+  TessellationCache cache(allocator, 100u);
+  auto key_1 = TessellationCache::MakeKey(MakePath(1), 1.0).value();
+  auto key_2 = TessellationCache::MakeKey(MakePath(2), 1.0).value();
+  auto key_3 = TessellationCache::MakeKey(MakePath(3), 1.0).value();
+
+  ASSERT_TRUE(InsertQuad(cache, key_1).has_value());
+  ASSERT_TRUE(InsertQuad(cache, key_2).has_value());
+  // Using the first entry makes the second one the least recently used.
+  ASSERT_TRUE(cache.Get(key_1).has_value());
+  ASSERT_TRUE(InsertQuad(cache, key_3).has_value());
+
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_LE(cache.GetByteSize(), 100u);
+  ASSERT_TRUE(cache.Get(key_1).has_value());
+  ASSERT_FALSE(cache.Get(key_2).has_value());
+  ASSERT_TRUE(cache.Get(key_3).has_value());
+}
+
+TEST(TessellationCacheTest, DoesNotCacheEntriesLargerThanHalfTheBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  TessellationCache cache(allocator, 80u);
+  auto key = TessellationCache::MakeKey(MakePath(1), 1.0).value();
+
+  ASSERT_FALSE(InsertQuad(cache, key).has_value());
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+
+#include "gmock/gmock.h"
+#include "impeller/core/allocator.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace impeller {
+namespace testing {
+
+/// An allocator of mock device buffers and textures for the tests of the
+/// entity caches. Copying contents into them always succeeds.
+class TestAllocator : public Allocator {
+ public:
+  TestAllocator() = default;
+
+  ~TestAllocator() = default;
+
+  ISize GetMaxTextureSizeSupported() const override {
+    return ISize(1024, 1024);
+  };
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    using ::testing::_;
+    auto buffer = std::make_shared<::testing::NiceMock<MockDeviceBuffer>>(desc);
+    ON_CALL(*buffer, OnCopyHostBuffer(_, _, _))
+        .WillByDefault(::testing::Return(true));
+    return buffer;
+  };
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    using ::testing::_;
+    auto texture = std::make_shared<::testing::NiceMock<MockTexture>>(desc);
+    ON_CALL(*texture, OnSetContents(_, _, _))
+        .WillByDefault(::testing::Return(true));
+    ON_CALL(*texture, OnSetContents(_, _))
+        .WillByDefault(::testing::Return(true));
+    return texture;
+  };
+};
+
+}  // namespace testing
+}  // namespace impeller
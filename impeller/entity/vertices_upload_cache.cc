@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/vertices_upload_cache.h"
+
+#include <iterator>
+
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_descriptor.h"
+
+namespace impeller {
+
+VerticesUploadCache::VerticesUploadCache(std::shared_ptr<Allocator> allocator,
+                                         size_t byte_budget)
+    : allocator_(std::move(allocator)), byte_budget_(byte_budget) {}
+
+VerticesUploadCache::~VerticesUploadCache() = default;
+
+std::optional<VertexBuffer> VerticesUploadCache::Find(const Key& key) {
+  auto found = index_.find({key.geometry_id, key.vertex_type});
+  if (found == index_.end()) {
+    return std::nullopt;
+  }
+  auto entry = found->second;
+  if (entry->key.texture_coverage != key.texture_coverage ||
+      entry->key.effect_transform != key.effect_transform) {
+    return std::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->vertex_buffer;
+}
+
+std::optional<VertexBuffer> VerticesUploadCache::Upload(
+    const Key& key,
+    const std::vector<uint8_t>& data,
+    size_t vertex_byte_size,
+    VertexBuffer vertex_buffer) {
+  if (!allocator_) {
+    return std::nullopt;
+  }
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.size = data.size();
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  auto buffer = allocator_->CreateBuffer(buffer_desc);
+  if (!buffer || !buffer->CopyHostBuffer(data.data(), Range{0, data.size()})) {
+    return std::nullopt;
+  }
+  vertex_buffer.vertex_buffer = {.buffer = buffer,
+                                 .range = Range{0, vertex_byte_size}};
+  vertex_buffer.index_buffer = {
+      .buffer = buffer,
+      .range = Range{vertex_byte_size, data.size() - vertex_byte_size}};
+
+  auto found = index_.find({key.geometry_id, key.vertex_type});
+  if (found != index_.end()) {
+    Erase(found->second);
+  }
+  const size_t byte_size = data.size();
+  if (byte_size > byte_budget_ / 2) {
+    return vertex_buffer;
+  }
+
+  EvictToFit(byte_size);
+  entries_.push_front(Entry{
+      .key = key,
+      .vertex_buffer = vertex_buffer,
+      .byte_size = byte_size,
+  });
+  index_[{key.geometry_id, key.vertex_type}] = entries_.begin();
+  byte_size_ += byte_size;
+  return vertex_buffer;
+}
+
+void VerticesUploadCache::Purge() {
+  entries_.clear();
+  index_.clear();
+  byte_size_ = 0u;
+}
+
+size_t VerticesUploadCache::GetByteSize() const {
+  return byte_size_;
+}
+
+size_t VerticesUploadCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+void VerticesUploadCache::Erase(EntryList::iterator entry) {
+  index_.erase({entry->key.geometry_id, entry->key.vertex_type});
+  byte_size_ -= entry->byte_size;
+  entries_.erase(entry);
+}
+
+void VerticesUploadCache::EvictToFit(size_t byte_size) {
+  while (!entries_.empty() && byte_size_ + byte_size > byte_budget_) {
+    Erase(std::prev(entries_.end()));
+  }
+}
+
+}  // namespace impeller
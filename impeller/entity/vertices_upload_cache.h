@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of the device buffers that the vertices geometries
+///             drawn in every frame are uploaded to.
+///
+///             The geometries themselves may be shared by every renderer in
+///             the process, so the buffers are owned by the content context
+///             of the renderer instead, and released with it before its
+///             context is. The least recently used entries are evicted once
+///             the cache grows past its byte budget.
+///
+class VerticesUploadCache {
+ public:
+  static constexpr size_t kDefaultByteBudget = 4u * 1024u * 1024u;
+
+  struct Key {
+    /// The unique ID of the geometry.
+    uint64_t geometry_id = 0u;
+    GeometryVertexType vertex_type = GeometryVertexType::kPosition;
+    /// The parameters the texture coordinates were computed with.
+    Rect texture_coverage;
+    Matrix effect_transform;
+  };
+
+  explicit VerticesUploadCache(std::shared_ptr<Allocator> allocator,
+                               size_t byte_budget = kDefaultByteBudget);
+
+  ~VerticesUploadCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the buffers uploaded for `key`, marking the entry as the
+  ///             most recently used.
+  ///
+  std::optional<VertexBuffer> Find(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Upload `data`, the vertices in its first `vertex_byte_size`
+  ///             bytes followed by the indices, into a device buffer and cache
+  ///             it for `key`, replacing the buffers uploaded for the same
+  ///             geometry and vertex type with other texture parameters.
+  ///
+  ///             The counts and index type are taken from `vertex_buffer`.
+  ///             Uploads larger than half of the byte budget are not cached.
+  ///
+  /// @return     The uploaded buffers, or std::nullopt if they could not be
+  ///             created.
+  ///
+  std::optional<VertexBuffer> Upload(const Key& key,
+                                     const std::vector<uint8_t>& data,
+                                     size_t vertex_byte_size,
+                                     VertexBuffer vertex_buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop every entry, such as when the system is low on memory.
+  ///
+  void Purge();
+
+  size_t GetByteSize() const;
+
+  size_t GetEntryCount() const;
+
+ private:
+  using Slot = std::pair<uint64_t, GeometryVertexType>;
+
+  struct Entry {
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t byte_size = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  std::shared_ptr<Allocator> allocator_;
+  const size_t byte_budget_;
+  size_t byte_size_ = 0u;
+  // Ordered from the most to the least recently used.
+  EntryList entries_;
+  std::map<Slot, EntryList::iterator> index_;
+
+  void Erase(EntryList::iterator entry);
+
+  void EvictToFit(size_t byte_size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VerticesUploadCache);
+};
+
+}  // namespace impeller
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/entity/test_allocator.h"
+#include "impeller/entity/vertices_upload_cache.h"
+
+namespace impeller {
+namespace testing {
+
+static VerticesUploadCache::Key MakeKey(uint64_t geometry_id) {
+  return {
+      .geometry_id = geometry_id,
+      .vertex_type = GeometryVertexType::kPosition,
+  };
+}
+
+TEST(VerticesUploadCacheTest, ReturnsCachedUploads) {
+  auto allocator = std::make_shared<TestAllocator>();
+  VerticesUploadCache cache(allocator);
+
+  // Four vertices followed by six indices.
+  std::vector<uint8_t> data(32u + 12u);
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_count = 6u;
+  vertex_buffer.index_type = IndexType::k16bit;
+  ASSERT_FALSE(cache.Find(MakeKey(1u)).has_value());
+  auto uploaded = cache.Upload(MakeKey(1u), data, 32u, vertex_buffer);
+  ASSERT_TRUE(uploaded.has_value());
+  EXPECT_EQ(uploaded->vertex_count, 6u);
+  EXPECT_EQ(uploaded->vertex_buffer.range, Range(0u, 32u));
+  EXPECT_EQ(uploaded->index_buffer.range, Range(32u, 12u));
+  EXPECT_EQ(uploaded->vertex_buffer.buffer, uploaded->index_buffer.buffer);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(cache.GetByteSize(), 44u);
+
+  auto found = cache.Find(MakeKey(1u));
+  ASSERT_TRUE(found.has_value());
+  EXPECT_EQ(found->vertex_buffer.buffer, uploaded->vertex_buffer.buffer);
+
+  // Other texture parameters miss, and their upload replaces the entry.
+  auto key = MakeKey(1u);
+  key.effect_transform = Matrix::MakeScale({2, 2, 1});
+  ASSERT_FALSE(cache.Find(key).has_value());
+  ASSERT_TRUE(cache.Upload(key, data, 32u, vertex_buffer).has_value());
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_FALSE(cache.Find(MakeKey(1u)).has_value());
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(VerticesUploadCacheTest, EvictsLeastRecentlyUsedEntries) {
+  auto allocator = std::make_shared<TestAllocator>();
+  // Room for two entries.
+  VerticesUploadCache cache(allocator, 20u);
+
+  std::vector<uint8_t> data(8u);
+  ASSERT_TRUE(cache.Upload(MakeKey(1u), data, 8u, {}).has_value());
+  ASSERT_TRUE(cache.Upload(MakeKey(2u), data, 8u, {}).has_value());
+  // Using the first entry makes the second one the least recently used.
+  ASSERT_TRUE(cache.Find(MakeKey(1u)).has_value());
+  ASSERT_TRUE(cache.Upload(MakeKey(3u), data, 8u, {}).has_value());
+
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(cache.GetByteSize(), 16u);
+  EXPECT_TRUE(cache.Find(MakeKey(1u)).has_value());
+  EXPECT_FALSE(cache.Find(MakeKey(2u)).has_value());
+  EXPECT_TRUE(cache.Find(MakeKey(3u)).has_value());
+
+  // Uploads larger than half of the budget are returned but not cached.
+  std::vector<uint8_t> large_data(12u);
+  EXPECT_TRUE(cache.Upload(MakeKey(4u), large_data, 12u, {}).has_value());
+  EXPECT_FALSE(cache.Find(MakeKey(4u)).has_value());
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
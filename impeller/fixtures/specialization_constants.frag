@@ -0,0 +1,20 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+layout(constant_id = 0) const float supports_decal = 1.0;
+layout(constant_id = 1) const float scale = 2.0;
+
+uniform sampler2D texture_sampler;
+
+in vec2 v_texture_coords;
+
+out vec4 frag_color;
+
+void main() {
+  vec4 color = texture(texture_sampler, v_texture_coords);
+  if (supports_decal > 0.5) {
+    color *= scale;
+  }
+  frag_color = color;
+}
@@ -0,0 +1,12 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Specialization constant IDs must start at zero and be contiguous.
+layout(constant_id = 3) const float scale = 2.0;
+
+out vec4 frag_color;
+
+void main() {
+  frag_color = vec4(scale);
+}
@@ -4,8 +4,11 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -16,6 +19,8 @@ namespace {
 Path CreateCubic();
 /// Similar to the path above, but with all cubics replaced by quadratics.
 Path CreateQuadratic();
+/// A single convex contour, which the tessellator fills without libtess.
+Path CreateRRect();
 }  // namespace
 
 static Tessellator tess;
@@ -43,10 +48,152 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+/// Like BM_Polyline, but flattens into storage that is reused across
+/// iterations the way the tessellator reuses it across frames.
+template <class... Args>
+static void BM_PolylineReused(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+  bool tessellate = std::get<bool>(args_tuple);
+
+  Path::Polyline polyline;
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    if (tessellate) {
+      tess.Tessellate(
+          FillType::kNonZero, path, 1.0f,
+          [&single_point_count](const float* vertices, size_t vertices_size,
+                                const uint16_t* indices, size_t indices_size) {
+            single_point_count = vertices_size / 2;
+            return true;
+          });
+    } else {
+      path.CreatePolyline(1.0f, polyline);
+      single_point_count = polyline.points.size();
+    }
+    point_count += single_point_count;
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+}
+
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline, CreateCubic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
+BENCHMARK_CAPTURE(BM_Polyline, rrect_polyline_tess, CreateRRect(), true);
+BENCHMARK_CAPTURE(BM_PolylineReused, cubic_polyline, CreateCubic(), false);
+BENCHMARK_CAPTURE(BM_PolylineReused, cubic_polyline_tess, CreateCubic(), true);
+BENCHMARK_CAPTURE(BM_PolylineReused, quad_polyline, CreateQuadratic(), false);
+BENCHMARK_CAPTURE(BM_PolylineReused,
+                  quad_polyline_tess,
+                  CreateQuadratic(),
+                  true);
+BENCHMARK_CAPTURE(BM_PolylineReused, rrect_polyline_tess, CreateRRect(), true);
+
+/// Compares the raster thread cost of the two stroke paths. The CPU path
+/// builds the whole triangle strip, while the compute path only packs the
+/// polyline for upload and leaves the expansion to the GPU.
+template <class... Args>
+static void BM_StrokePolyline(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+  bool compute = std::get<bool>(args_tuple);
+  const Scalar stroke_width = 5.0f;
+  const Scalar miter_limit = 10.0f;
+
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    auto polyline = path.CreatePolyline(1.0f);
+    if (compute) {
+      auto input = StrokePathGeometry::CreateComputeStrokeInput(
+          polyline, stroke_width, Cap::kButt);
+      single_point_count = input.points.size();
+    } else {
+      auto vertices = StrokePathGeometry::CreateSolidStrokeVertices(
+          polyline, stroke_width, miter_limit * stroke_width * 0.5,
+          Join::kMiter, Cap::kButt, 1.0f);
+      single_point_count = vertices.GetVertexCount();
+    }
+    point_count += single_point_count;
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+}
+
+BENCHMARK_CAPTURE(BM_StrokePolyline, cubic_stroke_cpu, CreateCubic(), false);
+BENCHMARK_CAPTURE(BM_StrokePolyline, cubic_stroke_compute, CreateCubic(), true);
+BENCHMARK_CAPTURE(BM_StrokePolyline, quad_stroke_cpu, CreateQuadratic(), false);
+BENCHMARK_CAPTURE(BM_StrokePolyline,
+                  quad_stroke_compute,
+                  CreateQuadratic(),
+                  true);
+
+/// The matrices an entity typically sees on its way to the GPU: a 2D scale
+/// and translate, a rotation, and a 3D perspective.
+static Matrix CreateAffineMatrix() {
+  return Matrix::MakeTranslation({120, 80}) *
+         Matrix::MakeRotationZ(Radians{0.3}) * Matrix::MakeScale({1.5, 2.0, 1});
+}
+
+static Matrix CreatePerspectiveMatrix() {
+  return Matrix::MakeTranslation({400, 300}) *
+         Matrix::MakePerspective(Radians(kPiOver2), 1, 1, 100) *
+         Matrix::MakeRotationX(Radians{0.3}) *
+         Matrix::MakeTranslation({0, 0, -500});
+}
+
+static void BM_MatrixMultiply(benchmark::State& state) {
+  Matrix a = CreateAffineMatrix();
+  Matrix b = CreatePerspectiveMatrix();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    Matrix result = a * b;
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+static void BM_MatrixInvert(benchmark::State& state) {
+  Matrix matrix = CreatePerspectiveMatrix();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(matrix);
+    Matrix result = matrix.Invert();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <class... Args>
+static void BM_TransformBounds(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  Matrix matrix = std::get<Matrix>(args_tuple);
+  Rect rect = Rect::MakeXYWH(10, 20, 300, 400);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(matrix);
+    benchmark::DoNotOptimize(rect);
+    Rect result = rect.TransformBounds(matrix);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+static void BM_RectUnion(benchmark::State& state) {
+  Rect a = Rect::MakeXYWH(10, 20, 300, 400);
+  Rect b = Rect::MakeXYWH(-50, 100, 200, 600);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    Rect result = a.Union(b);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK(BM_MatrixMultiply);
+BENCHMARK(BM_MatrixInvert);
+BENCHMARK_CAPTURE(BM_TransformBounds, affine, CreateAffineMatrix());
+BENCHMARK_CAPTURE(BM_TransformBounds, perspective, CreatePerspectiveMatrix());
+BENCHMARK(BM_RectUnion);
 
 namespace {
 Path CreateCubic() {
@@ -312,5 +459,11 @@ Path CreateQuadratic() {
       .TakePath();
 }
 
+Path CreateRRect() {
+  return PathBuilder{}
+      .AddRoundedRect(Rect::MakeXYWH(10, 10, 300, 200), 40)
+      .TakePath();
+}
+
 }  // namespace
 }  // namespace impeller
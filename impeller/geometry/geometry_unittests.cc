@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 #include "impeller/geometry/geometry_asserts.h"
 
+#include <algorithm>
 #include <limits>
 #include <sstream>
 #include <type_traits>
@@ -272,6 +273,19 @@ TEST(GeometryTest, MatrixVectorMultiplication) {
   }
 }
 
+TEST(GeometryTest, MatrixMultiplicationMatchesMultiply) {
+  auto a = Matrix::MakeTranslation({100, 200, 300}) *
+           Matrix::MakeRotationZ(Radians{0.4}) *
+           Matrix::MakeScale({2.0, 3.0, 4.0});
+  auto b = Matrix::MakePerspective(Radians(kPiOver2), 1, 1, 100) *
+           Matrix::MakeRotationX(Radians{0.7});
+
+  ASSERT_MATRIX_NEAR(a * b, a.Multiply(b));
+  ASSERT_MATRIX_NEAR(b * a, b.Multiply(a));
+  ASSERT_MATRIX_NEAR(a * Matrix(), a);
+  ASSERT_MATRIX_NEAR(Matrix() * a, a);
+}
+
 TEST(GeometryTest, MatrixMakeRotationFromQuaternion) {
   {
     auto matrix = Matrix::MakeRotation(Quaternion({1, 0, 0}, kPiOver2));
@@ -1898,6 +1912,34 @@ TEST(GeometryTest, RectGetTransformedPoints) {
   ASSERT_POINT_NEAR(points[3], Point(410, 620));
 }
 
+TEST(GeometryTest, RectTransformBounds) {
+  Rect r = Rect::MakeLTRB(100, 200, 300, 400);
+  {
+    auto bounds = r.TransformBounds(Matrix::MakeTranslation({10, 20}) *
+                                    Matrix::MakeScale({-2, 1, 1}));
+    ASSERT_RECT_NEAR(bounds, Rect::MakeLTRB(-590, 220, -190, 420));
+  }
+  {
+    auto bounds = r.TransformBounds(Matrix::MakeRotationZ(Radians{kPiOver2}));
+    ASSERT_RECT_NEAR(bounds, Rect::MakeLTRB(-400, 100, -200, 300));
+  }
+  {
+    auto matrix = Matrix::MakeTranslation({200, 300}) *
+                  Matrix::MakePerspective(Radians(kPiOver2), 1, 1, 100) *
+                  Matrix::MakeRotationX(Radians{0.3}) *
+                  Matrix::MakeTranslation({0, 0, -500});
+    auto points = r.GetTransformedPoints(matrix);
+    auto expected = Rect::MakePointBounds(points.begin(), points.end());
+    ASSERT_RECT_NEAR(r.TransformBounds(matrix), expected.value());
+  }
+  // Corners on the perspective singularity resolve to the origin.
+  {
+    auto matrix = Matrix::MakePerspective(Radians(kPiOver2), 1, 1, 100);
+    auto bounds = r.TransformBounds(matrix);
+    ASSERT_RECT_NEAR(bounds, Rect::MakeLTRB(0, 0, 0, 0));
+  }
+}
+
 TEST(GeometryTest, RectMakePointBounds) {
   {
     std::vector<Point> points{{1, 5}, {4, -1}, {0, 6}};
@@ -2019,6 +2061,108 @@ TEST(GeometryTest, CubicPathComponentPolylineDoesNotIncludePointOne) {
   ASSERT_EQ(polyline.back().y, 40);
 }
 
+TEST(GeometryTest, CubicPathComponentPolylineIsWithinTolerance) {
+  CubicPathComponent component({10, 10}, {20, 135}, {135, 20}, {40, 40});
+  for (auto scale : {1.0f, 4.0f}) {
+    auto polyline = component.CreatePolyline(scale);
+    ASSERT_GT(polyline.size(), 1u);
+    auto tolerance = kDefaultCurveTolerance / scale;
+    // The points are evenly spaced in t. Check the curve halfway between
+    // each pair against the segment joining them.
+    Point previous = component.p1;
+    for (size_t i = 0; i < polyline.size(); i++) {
+      auto t = (i + 0.5f) / polyline.size();
+      auto midpoint = component.Solve(t);
+      auto segment = polyline[i] - previous;
+      auto projection = std::clamp(
+          (midpoint - previous).Dot(segment) / segment.Dot(segment), 0.0f,
+          1.0f);
+      auto distance = midpoint.GetDistance(previous + segment * projection);
+      ASSERT_LE(distance, tolerance);
+      previous = polyline[i];
+    }
+  }
+}
+
+TEST(GeometryTest, PathEqualityComparesComponents) {
+  auto make_rrect = [](Scalar radius) {
+    return PathBuilder{}
+        .AddRoundedRect(Rect::MakeXYWH(0, 0, 100, 100), radius)
+        .TakePath();
+  };
+  ASSERT_TRUE(make_rrect(10) == make_rrect(10));
+  ASSERT_FALSE(make_rrect(10) == make_rrect(20));
+
+  auto line = PathBuilder{}.MoveTo({0, 0}).LineTo({10, 10}).TakePath();
+  auto quad = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .QuadraticCurveTo({0, 0}, {10, 10})
+                  .TakePath();
+  ASSERT_FALSE(line == quad);
+
+  auto even_odd =
+      PathBuilder{}.MoveTo({0, 0}).LineTo({10, 10}).TakePath(FillType::kOdd);
+  ASSERT_FALSE(line == even_odd);
+}
+
+TEST(GeometryTest, PathCreatePolylineReusesStorage) {
+  auto large = PathBuilder{}
+                   .AddCircle({100, 100}, 80)
+                   .AddRect(Rect::MakeXYWH(0, 0, 10, 10))
+                   .TakePath();
+  auto small = PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 10, 10)).TakePath();
+
+  Path::Polyline polyline;
+  large.CreatePolyline(1.0f, polyline);
+  auto capacity = polyline.points.capacity();
+  small.CreatePolyline(1.0f, polyline);
+
+  auto expected = small.CreatePolyline(1.0f);
+  ASSERT_EQ(polyline.points, expected.points);
+  ASSERT_EQ(polyline.contours.size(), expected.contours.size());
+  ASSERT_EQ(polyline.points.capacity(), capacity);
+}
+
+TEST(GeometryTest, PathIterateComponentsVisitsComponentsInOrder) {
+  auto path = PathBuilder{}
+                  .MoveTo({10, 10})
+                  .LineTo({20, 10})
+                  .QuadraticCurveTo({30, 10}, {30, 20})
+                  .CubicCurveTo({30, 30}, {20, 30}, {10, 30})
+                  .Close()
+                  .TakePath();
+
+  std::vector<std::pair<size_t, Path::ComponentType>> visited;
+  path.IterateComponents(
+      [&visited](size_t index, const LinearPathComponent& linear) {
+        visited.emplace_back(index, Path::ComponentType::kLinear);
+      },
+      [&visited](size_t index, const QuadraticPathComponent& quad) {
+        ASSERT_EQ(quad, QuadraticPathComponent({20, 10}, {30, 10}, {30, 20}));
+        visited.emplace_back(index, Path::ComponentType::kQuadratic);
+      },
+      [&visited](size_t index, const CubicPathComponent& cubic) {
+        ASSERT_EQ(cubic, CubicPathComponent({30, 20}, {30, 30}, {20, 30},
+                                            {10, 30}));
+        visited.emplace_back(index, Path::ComponentType::kCubic);
+      },
+      [&visited](size_t index, const ContourComponent& contour) {
+        visited.emplace_back(index, Path::ComponentType::kContour);
+      });
+
+  ASSERT_EQ(visited.size(), path.GetComponentCount());
+  for (size_t i = 0; i < visited.size(); i++) {
+    ASSERT_EQ(visited[i].first, i);
+  }
+  ASSERT_EQ(visited[0].second, Path::ComponentType::kContour);
+  ASSERT_EQ(visited[1].second, Path::ComponentType::kLinear);
+  ASSERT_EQ(visited[2].second, Path::ComponentType::kQuadratic);
+  ASSERT_EQ(visited[3].second, Path::ComponentType::kCubic);
+  ASSERT_EQ(path.GetComponentCount(Path::ComponentType::kLinear), 2u);
+  ASSERT_EQ(path.GetComponentCount(Path::ComponentType::kQuadratic), 1u);
+  ASSERT_EQ(path.GetComponentCount(Path::ComponentType::kCubic), 1u);
+}
+
 TEST(GeometryTest, PathCreatePolyLineDoesNotDuplicatePoints) {
   PathBuilder builder;
   builder.MoveTo({10, 10});
@@ -4,9 +4,18 @@
 
 #include "impeller/geometry/matrix.h"
 
+#include <algorithm>
 #include <climits>
 #include <sstream>
 
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define IMPELLER_GEOMETRY_NEON 1
+#include <arm_neon.h>
+#elif defined(__SSE__) || defined(_M_X64)
+#define IMPELLER_GEOMETRY_SSE 1
+#include <xmmintrin.h>
+#endif
+
 namespace impeller {
 
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
@@ -94,6 +103,112 @@ Matrix Matrix::operator+(const Matrix& o) const {
   );
 }
 
+Matrix Matrix::operator*(const Matrix& o) const {
+  // Each column of the product is the sum of the columns of this matrix
+  // scaled by the elements of the same column of |o|. The additions are done
+  // in the same order as |Multiply| so both give the same results.
+#if IMPELLER_GEOMETRY_NEON
+  const float32x4_t c0 = vld1q_f32(&m[0]);
+  const float32x4_t c1 = vld1q_f32(&m[4]);
+  const float32x4_t c2 = vld1q_f32(&m[8]);
+  const float32x4_t c3 = vld1q_f32(&m[12]);
+  Matrix result;
+  for (int i = 0; i < 4; i++) {
+    const Scalar* b = &o.m[i * 4];
+    float32x4_t column = vmulq_n_f32(c0, b[0]);
+    column = vaddq_f32(column, vmulq_n_f32(c1, b[1]));
+    column = vaddq_f32(column, vmulq_n_f32(c2, b[2]));
+    column = vaddq_f32(column, vmulq_n_f32(c3, b[3]));
+    vst1q_f32(&result.m[i * 4], column);
+  }
+  return result;
+#elif IMPELLER_GEOMETRY_SSE
+  const __m128 c0 = _mm_loadu_ps(&m[0]);
+  const __m128 c1 = _mm_loadu_ps(&m[4]);
+  const __m128 c2 = _mm_loadu_ps(&m[8]);
+  const __m128 c3 = _mm_loadu_ps(&m[12]);
+  Matrix result;
+  for (int i = 0; i < 4; i++) {
+    const Scalar* b = &o.m[i * 4];
+    __m128 column = _mm_mul_ps(c0, _mm_set1_ps(b[0]));
+    column = _mm_add_ps(column, _mm_mul_ps(c1, _mm_set1_ps(b[1])));
+    column = _mm_add_ps(column, _mm_mul_ps(c2, _mm_set1_ps(b[2])));
+    column = _mm_add_ps(column, _mm_mul_ps(c3, _mm_set1_ps(b[3])));
+    _mm_storeu_ps(&result.m[i * 4], column);
+  }
+  return result;
+#else
+  return Multiply(o);
+#endif
+}
+
+std::array<Scalar, 4> Matrix::TransformBoundsLTRB(Scalar left,
+                                                  Scalar top,
+                                                  Scalar right,
+                                                  Scalar bottom) const {
+  // Like |operator*(const Point&)|, a corner with a w of zero maps to the
+  // origin.
+#if IMPELLER_GEOMETRY_NEON
+  const float32x4_t x = {left, right, left, right};
+  const float32x4_t y = {top, top, bottom, bottom};
+  float32x4_t tx = vaddq_f32(vmulq_n_f32(x, m[0]), vmulq_n_f32(y, m[4]));
+  tx = vaddq_f32(tx, vdupq_n_f32(m[12]));
+  float32x4_t ty = vaddq_f32(vmulq_n_f32(x, m[1]), vmulq_n_f32(y, m[5]));
+  ty = vaddq_f32(ty, vdupq_n_f32(m[13]));
+  float32x4_t w = vaddq_f32(vmulq_n_f32(x, m[3]), vmulq_n_f32(y, m[7]));
+  w = vaddq_f32(w, vdupq_n_f32(m[15]));
+  const uint32x4_t non_zero = vmvnq_u32(vceqq_f32(w, vdupq_n_f32(0.0f)));
+  const float32x4_t inverse_w = vreinterpretq_f32_u32(vandq_u32(
+      non_zero, vreinterpretq_u32_f32(vdivq_f32(vdupq_n_f32(1.0f), w))));
+  tx = vmulq_f32(tx, inverse_w);
+  ty = vmulq_f32(ty, inverse_w);
+  return {vminvq_f32(tx), vminvq_f32(ty), vmaxvq_f32(tx), vmaxvq_f32(ty)};
+#elif IMPELLER_GEOMETRY_SSE
+  const __m128 x = _mm_setr_ps(left, right, left, right);
+  const __m128 y = _mm_setr_ps(top, top, bottom, bottom);
+  __m128 tx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[0])),
+                         _mm_mul_ps(y, _mm_set1_ps(m[4])));
+  tx = _mm_add_ps(tx, _mm_set1_ps(m[12]));
+  __m128 ty = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[1])),
+                         _mm_mul_ps(y, _mm_set1_ps(m[5])));
+  ty = _mm_add_ps(ty, _mm_set1_ps(m[13]));
+  __m128 w = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[3])),
+                        _mm_mul_ps(y, _mm_set1_ps(m[7])));
+  w = _mm_add_ps(w, _mm_set1_ps(m[15]));
+  const __m128 non_zero = _mm_cmpneq_ps(w, _mm_setzero_ps());
+  const __m128 inverse_w =
+      _mm_and_ps(non_zero, _mm_div_ps(_mm_set1_ps(1.0f), w));
+  tx = _mm_mul_ps(tx, inverse_w);
+  ty = _mm_mul_ps(ty, inverse_w);
+
+  // Reduce the four corners in [x0 x1 x2 x3 | y0 y1 y2 y3] pairs.
+  __m128 low = _mm_min_ps(_mm_unpacklo_ps(tx, ty), _mm_unpackhi_ps(tx, ty));
+  __m128 high = _mm_max_ps(_mm_unpacklo_ps(tx, ty), _mm_unpackhi_ps(tx, ty));
+  low = _mm_min_ps(low, _mm_movehl_ps(low, low));
+  high = _mm_max_ps(high, _mm_movehl_ps(high, high));
+  const __m128 ltrb = _mm_movelh_ps(low, high);
+  std::array<Scalar, 4> result;
+  _mm_storeu_ps(result.data(), ltrb);
+  return result;
+#else
+  const Point points[4] = {
+      *this * Point(left, top),
+      *this * Point(right, top),
+      *this * Point(left, bottom),
+      *this * Point(right, bottom),
+  };
+  std::array<Scalar, 4> result = {points[0].x, points[0].y, points[0].x,
+                                  points[0].y};
+  for (const Point& point : points) {
+    result[0] = std::min(result[0], point.x);
+    result[1] = std::min(result[1], point.y);
+    result[2] = std::max(result[2], point.x);
+    result[3] = std::max(result[3], point.y);
+  }
+  return result;
+#endif
+}
+
 Matrix Matrix::Invert() const {
   Matrix tmp{
       m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] +
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <limits>
@@ -286,6 +287,15 @@ struct Matrix {
 
   Matrix Invert() const;
 
+  /// @brief  Transform the four corners of the rectangle with the given left,
+  ///         top, right and bottom edges by this matrix, including the
+  ///         perspective divide, and return the left, top, right and bottom
+  ///         edges of their bounds.
+  std::array<Scalar, 4> TransformBoundsLTRB(Scalar left,
+                                            Scalar top,
+                                            Scalar right,
+                                            Scalar bottom) const;
+
   Scalar GetDeterminant() const;
 
   Scalar GetMaxBasisLength() const;
@@ -390,7 +400,10 @@ struct Matrix {
 
   Matrix operator-(const Vector3& t) const { return Translate(-t); }
 
-  Matrix operator*(const Matrix& m) const { return Multiply(m); }
+  /// @brief  Multiply by |m| using the SIMD instructions of the target where
+  ///         available. Prefer this over |Multiply| outside of constant
+  ///         expressions.
+  Matrix operator*(const Matrix& m) const;
 
   Matrix operator+(const Matrix& m) const;
 
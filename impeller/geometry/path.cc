@@ -33,11 +33,11 @@ size_t Path::GetComponentCount(std::optional<ComponentType> type) const {
   if (type.has_value()) {
     switch (type.value()) {
       case ComponentType::kLinear:
-        return linears_.size();
+        return linear_count_;
       case ComponentType::kQuadratic:
-        return quads_.size();
+        return quad_count_;
       case ComponentType::kCubic:
-        return cubics_.size();
+        return cubic_count_;
       case ComponentType::kContour:
         return contours_.size();
     }
@@ -62,47 +62,38 @@ void Path::SetConvexity(Convexity value) {
 }
 
 void Path::Shift(Point shift) {
-  size_t currentIndex = 0;
-  for (const auto& component : components_) {
-    switch (component.type) {
-      case ComponentType::kLinear:
-        linears_[component.index].p1 += shift;
-        linears_[component.index].p2 += shift;
-        break;
-      case ComponentType::kQuadratic:
-        quads_[component.index].cp += shift;
-        quads_[component.index].p1 += shift;
-        quads_[component.index].p2 += shift;
-        break;
-      case ComponentType::kCubic:
-        cubics_[component.index].cp1 += shift;
-        cubics_[component.index].cp2 += shift;
-        cubics_[component.index].p1 += shift;
-        cubics_[component.index].p2 += shift;
-        break;
-      case ComponentType::kContour:
-        contours_[component.index].destination += shift;
-        break;
-    }
-    currentIndex++;
+  for (auto& point : points_) {
+    point += shift;
   }
+  for (auto& contour : contours_) {
+    contour.destination += shift;
+  }
+}
+
+template <class T>
+void Path::AddSegmentComponent(ComponentType type, const T& segment) {
+  const auto* points = reinterpret_cast<const Point*>(&segment);
+  components_.emplace_back(type, points_.size());
+  points_.insert(points_.end(), points, points + sizeof(T) / sizeof(Point));
 }
 
 Path& Path::AddLinearComponent(Point p1, Point p2) {
-  linears_.emplace_back(p1, p2);
-  components_.emplace_back(ComponentType::kLinear, linears_.size() - 1);
+  AddSegmentComponent(ComponentType::kLinear, LinearPathComponent(p1, p2));
+  linear_count_++;
   return *this;
 }
 
 Path& Path::AddQuadraticComponent(Point p1, Point cp, Point p2) {
-  quads_.emplace_back(p1, cp, p2);
-  components_.emplace_back(ComponentType::kQuadratic, quads_.size() - 1);
+  AddSegmentComponent(ComponentType::kQuadratic,
+                      QuadraticPathComponent(p1, cp, p2));
+  quad_count_++;
   return *this;
 }
 
 Path& Path::AddCubicComponent(Point p1, Point cp1, Point cp2, Point p2) {
-  cubics_.emplace_back(p1, cp1, cp2, p2);
-  components_.emplace_back(ComponentType::kCubic, cubics_.size() - 1);
+  AddSegmentComponent(ComponentType::kCubic,
+                      CubicPathComponent(p1, cp1, cp2, p2));
+  cubic_count_++;
   return *this;
 }
 
@@ -127,32 +118,27 @@ void Path::EnumerateComponents(
     const Applier<QuadraticPathComponent>& quad_applier,
     const Applier<CubicPathComponent>& cubic_applier,
     const Applier<ContourComponent>& contour_applier) const {
-  size_t currentIndex = 0;
-  for (const auto& component : components_) {
-    switch (component.type) {
-      case ComponentType::kLinear:
+  IterateComponents(
+      [&linear_applier](size_t index, const LinearPathComponent& linear) {
         if (linear_applier) {
-          linear_applier(currentIndex, linears_[component.index]);
+          linear_applier(index, linear);
         }
-        break;
-      case ComponentType::kQuadratic:
+      },
+      [&quad_applier](size_t index, const QuadraticPathComponent& quad) {
         if (quad_applier) {
-          quad_applier(currentIndex, quads_[component.index]);
+          quad_applier(index, quad);
         }
-        break;
-      case ComponentType::kCubic:
+      },
+      [&cubic_applier](size_t index, const CubicPathComponent& cubic) {
         if (cubic_applier) {
-          cubic_applier(currentIndex, cubics_[component.index]);
+          cubic_applier(index, cubic);
         }
-        break;
-      case ComponentType::kContour:
+      },
+      [&contour_applier](size_t index, const ContourComponent& contour) {
         if (contour_applier) {
-          contour_applier(currentIndex, contours_[component.index]);
+          contour_applier(index, contour);
         }
-        break;
-    }
-    currentIndex++;
-  }
+      });
 }
 
 bool Path::GetLinearComponentAtIndex(size_t index,
@@ -165,7 +151,7 @@ bool Path::GetLinearComponentAtIndex(size_t index,
     return false;
   }
 
-  linear = linears_[components_[index].index];
+  linear = GetComponent<LinearPathComponent>(components_[index]);
   return true;
 }
 
@@ -180,7 +166,7 @@ bool Path::GetQuadraticComponentAtIndex(
     return false;
   }
 
-  quadratic = quads_[components_[index].index];
+  quadratic = GetComponent<QuadraticPathComponent>(components_[index]);
   return true;
 }
 
@@ -194,7 +180,7 @@ bool Path::GetCubicComponentAtIndex(size_t index,
     return false;
   }
 
-  cubic = cubics_[components_[index].index];
+  cubic = GetComponent<CubicPathComponent>(components_[index]);
   return true;
 }
 
@@ -222,7 +208,7 @@ bool Path::UpdateLinearComponentAtIndex(size_t index,
     return false;
   }
 
-  linears_[components_[index].index] = linear;
+  GetComponent<LinearPathComponent>(components_[index]) = linear;
   return true;
 }
 
@@ -237,7 +223,7 @@ bool Path::UpdateQuadraticComponentAtIndex(
     return false;
   }
 
-  quads_[components_[index].index] = quadratic;
+  GetComponent<QuadraticPathComponent>(components_[index]) = quadratic;
   return true;
 }
 
@@ -251,7 +237,7 @@ bool Path::UpdateCubicComponentAtIndex(size_t index,
     return false;
   }
 
-  cubics_[components_[index].index] = cubic;
+  GetComponent<CubicPathComponent>(components_[index]) = cubic;
   return true;
 }
 
@@ -271,23 +257,31 @@ bool Path::UpdateContourComponentAtIndex(size_t index,
 
 Path::Polyline Path::CreatePolyline(Scalar scale) const {
   Polyline polyline;
+  CreatePolyline(scale, polyline);
+  return polyline;
+}
 
-  std::optional<Point> previous_contour_point;
-  auto collect_points = [&polyline, &previous_contour_point](
-                            const std::vector<Point>& collection) {
-    if (collection.empty()) {
-      return;
-    }
+void Path::CreatePolyline(Scalar scale, Polyline& polyline) const {
+  polyline.points.clear();
+  polyline.contours.clear();
 
-    for (const auto& point : collection) {
+  // Components append their points directly to the polyline. This drops the
+  // points appended since `first_point` that repeat the point before them.
+  std::optional<Point> previous_contour_point;
+  auto collect_points = [&polyline,
+                         &previous_contour_point](size_t first_point) {
+    auto& points = polyline.points;
+    size_t kept = first_point;
+    for (size_t i = first_point; i < points.size(); i++) {
       if (previous_contour_point.has_value() &&
-          previous_contour_point.value() == point) {
+          previous_contour_point.value() == points[i]) {
         // Skip over duplicate points in the same contour.
         continue;
       }
-      previous_contour_point = point;
-      polyline.points.push_back(point);
+      previous_contour_point = points[i];
+      points[kept++] = points[i];
     }
+    points.resize(kept);
   };
 
   auto get_path_component = [this](size_t component_i) -> PathComponentVariant {
@@ -297,11 +291,11 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
     const auto& component = components_[component_i];
     switch (component.type) {
       case ComponentType::kLinear:
-        return &linears_[component.index];
+        return &GetComponent<LinearPathComponent>(component);
       case ComponentType::kQuadratic:
-        return &quads_[component.index];
+        return &GetComponent<QuadraticPathComponent>(component);
       case ComponentType::kCubic:
-        return &cubics_[component.index];
+        return &GetComponent<CubicPathComponent>(component);
       case ComponentType::kContour:
         return std::monostate{};
     }
@@ -361,17 +355,24 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
   for (size_t component_i = 0; component_i < components_.size();
        component_i++) {
     const auto& component = components_[component_i];
+    const auto first_point = polyline.points.size();
     switch (component.type) {
       case ComponentType::kLinear:
-        collect_points(linears_[component.index].CreatePolyline());
+        GetComponent<LinearPathComponent>(component).AppendPolylinePoints(
+            polyline.points);
+        collect_points(first_point);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kQuadratic:
-        collect_points(quads_[component.index].CreatePolyline(scale));
+        GetComponent<QuadraticPathComponent>(component).FillPointsForPolyline(
+            polyline.points, scale);
+        collect_points(first_point);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kCubic:
-        collect_points(cubics_[component.index].CreatePolyline(scale));
+        GetComponent<CubicPathComponent>(component).FillPointsForPolyline(
+            polyline.points, scale);
+        collect_points(first_point);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kContour:
@@ -388,12 +389,12 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
                                      .is_closed = contour.is_closed,
                                      .start_direction = start_direction});
         previous_contour_point = std::nullopt;
-        collect_points({contour.destination});
+        polyline.points.push_back(contour.destination);
+        collect_points(first_point);
         break;
     }
     end_contour();
   }
-  return polyline;
 }
 
 std::optional<Rect> Path::GetBoundingBox() const {
@@ -422,7 +423,7 @@ std::optional<Rect> Path::GetTransformedBoundingBox(
 }
 
 std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
-  if (linears_.empty() && quads_.empty() && cubics_.empty()) {
+  if (linear_count_ == 0u && quad_count_ == 0u && cubic_count_ == 0u) {
     return std::nullopt;
   }
 
@@ -442,22 +443,22 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
     }
   };
 
-  for (const auto& linear : linears_) {
-    clamp(linear.p1);
-    clamp(linear.p2);
-  }
-
-  for (const auto& quad : quads_) {
-    for (const Point& point : quad.Extrema()) {
-      clamp(point);
-    }
-  }
-
-  for (const auto& cubic : cubics_) {
-    for (const Point& point : cubic.Extrema()) {
-      clamp(point);
-    }
-  }
+  IterateComponents(
+      [&clamp](size_t index, const LinearPathComponent& linear) {
+        clamp(linear.p1);
+        clamp(linear.p2);
+      },
+      [&clamp](size_t index, const QuadraticPathComponent& quad) {
+        for (const Point& point : quad.Extrema()) {
+          clamp(point);
+        }
+      },
+      [&clamp](size_t index, const CubicPathComponent& cubic) {
+        for (const Point& point : cubic.Extrema()) {
+          clamp(point);
+        }
+      },
+      [](size_t index, const ContourComponent& contour) {});
 
   if (!min.has_value() || !max.has_value()) {
     return std::nullopt;
@@ -470,4 +471,30 @@ void Path::SetBounds(Rect rect) {
   computed_bounds_ = rect;
 }
 
+void Path::SetGenerationId(std::optional<uint32_t> generation_id) {
+  generation_id_ = generation_id;
+}
+
+std::optional<uint32_t> Path::GetGenerationId() const {
+  return generation_id_;
+}
+
+bool Path::operator==(const Path& other) const {
+  if (generation_id_.has_value() && generation_id_ == other.generation_id_) {
+    return true;
+  }
+  if (fill_ != other.fill_ || components_.size() != other.components_.size() ||
+      points_ != other.points_ || contours_ != other.contours_) {
+    return false;
+  }
+  // The components index into the points and contours in order, so only their
+  // types can differ.
+  for (size_t i = 0; i < components_.size(); i++) {
+    if (components_[i].type != other.components_[i].type) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace impeller
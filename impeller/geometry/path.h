@@ -8,6 +8,8 @@
 #include <optional>
 #include <set>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "impeller/geometry/path_component.h"
@@ -99,6 +101,9 @@ class Path {
 
   bool IsConvex() const;
 
+  /// Whether both paths have the same fill type and the same components.
+  bool operator==(const Path& other) const;
+
   template <class T>
   using Applier = std::function<void(size_t index, const T& component)>;
   void EnumerateComponents(
@@ -107,6 +112,37 @@ class Path {
       const Applier<CubicPathComponent>& cubic_applier,
       const Applier<ContourComponent>& contour_applier) const;
 
+  /// Calls the applier for the type of each component, in order. Unlike
+  /// `EnumerateComponents`, the appliers are template arguments and may be
+  /// inlined, and the components are references into the storage of the
+  /// path.
+  template <class LinearApplier,
+            class QuadApplier,
+            class CubicApplier,
+            class ContourApplier>
+  void IterateComponents(LinearApplier&& linear_applier,
+                         QuadApplier&& quad_applier,
+                         CubicApplier&& cubic_applier,
+                         ContourApplier&& contour_applier) const {
+    for (size_t i = 0; i < components_.size(); i++) {
+      const auto& component = components_[i];
+      switch (component.type) {
+        case ComponentType::kLinear:
+          linear_applier(i, GetComponent<LinearPathComponent>(component));
+          break;
+        case ComponentType::kQuadratic:
+          quad_applier(i, GetComponent<QuadraticPathComponent>(component));
+          break;
+        case ComponentType::kCubic:
+          cubic_applier(i, GetComponent<CubicPathComponent>(component));
+          break;
+        case ComponentType::kContour:
+          contour_applier(i, contours_[component.index]);
+          break;
+      }
+    }
+  }
+
   bool GetLinearComponentAtIndex(size_t index,
                                  LinearPathComponent& linear) const;
 
@@ -125,12 +161,26 @@ class Path {
   /// the path. If the provided scale is 0, curves will revert to lines.
   Polyline CreatePolyline(Scalar scale) const;
 
+  /// Like `CreatePolyline(Scalar)`, but replaces the contents of `polyline`
+  /// instead of allocating a new one. Callers that generate a polyline every
+  /// frame can keep one around, so that its storage is only allocated when a
+  /// path needs more points than any before it.
+  void CreatePolyline(Scalar scale, Polyline& polyline) const;
+
   std::optional<Rect> GetBoundingBox() const;
 
   std::optional<Rect> GetTransformedBoundingBox(const Matrix& transform) const;
 
   std::optional<std::pair<Point, Point>> GetMinMaxCoveragePoints() const;
 
+  /// An identifier of the immutable source this path was created from, such
+  /// as the generation ID of an SkPath.
+  ///
+  /// Two paths with the same generation ID have the same contents, so caches
+  /// may key derived data such as tessellations on it. Paths that may still
+  /// change, or that were built from scratch, have no generation ID.
+  std::optional<uint32_t> GetGenerationId() const;
+
  private:
   friend class PathBuilder;
 
@@ -140,6 +190,8 @@ class Path {
 
   void SetBounds(Rect rect);
 
+  void SetGenerationId(std::optional<uint32_t> generation_id);
+
   Path& AddLinearComponent(Point p1, Point p2);
 
   Path& AddQuadraticComponent(Point p1, Point cp, Point p2);
@@ -171,6 +223,8 @@ class Path {
 
   struct ComponentIndexPair {
     ComponentType type = ComponentType::kLinear;
+    /// The index of the first point of the component in `points_`, or of the
+    /// component in `contours_` for contours.
     size_t index = 0;
 
     ComponentIndexPair() {}
@@ -179,15 +233,34 @@ class Path {
         : type(a_type), index(a_index) {}
   };
 
+  /// The segments are stored as runs of points. The segment structs are
+  /// standard layout arrays of points, so they can be read in place.
+  template <class T>
+  const T& GetComponent(const ComponentIndexPair& component) const {
+    static_assert(std::is_standard_layout_v<T>);
+    static_assert(sizeof(T) % sizeof(Point) == 0);
+    return *reinterpret_cast<const T*>(points_.data() + component.index);
+  }
+
+  template <class T>
+  T& GetComponent(const ComponentIndexPair& component) {
+    return const_cast<T&>(std::as_const(*this).GetComponent<T>(component));
+  }
+
+  template <class T>
+  void AddSegmentComponent(ComponentType type, const T& segment);
+
   FillType fill_ = FillType::kNonZero;
   Convexity convexity_ = Convexity::kUnknown;
   std::vector<ComponentIndexPair> components_;
-  std::vector<LinearPathComponent> linears_;
-  std::vector<QuadraticPathComponent> quads_;
-  std::vector<CubicPathComponent> cubics_;
+  std::vector<Point> points_;
   std::vector<ContourComponent> contours_;
+  size_t linear_count_ = 0u;
+  size_t quad_count_ = 0u;
+  size_t cubic_count_ = 0u;
 
   std::optional<Rect> computed_bounds_;
+  std::optional<uint32_t> generation_id_;
 };
 
 }  // namespace impeller
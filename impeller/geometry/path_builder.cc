@@ -26,6 +26,8 @@ Path PathBuilder::TakePath(FillType fill) {
     path.ComputeBounds();
   }
   did_compute_bounds_ = false;
+  path.SetGenerationId(generation_id_);
+  generation_id_ = std::nullopt;
   return path;
 }
 
@@ -453,7 +455,7 @@ PathBuilder& PathBuilder::AddPath(const Path& path) {
   auto move = [&](size_t index, const ContourComponent& m) {
     prototype_.AddContourComponent(m.destination);
   };
-  path.EnumerateComponents(linear, quadratic, cubic, move);
+  path.IterateComponents(linear, quadratic, cubic, move);
   return *this;
 }
 
@@ -468,4 +470,9 @@ PathBuilder& PathBuilder::SetBounds(Rect bounds) {
   return *this;
 }
 
+PathBuilder& PathBuilder::SetGenerationId(uint32_t generation_id) {
+  generation_id_ = generation_id;
+  return *this;
+}
+
 }  // namespace impeller
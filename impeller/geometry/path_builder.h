@@ -105,6 +105,12 @@ class PathBuilder {
   ///        recomputing these bounds.
   PathBuilder& SetBounds(Rect bounds);
 
+  /// @brief Set the generation ID of the next path taken from this builder.
+  ///
+  ///        Only set this when the path is a faithful copy of an immutable
+  ///        source, see `Path::GetGenerationId`.
+  PathBuilder& SetGenerationId(uint32_t generation_id);
+
   struct RoundingRadii {
     Point top_left;
     Point bottom_left;
@@ -140,8 +146,9 @@ class PathBuilder {
   Point subpath_start_;
   Point current_;
   Path prototype_;
-  Convexity convexity_;
+  Convexity convexity_ = Convexity::kUnknown;
   bool did_compute_bounds_ = false;
+  std::optional<uint32_t> generation_id_;
 
   PathBuilder& AddRoundedRectTopLeft(Rect rect, RoundingRadii radii);
 
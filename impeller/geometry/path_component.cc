@@ -4,6 +4,7 @@
 
 #include "path_component.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace impeller {
@@ -63,6 +64,11 @@ std::vector<Point> LinearPathComponent::CreatePolyline() const {
   return {p2};
 }
 
+void LinearPathComponent::AppendPolylinePoints(
+    std::vector<Point>& points) const {
+  points.emplace_back(p2);
+}
+
 std::vector<Point> LinearPathComponent::Extrema() const {
   return {p1, p2};
 }
@@ -188,14 +194,40 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
 }
 
 std::vector<Point> CubicPathComponent::CreatePolyline(Scalar scale) const {
-  auto quads = ToQuadraticPathComponents(.1);
   std::vector<Point> points;
-  for (const auto& quad : quads) {
-    quad.FillPointsForPolyline(points, scale);
-  }
+  FillPointsForPolyline(points, scale);
   return points;
 }
 
+// Guards against degenerate curves and huge scales generating an absurd
+// number of points.
+static constexpr Scalar kMaxCubicSegmentCount = 1 << 10;
+
+void CubicPathComponent::FillPointsForPolyline(std::vector<Point>& points,
+                                               Scalar scale_factor) const {
+  auto tolerance = kDefaultCurveTolerance / scale_factor;
+
+  // Wang's formula for cubics: n = sqrt(3 * 2 / 8 * max|d2| / tolerance),
+  // where d2 are the second differences of the control points.
+  auto d0 = p1 - cp1 * 2 + cp2;
+  auto d1 = cp1 - cp2 * 2 + p2;
+  auto max_length_squared = std::max(d0.Dot(d0), d1.Dot(d1));
+  Scalar segment_count =
+      std::ceil(std::sqrt(0.75 * std::sqrt(max_length_squared) / tolerance));
+  // A zero scale reverts curves to lines. The comparison also catches the NaN
+  // of a straight curve at an infinite scale.
+  if (!(segment_count >= 1)) {
+    segment_count = 1;
+  }
+  segment_count = std::min(segment_count, kMaxCubicSegmentCount);
+
+  auto step = 1 / segment_count;
+  for (size_t i = 1; i < segment_count; i++) {
+    points.emplace_back(Solve(i * step));
+  }
+  points.emplace_back(p2);
+}
+
 inline QuadraticPathComponent CubicPathComponent::Lower() const {
   return QuadraticPathComponent(3.0 * (cp1 - p1), 3.0 * (cp2 - cp1),
                                 3.0 * (p2 - cp2));
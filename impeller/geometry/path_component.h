@@ -36,6 +36,8 @@ struct LinearPathComponent {
 
   std::vector<Point> CreatePolyline() const;
 
+  void AppendPolylinePoints(std::vector<Point>& points) const;
+
   std::vector<Point> Extrema() const;
 
   bool operator==(const LinearPathComponent& other) const {
@@ -108,12 +110,19 @@ struct CubicPathComponent {
 
   Point SolveDerivative(Scalar time) const;
 
-  // This method approximates the cubic component with quadratics, and then
-  // generates a polyline from those quadratics.
+  // Subdivides the curve into the number of evenly spaced segments given by
+  // Wang's formula, which bounds the distance between the curve and the
+  // polyline by the curve tolerance. The bound only depends on the second
+  // differences of the control points, so it is cheap to compute and doesn't
+  // need the allocations of lowering the curve to quadratics first.
   //
-  // See the note on QuadraticPathComponent::CreatePolyline for references.
+  // See "Rendering Curves and Surfaces with Hardware Tessellation" and the
+  // discussion in Skia's src/gpu/tessellate/WangsFormula.h.
   std::vector<Point> CreatePolyline(Scalar scale) const;
 
+  void FillPointsForPolyline(std::vector<Point>& points,
+                             Scalar scale_factor) const;
+
   std::vector<Point> Extrema() const;
 
   std::vector<QuadraticPathComponent> ToQuadraticPathComponents(
@@ -7,6 +7,7 @@
 #include <array>
 #include <optional>
 #include <ostream>
+#include <type_traits>
 #include <vector>
 
 #include "impeller/geometry/matrix.h"
@@ -202,6 +203,11 @@ struct TRect {
   /// @brief  Creates a new bounding box that contains this transformed
   ///         rectangle.
   constexpr TRect TransformBounds(const Matrix& transform) const {
+    if constexpr (std::is_same_v<Type, Scalar>) {
+      auto [left, top, right, bottom] = GetLTRB();
+      auto ltrb = transform.TransformBoundsLTRB(left, top, right, bottom);
+      return TRect::MakeLTRB(ltrb[0], ltrb[1], ltrb[2], ltrb[3]);
+    }
     auto points = GetTransformedPoints(transform);
     return TRect::MakePointBounds(points.begin(), points.end()).value();
   }
@@ -4,6 +4,7 @@
 
 #include "impeller/golden_tests/golden_digest.h"
 
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 
@@ -34,9 +35,105 @@ void GoldenDigest::AddDimension(const std::string& name,
 void GoldenDigest::AddImage(const std::string& test_name,
                             const std::string& filename,
                             int32_t width,
-                            int32_t height) {
+                            int32_t height,
+                            const Metrics& metrics) {
   entries_.push_back({test_name, filename, width, height, kMaxDiffPixelsPercent,
-                      kMaxColorDelta});
+                      kMaxColorDelta, metrics,
+                      GetRegressions(test_name, metrics)});
+}
+
+bool GoldenDigest::LoadThresholds(const std::string& path) {
+  std::ifstream fin(path);
+  if (!fin.good()) {
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(fin, line)) {
+    std::istringstream words(line);
+    std::string test_name;
+    if (!(words >> test_name) || test_name[0] == '#') {
+      continue;
+    }
+    Thresholds& thresholds = thresholds_[test_name];
+    std::string threshold;
+    while (words >> threshold) {
+      size_t equals = threshold.find('=');
+      if (equals == std::string::npos || equals + 1 == threshold.size()) {
+        return false;
+      }
+      std::string name = threshold.substr(0, equals);
+      std::string value = threshold.substr(equals + 1);
+      char* end = nullptr;
+      double number = std::strtod(value.c_str(), &end);
+      if (*end != '\0') {
+        return false;
+      }
+      if (name == "maxGpuTimeMs") {
+        thresholds.max_gpu_time_ms = number;
+      } else if (name == "maxDrawCount") {
+        thresholds.max_draw_count = static_cast<int32_t>(number);
+      } else if (name == "maxPipelineCount") {
+        thresholds.max_pipeline_count = static_cast<int32_t>(number);
+      } else if (name == "maxOffscreenCount") {
+        thresholds.max_offscreen_count = static_cast<int32_t>(number);
+      } else {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+GoldenDigest::Thresholds GoldenDigest::GetThresholds(
+    const std::string& test_name) const {
+  Thresholds result;
+  if (auto found = thresholds_.find("*"); found != thresholds_.end()) {
+    result = found->second;
+  }
+  if (auto found = thresholds_.find(test_name); found != thresholds_.end()) {
+    const Thresholds& overrides = found->second;
+    if (overrides.max_gpu_time_ms.has_value()) {
+      result.max_gpu_time_ms = overrides.max_gpu_time_ms;
+    }
+    if (overrides.max_draw_count.has_value()) {
+      result.max_draw_count = overrides.max_draw_count;
+    }
+    if (overrides.max_pipeline_count.has_value()) {
+      result.max_pipeline_count = overrides.max_pipeline_count;
+    }
+    if (overrides.max_offscreen_count.has_value()) {
+      result.max_offscreen_count = overrides.max_offscreen_count;
+    }
+  }
+  return result;
+}
+
+template <typename T>
+static bool Exceeds(const std::optional<T>& value,
+                    const std::optional<T>& threshold) {
+  return value.has_value() && threshold.has_value() &&
+         value.value() > threshold.value();
+}
+
+std::vector<std::string> GoldenDigest::GetRegressions(
+    const std::string& test_name,
+    const Metrics& metrics) const {
+  Thresholds thresholds = GetThresholds(test_name);
+  std::vector<std::string> regressions;
+  if (Exceeds(metrics.gpu_time_ms, thresholds.max_gpu_time_ms)) {
+    regressions.push_back("gpuTimeMs");
+  }
+  if (Exceeds(metrics.draw_count, thresholds.max_draw_count)) {
+    regressions.push_back("drawCount");
+  }
+  if (Exceeds(metrics.pipeline_count, thresholds.max_pipeline_count)) {
+    regressions.push_back("pipelineCount");
+  }
+  if (Exceeds(metrics.offscreen_count, thresholds.max_offscreen_count)) {
+    regressions.push_back("offscreenCount");
+  }
+  return regressions;
 }
 
 bool GoldenDigest::Write(WorkingDirectory* working_directory) {
@@ -82,7 +179,28 @@ bool GoldenDigest::Write(WorkingDirectory* working_directory) {
            << ", ";
     }
 
-    fout << "\"maxColorDelta\":" << entry.max_color_delta << " ";
+    fout << "\"maxColorDelta\":" << entry.max_color_delta << ", ";
+
+    fout << "\"performance\" : { ";
+    if (entry.metrics.gpu_time_ms.has_value()) {
+      fout << "\"gpuTimeMs\" : " << entry.metrics.gpu_time_ms.value() << ", ";
+    }
+    if (entry.metrics.draw_count.has_value()) {
+      fout << "\"drawCount\" : " << entry.metrics.draw_count.value() << ", ";
+    }
+    if (entry.metrics.pipeline_count.has_value()) {
+      fout << "\"pipelineCount\" : " << entry.metrics.pipeline_count.value()
+           << ", ";
+    }
+    if (entry.metrics.offscreen_count.has_value()) {
+      fout << "\"offscreenCount\" : " << entry.metrics.offscreen_count.value()
+           << ", ";
+    }
+    fout << "\"regressions\" : [";
+    for (size_t i = 0; i < entry.regressions.size(); i++) {
+      fout << (i == 0 ? "" : ", ") << "\"" << entry.regressions[i] << "\"";
+    }
+    fout << "] } ";
     fout << "}";
   }
   fout << std::endl << "  ]" << std::endl;
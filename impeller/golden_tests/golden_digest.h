@@ -5,6 +5,7 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,25 @@ namespace testing {
 /// Manages a global variable for tracking instances of golden images.
 class GoldenDigest {
  public:
+  /// How expensive rendering a golden image was. Metrics that couldn't be
+  /// measured, such as the counts in builds without Impeller's capture, are
+  /// unset.
+  struct Metrics {
+    std::optional<double> gpu_time_ms;
+    std::optional<int32_t> draw_count;
+    std::optional<int32_t> pipeline_count;
+    std::optional<int32_t> offscreen_count;
+  };
+
+  /// The highest metrics a test may have before it is flagged as a
+  /// regression. Unset thresholds aren't checked.
+  struct Thresholds {
+    std::optional<double> max_gpu_time_ms;
+    std::optional<int32_t> max_draw_count;
+    std::optional<int32_t> max_pipeline_count;
+    std::optional<int32_t> max_offscreen_count;
+  };
+
   static GoldenDigest* Instance();
 
   void AddDimension(const std::string& name, const std::string& value);
@@ -24,7 +44,20 @@ class GoldenDigest {
   void AddImage(const std::string& test_name,
                 const std::string& filename,
                 int32_t width,
-                int32_t height);
+                int32_t height,
+                const Metrics& metrics = {});
+
+  /// Reads the thresholds of tests from `path`. Every line holds a test name,
+  /// or "*" for the thresholds of all tests, followed by any of
+  /// "maxGpuTimeMs=<ms>", "maxDrawCount=<n>", "maxPipelineCount=<n>" and
+  /// "maxOffscreenCount=<n>". Lines starting with "#" are ignored.
+  ///
+  /// Returns `true` on success.
+  bool LoadThresholds(const std::string& path);
+
+  /// The names of the metrics of `test_name` that exceed its thresholds.
+  std::vector<std::string> GetRegressions(const std::string& test_name,
+                                          const Metrics& metrics) const;
 
   /// Writes a "digest.json" file to `working_directory`.
   ///
@@ -41,11 +74,16 @@ class GoldenDigest {
     int32_t height;
     double max_diff_pixels_percent;
     int32_t max_color_delta;
+    Metrics metrics;
+    std::vector<std::string> regressions;
   };
 
+  Thresholds GetThresholds(const std::string& test_name) const;
+
   static GoldenDigest* instance_;
   std::vector<Entry> entries_;
   std::map<std::string, std::string> dimensions_;
+  std::map<std::string, Thresholds> thresholds_;
 };
 }  // namespace testing
 }  // namespace impeller
@@ -5,9 +5,12 @@
 #include <dlfcn.h>
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "flutter/impeller/golden_tests/golden_playground_test.h"
 
+#include "flutter/fml/logging.h"
 #include "flutter/impeller/aiks/picture.h"
 #include "flutter/impeller/golden_tests/golden_digest.h"
 #include "flutter/impeller/golden_tests/metal_screenshoter.h"
@@ -78,9 +81,20 @@ bool SaveScreenshot(std::unique_ptr<testing::MetalScreenshot> screenshot) {
   std::string test_name = GetTestName();
   std::string filename = GetGoldenFilename();
   testing::GoldenDigest::Instance()->AddImage(
-      test_name, filename, screenshot->GetWidth(), screenshot->GetHeight());
-  return screenshot->WriteToPNG(
-      testing::WorkingDirectory::Instance()->GetFilenamePath(filename));
+      test_name, filename, screenshot->GetWidth(), screenshot->GetHeight(),
+      screenshot->GetMetrics());
+  if (!screenshot->WriteToPNG(
+          testing::WorkingDirectory::Instance()->GetFilenamePath(filename))) {
+    return false;
+  }
+  std::vector<std::string> regressions =
+      testing::GoldenDigest::Instance()->GetRegressions(
+          test_name, screenshot->GetMetrics());
+  for (const std::string& regression : regressions) {
+    FML_LOG(ERROR) << test_name << " exceeds its " << regression
+                   << " threshold.";
+  }
+  return regressions.empty();
 }
 }  // namespace
 
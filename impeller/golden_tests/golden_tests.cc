@@ -5,7 +5,10 @@
 #include "gtest/gtest.h"
 
 #include <sstream>
+#include <string>
+#include <vector>
 
+#include "flutter/fml/logging.h"
 #include "flutter/fml/platform/darwin/scoped_nsautorelease_pool.h"
 #include "impeller/aiks/aiks_context.h"
 #include "impeller/aiks/canvas.h"
@@ -41,9 +44,20 @@ bool SaveScreenshot(std::unique_ptr<MetalScreenshot> screenshot) {
   std::string test_name = GetTestName();
   std::string filename = GetGoldenFilename();
   GoldenDigest::Instance()->AddImage(
-      test_name, filename, screenshot->GetWidth(), screenshot->GetHeight());
-  return screenshot->WriteToPNG(
-      WorkingDirectory::Instance()->GetFilenamePath(filename));
+      test_name, filename, screenshot->GetWidth(), screenshot->GetHeight(),
+      screenshot->GetMetrics());
+  if (!screenshot->WriteToPNG(
+          WorkingDirectory::Instance()->GetFilenamePath(filename))) {
+    return false;
+  }
+  std::vector<std::string> regressions =
+      GoldenDigest::Instance()->GetRegressions(
+          test_name, screenshot->GetMetrics());
+  for (const std::string& regression : regressions) {
+    FML_LOG(ERROR) << test_name << " exceeds its " << regression
+                   << " threshold.";
+  }
+  return regressions.empty();
 }
 
 }  // namespace
@@ -14,13 +14,18 @@
 
 namespace {
 void print_usage() {
-  std::cout << "usage: impeller_golden_tests --working_dir=<working_dir>"
+  std::cout << "usage: impeller_golden_tests --working_dir=<working_dir> "
+               "[--performance_thresholds=<path>]"
             << std::endl
             << std::endl;
   std::cout << "flags:" << std::endl;
   std::cout << "  working_dir: Where the golden images will be generated and "
                "uploaded to Skia Gold from."
             << std::endl;
+  std::cout << "  performance_thresholds: Optional file with the highest GPU "
+               "time and draw, pipeline and offscreen counts of tests before "
+               "they fail as regressions."
+            << std::endl;
 }
 }  // namespace
 
@@ -38,6 +43,13 @@ int main(int argc, char** argv) {
       FML_CHECK(wordexp_result.we_wordc != 0);
       working_dir = wordexp_result.we_wordv[0];
       wordfree(&wordexp_result);
+    } else if (option.name == "performance_thresholds") {
+      if (!impeller::testing::GoldenDigest::Instance()->LoadThresholds(
+              option.value)) {
+        std::cout << "could not read the performance thresholds at \""
+                  << option.value << "\"." << std::endl;
+        return 1;
+      }
     }
   }
   if (!working_dir) {
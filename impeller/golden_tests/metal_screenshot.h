@@ -9,6 +9,7 @@
 #include <string>
 
 #include "flutter/fml/macros.h"
+#include "flutter/impeller/golden_tests/golden_digest.h"
 
 namespace impeller {
 namespace testing {
@@ -28,12 +29,16 @@ class MetalScreenshot {
 
   bool WriteToPNG(const std::string& path) const;
 
+  /// How expensive rendering the screenshot was.
+  const GoldenDigest::Metrics& GetMetrics() const { return metrics_; }
+
  private:
   friend class MetalScreenshoter;
   MetalScreenshot(CGImageRef cgImage);
   FML_DISALLOW_COPY_AND_ASSIGN(MetalScreenshot);
   CGImageRef cgImage_;
   CFDataRef pixel_data_;
+  GoldenDigest::Metrics metrics_;
 };
 }  // namespace testing
 }  // namespace impeller
@@ -5,14 +5,59 @@
 #include "flutter/impeller/golden_tests/metal_screenshoter.h"
 
 #include <CoreImage/CoreImage.h>
+#include <set>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "impeller/core/capture.h"
+#include "impeller/entity/entity_pass.h"
 #include "impeller/renderer/backend/metal/context_mtl.h"
 #include "impeller/renderer/backend/metal/texture_mtl.h"
+#include "impeller/renderer/gpu_tracer.h"
 #define GLFW_INCLUDE_NONE
 #include "third_party/glfw/include/GLFW/glfw3.h"
 
 namespace impeller {
 namespace testing {
 
+namespace {
+#ifdef IMPELLER_ENABLE_CAPTURE
+struct CaptureCounts {
+  int32_t draw_count = 0;
+  std::set<std::string> pipelines;
+  int32_t offscreen_count = 0;
+};
+
+// Adds up what the entities captured under `element` rendered, from the
+// properties the entity pass records for them.
+void CountCapturedCommands(const CaptureElement& element,
+                           CaptureCounts& counts) {
+  element.properties.Iterate([&](CaptureProperty& property) {
+    if (property.label == "Draw Count") {
+      counts.draw_count += property.AsInteger().value_or(0);
+    } else if (property.label == "Pipelines") {
+      std::string pipelines = property.AsString().value_or("");
+      size_t start = 0;
+      while (start < pipelines.size()) {
+        size_t end = pipelines.find(", ", start);
+        if (end == std::string::npos) {
+          end = pipelines.size();
+        }
+        counts.pipelines.insert(pipelines.substr(start, end - start));
+        start = end + 2;
+      }
+    }
+  });
+  element.children.Iterate([&](CaptureElement& child) {
+    // Collapsed passes are drawn into their parent.
+    if (child.label == "EntityPass") {
+      counts.offscreen_count++;
+    }
+    CountCapturedCommands(child, counts);
+  });
+}
+#endif  // IMPELLER_ENABLE_CAPTURE
+}  // namespace
+
 MetalScreenshoter::MetalScreenshoter() {
   FML_CHECK(::glfwInit() == GLFW_TRUE);
   playground_ =
@@ -23,10 +68,48 @@ std::unique_ptr<MetalScreenshot> MetalScreenshoter::MakeScreenshot(
     AiksContext& aiks_context,
     const Picture& picture,
     const ISize& size) {
+  std::shared_ptr<Context> context = aiks_context.GetContext();
+  std::shared_ptr<GPUTracer> gpu_tracer = context->GetGPUTracer();
+#ifdef IMPELLER_ENABLE_CAPTURE
+  context->capture =
+      CaptureContext::MakeAllowlist({EntityPass::kCaptureDocumentName});
+#endif  // IMPELLER_ENABLE_CAPTURE
+  if (gpu_tracer) {
+    gpu_tracer->SetEnabled(true);
+    gpu_tracer->MarkFrameStart();
+  }
+
   Vector2 content_scale = playground_->GetContentScale();
   std::shared_ptr<Image> image = picture.ToImage(
       aiks_context,
       ISize(size.width * content_scale.x, size.height * content_scale.y));
+
+  GoldenDigest::Metrics metrics;
+  if (gpu_tracer) {
+    fml::AutoResetWaitableEvent latch;
+    gpu_tracer->MarkFrameEnd([&](const GPUTracer::FrameResult& result) {
+      if (result.command_buffer_count > 0) {
+        metrics.gpu_time_ms = result.gpu_duration.ToMillisecondsF();
+      }
+      latch.Signal();
+    });
+    latch.Wait();
+    gpu_tracer->SetEnabled(false);
+  }
+#ifdef IMPELLER_ENABLE_CAPTURE
+  if (context->capture.DoesDocumentExist(EntityPass::kCaptureDocumentName)) {
+    CaptureCounts counts;
+    CountCapturedCommands(
+        *context->capture.GetDocument(EntityPass::kCaptureDocumentName)
+             .GetElement(),
+        counts);
+    metrics.draw_count = counts.draw_count;
+    metrics.pipeline_count = static_cast<int32_t>(counts.pipelines.size());
+    metrics.offscreen_count = counts.offscreen_count;
+  }
+  context->capture = CaptureContext::MakeInactive();
+#endif  // IMPELLER_ENABLE_CAPTURE
+
   std::shared_ptr<Texture> texture = image->GetTexture();
   id<MTLTexture> metal_texture =
       std::static_pointer_cast<TextureMTL>(texture)->GetMTLTexture();
@@ -39,7 +122,6 @@ std::unique_ptr<MetalScreenshot> MetalScreenshoter::MakeScreenshot(
                                                  options:@{}];
   FML_CHECK(ciImage);
 
-  std::shared_ptr<Context> context = playground_->GetContext();
   std::shared_ptr<ContextMTL> context_mtl =
       std::static_pointer_cast<ContextMTL>(context);
   CIContext* cicontext =
@@ -52,7 +134,10 @@ std::unique_ptr<MetalScreenshot> MetalScreenshoter::MakeScreenshot(
   CGImageRef cgImage = [cicontext createCGImage:flipped
                                        fromRect:[ciImage extent]];
 
-  return std::unique_ptr<MetalScreenshot>(new MetalScreenshot(cgImage));
+  auto screenshot =
+      std::unique_ptr<MetalScreenshot>(new MetalScreenshot(cgImage));
+  screenshot->metrics_ = metrics;
+  return screenshot;
 }
 
 }  // namespace testing
@@ -0,0 +1,327 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/image/etc2_encoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace impeller {
+
+namespace {
+
+// The pixels of a block, indexed the way ETC2 indexes them: column by column,
+// so that pixel (x, y) is at x * 4 + y.
+struct Block {
+  uint8_t rgb[16][3];
+  uint8_t alpha[16];
+};
+
+// The ETC1 intensity modifiers of the eight codewords, for the pixel indices
+// 0 and 1. Indices 2 and 3 are their negations.
+constexpr int kColorModifiers[8][2] = {
+    {2, 8},   {5, 17},  {9, 29},   {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+// The EAC alpha modifiers of the sixteen tables.
+constexpr int kAlphaModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},  {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},  {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},  {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},  {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},   {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},   {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},   {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+// Table 13 has a zero modifier at index 4, which encodes flat alpha exactly.
+constexpr uint64_t kFlatAlphaTable = 13u;
+constexpr uint64_t kFlatAlphaIndex = 4u;
+
+constexpr int Clamp255(int value) {
+  return std::clamp(value, 0, 255);
+}
+
+constexpr int Square(int value) {
+  return value * value;
+}
+
+void StoreBigEndian(uint64_t value, uint8_t* destination) {
+  for (int i = 7; i >= 0; i--) {
+    destination[i] = static_cast<uint8_t>(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+void LoadBlock(const uint8_t* pixels,
+               ISize size,
+               size_t row_bytes,
+               bool is_bgra,
+               int64_t block_x,
+               int64_t block_y,
+               Block& block) {
+  const int red = is_bgra ? 2 : 0;
+  const int blue = is_bgra ? 0 : 2;
+  for (int x = 0; x < 4; x++) {
+    const int64_t image_x = std::min(block_x * 4 + x, size.width - 1);
+    for (int y = 0; y < 4; y++) {
+      const int64_t image_y = std::min(block_y * 4 + y, size.height - 1);
+      const uint8_t* pixel = pixels + image_y * row_bytes + image_x * 4;
+      const int index = x * 4 + y;
+      block.rgb[index][0] = pixel[red];
+      block.rgb[index][1] = pixel[1];
+      block.rgb[index][2] = pixel[blue];
+      block.alpha[index] = pixel[3];
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// EAC alpha.
+//
+
+uint64_t EncodeAlpha(const Block& block) {
+  const auto [min_it, max_it] =
+      std::minmax_element(std::begin(block.alpha), std::end(block.alpha));
+  const int min_alpha = *min_it;
+  const int max_alpha = *max_it;
+
+  if (min_alpha == max_alpha) {
+    uint64_t bits = static_cast<uint64_t>(min_alpha) << 56 |
+                    uint64_t{1u} << 52 | kFlatAlphaTable << 48;
+    for (int i = 0; i < 16; i++) {
+      bits |= kFlatAlphaIndex << (45 - 3 * i);
+    }
+    return bits;
+  }
+
+  uint64_t best_bits = 0;
+  int best_error = std::numeric_limits<int>::max();
+  for (int table = 0; table < 16; table++) {
+    const int* modifiers = kAlphaModifiers[table];
+    // Index 3 holds the smallest modifier of every table and index 7 the
+    // largest.
+    const int span = modifiers[7] - modifiers[3];
+    const int estimate = std::clamp(
+        static_cast<int>(
+            std::lround(static_cast<double>(max_alpha - min_alpha) / span)),
+        1, 15);
+    for (int multiplier = std::max(estimate - 1, 1);
+         multiplier <= std::min(estimate + 1, 15); multiplier++) {
+      const int base = Clamp255(static_cast<int>(std::lround(
+          (min_alpha + max_alpha) / 2.0 -
+          (modifiers[3] + modifiers[7]) * multiplier / 2.0)));
+      uint64_t bits = static_cast<uint64_t>(base) << 56 |
+                      static_cast<uint64_t>(multiplier) << 52 |
+                      static_cast<uint64_t>(table) << 48;
+      int error = 0;
+      for (int i = 0; i < 16 && error < best_error; i++) {
+        int best_pixel_error = std::numeric_limits<int>::max();
+        uint64_t best_index = 0;
+        for (int index = 0; index < 8; index++) {
+          const int value = Clamp255(base + modifiers[index] * multiplier);
+          const int pixel_error = Square(value - block.alpha[i]);
+          if (pixel_error < best_pixel_error) {
+            best_pixel_error = pixel_error;
+            best_index = index;
+          }
+        }
+        error += best_pixel_error;
+        bits |= best_index << (45 - 3 * i);
+      }
+      if (error < best_error) {
+        best_error = error;
+        best_bits = bits;
+      }
+    }
+  }
+  return best_bits;
+}
+
+//------------------------------------------------------------------------------
+// ETC2 color, in the modes shared with ETC1.
+//
+
+struct SubBlockFit {
+  int error = std::numeric_limits<int>::max();
+  uint64_t codeword = 0;
+  // The pixel index bits of the sub-block, in their block positions.
+  uint64_t index_bits = 0;
+};
+
+// The block indices of the pixels in each sub-block, without and with the
+// flip bit.
+int SubBlockPixel(bool flip, int sub_block, int i) {
+  // Without flip, the sub-blocks are the left and right 2x4 halves, which are
+  // contiguous in column order. With flip, they are the top and bottom 4x2
+  // halves.
+  if (!flip) {
+    return sub_block * 8 + i;
+  }
+  const int x = i / 2;
+  const int y = sub_block * 2 + i % 2;
+  return x * 4 + y;
+}
+
+SubBlockFit FitSubBlock(const Block& block,
+                        bool flip,
+                        int sub_block,
+                        const int base[3]) {
+  SubBlockFit best;
+  for (int codeword = 0; codeword < 8; codeword++) {
+    const int modifiers[4] = {
+        kColorModifiers[codeword][0], kColorModifiers[codeword][1],
+        -kColorModifiers[codeword][0], -kColorModifiers[codeword][1]};
+    SubBlockFit fit;
+    fit.error = 0;
+    fit.codeword = codeword;
+    for (int i = 0; i < 8 && fit.error < best.error; i++) {
+      const int pixel = SubBlockPixel(flip, sub_block, i);
+      int best_pixel_error = std::numeric_limits<int>::max();
+      uint64_t best_index = 0;
+      for (int index = 0; index < 4; index++) {
+        int pixel_error = 0;
+        for (int c = 0; c < 3; c++) {
+          pixel_error += Square(Clamp255(base[c] + modifiers[index]) -
+                                block.rgb[pixel][c]);
+        }
+        if (pixel_error < best_pixel_error) {
+          best_pixel_error = pixel_error;
+          best_index = index;
+        }
+      }
+      fit.error += best_pixel_error;
+      fit.index_bits |= (best_index >> 1) << (16 + pixel);
+      fit.index_bits |= (best_index & 1) << pixel;
+    }
+    if (fit.error < best.error) {
+      best = fit;
+    }
+  }
+  return best;
+}
+
+void AverageSubBlock(const Block& block,
+                     bool flip,
+                     int sub_block,
+                     double average[3]) {
+  for (int c = 0; c < 3; c++) {
+    int sum = 0;
+    for (int i = 0; i < 8; i++) {
+      sum += block.rgb[SubBlockPixel(flip, sub_block, i)][c];
+    }
+    average[c] = sum / 8.0;
+  }
+}
+
+int Quantize(double value, int max) {
+  return std::clamp(static_cast<int>(std::lround(value * max / 255.0)), 0,
+                    max);
+}
+
+uint64_t EncodeColor(const Block& block) {
+  uint64_t best_bits = 0;
+  int best_error = std::numeric_limits<int>::max();
+
+  for (const bool flip : {false, true}) {
+    double averages[2][3];
+    AverageSubBlock(block, flip, 0, averages[0]);
+    AverageSubBlock(block, flip, 1, averages[1]);
+
+    auto try_mode = [&](const int bases[2][3], uint64_t base_bits,
+                        bool differential) {
+      const SubBlockFit first = FitSubBlock(block, flip, 0, bases[0]);
+      const SubBlockFit second = FitSubBlock(block, flip, 1, bases[1]);
+      const int error = first.error + second.error;
+      if (error >= best_error) {
+        return;
+      }
+      best_error = error;
+      best_bits = base_bits | first.codeword << 37 | second.codeword << 34 |
+                  static_cast<uint64_t>(differential) << 33 |
+                  static_cast<uint64_t>(flip) << 32 | first.index_bits |
+                  second.index_bits;
+    };
+
+    // Differential mode: a 5-bit base color and a 3-bit signed offset to the
+    // second sub-block. Offsets that leave the 5-bit range would select the
+    // ETC2-only modes, so those are skipped.
+    int first[3];
+    int delta[3];
+    bool differential_fits = true;
+    for (int c = 0; c < 3; c++) {
+      first[c] = Quantize(averages[0][c], 31);
+      delta[c] = Quantize(averages[1][c], 31) - first[c];
+      differential_fits &= delta[c] >= -4 && delta[c] <= 3;
+    }
+    if (differential_fits) {
+      int bases[2][3];
+      uint64_t base_bits = 0;
+      for (int c = 0; c < 3; c++) {
+        const int second = first[c] + delta[c];
+        bases[0][c] = first[c] << 3 | first[c] >> 2;
+        bases[1][c] = second << 3 | second >> 2;
+        base_bits |= static_cast<uint64_t>(first[c]) << (59 - 8 * c);
+        base_bits |= static_cast<uint64_t>(delta[c] & 0x7) << (56 - 8 * c);
+      }
+      try_mode(bases, base_bits, true);
+    }
+
+    // Individual mode: a 4-bit base color for each sub-block.
+    {
+      int bases[2][3];
+      uint64_t base_bits = 0;
+      for (int c = 0; c < 3; c++) {
+        const int quantized_first = Quantize(averages[0][c], 15);
+        const int quantized_second = Quantize(averages[1][c], 15);
+        bases[0][c] = quantized_first << 4 | quantized_first;
+        bases[1][c] = quantized_second << 4 | quantized_second;
+        base_bits |= static_cast<uint64_t>(quantized_first) << (60 - 8 * c);
+        base_bits |= static_cast<uint64_t>(quantized_second) << (56 - 8 * c);
+      }
+      try_mode(bases, base_bits, false);
+    }
+  }
+  return best_bits;
+}
+
+}  // namespace
+
+size_t GetETC2RGBA8ByteSize(ISize size) {
+  if (size.IsEmpty()) {
+    return 0u;
+  }
+  const auto blocks_wide = static_cast<size_t>((size.width + 3) / 4);
+  const auto blocks_high = static_cast<size_t>((size.height + 3) / 4);
+  return blocks_wide * blocks_high * kETC2RGBA8BlockByteSize;
+}
+
+bool EncodeETC2RGBA8(const uint8_t* pixels,
+                     ISize size,
+                     size_t row_bytes,
+                     bool is_bgra,
+                     uint8_t* blocks) {
+  if (!pixels || !blocks || size.IsEmpty() ||
+      row_bytes < static_cast<size_t>(size.width) * 4u) {
+    return false;
+  }
+
+  const int64_t blocks_wide = (size.width + 3) / 4;
+  const int64_t blocks_high = (size.height + 3) / 4;
+  Block block;
+  for (int64_t block_y = 0; block_y < blocks_high; block_y++) {
+    for (int64_t block_x = 0; block_x < blocks_wide; block_x++) {
+      LoadBlock(pixels, size, row_bytes, is_bgra, block_x, block_y, block);
+      StoreBigEndian(EncodeAlpha(block), blocks);
+      StoreBigEndian(EncodeColor(block), blocks + 8);
+      blocks += kETC2RGBA8BlockByteSize;
+    }
+  }
+  return true;
+}
+
+}  // namespace impeller
@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+/// The size of an ETC2 RGBA8 block, which holds 4x4 pixels.
+static constexpr size_t kETC2RGBA8BlockByteSize = 16u;
+
+//------------------------------------------------------------------------------
+/// @brief      The size of the ETC2 RGBA8 blocks that cover an image of `size`.
+///
+size_t GetETC2RGBA8ByteSize(ISize size);
+
+//------------------------------------------------------------------------------
+/// @brief      Encodes 8-bit four channel pixels as ETC2 RGBA8 (ETC2 color
+///             with EAC alpha) blocks, in rows of blocks from the top left.
+///
+///             This is a fast encoder meant for the runtime: it only uses the
+///             individual and differential modes that ETC2 shares with ETC1,
+///             and searches their tables exhaustively but not the base colors.
+///             The pixels past the right and bottom edges of images whose
+///             size isn't a multiple of four repeat the edge pixels.
+///
+/// @param[in]  pixels     The pixels, in RGBA or BGRA order.
+/// @param[in]  size       The size of the image in pixels.
+/// @param[in]  row_bytes  The stride of the rows of `pixels`.
+/// @param[in]  is_bgra    Whether `pixels` are in BGRA order.
+/// @param[out] blocks     The destination, of `GetETC2RGBA8ByteSize(size)`
+///                        bytes.
+///
+/// @return     Whether the image was encoded. Fails for empty images and
+///             strides that are too small.
+///
+bool EncodeETC2RGBA8(const uint8_t* pixels,
+                     ISize size,
+                     size_t row_bytes,
+                     bool is_bgra,
+                     uint8_t* blocks);
+
+}  // namespace impeller
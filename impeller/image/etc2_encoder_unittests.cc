@@ -0,0 +1,188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/image/etc2_encoder.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+constexpr int kColorModifiers[8][2] = {
+    {2, 8},   {5, 17},  {9, 29},   {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+constexpr int kAlphaModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},  {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},  {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},  {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},  {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},   {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},   {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},   {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+uint64_t LoadBigEndian(const uint8_t* bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; i++) {
+    value = value << 8 | bytes[i];
+  }
+  return value;
+}
+
+// Decodes the block modes that the encoder uses into RGBA pixels.
+void DecodeBlock(const uint8_t* block, uint8_t pixels[16][4]) {
+  const uint64_t alpha = LoadBigEndian(block);
+  const int alpha_base = static_cast<int>(alpha >> 56);
+  const int multiplier = static_cast<int>(alpha >> 52 & 0xF);
+  const int* alpha_modifiers = kAlphaModifiers[alpha >> 48 & 0xF];
+
+  const uint64_t color = LoadBigEndian(block + 8);
+  const bool differential = color >> 33 & 1;
+  const bool flip = color >> 32 & 1;
+  int bases[2][3];
+  for (int c = 0; c < 3; c++) {
+    if (differential) {
+      const int first = static_cast<int>(color >> (59 - 8 * c) & 0x1F);
+      int delta = static_cast<int>(color >> (56 - 8 * c) & 0x7);
+      delta = delta >= 4 ? delta - 8 : delta;
+      const int second = first + delta;
+      ASSERT_GE(second, 0);
+      ASSERT_LE(second, 31);
+      bases[0][c] = first << 3 | first >> 2;
+      bases[1][c] = second << 3 | second >> 2;
+    } else {
+      const int first = static_cast<int>(color >> (60 - 8 * c) & 0xF);
+      const int second = static_cast<int>(color >> (56 - 8 * c) & 0xF);
+      bases[0][c] = first << 4 | first;
+      bases[1][c] = second << 4 | second;
+    }
+  }
+  const int codewords[2] = {static_cast<int>(color >> 37 & 0x7),
+                            static_cast<int>(color >> 34 & 0x7)};
+
+  for (int x = 0; x < 4; x++) {
+    for (int y = 0; y < 4; y++) {
+      const int i = x * 4 + y;
+      const int sub_block = flip ? y / 2 : x / 2;
+      const int index = static_cast<int>((color >> (16 + i) & 1) << 1 |
+                                         (color >> i & 1));
+      const int* modifiers = kColorModifiers[codewords[sub_block]];
+      const int modifier = index & 2 ? -modifiers[index & 1]
+                                     : modifiers[index & 1];
+      // Decoded pixels are stored in row order.
+      uint8_t* pixel = pixels[y * 4 + x];
+      for (int c = 0; c < 3; c++) {
+        pixel[c] = std::clamp(bases[sub_block][c] + modifier, 0, 255);
+      }
+      const int alpha_index = static_cast<int>(alpha >> (45 - 3 * i) & 0x7);
+      pixel[3] = std::clamp(
+          alpha_base + alpha_modifiers[alpha_index] * multiplier, 0, 255);
+    }
+  }
+}
+
+std::vector<uint8_t> Encode(const std::vector<uint8_t>& pixels,
+                            ISize size,
+                            bool is_bgra = false) {
+  std::vector<uint8_t> blocks(GetETC2RGBA8ByteSize(size));
+  EXPECT_TRUE(EncodeETC2RGBA8(pixels.data(), size, size.width * 4, is_bgra,
+                              blocks.data()));
+  return blocks;
+}
+
+int MaxError(const std::vector<uint8_t>& pixels,
+             ISize size,
+             const std::vector<uint8_t>& blocks) {
+  const int64_t blocks_wide = (size.width + 3) / 4;
+  int max_error = 0;
+  for (int64_t y = 0; y < size.height; y++) {
+    for (int64_t x = 0; x < size.width; x++) {
+      uint8_t decoded[16][4];
+      DecodeBlock(
+          &blocks[((y / 4) * blocks_wide + x / 4) * kETC2RGBA8BlockByteSize],
+          decoded);
+      const uint8_t* pixel = &pixels[(y * size.width + x) * 4];
+      for (int c = 0; c < 4; c++) {
+        max_error = std::max(
+            max_error, std::abs(decoded[(y % 4) * 4 + x % 4][c] - pixel[c]));
+      }
+    }
+  }
+  return max_error;
+}
+
+}  // namespace
+
+TEST(ETC2EncoderTest, SizesCoverPartialBlocks) {
+  EXPECT_EQ(GetETC2RGBA8ByteSize(ISize(0, 4)), 0u);
+  EXPECT_EQ(GetETC2RGBA8ByteSize(ISize(4, 4)), 16u);
+  EXPECT_EQ(GetETC2RGBA8ByteSize(ISize(5, 4)), 32u);
+  EXPECT_EQ(GetETC2RGBA8ByteSize(ISize(9, 9)), 144u);
+}
+
+TEST(ETC2EncoderTest, RejectsInvalidImages) {
+  std::vector<uint8_t> pixels(64);
+  std::vector<uint8_t> blocks(16);
+  EXPECT_FALSE(
+      EncodeETC2RGBA8(pixels.data(), ISize(0, 0), 0, false, blocks.data()));
+  EXPECT_FALSE(
+      EncodeETC2RGBA8(pixels.data(), ISize(4, 4), 8, false, blocks.data()));
+  EXPECT_FALSE(EncodeETC2RGBA8(nullptr, ISize(4, 4), 16, false, blocks.data()));
+}
+
+TEST(ETC2EncoderTest, EncodesFlatColorsClosely) {
+  const ISize size(4, 4);
+  std::vector<uint8_t> pixels;
+  for (int i = 0; i < 16; i++) {
+    pixels.insert(pixels.end(), {200, 100, 50, 255});
+  }
+  const std::vector<uint8_t> blocks = Encode(pixels, size);
+  EXPECT_LE(MaxError(pixels, size, blocks), 4);
+
+  uint8_t decoded[16][4];
+  DecodeBlock(blocks.data(), decoded);
+  for (const auto& pixel : decoded) {
+    EXPECT_EQ(pixel[3], 255);
+  }
+}
+
+TEST(ETC2EncoderTest, EncodesGradientsClosely) {
+  const ISize size(16, 16);
+  std::vector<uint8_t> pixels;
+  for (int64_t y = 0; y < size.height; y++) {
+    for (int64_t x = 0; x < size.width; x++) {
+      const uint8_t alpha = static_cast<uint8_t>(255 - y * 8);
+      pixels.insert(pixels.end(), {static_cast<uint8_t>(x * 8 * alpha / 255),
+                                   static_cast<uint8_t>(y * 8 * alpha / 255),
+                                   static_cast<uint8_t>(64 * alpha / 255),
+                                   alpha});
+    }
+  }
+  EXPECT_LE(MaxError(pixels, size, Encode(pixels, size)), 16);
+}
+
+TEST(ETC2EncoderTest, SwizzlesBGRAPixels) {
+  const ISize size(6, 5);
+  std::vector<uint8_t> rgba;
+  std::vector<uint8_t> bgra;
+  for (int i = 0; i < size.Area(); i++) {
+    const uint8_t r = static_cast<uint8_t>(i * 7);
+    const uint8_t g = static_cast<uint8_t>(255 - i * 5);
+    const uint8_t b = static_cast<uint8_t>(i * 3);
+    rgba.insert(rgba.end(), {r, g, b, 255});
+    bgra.insert(bgra.end(), {b, g, r, 255});
+  }
+  EXPECT_EQ(Encode(bgra, size, /*is_bgra=*/true), Encode(rgba, size));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -86,6 +86,13 @@ CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
     gl.GetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &value);
     num_shader_binary_formats = value;
   }
+
+  if (gl.GetDescription()->IsES() &&
+      gl.GetDescription()->GetGlVersion().IsAtLeast(Version(3, 0, 0))) {
+    GLint value = 0;
+    gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &value);
+    num_program_binary_formats = value;
+  }
 }
 
 size_t CapabilitiesGLES::GetMaxTextureUnits(ShaderStage stage) const {
@@ -56,6 +56,9 @@ struct CapabilitiesGLES {
   // May be 0.
   size_t num_shader_binary_formats = 0;
 
+  // May be 0. Always 0 before OpenGL ES 3.0.
+  size_t num_program_binary_formats = 0;
+
   size_t GetMaxTextureUnits(ShaderStage stage) const;
 };
 
@@ -11,14 +11,16 @@ namespace impeller {
 
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
-    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries) {
-  return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries));
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+    fml::UniqueFD cache_directory) {
+  return std::shared_ptr<ContextGLES>(new ContextGLES(
+      std::move(gl), shader_libraries, std::move(cache_directory)));
 }
 
 ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
                          const std::vector<std::shared_ptr<fml::Mapping>>&
-                             shader_libraries_mappings) {
+                             shader_libraries_mappings,
+                         fml::UniqueFD cache_directory) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -38,8 +40,10 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    auto program_cache = std::make_shared<ProgramCacheGLES>(
+        reactor_->GetProcTable(), std::move(cache_directory));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, std::move(program_cache)));
   }
 
   // Create allocators.
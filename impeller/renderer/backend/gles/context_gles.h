@@ -5,6 +5,7 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/gles/allocator_gles.h"
 #include "impeller/renderer/backend/gles/command_buffer_gles.h"
@@ -23,7 +24,8 @@ class ContextGLES final : public Context,
  public:
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
-      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
+      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+      fml::UniqueFD cache_directory = {});
 
   // |Context|
   ~ContextGLES() override;
@@ -49,7 +51,8 @@ class ContextGLES final : public Context,
 
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
-      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
+      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+      fml::UniqueFD cache_directory);
 
   // |Context|
   std::string DescribeGpuModel() const override;
@@ -121,6 +121,10 @@ bool DescriptionGLES::IsValid() const {
   return is_valid_;
 }
 
+Version DescriptionGLES::GetGlVersion() const {
+  return gl_version_;
+}
+
 std::string DescriptionGLES::GetString() const {
   if (!IsValid()) {
     return "Unknown Renderer.";
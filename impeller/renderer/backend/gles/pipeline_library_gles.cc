@@ -4,8 +4,10 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "flutter/fml/container.h"
 #include "flutter/fml/trace_event.h"
@@ -15,8 +17,10 @@
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+PipelineLibraryGLES::PipelineLibraryGLES(
+    ReactorGLES::Ref reactor,
+    std::shared_ptr<ProgramCacheGLES> program_cache)
+    : reactor_(std::move(reactor)), program_cache_(std::move(program_cache)) {}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -69,102 +73,264 @@ static void LogShaderCompilationFailure(const ProcTableGLES& gl,
   VALIDATION_LOG << stream.str();
 }
 
-static bool LinkProgram(
-    const ReactorGLES& reactor,
-    const std::shared_ptr<PipelineGLES>& pipeline,
-    const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+//------------------------------------------------------------------------------
+/// @brief      A program whose shaders were submitted for compilation and
+///             linking, but whose results were not queried yet.
+///
+struct PipelineLibraryGLES::ProgramLink {
+  PipelineRequest request;
+  std::shared_ptr<PipelineGLES> pipeline;
+  GLuint program = GL_NONE;
+  GLuint vert_shader = GL_NONE;
+  GLuint frag_shader = GL_NONE;
+  std::shared_ptr<const fml::Mapping> vert_mapping;
+  std::shared_ptr<const fml::Mapping> frag_mapping;
+  uint64_t cache_key = 0u;
+  bool loaded_from_cache = false;
+};
+
+// SPIRV-Cross emits the specialization constants of GLSL shaders as macros
+// that default to the declared values unless they are already defined.
+static std::shared_ptr<const fml::Mapping> SpecializeShaderSource(
+    std::shared_ptr<const fml::Mapping> mapping,
+    const std::vector<Scalar>& constants) {
+  if (constants.empty()) {
+    return mapping;
+  }
+  std::string source(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+  std::stringstream defines;
+  for (size_t i = 0; i < constants.size(); i++) {
+    defines << "#define SPIRV_CROSS_CONSTANT_ID_" << i << " "
+            << std::to_string(constants[i]) << "\n";
+  }
+  // The defines must follow the version directive, if there is one.
+  size_t position = 0u;
+  if (source.compare(0, 8, "#version") == 0) {
+    position = source.find('\n');
+    position = position == std::string::npos ? source.size() : position + 1;
+  }
+  source.insert(position, defines.str());
+  std::vector<uint8_t> data(source.begin(), source.end());
+  return std::make_shared<fml::DataMapping>(std::move(data));
+}
+
+static std::optional<uint64_t> GetCacheKey(
+    const ProgramCacheGLES* program_cache,
+    const fml::Mapping& vert_mapping,
+    const fml::Mapping& frag_mapping,
+    const std::vector<std::pair<GLuint, std::string>>& attributes) {
+  if (!program_cache || !program_cache->IsEnabled()) {
+    return std::nullopt;
+  }
+  return ProgramCacheGLES::MakeKey(vert_mapping, frag_mapping, attributes);
+}
+
+bool PipelineLibraryGLES::BeginLinkProgram(const ReactorGLES& reactor,
+                                           ProgramLink& link) const {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  const auto& descriptor = pipeline->GetDescriptor();
+  const auto& descriptor = link.pipeline->GetDescriptor();
 
-  auto vert_mapping =
-      ShaderFunctionGLES::Cast(*vert_function).GetSourceMapping();
-  auto frag_mapping =
-      ShaderFunctionGLES::Cast(*frag_function).GetSourceMapping();
+  link.vert_mapping = SpecializeShaderSource(
+      ShaderFunctionGLES::Cast(*link.request.vert_function).GetSourceMapping(),
+      descriptor.GetSpecializationConstants());
+  link.frag_mapping = SpecializeShaderSource(
+      ShaderFunctionGLES::Cast(*link.request.frag_function).GetSourceMapping(),
+      descriptor.GetSpecializationConstants());
 
   const auto& gl = reactor.GetProcTable();
 
-  auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
-  auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
+  auto program = reactor.GetGLHandle(link.pipeline->GetProgramHandle());
+  if (!program.has_value()) {
+    VALIDATION_LOG << "Could not get program handle from reactor.";
+    return false;
+  }
+  link.program = program.value();
+
+  std::vector<std::pair<GLuint, std::string>> attributes;
+  for (const auto& stage_input :
+       descriptor.GetVertexDescriptor()->GetStageInputs()) {
+    attributes.emplace_back(static_cast<GLuint>(stage_input.location),
+                            stage_input.name);
+  }
+
+  auto cache_key = GetCacheKey(program_cache_.get(), *link.vert_mapping,
+                               *link.frag_mapping, attributes);
+  if (cache_key.has_value()) {
+    link.cache_key = cache_key.value();
+    if (program_cache_->LoadProgram(gl, link.program, link.cache_key)) {
+      link.loaded_from_cache = true;
+      return true;
+    }
+  }
+
+  link.vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
+  link.frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
 
-  if (vert_shader == 0 || frag_shader == 0) {
+  if (link.vert_shader == 0 || link.frag_shader == 0) {
     VALIDATION_LOG << "Could not create shader handles.";
     return false;
   }
 
-  gl.SetDebugLabel(DebugResourceType::kShader, vert_shader,
+  gl.SetDebugLabel(DebugResourceType::kShader, link.vert_shader,
                    SPrintF("%s Vertex Shader", descriptor.GetLabel().c_str()));
   gl.SetDebugLabel(
-      DebugResourceType::kShader, frag_shader,
+      DebugResourceType::kShader, link.frag_shader,
       SPrintF("%s Fragment Shader", descriptor.GetLabel().c_str()));
 
-  fml::ScopedCleanupClosure delete_vert_shader(
-      [&gl, vert_shader]() { gl.DeleteShader(vert_shader); });
-  fml::ScopedCleanupClosure delete_frag_shader(
-      [&gl, frag_shader]() { gl.DeleteShader(frag_shader); });
+  gl.ShaderSourceMapping(link.vert_shader, *link.vert_mapping);
+  gl.ShaderSourceMapping(link.frag_shader, *link.frag_mapping);
 
-  gl.ShaderSourceMapping(vert_shader, *vert_mapping);
-  gl.ShaderSourceMapping(frag_shader, *frag_mapping);
+  gl.CompileShader(link.vert_shader);
+  gl.CompileShader(link.frag_shader);
 
-  gl.CompileShader(vert_shader);
-  gl.CompileShader(frag_shader);
+  gl.AttachShader(link.program, link.vert_shader);
+  gl.AttachShader(link.program, link.frag_shader);
+
+  for (const auto& [location, name] : attributes) {
+    gl.BindAttribLocation(link.program, location, name.c_str());
+  }
+
+  if (cache_key.has_value()) {
+    gl.ProgramParameteri(link.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                         GL_TRUE);
+  }
+
+  // A failed compilation fails the link, so the compile status is only
+  // queried, and waited on, once the link status is.
+  gl.LinkProgram(link.program);
+  return true;
+}
+
+static bool IsLinkComplete(const ProcTableGLES& gl, GLuint program) {
+  // Without GL_KHR_parallel_shader_compile, querying the completion status is
+  // not supported, and any status query waits for the link.
+  if (!gl.MaxShaderCompilerThreadsKHR.IsAvailable()) {
+    return true;
+  }
+  GLint completion_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completion_status);
+  return completion_status == GL_TRUE;
+}
+
+bool PipelineLibraryGLES::FinishLinkProgram(const ReactorGLES& reactor,
+                                            ProgramLink& link) const {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+
+  if (link.loaded_from_cache) {
+    return true;
+  }
+
+  const auto& gl = reactor.GetProcTable();
+  const auto& descriptor = link.pipeline->GetDescriptor();
+
+  fml::ScopedCleanupClosure delete_shaders([&gl, &link]() {
+    gl.DetachShader(link.program, link.vert_shader);
+    gl.DetachShader(link.program, link.frag_shader);
+    gl.DeleteShader(link.vert_shader);
+    gl.DeleteShader(link.frag_shader);
+  });
+
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(link.program, GL_LINK_STATUS, &link_status);
+  if (link_status == GL_TRUE) {
+    if (program_cache_) {
+      program_cache_->StoreProgram(gl, link.program, link.cache_key);
+    }
+    return true;
+  }
 
   GLint vert_status = GL_FALSE;
   GLint frag_status = GL_FALSE;
 
-  gl.GetShaderiv(vert_shader, GL_COMPILE_STATUS, &vert_status);
-  gl.GetShaderiv(frag_shader, GL_COMPILE_STATUS, &frag_status);
+  gl.GetShaderiv(link.vert_shader, GL_COMPILE_STATUS, &vert_status);
+  gl.GetShaderiv(link.frag_shader, GL_COMPILE_STATUS, &frag_status);
 
   if (vert_status != GL_TRUE) {
-    LogShaderCompilationFailure(gl, vert_shader, descriptor.GetLabel(),
-                                *vert_mapping, ShaderStage::kVertex);
+    LogShaderCompilationFailure(gl, link.vert_shader, descriptor.GetLabel(),
+                                *link.vert_mapping, ShaderStage::kVertex);
     return false;
   }
 
   if (frag_status != GL_TRUE) {
-    LogShaderCompilationFailure(gl, frag_shader, descriptor.GetLabel(),
-                                *frag_mapping, ShaderStage::kFragment);
-    return false;
-  }
-
-  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-  if (!program.has_value()) {
-    VALIDATION_LOG << "Could not get program handle from reactor.";
+    LogShaderCompilationFailure(gl, link.frag_shader, descriptor.GetLabel(),
+                                *link.frag_mapping, ShaderStage::kFragment);
     return false;
   }
 
-  gl.AttachShader(*program, vert_shader);
-  gl.AttachShader(*program, frag_shader);
+  VALIDATION_LOG << "Could not link shader program: "
+                 << gl.GetProgramInfoLogString(link.program);
+  return false;
+}
 
-  fml::ScopedCleanupClosure detach_vert_shader(
-      [&gl, program = *program, vert_shader]() {
-        gl.DetachShader(program, vert_shader);
-      });
-  fml::ScopedCleanupClosure detach_frag_shader(
-      [&gl, program = *program, frag_shader]() {
-        gl.DetachShader(program, frag_shader);
-      });
+void PipelineLibraryGLES::CreatePendingPipelines(const ReactorGLES& reactor) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
 
-  for (const auto& stage_input :
-       descriptor.GetVertexDescriptor()->GetStageInputs()) {
-    gl.BindAttribLocation(*program,                                   //
-                          static_cast<GLuint>(stage_input.location),  //
-                          stage_input.name                            //
-    );
+  std::vector<PipelineRequest> requests;
+  {
+    Lock lock(pending_requests_mutex_);
+    std::swap(requests, pending_requests_);
+  }
+  if (requests.empty()) {
+    return;
   }
 
-  gl.LinkProgram(*program);
+  const auto& gl = reactor.GetProcTable();
+  if (requests.size() > 1u && gl.MaxShaderCompilerThreadsKHR.IsAvailable()) {
+    // Let the driver pick how many threads compile the batch.
+    gl.MaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+  }
 
-  GLint link_status = GL_FALSE;
-  gl.GetProgramiv(*program, GL_LINK_STATUS, &link_status);
+  // Submit every program before waiting on any of them, so that the driver
+  // can compile them concurrently.
+  std::vector<ProgramLink> links;
+  links.reserve(requests.size());
+  for (auto& request : requests) {
+    ProgramLink link;
+    link.pipeline = std::shared_ptr<PipelineGLES>(new PipelineGLES(
+        reactor_, weak_from_this(), request.descriptor));
+    link.request = std::move(request);
+    if (!BeginLinkProgram(reactor, link)) {
+      link.request.promise->set_value(nullptr);
+      VALIDATION_LOG << "Could not link pipeline program.";
+      continue;
+    }
+    links.push_back(std::move(link));
+  }
 
-  if (link_status != GL_TRUE) {
-    VALIDATION_LOG << "Could not link shader program: "
-                   << gl.GetProgramInfoLogString(*program);
-    return false;
+  // Finish the programs as they complete, only waiting on the oldest one
+  // when none of them is done.
+  while (!links.empty()) {
+    auto ready = std::find_if(
+        links.begin(), links.end(),
+        [&gl](const ProgramLink& link) {
+          return link.loaded_from_cache || IsLinkComplete(gl, link.program);
+        });
+    if (ready == links.end()) {
+      ready = links.begin();
+    }
+    auto link = std::move(*ready);
+    links.erase(ready);
+
+    const auto& promise = link.request.promise;
+    if (!FinishLinkProgram(reactor, link)) {
+      promise->set_value(nullptr);
+      VALIDATION_LOG << "Could not link pipeline program.";
+      continue;
+    }
+    if (!link.pipeline->BuildVertexDescriptor(gl, link.program)) {
+      promise->set_value(nullptr);
+      VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
+      continue;
+    }
+    if (!link.pipeline->IsValid()) {
+      promise->set_value(nullptr);
+      VALIDATION_LOG << "Pipeline validation checks failed.";
+      continue;
+    }
+    promise->set_value(std::move(link.pipeline));
   }
-  return true;
 }
 
 // |PipelineLibrary|
@@ -201,48 +367,24 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
-  auto weak_this = weak_from_this();
 
-  auto result = reactor_->AddOperation(
-      [promise, weak_this, reactor_ptr = reactor_, descriptor, vert_function,
-       frag_function](const ReactorGLES& reactor) {
+  {
+    Lock lock(pending_requests_mutex_);
+    pending_requests_.push_back(
+        {promise, descriptor, vert_function, frag_function});
+  }
+
+  // Requests that are made before the reactor gets to react are created
+  // together by the first of these operations.
+  auto weak_this = weak_from_this();
+  auto result =
+      reactor_->AddOperation([weak_this](const ReactorGLES& reactor) {
         auto strong_this = weak_this.lock();
         if (!strong_this) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Library was collected before a pending pipeline "
-                            "creation could finish.";
-          return;
-        }
-        auto pipeline = std::shared_ptr<PipelineGLES>(
-            new PipelineGLES(reactor_ptr, strong_this, descriptor));
-        auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-        if (!program.has_value()) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Could not obtain program handle.";
-          return;
-        }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
-        );
-        if (!link_result) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Could not link pipeline program.";
           return;
         }
-        if (!pipeline->BuildVertexDescriptor(reactor.GetProcTable(),
-                                             program.value())) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
-          return;
-        }
-        if (!pipeline->IsValid()) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Pipeline validation checks failed.";
-          return;
-        }
-        promise->set_value(std::move(pipeline));
+        PipelineLibraryGLES::Cast(*strong_this)
+            .CreatePendingPipelines(reactor);
       });
   FML_CHECK(result);
 
@@ -269,6 +411,20 @@ void PipelineLibraryGLES::RemovePipelinesWithEntryPoint(
 }
 
 // |PipelineLibrary|
-PipelineLibraryGLES::~PipelineLibraryGLES() = default;
+PipelineLibraryGLES::~PipelineLibraryGLES() {
+  Lock lock(pending_requests_mutex_);
+  for (const auto& request : pending_requests_) {
+    request.promise->set_value(nullptr);
+    VALIDATION_LOG << "Library was collected before a pending pipeline "
+                      "creation could finish.";
+  }
+}
+
+void PipelineLibraryGLES::DidAcquireSurfaceFrame() {
+  if (program_cache_ &&
+      ++frames_acquired_ % ProgramCacheGLES::kPersistAfterFrameCount == 0u) {
+    program_cache_->PersistToDisk();
+  }
+}
 
 }  // namespace impeller
@@ -4,7 +4,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
 #include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/gles/program_cache_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/pipeline_library.h"
 
@@ -12,18 +20,55 @@ namespace impeller {
 
 class ContextGLES;
 
-class PipelineLibraryGLES final : public PipelineLibrary {
+class PipelineLibraryGLES final
+    : public PipelineLibrary,
+      public BackendCast<PipelineLibraryGLES, PipelineLibrary> {
  public:
   // |PipelineLibrary|
   ~PipelineLibraryGLES() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the binaries of the programs linked so far to the
+  ///             program cache every
+  ///             `ProgramCacheGLES::kPersistAfterFrameCount` frames, if there
+  ///             are new ones.
+  ///
+  void DidAcquireSurfaceFrame();
+
  private:
   friend ContextGLES;
 
+  struct PipelineRequest {
+    std::shared_ptr<std::promise<std::shared_ptr<Pipeline<PipelineDescriptor>>>>
+        promise;
+    PipelineDescriptor descriptor;
+    std::shared_ptr<const ShaderFunction> vert_function;
+    std::shared_ptr<const ShaderFunction> frag_function;
+  };
+
+  struct ProgramLink;
+
   ReactorGLES::Ref reactor_;
+  std::shared_ptr<ProgramCacheGLES> program_cache_;
   PipelineMap pipelines_;
+  std::atomic_size_t frames_acquired_ = 0u;
+  Mutex pending_requests_mutex_;
+  std::vector<PipelineRequest> pending_requests_
+      IPLR_GUARDED_BY(pending_requests_mutex_);
+
+  PipelineLibraryGLES(ReactorGLES::Ref reactor,
+                      std::shared_ptr<ProgramCacheGLES> program_cache);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the pipelines of all pending requests. All of their
+  ///             programs are submitted to the driver before the results of
+  ///             any of them are waited on.
+  ///
+  void CreatePendingPipelines(const ReactorGLES& reactor);
+
+  bool BeginLinkProgram(const ReactorGLES& reactor, ProgramLink& link) const;
 
-  PipelineLibraryGLES(ReactorGLES::Ref reactor);
+  bool FinishLinkProgram(const ReactorGLES& reactor, ProgramLink& link) const;
 
   // |PipelineLibrary|
   bool IsValid() const override;
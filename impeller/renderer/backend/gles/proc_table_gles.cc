@@ -111,6 +111,10 @@ ProcTableGLES::ProcTableGLES(Resolver resolver) {
     DiscardFramebufferEXT.Reset();
   }
 
+  if (!description_->HasExtension("GL_KHR_parallel_shader_compile")) {
+    MaxShaderCompilerThreadsKHR.Reset();
+  }
+
   capabilities_ = std::make_unique<CapabilitiesGLES>(*this);
 
   is_valid_ = true;
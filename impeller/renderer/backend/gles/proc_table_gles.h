@@ -168,13 +168,18 @@ struct GLProc {
   PROC(Viewport);                            \
   PROC(ReadPixels);
 
-#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) PROC(BlitFramebuffer);
+#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) \
+  PROC(BlitFramebuffer);                   \
+  PROC(GetProgramBinary);                  \
+  PROC(ProgramBinary);                     \
+  PROC(ProgramParameteri);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC) \
   PROC(DiscardFramebufferEXT);           \
   PROC(PushDebugGroupKHR);               \
   PROC(PopDebugGroupKHR);                \
-  PROC(ObjectLabelKHR);
+  PROC(ObjectLabelKHR);                  \
+  PROC(MaxShaderCompilerThreadsKHR);
 
 enum class DebugResourceType {
   kTexture,
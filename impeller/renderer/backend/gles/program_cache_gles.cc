@@ -0,0 +1,232 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/program_cache_gles.h"
+
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/gles/description_gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+static constexpr const char* kProgramCacheFileName =
+    "flutter.impeller.glcache";
+
+struct ProgramCacheHeaderGLES {
+  // Always "IMPG". Changed when the layout of the file changes.
+  uint32_t magic = 0x47504d49;
+  uint32_t abi_version = sizeof(void*);
+  uint64_t driver_hash = 0u;
+  uint64_t binary_count = 0u;
+};
+
+struct ProgramBinaryHeaderGLES {
+  uint64_t key = 0u;
+  uint32_t format = 0u;
+  uint32_t length = 0u;
+};
+
+static bool CanLoadProgramBinaries(const ProcTableGLES& gl) {
+  return gl.GetProgramBinary.IsAvailable() &&
+         gl.ProgramBinary.IsAvailable() &&
+         gl.ProgramParameteri.IsAvailable() &&
+         gl.GetCapabilities()->num_program_binary_formats > 0u;
+}
+
+ProgramCacheGLES::ProgramCacheGLES(const ProcTableGLES& gl,
+                                   fml::UniqueFD cache_directory)
+    : cache_directory_(std::move(cache_directory)),
+      driver_hash_(
+          std::hash<std::string>{}(gl.GetDescription()->GetString())) {
+  if (!cache_directory_.is_valid() || !CanLoadProgramBinaries(gl)) {
+    return;
+  }
+  is_enabled_ = true;
+  Lock lock(mutex_);
+  Load();
+}
+
+ProgramCacheGLES::~ProgramCacheGLES() = default;
+
+bool ProgramCacheGLES::IsEnabled() const {
+  return is_enabled_;
+}
+
+uint64_t ProgramCacheGLES::MakeKey(
+    const fml::Mapping& vertex_source,
+    const fml::Mapping& fragment_source,
+    const std::vector<std::pair<GLuint, std::string>>& attributes) {
+  const auto hash_source = [](const fml::Mapping& source) {
+    return std::hash<std::string_view>{}(std::string_view(
+        reinterpret_cast<const char*>(source.GetMapping()), source.GetSize()));
+  };
+  auto key = fml::HashCombine(hash_source(vertex_source),
+                              hash_source(fragment_source));
+  for (const auto& attribute : attributes) {
+    fml::HashCombineSeed(key, attribute.first, attribute.second);
+  }
+  return key;
+}
+
+void ProgramCacheGLES::Load() {
+  TRACE_EVENT0("impeller", "ProgramCacheGLES::Load");
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(cache_directory_, kProgramCacheFileName);
+  if (!mapping || mapping->GetSize() < sizeof(ProgramCacheHeaderGLES)) {
+    return;
+  }
+
+  const uint8_t* data = mapping->GetMapping();
+  const uint8_t* end = data + mapping->GetSize();
+
+  ProgramCacheHeaderGLES header;
+  ProgramCacheHeaderGLES current;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != current.magic ||
+      header.abi_version != current.abi_version ||
+      header.driver_hash != driver_hash_) {
+    FML_LOG(INFO) << "Program cache on disk was written by a different "
+                     "driver or engine. Discarding it.";
+    return;
+  }
+  data += sizeof(header);
+
+  std::unordered_map<uint64_t, Binary> binaries;
+  for (uint64_t i = 0; i < header.binary_count; i++) {
+    ProgramBinaryHeaderGLES binary_header;
+    if (static_cast<size_t>(end - data) < sizeof(binary_header)) {
+      FML_LOG(INFO) << "Program cache on disk was truncated. Discarding it.";
+      return;
+    }
+    std::memcpy(&binary_header, data, sizeof(binary_header));
+    data += sizeof(binary_header);
+    if (static_cast<size_t>(end - data) < binary_header.length) {
+      FML_LOG(INFO) << "Program cache on disk was truncated. Discarding it.";
+      return;
+    }
+    Binary binary;
+    binary.format = binary_header.format;
+    binary.data = data;
+    binary.length = binary_header.length;
+    binaries[binary_header.key] = binary;
+    data += binary_header.length;
+  }
+
+  mapping_ = std::move(mapping);
+  binaries_ = std::move(binaries);
+}
+
+bool ProgramCacheGLES::LoadProgram(const ProcTableGLES& gl,
+                                   GLuint program,
+                                   uint64_t key) {
+  if (!is_enabled_) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ProgramCacheGLES::LoadProgram");
+
+  Lock lock(mutex_);
+  auto found = binaries_.find(key);
+  if (found == binaries_.end()) {
+    return false;
+  }
+
+  gl.ProgramBinary(program, found->second.format, found->second.data,
+                   found->second.length);
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  if (link_status != GL_TRUE) {
+    // The driver may reject binaries at any time, for instance after an
+    // update that didn't change its version string.
+    FML_LOG(INFO) << "Driver rejected a cached program binary. Linking the "
+                     "program from source.";
+    binaries_.erase(found);
+    is_dirty_ = true;
+    return false;
+  }
+  return true;
+}
+
+void ProgramCacheGLES::StoreProgram(const ProcTableGLES& gl,
+                                    GLuint program,
+                                    uint64_t key) {
+  if (!is_enabled_) {
+    return;
+  }
+
+  GLint length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  auto storage = std::make_shared<std::vector<uint8_t>>(length);
+  GLenum format = GL_NONE;
+  gl.GetProgramBinary(program, length, &length, &format, storage->data());
+  if (length <= 0) {
+    return;
+  }
+  storage->resize(length);
+
+  Binary binary;
+  binary.format = format;
+  binary.data = storage->data();
+  binary.length = storage->size();
+  binary.storage = std::move(storage);
+
+  Lock lock(mutex_);
+  binaries_[key] = std::move(binary);
+  is_dirty_ = true;
+}
+
+void ProgramCacheGLES::PersistToDisk() {
+  if (!is_enabled_) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "ProgramCacheGLES::PersistToDisk");
+
+  std::vector<uint8_t> data;
+  {
+    Lock lock(mutex_);
+    if (!is_dirty_) {
+      return;
+    }
+    is_dirty_ = false;
+
+    ProgramCacheHeaderGLES header;
+    header.driver_hash = driver_hash_;
+    header.binary_count = binaries_.size();
+    size_t size = sizeof(header);
+    for (const auto& [key, binary] : binaries_) {
+      size += sizeof(ProgramBinaryHeaderGLES) + binary.length;
+    }
+    data.resize(size);
+
+    uint8_t* cursor = data.data();
+    std::memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+    for (const auto& [key, binary] : binaries_) {
+      ProgramBinaryHeaderGLES binary_header;
+      binary_header.key = key;
+      binary_header.format = binary.format;
+      binary_header.length = binary.length;
+      std::memcpy(cursor, &binary_header, sizeof(binary_header));
+      cursor += sizeof(binary_header);
+      std::memcpy(cursor, binary.data, binary.length);
+      cursor += binary.length;
+    }
+  }
+
+  if (!fml::WriteAtomically(cache_directory_, kProgramCacheFileName,
+                            fml::DataMapping(std::move(data)))) {
+    VALIDATION_LOG << "Could not persist program cache to disk.";
+  }
+}
+
+}  // namespace impeller
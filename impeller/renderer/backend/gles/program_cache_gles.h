@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/gles/gles.h"
+
+namespace impeller {
+
+class ProcTableGLES;
+
+//------------------------------------------------------------------------------
+/// @brief      Stores the binaries of linked programs on disk so that later
+///             launches can load them instead of compiling and linking the
+///             shader sources again.
+///
+///             Programs are keyed by a hash of their shader sources and
+///             attribute bindings. The whole cache is discarded when it was
+///             written by a different driver, as identified by the vendor,
+///             renderer and version strings of the context.
+///
+///             All methods are thread safe.
+///
+class ProgramCacheGLES {
+ public:
+  static constexpr size_t kPersistAfterFrameCount = 50u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the cache stored in `cache_directory`, if any. The file
+  ///             is memory mapped, so the binaries are only read once a
+  ///             pipeline that needs them is created.
+  ///
+  ///             The cache is disabled if the directory is invalid or the
+  ///             context can't load program binaries.
+  ///
+  ProgramCacheGLES(const ProcTableGLES& gl, fml::UniqueFD cache_directory);
+
+  ~ProgramCacheGLES();
+
+  bool IsEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the key identifying a program with these sources and
+  ///             attribute bindings.
+  ///
+  static uint64_t MakeKey(
+      const fml::Mapping& vertex_source,
+      const fml::Mapping& fragment_source,
+      const std::vector<std::pair<GLuint, std::string>>& attributes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Links `program` from the binary stored for `key`.
+  ///
+  /// @return     Whether a binary was found and the driver accepted it. A
+  ///             rejected binary is forgotten, and the program must be linked
+  ///             from source instead.
+  ///
+  bool LoadProgram(const ProcTableGLES& gl, GLuint program, uint64_t key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remembers the binary of `program`, which was just linked from
+  ///             source, to be written on the next call to `PersistToDisk`.
+  ///
+  void StoreProgram(const ProcTableGLES& gl, GLuint program, uint64_t key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the cache to disk if programs were stored since it was
+  ///             last written.
+  ///
+  void PersistToDisk();
+
+ private:
+  struct Binary {
+    GLenum format = GL_NONE;
+    const uint8_t* data = nullptr;
+    size_t length = 0u;
+    // Owns `data` for binaries that were linked during this launch.
+    std::shared_ptr<std::vector<uint8_t>> storage;
+  };
+
+  const fml::UniqueFD cache_directory_;
+  const uint64_t driver_hash_;
+  bool is_enabled_ = false;
+  mutable Mutex mutex_;
+  std::unique_ptr<fml::Mapping> mapping_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<uint64_t, Binary> binaries_ IPLR_GUARDED_BY(mutex_);
+  bool is_dirty_ IPLR_GUARDED_BY(mutex_) = false;
+
+  void Load() IPLR_REQUIRES(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ProgramCacheGLES);
+};
+
+}  // namespace impeller
@@ -5,6 +5,8 @@
 #include "impeller/renderer/backend/gles/render_pass_gles.h"
 
 #include <algorithm>
+#include <optional>
+#include <tuple>
 
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/config.h"
@@ -36,22 +38,246 @@ void RenderPassGLES::OnSetLabel(std::string label) {
   label_ = std::move(label);
 }
 
-void ConfigureBlending(const ProcTableGLES& gl,
+//------------------------------------------------------------------------------
+/// @brief      Shadows the fixed function state and program set while encoding
+///             the commands of a render pass, so that state the previous
+///             command already set isn't set again.
+///
+///             Only the calls made through the tracker are known to it. Its
+///             lifetime is limited to a single pass, as the state may be
+///             changed by anything else using the context between passes.
+///
+class GLStateTracker {
+ public:
+  explicit GLStateTracker(const ProcTableGLES& gl) : gl_(gl) {}
+
+  /// @brief  Records state that was set without going through the tracker.
+  void AssumeDisabled(GLenum capability) {
+    if (auto state = GetCapabilityState(capability)) {
+      *state = false;
+    }
+  }
+
+  /// @brief  Records the color mask that was set without going through the
+  ///         tracker.
+  void AssumeColorMask(GLboolean red,
+                       GLboolean green,
+                       GLboolean blue,
+                       GLboolean alpha) {
+    color_mask_ = std::make_tuple(red, green, blue, alpha);
+  }
+
+  void SetEnabled(GLenum capability, bool enabled) {
+    auto state = GetCapabilityState(capability);
+    if (state && state->has_value() && state->value() == enabled) {
+      redundant_call_count_++;
+      return;
+    }
+    if (state) {
+      *state = enabled;
+    }
+    enabled ? gl_.Enable(capability) : gl_.Disable(capability);
+  }
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha) {
+    if (Update(blend_func_, src_color, dst_color, src_alpha, dst_alpha)) {
+      gl_.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+    }
+  }
+
+  void BlendEquationSeparate(GLenum mode_color, GLenum mode_alpha) {
+    if (Update(blend_equation_, mode_color, mode_alpha)) {
+      gl_.BlendEquationSeparate(mode_color, mode_alpha);
+    }
+  }
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha) {
+    if (Update(color_mask_, red, green, blue, alpha)) {
+      gl_.ColorMask(red, green, blue, alpha);
+    }
+  }
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass) {
+    if (UpdateFaces(face, stencil_op_, stencil_fail, depth_fail,
+                    depth_stencil_pass)) {
+      gl_.StencilOpSeparate(face, stencil_fail, depth_fail,
+                            depth_stencil_pass);
+    }
+  }
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+    if (UpdateFaces(face, stencil_func_, func, ref, mask)) {
+      gl_.StencilFuncSeparate(face, func, ref, mask);
+    }
+  }
+
+  void StencilMaskSeparate(GLenum face, GLuint mask) {
+    if (UpdateFaces(face, stencil_mask_, mask)) {
+      gl_.StencilMaskSeparate(face, mask);
+    }
+  }
+
+  void DepthFunc(GLenum func) {
+    if (Update(depth_func_, func)) {
+      gl_.DepthFunc(func);
+    }
+  }
+
+  void DepthMask(GLboolean flag) {
+    if (Update(depth_mask_, flag)) {
+      gl_.DepthMask(flag);
+    }
+  }
+
+  void DepthRangef(GLfloat z_near, GLfloat z_far) {
+    if (Update(depth_range_, z_near, z_far)) {
+      gl_.DepthRangef(z_near, z_far);
+    }
+  }
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (Update(viewport_, x, y, width, height)) {
+      gl_.Viewport(x, y, width, height);
+    }
+  }
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (Update(scissor_, x, y, width, height)) {
+      gl_.Scissor(x, y, width, height);
+    }
+  }
+
+  void CullFace(GLenum mode) {
+    if (Update(cull_face_, mode)) {
+      gl_.CullFace(mode);
+    }
+  }
+
+  void FrontFace(GLenum mode) {
+    if (Update(front_face_, mode)) {
+      gl_.FrontFace(mode);
+    }
+  }
+
+  /// @brief  Returns whether `pipeline` is not the last program bound, in
+  ///         which case it is remembered as the bound one.
+  bool ShouldBindProgram(const PipelineGLES* pipeline) {
+    if (program_ == pipeline) {
+      redundant_call_count_++;
+      return false;
+    }
+    program_ = pipeline;
+    return true;
+  }
+
+  const PipelineGLES* GetBoundProgram() const { return program_; }
+
+  size_t GetRedundantCallCount() const { return redundant_call_count_; }
+
+ private:
+  template <class... T>
+  using State = std::optional<std::tuple<T...>>;
+
+  const ProcTableGLES& gl_;
+  std::optional<bool> blend_;
+  std::optional<bool> stencil_test_;
+  std::optional<bool> depth_test_;
+  std::optional<bool> scissor_test_;
+  std::optional<bool> cull_face_enabled_;
+  State<GLenum, GLenum, GLenum, GLenum> blend_func_;
+  State<GLenum, GLenum> blend_equation_;
+  State<GLboolean, GLboolean, GLboolean, GLboolean> color_mask_;
+  // The stencil state of the front and back faces.
+  State<GLenum, GLenum, GLenum> stencil_op_[2];
+  State<GLenum, GLint, GLuint> stencil_func_[2];
+  State<GLuint> stencil_mask_[2];
+  State<GLenum> depth_func_;
+  State<GLboolean> depth_mask_;
+  State<GLfloat, GLfloat> depth_range_;
+  State<GLint, GLint, GLsizei, GLsizei> viewport_;
+  State<GLint, GLint, GLsizei, GLsizei> scissor_;
+  State<GLenum> cull_face_;
+  State<GLenum> front_face_;
+  const PipelineGLES* program_ = nullptr;
+  size_t redundant_call_count_ = 0u;
+
+  std::optional<bool>* GetCapabilityState(GLenum capability) {
+    switch (capability) {
+      case GL_BLEND:
+        return &blend_;
+      case GL_STENCIL_TEST:
+        return &stencil_test_;
+      case GL_DEPTH_TEST:
+        return &depth_test_;
+      case GL_SCISSOR_TEST:
+        return &scissor_test_;
+      case GL_CULL_FACE:
+        return &cull_face_enabled_;
+      default:
+        return nullptr;
+    }
+  }
+
+  /// Returns whether `state` changed, in which case it is updated.
+  template <class... T, class... U>
+  bool Update(State<T...>& state, U... values) {
+    std::tuple<T...> value(values...);
+    if (state == value) {
+      redundant_call_count_++;
+      return false;
+    }
+    state = value;
+    return true;
+  }
+
+  /// Returns whether the state of any of the faces `face` selects changed,
+  /// in which case all of them are updated.
+  template <class... T, class... U>
+  bool UpdateFaces(GLenum face, State<T...> (&states)[2], U... values) {
+    const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+    const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+    std::tuple<T...> value(values...);
+    if ((!front || states[0] == value) && (!back || states[1] == value)) {
+      redundant_call_count_++;
+      return false;
+    }
+    if (front) {
+      states[0] = value;
+    }
+    if (back) {
+      states[1] = value;
+    }
+    return true;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GLStateTracker);
+};
+
+void ConfigureBlending(GLStateTracker& state,
                        const ColorAttachmentDescriptor* color) {
   if (color->blending_enabled) {
-    gl.Enable(GL_BLEND);
-    gl.BlendFuncSeparate(
+    state.SetEnabled(GL_BLEND, true);
+    state.BlendFuncSeparate(
         ToBlendFactor(color->src_color_blend_factor),  // src color
         ToBlendFactor(color->dst_color_blend_factor),  // dst color
         ToBlendFactor(color->src_alpha_blend_factor),  // src alpha
         ToBlendFactor(color->dst_alpha_blend_factor)   // dst alpha
     );
-    gl.BlendEquationSeparate(
+    state.BlendEquationSeparate(
         ToBlendOperation(color->color_blend_op),  // mode color
         ToBlendOperation(color->alpha_blend_op)   // mode alpha
     );
   } else {
-    gl.Disable(GL_BLEND);
+    state.SetEnabled(GL_BLEND, false);
   }
 
   {
@@ -63,53 +289,55 @@ void ConfigureBlending(const ProcTableGLES& gl,
                  : GL_FALSE;
     };
 
-    gl.ColorMask(is_set(color->write_mask, ColorWriteMask::kRed),    // red
-                 is_set(color->write_mask, ColorWriteMask::kGreen),  // green
-                 is_set(color->write_mask, ColorWriteMask::kBlue),   // blue
-                 is_set(color->write_mask, ColorWriteMask::kAlpha)   // alpha
+    state.ColorMask(
+        is_set(color->write_mask, ColorWriteMask::kRed),    // red
+        is_set(color->write_mask, ColorWriteMask::kGreen),  // green
+        is_set(color->write_mask, ColorWriteMask::kBlue),   // blue
+        is_set(color->write_mask, ColorWriteMask::kAlpha)   // alpha
     );
   }
 }
 
 void ConfigureStencil(GLenum face,
-                      const ProcTableGLES& gl,
+                      GLStateTracker& state,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
-  gl.StencilOpSeparate(
+  state.StencilOpSeparate(
       face,                                    // face
       ToStencilOp(stencil.stencil_failure),    // stencil fail
       ToStencilOp(stencil.depth_failure),      // depth fail
       ToStencilOp(stencil.depth_stencil_pass)  // depth stencil pass
   );
-  gl.StencilFuncSeparate(face,                                        // face
-                         ToCompareFunction(stencil.stencil_compare),  // func
-                         stencil_reference,                           // ref
-                         stencil.read_mask                            // mask
+  state.StencilFuncSeparate(
+      face,                                        // face
+      ToCompareFunction(stencil.stencil_compare),  // func
+      stencil_reference,                           // ref
+      stencil.read_mask                            // mask
   );
-  gl.StencilMaskSeparate(face, stencil.write_mask);
+  state.StencilMaskSeparate(face, stencil.write_mask);
 }
 
-void ConfigureStencil(const ProcTableGLES& gl,
+void ConfigureStencil(GLStateTracker& state,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
-    gl.Disable(GL_STENCIL_TEST);
+    state.SetEnabled(GL_STENCIL_TEST, false);
     return;
   }
 
-  gl.Enable(GL_STENCIL_TEST);
+  state.SetEnabled(GL_STENCIL_TEST, true);
   const auto& front = pipeline.GetFrontStencilAttachmentDescriptor();
   const auto& back = pipeline.GetBackStencilAttachmentDescriptor();
 
   if (front.has_value() && back.has_value() && front == back) {
-    ConfigureStencil(GL_FRONT_AND_BACK, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT_AND_BACK, state, *front, stencil_reference);
     return;
   }
   if (front.has_value()) {
-    ConfigureStencil(GL_FRONT, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT, state, *front, stencil_reference);
   }
   if (back.has_value()) {
-    ConfigureStencil(GL_BACK, gl, *back, stencil_reference);
+    ConfigureStencil(GL_BACK, state, *back, stencil_reference);
   }
 }
 
@@ -233,6 +461,14 @@ struct RenderPassData {
 
   gl.Clear(clear_bits);
 
+  GLStateTracker state(gl);
+  state.AssumeDisabled(GL_SCISSOR_TEST);
+  state.AssumeDisabled(GL_DEPTH_TEST);
+  state.AssumeDisabled(GL_STENCIL_TEST);
+  state.AssumeDisabled(GL_CULL_FACE);
+  state.AssumeDisabled(GL_BLEND);
+  state.AssumeColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
   for (const auto& command : commands) {
     if (command.instance_count != 1u) {
       VALIDATION_LOG << "GLES backend does not support instanced rendering.";
@@ -267,12 +503,13 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    ConfigureBlending(state, color_attachment);
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    ConfigureStencil(state, pipeline.GetDescriptor(),
+                     command.stencil_reference);
 
     //--------------------------------------------------------------------------
     /// Configure depth.
@@ -280,11 +517,11 @@ struct RenderPassData {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.SetEnabled(GL_DEPTH_TEST, true);
+      state.DepthFunc(ToCompareFunction(depth->depth_compare));
+      state.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.SetEnabled(GL_DEPTH_TEST, false);
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -296,14 +533,15 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.origin.x,  // x
-                target_size.height - viewport.rect.origin.y -
-                    viewport.rect.size.height,  // y
-                viewport.rect.size.width,       // width
-                viewport.rect.size.height       // height
+    state.Viewport(viewport.rect.origin.x,  // x
+                   target_size.height - viewport.rect.origin.y -
+                       viewport.rect.size.height,  // y
+                   viewport.rect.size.width,       // width
+                   viewport.rect.size.height       // height
     );
     if (pass_data.depth_attachment) {
-      gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
+      state.DepthRangef(viewport.depth_range.z_near,
+                        viewport.depth_range.z_far);
     }
 
     //--------------------------------------------------------------------------
@@ -311,15 +549,15 @@ struct RenderPassData {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.SetEnabled(GL_SCISSOR_TEST, true);
+      state.Scissor(
           scissor.origin.x,                                             // x
           target_size.height - scissor.origin.y - scissor.size.height,  // y
           scissor.size.width,                                           // width
           scissor.size.height  // height
       );
     } else {
-      gl.Disable(GL_SCISSOR_TEST);
+      state.SetEnabled(GL_SCISSOR_TEST, false);
     }
 
     //--------------------------------------------------------------------------
@@ -327,15 +565,15 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetCullMode()) {
       case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
+        state.SetEnabled(GL_CULL_FACE, false);
         break;
       case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_FRONT);
         break;
       case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_BACK);
         break;
     }
     //--------------------------------------------------------------------------
@@ -343,10 +581,10 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetWindingOrder()) {
       case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
+        state.FrontFace(GL_CW);
         break;
       case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
+        state.FrontFace(GL_CCW);
         break;
     }
 
@@ -381,7 +619,7 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Bind the pipeline program.
     ///
-    if (!pipeline.BindProgram()) {
+    if (state.ShouldBindProgram(&pipeline) && !pipeline.BindProgram()) {
       return false;
     }
 
@@ -445,14 +683,25 @@ struct RenderPassData {
     if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
       return false;
     }
+  }
 
-    //--------------------------------------------------------------------------
-    /// Unbind the program pipeline.
-    ///
-    if (!pipeline.UnbindProgram()) {
-      return false;
-    }
+  //----------------------------------------------------------------------------
+  /// Unbind the program pipeline. Consecutive commands using the same
+  /// pipeline share the binding.
+  ///
+  if (auto program = state.GetBoundProgram();
+      program && !program->UnbindProgram()) {
+    return false;
+  }
+
+#if !FLUTTER_RELEASE
+  if (state.GetRedundantCallCount() > 0u) {
+    FML_TRACE_COUNTER("impeller", "RenderPassGLES",
+                      reinterpret_cast<int64_t>(&pass_data),
+                      "SkippedRedundantStateChanges",
+                      state.GetRedundantCallCount());
   }
+#endif  // !FLUTTER_RELEASE
 
   if (gl.DiscardFramebufferEXT.IsAvailable()) {
     std::vector<GLenum> attachments;
@@ -24,6 +24,9 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
   }
 
   const auto& gl_context = ContextGLES::Cast(*context);
+  if (auto pipeline_library = context->GetPipelineLibrary()) {
+    PipelineLibraryGLES::Cast(*pipeline_library).DidAcquireSurfaceFrame();
+  }
 
   TextureDescriptor color0_tex;
   color0_tex.type = TextureType::kTexture2D;
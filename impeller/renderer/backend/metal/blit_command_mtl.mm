@@ -74,12 +74,11 @@ bool BlitCopyTextureToBufferCommandMTL::Encode(
   auto source_size_mtl =
       MTLSizeMake(source_region.size.width, source_region.size.height, 1);
 
-  auto destination_bytes_per_pixel =
-      BytesPerPixelForPixelFormat(source->GetTextureDescriptor().format);
+  const auto format = source->GetTextureDescriptor().format;
   auto destination_bytes_per_row =
-      source_size_mtl.width * destination_bytes_per_pixel;
+      BytesPerRowForPixelFormat(format, source_region.size.width);
   auto destination_bytes_per_image =
-      source_size_mtl.height * destination_bytes_per_row;
+      BytesPerImageForPixelFormat(format, source_region.size);
 
   [encoder copyFromTexture:source_mtl
                    sourceSlice:0
@@ -113,18 +112,17 @@ bool BlitCopyBufferToTextureCommandMTL::Encode(
     return false;
   }
 
-  auto destination_origin_mtl =
-      MTLOriginMake(destination_origin.x, destination_origin.y, 0);
+  auto destination_origin_mtl = MTLOriginMake(destination_region.origin.x,
+                                              destination_region.origin.y, 0);
 
-  auto image_size = destination->GetTextureDescriptor().size;
+  auto image_size = destination_region.size;
   auto source_size_mtl = MTLSizeMake(image_size.width, image_size.height, 1);
 
-  auto destination_bytes_per_pixel =
-      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  const auto format = destination->GetTextureDescriptor().format;
   auto destination_bytes_per_row =
-      source_size_mtl.width * destination_bytes_per_pixel;
+      BytesPerRowForPixelFormat(format, image_size.width);
   auto destination_bytes_per_image =
-      source_size_mtl.height * destination_bytes_per_row;
+      BytesPerImageForPixelFormat(format, image_size);
 
   [encoder copyFromBuffer:source_mtl
              sourceOffset:source.range.offset
@@ -6,8 +6,11 @@
 
 #include <Metal/Metal.h>
 
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 namespace impeller {
 
@@ -20,9 +23,17 @@ class CommandBufferMTL final : public CommandBuffer {
   friend class ContextMTL;
 
   id<MTLCommandBuffer> buffer_ = nullptr;
+  const std::shared_ptr<GPUTracer> gpu_tracer_;
+  // Set until the GPU execution time of the buffer is reported to the tracer.
+  std::optional<uint64_t> traced_frame_;
 
   CommandBufferMTL(const std::weak_ptr<const Context>& context,
-                   id<MTLCommandQueue> queue);
+                   id<MTLCommandQueue> queue,
+                   std::shared_ptr<GPUTracer> gpu_tracer);
+
+  // Reports the GPU execution time of the buffer to the tracer once the buffer
+  // has completed. Must be called before the buffer is committed.
+  void TraceGPUTime(id<MTLCommandBuffer> buffer);
 
   // |CommandBuffer|
   void SetLabel(const std::string& label) const override;
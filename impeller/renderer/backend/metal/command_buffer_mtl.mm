@@ -129,10 +129,44 @@ static id<MTLCommandBuffer> CreateCommandBuffer(id<MTLCommandQueue> queue) {
 }
 
 CommandBufferMTL::CommandBufferMTL(const std::weak_ptr<const Context>& context,
-                                   id<MTLCommandQueue> queue)
-    : CommandBuffer(context), buffer_(CreateCommandBuffer(queue)) {}
+                                   id<MTLCommandQueue> queue,
+                                   std::shared_ptr<GPUTracer> gpu_tracer)
+    : CommandBuffer(context),
+      buffer_(CreateCommandBuffer(queue)),
+      gpu_tracer_(std::move(gpu_tracer)) {
+  if (buffer_ && gpu_tracer_) {
+    traced_frame_ = gpu_tracer_->OnCommandBufferCreated();
+  }
+}
+
+CommandBufferMTL::~CommandBufferMTL() {
+  if (traced_frame_.has_value()) {
+    // The buffer was never committed.
+    gpu_tracer_->OnCommandBufferCompleted(traced_frame_.value(), "",
+                                          std::nullopt);
+  }
+}
 
-CommandBufferMTL::~CommandBufferMTL() = default;
+void CommandBufferMTL::TraceGPUTime(id<MTLCommandBuffer> buffer) {
+  if (!traced_frame_.has_value()) {
+    return;
+  }
+  auto tracer = gpu_tracer_;
+  auto frame = traced_frame_.value();
+  traced_frame_.reset();
+  [buffer addCompletedHandler:^(id<MTLCommandBuffer> completed) {
+    std::optional<fml::TimeDelta> gpu_duration;
+    if (@available(iOS 10.3, macOS 10.15, *)) {
+      if (completed.status == MTLCommandBufferStatusCompleted) {
+        gpu_duration = fml::TimeDelta::FromSecondsF(completed.GPUEndTime -
+                                                    completed.GPUStartTime);
+      }
+    }
+    tracer->OnCommandBufferCompleted(
+        frame, completed.label ? completed.label.UTF8String : "",
+        gpu_duration);
+  }];
+}
 
 bool CommandBufferMTL::IsValid() const {
   return buffer_ != nil;
@@ -159,6 +193,7 @@ static CommandBuffer::Status ToCommitResult(MTLCommandBufferStatus status) {
 }
 
 bool CommandBufferMTL::OnSubmitCommands(CompletionCallback callback) {
+  TraceGPUTime(buffer_);
   if (callback) {
     [buffer_
         addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
@@ -187,6 +222,7 @@ bool CommandBufferMTL::SubmitCommandsAsync(
     return false;
   }
   [buffer_ enqueue];
+  TraceGPUTime(buffer_);
   auto buffer = buffer_;
   buffer_ = nil;
 
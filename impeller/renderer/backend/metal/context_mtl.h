@@ -20,6 +20,7 @@
 #include "impeller/renderer/backend/metal/shader_library_mtl.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/context.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 #if TARGET_OS_SIMULATOR
 #define IMPELLER_CA_METAL_LAYER_AVAILABLE API_AVAILABLE(macos(10.11), ios(13.0))
@@ -37,17 +38,28 @@ class ContextMTL final : public Context,
       const std::vector<std::string>& shader_library_paths,
       std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a context with the shader libraries in
+  ///             `shader_libraries_data`.
+  ///
+  ///             If `binary_archive_path` is not empty, the pipelines created
+  ///             by the context are recorded in a Metal binary archive at that
+  ///             path, and later launches load them from it instead of
+  ///             compiling their shader functions for the GPU again.
+  ///
   static std::shared_ptr<ContextMTL> Create(
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
       std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-      const std::string& label);
+      const std::string& label,
+      const std::string& binary_archive_path = {});
 
   static std::shared_ptr<ContextMTL> Create(
       id<MTLDevice> device,
       id<MTLCommandQueue> command_queue,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
       std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-      const std::string& label);
+      const std::string& label,
+      const std::string& binary_archive_path = {});
 
   // |Context|
   ~ContextMTL() override;
@@ -78,12 +90,26 @@ class ContextMTL final : public Context,
   // |Context|
   std::shared_ptr<CommandBuffer> CreateCommandBuffer() const override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
   // |Context|
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
 
   // |Context|
   bool UpdateOffscreenLayerPixelFormat(PixelFormat format) override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether offscreens use 8-bit BGRA even when the onscreen
+  ///             layer is extended range (such as for wide gamut). Halves the
+  ///             memory and bandwidth of every save layer and filter, at the
+  ///             cost of clamping their contents to the sRGB gamut.
+  ///
+  ///             Takes effect on the next call to
+  ///             `UpdateOffscreenLayerPixelFormat`.
+  ///
+  void SetUseStandardRangeOffscreens(bool use_standard_range_offscreens);
+
   // |Context|
   void Shutdown() override;
 
@@ -103,13 +129,16 @@ class ContextMTL final : public Context,
   std::shared_ptr<const Capabilities> device_capabilities_;
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
   std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch_;
+  std::shared_ptr<GPUTracer> gpu_tracer_ = std::make_shared<GPUTracer>();
+  bool use_standard_range_offscreens_ = false;
   bool is_valid_ = false;
 
   ContextMTL(
       id<MTLDevice> device,
       id<MTLCommandQueue> command_queue,
       NSArray<id<MTLLibrary>>* shader_libraries,
-      std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch);
+      std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
+      const std::string& binary_archive_path = {});
 
   std::shared_ptr<CommandBuffer> CreateCommandBufferInQueue(
       id<MTLCommandQueue> queue) const;
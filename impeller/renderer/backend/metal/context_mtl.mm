@@ -48,9 +48,41 @@ static bool DeviceSupportsComputeSubgroups(id<MTLDevice> device) {
   return supports_subgroups;
 }
 
+static std::vector<PixelFormat> DeviceSupportedCompressedPixelFormats(
+    id<MTLDevice> device) {
+  std::vector<PixelFormat> formats;
+  // ETC2 and ASTC are supported by all Apple GPUs, and BC by Mac GPUs.
+  if (@available(macOS 10.15, iOS 13, tvOS 13, *)) {
+    if ([device supportsFamily:MTLGPUFamilyApple2]) {
+      formats.push_back(PixelFormat::kETC2R8G8B8A8UNormInt);
+      formats.push_back(PixelFormat::kASTC4x4UNormInt);
+    }
+  }
+  if (@available(macOS 11.0, iOS 16.4, tvOS 16.4, *)) {
+    if (device.supportsBCTextureCompression) {
+      formats.push_back(PixelFormat::kBC7UNormInt);
+    }
+  }
+  return formats;
+}
+
+static bool IsExtendedRangeFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kR16G16B16A16Float:
+    case PixelFormat::kR32G32B32A32Float:
+    case PixelFormat::kB10G10R10XR:
+    case PixelFormat::kB10G10R10XRSRGB:
+    case PixelFormat::kB10G10R10A10XR:
+      return true;
+    default:
+      return false;
+  }
+}
+
 static std::unique_ptr<Capabilities> InferMetalCapabilities(
     id<MTLDevice> device,
-    PixelFormat color_format) {
+    PixelFormat color_format,
+    PixelFormat offscreen_color_format) {
   return CapabilitiesBuilder()
       .SetSupportsOffscreenMSAA(true)
       .SetSupportsSSBO(true)
@@ -59,6 +91,7 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsDecalSamplerAddressMode(true)
       .SetSupportsFramebufferFetch(DeviceSupportsFramebufferFetch(device))
       .SetDefaultColorFormat(color_format)
+      .SetDefaultOffscreenColorFormat(offscreen_color_format)
       .SetDefaultStencilFormat(PixelFormat::kS8UInt)
       .SetDefaultDepthStencilFormat(PixelFormat::kD32FloatS8UInt)
       .SetSupportsCompute(true)
@@ -66,6 +99,8 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsReadFromResolve(true)
       .SetSupportsReadFromOnscreenTexture(true)
       .SetSupportsDeviceTransientTextures(true)
+      .SetSupportedCompressedPixelFormats(
+          DeviceSupportedCompressedPixelFormats(device))
       .Build();
 }
 
@@ -73,7 +108,8 @@ ContextMTL::ContextMTL(
     id<MTLDevice> device,
     id<MTLCommandQueue> command_queue,
     NSArray<id<MTLLibrary>>* shader_libraries,
-    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch)
+    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
+    const std::string& binary_archive_path)
     : device_(device),
       command_queue_(command_queue),
       is_gpu_disabled_sync_switch_(std::move(is_gpu_disabled_sync_switch)) {
@@ -120,8 +156,8 @@ ContextMTL::ContextMTL(
 
   // Setup the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryMTL>(new PipelineLibraryMTL(device_));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryMTL>(
+        new PipelineLibraryMTL(device_, binary_archive_path));
   }
 
   // Setup the sampler library.
@@ -141,7 +177,8 @@ ContextMTL::ContextMTL(
   }
 
   device_capabilities_ =
-      InferMetalCapabilities(device_, PixelFormat::kB8G8R8A8UNormInt);
+      InferMetalCapabilities(device_, PixelFormat::kB8G8R8A8UNormInt,
+                             PixelFormat::kB8G8R8A8UNormInt);
 
   is_valid_ = true;
 }
@@ -248,7 +285,8 @@ std::shared_ptr<ContextMTL> ContextMTL::Create(
 std::shared_ptr<ContextMTL> ContextMTL::Create(
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
     std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-    const std::string& library_label) {
+    const std::string& library_label,
+    const std::string& binary_archive_path) {
   auto device = CreateMetalDevice();
   auto command_queue = CreateMetalCommandQueue(device);
   if (!command_queue) {
@@ -258,7 +296,8 @@ std::shared_ptr<ContextMTL> ContextMTL::Create(
       new ContextMTL(device, command_queue,
                      MTLShaderLibraryFromFileData(device, shader_libraries_data,
                                                   library_label),
-                     std::move(is_gpu_disabled_sync_switch)));
+                     std::move(is_gpu_disabled_sync_switch),
+                     binary_archive_path));
   if (!context->IsValid()) {
     FML_LOG(ERROR) << "Could not create Metal context.";
     return nullptr;
@@ -271,12 +310,14 @@ std::shared_ptr<ContextMTL> ContextMTL::Create(
     id<MTLCommandQueue> command_queue,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
     std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-    const std::string& library_label) {
+    const std::string& library_label,
+    const std::string& binary_archive_path) {
   auto context = std::shared_ptr<ContextMTL>(
       new ContextMTL(device, command_queue,
                      MTLShaderLibraryFromFileData(device, shader_libraries_data,
                                                   library_label),
-                     std::move(is_gpu_disabled_sync_switch)));
+                     std::move(is_gpu_disabled_sync_switch),
+                     binary_archive_path));
   if (!context->IsValid()) {
     FML_LOG(ERROR) << "Could not create Metal context.";
     return nullptr;
@@ -320,6 +361,11 @@ std::shared_ptr<CommandBuffer> ContextMTL::CreateCommandBuffer() const {
   return CreateCommandBufferInQueue(command_queue_);
 }
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextMTL::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
 // |Context|
 void ContextMTL::Shutdown() {
   raster_message_loop_.reset();
@@ -342,7 +388,7 @@ std::shared_ptr<CommandBuffer> ContextMTL::CreateCommandBufferInQueue(
   }
 
   auto buffer = std::shared_ptr<CommandBufferMTL>(
-      new CommandBufferMTL(weak_from_this(), queue));
+      new CommandBufferMTL(weak_from_this(), queue, gpu_tracer_));
   if (!buffer->IsValid()) {
     return nullptr;
   }
@@ -363,10 +409,20 @@ const std::shared_ptr<const Capabilities>& ContextMTL::GetCapabilities() const {
 
 // |Context|
 bool ContextMTL::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
-  device_capabilities_ = InferMetalCapabilities(device_, format);
+  const PixelFormat offscreen_format =
+      use_standard_range_offscreens_ && IsExtendedRangeFormat(format)
+          ? PixelFormat::kB8G8R8A8UNormInt
+          : format;
+  device_capabilities_ =
+      InferMetalCapabilities(device_, format, offscreen_format);
   return true;
 }
 
+void ContextMTL::SetUseStandardRangeOffscreens(
+    bool use_standard_range_offscreens) {
+  use_standard_range_offscreens_ = use_standard_range_offscreens;
+}
+
 id<MTLCommandBuffer> ContextMTL::CreateMTLCommandBuffer(
     const std::string& label) const {
   auto buffer = [command_queue_ commandBuffer];
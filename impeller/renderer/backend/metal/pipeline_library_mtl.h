@@ -6,28 +6,69 @@
 
 #include <Metal/Metal.h>
 
+#include <atomic>
+#include <string>
+
 #include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
 #include "impeller/renderer/pipeline_library.h"
 
 namespace impeller {
 
 class ContextMTL;
 
-class PipelineLibraryMTL final : public PipelineLibrary {
+class PipelineLibraryMTL final
+    : public PipelineLibrary,
+      public BackendCast<PipelineLibraryMTL, PipelineLibrary> {
  public:
+  static constexpr size_t kPersistAfterFrameCount = 50u;
+
   PipelineLibraryMTL();
 
   // |PipelineLibrary|
   ~PipelineLibraryMTL() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the surface each time a frame is acquired. Writes
+  ///             the binary archive to disk every `kPersistAfterFrameCount`
+  ///             frames if pipelines were added to it since it was last
+  ///             written.
+  ///
+  void DidAcquireSurfaceFrame();
+
  private:
   friend ContextMTL;
 
   id<MTLDevice> device_ = nullptr;
   PipelineMap pipelines_;
   ComputePipelineMap compute_pipelines_;
-
-  PipelineLibraryMTL(id<MTLDevice> device);
+  // The pipelines the app used in this and earlier launches. Pipelines found
+  // in the archive are created without compiling their shader functions for
+  // the GPU again. Nil if binary archives are unavailable or disabled.
+  id<MTLBinaryArchive> binary_archive_ API_AVAILABLE(ios(14.0), macos(11.0)) =
+      nil;
+  NSURL* binary_archive_url_ = nil;
+  // Serializes the updates of the archive, which compile pipelines for the
+  // GPU a second time, off the threads waiting for pipelines.
+  dispatch_queue_t binary_archive_queue_ = nil;
+  // Only accessed on `binary_archive_queue_`.
+  bool binary_archive_is_dirty_ = false;
+  std::atomic_size_t frames_acquired_ = 0u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a library whose pipelines are backed by the binary
+  ///             archive at `binary_archive_path`. The archive is created if
+  ///             the file doesn't exist yet. No archive is used if the path is
+  ///             empty.
+  ///
+  PipelineLibraryMTL(id<MTLDevice> device,
+                     const std::string& binary_archive_path = {});
+
+  bool HasBinaryArchive() const;
+
+  void AddToBinaryArchive(MTLRenderPipelineDescriptor* descriptor);
+
+  void PersistBinaryArchive();
 
   // |PipelineLibrary|
   bool IsValid() const override;
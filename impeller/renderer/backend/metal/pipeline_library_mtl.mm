@@ -8,6 +8,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/container.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/promise.h"
 #include "impeller/renderer/backend/metal/compute_pipeline_mtl.h"
 #include "impeller/renderer/backend/metal/formats_mtl.h"
@@ -17,25 +18,132 @@
 
 namespace impeller {
 
-PipelineLibraryMTL::PipelineLibraryMTL(id<MTLDevice> device)
-    : device_(device) {}
+PipelineLibraryMTL::PipelineLibraryMTL(id<MTLDevice> device,
+                                       const std::string& binary_archive_path)
+    : device_(device) {
+  if (binary_archive_path.empty()) {
+    return;
+  }
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    TRACE_EVENT0("impeller", "PipelineLibraryMTL::LoadBinaryArchive");
+    auto url = [NSURL fileURLWithPath:@(binary_archive_path.c_str())];
+    auto descriptor = [[MTLBinaryArchiveDescriptor alloc] init];
+    if ([[NSFileManager defaultManager] fileExistsAtPath:url.path]) {
+      descriptor.url = url;
+    }
+    NSError* error = nil;
+    binary_archive_ = [device_ newBinaryArchiveWithDescriptor:descriptor
+                                                         error:&error];
+    if (binary_archive_ == nil && descriptor.url != nil) {
+      // The archive may be corrupt or have been written by another OS version.
+      // Start over with an empty one.
+      FML_LOG(INFO) << "Could not load the pipeline binary archive: "
+                    << error.localizedDescription.UTF8String
+                    << ". Discarding it.";
+      descriptor.url = nil;
+      binary_archive_ = [device_ newBinaryArchiveWithDescriptor:descriptor
+                                                           error:&error];
+    }
+    if (binary_archive_ == nil) {
+      VALIDATION_LOG << "Could not create the pipeline binary archive: "
+                     << error.localizedDescription.UTF8String;
+      return;
+    }
+    binary_archive_url_ = url;
+    binary_archive_queue_ = dispatch_queue_create(
+        "io.flutter.impeller.binary_archive",
+        dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL,
+                                                QOS_CLASS_UTILITY, 0));
+  }
+}
 
 PipelineLibraryMTL::~PipelineLibraryMTL() = default;
 
+bool PipelineLibraryMTL::HasBinaryArchive() const {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    return binary_archive_ != nil;
+  }
+  return false;
+}
+
+void PipelineLibraryMTL::AddToBinaryArchive(
+    MTLRenderPipelineDescriptor* descriptor) {
+  if (!HasBinaryArchive()) {
+    return;
+  }
+  auto weak_this = weak_from_this();
+  dispatch_async(binary_archive_queue_, ^{
+    auto strong_this = weak_this.lock();
+    if (!strong_this) {
+      return;
+    }
+    if (@available(iOS 14.0, macOS 11.0, *)) {
+      auto& library = PipelineLibraryMTL::Cast(*strong_this);
+      // Metal skips the pipelines that are already in the archive.
+      NSError* error = nil;
+      if (![library.binary_archive_
+              addRenderPipelineFunctionsWithDescriptor:descriptor
+                                                 error:&error]) {
+        FML_LOG(INFO) << "Could not add pipeline "
+                      << descriptor.label.UTF8String
+                      << " to the binary archive: "
+                      << error.localizedDescription.UTF8String;
+        return;
+      }
+      library.binary_archive_is_dirty_ = true;
+    }
+  });
+}
+
+void PipelineLibraryMTL::PersistBinaryArchive() {
+  if (!HasBinaryArchive()) {
+    return;
+  }
+  auto weak_this = weak_from_this();
+  dispatch_async(binary_archive_queue_, ^{
+    auto strong_this = weak_this.lock();
+    if (!strong_this) {
+      return;
+    }
+    if (@available(iOS 14.0, macOS 11.0, *)) {
+      auto& library = PipelineLibraryMTL::Cast(*strong_this);
+      if (!library.binary_archive_is_dirty_) {
+        return;
+      }
+      TRACE_EVENT0("impeller", "PipelineLibraryMTL::PersistBinaryArchive");
+      library.binary_archive_is_dirty_ = false;
+      NSError* error = nil;
+      if (![library.binary_archive_ serializeToURL:library.binary_archive_url_
+                                             error:&error]) {
+        VALIDATION_LOG << "Could not persist the pipeline binary archive: "
+                       << error.localizedDescription.UTF8String;
+      }
+    }
+  });
+}
+
+void PipelineLibraryMTL::DidAcquireSurfaceFrame() {
+  if (HasBinaryArchive() &&
+      ++frames_acquired_ % kPersistAfterFrameCount == 0u) {
+    PersistBinaryArchive();
+  }
+}
+
 static MTLRenderPipelineDescriptor* GetMTLRenderPipelineDescriptor(
     const PipelineDescriptor& desc) {
   auto descriptor = [[MTLRenderPipelineDescriptor alloc] init];
   descriptor.label = @(desc.GetLabel().c_str());
   descriptor.rasterSampleCount = static_cast<NSUInteger>(desc.GetSampleCount());
 
+  const auto& constants = desc.GetSpecializationConstants();
   for (const auto& entry : desc.GetStageEntrypoints()) {
     if (entry.first == ShaderStage::kVertex) {
-      descriptor.vertexFunction =
-          ShaderFunctionMTL::Cast(*entry.second).GetMTLFunction();
+      descriptor.vertexFunction = ShaderFunctionMTL::Cast(*entry.second)
+                                      .GetMTLFunctionSpecialized(constants);
     }
     if (entry.first == ShaderStage::kFragment) {
-      descriptor.fragmentFunction =
-          ShaderFunctionMTL::Cast(*entry.second).GetMTLFunction();
+      descriptor.fragmentFunction = ShaderFunctionMTL::Cast(*entry.second)
+                                        .GetMTLFunctionSpecialized(constants);
     }
   }
 
@@ -108,6 +216,15 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
   pipelines_[descriptor] = pipeline_future;
   auto weak_this = weak_from_this();
 
+  auto mtl_descriptor = GetMTLRenderPipelineDescriptor(descriptor);
+  if (HasBinaryArchive()) {
+    if (@available(iOS 14.0, macOS 11.0, *)) {
+      // Pipelines missing from the archive are compiled as usual, and added
+      // to it once created so the next launch finds them.
+      mtl_descriptor.binaryArchives = @[ binary_archive_ ];
+    }
+  }
+
   auto completion_handler =
       ^(id<MTLRenderPipelineState> _Nullable render_pipeline_state,
         NSError* _Nullable error) {
@@ -132,8 +249,9 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
             CreateDepthStencilDescriptor(descriptor, device_)  //
             ));
         promise->set_value(new_pipeline);
+        PipelineLibraryMTL::Cast(*strong_this)
+            .AddToBinaryArchive(mtl_descriptor);
       };
-  auto mtl_descriptor = GetMTLRenderPipelineDescriptor(descriptor);
 #if FML_OS_IOS
   [device_ newRenderPipelineStateWithDescriptor:mtl_descriptor
                               completionHandler:completion_handler];
@@ -35,6 +35,9 @@ class RenderPassMTL final : public RenderPass {
   // |RenderPass|
   void OnSetLabel(std::string label) override;
 
+  // |RenderPass|
+  void OnSetStencilStoreAction(StoreAction action) override;
+
   // |RenderPass|
   bool OnEncodeCommands(const Context& context) const override;
 
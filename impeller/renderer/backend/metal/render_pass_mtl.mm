@@ -158,6 +158,10 @@ void RenderPassMTL::OnSetLabel(std::string label) {
   label_ = std::move(label);
 }
 
+void RenderPassMTL::OnSetStencilStoreAction(StoreAction action) {
+  desc_.stencilAttachment.storeAction = ToMTLStoreAction(action);
+}
+
 bool RenderPassMTL::OnEncodeCommands(const Context& context) const {
   TRACE_EVENT0("impeller", "RenderPassMTL::EncodeCommands");
   if (!IsValid()) {
@@ -179,7 +183,22 @@ bool RenderPassMTL::OnEncodeCommands(const Context& context) const {
   fml::ScopedCleanupClosure auto_end(
       [render_command_encoder]() { [render_command_encoder endEncoding]; });
 
-  return EncodeCommands(context.GetResourceAllocator(), render_command_encoder);
+  if (!EncodeCommands(context.GetResourceAllocator(), render_command_encoder)) {
+    return false;
+  }
+
+  // The transients buffer uploads into the same device buffer again once
+  // nothing else references it. Keep the one this pass reads alive until the
+  // GPU is done with it.
+  if (transients_buffer_->GetLength() > 0u) {
+    std::shared_ptr<const Buffer> transients = transients_buffer_;
+    auto device_buffer =
+        transients->GetDeviceBuffer(*context.GetResourceAllocator());
+    [buffer_ addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+      (void)device_buffer;
+    }];
+  }
+  return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -6,8 +6,11 @@
 
 #include <Metal/Metal.h>
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/geometry/scalar.h"
 #include "impeller/renderer/shader_function.h"
 
 namespace impeller {
@@ -21,13 +24,23 @@ class ShaderFunctionMTL final
 
   id<MTLFunction> GetMTLFunction() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the function with its function constants set to
+  ///             `constants`, indexed by constant ID, or the function itself
+  ///             if it has no function constants.
+  ///
+  id<MTLFunction> GetMTLFunctionSpecialized(
+      const std::vector<Scalar>& constants) const;
+
  private:
   friend class ShaderLibraryMTL;
 
   id<MTLFunction> function_ = nullptr;
+  id<MTLLibrary> library_ = nullptr;
 
   ShaderFunctionMTL(UniqueID parent_library_id,
                     id<MTLFunction> function,
+                    id<MTLLibrary> library,
                     std::string name,
                     ShaderStage stage);
 
@@ -4,14 +4,18 @@
 
 #include "impeller/renderer/backend/metal/shader_function_mtl.h"
 
+#include "impeller/base/validation.h"
+
 namespace impeller {
 
 ShaderFunctionMTL::ShaderFunctionMTL(UniqueID parent_library_id,
                                      id<MTLFunction> function,
+                                     id<MTLLibrary> library,
                                      std::string name,
                                      ShaderStage stage)
     : ShaderFunction(parent_library_id, std::move(name), stage),
-      function_(function) {}
+      function_(function),
+      library_(library) {}
 
 ShaderFunctionMTL::~ShaderFunctionMTL() = default;
 
@@ -19,4 +23,27 @@ id<MTLFunction> ShaderFunctionMTL::GetMTLFunction() const {
   return function_;
 }
 
+id<MTLFunction> ShaderFunctionMTL::GetMTLFunctionSpecialized(
+    const std::vector<Scalar>& constants) const {
+  // Functions with function constants must always be specialized. Constants
+  // without a value fall back to their defaults.
+  if (function_.functionConstantsDictionary.count == 0) {
+    return function_;
+  }
+  auto constant_values = [[MTLFunctionConstantValues alloc] init];
+  for (size_t i = 0; i < constants.size(); i++) {
+    auto value = constants[i];
+    [constant_values setConstantValue:&value type:MTLDataTypeFloat atIndex:i];
+  }
+  NSError* error = nil;
+  auto function = [library_ newFunctionWithName:function_.name
+                                 constantValues:constant_values
+                                          error:&error];
+  if (function == nil) {
+    VALIDATION_LOG << "Could not specialize function " << GetName() << ": "
+                   << error.localizedDescription.UTF8String;
+  }
+  return function;
+}
+
 }  // namespace impeller
@@ -129,6 +129,10 @@ std::unique_ptr<SurfaceMTL> SurfaceMTL::MakeFromTexture(
     id<MTLTexture> texture,
     std::optional<IRect> clip_rect,
     id<CAMetalDrawable> drawable) {
+  if (auto pipeline_library = context->GetPipelineLibrary()) {
+    PipelineLibraryMTL::Cast(*pipeline_library).DidAcquireSurfaceFrame();
+  }
+
   bool partial_repaint_blit_required = ShouldPerformPartialRepaint(clip_rect);
 
   // The returned render target is the texture that Impeller will render the
@@ -4,4 +4,167 @@
 
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 
-namespace impeller {}  // namespace impeller
+#include <atomic>
+
+#include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+
+namespace impeller {
+
+static std::atomic_size_t sEncodedBarrierCount;
+static std::atomic_size_t sEncodedImageBarrierCount;
+
+// The operations that may have written to an image that was left in `layout`,
+// and that a transition out of it must wait for.
+static void GetSrcScopeForLayout(vk::ImageLayout layout,
+                                 vk::PipelineStageFlags& stage,
+                                 vk::AccessFlags& access) {
+  switch (layout) {
+    case vk::ImageLayout::eUndefined:
+      stage = vk::PipelineStageFlagBits::eTopOfPipe;
+      access = {};
+      return;
+    case vk::ImageLayout::eColorAttachmentOptimal:
+      stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+      access = vk::AccessFlagBits::eColorAttachmentWrite;
+      return;
+    case vk::ImageLayout::eDepthStencilAttachmentOptimal:
+      stage = vk::PipelineStageFlagBits::eEarlyFragmentTests |
+              vk::PipelineStageFlagBits::eLateFragmentTests;
+      access = vk::AccessFlagBits::eDepthStencilAttachmentWrite;
+      return;
+    case vk::ImageLayout::eTransferDstOptimal:
+      stage = vk::PipelineStageFlagBits::eTransfer;
+      access = vk::AccessFlagBits::eTransferWrite;
+      return;
+    case vk::ImageLayout::eTransferSrcOptimal:
+      // Reads only need to be done before the layout changes, there are no
+      // writes to make visible.
+      stage = vk::PipelineStageFlagBits::eTransfer;
+      access = {};
+      return;
+    case vk::ImageLayout::eShaderReadOnlyOptimal:
+      stage = vk::PipelineStageFlagBits::eVertexShader |
+              vk::PipelineStageFlagBits::eFragmentShader |
+              vk::PipelineStageFlagBits::eComputeShader;
+      access = {};
+      return;
+    case vk::ImageLayout::ePresentSrcKHR:
+      // Swapchain images are waited for with the acquire semaphore, at the
+      // color attachment output stage.
+      stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+      access = {};
+      return;
+    default:
+      // The general layout can be left by any of the above.
+      stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
+              vk::PipelineStageFlagBits::eEarlyFragmentTests |
+              vk::PipelineStageFlagBits::eLateFragmentTests |
+              vk::PipelineStageFlagBits::eTransfer |
+              vk::PipelineStageFlagBits::eFragmentShader |
+              vk::PipelineStageFlagBits::eComputeShader;
+      access = vk::AccessFlagBits::eColorAttachmentWrite |
+               vk::AccessFlagBits::eDepthStencilAttachmentWrite |
+               vk::AccessFlagBits::eTransferWrite |
+               vk::AccessFlagBits::eShaderWrite;
+      return;
+  }
+}
+
+BarrierBatchVK::BarrierBatchVK() = default;
+
+BarrierBatchVK::~BarrierBatchVK() = default;
+
+void BarrierBatchVK::AddTransition(const TextureSourceVK& source,
+                                   const BarrierVK& barrier) {
+  const auto old_layout = source.SetLayoutWithoutEncoding(barrier.new_layout);
+  if (old_layout == barrier.new_layout) {
+    return;
+  }
+  src_stage_ |= barrier.src_stage;
+  dst_stage_ |= barrier.dst_stage;
+  AppendImageBarrier(source, old_layout, barrier.new_layout, barrier.src_access,
+                     barrier.dst_access);
+}
+
+void BarrierBatchVK::AddTransition(const TextureSourceVK& source,
+                                   vk::ImageLayout new_layout,
+                                   vk::PipelineStageFlags dst_stage,
+                                   vk::AccessFlags dst_access) {
+  const auto old_layout = source.SetLayoutWithoutEncoding(new_layout);
+  if (old_layout == new_layout) {
+    return;
+  }
+  vk::PipelineStageFlags src_stage;
+  vk::AccessFlags src_access;
+  GetSrcScopeForLayout(old_layout, src_stage, src_access);
+  src_stage_ |= src_stage;
+  dst_stage_ |= dst_stage;
+  AppendImageBarrier(source, old_layout, new_layout, src_access, dst_access);
+}
+
+void BarrierBatchVK::AppendImageBarrier(const TextureSourceVK& source,
+                                        vk::ImageLayout old_layout,
+                                        vk::ImageLayout new_layout,
+                                        vk::AccessFlags src_access,
+                                        vk::AccessFlags dst_access) {
+  const auto& desc = source.GetTextureDescriptor();
+
+  vk::ImageMemoryBarrier image_barrier;
+  image_barrier.srcAccessMask = src_access;
+  image_barrier.dstAccessMask = dst_access;
+  image_barrier.oldLayout = old_layout;
+  image_barrier.newLayout = new_layout;
+  image_barrier.image = source.GetImage();
+  image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  image_barrier.subresourceRange.aspectMask = ToImageAspectFlags(desc.format);
+  image_barrier.subresourceRange.baseMipLevel = 0u;
+  image_barrier.subresourceRange.levelCount = desc.mip_count;
+  image_barrier.subresourceRange.baseArrayLayer = 0u;
+  image_barrier.subresourceRange.layerCount = ToArrayLayerCount(desc.type);
+  image_barriers_.push_back(image_barrier);
+}
+
+size_t BarrierBatchVK::GetTransitionCount() const {
+  return image_barriers_.size();
+}
+
+void BarrierBatchVK::Encode(const vk::CommandBuffer& buffer) {
+  if (image_barriers_.empty()) {
+    return;
+  }
+
+  // Without synchronization2, the stage masks may not be empty.
+  if (!src_stage_) {
+    src_stage_ = vk::PipelineStageFlagBits::eTopOfPipe;
+  }
+  if (!dst_stage_) {
+    dst_stage_ = vk::PipelineStageFlagBits::eBottomOfPipe;
+  }
+
+  buffer.pipelineBarrier(src_stage_,      // src stage
+                         dst_stage_,      // dst stage
+                         {},              // dependency flags
+                         nullptr,         // memory barriers
+                         nullptr,         // buffer barriers
+                         image_barriers_  // image barriers
+  );
+
+  sEncodedBarrierCount++;
+  sEncodedImageBarrierCount += image_barriers_.size();
+
+  image_barriers_.clear();
+  src_stage_ = {};
+  dst_stage_ = {};
+}
+
+size_t BarrierBatchVK::GetEncodedBarrierCount() {
+  return sEncodedBarrierCount;
+}
+
+size_t BarrierBatchVK::GetEncodedImageBarrierCount() {
+  return sEncodedImageBarrierCount;
+}
+
+}  // namespace impeller
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
@@ -42,4 +44,76 @@ struct BarrierVK {
   vk::AccessFlags dst_access = vk::AccessFlagBits::eNone;
 };
 
+class TextureSourceVK;
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the layout transitions needed at one point of a
+///             command buffer, such as the start of a pass, and encodes them
+///             with a single pipeline barrier.
+///
+///             Transitions of an image to the layout it is already in are
+///             skipped, so an image sampled by many commands of a pass is only
+///             transitioned once. The stages of all the transitions in a batch
+///             are merged.
+///
+class BarrierBatchVK {
+ public:
+  BarrierBatchVK();
+
+  ~BarrierBatchVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the transition of `source` described by `barrier`.
+  ///             `barrier.cmd_buffer` is ignored.
+  ///
+  void AddTransition(const TextureSourceVK& source, const BarrierVK& barrier);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the transition of `source` to `new_layout` ahead of
+  ///             the `dst_access` accesses in `dst_stage`.
+  ///
+  ///             Only the operations that could have left the image in its
+  ///             current layout are waited for. For instance, an image last
+  ///             used as a color attachment only needs the color attachment
+  ///             writes to be done, not the transfers and shader writes too.
+  ///
+  void AddTransition(const TextureSourceVK& source,
+                     vk::ImageLayout new_layout,
+                     vk::PipelineStageFlags dst_stage,
+                     vk::AccessFlags dst_access);
+
+  size_t GetTransitionCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes the recorded transitions to `buffer`, if there are
+  ///             any, and clears the batch.
+  ///
+  void Encode(const vk::CommandBuffer& buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of pipeline barriers encoded by all batches since
+  ///             the process started.
+  ///
+  static size_t GetEncodedBarrierCount();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of image barriers in the pipeline barriers
+  ///             encoded by all batches since the process started.
+  ///
+  static size_t GetEncodedImageBarrierCount();
+
+ private:
+  std::vector<vk::ImageMemoryBarrier> image_barriers_;
+  vk::PipelineStageFlags src_stage_;
+  vk::PipelineStageFlags dst_stage_;
+
+  void AppendImageBarrier(const TextureSourceVK& source,
+                          vk::ImageLayout old_layout,
+                          vk::ImageLayout new_layout,
+                          vk::AccessFlags src_access,
+                          vk::AccessFlags dst_access);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BarrierBatchVK);
+};
+
 }  // namespace impeller
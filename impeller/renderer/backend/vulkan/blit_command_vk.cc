@@ -55,11 +55,19 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  const auto src_source = src.GetTextureSource();
+  const auto dst_source = dst.GetTextureSource();
+  if (!src_source || !dst_source) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
 
+  // Both transitions are needed before the copy, so encode them together.
+  BarrierBatchVK barriers;
+  barriers.AddTransition(*src_source, src_barrier);
+  barriers.AddTransition(*dst_source, dst_barrier);
+  barriers.Encode(cmd_buffer);
+
   vk::ImageCopy image_copy;
 
   image_copy.setSrcSubresource(
@@ -183,10 +191,10 @@ bool BlitCopyBufferToTextureCommandVK::Encode(CommandEncoderVK& encoder) const {
   image_copy.setBufferImageHeight(0);
   image_copy.setImageSubresource(
       vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
-  image_copy.setImageOffset(
-      vk::Offset3D(destination_origin.x, destination_origin.y, 0));
-  image_copy.setImageExtent(vk::Extent3D(destination->GetSize().width,
-                                         destination->GetSize().height, 1));
+  image_copy.setImageOffset(vk::Offset3D(destination_region.origin.x,
+                                         destination_region.origin.y, 0));
+  image_copy.setImageExtent(vk::Extent3D(destination_region.size.width,
+                                         destination_region.size.height, 1));
 
   if (!dst.SetLayout(dst_barrier)) {
     VALIDATION_LOG << "Could not encode layout transition.";
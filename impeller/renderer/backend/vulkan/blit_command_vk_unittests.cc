@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "flutter/testing/testing.h"
 #include "impeller/renderer/backend/vulkan/blit_command_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
@@ -27,6 +29,37 @@ TEST(BlitCommandVkTest, BlitCopyTextureToTextureCommandVK) {
   EXPECT_TRUE(encoder->IsTracking(cmd.destination));
 }
 
+TEST(BlitCommandVkTest, BlitCopyTextureToTextureBatchesLayoutTransitions) {
+  auto context = CreateMockVulkanContext();
+  auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
+  BlitCopyTextureToTextureCommandVK cmd;
+  cmd.source = context->GetResourceAllocator()->CreateTexture({
+      .size = ISize(100, 100),
+  });
+  cmd.destination = context->GetResourceAllocator()->CreateTexture({
+      .size = ISize(100, 100),
+  });
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  const auto count_barriers = [&functions]() {
+    return std::count(functions->begin(), functions->end(),
+                      "vkCmdPipelineBarrier");
+  };
+  const auto image_barrier_count =
+      BarrierBatchVK::GetEncodedImageBarrierCount();
+
+  // Both images are transitioned by a single barrier.
+  ASSERT_TRUE(cmd.Encode(*encoder.get()));
+  EXPECT_EQ(count_barriers(), 1);
+  EXPECT_EQ(BarrierBatchVK::GetEncodedImageBarrierCount(),
+            image_barrier_count + 2u);
+
+  // Both images are already in the layouts the copy needs.
+  ASSERT_TRUE(cmd.Encode(*encoder.get()));
+  EXPECT_EQ(count_barriers(), 1);
+  EXPECT_EQ(BarrierBatchVK::GetEncodedImageBarrierCount(),
+            image_barrier_count + 2u);
+}
+
 TEST(BlitCommandVkTest, BlitCopyTextureToBufferCommandVK) {
   auto context = CreateMockVulkanContext();
   auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
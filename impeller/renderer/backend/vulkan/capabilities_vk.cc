@@ -8,6 +8,7 @@
 
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
@@ -153,6 +154,12 @@ static const char* GetDeviceExtensionName(OptionalDeviceExtensionVK ext) {
   switch (ext) {
     case OptionalDeviceExtensionVK::kEXTPipelineCreationFeedback:
       return VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRIncrementalPresent:
+      return VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kGOOGLEDisplayTiming:
+      return VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRTimelineSemaphore:
+      return VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kLast:
       return "Unknown";
   }
@@ -245,6 +252,15 @@ static bool HasSuitableDepthStencilFormat(const vk::PhysicalDevice& device,
             vk::FormatFeatureFlagBits::eDepthStencilAttachment);
 }
 
+static bool HasSuitableCompressedFormat(const vk::PhysicalDevice& device,
+                                        vk::Format format) {
+  const auto props = device.getFormatProperties(format);
+  return !!(props.optimalTilingFeatures &
+            vk::FormatFeatureFlagBits::eSampledImage) &&
+         !!(props.optimalTilingFeatures &
+            vk::FormatFeatureFlagBits::eSampledImageFilterLinear);
+}
+
 static bool PhysicalDeviceSupportsRequiredFormats(
     const vk::PhysicalDevice& device) {
   const auto has_color_format =
@@ -310,6 +326,13 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
   // necessarily a big deal if we don't have this feature.
   required.fillModeNonSolid = device_features.fillModeNonSolid;
 
+  // Block compressed image formats can only be used if their features are
+  // enabled. See |SupportsCompressedPixelFormat|.
+  required.textureCompressionETC2 = device_features.textureCompressionETC2;
+  required.textureCompressionASTC_LDR =
+      device_features.textureCompressionASTC_LDR;
+  required.textureCompressionBC = device_features.textureCompressionBC;
+
   return required;
 }
 
@@ -383,6 +406,24 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
     }
   }
 
+  {
+    // Query the support for block compressed textures. The device features
+    // they depend on are enabled by |GetEnabledDeviceFeatures|.
+    supported_compressed_pixel_formats_.clear();
+    const auto features = device.getFeatures();
+    const auto add_if_supported = [&](bool feature, PixelFormat format) {
+      if (feature &&
+          HasSuitableCompressedFormat(device, ToVKImageFormat(format))) {
+        supported_compressed_pixel_formats_.insert(format);
+      }
+    };
+    add_if_supported(features.textureCompressionETC2,
+                     PixelFormat::kETC2R8G8B8A8UNormInt);
+    add_if_supported(features.textureCompressionASTC_LDR,
+                     PixelFormat::kASTC4x4UNormInt);
+    add_if_supported(features.textureCompressionBC, PixelFormat::kBC7UNormInt);
+  }
+
   // Determine the optional device extensions this physical device supports.
   {
     optional_device_extensions_.clear();
@@ -398,9 +439,29 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
     });
   }
 
+  supports_timeline_semaphores_ = CanEnableTimelineSemaphores(device);
+
   return true;
 }
 
+bool CapabilitiesVK::CanEnableTimelineSemaphores(
+    const vk::PhysicalDevice& physical_device) const {
+  auto exts = GetSupportedDeviceExtensions(physical_device);
+  if (!exts.has_value() ||
+      exts->find(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) == exts->end()) {
+    return false;
+  }
+  using TimelineFeatures = vk::PhysicalDeviceTimelineSemaphoreFeatures;
+  const auto features =
+      physical_device
+          .getFeatures2<vk::PhysicalDeviceFeatures2, TimelineFeatures>();
+  return features.get<TimelineFeatures>().timelineSemaphore;
+}
+
+bool CapabilitiesVK::SupportsTimelineSemaphores() const {
+  return supports_timeline_semaphores_;
+}
+
 // |Capabilities|
 bool CapabilitiesVK::SupportsOffscreenMSAA() const {
   return true;
@@ -457,11 +518,23 @@ bool CapabilitiesVK::SupportsDeviceTransientTextures() const {
   return supports_device_transient_textures_;
 }
 
+// |Capabilities|
+bool CapabilitiesVK::SupportsCompressedPixelFormat(PixelFormat format) const {
+  // Set by |SetPhysicalDevice|.
+  return supported_compressed_pixel_formats_.find(format) !=
+         supported_compressed_pixel_formats_.end();
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultColorFormat() const {
   return default_color_format_;
 }
 
+// |Capabilities|
+PixelFormat CapabilitiesVK::GetDefaultOffscreenColorFormat() const {
+  return default_color_format_;
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultStencilFormat() const {
   return default_stencil_format_;
@@ -21,6 +21,12 @@ class ContextVK;
 enum class OptionalDeviceExtensionVK : uint32_t {
   // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_pipeline_creation_feedback.html
   kEXTPipelineCreationFeedback,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_incremental_present.html
+  kKHRIncrementalPresent,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_GOOGLE_display_timing.html
+  kGOOGLEDisplayTiming,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_timeline_semaphore.html
+  kKHRTimelineSemaphore,
   kLast,
 };
 
@@ -50,6 +56,16 @@ class CapabilitiesVK final : public Capabilities,
   std::optional<vk::PhysicalDeviceFeatures> GetEnabledDeviceFeatures(
       const vk::PhysicalDevice& physical_device) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the timeline semaphore feature can be enabled on the
+  ///             device. It has to be chained to the create info of the
+  ///             logical device for timeline semaphores to be used.
+  ///
+  bool CanEnableTimelineSemaphores(
+      const vk::PhysicalDevice& physical_device) const;
+
+  bool SupportsTimelineSemaphores() const;
+
   [[nodiscard]] bool SetPhysicalDevice(
       const vk::PhysicalDevice& physical_device);
 
@@ -90,9 +106,15 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsDeviceTransientTextures() const override;
 
+  // |Capabilities|
+  bool SupportsCompressedPixelFormat(PixelFormat format) const override;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
+  // |Capabilities|
+  PixelFormat GetDefaultOffscreenColorFormat() const override;
+
   // |Capabilities|
   PixelFormat GetDefaultStencilFormat() const override;
 
@@ -109,6 +131,8 @@ class CapabilitiesVK final : public Capabilities,
   vk::PhysicalDeviceProperties device_properties_;
   bool supports_compute_subgroups_ = false;
   bool supports_device_transient_textures_ = false;
+  bool supports_timeline_semaphores_ = false;
+  std::set<PixelFormat> supported_compressed_pixel_formats_;
   bool is_valid_ = false;
 
   bool HasExtension(const std::string& ext) const;
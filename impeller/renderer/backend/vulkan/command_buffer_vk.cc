@@ -8,13 +8,18 @@
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/blit_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/compute_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/encoding_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/gpu_timestamp_queries_vk.h"
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
+#include "impeller/renderer/backend/vulkan/submission_batch_vk.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_target.h"
 
@@ -22,13 +27,30 @@ namespace impeller {
 
 CommandBufferVK::CommandBufferVK(
     std::weak_ptr<const Context> context,
-    std::shared_ptr<CommandEncoderFactoryVK> encoder_factory)
+    std::shared_ptr<CommandEncoderFactoryVK> encoder_factory,
+    std::shared_ptr<GPUTracer> gpu_tracer,
+    std::shared_ptr<GPUTimestampQueriesVK> timestamp_queries)
     : CommandBuffer(std::move(context)),
-      encoder_factory_(std::move(encoder_factory)) {}
+      encoder_factory_(std::move(encoder_factory)),
+      gpu_tracer_(std::move(gpu_tracer)),
+      timestamp_queries_(std::move(timestamp_queries)) {
+  if (gpu_tracer_ && timestamp_queries_) {
+    traced_frame_ = gpu_tracer_->OnCommandBufferCreated();
+  }
+}
 
-CommandBufferVK::~CommandBufferVK() = default;
+CommandBufferVK::~CommandBufferVK() {
+  if (traced_frame_.has_value()) {
+    // The buffer was never submitted.
+    gpu_tracer_->OnCommandBufferCompleted(traced_frame_.value(), label_,
+                                          std::nullopt);
+  }
+}
 
 void CommandBufferVK::SetLabel(const std::string& label) const {
+  if (traced_frame_.has_value()) {
+    label_ = label;
+  }
   if (!encoder_) {
     encoder_factory_->SetLabel(label);
   } else {
@@ -47,21 +69,120 @@ bool CommandBufferVK::IsValid() const {
 const std::shared_ptr<CommandEncoderVK>& CommandBufferVK::GetEncoder() {
   if (!encoder_) {
     encoder_ = encoder_factory_->Create();
+    if (encoder_ && traced_frame_.has_value()) {
+      timestamp_query_ =
+          timestamp_queries_->RecordStart(encoder_->GetCommandBuffer());
+    }
   }
   return encoder_;
 }
 
+CommandEncoderVK::SubmitCallback CommandBufferVK::TraceGPUTime(
+    CommandEncoderVK::SubmitCallback callback) {
+  if (!traced_frame_.has_value()) {
+    return callback;
+  }
+  const uint64_t frame = traced_frame_.value();
+  traced_frame_.reset();
+  const auto query = timestamp_query_;
+  if (query.has_value() && encoder_) {
+    timestamp_queries_->RecordEnd(encoder_->GetCommandBuffer(), query.value());
+  }
+  return [callback = std::move(callback), frame, query,
+          tracer = gpu_tracer_, queries = timestamp_queries_,
+          label = label_](bool submitted) {
+    std::optional<fml::TimeDelta> gpu_duration;
+    if (submitted && query.has_value()) {
+      gpu_duration = queries->GetDuration(query.value());
+    }
+    tracer->OnCommandBufferCompleted(frame, label, gpu_duration);
+    if (callback) {
+      callback(submitted);
+    }
+  };
+}
+
+std::shared_ptr<CommandEncoderVK> CommandBufferVK::CreateSecondaryEncoder(
+    const vk::CommandBufferInheritanceInfo& inheritance_info) const {
+  return encoder_factory_->CreateSecondary(inheritance_info);
+}
+
+// Whether submissions made now on the calling thread are left to be made
+// together when the frame is presented.
+static bool ShouldDeferSubmission(const std::weak_ptr<const Context>& context) {
+  auto strong_context = context.lock();
+  if (!strong_context) {
+    return false;
+  }
+  const auto& batch = ContextVK::Cast(*strong_context).GetSubmissionBatch();
+  return batch && batch->IsDeferringOnCurrentThread();
+}
+
 bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
-  if (!callback) {
-    return encoder_->Submit();
+  // Anything submitted asynchronously before this buffer was recorded must
+  // reach the queue first.
+  if (auto context = context_.lock()) {
+    if (const auto& queue = ContextVK::Cast(*context).GetEncodingQueue()) {
+      queue->Flush();
+    }
+  }
+  CommandEncoderVK::SubmitCallback submit_callback;
+  if (callback) {
+    submit_callback = [callback](bool submitted) {
+      callback(submitted ? CommandBuffer::Status::kCompleted
+                         : CommandBuffer::Status::kError);
+    };
+  }
+  return encoder_->Submit(TraceGPUTime(std::move(submit_callback)),
+                          ShouldDeferSubmission(context_));
+}
+
+bool CommandBufferVK::SubmitCommandsAsync(
+    std::shared_ptr<RenderPass> render_pass) {
+  TRACE_EVENT0("impeller", "CommandBufferVK::SubmitCommandsAsync");
+  if (!IsValid() || !render_pass->IsValid()) {
+    return false;
+  }
+  auto context = context_.lock();
+  if (!context) {
+    return false;
+  }
+  const auto& queue = ContextVK::Cast(*context).GetEncodingQueue();
+  if (!queue) {
+    return CommandBuffer::SubmitCommandsAsync(std::move(render_pass));
   }
-  return encoder_->Submit([callback](bool submitted) {
-    callback(submitted ? CommandBuffer::Status::kCompleted
-                       : CommandBuffer::Status::kError);
-  });
+
+  // The encoder is created lazily when the pass is encoded, so its command
+  // buffer comes from the command pool of the worker that encodes it.
+  // Whether to defer is decided on the thread recording the frame, not on
+  // the worker.
+  queue->Post(fml::MakeCopyable(
+      [render_pass = std::move(render_pass), buffer = shared_from_this(),
+       defer = ShouldDeferSubmission(context_)]() {
+        if (!render_pass->EncodeCommands()) {
+          VALIDATION_LOG << "Failed to encode render pass asynchronously.";
+          return;
+        }
+        const auto& encoder = buffer->GetEncoder();
+        if (!encoder || !encoder->Submit(buffer->TraceGPUTime({}), defer)) {
+          VALIDATION_LOG << "Failed to submit render pass asynchronously.";
+        }
+      }));
+  return true;
 }
 
-void CommandBufferVK::OnWaitUntilScheduled() {}
+void CommandBufferVK::OnWaitUntilScheduled() {
+  if (auto context = context_.lock()) {
+    const auto& context_vk = ContextVK::Cast(*context);
+    if (const auto& queue = context_vk.GetEncodingQueue()) {
+      queue->Flush();
+    }
+    // Deferred command buffers are only scheduled once they are submitted.
+    if (const auto& batch = context_vk.GetSubmissionBatch()) {
+      batch->Flush();
+    }
+  }
+}
 
 std::shared_ptr<RenderPass> CommandBufferVK::OnCreateRenderPass(
     RenderTarget target) {
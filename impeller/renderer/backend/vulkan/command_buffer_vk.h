@@ -4,16 +4,22 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 namespace impeller {
 
 class ContextVK;
 class CommandEncoderFactoryVK;
 class CommandEncoderVK;
+class GPUTimestampQueriesVK;
 
 class CommandBufferVK final
     : public CommandBuffer,
@@ -25,14 +31,37 @@ class CommandBufferVK final
 
   const std::shared_ptr<CommandEncoderVK>& GetEncoder();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create an encoder for a secondary command buffer recorded on
+  ///             the calling thread and later executed by |GetEncoder|.
+  ///
+  std::shared_ptr<CommandEncoderVK> CreateSecondaryEncoder(
+      const vk::CommandBufferInheritanceInfo& inheritance_info) const;
+
  private:
   friend class ContextVK;
 
   std::shared_ptr<CommandEncoderVK> encoder_;
   std::shared_ptr<CommandEncoderFactoryVK> encoder_factory_;
+  const std::shared_ptr<GPUTracer> gpu_tracer_;
+  const std::shared_ptr<GPUTimestampQueriesVK> timestamp_queries_;
+  // Set until the GPU execution time of the buffer is reported to the tracer.
+  std::optional<uint64_t> traced_frame_;
+  std::optional<uint32_t> timestamp_query_;
+  // Only kept for the timeline when the buffer is traced.
+  mutable std::string label_;
 
   CommandBufferVK(std::weak_ptr<const Context> context,
-                  std::shared_ptr<CommandEncoderFactoryVK> encoder_factory);
+                  std::shared_ptr<CommandEncoderFactoryVK> encoder_factory,
+                  std::shared_ptr<GPUTracer> gpu_tracer = nullptr,
+                  std::shared_ptr<GPUTimestampQueriesVK> timestamp_queries =
+                      nullptr);
+
+  // Writes the end timestamp of the buffer and returns a callback for its
+  // submission that reports the GPU execution time to the tracer before
+  // calling |callback|.
+  CommandEncoderVK::SubmitCallback TraceGPUTime(
+      CommandEncoderVK::SubmitCallback callback);
 
   // |CommandBuffer|
   void SetLabel(const std::string& label) const override;
@@ -43,6 +72,9 @@ class CommandBufferVK final
   // |CommandBuffer|
   bool OnSubmitCommands(CompletionCallback callback) override;
 
+  // |CommandBuffer|
+  bool SubmitCommandsAsync(std::shared_ptr<RenderPass> render_pass) override;
+
   // |CommandBuffer|
   void OnWaitUntilScheduled() override;
 
@@ -8,6 +8,7 @@
 #include "flutter/fml/trace_event.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/submission_batch_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
 
 namespace impeller {
@@ -16,12 +17,13 @@ class TrackedObjectsVK {
  public:
   explicit TrackedObjectsVK(
       const std::weak_ptr<const DeviceHolder>& device_holder,
-      const std::shared_ptr<CommandPoolVK>& pool)
-      : desc_pool_(device_holder) {
+      const std::shared_ptr<CommandPoolVK>& pool,
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary)
+      : desc_pool_(device_holder), level_(level) {
     if (!pool) {
       return;
     }
-    auto buffer = pool->CreateGraphicsCommandBuffer();
+    auto buffer = pool->CreateGraphicsCommandBuffer(level_);
     if (!buffer) {
       return;
     }
@@ -40,7 +42,7 @@ class TrackedObjectsVK {
       buffer_.release();
       return;
     }
-    pool->CollectGraphicsCommandBuffer(std::move(buffer_));
+    pool->CollectGraphicsCommandBuffer(std::move(buffer_), level_);
   }
 
   bool IsValid() const { return is_valid_; }
@@ -80,17 +82,28 @@ class TrackedObjectsVK {
     return tracked_textures_.find(texture) != tracked_textures_.end();
   }
 
+  void Track(std::shared_ptr<TrackedObjectsVK> secondary) {
+    if (!secondary) {
+      return;
+    }
+    tracked_secondaries_.emplace_back(std::move(secondary));
+  }
+
   vk::CommandBuffer GetCommandBuffer() const { return *buffer_; }
 
   DescriptorPoolVK& GetDescriptorPool() { return desc_pool_; }
 
  private:
   DescriptorPoolVK desc_pool_;
+  const vk::CommandBufferLevel level_;
   std::weak_ptr<CommandPoolVK> pool_;
   vk::UniqueCommandBuffer buffer_;
   std::set<std::shared_ptr<SharedObjectVK>> tracked_objects_;
   std::set<std::shared_ptr<const Buffer>> tracked_buffers_;
   std::set<std::shared_ptr<const TextureSourceVK>> tracked_textures_;
+  // Secondary command buffers executed by this one. They must stay alive
+  // until the primary command buffer has completed.
+  std::vector<std::shared_ptr<TrackedObjectsVK>> tracked_secondaries_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TrackedObjectsVK);
@@ -138,18 +151,57 @@ std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
 
   return std::make_shared<CommandEncoderVK>(context_vk.GetDeviceHolder(),
                                             tracked_objects, queue,
-                                            context_vk.GetFenceWaiter());
+                                            context_vk.GetFenceWaiter(),
+                                            context_vk.GetSubmissionBatch());
+}
+
+std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::CreateSecondary(
+    const vk::CommandBufferInheritanceInfo& inheritance_info) {
+  auto context = context_.lock();
+  if (!context) {
+    return nullptr;
+  }
+  auto& context_vk = ContextVK::Cast(*context);
+  auto tls_pool = CommandPoolVK::GetThreadLocal(&context_vk);
+  if (!tls_pool) {
+    return nullptr;
+  }
+
+  auto tracked_objects = std::make_shared<TrackedObjectsVK>(
+      context_vk.GetDeviceHolder(), tls_pool,
+      vk::CommandBufferLevel::eSecondary);
+  if (!tracked_objects || !tracked_objects->IsValid()) {
+    return nullptr;
+  }
+
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                     vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+  begin_info.pInheritanceInfo = &inheritance_info;
+  if (tracked_objects->GetCommandBuffer().begin(begin_info) !=
+      vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not begin secondary command buffer.";
+    return nullptr;
+  }
+
+  // Secondary encoders are never submitted directly, so they don't need a
+  // queue, a fence waiter or a submission batch.
+  return std::make_shared<CommandEncoderVK>(context_vk.GetDeviceHolder(),
+                                            tracked_objects, nullptr, nullptr,
+                                            nullptr);
 }
 
 CommandEncoderVK::CommandEncoderVK(
     std::weak_ptr<const DeviceHolder> device_holder,
     std::shared_ptr<TrackedObjectsVK> tracked_objects,
     const std::shared_ptr<QueueVK>& queue,
-    std::shared_ptr<FenceWaiterVK> fence_waiter)
+    std::shared_ptr<FenceWaiterVK> fence_waiter,
+    std::shared_ptr<SubmissionBatchVK> submission_batch)
     : device_holder_(std::move(device_holder)),
       tracked_objects_(std::move(tracked_objects)),
       queue_(queue),
-      fence_waiter_(std::move(fence_waiter)) {}
+      fence_waiter_(std::move(fence_waiter)),
+      submission_batch_(std::move(submission_batch)) {}
 
 CommandEncoderVK::~CommandEncoderVK() = default;
 
@@ -157,7 +209,7 @@ bool CommandEncoderVK::IsValid() const {
   return is_valid_;
 }
 
-bool CommandEncoderVK::Submit(SubmitCallback callback) {
+bool CommandEncoderVK::Submit(SubmitCallback callback, bool defer) {
   // Make sure to call callback with `false` if anything returns early.
   bool fail_callback = !!callback;
   if (!IsValid()) {
@@ -185,36 +237,70 @@ bool CommandEncoderVK::Submit(SubmitCallback callback) {
     VALIDATION_LOG << "Failed to end command buffer: " << vk::to_string(status);
     return false;
   }
-  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
-  if (!strong_device) {
-    VALIDATION_LOG << "Device lost.";
-    return false;
+
+  if (submission_batch_ && defer) {
+    // The batch calls back with false if it can't submit the buffer either.
+    fail_callback = false;
+    submission_batch_->Defer(
+        command_buffer,
+        [callback, tracked_objects = std::move(tracked_objects_)](bool ok) {
+          if (callback) {
+            callback(ok);
+          }
+        });
+    return true;
   }
-  auto [fence_result, fence] = strong_device->GetDevice().createFenceUnique({});
-  if (fence_result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to create fence: " << vk::to_string(fence_result);
-    return false;
+
+  // Command buffers recorded before this one must reach the queue first.
+  if (submission_batch_) {
+    submission_batch_->Flush();
   }
 
   vk::SubmitInfo submit_info;
   std::vector<vk::CommandBuffer> buffers = {command_buffer};
   submit_info.setCommandBuffers(buffers);
-  status = queue_->Submit(submit_info, *fence);
-  if (status != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
+  // The fence waiter picks how completion is signaled.
+  if (!fence_waiter_->Submit(
+          *queue_, submit_info,
+          [callback, tracked_objects = std::move(tracked_objects_)] {
+            if (callback) {
+              callback(true);
+            }
+          })) {
     return false;
   }
 
   // Submit will proceed, call callback with true when it is done and do not
   // call when `reset` is collected.
   fail_callback = false;
-  return fence_waiter_->AddFence(
-      std::move(fence),
-      [callback, tracked_objects = std::move(tracked_objects_)] {
-        if (callback) {
-          callback(true);
-        }
-      });
+  return true;
+}
+
+bool CommandEncoderVK::ExecuteSecondary(
+    const std::vector<std::shared_ptr<CommandEncoderVK>>& secondaries) {
+  if (!IsValid()) {
+    return false;
+  }
+  std::vector<vk::CommandBuffer> buffers;
+  buffers.reserve(secondaries.size());
+  for (const auto& secondary : secondaries) {
+    if (!secondary || !secondary->IsValid()) {
+      VALIDATION_LOG << "Cannot execute an invalid secondary encoder.";
+      return false;
+    }
+    auto buffer = secondary->GetCommandBuffer();
+    if (buffer.end() != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to end secondary command buffer.";
+      return false;
+    }
+    buffers.push_back(buffer);
+  }
+  GetCommandBuffer().executeCommands(buffers);
+  for (const auto& secondary : secondaries) {
+    tracked_objects_->Track(std::move(secondary->tracked_objects_));
+    secondary->Reset();
+  }
+  return true;
 }
 
 vk::CommandBuffer CommandEncoderVK::GetCommandBuffer() const {
@@ -294,6 +380,18 @@ std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
       layout, command_count);
 }
 
+std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    size_t command_count,
+    std::vector<vk::WriteDescriptorSet>& writes) {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+
+  return tracked_objects_->GetDescriptorPool().AllocateDescriptorSet(
+      layout, command_count, writes);
+}
+
 void CommandEncoderVK::PushDebugGroup(const char* label) const {
   if (!HasValidationLayers()) {
     return;
@@ -7,6 +7,7 @@
 #include <functional>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
@@ -26,6 +27,7 @@ class Texture;
 class TextureSourceVK;
 class TrackedObjectsVK;
 class FenceWaiterVK;
+class SubmissionBatchVK;
 
 class CommandEncoderFactoryVK {
  public:
@@ -33,6 +35,15 @@ class CommandEncoderFactoryVK {
 
   std::shared_ptr<CommandEncoderVK> Create();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create an encoder for a secondary command buffer that
+  ///             continues the render pass described by `inheritance_info`.
+  ///             The command buffer is allocated from the calling thread's
+  ///             command pool.
+  ///
+  std::shared_ptr<CommandEncoderVK> CreateSecondary(
+      const vk::CommandBufferInheritanceInfo& inheritance_info);
+
   void SetLabel(const std::string& label);
 
  private:
@@ -50,13 +61,33 @@ class CommandEncoderVK {
   CommandEncoderVK(std::weak_ptr<const DeviceHolder> device_holder,
                    std::shared_ptr<TrackedObjectsVK> tracked_objects,
                    const std::shared_ptr<QueueVK>& queue,
-                   std::shared_ptr<FenceWaiterVK> fence_waiter);
+                   std::shared_ptr<FenceWaiterVK> fence_waiter,
+                   std::shared_ptr<SubmissionBatchVK> submission_batch);
 
   ~CommandEncoderVK();
 
   bool IsValid() const;
 
-  bool Submit(SubmitCallback callback = {});
+  //----------------------------------------------------------------------------
+  /// @brief      Ends the command buffer and submits it to the queue.
+  ///
+  /// @param[in]  callback  Invoked with whether the command buffer was
+  ///                       submitted, once the GPU is done with it.
+  /// @param[in]  defer     Whether to leave the command buffer in the
+  ///                       submission batch of the frame, to be submitted with
+  ///                       the other ones of the frame when it is presented.
+  ///                       Otherwise, the batch is flushed first.
+  ///
+  bool Submit(SubmitCallback callback = {}, bool defer = false);
+
+  //----------------------------------------------------------------------------
+  /// @brief      End the given secondary encoders and execute them, in order,
+  ///             from this encoder's command buffer. The secondary encoders are
+  ///             invalidated and their resources are kept alive until this
+  ///             encoder's submission completes.
+  ///
+  bool ExecuteSecondary(
+      const std::vector<std::shared_ptr<CommandEncoderVK>>& secondaries);
 
   bool Track(std::shared_ptr<SharedObjectVK> object);
 
@@ -82,6 +113,12 @@ class CommandEncoderVK {
       const vk::DescriptorSetLayout& layout,
       size_t command_count);
 
+  // |DescriptorPoolVK::AllocateDescriptorSet|
+  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      size_t command_count,
+      std::vector<vk::WriteDescriptorSet>& writes);
+
  private:
   friend class ContextVK;
 
@@ -89,6 +126,7 @@ class CommandEncoderVK {
   std::shared_ptr<TrackedObjectsVK> tracked_objects_;
   std::shared_ptr<QueueVK> queue_;
   const std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  const std::shared_ptr<SubmissionBatchVK> submission_batch_;
   bool is_valid_ = true;
 
   void Reset();
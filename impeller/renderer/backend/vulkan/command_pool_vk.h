@@ -33,9 +33,12 @@ class CommandPoolVK {
 
   vk::CommandPool GetGraphicsCommandPool() const;
 
-  vk::UniqueCommandBuffer CreateGraphicsCommandBuffer();
+  vk::UniqueCommandBuffer CreateGraphicsCommandBuffer(
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
-  void CollectGraphicsCommandBuffer(vk::UniqueCommandBuffer buffer);
+  void CollectGraphicsCommandBuffer(
+      vk::UniqueCommandBuffer buffer,
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
  private:
   const std::thread::id owner_id_;
@@ -44,7 +47,10 @@ class CommandPoolVK {
   Mutex buffers_to_collect_mutex_;
   std::vector<vk::UniqueCommandBuffer> buffers_to_collect_
       IPLR_GUARDED_BY(buffers_to_collect_mutex_);
+  std::vector<vk::UniqueCommandBuffer> secondary_buffers_to_collect_
+      IPLR_GUARDED_BY(buffers_to_collect_mutex_);
   std::vector<vk::UniqueCommandBuffer> recycled_buffers_;
+  std::vector<vk::UniqueCommandBuffer> recycled_secondary_buffers_;
   bool is_valid_ = false;
 
   explicit CommandPoolVK(const ContextVK* context);
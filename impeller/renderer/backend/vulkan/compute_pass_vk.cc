@@ -33,36 +33,34 @@ void ComputePassVK::OnSetLabel(const std::string& label) {
 }
 
 static bool UpdateBindingLayouts(const Bindings& bindings,
-                                 const vk::CommandBuffer& buffer) {
-  BarrierVK barrier;
-  barrier.cmd_buffer = buffer;
-  barrier.src_access = vk::AccessFlagBits::eTransferWrite;
-  barrier.src_stage = vk::PipelineStageFlagBits::eTransfer;
-  barrier.dst_access = vk::AccessFlagBits::eShaderRead;
-  barrier.dst_stage = vk::PipelineStageFlagBits::eComputeShader;
-
-  barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
-
+                                 BarrierBatchVK& barriers) {
   for (const auto& [_, data] : bindings.sampled_images) {
-    if (!TextureVK::Cast(*data.texture.resource).SetLayout(barrier)) {
+    const auto source =
+        TextureVK::Cast(*data.texture.resource).GetTextureSource();
+    if (!source) {
       return false;
     }
+    barriers.AddTransition(*source, vk::ImageLayout::eShaderReadOnlyOptimal,
+                           vk::PipelineStageFlagBits::eComputeShader,
+                           vk::AccessFlagBits::eShaderRead);
   }
   return true;
 }
 
 static bool UpdateBindingLayouts(const ComputeCommand& command,
-                                 const vk::CommandBuffer& buffer) {
-  return UpdateBindingLayouts(command.bindings, buffer);
+                                 BarrierBatchVK& barriers) {
+  return UpdateBindingLayouts(command.bindings, barriers);
 }
 
 static bool UpdateBindingLayouts(const std::vector<ComputeCommand>& commands,
                                  const vk::CommandBuffer& buffer) {
+  BarrierBatchVK barriers;
   for (const auto& command : commands) {
-    if (!UpdateBindingLayouts(command, buffer)) {
+    if (!UpdateBindingLayouts(command, barriers)) {
       return false;
     }
   }
+  barriers.Encode(buffer);
   return true;
 }
 
@@ -26,10 +26,14 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
+#include "impeller/renderer/backend/vulkan/encoding_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/gpu_timestamp_queries_vk.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
+#include "impeller/renderer/backend/vulkan/submission_batch_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
@@ -90,6 +94,24 @@ static std::optional<QueueIndexVK> PickQueue(const vk::PhysicalDevice& device,
   return std::nullopt;
 }
 
+// Graphics and compute queues can always transfer, so the first family that
+// supports transfers is usually the graphics one. Prefer a family that only
+// transfers, which is usually backed by a copy engine that runs alongside the
+// graphics queue.
+static std::optional<QueueIndexVK> PickTransferQueue(
+    const vk::PhysicalDevice& device) {
+  const auto families = device.getQueueFamilyProperties();
+  for (size_t i = 0u; i < families.size(); i++) {
+    const auto flags = families[i].queueFlags;
+    if ((flags & vk::QueueFlagBits::eTransfer) &&
+        !(flags & vk::QueueFlagBits::eGraphics) &&
+        !(flags & vk::QueueFlagBits::eCompute)) {
+      return QueueIndexVK{.family = i, .index = 0};
+    }
+  }
+  return PickQueue(device, vk::QueueFlagBits::eTransfer);
+}
+
 std::shared_ptr<ContextVK> ContextVK::Create(Settings settings) {
   auto context = std::shared_ptr<ContextVK>(new ContextVK());
   context->Setup(std::move(settings));
@@ -111,6 +133,9 @@ uint64_t CalculateHash(void* ptr) {
 ContextVK::ContextVK() : hash_(CalculateHash(this)) {}
 
 ContextVK::~ContextVK() {
+  if (submission_batch_) {
+    submission_batch_->EndFrame();
+  }
   if (device_holder_ && device_holder_->device) {
     [[maybe_unused]] auto result = device_holder_->device->waitIdle();
   }
@@ -260,8 +285,7 @@ void ContextVK::Setup(Settings settings) {
   ///
   auto graphics_queue =
       PickQueue(device_holder->physical_device, vk::QueueFlagBits::eGraphics);
-  auto transfer_queue =
-      PickQueue(device_holder->physical_device, vk::QueueFlagBits::eTransfer);
+  auto transfer_queue = PickTransferQueue(device_holder->physical_device);
   auto compute_queue =
       PickQueue(device_holder->physical_device, vk::QueueFlagBits::eCompute);
 
@@ -270,7 +294,7 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
   if (!transfer_queue.has_value()) {
-    FML_LOG(INFO) << "Dedicated transfer queue not avialable.";
+    FML_LOG(INFO) << "Dedicated transfer queue not available.";
     transfer_queue = graphics_queue.value();
   }
   if (!compute_queue.has_value()) {
@@ -312,6 +336,13 @@ void ContextVK::Setup(Settings settings) {
   device_info.setPEnabledFeatures(&enabled_features.value());
   // Device layers are deprecated and ignored.
 
+  // Lets the fence waiter signal all submissions on one semaphore.
+  vk::PhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features;
+  if (caps->CanEnableTimelineSemaphores(device_holder->physical_device)) {
+    timeline_semaphore_features.timelineSemaphore = true;
+    device_info.setPNext(&timeline_semaphore_features);
+  }
+
   {
     auto device_result =
         device_holder->physical_device.createDeviceUnique(device_info);
@@ -353,6 +384,7 @@ void ContextVK::Setup(Settings settings) {
       new PipelineLibraryVK(device_holder,                         //
                             caps,                                  //
                             std::move(settings.cache_directory),   //
+                            std::move(settings.engine_version),    //
                             raster_message_loop_->GetTaskRunner()  //
                             ));
 
@@ -378,7 +410,8 @@ void ContextVK::Setup(Settings settings) {
   /// Create the fence waiter.
   ///
   auto fence_waiter =
-      std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(device_holder));
+      std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(
+          device_holder, caps->SupportsTimelineSemaphores()));
   if (!fence_waiter->IsValid()) {
     VALIDATION_LOG << "Could not create fence waiter.";
     return;
@@ -422,7 +455,27 @@ void ContextVK::Setup(Settings settings) {
   queues_ = std::move(queues);
   device_capabilities_ = std::move(caps);
   fence_waiter_ = std::move(fence_waiter);
+  submission_batch_ = std::make_shared<SubmissionBatchVK>(
+      queues_.graphics_queue, fence_waiter_);
   resource_manager_ = std::move(resource_manager);
+  parallel_render_pass_encoding_ =
+      settings.enable_parallel_render_pass_encoding;
+  swapchain_settings_ = settings.swapchain;
+  if (settings.enable_async_subpass_encoding) {
+    encoding_queue_ =
+        EncodingQueueVK::Create(raster_message_loop_->GetTaskRunner());
+  }
+  const auto queue_families =
+      device_holder_->physical_device.getQueueFamilyProperties();
+  const auto graphics_family = queues_.graphics_queue->GetIndex().family;
+  if (graphics_family < queue_families.size() &&
+      queue_families[graphics_family].timestampValidBits > 0 &&
+      physical_device_properties.limits.timestampPeriod > 0) {
+    gpu_tracer_ = std::make_shared<GPUTracer>();
+    timestamp_queries_ = std::make_shared<GPUTimestampQueriesVK>(
+        device_holder_, physical_device_properties.limits.timestampPeriod,
+        queue_families[graphics_family].timestampValidBits);
+  }
   device_name_ = std::string(physical_device_properties.deviceName);
   is_valid_ = true;
 
@@ -464,9 +517,11 @@ std::shared_ptr<PipelineLibrary> ContextVK::GetPipelineLibrary() const {
 
 std::shared_ptr<CommandBuffer> ContextVK::CreateCommandBuffer() const {
   return std::shared_ptr<CommandBufferVK>(
-      new CommandBufferVK(shared_from_this(),                     //
-                          CreateGraphicsCommandEncoderFactory())  //
-  );
+      new CommandBufferVK(shared_from_this(),                      //
+                          CreateGraphicsCommandEncoderFactory(),  //
+                          gpu_tracer_,                            //
+                          timestamp_queries_                      //
+                          ));
 }
 
 vk::Instance ContextVK::GetInstance() const {
@@ -483,6 +538,9 @@ ContextVK::GetConcurrentWorkerTaskRunner() const {
 }
 
 void ContextVK::Shutdown() {
+  if (encoding_queue_) {
+    encoding_queue_->Flush();
+  }
   raster_message_loop_->Terminate();
 }
 
@@ -494,6 +552,11 @@ const std::shared_ptr<const Capabilities>& ContextVK::GetCapabilities() const {
   return device_capabilities_;
 }
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextVK::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
 const std::shared_ptr<QueueVK>& ContextVK::GetGraphicsQueue() const {
   return queues_.graphics_queue;
 }
@@ -506,10 +569,19 @@ std::shared_ptr<FenceWaiterVK> ContextVK::GetFenceWaiter() const {
   return fence_waiter_;
 }
 
+const std::shared_ptr<SubmissionBatchVK>& ContextVK::GetSubmissionBatch()
+    const {
+  return submission_batch_;
+}
+
 std::shared_ptr<ResourceManagerVK> ContextVK::GetResourceManager() const {
   return resource_manager_;
 }
 
+const std::shared_ptr<EncodingQueueVK>& ContextVK::GetEncodingQueue() const {
+  return encoding_queue_;
+}
+
 std::unique_ptr<CommandEncoderFactoryVK>
 ContextVK::CreateGraphicsCommandEncoderFactory() const {
   return std::make_unique<CommandEncoderFactoryVK>(weak_from_this());
@@ -5,10 +5,12 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/formats.h"
@@ -27,7 +29,10 @@ bool HasValidationLayers();
 class CommandEncoderFactoryVK;
 class CommandEncoderVK;
 class DebugReportVK;
+class EncodingQueueVK;
 class FenceWaiterVK;
+class SubmissionBatchVK;
+class GPUTimestampQueriesVK;
 class ResourceManagerVK;
 class SurfaceContextVK;
 
@@ -35,11 +40,38 @@ class ContextVK final : public Context,
                         public BackendCast<ContextVK, Context>,
                         public std::enable_shared_from_this<ContextVK> {
  public:
+  struct SwapchainSettings {
+    /// The present mode of the swapchains of the surfaces of this context.
+    /// Swapchains fall back to FIFO, which all surfaces support, if the
+    /// surface doesn't support this mode.
+    vk::PresentModeKHR present_mode = vk::PresentModeKHR::eFifo;
+    /// The number of images requested for swapchains, clamped to the range
+    /// the surface supports. Zero requests one more than the minimum of the
+    /// surface.
+    uint32_t image_count = 0u;
+    /// How long acquiring the next drawable may wait for the presentation
+    /// engine to release an image, and for the GPU to finish the frame that
+    /// last used the synchronizer of the drawable, before the frame is
+    /// dropped.
+    fml::TimeDelta acquire_timeout = fml::TimeDelta::FromSeconds(1);
+  };
+
   struct Settings {
     PFN_vkGetInstanceProcAddr proc_address_callback = nullptr;
     std::vector<std::shared_ptr<fml::Mapping>> shader_libraries_data;
     fml::UniqueFD cache_directory;
+    /// Identifies the engine build. Pipeline caches on disk that were written
+    /// by a different build are discarded.
+    std::string engine_version;
     bool enable_validation = false;
+    /// Encode and submit offscreen (subpass) render passes on the concurrent
+    /// worker pool instead of the raster thread. Submission order still
+    /// follows the order in which the passes were recorded.
+    bool enable_async_subpass_encoding = false;
+    /// Split render passes with many commands into secondary command buffers
+    /// that are recorded in parallel on the concurrent worker pool.
+    bool enable_parallel_render_pass_encoding = false;
+    SwapchainSettings swapchain;
 
     Settings() = default;
 
@@ -80,6 +112,9 @@ class ContextVK final : public Context,
   // |Context|
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
   // |Context|
   void Shutdown() override;
 
@@ -138,8 +173,32 @@ class ContextVK final : public Context,
 
   std::shared_ptr<FenceWaiterVK> GetFenceWaiter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The command buffers of the frame being recorded waiting to be
+  ///             submitted together when it is presented.
+  ///
+  const std::shared_ptr<SubmissionBatchVK>& GetSubmissionBatch() const;
+
   std::shared_ptr<ResourceManagerVK> GetResourceManager() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The queue asynchronously submitted render passes are encoded
+  ///             on, or `nullptr` if async subpass encoding is disabled.
+  ///
+  const std::shared_ptr<EncodingQueueVK>& GetEncodingQueue() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether large render passes may be encoded into secondary
+  ///             command buffers on the concurrent worker pool.
+  ///
+  bool IsParallelRenderPassEncodingEnabled() const {
+    return parallel_render_pass_encoding_;
+  }
+
+  const SwapchainSettings& GetSwapchainSettings() const {
+    return swapchain_settings_;
+  }
+
  private:
   struct DeviceHolderImpl : public DeviceHolder {
     // |DeviceHolder|
@@ -163,10 +222,17 @@ class ContextVK final : public Context,
   QueuesVK queues_;
   std::shared_ptr<const Capabilities> device_capabilities_;
   std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::shared_ptr<SubmissionBatchVK> submission_batch_;
   std::shared_ptr<ResourceManagerVK> resource_manager_;
+  std::shared_ptr<EncodingQueueVK> encoding_queue_;
+  // Only set if the graphics queue supports timestamps.
+  std::shared_ptr<GPUTracer> gpu_tracer_;
+  std::shared_ptr<GPUTimestampQueriesVK> timestamp_queries_;
   std::string device_name_;
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
   bool sync_presentation_ = false;
+  bool parallel_render_pass_encoding_ = false;
+  SwapchainSettings swapchain_settings_;
   const uint64_t hash_;
 
   bool is_valid_ = false;
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/base/validation.h"
@@ -46,6 +47,72 @@ std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
   return AllocateDescriptorSet(layout);
 }
 
+template <class VKHandle>
+static uint64_t ToKey(VKHandle handle) {
+  return reinterpret_cast<uint64_t>(
+      static_cast<typename VKHandle::CType>(handle));
+}
+
+std::size_t DescriptorPoolVK::DescriptorSetKey::Hash::operator()(
+    const DescriptorSetKey& key) const {
+  auto hash = fml::HashCombine(key.layout);
+  for (auto resource : key.resources) {
+    fml::HashCombineSeed(hash, resource);
+  }
+  return hash;
+}
+
+std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    size_t command_count,
+    std::vector<vk::WriteDescriptorSet>& writes) {
+  DescriptorSetKey key;
+  key.layout = static_cast<VkDescriptorSetLayout>(layout);
+  key.resources.reserve(writes.size() * 5u);
+  for (const auto& write : writes) {
+    key.resources.push_back(write.dstBinding);
+    key.resources.push_back(static_cast<uint64_t>(write.descriptorType));
+    for (uint32_t i = 0; i < write.descriptorCount; i++) {
+      if (write.pBufferInfo) {
+        const auto& info = write.pBufferInfo[i];
+        key.resources.push_back(ToKey(info.buffer));
+        key.resources.push_back(info.offset);
+        key.resources.push_back(info.range);
+      }
+      if (write.pImageInfo) {
+        const auto& info = write.pImageInfo[i];
+        key.resources.push_back(ToKey(info.imageView));
+        key.resources.push_back(ToKey(info.sampler));
+        key.resources.push_back(static_cast<uint64_t>(info.imageLayout));
+      }
+    }
+  }
+
+  auto found = descriptor_sets_.find(key);
+  if (found != descriptor_sets_.end()) {
+    return found->second;
+  }
+
+  auto set = AllocateDescriptorSet(layout, command_count);
+  if (!set) {
+    return std::nullopt;
+  }
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    return std::nullopt;
+  }
+  for (auto& write : writes) {
+    write.dstSet = set.value();
+  }
+  strong_device->GetDevice().updateDescriptorSets(writes, {});
+  descriptor_sets_[std::move(key)] = set.value();
+  return set;
+}
+
+size_t DescriptorPoolVK::GetCachedDescriptorSetCount() const {
+  return descriptor_sets_.size();
+}
+
 std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
     const vk::DescriptorSetLayout& layout) {
   auto pool = GetDescriptorPool();
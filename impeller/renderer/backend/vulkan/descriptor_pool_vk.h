@@ -6,6 +6,8 @@
 
 #include <optional>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
@@ -36,13 +38,52 @@ class DescriptorPoolVK {
       const vk::DescriptorSetLayout& layout,
       size_t command_count);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gets a descriptor set of the given layout that holds the
+  ///             resources of |writes|. A set allocated from this pool earlier
+  ///             with the same layout and resources is reused, which skips both
+  ///             the allocation and the update.
+  ///
+  /// @param[in]  layout         The layout of the descriptor set.
+  /// @param[in]  command_count  The number of commands in the pass, used to
+  ///                            size the first pool.
+  /// @param      writes         The resources of the set. Their destination
+  ///                            set is filled in when a new set is updated.
+  ///
+  /// @return     The descriptor set, or std::nullopt if allocation failed.
+  ///
+  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      size_t command_count,
+      std::vector<vk::WriteDescriptorSet>& writes);
+
+  // visible for testing.
+  size_t GetCachedDescriptorSetCount() const;
+
  private:
+  struct DescriptorSetKey {
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    std::vector<uint64_t> resources;
+
+    bool operator==(const DescriptorSetKey& other) const {
+      return layout == other.layout && resources == other.resources;
+    }
+
+    struct Hash {
+      std::size_t operator()(const DescriptorSetKey& key) const;
+    };
+  };
+
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout);
 
   std::weak_ptr<const DeviceHolder> device_holder_;
   uint32_t pool_size_ = 31u;
   std::queue<vk::UniqueDescriptorPool> pools_;
+  std::unordered_map<DescriptorSetKey,
+                     vk::DescriptorSet,
+                     DescriptorSetKey::Hash>
+      descriptor_sets_;
 
   std::optional<vk::DescriptorPool> GetDescriptorPool();
 
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+vk::WriteDescriptorSet MakeBufferWrite(const vk::DescriptorBufferInfo& info) {
+  vk::WriteDescriptorSet write;
+  write.dstBinding = 0u;
+  write.descriptorCount = 1u;
+  write.descriptorType = vk::DescriptorType::eUniformBuffer;
+  write.pBufferInfo = &info;
+  return write;
+}
+
+size_t CountCalls(const std::vector<std::string>& functions,
+                  std::string_view name) {
+  return std::count(functions.begin(), functions.end(), name);
+}
+
+}  // namespace
+
+TEST(DescriptorPoolVKTest, ReusesDescriptorSetsWithIdenticalResources) {
+  auto context = CreateMockVulkanContext();
+  DescriptorPoolVK pool(context->GetDeviceHolder());
+  vk::DescriptorSetLayout layout(
+      reinterpret_cast<VkDescriptorSetLayout>(0x77777777));
+  vk::Buffer buffer(reinterpret_cast<VkBuffer>(0x12345678));
+
+  vk::DescriptorBufferInfo info(buffer, 0u, 64u);
+  std::vector<vk::WriteDescriptorSet> writes = {MakeBufferWrite(info)};
+  auto first = pool.AllocateDescriptorSet(layout, 3u, writes);
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(writes[0].dstSet, first.value());
+
+  writes = {MakeBufferWrite(info)};
+  auto second = pool.AllocateDescriptorSet(layout, 3u, writes);
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first.value(), second.value());
+
+  // Another range of the same buffer needs its own set.
+  vk::DescriptorBufferInfo other_info(buffer, 256u, 64u);
+  writes = {MakeBufferWrite(other_info)};
+  auto third = pool.AllocateDescriptorSet(layout, 3u, writes);
+  ASSERT_TRUE(third.has_value());
+  EXPECT_NE(first.value(), third.value());
+  EXPECT_EQ(pool.GetCachedDescriptorSetCount(), 2u);
+
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(CountCalls(*functions, "vkAllocateDescriptorSets"), 2u);
+  EXPECT_EQ(CountCalls(*functions, "vkUpdateDescriptorSets"), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
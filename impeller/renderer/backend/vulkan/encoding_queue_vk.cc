@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/encoding_queue_vk.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+std::shared_ptr<EncodingQueueVK> EncodingQueueVK::Create(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner) {
+  return std::shared_ptr<EncodingQueueVK>(
+      new EncodingQueueVK(std::move(worker_task_runner)));
+}
+
+EncodingQueueVK::EncodingQueueVK(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : worker_task_runner_(std::move(worker_task_runner)) {}
+
+EncodingQueueVK::~EncodingQueueVK() = default;
+
+void EncodingQueueVK::Post(fml::closure task) {
+  if (!task) {
+    return;
+  }
+  std::unique_lock lock(mutex_);
+  tasks_.emplace_back(std::move(task));
+  if (is_draining_) {
+    return;
+  }
+  is_draining_ = true;
+  lock.unlock();
+
+  worker_task_runner_->PostTask([weak_queue = weak_from_this()]() {
+    if (auto queue = weak_queue.lock()) {
+      queue->Drain();
+    }
+  });
+}
+
+void EncodingQueueVK::RunOneLocked(std::unique_lock<std::mutex>& lock) {
+  auto task = std::move(tasks_.front());
+  tasks_.pop_front();
+  is_running_task_ = true;
+  lock.unlock();
+  task();
+  lock.lock();
+  is_running_task_ = false;
+  cv_.notify_all();
+}
+
+void EncodingQueueVK::Drain() {
+  TRACE_EVENT0("impeller", "EncodingQueueVK::Drain");
+  std::unique_lock lock(mutex_);
+  while (true) {
+    // A flushing thread may have picked up a task in the meantime.
+    cv_.wait(lock, [&]() { return !is_running_task_; });
+    if (tasks_.empty()) {
+      is_draining_ = false;
+      return;
+    }
+    RunOneLocked(lock);
+  }
+}
+
+void EncodingQueueVK::Flush() {
+  TRACE_EVENT0("impeller", "EncodingQueueVK::Flush");
+  std::unique_lock lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [&]() { return !is_running_task_; });
+    if (tasks_.empty()) {
+      return;
+    }
+    RunOneLocked(lock);
+  }
+}
+
+bool EncodingQueueVK::HasPendingTasks() const {
+  std::scoped_lock lock(mutex_);
+  return is_running_task_ || !tasks_.empty();
+}
+
+}  // namespace impeller
@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Runs command buffer encoding tasks on the concurrent worker pool
+///             one at a time and in the order they were posted.
+///
+///             Image layouts are tracked on the CPU while commands are
+///             encoded, so encoding must happen in the same order the passes
+///             were recorded in. The queue lets the raster thread move on to
+///             recording the next pass while a worker encodes and submits the
+///             previous ones.
+///
+///             Submissions that do not go through the queue must call |Flush|
+///             first so that queue order always matches recording order.
+///
+class EncodingQueueVK final
+    : public std::enable_shared_from_this<EncodingQueueVK> {
+ public:
+  static std::shared_ptr<EncodingQueueVK> Create(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  ~EncodingQueueVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enqueue a task to be run after all previously posted tasks.
+  ///
+  void Post(fml::closure task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Block until all previously posted tasks have run. Tasks that
+  ///             have not been picked up by a worker yet are run on the calling
+  ///             thread.
+  ///
+  ///             Must not be called from a task posted to this queue.
+  ///
+  void Flush();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a flush would have to do any work.
+  ///
+  bool HasPendingTasks() const;
+
+ private:
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<fml::closure> tasks_;
+  bool is_draining_ = false;
+  bool is_running_task_ = false;
+
+  explicit EncodingQueueVK(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  void Drain();
+
+  void RunOneLocked(std::unique_lock<std::mutex>& lock);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EncodingQueueVK);
+};
+
+}  // namespace impeller
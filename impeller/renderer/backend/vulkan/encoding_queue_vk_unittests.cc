@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/encoding_queue_vk.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(EncodingQueueVKTest, RunsTasksInOrder) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto queue = EncodingQueueVK::Create(loop->GetTaskRunner());
+
+  std::vector<int> order;
+  for (int i = 0; i < 100; i++) {
+    queue->Post([&order, i]() { order.push_back(i); });
+  }
+  queue->Flush();
+
+  ASSERT_FALSE(queue->HasPendingTasks());
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(order[i], i);
+  }
+}
+
+TEST(EncodingQueueVKTest, FlushWaitsForRunningTask) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto queue = EncodingQueueVK::Create(loop->GetTaskRunner());
+
+  fml::AutoResetWaitableEvent started;
+  fml::AutoResetWaitableEvent release;
+  bool finished = false;
+  queue->Post([&]() {
+    started.Signal();
+    release.Wait();
+    finished = true;
+  });
+  started.Wait();
+  ASSERT_TRUE(queue->HasPendingTasks());
+  release.Signal();
+  queue->Flush();
+  ASSERT_TRUE(finished);
+}
+
+TEST(EncodingQueueVKTest, FlushRunsTasksAfterLoopTermination) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto queue = EncodingQueueVK::Create(loop->GetTaskRunner());
+  loop->Terminate();
+
+  int count = 0;
+  queue->Post([&count]() { count++; });
+  queue->Post([&count]() { count++; });
+  queue->Flush();
+  ASSERT_EQ(count, 2);
+}
+
+}  // namespace testing
+}  // namespace impeller
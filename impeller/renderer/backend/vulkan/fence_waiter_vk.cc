@@ -6,10 +6,14 @@
 
 #include <algorithm>
 #include <chrono>
+#include <optional>
 
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
+#include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
+#include "vulkan/vulkan_to_string.hpp"
 
 namespace impeller {
 
@@ -44,8 +48,26 @@ class WaitSetEntry {
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(WaitSetEntry);
 };
 
-FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder)
+FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                             bool use_timeline_semaphore)
     : device_holder_(std::move(device_holder)) {
+  if (auto strong_device = device_holder_.lock();
+      strong_device && use_timeline_semaphore) {
+    vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfo>
+        semaphore_chain;
+    semaphore_chain.get<vk::SemaphoreTypeCreateInfo>().semaphoreType =
+        vk::SemaphoreType::eTimeline;
+    semaphore_chain.get<vk::SemaphoreTypeCreateInfo>().initialValue = 0u;
+    auto [result, semaphore] = strong_device->GetDevice().createSemaphoreUnique(
+        semaphore_chain.get());
+    if (result == vk::Result::eSuccess) {
+      timeline_semaphore_ = std::move(semaphore);
+    } else {
+      FML_LOG(ERROR) << "Could not create timeline semaphore, waiting for "
+                        "fences instead: "
+                     << vk::to_string(result);
+    }
+  }
   waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
   is_valid_ = true;
 }
@@ -55,6 +77,11 @@ FenceWaiterVK::~FenceWaiterVK() {
   if (waiter_thread_) {
     waiter_thread_->join();
   }
+  // Like the callbacks of the fences left in the wait set, the ones of the
+  // submissions still pending are invoked as the waiter is collected.
+  for (const auto& submission : pending_submissions_) {
+    submission.callback();
+  }
 }
 
 bool FenceWaiterVK::IsValid() const {
@@ -75,6 +102,89 @@ bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
   return true;
 }
 
+bool FenceWaiterVK::UsesTimelineSemaphore() const {
+  return !!timeline_semaphore_;
+}
+
+bool FenceWaiterVK::Submit(const QueueVK& queue,
+                           const vk::SubmitInfo& submit_info,
+                           const fml::closure& callback) {
+  TRACE_EVENT0("impeller", "FenceWaiterVK::Submit");
+  if (!IsValid() || !callback) {
+    return false;
+  }
+  if (!timeline_semaphore_) {
+    return SubmitWithFence(queue, submit_info, callback);
+  }
+
+  std::scoped_lock submit_lock(timeline_submit_mutex_);
+  if (!timeline_queue_) {
+    timeline_queue_ = &queue;
+  }
+  if (timeline_queue_ != &queue) {
+    return SubmitWithFence(queue, submit_info, callback);
+  }
+
+  const uint64_t value = last_timeline_value_ + 1u;
+
+  std::vector<vk::Semaphore> signal_semaphores(
+      submit_info.pSignalSemaphores,
+      submit_info.pSignalSemaphores + submit_info.signalSemaphoreCount);
+  signal_semaphores.push_back(*timeline_semaphore_);
+  // The values of binary semaphores are ignored.
+  std::vector<uint64_t> signal_values(signal_semaphores.size(), 0u);
+  signal_values.back() = value;
+
+  vk::TimelineSemaphoreSubmitInfo timeline_info;
+  timeline_info.pNext = submit_info.pNext;
+  timeline_info.setSignalSemaphoreValues(signal_values);
+
+  vk::SubmitInfo timeline_submit_info = submit_info;
+  timeline_submit_info.pNext = &timeline_info;
+  timeline_submit_info.setSignalSemaphores(signal_semaphores);
+
+  const auto result = queue.Submit(timeline_submit_info, {});
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(result);
+    return false;
+  }
+  last_timeline_value_ = value;
+
+  bool was_idle = false;
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    was_idle = pending_submissions_.empty() && wait_set_.empty();
+    pending_submissions_.push_back({value, callback});
+  }
+  // Otherwise the waiter thread is already waiting for an earlier value, and
+  // picks this one up after.
+  if (was_idle) {
+    wait_set_cv_.notify_one();
+  }
+  return true;
+}
+
+bool FenceWaiterVK::SubmitWithFence(const QueueVK& queue,
+                                    const vk::SubmitInfo& submit_info,
+                                    const fml::closure& callback) {
+  auto strong_device = device_holder_.lock();
+  if (!strong_device) {
+    VALIDATION_LOG << "Device lost.";
+    return false;
+  }
+  auto [fence_result, fence] = strong_device->GetDevice().createFenceUnique({});
+  if (fence_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to create fence: " << vk::to_string(fence_result);
+    return false;
+  }
+  const auto result = queue.Submit(submit_info, *fence);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(result);
+    return false;
+  }
+  return AddFence(std::move(fence), callback);
+}
+
 static std::vector<vk::Fence> GetFencesForWaitSet(const WaitSet& set) {
   std::vector<vk::Fence> fences;
   for (const auto& entry : set) {
@@ -94,14 +204,24 @@ void FenceWaiterVK::Main() {
   while (true) {
     std::unique_lock lock(wait_set_mutex_);
 
-    // If there are no fences to wait on, wait on the condition variable.
-    wait_set_cv_.wait(lock, [&]() { return !wait_set_.empty() || terminate_; });
+    // If there are no fences or submissions to wait on, wait on the condition
+    // variable.
+    wait_set_cv_.wait(lock, [&]() {
+      return !wait_set_.empty() || !pending_submissions_.empty() || terminate_;
+    });
 
     // We don't want to check on fence status or collect wait set entries in the
     // critical section. Copy the array of entries and immediately unlock the
     // mutex.
     WaitSet wait_set = wait_set_;
 
+    // Waiting for the oldest pending submission is enough to make progress.
+    // The ones after it that are done by then are collected along with it.
+    std::optional<uint64_t> timeline_wait_value;
+    if (!pending_submissions_.empty()) {
+      timeline_wait_value = pending_submissions_.front().timeline_value;
+    }
+
     const auto terminate = terminate_;
 
     lock.unlock();
@@ -118,27 +238,49 @@ void FenceWaiterVK::Main() {
 
     const auto& device = device_holder->GetDevice();
 
-    // Wait for one or more fences to be signaled. Any additional fences added
-    // to the waiter will be serviced in the next pass. If a fence that is going
-    // to be signaled at an abnormally long deadline is the only one in the set,
-    // a timeout will bail out the wait.
-    auto fences = GetFencesForWaitSet(wait_set);
-    if (fences.empty()) {
-      continue;
-    }
+    vk::Result result = vk::Result::eSuccess;
+    if (timeline_wait_value.has_value()) {
+      vk::SemaphoreWaitInfo wait_info;
+      wait_info.setSemaphores(*timeline_semaphore_);
+      wait_info.setValues(timeline_wait_value.value());
+      result = device.waitSemaphoresKHR(
+          wait_info,                               // wait info
+          std::chrono::nanoseconds{100ms}.count()  // timeout (ns)
+      );
+    } else {
+      // Wait for one or more fences to be signaled. Any additional fences
+      // added to the waiter will be serviced in the next pass. If a fence that
+      // is going to be signaled at an abnormally long deadline is the only one
+      // in the set, a timeout will bail out the wait.
+      auto fences = GetFencesForWaitSet(wait_set);
+      if (fences.empty()) {
+        continue;
+      }
 
-    auto result = device.waitForFences(
-        fences.size(),                           // fences count
-        fences.data(),                           // fences
-        false,                                   // wait for all
-        std::chrono::nanoseconds{100ms}.count()  // timeout (ns)
-    );
+      result = device.waitForFences(
+          fences.size(),                           // fences count
+          fences.data(),                           // fences
+          false,                                   // wait for all
+          std::chrono::nanoseconds{100ms}.count()  // timeout (ns)
+      );
+    }
     if (!(result == vk::Result::eSuccess || result == vk::Result::eTimeout)) {
       VALIDATION_LOG << "Fence waiter encountered an unexpected error. Tearing "
                         "down the waiter thread.";
       break;
     }
 
+    uint64_t completed_timeline_value = 0u;
+    if (timeline_wait_value.has_value()) {
+      auto counter = device.getSemaphoreCounterValueKHR(*timeline_semaphore_);
+      if (counter.result != vk::Result::eSuccess) {
+        VALIDATION_LOG << "Could not read the timeline semaphore. Tearing "
+                          "down the waiter thread.";
+        break;
+      }
+      completed_timeline_value = counter.value;
+    }
+
     // One or more fences have been signaled. Find out which ones and update
     // their signaled statuses.
     {
@@ -149,10 +291,12 @@ void FenceWaiterVK::Main() {
       wait_set.clear();
     }
 
-    // Quickly acquire the wait set lock and erase signaled entries. Make sure
-    // the mutex is unlocked before calling the destructors of the erased
-    // entries. These might touch allocators.
+    // Quickly acquire the wait set lock and erase signaled entries and the
+    // completed submissions. Make sure the mutex is unlocked before calling
+    // the destructors of the erased entries and the callbacks. These might
+    // touch allocators.
     WaitSet erased_entries;
+    std::vector<fml::closure> completed_callbacks;
     {
       static auto is_signalled = [](const auto& entry) {
         return entry->IsSignalled();
@@ -163,12 +307,26 @@ void FenceWaiterVK::Main() {
       wait_set_.erase(
           std::remove_if(wait_set_.begin(), wait_set_.end(), is_signalled),
           wait_set_.end());
+      while (!pending_submissions_.empty() &&
+             pending_submissions_.front().timeline_value <=
+                 completed_timeline_value) {
+        completed_callbacks.push_back(
+            std::move(pending_submissions_.front().callback));
+        pending_submissions_.pop_front();
+      }
     }
 
     {
       TRACE_EVENT0("impeller", "ClearSignaledFences");
+      // Hand the resources released by the callbacks to the resource manager
+      // together.
+      ResourceManagerVK::ScopedReclaimBatch reclaim_batch;
       // Erase the erased entries which will invoke callbacks.
       erased_entries.clear();  // Bit redundant because of scope but hey.
+      // Submissions complete in the order they were made.
+      for (const auto& callback : completed_callbacks) {
+        callback();
+      }
     }
   }
 }
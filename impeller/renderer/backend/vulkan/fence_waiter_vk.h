@@ -5,6 +5,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -19,10 +20,24 @@
 namespace impeller {
 
 class ContextVK;
+class QueueVK;
 class WaitSetEntry;
 
 using WaitSet = std::vector<std::shared_ptr<WaitSetEntry>>;
 
+//------------------------------------------------------------------------------
+/// @brief      Invokes callbacks on a background thread once the GPU is done
+///             with the submissions they were added for.
+///
+///             Where timeline semaphores are supported, each submission made
+///             via `Submit` signals the next value of a single timeline
+///             semaphore instead of a fence of its own. The waiter thread
+///             waits for the oldest value still pending and then invokes the
+///             callbacks of all the submissions that are done, in the order
+///             they were made. There are no fences to create and destroy per
+///             submission, and the thread is only woken when it has nothing
+///             to wait for.
+///
 class FenceWaiterVK {
  public:
   ~FenceWaiterVK();
@@ -33,9 +48,33 @@ class FenceWaiterVK {
 
   bool AddFence(vk::UniqueFence fence, const fml::closure& callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Submits `submit_info` to `queue` and invokes `callback` once
+  ///             the GPU is done with it.
+  ///
+  ///             Submissions signal the timeline semaphore of the waiter if
+  ///             there is one and they are all made to the same queue, whose
+  ///             order keeps the values signaled increasing. Submissions to
+  ///             other queues fall back to a fence, which is only checked
+  ///             when waits for the timeline return while both are pending.
+  ///
+  /// @return     Whether the submission was made. The callback is not invoked
+  ///             otherwise.
+  ///
+  bool Submit(const QueueVK& queue,
+              const vk::SubmitInfo& submit_info,
+              const fml::closure& callback);
+
+  bool UsesTimelineSemaphore() const;
+
  private:
   friend class ContextVK;
 
+  struct PendingSubmission {
+    uint64_t timeline_value = 0u;
+    fml::closure callback;
+  };
+
   std::weak_ptr<DeviceHolder> device_holder_;
   std::unique_ptr<std::thread> waiter_thread_;
   std::mutex wait_set_mutex_;
@@ -44,10 +83,24 @@ class FenceWaiterVK {
   bool terminate_ = false;
   bool is_valid_ = false;
 
-  explicit FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder);
+  vk::UniqueSemaphore timeline_semaphore_;
+  // Held while a submission picks its value and is made, so that the values
+  // are signaled in increasing order.
+  std::mutex timeline_submit_mutex_;
+  uint64_t last_timeline_value_ = 0u;
+  const QueueVK* timeline_queue_ = nullptr;
+  // Ordered by value. Guarded by `wait_set_mutex_`.
+  std::deque<PendingSubmission> pending_submissions_;
+
+  FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                bool use_timeline_semaphore);
 
   void Main();
 
+  bool SubmitWithFence(const QueueVK& queue,
+                       const vk::SubmitInfo& submit_info,
+                       const fml::closure& callback);
+
   FML_DISALLOW_COPY_AND_ASSIGN(FenceWaiterVK);
 };
 
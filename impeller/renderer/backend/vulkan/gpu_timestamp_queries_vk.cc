@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/gpu_timestamp_queries_vk.h"
+
+#include <utility>
+
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+GPUTimestampQueriesVK::GPUTimestampQueriesVK(
+    std::weak_ptr<const DeviceHolder> device_holder,
+    float timestamp_period,
+    uint32_t timestamp_valid_bits)
+    : device_holder_(std::move(device_holder)),
+      nanoseconds_per_tick_(timestamp_period),
+      timestamp_mask_(timestamp_valid_bits >= 64
+                          ? ~0ull
+                          : (1ull << timestamp_valid_bits) - 1) {}
+
+GPUTimestampQueriesVK::~GPUTimestampQueriesVK() {
+  if (!pool_) {
+    return;
+  }
+  if (auto device_holder = device_holder_.lock()) {
+    device_holder->GetDevice().destroyQueryPool(pool_);
+  }
+}
+
+std::optional<uint32_t> GPUTimestampQueriesVK::RecordStart(
+    vk::CommandBuffer buffer) {
+  vk::QueryPool pool;
+  {
+    std::scoped_lock lock(pool_mutex_);
+    if (!pool_ && !pool_failed_) {
+      auto device_holder = device_holder_.lock();
+      if (!device_holder) {
+        return std::nullopt;
+      }
+      vk::QueryPoolCreateInfo info;
+      info.queryType = vk::QueryType::eTimestamp;
+      info.queryCount = kQueryPairCount * 2;
+      auto [result, created] =
+          device_holder->GetDevice().createQueryPool(info);
+      if (result != vk::Result::eSuccess) {
+        VALIDATION_LOG << "Could not create the timestamp query pool: "
+                       << vk::to_string(result);
+        pool_failed_ = true;
+      } else {
+        pool_ = created;
+      }
+    }
+    pool = pool_;
+  }
+  if (!pool) {
+    return std::nullopt;
+  }
+  const uint32_t query = (next_pair_++ % kQueryPairCount) * 2;
+  buffer.resetQueryPool(pool, query, 2);
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, pool, query);
+  return query;
+}
+
+void GPUTimestampQueriesVK::RecordEnd(vk::CommandBuffer buffer,
+                                      uint32_t query) const {
+  // The pool is never destroyed while queries are handed out.
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, pool_,
+                        query + 1);
+}
+
+std::optional<fml::TimeDelta> GPUTimestampQueriesVK::GetDuration(
+    uint32_t query) const {
+  auto device_holder = device_holder_.lock();
+  if (!device_holder || !pool_) {
+    return std::nullopt;
+  }
+  uint64_t timestamps[2] = {};
+  auto result = device_holder->GetDevice().getQueryPoolResults(
+      pool_, query, 2, sizeof(timestamps), timestamps, sizeof(uint64_t),
+      vk::QueryResultFlagBits::e64);
+  if (result != vk::Result::eSuccess) {
+    return std::nullopt;
+  }
+  const uint64_t ticks = (timestamps[1] - timestamps[0]) & timestamp_mask_;
+  return fml::TimeDelta::FromNanoseconds(
+      static_cast<int64_t>(ticks * nanoseconds_per_tick_));
+}
+
+}  // namespace impeller
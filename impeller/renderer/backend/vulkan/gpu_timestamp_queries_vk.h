@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Measures the GPU execution time of command buffers with a pair
+///             of timestamps written at the top and the bottom of the pipe.
+///
+///             The query pool is created the first time a command buffer is
+///             measured. Query pairs are handed out round robin, so at most
+///             `kQueryPairCount` measured command buffers may be in flight.
+///
+class GPUTimestampQueriesVK {
+ public:
+  static constexpr uint32_t kQueryPairCount = 128;
+
+  GPUTimestampQueriesVK(std::weak_ptr<const DeviceHolder> device_holder,
+                        float timestamp_period,
+                        uint32_t timestamp_valid_bits);
+
+  ~GPUTimestampQueriesVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resets a pair of queries and writes the start timestamp.
+  ///             Must be recorded before any render pass of the buffer.
+  ///
+  /// @return     The first query of the pair, or nullopt if the pool could
+  ///             not be created.
+  ///
+  std::optional<uint32_t> RecordStart(vk::CommandBuffer buffer);
+
+  /// Writes the end timestamp. Must be recorded after all the render passes
+  /// of the buffer.
+  void RecordEnd(vk::CommandBuffer buffer, uint32_t query) const;
+
+  /// The time between the two timestamps of the pair. Must only be called
+  /// after the command buffer has completed.
+  std::optional<fml::TimeDelta> GetDuration(uint32_t query) const;
+
+ private:
+  const std::weak_ptr<const DeviceHolder> device_holder_;
+  const double nanoseconds_per_tick_;
+  const uint64_t timestamp_mask_;
+  std::mutex pool_mutex_;
+  vk::QueryPool pool_;
+  bool pool_failed_ = false;
+  std::atomic<uint32_t> next_pair_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTimestampQueriesVK);
+};
+
+}  // namespace impeller
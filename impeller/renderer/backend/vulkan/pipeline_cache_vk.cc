@@ -6,9 +6,12 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
 
+#include <cstring>
+#include <functional>
 #include <sstream>
 
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 
 namespace impeller {
@@ -16,25 +19,85 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
+PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
+
+PipelineCacheHeaderVK::PipelineCacheHeaderVK(
+    const vk::PhysicalDeviceProperties& props,
+    const std::string& engine_version,
+    uint64_t p_data_length)
+    : vendor_id(props.vendorID),
+      device_id(props.deviceID),
+      driver_version(props.driverVersion),
+      api_version(props.apiVersion),
+      engine_version_hash(std::hash<std::string>{}(engine_version)),
+      data_length(p_data_length) {
+  std::memcpy(uuid, props.pipelineCacheUUID.data(), VK_UUID_SIZE);
+}
+
+bool PipelineCacheHeaderVK::IsCompatibleWith(
+    const PipelineCacheHeaderVK& current) const {
+  return magic == current.magic &&                              //
+         abi_version == current.abi_version &&                  //
+         vendor_id == current.vendor_id &&                      //
+         device_id == current.device_id &&                      //
+         driver_version == current.driver_version &&            //
+         api_version == current.api_version &&                  //
+         engine_version_hash == current.engine_version_hash &&  //
+         std::memcmp(uuid, current.uuid, VK_UUID_SIZE) == 0     //
+      ;
+}
+
 static bool VerifyExistingCache(const fml::Mapping& mapping,
-                                const CapabilitiesVK& caps) {
+                                const CapabilitiesVK& caps,
+                                const std::string& engine_version) {
+  if (mapping.GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return false;
+  }
+  PipelineCacheHeaderVK header;
+  std::memcpy(&header, mapping.GetMapping(), sizeof(header));
+  const PipelineCacheHeaderVK current(caps.GetPhysicalDeviceProperties(),
+                                      engine_version, 0u);
+  if (!header.IsCompatibleWith(current)) {
+    FML_LOG(INFO) << "Pipeline cache on disk was written by a different "
+                     "driver, device or engine version. Discarding it.";
+    return false;
+  }
+  if (header.data_length != mapping.GetSize() - sizeof(header)) {
+    FML_LOG(INFO) << "Pipeline cache on disk was truncated. Discarding it.";
+    return false;
+  }
   return true;
 }
 
 static std::shared_ptr<fml::Mapping> DecorateCacheWithMetadata(
-    std::shared_ptr<fml::Mapping> data) {
-  return data;
+    std::shared_ptr<fml::Mapping> data,
+    const CapabilitiesVK& caps,
+    const std::string& engine_version) {
+  const PipelineCacheHeaderVK header(caps.GetPhysicalDeviceProperties(),
+                                     engine_version, data->GetSize());
+  auto decorated = std::make_shared<std::vector<uint8_t>>(sizeof(header) +
+                                                          data->GetSize());
+  std::memcpy(decorated->data(), &header, sizeof(header));
+  std::memcpy(decorated->data() + sizeof(header), data->GetMapping(),
+              data->GetSize());
+  return std::make_shared<fml::NonOwnedMapping>(
+      decorated->data(), decorated->size(), [decorated](auto, auto) {});
 }
 
 static std::unique_ptr<fml::Mapping> RemoveMetadataFromCache(
     std::unique_ptr<fml::Mapping> data) {
-  return data;
+  std::shared_ptr<fml::Mapping> shared_data = std::move(data);
+  return std::make_unique<fml::NonOwnedMapping>(
+      shared_data->GetMapping() + sizeof(PipelineCacheHeaderVK),
+      shared_data->GetSize() - sizeof(PipelineCacheHeaderVK),
+      [shared_data](auto, auto) {});
 }
 
 static std::unique_ptr<fml::Mapping> OpenCacheFile(
     const fml::UniqueFD& base_directory,
     const std::string& cache_file_name,
-    const CapabilitiesVK& caps) {
+    const CapabilitiesVK& caps,
+    const std::string& engine_version) {
   if (!base_directory.is_valid()) {
     return nullptr;
   }
@@ -43,7 +106,7 @@ static std::unique_ptr<fml::Mapping> OpenCacheFile(
   if (!mapping) {
     return nullptr;
   }
-  if (!VerifyExistingCache(*mapping, caps)) {
+  if (!VerifyExistingCache(*mapping, caps, engine_version)) {
     return nullptr;
   }
   mapping = RemoveMetadataFromCache(std::move(mapping));
@@ -53,20 +116,43 @@ static std::unique_ptr<fml::Mapping> OpenCacheFile(
   return mapping;
 }
 
-PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
-                                 std::shared_ptr<DeviceHolder> device_holder,
-                                 fml::UniqueFD cache_directory)
+PipelineCacheVK::PipelineCacheVK(
+    std::shared_ptr<const Capabilities> caps,
+    std::shared_ptr<DeviceHolder> device_holder,
+    fml::UniqueFD cache_directory,
+    std::string engine_version,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner)
     : caps_(std::move(caps)),
       device_holder_(device_holder),
-      cache_directory_(std::move(cache_directory)) {
+      cache_directory_(std::move(cache_directory)),
+      engine_version_(std::move(engine_version)) {
   if (!caps_ || !device_holder->GetDevice()) {
+    cache_ready_.Signal();
     return;
   }
 
+  // If the cache cannot be created, pipelines are still created without one.
+  is_valid_ = true;
+
+  if (!worker_task_runner) {
+    LoadCache(device_holder->GetDevice());
+    return;
+  }
+
+  // Mapping the file and having the driver parse a large cache can take a
+  // while. Do it off the thread setting up the context. Any pipeline creation
+  // task posted after this one waits for the load to finish.
+  worker_task_runner->PostTask([this, device = device_holder->GetDevice()]() {
+    LoadCache(device);
+  });
+}
+
+void PipelineCacheVK::LoadCache(const vk::Device& device) {
+  TRACE_EVENT0("impeller", "PipelineCacheVK::LoadCache");
   const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
 
-  auto existing_cache_data =
-      OpenCacheFile(cache_directory_, kPipelineCacheFileName, vk_caps);
+  auto existing_cache_data = OpenCacheFile(
+      cache_directory_, kPipelineCacheFileName, vk_caps, engine_version_);
 
   vk::PipelineCacheCreateInfo cache_info;
   if (existing_cache_data) {
@@ -74,8 +160,7 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
     cache_info.pInitialData = existing_cache_data->GetMapping();
   }
 
-  auto [result, existing_cache] =
-      device_holder->GetDevice().createPipelineCacheUnique(cache_info);
+  auto [result, existing_cache] = device.createPipelineCacheUnique(cache_info);
 
   if (result == vk::Result::eSuccess) {
     cache_ = std::move(existing_cache);
@@ -87,8 +172,7 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
                   << vk::to_string(result) << ". Starting with a fresh cache.";
     cache_info.pInitialData = nullptr;
     cache_info.initialDataSize = 0u;
-    auto [result2, new_cache] =
-        device_holder->GetDevice().createPipelineCacheUnique(cache_info);
+    auto [result2, new_cache] = device.createPipelineCacheUnique(cache_info);
     if (result2 == vk::Result::eSuccess) {
       cache_ = std::move(new_cache);
     } else {
@@ -97,10 +181,17 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
     }
   }
 
-  is_valid_ = !!cache_;
+  cache_ready_.Signal();
+}
+
+const vk::UniquePipelineCache& PipelineCacheVK::GetCache() const {
+  cache_ready_.Wait();
+  return cache_;
 }
 
 PipelineCacheVK::~PipelineCacheVK() {
+  // The load task refers to this object.
+  cache_ready_.Wait();
   std::shared_ptr<DeviceHolder> device_holder = device_holder_.lock();
   if (device_holder) {
     cache_.reset();
@@ -121,7 +212,8 @@ vk::UniquePipeline PipelineCacheVK::CreatePipeline(
   }
 
   auto [result, pipeline] =
-      strong_device->GetDevice().createGraphicsPipelineUnique(*cache_, info);
+      strong_device->GetDevice().createGraphicsPipelineUnique(GetCache().get(),
+                                                              info);
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create graphics pipeline: "
                    << vk::to_string(result);
@@ -137,7 +229,8 @@ vk::UniquePipeline PipelineCacheVK::CreatePipeline(
   }
 
   auto [result, pipeline] =
-      strong_device->GetDevice().createComputePipelineUnique(*cache_, info);
+      strong_device->GetDevice().createComputePipelineUnique(GetCache().get(),
+                                                             info);
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create compute pipeline: "
                    << vk::to_string(result);
@@ -151,11 +244,11 @@ std::shared_ptr<fml::Mapping> PipelineCacheVK::CopyPipelineCacheData() const {
     return nullptr;
   }
 
-  if (!IsValid()) {
+  if (!IsValid() || !GetCache()) {
     return nullptr;
   }
   auto [result, data] =
-      strong_device->GetDevice().getPipelineCacheData(*cache_);
+      strong_device->GetDevice().getPipelineCacheData(*GetCache());
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not get pipeline cache data to persist.";
     return nullptr;
@@ -175,7 +268,9 @@ void PipelineCacheVK::PersistCacheToDisk() const {
     VALIDATION_LOG << "Could not copy pipeline cache data.";
     return;
   }
-  data = DecorateCacheWithMetadata(std::move(data));
+  data = DecorateCacheWithMetadata(std::move(data),
+                                   CapabilitiesVK::Cast(*caps_),
+                                   engine_version_);
   if (!data) {
     VALIDATION_LOG
         << "Could not decorate pipeline cache with additional metadata.";
@@ -4,22 +4,97 @@
 
 #pragma once
 
+#include <string>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      The header prepended to the pipeline cache data persisted to
+///             disk.
+///
+///             The driver performs its own compatibility checks on the data
+///             but those are not trusted. Caches written by a different
+///             driver, device or engine build are discarded before they
+///             reach the driver.
+///
+struct PipelineCacheHeaderVK {
+  // sizeof(PipelineCacheHeaderVK) must be stable across platforms. Only use
+  // fixed size fields and keep them naturally aligned.
+
+  //----------------------------------------------------------------------------
+  /// Identifies the file as an Impeller pipeline cache.
+  ///
+  uint32_t magic = kMagic;
+  //----------------------------------------------------------------------------
+  /// Bumped whenever the layout of this header changes.
+  ///
+  uint32_t abi_version = kABIVersion;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint32_t driver_version = 0u;
+  uint32_t api_version = 0u;
+  uint8_t uuid[VK_UUID_SIZE] = {};
+  //----------------------------------------------------------------------------
+  /// A hash of the engine version that wrote the cache.
+  ///
+  uint64_t engine_version_hash = 0u;
+  //----------------------------------------------------------------------------
+  /// The size of the driver data that follows the header.
+  ///
+  uint64_t data_length = 0u;
+
+  static constexpr uint32_t kMagic = 0x43504d49u;  // "IMPC"
+  static constexpr uint32_t kABIVersion = 1u;
+
+  PipelineCacheHeaderVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a header describing cache data of the given length
+  ///             produced by the device with the given properties.
+  ///
+  PipelineCacheHeaderVK(const vk::PhysicalDeviceProperties& props,
+                        const std::string& engine_version,
+                        uint64_t data_length);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether cache data described by this header (read from disk)
+  ///             may be handed to the device described by `current`. The
+  ///             data lengths are not compared.
+  ///
+  bool IsCompatibleWith(const PipelineCacheHeaderVK& current) const;
+};
+
 class PipelineCacheVK {
  public:
+  //----------------------------------------------------------------------------
+  /// The number of surface frames after which the cache is written to disk.
+  /// By then the pipelines needed to render the first screens of the
+  /// application have usually been created.
+  ///
+  static constexpr size_t kPersistAfterFrameCount = 50u;
+
   // The [device] is passed in directly so that it can be used in the
   // constructor directly. The [device_holder] isn't guaranteed to be valid
   // at the time of executing `PipelineCacheVK` because of how `ContextVK` does
   // initialization.
-  explicit PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
-                           std::shared_ptr<DeviceHolder> device_holder,
-                           fml::UniqueFD cache_directory);
+  //
+  // If a [worker_task_runner] is given, the existing cache is read from disk
+  // and handed to the driver on that runner. Pipeline creation waits for the
+  // load to finish.
+  explicit PipelineCacheVK(
+      std::shared_ptr<const Capabilities> caps,
+      std::shared_ptr<DeviceHolder> device_holder,
+      fml::UniqueFD cache_directory,
+      std::string engine_version = "",
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner =
+          nullptr);
 
   ~PipelineCacheVK();
 
@@ -37,9 +112,16 @@ class PipelineCacheVK {
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolder> device_holder_;
   const fml::UniqueFD cache_directory_;
+  const std::string engine_version_;
+  // Written once by the load task before |cache_ready_| is signaled.
   vk::UniquePipelineCache cache_;
+  mutable fml::ManualResetWaitableEvent cache_ready_;
   bool is_valid_ = false;
 
+  void LoadCache(const vk::Device& device);
+
+  const vk::UniquePipelineCache& GetCache() const;
+
   std::shared_ptr<fml::Mapping> CopyPipelineCacheData() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineCacheVK);
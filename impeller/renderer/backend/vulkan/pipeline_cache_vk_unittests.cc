@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstddef>
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+static vk::PhysicalDeviceProperties CreateTestDeviceProperties() {
+  vk::PhysicalDeviceProperties props;
+  props.vendorID = 0x13b5;
+  props.deviceID = 42u;
+  props.driverVersion = 7u;
+  props.apiVersion = VK_API_VERSION_1_1;
+  for (size_t i = 0; i < VK_UUID_SIZE; i++) {
+    props.pipelineCacheUUID[i] = static_cast<uint8_t>(i);
+  }
+  return props;
+}
+
+TEST(PipelineCacheVKTest, HeaderHasStableLayout) {
+  // The header is written to disk verbatim.
+  ASSERT_EQ(sizeof(PipelineCacheHeaderVK), 56u);
+  ASSERT_EQ(offsetof(PipelineCacheHeaderVK, uuid), 24u);
+  ASSERT_EQ(offsetof(PipelineCacheHeaderVK, data_length), 48u);
+}
+
+TEST(PipelineCacheVKTest, HeaderIsCompatibleWithSameDevice) {
+  const auto props = CreateTestDeviceProperties();
+  PipelineCacheHeaderVK on_disk(props, "1.0.0", 1024u);
+  PipelineCacheHeaderVK current(props, "1.0.0", 0u);
+  ASSERT_EQ(on_disk.magic, PipelineCacheHeaderVK::kMagic);
+  ASSERT_EQ(on_disk.data_length, 1024u);
+  ASSERT_TRUE(on_disk.IsCompatibleWith(current));
+}
+
+TEST(PipelineCacheVKTest, HeaderRejectsDifferentDriverOrEngine) {
+  const auto props = CreateTestDeviceProperties();
+  PipelineCacheHeaderVK current(props, "1.0.0", 0u);
+
+  ASSERT_FALSE(PipelineCacheHeaderVK(props, "1.0.1", 0u)  //
+                   .IsCompatibleWith(current));
+
+  auto other_driver = props;
+  other_driver.driverVersion++;
+  ASSERT_FALSE(PipelineCacheHeaderVK(other_driver, "1.0.0", 0u)
+                   .IsCompatibleWith(current));
+
+  auto other_uuid = props;
+  other_uuid.pipelineCacheUUID[VK_UUID_SIZE - 1]++;
+  ASSERT_FALSE(PipelineCacheHeaderVK(other_uuid, "1.0.0", 0u)
+                   .IsCompatibleWith(current));
+
+  PipelineCacheHeaderVK corrupt(props, "1.0.0", 0u);
+  corrupt.magic = 0u;
+  ASSERT_FALSE(corrupt.IsCompatibleWith(current));
+
+  PipelineCacheHeaderVK old_abi(props, "1.0.0", 0u);
+  old_abi.abi_version = PipelineCacheHeaderVK::kABIVersion - 1u;
+  ASSERT_FALSE(old_abi.IsCompatibleWith(current));
+}
+
+TEST(PipelineCacheVKTest, CacheIsLoadedBeforePipelinesAreCreated) {
+  auto context = CreateMockVulkanContext();
+  PipelineDescriptor pipeline_desc;
+  pipeline_desc.SetVertexDescriptor(std::make_shared<VertexDescriptor>());
+  auto pipeline =
+      context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  ASSERT_TRUE(pipeline);
+
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  auto cache_created = std::find(functions->begin(), functions->end(),
+                                 "vkCreatePipelineCache");
+  auto pipeline_created = std::find(functions->begin(), functions->end(),
+                                    "vkCreateGraphicsPipelines");
+  ASSERT_NE(cache_created, functions->end());
+  ASSERT_NE(pipeline_created, functions->end());
+  ASSERT_LT(cache_created, pipeline_created);
+}
+
+}  // namespace testing
+}  // namespace impeller
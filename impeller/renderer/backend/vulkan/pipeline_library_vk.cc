@@ -25,11 +25,14 @@ PipelineLibraryVK::PipelineLibraryVK(
     const std::shared_ptr<DeviceHolder>& device_holder,
     std::shared_ptr<const Capabilities> caps,
     fml::UniqueFD cache_directory,
+    std::string engine_version,
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
     : device_holder_(device_holder),
       pso_cache_(std::make_shared<PipelineCacheVK>(std::move(caps),
                                                    device_holder,
-                                                   std::move(cache_directory))),
+                                                   std::move(cache_directory),
+                                                   std::move(engine_version),
+                                                   worker_task_runner)),
       worker_task_runner_(std::move(worker_task_runner)) {
   FML_DCHECK(worker_task_runner_);
   if (!pso_cache_->IsValid() || !worker_task_runner_) {
@@ -269,6 +272,22 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
   //----------------------------------------------------------------------------
   /// Shader Stages
   ///
+  // All stages share the specialization constants of the pipeline. Constants
+  // a stage doesn't declare are ignored by it.
+  const auto& constants = desc.GetSpecializationConstants();
+  std::vector<vk::SpecializationMapEntry> specialization_map_entries;
+  for (size_t i = 0; i < constants.size(); i++) {
+    vk::SpecializationMapEntry entry;
+    entry.constantID = i;
+    entry.offset = i * sizeof(Scalar);
+    entry.size = sizeof(Scalar);
+    specialization_map_entries.push_back(entry);
+  }
+  vk::SpecializationInfo specialization_info;
+  specialization_info.setMapEntries(specialization_map_entries);
+  specialization_info.dataSize = constants.size() * sizeof(Scalar);
+  specialization_info.pData = constants.data();
+
   std::vector<vk::PipelineShaderStageCreateInfo> shader_stages;
   for (const auto& entrypoint : desc.GetStageEntrypoints()) {
     auto stage = ToVKShaderStageFlagBits(entrypoint.first);
@@ -282,6 +301,9 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
     info.setPName("main");
     info.setModule(
         ShaderFunctionVK::Cast(entrypoint.second.get())->GetModule());
+    if (!constants.empty()) {
+      info.setPSpecializationInfo(&specialization_info);
+    }
     shader_stages.push_back(info);
   }
   pipeline_info.setStages(shader_stages);
@@ -668,7 +690,7 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
 }
 
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
-  if (++frames_acquired_ == 50u) {
+  if (++frames_acquired_ == PipelineCacheVK::kPersistAfterFrameCount) {
     PersistPipelineCacheToDisk();
   }
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <string>
 
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
@@ -49,6 +50,7 @@ class PipelineLibraryVK final
       const std::shared_ptr<DeviceHolder>& device_holder,
       std::shared_ptr<const Capabilities> caps,
       fml::UniqueFD cache_directory,
+      std::string engine_version,
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
 
   // |PipelineLibrary|
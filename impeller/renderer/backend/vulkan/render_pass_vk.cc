@@ -4,8 +4,12 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -69,26 +73,31 @@ static vk::AttachmentDescription CreateAttachmentDescription(
 static void SetTextureLayout(
     const Attachment& attachment,
     const vk::AttachmentDescription& attachment_desc,
-    const std::shared_ptr<CommandBufferVK>& command_buffer,
+    BarrierBatchVK& barriers,
     const std::shared_ptr<Texture> Attachment::*texture_ptr) {
   const auto& texture = attachment.*texture_ptr;
   if (!texture) {
     return;
   }
   const auto& texture_vk = TextureVK::Cast(*texture);
-
-  if (attachment_desc.initialLayout == vk::ImageLayout::eGeneral) {
-    BarrierVK barrier;
-    barrier.new_layout = vk::ImageLayout::eGeneral;
-    barrier.cmd_buffer = command_buffer->GetEncoder()->GetCommandBuffer();
-    barrier.src_access = vk::AccessFlagBits::eShaderRead;
-    barrier.src_stage = vk::PipelineStageFlagBits::eFragmentShader;
-    barrier.dst_access = vk::AccessFlagBits::eColorAttachmentWrite |
-                         vk::AccessFlagBits::eTransferWrite;
-    barrier.dst_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
-                        vk::PipelineStageFlagBits::eTransfer;
-
-    texture_vk.SetLayout(barrier);
+  const auto source = texture_vk.GetTextureSource();
+
+  if (source && attachment_desc.initialLayout == vk::ImageLayout::eGeneral) {
+    if (attachment_desc.finalLayout ==
+        vk::ImageLayout::eDepthStencilAttachmentOptimal) {
+      barriers.AddTransition(
+          *source, vk::ImageLayout::eGeneral,
+          vk::PipelineStageFlagBits::eEarlyFragmentTests |
+              vk::PipelineStageFlagBits::eLateFragmentTests,
+          vk::AccessFlagBits::eDepthStencilAttachmentRead |
+              vk::AccessFlagBits::eDepthStencilAttachmentWrite);
+    } else {
+      barriers.AddTransition(
+          *source, vk::ImageLayout::eGeneral,
+          vk::PipelineStageFlagBits::eColorAttachmentOutput,
+          vk::AccessFlagBits::eColorAttachmentRead |
+              vk::AccessFlagBits::eColorAttachmentWrite);
+    }
   }
 
   // Instead of transitioning layouts manually using barriers, we are going to
@@ -98,7 +107,7 @@ static void SetTextureLayout(
 
 SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
     const ContextVK& context,
-    const std::shared_ptr<CommandBufferVK>& command_buffer) const {
+    BarrierBatchVK& barriers) const {
   std::vector<vk::AttachmentDescription> attachments;
 
   std::vector<vk::AttachmentReference> color_refs;
@@ -124,14 +133,14 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
                                 vk::ImageLayout::eColorAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(color, &Attachment::texture));
-    SetTextureLayout(color, attachments.back(), command_buffer,
+    SetTextureLayout(color, attachments.back(), barriers,
                      &Attachment::texture);
     if (color.resolve_texture) {
       resolve_refs[bind_point] = vk::AttachmentReference{
           static_cast<uint32_t>(attachments.size()), vk::ImageLayout::eGeneral};
       attachments.emplace_back(
           CreateAttachmentDescription(color, &Attachment::resolve_texture));
-      SetTextureLayout(color, attachments.back(), command_buffer,
+      SetTextureLayout(color, attachments.back(), barriers,
                        &Attachment::resolve_texture);
     }
   }
@@ -142,7 +151,7 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         vk::ImageLayout::eDepthStencilAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(depth.value(), &Attachment::texture));
-    SetTextureLayout(depth.value(), attachments.back(), command_buffer,
+    SetTextureLayout(depth.value(), attachments.back(), barriers,
                      &Attachment::texture);
   }
 
@@ -153,7 +162,7 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         vk::ImageLayout::eDepthStencilAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(stencil.value(), &Attachment::texture));
-    SetTextureLayout(stencil.value(), attachments.back(), command_buffer,
+    SetTextureLayout(stencil.value(), attachments.back(), barriers,
                      &Attachment::texture);
   }
 
@@ -285,38 +294,37 @@ SharedHandleVK<vk::Framebuffer> RenderPassVK::CreateVKFramebuffer(
 }
 
 static bool UpdateBindingLayouts(const Bindings& bindings,
-                                 const vk::CommandBuffer& buffer) {
+                                 vk::PipelineStageFlags stage,
+                                 BarrierBatchVK& barriers) {
   // All previous writes via a render or blit pass must be done before another
-  // shader attempts to read the resource.
-  BarrierVK barrier;
-  barrier.cmd_buffer = buffer;
-  barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite |
-                       vk::AccessFlagBits::eTransferWrite;
-  barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
-                      vk::PipelineStageFlagBits::eTransfer;
-  barrier.dst_access = vk::AccessFlagBits::eShaderRead;
-  barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
-
-  barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
-
+  // shader attempts to read the resource. The writes to wait for are derived
+  // from the layout each image was left in.
   for (const auto& [_, data] : bindings.sampled_images) {
-    if (!TextureVK::Cast(*data.texture.resource).SetLayout(barrier)) {
+    const auto source =
+        TextureVK::Cast(*data.texture.resource).GetTextureSource();
+    if (!source) {
       return false;
     }
+    barriers.AddTransition(*source, vk::ImageLayout::eShaderReadOnlyOptimal,
+                           stage, vk::AccessFlagBits::eShaderRead);
   }
   return true;
 }
 
 static bool UpdateBindingLayouts(const Command& command,
-                                 const vk::CommandBuffer& buffer) {
-  return UpdateBindingLayouts(command.vertex_bindings, buffer) &&
-         UpdateBindingLayouts(command.fragment_bindings, buffer);
+                                 BarrierBatchVK& barriers) {
+  return UpdateBindingLayouts(command.vertex_bindings,
+                              vk::PipelineStageFlagBits::eVertexShader,
+                              barriers) &&
+         UpdateBindingLayouts(command.fragment_bindings,
+                              vk::PipelineStageFlagBits::eFragmentShader,
+                              barriers);
 }
 
 static bool UpdateBindingLayouts(const std::vector<Command>& commands,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   for (const auto& command : commands) {
-    if (!UpdateBindingLayouts(command, buffer)) {
+    if (!UpdateBindingLayouts(command, barriers)) {
       return false;
     }
   }
@@ -330,11 +338,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                                           size_t command_count) {
   auto desc_set =
       pipeline.GetDescriptor().GetVertexDescriptor()->GetDescriptorSetLayouts();
-  auto vk_desc_set = encoder.AllocateDescriptorSet(
-      pipeline.GetDescriptorSetLayout(), command_count);
-  if (!vk_desc_set) {
-    return false;
-  }
 
   auto& allocator = *context.GetResourceAllocator();
 
@@ -348,10 +351,9 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
   buffers.reserve(command.vertex_bindings.buffers.size() +
                   command.fragment_bindings.buffers.size());
 
-  auto bind_images = [&encoder,     //
-                      &images,      //
-                      &writes,      //
-                      &vk_desc_set  //
+  auto bind_images = [&encoder,  //
+                      &images,   //
+                      &writes    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [index, data] : bindings.sampled_images) {
       auto texture = data.texture.resource;
@@ -372,7 +374,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       images.push_back(image_info);
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = slot.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
@@ -384,12 +385,11 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return true;
   };
 
-  auto bind_buffers = [&allocator,   //
-                       &encoder,     //
-                       &buffers,     //
-                       &writes,      //
-                       &desc_set,    //
-                       &vk_desc_set  //
+  auto bind_buffers = [&allocator,  //
+                       &encoder,    //
+                       &buffers,    //
+                       &writes,     //
+                       &desc_set    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [buffer_index, data] : bindings.buffers) {
       const auto& buffer_view = data.view.resource.buffer;
@@ -430,7 +430,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       auto layout = *layout_it;
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = uniform.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
@@ -447,7 +446,13 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return false;
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
+  // Commands of the pass that bind identical resources share one descriptor
+  // set.
+  auto vk_desc_set = encoder.AllocateDescriptorSet(
+      pipeline.GetDescriptorSetLayout(), command_count, writes);
+  if (!vk_desc_set) {
+    return false;
+  }
 
   encoder.GetCommandBuffer().bindDescriptorSets(
       vk::PipelineBindPoint::eGraphics,   // bind point
@@ -594,6 +599,130 @@ static bool EncodeCommand(const Context& context,
   return true;
 }
 
+/// Render passes are only split into secondary command buffers if each of them
+/// would record at least this many commands.
+static constexpr size_t kMinCommandsPerSecondaryBuffer = 256u;
+
+/// The concurrent worker pool has at most four workers.
+static constexpr size_t kMaxSecondaryBuffers = 4u;
+
+/// Host buffers lazily create their device buffer the first time it is
+/// requested. Resolve them up front so that encoders running in parallel only
+/// ever read the cached device buffer.
+static bool PrepareDeviceBuffers(const std::vector<Command>& commands,
+                                 Allocator& allocator) {
+  const Buffer* last_buffer = nullptr;
+  auto prepare = [&](const BufferView& view) -> bool {
+    if (!view.buffer || view.buffer.get() == last_buffer) {
+      return true;
+    }
+    last_buffer = view.buffer.get();
+    return !!view.buffer->GetDeviceBuffer(allocator);
+  };
+  auto prepare_bindings = [&](const Bindings& bindings) -> bool {
+    for (const auto& [_, data] : bindings.buffers) {
+      if (!prepare(data.view.resource)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  for (const auto& command : commands) {
+    if (!prepare(command.GetVertexBuffer()) ||
+        (command.index_type != IndexType::kNone &&
+         !prepare(command.index_buffer)) ||
+        !prepare_bindings(command.vertex_bindings) ||
+        !prepare_bindings(command.fragment_bindings)) {
+      VALIDATION_LOG << "Failed to acquire device buffers for render pass.";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RenderPassVK::EncodeCommandsInParallel(
+    const ContextVK& context,
+    CommandEncoderVK& encoder,
+    const std::shared_ptr<CommandBufferVK>& command_buffer,
+    const vk::CommandBufferInheritanceInfo& inheritance_info,
+    const ISize& target_size) const {
+  TRACE_EVENT0("impeller", "RenderPassVK::EncodeCommandsInParallel");
+  const size_t chunk_count = std::clamp<size_t>(
+      commands_.size() / kMinCommandsPerSecondaryBuffer, 1u,
+      kMaxSecondaryBuffers);
+  const size_t chunk_size = (commands_.size() + chunk_count - 1) / chunk_count;
+
+  struct State {
+    std::atomic<size_t> next_chunk = 0u;
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t completed = 0u;
+    bool failed = false;
+    std::vector<std::shared_ptr<CommandEncoderVK>> secondaries;
+  };
+  auto state = std::make_shared<State>();
+  state->secondaries.resize(chunk_count);
+
+  // Both the calling thread and the workers pull chunks until none are left.
+  // If the workers are busy, the calling thread ends up encoding everything
+  // itself instead of waiting on them. Workers that start late find no chunks
+  // left and never touch this pass.
+  auto encode_chunks = [state, chunk_count, chunk_size, &context,
+                        command_buffer, inheritance_info, target_size,
+                        this]() {
+    while (true) {
+      const size_t chunk = state->next_chunk.fetch_add(1u);
+      if (chunk >= chunk_count) {
+        return;
+      }
+      const size_t begin = chunk * chunk_size;
+      const size_t end = std::min(begin + chunk_size, commands_.size());
+
+      auto secondary = command_buffer->CreateSecondaryEncoder(inheritance_info);
+      bool success = !!secondary;
+      if (success) {
+        // Dynamic state is not inherited by secondary command buffers, so each
+        // of them needs its own cache.
+        PassBindingsCache bindings_cache;
+        for (size_t i = begin; i < end && success; i++) {
+          const auto& command = commands_[i];
+          if (!command.pipeline) {
+            continue;
+          }
+          success = EncodeCommand(context, command, *secondary, bindings_cache,
+                                  target_size, end - begin);
+        }
+      }
+
+      {
+        std::scoped_lock lock(state->mutex);
+        state->secondaries[chunk] = success ? std::move(secondary) : nullptr;
+        state->failed |= !success;
+        state->completed++;
+      }
+      state->cv.notify_all();
+    }
+  };
+
+  auto worker_task_runner = context.GetConcurrentWorkerTaskRunner();
+  // The raster thread is blocked on the chunks.
+  for (size_t i = 1; i < chunk_count; i++) {
+    worker_task_runner->PostHighPriorityTask(encode_chunks);
+  }
+  encode_chunks();
+
+  {
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [&]() { return state->completed == chunk_count; });
+    if (state->failed) {
+      VALIDATION_LOG << "Failed to encode secondary command buffers.";
+      return false;
+    }
+  }
+
+  return encoder.ExecuteSecondary(state->secondaries);
+}
+
 bool RenderPassVK::OnEncodeCommands(const Context& context) const {
   TRACE_EVENT0("impeller", "RenderPassVK::OnEncodeCommands");
   if (!IsValid()) {
@@ -622,7 +751,10 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   auto cmd_buffer = encoder->GetCommandBuffer();
 
-  if (!UpdateBindingLayouts(commands_, cmd_buffer)) {
+  // The layout transitions of the sampled images and attachments of the pass
+  // are encoded together, ahead of the render pass.
+  BarrierBatchVK barriers;
+  if (!UpdateBindingLayouts(commands_, barriers)) {
     return false;
   }
 
@@ -635,11 +767,12 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   const auto& target_size = render_target_.GetRenderTargetSize();
 
-  auto render_pass = CreateVKRenderPass(vk_context, command_buffer);
+  auto render_pass = CreateVKRenderPass(vk_context, barriers);
   if (!render_pass) {
     VALIDATION_LOG << "Could not create renderpass.";
     return false;
   }
+  barriers.Encode(cmd_buffer);
 
   auto framebuffer = CreateVKFramebuffer(vk_context, *render_pass);
   if (!framebuffer) {
@@ -661,6 +794,30 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
       static_cast<uint32_t>(target_size.height);
   pass_info.setClearValues(clear_values);
 
+  const bool encode_in_parallel =
+      vk_context.IsParallelRenderPassEncodingEnabled() &&
+      commands_.size() >= 2u * kMinCommandsPerSecondaryBuffer;
+
+  if (encode_in_parallel) {
+    if (!PrepareDeviceBuffers(commands_, *vk_context.GetResourceAllocator())) {
+      return false;
+    }
+
+    vk::CommandBufferInheritanceInfo inheritance_info;
+    inheritance_info.renderPass = *render_pass;
+    inheritance_info.subpass = 0u;
+    inheritance_info.framebuffer = *framebuffer;
+
+    cmd_buffer.beginRenderPass(pass_info,
+                               vk::SubpassContents::eSecondaryCommandBuffers);
+
+    fml::ScopedCleanupClosure end_render_pass(
+        [cmd_buffer]() { cmd_buffer.endRenderPass(); });
+
+    return EncodeCommandsInParallel(vk_context, *encoder, command_buffer,
+                                    inheritance_info, target_size);
+  }
+
   {
     TRACE_EVENT0("impeller", "EncodeRenderPassCommands");
     cmd_buffer.beginRenderPass(pass_info, vk::SubpassContents::eInline);
@@ -17,6 +17,7 @@
 namespace impeller {
 
 class CommandBufferVK;
+class CommandEncoderVK;
 
 class RenderPassVK final : public RenderPass {
  public:
@@ -46,12 +47,25 @@ class RenderPassVK final : public RenderPass {
 
   SharedHandleVK<vk::RenderPass> CreateVKRenderPass(
       const ContextVK& context,
-      const std::shared_ptr<CommandBufferVK>& command_buffer) const;
+      BarrierBatchVK& barriers) const;
 
   SharedHandleVK<vk::Framebuffer> CreateVKFramebuffer(
       const ContextVK& context,
       const vk::RenderPass& pass) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Split the commands into secondary command buffers that are
+  ///             recorded on the concurrent worker pool and executed in order
+  ///             from the primary `encoder`. The render pass must already have
+  ///             begun with secondary command buffer contents.
+  ///
+  bool EncodeCommandsInParallel(
+      const ContextVK& context,
+      CommandEncoderVK& encoder,
+      const std::shared_ptr<CommandBufferVK>& command_buffer,
+      const vk::CommandBufferInheritanceInfo& inheritance_info,
+      const ISize& target_size) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(RenderPassVK);
 };
 
@@ -4,16 +4,26 @@
 
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 
+#include <iterator>
+
+#include "flutter/fml/logging.h"
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 
 namespace impeller {
 
+// The innermost batch open on the current thread.
+static thread_local ResourceManagerVK::ScopedReclaimBatch* tls_reclaim_batch =
+    nullptr;
+
 std::shared_ptr<ResourceManagerVK> ResourceManagerVK::Create() {
   return std::shared_ptr<ResourceManagerVK>(new ResourceManagerVK());
 }
 
-ResourceManagerVK::ResourceManagerVK() : waiter_([&]() { Main(); }) {}
+ResourceManagerVK::ResourceManagerVK() {
+  // Start the thread once the members it uses are initialized.
+  waiter_ = std::thread([&]() { Main(); });
+}
 
 ResourceManagerVK::~ResourceManagerVK() {
   Terminate();
@@ -57,6 +67,10 @@ void ResourceManagerVK::Reclaim(std::unique_ptr<ResourceVK> resource) {
   if (!resource) {
     return;
   }
+  if (tls_reclaim_batch) {
+    tls_reclaim_batch->Add(shared_from_this(), std::move(resource));
+    return;
+  }
   {
     std::scoped_lock lock(reclaimables_mutex_);
     reclaimables_.emplace_back(std::move(resource));
@@ -64,6 +78,55 @@ void ResourceManagerVK::Reclaim(std::unique_ptr<ResourceVK> resource) {
   reclaimables_cv_.notify_one();
 }
 
+void ResourceManagerVK::Reclaim(
+    std::vector<std::unique_ptr<ResourceVK>> resources) {
+  if (resources.empty()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(reclaimables_mutex_);
+    if (reclaimables_.empty()) {
+      std::swap(reclaimables_, resources);
+    } else {
+      std::move(resources.begin(), resources.end(),
+                std::back_inserter(reclaimables_));
+    }
+  }
+  reclaimables_cv_.notify_one();
+}
+
+ResourceManagerVK::ScopedReclaimBatch::ScopedReclaimBatch()
+    : previous_(tls_reclaim_batch) {
+  tls_reclaim_batch = this;
+}
+
+ResourceManagerVK::ScopedReclaimBatch::~ScopedReclaimBatch() {
+  FML_DCHECK(tls_reclaim_batch == this);
+  tls_reclaim_batch = previous_;
+  if (resource_manager_) {
+    resource_manager_->Reclaim(std::move(resources_));
+  }
+  for (auto& [resource_manager, resource] : other_resources_) {
+    resource_manager->Reclaim(std::move(resource));
+  }
+}
+
+void ResourceManagerVK::ScopedReclaimBatch::Add(
+    std::shared_ptr<ResourceManagerVK> resource_manager,
+    std::unique_ptr<ResourceVK> resource) {
+  // There is one resource manager per context, so a batch almost always only
+  // sees one.
+  if (!resource_manager_) {
+    resource_manager_ = resource_manager;
+  }
+  if (resource_manager == resource_manager_) {
+    resources_.emplace_back(std::move(resource));
+    return;
+  }
+  other_resources_.emplace_back(std::move(resource_manager),
+                                std::move(resource));
+}
+
 void ResourceManagerVK::Terminate() {
   {
     std::scoped_lock lock(reclaimables_mutex_);
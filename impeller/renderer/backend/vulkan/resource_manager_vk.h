@@ -59,6 +59,45 @@ class ResourceManagerVK
   ///
   void Reclaim(std::unique_ptr<ResourceVK> resource);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Mark resources as being reclaimable by giving ownership of
+  ///             all of them to the resource manager at once.
+  ///
+  /// @param[in]  resources  The resources to reclaim.
+  ///
+  void Reclaim(std::vector<std::unique_ptr<ResourceVK>> resources);
+
+  //----------------------------------------------------------------------------
+  /// @brief      While a batch is alive, the resources reclaimed on its thread
+  ///             are held by the batch and handed to their resource managers
+  ///             together when it is destroyed.
+  ///
+  ///             The fence waiter opens one while it drops the objects of the
+  ///             command buffers that completed, so that the resources of a
+  ///             frame don't each lock and wake the resource manager.
+  ///
+  class ScopedReclaimBatch {
+   public:
+    ScopedReclaimBatch();
+
+    ~ScopedReclaimBatch();
+
+   private:
+    friend class ResourceManagerVK;
+
+    ScopedReclaimBatch* const previous_;
+    std::shared_ptr<ResourceManagerVK> resource_manager_;
+    std::vector<std::unique_ptr<ResourceVK>> resources_;
+    std::vector<std::pair<std::shared_ptr<ResourceManagerVK>,
+                          std::unique_ptr<ResourceVK>>>
+        other_resources_;
+
+    void Add(std::shared_ptr<ResourceManagerVK> resource_manager,
+             std::unique_ptr<ResourceVK> resource);
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedReclaimBatch);
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Terminate the resource manager. Any resources given to the
   ///             resource manager post termination will be collected when the
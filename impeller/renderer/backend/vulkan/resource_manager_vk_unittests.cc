@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+// Calls |callback| when destroyed.
+class DeathRattle {
+ public:
+  explicit DeathRattle(std::function<void()> callback)
+      : callback_(std::move(callback)) {}
+
+  DeathRattle(DeathRattle&& other) : callback_(std::move(other.callback_)) {
+    other.callback_ = nullptr;
+  }
+
+  ~DeathRattle() {
+    if (callback_) {
+      callback_();
+    }
+  }
+
+ private:
+  std::function<void()> callback_;
+};
+
+}  // namespace
+
+TEST(ResourceManagerVKTest, ReclaimsBatchesTogetherOnItsThread) {
+  auto const manager = ResourceManagerVK::Create();
+  constexpr size_t kResourceCount = 3u;
+  std::atomic<size_t> reclaimed_count = 0;
+  std::thread::id reclaim_thread;
+  fml::CountDownLatch all_reclaimed(kResourceCount);
+
+  {
+    ResourceManagerVK::ScopedReclaimBatch batch;
+    for (size_t i = 0; i < kResourceCount; i++) {
+      UniqueResourceVKT<DeathRattle> resource(
+          manager, DeathRattle([&]() {
+            reclaim_thread = std::this_thread::get_id();
+            reclaimed_count++;
+            all_reclaimed.CountDown();
+          }));
+    }
+    // The batch holds the resources until it is destroyed.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(reclaimed_count, 0u);
+  }
+
+  all_reclaimed.Wait();
+  EXPECT_EQ(reclaimed_count, kResourceCount);
+  EXPECT_NE(reclaim_thread, std::this_thread::get_id());
+}
+
+}  // namespace testing
+}  // namespace impeller
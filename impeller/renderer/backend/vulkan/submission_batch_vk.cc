@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/submission_batch_vk.h"
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
+
+namespace impeller {
+
+SubmissionBatchVK::SubmissionBatchVK(
+    std::shared_ptr<QueueVK> queue,
+    std::shared_ptr<FenceWaiterVK> fence_waiter)
+    : queue_(std::move(queue)), fence_waiter_(std::move(fence_waiter)) {}
+
+SubmissionBatchVK::~SubmissionBatchVK() {
+  Flush();
+}
+
+void SubmissionBatchVK::BeginFrame() {
+  std::scoped_lock lock(mutex_);
+  frame_thread_ = std::this_thread::get_id();
+}
+
+bool SubmissionBatchVK::EndFrame() {
+  std::unique_lock lock(mutex_);
+  frame_thread_.reset();
+  return FlushLocked(lock);
+}
+
+bool SubmissionBatchVK::IsDeferringOnCurrentThread() const {
+  std::scoped_lock lock(mutex_);
+  return frame_thread_.has_value() &&
+         frame_thread_.value() == std::this_thread::get_id();
+}
+
+void SubmissionBatchVK::Defer(vk::CommandBuffer buffer,
+                              CompletionCallback callback) {
+  std::scoped_lock lock(mutex_);
+  buffers_.push_back(buffer);
+  callbacks_.push_back(std::move(callback));
+}
+
+bool SubmissionBatchVK::Flush() {
+  std::unique_lock lock(mutex_);
+  return FlushLocked(lock);
+}
+
+size_t SubmissionBatchVK::GetDeferredCount() const {
+  std::scoped_lock lock(mutex_);
+  return buffers_.size();
+}
+
+bool SubmissionBatchVK::FlushLocked(std::unique_lock<std::mutex>& lock) {
+  if (buffers_.empty()) {
+    return true;
+  }
+  TRACE_EVENT0("impeller", "SubmissionBatchVK::Flush");
+
+  const auto buffers = std::move(buffers_);
+  auto callbacks = std::make_shared<std::vector<CompletionCallback>>(
+      std::move(callbacks_));
+  buffers_.clear();
+  callbacks_.clear();
+
+  // The lock is held while submitting so that concurrent flushes reach the
+  // queue in order.
+  vk::SubmitInfo submit_info;
+  submit_info.setCommandBuffers(buffers);
+  const auto submitted =
+      fence_waiter_->Submit(*queue_, submit_info, [callbacks]() {
+        for (const auto& callback : *callbacks) {
+          if (callback) {
+            callback(true);
+          }
+        }
+      });
+  lock.unlock();
+
+  if (!submitted) {
+    VALIDATION_LOG << "Could not submit " << buffers.size()
+                   << " deferred command buffers.";
+    for (const auto& callback : *callbacks) {
+      if (callback) {
+        callback(false);
+      }
+    }
+  }
+  return submitted;
+}
+
+}  // namespace impeller
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+class FenceWaiterVK;
+class QueueVK;
+
+//------------------------------------------------------------------------------
+/// @brief      Defers the command buffers submitted while a frame is recorded
+///             so that they reach the queue with a single `vkQueueSubmit`
+///             when the frame is presented, instead of one per pass.
+///
+///             Only the submissions of the thread that began the frame, and
+///             of the encoding tasks it posted, are deferred. Any submission
+///             made to the queue directly must call |Flush| first, so that the
+///             queue sees command buffers in the order they were recorded in.
+///
+///             All methods are thread safe.
+///
+class SubmissionBatchVK {
+ public:
+  using CompletionCallback = std::function<void(bool)>;
+
+  SubmissionBatchVK(std::shared_ptr<QueueVK> queue,
+                    std::shared_ptr<FenceWaiterVK> fence_waiter);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the command buffers that are still deferred.
+  ///
+  ~SubmissionBatchVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start deferring the submissions made on the calling thread.
+  ///
+  void BeginFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submit the deferred command buffers and stop deferring.
+  ///
+  bool EndFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether submissions made on the calling thread right now
+  ///             should be deferred.
+  ///
+  bool IsDeferringOnCurrentThread() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Defer the submission of the ended command buffer `buffer`.
+  ///             `callback` is invoked with `true` once the GPU is done with
+  ///             it, or with `false` if it could not be submitted.
+  ///
+  void Defer(vk::CommandBuffer buffer, CompletionCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submit the deferred command buffers, in the order they were
+  ///             deferred in, with a single submission. Deferring goes on if a
+  ///             frame is being recorded.
+  ///
+  bool Flush();
+
+  size_t GetDeferredCount() const;
+
+ private:
+  const std::shared_ptr<QueueVK> queue_;
+  const std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  mutable std::mutex mutex_;
+  std::optional<std::thread::id> frame_thread_;
+  std::vector<vk::CommandBuffer> buffers_;
+  std::vector<CompletionCallback> callbacks_;
+
+  bool FlushLocked(std::unique_lock<std::mutex>& lock);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SubmissionBatchVK);
+};
+
+}  // namespace impeller
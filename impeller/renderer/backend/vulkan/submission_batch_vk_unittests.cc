@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <thread>
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/submission_batch_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(SubmissionBatchVKTest, OnlyDefersOnTheFrameThread) {
+  auto context = CreateMockVulkanContext();
+  const auto& batch = context->GetSubmissionBatch();
+  ASSERT_TRUE(batch);
+  EXPECT_FALSE(batch->IsDeferringOnCurrentThread());
+
+  batch->BeginFrame();
+  EXPECT_TRUE(batch->IsDeferringOnCurrentThread());
+  bool deferring_on_other_thread = true;
+  std::thread([&]() {
+    deferring_on_other_thread = batch->IsDeferringOnCurrentThread();
+  }).join();
+  EXPECT_FALSE(deferring_on_other_thread);
+
+  EXPECT_TRUE(batch->EndFrame());
+  EXPECT_FALSE(batch->IsDeferringOnCurrentThread());
+}
+
+TEST(SubmissionBatchVKTest, FlushingAnEmptyBatchSucceeds) {
+  auto context = CreateMockVulkanContext();
+  const auto& batch = context->GetSubmissionBatch();
+  ASSERT_TRUE(batch);
+
+  batch->BeginFrame();
+  EXPECT_EQ(batch->GetDeferredCount(), 0u);
+  EXPECT_TRUE(batch->Flush());
+  // Flushing doesn't end the frame.
+  EXPECT_TRUE(batch->IsDeferringOnCurrentThread());
+  EXPECT_TRUE(batch->EndFrame());
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -15,20 +15,28 @@ namespace impeller {
 
 class SurfaceVK final : public Surface {
  public:
-  using SwapCallback = std::function<bool(void)>;
+  using SwapCallback =
+      std::function<bool(const std::optional<IRect>& frame_damage)>;
 
   static std::unique_ptr<SurfaceVK> WrapSwapchainImage(
       const std::shared_ptr<Context>& context,
       std::shared_ptr<SwapchainImageVK>& swapchain_image,
+      std::optional<IRect> existing_damage,
       SwapCallback swap_callback);
 
   // |Surface|
   ~SurfaceVK() override;
 
+  // |Surface|
+  std::optional<IRect> GetExistingDamage() const override;
+
  private:
+  std::optional<IRect> existing_damage_;
   SwapCallback swap_callback_;
 
-  SurfaceVK(const RenderTarget& target, SwapCallback swap_callback);
+  SurfaceVK(const RenderTarget& target,
+            std::optional<IRect> existing_damage,
+            SwapCallback swap_callback);
 
   // |Surface|
   bool Present() const override;
@@ -4,10 +4,14 @@
 
 #include "impeller/renderer/backend/vulkan/swapchain_impl_vk.h"
 
+#include "flutter/fml/closure.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/submission_batch_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
 #include "impeller/renderer/backend/vulkan/swapchain_image_vk.h"
 #include "vulkan/vulkan_structs.hpp"
@@ -21,6 +25,10 @@ static constexpr size_t kMaxFramesInFlight = 3u;
 // orientation will be polled every other frame.
 static constexpr size_t kPollFramesForOrientation = 1u;
 
+// The number of presents whose timings are remembered until the presentation
+// engine reports them, in case it never reports some of them.
+static constexpr size_t kMaxPendingPresentTimings = 16u;
+
 struct FrameSynchronizer {
   vk::UniqueFence acquire;
   vk::UniqueSemaphore render_ready;
@@ -47,22 +55,16 @@ struct FrameSynchronizer {
 
   ~FrameSynchronizer() = default;
 
-  bool WaitForFence(const vk::Device& device) {
-    if (auto result = device.waitForFences(
-            *acquire,                             // fence
-            true,                                 // wait all
-            std::numeric_limits<uint64_t>::max()  // timeout (ns)
-        );
-        result != vk::Result::eSuccess) {
-      VALIDATION_LOG << "Fence wait failed: " << vk::to_string(result);
-      return false;
+  // Waits for the frame that last used this synchronizer to be submitted to
+  // the GPU. The fence is only reset once the next image has been acquired,
+  // so that a frame that is dropped doesn't leave it unsignaled.
+  vk::Result WaitForFence(const vk::Device& device, uint64_t timeout_ns) {
+    auto result = device.waitForFences(*acquire, true, 0u);
+    if (result == vk::Result::eTimeout) {
+      TRACE_EVENT0("impeller", "WaitForFrameFence");
+      result = device.waitForFences(*acquire, true, timeout_ns);
     }
-    if (auto result = device.resetFences(*acquire);
-        result != vk::Result::eSuccess) {
-      VALIDATION_LOG << "Could not reset fence: " << vk::to_string(result);
-      return false;
-    }
-    return true;
+    return result;
   }
 };
 
@@ -111,6 +113,24 @@ static std::optional<vk::CompositeAlphaFlagBitsKHR> ChooseAlphaCompositionMode(
   return std::nullopt;
 }
 
+static vk::PresentModeKHR ChoosePresentMode(
+    const vk::PhysicalDevice& physical_device,
+    const vk::SurfaceKHR& surface,
+    vk::PresentModeKHR preference) {
+  // FIFO is the only mode all surfaces are required to support.
+  if (preference == vk::PresentModeKHR::eFifo) {
+    return preference;
+  }
+  auto [result, modes] = physical_device.getSurfacePresentModesKHR(surface);
+  if (result == vk::Result::eSuccess &&
+      std::find(modes.begin(), modes.end(), preference) != modes.end()) {
+    return preference;
+  }
+  FML_LOG(WARNING) << "The surface does not support the present mode "
+                   << vk::to_string(preference) << ". Using FIFO instead.";
+  return vk::PresentModeKHR::eFifo;
+}
+
 static std::optional<vk::Queue> ChoosePresentQueue(
     const vk::PhysicalDevice& physical_device,
     const vk::Device& device,
@@ -187,22 +207,30 @@ SwapchainImplVK::SwapchainImplVK(
     return;
   }
 
+  const auto& swapchain_settings = vk_context.GetSwapchainSettings();
+
   vk::SwapchainCreateInfoKHR swapchain_info;
   swapchain_info.surface = *surface;
   swapchain_info.imageFormat = format.value().format;
   swapchain_info.imageColorSpace = format.value().colorSpace;
-  swapchain_info.presentMode = vk::PresentModeKHR::eFifo;
+  swapchain_info.presentMode =
+      ChoosePresentMode(vk_context.GetPhysicalDevice(), *surface,
+                        swapchain_settings.present_mode);
   swapchain_info.imageExtent = vk::Extent2D{
       std::clamp(caps.currentExtent.width, caps.minImageExtent.width,
                  caps.maxImageExtent.width),
       std::clamp(caps.currentExtent.height, caps.minImageExtent.height,
                  caps.maxImageExtent.height),
   };
+  const uint32_t preferred_image_count = swapchain_settings.image_count > 0u
+                                             ? swapchain_settings.image_count
+                                             : caps.minImageCount + 1u;
   swapchain_info.minImageCount = std::clamp(
-      caps.minImageCount + 1u,  // preferred image count
-      caps.minImageCount,       // min count cannot be zero
-      caps.maxImageCount == 0u ? caps.minImageCount + 1u
-                               : caps.maxImageCount  // max zero means no limit
+      preferred_image_count,  // preferred image count
+      caps.minImageCount,     // min count cannot be zero
+      caps.maxImageCount == 0u
+          ? std::max(preferred_image_count, caps.minImageCount)
+          : caps.maxImageCount  // max zero means no limit
   );
   swapchain_info.imageArrayLayers = 1u;
   // Swapchain images are primarily used as color attachments (via resolve) or
@@ -279,9 +307,14 @@ SwapchainImplVK::SwapchainImplVK(
   context_ = context;
   surface_ = std::move(surface);
   present_queue_ = present_queue.value();
+  has_display_timing_ =
+      CapabilitiesVK::Cast(*vk_context.GetCapabilities())
+          .HasOptionalDeviceExtension(
+              OptionalDeviceExtensionVK::kGOOGLEDisplayTiming);
   surface_format_ = swapchain_info.imageFormat;
   swapchain_ = std::move(swapchain);
   images_ = std::move(swapchain_images);
+  image_damage_.assign(images_.size(), std::nullopt);
   synchronizers_ = std::move(synchronizers);
   current_frame_ = synchronizers_.size() - 1u;
   is_valid_ = true;
@@ -309,6 +342,7 @@ SwapchainImplVK::DestroySwapchain() {
   is_valid_ = false;
   synchronizers_.clear();
   images_.clear();
+  image_damage_.clear();
   context_.reset();
   return {std::move(surface_), std::move(swapchain_)};
 }
@@ -336,12 +370,21 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   current_frame_ = (current_frame_ + 1u) % synchronizers_.size();
 
   const auto& sync = synchronizers_[current_frame_];
+  const auto timeout_ns = static_cast<uint64_t>(
+      context.GetSwapchainSettings().acquire_timeout.ToNanoseconds());
 
   //----------------------------------------------------------------------------
   /// Wait on the host for the synchronizer fence.
   ///
-  if (!sync->WaitForFence(context.GetDevice())) {
-    VALIDATION_LOG << "Could not wait for fence.";
+  if (auto result = sync->WaitForFence(context.GetDevice(), timeout_ns);
+      result != vk::Result::eSuccess) {
+    if (result == vk::Result::eTimeout) {
+      // The GPU is too far behind. Drop this frame rather than stalling the
+      // raster thread any longer.
+      TRACE_EVENT_INSTANT0("impeller", "FrameFenceTimedOut");
+    } else {
+      VALIDATION_LOG << "Fence wait failed: " << vk::to_string(result);
+    }
     return {};
   }
 
@@ -368,17 +411,38 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   //----------------------------------------------------------------------------
   /// Get the next image index.
   ///
+  /// An image is usually available right away. Only trace the acquisitions
+  /// that have to wait for the presentation engine.
+  ///
   auto [acq_result, index] = context.GetDevice().acquireNextImageKHR(
       *swapchain_,          // swapchain
-      1'000'000'000,        // timeout (ns) 1000ms
+      0u,                   // timeout (ns)
       *sync->render_ready,  // signal semaphore
       nullptr               // fence
   );
+  if (acq_result == vk::Result::eNotReady ||
+      acq_result == vk::Result::eTimeout) {
+    TRACE_EVENT0("impeller", "WaitForSwapchainImage");
+    auto retry = context.GetDevice().acquireNextImageKHR(
+        *swapchain_,          // swapchain
+        timeout_ns,           // timeout (ns)
+        *sync->render_ready,  // signal semaphore
+        nullptr               // fence
+    );
+    acq_result = retry.result;
+    index = retry.value;
+  }
 
   if (acq_result == vk::Result::eErrorOutOfDateKHR) {
     return AcquireResult{true /* out of date */};
   }
 
+  if (acq_result == vk::Result::eTimeout ||
+      acq_result == vk::Result::eNotReady) {
+    TRACE_EVENT_INSTANT0("impeller", "SwapchainImageTimedOut");
+    return {};
+  }
+
   if (acq_result != vk::Result::eSuccess &&
       acq_result != vk::Result::eSuboptimalKHR) {
     VALIDATION_LOG << "Could not acquire next swapchain image: "
@@ -391,23 +455,70 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
     return {};
   }
 
+  if (auto result = context.GetDevice().resetFences(*sync->acquire);
+      result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not reset fence: " << vk::to_string(result);
+    return {};
+  }
+
+  // Hold on to the command buffers of the frame until it is presented, or
+  // until its surface is discarded without being presented.
+  std::shared_ptr<fml::ScopedCleanupClosure> end_frame;
+  if (const auto& batch = context.GetSubmissionBatch()) {
+    batch->BeginFrame();
+    end_frame = std::make_shared<fml::ScopedCleanupClosure>(
+        [weak_batch = std::weak_ptr<SubmissionBatchVK>(batch)]() {
+          if (auto batch = weak_batch.lock()) {
+            batch->EndFrame();
+          }
+        });
+  }
+
   auto image = images_[index % images_.size()];
   uint32_t image_index = index;
   return AcquireResult{SurfaceVK::WrapSwapchainImage(
-      context_strong,  // context
-      image,           // swapchain image
-      [weak_swapchain = weak_from_this(), image, image_index]() -> bool {
+      context_strong,        // context
+      image,                 // swapchain image
+      image_damage_[index],  // existing damage
+      [weak_swapchain = weak_from_this(), image, image_index, end_frame](
+          const std::optional<IRect>& frame_damage) -> bool {
         auto swapchain = weak_swapchain.lock();
         if (!swapchain) {
           return false;
         }
-        return swapchain->Present(image, image_index);
+        return swapchain->Present(image, image_index, frame_damage);
       }  // swap callback
       )};
 }
 
+void SwapchainImplVK::AccumulateDamage(
+    uint32_t index,
+    const std::optional<IRect>& frame_damage) {
+  for (size_t i = 0; i < image_damage_.size(); i++) {
+    if (i == index) {
+      // The presented image is now up to date.
+      image_damage_[i] = IRect();
+      continue;
+    }
+    auto& damage = image_damage_[i];
+    if (!damage.has_value()) {
+      continue;
+    }
+    if (!frame_damage.has_value()) {
+      // The whole frame changed, so the contents of the other images no
+      // longer tell anything about the next frame.
+      damage = std::nullopt;
+    } else if (damage->IsEmpty()) {
+      damage = frame_damage;
+    } else if (!frame_damage->IsEmpty()) {
+      damage = damage->Union(frame_damage.value());
+    }
+  }
+}
+
 bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
-                              uint32_t index) {
+                              uint32_t index,
+                              const std::optional<IRect>& frame_damage) {
   auto context_strong = context_.lock();
   if (!context_strong) {
     return false;
@@ -416,6 +527,18 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   const auto& context = ContextVK::Cast(*context_strong);
   const auto& sync = synchronizers_[current_frame_];
 
+  // The final layout transition reads the layout tracked by passes that may
+  // still be encoding on the workers.
+  if (const auto& queue = context.GetEncodingQueue()) {
+    queue->Flush();
+  }
+
+  // Submit all the command buffers of the frame at once, ahead of the final
+  // layout transition.
+  if (const auto& batch = context.GetSubmissionBatch()) {
+    batch->EndFrame();
+  }
+
   //----------------------------------------------------------------------------
   /// Transition the image to color-attachment-optimal.
   ///
@@ -445,6 +568,8 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     }
   }
 
+  TraceBarrierCounts();
+
   //----------------------------------------------------------------------------
   /// Signal that the presentation semaphore is ready.
   ///
@@ -465,7 +590,26 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     }
   }
 
-  auto task = [&, index, image, current_frame = current_frame_] {
+  AccumulateDamage(index, frame_damage);
+
+  // Hint the presentation engine about the area that changed, which lets
+  // compositors skip recomposing the rest of the surface.
+  std::optional<vk::RectLayerKHR> present_rect;
+  if (frame_damage.has_value() &&
+      CapabilitiesVK::Cast(*context.GetCapabilities())
+          .HasOptionalDeviceExtension(
+              OptionalDeviceExtensionVK::kKHRIncrementalPresent)) {
+    present_rect = vk::RectLayerKHR{
+        vk::Offset2D{frame_damage->origin.x, frame_damage->origin.y},
+        vk::Extent2D{static_cast<uint32_t>(frame_damage->size.width),
+                     static_cast<uint32_t>(frame_damage->size.height)},
+        0u};
+  }
+
+  const uint32_t present_id = ++last_present_id_;
+
+  auto task = [&, index, image, present_rect, present_id,
+               current_frame = current_frame_] {
     auto context_strong = context_.lock();
     if (!context_strong) {
       return;
@@ -483,6 +627,30 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     present_info.setImageIndices(indices);
     present_info.setWaitSemaphores(*sync->present_ready);
 
+    vk::PresentRegionKHR present_region;
+    vk::PresentRegionsKHR present_regions;
+    if (present_rect.has_value()) {
+      present_region.setRectangles(present_rect.value());
+      present_regions.setRegions(present_region);
+      present_info.setPNext(&present_regions);
+    }
+
+    // Ask the presentation engine to report when the image actually reached
+    // the display, which tells late presents apart from late frames.
+    vk::PresentTimeGOOGLE present_time;
+    vk::PresentTimesInfoGOOGLE present_times;
+    if (has_display_timing_) {
+      present_time.presentID = present_id;
+      present_time.desiredPresentTime = 0u;  // As soon as possible.
+      present_times.setTimes(present_time);
+      present_times.setPNext(present_info.pNext);
+      present_info.setPNext(&present_times);
+    }
+
+    Lock lock(present_timing_mutex_);
+    if (has_display_timing_) {
+      pending_presents_.push_back({present_id, fml::TimePoint::Now()});
+    }
     switch (auto result = present_queue_.presentKHR(present_info)) {
       case vk::Result::eErrorOutOfDateKHR:
         // Caller will recreate the impl on acquisition, not submission.
@@ -498,12 +666,14 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
         // aren't doing Vulkan pre-rotation).
         [[fallthrough]];
       case vk::Result::eSuccess:
-        return;
+        break;
       default:
         VALIDATION_LOG << "Could not present queue: " << vk::to_string(result);
         return;
     }
-    FML_UNREACHABLE();
+    if (has_display_timing_) {
+      ReportPresentTimings(ContextVK::Cast(*context_strong).GetDevice());
+    }
   };
   if (context.GetSyncPresentation()) {
     task();
@@ -513,4 +683,51 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   return true;
 }
 
+void SwapchainImplVK::TraceBarrierCounts() {
+  // The counts are process wide, so they include the barriers of other
+  // swapchains and of offscreen work between presents.
+  const auto barrier_count = BarrierBatchVK::GetEncodedBarrierCount();
+  const auto image_barrier_count =
+      BarrierBatchVK::GetEncodedImageBarrierCount();
+  FML_TRACE_COUNTER(
+      "impeller", "BarriersPerFrame", reinterpret_cast<int64_t>(this),  //
+      "PipelineBarriers", barrier_count - last_barrier_count_,          //
+      "ImageBarriers", image_barrier_count - last_image_barrier_count_);
+  last_barrier_count_ = barrier_count;
+  last_image_barrier_count_ = image_barrier_count;
+}
+
+void SwapchainImplVK::ReportPresentTimings(const vk::Device& device) {
+  auto [result, timings] = device.getPastPresentationTimingGOOGLE(*swapchain_);
+  if (result != vk::Result::eSuccess && result != vk::Result::eIncomplete) {
+    return;
+  }
+  for (const auto& timing : timings) {
+    // The timings arrive in present order, but presents of images that were
+    // never displayed may be skipped.
+    while (!pending_presents_.empty() &&
+           pending_presents_.front().id != timing.presentID) {
+      pending_presents_.pop_front();
+    }
+    if (pending_presents_.empty()) {
+      break;
+    }
+    // Both are measured with the monotonic clock.
+    const auto latency =
+        fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(
+            static_cast<int64_t>(timing.actualPresentTime))) -
+        pending_presents_.front().presented_at;
+    pending_presents_.pop_front();
+    FML_TRACE_COUNTER("impeller", "PresentLatency",
+                      reinterpret_cast<int64_t>(this), "microseconds",
+                      latency.ToMicroseconds());
+    FML_TRACE_COUNTER("impeller", "PresentMargin",
+                      reinterpret_cast<int64_t>(this), "microseconds",
+                      static_cast<int64_t>(timing.presentMargin / 1000u));
+  }
+  while (pending_presents_.size() > kMaxPendingPresentTimings) {
+    pending_presents_.pop_front();
+  }
+}
+
 }  // namespace impeller
@@ -4,10 +4,16 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <optional>
 #include <variant>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+#include "impeller/base/thread.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "vulkan/vulkan_enums.hpp"
 
@@ -67,21 +73,60 @@ class SwapchainImplVK final
   vk::Format surface_format_ = vk::Format::eUndefined;
   vk::UniqueSwapchainKHR swapchain_;
   std::vector<std::shared_ptr<SwapchainImageVK>> images_;
+  // The area of each image that lags behind the last presented frame, or
+  // std::nullopt while the contents of the image are unknown.
+  std::vector<std::optional<IRect>> image_damage_;
   std::vector<std::unique_ptr<FrameSynchronizer>> synchronizers_;
   size_t current_frame_ = 0u;
   bool is_valid_ = false;
   size_t current_transform_poll_count_ = 0u;
   vk::SurfaceTransformFlagBitsKHR transform_if_changed_discard_swapchain_;
+  // Whether presents are timed with VK_GOOGLE_display_timing.
+  bool has_display_timing_ = false;
+  uint32_t last_present_id_ = 0u;
+  // The barrier counts of BarrierBatchVK at the previous present.
+  size_t last_barrier_count_ = 0u;
+  size_t last_image_barrier_count_ = 0u;
+
+  struct PendingPresent {
+    uint32_t id = 0u;
+    fml::TimePoint presented_at;
+  };
+
+  // Serializes presents, which may happen on the concurrent workers, with the
+  // queries of their timings.
+  Mutex present_timing_mutex_;
+  std::deque<PendingPresent> pending_presents_
+      IPLR_GUARDED_BY(present_timing_mutex_);
 
   SwapchainImplVK(const std::shared_ptr<Context>& context,
                   vk::UniqueSurfaceKHR surface,
                   vk::SwapchainKHR old_swapchain,
                   vk::SurfaceTransformFlagBitsKHR last_transform);
 
-  bool Present(const std::shared_ptr<SwapchainImageVK>& image, uint32_t index);
+  bool Present(const std::shared_ptr<SwapchainImageVK>& image,
+               uint32_t index,
+               const std::optional<IRect>& frame_damage);
+
+  void AccumulateDamage(uint32_t index,
+                        const std::optional<IRect>& frame_damage);
 
   void WaitIdle() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Traces the number of pipeline barriers, and of image barriers
+  ///             in them, encoded since the previous present.
+  ///
+  void TraceBarrierCounts();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Traces how long after they were presented the images that
+  ///             reached the display since the last call did so, and how
+  ///             early their frames were ready.
+  ///
+  void ReportPresentTimings(const vk::Device& device)
+      IPLR_REQUIRES(present_timing_mutex_);
+
   FML_DISALLOW_COPY_AND_ASSIGN(SwapchainImplVK);
 };
 
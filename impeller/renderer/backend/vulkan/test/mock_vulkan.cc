@@ -254,6 +254,39 @@ VkResult vkCreateDescriptorSetLayout(
   return VK_SUCCESS;
 }
 
+VkResult vkCreateDescriptorPool(VkDevice device,
+                                const VkDescriptorPoolCreateInfo* pCreateInfo,
+                                const VkAllocationCallbacks* pAllocator,
+                                VkDescriptorPool* pDescriptorPool) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkCreateDescriptorPool");
+  *pDescriptorPool = reinterpret_cast<VkDescriptorPool>(0x66666666);
+  return VK_SUCCESS;
+}
+
+VkResult vkAllocateDescriptorSets(
+    VkDevice device,
+    const VkDescriptorSetAllocateInfo* pAllocateInfo,
+    VkDescriptorSet* pDescriptorSets) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkAllocateDescriptorSets");
+  static uintptr_t next_descriptor_set = 0x55550000;
+  for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; i++) {
+    pDescriptorSets[i] =
+        reinterpret_cast<VkDescriptorSet>(next_descriptor_set++);
+  }
+  return VK_SUCCESS;
+}
+
+void vkUpdateDescriptorSets(VkDevice device,
+                            uint32_t descriptorWriteCount,
+                            const VkWriteDescriptorSet* pDescriptorWrites,
+                            uint32_t descriptorCopyCount,
+                            const VkCopyDescriptorSet* pDescriptorCopies) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkUpdateDescriptorSets");
+}
+
 VkResult vkCreatePipelineLayout(VkDevice device,
                                 const VkPipelineLayoutCreateInfo* pCreateInfo,
                                 const VkAllocationCallbacks* pAllocator,
@@ -346,6 +379,21 @@ void vkCmdSetViewport(VkCommandBuffer commandBuffer,
   mock_command_buffer->called_functions_->push_back("vkCmdSetViewport");
 }
 
+void vkCmdPipelineBarrier(VkCommandBuffer commandBuffer,
+                          VkPipelineStageFlags srcStageMask,
+                          VkPipelineStageFlags dstStageMask,
+                          VkDependencyFlags dependencyFlags,
+                          uint32_t memoryBarrierCount,
+                          const VkMemoryBarrier* pMemoryBarriers,
+                          uint32_t bufferMemoryBarrierCount,
+                          const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+                          uint32_t imageMemoryBarrierCount,
+                          const VkImageMemoryBarrier* pImageMemoryBarriers) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdPipelineBarrier");
+}
+
 PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
                                             const char* pName) {
   if (strcmp("vkEnumerateInstanceExtensionProperties", pName) == 0) {
@@ -402,6 +450,12 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCreateRenderPass;
   } else if (strcmp("vkCreateDescriptorSetLayout", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateDescriptorSetLayout;
+  } else if (strcmp("vkCreateDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCreateDescriptorPool;
+  } else if (strcmp("vkAllocateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
+  } else if (strcmp("vkUpdateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
   } else if (strcmp("vkCreatePipelineLayout", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreatePipelineLayout;
   } else if (strcmp("vkCreateGraphicsPipelines", pName) == 0) {
@@ -424,6 +478,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCmdSetScissor;
   } else if (strcmp("vkCmdSetViewport", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetViewport;
+  } else if (strcmp("vkCmdPipelineBarrier", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdPipelineBarrier;
   }
   return noop;
 }
@@ -31,7 +31,7 @@ struct BlitCopyTextureToBufferCommand : public BlitCommand {
 struct BlitCopyBufferToTextureCommand : public BlitCommand {
   BufferView source;
   std::shared_ptr<Texture> destination;
-  IPoint destination_origin;
+  IRect destination_region;
 };
 
 struct BlitGenerateMipmapCommand : public BlitCommand {
@@ -94,9 +94,8 @@ bool BlitPass::AddCopy(std::shared_ptr<Texture> source,
     source_region = IRect::MakeSize(source->GetSize());
   }
 
-  auto bytes_per_pixel =
-      BytesPerPixelForPixelFormat(source->GetTextureDescriptor().format);
-  auto bytes_per_image = source_region->size.Area() * bytes_per_pixel;
+  auto bytes_per_image = BytesPerImageForPixelFormat(
+      source->GetTextureDescriptor().format, source_region->size);
   if (destination_offset + bytes_per_image >
       destination->GetDeviceBufferDescriptor().size) {
     VALIDATION_LOG
@@ -118,17 +117,45 @@ bool BlitPass::AddCopy(std::shared_ptr<Texture> source,
 
 bool BlitPass::AddCopy(BufferView source,
                        std::shared_ptr<Texture> destination,
-                       IPoint destination_origin,
+                       std::optional<IRect> destination_region,
                        std::string label) {
   if (!destination) {
     VALIDATION_LOG << "Attempted to add a texture blit with no destination.";
     return false;
   }
 
-  auto bytes_per_pixel =
-      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  const auto texture_bounds =
+      IRect::MakeSize(destination->GetTextureDescriptor().size);
+  if (!destination_region.has_value()) {
+    destination_region = texture_bounds;
+  }
+  if (destination_region->IsEmpty() ||
+      !texture_bounds.Contains(destination_region.value())) {
+    VALIDATION_LOG
+        << "Attempted to add a texture blit with out of bounds access.";
+    return false;
+  }
+
+  const auto format = destination->GetTextureDescriptor().format;
+  if (IsBlockCompressedPixelFormat(format)) {
+    // Blocks can't be partially written, except for the ones that overhang
+    // the edges of the texture.
+    const auto block_size = BlockSizeForPixelFormat(format);
+    const auto region = destination_region.value();
+    if (region.origin.x % block_size != 0 ||
+        region.origin.y % block_size != 0 ||
+        (region.size.width % block_size != 0 &&
+         region.GetRight() != texture_bounds.GetRight()) ||
+        (region.size.height % block_size != 0 &&
+         region.GetBottom() != texture_bounds.GetBottom())) {
+      VALIDATION_LOG << "Attempted to add a texture blit to a region that "
+                        "isn't aligned to the blocks of the texture.";
+      return false;
+    }
+  }
+
   auto bytes_per_image =
-      destination->GetTextureDescriptor().size.Area() * bytes_per_pixel;
+      BytesPerImageForPixelFormat(format, destination_region->size);
 
   if (source.range.length != bytes_per_image) {
     VALIDATION_LOG
@@ -137,7 +164,8 @@ bool BlitPass::AddCopy(BufferView source,
   }
 
   return OnCopyBufferToTextureCommand(std::move(source), std::move(destination),
-                                      destination_origin, std::move(label));
+                                      destination_region.value(),
+                                      std::move(label));
 }
 
 bool BlitPass::GenerateMipmap(std::shared_ptr<Texture> texture,
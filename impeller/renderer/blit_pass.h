@@ -89,11 +89,15 @@ class BlitPass {
   ///             the texture.
   ///             No work is encoded into the command buffer at this time.
   ///
-  /// @param[in]  source              The buffer view to read for copying.
+  /// @param[in]  source              The buffer view to read for copying. It
+  ///                                 must contain tightly packed rows of the
+  ///                                 destination region.
   /// @param[in]  destination         The texture to overwrite using the source
   ///                                 contents.
-  /// @param[in]  destination_offset  The offset to start writing to in the
-  ///                                 destination buffer.
+  /// @param[in]  destination_region  The optional region of the destination
+  ///                                 texture to overwrite. If not specified,
+  ///                                 the full size of the destination texture
+  ///                                 is used.
   /// @param[in]  label               The optional debug label to give the
   ///                                 command.
   ///
@@ -101,7 +105,7 @@ class BlitPass {
   ///
   bool AddCopy(BufferView source,
                std::shared_ptr<Texture> destination,
-               IPoint destination_origin = {},
+               std::optional<IRect> destination_region = std::nullopt,
                std::string label = "");
 
   //----------------------------------------------------------------------------
@@ -150,7 +154,7 @@ class BlitPass {
   virtual bool OnCopyBufferToTextureCommand(
       BufferView source,
       std::shared_ptr<Texture> destination,
-      IPoint destination_origin,
+      IRect destination_region,
       std::string label) = 0;
 
   virtual bool OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
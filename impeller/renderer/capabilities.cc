@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/capabilities.h"
 
+#include <algorithm>
+
 namespace impeller {
 
 Capabilities::Capabilities() = default;
@@ -66,6 +68,11 @@ class StandardCapabilities final : public Capabilities {
     return default_color_format_;
   }
 
+  // |Capabilities|
+  PixelFormat GetDefaultOffscreenColorFormat() const override {
+    return default_offscreen_color_format_;
+  }
+
   // |Capabilities|
   PixelFormat GetDefaultStencilFormat() const override {
     return default_stencil_format_;
@@ -80,6 +87,13 @@ class StandardCapabilities final : public Capabilities {
     return supports_device_transient_textures_;
   }
 
+  // |Capabilities|
+  bool SupportsCompressedPixelFormat(PixelFormat format) const override {
+    return std::find(supported_compressed_pixel_formats_.begin(),
+                     supported_compressed_pixel_formats_.end(),
+                     format) != supported_compressed_pixel_formats_.end();
+  }
+
  private:
   StandardCapabilities(bool supports_offscreen_msaa,
                        bool supports_ssbo,
@@ -92,7 +106,9 @@ class StandardCapabilities final : public Capabilities {
                        bool supports_read_from_resolve,
                        bool supports_decal_sampler_address_mode,
                        bool supports_device_transient_textures,
+                       std::vector<PixelFormat> compressed_pixel_formats,
                        PixelFormat default_color_format,
+                       PixelFormat default_offscreen_color_format,
                        PixelFormat default_stencil_format,
                        PixelFormat default_depth_stencil_format)
       : supports_offscreen_msaa_(supports_offscreen_msaa),
@@ -108,7 +124,10 @@ class StandardCapabilities final : public Capabilities {
         supports_decal_sampler_address_mode_(
             supports_decal_sampler_address_mode),
         supports_device_transient_textures_(supports_device_transient_textures),
+        supported_compressed_pixel_formats_(
+            std::move(compressed_pixel_formats)),
         default_color_format_(default_color_format),
+        default_offscreen_color_format_(default_offscreen_color_format),
         default_stencil_format_(default_stencil_format),
         default_depth_stencil_format_(default_depth_stencil_format) {}
 
@@ -125,7 +144,9 @@ class StandardCapabilities final : public Capabilities {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  std::vector<PixelFormat> supported_compressed_pixel_formats_;
   PixelFormat default_color_format_ = PixelFormat::kUnknown;
+  PixelFormat default_offscreen_color_format_ = PixelFormat::kUnknown;
   PixelFormat default_stencil_format_ = PixelFormat::kUnknown;
   PixelFormat default_depth_stencil_format_ = PixelFormat::kUnknown;
 
@@ -193,6 +214,12 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetDefaultColorFormat(
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetDefaultOffscreenColorFormat(
+    PixelFormat value) {
+  default_offscreen_color_format_ = value;
+  return *this;
+}
+
 CapabilitiesBuilder& CapabilitiesBuilder::SetDefaultStencilFormat(
     PixelFormat value) {
   default_stencil_format_ = value;
@@ -217,6 +244,12 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsDeviceTransientTextures(
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportedCompressedPixelFormats(
+    std::vector<PixelFormat> formats) {
+  supported_compressed_pixel_formats_ = std::move(formats);
+  return *this;
+}
+
 std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
   return std::unique_ptr<StandardCapabilities>(new StandardCapabilities(  //
       supports_offscreen_msaa_,                                           //
@@ -230,7 +263,10 @@ std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
       supports_read_from_resolve_,                                        //
       supports_decal_sampler_address_mode_,                               //
       supports_device_transient_textures_,                                //
+      supported_compressed_pixel_formats_,                                //
       default_color_format_.value_or(PixelFormat::kUnknown),              //
+      default_offscreen_color_format_.value_or(                           //
+          default_color_format_.value_or(PixelFormat::kUnknown)),         //
       default_stencil_format_.value_or(PixelFormat::kUnknown),            //
       default_depth_stencil_format_.value_or(PixelFormat::kUnknown)       //
       ));
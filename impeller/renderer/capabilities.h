@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/formats.h"
@@ -87,10 +88,22 @@ class Capabilities {
   ///         This feature is especially useful for MSAA and stencils.
   virtual bool SupportsDeviceTransientTextures() const = 0;
 
+  /// @brief  Whether the context backend supports creating, uploading to and
+  ///         sampling from textures of the block compressed `format`, such as
+  ///         `PixelFormat::kASTC4x4UNormInt`.
+  virtual bool SupportsCompressedPixelFormat(PixelFormat format) const = 0;
+
   /// @brief  Returns a supported `PixelFormat` for textures that store
   ///         4-channel colors (red/green/blue/alpha).
   virtual PixelFormat GetDefaultColorFormat() const = 0;
 
+  /// @brief  Returns the `PixelFormat` of the offscreen textures that layers
+  ///         and filters are rendered into before being composited. Defaults
+  ///         to `GetDefaultColorFormat`, but may have a smaller range and bit
+  ///         depth when the onscreen format is extended range, which saves
+  ///         bandwidth at the cost of clamping the colors of those layers.
+  virtual PixelFormat GetDefaultOffscreenColorFormat() const = 0;
+
   /// @brief  Returns a supported `PixelFormat` for textures that store stencil
   ///         information. May include a depth channel if a stencil-only format
   ///         is not available.
@@ -135,6 +148,8 @@ class CapabilitiesBuilder {
 
   CapabilitiesBuilder& SetDefaultColorFormat(PixelFormat value);
 
+  CapabilitiesBuilder& SetDefaultOffscreenColorFormat(PixelFormat value);
+
   CapabilitiesBuilder& SetDefaultStencilFormat(PixelFormat value);
 
   CapabilitiesBuilder& SetDefaultDepthStencilFormat(PixelFormat value);
@@ -143,6 +158,9 @@ class CapabilitiesBuilder {
 
   CapabilitiesBuilder& SetSupportsDeviceTransientTextures(bool value);
 
+  CapabilitiesBuilder& SetSupportedCompressedPixelFormats(
+      std::vector<PixelFormat> formats);
+
   std::unique_ptr<Capabilities> Build();
 
  private:
@@ -157,7 +175,9 @@ class CapabilitiesBuilder {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  std::vector<PixelFormat> supported_compressed_pixel_formats_;
   std::optional<PixelFormat> default_color_format_ = std::nullopt;
+  std::optional<PixelFormat> default_offscreen_color_format_ = std::nullopt;
   std::optional<PixelFormat> default_stencil_format_ = std::nullopt;
   std::optional<PixelFormat> default_depth_stencil_format_ = std::nullopt;
 
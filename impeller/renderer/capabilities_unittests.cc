@@ -39,6 +39,22 @@ TEST(CapabilitiesTest, DefaultColorFormat) {
   ASSERT_EQ(mutated->GetDefaultColorFormat(), PixelFormat::kB10G10R10A10XR);
 }
 
+TEST(CapabilitiesTest, DefaultOffscreenColorFormat) {
+  auto defaults = CapabilitiesBuilder()
+                      .SetDefaultColorFormat(PixelFormat::kR16G16B16A16Float)
+                      .Build();
+  ASSERT_EQ(defaults->GetDefaultOffscreenColorFormat(),
+            PixelFormat::kR16G16B16A16Float);
+  auto mutated =
+      CapabilitiesBuilder()
+          .SetDefaultColorFormat(PixelFormat::kR16G16B16A16Float)
+          .SetDefaultOffscreenColorFormat(PixelFormat::kB8G8R8A8UNormInt)
+          .Build();
+  ASSERT_EQ(mutated->GetDefaultColorFormat(), PixelFormat::kR16G16B16A16Float);
+  ASSERT_EQ(mutated->GetDefaultOffscreenColorFormat(),
+            PixelFormat::kB8G8R8A8UNormInt);
+}
+
 TEST(CapabilitiesTest, DefaultStencilFormat) {
   auto defaults = CapabilitiesBuilder().Build();
   ASSERT_EQ(defaults->GetDefaultStencilFormat(), PixelFormat::kUnknown);
@@ -58,5 +74,22 @@ TEST(CapabilitiesTest, DefaultDepthStencilFormat) {
             PixelFormat::kD32FloatS8UInt);
 }
 
+TEST(CapabilitiesTest, SupportedCompressedPixelFormats) {
+  auto defaults = CapabilitiesBuilder().Build();
+  ASSERT_FALSE(
+      defaults->SupportsCompressedPixelFormat(PixelFormat::kASTC4x4UNormInt));
+  auto mutated = CapabilitiesBuilder()
+                     .SetSupportedCompressedPixelFormats(
+                         {PixelFormat::kETC2R8G8B8A8UNormInt,
+                          PixelFormat::kASTC4x4UNormInt})
+                     .Build();
+  ASSERT_TRUE(mutated->SupportsCompressedPixelFormat(
+      PixelFormat::kETC2R8G8B8A8UNormInt));
+  ASSERT_TRUE(
+      mutated->SupportsCompressedPixelFormat(PixelFormat::kASTC4x4UNormInt));
+  ASSERT_FALSE(
+      mutated->SupportsCompressedPixelFormat(PixelFormat::kBC7UNormInt));
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,8 +4,75 @@
 
 #include "impeller/renderer/compute_pipeline_builder.h"
 
+#include <future>
+
+#include "flutter/fml/make_copyable.h"
+#include "impeller/core/shader_types.h"
+#include "impeller/renderer/pipeline_library.h"
+
 namespace impeller {
 
-//
+std::optional<ComputePipelineDescriptor> MakeRuntimeStagePipelineDescriptor(
+    const Context& context,
+    RuntimeStage& stage,
+    const std::vector<DescriptorSetLayout>& descriptor_set_layouts) {
+  if (!stage.IsValid() ||
+      stage.GetShaderStage() != RuntimeShaderStage::kCompute) {
+    VALIDATION_LOG << "Runtime stage is not a valid compute stage.";
+    return std::nullopt;
+  }
+  if (!context.GetCapabilities()->SupportsCompute()) {
+    VALIDATION_LOG << "The context does not support compute.";
+    return std::nullopt;
+  }
+
+  auto library = context.GetShaderLibrary();
+  auto function =
+      library->GetFunction(stage.GetEntrypoint(), ShaderStage::kCompute);
+
+  if (function && stage.IsDirty()) {
+    context.GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
+    library->UnregisterFunction(stage.GetEntrypoint(), ShaderStage::kCompute);
+    function = nullptr;
+  }
+
+  if (!function) {
+    std::promise<bool> promise;
+    auto future = promise.get_future();
+    library->RegisterFunction(
+        stage.GetEntrypoint(), ShaderStage::kCompute, stage.GetCodeMapping(),
+        fml::MakeCopyable([promise = std::move(promise)](bool result) mutable {
+          promise.set_value(result);
+        }));
+    if (!future.get()) {
+      VALIDATION_LOG << "Failed to build runtime compute stage (entry point: "
+                     << stage.GetEntrypoint() << ")";
+      return std::nullopt;
+    }
+
+    function =
+        library->GetFunction(stage.GetEntrypoint(), ShaderStage::kCompute);
+    if (!function) {
+      VALIDATION_LOG << "Failed to fetch runtime compute function immediately "
+                        "after registering it (entry point: "
+                     << stage.GetEntrypoint() << ")";
+      return std::nullopt;
+    }
+    stage.SetClean();
+  }
+
+  ComputePipelineDescriptor desc;
+  desc.SetLabel(SPrintF("%s Runtime Pipeline", stage.GetEntrypoint().c_str()));
+  desc.SetStageEntrypoint(std::move(function));
+  if (!descriptor_set_layouts.empty() &&
+      !desc.RegisterDescriptorSetLayouts(descriptor_set_layouts.data(),
+                                         descriptor_set_layouts.size())) {
+    VALIDATION_LOG << "Could not configure compute descriptor set layout for "
+                      "runtime stage (entry point: "
+                   << stage.GetEntrypoint() << ")";
+    return std::nullopt;
+  }
+  return desc;
+}
 
 }  // namespace impeller
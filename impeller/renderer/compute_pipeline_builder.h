@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/strings.h"
@@ -13,6 +16,7 @@
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/shader_library.h"
 #include "impeller/renderer/vertex_descriptor.h"
+#include "impeller/runtime_stage/runtime_stage.h"
 
 namespace impeller {
 
@@ -82,4 +86,27 @@ struct ComputePipelineBuilder {
   }
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Create a pipeline descriptor for the compute shader of a runtime
+///             stage, such as one loaded from an asset. Unlike shaders built
+///             into the engine, the function of the stage is registered with
+///             the shader library of the context here. It is registered again
+///             if the stage was marked dirty by a hot reload.
+///
+///             Runtime stages don't record the bindings of their storage
+///             buffers. Backends that need descriptor set layouts to create
+///             the pipeline, like Vulkan, use `descriptor_set_layouts`.
+///
+/// @param[in]  context                 The context
+/// @param[in]  stage                   The runtime stage of a compute shader.
+/// @param[in]  descriptor_set_layouts  The resources bound by the shader.
+///
+/// @return     A pipeline descriptor if the stage is a valid compute stage
+///             and its function could be registered.
+///
+std::optional<ComputePipelineDescriptor> MakeRuntimeStagePipelineDescriptor(
+    const Context& context,
+    RuntimeStage& stage,
+    const std::vector<DescriptorSetLayout>& descriptor_set_layouts = {});
+
 }  // namespace impeller
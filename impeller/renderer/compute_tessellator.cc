@@ -84,7 +84,7 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
   PS::Config config{.cubic_accuracy = cubic_accuracy_,
                     .quad_tolerance = quad_tolerance_};
 
-  path.EnumerateComponents(
+  path.IterateComponents(
       [&lines, &components](size_t index, const LinearPathComponent& linear) {
         ::memcpy(&lines.data[lines.count], &linear,
                  sizeof(LinearPathComponent));
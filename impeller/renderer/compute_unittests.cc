@@ -7,6 +7,7 @@
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
 #include "impeller/base/strings.h"
+#include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/fixtures/sample.comp.h"
 #include "impeller/fixtures/stage1.comp.h"
@@ -20,6 +21,7 @@
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/prefix_sum_test.comp.h"
 #include "impeller/renderer/threadgroup_sizing_test.comp.h"
+#include "impeller/runtime_stage/runtime_stage.h"
 
 namespace impeller {
 namespace testing {
@@ -447,6 +449,40 @@ TEST_P(ComputeTest, CanCompute1DimensionalData) {
   latch.Wait();
 }
 
+TEST_P(ComputeTest, CanCreatePipelineFromRuntimeStage) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("The runtime stage fixtures are only built for Metal.");
+  }
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+
+  auto fixture = flutter::testing::OpenFixtureAsMapping("stage1.comp.iplr");
+  ASSERT_TRUE(fixture);
+  RuntimeStage stage(std::move(fixture));
+  ASSERT_TRUE(stage.IsValid());
+  ASSERT_EQ(stage.GetShaderStage(), RuntimeShaderStage::kCompute);
+
+  auto pipeline_desc = MakeRuntimeStagePipelineDescriptor(*context, stage);
+  ASSERT_TRUE(pipeline_desc.has_value());
+  ASSERT_FALSE(stage.IsDirty());
+  auto compute_pipeline =
+      context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  ASSERT_TRUE(compute_pipeline);
+}
+
+TEST_P(ComputeTest, RuntimeStagePipelineRequiresComputeStage) {
+  ScopedValidationDisable disable_validation;
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+
+  auto fixture =
+      flutter::testing::OpenFixtureAsMapping("ink_sparkle.frag.iplr");
+  ASSERT_TRUE(fixture);
+  RuntimeStage stage(std::move(fixture));
+  ASSERT_TRUE(stage.IsValid());
+  ASSERT_FALSE(MakeRuntimeStagePipelineDescriptor(*context, stage).has_value());
+}
+
 TEST_P(ComputeTest, ReturnsEarlyWhenAnyGridDimensionIsZero) {
   using CS = SampleComputeShader;
   auto context = GetContext();
@@ -19,6 +19,7 @@ namespace impeller {
 class ShaderLibrary;
 class SamplerLibrary;
 class CommandBuffer;
+class GPUTracer;
 class PipelineLibrary;
 class Allocator;
 
@@ -170,6 +171,15 @@ class Context {
   ///             backends.
   virtual void SetSyncPresentation(bool value) {}
 
+  //----------------------------------------------------------------------------
+  /// @brief      The tracer that measures the GPU execution time of command
+  ///             buffers with GPU timestamps.
+  ///
+  /// @return     The tracer, or null if the backend can't measure GPU
+  ///             execution times.
+  ///
+  virtual std::shared_ptr<GPUTracer> GetGPUTracer() const { return nullptr; }
+
   //----------------------------------------------------------------------------
   /// @brief Accessor for a pool of HostBuffers.
   Pool<HostBuffer>& GetHostBufferPool() const { return host_buffer_pool_; }
@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/gpu_tracer.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+GPUTracer::GPUTracer() = default;
+
+GPUTracer::~GPUTracer() = default;
+
+void GPUTracer::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+}
+
+void GPUTracer::MarkFrameStart() {
+  if (!enabled_) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  const uint64_t frame = ++last_frame_;
+  auto [current, inserted] =
+      current_frames_.emplace(std::this_thread::get_id(), frame);
+  FML_DCHECK(inserted) << "The previous frame has not ended.";
+  current->second = frame;
+  frames_[frame] = {};
+}
+
+void GPUTracer::MarkFrameEnd(FrameCallback callback) {
+  std::optional<Frame> completed;
+  {
+    std::scoped_lock lock(mutex_);
+    auto current = current_frames_.find(std::this_thread::get_id());
+    if (current == current_frames_.end()) {
+      // The tracer was disabled when the frame started.
+      completed = Frame{.callback = std::move(callback)};
+    } else {
+      const uint64_t frame = current->second;
+      current_frames_.erase(current);
+      Frame& pending = frames_[frame];
+      pending.ended = true;
+      pending.callback = std::move(callback);
+      completed = TakeFrameIfComplete(frame);
+    }
+  }
+  if (completed.has_value() && completed->callback) {
+    completed->callback(completed->result);
+  }
+}
+
+std::optional<uint64_t> GPUTracer::OnCommandBufferCreated() {
+  if (!enabled_) {
+    return std::nullopt;
+  }
+  std::scoped_lock lock(mutex_);
+  auto current = current_frames_.find(std::this_thread::get_id());
+  if (current == current_frames_.end()) {
+    return std::nullopt;
+  }
+  frames_[current->second].pending_command_buffer_count++;
+  return current->second;
+}
+
+void GPUTracer::OnCommandBufferCompleted(
+    uint64_t frame,
+    const std::string& label,
+    std::optional<fml::TimeDelta> gpu_duration) {
+  if (gpu_duration.has_value()) {
+    // GPU timestamps are not in the time domain of the timeline, so the event
+    // ends when the completion was observed.
+    const auto end = fml::TimePoint::Now();
+    fml::tracing::TraceEventAsyncComplete("impeller", "GPUCommandBuffer",
+                                          end - gpu_duration.value(), end,
+                                          "label", label.c_str());
+  }
+
+  std::optional<Frame> completed;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = frames_.find(frame);
+    if (found == frames_.end()) {
+      FML_DLOG(ERROR) << "Command buffer completed for an unknown frame.";
+      return;
+    }
+    Frame& pending = found->second;
+    FML_DCHECK(pending.pending_command_buffer_count > 0);
+    pending.pending_command_buffer_count--;
+    if (gpu_duration.has_value()) {
+      pending.result.gpu_duration = pending.result.gpu_duration + *gpu_duration;
+      pending.result.command_buffer_count++;
+    }
+    completed = TakeFrameIfComplete(frame);
+  }
+  if (completed.has_value() && completed->callback) {
+    completed->callback(completed->result);
+  }
+}
+
+std::optional<GPUTracer::Frame> GPUTracer::TakeFrameIfComplete(
+    uint64_t frame) {
+  auto found = frames_.find(frame);
+  if (found == frames_.end() || !found->second.ended ||
+      found->second.pending_command_buffer_count > 0) {
+    return std::nullopt;
+  }
+  Frame completed = std::move(found->second);
+  frames_.erase(found);
+  if (completed.result.command_buffer_count > 0) {
+    FML_TRACE_COUNTER("impeller", "GPUFrameTime",
+                      reinterpret_cast<int64_t>(this), "microseconds",
+                      completed.result.gpu_duration.ToMicroseconds());
+  }
+  return completed;
+}
+
+}  // namespace impeller
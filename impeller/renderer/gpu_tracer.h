@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the GPU execution times of the command buffers of a
+///             frame, as measured by the backend with GPU timestamps.
+///
+///             A frame is the work recorded on one thread between
+///             `MarkFrameStart` and `MarkFrameEnd`. Command buffers created on
+///             other threads, for example to upload images, are not part of
+///             the frame.
+///
+///             The tracer is disabled until `SetEnabled` is called, in which
+///             case the backends don't measure anything.
+///
+///             Frames of different threads, for example of the rasterizers of
+///             several engines sharing a context, are recorded independently.
+///             Command buffers may complete on any thread.
+///
+class GPUTracer {
+ public:
+  struct FrameResult {
+    /// The sum of the GPU execution times of the command buffers of the
+    /// frame.
+    fml::TimeDelta gpu_duration;
+    size_t command_buffer_count = 0;
+  };
+
+  using FrameCallback = std::function<void(const FrameResult&)>;
+
+  GPUTracer();
+
+  ~GPUTracer();
+
+  void SetEnabled(bool enabled);
+
+  bool IsEnabled() const { return enabled_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts recording the command buffers created on the calling
+  ///             thread as part of a new frame.
+  ///
+  void MarkFrameStart();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops recording the command buffers of the frame of the
+  ///             calling thread.
+  ///
+  /// @param[in]  callback  Called once all the command buffers of the frame
+  ///                       have completed, on the thread the last one
+  ///                       completed on, or right away if they already have.
+  ///                       May be null.
+  ///
+  void MarkFrameEnd(FrameCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the backends when a command buffer is created.
+  ///
+  /// @return     The frame the command buffer belongs to, if it should be
+  ///             measured. Each frame that is returned must be passed to
+  ///             `OnCommandBufferCompleted` exactly once.
+  ///
+  std::optional<uint64_t> OnCommandBufferCreated();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the backends when a measured command buffer has
+  ///             completed on the GPU, or could not be submitted.
+  ///
+  /// @param[in]  frame         The frame the command buffer belongs to.
+  /// @param[in]  label         The label of the command buffer, used in the
+  ///                           timeline.
+  /// @param[in]  gpu_duration  How long the command buffer executed on the
+  ///                           GPU, if it could be measured.
+  ///
+  void OnCommandBufferCompleted(uint64_t frame,
+                                const std::string& label,
+                                std::optional<fml::TimeDelta> gpu_duration);
+
+ private:
+  struct Frame {
+    size_t pending_command_buffer_count = 0;
+    bool ended = false;
+    FrameResult result;
+    FrameCallback callback;
+  };
+
+  std::atomic_bool enabled_ = false;
+  std::mutex mutex_;
+  uint64_t last_frame_ = 0;
+  // The frames being recorded, by the thread they are recorded on.
+  std::map<std::thread::id, uint64_t> current_frames_;
+  std::map<uint64_t, Frame> frames_;
+
+  // Removes and returns the frame if it has ended and all its command buffers
+  // have completed. Must be called with the mutex held.
+  std::optional<Frame> TakeFrameIfComplete(uint64_t frame);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracer);
+};
+
+}  // namespace impeller
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <optional>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(GPUTracerTest, DisabledTracerMeasuresNothing) {
+  GPUTracer tracer;
+  tracer.MarkFrameStart();
+  EXPECT_FALSE(tracer.OnCommandBufferCreated().has_value());
+
+  std::optional<GPUTracer::FrameResult> result;
+  tracer.MarkFrameEnd(
+      [&result](const GPUTracer::FrameResult& frame) { result = frame; });
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->command_buffer_count, 0u);
+}
+
+TEST(GPUTracerTest, ReportsFrameOnceAllCommandBuffersCompleted) {
+  GPUTracer tracer;
+  tracer.SetEnabled(true);
+  EXPECT_FALSE(tracer.OnCommandBufferCreated().has_value());
+
+  tracer.MarkFrameStart();
+  auto first = tracer.OnCommandBufferCreated();
+  auto second = tracer.OnCommandBufferCreated();
+  auto third = tracer.OnCommandBufferCreated();
+  ASSERT_TRUE(first.has_value());
+  ASSERT_EQ(first, second);
+
+  // Command buffers created on other threads are not part of the frame.
+  std::optional<uint64_t> other_thread;
+  std::thread([&]() { other_thread = tracer.OnCommandBufferCreated(); })
+      .join();
+  EXPECT_FALSE(other_thread.has_value());
+
+  tracer.OnCommandBufferCompleted(*first, "first",
+                                  fml::TimeDelta::FromMilliseconds(3));
+
+  std::optional<GPUTracer::FrameResult> result;
+  tracer.MarkFrameEnd(
+      [&result](const GPUTracer::FrameResult& frame) { result = frame; });
+  EXPECT_FALSE(tracer.OnCommandBufferCreated().has_value());
+  EXPECT_FALSE(result.has_value());
+
+  tracer.OnCommandBufferCompleted(*second, "second",
+                                  fml::TimeDelta::FromMilliseconds(2));
+  EXPECT_FALSE(result.has_value());
+  // A command buffer that could not be measured.
+  tracer.OnCommandBufferCompleted(*third, "third", std::nullopt);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->gpu_duration, fml::TimeDelta::FromMilliseconds(5));
+  EXPECT_EQ(result->command_buffer_count, 2u);
+}
+
+TEST(GPUTracerTest, FramesCompleteIndependently) {
+  GPUTracer tracer;
+  tracer.SetEnabled(true);
+
+  tracer.MarkFrameStart();
+  auto first_frame = tracer.OnCommandBufferCreated();
+  size_t first_count = 0;
+  tracer.MarkFrameEnd(
+      [&first_count](const GPUTracer::FrameResult&) { first_count++; });
+
+  tracer.MarkFrameStart();
+  auto second_frame = tracer.OnCommandBufferCreated();
+  size_t second_count = 0;
+  tracer.MarkFrameEnd(
+      [&second_count](const GPUTracer::FrameResult&) { second_count++; });
+  ASSERT_NE(first_frame, second_frame);
+
+  tracer.OnCommandBufferCompleted(*second_frame, "second",
+                                  fml::TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(first_count, 0u);
+  EXPECT_EQ(second_count, 1u);
+  tracer.OnCommandBufferCompleted(*first_frame, "first",
+                                  fml::TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(first_count, 1u);
+  EXPECT_EQ(second_count, 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -3,11 +3,52 @@
 // found in the LICENSE file.
 
 #include "flutter/testing/testing.h"
+#include "gmock/gmock.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/renderer/testing/mocks.h"
 
 namespace impeller {
 namespace testing {
 
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+
+class CountingAllocator : public Allocator {
+ public:
+  size_t buffer_count() const { return buffer_count_; }
+
+  ISize GetMaxTextureSizeSupported() const override {
+    return ISize(1024, 1024);
+  }
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    buffer_count_++;
+    auto buffer = std::make_shared<NiceMock<MockDeviceBuffer>>(desc);
+    ON_CALL(*buffer, OnCopyHostBuffer).WillByDefault(Return(true));
+    return buffer;
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+
+ private:
+  size_t buffer_count_ = 0;
+};
+
+std::shared_ptr<const DeviceBuffer> Upload(
+    const std::shared_ptr<HostBuffer>& host_buffer,
+    Allocator& allocator) {
+  std::shared_ptr<const Buffer> buffer = host_buffer;
+  return buffer->GetDeviceBuffer(allocator);
+}
+
+}  // namespace
+
 TEST(HostBufferTest, TestInitialization) {
   ASSERT_TRUE(HostBuffer::Create());
   // Newly allocated buffers don't touch the heap till they have to.
@@ -75,5 +116,36 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST(HostBufferTest, ReusesDeviceBuffersTheGPUIsDoneWith) {
+  struct Length16 {
+    uint8_t pad[16];
+  };
+  CountingAllocator allocator;
+  auto buffer = HostBuffer::Create();
+
+  ASSERT_TRUE(buffer->Emplace(Length16{}));
+  auto first = Upload(buffer, allocator);
+  ASSERT_TRUE(first);
+  ASSERT_EQ(allocator.buffer_count(), 1u);
+
+  // The first device buffer is still referenced, as by a command buffer in
+  // flight, so the next contents get another one.
+  buffer->Reset();
+  ASSERT_TRUE(buffer->Emplace(Length16{}));
+  auto second = Upload(buffer, allocator);
+  ASSERT_TRUE(second);
+  ASSERT_NE(first, second);
+  ASSERT_EQ(allocator.buffer_count(), 2u);
+
+  // Once released, it is written again instead of allocating.
+  auto* released = first.get();
+  first.reset();
+  buffer->Reset();
+  ASSERT_TRUE(buffer->Emplace(Length16{}));
+  auto third = Upload(buffer, allocator);
+  ASSERT_EQ(third.get(), released);
+  ASSERT_EQ(allocator.buffer_count(), 2u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
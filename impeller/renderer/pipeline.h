@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <future>
 
 #include "compute_pipeline_descriptor.h"
+#include "flutter/fml/frame_cost_ledger.h"
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/compute_pipeline_builder.h"
 #include "impeller/renderer/compute_pipeline_descriptor.h"
@@ -28,6 +30,12 @@ struct PipelineFuture {
   const std::shared_ptr<Pipeline<T>> Get() const { return future.get(); }
 
   bool IsValid() const { return future.valid(); }
+
+  /// @brief  Whether `Get` returns without blocking.
+  bool IsReady() const {
+    return future.valid() && future.wait_for(std::chrono::seconds(0)) ==
+                                 std::future_status::ready;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -109,11 +117,20 @@ class RenderPipelineT {
     }
     did_wait_ = true;
     if (pipeline_future_.IsValid()) {
+      // Only the first wait may block on the compilation of the pipeline.
+      fml::ScopedFrameCost cost(
+          fml::FrameCostLedger::Category::kPipelineCompile);
       pipeline_ = pipeline_future_.Get();
     }
     return pipeline_;
   }
 
+  /// @brief  Whether `WaitAndGet` returns without blocking.
+  bool IsReady() const {
+    return did_wait_ || !pipeline_future_.IsValid() ||
+           pipeline_future_.IsReady();
+  }
+
   std::optional<PipelineDescriptor> GetDescriptor() const {
     return pipeline_future_.descriptor;
   }
@@ -42,6 +42,9 @@ std::size_t PipelineDescriptor::GetHash() const {
   fml::HashCombineSeed(seed, cull_mode_);
   fml::HashCombineSeed(seed, primitive_type_);
   fml::HashCombineSeed(seed, polygon_mode_);
+  for (const auto& constant : specialization_constants_) {
+    fml::HashCombineSeed(seed, constant);
+  }
   return seed;
 }
 
@@ -61,7 +64,8 @@ bool PipelineDescriptor::IsEqual(const PipelineDescriptor& other) const {
          winding_order_ == other.winding_order_ &&
          cull_mode_ == other.cull_mode_ &&
          primitive_type_ == other.primitive_type_ &&
-         polygon_mode_ == other.polygon_mode_;
+         polygon_mode_ == other.polygon_mode_ &&
+         specialization_constants_ == other.specialization_constants_;
 }
 
 PipelineDescriptor& PipelineDescriptor::SetLabel(std::string label) {
@@ -277,4 +281,14 @@ PolygonMode PipelineDescriptor::GetPolygonMode() const {
   return polygon_mode_;
 }
 
+void PipelineDescriptor::SetSpecializationConstants(
+    std::vector<Scalar> values) {
+  specialization_constants_ = std::move(values);
+}
+
+const std::vector<Scalar>& PipelineDescriptor::GetSpecializationConstants()
+    const {
+  return specialization_constants_;
+}
+
 }  // namespace impeller
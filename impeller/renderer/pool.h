@@ -4,51 +4,161 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
 
 namespace impeller {
 
-/// @brief A thread-safe pool with a limited byte size.
+/// @brief A thread-safe, lock-free pool with a limited byte size.
+///
+///        Objects are stored in a bounded multi-producer multi-consumer ring
+///        buffer. Each slot carries a sequence number so that producers and
+///        consumers only ever contend on a single compare-and-swap of the
+///        head or tail cursor. The byte budget is reserved with a
+///        compare-and-swap before an object is enqueued, which keeps the same
+///        limit semantics as a mutex guarded vector.
+///
 /// @tparam T The type that the pool will contain.
 template <typename T>
 class Pool {
  public:
-  Pool(uint32_t limit_bytes) : limit_bytes_(limit_bytes), size_(0) {}
+  static constexpr size_t kDefaultCapacity = 128u;
+
+  explicit Pool(uint32_t limit_bytes, size_t capacity = kDefaultCapacity)
+      : limit_bytes_(limit_bytes),
+        mask_(RoundUpToPowerOfTwo(capacity) - 1u),
+        slots_(mask_ + 1u) {
+    for (size_t i = 0; i < slots_.size(); i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~Pool() = default;
 
   std::shared_ptr<T> Grab() {
-    std::scoped_lock lock(mutex_);
-    if (pool_.empty()) {
+    std::shared_ptr<T> result;
+    if (!Dequeue(result)) {
       return T::Create();
     }
-    std::shared_ptr<T> result = std::move(pool_.back());
-    pool_.pop_back();
-    size_ -= result->GetSize();
+    size_.fetch_sub(result->GetSize(), std::memory_order_relaxed);
     return result;
   }
 
   void Recycle(std::shared_ptr<T> object) {
-    std::scoped_lock lock(mutex_);
-    size_t object_size = object->GetSize();
-    if (size_ + object_size <= limit_bytes_ &&
-        object_size < (limit_bytes_ / 2)) {
-      object->Reset();
-      size_ += object_size;
-      pool_.emplace_back(std::move(object));
+    const size_t object_size = object->GetSize();
+    if (object_size >= (limit_bytes_ / 2)) {
+      return;
+    }
+    if (!ReserveBytes(object_size)) {
+      return;
+    }
+    object->Reset();
+    // Reset may release or allocate memory; account for what the pool
+    // actually holds.
+    const size_t reset_size = object->GetSize();
+    if (reset_size < object_size) {
+      size_.fetch_sub(object_size - reset_size, std::memory_order_relaxed);
+    } else if (reset_size > object_size &&
+               !ReserveBytes(reset_size - object_size)) {
+      // The object grew past the limit. Drop it and give the bytes back.
+      size_.fetch_sub(object_size, std::memory_order_relaxed);
+      return;
+    }
+    if (!Enqueue(std::move(object))) {
+      // The ring is full. Drop the object and give the bytes back.
+      size_.fetch_sub(reset_size, std::memory_order_relaxed);
     }
   }
 
-  uint32_t GetSize() const {
-    std::scoped_lock lock(mutex_);
-    return size_;
-  }
+  uint32_t GetSize() const { return size_.load(std::memory_order_relaxed); }
+
+  size_t GetCapacity() const { return slots_.size(); }
 
  private:
-  std::vector<std::shared_ptr<T>> pool_;
+  struct alignas(64) Slot {
+    std::atomic<size_t> sequence = 0u;
+    std::shared_ptr<T> value;
+  };
+
   const uint32_t limit_bytes_;
-  uint32_t size_;
-  // Note: This would perform better as a lockless ring buffer.
-  mutable std::mutex mutex_;
+  const size_t mask_;
+  std::vector<Slot> slots_;
+  alignas(64) std::atomic<size_t> enqueue_pos_ = 0u;
+  alignas(64) std::atomic<size_t> dequeue_pos_ = 0u;
+  alignas(64) std::atomic<uint32_t> size_ = 0u;
+
+  static size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t result = 1u;
+    while (result < value) {
+      result <<= 1u;
+    }
+    return result;
+  }
+
+  bool ReserveBytes(size_t bytes) {
+    uint32_t current = size_.load(std::memory_order_relaxed);
+    do {
+      if (current + bytes > limit_bytes_) {
+        return false;
+      }
+    } while (!size_.compare_exchange_weak(current, current + bytes,
+                                          std::memory_order_relaxed));
+    return true;
+  }
+
+  bool Enqueue(std::shared_ptr<T> object) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::move(object);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool Dequeue(std::shared_ptr<T>& object) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    object = std::move(slot->value);
+    slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Pool);
 };
 
 }  // namespace impeller
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "impeller/renderer/pool.h"
+
+namespace impeller {
+
+namespace {
+
+class Foobar {
+ public:
+  static std::shared_ptr<Foobar> Create() { return std::make_shared<Foobar>(); }
+
+  size_t GetSize() const { return 1'024u; }
+
+  void Reset() {}
+};
+
+/// The mutex guarded pool that |Pool| replaced, kept here as a baseline.
+template <typename T>
+class MutexPool {
+ public:
+  explicit MutexPool(uint32_t limit_bytes) : limit_bytes_(limit_bytes) {}
+
+  std::shared_ptr<T> Grab() {
+    std::scoped_lock lock(mutex_);
+    if (pool_.empty()) {
+      return T::Create();
+    }
+    std::shared_ptr<T> result = std::move(pool_.back());
+    pool_.pop_back();
+    size_ -= result->GetSize();
+    return result;
+  }
+
+  void Recycle(std::shared_ptr<T> object) {
+    std::scoped_lock lock(mutex_);
+    size_t object_size = object->GetSize();
+    if (size_ + object_size <= limit_bytes_ &&
+        object_size < (limit_bytes_ / 2)) {
+      object->Reset();
+      size_ += object_size;
+      pool_.emplace_back(std::move(object));
+    }
+  }
+
+ private:
+  std::vector<std::shared_ptr<T>> pool_;
+  const uint32_t limit_bytes_;
+  uint32_t size_ = 0u;
+  std::mutex mutex_;
+};
+
+}  // namespace
+
+template <class PoolType>
+static void BM_GrabRecycle(benchmark::State& state) {
+  static PoolType* pool = nullptr;
+  if (state.thread_index() == 0) {
+    pool = new PoolType(1'000'000);
+  }
+  // Each iteration mimics a render pass grabbing a transients buffer and
+  // returning it when the pass is destroyed.
+  for (auto _ : state) {
+    auto buffer = pool->Grab();
+    benchmark::DoNotOptimize(buffer);
+    pool->Recycle(std::move(buffer));
+  }
+  if (state.thread_index() == 0) {
+    delete pool;
+    pool = nullptr;
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_GrabRecycle, MutexPool<Foobar>)->ThreadRange(1, 16);
+BENCHMARK_TEMPLATE(BM_GrabRecycle, Pool<Foobar>)->ThreadRange(1, 16);
+
+}  // namespace impeller
@@ -2,6 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <optional>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "impeller/renderer/pool.h"
@@ -18,14 +22,22 @@ class Foobar {
 
   void SetSize(size_t size) { size_ = size; }
 
-  void Reset() { is_reset_ = true; }
+  void Reset() {
+    is_reset_ = true;
+    if (size_after_reset_.has_value()) {
+      size_ = size_after_reset_.value();
+    }
+  }
+
+  void SetSizeAfterReset(size_t size) { size_after_reset_ = size; }
 
   bool GetIsReset() const { return is_reset_; }
 
   void SetIsReset(bool is_reset) { is_reset_ = is_reset; }
 
  private:
-  size_t size_;
+  size_t size_ = 0u;
+  std::optional<size_t> size_after_reset_;
   bool is_reset_ = false;
 };
 }  // namespace
@@ -59,5 +71,79 @@ TEST(PoolTest, Overload) {
   EXPECT_EQ(pool.GetSize(), 1'000u);
 }
 
+TEST(PoolTest, AccountsForTheSizeAfterReset) {
+  Pool<Foobar> pool(1'000);
+  // Shrinks on reset.
+  auto shrinking = pool.Grab();
+  shrinking->SetSize(300);
+  shrinking->SetSizeAfterReset(100);
+  pool.Recycle(shrinking);
+  EXPECT_EQ(pool.GetSize(), 100u);
+
+  // Grows on reset.
+  auto growing = Foobar::Create();
+  growing->SetSize(100);
+  growing->SetSizeAfterReset(300);
+  pool.Recycle(growing);
+  EXPECT_EQ(pool.GetSize(), 400u);
+
+  // Grows past the limit on reset, and is dropped.
+  auto overgrowing = Foobar::Create();
+  overgrowing->SetSize(100);
+  overgrowing->SetSizeAfterReset(700);
+  pool.Recycle(overgrowing);
+  EXPECT_EQ(pool.GetSize(), 400u);
+
+  EXPECT_EQ(pool.Grab(), shrinking);
+  EXPECT_EQ(pool.Grab(), growing);
+  EXPECT_EQ(pool.GetSize(), 0u);
+  EXPECT_FALSE(pool.Grab()->GetIsReset());
+}
+
+TEST(PoolTest, CapacityBoundsEntries) {
+  Pool<Foobar> pool(1'000, /*capacity=*/4);
+  EXPECT_EQ(pool.GetCapacity(), 4u);
+  {
+    std::vector<std::shared_ptr<Foobar>> values;
+    for (int i = 0; i < 8; i++) {
+      values.push_back(pool.Grab());
+    }
+    for (auto value : values) {
+      value->SetSize(10);
+      pool.Recycle(value);
+    }
+  }
+  // Entries that do not fit in the ring give their bytes back.
+  EXPECT_EQ(pool.GetSize(), 40u);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(pool.Grab()->GetIsReset());
+  }
+  EXPECT_EQ(pool.GetSize(), 0u);
+  EXPECT_FALSE(pool.Grab()->GetIsReset());
+}
+
+TEST(PoolTest, ConcurrentGrabAndRecycle) {
+  Pool<Foobar> pool(100'000);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&pool] {
+      for (int i = 0; i < 1'000; i++) {
+        auto value = pool.Grab();
+        value->SetSize(10);
+        pool.Recycle(value);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(pool.GetSize() % 10u, 0u);
+  // Draining the pool must return the byte accounting to zero.
+  while (pool.GetSize() > 0u) {
+    EXPECT_TRUE(pool.Grab()->GetIsReset());
+  }
+  EXPECT_EQ(pool.GetSize(), 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -43,6 +43,22 @@ void RenderPass::SetLabel(std::string label) {
   OnSetLabel(std::move(label));
 }
 
+void RenderPass::SetStencilStoreAction(StoreAction action) {
+  auto stencil = render_target_.GetStencilAttachment();
+  if (!stencil.has_value() || stencil->store_action == action) {
+    return;
+  }
+  stencil->store_action = action;
+  render_target_.SetStencilAttachment(stencil.value());
+  OnSetStencilStoreAction(action);
+}
+
+void RenderPass::OnSetStencilStoreAction(StoreAction action) {}
+
+void RenderPass::SetScissor(std::optional<IRect> scissor) {
+  scissor_ = scissor;
+}
+
 bool RenderPass::AddCommand(Command&& command) {
   if (!command) {
     VALIDATION_LOG << "Attempted to add an invalid command to the render pass.";
@@ -58,6 +74,16 @@ bool RenderPass::AddCommand(Command&& command) {
     }
   }
 
+  if (scissor_.has_value()) {
+    command.scissor = command.scissor.has_value()
+                          ? command.scissor->Intersection(scissor_.value())
+                          : scissor_;
+    if (!command.scissor.has_value()) {
+      // The command doesn't touch any pixel that is drawn to.
+      return true;
+    }
+  }
+
   if (command.vertex_count == 0u) {
     // Essentially a no-op. Don't record the command but this is not necessary
     // an error either.
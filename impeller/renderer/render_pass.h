@@ -49,6 +49,16 @@ class RenderPass {
   ///
   bool AddCommand(Command&& command);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Limit the commands added after this call to a rectangle of the
+  ///             render target, on top of any scissor set on the commands
+  ///             themselves. Commands outside of it are dropped.
+  ///
+  /// @param[in]  scissor  The scissor, or `std::nullopt` to stop limiting
+  ///                      the commands.
+  ///
+  void SetScissor(std::optional<IRect> scissor);
+
   //----------------------------------------------------------------------------
   /// @brief      Encode the recorded commands to the underlying command buffer.
   ///
@@ -57,6 +67,18 @@ class RenderPass {
   ///
   bool EncodeCommands() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Change the store action of the stencil attachment. Must be
+  ///             called before the commands are encoded.
+  ///
+  ///             The owner of the pass may only learn that the stencil
+  ///             contents won't be needed by later passes after recording the
+  ///             commands of this one.
+  ///
+  /// @param[in]  action  The store action.
+  ///
+  void SetStencilStoreAction(StoreAction action);
+
   //----------------------------------------------------------------------------
   /// @brief      Accessor for the current Commands.
   ///
@@ -66,9 +88,10 @@ class RenderPass {
 
  protected:
   const std::weak_ptr<const Context> context_;
-  const RenderTarget render_target_;
+  RenderTarget render_target_;
   std::shared_ptr<HostBuffer> transients_buffer_;
   std::vector<Command> commands_;
+  std::optional<IRect> scissor_;
 
   RenderPass(std::weak_ptr<const Context> context, const RenderTarget& target);
 
@@ -76,6 +99,8 @@ class RenderPass {
 
   virtual void OnSetLabel(std::string label) = 0;
 
+  virtual void OnSetStencilStoreAction(StoreAction action);
+
   virtual bool OnEncodeCommands(const Context& context) const = 0;
 
  private:
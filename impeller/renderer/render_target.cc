@@ -22,9 +22,13 @@ void RenderTargetAllocator::Start() {}
 
 void RenderTargetAllocator::End() {}
 
+void RenderTargetAllocator::Purge() {}
+
 std::shared_ptr<Texture> RenderTargetAllocator::CreateTexture(
     const TextureDescriptor& desc) {
-  return allocator_->CreateTexture(desc);
+  auto offscreen_desc = desc;
+  offscreen_desc.tag = AllocationTag::kOffscreen;
+  return allocator_->CreateTexture(offscreen_desc);
 }
 
 RenderTarget::RenderTarget() = default;
@@ -226,7 +230,8 @@ RenderTarget RenderTarget::CreateOffscreen(
     ISize size,
     const std::string& label,
     AttachmentConfig color_attachment_config,
-    std::optional<AttachmentConfig> stencil_attachment_config) {
+    std::optional<AttachmentConfig> stencil_attachment_config,
+    PixelFormat color_format) {
   if (size.IsEmpty()) {
     return {};
   }
@@ -237,7 +242,10 @@ RenderTarget RenderTarget::CreateOffscreen(
 #endif  // FML_OS_ANDROID
 
   RenderTarget target;
-  PixelFormat pixel_format = context.GetCapabilities()->GetDefaultColorFormat();
+  PixelFormat pixel_format =
+      color_format == PixelFormat::kUnknown
+          ? context.GetCapabilities()->GetDefaultColorFormat()
+          : color_format;
   TextureDescriptor color_tex0;
   color_tex0.storage_mode = color_attachment_config.storage_mode;
   color_tex0.format = pixel_format;
@@ -273,7 +281,8 @@ RenderTarget RenderTarget::CreateOffscreenMSAA(
     ISize size,
     const std::string& label,
     AttachmentConfigMSAA color_attachment_config,
-    std::optional<AttachmentConfig> stencil_attachment_config) {
+    std::optional<AttachmentConfig> stencil_attachment_config,
+    PixelFormat color_format) {
   if (size.IsEmpty()) {
     return {};
   }
@@ -284,7 +293,10 @@ RenderTarget RenderTarget::CreateOffscreenMSAA(
 #endif  // FML_OS_ANDROID
 
   RenderTarget target;
-  PixelFormat pixel_format = context.GetCapabilities()->GetDefaultColorFormat();
+  PixelFormat pixel_format =
+      color_format == PixelFormat::kUnknown
+          ? context.GetCapabilities()->GetDefaultColorFormat()
+          : color_format;
 
   // Create MSAA color texture.
 
@@ -41,6 +41,10 @@ class RenderTargetAllocator {
   ///        This may be used to deallocate any unused textures.
   virtual void End();
 
+  /// @brief Release any textures that are kept for later frames, such as
+  ///        when the system is low on memory.
+  virtual void Purge();
+
  private:
   std::shared_ptr<Allocator> allocator_;
 };
@@ -81,6 +85,8 @@ class RenderTarget final {
       .store_action = StoreAction::kDontCare,
       .clear_color = Color::BlackTransparent()};
 
+  /// The color texture has the `color_format`, or the default color format of
+  /// the context if it is `PixelFormat::kUnknown`.
   static RenderTarget CreateOffscreen(
       const Context& context,
       RenderTargetAllocator& allocator,
@@ -88,8 +94,11 @@ class RenderTarget final {
       const std::string& label = "Offscreen",
       AttachmentConfig color_attachment_config = kDefaultColorAttachmentConfig,
       std::optional<AttachmentConfig> stencil_attachment_config =
-          kDefaultStencilAttachmentConfig);
+          kDefaultStencilAttachmentConfig,
+      PixelFormat color_format = PixelFormat::kUnknown);
 
+  /// The color textures have the `color_format`, or the default color format
+  /// of the context if it is `PixelFormat::kUnknown`.
   static RenderTarget CreateOffscreenMSAA(
       const Context& context,
       RenderTargetAllocator& allocator,
@@ -98,7 +107,8 @@ class RenderTarget final {
       AttachmentConfigMSAA color_attachment_config =
           kDefaultColorAttachmentConfigMSAA,
       std::optional<AttachmentConfig> stencil_attachment_config =
-          kDefaultStencilAttachmentConfig);
+          kDefaultStencilAttachmentConfig,
+      PixelFormat color_format = PixelFormat::kUnknown);
 
   RenderTarget();
 
@@ -38,4 +38,16 @@ bool Surface::Present() const {
   return false;
 };
 
+std::optional<IRect> Surface::GetExistingDamage() const {
+  return std::nullopt;
+}
+
+void Surface::SetFrameDamage(std::optional<IRect> frame_damage) {
+  frame_damage_ = frame_damage;
+}
+
+const std::optional<IRect>& Surface::GetFrameDamage() const {
+  return frame_damage_;
+}
+
 }  // namespace impeller
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/context.h"
@@ -30,9 +31,33 @@ class Surface {
 
   virtual bool Present() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The area of this surface that lags behind the last presented
+  ///             frame, for surfaces that keep their contents between frames.
+  ///
+  /// @return     The stale area, or std::nullopt if the contents of the
+  ///             surface are unknown and all of it must be redrawn.
+  ///
+  virtual std::optional<IRect> GetExistingDamage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Set the area that changed since the last presented frame.
+  ///             Surfaces that keep their contents between frames use it to
+  ///             track the damage of their other buffers and to hint the
+  ///             presentation engine when this surface is presented.
+  ///
+  /// @param[in]  frame_damage  The changed area, or std::nullopt if the
+  ///                           whole surface changed.
+  ///
+  void SetFrameDamage(std::optional<IRect> frame_damage);
+
+ protected:
+  const std::optional<IRect>& GetFrameDamage() const;
+
  private:
   RenderTarget desc_;
   ISize size_;
+  std::optional<IRect> frame_damage_;
 
   bool is_valid_ = false;
 
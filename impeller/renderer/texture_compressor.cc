@@ -0,0 +1,173 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/texture_compressor.h"
+
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/image/etc2_encoder.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+
+namespace impeller {
+
+static constexpr PixelFormat kCompressedFormat =
+    PixelFormat::kETC2R8G8B8A8UNormInt;
+
+static bool IsBGRA(PixelFormat format) {
+  return format == PixelFormat::kB8G8R8A8UNormInt;
+}
+
+static std::shared_ptr<fml::Mapping> Encode(
+    const DeviceBuffer& pixels,
+    const TextureDescriptor& source_desc) {
+  TRACE_EVENT0("impeller", "TextureCompressor::Encode");
+  std::vector<uint8_t> blocks(GetETC2RGBA8ByteSize(source_desc.size));
+  if (!EncodeETC2RGBA8(pixels.AsBufferView().contents, source_desc.size,
+                       source_desc.GetBytesPerRow(),
+                       IsBGRA(source_desc.format), blocks.data())) {
+    VALIDATION_LOG << "Could not encode the texture.";
+    return nullptr;
+  }
+  return std::make_shared<fml::DataMapping>(std::move(blocks));
+}
+
+std::shared_ptr<Texture> TextureCompressor::Upload(
+    const std::shared_ptr<Context>& context,
+    ISize size,
+    const fml::Mapping& blocks) {
+  TRACE_EVENT0("impeller", "TextureCompressor::Upload");
+  if (!context ||
+      !context->GetCapabilities()->SupportsBufferToTextureBlits() ||
+      !context->GetCapabilities()->SupportsCompressedPixelFormat(
+          kCompressedFormat) ||
+      size.IsEmpty() || blocks.GetSize() != GetETC2RGBA8ByteSize(size)) {
+    return nullptr;
+  }
+
+  const auto& allocator = context->GetResourceAllocator();
+  auto buffer = allocator->CreateBufferWithCopy(
+      blocks.GetMapping(), blocks.GetSize(), AllocationTag::kCompressed);
+  if (!buffer) {
+    VALIDATION_LOG << "Could not create the compressed staging buffer.";
+    return nullptr;
+  }
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = kCompressedFormat;
+  desc.size = size;
+  desc.mip_count = 1u;
+  desc.tag = AllocationTag::kCompressed;
+  auto texture = allocator->CreateTexture(desc);
+  if (!texture) {
+    VALIDATION_LOG << "Could not create the compressed texture.";
+    return nullptr;
+  }
+  texture->SetLabel("Compressed Texture");
+
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return nullptr;
+  }
+  command_buffer->SetLabel("Compressed Texture Upload Command Buffer");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return nullptr;
+  }
+  blit_pass->SetLabel("Compressed Texture Upload Blit Pass");
+  if (!blit_pass->AddCopy(buffer->AsBufferView(), texture) ||
+      !blit_pass->EncodeCommands(allocator) ||
+      !command_buffer->SubmitCommands()) {
+    VALIDATION_LOG << "Could not upload the compressed texture.";
+    return nullptr;
+  }
+  return texture;
+}
+
+bool TextureCompressor::CanCompress(const Context& context,
+                                    const Texture& texture) {
+  const auto& caps = context.GetCapabilities();
+  const TextureDescriptor& desc = texture.GetTextureDescriptor();
+  return caps->SupportsBufferToTextureBlits() &&
+         caps->SupportsCompressedPixelFormat(kCompressedFormat) &&
+         (desc.format == PixelFormat::kR8G8B8A8UNormInt ||
+          desc.format == PixelFormat::kB8G8R8A8UNormInt) &&
+         desc.type == TextureType::kTexture2D && desc.mip_count == 1u &&
+         desc.sample_count == SampleCount::kCount1 && !desc.size.IsEmpty();
+}
+
+bool TextureCompressor::CompressAsync(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<Texture>& texture,
+    const fml::RefPtr<fml::TaskRunner>& encode_task_runner,
+    Callback callback) {
+  TRACE_EVENT0("impeller", "TextureCompressor::CompressAsync");
+  if (!callback) {
+    return false;
+  }
+  const ISize size = texture ? texture->GetTextureDescriptor().size : ISize();
+  return EncodeAsync(
+      context, texture, encode_task_runner,
+      [context, size, callback = std::move(callback)](
+          const std::shared_ptr<fml::Mapping>& blocks) {
+        callback(blocks ? Upload(context, size, *blocks) : nullptr);
+      });
+}
+
+bool TextureCompressor::EncodeAsync(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<Texture>& texture,
+    const fml::RefPtr<fml::TaskRunner>& encode_task_runner,
+    EncodeCallback callback) {
+  TRACE_EVENT0("impeller", "TextureCompressor::EncodeAsync");
+  if (!context || !texture || !encode_task_runner || !callback ||
+      !CanCompress(*context, *texture)) {
+    return false;
+  }
+
+  const TextureDescriptor source_desc = texture->GetTextureDescriptor();
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size = source_desc.GetByteSizeOfBaseMipLevel();
+  auto pixels = context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  if (!pixels) {
+    return false;
+  }
+
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("Texture Compression Readback Command Buffer");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("Texture Compression Readback Blit Pass");
+  if (!blit_pass->AddCopy(texture, pixels) ||
+      !blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+    return false;
+  }
+
+  // The readback completes on a backend thread, which must not be held up by
+  // the encoding.
+  auto on_read_back = [pixels, source_desc, encode_task_runner,
+                       callback = std::move(callback)](
+                          CommandBuffer::Status status) {
+    encode_task_runner->PostTask([pixels, source_desc, status, callback]() {
+      if (status != CommandBuffer::Status::kCompleted) {
+        callback(nullptr);
+        return;
+      }
+      callback(Encode(*pixels, source_desc));
+    });
+  };
+  return command_buffer->SubmitCommands(on_read_back);
+}
+
+}  // namespace impeller
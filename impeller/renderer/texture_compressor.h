@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "impeller/core/texture.h"
+#include "impeller/renderer/context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Re-encodes textures that have stopped changing into a block
+///             compressed format, which takes a quarter of the memory of 8-bit
+///             RGBA on the GPU.
+///
+///             The texture is read back, encoded as ETC2 RGBA8 on a background
+///             task runner, and uploaded again. Compression is lossy, so only
+///             textures that are sampled for display, and never rendered to or
+///             read back again, should be compressed.
+///
+class TextureCompressor {
+ public:
+  using Callback = std::function<void(std::shared_ptr<Texture> compressed)>;
+  using EncodeCallback =
+      std::function<void(std::shared_ptr<fml::Mapping> blocks)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether `texture` can be compressed on `context`. It must be
+  ///             a single sampled, single level 8-bit RGBA or BGRA texture, and
+  ///             the context must be able to sample ETC2 textures.
+  ///
+  static bool CanCompress(const Context& context, const Texture& texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts compressing `texture`.
+  ///
+  /// @param[in]  context             The context that created `texture`.
+  /// @param[in]  texture             The texture, which must not change from
+  ///                                 now on.
+  /// @param[in]  encode_task_runner  The runner the pixels are encoded on.
+  /// @param[in]  callback            Called on `encode_task_runner` with the
+  ///                                 compressed texture, which may be sampled
+  ///                                 right away, or nullptr on failure. Not
+  ///                                 called if this returns false.
+  ///
+  /// @return     Whether the texture is being compressed.
+  ///
+  static bool CompressAsync(
+      const std::shared_ptr<Context>& context,
+      const std::shared_ptr<Texture>& texture,
+      const fml::RefPtr<fml::TaskRunner>& encode_task_runner,
+      Callback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts encoding `texture` as ETC2 RGBA8 blocks without
+  ///             uploading them again, such as to save them for later.
+  ///
+  /// @param[in]  callback  Called on `encode_task_runner` with the blocks of
+  ///                       the texture, or nullptr on failure. Not called if
+  ///                       this returns false.
+  ///
+  /// @see        CompressAsync
+  ///
+  static bool EncodeAsync(
+      const std::shared_ptr<Context>& context,
+      const std::shared_ptr<Texture>& texture,
+      const fml::RefPtr<fml::TaskRunner>& encode_task_runner,
+      EncodeCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Uploads the ETC2 RGBA8 blocks of a texture of `size`, as made
+  ///             by `EncodeAsync`.
+  ///
+  /// @return     The compressed texture, or nullptr if the context can't
+  ///             sample ETC2 textures or `blocks` isn't the right size.
+  ///
+  static std::shared_ptr<Texture> Upload(
+      const std::shared_ptr<Context>& context,
+      ISize size,
+      const fml::Mapping& blocks);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(TextureCompressor);
+};
+
+}  // namespace impeller
@@ -16,6 +16,7 @@
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/sampler_library.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
@@ -64,6 +65,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
   const uint8_t* vertices_start;
   size_t vertices_bytes;
   bool is_skinned;
+  std::optional<GeometryBounds> bounds;
 
   switch (mesh.vertices_type()) {
     case fb::VertexBuffer::UnskinnedVertexBuffer: {
@@ -72,6 +74,15 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       vertices_start = reinterpret_cast<const uint8_t*>(vertices->Get(0));
       vertices_bytes = vertices->size() * sizeof(fb::Vertex);
       is_skinned = false;
+      for (const auto* vertex : *vertices) {
+        auto position = importer::ToVector3(vertex->position());
+        if (!bounds.has_value()) {
+          bounds = GeometryBounds{.min = position, .max = position};
+          continue;
+        }
+        bounds->min = bounds->min.Min(position);
+        bounds->max = bounds->max.Max(position);
+      }
       break;
     }
     case fb::VertexBuffer::SkinnedVertexBuffer: {
@@ -97,6 +108,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
   DeviceBufferDescriptor buffer_desc;
   buffer_desc.size = vertices_bytes + indices_bytes;
   buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.tag = AllocationTag::kScene;
 
   auto buffer = allocator.CreateBuffer(buffer_desc);
   buffer->SetLabel("Mesh vertices+indices");
@@ -116,7 +128,17 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .vertex_count = mesh.indices()->count(),
       .index_type = index_type,
   };
-  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  if (is_skinned) {
+    return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  }
+  auto result = std::make_shared<UnskinnedVertexBufferGeometry>();
+  result->SetVertexBuffer(std::move(vertex_buffer));
+  result->SetLocalBounds(bounds);
+  return result;
+}
+
+std::optional<GeometryBounds> Geometry::GetLocalBounds() const {
+  return std::nullopt;
 }
 
 void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
@@ -160,6 +182,12 @@ VertexBuffer CuboidGeometry::GetVertexBuffer(Allocator& allocator) const {
   return builder.CreateVertexBuffer(allocator);
 }
 
+// |Geometry|
+std::optional<GeometryBounds> CuboidGeometry::GetLocalBounds() const {
+  // Matches the vertices built by `GetVertexBuffer`.
+  return GeometryBounds{.min = Vector3(0, 0, 0), .max = Vector3(1, 1, 0)};
+}
+
 // |Geometry|
 void CuboidGeometry::BindToCommand(const SceneContext& scene_context,
                                    HostBuffer& buffer,
@@ -186,6 +214,11 @@ void UnskinnedVertexBufferGeometry::SetVertexBuffer(
   vertex_buffer_ = std::move(vertex_buffer);
 }
 
+void UnskinnedVertexBufferGeometry::SetLocalBounds(
+    std::optional<GeometryBounds> bounds) {
+  bounds_ = bounds;
+}
+
 // |Geometry|
 GeometryType UnskinnedVertexBufferGeometry::GetGeometryType() const {
   return GeometryType::kUnskinned;
@@ -197,6 +230,12 @@ VertexBuffer UnskinnedVertexBufferGeometry::GetVertexBuffer(
   return vertex_buffer_;
 }
 
+// |Geometry|
+std::optional<GeometryBounds> UnskinnedVertexBufferGeometry::GetLocalBounds()
+    const {
+  return bounds_;
+}
+
 // |Geometry|
 void UnskinnedVertexBufferGeometry::BindToCommand(
     const SceneContext& scene_context,
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/allocator.h"
@@ -24,6 +25,12 @@ namespace scene {
 class CuboidGeometry;
 class UnskinnedVertexBufferGeometry;
 
+/// An axis aligned box in the local space of a geometry.
+struct GeometryBounds {
+  Vector3 min;
+  Vector3 max;
+};
+
 class Geometry {
  public:
   virtual ~Geometry();
@@ -41,6 +48,14 @@ class Geometry {
 
   virtual VertexBuffer GetVertexBuffer(Allocator& allocator) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The box containing every vertex of the geometry, used to skip
+  ///             drawing it when it's outside of the view. Geometry without
+  ///             bounds, such as skinned geometry whose vertices are moved by
+  ///             its joints, is always drawn.
+  ///
+  virtual std::optional<GeometryBounds> GetLocalBounds() const;
+
   virtual void BindToCommand(const SceneContext& scene_context,
                              HostBuffer& buffer,
                              const Matrix& transform,
@@ -63,6 +78,9 @@ class CuboidGeometry final : public Geometry {
   // |Geometry|
   VertexBuffer GetVertexBuffer(Allocator& allocator) const override;
 
+  // |Geometry|
+  std::optional<GeometryBounds> GetLocalBounds() const override;
+
   // |Geometry|
   void BindToCommand(const SceneContext& scene_context,
                      HostBuffer& buffer,
@@ -83,12 +101,17 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
 
   void SetVertexBuffer(VertexBuffer vertex_buffer);
 
+  void SetLocalBounds(std::optional<GeometryBounds> bounds);
+
   // |Geometry|
   GeometryType GetGeometryType() const override;
 
   // |Geometry|
   VertexBuffer GetVertexBuffer(Allocator& allocator) const override;
 
+  // |Geometry|
+  std::optional<GeometryBounds> GetLocalBounds() const override;
+
   // |Geometry|
   void BindToCommand(const SceneContext& scene_context,
                      HostBuffer& buffer,
@@ -97,6 +120,7 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
 
  private:
   VertexBuffer vertex_buffer_;
+  std::optional<GeometryBounds> bounds_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(UnskinnedVertexBufferGeometry);
 };
@@ -116,6 +116,7 @@ static std::shared_ptr<Texture> UnpackTextureFromFlatbuffer(
   texture_descriptor.size = decompressed_image.GetSize();
   // TODO(bdero): Generate mipmaps for embedded textures.
   texture_descriptor.mip_count = 1u;
+  texture_descriptor.tag = AllocationTag::kScene;
 
   auto texture = allocator.CreateTexture(texture_descriptor);
   if (!texture) {
@@ -52,6 +52,7 @@ SceneContext::SceneContext(std::shared_ptr<Context> context)
     texture_descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
     texture_descriptor.size = {1, 1};
     texture_descriptor.mip_count = 1u;
+    texture_descriptor.tag = AllocationTag::kScene;
 
     placeholder_texture_ =
         context_->GetResourceAllocator()->CreateTexture(texture_descriptor);
@@ -4,6 +4,10 @@
 
 #include "flutter/fml/macros.h"
 
+#include <algorithm>
+#include <array>
+#include <tuple>
+
 #include "flutter/fml/logging.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/render_target.h"
@@ -16,10 +20,37 @@ namespace scene {
 SceneEncoder::SceneEncoder() = default;
 
 void SceneEncoder::Add(const SceneCommand& command) {
-  // TODO(bdero): Manage multi-pass translucency ordering.
   commands_.push_back(command);
 }
 
+/// Whether the local bounds of the command's geometry are entirely outside of
+/// the view volume. The corners of the bounds are tested against the planes
+/// of the view volume in clip space, so geometry that is partially behind the
+/// camera is handled correctly.
+static bool IsOutsideOfView(const Matrix& view_transform,
+                            const SceneCommand& scene_command) {
+  auto bounds = scene_command.geometry->GetLocalBounds();
+  if (!bounds.has_value()) {
+    return false;
+  }
+  const Matrix mvp = view_transform * scene_command.transform;
+  std::array<Vector4, 8> corners;
+  for (size_t i = 0; i < corners.size(); i++) {
+    corners[i] = mvp * Vector4((i & 1) ? bounds->max.x : bounds->min.x,
+                               (i & 2) ? bounds->max.y : bounds->min.y,
+                               (i & 4) ? bounds->max.z : bounds->min.z, 1);
+  }
+  const auto all_corners = [&corners](auto&& is_outside) {
+    return std::all_of(corners.begin(), corners.end(), is_outside);
+  };
+  return all_corners([](const Vector4& c) { return c.x < -c.w; }) ||
+         all_corners([](const Vector4& c) { return c.x > c.w; }) ||
+         all_corners([](const Vector4& c) { return c.y < -c.w; }) ||
+         all_corners([](const Vector4& c) { return c.y > c.w; }) ||
+         all_corners([](const Vector4& c) { return c.z < 0; }) ||
+         all_corners([](const Vector4& c) { return c.z > c.w; });
+}
+
 static void EncodeCommand(const SceneContext& scene_context,
                           const Matrix& view_transform,
                           RenderPass& render_pass,
@@ -57,6 +88,7 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
         static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
     ds_texture.sample_count = SampleCount::kCount4;
     ds_texture.storage_mode = StorageMode::kDeviceTransient;
+    ds_texture.tag = AllocationTag::kScene;
     auto texture =
         scene_context.GetContext()->GetResourceAllocator()->CreateTexture(
             ds_texture);
@@ -90,8 +122,33 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
-  for (auto& command : commands_) {
-    EncodeCommand(scene_context, camera_transform, *render_pass, command);
+  // Opaque commands are drawn first, grouped by pipeline and then by material
+  // so that consecutive commands share as much state as possible. Translucent
+  // commands are drawn afterwards in the order they were added.
+  std::vector<const SceneCommand*> commands;
+  commands.reserve(commands_.size());
+  for (const auto& command : commands_) {
+    if (!IsOutsideOfView(camera_transform, command)) {
+      commands.push_back(&command);
+    }
+  }
+  const auto sort_key = [](const SceneCommand* command) {
+    return std::make_tuple(command->material->IsTranslucent(),
+                           command->geometry->GetGeometryType(),
+                           command->material->GetMaterialType(),
+                           command->material, command->geometry);
+  };
+  std::stable_sort(commands.begin(), commands.end(),
+                   [&sort_key](const SceneCommand* a, const SceneCommand* b) {
+                     if (a->material->IsTranslucent() &&
+                         b->material->IsTranslucent()) {
+                       return false;
+                     }
+                     return sort_key(a) < sort_key(b);
+                   });
+
+  for (const auto* command : commands) {
+    EncodeCommand(scene_context, camera_transform, *render_pass, *command);
   }
 
   if (!render_pass->EncodeCommands()) {
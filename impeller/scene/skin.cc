@@ -7,6 +7,7 @@
 #include <cmath>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -54,6 +55,27 @@ std::unique_ptr<Skin> Skin::MakeFromFlatbuffer(
   return std::make_unique<Skin>(std::move(result));
 }
 
+/// Computes a model space matrix for the joint by walking up the bones to the
+/// skeleton root. Joints share most of their ancestors, so the matrices of the
+/// ancestors are remembered in `model_transforms` instead of being recomputed
+/// for every joint.
+static Matrix GetJointModelTransform(
+    const Node* joint,
+    std::unordered_map<const Node*, Matrix>& model_transforms) {
+  if (!joint || !joint->IsJoint()) {
+    return Matrix();
+  }
+  auto found = model_transforms.find(joint);
+  if (found != model_transforms.end()) {
+    return found->second;
+  }
+  Matrix result =
+      GetJointModelTransform(joint->GetParent(), model_transforms) *
+      joint->GetLocalTransform();
+  model_transforms[joint] = result;
+  return result;
+}
+
 Skin::Skin() = default;
 
 Skin::~Skin() = default;
@@ -75,6 +97,7 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
   texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
   texture_descriptor.size = {dimension_size, dimension_size};
   texture_descriptor.mip_count = 1u;
+  texture_descriptor.tag = AllocationTag::kScene;
 
   auto result = allocator.CreateTexture(texture_descriptor);
   result->SetLabel("Joints Texture");
@@ -86,6 +109,8 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
   std::vector<Matrix> joints;
   joints.resize(result->GetSize().Area() / 4, Matrix());
   FML_DCHECK(joints.size() >= joints_.size());
+  std::unordered_map<const Node*, Matrix> model_transforms;
+  model_transforms.reserve(joints_.size());
   for (size_t joint_i = 0; joint_i < joints_.size(); joint_i++) {
     const Node* joint = joints_[joint_i].get();
     if (!joint) {
@@ -93,12 +118,7 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
       continue;
     }
 
-    // Compute a model space matrix for the joint by walking up the bones to the
-    // skeleton root.
-    while (joint && joint->IsJoint()) {
-      joints[joint_i] = joint->GetLocalTransform() * joints[joint_i];
-      joint = joint->GetParent();
-    }
+    joints[joint_i] = GetJointModelTransform(joint, model_transforms);
 
     // Get the joint transform relative to the default pose of the bone by
     // incorporating the joint's inverse bind matrix. The inverse bind matrix
@@ -4,6 +4,8 @@
 
 #include "impeller/tessellator/tessellator.h"
 
+#include <limits>
+
 #include "third_party/libtess2/Include/tesselator.h"
 
 namespace impeller {
@@ -52,6 +54,84 @@ static int ToTessWindingRule(FillType fill_type) {
   return TESS_WINDING_ODD;
 }
 
+// Whether the polygon turns the same way at every vertex and winds around
+// only once. A polygon that turns consistently but winds more than once, like
+// a pentagram, reverses the direction of its edges along an axis more than
+// twice.
+static bool IsConvexPolygon(const Point* points, size_t count) {
+  Scalar winding = 0;
+  Scalar last_dx = 0;
+  Scalar last_dy = 0;
+  int x_reversals = 0;
+  int y_reversals = 0;
+  Vector2 previous_edge = points[0] - points[count - 1];
+  for (size_t i = 0; i < count; i++) {
+    Vector2 edge = points[(i + 1) % count] - points[i];
+    if (edge.IsZero()) {
+      continue;
+    }
+    Scalar cross = previous_edge.Cross(edge);
+    if (cross != 0) {
+      if (winding != 0 && (cross > 0) != (winding > 0)) {
+        return false;
+      }
+      winding = cross;
+    }
+    if (edge.x != 0) {
+      x_reversals += (last_dx != 0 && (edge.x > 0) != (last_dx > 0));
+      last_dx = edge.x;
+    }
+    if (edge.y != 0) {
+      y_reversals += (last_dy != 0 && (edge.y > 0) != (last_dy > 0));
+      last_dy = edge.y;
+    }
+    previous_edge = edge;
+  }
+  return winding != 0 && x_reversals <= 2 && y_reversals <= 2;
+}
+
+bool Tessellator::TessellateConvexContour(FillType fill_type,
+                                          const Path::Polyline& polyline,
+                                          const BuilderCallback& callback,
+                                          Result& result) const {
+  // Every point of a convex polygon has a winding number of one or zero, but
+  // the sign of the one depends on the direction of the contour.
+  if (fill_type != FillType::kNonZero && fill_type != FillType::kOdd) {
+    return false;
+  }
+  if (polyline.contours.size() != 1u) {
+    return false;
+  }
+  size_t count = polyline.points.size();
+  if (count > 1 && polyline.points[count - 1] == polyline.points[0]) {
+    count--;
+  }
+  if (count < 3 || count > std::numeric_limits<uint16_t>::max() ||
+      !IsConvexPolygon(polyline.points.data(), count)) {
+    return false;
+  }
+
+  indices_.clear();
+  for (size_t i = 2; i < count; i++) {
+    indices_.push_back(0);
+    indices_.push_back(static_cast<uint16_t>(i - 1));
+    indices_.push_back(static_cast<uint16_t>(i));
+  }
+  result = callback(reinterpret_cast<const float*>(polyline.points.data()),
+                    count * 2, indices_.data(), indices_.size())
+               ? Result::kSuccess
+               : Result::kInputError;
+  return true;
+}
+
+Tessellator::Result Tessellator::Tessellate(FillType fill_type,
+                                            const Path& path,
+                                            Scalar scale,
+                                            const BuilderCallback& callback) {
+  path.CreatePolyline(scale, polyline_);
+  return Tessellate(fill_type, polyline_, callback);
+}
+
 Tessellator::Result Tessellator::Tessellate(
     FillType fill_type,
     const Path::Polyline& polyline,
@@ -64,6 +144,11 @@ Tessellator::Result Tessellator::Tessellate(
     return Result::kInputError;
   }
 
+  Result convex_result;
+  if (TessellateConvexContour(fill_type, polyline, callback, convex_result)) {
+    return convex_result;
+  }
+
   auto tessellator = c_tessellator_.get();
   if (!tessellator) {
     return Result::kTessellationError;
@@ -111,11 +196,11 @@ Tessellator::Result Tessellator::Tessellate(
   auto elements = tessGetElements(tessellator);
   // libtess uses an int index internally due to usage of -1 as a sentinel
   // value.
-  std::vector<uint16_t> indices(elementItemCount);
+  indices_.resize(elementItemCount);
   for (int i = 0; i < elementItemCount; i++) {
-    indices[i] = static_cast<uint16_t>(elements[i]);
+    indices_[i] = static_cast<uint16_t>(elements[i]);
   }
-  if (!callback(vertices, vertexItemCount, indices.data(), elementItemCount)) {
+  if (!callback(vertices, vertexItemCount, indices_.data(), elementItemCount)) {
     return Result::kInputError;
   }
 
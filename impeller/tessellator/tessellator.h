@@ -63,8 +63,38 @@ class Tessellator {
                                  const Path::Polyline& polyline,
                                  const BuilderCallback& callback) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Generates filled triangles from the path, flattened at the
+  ///             given scale into storage owned by the tessellator. The
+  ///             storage is reused by every call, so tessellating a path per
+  ///             frame doesn't allocate once it has grown to fit.
+  ///
+  /// @param[in]  fill_type The fill rule to use when filling.
+  /// @param[in]  path      The path to flatten and fill.
+  /// @param[in]  scale     The scale passed to `Path::CreatePolyline`.
+  /// @param[in]  callback  The callback, return false to indicate failure.
+  ///
+  /// @return The result status of the tessellation.
+  ///
+  Tessellator::Result Tessellate(FillType fill_type,
+                                 const Path& path,
+                                 Scalar scale,
+                                 const BuilderCallback& callback);
+
  private:
   CTessellator c_tessellator_;
+  Path::Polyline polyline_;
+  // Only used while a tessellation is in progress.
+  mutable std::vector<uint16_t> indices_;
+
+  // Triangulates a polyline made of a single convex contour as a fan around
+  // its first point, which is much cheaper than going through libtess.
+  //
+  // Returns false without calling the callback if the polyline isn't convex.
+  bool TessellateConvexContour(FillType fill_type,
+                               const Path::Polyline& polyline,
+                               const BuilderCallback& callback,
+                               Result& result) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Tessellator);
 };
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <vector>
+
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/geometry/path_builder.h"
@@ -84,5 +86,50 @@ TEST(TessellatorTest, TessellatorBuilderReturnsCorrectResultStatus) {
   }
 }
 
+TEST(TessellatorTest, ConvexContourIsFilledAsAFan) {
+  Tessellator t;
+  auto path = PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 10, 10)).TakePath();
+  size_t vertex_count = 0u;
+  std::vector<uint16_t> triangles;
+  Tessellator::Result result = t.Tessellate(
+      FillType::kNonZero, path, 1.0f,
+      [&vertex_count, &triangles](const float* vertices, size_t vertices_size,
+                                  const uint16_t* indices,
+                                  size_t indices_size) {
+        vertex_count = vertices_size / 2;
+        triangles.assign(indices, indices + indices_size);
+        return true;
+      });
+
+  ASSERT_EQ(result, Tessellator::Result::kSuccess);
+  ASSERT_EQ(vertex_count, 4u);
+  ASSERT_EQ(triangles, std::vector<uint16_t>({0, 1, 2, 0, 2, 3}));
+}
+
+TEST(TessellatorTest, SelfIntersectingContourIsNotFilledAsAFan) {
+  // A pentagram turns the same way at every point, but isn't convex.
+  Tessellator t;
+  auto path = PathBuilder{}
+                  .MoveTo({50, 0})
+                  .LineTo({79, 90})
+                  .LineTo({2, 35})
+                  .LineTo({97, 35})
+                  .LineTo({21, 90})
+                  .Close()
+                  .TakePath();
+  size_t vertex_count = 0u;
+  Tessellator::Result result = t.Tessellate(
+      FillType::kNonZero, path, 1.0f,
+      [&vertex_count](const float* vertices, size_t vertices_size,
+                      const uint16_t* indices, size_t indices_size) {
+        vertex_count = vertices_size / 2;
+        return true;
+      });
+
+  ASSERT_EQ(result, Tessellator::Result::kSuccess);
+  // libtess adds the points where the edges cross.
+  ASSERT_GT(vertex_count, 5u);
+}
+
 }  // namespace testing
 }  // namespace impeller
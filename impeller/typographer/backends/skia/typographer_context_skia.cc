@@ -4,6 +4,7 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <cmath>
 #include <numeric>
 #include <utility>
 
@@ -14,6 +15,7 @@
 #include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
 #include "impeller/typographer/backends/skia/typeface_skia.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "impeller/typographer/typographer_context.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -27,6 +29,8 @@ namespace impeller {
 //              https://github.com/flutter/flutter/issues/114563
 constexpr auto kPadding = 2;
 
+constexpr auto kMaxAtlasSize = 4096u;
+
 std::shared_ptr<TypographerContext> TypographerContextSkia::Make() {
   return std::make_shared<TypographerContextSkia>();
 }
@@ -40,11 +44,32 @@ TypographerContextSkia::CreateGlyphAtlasContext() const {
   return std::make_shared<GlyphAtlasContextSkia>();
 }
 
+bool TypographerContextSkia::SupportsSignedDistanceFields() const {
+  return true;
+}
+
+// The size of the area of the atlas taken by the glyph, not counting the
+// padding between glyphs.
+static ISize ComputeGlyphSize(const FontGlyphPair& pair,
+                              GlyphAtlas::Type type) {
+  auto glyph_size =
+      ISize::Ceil(pair.glyph.bounds.size * pair.scaled_font.scale);
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    // The field extends past the outline of the glyph.
+    constexpr auto spread =
+        static_cast<int64_t>(GlyphAtlas::kSignedDistanceFieldSpread);
+    glyph_size = ISize(glyph_size.width + 2 * spread,
+                       glyph_size.height + 2 * spread);
+  }
+  return glyph_size;
+}
+
 static size_t PairsFitInAtlasOfSize(
     const std::vector<FontGlyphPair>& pairs,
     const ISize& atlas_size,
     std::vector<Rect>& glyph_positions,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
+    const std::shared_ptr<RectanglePacker>& rect_packer,
+    GlyphAtlas::Type type) {
   if (atlas_size.IsEmpty()) {
     return false;
   }
@@ -56,8 +81,7 @@ static size_t PairsFitInAtlasOfSize(
   for (auto it = pairs.begin(); it != pairs.end(); ++i, ++it) {
     const auto& pair = *it;
 
-    const auto glyph_size =
-        ISize::Ceil(pair.glyph.bounds.size * pair.scaled_font.scale);
+    const auto glyph_size = ComputeGlyphSize(pair, type);
     IPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -94,8 +118,7 @@ static bool CanAppendToExistingAtlas(
   for (size_t i = 0; i < extra_pairs.size(); i++) {
     const FontGlyphPair& pair = extra_pairs[i];
 
-    const auto glyph_size =
-        ISize::Ceil(pair.glyph.bounds.size * pair.scaled_font.scale);
+    const auto glyph_size = ComputeGlyphSize(pair, atlas->GetType());
     IPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -120,7 +143,6 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
     GlyphAtlas::Type type) {
   static constexpr auto kMinAtlasSize = 8u;
   static constexpr auto kMinAlphaBitmapSize = 1024u;
-  static constexpr auto kMaxAtlasSize = 4096u;
 
   TRACE_EVENT0("impeller", __FUNCTION__);
 
@@ -132,8 +154,8 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
     auto rect_packer = std::shared_ptr<RectanglePacker>(
         RectanglePacker::Factory(current_size.width, current_size.height));
 
-    auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
-                                                 glyph_positions, rect_packer);
+    auto remaining_pairs = PairsFitInAtlasOfSize(
+        pairs, current_size, glyph_positions, rect_packer, type);
     if (remaining_pairs == 0) {
       atlas_context->UpdateRectPacker(rect_packer);
       return current_size;
@@ -152,6 +174,61 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
   return ISize{0, 0};
 }
 
+static std::shared_ptr<RectanglePacker> PackIntoGrownAtlas(
+    const ISize& old_size,
+    const std::vector<FontGlyphPair>& extra_pairs,
+    std::vector<Rect>& glyph_positions,
+    GlyphAtlas::Type type,
+    ISize& new_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (old_size.IsEmpty()) {
+    return nullptr;
+  }
+
+  new_size = old_size;
+  while (true) {
+    // Double the smaller dimension so the atlas stays roughly square.
+    if (new_size.width <= new_size.height) {
+      new_size.width *= 2;
+    } else {
+      new_size.height *= 2;
+    }
+    if (new_size.width > static_cast<int64_t>(kMaxAtlasSize) ||
+        new_size.height > static_cast<int64_t>(kMaxAtlasSize)) {
+      return nullptr;
+    }
+
+    auto rect_packer = std::shared_ptr<RectanglePacker>(
+        RectanglePacker::Factory(new_size.width, new_size.height));
+    // Reserve the area of the old atlas first. The packer is empty so this
+    // always lands at the origin, which keeps existing glyphs in place.
+    IPoint16 old_location;
+    if (!rect_packer->addRect(old_size.width, old_size.height,
+                              &old_location) ||
+        old_location.x() != 0 || old_location.y() != 0) {
+      return nullptr;
+    }
+    if (PairsFitInAtlasOfSize(extra_pairs, new_size, glyph_positions,
+                              rect_packer, type) == 0) {
+      return rect_packer;
+    }
+  }
+}
+
+static IRect ComputeDirtyRegion(const std::vector<Rect>& glyph_positions) {
+  FML_DCHECK(!glyph_positions.empty());
+  auto dirty = glyph_positions.front();
+  for (const auto& position : glyph_positions) {
+    dirty = dirty.Union(position);
+  }
+  // Anti-aliasing may touch the padding around each glyph.
+  dirty = dirty.Expand(kPadding);
+  return IRect::MakeLTRB(static_cast<int64_t>(std::floor(dirty.GetLeft())),
+                         static_cast<int64_t>(std::floor(dirty.GetTop())),
+                         static_cast<int64_t>(std::ceil(dirty.GetRight())),
+                         static_cast<int64_t>(std::ceil(dirty.GetBottom())));
+}
+
 static void DrawGlyph(SkCanvas* canvas,
                       const ScaledFont& scaled_font,
                       const Glyph& glyph,
@@ -185,6 +262,36 @@ static void DrawGlyph(SkCanvas* canvas,
   );
 }
 
+// Draws the glyph into a bitmap with room for the field around its outline,
+// then stores the signed distance field of the bitmap in the atlas.
+static void DrawSignedDistanceFieldGlyph(const SkBitmap& atlas_bitmap,
+                                         const ScaledFont& scaled_font,
+                                         const Glyph& glyph,
+                                         const Rect& location) {
+  const ISize size(static_cast<int64_t>(location.size.width),
+                   static_cast<int64_t>(location.size.height));
+  SkBitmap coverage;
+  if (!coverage.tryAllocPixels(
+          SkImageInfo::MakeA8(size.width, size.height))) {
+    return;
+  }
+  coverage.eraseColor(SK_ColorTRANSPARENT);
+  auto surface = SkSurfaces::WrapPixels(coverage.pixmap());
+  if (!surface || !surface->getCanvas()) {
+    return;
+  }
+
+  constexpr auto spread = GlyphAtlas::kSignedDistanceFieldSpread;
+  DrawGlyph(surface->getCanvas(), scaled_font, glyph,
+            Rect::MakeXYWH(spread, spread, size.width, size.height),
+            /*has_color=*/false);
+  ComputeSignedDistanceField(
+      coverage.getAddr8(0, 0), coverage.rowBytes(), size, spread,
+      atlas_bitmap.getAddr8(static_cast<int>(location.origin.x),
+                            static_cast<int>(location.origin.y)),
+      atlas_bitmap.rowBytes());
+}
+
 static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
                               const std::shared_ptr<SkBitmap>& bitmap,
                               const std::vector<FontGlyphPair>& new_pairs) {
@@ -201,13 +308,19 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
   }
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  bool is_sdf = atlas.GetType() == GlyphAtlas::Type::kSignedDistanceField;
 
   for (const FontGlyphPair& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair.scaled_font, pair.glyph, pos.value(), has_color);
+    if (is_sdf) {
+      DrawSignedDistanceFieldGlyph(*bitmap, pair.scaled_font, pair.glyph,
+                                   pos.value());
+    } else {
+      DrawGlyph(canvas, pair.scaled_font, pair.glyph, pos.value(), has_color);
+    }
   }
   return true;
 }
@@ -220,6 +333,7 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
 
   switch (atlas.GetType()) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       image_info = SkImageInfo::MakeA8(atlas_size.width, atlas_size.height);
       break;
     case GlyphAtlas::Type::kColorBitmap:
@@ -242,17 +356,36 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
   }
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  bool is_sdf = atlas.GetType() == GlyphAtlas::Type::kSignedDistanceField;
 
-  atlas.IterateGlyphs([canvas, has_color](const ScaledFont& scaled_font,
-                                          const Glyph& glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, scaled_font, glyph, location, has_color);
+  atlas.IterateGlyphs([&bitmap, canvas, has_color, is_sdf](
+                          const ScaledFont& scaled_font, const Glyph& glyph,
+                          const Rect& location) -> bool {
+    if (is_sdf) {
+      DrawSignedDistanceFieldGlyph(*bitmap, scaled_font, glyph, location);
+    } else {
+      DrawGlyph(canvas, scaled_font, glyph, location, has_color);
+    }
     return true;
   });
 
   return bitmap;
 }
 
+static std::shared_ptr<SkBitmap> GrowAtlasBitmap(const SkBitmap& old_bitmap,
+                                                 const ISize& atlas_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto bitmap = std::make_shared<SkBitmap>();
+  if (!bitmap->tryAllocPixels(
+          old_bitmap.info().makeWH(atlas_size.width, atlas_size.height))) {
+    return nullptr;
+  }
+  if (!bitmap->writePixels(old_bitmap.pixmap(), 0, 0)) {
+    return nullptr;
+  }
+  return bitmap;
+}
+
 static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
                                     const std::shared_ptr<Texture>& texture) {
   TRACE_EVENT0("impeller", __FUNCTION__);
@@ -286,6 +419,7 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   texture_descriptor.storage_mode = StorageMode::kHostVisible;
   texture_descriptor.format = format;
   texture_descriptor.size = atlas_size;
+  texture_descriptor.tag = AllocationTag::kGlyphAtlas;
 
   if (pixmap.rowBytes() * pixmap.height() !=
       texture_descriptor.GetByteSizeOfBaseMipLevel()) {
@@ -310,6 +444,32 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   return texture;
 }
 
+static PixelFormat GetAtlasPixelFormat(GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return PixelFormat::kA8UNormInt;
+    case GlyphAtlas::Type::kColorBitmap:
+      return PixelFormat::kR8G8B8A8UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+
+static std::vector<FontGlyphPair> FlattenFontGlyphMap(
+    const FontGlyphMap& font_glyph_map) {
+  std::vector<FontGlyphPair> font_glyph_pairs;
+  font_glyph_pairs.reserve(std::accumulate(
+      font_glyph_map.begin(), font_glyph_map.end(), 0,
+      [](const int a, const auto& b) { return a + b.second.size(); }));
+  for (const auto& font_value : font_glyph_map) {
+    const ScaledFont& scaled_font = font_value.first;
+    for (const Glyph& glyph : font_value.second) {
+      font_glyph_pairs.push_back({scaled_font, glyph});
+    }
+  }
+  return font_glyph_pairs;
+}
+
 std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     Context& context,
     GlyphAtlas::Type type,
@@ -325,6 +485,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   if (font_glyph_map.empty()) {
     return last_atlas;
   }
+  atlas_context->MarkGlyphsUsed(font_glyph_map);
 
   // ---------------------------------------------------------------------------
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
@@ -381,31 +542,74 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     }
 
     // ---------------------------------------------------------------------------
-    // Step 5a: Update the existing texture with the updated bitmap.
+    // Step 5a: Upload only the region of the bitmap that changed. Replace the
+    // contents of the whole texture if the backend can't blit from buffers.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
+    if (!UploadGlyphAtlasRegion(
+            context, last_atlas->GetTexture(),
+            reinterpret_cast<const uint8_t*>(bitmap->getPixels()),
+            bitmap->rowBytes(), ComputeDirtyRegion(glyph_positions)) &&
+        !UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
       return nullptr;
     }
     return last_atlas;
   }
-  // A new glyph atlas must be created.
 
   // ---------------------------------------------------------------------------
-  // Step 3b: Get the optimum size of the texture atlas.
+  // Step 2c: The existing atlas is full. Grow it by doubling its size while
+  //          keeping every existing glyph where it is, so only the new glyphs
+  //          need to be drawn.
   // ---------------------------------------------------------------------------
-  std::vector<FontGlyphPair> font_glyph_pairs;
-  font_glyph_pairs.reserve(std::accumulate(
-      font_glyph_map.begin(), font_glyph_map.end(), 0,
-      [](const int a, const auto& b) { return a + b.second.size(); }));
-  for (const auto& font_value : font_glyph_map) {
-    const ScaledFont& scaled_font = font_value.first;
-    for (const Glyph& glyph : font_value.second) {
-      font_glyph_pairs.push_back({scaled_font, glyph});
+  if (last_atlas->GetType() == type && last_atlas->GetTexture() &&
+      atlas_context_skia.GetBitmap()) {
+    glyph_positions.clear();
+    ISize grown_size;
+    auto rect_packer =
+        PackIntoGrownAtlas(atlas_context->GetAtlasSize(), new_glyphs,
+                           glyph_positions, type, grown_size);
+    auto bitmap = rect_packer ? GrowAtlasBitmap(*atlas_context_skia.GetBitmap(),
+                                                grown_size)
+                              : nullptr;
+    if (bitmap) {
+      for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
+        last_atlas->AddTypefaceGlyphPosition(new_glyphs[i],
+                                             glyph_positions[i]);
+      }
+      if (UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+        auto texture =
+            UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
+                                    grown_size, GetAtlasPixelFormat(type));
+        if (texture) {
+          last_atlas->SetTexture(std::move(texture));
+          atlas_context->UpdateGlyphAtlas(last_atlas, grown_size);
+          atlas_context->UpdateRectPacker(std::move(rect_packer));
+          atlas_context_skia.UpdateBitmap(std::move(bitmap));
+          return last_atlas;
+        }
+      }
     }
   }
+  // A new glyph atlas must be created.
+
+  // ---------------------------------------------------------------------------
+  // Step 3b: Get the optimum size of the texture atlas. Glyphs used recently
+  //          are carried over so that they don't have to be added back one by
+  //          one. If they don't fit, only the glyphs of this frame are kept.
+  // ---------------------------------------------------------------------------
+  glyph_positions.clear();
+  FontGlyphMap retained_glyph_map = font_glyph_map;
+  if (last_atlas->GetType() == type) {
+    atlas_context->CollectRecentlyUsedGlyphs(retained_glyph_map);
+  }
+  auto font_glyph_pairs = FlattenFontGlyphMap(retained_glyph_map);
   auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
   auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(
       font_glyph_pairs, glyph_positions, atlas_context, type);
+  if (atlas_size.IsEmpty() && last_atlas->GetType() == type) {
+    font_glyph_pairs = FlattenFontGlyphMap(font_glyph_map);
+    atlas_size = OptimumAtlasSizeForFontGlyphPairs(
+        font_glyph_pairs, glyph_positions, atlas_context, type);
+  }
 
   atlas_context->UpdateGlyphAtlas(glyph_atlas, atlas_size);
   if (atlas_size.IsEmpty()) {
@@ -444,17 +648,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 7b: Upload the atlas as a texture.
   // ---------------------------------------------------------------------------
-  PixelFormat format;
-  switch (type) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      format = PixelFormat::kA8UNormInt;
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      format = PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
   auto texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
-                                         atlas_size, format);
+                                         atlas_size, GetAtlasPixelFormat(type));
   if (!texture) {
     return nullptr;
   }
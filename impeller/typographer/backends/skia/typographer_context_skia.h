@@ -20,6 +20,9 @@ class TypographerContextSkia : public TypographerContext {
   // |TypographerContext|
   std::shared_ptr<GlyphAtlasContext> CreateGlyphAtlasContext() const override;
 
+  // |TypographerContext|
+  bool SupportsSignedDistanceFields() const override;
+
   // |TypographerContext|
   std::shared_ptr<GlyphAtlas> CreateGlyphAtlas(
       Context& context,
@@ -4,6 +4,8 @@
 
 #include "impeller/typographer/backends/stb/typographer_context_stb.h"
 
+#include <cmath>
+#include <cstring>
 #include <numeric>
 #include <utility>
 
@@ -26,6 +28,8 @@ namespace impeller {
 
 constexpr size_t kPadding = 1;
 
+constexpr auto kMaxAtlasSize = 2048u;  // QNX required 2048 or less.
+
 std::unique_ptr<TypographerContext> TypographerContextSTB::Make() {
   return std::make_unique<TypographerContextSTB>();
 }
@@ -163,7 +167,6 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
     GlyphAtlas::Type type) {
   static constexpr auto kMinAtlasSize = 8u;
   static constexpr auto kMinAlphaBitmapSize = 1024u;
-  static constexpr auto kMaxAtlasSize = 2048u;  // QNX required 2048 or less.
 
   TRACE_EVENT0("impeller", __FUNCTION__);
 
@@ -195,6 +198,59 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
   return ISize{0, 0};
 }
 
+static std::shared_ptr<RectanglePacker> PackIntoGrownAtlas(
+    const ISize& old_size,
+    const std::vector<FontGlyphPair>& extra_pairs,
+    std::vector<Rect>& glyph_positions,
+    ISize& new_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (old_size.IsEmpty()) {
+    return nullptr;
+  }
+
+  new_size = old_size;
+  while (true) {
+    // Double the smaller dimension so the atlas stays roughly square.
+    if (new_size.width <= new_size.height) {
+      new_size.width *= 2;
+    } else {
+      new_size.height *= 2;
+    }
+    if (new_size.width > static_cast<int64_t>(kMaxAtlasSize) ||
+        new_size.height > static_cast<int64_t>(kMaxAtlasSize)) {
+      return nullptr;
+    }
+
+    auto rect_packer = std::shared_ptr<RectanglePacker>(
+        RectanglePacker::Factory(new_size.width, new_size.height));
+    // Reserve the area of the old atlas first. The packer is empty so this
+    // always lands at the origin, which keeps existing glyphs in place.
+    IPoint16 old_location;
+    if (!rect_packer->addRect(old_size.width, old_size.height,
+                              &old_location) ||
+        old_location.x() != 0 || old_location.y() != 0) {
+      return nullptr;
+    }
+    if (PairsFitInAtlasOfSize(extra_pairs, new_size, glyph_positions,
+                              rect_packer) == 0) {
+      return rect_packer;
+    }
+  }
+}
+
+static IRect ComputeDirtyRegion(const std::vector<Rect>& glyph_positions) {
+  FML_DCHECK(!glyph_positions.empty());
+  auto dirty = glyph_positions.front();
+  for (const auto& position : glyph_positions) {
+    dirty = dirty.Union(position);
+  }
+  dirty = dirty.Expand(kPadding);
+  return IRect::MakeLTRB(static_cast<int64_t>(std::floor(dirty.GetLeft())),
+                         static_cast<int64_t>(std::floor(dirty.GetTop())),
+                         static_cast<int64_t>(std::ceil(dirty.GetRight())),
+                         static_cast<int64_t>(std::ceil(dirty.GetBottom())));
+}
+
 static void DrawGlyph(BitmapSTB* bitmap,
                       const ScaledFont& scaled_font,
                       const Glyph& glyph,
@@ -313,6 +369,19 @@ static std::shared_ptr<BitmapSTB> CreateAtlasBitmap(const GlyphAtlas& atlas,
   return bitmap;
 }
 
+static std::shared_ptr<BitmapSTB> GrowAtlasBitmap(BitmapSTB& old_bitmap,
+                                                  const ISize& atlas_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto bitmap = std::make_shared<BitmapSTB>(
+      atlas_size.width, atlas_size.height,
+      old_bitmap.GetRowBytes() / old_bitmap.GetWidth());
+  for (size_t row = 0; row < old_bitmap.GetHeight(); row++) {
+    std::memcpy(bitmap->GetPixelAddress({0, row}),
+                old_bitmap.GetPixelAddress({0, row}), old_bitmap.GetRowBytes());
+  }
+  return bitmap;
+}
+
 // static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
 static bool UpdateGlyphTextureAtlas(std::shared_ptr<BitmapSTB>& bitmap,
                                     const std::shared_ptr<Texture>& texture) {
@@ -348,6 +417,7 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   texture_descriptor.storage_mode = StorageMode::kHostVisible;
   texture_descriptor.format = format;
   texture_descriptor.size = atlas_size;
+  texture_descriptor.tag = AllocationTag::kGlyphAtlas;
 
   if (bitmap->GetRowBytes() * bitmap->GetHeight() !=
       texture_descriptor.GetByteSizeOfBaseMipLevel()) {
@@ -373,6 +443,33 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   return texture;
 }
 
+static PixelFormat GetAtlasPixelFormat(GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return PixelFormat::kA8UNormInt;
+    case GlyphAtlas::Type::kColorBitmap:
+      return DISABLE_COLOR_FONT_SUPPORT ? PixelFormat::kA8UNormInt
+                                        : PixelFormat::kR8G8B8A8UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+
+static std::vector<FontGlyphPair> FlattenFontGlyphMap(
+    const FontGlyphMap& font_glyph_map) {
+  std::vector<FontGlyphPair> font_glyph_pairs;
+  font_glyph_pairs.reserve(std::accumulate(
+      font_glyph_map.begin(), font_glyph_map.end(), 0,
+      [](const int a, const auto& b) { return a + b.second.size(); }));
+  for (const auto& font_value : font_glyph_map) {
+    const ScaledFont& scaled_font = font_value.first;
+    for (const Glyph& glyph : font_value.second) {
+      font_glyph_pairs.push_back({scaled_font, glyph});
+    }
+  }
+  return font_glyph_pairs;
+}
+
 std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
     Context& context,
     GlyphAtlas::Type type,
@@ -388,6 +485,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
   if (font_glyph_map.empty()) {
     return last_atlas;
   }
+  atlas_context->MarkGlyphsUsed(font_glyph_map);
 
   // ---------------------------------------------------------------------------
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
@@ -445,31 +543,72 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
     }
 
     // ---------------------------------------------------------------------------
-    // Step 5a: Update the existing texture with the updated bitmap.
+    // Step 5a: Upload only the region of the bitmap that changed. Replace the
+    // contents of the whole texture if the backend can't blit from buffers.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
+    if (!UploadGlyphAtlasRegion(context, last_atlas->GetTexture(),
+                                bitmap->GetPixels(), bitmap->GetRowBytes(),
+                                ComputeDirtyRegion(glyph_positions)) &&
+        !UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
       return nullptr;
     }
     return last_atlas;
   }
-  // A new glyph atlas must be created.
 
   // ---------------------------------------------------------------------------
-  // Step 3b: Get the optimum size of the texture atlas.
+  // Step 2c: The existing atlas is full. Grow it by doubling its size while
+  //          keeping every existing glyph where it is, so only the new glyphs
+  //          need to be drawn.
   // ---------------------------------------------------------------------------
-  std::vector<FontGlyphPair> font_glyph_pairs;
-  font_glyph_pairs.reserve(std::accumulate(
-      font_glyph_map.begin(), font_glyph_map.end(), 0,
-      [](const int a, const auto& b) { return a + b.second.size(); }));
-  for (const auto& font_value : font_glyph_map) {
-    const ScaledFont& scaled_font = font_value.first;
-    for (const Glyph& glyph : font_value.second) {
-      font_glyph_pairs.push_back({scaled_font, glyph});
+  if (last_atlas->GetType() == type && last_atlas->GetTexture() &&
+      atlas_context_stb.GetBitmap()) {
+    glyph_positions.clear();
+    ISize grown_size;
+    auto rect_packer =
+        PackIntoGrownAtlas(atlas_context->GetAtlasSize(), new_glyphs,
+                           glyph_positions, grown_size);
+    if (rect_packer) {
+      auto bitmap =
+          GrowAtlasBitmap(*atlas_context_stb.GetBitmap(), grown_size);
+      for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
+        last_atlas->AddTypefaceGlyphPosition(new_glyphs[i],
+                                             glyph_positions[i]);
+      }
+      if (UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+        auto texture =
+            UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
+                                    grown_size, GetAtlasPixelFormat(type));
+        if (texture) {
+          last_atlas->SetTexture(std::move(texture));
+          atlas_context->UpdateGlyphAtlas(last_atlas, grown_size);
+          atlas_context->UpdateRectPacker(std::move(rect_packer));
+          atlas_context_stb.UpdateBitmap(std::move(bitmap));
+          return last_atlas;
+        }
+      }
     }
   }
+  // A new glyph atlas must be created.
+
+  // ---------------------------------------------------------------------------
+  // Step 3b: Get the optimum size of the texture atlas. Glyphs used recently
+  //          are carried over so that they don't have to be added back one by
+  //          one. If they don't fit, only the glyphs of this frame are kept.
+  // ---------------------------------------------------------------------------
+  glyph_positions.clear();
+  FontGlyphMap retained_glyph_map = font_glyph_map;
+  if (last_atlas->GetType() == type) {
+    atlas_context->CollectRecentlyUsedGlyphs(retained_glyph_map);
+  }
+  auto font_glyph_pairs = FlattenFontGlyphMap(retained_glyph_map);
   auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
   auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(
       font_glyph_pairs, glyph_positions, atlas_context, type);
+  if (atlas_size.IsEmpty() && last_atlas->GetType() == type) {
+    font_glyph_pairs = FlattenFontGlyphMap(font_glyph_map);
+    atlas_size = OptimumAtlasSizeForFontGlyphPairs(
+        font_glyph_pairs, glyph_positions, atlas_context, type);
+  }
 
   atlas_context->UpdateGlyphAtlas(glyph_atlas, atlas_size);
   if (atlas_size.IsEmpty()) {
@@ -509,18 +648,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 7b: Upload the atlas as a texture.
   // ---------------------------------------------------------------------------
-  PixelFormat format;
-  switch (type) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      format = PixelFormat::kA8UNormInt;
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      format = DISABLE_COLOR_FONT_SUPPORT ? PixelFormat::kA8UNormInt
-                                          : PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
   auto texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
-                                         atlas_size, format);
+                                         atlas_size, GetAtlasPixelFormat(type));
   if (!texture) {
     return nullptr;
   }
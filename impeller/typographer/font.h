@@ -77,3 +77,17 @@ struct std::hash<impeller::Font::Metrics> {
     return fml::HashCombine(m.point_size, m.skewX, m.scaleX);
   }
 };
+
+template <>
+struct std::hash<impeller::Font> {
+  std::size_t operator()(const impeller::Font& font) const {
+    return font.GetHash();
+  }
+};
+
+template <>
+struct std::equal_to<impeller::Font> {
+  bool operator()(const impeller::Font& lhs, const impeller::Font& rhs) const {
+    return lhs.IsEqual(rhs);
+  }
+};
@@ -38,6 +38,69 @@ void GlyphAtlasContext::UpdateRectPacker(
   rect_packer_ = std::move(rect_packer);
 }
 
+float GlyphAtlasContext::GetOccupancy() const {
+  return rect_packer_ ? rect_packer_->percentFull() : 0.0f;
+}
+
+float GlyphAtlasContext::GetFragmentation() const {
+  return rect_packer_ ? rect_packer_->fragmentation() : 0.0f;
+}
+
+size_t GlyphAtlasContext::GetRecentScaleCount(const Font& font) const {
+  auto found = scale_last_used_frames_.find(font);
+  if (found == scale_last_used_frames_.end()) {
+    return 0u;
+  }
+  size_t count = 0u;
+  for (const auto& [scale, last_used] : found->second) {
+    if (frame_count_ - last_used < kGlyphEvictionFrameCount) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void GlyphAtlasContext::MarkGlyphsUsed(const FontGlyphMap& font_glyph_map) {
+  frame_count_++;
+  for (const auto& font_value : font_glyph_map) {
+    auto& last_used = last_used_frames_[font_value.first];
+    for (const auto& glyph : font_value.second) {
+      last_used[glyph] = frame_count_;
+    }
+
+    auto& scales = scale_last_used_frames_[font_value.first.font];
+    scales[font_value.first.scale] = frame_count_;
+    for (auto it = scales.begin(); it != scales.end();) {
+      if (frame_count_ - it->second >= kGlyphEvictionFrameCount) {
+        it = scales.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+void GlyphAtlasContext::CollectRecentlyUsedGlyphs(
+    FontGlyphMap& font_glyph_map) {
+  for (auto font_it = last_used_frames_.begin();
+       font_it != last_used_frames_.end();) {
+    auto& last_used = font_it->second;
+    for (auto glyph_it = last_used.begin(); glyph_it != last_used.end();) {
+      if (frame_count_ - glyph_it->second >= kGlyphEvictionFrameCount) {
+        glyph_it = last_used.erase(glyph_it);
+        continue;
+      }
+      font_glyph_map[font_it->first].insert(glyph_it->first);
+      ++glyph_it;
+    }
+    if (last_used.empty()) {
+      font_it = last_used_frames_.erase(font_it);
+      continue;
+    }
+    ++font_it;
+  }
+}
+
 GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
@@ -41,8 +41,27 @@ class GlyphAtlas {
     /// colors.
     ///
     kColorBitmap,
+
+    //--------------------------------------------------------------------------
+    /// The glyphs are represented at a fixed size as an 8-bit signed distance
+    /// field, which can be drawn at any scale. The outline of the glyph is at
+    /// half the maximum value.
+    ///
+    kSignedDistanceField,
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      The size, in pixels, of the fonts rasterized into a signed
+  ///             distance field atlas.
+  ///
+  static constexpr Scalar kSignedDistanceFieldFontSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The distance, in pixels, covered by the signed distance field
+  ///             on each side of the outline of a glyph.
+  ///
+  static constexpr Scalar kSignedDistanceFieldSpread = 8.0f;
+
   //----------------------------------------------------------------------------
   /// @brief      Create an empty glyph atlas.
   ///
@@ -161,6 +180,47 @@ class GlyphAtlasContext {
 
   void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the fraction of the current atlas area that is
+  ///             occupied by glyphs, between 0.0 and 1.0.
+  float GetOccupancy() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the fraction of the free atlas area that lies outside
+  ///             the largest free rectangle, between 0.0 and 1.0.
+  float GetFragmentation() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of atlas updates a glyph may go unused before it is
+  ///             evicted the next time the atlas has to be rebuilt.
+  static constexpr size_t kGlyphEvictionFrameCount = 60u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of scales |font| was drawn at within the last
+  ///             `kGlyphEvictionFrameCount` updates. Text drawn at many scales,
+  ///             like text under an animated transform, keeps adding glyphs to
+  ///             the atlas.
+  ///
+  size_t GetRecentScaleCount(const Font& font) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record that the glyphs in the map were requested for the
+  ///             current atlas update and advance the frame counter.
+  ///
+  /// @param[in]  font_glyph_map  The glyphs requested this frame.
+  ///
+  void MarkGlyphsUsed(const FontGlyphMap& font_glyph_map);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add every glyph used within the last
+  ///             `kGlyphEvictionFrameCount` updates to the map. Glyphs that
+  ///             have not been used for longer are forgotten so that a rebuilt
+  ///             atlas no longer contains them.
+  ///
+  /// @param[out] font_glyph_map  The map to add the recently used glyphs to.
+  ///
+  void CollectRecentlyUsedGlyphs(FontGlyphMap& font_glyph_map);
+
  protected:
   GlyphAtlasContext();
 
@@ -168,6 +228,11 @@ class GlyphAtlasContext {
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
   std::shared_ptr<RectanglePacker> rect_packer_;
+  size_t frame_count_ = 0u;
+  std::unordered_map<ScaledFont, std::unordered_map<Glyph, size_t>>
+      last_used_frames_;
+  std::unordered_map<Font, std::unordered_map<Scalar, size_t>>
+      scale_last_used_frames_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasContext);
 };
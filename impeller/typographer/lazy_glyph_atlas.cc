@@ -4,6 +4,8 @@
 
 #include "impeller/typographer/lazy_glyph_atlas.h"
 
+#include "flutter/fml/frame_cost_ledger.h"
+#include "flutter/fml/logging.h"
 #include "impeller/base/validation.h"
 #include "impeller/typographer/typographer_context.h"
 
@@ -19,25 +21,81 @@ LazyGlyphAtlas::LazyGlyphAtlas(
                          : nullptr),
       color_context_(typographer_context_
                          ? typographer_context_->CreateGlyphAtlasContext()
-                         : nullptr) {}
+                         : nullptr),
+      sdf_context_(typographer_context_
+                       ? typographer_context_->CreateGlyphAtlasContext()
+                       : nullptr) {}
 
 LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
-void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame, Scalar scale) {
+GlyphAtlas::Type LazyGlyphAtlas::GetAtlasType(const TextFrame& frame,
+                                              Scalar scale) const {
+  GlyphAtlas::Type type = frame.GetAtlasType();
+  if (type != GlyphAtlas::Type::kAlphaBitmap || !typographer_context_ ||
+      !typographer_context_->SupportsSignedDistanceFields()) {
+    return type;
+  }
+  for (const TextRun& run : frame.GetRuns()) {
+    const Font& font = run.GetFont();
+    if (font.GetMetrics().point_size * scale >=
+            kSignedDistanceFieldMinimumSize ||
+        alpha_context_->GetRecentScaleCount(font) >= kAnimatedScaleCount) {
+      return GlyphAtlas::Type::kSignedDistanceField;
+    }
+  }
+  return type;
+}
+
+GlyphAtlas::Type LazyGlyphAtlas::AddTextFrame(const TextFrame& frame,
+                                              Scalar scale) {
   FML_DCHECK(atlas_map_.empty());
-  if (frame.GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
-    frame.CollectUniqueFontGlyphPairs(alpha_glyph_map_, scale);
-  } else {
-    frame.CollectUniqueFontGlyphPairs(color_glyph_map_, scale);
+  GlyphAtlas::Type type = GetAtlasType(frame, scale);
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      frame.CollectUniqueFontGlyphPairs(alpha_glyph_map_, scale, type);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      frame.CollectUniqueFontGlyphPairs(color_glyph_map_, scale, type);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      frame.CollectUniqueFontGlyphPairs(sdf_glyph_map_, scale, type);
+      break;
   }
+  return type;
 }
 
 void LazyGlyphAtlas::ResetTextFrames() {
   alpha_glyph_map_.clear();
   color_glyph_map_.clear();
+  sdf_glyph_map_.clear();
   atlas_map_.clear();
 }
 
+const FontGlyphMap& LazyGlyphAtlas::GetGlyphMap(GlyphAtlas::Type type) const {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return alpha_glyph_map_;
+    case GlyphAtlas::Type::kColorBitmap:
+      return color_glyph_map_;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return sdf_glyph_map_;
+  }
+  FML_UNREACHABLE();
+}
+
+const std::shared_ptr<GlyphAtlasContext>& LazyGlyphAtlas::GetAtlasContext(
+    GlyphAtlas::Type type) const {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return alpha_context_;
+    case GlyphAtlas::Type::kColorBitmap:
+      return color_context_;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return sdf_context_;
+  }
+  FML_UNREACHABLE();
+}
+
 std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     Context& context,
     GlyphAtlas::Type type) const {
@@ -59,10 +117,9 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     return nullptr;
   }
 
-  auto& glyph_map = type == GlyphAtlas::Type::kAlphaBitmap ? alpha_glyph_map_
-                                                           : color_glyph_map_;
-  auto atlas_context =
-      type == GlyphAtlas::Type::kAlphaBitmap ? alpha_context_ : color_context_;
+  const auto& glyph_map = GetGlyphMap(type);
+  const auto& atlas_context = GetAtlasContext(type);
+  fml::ScopedFrameCost cost(fml::FrameCostLedger::Category::kGlyphAtlasUpdate);
   auto atlas = typographer_context_->CreateGlyphAtlas(context, type,
                                                       atlas_context, glyph_map);
   if (!atlas || !atlas->IsValid()) {
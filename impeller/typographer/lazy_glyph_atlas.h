@@ -21,7 +21,33 @@ class LazyGlyphAtlas {
 
   ~LazyGlyphAtlas();
 
-  void AddTextFrame(const TextFrame& frame, Scalar scale);
+  //----------------------------------------------------------------------------
+  /// @brief      Text at least this large, in pixels, is drawn from a signed
+  ///             distance field atlas so that large glyphs don't fill the
+  ///             bitmap atlas.
+  ///
+  static constexpr Scalar kSignedDistanceFieldMinimumSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Fonts drawn at this many scales recently are assumed to be
+  ///             under an animated transform, and are drawn from a signed
+  ///             distance field atlas so that each frame doesn't rasterize
+  ///             the glyphs again.
+  ///
+  static constexpr size_t kAnimatedScaleCount = 8u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add the glyphs of |frame| drawn at |scale| to the atlas they
+  ///             are drawn from.
+  ///
+  /// @return     The type of the atlas the frame must be drawn from.
+  ///
+  GlyphAtlas::Type AddTextFrame(const TextFrame& frame, Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The type of the atlas |frame| drawn at |scale| is drawn from.
+  ///
+  GlyphAtlas::Type GetAtlasType(const TextFrame& frame, Scalar scale) const;
 
   void ResetTextFrames();
 
@@ -34,11 +60,18 @@ class LazyGlyphAtlas {
 
   FontGlyphMap alpha_glyph_map_;
   FontGlyphMap color_glyph_map_;
+  FontGlyphMap sdf_glyph_map_;
   std::shared_ptr<GlyphAtlasContext> alpha_context_;
   std::shared_ptr<GlyphAtlasContext> color_context_;
+  std::shared_ptr<GlyphAtlasContext> sdf_context_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
       atlas_map_;
 
+  const FontGlyphMap& GetGlyphMap(GlyphAtlas::Type type) const;
+
+  const std::shared_ptr<GlyphAtlasContext>& GetAtlasContext(
+      GlyphAtlas::Type type) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(LazyGlyphAtlas);
 };
 
@@ -5,6 +5,7 @@
 #include "impeller/typographer/rectangle_packer.h"
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace impeller {
@@ -33,6 +34,8 @@ class SkylineRectanglePacker final : public RectanglePacker {
     return area_so_far_ / ((float)this->width() * this->height());
   }
 
+  float fragmentation() const final;
+
  private:
   struct SkylineSegment {
     int x_;
@@ -166,8 +169,208 @@ void SkylineRectanglePacker::addSkylineLevel(int skylineIndex,
   }
 }
 
-RectanglePacker* RectanglePacker::Factory(int width, int height) {
-  return new SkylineRectanglePacker(width, height);
+float SkylineRectanglePacker::fragmentation() const {
+  // Only the area above the skyline is free. It is a histogram so the largest
+  // free rectangle spans a run of segments at the height of the lowest one.
+  int64_t free_area = 0;
+  int64_t largest_free_area = 0;
+  for (size_t i = 0; i < skyline_.size(); ++i) {
+    free_area +=
+        static_cast<int64_t>(skyline_[i].width_) * (height() - skyline_[i].y_);
+    int run_width = 0;
+    int run_height = height();
+    for (size_t j = i; j < skyline_.size(); ++j) {
+      run_width += skyline_[j].width_;
+      run_height = std::min(run_height, height() - skyline_[j].y_);
+      largest_free_area = std::max(
+          largest_free_area, static_cast<int64_t>(run_width) * run_height);
+    }
+  }
+  if (free_area == 0) {
+    return 0.0f;
+  }
+  return 1.0f - static_cast<float>(largest_free_area) / free_area;
+}
+
+// Pack rectangles into a list of free rectangles. Each placement splits its
+// free rectangle along the shorter leftover axis, and free rectangles that
+// share a full edge are merged back together to limit fragmentation.
+// Based on Jukka Jylanki's "A Thousand Ways to Pack the Bin".
+class GuillotineRectanglePacker final : public RectanglePacker {
+ public:
+  GuillotineRectanglePacker(int w, int h) : RectanglePacker(w, h) {
+    this->reset();
+  }
+
+  ~GuillotineRectanglePacker() final {}
+
+  void reset() final {
+    area_so_far_ = 0;
+    free_rects_.clear();
+    free_rects_.push_back(FreeRect{0, 0, this->width(), this->height()});
+  }
+
+  bool addRect(int w, int h, IPoint16* loc) final;
+
+  float percentFull() const final {
+    return area_so_far_ / ((float)this->width() * this->height());
+  }
+
+  float fragmentation() const final;
+
+ private:
+  struct FreeRect {
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+
+    int64_t area() const { return static_cast<int64_t>(width_) * height_; }
+  };
+
+  std::vector<FreeRect> free_rects_;
+
+  int32_t area_so_far_;
+
+  // Split 'free_rect' after placing a width x height rectangle in its top-left
+  // corner and add the non-empty remainders to the free list.
+  void splitFreeRect(const FreeRect& free_rect, int width, int height);
+  // Merge pairs of free rectangles that together form a larger rectangle.
+  void mergeFreeRects();
+};
+
+bool GuillotineRectanglePacker::addRect(int width, int height, IPoint16* loc) {
+  if ((unsigned)width > (unsigned)this->width() ||
+      (unsigned)height > (unsigned)this->height()) {
+    return false;
+  }
+
+  // best area fit, ties broken by the shorter leftover side
+  int bestIndex = -1;
+  int64_t bestArea = std::numeric_limits<int64_t>::max();
+  int bestShortSide = std::numeric_limits<int>::max();
+  for (int i = 0; i < (int)free_rects_.size(); ++i) {
+    const FreeRect& free_rect = free_rects_[i];
+    if (free_rect.width_ < width || free_rect.height_ < height) {
+      continue;
+    }
+    int64_t leftoverArea =
+        free_rect.area() - static_cast<int64_t>(width) * height;
+    int shortSide =
+        std::min(free_rect.width_ - width, free_rect.height_ - height);
+    if (leftoverArea < bestArea ||
+        (leftoverArea == bestArea && shortSide < bestShortSide)) {
+      bestIndex = i;
+      bestArea = leftoverArea;
+      bestShortSide = shortSide;
+    }
+  }
+
+  if (-1 == bestIndex) {
+    loc->x_ = 0;
+    loc->y_ = 0;
+    return false;
+  }
+
+  FreeRect chosen = free_rects_[bestIndex];
+  free_rects_.erase(std::next(free_rects_.begin(), bestIndex));
+  this->splitFreeRect(chosen, width, height);
+  this->mergeFreeRects();
+
+  loc->x_ = chosen.x_;
+  loc->y_ = chosen.y_;
+  area_so_far_ += width * height;
+  return true;
+}
+
+void GuillotineRectanglePacker::splitFreeRect(const FreeRect& free_rect,
+                                              int width,
+                                              int height) {
+  int leftoverWidth = free_rect.width_ - width;
+  int leftoverHeight = free_rect.height_ - height;
+
+  FreeRect right;
+  FreeRect bottom;
+  if (leftoverWidth <= leftoverHeight) {
+    // horizontal split, the bottom remainder spans the full width
+    right = FreeRect{free_rect.x_ + width, free_rect.y_, leftoverWidth, height};
+    bottom = FreeRect{free_rect.x_, free_rect.y_ + height, free_rect.width_,
+                      leftoverHeight};
+  } else {
+    // vertical split, the right remainder spans the full height
+    right = FreeRect{free_rect.x_ + width, free_rect.y_, leftoverWidth,
+                     free_rect.height_};
+    bottom = FreeRect{free_rect.x_, free_rect.y_ + height, width,
+                      leftoverHeight};
+  }
+
+  if (right.width_ > 0 && right.height_ > 0) {
+    free_rects_.push_back(right);
+  }
+  if (bottom.width_ > 0 && bottom.height_ > 0) {
+    free_rects_.push_back(bottom);
+  }
+}
+
+void GuillotineRectanglePacker::mergeFreeRects() {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t i = 0; i < free_rects_.size() && !merged; ++i) {
+      for (size_t j = i + 1; j < free_rects_.size(); ++j) {
+        FreeRect& a = free_rects_[i];
+        const FreeRect& b = free_rects_[j];
+        if (a.x_ == b.x_ && a.width_ == b.width_) {
+          if (a.y_ + a.height_ == b.y_) {
+            a.height_ += b.height_;
+            merged = true;
+          } else if (b.y_ + b.height_ == a.y_) {
+            a.y_ = b.y_;
+            a.height_ += b.height_;
+            merged = true;
+          }
+        } else if (a.y_ == b.y_ && a.height_ == b.height_) {
+          if (a.x_ + a.width_ == b.x_) {
+            a.width_ += b.width_;
+            merged = true;
+          } else if (b.x_ + b.width_ == a.x_) {
+            a.x_ = b.x_;
+            a.width_ += b.width_;
+            merged = true;
+          }
+        }
+        if (merged) {
+          free_rects_.erase(std::next(free_rects_.begin(), j));
+          break;
+        }
+      }
+    }
+  }
+}
+
+float GuillotineRectanglePacker::fragmentation() const {
+  int64_t free_area = 0;
+  int64_t largest_free_area = 0;
+  for (const FreeRect& free_rect : free_rects_) {
+    free_area += free_rect.area();
+    largest_free_area = std::max(largest_free_area, free_rect.area());
+  }
+  if (free_area == 0) {
+    return 0.0f;
+  }
+  return 1.0f - static_cast<float>(largest_free_area) / free_area;
+}
+
+RectanglePacker* RectanglePacker::Factory(int width,
+                                          int height,
+                                          Strategy strategy) {
+  switch (strategy) {
+    case Strategy::kSkylineBottomLeft:
+      return new SkylineRectanglePacker(width, height);
+    case Strategy::kGuillotine:
+      return new GuillotineRectanglePacker(width, height);
+  }
+  FML_UNREACHABLE();
 }
 
 }  // namespace impeller
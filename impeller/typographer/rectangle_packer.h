@@ -23,10 +23,24 @@ struct IPoint16 {
 ///
 class RectanglePacker {
  public:
+  enum class Strategy {
+    /// Places each rectangle as low as possible on a skyline of the top edges
+    /// of the rectangles placed so far. Fast, but space below overhangs is
+    /// lost.
+    kSkylineBottomLeft,
+    /// Places each rectangle in the best fitting free rectangle, splits the
+    /// remainder in two and merges adjacent free rectangles. Slower, but
+    /// packs mixed sizes more tightly.
+    kGuillotine,
+  };
+
   //----------------------------------------------------------------------------
   /// @brief     Return an empty packer with area specified by width and height.
   ///
-  static RectanglePacker* Factory(int width, int height);
+  static RectanglePacker* Factory(
+      int width,
+      int height,
+      Strategy strategy = Strategy::kSkylineBottomLeft);
 
   virtual ~RectanglePacker() {}
 
@@ -49,6 +63,15 @@ class RectanglePacker {
   ///
   virtual float percentFull() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Returns how fragmented the remaining free area is.
+  ///
+  /// @return    The fraction of the free area that lies outside the largest
+  ///            free rectangle, between 0.0 and 1.0. 0.0 means all free space
+  ///            is available to a single rectangle.
+  ///
+  virtual float fragmentation() const = 0;
+
   //----------------------------------------------------------------------------
   /// @brief     Empty out all previously added rectangles.
   ///
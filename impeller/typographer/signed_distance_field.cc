@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/signed_distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr float kFar = 1e20f;
+
+// Computes the squared distance from each of the |count| samples of |f|,
+// spaced |stride| apart, to the nearest sample of value 0 in place, with the
+// lower envelope of parabolas of Felzenszwalb and Huttenlocher. The scratch
+// buffers hold at least |count| samples, or |count| + 1 for |z|.
+void DistanceTransform1D(float* f,
+                         size_t count,
+                         size_t stride,
+                         std::vector<float>& d,
+                         std::vector<size_t>& v,
+                         std::vector<float>& z) {
+  auto value = [f, stride](size_t i) { return f[i * stride]; };
+  auto intersection = [&value](size_t q, size_t p) {
+    float fq = value(q) + static_cast<float>(q * q);
+    float fp = value(p) + static_cast<float>(p * p);
+    return (fq - fp) / (2.0f * static_cast<float>(q - p));
+  };
+
+  size_t k = 0;
+  v[0] = 0;
+  z[0] = -std::numeric_limits<float>::infinity();
+  z[1] = std::numeric_limits<float>::infinity();
+  for (size_t q = 1; q < count; q++) {
+    float s = intersection(q, v[k]);
+    while (s <= z[k]) {
+      k--;
+      s = intersection(q, v[k]);
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = std::numeric_limits<float>::infinity();
+  }
+
+  k = 0;
+  for (size_t q = 0; q < count; q++) {
+    while (z[k + 1] < static_cast<float>(q)) {
+      k++;
+    }
+    float delta = static_cast<float>(q) - static_cast<float>(v[k]);
+    d[q] = delta * delta + value(v[k]);
+  }
+  for (size_t q = 0; q < count; q++) {
+    f[q * stride] = d[q];
+  }
+}
+
+// Replaces the 0 and kFar values of |grid| with the squared distance to the
+// nearest 0.
+void DistanceTransform2D(std::vector<float>& grid,
+                         size_t width,
+                         size_t height) {
+  const size_t max = std::max(width, height);
+  std::vector<float> d(max);
+  std::vector<size_t> v(max);
+  std::vector<float> z(max + 1);
+  for (size_t x = 0; x < width; x++) {
+    DistanceTransform1D(grid.data() + x, height, width, d, v, z);
+  }
+  for (size_t y = 0; y < height; y++) {
+    DistanceTransform1D(grid.data() + y * width, width, 1, d, v, z);
+  }
+}
+
+}  // namespace
+
+void ComputeSignedDistanceField(const uint8_t* coverage,
+                                size_t coverage_row_bytes,
+                                ISize size,
+                                Scalar spread,
+                                uint8_t* field,
+                                size_t field_row_bytes) {
+  FML_DCHECK(spread > 0);
+  if (size.IsEmpty()) {
+    return;
+  }
+  const size_t width = size.width;
+  const size_t height = size.height;
+
+  // The distances to the nearest pixel inside and outside the glyph.
+  std::vector<float> to_inside(width * height);
+  std::vector<float> to_outside(width * height);
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      bool inside = coverage[y * coverage_row_bytes + x] >= 128;
+      to_inside[y * width + x] = inside ? 0.0f : kFar;
+      to_outside[y * width + x] = inside ? kFar : 0.0f;
+    }
+  }
+  DistanceTransform2D(to_inside, width, height);
+  DistanceTransform2D(to_outside, width, height);
+
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      size_t i = y * width + x;
+      // The outline lies halfway between the centers of the pixels on either
+      // side of it.
+      float distance = to_inside[i] == 0.0f
+                           ? std::sqrt(to_outside[i]) - 0.5f
+                           : 0.5f - std::sqrt(to_inside[i]);
+      float value = std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+      field[y * field_row_bytes + x] =
+          static_cast<uint8_t>(std::round(value * 255.0f));
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,39 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "impeller/geometry/scalar.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Converts the 8-bit coverage of a glyph into an 8-bit signed
+///             distance field of the same size.
+///
+///             Pixels with at least half coverage are inside the glyph. Each
+///             pixel of the field holds the Euclidean distance from its center
+///             to the outline, positive inside, mapped from [-spread, spread]
+///             to [0, 255]. The outline is at 127.5.
+///
+/// @param[in]  coverage            The coverage of the glyph.
+/// @param[in]  coverage_row_bytes  The row pitch of |coverage|.
+/// @param[in]  size                The size of both images in pixels.
+/// @param[in]  spread              The distance covered by the field on either
+///                                 side of the outline.
+/// @param[out] field               The signed distance field.
+/// @param[in]  field_row_bytes     The row pitch of |field|.
+///
+void ComputeSignedDistanceField(const uint8_t* coverage,
+                                size_t coverage_row_bytes,
+                                ISize size,
+                                Scalar spread,
+                                uint8_t* field,
+                                size_t field_row_bytes);
+
+}  // namespace impeller
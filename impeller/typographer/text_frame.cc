@@ -67,12 +67,28 @@ Scalar TextFrame::RoundScaledFontSize(Scalar scale, Scalar point_size) {
   return std::round(scale * 100) / 100;
 }
 
+// static
+Scalar TextFrame::GetAtlasScale(GlyphAtlas::Type type,
+                                Scalar scale,
+                                Scalar point_size) {
+  if (type == GlyphAtlas::Type::kSignedDistanceField && point_size > 0) {
+    return GlyphAtlas::kSignedDistanceFieldFontSize / point_size;
+  }
+  return RoundScaledFontSize(scale, point_size);
+}
+
 void TextFrame::CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map,
                                             Scalar scale) const {
+  CollectUniqueFontGlyphPairs(glyph_map, scale, GetAtlasType());
+}
+
+void TextFrame::CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map,
+                                            Scalar scale,
+                                            GlyphAtlas::Type type) const {
   for (const TextRun& run : GetRuns()) {
     const Font& font = run.GetFont();
     auto rounded_scale =
-        RoundScaledFontSize(scale, font.GetMetrics().point_size);
+        GetAtlasScale(type, scale, font.GetMetrics().point_size);
     auto& set = glyph_map[{font, rounded_scale}];
     for (const TextRun::GlyphPosition& glyph_position :
          run.GetGlyphPositions()) {
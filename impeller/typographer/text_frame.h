@@ -26,8 +26,27 @@ class TextFrame {
 
   void CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map, Scalar scale) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Collect the glyphs of this frame for an atlas of |type|,
+  ///             which need not be the type of this frame.
+  ///
+  void CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map,
+                                   Scalar scale,
+                                   GlyphAtlas::Type type) const;
+
   static Scalar RoundScaledFontSize(Scalar scale, Scalar point_size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The scale the glyphs of a font of |point_size| drawn at
+  ///             |scale| are rasterized at in an atlas of |type|.
+  ///
+  ///             Glyphs in a signed distance field atlas are rasterized at
+  ///             the same size whatever the scale they are drawn at.
+  ///
+  static Scalar GetAtlasScale(GlyphAtlas::Type type,
+                              Scalar scale,
+                              Scalar point_size);
+
   //----------------------------------------------------------------------------
   /// @brief      The conservative bounding box for this text frame.
   ///
@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "impeller/typographer/backends/skia/text_frame_skia.h"
+#include "impeller/typographer/rectangle_packer.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace impeller {
+
+namespace {
+
+// Matches the padding the Skia typographer adds around each glyph.
+constexpr int kPadding = 2;
+
+// The string used by GlyphAtlasWithLotsOfdUniqueGlyphSize in
+// typographer_unittests.cc.
+constexpr const char* kTestString =
+    "QWERTYUIOPASDFGHJKLZXCVBNMqewrtyuiopasdfghjklzxcvbnm,.<>[]{};':"
+    "2134567890-=!@#$%^&*()_+"
+    "œ∑´®†¥¨ˆøπ““‘‘åß∂ƒ©˙∆˚¬…æ≈ç√∫˜µ≤≥≥≥≥÷¡™£¢∞§¶•ªº–≠⁄€‹›ﬁﬂ‡°·‚—±Œ„´‰Á¨Ø∏”’/"
+    "* Í˝ */¸˛Ç◊ı˜Â¯˘¿";
+
+void CollectGlyphSizes(const SkFont& sk_font,
+                       Scalar scale,
+                       std::vector<ISize>& sizes) {
+  auto blob = SkTextBlob::MakeFromString(kTestString, sk_font);
+  FontGlyphMap font_glyph_map;
+  MakeTextFrameFromTextBlobSkia(blob).value().CollectUniqueFontGlyphPairs(
+      font_glyph_map, scale);
+  for (const auto& font_value : font_glyph_map) {
+    for (const auto& glyph : font_value.second) {
+      auto size = ISize::Ceil(glyph.bounds.size * font_value.first.scale);
+      sizes.push_back(size + ISize(kPadding, kPadding));
+    }
+  }
+}
+
+// Small Latin glyphs at the non-zero scales used by the unit tests.
+std::vector<ISize> MakeLatinGlyphSet() {
+  std::vector<ISize> sizes;
+  SkFont sk_font;
+  for (size_t index = 1; index < 8; index++) {
+    CollectGlyphSizes(sk_font, 0.6 * index, sizes);
+  }
+  return sizes;
+}
+
+// The Latin set mixed with glyphs the size of the 50pt emoji used by the
+// unit tests. The emoji font is a test fixture that isn't available here, so
+// the same string at 50pt stands in for it.
+std::vector<ISize> MakeMixedGlyphSet() {
+  auto sizes = MakeLatinGlyphSet();
+  SkFont emoji_sized_font;
+  emoji_sized_font.setSize(50.0);
+  CollectGlyphSizes(emoji_sized_font, 1.0, sizes);
+  return sizes;
+}
+
+bool PackAll(RectanglePacker& packer, const std::vector<ISize>& sizes) {
+  IPoint16 location;
+  for (const auto& size : sizes) {
+    if (!packer.addRect(size.width, size.height, &location)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Grows the atlas the same way the typographer does until every glyph fits.
+std::unique_ptr<RectanglePacker> PackIntoSmallestAtlas(
+    const std::vector<ISize>& sizes,
+    RectanglePacker::Strategy strategy,
+    ISize& atlas_size) {
+  atlas_size = ISize(8, 8);
+  while (atlas_size.width <= 4096 && atlas_size.height <= 4096) {
+    auto packer = std::unique_ptr<RectanglePacker>(RectanglePacker::Factory(
+        atlas_size.width, atlas_size.height, strategy));
+    if (PackAll(*packer, sizes)) {
+      return packer;
+    }
+    if (atlas_size.width <= atlas_size.height) {
+      atlas_size.width *= 2;
+    } else {
+      atlas_size.height *= 2;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+static void BM_PackGlyphs(benchmark::State& state,
+                          RectanglePacker::Strategy strategy,
+                          std::vector<ISize> (*make_glyph_set)()) {
+  auto sizes = make_glyph_set();
+  // Sort by decreasing height so the result doesn't depend on the iteration
+  // order of the glyph map.
+  std::sort(sizes.begin(), sizes.end(), [](const ISize& a, const ISize& b) {
+    return a.height > b.height;
+  });
+
+  ISize atlas_size;
+  std::unique_ptr<RectanglePacker> packer;
+  for (auto _ : state) {
+    packer = PackIntoSmallestAtlas(sizes, strategy, atlas_size);
+    benchmark::DoNotOptimize(packer);
+  }
+  if (!packer) {
+    state.SkipWithError("Glyphs did not fit in the largest atlas.");
+    return;
+  }
+  state.counters["Glyphs"] = sizes.size();
+  state.counters["AtlasArea"] = atlas_size.Area();
+  state.counters["Occupancy"] = packer->percentFull();
+  state.counters["Fragmentation"] = packer->fragmentation();
+}
+
+BENCHMARK_CAPTURE(BM_PackGlyphs,
+                  latin_skyline,
+                  RectanglePacker::Strategy::kSkylineBottomLeft,
+                  &MakeLatinGlyphSet);
+BENCHMARK_CAPTURE(BM_PackGlyphs,
+                  latin_guillotine,
+                  RectanglePacker::Strategy::kGuillotine,
+                  &MakeLatinGlyphSet);
+BENCHMARK_CAPTURE(BM_PackGlyphs,
+                  mixed_skyline,
+                  RectanglePacker::Strategy::kSkylineBottomLeft,
+                  &MakeMixedGlyphSet);
+BENCHMARK_CAPTURE(BM_PackGlyphs,
+                  mixed_guillotine,
+                  RectanglePacker::Strategy::kGuillotine,
+                  &MakeMixedGlyphSet);
+
+}  // namespace impeller
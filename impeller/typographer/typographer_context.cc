@@ -4,7 +4,14 @@
 
 #include "impeller/typographer/typographer_context.h"
 
+#include <cstring>
 #include <utility>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/allocator.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
 
@@ -18,4 +25,62 @@ bool TypographerContext::IsValid() const {
   return is_valid_;
 }
 
+bool TypographerContext::SupportsSignedDistanceFields() const {
+  return false;
+}
+
+bool TypographerContext::UploadGlyphAtlasRegion(
+    Context& context,
+    const std::shared_ptr<Texture>& texture,
+    const uint8_t* pixels,
+    size_t bytes_per_row,
+    IRect region) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!texture || !pixels || region.IsEmpty() ||
+      !context.GetCapabilities()->SupportsBufferToTextureBlits()) {
+    return false;
+  }
+  const auto& descriptor = texture->GetTextureDescriptor();
+  region = region.Intersection(IRect::MakeSize(descriptor.size))
+               .value_or(IRect::MakeSize(ISize{}));
+  if (region.IsEmpty()) {
+    return false;
+  }
+
+  const auto bytes_per_pixel = BytesPerPixelForPixelFormat(descriptor.format);
+  const size_t region_bytes_per_row = region.size.width * bytes_per_pixel;
+
+  // The blit expects tightly packed rows of the region.
+  std::vector<uint8_t> packed(region_bytes_per_row * region.size.height);
+  const uint8_t* src = pixels + region.origin.y * bytes_per_row +
+                       region.origin.x * bytes_per_pixel;
+  for (auto row = 0; row < region.size.height; row++) {
+    std::memcpy(packed.data() + row * region_bytes_per_row,
+                src + row * bytes_per_row, region_bytes_per_row);
+  }
+  auto buffer = context.GetResourceAllocator()->CreateBufferWithCopy(
+      packed.data(), packed.size());
+  if (!buffer) {
+    return false;
+  }
+
+  auto command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("Glyph Atlas Update");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  if (!blit_pass->AddCopy(buffer->AsBufferView(), texture, region,
+                          "Glyph Atlas Region")) {
+    return false;
+  }
+  if (!blit_pass->EncodeCommands(context.GetResourceAllocator())) {
+    return false;
+  }
+  return command_buffer->SubmitCommands();
+}
+
 }  // namespace impeller
@@ -26,6 +26,12 @@ class TypographerContext {
 
   virtual bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether this context can create atlases of type
+  ///             `GlyphAtlas::Type::kSignedDistanceField`.
+  ///
+  virtual bool SupportsSignedDistanceFields() const;
+
   virtual std::shared_ptr<GlyphAtlasContext> CreateGlyphAtlasContext()
       const = 0;
 
@@ -45,6 +51,27 @@ class TypographerContext {
   ///
   TypographerContext();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Copy a region of the CPU side atlas bitmap into the same
+  ///             region of the atlas texture. Only the bytes of the region
+  ///             are transferred.
+  ///
+  /// @param[in]  context        The context used to record the blit.
+  /// @param[in]  texture        The atlas texture.
+  /// @param[in]  pixels         The first pixel of the atlas bitmap.
+  /// @param[in]  bytes_per_row  The row pitch of the atlas bitmap.
+  /// @param[in]  region         The region of the atlas to copy.
+  ///
+  /// @return     If the copy was submitted. This fails on backends that
+  ///             cannot blit buffers to textures, in which case callers must
+  ///             replace the full contents of the texture.
+  ///
+  static bool UploadGlyphAtlasRegion(Context& context,
+                                     const std::shared_ptr<Texture>& texture,
+                                     const uint8_t* pixels,
+                                     size_t bytes_per_row,
+                                     IRect region);
+
  private:
   bool is_valid_ = false;
 
@@ -8,6 +8,7 @@
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -290,6 +291,157 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   ASSERT_NE(old_packer, new_packer);
 }
 
+TEST_P(TypographerTest, GlyphAtlasGrowsWithoutMovingExistingGlyphs) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("spooky 1", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas = CreateGlyphAtlas(
+      *GetContext(), context.get(), GlyphAtlas::Type::kColorBitmap, 1.0f,
+      atlas_context, MakeTextFrameFromTextBlobSkia(blob).value());
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+  auto old_size = atlas_context->GetAtlasSize();
+
+  std::vector<std::pair<FontGlyphPair, Rect>> old_positions;
+  atlas->IterateGlyphs(
+      [&](const ScaledFont& scaled_font, const Glyph& glyph, const Rect& rect) {
+        old_positions.push_back({{scaled_font, glyph}, rect});
+        return true;
+      });
+
+  // Many more glyphs than fit in the remaining space of the small atlas.
+  auto blob2 = SkTextBlob::MakeFromString(
+      "the quick brown fox jumped over the lazy dog. THE QUICK BROWN FOX",
+      sk_font);
+  auto next_atlas = CreateGlyphAtlas(
+      *GetContext(), context.get(), GlyphAtlas::Type::kColorBitmap, 1.0f,
+      atlas_context, MakeTextFrameFromTextBlobSkia(blob2).value());
+  ASSERT_EQ(atlas, next_atlas);
+
+  auto new_size = atlas_context->GetAtlasSize();
+  EXPECT_GT(new_size.Area(), old_size.Area());
+  EXPECT_EQ(next_atlas->GetTexture()->GetSize(), new_size);
+  for (const auto& [pair, rect] : old_positions) {
+    auto position = next_atlas->FindFontGlyphBounds(pair);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(position.value(), rect);
+  }
+}
+
+TEST_P(TypographerTest, GlyphAtlasContextForgetsStaleGlyphs) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  SkFont sk_font;
+
+  FontGlyphMap stale_glyphs;
+  MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("xyz", sk_font))
+      .value()
+      .CollectUniqueFontGlyphPairs(stale_glyphs, 1.0f);
+  FontGlyphMap recent_glyphs;
+  MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("abc", sk_font))
+      .value()
+      .CollectUniqueFontGlyphPairs(recent_glyphs, 1.0f);
+
+  atlas_context->MarkGlyphsUsed(stale_glyphs);
+  for (size_t i = 0; i < GlyphAtlasContext::kGlyphEvictionFrameCount; i++) {
+    atlas_context->MarkGlyphsUsed(recent_glyphs);
+  }
+
+  FontGlyphMap retained;
+  atlas_context->CollectRecentlyUsedGlyphs(retained);
+  ASSERT_EQ(retained.size(), 1u);
+  EXPECT_EQ(retained.begin()->second, recent_glyphs.begin()->second);
+}
+
+TEST_P(TypographerTest, LazyAtlasDrawsLargeTextFromSignedDistanceFields) {
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+  SkFont small_font;
+  small_font.setSize(12);
+  auto small_frame = MakeTextFrameFromTextBlobSkia(
+                         SkTextBlob::MakeFromString("hello", small_font))
+                         .value();
+  SkFont large_font;
+  large_font.setSize(LazyGlyphAtlas::kSignedDistanceFieldMinimumSize);
+  auto large_frame = MakeTextFrameFromTextBlobSkia(
+                         SkTextBlob::MakeFromString("hello", large_font))
+                         .value();
+
+  EXPECT_EQ(lazy_atlas.AddTextFrame(small_frame, 1.0f),
+            GlyphAtlas::Type::kAlphaBitmap);
+  // The size on screen counts.
+  EXPECT_EQ(lazy_atlas.AddTextFrame(small_frame, 10.0f),
+            GlyphAtlas::Type::kSignedDistanceField);
+  EXPECT_EQ(lazy_atlas.AddTextFrame(large_frame, 1.0f),
+            GlyphAtlas::Type::kSignedDistanceField);
+
+  auto atlas = lazy_atlas.CreateOrGetGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_NE(atlas, nullptr);
+  EXPECT_EQ(atlas->GetType(), GlyphAtlas::Type::kSignedDistanceField);
+  EXPECT_EQ(atlas->GetTexture()->GetTextureDescriptor().format,
+            PixelFormat::kA8UNormInt);
+  // The small text drawn at a large scale is rasterized at the same size as
+  // the large text.
+  EXPECT_EQ(atlas->GetGlyphCount(), 8u);
+  atlas->IterateGlyphs([](const ScaledFont& scaled_font, const Glyph& glyph,
+                          const Rect& rect) -> bool {
+    EXPECT_FLOAT_EQ(scaled_font.font.GetMetrics().point_size *
+                        scaled_font.scale,
+                    GlyphAtlas::kSignedDistanceFieldFontSize);
+    return true;
+  });
+}
+
+TEST_P(TypographerTest, LazyAtlasDrawsTextAtChangingScalesFromSDFs) {
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+  SkFont sk_font;
+  auto frame = MakeTextFrameFromTextBlobSkia(
+                   SkTextBlob::MakeFromString("hello", sk_font))
+                   .value();
+
+  // A zoom animation draws the text at a new scale every frame.
+  for (size_t i = 0; i < LazyGlyphAtlas::kAnimatedScaleCount; i++) {
+    ASSERT_EQ(lazy_atlas.AddTextFrame(frame, 1.0f + i * 0.1f),
+              GlyphAtlas::Type::kAlphaBitmap);
+    ASSERT_NE(lazy_atlas.CreateOrGetGlyphAtlas(*GetContext(),
+                                               GlyphAtlas::Type::kAlphaBitmap),
+              nullptr);
+    lazy_atlas.ResetTextFrames();
+  }
+  EXPECT_EQ(lazy_atlas.AddTextFrame(frame, 2.0f),
+            GlyphAtlas::Type::kSignedDistanceField);
+}
+
+TEST_P(TypographerTest, SignedDistanceFieldIsHalfwayAtTheOutline) {
+  constexpr ISize kSize(16, 16);
+  std::vector<uint8_t> coverage(kSize.Area(), 0);
+  // A square covering the pixels [4, 12) in both directions.
+  for (auto y = 4; y < 12; y++) {
+    for (auto x = 4; x < 12; x++) {
+      coverage[y * kSize.width + x] = 255;
+    }
+  }
+  std::vector<uint8_t> field(kSize.Area());
+  ComputeSignedDistanceField(coverage.data(), kSize.width, kSize, 4.0f,
+                             field.data(), kSize.width);
+
+  auto at = [&field, &kSize](int x, int y) {
+    return field[y * kSize.width + x];
+  };
+  // Half a pixel from the outline on either side.
+  EXPECT_EQ(at(4, 8), 143);
+  EXPECT_EQ(at(3, 8), 112);
+  EXPECT_EQ(at(4, 8) + at(3, 8), 255);
+  // Deeper inside is larger, further outside is smaller.
+  EXPECT_GT(at(6, 8), at(4, 8));
+  EXPECT_LT(at(1, 8), at(3, 8));
+  // Beyond the spread, the field saturates.
+  EXPECT_EQ(at(0, 0), 0);
+}
+
 TEST_P(TypographerTest, MaybeHasOverlapping) {
   sk_sp<SkFontMgr> font_mgr = SkFontMgr::RefDefault();
   sk_sp<SkTypeface> typeface =
@@ -352,6 +504,61 @@ TEST_P(TypographerTest, RectanglePackerAddsNonoverlapingRectangles) {
   ASSERT_EQ(packer->percentFull(), 0);
 }
 
+TEST_P(TypographerTest, GuillotinePackerAddsNonoverlapingRectangles) {
+  auto packer = std::unique_ptr<RectanglePacker>(RectanglePacker::Factory(
+      200, 100, RectanglePacker::Strategy::kGuillotine));
+  ASSERT_NE(packer, nullptr);
+  ASSERT_EQ(packer->percentFull(), 0);
+  ASSERT_EQ(packer->fragmentation(), 0);
+
+  const SkIRect packer_area = SkIRect::MakeXYWH(0, 0, 200, 100);
+
+  IPoint16 first_output = {-1, -1};
+  ASSERT_TRUE(packer->addRect(20, 20, &first_output));
+  const SkIRect first_rect =
+      SkIRect::MakeXYWH(first_output.x(), first_output.y(), 20, 20);
+  ASSERT_TRUE(packer_area.contains(first_rect));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.02));
+
+  IPoint16 second_output = {-1, -1};
+  ASSERT_TRUE(packer->addRect(140, 90, &second_output));
+  const SkIRect second_rect =
+      SkIRect::MakeXYWH(second_output.x(), second_output.y(), 140, 90);
+  ASSERT_TRUE(packer_area.contains(second_rect));
+  ASSERT_FALSE(SkIRect::Intersects(first_rect, second_rect));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.65));
+
+  // The free space is split across several rectangles now.
+  ASSERT_GT(packer->fragmentation(), 0);
+
+  packer->reset();
+  ASSERT_EQ(packer->percentFull(), 0);
+  ASSERT_EQ(packer->fragmentation(), 0);
+}
+
+TEST_P(TypographerTest, GuillotinePackerMergesFreeRectangles) {
+  auto packer = std::unique_ptr<RectanglePacker>(RectanglePacker::Factory(
+      100, 100, RectanglePacker::Strategy::kGuillotine));
+
+  // Four quadrants fill the area exactly, which only works if the free
+  // rectangles left behind by each split are reused.
+  for (int i = 0; i < 4; i++) {
+    IPoint16 output;
+    ASSERT_TRUE(packer->addRect(50, 50, &output));
+  }
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 1.0));
+  IPoint16 output;
+  ASSERT_FALSE(packer->addRect(1, 1, &output));
+
+  // A full width strip along the top leaves one merged free rectangle below.
+  packer->reset();
+  ASSERT_TRUE(packer->addRect(20, 10, &output));
+  ASSERT_TRUE(packer->addRect(80, 10, &output));
+  ASSERT_EQ(packer->fragmentation(), 0);
+  ASSERT_TRUE(packer->addRect(100, 90, &output));
+  ASSERT_EQ(output.y(), 10);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -237,6 +237,13 @@ abstract class SceneBuilder {
   ///
   /// The objects are transformed by the given matrix before rasterization.
   ///
+  /// If `lateLatchPointer` is true, the objects are also moved by the distance
+  /// the first pointer that is down moved after the events this scene was
+  /// built from, right before the scene is rasterized. This hides a frame of
+  /// latency for content that follows the pointer, such as a dragged object
+  /// or the tip of a stroke. The framework sees the newer events and moves the
+  /// content itself in the next frame.
+  ///
   /// {@template dart.ui.sceneBuilder.oldLayer}
   /// If `oldLayer` is not null the engine will attempt to reuse the resources
   /// allocated for the old layer when rendering the new layer. This is purely
@@ -264,6 +271,7 @@ abstract class SceneBuilder {
   TransformEngineLayer pushTransform(
     Float64List matrix4, {
     TransformEngineLayer? oldLayer,
+    bool lateLatchPointer = false,
   });
 
   /// Pushes an offset operation onto the operation stack.
@@ -639,18 +647,19 @@ base class _NativeSceneBuilder extends NativeFieldWrapperClass1 implements Scene
   TransformEngineLayer pushTransform(
     Float64List matrix4, {
     TransformEngineLayer? oldLayer,
+    bool lateLatchPointer = false,
   }) {
     assert(_matrix4IsValid(matrix4));
     assert(_debugCheckCanBeUsedAsOldLayer(oldLayer, 'pushTransform'));
     final EngineLayer engineLayer = _NativeEngineLayer._();
-    _pushTransform(engineLayer, matrix4, oldLayer?._nativeLayer);
+    _pushTransform(engineLayer, matrix4, oldLayer?._nativeLayer, lateLatchPointer);
     final TransformEngineLayer layer = TransformEngineLayer._(engineLayer);
     assert(_debugPushLayer(layer));
     return layer;
   }
 
-  @Native<Void Function(Pointer<Void>, Handle, Handle, Handle)>(symbol: 'SceneBuilder::pushTransformHandle')
-  external void _pushTransform(EngineLayer layer, Float64List matrix4, EngineLayer? oldLayer);
+  @Native<Void Function(Pointer<Void>, Handle, Handle, Handle, Bool)>(symbol: 'SceneBuilder::pushTransformHandle')
+  external void _pushTransform(EngineLayer layer, Float64List matrix4, EngineLayer? oldLayer, bool lateLatchPointer);
 
   @override
   OffsetEngineLayer pushOffset(
@@ -900,7 +909,7 @@ base class _NativeSceneBuilder extends NativeFieldWrapperClass1 implements Scene
     _addPicture(offset.dx, offset.dy, picture as _NativePicture, hints);
   }
 
-  @Native<Void Function(Pointer<Void>, Double, Double, Pointer<Void>, Int32)>(symbol: 'SceneBuilder::addPicture')
+  @Native<Void Function(Pointer<Void>, Double, Double, Pointer<Void>, Int32)>(symbol: 'SceneBuilder::addPicture', isLeaf: true)
   external void _addPicture(double dx, double dy, _NativePicture picture, int hints);
 
   @override
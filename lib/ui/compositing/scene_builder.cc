@@ -43,9 +43,11 @@ SceneBuilder::~SceneBuilder() = default;
 
 void SceneBuilder::pushTransform(Dart_Handle layer_handle,
                                  tonic::Float64List& matrix4,
-                                 const fml::RefPtr<EngineLayer>& oldLayer) {
+                                 const fml::RefPtr<EngineLayer>& oldLayer,
+                                 bool lateLatchPointer) {
   SkM44 sk_matrix = ToSkM44(matrix4);
   auto layer = std::make_shared<flutter::TransformLayer>(sk_matrix);
+  layer->set_pointer_late_latched(lateLatchPointer);
   PushLayer(layer);
   // matrix4 has to be released before we can return another Dart object
   matrix4.Release();
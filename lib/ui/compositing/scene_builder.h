@@ -38,13 +38,15 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
 
   void pushTransformHandle(Dart_Handle layer_handle,
                            Dart_Handle matrix4_handle,
-                           fml::RefPtr<EngineLayer> oldLayer) {
+                           fml::RefPtr<EngineLayer> oldLayer,
+                           bool lateLatchPointer) {
     tonic::Float64List matrix4(matrix4_handle);
-    pushTransform(layer_handle, matrix4, oldLayer);
+    pushTransform(layer_handle, matrix4, oldLayer, lateLatchPointer);
   }
   void pushTransform(Dart_Handle layer_handle,
                      tonic::Float64List& matrix4,
-                     const fml::RefPtr<EngineLayer>& oldLayer);
+                     const fml::RefPtr<EngineLayer>& oldLayer,
+                     bool lateLatchPointer = false);
   void pushOffset(Dart_Handle layer_handle,
                   double dx,
                   double dy,
@@ -96,6 +96,7 @@ typedef CanvasPath Path;
   V(IsolateNameServerNatives::RemovePortNameMapping, 1)               \
   V(NativeStringAttribute::initLocaleStringAttribute, 4)              \
   V(NativeStringAttribute::initSpellOutStringAttribute, 3)            \
+  V(Paragraph::layoutBatch, 2)                                        \
   V(PlatformConfigurationNativeApi::DefaultRouteName, 0)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame, 0)                 \
   V(PlatformConfigurationNativeApi::Render, 1)                        \
@@ -155,6 +156,7 @@ typedef CanvasPath Path;
   V(Canvas, drawPoints, 5)                             \
   V(Canvas, drawRRect, 4)                              \
   V(Canvas, drawRect, 7)                               \
+  V(Canvas, drawRects, 5)                              \
   V(Canvas, drawShadow, 5)                             \
   V(Canvas, drawVertices, 5)                           \
   V(Canvas, getDestinationClipBounds, 2)               \
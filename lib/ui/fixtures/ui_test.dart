@@ -42,6 +42,18 @@ void customOnErrorThrow() {
   throw Exception('throw1');
 }
 
+@pragma('vm:entry-point')
+void receiveLargePlatformMessage() {
+  channelBuffers.setListener('test/large', (ByteData? data, PlatformMessageResponseCallback callback) {
+    _validateLargePlatformMessage(data);
+    callback(null);
+  });
+  _finish();
+}
+
+@pragma('vm:external-name', 'ValidateLargePlatformMessage')
+external void _validateLargePlatformMessage(ByteData? data);
+
 @pragma('vm:entry-point')
 void setLatencyPerformanceMode() {
   PlatformDispatcher.instance.requestDartPerformanceMode(DartPerformanceMode.latency);
@@ -994,6 +1006,23 @@ void hooksTests() async {
     }
   });
 
+  await test('background isolate pool', () async {
+    await BackgroundIsolatePool.warmUp();
+    final List<bool> results = await Future.wait(<Future<bool>>[
+      for (int i = 0; i < 2 * BackgroundIsolatePool.isolateCount; i++)
+        BackgroundIsolatePool.run(_isBackgroundIsolate),
+    ]);
+    expectEquals(results.every((bool result) => result), true);
+
+    Object? error;
+    try {
+      await BackgroundIsolatePool.run<void>(_throwStateError);
+    } catch (e) {
+      error = e;
+    }
+    expectEquals(error is StateError, true);
+  });
+
   _finish();
 }
 
@@ -1003,6 +1032,13 @@ void _backgroundRootIsolateTestMain(SendPort port) {
   port.send(RootIsolateToken.instance == null);
 }
 
+/// Whether the isolate executing the function is not a root isolate.
+bool _isBackgroundIsolate() => RootIsolateToken.instance == null;
+
+void _throwStateError() {
+  throw StateError('Thrown on a background isolate.');
+}
+
 /// Sends `true` on [port] if [PlatformDispatcher.sendPortPlatformMessage]
 /// throws an exception without calling
 /// [PlatformDispatcher.registerBackgroundIsolate].
@@ -5432,6 +5432,27 @@ abstract class Canvas {
   ///    [List<Float32List>].
   void drawRawPoints(PointMode pointMode, Float32List points, Paint paint);
 
+  /// Draws a batch of rectangles with the given [Paint].
+  ///
+  /// The `rects` argument is interpreted as a list of four floating point
+  /// numbers for each rectangle, being its left, top, right and bottom edges,
+  /// in the same way as [Rect.fromLTRB].
+  ///
+  /// If non-null, the `colors` argument holds one color value for each
+  /// rectangle, encoded as with [Color.value], which replaces the
+  /// [Paint.color] of the `paint` for that rectangle. All of the other
+  /// properties of the `paint` are shared by every rectangle.
+  ///
+  /// The result is the same as calling [drawRect] for each rectangle, but
+  /// this method is much faster when drawing many rectangles, such as the
+  /// bars or markers of a chart.
+  ///
+  /// See also:
+  ///
+  ///  * [drawRect], which draws a single rectangle.
+  ///  * [drawRawPoints], which draws a batch of points or lines.
+  void drawRawRects(Float32List rects, Int32List? colors, Paint paint);
+
   /// Draws a set of [Vertices] onto the canvas as one or more triangles.
   ///
   /// The [Paint.color] property specifies the default color to use for the
@@ -6121,6 +6142,20 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @Native<Void Function(Pointer<Void>, Handle, Handle, Int32, Handle)>(symbol: 'Canvas::drawPoints')
   external void _drawPoints(List<Object?>? paintObjects, ByteData paintData, int pointMode, Float32List points);
 
+  @override
+  void drawRawRects(Float32List rects, Int32List? colors, Paint paint) {
+    if (rects.length % 4 != 0) {
+      throw ArgumentError('"rects" length must be a multiple of four.');
+    }
+    if (colors != null && colors.length * 4 != rects.length) {
+      throw ArgumentError('If non-null, "colors" length must be one fourth the length of "rects".');
+    }
+    _drawRects(paint._objects, paint._data, rects, colors);
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Handle, Handle, Handle)>(symbol: 'Canvas::drawRects')
+  external void _drawRects(List<Object?>? paintObjects, ByteData paintData, Float32List rects, Int32List? colors);
+
   @override
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint) {
     assert(!vertices.debugDisposed);
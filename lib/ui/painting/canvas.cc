@@ -540,6 +540,33 @@ void Canvas::drawPoints(Dart_Handle paint_objects,
   }
 }
 
+void Canvas::drawRects(Dart_Handle paint_objects,
+                       Dart_Handle paint_data,
+                       Dart_Handle rects_handle,
+                       Dart_Handle colors_handle) {
+  Paint paint(paint_objects, paint_data);
+
+  static_assert(sizeof(SkRect) == sizeof(float) * 4,
+                "SkRect doesn't use floats.");
+
+  FML_DCHECK(paint.isNotNull());
+  if (display_list_builder_) {
+    tonic::Float32List rects(rects_handle);
+    tonic::Int32List colors(colors_handle);
+
+    DlPaint dl_paint;
+    paint.paint(dl_paint, kDrawRectFlags);
+    const SkRect* sk_rects = reinterpret_cast<const SkRect*>(rects.data());
+    const size_t count = rects.num_elements() / 4;  // SkRect have four floats.
+    for (size_t i = 0; i < count; i++) {
+      if (colors.data() != nullptr) {
+        dl_paint.setColor(DlColor(static_cast<uint32_t>(colors[i])));
+      }
+      builder()->DrawRect(sk_rects[i], dl_paint);
+    }
+  }
+}
+
 void Canvas::drawVertices(const Vertices* vertices,
                           DlBlendMode blend_mode,
                           Dart_Handle paint_objects,
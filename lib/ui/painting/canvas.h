@@ -164,6 +164,11 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   DlCanvas::PointMode point_mode,
                   const tonic::Float32List& points);
 
+  void drawRects(Dart_Handle paint_objects,
+                 Dart_Handle paint_data,
+                 Dart_Handle rects_handle,
+                 Dart_Handle colors_handle);
+
   void drawVertices(const Vertices* vertices,
                     DlBlendMode blend_mode,
                     Dart_Handle paint_objects,
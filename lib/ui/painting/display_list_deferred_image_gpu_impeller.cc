@@ -4,12 +4,68 @@
 
 #include "flutter/lib/ui/painting/display_list_deferred_image_gpu_impeller.h"
 
+#include <optional>
+#include <unordered_map>
 #include <utility>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/make_copyable.h"
 
 namespace flutter {
 
+namespace {
+
+// Identifies the raster snapshot of a display list at one size, taken by one
+// snapshot delegate.
+struct SnapshotKey {
+  const SnapshotDelegate* snapshot_delegate = nullptr;
+  uint32_t display_list_id = 0u;
+  int32_t width = 0;
+  int32_t height = 0;
+
+  bool operator==(const SnapshotKey& other) const {
+    return snapshot_delegate == other.snapshot_delegate &&
+           display_list_id == other.display_list_id && width == other.width &&
+           height == other.height;
+  }
+
+  struct Hash {
+    std::size_t operator()(const SnapshotKey& key) const {
+      return fml::HashCombine(key.snapshot_delegate, key.display_list_id,
+                              key.width, key.height);
+    }
+  };
+};
+
+using SnapshotTextureMap = std::unordered_map<SnapshotKey,
+                                              std::weak_ptr<impeller::Texture>,
+                                              SnapshotKey::Hash>;
+
+// The snapshots of display lists that are still used by an image. Converting
+// the same picture to an image at the same size again, such as thumbnails
+// that are requested repeatedly, shares the texture instead of rasterizing
+// the display list again. Only used on the raster thread.
+SnapshotTextureMap& GetSnapshotTextures() {
+  thread_local SnapshotTextureMap textures;
+  return textures;
+}
+
+void RememberSnapshotTexture(
+    const SnapshotKey& key,
+    const std::shared_ptr<impeller::Texture>& texture) {
+  auto& textures = GetSnapshotTextures();
+  for (auto it = textures.begin(); it != textures.end();) {
+    if (it->second.expired()) {
+      it = textures.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  textures[key] = texture;
+}
+
+}  // namespace
+
 sk_sp<DlDeferredImageGPUImpeller> DlDeferredImageGPUImpeller::Make(
     std::unique_ptr<LayerTree> layer_tree,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
@@ -175,6 +231,24 @@ void DlDeferredImageGPUImpeller::ImageWrapper::SnapshotDisplayList(
               SkRect::MakeWH(wrapper->size_.width(), wrapper->size_.height()),
               wrapper->texture_registry_);
         }
+        // Display lists flattened from a layer tree are never seen again.
+        std::optional<SnapshotKey> key;
+        if (!layer_tree) {
+          key = SnapshotKey{
+              .snapshot_delegate = snapshot_delegate.get(),
+              .display_list_id = wrapper->display_list_->unique_id(),
+              .width = wrapper->size_.width(),
+              .height = wrapper->size_.height(),
+          };
+          auto found = GetSnapshotTextures().find(key.value());
+          if (found != GetSnapshotTextures().end()) {
+            if (auto texture = found->second.lock()) {
+              wrapper->texture_ = std::move(texture);
+              return;
+            }
+          }
+        }
+
         auto snapshot = snapshot_delegate->MakeRasterSnapshot(
             wrapper->display_list_, wrapper->size_);
         if (!snapshot) {
@@ -183,6 +257,9 @@ void DlDeferredImageGPUImpeller::ImageWrapper::SnapshotDisplayList(
           return;
         }
         wrapper->texture_ = snapshot->impeller_texture();
+        if (key.has_value() && wrapper->texture_) {
+          RememberSnapshotTexture(key.value(), wrapper->texture_);
+        }
       }));
 }
 
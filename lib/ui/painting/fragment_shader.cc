@@ -100,9 +100,8 @@ std::shared_ptr<DlColorSource> ReusableFragmentShader::shader(
   // The lifetime of this object is longer than a frame, and the uniforms can be
   // continually changed on the UI thread. So we take a copy of the uniforms
   // before handing it to the DisplayList for consumption on the render thread.
-  auto uniform_data = std::make_shared<std::vector<uint8_t>>();
-  uniform_data->resize(uniform_data_->size());
-  memcpy(uniform_data->data(), uniform_data_->bytes(), uniform_data->size());
+  auto uniform_data = std::make_shared<std::vector<uint8_t>>(
+      uniform_data_->bytes(), uniform_data_->bytes() + uniform_data_->size());
 
   auto source = program_->MakeDlColorSource(std::move(uniform_data), samplers_);
   // The samplers should have been checked as they were added, this
@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_decode_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+std::shared_ptr<ImageDecodeScheduler> ImageDecodeScheduler::Create(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner,
+    size_t max_concurrent_decodes,
+    size_t max_decode_bytes) {
+  return std::shared_ptr<ImageDecodeScheduler>(new ImageDecodeScheduler(
+      std::move(task_runner), max_concurrent_decodes, max_decode_bytes));
+}
+
+ImageDecodeScheduler::ImageDecodeScheduler(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner,
+    size_t max_concurrent_decodes,
+    size_t max_decode_bytes)
+    : task_runner_(std::move(task_runner)),
+      max_concurrent_decodes_(std::max(max_concurrent_decodes, size_t{1})),
+      max_decode_bytes_(max_decode_bytes) {
+  FML_DCHECK(task_runner_);
+}
+
+ImageDecodeScheduler::~ImageDecodeScheduler() {
+  // Running decodes keep the scheduler alive, so only waiting decodes are
+  // left.
+  for (auto& [key, task] : pending_tasks_) {
+    if (task.cancelled) {
+      task.cancelled();
+    }
+  }
+}
+
+ImageDecodeScheduler::TaskID ImageDecodeScheduler::Schedule(
+    Priority priority,
+    size_t decode_bytes,
+    fml::closure decode,
+    fml::closure cancelled) {
+  FML_DCHECK(decode);
+  TaskID task_id;
+  {
+    std::scoped_lock lock(mutex_);
+    task_id = ++last_task_id_;
+    pending_tasks_[{priority, task_id}] = {
+        .decode_bytes = decode_bytes,
+        .decode = std::move(decode),
+        .cancelled = std::move(cancelled),
+    };
+    pending_priorities_[task_id] = priority;
+  }
+  StartPendingTasks();
+  return task_id;
+}
+
+bool ImageDecodeScheduler::SetPriority(TaskID task_id, Priority priority) {
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = pending_priorities_.find(task_id);
+    if (found == pending_priorities_.end()) {
+      return false;
+    }
+    if (found->second == priority) {
+      return true;
+    }
+    auto node = pending_tasks_.extract({found->second, task_id});
+    FML_DCHECK(!node.empty());
+    node.key().first = priority;
+    pending_tasks_.insert(std::move(node));
+    found->second = priority;
+  }
+  // Nothing new can start, since the limits don't depend on priorities.
+  return true;
+}
+
+bool ImageDecodeScheduler::Cancel(TaskID task_id) {
+  Task task;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = pending_priorities_.find(task_id);
+    if (found == pending_priorities_.end()) {
+      return false;
+    }
+    auto node = pending_tasks_.extract({found->second, task_id});
+    FML_DCHECK(!node.empty());
+    task = std::move(node.mapped());
+    pending_priorities_.erase(found);
+  }
+  if (task.cancelled) {
+    task.cancelled();
+  }
+  return true;
+}
+
+size_t ImageDecodeScheduler::GetPendingDecodeCount() const {
+  std::scoped_lock lock(mutex_);
+  return pending_tasks_.size();
+}
+
+size_t ImageDecodeScheduler::GetRunningDecodeCount() const {
+  std::scoped_lock lock(mutex_);
+  return running_decodes_;
+}
+
+void ImageDecodeScheduler::StartPendingTasks() {
+  std::vector<Task> tasks;
+  {
+    std::scoped_lock lock(mutex_);
+    while (!pending_tasks_.empty() &&
+           running_decodes_ < max_concurrent_decodes_) {
+      auto first = pending_tasks_.begin();
+      const size_t decode_bytes = first->second.decode_bytes;
+      // A decode that is larger than the budget on its own waits until it
+      // can run alone.
+      if (running_decodes_ > 0u &&
+          running_decode_bytes_ + decode_bytes > max_decode_bytes_) {
+        break;
+      }
+      running_decodes_++;
+      running_decode_bytes_ += decode_bytes;
+      pending_priorities_.erase(first->first.second);
+      tasks.push_back(std::move(first->second));
+      pending_tasks_.erase(first);
+    }
+  }
+
+  // The task runner may run the tasks right away, so they are posted without
+  // holding the lock.
+  for (auto& task : tasks) {
+    task_runner_->PostTask(
+        [self = shared_from_this(), decode = std::move(task.decode),
+         decode_bytes = task.decode_bytes]() {
+          TRACE_EVENT0("flutter", "ImageDecodeScheduler::Decode");
+          decode();
+          self->OnTaskDone(decode_bytes);
+        });
+  }
+}
+
+void ImageDecodeScheduler::OnTaskDone(size_t decode_bytes) {
+  {
+    std::scoped_lock lock(mutex_);
+    FML_DCHECK(running_decodes_ > 0u);
+    FML_DCHECK(running_decode_bytes_ >= decode_bytes);
+    running_decodes_--;
+    running_decode_bytes_ -= decode_bytes;
+  }
+  StartPendingTasks();
+}
+
+}  // namespace flutter
@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_SCHEDULER_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_SCHEDULER_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decides in which order image decodes run on the concurrent
+///             task runner.
+///
+///             Decodes wait in the scheduler until a worker is free, and the
+///             waiting decode with the highest priority is started first.
+///             Decodes of the same priority start in the order in which they
+///             were scheduled. Waiting decodes can be re-prioritized or
+///             cancelled, so that decodes of images that were scrolled away
+///             before they were decoded never hold up the visible ones.
+///
+///             The number of concurrent decodes and the memory that they
+///             decode into are capped, though at least one decode is always
+///             allowed to run.
+///
+///             All methods are thread safe. Every started decode keeps the
+///             scheduler alive until it is done.
+///
+class ImageDecodeScheduler
+    : public std::enable_shared_from_this<ImageDecodeScheduler> {
+ public:
+  /// The priorities of decodes, from the most to the least urgent.
+  enum class Priority {
+    /// The image is needed for the current frame.
+    kVisible,
+    /// The image will likely be needed soon, e.g. because it's about to be
+    /// scrolled into view.
+    kPrefetch,
+    /// The image isn't needed any time soon.
+    kBackground,
+  };
+
+  using TaskID = uint64_t;
+
+  /// Never returned by |Schedule|.
+  static constexpr TaskID kInvalidTaskID = 0;
+
+  static std::shared_ptr<ImageDecodeScheduler> Create(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner,
+      size_t max_concurrent_decodes,
+      size_t max_decode_bytes);
+
+  ~ImageDecodeScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Schedules a decode to run on the task runner.
+  ///
+  /// @param[in]  priority      The priority of the decode.
+  /// @param[in]  decode_bytes  An estimate of the memory that the decode
+  ///                           needs until |decode| returns.
+  /// @param[in]  decode        Decodes the image on the task runner.
+  /// @param[in]  cancelled     Invoked instead of |decode| if the decode is
+  ///                           cancelled before it started, or if the
+  ///                           scheduler is collected first.
+  ///
+  /// @return     The ID with which the decode can be re-prioritized or
+  ///             cancelled.
+  ///
+  TaskID Schedule(Priority priority,
+                  size_t decode_bytes,
+                  fml::closure decode,
+                  fml::closure cancelled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Changes the priority of a decode that hasn't started yet.
+  ///
+  /// @return     Whether the decode was still waiting.
+  ///
+  bool SetPriority(TaskID task_id, Priority priority);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops a decode that hasn't started yet and invokes its
+  ///             cancellation callback on the calling thread. Decodes that
+  ///             already started run to completion.
+  ///
+  /// @return     Whether the decode was still waiting.
+  ///
+  bool Cancel(TaskID task_id);
+
+  size_t GetPendingDecodeCount() const;
+
+  size_t GetRunningDecodeCount() const;
+
+ private:
+  struct Task {
+    size_t decode_bytes = 0;
+    fml::closure decode;
+    fml::closure cancelled;
+  };
+
+  // Orders the waiting decodes by priority, then by the order in which they
+  // were scheduled.
+  using TaskKey = std::pair<Priority, TaskID>;
+
+  const std::shared_ptr<fml::BasicTaskRunner> task_runner_;
+  const size_t max_concurrent_decodes_;
+  const size_t max_decode_bytes_;
+
+  mutable std::mutex mutex_;
+  TaskID last_task_id_ = kInvalidTaskID;
+  std::map<TaskKey, Task> pending_tasks_;
+  std::unordered_map<TaskID, Priority> pending_priorities_;
+  size_t running_decodes_ = 0;
+  size_t running_decode_bytes_ = 0;
+
+  ImageDecodeScheduler(std::shared_ptr<fml::BasicTaskRunner> task_runner,
+                       size_t max_concurrent_decodes,
+                       size_t max_decode_bytes);
+
+  // Starts waiting decodes until one of the limits is reached.
+  void StartPendingTasks();
+
+  void OnTaskDone(size_t decode_bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageDecodeScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_SCHEDULER_H_
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_decode_scheduler.h"
+
+#include <deque>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+// Queues the posted tasks until the test runs them.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  size_t GetTaskCount() const { return tasks_.size(); }
+
+  void RunNextTask() {
+    ASSERT_FALSE(tasks_.empty());
+    auto task = tasks_.front();
+    tasks_.pop_front();
+    task();
+  }
+
+  void DropAllTasks() { tasks_.clear(); }
+
+  void RunAllTasks() {
+    while (!tasks_.empty()) {
+      RunNextTask();
+    }
+  }
+
+ private:
+  std::deque<fml::closure> tasks_;
+};
+
+using Priority = ImageDecodeScheduler::Priority;
+}  // namespace
+
+TEST(ImageDecodeSchedulerTest, RunsDecodesByPriority) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = ImageDecodeScheduler::Create(runner, 1, 1000);
+  std::vector<int> order;
+  auto schedule = [&](Priority priority, int value) {
+    return scheduler->Schedule(
+        priority, 1, [&order, value]() { order.push_back(value); }, nullptr);
+  };
+
+  // The first decode starts right away.
+  schedule(Priority::kBackground, 0);
+  schedule(Priority::kBackground, 1);
+  schedule(Priority::kPrefetch, 2);
+  schedule(Priority::kVisible, 3);
+  schedule(Priority::kVisible, 4);
+  EXPECT_EQ(runner->GetTaskCount(), 1u);
+  EXPECT_EQ(scheduler->GetRunningDecodeCount(), 1u);
+  EXPECT_EQ(scheduler->GetPendingDecodeCount(), 4u);
+
+  runner->RunAllTasks();
+  EXPECT_EQ(order, std::vector<int>({0, 3, 4, 2, 1}));
+  EXPECT_EQ(scheduler->GetRunningDecodeCount(), 0u);
+  EXPECT_EQ(scheduler->GetPendingDecodeCount(), 0u);
+}
+
+TEST(ImageDecodeSchedulerTest, CanReprioritizePendingDecodes) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = ImageDecodeScheduler::Create(runner, 1, 1000);
+  std::vector<int> order;
+  auto schedule = [&](Priority priority, int value) {
+    return scheduler->Schedule(
+        priority, 1, [&order, value]() { order.push_back(value); }, nullptr);
+  };
+
+  auto running = schedule(Priority::kVisible, 0);
+  auto visible = schedule(Priority::kVisible, 1);
+  auto background = schedule(Priority::kBackground, 2);
+  EXPECT_TRUE(scheduler->SetPriority(visible, Priority::kBackground));
+  EXPECT_TRUE(scheduler->SetPriority(background, Priority::kVisible));
+  // Started decodes can't be re-prioritized.
+  EXPECT_FALSE(scheduler->SetPriority(running, Priority::kBackground));
+
+  runner->RunAllTasks();
+  EXPECT_EQ(order, std::vector<int>({0, 2, 1}));
+  EXPECT_FALSE(scheduler->SetPriority(visible, Priority::kVisible));
+}
+
+TEST(ImageDecodeSchedulerTest, CancelledDecodesNeverRun) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = ImageDecodeScheduler::Create(runner, 1, 1000);
+  int decoded = 0;
+  int cancelled = 0;
+  auto schedule = [&]() {
+    return scheduler->Schedule(
+        Priority::kVisible, 1, [&decoded]() { decoded++; },
+        [&cancelled]() { cancelled++; });
+  };
+
+  auto running = schedule();
+  auto pending = schedule();
+  EXPECT_TRUE(scheduler->Cancel(pending));
+  EXPECT_EQ(cancelled, 1);
+  EXPECT_FALSE(scheduler->Cancel(pending));
+  // Started decodes run to completion.
+  EXPECT_FALSE(scheduler->Cancel(running));
+
+  runner->RunAllTasks();
+  EXPECT_EQ(decoded, 1);
+  EXPECT_EQ(cancelled, 1);
+  EXPECT_FALSE(scheduler->Cancel(ImageDecodeScheduler::kInvalidTaskID));
+}
+
+TEST(ImageDecodeSchedulerTest, LimitsConcurrentDecodes) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = ImageDecodeScheduler::Create(runner, 2, 1000);
+  for (int i = 0; i < 5; i++) {
+    scheduler->Schedule(Priority::kVisible, 1, []() {}, nullptr);
+  }
+  EXPECT_EQ(runner->GetTaskCount(), 2u);
+  EXPECT_EQ(scheduler->GetPendingDecodeCount(), 3u);
+
+  // Every finished decode starts the next one.
+  runner->RunNextTask();
+  EXPECT_EQ(runner->GetTaskCount(), 2u);
+  EXPECT_EQ(scheduler->GetRunningDecodeCount(), 2u);
+  EXPECT_EQ(scheduler->GetPendingDecodeCount(), 2u);
+  runner->RunAllTasks();
+  EXPECT_EQ(scheduler->GetPendingDecodeCount(), 0u);
+}
+
+TEST(ImageDecodeSchedulerTest, LimitsConcurrentDecodeBytes) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = ImageDecodeScheduler::Create(runner, 4, 100);
+  scheduler->Schedule(Priority::kVisible, 60, []() {}, nullptr);
+  scheduler->Schedule(Priority::kVisible, 60, []() {}, nullptr);
+  scheduler->Schedule(Priority::kVisible, 30, []() {}, nullptr);
+  EXPECT_EQ(runner->GetTaskCount(), 1u);
+
+  runner->RunNextTask();
+  // The decodes that fit into the budget together run at once.
+  EXPECT_EQ(runner->GetTaskCount(), 2u);
+  EXPECT_EQ(scheduler->GetRunningDecodeCount(), 2u);
+  runner->RunAllTasks();
+
+  // Decodes that exceed the budget on their own still run, one at a time.
+  scheduler->Schedule(Priority::kVisible, 500, []() {}, nullptr);
+  scheduler->Schedule(Priority::kVisible, 500, []() {}, nullptr);
+  EXPECT_EQ(runner->GetTaskCount(), 1u);
+  runner->RunNextTask();
+  EXPECT_EQ(runner->GetTaskCount(), 1u);
+  runner->RunAllTasks();
+  EXPECT_EQ(scheduler->GetRunningDecodeCount(), 0u);
+}
+
+TEST(ImageDecodeSchedulerTest, PendingDecodesAreCancelledWithTheScheduler) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = ImageDecodeScheduler::Create(runner, 1, 1000);
+  int cancelled = 0;
+  scheduler->Schedule(
+      Priority::kVisible, 1, []() {}, [&cancelled]() { cancelled++; });
+  scheduler->Schedule(
+      Priority::kVisible, 1, []() {}, [&cancelled]() { cancelled++; });
+
+  // The started decode keeps the scheduler alive until the runner drops it,
+  // e.g. because it's shutting down.
+  scheduler = nullptr;
+  EXPECT_EQ(cancelled, 0);
+  runner->DropAllTasks();
+  EXPECT_EQ(cancelled, 1);
+}
+
+}  // namespace testing
+}  // namespace flutter
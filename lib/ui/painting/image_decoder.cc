@@ -4,6 +4,9 @@
 
 #include "flutter/lib/ui/painting/image_decoder.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
@@ -46,10 +49,28 @@ ImageDecoder::ImageDecoder(
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
       << "The image decoder must be created & collected on the UI thread.";
+  decode_scheduler_ = ImageDecodeScheduler::Create(
+      concurrent_task_runner_, GetMaxConcurrentDecodes(),
+      kMaxConcurrentDecodeBytes);
 }
 
 ImageDecoder::~ImageDecoder() = default;
 
+const std::shared_ptr<ImageDecodeScheduler>& ImageDecoder::GetDecodeScheduler()
+    const {
+  return decode_scheduler_;
+}
+
+size_t ImageDecoder::GetMaxConcurrentDecodes() {
+  return std::max(2u, std::thread::hardware_concurrency() / 2u);
+}
+
+size_t ImageDecoder::EstimateDecodeBytes(uint32_t target_width,
+                                         uint32_t target_height) {
+  // Decodes use 4 bytes per pixel unless they are wide gamut.
+  return static_cast<size_t>(target_width) * target_height * 4u;
+}
+
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
@@ -12,6 +12,7 @@
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/image_decode_scheduler.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
 
 namespace flutter {
@@ -39,17 +40,38 @@ class ImageDecoder {
   // concurrently. Texture upload is done on the IO thread and the result
   // returned back on the UI thread. On error, the texture is null but the
   // callback is guaranteed to return on the UI thread.
-  virtual void Decode(fml::RefPtr<ImageDescriptor> descriptor,
-                      uint32_t target_width,
-                      uint32_t target_height,
-                      const ImageResult& result) = 0;
+  //
+  // Decompression is scheduled on the decode scheduler with the |kVisible|
+  // priority. The returned ID can be used to re-prioritize or cancel the
+  // decode until it starts, after which the callback returns a null texture.
+  // |ImageDecodeScheduler::kInvalidTaskID| is returned if nothing needed to
+  // be scheduled.
+  virtual ImageDecodeScheduler::TaskID Decode(
+      fml::RefPtr<ImageDescriptor> descriptor,
+      uint32_t target_width,
+      uint32_t target_height,
+      const ImageResult& result) = 0;
+
+  const std::shared_ptr<ImageDecodeScheduler>& GetDecodeScheduler() const;
 
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
+  // Limits the decodes that run at once on the concurrent runner, leaving
+  // workers for the other users of the runner.
+  static size_t GetMaxConcurrentDecodes();
+
+  // Limits the memory that decodes running at once decompress into.
+  static constexpr size_t kMaxConcurrentDecodeBytes = 128u * 1024u * 1024u;
+
  protected:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  std::shared_ptr<ImageDecodeScheduler> decode_scheduler_;
+
+  // The memory that decompressing an image to the target size needs.
+  static size_t EstimateDecodeBytes(uint32_t target_width,
+                                    uint32_t target_height);
 
   ImageDecoder(
       const TaskRunners& runners,
@@ -4,9 +4,11 @@
 
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/host_allocator.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/core/allocator.h"
@@ -36,10 +38,13 @@ class MallocDeviceBuffer : public impeller::DeviceBuffer {
  public:
   explicit MallocDeviceBuffer(impeller::DeviceBufferDescriptor desc)
       : impeller::DeviceBuffer(desc) {
-    data_ = static_cast<uint8_t*>(malloc(desc.size));
+    data_ = static_cast<uint8_t*>(fml::HostAllocate(
+        desc.size, fml::HostAllocationCategory::kImageDecode));
   }
 
-  ~MallocDeviceBuffer() override { free(data_); }
+  ~MallocDeviceBuffer() override {
+    fml::HostFree(data_, desc_.size, fml::HostAllocationCategory::kImageDecode);
+  }
 
   bool SetLabel(const std::string& label) override { return true; }
 
@@ -150,7 +155,8 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     SkISize target_size,
     impeller::ISize max_texture_size,
     bool supports_wide_gamut,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    const RowsDecodedCallback& rows_decoded) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     std::string decode_error("Invalid descriptor (should never happen)");
@@ -220,7 +226,26 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       return DecompressResult{.decode_error = decode_error};
     }
     // Decode the image into the image generator's closest supported size.
-    if (!descriptor->get_pixels(bitmap->pixmap())) {
+    // Large images that don't need to be resized afterwards hand out their
+    // rows as they are decoded, so the caller can start uploading them.
+    bool decoded = false;
+    if (rows_decoded && decode_size == target_size &&
+        image_info.computeMinByteSize() >= kStreamingDecodeMinBytes) {
+      FML_DCHECK(bitmap->rowBytes() == image_info.minRowBytes());
+      auto buffer = bitmap_allocator->GetDeviceBuffer();
+      const auto& info = bitmap->info();
+      int rows_per_batch = std::max(
+          1, static_cast<int>(kStreamingDecodeBytesPerBatch /
+                              bitmap->rowBytes()));
+      decoded = descriptor->get_pixels_incrementally(
+          bitmap->pixmap(), rows_per_batch,
+          [&rows_decoded, &buffer, &info](int first_row, int row_count) {
+            rows_decoded(buffer, info, first_row, row_count);
+          });
+    } else {
+      decoded = descriptor->get_pixels(bitmap->pixmap());
+    }
+    if (!decoded) {
       std::string decode_error("Could not decompress image.");
       FML_DLOG(ERROR) << decode_error;
       return DecompressResult{.decode_error = decode_error};
@@ -284,11 +309,10 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
                           .image_info = scaled_bitmap->info()};
 }
 
-/// Only call this method if the GPU is available.
-static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
-    const std::shared_ptr<impeller::Context>& context,
-    const std::shared_ptr<impeller::DeviceBuffer>& buffer,
-    const SkImageInfo& image_info) {
+/// Create the device private texture that |image_info| is uploaded to.
+static std::pair<std::shared_ptr<impeller::Texture>, std::string>
+CreateDevicePrivateTexture(const std::shared_ptr<impeller::Context>& context,
+                           const SkImageInfo& image_info) {
   const auto pixel_format =
       impeller::skia_conversions::ToPixelFormat(image_info.colorType());
   if (!pixel_format) {
@@ -304,6 +328,7 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
   texture_descriptor.size = {image_info.width(), image_info.height()};
   texture_descriptor.mip_count = texture_descriptor.size.MipCount();
   texture_descriptor.compression_type = impeller::CompressionType::kLossy;
+  texture_descriptor.tag = impeller::AllocationTag::kImage;
 
   auto dest_texture =
       context->GetResourceAllocator()->CreateTexture(texture_descriptor);
@@ -315,6 +340,20 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
 
   dest_texture->SetLabel(
       impeller::SPrintF("ui.Image(%p)", dest_texture.get()).c_str());
+  return std::make_pair(std::move(dest_texture), std::string());
+}
+
+/// Only call this method if the GPU is available.
+static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+    const SkImageInfo& image_info) {
+  auto [dest_texture, texture_error] =
+      CreateDevicePrivateTexture(context, image_info);
+  if (!dest_texture) {
+    return std::make_pair(nullptr, texture_error);
+  }
+  const auto& texture_descriptor = dest_texture->GetTextureDescriptor();
 
   auto command_buffer = context->CreateCommandBuffer();
   if (!command_buffer) {
@@ -349,6 +388,134 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
       impeller::DlImageImpeller::Make(std::move(dest_texture)), std::string());
 }
 
+namespace {
+/// Uploads the rows of a large image to a device private texture while the
+/// rest of the image is still being decoded, so that the blits overlap with
+/// the decode instead of waiting for it. Every method is called on the IO
+/// runner.
+class StreamingTextureUpload {
+ public:
+  StreamingTextureUpload(std::shared_ptr<impeller::Context> context,
+                         std::shared_ptr<fml::SyncSwitch> gpu_disabled_switch)
+      : context_(std::move(context)),
+        gpu_disabled_switch_(std::move(gpu_disabled_switch)) {}
+
+  void UploadRows(const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+                  const SkImageInfo& image_info,
+                  int first_row,
+                  int row_count) {
+    if (failed_) {
+      return;
+    }
+    gpu_disabled_switch_->Execute(
+        fml::SyncSwitch::Handlers()
+            .SetIfFalse([&] {
+              failed_ = !UnsafeUploadRows(buffer, image_info, first_row,
+                                          row_count);
+            })
+            .SetIfTrue([&] { failed_ = true; }));
+  }
+
+  /// Whether every row of |image_info| has been uploaded.
+  bool IsComplete(const SkImageInfo& image_info) const {
+    return !failed_ && texture_ &&
+           texture_->GetSize() ==
+               impeller::ISize(image_info.width(), image_info.height()) &&
+           uploaded_rows_ == image_info.height();
+  }
+
+  /// Generates the mipmaps of the uploaded texture and wraps it in an image.
+  std::pair<sk_sp<DlImage>, std::string> Finish() {
+    FML_DCHECK(texture_);
+    std::pair<sk_sp<DlImage>, std::string> result =
+        std::make_pair(nullptr, "GPU access is disabled");
+    gpu_disabled_switch_->Execute(
+        fml::SyncSwitch::Handlers().SetIfFalse([this, &result] {
+          result = UnsafeFinish();
+        }));
+    return result;
+  }
+
+ private:
+  bool UnsafeUploadRows(const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+                        const SkImageInfo& image_info,
+                        int first_row,
+                        int row_count) {
+    if (!texture_) {
+      texture_ = CreateDevicePrivateTexture(context_, image_info).first;
+      if (!texture_) {
+        return false;
+      }
+    }
+    if (first_row != uploaded_rows_) {
+      FML_DLOG(ERROR) << "Image rows were decoded out of order.";
+      return false;
+    }
+
+    auto command_buffer = context_->CreateCommandBuffer();
+    if (!command_buffer) {
+      return false;
+    }
+    command_buffer->SetLabel("Streaming Upload Command Buffer");
+    auto blit_pass = command_buffer->CreateBlitPass();
+    if (!blit_pass) {
+      return false;
+    }
+    blit_pass->SetLabel("Streaming Upload Blit Pass");
+
+    auto view = buffer->AsBufferView();
+    view.range = impeller::Range(first_row * image_info.minRowBytes(),
+                                 row_count * image_info.minRowBytes());
+    if (!blit_pass->AddCopy(
+            std::move(view), texture_,
+            impeller::IRect::MakeXYWH(0, first_row, image_info.width(),
+                                      row_count))) {
+      return false;
+    }
+    if (!blit_pass->EncodeCommands(context_->GetResourceAllocator()) ||
+        !command_buffer->SubmitCommands()) {
+      FML_DLOG(ERROR) << "Failed to submit streaming upload command buffer.";
+      return false;
+    }
+    uploaded_rows_ += row_count;
+    return true;
+  }
+
+  std::pair<sk_sp<DlImage>, std::string> UnsafeFinish() {
+    if (texture_->GetTextureDescriptor().mip_count > 1u) {
+      auto command_buffer = context_->CreateCommandBuffer();
+      if (!command_buffer) {
+        return std::make_pair(
+            nullptr, "Could not create command buffer for mipmap generation.");
+      }
+      command_buffer->SetLabel("Mipmap Command Buffer");
+      auto blit_pass = command_buffer->CreateBlitPass();
+      if (!blit_pass) {
+        return std::make_pair(
+            nullptr, "Could not create blit pass for mipmap generation.");
+      }
+      blit_pass->SetLabel("Mipmap Blit Pass");
+      blit_pass->GenerateMipmap(texture_);
+      blit_pass->EncodeCommands(context_->GetResourceAllocator());
+      if (!command_buffer->SubmitCommands()) {
+        return std::make_pair(nullptr,
+                              "Failed to submit blit pass command buffer.");
+      }
+    }
+    return std::make_pair(impeller::DlImageImpeller::Make(texture_),
+                          std::string());
+  }
+
+  std::shared_ptr<impeller::Context> context_;
+  std::shared_ptr<fml::SyncSwitch> gpu_disabled_switch_;
+  std::shared_ptr<impeller::Texture> texture_;
+  int uploaded_rows_ = 0;
+  bool failed_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StreamingTextureUpload);
+};
+}  // namespace
+
 std::pair<sk_sp<DlImage>, std::string>
 ImageDecoderImpeller::UploadTextureToPrivate(
     const std::shared_ptr<impeller::Context>& context,
@@ -410,6 +577,7 @@ ImageDecoderImpeller::UploadTextureToStorage(
   texture_descriptor.size = {image_info.width(), image_info.height()};
   texture_descriptor.mip_count =
       create_mips ? texture_descriptor.size.MipCount() : 1;
+  texture_descriptor.tag = impeller::AllocationTag::kImage;
 
   auto texture =
       context->GetResourceAllocator()->CreateTexture(texture_descriptor);
@@ -474,11 +642,135 @@ ImageDecoderImpeller::UploadTextureToStorage(
                         std::string());
 }
 
+static impeller::PixelFormat ToPixelFormat(
+    ImageGenerator::CompressedTextureFormat format) {
+  switch (format) {
+    case ImageGenerator::CompressedTextureFormat::kETC2RGBA8:
+      return impeller::PixelFormat::kETC2R8G8B8A8UNormInt;
+    case ImageGenerator::CompressedTextureFormat::kASTC4x4:
+      return impeller::PixelFormat::kASTC4x4UNormInt;
+    case ImageGenerator::CompressedTextureFormat::kBC7:
+      return impeller::PixelFormat::kBC7UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+
+/// Whether |texture| can be sampled by the renderer as-is, instead of being
+/// decoded to RGBA first.
+static bool CanUploadCompressedTexture(
+    const ImageGenerator::CompressedTexture& texture,
+    const SkImageInfo& image_info,
+    SkISize target_size,
+    impeller::ISize max_texture_size,
+    const impeller::Capabilities& capabilities) {
+  // The renderer samples from premultiplied textures, and compressed
+  // textures can't be resized or have their mipmaps generated on the GPU.
+  return capabilities.SupportsBufferToTextureBlits() &&
+         capabilities.SupportsCompressedPixelFormat(
+             ToPixelFormat(texture.format)) &&
+         image_info.alphaType() != kUnpremul_SkAlphaType &&
+         texture.size == target_size &&
+         texture.size.width() <= max_texture_size.width &&
+         texture.size.height() <= max_texture_size.height;
+}
+
+std::pair<sk_sp<DlImage>, std::string>
+ImageDecoderImpeller::UploadCompressedTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const ImageGenerator::CompressedTexture& texture,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context) {
+    return std::make_pair(nullptr, "No Impeller context is available");
+  }
+  if (!texture.data) {
+    return std::make_pair(nullptr, "No compressed texture data is available");
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.format = ToPixelFormat(texture.format);
+  texture_descriptor.size = {texture.size.width(), texture.size.height()};
+  // Only the base level is uploaded, and the mipmaps of compressed textures
+  // can't be generated with a blit pass.
+  texture_descriptor.mip_count = 1u;
+  if (texture.data->size() !=
+      texture_descriptor.GetByteSizeOfBaseMipLevel()) {
+    std::string decode_error("Unexpected size of compressed texture data.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  std::pair<sk_sp<DlImage>, std::string> result =
+      std::make_pair(nullptr, "Could not upload compressed texture.");
+  auto upload = [&](impeller::StorageMode storage_mode) {
+    texture_descriptor.storage_mode = storage_mode;
+    texture_descriptor.tag = impeller::AllocationTag::kImage;
+    auto dest_texture =
+        context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+    if (!dest_texture) {
+      result.second = "Could not create Impeller texture.";
+      return;
+    }
+    dest_texture->SetLabel(
+        impeller::SPrintF("ui.Image(%p)", dest_texture.get()).c_str());
+
+    if (storage_mode == impeller::StorageMode::kHostVisible) {
+      auto mapping = std::make_shared<fml::NonOwnedMapping>(
+          texture.data->bytes(), texture.data->size(),
+          [data = texture.data](auto, auto) {});
+      if (!dest_texture->SetContents(mapping)) {
+        result.second = "Could not copy contents into Impeller texture.";
+        return;
+      }
+    } else {
+      auto buffer = context->GetResourceAllocator()->CreateBufferWithCopy(
+          texture.data->bytes(), texture.data->size(),
+          impeller::AllocationTag::kImage);
+      if (!buffer) {
+        result.second = "Could not create buffer for compressed texture.";
+        return;
+      }
+      auto command_buffer = context->CreateCommandBuffer();
+      if (!command_buffer) {
+        result.second = "Could not create command buffer for texture upload.";
+        return;
+      }
+      command_buffer->SetLabel("Compressed Upload Command Buffer");
+      auto blit_pass = command_buffer->CreateBlitPass();
+      if (!blit_pass) {
+        result.second = "Could not create blit pass for texture upload.";
+        return;
+      }
+      blit_pass->SetLabel("Compressed Upload Blit Pass");
+      if (!blit_pass->AddCopy(buffer->AsBufferView(), dest_texture) ||
+          !blit_pass->EncodeCommands(context->GetResourceAllocator()) ||
+          !command_buffer->SubmitCommands()) {
+        result.second = "Failed to submit blit pass command buffer.";
+        return;
+      }
+    }
+    result = std::make_pair(
+        impeller::DlImageImpeller::Make(std::move(dest_texture)),
+        std::string());
+  };
+  gpu_disabled_switch->Execute(
+      fml::SyncSwitch::Handlers()
+          .SetIfFalse(
+              [&upload] { upload(impeller::StorageMode::kDevicePrivate); })
+          .SetIfTrue(
+              [&upload] { upload(impeller::StorageMode::kHostVisible); }));
+  if (!result.first) {
+    FML_DLOG(ERROR) << result.second;
+  }
+  return result;
+}
+
 // |ImageDecoder|
-void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
-                                  uint32_t target_width,
-                                  uint32_t target_height,
-                                  const ImageResult& p_result) {
+ImageDecodeScheduler::TaskID ImageDecoderImpeller::Decode(
+    fml::RefPtr<ImageDescriptor> descriptor,
+    uint32_t target_width,
+    uint32_t target_height,
+    const ImageResult& p_result) {
   FML_DCHECK(descriptor);
   FML_DCHECK(p_result);
 
@@ -495,7 +787,9 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
     });
   };
 
-  concurrent_task_runner_->PostTask(
+  return decode_scheduler_->Schedule(
+      ImageDecodeScheduler::Priority::kVisible,
+      EstimateDecodeBytes(target_width, target_height),
       [raw_descriptor,                                            //
        context = context_.get(),                                  //
        target_size = SkISize::Make(target_width, target_height),  //
@@ -510,20 +804,71 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
+        // Compressed textures that the renderer can sample from skip the
+        // decode entirely.
+        auto compressed_texture = raw_descriptor->get_compressed_texture();
+        if (compressed_texture.has_value() &&
+            CanUploadCompressedTexture(
+                compressed_texture.value(), raw_descriptor->image_info(),
+                target_size, max_size_supported,
+                *context->GetCapabilities())) {
+          io_runner->PostTask(
+              [context, result, gpu_disabled_switch,
+               texture = std::move(compressed_texture.value())]() {
+                auto [image, decode_error] = UploadCompressedTexture(
+                    context, texture, gpu_disabled_switch);
+                result(image, decode_error);
+              });
+          return;
+        }
+
+        const bool upload_to_private =
+            !kShouldUseMallocDeviceBuffer &&
+            context->GetCapabilities()->SupportsBufferToTextureBlits();
+
+        // Large images are blitted to the texture as they are decoded.
+        std::shared_ptr<StreamingTextureUpload> streaming_upload;
+        RowsDecodedCallback rows_decoded;
+        if (upload_to_private) {
+          streaming_upload = std::make_shared<StreamingTextureUpload>(
+              context, gpu_disabled_switch);
+          rows_decoded = [streaming_upload, io_runner](
+                             const std::shared_ptr<impeller::DeviceBuffer>&
+                                 buffer,
+                             const SkImageInfo& image_info, int first_row,
+                             int row_count) {
+            io_runner->PostTask([streaming_upload, buffer, image_info,
+                                 first_row, row_count]() {
+              streaming_upload->UploadRows(buffer, image_info, first_row,
+                                           row_count);
+            });
+          };
+        }
+
         // Always decompress on the concurrent runner.
         auto bitmap_result = DecompressTexture(
             raw_descriptor, target_size, max_size_supported,
-            supports_wide_gamut, context->GetResourceAllocator());
+            supports_wide_gamut, context->GetResourceAllocator(),
+            rows_decoded);
         if (!bitmap_result.device_buffer) {
           result(nullptr, bitmap_result.decode_error);
           return;
         }
         auto upload_texture_and_invoke_result = [result, context, bitmap_result,
-                                                 gpu_disabled_switch]() {
+                                                 gpu_disabled_switch,
+                                                 upload_to_private,
+                                                 streaming_upload]() {
           sk_sp<DlImage> image;
           std::string decode_error;
-          if (!kShouldUseMallocDeviceBuffer &&
-              context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+          if (streaming_upload &&
+              streaming_upload->IsComplete(bitmap_result.image_info)) {
+            std::tie(image, decode_error) = streaming_upload->Finish();
+            if (image) {
+              result(image, decode_error);
+              return;
+            }
+          }
+          if (upload_to_private) {
             std::tie(image, decode_error) = UploadTextureToPrivate(
                 context, bitmap_result.device_buffer, bitmap_result.image_info,
                 bitmap_result.sk_bitmap, gpu_disabled_switch);
@@ -542,7 +887,8 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         // forced serialization we can end up overloading the GPU and/or
         // competing with raster workloads.
         io_runner->PostTask(upload_texture_and_invoke_result);
-      });
+      },
+      [result]() { result(nullptr, "Image decode was cancelled"); });
 }
 
 ImpellerAllocator::ImpellerAllocator(
@@ -565,6 +911,7 @@ bool ImpellerAllocator::allocPixelRef(SkBitmap* bitmap) {
   descriptor.storage_mode = impeller::StorageMode::kHostVisible;
   descriptor.size = ((bitmap->height() - 1) * bitmap->rowBytes()) +
                     (bitmap->width() * bitmap->bytesPerPixel());
+  descriptor.tag = impeller::AllocationTag::kImage;
 
   std::shared_ptr<impeller::DeviceBuffer> device_buffer =
       kShouldUseMallocDeviceBuffer
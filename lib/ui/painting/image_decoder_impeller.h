@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_IMPELLER_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_IMPELLER_H_
 
+#include <functional>
 #include <future>
 
 #include "flutter/fml/macros.h"
@@ -55,18 +56,35 @@ class ImageDecoderImpeller final : public ImageDecoder {
 
   ~ImageDecoderImpeller() override;
 
+  /// @brief Invoked by |DecompressTexture| on the decoding thread once the
+  ///        tightly packed rows in [first_row, first_row + row_count) of the
+  ///        decoded image have been written to |buffer|.
+  using RowsDecodedCallback =
+      std::function<void(const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+                         const SkImageInfo& image_info,
+                         int first_row,
+                         int row_count)>;
+
+  /// Images that are decoded at their target size and are at least this large
+  /// are decoded in batches of |kStreamingDecodeBytesPerBatch| and reported
+  /// to the |RowsDecodedCallback| of |DecompressTexture|.
+  static constexpr size_t kStreamingDecodeMinBytes = 8u * 1024u * 1024u;
+  static constexpr size_t kStreamingDecodeBytesPerBatch = 2u * 1024u * 1024u;
+
   // |ImageDecoder|
-  void Decode(fml::RefPtr<ImageDescriptor> descriptor,
-              uint32_t target_width,
-              uint32_t target_height,
-              const ImageResult& result) override;
+  ImageDecodeScheduler::TaskID Decode(
+      fml::RefPtr<ImageDescriptor> descriptor,
+      uint32_t target_width,
+      uint32_t target_height,
+      const ImageResult& result) override;
 
   static DecompressResult DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
       impeller::ISize max_texture_size,
       bool supports_wide_gamut,
-      const std::shared_ptr<impeller::Allocator>& allocator);
+      const std::shared_ptr<impeller::Allocator>& allocator,
+      const RowsDecodedCallback& rows_decoded = nullptr);
 
   /// @brief Create a device private texture from the provided host buffer.
   ///        This method is only suported on the metal backend.
@@ -98,6 +116,19 @@ class ImageDecoderImpeller final : public ImageDecoder {
       impeller::StorageMode storage_mode,
       bool create_mips = true);
 
+  /// @brief Create a texture from the base level of a compressed texture
+  ///        without decoding it. The caller must check that the backend
+  ///        supports sampling from the format of the texture.
+  /// @param context    The Impeller graphics context.
+  /// @param texture    The compressed texture to be uploaded.
+  /// @param gpu_disabled_switch Whether the GPU is available for command
+  /// encoding.
+  /// @return           A DlImage.
+  static std::pair<sk_sp<DlImage>, std::string> UploadCompressedTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const ImageGenerator::CompressedTexture& texture,
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+
  private:
   using FutureContext = std::shared_future<std::shared_ptr<impeller::Context>>;
   FutureContext context_;
@@ -217,10 +217,11 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
 }
 
 // |ImageDecoder|
-void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
-                              uint32_t target_width,
-                              uint32_t target_height,
-                              const ImageResult& callback) {
+ImageDecodeScheduler::TaskID ImageDecoderSkia::Decode(
+    fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
+    uint32_t target_width,
+    uint32_t target_height,
+    const ImageResult& callback) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   fml::tracing::TraceFlow flow(__FUNCTION__);
 
@@ -261,10 +262,12 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
 
   if (!raw_descriptor->data() || raw_descriptor->data()->size() == 0) {
     result({}, std::move(flow));
-    return;
+    return ImageDecodeScheduler::kInvalidTaskID;
   }
 
-  concurrent_task_runner_->PostTask(
+  return decode_scheduler_->Schedule(
+      ImageDecodeScheduler::Priority::kVisible,
+      EstimateDecodeBytes(target_width, target_height),
       fml::MakeCopyable([raw_descriptor,                          //
                          io_manager = io_manager_,                //
                          io_runner = runners_.GetIOTaskRunner(),  //
@@ -325,7 +328,10 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
           // Finally, all done.
           result(std::move(uploaded), std::move(flow));
         }));
-      }));
+      }),
+      [result]() {
+        result({}, fml::tracing::TraceFlow("ImageDecodeCancelled"));
+      });
 }
 
 }  // namespace flutter
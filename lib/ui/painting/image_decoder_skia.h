@@ -20,10 +20,11 @@ class ImageDecoderSkia final : public ImageDecoder {
   ~ImageDecoderSkia() override;
 
   // |ImageDecoder|
-  void Decode(fml::RefPtr<ImageDescriptor> descriptor,
-              uint32_t target_width,
-              uint32_t target_height,
-              const ImageResult& result) override;
+  ImageDecodeScheduler::TaskID Decode(
+      fml::RefPtr<ImageDescriptor> descriptor,
+      uint32_t target_width,
+      uint32_t target_height,
+      const ImageResult& result) override;
 
   static sk_sp<SkImage> ImageFromCompressedData(
       ImageDescriptor* descriptor,
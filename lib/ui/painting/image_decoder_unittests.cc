@@ -12,7 +12,9 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
+#include "flutter/lib/ui/painting/multi_frame_compositor.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/testing/dart_isolate_runner.h"
@@ -878,6 +880,61 @@ TEST(ImageDecoderTest,
   ASSERT_EQ(webp_generator->GetPlayCount(), static_cast<unsigned int>(2));
 }
 
+TEST(ImageDecoderTest, MultiFrameCompositorRecyclesFrameBuffers) {
+  auto data = OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  const int frame_count = generator->GetFrameCount();
+  ASSERT_GT(frame_count, 1);
+
+  // Without a pool, every frame is composited into a new buffer.
+  MultiFrameCompositor reference(generator, 0);
+  MultiFrameCompositor recycling(generator, 2);
+  for (int i = 0; i < frame_count * 2; i++) {
+    auto [expected, expected_error] = reference.CompositeNextFrame();
+    auto [actual, actual_error] = recycling.CompositeNextFrame();
+    ASSERT_TRUE(expected.has_value()) << expected_error;
+    ASSERT_TRUE(actual.has_value()) << actual_error;
+    EXPECT_EQ(actual->index, i % frame_count);
+    ASSERT_EQ(actual->bitmap.info(), expected->bitmap.info());
+    ASSERT_EQ(actual->bitmap.rowBytes(), expected->bitmap.rowBytes());
+    EXPECT_EQ(memcmp(actual->bitmap.getPixels(), expected->bitmap.getPixels(),
+                     actual->bitmap.computeByteSize()),
+              0)
+        << "frame " << i;
+  }
+  EXPECT_EQ(reference.GetAllocatedBufferCount(),
+            static_cast<size_t>(frame_count * 2));
+  EXPECT_LE(recycling.GetAllocatedBufferCount(), 2u);
+}
+
+TEST(ImageDecoderTest, MultiFrameCompositorNeverReusesFramesInUse) {
+  auto data = OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  const int frame_count = generator->GetFrameCount();
+
+  MultiFrameCompositor compositor(generator, 2);
+  std::vector<SkBitmap> frames;
+  for (int i = 0; i < frame_count; i++) {
+    auto [frame, decode_error] = compositor.CompositeNextFrame();
+    ASSERT_TRUE(frame.has_value()) << decode_error;
+    for (const auto& held : frames) {
+      EXPECT_NE(held.getPixels(), frame->bitmap.getPixels());
+    }
+    frames.push_back(frame->bitmap);
+  }
+  EXPECT_EQ(compositor.GetAllocatedBufferCount(),
+            static_cast<size_t>(frame_count));
+  EXPECT_EQ(compositor.GetNextFrameIndex(), 0);
+}
+
 TEST(ImageDecoderTest, VerifySimpleDecoding) {
   auto data = OpenFixtureAsSkData("Horizontal.jpg");
   auto image = SkImages::DeferredFromEncodedData(data);
@@ -915,6 +972,76 @@ TEST(ImageDecoderTest, VerifySimpleDecoding) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST(ImageDecoderTest, ScaledDimensionsAreNeverSmallerThanRequested) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  // JPEG decodes scale by multiples of 1/8. The codec rounds 0.55 down to
+  // 4/8, which is smaller than requested.
+  ASSERT_EQ(generator->GetScaledDimensions(0.55f), SkISize::Make(375, 125));
+  ASSERT_EQ(generator->GetScaledDimensions(0.5f), SkISize::Make(300, 100));
+
+  for (float scale = 0.05f; scale <= 1.0f; scale += 0.05f) {
+    SkISize size = generator->GetScaledDimensions(scale);
+    EXPECT_GE(size.width(), 600 * scale - 0.5f) << "scale " << scale;
+    EXPECT_GE(size.height(), 200 * scale - 0.5f) << "scale " << scale;
+    EXPECT_LE(size.width(), 600);
+    EXPECT_LE(size.height(), 200);
+  }
+}
+
+#if IMPELLER_SUPPORTS_RENDERING
+TEST(ImageDecoderTest, ImpellerStreamsRowsOfLargeImages) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32Premul(1500, 1500));
+  bitmap.eraseColor(SK_ColorRED);
+  auto data = SkPngEncoder::Encode(
+      nullptr, SkImages::RasterFromBitmap(bitmap).get(), {});
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  std::shared_ptr<impeller::DeviceBuffer> streamed_buffer;
+  int decoded_rows = 0;
+  int batches = 0;
+  auto rows_decoded = [&](const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+                          const SkImageInfo& image_info, int first_row,
+                          int row_count) {
+    EXPECT_EQ(image_info.dimensions(), SkISize::Make(1500, 1500));
+    EXPECT_EQ(first_row, decoded_rows);
+    streamed_buffer = buffer;
+    decoded_rows += row_count;
+    batches++;
+  };
+
+  auto result = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(1500, 1500), {2048, 2048},
+      /*supports_wide_gamut=*/false, allocator, rows_decoded);
+  ASSERT_TRUE(result.device_buffer);
+  EXPECT_EQ(result.device_buffer, streamed_buffer);
+  EXPECT_EQ(decoded_rows, 1500);
+  EXPECT_GT(batches, 1);
+
+  // Images that are resized after decoding are not streamed.
+  batches = 0;
+  result = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(1000, 1000), {2048, 2048},
+      /*supports_wide_gamut=*/false, allocator, rows_decoded);
+  ASSERT_TRUE(result.device_buffer);
+  EXPECT_EQ(batches, 0);
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 TEST(ImageDecoderTest, ImagesWithTransparencyArePremulAlpha) {
   auto data = OpenFixtureAsSkData("heart_end.png");
   ASSERT_TRUE(data);
@@ -933,6 +1060,160 @@ TEST(ImageDecoderTest, ImagesWithTransparencyArePremulAlpha) {
   ASSERT_EQ(compressed_image->alphaType(), kPremul_SkAlphaType);
 }
 
+namespace {
+// Builds a KTX2 file holding a single level of |blocks| in |vk_format|.
+sk_sp<SkData> MakeKTX2(uint32_t vk_format,
+                       uint32_t width,
+                       uint32_t height,
+                       const std::vector<uint8_t>& blocks,
+                       bool premultiplied) {
+  constexpr size_t kDFDOffset = 104;
+  constexpr size_t kDFDLength = 44;
+  constexpr size_t kLevelOffset = kDFDOffset + kDFDLength;
+  std::vector<uint8_t> file(kLevelOffset + blocks.size(), 0);
+  auto write32 = [&file](size_t offset, uint32_t value) {
+    for (size_t i = 0; i < 4; i++) {
+      file[offset + i] = (value >> (i * 8)) & 0xff;
+    }
+  };
+  const uint8_t identifier[] = {0xAB, 'K',  'T',  'X', ' ',  '2',
+                                '0',  0xBB, '\r', '\n', 0x1A, '\n'};
+  memcpy(file.data(), identifier, sizeof(identifier));
+  write32(12, vk_format);
+  write32(16, 1);  // typeSize
+  write32(20, width);
+  write32(24, height);
+  write32(36, 1);  // faceCount
+  write32(40, 1);  // levelCount
+  write32(48, kDFDOffset);
+  write32(52, kDFDLength);
+  write32(80, kLevelOffset);
+  write32(88, blocks.size());
+  write32(96, blocks.size());
+  write32(kDFDOffset, kDFDLength);
+  file[kDFDOffset + 15] = premultiplied ? 1 : 0;
+  std::copy(blocks.begin(), blocks.end(), file.begin() + kLevelOffset);
+  return SkData::MakeWithCopy(file.data(), file.size());
+}
+
+// A 4x4 ETC2 block whose left half is (172, 2, 255) and whose right half is
+// (87, 2, 255), all with an alpha of 128.
+const std::vector<uint8_t> kETC2Block = {
+    100,  0x20, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,  // EAC alpha
+    0xA5, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,  // ETC2 color
+};
+
+constexpr uint32_t kVkFormatETC2 = 151;
+constexpr uint32_t kVkFormatASTC4x4 = 157;
+}  // namespace
+
+TEST(ImageDecoderTest, KTX2ImagesExposeTheirCompressedTexture) {
+  std::vector<uint8_t> blocks;
+  for (int i = 0; i < 4; i++) {
+    blocks.insert(blocks.end(), kETC2Block.begin(), kETC2Block.end());
+  }
+  auto data = MakeKTX2(kVkFormatETC2, 7, 5, blocks, /*premultiplied=*/true);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  const auto& info = generator->GetInfo();
+  EXPECT_EQ(info.dimensions(), SkISize::Make(7, 5));
+  EXPECT_EQ(info.colorType(), kRGBA_8888_SkColorType);
+  EXPECT_EQ(info.alphaType(), kPremul_SkAlphaType);
+  EXPECT_EQ(generator->GetScaledDimensions(0.5f), SkISize::Make(7, 5));
+
+  auto texture = generator->GetCompressedTexture();
+  ASSERT_TRUE(texture.has_value());
+  EXPECT_EQ(texture->format,
+            ImageGenerator::CompressedTextureFormat::kETC2RGBA8);
+  EXPECT_EQ(texture->size, SkISize::Make(7, 5));
+  ASSERT_TRUE(texture->data);
+  ASSERT_EQ(texture->data->size(), blocks.size());
+  EXPECT_EQ(memcmp(texture->data->data(), blocks.data(), blocks.size()), 0);
+
+  // Unmarked images are unpremultiplied.
+  generator = registry.CreateCompatibleGenerator(
+      MakeKTX2(kVkFormatETC2, 7, 5, blocks, /*premultiplied=*/false));
+  ASSERT_TRUE(generator);
+  EXPECT_EQ(generator->GetInfo().alphaType(), kUnpremul_SkAlphaType);
+}
+
+TEST(ImageDecoderTest, KTX2ETC2ImagesAreTranscoded) {
+  auto generator = KTX2ImageGenerator::MakeFromData(
+      MakeKTX2(kVkFormatETC2, 4, 4, kETC2Block, /*premultiplied=*/false));
+  ASSERT_TRUE(generator);
+
+  SkBitmap bitmap;
+  bitmap.allocPixels(generator->GetInfo());
+  ASSERT_TRUE(generator->GetPixels(bitmap.info(), bitmap.getPixels(),
+                                   bitmap.rowBytes(), 0, std::nullopt));
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      const auto* pixel = static_cast<const uint8_t*>(bitmap.getAddr(x, y));
+      EXPECT_EQ(pixel[0], x < 2 ? 172 : 87) << x << ", " << y;
+      EXPECT_EQ(pixel[1], 2) << x << ", " << y;
+      EXPECT_EQ(pixel[2], 255) << x << ", " << y;
+      EXPECT_EQ(pixel[3], 128) << x << ", " << y;
+    }
+  }
+}
+
+TEST(ImageDecoderTest, KTX2ASTCImagesAreNotTranscoded) {
+  auto generator = KTX2ImageGenerator::MakeFromData(
+      MakeKTX2(kVkFormatASTC4x4, 4, 4, std::vector<uint8_t>(16),
+               /*premultiplied=*/true));
+  ASSERT_TRUE(generator);
+  ASSERT_TRUE(generator->GetCompressedTexture().has_value());
+
+  SkBitmap bitmap;
+  bitmap.allocPixels(generator->GetInfo());
+  EXPECT_FALSE(generator->GetPixels(bitmap.info(), bitmap.getPixels(),
+                                    bitmap.rowBytes(), 0, std::nullopt));
+}
+
+TEST(ImageDecoderTest, InvalidKTX2ImagesAreRejected) {
+  // The level is shorter than the image.
+  EXPECT_FALSE(KTX2ImageGenerator::MakeFromData(
+      MakeKTX2(kVkFormatETC2, 8, 4, kETC2Block, /*premultiplied=*/true)));
+  // Unsupported format.
+  EXPECT_FALSE(KTX2ImageGenerator::MakeFromData(
+      MakeKTX2(37, 4, 4, kETC2Block, /*premultiplied=*/true)));
+  // Truncated file.
+  auto data = MakeKTX2(kVkFormatETC2, 4, 4, kETC2Block, /*premultiplied=*/true);
+  EXPECT_FALSE(KTX2ImageGenerator::MakeFromData(
+      SkData::MakeSubset(data.get(), 0, data->size() - 1)));
+  EXPECT_FALSE(KTX2ImageGenerator::MakeFromData(
+      SkData::MakeSubset(data.get(), 0, 64)));
+}
+
+#if IMPELLER_SUPPORTS_RENDERING
+TEST(ImageDecoderTest, ImpellerUploadsCompressedTexturesWithoutGpu) {
+  auto no_gpu_access_context =
+      std::make_shared<impeller::TestImpellerContext>();
+  auto gpu_disabled_switch = std::make_shared<fml::SyncSwitch>(true);
+
+  ImageGenerator::CompressedTexture texture = {
+      .format = ImageGenerator::CompressedTextureFormat::kETC2RGBA8,
+      .size = SkISize::Make(4, 4),
+      .data = SkData::MakeWithCopy(kETC2Block.data(), kETC2Block.size()),
+  };
+  auto result = ImageDecoderImpeller::UploadCompressedTexture(
+      no_gpu_access_context, texture, gpu_disabled_switch);
+  ASSERT_EQ(no_gpu_access_context->command_buffer_count_, 0ul);
+  ASSERT_EQ(result.second, "");
+  ASSERT_TRUE(result.first);
+  EXPECT_EQ(result.first->dimensions(), SkISize::Make(4, 4));
+
+  // The data must cover every block of the texture.
+  texture.size = SkISize::Make(8, 4);
+  result = ImageDecoderImpeller::UploadCompressedTexture(
+      no_gpu_access_context, texture, gpu_disabled_switch);
+  EXPECT_FALSE(result.first);
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   auto data = OpenFixtureAsSkData("Horizontal.jpg");
 
@@ -131,4 +131,14 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_pixels_incrementally(
+    const SkPixmap& pixmap,
+    int rows_per_batch,
+    const ImageGenerator::RowsDecodedCallback& rows_decoded) const {
+  FML_DCHECK(generator_);
+  return generator_->GetPixelsIncrementally(
+      pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes(), rows_per_batch,
+      rows_decoded);
+}
+
 }  // namespace flutter
@@ -106,10 +106,29 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
     return image_info_.dimensions();
   }
 
+  /// @brief  Gets the GPU compressed texture of this image, if it is stored
+  ///         in a GPU texture compression format.
+  /// @see    `ImageGenerator::GetCompressedTexture`
+  std::optional<ImageGenerator::CompressedTexture> get_compressed_texture()
+      const {
+    if (generator_) {
+      return generator_->GetCompressedTexture();
+    }
+    return std::nullopt;
+  }
+
   /// @brief  Gets pixels for this image transformed based on the EXIF
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Gets pixels for this image like `get_pixels`, reporting batches
+  ///         of rows as soon as they are decoded.
+  /// @see    `ImageGenerator::GetPixelsIncrementally`
+  bool get_pixels_incrementally(
+      const SkPixmap& pixmap,
+      int rows_per_batch,
+      const ImageGenerator::RowsDecodedCallback& rows_decoded) const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -10,12 +10,14 @@
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_encoding_impeller.h"
 #endif  // IMPELLER_SUPPORTS_RENDERING
+#include "flutter/lib/ui/painting/image_encoding_png.h"
 #include "flutter/lib/ui/painting/image_encoding_skia.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -107,8 +109,10 @@ sk_sp<SkData> CopyImageByteData(const sk_sp<SkImage>& raster_image,
   return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
 }
 
-sk_sp<SkData> EncodeImage(const sk_sp<SkImage>& raster_image,
-                          ImageByteFormat format) {
+sk_sp<SkData> EncodeImage(
+    const sk_sp<SkImage>& raster_image,
+    ImageByteFormat format,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("flutter", __FUNCTION__);
 
   if (!raster_image) {
@@ -117,6 +121,12 @@ sk_sp<SkData> EncodeImage(const sk_sp<SkImage>& raster_image,
 
   switch (format) {
     case kPNG: {
+      if (concurrent_task_runner && ShouldEncodePngInStrips(*raster_image)) {
+        if (auto png_image =
+                EncodePngInStrips(raster_image, concurrent_task_runner)) {
+          return png_image;
+        }
+      }
       auto png_image = SkPngEncoder::Encode(nullptr, raster_image.get(), {});
 
       if (png_image == nullptr) {
@@ -152,6 +162,7 @@ void EncodeImageAndInvokeDataCallback(
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
     const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
     const fml::RefPtr<fml::TaskRunner>& io_task_runner,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
     const fml::WeakPtr<GrDirectContext>& resource_context,
     const fml::TaskRunnerAffineWeakPtr<SnapshotDelegate>& snapshot_delegate,
     const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
@@ -164,14 +175,30 @@ void EncodeImageAndInvokeDataCallback(
   // The static leak checker gets confused by the use of fml::MakeCopyable in
   // EncodeImage.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-  auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](const sk_sp<SkImage>& raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(raster_image, format);
+  auto encode_and_reply = [callback_task = std::move(callback_task), format,
+                           ui_task_runner, concurrent_task_runner](
+                              const sk_sp<SkImage>& raster_image) {
+    sk_sp<SkData> encoded =
+        EncodeImage(raster_image, format, concurrent_task_runner);
     ui_task_runner->PostTask([callback_task = callback_task,
                               encoded = std::move(encoded)]() mutable {
       callback_task(std::move(encoded));
     });
   };
+  // Encoding a large image, especially to PNG, can take longer than a frame.
+  // The raster image is only read, so it is encoded on a worker instead of
+  // holding up the uploads and readbacks queued on the IO thread.
+  auto encode_task = [encode_and_reply = std::move(encode_and_reply),
+                      concurrent_task_runner](sk_sp<SkImage> raster_image) {
+    if (!concurrent_task_runner || !raster_image) {
+      encode_and_reply(raster_image);
+      return;
+    }
+    concurrent_task_runner->PostTask(
+        [encode_and_reply, raster_image = std::move(raster_image)]() {
+          encode_and_reply(raster_image);
+        });
+  };
 
   FML_DCHECK(image);
 #if IMPELLER_SUPPORTS_RENDERING
@@ -214,13 +241,15 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
        image_format, ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
+       concurrent_task_runner =
+           UIDartState::Current()->GetConcurrentTaskRunner(),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate = UIDartState::Current()->GetSnapshotDelegate(),
        is_impeller_enabled =
            UIDartState::Current()->IsImpellerEnabled()]() mutable {
         EncodeImageAndInvokeDataCallback(
             image, std::move(callback), image_format, ui_task_runner,
-            raster_task_runner, io_task_runner,
+            raster_task_runner, io_task_runner, concurrent_task_runner,
             io_manager->GetResourceContext(), snapshot_delegate,
             io_manager->GetIsGpuDisabledSyncSwitch(),
             io_manager->GetImpellerContext(), is_impeller_enabled);
@@ -0,0 +1,321 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_encoding_png.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+namespace {
+
+// Tall enough for the dictionary and flush at the start and end of each
+// strip to cost little, short enough for large images to spread over the
+// workers.
+constexpr int kRowsPerStrip = 128;
+// Below this, posting the strips costs more than compressing them serially.
+constexpr uint64_t kMinPixelCount = 1024 * 1024;
+// The level Skia's encoder uses.
+constexpr int kCompressionLevel = 6;
+constexpr size_t kDeflateWindowSize = 32 * 1024;
+constexpr uint8_t kSubFilter = 1;
+
+constexpr uint8_t kPngSignature[] = {0x89, 0x50, 0x4e, 0x47,
+                                     0x0d, 0x0a, 0x1a, 0x0a};
+constexpr uint8_t kColorTypeRGB = 2;
+constexpr uint8_t kColorTypeRGBA = 6;
+
+struct Strip {
+  std::vector<uint8_t> deflated;
+  uLong adler = 0;
+  size_t filtered_size = 0;
+  bool is_valid = false;
+};
+
+struct EncodeState {
+  sk_sp<SkImage> image;
+  size_t bytes_per_pixel = 0;
+  std::vector<Strip> strips;
+  std::atomic<size_t> next_strip = 0;
+  std::mutex mutex;
+  std::condition_variable strip_done;
+  size_t done_count = 0;
+};
+
+// Reads `row_count` rows starting at `first_row` and filters each of them,
+// prefixed with its filter type.
+bool ReadFilteredRows(const SkImage& image,
+                      size_t bytes_per_pixel,
+                      int first_row,
+                      int row_count,
+                      std::vector<uint8_t>& filtered) {
+  const size_t width = image.width();
+  const size_t pixels_row_bytes = width * 4;
+  std::vector<uint8_t> pixels(pixels_row_bytes * row_count);
+  const SkImageInfo info =
+      SkImageInfo::Make(image.width(), row_count, kRGBA_8888_SkColorType,
+                        kUnpremul_SkAlphaType, image.refColorSpace());
+  if (!image.readPixels(nullptr, info, pixels.data(), pixels_row_bytes, 0,
+                        first_row)) {
+    return false;
+  }
+
+  const size_t row_bytes = width * bytes_per_pixel;
+  filtered.resize((row_bytes + 1) * row_count);
+  uint8_t* out = filtered.data();
+  for (int y = 0; y < row_count; y++) {
+    const uint8_t* rgba = pixels.data() + y * pixels_row_bytes;
+    uint8_t* row = out + 1;
+    if (bytes_per_pixel == 4) {
+      std::memcpy(row, rgba, row_bytes);
+    } else {
+      for (size_t x = 0; x < width; x++) {
+        std::memcpy(row + x * 3, rgba + x * 4, 3);
+      }
+    }
+    // Filter in place from the end of the row, where the unfiltered bytes to
+    // the left are still available.
+    for (size_t i = row_bytes - 1; i >= bytes_per_pixel; i--) {
+      row[i] -= row[i - bytes_per_pixel];
+    }
+    out[0] = kSubFilter;
+    out += row_bytes + 1;
+  }
+  return true;
+}
+
+bool DeflateStrip(const EncodeState& state, size_t index, Strip& strip) {
+  TRACE_EVENT0("flutter", "DeflatePngStrip");
+  const SkImage& image = *state.image;
+  const int first_row = index * kRowsPerStrip;
+  const int row_count = std::min(kRowsPerStrip, image.height() - first_row);
+  const bool is_last = index + 1 == state.strips.size();
+
+  std::vector<uint8_t> filtered;
+  if (!ReadFilteredRows(image, state.bytes_per_pixel, first_row, row_count,
+                        filtered)) {
+    return false;
+  }
+
+  z_stream stream = {};
+  if (deflateInit2(&stream, kCompressionLevel, Z_DEFLATED,
+                   -MAX_WBITS,  // Raw deflate, the zlib wrapper is shared.
+                   8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  bool result = true;
+  if (first_row > 0) {
+    // Let the strip refer back to the end of the one above it, as a serial
+    // encoder would.
+    const size_t filtered_row_bytes = filtered.size() / row_count;
+    const int dictionary_rows = std::min<int>(
+        first_row, (kDeflateWindowSize + filtered_row_bytes - 1) /
+                       filtered_row_bytes);
+    std::vector<uint8_t> dictionary;
+    result = ReadFilteredRows(image, state.bytes_per_pixel,
+                              first_row - dictionary_rows, dictionary_rows,
+                              dictionary);
+    if (result) {
+      const size_t length = std::min(kDeflateWindowSize, dictionary.size());
+      result = deflateSetDictionary(&stream,
+                                    dictionary.data() + dictionary.size() -
+                                        length,
+                                    length) == Z_OK;
+    }
+  }
+
+  // A sync flush ends the stream on a byte boundary, so that the next strip
+  // can be appended to it.
+  const int flush = is_last ? Z_FINISH : Z_SYNC_FLUSH;
+  strip.deflated.resize(deflateBound(&stream, filtered.size()) + 16);
+  stream.next_in = filtered.data();
+  stream.avail_in = filtered.size();
+  while (result) {
+    stream.next_out = strip.deflated.data() + stream.total_out;
+    stream.avail_out = strip.deflated.size() - stream.total_out;
+    const int status = deflate(&stream, flush);
+    if (is_last ? status == Z_STREAM_END
+                : status == Z_OK && stream.avail_in == 0 &&
+                      stream.avail_out > 0) {
+      break;
+    }
+    if (status != Z_OK && status != Z_BUF_ERROR) {
+      result = false;
+      break;
+    }
+    strip.deflated.resize(strip.deflated.size() * 2);
+  }
+  strip.deflated.resize(stream.total_out);
+  deflateEnd(&stream);
+  if (!result) {
+    return false;
+  }
+
+  strip.adler = adler32(adler32(0, nullptr, 0), filtered.data(),
+                        filtered.size());
+  strip.filtered_size = filtered.size();
+  return true;
+}
+
+void DeflateStrips(const std::shared_ptr<EncodeState>& state) {
+  while (true) {
+    const size_t index = state->next_strip++;
+    if (index >= state->strips.size()) {
+      return;
+    }
+    Strip& strip = state->strips[index];
+    strip.is_valid = DeflateStrip(*state, index, strip);
+    {
+      std::scoped_lock lock(state->mutex);
+      state->done_count++;
+    }
+    state->strip_done.notify_all();
+  }
+}
+
+uint8_t* WriteUint32(uint8_t* out, uint32_t value) {
+  out[0] = value >> 24;
+  out[1] = value >> 16;
+  out[2] = value >> 8;
+  out[3] = value;
+  return out + 4;
+}
+
+uLong Crc32(uLong crc, const uint8_t* data, size_t length) {
+  // zlib takes 32 bit lengths.
+  constexpr size_t kMaxLength = std::numeric_limits<uInt>::max();
+  do {
+    const size_t piece = std::min(length, kMaxLength);
+    crc = crc32(crc, data, piece);
+    data += piece;
+    length -= piece;
+  } while (length > 0);
+  return crc;
+}
+
+// Writes the length and type of a chunk whose data follows.
+uint8_t* WriteChunkHeader(uint8_t* out, const char* type, size_t length) {
+  out = WriteUint32(out, length);
+  std::memcpy(out, type, 4);
+  return out + 4;
+}
+
+// Writes the CRC of the chunk that starts at `chunk`.
+uint8_t* WriteChunkCrc(uint8_t* out, const uint8_t* chunk) {
+  // The CRC covers the type and data, but not the length.
+  const uint8_t* type = chunk + 4;
+  return WriteUint32(out, Crc32(crc32(0, nullptr, 0), type, out - type));
+}
+
+}  // namespace
+
+bool ShouldEncodePngInStrips(const SkImage& image) {
+  if (static_cast<uint64_t>(image.width()) * image.height() < kMinPixelCount ||
+      image.height() < 2 * kRowsPerStrip) {
+    return false;
+  }
+  // Higher precision images are written with 16 bits per channel by Skia.
+  if (image.colorType() != kRGBA_8888_SkColorType &&
+      image.colorType() != kBGRA_8888_SkColorType) {
+    return false;
+  }
+  // No color profile is written.
+  return image.colorSpace() == nullptr || image.colorSpace()->isSRGB();
+}
+
+sk_sp<SkData> EncodePngInStrips(
+    const sk_sp<SkImage>& image,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  TRACE_EVENT0("flutter", "EncodePngInStrips");
+  FML_DCHECK(image && !image->isTextureBacked());
+
+  auto state = std::make_shared<EncodeState>();
+  state->image = image;
+  state->bytes_per_pixel = image->isOpaque() ? 3 : 4;
+  state->strips.resize((image->height() + kRowsPerStrip - 1) / kRowsPerStrip);
+
+  const size_t helper_count = std::min<size_t>(
+      state->strips.size() - 1, std::thread::hardware_concurrency());
+  for (size_t i = 0; i < helper_count; i++) {
+    task_runner->PostTask([state]() { DeflateStrips(state); });
+  }
+  DeflateStrips(state);
+  {
+    std::unique_lock lock(state->mutex);
+    state->strip_done.wait(
+        lock, [&state] { return state->done_count == state->strips.size(); });
+  }
+
+  // The zlib wrapper around the strips: a header for the default window size
+  // and compression level, and the checksum of all the filtered rows.
+  constexpr uint8_t kZlibHeader[] = {0x78, 0x9c};
+  size_t idat_length = sizeof(kZlibHeader) + 4;
+  uLong adler = adler32(0, nullptr, 0);
+  for (const Strip& strip : state->strips) {
+    if (!strip.is_valid) {
+      FML_LOG(ERROR) << "Could not compress the image to PNG.";
+      return nullptr;
+    }
+    idat_length += strip.deflated.size();
+    adler = adler32_combine(adler, strip.adler,
+                            static_cast<z_off_t>(strip.filtered_size));
+  }
+  if (idat_length > std::numeric_limits<int32_t>::max()) {
+    return nullptr;
+  }
+
+  constexpr size_t kIhdrLength = 13;
+  constexpr size_t kChunkOverhead = 12;
+  auto data = SkData::MakeUninitialized(
+      sizeof(kPngSignature) + kChunkOverhead + kIhdrLength + kChunkOverhead +
+      idat_length + kChunkOverhead);
+  uint8_t* out = static_cast<uint8_t*>(data->writable_data());
+
+  std::memcpy(out, kPngSignature, sizeof(kPngSignature));
+  out += sizeof(kPngSignature);
+
+  uint8_t* chunk = out;
+  out = WriteChunkHeader(out, "IHDR", kIhdrLength);
+  out = WriteUint32(out, image->width());
+  out = WriteUint32(out, image->height());
+  *out++ = 8;  // Bit depth.
+  *out++ = state->bytes_per_pixel == 4 ? kColorTypeRGBA : kColorTypeRGB;
+  *out++ = 0;  // Deflate.
+  *out++ = 0;  // Adaptive filtering.
+  *out++ = 0;  // No interlacing.
+  out = WriteChunkCrc(out, chunk);
+
+  chunk = out;
+  out = WriteChunkHeader(out, "IDAT", idat_length);
+  std::memcpy(out, kZlibHeader, sizeof(kZlibHeader));
+  out += sizeof(kZlibHeader);
+  for (const Strip& strip : state->strips) {
+    std::memcpy(out, strip.deflated.data(), strip.deflated.size());
+    out += strip.deflated.size();
+  }
+  out = WriteUint32(out, adler);
+  out = WriteChunkCrc(out, chunk);
+
+  chunk = out;
+  out = WriteChunkHeader(out, "IEND", 0);
+  out = WriteChunkCrc(out, chunk);
+
+  FML_DCHECK(out == data->bytes() + data->size());
+  return data;
+}
+
+}  // namespace flutter
@@ -6,14 +6,19 @@
 #include "flutter/lib/ui/painting/image_encoding_impl.h"
 
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_encoding_png.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/codec/SkPngDecoder.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_encoding_impeller.h"
@@ -277,6 +282,65 @@ TEST(ImageEncodingImpellerTest, ConvertDlImageToSkImage10XR) {
 }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
+TEST(ImageEncodingPngTest, EncodesInStripsLosslessly) {
+  for (bool is_opaque : {false, true}) {
+    // Tall enough for a partial strip at the bottom.
+    SkImageInfo info = SkImageInfo::Make(
+        1000, 1100, kRGBA_8888_SkColorType,
+        is_opaque ? kOpaque_SkAlphaType : kUnpremul_SkAlphaType);
+    SkBitmap bitmap;
+    ASSERT_TRUE(bitmap.tryAllocPixels(info));
+    for (int y = 0; y < info.height(); y++) {
+      for (int x = 0; x < info.width(); x++) {
+        uint8_t* rgba = static_cast<uint8_t*>(bitmap.getAddr(x, y));
+        rgba[0] = x % 256;
+        rgba[1] = y % 256;
+        rgba[2] = (x + y) % 256;
+        rgba[3] = is_opaque ? 0xff : (x * y) % 256;
+      }
+    }
+    bitmap.setImmutable();
+    auto image = SkImages::RasterFromBitmap(bitmap);
+    ASSERT_TRUE(ShouldEncodePngInStrips(*image));
+
+    auto loop = fml::ConcurrentMessageLoop::Create(4);
+    auto data = EncodePngInStrips(image, loop->GetTaskRunner());
+    ASSERT_TRUE(data);
+
+    SkCodec::Result result;
+    auto codec = SkPngDecoder::Decode(data, &result);
+    ASSERT_TRUE(codec) << result;
+    SkBitmap decoded;
+    ASSERT_TRUE(decoded.tryAllocPixels(
+        info.makeAlphaType(kUnpremul_SkAlphaType)));
+    ASSERT_EQ(codec->getPixels(decoded.pixmap()), SkCodec::kSuccess);
+    EXPECT_EQ(std::memcmp(decoded.getPixels(), bitmap.getPixels(),
+                          bitmap.computeByteSize()),
+              0);
+  }
+}
+
+TEST(ImageEncodingPngTest, OnlyEncodesLarge8BitImagesInStrips) {
+  auto make_image = [](int width, int height, SkColorType color_type) {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::Make(width, height, color_type,
+                                         kPremul_SkAlphaType));
+    bitmap.eraseColor(SK_ColorWHITE);
+    return SkImages::RasterFromBitmap(bitmap);
+  };
+  EXPECT_TRUE(ShouldEncodePngInStrips(
+      *make_image(1024, 1024, kRGBA_8888_SkColorType)));
+  EXPECT_TRUE(ShouldEncodePngInStrips(
+      *make_image(1024, 1024, kBGRA_8888_SkColorType)));
+  EXPECT_FALSE(ShouldEncodePngInStrips(
+      *make_image(100, 100, kRGBA_8888_SkColorType)));
+  // Too short to split.
+  EXPECT_FALSE(ShouldEncodePngInStrips(
+      *make_image(8192, 200, kRGBA_8888_SkColorType)));
+  EXPECT_FALSE(ShouldEncodePngInStrips(
+      *make_image(1024, 1024, kRGBA_F16_SkColorType)));
+}
+
 }  // namespace testing
 }  // namespace flutter
 
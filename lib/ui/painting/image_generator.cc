@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -14,6 +15,10 @@
 
 namespace flutter {
 
+// Half of the smallest step between the JPEG DCT scales, so that stepping up
+// from any scale never skips a supported one.
+static constexpr float kScaledDimensionsStep = 1.0f / 16.0f;
+
 ImageGenerator::~ImageGenerator() = default;
 
 sk_sp<SkImage> ImageGenerator::GetImage() {
@@ -35,6 +40,24 @@ sk_sp<SkImage> ImageGenerator::GetImage() {
   return SkImages::RasterFromBitmap(bitmap);
 }
 
+bool ImageGenerator::GetPixelsIncrementally(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes,
+    int rows_per_batch,
+    const RowsDecodedCallback& rows_decoded) {
+  if (!GetPixels(info, pixels, row_bytes)) {
+    return false;
+  }
+  rows_decoded(0, info.height());
+  return true;
+}
+
+std::optional<ImageGenerator::CompressedTexture>
+ImageGenerator::GetCompressedTexture() const {
+  return std::nullopt;
+}
+
 BuiltinSkiaImageGenerator::~BuiltinSkiaImageGenerator() = default;
 
 BuiltinSkiaImageGenerator::BuiltinSkiaImageGenerator(
@@ -134,7 +157,20 @@ const ImageGenerator::FrameInfo BuiltinSkiaCodecImageGenerator::GetFrameInfo(
 
 SkISize BuiltinSkiaCodecImageGenerator::GetScaledDimensions(
     float desired_scale) {
-  SkISize size = codec_->getScaledDimensions(desired_scale);
+  // Codecs round to the closest scale they support, which for JPEG DCT
+  // scaling is a multiple of 1/8 that may be below the desired scale. Scaling
+  // a decode that is smaller than the target back up loses detail, so step up
+  // to the next supported scale instead.
+  const SkISize full_size = codec_->dimensions();
+  const float min_width = full_size.width() * desired_scale - 0.5f;
+  const float min_height = full_size.height() * desired_scale - 0.5f;
+  float scale = std::min(desired_scale, 1.0f);
+  SkISize size = codec_->getScaledDimensions(scale);
+  while ((size.width() < min_width || size.height() < min_height) &&
+         scale < 1.0f) {
+    scale = std::min(scale + kScaledDimensionsStep, 1.0f);
+    size = codec_->getScaledDimensions(scale);
+  }
   if (SkEncodedOriginSwapsWidthHeight(codec_->getOrigin())) {
     std::swap(size.fWidth, size.fHeight);
   }
@@ -188,6 +224,38 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::GetPixelsIncrementally(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes,
+    int rows_per_batch,
+    const RowsDecodedCallback& rows_decoded) {
+  FML_DCHECK(rows_per_batch > 0);
+  // Re-oriented images and codecs that don't decode rows top down (such as
+  // interlaced images) need the whole image before any row is final.
+  if (codec_->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec_->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder ||
+      codec_->startScanlineDecode(info) != SkCodec::kSuccess) {
+    return ImageGenerator::GetPixelsIncrementally(info, pixels, row_bytes,
+                                                  rows_per_batch, rows_decoded);
+  }
+
+  auto* rows = static_cast<uint8_t*>(pixels);
+  for (int first_row = 0; first_row < info.height();
+       first_row += rows_per_batch) {
+    int row_count = std::min(rows_per_batch, info.height() - first_row);
+    int decoded_rows = codec_->getScanlines(rows + first_row * row_bytes,
+                                            row_count, row_bytes);
+    if (decoded_rows != row_count) {
+      FML_DLOG(WARNING) << "codec could not get scanlines " << first_row
+                        << " to " << first_row + row_count << ".";
+      return false;
+    }
+    rows_decoded(first_row, row_count);
+  }
+  return true;
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
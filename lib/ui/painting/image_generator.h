@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <functional>
 #include <optional>
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/codec/SkCodec.h"
@@ -51,6 +52,31 @@ class ImageGenerator {
     SkCodecAnimation::Blend blend_mode;
   };
 
+  /// @brief  Invoked by `GetPixelsIncrementally` once the rows in
+  ///         [first_row, first_row + row_count) are fully decoded. Reported
+  ///         rows are never written to again.
+  using RowsDecodedCallback = std::function<void(int first_row, int row_count)>;
+
+  /// @brief  The GPU texture compression formats that images can be stored
+  ///         in. Each of them stores 4x4 blocks of pixels in 16 bytes.
+  enum class CompressedTextureFormat {
+    kETC2RGBA8,
+    kASTC4x4,
+    kBC7,
+  };
+
+  /// @brief  The blocks of an image that is stored in a GPU texture
+  ///         compression format.
+  struct CompressedTexture {
+    CompressedTextureFormat format;
+
+    /// The size of the image in pixels.
+    SkISize size;
+
+    /// The tightly packed rows of blocks of the image, from the top left.
+    sk_sp<SkData> data;
+  };
+
   virtual ~ImageGenerator();
 
   /// @brief   Returns basic information about the contents of the encoded
@@ -135,6 +161,42 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Decode the first frame of the image into a given buffer,
+  ///             reporting batches of rows as they are decoded so the caller
+  ///             can start consuming them before the whole image is ready.
+  ///
+  ///             The default implementation decodes the whole image with
+  ///             `GetPixels` and reports all the rows at once.
+  /// @param[in]  info            The desired size and color info of the
+  ///                             decoded image, as for `GetPixels`.
+  /// @param[in]  pixels          The location where the raw decoded image
+  ///                             data should be written.
+  /// @param[in]  row_bytes       The total number of bytes that should make
+  ///                             up a single row of decoded image data.
+  /// @param[in]  rows_per_batch  The number of rows to decode between two
+  ///                             invocations of `rows_decoded`. The last
+  ///                             batch may be smaller.
+  /// @param[in]  rows_decoded    Invoked on the decoding thread after each
+  ///                             batch.
+  /// @return     True if the image was successfully decoded. Rows may have
+  ///             been reported even if decoding fails later on.
+  /// @see        `GetPixels`
+  virtual bool GetPixelsIncrementally(const SkImageInfo& info,
+                                      void* pixels,
+                                      size_t row_bytes,
+                                      int rows_per_batch,
+                                      const RowsDecodedCallback& rows_decoded);
+
+  /// @brief   Get the image as a GPU compressed texture, for images that are
+  ///          stored in one of the `CompressedTextureFormat`s. Renderers that
+  ///          can sample from the format upload these blocks as-is instead of
+  ///          decoding the image with `GetPixels`.
+  ///
+  ///          The default implementation returns std::nullopt.
+  /// @return  The blocks of the image, or std::nullopt if the image isn't
+  ///          stored in a GPU texture compression format.
+  virtual std::optional<CompressedTexture> GetCompressedTexture() const;
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -212,6 +274,13 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool GetPixelsIncrementally(const SkImageInfo& info,
+                              void* pixels,
+                              size_t row_bytes,
+                              int rows_per_batch,
+                              const RowsDecodedCallback& rows_decoded) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
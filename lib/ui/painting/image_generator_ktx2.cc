@@ -0,0 +1,441 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "image_generator_ktx2.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkAlphaType.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkColorType.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+namespace {
+
+// The offsets of the fields of the KTX2 header that are read.
+constexpr size_t kVkFormatOffset = 12;
+constexpr size_t kPixelWidthOffset = 20;
+constexpr size_t kPixelHeightOffset = 24;
+constexpr size_t kPixelDepthOffset = 28;
+constexpr size_t kLayerCountOffset = 32;
+constexpr size_t kFaceCountOffset = 36;
+constexpr size_t kLevelCountOffset = 40;
+constexpr size_t kSupercompressionSchemeOffset = 44;
+constexpr size_t kDFDByteOffsetOffset = 48;
+constexpr size_t kDFDByteLengthOffset = 52;
+constexpr size_t kLevelIndexOffset = 80;
+constexpr size_t kLevelIndexEntrySize = 24;
+
+// The flags of the basic data format descriptor block follow the total size
+// of the descriptor, the block header and the color model, primaries and
+// transfer function.
+constexpr size_t kDFDFlagsOffset = 15;
+
+constexpr int kBlockSize = 4;
+constexpr size_t kBytesPerBlock = 16;
+
+template <typename T>
+T ReadLittleEndian(const uint8_t* bytes) {
+  T value;
+  memcpy(&value, bytes, sizeof(T));
+  return fml::LittleEndianToArch(value);
+}
+
+uint64_t ReadBigEndian64(const uint8_t* bytes) {
+  uint64_t value;
+  memcpy(&value, bytes, sizeof(value));
+  return fml::BigEndianToArch(value);
+}
+
+uint8_t Clamp255(int value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+uint8_t Extend4(uint64_t value) {
+  return static_cast<uint8_t>((value << 4) | value);
+}
+
+uint8_t Extend5(uint64_t value) {
+  return static_cast<uint8_t>((value << 3) | (value >> 2));
+}
+
+uint8_t Extend6(uint64_t value) {
+  return static_cast<uint8_t>((value << 2) | (value >> 4));
+}
+
+uint8_t Extend7(uint64_t value) {
+  return static_cast<uint8_t>((value << 1) | (value >> 6));
+}
+
+int SignExtend3(uint64_t value) {
+  return static_cast<int>(value ^ 4) - 4;
+}
+
+// The intensity modifiers of the individual and differential modes, indexed
+// by the table codeword of a subblock.
+constexpr int kETC1Modifiers[8][2] = {
+    {2, 8},   {5, 17},  {9, 29},  {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+// The distances between the paint colors of the T and H modes.
+constexpr int kETC2Distances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+constexpr int kEACModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},  {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},  {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},   {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+// The RGBA8888 pixels of a 4x4 block, indexed by row and column.
+using BlockPixels = uint8_t[kBlockSize][kBlockSize][4];
+
+// Decodes the EAC block that holds the alpha channel of an ETC2 RGBA8 block.
+void DecodeEACAlphaBlock(uint64_t block, BlockPixels& pixels) {
+  const int base = static_cast<int>((block >> 56) & 0xFF);
+  const int multiplier = static_cast<int>((block >> 52) & 0xF);
+  const int* modifiers = kEACModifiers[(block >> 48) & 0xF];
+  for (int x = 0; x < kBlockSize; x++) {
+    for (int y = 0; y < kBlockSize; y++) {
+      // Pixels are stored column by column with 3 bits each.
+      const auto index = (block >> (45 - 3 * (x * kBlockSize + y))) & 0x7;
+      pixels[y][x][3] = Clamp255(base + modifiers[index] * multiplier);
+    }
+  }
+}
+
+// Decodes the color channels of an ETC2 block in any of its five modes.
+void DecodeETC2ColorBlock(uint64_t block, BlockPixels& pixels) {
+  // The 2 bit paint color or modifier index of each pixel, whose least and
+  // most significant bits are stored column by column in the lower 32 bits.
+  const auto pixel_index = [block](int x, int y) {
+    const int bit = x * kBlockSize + y;
+    return static_cast<int>(((block >> (bit + 16)) & 1) << 1 |
+                            ((block >> bit) & 1));
+  };
+  const auto set_color = [&pixels](int x, int y, int r, int g, int b) {
+    pixels[y][x][0] = Clamp255(r);
+    pixels[y][x][1] = Clamp255(g);
+    pixels[y][x][2] = Clamp255(b);
+  };
+
+  const bool differential = (block >> 33) & 1;
+  const bool flip = (block >> 32) & 1;
+  int base_colors[2][3];
+  if (!differential) {
+    for (int c = 0; c < 3; c++) {
+      base_colors[0][c] = Extend4((block >> (60 - 8 * c)) & 0xF);
+      base_colors[1][c] = Extend4((block >> (56 - 8 * c)) & 0xF);
+    }
+  } else {
+    int bases[3];
+    int deltas[3];
+    for (int c = 0; c < 3; c++) {
+      bases[c] = static_cast<int>((block >> (59 - 8 * c)) & 0x1F);
+      deltas[c] = SignExtend3((block >> (56 - 8 * c)) & 0x7);
+    }
+    const auto overflows = [&](int c) {
+      return bases[c] + deltas[c] < 0 || bases[c] + deltas[c] > 31;
+    };
+
+    if (overflows(0)) {
+      // T mode.
+      const int c1[3] = {
+          Extend4(((block >> 57) & 0xC) | ((block >> 56) & 0x3)),
+          Extend4((block >> 52) & 0xF), Extend4((block >> 48) & 0xF)};
+      const int c2[3] = {Extend4((block >> 44) & 0xF),
+                         Extend4((block >> 40) & 0xF),
+                         Extend4((block >> 36) & 0xF)};
+      const int d =
+          kETC2Distances[((block >> 33) & 0x6) | ((block >> 32) & 0x1)];
+      for (int x = 0; x < kBlockSize; x++) {
+        for (int y = 0; y < kBlockSize; y++) {
+          switch (pixel_index(x, y)) {
+            case 0:
+              set_color(x, y, c1[0], c1[1], c1[2]);
+              break;
+            case 1:
+              set_color(x, y, c2[0] + d, c2[1] + d, c2[2] + d);
+              break;
+            case 2:
+              set_color(x, y, c2[0], c2[1], c2[2]);
+              break;
+            case 3:
+              set_color(x, y, c2[0] - d, c2[1] - d, c2[2] - d);
+              break;
+          }
+        }
+      }
+      return;
+    }
+
+    if (overflows(1)) {
+      // H mode.
+      const int c1[3] = {
+          Extend4((block >> 59) & 0xF),
+          Extend4(((block >> 55) & 0xE) | ((block >> 52) & 0x1)),
+          Extend4(((block >> 48) & 0x8) | ((block >> 47) & 0x7))};
+      const int c2[3] = {Extend4((block >> 43) & 0xF),
+                         Extend4((block >> 39) & 0xF),
+                         Extend4((block >> 35) & 0xF)};
+      // The last bit of the distance index is whether the first base color
+      // is at least the second one.
+      const int c1_value = (c1[0] << 16) | (c1[1] << 8) | c1[2];
+      const int c2_value = (c2[0] << 16) | (c2[1] << 8) | c2[2];
+      const int d =
+          kETC2Distances[((block >> 32) & 0x4) | ((block >> 31) & 0x2) |
+                         (c1_value >= c2_value ? 1 : 0)];
+      for (int x = 0; x < kBlockSize; x++) {
+        for (int y = 0; y < kBlockSize; y++) {
+          const int index = pixel_index(x, y);
+          const int* base = index < 2 ? c1 : c2;
+          const int offset = (index & 1) ? -d : d;
+          set_color(x, y, base[0] + offset, base[1] + offset, base[2] + offset);
+        }
+      }
+      return;
+    }
+
+    if (overflows(2)) {
+      // Planar mode, which interpolates between three colors and ignores
+      // the pixel indices.
+      const int o[3] = {
+          Extend6((block >> 57) & 0x3F),
+          Extend7(((block >> 50) & 0x40) | ((block >> 49) & 0x3F)),
+          Extend6(((block >> 43) & 0x20) | ((block >> 40) & 0x18) |
+                  ((block >> 39) & 0x7))};
+      const int h[3] = {
+          Extend6(((block >> 33) & 0x3E) | ((block >> 32) & 0x1)),
+          Extend7((block >> 25) & 0x7F), Extend6((block >> 19) & 0x3F)};
+      const int v[3] = {Extend6((block >> 13) & 0x3F),
+                        Extend7((block >> 6) & 0x7F), Extend6(block & 0x3F)};
+      for (int x = 0; x < kBlockSize; x++) {
+        for (int y = 0; y < kBlockSize; y++) {
+          int color[3];
+          for (int c = 0; c < 3; c++) {
+            color[c] = (x * (h[c] - o[c]) + y * (v[c] - o[c]) + 4 * o[c] + 2) >>
+                       2;
+          }
+          set_color(x, y, color[0], color[1], color[2]);
+        }
+      }
+      return;
+    }
+
+    for (int c = 0; c < 3; c++) {
+      base_colors[0][c] = Extend5(bases[c]);
+      base_colors[1][c] = Extend5(bases[c] + deltas[c]);
+    }
+  }
+
+  // Individual and differential modes split the block into two subblocks,
+  // side by side or, when flipped, on top of each other.
+  const int codewords[2] = {static_cast<int>((block >> 37) & 0x7),
+                            static_cast<int>((block >> 34) & 0x7)};
+  for (int x = 0; x < kBlockSize; x++) {
+    for (int y = 0; y < kBlockSize; y++) {
+      const int subblock = flip ? (y >= 2) : (x >= 2);
+      const int index = pixel_index(x, y);
+      const int* modifiers = kETC1Modifiers[codewords[subblock]];
+      const int modifier =
+          (index & 2) ? -modifiers[index & 1] : modifiers[index & 1];
+      const int* base = base_colors[subblock];
+      set_color(x, y, base[0] + modifier, base[1] + modifier,
+                base[2] + modifier);
+    }
+  }
+}
+
+}  // namespace
+
+KTX2ImageGenerator::~KTX2ImageGenerator() = default;
+
+KTX2ImageGenerator::KTX2ImageGenerator(sk_sp<SkData> data,
+                                       const SkImageInfo& image_info,
+                                       CompressedTexture texture)
+    : data_(std::move(data)),
+      image_info_(image_info),
+      texture_(std::move(texture)) {}
+
+const SkImageInfo& KTX2ImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int KTX2ImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int KTX2ImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo KTX2ImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize KTX2ImageGenerator::GetScaledDimensions(float desired_scale) {
+  return image_info_.dimensions();
+}
+
+bool KTX2ImageGenerator::GetPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes,
+                                   unsigned int frame_index,
+                                   std::optional<unsigned int> prior_frame) {
+  if (frame_index != 0 || info.dimensions() != image_info_.dimensions()) {
+    FML_DLOG(ERROR) << "KTX2 images can only be decoded at their full size.";
+    return false;
+  }
+  if (texture_.format != CompressedTextureFormat::kETC2RGBA8) {
+    FML_DLOG(ERROR) << "Only ETC2 images can be transcoded, and the renderer "
+                       "can't sample from the compressed format of this image.";
+    return false;
+  }
+
+  if (info == image_info_) {
+    return DecodeETC2(pixels, row_bytes);
+  }
+  // Decode to a temporary buffer and let Skia convert it to the requested
+  // color and alpha type.
+  std::vector<uint8_t> decoded(image_info_.computeMinByteSize());
+  if (!DecodeETC2(decoded.data(), image_info_.minRowBytes())) {
+    return false;
+  }
+  SkPixmap decoded_pixmap(image_info_, decoded.data(),
+                          image_info_.minRowBytes());
+  return decoded_pixmap.readPixels(info, pixels, row_bytes);
+}
+
+bool KTX2ImageGenerator::DecodeETC2(void* pixels, size_t row_bytes) const {
+  const auto* blocks = texture_.data->bytes();
+  auto* rows = static_cast<uint8_t*>(pixels);
+  const int width = image_info_.width();
+  const int height = image_info_.height();
+  BlockPixels block_pixels;
+  for (int block_y = 0; block_y < height; block_y += kBlockSize) {
+    for (int block_x = 0; block_x < width; block_x += kBlockSize) {
+      // Each block is an EAC alpha block followed by an ETC2 color block.
+      DecodeEACAlphaBlock(ReadBigEndian64(blocks), block_pixels);
+      DecodeETC2ColorBlock(ReadBigEndian64(blocks + 8), block_pixels);
+      blocks += kBytesPerBlock;
+
+      // Blocks at the right and bottom edges may overhang the image.
+      const int columns = std::min(kBlockSize, width - block_x);
+      const int block_rows = std::min(kBlockSize, height - block_y);
+      for (int y = 0; y < block_rows; y++) {
+        memcpy(rows + (block_y + y) * row_bytes + block_x * 4,
+               block_pixels[y], columns * 4);
+      }
+    }
+  }
+  return true;
+}
+
+std::optional<ImageGenerator::CompressedTexture>
+KTX2ImageGenerator::GetCompressedTexture() const {
+  return texture_;
+}
+
+std::unique_ptr<ImageGenerator> KTX2ImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data || data->size() < kLevelIndexOffset + kLevelIndexEntrySize) {
+    return nullptr;
+  }
+  const auto* bytes = data->bytes();
+  if (memcmp(bytes, kKTX2Identifier, sizeof(kKTX2Identifier)) != 0) {
+    return nullptr;
+  }
+
+  CompressedTextureFormat format;
+  switch (ReadLittleEndian<uint32_t>(bytes + kVkFormatOffset)) {
+    case kVkFormatETC2R8G8B8A8UNormBlock:
+      format = CompressedTextureFormat::kETC2RGBA8;
+      break;
+    case kVkFormatASTC4x4UNormBlock:
+      format = CompressedTextureFormat::kASTC4x4;
+      break;
+    case kVkFormatBC7UNormBlock:
+      format = CompressedTextureFormat::kBC7;
+      break;
+    default:
+      FML_DLOG(ERROR) << "Unsupported KTX2 image format.";
+      return nullptr;
+  }
+
+  const auto width = ReadLittleEndian<uint32_t>(bytes + kPixelWidthOffset);
+  const auto height = ReadLittleEndian<uint32_t>(bytes + kPixelHeightOffset);
+  // Arrays of 1 layer are the same as plain images.
+  if (width == 0 || height == 0 ||
+      width > static_cast<uint32_t>(std::numeric_limits<int>::max()) ||
+      height > static_cast<uint32_t>(std::numeric_limits<int>::max()) ||
+      ReadLittleEndian<uint32_t>(bytes + kPixelDepthOffset) != 0 ||
+      ReadLittleEndian<uint32_t>(bytes + kLayerCountOffset) > 1 ||
+      ReadLittleEndian<uint32_t>(bytes + kFaceCountOffset) != 1 ||
+      ReadLittleEndian<uint32_t>(bytes + kSupercompressionSchemeOffset) != 0) {
+    FML_DLOG(ERROR) << "Only single 2D KTX2 images without supercompression "
+                       "are supported.";
+    return nullptr;
+  }
+  // A level count of 0 asks for the mipmaps to be generated.
+  const auto level_count = std::max(
+      ReadLittleEndian<uint32_t>(bytes + kLevelCountOffset), uint32_t{1});
+  if (data->size() <
+      kLevelIndexOffset + uint64_t{level_count} * kLevelIndexEntrySize) {
+    return nullptr;
+  }
+
+  // The first level is the base level. The smaller levels are dropped, and
+  // the mipmaps of the image are generated by the renderer instead, if at
+  // all.
+  const auto level_offset =
+      ReadLittleEndian<uint64_t>(bytes + kLevelIndexOffset);
+  const auto level_length =
+      ReadLittleEndian<uint64_t>(bytes + kLevelIndexOffset + 8);
+  const uint64_t expected_length =
+      ((uint64_t{width} + kBlockSize - 1) / kBlockSize) *
+      ((uint64_t{height} + kBlockSize - 1) / kBlockSize) * kBytesPerBlock;
+  if (level_length != expected_length || level_offset > data->size() ||
+      level_length > data->size() - level_offset) {
+    FML_DLOG(ERROR) << "Invalid KTX2 level index.";
+    return nullptr;
+  }
+
+  auto alpha_type = kUnpremul_SkAlphaType;
+  const auto dfd_offset =
+      ReadLittleEndian<uint32_t>(bytes + kDFDByteOffsetOffset);
+  const auto dfd_length =
+      ReadLittleEndian<uint32_t>(bytes + kDFDByteLengthOffset);
+  if (dfd_length > kDFDFlagsOffset &&
+      uint64_t{dfd_offset} + kDFDFlagsOffset < data->size() &&
+      (bytes[dfd_offset + kDFDFlagsOffset] & kDFDFlagAlphaPremultiplied)) {
+    alpha_type = kPremul_SkAlphaType;
+  }
+
+  CompressedTexture texture = {
+      .format = format,
+      .size = SkISize::Make(width, height),
+      .data = SkData::MakeSubset(data.get(), level_offset, level_length),
+  };
+  auto image_info = SkImageInfo::Make(texture.size, kRGBA_8888_SkColorType,
+                                      alpha_type, SkColorSpace::MakeSRGB());
+  return std::unique_ptr<KTX2ImageGenerator>(new KTX2ImageGenerator(
+      std::move(data), image_info, std::move(texture)));
+}
+
+}  // namespace flutter
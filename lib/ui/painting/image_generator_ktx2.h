@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+
+#include "image_generator.h"
+
+namespace flutter {
+
+/// @brief  Reads KTX2 containers that hold an image in one of the
+///         `ImageGenerator::CompressedTextureFormat`s.
+///
+///         Renderers that can sample from the format of the image upload its
+///         base level as-is through `GetCompressedTexture`. Everywhere else
+///         ETC2 images are transcoded to RGBA8888 by `GetPixels`, while ASTC
+///         and BC7 images fail to decode.
+///
+///         Only single 2D images without supercompression are supported.
+///         Images must be marked as premultiplied in their data format
+///         descriptor to be uploaded as-is, since renderers sample from
+///         premultiplied textures.
+class KTX2ImageGenerator : public ImageGenerator {
+ public:
+  ~KTX2ImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  // |ImageGenerator|
+  std::optional<CompressedTexture> GetCompressedTexture() const override;
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  static constexpr uint8_t kKTX2Identifier[12] = {
+      0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+  // The VkFormat values of the supported formats.
+  enum VkFormat : uint32_t {
+    kVkFormatBC7UNormBlock = 145,
+    kVkFormatETC2R8G8B8A8UNormBlock = 151,
+    kVkFormatASTC4x4UNormBlock = 157,
+  };
+
+  // The only data format descriptor flag, set when the color channels are
+  // premultiplied by alpha.
+  static constexpr uint8_t kDFDFlagAlphaPremultiplied = 1;
+
+  KTX2ImageGenerator(sk_sp<SkData> data,
+                     const SkImageInfo& image_info,
+                     CompressedTexture texture);
+
+  // Decodes the base level of an ETC2 image into unpremultiplied RGBA8888
+  // pixels.
+  bool DecodeETC2(void* pixels, size_t row_bytes) const;
+
+  sk_sp<SkData> data_;
+  const SkImageInfo image_info_;
+  const CompressedTexture texture_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(KTX2ImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
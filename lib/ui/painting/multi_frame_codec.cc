@@ -4,9 +4,11 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -21,12 +23,15 @@
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 int decode_ahead_frames)
+    : state_(std::make_shared<State>(std::move(generator),
+                                     decode_ahead_frames)) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              int decode_ahead_frames)
     : generator_(std::move(generator)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
@@ -34,7 +39,10 @@ MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
                            ? -1
                            : generator_->GetPlayCount() - 1),
       is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()),
-      nextFrameIndex_(0) {}
+      decode_ahead_frames_(std::max(decode_ahead_frames, 0)),
+      // Besides the frames decoded ahead, one buffer is in use by the frame
+      // that is being uploaded and one by the frame that is on screen.
+      compositor_(generator_, decode_ahead_frames_ + 2) {}
 
 static void InvokeNextFrameCallback(
     const fml::RefPtr<CanvasImage>& image,
@@ -54,95 +62,12 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
+std::pair<sk_sp<DlImage>, std::string> MultiFrameCodec::State::GetFrameImage(
+    const SkBitmap& bitmap,
     fml::WeakPtr<GrDirectContext> resourceContext,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
     const std::shared_ptr<impeller::Context>& impeller_context,
     fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
-  SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
-  if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
-  }
-  if (!bitmap.tryAllocPixels(info)) {
-    std::ostringstream ostr;
-    ostr << "Failed to allocate memory for bitmap of size "
-         << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
-  }
-
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
-
-  const int requiredFrameIndex =
-      frameInfo.required_frame.value_or(SkCodec::kNoFrame);
-
-  if (requiredFrameIndex != SkCodec::kNoFrame) {
-    // We are here when the frame said |disposal_method| is
-    // `DisposalMethod::kKeep` or `DisposalMethod::kRestorePrevious` and
-    // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
-    if (!lastRequiredFrame_.has_value()) {
-      FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
-          << requiredFrameIndex
-          << " and no required frames are cached. Using blank slate instead.";
-    } else {
-      // Copy the previous frame's output buffer into the current frame as the
-      // starting point.
-      bitmap.writePixels(lastRequiredFrame_->pixmap());
-      if (restoreBGColorRect_.has_value()) {
-        bitmap.erase(SK_ColorTRANSPARENT, restoreBGColorRect_.value());
-      }
-    }
-  }
-
-  // Write the new frame to the output buffer. The bitmap pixels as supplied
-  // are already set in accordance with the previous frame's disposal policy.
-  if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
-    std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
-  }
-
-  const bool keep_current_frame =
-      frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep;
-  const bool restore_previous_frame =
-      frameInfo.disposal_method ==
-      SkCodecAnimation::DisposalMethod::kRestorePrevious;
-  const bool previous_frame_available = lastRequiredFrame_.has_value();
-
-  // Store the current frame in `lastRequiredFrame_` if the frame's disposal
-  // method indicates we should do so.
-  // * When the disposal method is "Keep", the stored frame should always be
-  //   overwritten with the new frame we just crafted.
-  // * When the disposal method is "RestorePrevious", the previously stored
-  //   frame should be retained and used as the backdrop for the next frame
-  //   again. If there isn't already a stored frame, that means we haven't
-  //   rendered any frames yet! When this happens, we just fall back to "Keep"
-  //   behavior and store the current frame as the backdrop of the next frame.
-
-  if (keep_current_frame ||
-      (previous_frame_available && !restore_previous_frame)) {
-    // Replace the stored frame. The `lastRequiredFrame_` will get used as the
-    // starting backdrop for the next frame.
-    lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
-  }
-
-  if (frameInfo.disposal_method ==
-      SkCodecAnimation::DisposalMethod::kRestoreBGColor) {
-    restoreBGColorRect_ = frameInfo.disposal_rect;
-  } else {
-    restoreBGColorRect_.reset();
-  }
-
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     // This is safe regardless of whether the GPU is available or not because
@@ -185,26 +110,39 @@ MultiFrameCodec::State::GetNextFrameImage(
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::unique_ptr<DartPersistentValue> callback,
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
+    const fml::RefPtr<fml::TaskRunner>& io_task_runner,
     fml::WeakPtr<GrDirectContext> resourceContext,
     fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
     size_t trace_id,
     const std::shared_ptr<impeller::Context>& impeller_context) {
+  std::optional<MultiFrameCompositor::Frame> frame;
+  std::string decode_error;
+  if (decodedFrames_.empty()) {
+    std::tie(frame, decode_error) = compositor_.CompositeNextFrame();
+  } else {
+    std::tie(frame, decode_error) = std::move(decodedFrames_.front());
+    decodedFrames_.pop_front();
+  }
+
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
-  sk_sp<DlImage> dlImage;
-  std::string decode_error;
-  std::tie(dlImage, decode_error) =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
-  if (dlImage) {
-    image = CanvasImage::Create();
-    image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+  if (frame.has_value()) {
+    sk_sp<DlImage> dlImage;
+    std::tie(dlImage, decode_error) =
+        GetFrameImage(frame->bitmap, std::move(resourceContext),
+                      gpu_disable_sync_switch, impeller_context,
+                      std::move(unref_queue));
+    if (dlImage) {
+      image = CanvasImage::Create();
+      image->set_image(dlImage);
+      ImageGenerator::FrameInfo frameInfo =
+          generator_->GetFrameInfo(frame->index);
+      duration = frameInfo.duration;
+    }
+    // Lets the compositor reuse the buffer once the image is done with it.
+    frame.reset();
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -214,6 +152,29 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
         InvokeNextFrameCallback(image, duration, decode_error,
                                 std::move(callback), trace_id);
       }));
+
+  ScheduleDecodeAhead(io_task_runner);
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead(
+    const fml::RefPtr<fml::TaskRunner>& io_task_runner) {
+  if (decodeAheadScheduled_ ||
+      decodedFrames_.size() >= static_cast<size_t>(decode_ahead_frames_)) {
+    return;
+  }
+  decodeAheadScheduled_ = true;
+  io_task_runner->PostTask(
+      [weak_state = weak_from_this(), io_task_runner]() {
+        auto state = weak_state.lock();
+        if (!state) {
+          return;
+        }
+        TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeAhead");
+        state->decodeAheadScheduled_ = false;
+        state->decodedFrames_.push_back(
+            state->compositor_.CompositeNextFrame());
+        state->ScheduleDecodeAhead(io_task_runner);
+      });
 }
 
 Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
@@ -246,6 +207,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       io_task_runner = task_runners.GetIOTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -254,7 +216,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
           return;
         }
         state->GetNextFrameAndInvokeCallback(
-            std::move(callback), ui_task_runner,
+            std::move(callback), ui_task_runner, io_task_runner,
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
             io_manager->GetImpellerContext());
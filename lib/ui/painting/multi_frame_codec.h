@@ -8,7 +8,9 @@
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
+#include "flutter/lib/ui/painting/multi_frame_compositor.h"
 
+#include <deque>
 #include <utility>
 
 using tonic::DartPersistentValue;
@@ -17,7 +19,13 @@ namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
-  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  /// The number of frames that are composited ahead of the frame that was
+  /// last requested by default.
+  static constexpr int kDefaultDecodeAheadFrames = 1;
+
+  explicit MultiFrameCodec(
+      std::shared_ptr<ImageGenerator> generator,
+      int decode_ahead_frames = kDefaultDecodeAheadFrames);
 
   ~MultiFrameCodec() override;
 
@@ -40,28 +48,27 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<ImageGenerator> generator, int decode_ahead_frames);
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
+    const int decode_ahead_frames_;
 
     // The non-const members and functions below here are only read or written
     // to on the IO thread. They are not safe to access or write on the UI
     // thread.
-    int nextFrameIndex_;
-    // The last decoded frame that's required to decode any subsequent frames.
-    std::optional<SkBitmap> lastRequiredFrame_;
-    // The index of the last decoded required frame.
-    int lastRequiredFrameIndex_ = -1;
-
-    // The rectangle that should be cleared if the previous frame's disposal
-    // method was kRestoreBGColor.
-    std::optional<SkIRect> restoreBGColorRect_;
-
-    std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+    MultiFrameCompositor compositor_;
+    // The frames that were composited ahead of time, in order.
+    std::deque<std::pair<std::optional<MultiFrameCompositor::Frame>,
+                         std::string>>
+        decodedFrames_;
+    bool decodeAheadScheduled_ = false;
+
+    std::pair<sk_sp<DlImage>, std::string> GetFrameImage(
+        const SkBitmap& bitmap,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
@@ -70,11 +77,17 @@ class MultiFrameCodec : public Codec {
     void GetNextFrameAndInvokeCallback(
         std::unique_ptr<DartPersistentValue> callback,
         const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
+        const fml::RefPtr<fml::TaskRunner>& io_task_runner,
         fml::WeakPtr<GrDirectContext> resourceContext,
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         size_t trace_id,
         const std::shared_ptr<impeller::Context>& impeller_context);
+
+    // Composites the frames after the requested one on the IO task runner,
+    // one task per frame so that other IO work can run in between.
+    void ScheduleDecodeAhead(
+        const fml::RefPtr<fml::TaskRunner>& io_task_runner);
   };
 
   // Shared across the UI and IO task runners.
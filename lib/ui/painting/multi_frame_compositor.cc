@@ -0,0 +1,169 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/multi_frame_compositor.h"
+
+#include <sstream>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/codec/SkCodecAnimation.h"
+#include "third_party/skia/include/core/SkPixelRef.h"
+
+namespace flutter {
+
+MultiFrameCompositor::MultiFrameCompositor(
+    std::shared_ptr<ImageGenerator> generator,
+    size_t max_pooled_buffers)
+    : generator_(std::move(generator)),
+      frame_count_(generator_->GetFrameCount()),
+      max_pooled_buffers_(max_pooled_buffers) {}
+
+MultiFrameCompositor::~MultiFrameCompositor() = default;
+
+bool MultiFrameCompositor::AcquireBuffer(const SkImageInfo& info,
+                                         SkBitmap* bitmap,
+                                         bool* recycled) {
+  for (auto it = buffer_pool_.begin(); it != buffer_pool_.end(); ++it) {
+    if (it->info() == info && it->pixelRef()->unique()) {
+      *bitmap = std::move(*it);
+      buffer_pool_.erase(it);
+      *recycled = true;
+      return true;
+    }
+  }
+  if (!bitmap->tryAllocPixels(info)) {
+    return false;
+  }
+  allocated_buffer_count_++;
+  *recycled = false;
+  return true;
+}
+
+void MultiFrameCompositor::ReleaseBuffer(const SkBitmap& bitmap) {
+  if (buffer_pool_.size() < max_pooled_buffers_) {
+    buffer_pool_.push_back(bitmap);
+  }
+}
+
+std::pair<std::optional<MultiFrameCompositor::Frame>, std::string>
+MultiFrameCompositor::CompositeNextFrame() {
+  TRACE_EVENT0("flutter", "MultiFrameCompositor::CompositeNextFrame");
+  const int frame_index = next_frame_index_;
+  next_frame_index_ = (next_frame_index_ + 1) % frame_count_;
+
+  SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    info = info.makeAlphaType(kPremul_SkAlphaType);
+  }
+
+  ImageGenerator::FrameInfo frame_info = generator_->GetFrameInfo(frame_index);
+  const int required_frame_index =
+      frame_info.required_frame.value_or(SkCodec::kNoFrame);
+  const bool keep_current_frame =
+      frame_info.disposal_method == SkCodecAnimation::DisposalMethod::kKeep;
+  const bool restore_previous_frame =
+      frame_info.disposal_method ==
+      SkCodecAnimation::DisposalMethod::kRestorePrevious;
+  const bool previous_frame_available = last_required_frame_.has_value();
+  const bool has_backdrop =
+      required_frame_index != SkCodec::kNoFrame && previous_frame_available;
+
+  // Frames that replace the stored frame can be drawn straight on top of it,
+  // unless the pixels of the stored frame are still in use elsewhere.
+  SkBitmap bitmap;
+  bool composited_in_place = false;
+  if (has_backdrop && !restore_previous_frame && max_pooled_buffers_ > 0 &&
+      last_required_frame_->info() == info &&
+      last_required_frame_->pixelRef()->unique()) {
+    bitmap = std::move(last_required_frame_.value());
+    last_required_frame_.reset();
+    composited_in_place = true;
+  } else {
+    bool recycled = false;
+    if (!AcquireBuffer(info, &bitmap, &recycled)) {
+      std::ostringstream ostr;
+      ostr << "Failed to allocate memory for bitmap of size "
+           << info.computeMinByteSize() << "B";
+      std::string decode_error = ostr.str();
+      FML_LOG(ERROR) << decode_error;
+      return std::make_pair(std::nullopt, decode_error);
+    }
+    if (recycled && !has_backdrop) {
+      // Recycled buffers still hold an older frame.
+      bitmap.eraseColor(SK_ColorTRANSPARENT);
+    }
+  }
+
+  if (required_frame_index != SkCodec::kNoFrame) {
+    // We are here when the frame said |disposal_method| is
+    // `DisposalMethod::kKeep` or `DisposalMethod::kRestorePrevious` and
+    // |required_frame_index| is set to ex-frame or ex-ex-frame.
+    if (!has_backdrop) {
+      FML_DLOG(INFO)
+          << "Frame " << frame_index << " depends on frame "
+          << required_frame_index
+          << " and no required frames are cached. Using blank slate instead.";
+    } else {
+      // Copy the previous frame's output buffer into the current frame as the
+      // starting point.
+      if (!composited_in_place) {
+        bitmap.writePixels(last_required_frame_->pixmap());
+      }
+      if (restore_bg_color_rect_.has_value()) {
+        bitmap.erase(SK_ColorTRANSPARENT, restore_bg_color_rect_.value());
+      }
+    }
+  }
+
+  // Write the new frame to the output buffer. The bitmap pixels as supplied
+  // are already set in accordance with the previous frame's disposal policy.
+  if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
+                             frame_index, required_frame_index)) {
+    std::ostringstream ostr;
+    ostr << "Could not getPixels for frame " << frame_index;
+    std::string decode_error = ostr.str();
+    FML_LOG(ERROR) << decode_error;
+    // The stored frame was partially overwritten, so the frames that depend
+    // on it start from a blank slate.
+    if (!composited_in_place) {
+      ReleaseBuffer(bitmap);
+    }
+    return std::make_pair(std::nullopt, decode_error);
+  }
+
+  // Store the current frame in `last_required_frame_` if the frame's disposal
+  // method indicates we should do so.
+  // * When the disposal method is "Keep", the stored frame should always be
+  //   overwritten with the new frame we just crafted.
+  // * When the disposal method is "RestorePrevious", the previously stored
+  //   frame should be retained and used as the backdrop for the next frame
+  //   again. If there isn't already a stored frame, that means we haven't
+  //   rendered any frames yet! When this happens, we just fall back to "Keep"
+  //   behavior and store the current frame as the backdrop of the next frame.
+  if (keep_current_frame ||
+      (previous_frame_available && !restore_previous_frame)) {
+    // Replace the stored frame. The `last_required_frame_` will get used as
+    // the starting backdrop for the next frame.
+    if (last_required_frame_.has_value()) {
+      ReleaseBuffer(last_required_frame_.value());
+    }
+    last_required_frame_ = bitmap;
+  } else {
+    ReleaseBuffer(bitmap);
+  }
+
+  if (frame_info.disposal_method ==
+      SkCodecAnimation::DisposalMethod::kRestoreBGColor) {
+    restore_bg_color_rect_ = frame_info.disposal_rect;
+  } else {
+    restore_bg_color_rect_.reset();
+  }
+
+  Frame frame = {.index = frame_index, .bitmap = std::move(bitmap)};
+  return std::make_pair(std::move(frame), std::string());
+}
+
+}  // namespace flutter
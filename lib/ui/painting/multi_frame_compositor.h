@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_COMPOSITOR_H_
+#define FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_COMPOSITOR_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Composites the frames of an animated image in order, on top of
+///             the frames that they depend on according to the frame info of
+///             the generator.
+///
+///             Frame buffers are recycled once nothing but the compositor
+///             references their pixels anymore. Frames that are drawn on top
+///             of the previous frame are composited in place when the
+///             previous frame is no longer in use, instead of copying it to a
+///             new buffer first.
+///
+///             Not thread safe. The compositor must only be used on a single
+///             thread at a time.
+///
+class MultiFrameCompositor {
+ public:
+  struct Frame {
+    int index = 0;
+    /// The composited frame. Its pixels can be overwritten by later frames
+    /// as soon as the last copy of the bitmap that shares them is dropped.
+    SkBitmap bitmap;
+  };
+
+  /// @param[in]  generator            The generator of the animated image.
+  /// @param[in]  max_pooled_buffers   The number of unused frame buffers
+  ///                                  that are kept for later frames. No
+  ///                                  buffers are recycled if this is 0.
+  MultiFrameCompositor(std::shared_ptr<ImageGenerator> generator,
+                       size_t max_pooled_buffers);
+
+  ~MultiFrameCompositor();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Composites the next frame of the animation, and loops back
+  ///             to the first frame after the last one.
+  ///
+  /// @return     The frame, or an error message if it could not be decoded.
+  ///
+  std::pair<std::optional<Frame>, std::string> CompositeNextFrame();
+
+  /// The index of the frame that |CompositeNextFrame| composites next.
+  int GetNextFrameIndex() const { return next_frame_index_; }
+
+  /// The number of frame buffers allocated so far.
+  size_t GetAllocatedBufferCount() const { return allocated_buffer_count_; }
+
+ private:
+  const std::shared_ptr<ImageGenerator> generator_;
+  const int frame_count_;
+  const size_t max_pooled_buffers_;
+  int next_frame_index_ = 0;
+  size_t allocated_buffer_count_ = 0;
+
+  // The last decoded frame that's required to decode any subsequent frames.
+  std::optional<SkBitmap> last_required_frame_;
+
+  // The rectangle that should be cleared if the previous frame's disposal
+  // method was kRestoreBGColor.
+  std::optional<SkIRect> restore_bg_color_rect_;
+
+  // Frame buffers that may be reused once they are no longer referenced
+  // elsewhere.
+  std::vector<SkBitmap> buffer_pool_;
+
+  // Returns a buffer for a frame of |info| that no one else uses. The
+  // contents of |recycled| buffers are undefined.
+  bool AcquireBuffer(const SkImageInfo& info,
+                     SkBitmap* bitmap,
+                     bool* recycled);
+
+  void ReleaseBuffer(const SkBitmap& bitmap);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MultiFrameCompositor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_COMPOSITOR_H_
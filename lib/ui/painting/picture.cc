@@ -203,23 +203,22 @@ Dart_Handle Picture::DoRasterizeToImage(const sk_sp<DisplayList>& display_list,
                          height, ui_task,
                          layer_tree = std::move(layer_tree)]() mutable {
         auto picture_bounds = SkISize::Make(width, height);
-        sk_sp<DlImage> image;
         if (layer_tree) {
           FML_DCHECK(picture_bounds == layer_tree->frame_size());
-          auto display_list =
+          display_list =
               layer_tree->Flatten(SkRect::MakeWH(width, height),
                                   snapshot_delegate->GetTextureRegistry(),
                                   snapshot_delegate->GetGrContext());
-
-          image = snapshot_delegate->MakeRasterSnapshot(display_list,
-                                                        picture_bounds);
-        } else {
-          image = snapshot_delegate->MakeRasterSnapshot(display_list,
-                                                        picture_bounds);
         }
 
-        fml::TaskRunner::RunNowOrPostTask(
-            ui_task_runner, [ui_task, image]() { ui_task(image); });
+        // Where the backend allows it, the snapshot is rendered off the
+        // raster thread so that it doesn't hold up frames.
+        snapshot_delegate->MakeRasterSnapshotAsync(
+            std::move(display_list), picture_bounds,
+            [ui_task_runner, ui_task](sk_sp<DlImage> image) {
+              fml::TaskRunner::RunNowOrPostTask(
+                  ui_task_runner, [ui_task, image]() { ui_task(image); });
+            });
       }));
 
   return Dart_Null();
@@ -68,12 +68,21 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   fml::RefPtr<SingleFrameCodec>* raw_codec_ref =
       new fml::RefPtr<SingleFrameCodec>(this);
 
-  decoder->Decode(
+  decode_scheduler_ = decoder->GetDecodeScheduler();
+  decode_task_id_ = decoder->Decode(
       descriptor_, target_width_, target_height_,
       [raw_codec_ref](auto image, auto decode_error) {
         std::unique_ptr<fml::RefPtr<SingleFrameCodec>> codec_ref(raw_codec_ref);
         fml::RefPtr<SingleFrameCodec> codec(std::move(*codec_ref));
 
+        codec->decode_scheduler_ = nullptr;
+        codec->decode_task_id_ = ImageDecodeScheduler::kInvalidTaskID;
+        if (codec->decode_cancelled_) {
+          // Nobody is waiting for the frames of a disposed codec.
+          codec->pending_callbacks_.clear();
+          return;
+        }
+
         auto state = codec->pending_callbacks_.front().dart_state().lock();
 
         if (!state) {
@@ -114,4 +123,16 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   return Dart_Null();
 }
 
+void SingleFrameCodec::dispose() {
+  // Decodes that already started run to completion, but their result is
+  // dropped.
+  if (status_ == Status::kInProgress) {
+    decode_cancelled_ = true;
+    if (decode_scheduler_) {
+      decode_scheduler_->Cancel(decode_task_id_);
+    }
+  }
+  Codec::dispose();
+}
+
 }  // namespace flutter
@@ -32,6 +32,9 @@ class SingleFrameCodec : public Codec {
   // |Codec|
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
+  // |Codec|
+  void dispose() override;
+
  private:
   enum class Status { kNew, kInProgress, kComplete };
   Status status_;
@@ -40,6 +43,12 @@ class SingleFrameCodec : public Codec {
   uint32_t target_height_;
   fml::RefPtr<CanvasImage> cached_image_;
   std::vector<DartPersistentValue> pending_callbacks_;
+  // The decode that is in progress, which is cancelled if the codec is
+  // disposed before the decode started.
+  std::shared_ptr<ImageDecodeScheduler> decode_scheduler_;
+  ImageDecodeScheduler::TaskID decode_task_id_ =
+      ImageDecodeScheduler::kInvalidTaskID;
+  bool decode_cancelled_ = false;
 
   FML_FRIEND_MAKE_REF_COUNTED(SingleFrameCodec);
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(SingleFrameCodec);
@@ -93,6 +93,119 @@ class RootIsolateToken {
   external static int __getRootIsolateToken();
 }
 
+/// A pool of background isolates, in the isolate group of the root isolate,
+/// that run computations for the root isolate.
+///
+/// Unlike [Isolate.run], which spawns an isolate for every computation, the
+/// pool spawns its isolates once and reuses them, so running a computation
+/// only costs a couple of messages. Call [warmUp] early, such as in `main`,
+/// so that the first computations don't wait for the isolates to spawn.
+///
+/// The isolates of the pool are registered with
+/// [PlatformDispatcher.registerBackgroundIsolate], so they send platform
+/// messages directly rather than through the root isolate.
+///
+/// Computations, their results and their errors are sent between the
+/// isolates with [SendPort.send], so they are subject to its restrictions on
+/// the objects that can be sent. A computation waits for the ones that were
+/// sent to the same isolate before it.
+abstract final class BackgroundIsolatePool {
+  /// The number of isolates in the pool.
+  static final int isolateCount =
+      math.max(1, math.min(4, Platform.numberOfProcessors - 1));
+
+  static Future<List<SendPort>>? _isolates;
+  // The number of computations that each isolate hasn't returned yet.
+  static final List<int> _pendingCounts = List<int>.filled(isolateCount, 0);
+
+  /// Spawns the isolates of the pool unless they were already spawned.
+  ///
+  /// Throws a [StateError] if it isn't called on the root isolate.
+  static Future<void> warmUp() => _getIsolates();
+
+  /// Runs [computation] on an isolate of the pool and returns its result.
+  ///
+  /// If [computation] throws, the returned future completes with the error.
+  ///
+  /// Throws a [StateError] if it isn't called on the root isolate.
+  static Future<R> run<R>(FutureOr<R> Function() computation) async {
+    final List<SendPort> isolates = await _getIsolates();
+    int index = 0;
+    for (int i = 1; i < isolates.length; i++) {
+      if (_pendingCounts[i] < _pendingCounts[index]) {
+        index = i;
+      }
+    }
+    final ReceivePort responsePort = ReceivePort();
+    _pendingCounts[index]++;
+    final List<Object?> response;
+    try {
+      isolates[index].send(<Object?>[computation, responsePort.sendPort]);
+      response = await responsePort.first as List<Object?>;
+    } finally {
+      _pendingCounts[index]--;
+      responsePort.close();
+    }
+    if (response.length == 2) {
+      Error.throwWithStackTrace(
+        response[0]!,
+        StackTrace.fromString(response[1]! as String),
+      );
+    }
+    return response[0] as R;
+  }
+
+  static Future<List<SendPort>> _getIsolates() {
+    final RootIsolateToken? token = RootIsolateToken.instance;
+    if (token == null) {
+      throw StateError('The background isolate pool can only be used on the root isolate.');
+    }
+    return _isolates ??= Future.wait(<Future<SendPort>>[
+      for (int i = 0; i < isolateCount; i++) _spawnIsolate(token, i),
+    ]);
+  }
+
+  static Future<SendPort> _spawnIsolate(RootIsolateToken token, int index) async {
+    final ReceivePort port = ReceivePort();
+    try {
+      await Isolate.spawn(
+        _backgroundIsolateMain,
+        <Object>[port.sendPort, token],
+        debugName: 'BackgroundIsolatePool $index',
+      );
+      return await port.first as SendPort;
+    } finally {
+      port.close();
+    }
+  }
+
+  static void _backgroundIsolateMain(List<Object> arguments) {
+    PlatformDispatcher.instance.registerBackgroundIsolate(arguments[1] as RootIsolateToken);
+    final ReceivePort computationPort = ReceivePort();
+    computationPort.listen((Object? message) async {
+      final List<Object?> request = message! as List<Object?>;
+      final FutureOr<Object?> Function() computation =
+          request[0]! as FutureOr<Object?> Function();
+      final SendPort responsePort = request[1]! as SendPort;
+      try {
+        // A result that can't be sent makes send throw, and is reported like
+        // an error of the computation.
+        responsePort.send(<Object?>[await computation()]);
+      } catch (error, stackTrace) {
+        try {
+          responsePort.send(<Object?>[error, stackTrace.toString()]);
+        } catch (_) {
+          responsePort.send(<Object?>[
+            RemoteError(error.toString(), stackTrace.toString()),
+            stackTrace.toString(),
+          ]);
+        }
+      }
+    });
+    (arguments[0] as SendPort).send(computationPort.sendPort);
+  }
+}
+
 /// Platform event dispatcher singleton.
 ///
 /// The most basic interface to the host operating system's interface.
@@ -1576,6 +1689,12 @@ enum _FrameTimingInfo {
 
   /// The frame number of the frame.
   frameNumber,
+
+  /// The number of frames the engine dropped since the previous frame.
+  droppedFrameCount,
+
+  /// The time in microseconds the GPU spent executing the frame.
+  gpuDuration,
 }
 
 /// Time-related performance metrics of a frame.
@@ -1610,6 +1729,8 @@ class FrameTiming {
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
     int frameNumber = -1,
+    int droppedFrameCount = 0,
+    int gpuDuration = 0,
   }) {
     return FrameTiming._(<int>[
       vsyncStart,
@@ -1623,6 +1744,8 @@ class FrameTiming {
       pictureCacheCount,
       pictureCacheBytes,
       frameNumber,
+      droppedFrameCount,
+      gpuDuration,
     ]);
   }
 
@@ -1713,7 +1836,26 @@ class FrameTiming {
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
   /// The frame key associated with this frame measurement.
-  int get frameNumber => _data.last;
+  int get frameNumber => _rawInfo(_FrameTimingInfo.frameNumber);
+
+  /// The number of frames that were built but not rasterized since the
+  /// previous frame, because the engine dropped them in favor of a newer frame
+  /// while the GPU was busy with previous frames.
+  ///
+  /// Dropped frames are not reported to [PlatformDispatcher.onReportTimings]
+  /// themselves.
+  int get droppedFrameCount => _rawInfo(_FrameTimingInfo.droppedFrameCount);
+
+  /// The time the GPU spent executing the frame.
+  ///
+  /// Unlike [rasterDuration], which is the time the raster thread spent
+  /// recording and submitting the frame, this tells whether a frame that is
+  /// slow to rasterize is bound by the GPU.
+  ///
+  /// This is [Duration.zero] unless the engine measures GPU frame times, which
+  /// requires Impeller on Metal or Vulkan and the `--enable-gpu-frame-timing`
+  /// flag.
+  Duration get gpuDuration => Duration(microseconds: _rawInfo(_FrameTimingInfo.gpuDuration));
 
   final List<int> _data; // some elements in microseconds, some in bytes, some are counts
 
@@ -1729,7 +1871,7 @@ class FrameTiming {
         'layerCacheBytes: $layerCacheBytes, '
         'pictureCacheCount: $pictureCacheCount, '
         'pictureCacheBytes: $pictureCacheBytes, '
-        'frameNumber: ${_data.last})';
+        'frameNumber: $frameNumber)';
   }
 }
 
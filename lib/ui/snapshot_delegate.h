@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 #define FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 
+#include <functional>
 #include <string>
 
 #include "flutter/common/graphics/texture.h"
@@ -70,6 +71,22 @@ class SnapshotDelegate {
   virtual sk_sp<DlImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
                                             SkISize picture_size) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the display list like `MakeRasterSnapshot`, but
+  ///             without blocking the calling thread if the backend can render
+  ///             it concurrently with frames.
+  ///
+  ///             Must be called on the raster thread. `callback` is called
+  ///             exactly once, on an unspecified thread, possibly before this
+  ///             returns. Its image is null if the snapshot failed, and is
+  ///             otherwise not guaranteed to be UI thread safe, as with
+  ///             `MakeRasterSnapshot`.
+  ///
+  virtual void MakeRasterSnapshotAsync(
+      sk_sp<DisplayList> display_list,
+      SkISize picture_size,
+      std::function<void(sk_sp<DlImage>)> callback) = 0;
+
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
 };
 
@@ -2933,6 +2933,38 @@ abstract class Paragraph {
   /// The [ParagraphConstraints] control how wide the text is allowed to be.
   void layout(ParagraphConstraints constraints);
 
+  /// Lays out each of the [paragraphs] with the constraints at the same index
+  /// of [constraints], as if [layout] was called on each of them.
+  ///
+  /// The layouts of independent paragraphs, such as the cells of a table, run
+  /// in parallel on background threads, which is faster than laying them out
+  /// one after the other on devices with several cores. Returns once every
+  /// paragraph is laid out.
+  static void layoutBatch(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs.length == constraints.length);
+    final List<_NativeParagraph> nativeParagraphs = <_NativeParagraph>[];
+    final List<double> widths = <double>[];
+    for (int index = 0; index < paragraphs.length; index += 1) {
+      final Paragraph paragraph = paragraphs[index];
+      if (paragraph is _NativeParagraph) {
+        nativeParagraphs.add(paragraph);
+        widths.add(constraints[index].width);
+      } else {
+        paragraph.layout(constraints[index]);
+      }
+    }
+    if (nativeParagraphs.isEmpty) {
+      return;
+    }
+    _NativeParagraph._layoutBatch(nativeParagraphs, Float64List.fromList(widths));
+    assert(() {
+      for (final _NativeParagraph paragraph in nativeParagraphs) {
+        paragraph._needsLayout = false;
+      }
+      return true;
+    }());
+  }
+
   /// Returns a list of text boxes that enclose the given text range.
   ///
   /// The [boxHeightStyle] and [boxWidthStyle] parameters allow customization
@@ -3058,6 +3090,9 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Paragraph::layout', isLeaf: true)
   external void _layout(double width);
 
+  @Native<Void Function(Handle, Handle)>(symbol: 'Paragraph::layoutBatch')
+  external static void _layoutBatch(List<_NativeParagraph> paragraphs, Float64List widths);
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -3144,7 +3179,7 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   // Redirecting the paint function in this way solves some dependency problems
   // in the C++ code. If we straighten out the C++ dependencies, we can remove
   // this indirection.
-  @Native<Void Function(Pointer<Void>, Pointer<Void>, Double, Double)>(symbol: 'Paragraph::paint')
+  @Native<Void Function(Pointer<Void>, Pointer<Void>, Double, Double)>(symbol: 'Paragraph::paint', isLeaf: true)
   external void _paint(_NativeCanvas canvas, double x, double y);
 
   @override
@@ -3510,7 +3545,7 @@ base class _NativeParagraphBuilder extends NativeFieldWrapperClass1 implements P
     _placeholderScales.add(scale);
   }
 
-  @Native<Void Function(Pointer<Void>, Double, Double, Uint32, Double, Uint32)>(symbol: 'ParagraphBuilder::addPlaceholder')
+  @Native<Void Function(Pointer<Void>, Double, Double, Uint32, Double, Uint32)>(symbol: 'ParagraphBuilder::addPlaceholder', isLeaf: true)
   external void _addPlaceholder(double width, double height, int alignment, double baselineOffset, int baseline);
 
   @override
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 
+#include <optional>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -20,6 +21,78 @@ void MappingReleaseProc(const void* ptr, void* context) {
   delete reinterpret_cast<fml::Mapping*>(context);
 }
 
+constexpr uint32_t MakeTag(char a, char b, char c, char d) {
+  return (static_cast<uint32_t>(a) << 24) | (static_cast<uint32_t>(b) << 16) |
+         (static_cast<uint32_t>(c) << 8) | static_cast<uint32_t>(d);
+}
+
+bool ReadBigEndian(const fml::Mapping& mapping,
+                   size_t offset,
+                   size_t length,
+                   uint32_t* value) {
+  if (offset > mapping.GetSize() || length > mapping.GetSize() - offset) {
+    return false;
+  }
+  *value = 0;
+  for (size_t i = 0; i < length; i++) {
+    *value = (*value << 8) | mapping.GetMapping()[offset + i];
+  }
+  return true;
+}
+
+// Reads the style of the (first) font in |mapping| from its OS/2 table.
+//
+// Only the table directory and the OS/2 table are read, so unlike creating a
+// typeface, this pages in almost none of a memory-mapped font. The style is
+// the one FreeType reports for well formed fonts. Fonts without a usable OS/2
+// table are left to the typeface.
+std::optional<SkFontStyle> ReadFontStyle(const fml::Mapping& mapping) {
+  uint32_t font_offset = 0;
+  uint32_t tag;
+  if (!ReadBigEndian(mapping, 0, 4, &tag)) {
+    return std::nullopt;
+  }
+  if (tag == MakeTag('t', 't', 'c', 'f') &&
+      !ReadBigEndian(mapping, 12, 4, &font_offset)) {
+    return std::nullopt;
+  }
+
+  uint32_t table_count;
+  if (!ReadBigEndian(mapping, size_t{font_offset} + 4, 2, &table_count)) {
+    return std::nullopt;
+  }
+  for (uint32_t i = 0; i < table_count; i++) {
+    size_t record = size_t{font_offset} + 12 + 16 * size_t{i};
+    uint32_t table_offset;
+    if (!ReadBigEndian(mapping, record, 4, &tag) ||
+        !ReadBigEndian(mapping, record + 8, 4, &table_offset)) {
+      return std::nullopt;
+    }
+    if (tag != MakeTag('O', 'S', '/', '2')) {
+      continue;
+    }
+    uint32_t weight, width, selection;
+    size_t table = table_offset;
+    if (!ReadBigEndian(mapping, table + 4, 2, &weight) ||
+        !ReadBigEndian(mapping, table + 6, 2, &width) ||
+        !ReadBigEndian(mapping, table + 62, 2, &selection) ||
+        weight < SkFontStyle::kThin_Weight ||
+        weight > SkFontStyle::kExtraBlack_Weight ||
+        width < SkFontStyle::kUltraCondensed_Width ||
+        width > SkFontStyle::kUltraExpanded_Width) {
+      return std::nullopt;
+    }
+    SkFontStyle::Slant slant = SkFontStyle::kUpright_Slant;
+    if (selection & (1u << 9)) {
+      slant = SkFontStyle::kOblique_Slant;
+    } else if (selection & 1u) {
+      slant = SkFontStyle::kItalic_Slant;
+    }
+    return SkFontStyle(weight, width, slant);
+  }
+  return std::nullopt;
+}
+
 }  // anonymous namespace
 
 AssetManagerFontProvider::AssetManagerFontProvider(
@@ -86,9 +159,9 @@ void AssetManagerFontStyleSet::getStyle(int index,
                                         SkString* name) {
   FML_DCHECK(index < static_cast<int>(assets_.size()));
   if (style) {
-    sk_sp<SkTypeface> typeface(createTypeface(index));
-    if (typeface) {
-      *style = typeface->fontStyle();
+    std::optional<SkFontStyle> asset_style = GetAssetStyle(index);
+    if (asset_style.has_value()) {
+      *style = asset_style.value();
     }
   }
   if (name) {
@@ -102,6 +175,7 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
     return nullptr;
   }
 
+  std::scoped_lock lock(typeface_mutex_);
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
     std::unique_ptr<fml::Mapping> asset_mapping =
@@ -123,6 +197,7 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
                       << family_name_;
       return nullptr;
     }
+    asset.style = asset.typeface->fontStyle();
   }
 
   return CreateTypefaceRet(SkRef(asset.typeface.get()));
@@ -130,9 +205,41 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
 
 auto AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern)
     -> MatchStyleRet {
+  // The only font of a family is the best match for any style, so there is
+  // no need to look at its style.
+  if (assets_.size() == 1) {
+    return createTypeface(0);
+  }
   return matchStyleCSS3(pattern);
 }
 
+std::optional<SkFontStyle> AssetManagerFontStyleSet::GetAssetStyle(
+    size_t index) {
+  {
+    std::scoped_lock lock(typeface_mutex_);
+    TypefaceAsset& asset = assets_[index];
+    if (!asset.style.has_value() && !asset.typeface) {
+      // Matching a style looks at every font of the family, so reading the
+      // styles from the font files avoids creating typefaces for the fonts
+      // that are not used.
+      std::unique_ptr<fml::Mapping> asset_mapping =
+          asset_manager_->GetAsMapping(asset.asset);
+      if (asset_mapping != nullptr) {
+        asset.style = ReadFontStyle(*asset_mapping);
+      }
+    }
+    if (asset.style.has_value()) {
+      return asset.style;
+    }
+  }
+
+  sk_sp<SkTypeface> typeface(createTypeface(index));
+  if (!typeface) {
+    return std::nullopt;
+  }
+  return typeface->fontStyle();
+}
+
 AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(std::string a)
     : asset(std::move(a)) {}
 
@@ -6,6 +6,8 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -44,6 +46,10 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
   MatchStyleRet matchStyle(const SkFontStyle& pattern) override;
 
  private:
+  // The style of the font at |index|, read from the font file unless its
+  // typeface has already been created.
+  std::optional<SkFontStyle> GetAssetStyle(size_t index);
+
   std::shared_ptr<AssetManager> asset_manager_;
   std::string family_name_;
 
@@ -56,8 +62,12 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
 
     std::string asset;
     sk_sp<SkTypeface> typeface;
+    std::optional<SkFontStyle> style;
   };
   std::vector<TypefaceAsset> assets_;
+  // Guards the typefaces and styles, which are loaded on first use by
+  // whichever thread is matching fonts.
+  std::mutex typeface_mutex_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
 };
@@ -4,10 +4,17 @@
 
 #include "flutter/lib/ui/text/paragraph.h"
 
+#include <thread>
+#include <vector>
+
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/text/font_collection.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
+#include "flutter/third_party/txt/src/txt/paragraph_batch_layout.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -22,6 +29,36 @@ Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph)
 
 Paragraph::~Paragraph() = default;
 
+void Paragraph::layoutBatch(Dart_Handle paragraphs_handle,
+                            Dart_Handle widths_handle) {
+  std::vector<Paragraph*> paragraphs =
+      tonic::DartConverter<std::vector<Paragraph*>>::FromDart(
+          paragraphs_handle);
+  std::vector<txt::Paragraph*> txt_paragraphs;
+  std::vector<double> widths;
+  {
+    tonic::Float64List widths_list(widths_handle);
+    FML_DCHECK(static_cast<size_t>(widths_list.num_elements()) ==
+               paragraphs.size());
+    for (size_t i = 0; i < paragraphs.size(); i++) {
+      // Disposed paragraphs have nothing to lay out.
+      if (paragraphs[i] && paragraphs[i]->m_paragraph) {
+        txt_paragraphs.push_back(paragraphs[i]->m_paragraph.get());
+        widths.push_back(widths_list[i]);
+      }
+    }
+  }
+
+  UIDartState* state = UIDartState::Current();
+  FontCollection& font_collection =
+      state->platform_configuration()->client()->GetFontCollection();
+  // The concurrent message loop has as many workers as there are cores.
+  txt::LayoutParagraphs(txt_paragraphs, widths,
+                        *font_collection.GetFontCollection(),
+                        state->GetConcurrentTaskRunner(),
+                        std::thread::hardware_concurrency());
+}
+
 double Paragraph::width() {
   return m_paragraph->GetMaxWidth();
 }
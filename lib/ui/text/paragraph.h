@@ -27,6 +27,15 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
 
   ~Paragraph() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Lays out a list of paragraphs at the widths in a
+  ///             `Float64List` of the same length, concurrently on the workers
+  ///             of the concurrent message loop and the UI thread. Returns
+  ///             once all the paragraphs are laid out.
+  ///
+  static void layoutBatch(Dart_Handle paragraphs_handle,
+                          Dart_Handle widths_handle);
+
   double width();
   double height();
   double longestLine();
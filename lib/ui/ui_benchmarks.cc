@@ -4,12 +4,16 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/lib/ui/painting/image_encoding_png.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
 
 #include <future>
 
@@ -112,9 +116,43 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
   }
 }
 
+// Encodes a screenshot sized image with noise over a gradient, like a photo.
+// Encodes serially with Skia if the argument is 0, and in strips otherwise.
+static void BM_EncodePng(benchmark::State& state) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::Make(1440, 3120, kRGBA_8888_SkColorType,
+                                       kPremul_SkAlphaType));
+  uint32_t noise = 1;
+  for (int y = 0; y < bitmap.height(); y++) {
+    for (int x = 0; x < bitmap.width(); x++) {
+      noise = noise * 1103515245 + 12345;
+      uint8_t* rgba = static_cast<uint8_t*>(bitmap.getAddr(x, y));
+      rgba[0] = (x / 8 + (noise >> 28)) % 256;
+      rgba[1] = (y / 16 + (noise >> 29)) % 256;
+      rgba[2] = ((x + y) / 32) % 256;
+      rgba[3] = 0xff;
+    }
+  }
+  bitmap.setImmutable();
+  auto image = SkImages::RasterFromBitmap(bitmap);
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  const bool in_strips = state.range(0) != 0;
+
+  size_t encoded_size = 0;
+  while (state.KeepRunning()) {
+    auto data = in_strips ? EncodePngInStrips(image, loop->GetTaskRunner())
+                          : SkPngEncoder::Encode(nullptr, image.get(), {});
+    FML_CHECK(data);
+    encoded_size = data->size();
+  }
+  state.counters["EncodedBytes"] = encoded_size;
+}
+
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_EncodePng)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
 }  // namespace flutter
@@ -27,6 +27,33 @@ Dart_Handle ToByteData(const fml::Mapping& buffer) {
   return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
 }
 
+void MallocMappingFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<fml::MallocMapping*>(peer);
+}
+
+// Hands the data of a message to Dart. Large payloads are not copied: the
+// ByteData wraps the buffer of the message and frees it when it is collected.
+Dart_Handle ToExternalByteData(fml::MallocMapping&& data) {
+  const size_t size = data.GetSize();
+  if (size <= tonic::DartByteData::kExternalSizeThreshold) {
+    return ToByteData(data);
+  }
+  auto* peer = new fml::MallocMapping(std::move(data));
+  // The buffer was allocated by the message and is writable, so Dart can be
+  // given a mutable view of it like of the ByteData it would have copied to.
+  Dart_Handle byte_data = Dart_NewExternalTypedDataWithFinalizer(
+      /*type=*/Dart_TypedData_kByteData,
+      /*data=*/const_cast<uint8_t*>(peer->GetMapping()),
+      /*length=*/size,
+      /*peer=*/peer,
+      /*external_allocation_size=*/size,
+      /*callback=*/MallocMappingFinalizer);
+  if (Dart_IsError(byte_data)) {
+    delete peer;
+  }
+  return byte_data;
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -299,7 +326,8 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? ToExternalByteData(message->releaseData())
+                           : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -6,9 +6,12 @@
 
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/painting/vertices.h"
 #include "flutter/runtime/dart_vm.h"
@@ -332,5 +335,71 @@ TEST_F(PlatformConfigurationTest, SetDartPerformanceMode) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(PlatformConfigurationTest, DispatchesLargePlatformMessagesWithoutCopy) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  auto finish = [message_latch](Dart_NativeArguments args) {
+    message_latch->Signal();
+  };
+  AddNativeCallback("Finish", CREATE_NATIVE_ENTRY(finish));
+
+  // Larger than the payloads that are copied into the heap of the isolate.
+  constexpr size_t kMessageSize = 4 * 1024;
+  std::vector<uint8_t> payload(kMessageSize);
+  for (size_t i = 0; i < kMessageSize; i++) {
+    payload[i] = static_cast<uint8_t>(i);
+  }
+  auto data = fml::MallocMapping::Copy(payload.data(), payload.size());
+  const uint8_t* sent_data = data.GetMapping();
+
+  bool did_validate = false;
+  auto validate = [message_latch, &payload, sent_data,
+                   &did_validate](Dart_NativeArguments args) {
+    Dart_Handle byte_data = Dart_GetNativeArgument(args, 0);
+    Dart_TypedData_Type type;
+    void* received_data = nullptr;
+    intptr_t length = 0;
+    ASSERT_FALSE(Dart_IsError(Dart_TypedDataAcquireData(
+        byte_data, &type, &received_data, &length)));
+    // The ByteData wraps the buffer of the message.
+    EXPECT_EQ(received_data, sent_data);
+    EXPECT_EQ(static_cast<size_t>(length), payload.size());
+    EXPECT_EQ(memcmp(received_data, payload.data(), payload.size()), 0);
+    Dart_TypedDataReleaseData(byte_data);
+    did_validate = true;
+    message_latch->Signal();
+  };
+  AddNativeCallback("ValidateLargePlatformMessage",
+                    CREATE_NATIVE_ENTRY(validate));
+
+  Settings settings = CreateSettingsForFixture();
+
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint("receiveLargePlatformMessage");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  // Wait for the listener to be set.
+  message_latch->Wait();
+
+  SendPlatformMessage(shell.get(), std::make_unique<PlatformMessage>(
+                                       "test/large", std::move(data), nullptr));
+  message_latch->Wait();
+
+  ASSERT_TRUE(did_validate);
+  DestroyShell(std::move(shell), task_runners);
+}
+
 }  // namespace testing
 }  // namespace flutter
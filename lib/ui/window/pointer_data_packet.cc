@@ -33,4 +33,8 @@ size_t PointerDataPacket::GetLength() const {
   return data_.size() / sizeof(PointerData);
 }
 
+void PointerDataPacket::Append(const PointerDataPacket& packet) {
+  data_.insert(data_.end(), packet.data_.begin(), packet.data_.end());
+}
+
 }  // namespace flutter
@@ -22,6 +22,9 @@ class PointerDataPacket {
   void SetPointerData(size_t i, const PointerData& data);
   PointerData GetPointerData(size_t i) const;
   size_t GetLength() const;
+
+  // Adds the pointer data of |packet| after the pointer data of this packet.
+  void Append(const PointerDataPacket& packet);
   const std::vector<uint8_t>& data() const { return data_; }
 
  private:
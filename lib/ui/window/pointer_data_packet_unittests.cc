@@ -65,5 +65,26 @@ TEST(PointerDataPacketTest, CanGetLength) {
   ASSERT_EQ(packet->GetLength(), (size_t)6);
 }
 
+TEST(PointerDataPacketTest, CanAppendPacket) {
+  PointerData data;
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  CreateSimpleSimulatedPointerData(data, PointerData::Change::kMove, 1, 2.0,
+                                   3.0, 0);
+  packet->SetPointerData(0, data);
+  auto other = std::make_unique<PointerDataPacket>(2);
+  CreateSimpleSimulatedPointerData(data, PointerData::Change::kMove, 1, 4.0,
+                                   5.0, 0);
+  other->SetPointerData(0, data);
+  CreateSimpleSimulatedPointerData(data, PointerData::Change::kUp, 1, 6.0, 7.0,
+                                   0);
+  other->SetPointerData(1, data);
+
+  packet->Append(*other);
+  ASSERT_EQ(packet->GetLength(), (size_t)3);
+  ASSERT_EQ(packet->GetPointerData(0).physical_x, 2.0);
+  ASSERT_EQ(packet->GetPointerData(1).physical_x, 4.0);
+  ASSERT_EQ(packet->GetPointerData(2).change, PointerData::Change::kUp);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -97,6 +97,7 @@ abstract class Canvas {
   void drawParagraph(Paragraph paragraph, Offset offset);
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint);
   void drawRawPoints(PointMode pointMode, Float32List points, Paint paint);
+  void drawRawRects(Float32List rects, Int32List? colors, Paint paint);
 
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint);
   void drawAtlas(
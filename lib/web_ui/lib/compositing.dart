@@ -42,6 +42,7 @@ abstract class SceneBuilder {
   TransformEngineLayer pushTransform(
     Float64List matrix4, {
     TransformEngineLayer? oldLayer,
+    bool lateLatchPointer = false,
   });
   ClipRectEngineLayer pushClipRect(
     Rect rect, {
@@ -23,6 +23,17 @@ class RootIsolateToken {
   }
 }
 
+// There are no background isolates on the web, so computations run right
+// away on the main thread.
+abstract final class BackgroundIsolatePool {
+  static final int isolateCount = 0;
+
+  static Future<void> warmUp() => Future<void>.value();
+
+  static Future<R> run<R>(FutureOr<R> Function() computation) =>
+      Future<R>.sync(computation);
+}
+
 abstract class PlatformDispatcher {
   static PlatformDispatcher get instance => engine.EnginePlatformDispatcher.instance;
 
@@ -165,6 +176,8 @@ enum _FrameTimingInfo {
   pictureCacheCount,
   pictureCacheBytes,
   frameNumber,
+  droppedFrameCount,
+  gpuDuration,
 }
 
 class FrameTiming {
@@ -180,6 +193,8 @@ class FrameTiming {
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
     int frameNumber = 1,
+    int droppedFrameCount = 0,
+    int gpuDuration = 0,
   }) {
     return FrameTiming._(<int>[
       vsyncStart,
@@ -193,6 +208,8 @@ class FrameTiming {
       pictureCacheCount,
       pictureCacheBytes,
       frameNumber,
+      droppedFrameCount,
+      gpuDuration,
     ]);
   }
 
@@ -230,7 +247,11 @@ class FrameTiming {
 
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
-  int get frameNumber => _data.last;
+  int get frameNumber => _rawInfo(_FrameTimingInfo.frameNumber);
+
+  int get droppedFrameCount => _rawInfo(_FrameTimingInfo.droppedFrameCount);
+
+  Duration get gpuDuration => Duration(microseconds: _rawInfo(_FrameTimingInfo.gpuDuration));
 
   final List<int> _data;  // some elements in microseconds, some in bytes, some are counts
 
@@ -246,7 +267,7 @@ class FrameTiming {
         'layerCacheBytes: $layerCacheBytes, '
         'pictureCacheCount: $pictureCacheCount, '
         'pictureCacheBytes: $pictureCacheBytes, '
-        'frameNumber: ${_data.last})';
+        'frameNumber: $frameNumber)';
   }
 }
 
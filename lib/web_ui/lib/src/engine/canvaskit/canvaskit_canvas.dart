@@ -6,6 +6,7 @@ import 'dart:typed_data';
 
 import 'package:ui/ui.dart' as ui;
 
+import '../util.dart';
 import '../validators.dart';
 import '../vector_math.dart';
 import 'canvas.dart';
@@ -310,6 +311,11 @@ class CanvasKitCanvas implements ui.Canvas {
     );
   }
 
+  @override
+  void drawRawRects(Float32List rects, Int32List? colors, ui.Paint paint) {
+    drawRawRectsOneByOne(this, rects, colors, paint);
+  }
+
   @override
   void drawVertices(
       ui.Vertices vertices, ui.BlendMode blendMode, ui.Paint paint) {
@@ -428,6 +428,11 @@ class SurfaceCanvas implements ui.Canvas {
     _canvas.drawRawPoints(pointMode, points, paint as SurfacePaint);
   }
 
+  @override
+  void drawRawRects(Float32List rects, Int32List? colors, ui.Paint paint) {
+    drawRawRectsOneByOne(this, rects, colors, paint);
+  }
+
   @override
   void drawVertices(
       ui.Vertices vertices, ui.BlendMode blendMode, ui.Paint paint) {
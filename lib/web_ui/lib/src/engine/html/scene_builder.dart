@@ -102,6 +102,7 @@ class SurfaceSceneBuilder implements ui.SceneBuilder {
   ui.TransformEngineLayer pushTransform(
     Float64List matrix4, {
     ui.TransformEngineLayer? oldLayer,
+    bool lateLatchPointer = false,
   }) {
     if (matrix4.length != 16) {
       throw ArgumentError('"matrix4" must have 16 entries.');
@@ -221,7 +221,8 @@ class EngineSceneBuilder implements ui.SceneBuilder {
   @override
   ui.TransformEngineLayer pushTransform(
     Float64List matrix4, {
-    ui.TransformEngineLayer? oldLayer
+    ui.TransformEngineLayer? oldLayer,
+    bool lateLatchPointer = false,
   }) => pushLayer<TransformLayer>(
       TransformLayer(),
       TransformOperation(matrix4),
@@ -289,6 +289,10 @@ class SkwasmCanvas implements SceneCanvas {
     );
   });
 
+  @override
+  void drawRawRects(Float32List rects, Int32List? colors, ui.Paint paint) =>
+    drawRawRectsOneByOne(this, rects, colors, paint);
+
   @override
   void drawVertices(
     ui.Vertices vertices,
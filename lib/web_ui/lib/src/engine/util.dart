@@ -333,6 +333,35 @@ bool rectContainsOther(ui.Rect rect, ui.Rect other) {
       rect.bottom >= other.bottom;
 }
 
+/// Implements [ui.Canvas.drawRawRects] by drawing each rectangle with
+/// [ui.Canvas.drawRect].
+///
+/// The color of [paint] is changed for each rectangle that has a color in
+/// [colors], and is restored before returning.
+void drawRawRectsOneByOne(
+    ui.Canvas canvas, Float32List rects, Int32List? colors, ui.Paint paint) {
+  if (rects.length % 4 != 0) {
+    throw ArgumentError('"rects" length must be a multiple of four.');
+  }
+  if (colors != null && colors.length * 4 != rects.length) {
+    throw ArgumentError(
+        'If non-null, "colors" length must be one fourth the length of "rects".');
+  }
+  final ui.Color color = paint.color;
+  try {
+    for (int i = 0; i < rects.length; i += 4) {
+      if (colors != null) {
+        paint.color = ui.Color(colors[i ~/ 4]);
+      }
+      canvas.drawRect(
+          ui.Rect.fromLTRB(rects[i], rects[i + 1], rects[i + 2], rects[i + 3]),
+          paint);
+    }
+  } finally {
+    paint.color = color;
+  }
+}
+
 extension CssColor on ui.Color {
   /// Converts color to a css compatible attribute value.
   String toCssString() {
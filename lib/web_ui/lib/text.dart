@@ -687,6 +687,13 @@ abstract class Paragraph {
   double get ideographicBaseline;
   bool get didExceedMaxLines;
   void layout(ParagraphConstraints constraints);
+  static void layoutBatch(
+      List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs.length == constraints.length);
+    for (int index = 0; index < paragraphs.length; index += 1) {
+      paragraphs[index].layout(constraints[index]);
+    }
+  }
   List<TextBox> getBoxesForRange(int start, int end,
       {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight,
       BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight});
@@ -75,12 +75,14 @@ mergeInto(LibraryManager.library, {
     _skwasm_captureImageBitmap = async function(surfaceHandle, contextHandle, callbackId, width, height) {
       const canvas = handleToCanvasMap.get(contextHandle);
       const imageBitmap = await createImageBitmap(canvas, 0, 0, width, height);
+      // Transfer the bitmap instead of cloning it, so the main thread takes
+      // ownership of the rendered pixels without a copy.
       postMessage({
         skwasmMessage: 'onRenderComplete',
         surface: surfaceHandle,
         callbackId,
         imageBitmap,
-      });
+      }, [imageBitmap]);
     };
     _skwasm_createGlTextureFromTextureSource = function(textureSource, width, height) {
       const glCtx = GL.currentContext.GLctx;
@@ -125,6 +125,9 @@ class StubSceneCanvas implements SceneCanvas {
   @override
   void drawRawPoints(ui.PointMode pointMode, Float32List points, ui.Paint paint) {}
 
+  @override
+  void drawRawRects(Float32List rects, Int32List? colors, ui.Paint paint) {}
+
   @override
   void drawRect(ui.Rect rect, ui.Paint paint) {}
 
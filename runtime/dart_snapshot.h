@@ -160,6 +160,23 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///
   const uint8_t* GetInstructionsMapping() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the size of the heap snapshot mapping.
+  ///
+  /// @return     The size of the data mapping, or 0 if there is no mapping or
+  ///             its size is unknown, which is the case for snapshots that
+  ///             are resolved as symbols.
+  ///
+  size_t GetDataSize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the size of the instructions snapshot mapping.
+  ///
+  /// @return     The size of the instructions mapping, or 0 if there is no
+  ///             mapping or its size is unknown.
+  ///
+  size_t GetInstructionsSize() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Returns whether both the data and instructions mappings are
   ///             safe to use with madvise(DONTNEED).
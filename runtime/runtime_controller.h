@@ -552,7 +552,7 @@ class RuntimeController : public PlatformConfigurationClient {
   /// @param[in]  snapshot_data    Dart snapshot instructions of the loading
   ///                              unit's shared library.
   ///
-  void LoadDartDeferredLibrary(
+  virtual void LoadDartDeferredLibrary(
       intptr_t loading_unit_id,
       std::unique_ptr<const fml::Mapping> snapshot_data,
       std::unique_ptr<const fml::Mapping> snapshot_instructions);
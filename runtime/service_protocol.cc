@@ -34,9 +34,17 @@ const std::string_view ServiceProtocol::kGetDisplayRefreshRateExtensionName =
     "_flutter.getDisplayRefreshRate";
 const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
     "_flutter.getSkSLs";
+const std::string_view ServiceProtocol::kGetStartupMetricsExtensionName =
+    "_flutter.getStartupMetrics";
+const std::string_view ServiceProtocol::kGetFrameCostLedgerExtensionName =
+    "_flutter.getFrameCostLedger";
+const std::string_view ServiceProtocol::kGetFrameStatisticsExtensionName =
+    "_flutter.getFrameStatistics";
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view ServiceProtocol::kGetImpellerCaptureExtensionName =
+    "_flutter.getImpellerCapture";
 const std::string_view
     ServiceProtocol::kRenderFrameWithRasterStatsExtensionName =
         "_flutter.renderFrameWithRasterStats";
@@ -60,7 +68,11 @@ ServiceProtocol::ServiceProtocol()
           kSetAssetBundlePathExtensionName,
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
+          kGetStartupMetricsExtensionName,
+          kGetFrameCostLedgerExtensionName,
+          kGetFrameStatisticsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetImpellerCaptureExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
       }),
@@ -28,7 +28,11 @@ class ServiceProtocol {
   static const std::string_view kSetAssetBundlePathExtensionName;
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
+  static const std::string_view kGetStartupMetricsExtensionName;
+  static const std::string_view kGetFrameCostLedgerExtensionName;
+  static const std::string_view kGetFrameStatisticsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kGetImpellerCaptureExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
   static const std::string_view kReloadAssetFonts;
 
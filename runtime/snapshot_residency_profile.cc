@@ -0,0 +1,349 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_residency_profile.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <sstream>
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+#if FML_OS_LINUX || FML_OS_ANDROID
+#define FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+
+namespace flutter {
+
+namespace {
+
+constexpr char kProfileMagic[] = "flutter_snapshot_residency";
+constexpr int kProfileVersion = 1;
+
+size_t GetPageSize() {
+#if FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  return page_size;
+#else
+  return 4096u;
+#endif  // FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+}
+
+#if FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+// Returns the end of the memory mapping that contains |address|, or 0.
+uintptr_t GetMappingEnd(uintptr_t address) {
+  FILE* maps = ::fopen("/proc/self/maps", "r");
+  if (maps == nullptr) {
+    return 0;
+  }
+  uintptr_t end = 0;
+  char line[512];
+  while (::fgets(line, sizeof(line), maps) != nullptr) {
+    uintptr_t mapping_start = 0;
+    uintptr_t mapping_end = 0;
+    if (std::sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &mapping_start,
+                    &mapping_end) == 2 &&
+        address >= mapping_start && address < mapping_end) {
+      end = mapping_end;
+      break;
+    }
+  }
+  ::fclose(maps);
+  return end;
+}
+#endif  // FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+
+// Computes the page aligned extent of |region|.
+bool GetPageSpan(const SnapshotResidencyProfile::Region& region,
+                 uintptr_t* first_page,
+                 size_t* page_count) {
+#if FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  if (region.data == nullptr) {
+    return false;
+  }
+  const size_t page_size = GetPageSize();
+  const uintptr_t start = reinterpret_cast<uintptr_t>(region.data);
+  uintptr_t end = start + region.size;
+  if (region.size == 0) {
+    end = GetMappingEnd(start);
+    if (end <= start) {
+      return false;
+    }
+  }
+  *first_page = start / page_size * page_size;
+  *page_count = (end - *first_page + page_size - 1) / page_size;
+  return true;
+#else
+  return false;
+#endif  // FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+}
+
+size_t Advise(uintptr_t first_page, size_t page_count, int advice) {
+#if FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  if (page_count == 0) {
+    return 0;
+  }
+  if (::madvise(reinterpret_cast<void*>(first_page),
+                page_count * GetPageSize(), advice) != 0) {
+    FML_DLOG(WARNING) << "madvise on snapshot pages failed.";
+    return 0;
+  }
+  return page_count;
+#else
+  return 0;
+#endif  // FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+}
+
+}  // namespace
+
+std::vector<SnapshotResidencyProfile::Region>
+SnapshotResidencyProfile::GetRegions(const DartSnapshot& vm_snapshot,
+                                     const DartSnapshot* isolate_snapshot) {
+  std::vector<Region> regions;
+  auto add_snapshot = [&regions](const std::string& name,
+                                 const DartSnapshot& snapshot) {
+    if (snapshot.GetDataMapping() != nullptr) {
+      regions.push_back({
+          .name = name + ".data",
+          .data = snapshot.GetDataMapping(),
+          .size = snapshot.GetDataSize(),
+      });
+    }
+    if (snapshot.GetInstructionsMapping() != nullptr) {
+      regions.push_back({
+          .name = name + ".instructions",
+          .data = snapshot.GetInstructionsMapping(),
+          .size = snapshot.GetInstructionsSize(),
+      });
+    }
+  };
+  add_snapshot("vm", vm_snapshot);
+  if (isolate_snapshot != nullptr) {
+    add_snapshot("isolate", *isolate_snapshot);
+  }
+  return regions;
+}
+
+std::unique_ptr<SnapshotResidencyProfile> SnapshotResidencyProfile::Record(
+    const std::vector<Region>& regions) {
+  TRACE_EVENT0("flutter", "SnapshotResidencyProfile::Record");
+  auto profile = std::make_unique<SnapshotResidencyProfile>();
+#if FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  for (const auto& region : regions) {
+    uintptr_t first_page = 0;
+    size_t page_count = 0;
+    if (!GetPageSpan(region, &first_page, &page_count)) {
+      continue;
+    }
+    std::vector<unsigned char> residency(page_count);
+    if (::mincore(reinterpret_cast<void*>(first_page),
+                  page_count * GetPageSize(), residency.data()) != 0) {
+      FML_LOG(ERROR) << "Could not sample the residency of " << region.name;
+      continue;
+    }
+    RecordedRegion recorded;
+    recorded.page_count = page_count;
+    for (size_t page = 0; page < page_count; page++) {
+      if ((residency[page] & 1) == 0) {
+        continue;
+      }
+      if (!recorded.resident_pages.empty() &&
+          recorded.resident_pages.back().first_page +
+                  recorded.resident_pages.back().page_count ==
+              page) {
+        recorded.resident_pages.back().page_count++;
+      } else {
+        recorded.resident_pages.push_back({page, 1});
+      }
+    }
+    profile->regions_[region.name] = std::move(recorded);
+  }
+#endif  // FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  return profile;
+}
+
+void SnapshotResidencyProfile::DisableReadAhead(
+    const std::vector<Region>& regions) {
+#if FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  for (const auto& region : regions) {
+    uintptr_t first_page = 0;
+    size_t page_count = 0;
+    if (GetPageSpan(region, &first_page, &page_count)) {
+      Advise(first_page, page_count, MADV_RANDOM);
+    }
+  }
+#endif  // FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+}
+
+std::unique_ptr<SnapshotResidencyProfile> SnapshotResidencyProfile::Parse(
+    std::string_view profile_data) {
+  std::istringstream stream{std::string(profile_data)};
+  std::string magic;
+  int version = 0;
+  std::string page_size_key;
+  size_t page_size = 0;
+  if (!(stream >> magic >> version >> page_size_key >> page_size) ||
+      magic != kProfileMagic || version != kProfileVersion ||
+      page_size_key != "page_size") {
+    FML_LOG(ERROR) << "Malformed snapshot residency profile.";
+    return nullptr;
+  }
+  if (page_size != GetPageSize()) {
+    FML_LOG(ERROR) << "The snapshot residency profile was recorded with a "
+                      "different page size.";
+    return nullptr;
+  }
+
+  auto profile = std::make_unique<SnapshotResidencyProfile>();
+  std::string region_key;
+  while (stream >> region_key) {
+    std::string name;
+    RecordedRegion region;
+    size_t range_count = 0;
+    if (region_key != "region" ||
+        !(stream >> name >> region.page_count >> range_count)) {
+      FML_LOG(ERROR) << "Malformed snapshot residency profile.";
+      return nullptr;
+    }
+    size_t next_page = 0;
+    for (size_t i = 0; i < range_count; i++) {
+      PageRange range;
+      if (!(stream >> range.first_page >> range.page_count) ||
+          range.first_page < next_page || range.page_count == 0 ||
+          range.page_count > region.page_count ||
+          range.first_page > region.page_count - range.page_count) {
+        FML_LOG(ERROR) << "Malformed snapshot residency profile.";
+        return nullptr;
+      }
+      next_page = range.first_page + range.page_count;
+      region.resident_pages.push_back(range);
+    }
+    profile->regions_[name] = std::move(region);
+  }
+  return profile;
+}
+
+SnapshotResidencyProfile::SnapshotResidencyProfile()
+    : page_size_(GetPageSize()) {}
+
+SnapshotResidencyProfile::~SnapshotResidencyProfile() = default;
+
+std::string SnapshotResidencyProfile::Serialize() const {
+  std::ostringstream stream;
+  stream << kProfileMagic << " " << kProfileVersion << "\n";
+  stream << "page_size " << page_size_ << "\n";
+  for (const auto& [name, region] : regions_) {
+    stream << "region " << name << " " << region.page_count << " "
+           << region.resident_pages.size() << "\n";
+    for (const auto& range : region.resident_pages) {
+      stream << range.first_page << " " << range.page_count << "\n";
+    }
+  }
+  return stream.str();
+}
+
+std::vector<SnapshotResidencyProfile::PageRange>
+SnapshotResidencyProfile::GetResidentPages(const std::string& name) const {
+  auto found = regions_.find(name);
+  if (found == regions_.end()) {
+    return {};
+  }
+  return found->second.resident_pages;
+}
+
+const SnapshotResidencyProfile::RecordedRegion*
+SnapshotResidencyProfile::FindRecordedRegion(const Region& region,
+                                             uintptr_t* first_page) const {
+  auto found = regions_.find(region.name);
+  if (found == regions_.end()) {
+    return nullptr;
+  }
+  size_t page_count = 0;
+  if (!GetPageSpan(region, first_page, &page_count)) {
+    return nullptr;
+  }
+  if (page_count != found->second.page_count) {
+    FML_LOG(INFO) << "Ignoring the stale snapshot residency profile of "
+                  << region.name;
+    return nullptr;
+  }
+  return &found->second;
+}
+
+size_t SnapshotResidencyProfile::Prefetch(
+    const std::vector<Region>& regions) const {
+  TRACE_EVENT0("flutter", "SnapshotResidencyProfile::Prefetch");
+  size_t prefetched_pages = 0;
+#if FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  for (const auto& region : regions) {
+    uintptr_t first_page = 0;
+    const RecordedRegion* recorded = FindRecordedRegion(region, &first_page);
+    if (recorded == nullptr) {
+      continue;
+    }
+    for (const auto& range : recorded->resident_pages) {
+      prefetched_pages +=
+          Advise(first_page + range.first_page * page_size_, range.page_count,
+                 MADV_WILLNEED);
+    }
+  }
+#endif  // FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  return prefetched_pages;
+}
+
+size_t SnapshotResidencyProfile::ReleaseColdPages(
+    const std::vector<Region>& regions) const {
+  TRACE_EVENT0("flutter", "SnapshotResidencyProfile::ReleaseColdPages");
+  size_t released_pages = 0;
+#if FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  // Regions can share pages, for example when the snapshots are symbols of
+  // the same library, so hot pages are collected across all regions first.
+  std::vector<std::pair<uintptr_t, uintptr_t>> hot_pages;
+  std::vector<std::pair<uintptr_t, uintptr_t>> spans;
+  for (const auto& region : regions) {
+    uintptr_t first_page = 0;
+    const RecordedRegion* recorded = FindRecordedRegion(region, &first_page);
+    if (recorded == nullptr) {
+      continue;
+    }
+    spans.emplace_back(first_page,
+                       first_page + recorded->page_count * page_size_);
+    for (const auto& range : recorded->resident_pages) {
+      const uintptr_t start = first_page + range.first_page * page_size_;
+      hot_pages.emplace_back(start, start + range.page_count * page_size_);
+    }
+  }
+  std::sort(hot_pages.begin(), hot_pages.end());
+
+  for (const auto& [span_start, span_end] : spans) {
+    uintptr_t cold_start = span_start;
+    for (const auto& [hot_start, hot_end] : hot_pages) {
+      if (hot_end <= cold_start) {
+        continue;
+      }
+      if (hot_start >= span_end) {
+        break;
+      }
+      if (hot_start > cold_start) {
+        released_pages += Advise(
+            cold_start, (hot_start - cold_start) / page_size_, MADV_DONTNEED);
+      }
+      cold_start = std::max(cold_start, hot_end);
+    }
+    if (cold_start < span_end) {
+      released_pages += Advise(cold_start, (span_end - cold_start) / page_size_,
+                               MADV_DONTNEED);
+    }
+  }
+#endif  // FLUTTER_SNAPSHOT_RESIDENCY_SUPPORTED
+  return released_pages;
+}
+
+}  // namespace flutter
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_RESIDENCY_PROFILE_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_RESIDENCY_PROFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/runtime/dart_snapshot.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The pages of the Dart snapshots that were resident at the end
+///             of the startup of a profiling run, like an order file for the
+///             snapshot mappings.
+///
+///             On later launches, the recorded pages are read ahead with
+///             madvise(WILLNEED) before the VM touches them, and once the
+///             first frame is rasterized the pages that were not needed are
+///             released with madvise(DONTNEED).
+///
+///             Residency is sampled with mincore, which reports the pages in
+///             the page cache. Read-ahead should therefore be disabled with
+///             |DisableReadAhead| during the profiling run, which should also
+///             start with a cold page cache, for example right after a
+///             reboot.
+///
+///             Only supported on Linux and Android, where the extents of
+///             snapshots that are resolved as symbols can be looked up. All
+///             operations are no-ops elsewhere.
+///
+class SnapshotResidencyProfile {
+ public:
+  /// A snapshot mapping in the current process.
+  struct Region {
+    std::string name;
+    const uint8_t* data = nullptr;
+    /// The size of the mapping, or 0 if unknown. The region then extends to
+    /// the end of the memory mapping that contains |data|.
+    size_t size = 0;
+  };
+
+  struct PageRange {
+    size_t first_page = 0;
+    size_t page_count = 0;
+
+    bool operator==(const PageRange& other) const {
+      return first_page == other.first_page && page_count == other.page_count;
+    }
+  };
+
+  /// The regions of the data and instructions of the VM and isolate
+  /// snapshots.
+  static std::vector<Region> GetRegions(const DartSnapshot& vm_snapshot,
+                                        const DartSnapshot* isolate_snapshot);
+
+  /// Records the pages of |regions| that are currently resident.
+  static std::unique_ptr<SnapshotResidencyProfile> Record(
+      const std::vector<Region>& regions);
+
+  /// Disables read-ahead on |regions|, so that only the pages that are
+  /// touched become resident.
+  static void DisableReadAhead(const std::vector<Region>& regions);
+
+  /// Parses a profile written by |Serialize|. Returns nullptr if the profile
+  /// is malformed or was recorded with a different page size.
+  static std::unique_ptr<SnapshotResidencyProfile> Parse(
+      std::string_view profile);
+
+  SnapshotResidencyProfile();
+
+  ~SnapshotResidencyProfile();
+
+  std::string Serialize() const;
+
+  /// The resident pages of the region with |name|, relative to the page
+  /// that contains the start of the region. Empty if the profile has no such
+  /// region.
+  std::vector<PageRange> GetResidentPages(const std::string& name) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads ahead the recorded pages of |regions|. Regions whose
+  ///             size changed since the profile was recorded are skipped.
+  ///
+  /// @return     The number of pages that were read ahead.
+  ///
+  size_t Prefetch(const std::vector<Region>& regions) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the pages of |regions| that were not resident
+  ///             when the profile was recorded. The caller must make sure
+  ///             that the regions are safe to use with madvise(DONTNEED).
+  ///             Regions whose size changed since the profile was recorded
+  ///             are skipped. Pages that are shared with a recorded page of
+  ///             another region are kept.
+  ///
+  /// @return     The number of pages that were released.
+  ///
+  size_t ReleaseColdPages(const std::vector<Region>& regions) const;
+
+ private:
+  struct RecordedRegion {
+    size_t page_count = 0;
+    std::vector<PageRange> resident_pages;
+  };
+
+  size_t page_size_;
+  std::map<std::string, RecordedRegion> regions_;
+
+  // Returns the recorded region of |region| if its page count still
+  // matches, and the address of its first page.
+  const RecordedRegion* FindRecordedRegion(const Region& region,
+                                           uintptr_t* first_page) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SnapshotResidencyProfile);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_RESIDENCY_PROFILE_H_
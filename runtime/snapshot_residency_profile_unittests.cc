@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_residency_profile.h"
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/testing/testing.h"
+
+#if FML_OS_LINUX || FML_OS_ANDROID
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+
+namespace flutter {
+namespace testing {
+
+using PageRange = SnapshotResidencyProfile::PageRange;
+
+TEST(SnapshotResidencyProfileTest, RejectsMalformedProfiles) {
+  EXPECT_FALSE(SnapshotResidencyProfile::Parse(""));
+  EXPECT_FALSE(SnapshotResidencyProfile::Parse("flutter_snapshot_residency 2"));
+  EXPECT_FALSE(SnapshotResidencyProfile::Parse(
+      "flutter_snapshot_residency 1\npage_size 12345\n"));
+
+  SnapshotResidencyProfile empty;
+  const std::string header = empty.Serialize();
+  EXPECT_TRUE(SnapshotResidencyProfile::Parse(header));
+  EXPECT_TRUE(
+      SnapshotResidencyProfile::Parse(header + "region vm.data 4 1\n0 4\n"));
+  // Out of bounds.
+  EXPECT_FALSE(
+      SnapshotResidencyProfile::Parse(header + "region vm.data 4 1\n2 3\n"));
+  // Unsorted.
+  EXPECT_FALSE(SnapshotResidencyProfile::Parse(
+      header + "region vm.data 4 2\n2 1\n0 1\n"));
+  // Truncated.
+  EXPECT_FALSE(
+      SnapshotResidencyProfile::Parse(header + "region vm.data 4 2\n0 1\n"));
+}
+
+#if FML_OS_LINUX || FML_OS_ANDROID
+
+namespace {
+// Anonymous memory whose pages only become resident once they are touched.
+class TestRegion {
+ public:
+  explicit TestRegion(size_t page_count)
+      : page_size_(::sysconf(_SC_PAGESIZE)), size_(page_count * page_size_) {
+    data_ = static_cast<uint8_t*>(::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    FML_CHECK(data_ != MAP_FAILED);
+  }
+
+  ~TestRegion() { ::munmap(data_, size_); }
+
+  void TouchPage(size_t page) { data_[page * page_size_] = 1; }
+
+  SnapshotResidencyProfile::Region GetRegion(const std::string& name) const {
+    return {.name = name, .data = data_, .size = size_};
+  }
+
+ private:
+  const size_t page_size_;
+  const size_t size_;
+  uint8_t* data_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TestRegion);
+};
+}  // namespace
+
+TEST(SnapshotResidencyProfileTest, RecordsResidentPages) {
+  TestRegion data(8);
+  TestRegion instructions(4);
+  data.TouchPage(0);
+  data.TouchPage(5);
+  data.TouchPage(6);
+  const std::vector<SnapshotResidencyProfile::Region> regions = {
+      data.GetRegion("vm.data"), instructions.GetRegion("vm.instructions")};
+
+  auto profile = SnapshotResidencyProfile::Record(regions);
+  ASSERT_TRUE(profile);
+  EXPECT_EQ(profile->GetResidentPages("vm.data"),
+            (std::vector<PageRange>{{0, 1}, {5, 2}}));
+  EXPECT_TRUE(profile->GetResidentPages("vm.instructions").empty());
+  EXPECT_TRUE(profile->GetResidentPages("isolate.data").empty());
+
+  auto parsed = SnapshotResidencyProfile::Parse(profile->Serialize());
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->Serialize(), profile->Serialize());
+  EXPECT_EQ(parsed->Prefetch(regions), 3u);
+}
+
+TEST(SnapshotResidencyProfileTest, ReleasesColdPages) {
+  TestRegion data(8);
+  data.TouchPage(2);
+  auto profile = SnapshotResidencyProfile::Record({data.GetRegion("vm.data")});
+  ASSERT_TRUE(profile);
+
+  // Pages that are touched after the profile was recorded are cold.
+  data.TouchPage(4);
+  EXPECT_EQ(profile->ReleaseColdPages({data.GetRegion("vm.data")}), 7u);
+  auto resident = SnapshotResidencyProfile::Record({data.GetRegion("vm.data")});
+  EXPECT_EQ(resident->GetResidentPages("vm.data"),
+            (std::vector<PageRange>{{2, 1}}));
+}
+
+TEST(SnapshotResidencyProfileTest, IgnoresRegionsThatChanged) {
+  TestRegion data(8);
+  TestRegion larger(16);
+  data.TouchPage(0);
+  auto profile = SnapshotResidencyProfile::Record({data.GetRegion("vm.data")});
+  ASSERT_TRUE(profile);
+
+  EXPECT_EQ(profile->Prefetch({larger.GetRegion("vm.data")}), 0u);
+  EXPECT_EQ(profile->ReleaseColdPages({larger.GetRegion("vm.data")}), 0u);
+}
+
+#endif  // FML_OS_LINUX || FML_OS_ANDROID
+
+}  // namespace testing
+}  // namespace flutter
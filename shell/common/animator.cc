@@ -5,8 +5,10 @@
 #include "flutter/shell/common/animator.h"
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/pipeline_depth_controller.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 namespace flutter {
@@ -19,6 +21,24 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+std::shared_ptr<LayerTreePipeline> CreateLayerTreePipeline(
+    const TaskRunners& task_runners) {
+#if SHELL_ENABLE_METAL
+  return std::make_shared<LayerTreePipeline>(
+      2, PipelineDepthController::kMaxDepth);
+#else   // SHELL_ENABLE_METAL
+  // TODO(dnfield): We should remove this logic and set the pipeline depth
+  // back to 2 in this case. See
+  // https://github.com/flutter/engine/pull/9132 for discussion.
+  if (task_runners.GetPlatformTaskRunner() ==
+      task_runners.GetRasterTaskRunner()) {
+    return std::make_shared<LayerTreePipeline>(1);
+  }
+  return std::make_shared<LayerTreePipeline>(
+      2, PipelineDepthController::kMaxDepth);
+#endif  // SHELL_ENABLE_METAL
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
@@ -27,18 +47,7 @@ Animator::Animator(Delegate& delegate,
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
-#if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(2)),
-#else   // SHELL_ENABLE_METAL
-      // TODO(dnfield): We should remove this logic and set the pipeline depth
-      // back to 2 in this case. See
-      // https://github.com/flutter/engine/pull/9132 for discussion.
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(
-          task_runners.GetPlatformTaskRunner() ==
-                  task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
-#endif  // SHELL_ENABLE_METAL
+      layer_tree_pipeline_(CreateLayerTreePipeline(task_runners)),
       pending_frame_semaphore_(1),
       weak_factory_(this) {
 }
@@ -185,6 +194,11 @@ const std::weak_ptr<VsyncWaiter> Animator::GetVsyncWaiter() const {
   return weak;
 }
 
+void Animator::SetFrameStartPredictor(
+    std::shared_ptr<const FrameStartPredictor> predictor) {
+  frame_start_predictor_ = std::move(predictor);
+}
+
 bool Animator::CanReuseLastLayerTree() {
   return !regenerate_layer_tree_;
 }
@@ -245,11 +259,7 @@ void Animator::AwaitVSync() {
       [self = weak_factory_.GetWeakPtr()](
           std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
         if (self) {
-          if (self->CanReuseLastLayerTree()) {
-            self->DrawLastLayerTree(std::move(frame_timings_recorder));
-          } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
-          }
+          self->OnVsync(std::move(frame_timings_recorder));
         }
       });
   if (has_rendered_) {
@@ -257,6 +267,38 @@ void Animator::AwaitVSync() {
   }
 }
 
+void Animator::OnVsync(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  if (CanReuseLastLayerTree()) {
+    DrawLastLayerTree(std::move(frame_timings_recorder));
+    return;
+  }
+
+  if (frame_start_predictor_) {
+    const fml::TimePoint vsync_start =
+        frame_timings_recorder->GetVsyncStartTime();
+    const fml::TimeDelta delay = frame_start_predictor_->GetStartDelay(
+        vsync_start, frame_timings_recorder->GetVsyncTargetTime());
+    if (delay > fml::TimeDelta::Zero() &&
+        vsync_start + delay > fml::TimePoint::Now()) {
+      // Let the input that arrives in the meantime into this frame.
+      TRACE_EVENT0("flutter", "Animator::DelayFrameStart");
+      task_runners_.GetUITaskRunner()->PostTaskForTime(
+          fml::MakeCopyable(
+              [self = weak_factory_.GetWeakPtr(),
+               recorder = std::move(frame_timings_recorder)]() mutable {
+                if (self) {
+                  self->BeginFrame(std::move(recorder));
+                }
+              }),
+          vsync_start + delay);
+      return;
+    }
+  }
+
+  BeginFrame(std::move(frame_timings_recorder));
+}
+
 void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
                                               const fml::closure& callback) {
   waiter_->ScheduleSecondaryCallback(id, callback);
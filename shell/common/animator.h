@@ -13,6 +13,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_start_predictor.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -59,6 +60,14 @@ class Animator final {
 
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
 
+  //--------------------------------------------------------------------------
+  /// @brief    Delays the start of building frames after vsync by the delay
+  ///           that |predictor| returns, so that frames are built from more
+  ///           recent input. Frames are built at vsync if no predictor is
+  ///           set.
+  void SetFrameStartPredictor(
+      std::shared_ptr<const FrameStartPredictor> predictor);
+
   //--------------------------------------------------------------------------
   /// @brief    Schedule a secondary callback to be executed right after the
   ///           main `VsyncWaiter::AsyncWaitForVsync` callback (which is added
@@ -92,12 +101,15 @@ class Animator final {
 
   void AwaitVSync();
 
+  void OnVsync(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
   void ScheduleMaybeClearTraceFlowIds();
 
   Delegate& delegate_;
   TaskRunners task_runners_;
   std::shared_ptr<VsyncWaiter> waiter_;
+  std::shared_ptr<const FrameStartPredictor> frame_start_predictor_;
 
   std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder_;
   uint64_t frame_request_number_ = 1;
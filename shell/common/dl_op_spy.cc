@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/dl_op_spy.h"
 
+#include "flutter/display_list/dl_inline_dispatch.h"
+
 namespace flutter {
 
 bool DlOpSpy::did_draw() {
@@ -119,7 +121,7 @@ void DlOpSpy::drawDisplayList(const sk_sp<DisplayList> display_list,
     return;
   }
   DlOpSpy receiver;
-  display_list->Dispatch(receiver);
+  display_list->DispatchInline(receiver);
   did_draw_ |= receiver.did_draw();
 }
 void DlOpSpy::drawTextBlob(const sk_sp<SkTextBlob> blob,
@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/settings.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
@@ -57,9 +58,19 @@ Engine::Engine(
                                         std::move(image_decoder_task_runner),
                                         std::move(io_manager),
                                         gpu_disabled_switch)),
+      idle_task_scheduler_([] {
+        return fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros());
+      }),
       task_runners_(task_runners),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
+  // One loading unit per idle period, as the embedder does the loading on
+  // its own time.
+  idle_task_scheduler_.AddTask("PrefetchDartDeferredLibrary",
+                               [this](fml::TimeDelta deadline) {
+                                 PrefetchNextDartDeferredLibrary();
+                                 return false;
+                               });
 }
 
 Engine::Engine(Delegate& delegate,
@@ -154,6 +165,9 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
 
 void Engine::SetupDefaultFontManager() {
   TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
+  font_collection_->GetFontCollection()->SetFontFallbackCacheStorage(
+      PersistentCache::GetCacheForProcess()->GetFontFallbackCacheDirectory(),
+      task_runners_.GetIOTaskRunner());
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
 }
 
@@ -265,6 +279,33 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
 
 void Engine::NotifyIdle(fml::TimeDelta deadline) {
   runtime_controller_->NotifyIdle(deadline);
+  idle_task_scheduler_.RunTasks(deadline);
+}
+
+IdleTaskScheduler::TaskId Engine::AddIdleTask(std::string name,
+                                              IdleTaskScheduler::Task task) {
+  return idle_task_scheduler_.AddTask(std::move(name), std::move(task));
+}
+
+void Engine::RemoveIdleTask(IdleTaskScheduler::TaskId id) {
+  idle_task_scheduler_.RemoveTask(id);
+}
+
+void Engine::PrefetchNextDartDeferredLibrary() {
+  while (!loading_units_to_prefetch_.empty()) {
+    auto loading_unit_id = loading_units_to_prefetch_.front();
+    loading_units_to_prefetch_.pop_front();
+    if (requested_loading_units_.count(loading_unit_id) > 0 ||
+        prefetching_loading_units_.count(loading_unit_id) > 0 ||
+        prefetched_loading_units_.count(loading_unit_id) > 0) {
+      continue;
+    }
+    TRACE_EVENT1("flutter", "Engine::PrefetchDartDeferredLibrary",
+                 "loading_unit_id", std::to_string(loading_unit_id).c_str());
+    prefetching_loading_units_.insert(loading_unit_id);
+    delegate_.RequestDartDeferredLibrary(loading_unit_id);
+    break;
+  }
 }
 
 void Engine::NotifyDestroyed() {
@@ -433,6 +474,36 @@ void Engine::DispatchPointerDataPacket(
   pointer_data_dispatcher_->DispatchPacket(std::move(packet), trace_flow_id);
 }
 
+void Engine::SetPointerLateLatch(std::shared_ptr<PointerLateLatch> latch) {
+  pointer_late_latch_ = std::move(latch);
+}
+
+void Engine::AddToPointerLateLatch(PointerLateLatch& latch,
+                                   PointerLateLatch::Source source,
+                                   const PointerDataPacket& packet) {
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    const PointerData data = packet.GetPointerData(i);
+    PointerLateLatch::Phase phase;
+    switch (data.change) {
+      case PointerData::Change::kDown:
+        phase = PointerLateLatch::Phase::kDown;
+        break;
+      case PointerData::Change::kMove:
+        phase = PointerLateLatch::Phase::kMove;
+        break;
+      case PointerData::Change::kUp:
+      case PointerData::Change::kCancel:
+      case PointerData::Change::kRemove:
+        phase = PointerLateLatch::Phase::kUp;
+        break;
+      default:
+        continue;
+    }
+    latch.AddPointerEvent(source, phase, data.device,
+                          SkPoint::Make(data.physical_x, data.physical_y));
+  }
+}
+
 void Engine::DispatchSemanticsAction(int node_id,
                                      SemanticsAction action,
                                      fml::MallocMapping args) {
@@ -470,6 +541,12 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
     return;
   }
 
+  if (pointer_late_latch_) {
+    if (auto sample = pointer_late_latch_->GetFrameworkSample()) {
+      layer_tree->set_pointer_late_latch(pointer_late_latch_, sample.value());
+    }
+  }
+
   animator_->Render(std::move(layer_tree), device_pixel_ratio);
 }
 
@@ -516,6 +593,10 @@ FontCollection& Engine::GetFontCollection() {
 void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) {
   animator_->EnqueueTraceFlowId(trace_flow_id);
+  if (pointer_late_latch_) {
+    AddToPointerLateLatch(*pointer_late_latch_,
+                          PointerLateLatch::Source::kFramework, *packet);
+  }
   if (runtime_controller_) {
     runtime_controller_->DispatchPointerDataPacket(*packet);
   }
@@ -562,7 +643,32 @@ const std::vector<std::string>& Engine::GetLastEntrypointArgs() const {
 
 // |RuntimeDelegate|
 void Engine::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
-  return delegate_.RequestDartDeferredLibrary(loading_unit_id);
+  requested_loading_units_.insert(loading_unit_id);
+
+  auto found = prefetched_loading_units_.find(loading_unit_id);
+  if (found != prefetched_loading_units_.end()) {
+    // Complete the load once the isolate is done asking for it.
+    task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+        [engine = GetWeakPtr(), loading_unit_id,
+         loading_unit = std::move(found->second)]() mutable {
+          if (engine) {
+            engine->LoadDartDeferredLibrary(
+                loading_unit_id, std::move(loading_unit.snapshot_data),
+                std::move(loading_unit.snapshot_instructions));
+          }
+        }));
+    prefetched_loading_units_.erase(found);
+    return;
+  }
+  if (prefetching_loading_units_.count(loading_unit_id) > 0) {
+    // The embedder is already loading it.
+    return;
+  }
+  delegate_.RequestDartDeferredLibrary(loading_unit_id);
+}
+
+void Engine::PrefetchDartDeferredLibrary(intptr_t loading_unit_id) {
+  loading_units_to_prefetch_.push_back(loading_unit_id);
 }
 
 std::weak_ptr<PlatformMessageHandler> Engine::GetPlatformMessageHandler()
@@ -578,6 +684,13 @@ void Engine::LoadDartDeferredLibrary(
     intptr_t loading_unit_id,
     std::unique_ptr<const fml::Mapping> snapshot_data,
     std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  const bool prefetched = prefetching_loading_units_.erase(loading_unit_id) > 0;
+  if (requested_loading_units_.erase(loading_unit_id) == 0 && prefetched) {
+    // A prefetch that arrived before the isolate asked for it.
+    prefetched_loading_units_[loading_unit_id] = {
+        std::move(snapshot_data), std::move(snapshot_instructions)};
+    return;
+  }
   if (runtime_controller_->IsRootIsolateRunning()) {
     runtime_controller_->LoadDartDeferredLibrary(
         loading_unit_id, std::move(snapshot_data),
@@ -591,6 +704,11 @@ void Engine::LoadDartDeferredLibrary(
 void Engine::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                           const std::string& error_message,
                                           bool transient) {
+  const bool prefetched = prefetching_loading_units_.erase(loading_unit_id) > 0;
+  if (requested_loading_units_.erase(loading_unit_id) == 0 && prefetched) {
+    // A failed prefetch. The isolate asks again if it needs the unit.
+    return;
+  }
   if (runtime_controller_->IsRootIsolateRunning()) {
     runtime_controller_->LoadDartDeferredLibraryError(loading_unit_id,
                                                       error_message, transient);
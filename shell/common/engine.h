@@ -5,13 +5,17 @@
 #ifndef SHELL_COMMON_ENGINE_H_
 #define SHELL_COMMON_ENGINE_H_
 
+#include <deque>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/flow/pointer_late_latch.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
@@ -27,6 +31,7 @@
 #include "flutter/runtime/runtime_delegate.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
+#include "flutter/shell/common/idle_task_scheduler.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -582,6 +587,8 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///             collection, just gives the Dart VM more hints about opportune
   ///             moments to perform collections.
   ///
+  ///             The time left before the deadline is then given to the
+  ///             tasks registered with `AddIdleTask`.
   ///
   /// @param[in]  deadline  The deadline is used by the VM to determine if the
   ///                       corresponding sweep can be performed within the
@@ -784,6 +791,22 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   void DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet,
                                  uint64_t trace_flow_id);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the engine record the pointer events it delivers to the
+  ///             framework in |latch|, and attach |latch| to the layer trees
+  ///             it renders, so that late latched layers can follow the
+  ///             pointer until the frame is rasterized.
+  ///
+  void SetPointerLateLatch(std::shared_ptr<PointerLateLatch> latch);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the pointer down, move and up events of |packet| to
+  ///             |latch|. May be called on any thread.
+  ///
+  static void AddToPointerLateLatch(PointerLateLatch& latch,
+                                    PointerLateLatch::Source source,
+                                    const PointerDataPacket& packet);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder encountered an
   ///             accessibility related action on the specified node. This call
@@ -946,6 +969,38 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
                                     const std::string& error_message,
                                     bool transient);
 
+  //--------------------------------------------------------------------------
+  /// @brief      Asks the embedder for a deferred library before the Dart code
+  ///             calls loadLibrary() for it, so that the call doesn't wait on
+  ///             the embedder to download and map the loading unit.
+  ///
+  ///             The request is sent to the embedder through
+  ///             `RequestDartDeferredLibrary` by an idle task, one loading
+  ///             unit per idle period. The loading unit passed
+  ///             back to `LoadDartDeferredLibrary` is kept until the isolate
+  ///             asks for it, which then completes without another request.
+  ///             Prefetches that fail are dropped, and the isolate's own
+  ///             request will ask the embedder again.
+  ///
+  /// @param[in]  loading_unit_id  The unique id of the deferred library's
+  ///                              loading unit.
+  ///
+  void PrefetchDartDeferredLibrary(intptr_t loading_unit_id);
+
+  //--------------------------------------------------------------------------
+  /// @brief      Registers maintenance work to run on the UI thread in the
+  ///             idle periods reported to `NotifyIdle`, after the Dart VM
+  ///             was notified.
+  ///
+  /// @see        `IdleTaskScheduler`
+  ///
+  /// @return     The id used to remove the task.
+  ///
+  IdleTaskScheduler::TaskId AddIdleTask(std::string name,
+                                        IdleTaskScheduler::Task task);
+
+  void RemoveIdleTask(IdleTaskScheduler::TaskId id);
+
   //--------------------------------------------------------------------------
   /// @brief      Accessor for the RuntimeController.
   ///
@@ -956,6 +1011,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
 
  private:
+  // Asks the embedder for the next loading unit to prefetch, if any.
+  void PrefetchNextDartDeferredLibrary();
+
   // |RuntimeDelegate|
   std::string DefaultRouteName() override;
 
@@ -1021,6 +1079,7 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   // So it should be defined after them to ensure that pointer_data_dispatcher_
   // is destructed first.
   std::unique_ptr<PointerDataDispatcher> pointer_data_dispatcher_;
+  std::shared_ptr<PointerLateLatch> pointer_late_latch_;
 
   std::string last_entry_point_;
   std::string last_entry_point_library_;
@@ -1030,6 +1089,23 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::shared_ptr<FontCollection> font_collection_;
   const std::unique_ptr<ImageDecoder> image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
+
+  struct PrefetchedLoadingUnit {
+    std::unique_ptr<const fml::Mapping> snapshot_data;
+    std::unique_ptr<const fml::Mapping> snapshot_instructions;
+  };
+  // Loading units that the isolate asked for and that aren't loaded yet.
+  std::unordered_set<intptr_t> requested_loading_units_;
+  // Loading units to ask the embedder for while idle, in order.
+  std::deque<intptr_t> loading_units_to_prefetch_;
+  // Prefetches that were sent to the embedder and aren't answered yet.
+  std::unordered_set<intptr_t> prefetching_loading_units_;
+  // Prefetched loading units that the isolate hasn't asked for yet.
+  std::unordered_map<intptr_t, PrefetchedLoadingUnit>
+      prefetched_loading_units_;
+
+  IdleTaskScheduler idle_task_scheduler_;
+
   TaskRunners task_runners_;
   fml::WeakPtrFactory<Engine> weak_factory_;  // Must be the last member.
   FML_DISALLOW_COPY_AND_ASSIGN(Engine);
@@ -14,6 +14,7 @@
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
 
 namespace flutter {
 
@@ -113,6 +114,12 @@ class MockRuntimeController : public RuntimeController {
               LoadDartDeferredLibraryError,
               (intptr_t, const std::string, bool),
               (override));
+  MOCK_METHOD(void,
+              LoadDartDeferredLibrary,
+              (intptr_t,
+               std::unique_ptr<const fml::Mapping>,
+               std::unique_ptr<const fml::Mapping>),
+              (override));
   MOCK_METHOD(DartVM*, GetDartVM, (), (const, override));
   MOCK_METHOD(bool, NotifyIdle, (fml::TimeDelta), (override));
 };
@@ -418,4 +425,98 @@ TEST_F(EngineTest, PassesLoadDartDeferredLibraryErrorToRuntime) {
   });
 }
 
+TEST_F(EngineTest, RunsIdleTasksAfterNotifyingTheVM) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    bool notified_vm = false;
+    EXPECT_CALL(*mock_runtime_controller, NotifyIdle(::testing::_))
+        .WillRepeatedly([&notified_vm](fml::TimeDelta deadline) {
+          notified_vm = true;
+          return true;
+        });
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller),
+        /*gpu_disabled_switch=*/std::make_shared<fml::SyncSwitch>());
+
+    auto deadline = fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros()) +
+                    fml::TimeDelta::FromMilliseconds(100);
+    size_t call_count = 0;
+    auto id = engine->AddIdleTask("test", [&](fml::TimeDelta task_deadline) {
+      EXPECT_TRUE(notified_vm);
+      EXPECT_EQ(task_deadline, deadline);
+      call_count++;
+      return false;
+    });
+    engine->NotifyIdle(deadline);
+    EXPECT_EQ(call_count, 1u);
+
+    engine->RemoveIdleTask(id);
+    engine->NotifyIdle(deadline);
+    EXPECT_EQ(call_count, 1u);
+  });
+}
+
+TEST_F(EngineTest, PrefetchesDartDeferredLibrariesWhileIdle) {
+  intptr_t loading_unit_id = 5;
+  std::unique_ptr<Engine> engine;
+  MockRuntimeDelegate client;
+  PostUITaskSync([this, &engine, &client, loading_unit_id] {
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*mock_runtime_controller, NotifyIdle(::testing::_))
+        .WillRepeatedly(::testing::Return(true));
+    // Nothing is loaded into the isolate before it asks for the unit.
+    EXPECT_CALL(*mock_runtime_controller,
+                LoadDartDeferredLibrary(loading_unit_id, ::testing::_,
+                                        ::testing::_))
+        .Times(0);
+    auto* runtime_controller = mock_runtime_controller.get();
+    // The unit is only requested from the embedder once.
+    EXPECT_CALL(delegate_, RequestDartDeferredLibrary(loading_unit_id))
+        .Times(1);
+    engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller),
+        /*gpu_disabled_switch=*/std::make_shared<fml::SyncSwitch>());
+
+    engine->PrefetchDartDeferredLibrary(loading_unit_id);
+    engine->NotifyIdle(
+        fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros()) +
+        fml::TimeDelta::FromMilliseconds(16));
+    engine->LoadDartDeferredLibrary(
+        loading_unit_id, std::make_unique<fml::NonOwnedMapping>(nullptr, 0),
+        std::make_unique<fml::NonOwnedMapping>(nullptr, 0));
+    ::testing::Mock::VerifyAndClearExpectations(runtime_controller);
+
+    EXPECT_CALL(*runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*runtime_controller,
+                LoadDartDeferredLibrary(loading_unit_id, ::testing::_,
+                                        ::testing::_))
+        .Times(1);
+    engine->RequestDartDeferredLibrary(loading_unit_id);
+  });
+  // The prefetched unit is loaded in a task posted by the request.
+  PostUITaskSync([&engine] { engine.reset(); });
+}
+
 }  // namespace flutter
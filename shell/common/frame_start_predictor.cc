@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_start_predictor.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+namespace {
+// The safety margin is this fraction of the frame interval.
+constexpr int64_t kSafetyMarginDivisor = 5;
+}  // namespace
+
+FrameStartPredictor::FrameStartPredictor() = default;
+
+FrameStartPredictor::~FrameStartPredictor() = default;
+
+void FrameStartPredictor::AddFrame(const FrameTiming& timing) {
+  AddFrame(timing.Get(FrameTiming::kBuildFinish) -
+               timing.Get(FrameTiming::kBuildStart),
+           timing.Get(FrameTiming::kRasterFinish) -
+               timing.Get(FrameTiming::kRasterStart));
+}
+
+void FrameStartPredictor::AddFrame(fml::TimeDelta build_duration,
+                                   fml::TimeDelta raster_duration) {
+  std::scoped_lock lock(mutex_);
+  frame_durations_.push_back(build_duration + raster_duration);
+  if (frame_durations_.size() > kWindowSize) {
+    frame_durations_.pop_front();
+  }
+}
+
+fml::TimeDelta FrameStartPredictor::GetStartDelay(
+    fml::TimePoint vsync_start,
+    fml::TimePoint vsync_target) const {
+  const fml::TimeDelta interval = vsync_target - vsync_start;
+  fml::TimeDelta predicted_duration;
+  {
+    std::scoped_lock lock(mutex_);
+    if (frame_durations_.size() < kWindowSize) {
+      return fml::TimeDelta::Zero();
+    }
+    predicted_duration =
+        *std::max_element(frame_durations_.begin(), frame_durations_.end());
+  }
+  const fml::TimeDelta delay =
+      interval - predicted_duration - interval / kSafetyMarginDivisor;
+  return std::max(delay, fml::TimeDelta::Zero());
+}
+
+}  // namespace flutter
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Predicts how late the build of a frame can start and still be
+///             rasterized before the target time of its vsync.
+///
+///             Starting the build later than the vsync lets the frame use
+///             input that arrives in the meantime, which reduces the latency
+///             from input to photon. The prediction is the longest build plus
+///             raster duration of the recent frames, plus a safety margin of
+///             a fifth of the frame interval. The build starts at the vsync
+///             when no prediction is available yet or when the recent frames
+///             don't fit in the interval.
+///
+///             The frame interval is taken from each vsync, so the start of
+///             the build follows displays whose refresh rate changes.
+///
+///             Frames are added on the raster thread and the delay is queried
+///             on the UI thread.
+///
+class FrameStartPredictor {
+ public:
+  /// The number of recent frames the prediction is based on.
+  static constexpr size_t kWindowSize = 30;
+
+  FrameStartPredictor();
+
+  ~FrameStartPredictor();
+
+  /// Adds the timings of a rasterized frame.
+  void AddFrame(const FrameTiming& timing);
+
+  /// Adds a frame with the given durations.
+  void AddFrame(fml::TimeDelta build_duration, fml::TimeDelta raster_duration);
+
+  /// How long after |vsync_start| the build of the frame for this vsync
+  /// should start.
+  fml::TimeDelta GetStartDelay(fml::TimePoint vsync_start,
+                               fml::TimePoint vsync_target) const;
+
+ private:
+  mutable std::mutex mutex_;
+  // Build plus raster durations of the recent frames, oldest first.
+  std::deque<fml::TimeDelta> frame_durations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStartPredictor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_start_predictor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+fml::TimeDelta Millis(int64_t millis) {
+  return fml::TimeDelta::FromMilliseconds(millis);
+}
+
+void AddFrames(FrameStartPredictor& predictor,
+               size_t count,
+               fml::TimeDelta build,
+               fml::TimeDelta raster) {
+  for (size_t i = 0; i < count; i++) {
+    predictor.AddFrame(build, raster);
+  }
+}
+}  // namespace
+
+TEST(FrameStartPredictorTest, StartsAtVsyncUntilFramesWereSeen) {
+  FrameStartPredictor predictor;
+  const fml::TimePoint vsync_start = fml::TimePoint::Now();
+  AddFrames(predictor, FrameStartPredictor::kWindowSize - 1, Millis(2),
+            Millis(3));
+  EXPECT_EQ(predictor.GetStartDelay(vsync_start, vsync_start + Millis(20)),
+            fml::TimeDelta::Zero());
+
+  AddFrames(predictor, 1, Millis(2), Millis(3));
+  // 20ms interval minus 5ms of work minus a 4ms margin.
+  EXPECT_EQ(predictor.GetStartDelay(vsync_start, vsync_start + Millis(20)),
+            Millis(11));
+}
+
+TEST(FrameStartPredictorTest, PredictsTheSlowestRecentFrame) {
+  FrameStartPredictor predictor;
+  const fml::TimePoint vsync_start = fml::TimePoint::Now();
+  AddFrames(predictor, FrameStartPredictor::kWindowSize, Millis(2), Millis(3));
+  predictor.AddFrame(Millis(4), Millis(6));
+  EXPECT_EQ(predictor.GetStartDelay(vsync_start, vsync_start + Millis(20)),
+            Millis(6));
+
+  // The slow frame leaves the window.
+  AddFrames(predictor, FrameStartPredictor::kWindowSize - 1, Millis(2),
+            Millis(3));
+  EXPECT_EQ(predictor.GetStartDelay(vsync_start, vsync_start + Millis(20)),
+            Millis(6));
+  AddFrames(predictor, 1, Millis(2), Millis(3));
+  EXPECT_EQ(predictor.GetStartDelay(vsync_start, vsync_start + Millis(20)),
+            Millis(11));
+}
+
+TEST(FrameStartPredictorTest, FollowsTheVsyncInterval) {
+  FrameStartPredictor predictor;
+  const fml::TimePoint vsync_start = fml::TimePoint::Now();
+  AddFrames(predictor, FrameStartPredictor::kWindowSize, Millis(2), Millis(3));
+  EXPECT_EQ(predictor.GetStartDelay(vsync_start, vsync_start + Millis(40)),
+            Millis(27));
+  EXPECT_EQ(predictor.GetStartDelay(vsync_start, vsync_start + Millis(10)),
+            Millis(3));
+  // Frames that don't fit the interval start at the vsync.
+  EXPECT_EQ(predictor.GetStartDelay(vsync_start, vsync_start + Millis(5)),
+            fml::TimeDelta::Zero());
+}
+
+}  // namespace testing
+}  // namespace flutter
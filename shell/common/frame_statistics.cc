@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_statistics.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace flutter {
+
+namespace {
+
+// The nearest-rank percentiles of |nanos|, which is reordered.
+FrameStatistics::Percentiles ComputePercentiles(std::vector<int64_t>& nanos) {
+  FrameStatistics::Percentiles percentiles;
+  if (nanos.empty()) {
+    return percentiles;
+  }
+  std::sort(nanos.begin(), nanos.end());
+  auto percentile = [&nanos](size_t percent) {
+    // The smallest duration that is at least as long as |percent| percent of
+    // the durations.
+    size_t rank = std::max<size_t>((nanos.size() * percent + 99) / 100, 1);
+    return fml::TimeDelta::FromNanoseconds(nanos[rank - 1]);
+  };
+  percentiles.p50 = percentile(50);
+  percentiles.p90 = percentile(90);
+  percentiles.p99 = percentile(99);
+  return percentiles;
+}
+
+}  // namespace
+
+FrameStatistics::FrameStatistics() = default;
+
+FrameStatistics::~FrameStatistics() = default;
+
+void FrameStatistics::AddFrame(const FrameTiming& timing,
+                               fml::TimeDelta frame_budget) {
+  const fml::TimeDelta build = timing.Get(FrameTiming::kBuildFinish) -
+                               timing.Get(FrameTiming::kBuildStart);
+  const fml::TimeDelta raster = timing.Get(FrameTiming::kRasterFinish) -
+                                timing.Get(FrameTiming::kRasterStart);
+  const fml::TimeDelta gpu = timing.GetGpuDuration();
+
+  // Only this thread writes, so the count can't change in the meantime.
+  const uint64_t frame_count = frame_count_.load(std::memory_order_relaxed);
+  Sample& sample = samples_[frame_count % kWindowSize];
+  sample.build_nanos.store(build.ToNanoseconds(), std::memory_order_relaxed);
+  sample.raster_nanos.store(raster.ToNanoseconds(), std::memory_order_relaxed);
+  sample.gpu_nanos.store(
+      gpu > fml::TimeDelta::Zero() ? gpu.ToNanoseconds() : -1,
+      std::memory_order_relaxed);
+  if (build > frame_budget || raster > frame_budget) {
+    janky_frame_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  dropped_frame_count_.fetch_add(timing.GetDroppedFrameCount(),
+                                 std::memory_order_relaxed);
+  frame_count_.store(frame_count + 1, std::memory_order_release);
+}
+
+FrameStatistics::Snapshot FrameStatistics::GetSnapshot() const {
+  Snapshot snapshot;
+  snapshot.frame_count = frame_count_.load(std::memory_order_acquire);
+  snapshot.janky_frame_count =
+      janky_frame_count_.load(std::memory_order_relaxed);
+  snapshot.dropped_frame_count =
+      dropped_frame_count_.load(std::memory_order_relaxed);
+  snapshot.sample_count =
+      std::min<uint64_t>(snapshot.frame_count, kWindowSize);
+
+  std::vector<int64_t> build_nanos;
+  std::vector<int64_t> raster_nanos;
+  std::vector<int64_t> gpu_nanos;
+  build_nanos.reserve(snapshot.sample_count);
+  raster_nanos.reserve(snapshot.sample_count);
+  gpu_nanos.reserve(snapshot.sample_count);
+  // Until the window is full, the samples are the first ones.
+  for (size_t i = 0; i < snapshot.sample_count; i++) {
+    const Sample& sample = samples_[i];
+    build_nanos.push_back(sample.build_nanos.load(std::memory_order_relaxed));
+    raster_nanos.push_back(
+        sample.raster_nanos.load(std::memory_order_relaxed));
+    const int64_t gpu = sample.gpu_nanos.load(std::memory_order_relaxed);
+    if (gpu >= 0) {
+      gpu_nanos.push_back(gpu);
+    }
+  }
+  snapshot.gpu_sample_count = gpu_nanos.size();
+  snapshot.build = ComputePercentiles(build_nanos);
+  snapshot.raster = ComputePercentiles(raster_nanos);
+  snapshot.gpu = ComputePercentiles(gpu_nanos);
+  return snapshot;
+}
+
+}  // namespace flutter
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
+#define FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Rolling statistics of the durations of the last frames that
+///             were rasterized, and counts of the janky and dropped frames.
+///
+///             Unlike the performance overlay, the statistics cost nothing to
+///             render and can be sampled by production telemetry at any
+///             time. Frames are added on the raster thread, and snapshots may
+///             be taken on any thread without blocking it. A snapshot taken
+///             while a frame is added may already contain some durations
+///             of that frame in place of those of the oldest frame.
+///
+class FrameStatistics {
+ public:
+  /// The number of the last frames the percentiles are computed over, four
+  /// seconds at 60 Hz.
+  static constexpr size_t kWindowSize = 240;
+
+  struct Percentiles {
+    fml::TimeDelta p50;
+    fml::TimeDelta p90;
+    fml::TimeDelta p99;
+  };
+
+  struct Snapshot {
+    /// The number of frames added since the statistics were created.
+    uint64_t frame_count = 0;
+    /// The number of those frames whose build or raster took longer than the
+    /// frame budget.
+    uint64_t janky_frame_count = 0;
+    /// The number of frames the rasterizer dropped in the meantime.
+    uint64_t dropped_frame_count = 0;
+    /// The number of the last frames the build and raster percentiles are
+    /// computed over, at most |kWindowSize|.
+    size_t sample_count = 0;
+    Percentiles build;
+    Percentiles raster;
+    /// The number of those frames whose GPU duration was measured, which the
+    /// GPU percentiles are computed over.
+    size_t gpu_sample_count = 0;
+    Percentiles gpu;
+  };
+
+  FrameStatistics();
+
+  ~FrameStatistics();
+
+  /// Adds a rasterized frame. Must always be called on the same thread.
+  void AddFrame(const FrameTiming& timing, fml::TimeDelta frame_budget);
+
+  Snapshot GetSnapshot() const;
+
+ private:
+  struct Sample {
+    std::atomic<int64_t> build_nanos{0};
+    std::atomic<int64_t> raster_nanos{0};
+    // Negative if the GPU duration was not measured.
+    std::atomic<int64_t> gpu_nanos{-1};
+  };
+
+  std::array<Sample, kWindowSize> samples_;
+  // Each frame is published by incrementing |frame_count_| after the other
+  // members, so that a snapshot sees them.
+  std::atomic<uint64_t> frame_count_{0};
+  std::atomic<uint64_t> janky_frame_count_{0};
+  std::atomic<uint64_t> dropped_frame_count_{0};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_statistics.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+fml::TimeDelta Millis(int64_t millis) {
+  return fml::TimeDelta::FromMilliseconds(millis);
+}
+
+FrameTiming MakeTiming(fml::TimeDelta build,
+                       fml::TimeDelta raster,
+                       fml::TimeDelta gpu = fml::TimeDelta::Zero(),
+                       size_t dropped_frame_count = 0) {
+  const fml::TimePoint build_start = fml::TimePoint::Now();
+  FrameTiming timing;
+  timing.Set(FrameTiming::kBuildStart, build_start);
+  timing.Set(FrameTiming::kBuildFinish, build_start + build);
+  timing.Set(FrameTiming::kRasterStart, build_start + build);
+  timing.Set(FrameTiming::kRasterFinish, build_start + build + raster);
+  timing.SetGpuDuration(gpu);
+  timing.SetDroppedFrameCount(dropped_frame_count);
+  return timing;
+}
+}  // namespace
+
+TEST(FrameStatisticsTest, IsEmptyUntilFramesAreAdded) {
+  FrameStatistics statistics;
+  const auto snapshot = statistics.GetSnapshot();
+  EXPECT_EQ(snapshot.frame_count, 0u);
+  EXPECT_EQ(snapshot.sample_count, 0u);
+  EXPECT_EQ(snapshot.gpu_sample_count, 0u);
+  EXPECT_EQ(snapshot.build.p99, fml::TimeDelta::Zero());
+  EXPECT_EQ(snapshot.raster.p99, fml::TimeDelta::Zero());
+}
+
+TEST(FrameStatisticsTest, ComputesPercentiles) {
+  FrameStatistics statistics;
+  // Added out of order, so that the order of the frames doesn't matter.
+  for (int64_t i = 100; i > 0; i--) {
+    statistics.AddFrame(MakeTiming(Millis(i), Millis(2 * i)), Millis(1000));
+  }
+  const auto snapshot = statistics.GetSnapshot();
+  EXPECT_EQ(snapshot.frame_count, 100u);
+  EXPECT_EQ(snapshot.sample_count, 100u);
+  EXPECT_EQ(snapshot.build.p50, Millis(50));
+  EXPECT_EQ(snapshot.build.p90, Millis(90));
+  EXPECT_EQ(snapshot.build.p99, Millis(99));
+  EXPECT_EQ(snapshot.raster.p50, Millis(100));
+  EXPECT_EQ(snapshot.raster.p99, Millis(198));
+  // The GPU durations were not measured.
+  EXPECT_EQ(snapshot.gpu_sample_count, 0u);
+  EXPECT_EQ(snapshot.gpu.p50, fml::TimeDelta::Zero());
+}
+
+TEST(FrameStatisticsTest, OnlyKeepsTheLastFrames) {
+  FrameStatistics statistics;
+  for (size_t i = 0; i < FrameStatistics::kWindowSize; i++) {
+    statistics.AddFrame(MakeTiming(Millis(1), Millis(1)), Millis(16));
+  }
+  statistics.AddFrame(MakeTiming(Millis(8), Millis(8)), Millis(16));
+  auto snapshot = statistics.GetSnapshot();
+  EXPECT_EQ(snapshot.sample_count, FrameStatistics::kWindowSize);
+  EXPECT_EQ(snapshot.build.p50, Millis(1));
+  EXPECT_EQ(snapshot.build.p99, Millis(1));
+
+  for (size_t i = 1; i < FrameStatistics::kWindowSize; i++) {
+    statistics.AddFrame(MakeTiming(Millis(5), Millis(5)), Millis(16));
+  }
+  snapshot = statistics.GetSnapshot();
+  EXPECT_EQ(snapshot.frame_count, 2 * FrameStatistics::kWindowSize);
+  EXPECT_EQ(snapshot.sample_count, FrameStatistics::kWindowSize);
+  EXPECT_EQ(snapshot.build.p50, Millis(5));
+  EXPECT_EQ(snapshot.raster.p99, Millis(5));
+}
+
+TEST(FrameStatisticsTest, CountsJankyAndDroppedFrames) {
+  FrameStatistics statistics;
+  statistics.AddFrame(MakeTiming(Millis(4), Millis(4), Millis(3)), Millis(16));
+  statistics.AddFrame(MakeTiming(Millis(20), Millis(4)), Millis(16));
+  statistics.AddFrame(MakeTiming(Millis(4), Millis(20), Millis(18), 2),
+                      Millis(16));
+  statistics.AddFrame(MakeTiming(Millis(16), Millis(16), Millis(5), 1),
+                      Millis(16));
+  const auto snapshot = statistics.GetSnapshot();
+  EXPECT_EQ(snapshot.frame_count, 4u);
+  EXPECT_EQ(snapshot.janky_frame_count, 2u);
+  EXPECT_EQ(snapshot.dropped_frame_count, 3u);
+  // Only the frames whose GPU duration was measured count.
+  EXPECT_EQ(snapshot.gpu_sample_count, 3u);
+  EXPECT_EQ(snapshot.gpu.p50, Millis(5));
+  EXPECT_EQ(snapshot.gpu.p99, Millis(18));
+}
+
+TEST(FrameStatisticsTest, CanBeSampledWhileFramesAreAdded) {
+  FrameStatistics statistics;
+  std::thread raster_thread([&statistics]() {
+    for (int64_t i = 0; i < 10000; i++) {
+      statistics.AddFrame(MakeTiming(Millis(i % 10), Millis(i % 20)),
+                          Millis(16));
+    }
+  });
+  uint64_t frame_count = 0;
+  while (frame_count < 10000) {
+    const auto snapshot = statistics.GetSnapshot();
+    EXPECT_GE(snapshot.frame_count, frame_count);
+    EXPECT_LE(snapshot.build.p50, snapshot.build.p90);
+    EXPECT_LE(snapshot.build.p90, snapshot.build.p99);
+    EXPECT_LT(snapshot.build.p99, Millis(10));
+    EXPECT_LT(snapshot.raster.p99, Millis(20));
+    frame_count = snapshot.frame_count;
+  }
+  raster_thread.join();
+  EXPECT_EQ(statistics.GetSnapshot().janky_frame_count, 1500u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/gpu_backlog_policy.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+GpuBacklogPolicy::GpuBacklogPolicy(size_t max_frames_in_flight)
+    : max_frames_in_flight_(max_frames_in_flight) {
+  FML_DCHECK(max_frames_in_flight_ > 0);
+}
+
+GpuBacklogPolicy::~GpuBacklogPolicy() = default;
+
+void GpuBacklogPolicy::OnFrameSubmitted() {
+  const size_t frames_in_flight = ++frames_in_flight_;
+  FML_TRACE_COUNTER("flutter", "GpuBacklog", reinterpret_cast<int64_t>(this),
+                    "frames in flight", frames_in_flight);
+}
+
+void GpuBacklogPolicy::OnFrameCompleted() {
+  FML_DCHECK(frames_in_flight_ > 0);
+  const size_t frames_in_flight = --frames_in_flight_;
+  FML_TRACE_COUNTER("flutter", "GpuBacklog", reinterpret_cast<int64_t>(this),
+                    "frames in flight", frames_in_flight);
+}
+
+bool GpuBacklogPolicy::IsBacklogged() const {
+  return frames_in_flight_ >= max_frames_in_flight_;
+}
+
+bool GpuBacklogPolicy::ShouldDropFrame(size_t queued_frame_count) {
+  if (queued_frame_count < 2 || !IsBacklogged()) {
+    return false;
+  }
+  ++dropped_frame_count_;
+  return true;
+}
+
+size_t GpuBacklogPolicy::TakeDroppedFrameCount() {
+  size_t dropped_frame_count = dropped_frame_count_;
+  dropped_frame_count_ = 0;
+  return dropped_frame_count;
+}
+
+}  // namespace flutter
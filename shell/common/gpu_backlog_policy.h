@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_GPU_BACKLOG_POLICY_H_
+#define FLUTTER_SHELL_COMMON_GPU_BACKLOG_POLICY_H_
+
+#include <atomic>
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decides when the rasterizer drops a frame instead of rendering
+///             it because the GPU has not caught up with the frames that
+///             were already submitted.
+///
+///             When the GPU is slower than the display, for example on a
+///             thermally throttled device, every frame that is rendered adds
+///             to the work queued on the GPU and so to the latency of the
+///             following frames. While the number of frames the GPU is still
+///             working on is at the threshold, a frame that already has a
+///             newer frame queued behind it is stale and is dropped. The
+///             newest frame is always rendered.
+///
+///             Frames are submitted and dropped on the raster thread. They
+///             may complete on any thread.
+///
+class GpuBacklogPolicy {
+ public:
+  /// The default number of frames the GPU may work on before frames are
+  /// dropped.
+  static constexpr size_t kDefaultMaxFramesInFlight = 2;
+
+  explicit GpuBacklogPolicy(
+      size_t max_frames_in_flight = kDefaultMaxFramesInFlight);
+
+  ~GpuBacklogPolicy();
+
+  /// Called when a frame was submitted to the GPU.
+  void OnFrameSubmitted();
+
+  /// Called when the GPU completed, or failed, a frame that was submitted.
+  void OnFrameCompleted();
+
+  /// The number of submitted frames the GPU has not completed yet.
+  size_t GetFramesInFlight() const { return frames_in_flight_; }
+
+  bool IsBacklogged() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the next frame should be dropped. Counts the frame as
+  ///             dropped if it should.
+  ///
+  /// @param[in]  queued_frame_count  The number of frames queued for the
+  ///                                 rasterizer, including the next frame.
+  ///
+  bool ShouldDropFrame(size_t queued_frame_count);
+
+  /// Returns the number of frames dropped since the last call.
+  size_t TakeDroppedFrameCount();
+
+ private:
+  const size_t max_frames_in_flight_;
+  std::atomic<size_t> frames_in_flight_ = 0;
+  size_t dropped_frame_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GpuBacklogPolicy);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_GPU_BACKLOG_POLICY_H_
@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/gpu_backlog_policy.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(GpuBacklogPolicyTest, DropsStaleFramesWhileBacklogged) {
+  GpuBacklogPolicy policy(2);
+  policy.OnFrameSubmitted();
+  EXPECT_FALSE(policy.IsBacklogged());
+  EXPECT_FALSE(policy.ShouldDropFrame(3));
+
+  policy.OnFrameSubmitted();
+  EXPECT_TRUE(policy.IsBacklogged());
+  EXPECT_EQ(policy.GetFramesInFlight(), 2u);
+  // The newest frame is always rendered.
+  EXPECT_FALSE(policy.ShouldDropFrame(1));
+  EXPECT_TRUE(policy.ShouldDropFrame(3));
+  EXPECT_TRUE(policy.ShouldDropFrame(2));
+
+  policy.OnFrameCompleted();
+  EXPECT_FALSE(policy.IsBacklogged());
+  EXPECT_FALSE(policy.ShouldDropFrame(2));
+}
+
+TEST(GpuBacklogPolicyTest, CountsDroppedFramesUntilTaken) {
+  GpuBacklogPolicy policy(1);
+  EXPECT_EQ(policy.TakeDroppedFrameCount(), 0u);
+
+  policy.OnFrameSubmitted();
+  ASSERT_TRUE(policy.ShouldDropFrame(2));
+  ASSERT_TRUE(policy.ShouldDropFrame(2));
+  EXPECT_EQ(policy.TakeDroppedFrameCount(), 2u);
+  EXPECT_EQ(policy.TakeDroppedFrameCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleTaskScheduler::IdleTaskScheduler(Clock clock) : clock_(std::move(clock)) {
+  FML_DCHECK(clock_);
+}
+
+IdleTaskScheduler::~IdleTaskScheduler() = default;
+
+IdleTaskScheduler::TaskId IdleTaskScheduler::AddTask(std::string name,
+                                                     Task task) {
+  FML_DCHECK(task);
+  const TaskId id = next_id_++;
+  tasks_.push_back({id, std::move(name), std::move(task)});
+  return id;
+}
+
+void IdleTaskScheduler::RemoveTask(TaskId id) {
+  auto found = std::find_if(tasks_.begin(), tasks_.end(),
+                            [id](const Entry& entry) { return entry.id == id; });
+  if (found == tasks_.end()) {
+    return;
+  }
+  const size_t index = found - tasks_.begin();
+  tasks_.erase(found);
+  if (index < next_index_) {
+    next_index_--;
+  }
+}
+
+size_t IdleTaskScheduler::RunTasks(fml::TimeDelta deadline) {
+  if (tasks_.empty() || deadline - clock_() < kMinimumTaskBudget) {
+    return 0;
+  }
+  TRACE_EVENT0("flutter", "IdleTaskScheduler::RunTasks");
+
+  // Tasks that reported they are done for this idle period. Tasks may add or
+  // remove tasks, so they are tracked by id.
+  std::vector<TaskId> done;
+  size_t call_count = 0;
+  while (true) {
+    bool called = false;
+    for (size_t i = 0; i < tasks_.size(); i++) {
+      const size_t index = (next_index_ + i) % tasks_.size();
+      const TaskId id = tasks_[index].id;
+      if (std::find(done.begin(), done.end(), id) != done.end()) {
+        continue;
+      }
+      if (deadline - clock_() < kMinimumTaskBudget) {
+        // Start with this task in the next idle period.
+        next_index_ = index;
+        return call_count;
+      }
+      bool has_more_work;
+      {
+        // Copied, since the task may remove itself.
+        auto task = tasks_[index].task;
+        TRACE_EVENT1("flutter", "IdleTask", "name",
+                     tasks_[index].name.c_str());
+        has_more_work = task(deadline);
+      }
+      call_count++;
+      called = true;
+      if (!has_more_work) {
+        done.push_back(id);
+      }
+      if (tasks_.empty()) {
+        return call_count;
+      }
+      // Move on to the next task, even if the list changed.
+      auto found =
+          std::find_if(tasks_.begin(), tasks_.end(),
+                       [id](const Entry& entry) { return entry.id == id; });
+      next_index_ = found == tasks_.end()
+                        ? index % tasks_.size()
+                        : (found - tasks_.begin() + 1) % tasks_.size();
+      break;
+    }
+    if (!called) {
+      return call_count;
+    }
+  }
+}
+
+}  // namespace flutter
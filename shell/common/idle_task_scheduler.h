@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Runs maintenance work that doesn't have to happen at any
+///             particular time, such as trimming caches or prefetching
+///             resources, in the idle periods between frames.
+///
+///             Tasks are registered once and called again in every idle
+///             period until they report that they have nothing left to do
+///             in it. Each call gets the deadline of the idle period and is
+///             expected to return before it, splitting its work into
+///             smaller pieces if needed. A task is only called while at
+///             least `kMinimumTaskBudget` is left before the deadline, and
+///             tasks are called in turns so that a task with a lot of work
+///             doesn't starve the others.
+///
+///             Deadlines are measured on the clock passed to the scheduler,
+///             which is the same clock as the deadlines of
+///             `Animator::Delegate::OnAnimatorNotifyIdle`.
+///
+///             Not thread safe. Tasks are called on the thread that runs the
+///             scheduler.
+///
+class IdleTaskScheduler {
+ public:
+  /// Returns the current time in the time base of the deadlines.
+  using Clock = std::function<fml::TimeDelta()>;
+
+  /// Does some work before `deadline`. Returns whether the task has more
+  /// work to do in this idle period.
+  using Task = std::function<bool(fml::TimeDelta deadline)>;
+
+  using TaskId = size_t;
+
+  /// Tasks aren't called with less time than this left before the deadline.
+  static constexpr fml::TimeDelta kMinimumTaskBudget =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  explicit IdleTaskScheduler(Clock clock);
+
+  ~IdleTaskScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers a task to be called in idle periods.
+  ///
+  /// @param[in]  name  The name of the task in traces.
+  ///
+  /// @return     The id used to remove the task.
+  ///
+  TaskId AddTask(std::string name, Task task);
+
+  void RemoveTask(TaskId id);
+
+  size_t GetTaskCount() const { return tasks_.size(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Calls the tasks until they have nothing left to do, or until
+  ///             less than `kMinimumTaskBudget` is left before `deadline`.
+  ///
+  /// @return     The number of times a task was called.
+  ///
+  size_t RunTasks(fml::TimeDelta deadline);
+
+ private:
+  struct Entry {
+    TaskId id;
+    std::string name;
+    Task task;
+  };
+
+  const Clock clock_;
+  std::vector<Entry> tasks_;
+  TaskId next_id_ = 0;
+  // The task called first in the next idle period.
+  size_t next_index_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kStep = fml::TimeDelta::FromMilliseconds(2);
+
+// A clock that only moves when a task does work.
+class FakeClock {
+ public:
+  IdleTaskScheduler::Clock GetClock() {
+    return [this] { return now_; };
+  }
+
+  void Advance(fml::TimeDelta delta) { now_ = now_ + delta; }
+
+  fml::TimeDelta Now() const { return now_; }
+
+ private:
+  fml::TimeDelta now_ = fml::TimeDelta::FromSeconds(1);
+};
+
+}  // namespace
+
+TEST(IdleTaskSchedulerTest, RunsTasksUntilTheyAreDone) {
+  FakeClock clock;
+  IdleTaskScheduler scheduler(clock.GetClock());
+  int remaining_work = 3;
+  scheduler.AddTask("work", [&](fml::TimeDelta deadline) {
+    clock.Advance(kStep);
+    return --remaining_work > 0;
+  });
+
+  EXPECT_EQ(scheduler.RunTasks(clock.Now() + kStep * 10), 3u);
+  EXPECT_EQ(remaining_work, 0);
+}
+
+TEST(IdleTaskSchedulerTest, StopsBeforeTheDeadline) {
+  FakeClock clock;
+  IdleTaskScheduler scheduler(clock.GetClock());
+  size_t call_count = 0;
+  fml::TimeDelta deadline = clock.Now() + kStep * 3;
+  scheduler.AddTask("work", [&](fml::TimeDelta task_deadline) {
+    EXPECT_EQ(task_deadline, deadline);
+    EXPECT_GE(task_deadline - clock.Now(),
+              IdleTaskScheduler::kMinimumTaskBudget);
+    call_count++;
+    clock.Advance(kStep);
+    return true;
+  });
+
+  EXPECT_EQ(scheduler.RunTasks(deadline), 3u);
+  EXPECT_EQ(call_count, 3u);
+
+  // Nothing runs once the deadline has passed.
+  EXPECT_EQ(scheduler.RunTasks(clock.Now() - kStep), 0u);
+  EXPECT_EQ(call_count, 3u);
+}
+
+TEST(IdleTaskSchedulerTest, TakesTurnsAcrossIdlePeriods) {
+  FakeClock clock;
+  IdleTaskScheduler scheduler(clock.GetClock());
+  std::vector<std::string> calls;
+  for (const char* name : {"a", "b", "c"}) {
+    scheduler.AddTask(name, [&calls, &clock, name](fml::TimeDelta deadline) {
+      calls.push_back(name);
+      clock.Advance(kStep);
+      return true;
+    });
+  }
+
+  // Each idle period has room for two calls. Tasks with more work to do
+  // don't starve the tasks after them.
+  scheduler.RunTasks(clock.Now() + kStep * 2);
+  scheduler.RunTasks(clock.Now() + kStep * 2);
+  EXPECT_EQ(calls, std::vector<std::string>({"a", "b", "c", "a"}));
+}
+
+TEST(IdleTaskSchedulerTest, CanRemoveTasks) {
+  FakeClock clock;
+  IdleTaskScheduler scheduler(clock.GetClock());
+  size_t removed_count = 0;
+  size_t kept_count = 0;
+  IdleTaskScheduler::TaskId removed;
+  removed = scheduler.AddTask("removed", [&](fml::TimeDelta deadline) {
+    removed_count++;
+    // Tasks can remove themselves.
+    scheduler.RemoveTask(removed);
+    return true;
+  });
+  scheduler.AddTask("kept", [&](fml::TimeDelta deadline) {
+    kept_count++;
+    return false;
+  });
+  ASSERT_EQ(scheduler.GetTaskCount(), 2u);
+
+  EXPECT_EQ(scheduler.RunTasks(clock.Now() + kStep), 2u);
+  EXPECT_EQ(scheduler.GetTaskCount(), 1u);
+  EXPECT_EQ(scheduler.RunTasks(clock.Now() + kStep), 1u);
+  EXPECT_EQ(removed_count, 1u);
+  EXPECT_EQ(kept_count, 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -126,20 +128,40 @@ class Pipeline {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+  explicit Pipeline(uint32_t depth) : Pipeline(depth, depth) {}
+
+  /// Creates a pipeline whose depth can be changed with |SetDepth| up to
+  /// |max_depth|.
+  Pipeline(uint32_t depth, uint32_t max_depth)
+      : empty_(max_depth),
+        available_(0),
+        inflight_(0),
+        max_depth_(max_depth),
+        depth_(std::clamp(depth, 1u, max_depth)) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// The number of resources that may be in flight at once, including the
+  /// one being consumed.
+  uint32_t GetDepth() const { return depth_; }
+
+  uint32_t GetMaxDepth() const { return max_depth_; }
+
+  /// Changes the depth of the pipeline, clamped to [1, max depth]. Resources
+  /// that are already in flight are not affected when the depth shrinks.
+  void SetDepth(uint32_t depth) {
+    depth_ = std::clamp(depth, 1u, max_depth_);
+  }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
   /// If the queue is already at its maximum depth, the `ProducerContinuation`
   /// is returned with success = false.
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (inflight_ >= static_cast<int>(depth_.load()) || !empty_.TryWait()) {
       return {};
     }
     ++inflight_;
@@ -175,6 +197,12 @@ class Pipeline {
         GetNextPipelineTraceID()};         // trace id
   }
 
+  /// The number of resources that were produced and not consumed yet.
+  size_t GetQueuedCount() const {
+    std::scoped_lock lock(queue_mutex_);
+    return queue_.size();
+  }
+
   using Consumer = std::function<void(ResourcePtr)>;
 
   /// @note Procedure doesn't copy all closures.
@@ -214,7 +242,9 @@ class Pipeline {
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
-  std::mutex queue_mutex_;
+  const uint32_t max_depth_;
+  std::atomic<uint32_t> depth_;
+  mutable std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
   /// Commits a produced resource to the queue and signals the consumer that a
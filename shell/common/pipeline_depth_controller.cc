@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_controller.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+PipelineDepthController::PipelineDepthController(uint32_t initial_depth,
+                                                 uint32_t max_depth)
+    : max_depth_(std::max(max_depth, 1u)),
+      depth_(std::clamp(initial_depth, 1u, max_depth_)) {}
+
+PipelineDepthController::~PipelineDepthController() = default;
+
+uint32_t PipelineDepthController::AddFrame(
+    const FrameTimingsRecorder& recorder) {
+  return AddFrame(
+      recorder.GetVsyncTargetTime() - recorder.GetVsyncStartTime(),
+      recorder.GetBuildDuration(),
+      recorder.GetRasterEndTime() - recorder.GetRasterStartTime());
+}
+
+uint32_t PipelineDepthController::AddFrame(fml::TimeDelta frame_budget,
+                                           fml::TimeDelta build_duration,
+                                           fml::TimeDelta raster_duration) {
+  if (frame_budget <= fml::TimeDelta::Zero()) {
+    // The frame was not scheduled by a vsync, so it says nothing about how
+    // the pipeline keeps up with the display.
+    return depth_;
+  }
+
+  frame_count_++;
+  if (build_duration + raster_duration <= frame_budget) {
+    serial_frame_count_++;
+  }
+  if (raster_duration > frame_budget) {
+    slow_raster_frame_count_++;
+  }
+  raster_overrun_ = raster_overrun_ + (raster_duration - frame_budget);
+
+  if (frame_count_ < kWindowSize) {
+    return depth_;
+  }
+
+  const uint32_t desired_depth = GetDesiredDepth();
+  if (desired_depth > depth_) {
+    depth_++;
+  } else if (desired_depth < depth_) {
+    depth_--;
+  }
+  FML_TRACE_COUNTER("flutter", "PipelineDepthController",
+                    reinterpret_cast<int64_t>(this),  //
+                    "depth", depth_                   //
+  );
+
+  frame_count_ = 0;
+  serial_frame_count_ = 0;
+  slow_raster_frame_count_ = 0;
+  raster_overrun_ = fml::TimeDelta::Zero();
+  return depth_;
+}
+
+uint32_t PipelineDepthController::GetDesiredDepth() const {
+  if (serial_frame_count_ == frame_count_) {
+    // Nothing is gained by building ahead, so keep the latency low.
+    return 1;
+  }
+  if (slow_raster_frame_count_ > 0 &&
+      raster_overrun_ <= fml::TimeDelta::Zero()) {
+    // The raster thread keeps up on average but misses the budget now and
+    // then, which frames built ahead of time can hide.
+    return max_depth_;
+  }
+  // Either the UI and raster threads overlap and both keep up, or the raster
+  // thread doesn't keep up, in which case more frames in flight only add
+  // latency.
+  return std::min(2u, max_depth_);
+}
+
+}  // namespace flutter
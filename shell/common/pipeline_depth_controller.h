@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_CONTROLLER_H_
+#define FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_CONTROLLER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/flow/frame_timings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Picks the depth of the layer tree pipeline from the timings of
+///             the frames that were rasterized recently.
+///
+///             A deeper pipeline lets the UI thread build frames ahead of the
+///             raster thread, which absorbs frames that occasionally take
+///             longer than the frame budget to rasterize, at the cost of one
+///             frame of latency per frame in flight. The controller deepens
+///             the pipeline while such spikes happen and the raster thread
+///             keeps up on average, and shrinks it again once frames are
+///             built and rasterized within a single frame budget.
+///
+///             Decisions are made once per window of frames, and the depth
+///             changes by at most one per window.
+///
+class PipelineDepthController {
+ public:
+  /// The deepest pipeline the controller picks.
+  static constexpr uint32_t kMaxDepth = 3;
+
+  /// The number of frames the controller looks at before it changes the
+  /// depth.
+  static constexpr size_t kWindowSize = 16;
+
+  PipelineDepthController(uint32_t initial_depth, uint32_t max_depth);
+
+  ~PipelineDepthController();
+
+  uint32_t GetDepth() const { return depth_; }
+
+  /// Adds a frame that was rasterized and returns the new depth.
+  uint32_t AddFrame(const FrameTimingsRecorder& recorder);
+
+  /// Adds a frame with the given timings and returns the new depth.
+  uint32_t AddFrame(fml::TimeDelta frame_budget,
+                    fml::TimeDelta build_duration,
+                    fml::TimeDelta raster_duration);
+
+ private:
+  const uint32_t max_depth_;
+  uint32_t depth_;
+
+  size_t frame_count_ = 0;
+  // Frames that were built and rasterized within a single frame budget.
+  size_t serial_frame_count_ = 0;
+  // Frames that took longer than the frame budget to rasterize.
+  size_t slow_raster_frame_count_ = 0;
+  // The sum of the raster durations minus the frame budgets of the window.
+  fml::TimeDelta raster_overrun_;
+
+  uint32_t GetDesiredDepth() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineDepthController);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_CONTROLLER_H_
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_controller.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+constexpr fml::TimeDelta kBudget = fml::TimeDelta::FromMilliseconds(16);
+
+fml::TimeDelta Millis(int64_t millis) {
+  return fml::TimeDelta::FromMilliseconds(millis);
+}
+
+// Adds a window of frames where every |spike_interval|th frame takes
+// |spike| to rasterize and the others take |raster|.
+uint32_t AddWindow(PipelineDepthController& controller,
+                   fml::TimeDelta build,
+                   fml::TimeDelta raster,
+                   fml::TimeDelta spike = fml::TimeDelta::Zero(),
+                   size_t spike_interval = 0) {
+  uint32_t depth = controller.GetDepth();
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize; i++) {
+    const bool is_spike = spike_interval > 0 && i % spike_interval == 0;
+    depth = controller.AddFrame(kBudget, build, is_spike ? spike : raster);
+  }
+  return depth;
+}
+}  // namespace
+
+TEST(PipelineDepthControllerTest, DeepensPipelineForRasterSpikes) {
+  PipelineDepthController controller(2, PipelineDepthController::kMaxDepth);
+  ASSERT_EQ(controller.GetDepth(), 2u);
+
+  // The depth only changes at the end of a window.
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize - 1; i++) {
+    const fml::TimeDelta raster = i % 4 == 0 ? Millis(24) : Millis(10);
+    ASSERT_EQ(controller.AddFrame(kBudget, Millis(8), raster), 2u);
+  }
+  EXPECT_EQ(controller.AddFrame(kBudget, Millis(8), Millis(10)), 3u);
+  EXPECT_EQ(AddWindow(controller, Millis(8), Millis(10), Millis(24), 4), 3u);
+}
+
+TEST(PipelineDepthControllerTest, KeepsDepthWhenRasterCannotKeepUp) {
+  PipelineDepthController controller(2, PipelineDepthController::kMaxDepth);
+  EXPECT_EQ(AddWindow(controller, Millis(4), Millis(20)), 2u);
+
+  PipelineDepthController deep(3, PipelineDepthController::kMaxDepth);
+  EXPECT_EQ(AddWindow(deep, Millis(4), Millis(20)), 2u);
+}
+
+TEST(PipelineDepthControllerTest, ShrinksPipelineWhenFramesFitTheBudget) {
+  PipelineDepthController controller(3, PipelineDepthController::kMaxDepth);
+  EXPECT_EQ(AddWindow(controller, Millis(4), Millis(6)), 2u);
+  EXPECT_EQ(AddWindow(controller, Millis(4), Millis(6)), 1u);
+  EXPECT_EQ(AddWindow(controller, Millis(4), Millis(6)), 1u);
+
+  // Frames that only fit the budget when building and rasterizing overlap.
+  EXPECT_EQ(AddWindow(controller, Millis(10), Millis(10)), 2u);
+}
+
+TEST(PipelineDepthControllerTest, RespectsMaxDepth) {
+  PipelineDepthController controller(5, 2);
+  EXPECT_EQ(controller.GetDepth(), 2u);
+  EXPECT_EQ(AddWindow(controller, Millis(8), Millis(10), Millis(24), 4), 2u);
+}
+
+TEST(PipelineDepthControllerTest, IgnoresFramesWithoutBudget) {
+  PipelineDepthController controller(2, PipelineDepthController::kMaxDepth);
+  for (size_t i = 0; i < PipelineDepthController::kWindowSize * 2; i++) {
+    controller.AddFrame(fml::TimeDelta::Zero(), Millis(1), Millis(1));
+  }
+  EXPECT_EQ(controller.GetDepth(), 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
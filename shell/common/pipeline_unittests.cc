@@ -144,5 +144,49 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, SetDepthLimitsResourcesInFlight) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(1, 3);
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+  ASSERT_EQ(pipeline->GetMaxDepth(), 3u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepth(2);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepth(5);
+  ASSERT_EQ(pipeline->GetDepth(), 3u);
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_3);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepth(0);
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)).success);
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::Done);
+  // Two resources are still in flight, which is more than the new depth.
+  ASSERT_FALSE(pipeline->Produce());
+}
+
+TEST(PipelineTest, GetQueuedCountIgnoresPendingContinuations) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(3);
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_EQ(pipeline->GetQueuedCount(), 0u);
+
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)).success);
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)).success);
+  ASSERT_EQ(pipeline->GetQueuedCount(), 2u);
+
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(pipeline->GetQueuedCount(), 1u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -11,8 +11,11 @@ namespace flutter {
 PointerDataDispatcher::~PointerDataDispatcher() = default;
 DefaultPointerDataDispatcher::~DefaultPointerDataDispatcher() = default;
 
-SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
-    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate,
+                                                         bool coalesce_packets)
+    : DefaultPointerDataDispatcher(delegate),
+      coalesce_packets_(coalesce_packets),
+      weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
 void DefaultPointerDataDispatcher::DispatchPacket(
@@ -34,6 +37,13 @@ void SmoothPointerDataDispatcher::DispatchPacket(
   TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
 
   if (is_pointer_data_in_progress_) {
+    if (pending_packet_ != nullptr && coalesce_packets_) {
+      // The events are dispatched with the pending packet, and traced with
+      // its flow.
+      pending_packet_->Append(*packet);
+      TRACE_FLOW_END("flutter", "PointerEvent", trace_flow_id);
+      return;
+    }
     if (pending_packet_ != nullptr) {
       DispatchPendingPacket();
     }
@@ -137,9 +137,18 @@ class DefaultPointerDataDispatcher : public PointerDataDispatcher {
 /// we'll need a different solution.
 ///
 /// See also input_events_unittests.cc where we test all our claims above.
+///
+/// When constructed with |coalesce_packets|, the packets received while one is
+/// already pending are appended to it instead of forcing it out, so that the
+/// framework receives at most one packet per frame however fast the events
+/// are delivered. Every event is kept, which preserves the full resolution
+/// history of a pointer for velocity tracking and resampling. This is meant
+/// for input devices that report at many times the display refresh rate, such
+/// as pen tablets.
 class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
  public:
-  explicit SmoothPointerDataDispatcher(Delegate& delegate);
+  explicit SmoothPointerDataDispatcher(Delegate& delegate,
+                                       bool coalesce_packets = false);
 
   // |PointerDataDispatcer|
   void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
@@ -157,6 +166,7 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   std::unique_ptr<PointerDataPacket> pending_packet_;
   int pending_trace_flow_id_ = -1;
   bool is_pointer_data_in_progress_ = false;
+  const bool coalesce_packets_;
 
   // WeakPtrFactory must be the last member.
   fml::WeakPtrFactory<SmoothPointerDataDispatcher> weak_factory_;
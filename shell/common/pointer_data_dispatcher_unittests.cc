@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Records the dispatched packets, and runs the vsync callback on demand.
+class RecordingDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    dispatched_lengths.push_back(packet->GetLength());
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback_ = callback;
+  }
+
+  void Vsync() {
+    auto callback = std::move(vsync_callback_);
+    vsync_callback_ = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<size_t> dispatched_lengths;
+
+ private:
+  fml::closure vsync_callback_;
+};
+
+std::unique_ptr<PointerDataPacket> CreatePacket(size_t length) {
+  auto packet = std::make_unique<PointerDataPacket>(length);
+  for (size_t i = 0; i < length; i++) {
+    PointerData data;
+    data.Clear();
+    data.change = PointerData::Change::kMove;
+    data.physical_x = i;
+    packet->SetPointerData(i, data);
+  }
+  return packet;
+}
+
+}  // namespace
+
+TEST(SmoothPointerDataDispatcherTest, DispatchesOnePendingPacketPerFrame) {
+  RecordingDelegate delegate;
+  SmoothPointerDataDispatcher dispatcher(delegate);
+  for (size_t i = 0; i < 4; i++) {
+    dispatcher.DispatchPacket(CreatePacket(1), i);
+  }
+  // Without coalescing, a packet received while one is pending pushes it out.
+  EXPECT_EQ(delegate.dispatched_lengths, std::vector<size_t>({1, 1, 1}));
+  delegate.Vsync();
+  EXPECT_EQ(delegate.dispatched_lengths, std::vector<size_t>({1, 1, 1, 1}));
+}
+
+TEST(SmoothPointerDataDispatcherTest, CoalescesThePacketsOfAFrame) {
+  RecordingDelegate delegate;
+  SmoothPointerDataDispatcher dispatcher(delegate, /*coalesce_packets=*/true);
+  for (size_t i = 0; i < 4; i++) {
+    dispatcher.DispatchPacket(CreatePacket(2), i);
+  }
+  EXPECT_EQ(delegate.dispatched_lengths, std::vector<size_t>({2}));
+
+  // Every event of the packets received during the frame is kept.
+  delegate.Vsync();
+  EXPECT_EQ(delegate.dispatched_lengths, std::vector<size_t>({2, 6}));
+
+  delegate.Vsync();
+  dispatcher.DispatchPacket(CreatePacket(1), 4);
+  EXPECT_EQ(delegate.dispatched_lengths, std::vector<size_t>({2, 6, 1}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,13 +5,19 @@
 #include "flutter/shell/common/rasterizer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "flow/frame_timings.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/flow/raster_cache_disk_store.h"
+#include "flutter/fml/allocation_profiler.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/frame_cost_ledger.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/serialization_callbacks.h"
@@ -26,10 +32,16 @@
 #include "third_party/skia/include/core/SkSerialProcs.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "third_party/skia/include/utils/SkBase64.h"
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/entity/entity_pass.h"       // nogncheck
+#include "impeller/renderer/command_buffer.h"  // nogncheck
+#include "impeller/renderer/gpu_tracer.h"      // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 namespace flutter {
 
@@ -47,6 +59,25 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  const Settings& settings = delegate.GetSettings();
+  compositor_context_->raster_cache().SetMaxUnusedFrames(
+      settings.raster_cache_max_unused_frames);
+  if (settings.raster_cache_compress_after_frames > 0) {
+    // The images are encoded on the IO thread, like other deferred uploads.
+    compositor_context_->raster_cache().SetTextureCompression(
+        settings.raster_cache_compress_after_frames,
+        delegate.GetTaskRunners().GetIOTaskRunner());
+    std::shared_ptr<fml::UniqueFD> directory =
+        settings.enable_raster_cache_disk_store
+            ? PersistentCache::GetCacheForProcess()->GetRasterCacheDirectory()
+            : nullptr;
+    if (directory) {
+      auto disk_store = std::make_shared<RasterCacheDiskStore>(
+          std::move(directory), delegate.GetTaskRunners().GetIOTaskRunner());
+      disk_store->LoadAsync();
+      compositor_context_->raster_cache().SetDiskStore(std::move(disk_store));
+    }
+  }
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -65,6 +96,37 @@ void Rasterizer::SetImpellerContext(
   impeller_context_ = std::move(impeller_context);
 }
 
+std::shared_ptr<impeller::Context> Rasterizer::GetImpellerContext() const {
+  return impeller_context_.lock();
+}
+
+void Rasterizer::SetImpellerCaptureEnabled(bool enabled) {
+  pending_impeller_capture_enabled_ = enabled;
+}
+
+void Rasterizer::ApplyPendingImpellerCapture() {
+  if (!pending_impeller_capture_enabled_.has_value()) {
+    return;
+  }
+#if IMPELLER_SUPPORTS_RENDERING && IMPELLER_ENABLE_CAPTURE
+  if (auto context = impeller_context_.lock()) {
+    impeller::CaptureContext& capture = context->capture;
+    if (!pending_impeller_capture_enabled_.value()) {
+      capture = impeller::CaptureContext::MakeInactive();
+    } else if (!capture.IsActive()) {
+      capture = impeller::CaptureContext::MakeAllowlist(
+          {impeller::EntityPass::kCaptureDocumentName});
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING && IMPELLER_ENABLE_CAPTURE
+  pending_impeller_capture_enabled_.reset();
+}
+
+void Rasterizer::SetConcurrentPrerollTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  compositor_context_->SetConcurrentPrerollTaskRunner(std::move(task_runner));
+}
+
 void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   surface_ = std::move(surface);
 
@@ -78,6 +140,13 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->SetFrameArenaEnabled(
+        delegate_.GetSettings().enable_impeller_frame_arena);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -139,11 +208,19 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
 }
 
 void Rasterizer::NotifyLowMemoryWarning() const {
+  // Raster cache entries are rebuilt from the layer tree as they are needed.
+  compositor_context_->raster_cache().Clear();
   if (!surface_) {
     FML_DLOG(INFO)
         << "Rasterizer::NotifyLowMemoryWarning called with no surface.";
     return;
   }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->GetContentContext().PurgeCaches();
+    return;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
   auto context = surface_->GetContext();
   if (!context) {
     FML_DLOG(INFO)
@@ -206,10 +283,43 @@ RasterStatus Rasterizer::Draw(
                  .GetRasterTaskRunner()
                  ->RunsTasksOnCurrentThread());
 
+  if (!pipeline_depth_controller_ && pipeline->GetMaxDepth() > 1 &&
+      delegate_.GetSettings().enable_adaptive_frame_pipeline_depth) {
+    pipeline_depth_controller_ = std::make_unique<PipelineDepthController>(
+        pipeline->GetDepth(), pipeline->GetMaxDepth());
+  }
+  if (!gpu_backlog_policy_ &&
+      delegate_.GetSettings().enable_gpu_backlog_frame_dropping &&
+      !impeller_context_.expired()) {
+    gpu_backlog_policy_ = std::make_shared<GpuBacklogPolicy>();
+  }
+  if (!performance_hint_session_requested_ &&
+      delegate_.GetSettings().enable_thread_qos_policy) {
+    // Creating a session may fail on every frame, so it is only tried once.
+    performance_hint_session_requested_ = true;
+    performance_hint_session_ = fml::PerformanceHintSession::Create(
+        {fml::PerformanceHintSession::GetCurrentThreadId()},
+        fml::TimeDelta::FromMillisecondsF(delegate_.GetFrameBudget().count()));
+  }
+
+  // Only the raster thread consumes the pipeline, so the frames that are
+  // queued now are still queued when the next frame is consumed.
+  const bool drop_frame =
+      gpu_backlog_policy_ &&
+      gpu_backlog_policy_->ShouldDropFrame(pipeline->GetQueuedCount());
+
   DoDrawResult draw_result;
   LayerTreePipeline::Consumer consumer =
-      [&draw_result, this,
+      [&draw_result, drop_frame, this,
        &delegate = delegate_](std::unique_ptr<LayerTreeItem> item) {
+        if (drop_frame) {
+          // The GPU is still busy with previous frames and a newer frame is
+          // queued, so this one would only add latency. The last layer tree
+          // stays on screen and remains the base of the next frame's damage.
+          TRACE_EVENT0("flutter", "Rasterizer::DropStaleFrame");
+          draw_result.raster_status = RasterStatus::kDiscarded;
+          return;
+        }
         // TODO(dkwingsmt): Use a proper view ID when Rasterizer supports
         // multi-view.
         int64_t view_id = kFlutterImplicitViewId;
@@ -229,6 +339,9 @@ RasterStatus Rasterizer::Draw(
   if (consume_result == PipelineConsumeResult::NoneAvailable) {
     return RasterStatus::kFailed;
   }
+  if (pipeline_depth_controller_) {
+    pipeline->SetDepth(pipeline_depth_controller_->GetDepth());
+  }
   // if the raster status is to resubmit the frame, we push the frame to the
   // front of the queue and also change the consume status to more available.
 
@@ -270,6 +383,98 @@ RasterStatus Rasterizer::Draw(
   return draw_result.raster_status;
 }
 
+void Rasterizer::TrackGpuCompletion() {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (!gpu_backlog_policy_) {
+    return;
+  }
+  auto context = impeller_context_.lock();
+  if (!context) {
+    return;
+  }
+  // Command buffers complete in the order they are submitted, so an empty
+  // command buffer that is submitted after the frame completes once the
+  // frame has.
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return;
+  }
+  gpu_backlog_policy_->OnFrameSubmitted();
+  // Backends differ in whether the callback is called when the submission
+  // fails, so make sure the frame is only completed once.
+  auto completed = std::make_shared<std::atomic_bool>(false);
+  auto on_completed = [policy = gpu_backlog_policy_,
+                       completed](impeller::CommandBuffer::Status status) {
+    if (!completed->exchange(true)) {
+      policy->OnFrameCompleted();
+    }
+  };
+  if (!command_buffer->SubmitCommands(on_completed)) {
+    on_completed(impeller::CommandBuffer::Status::kError);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+bool Rasterizer::MarkGpuFrameStart() {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (!delegate_.GetSettings().enable_gpu_frame_timing) {
+    return false;
+  }
+  auto context = impeller_context_.lock();
+  auto gpu_tracer = context ? context->GetGPUTracer() : nullptr;
+  if (!gpu_tracer) {
+    return false;
+  }
+  gpu_tracer->SetEnabled(true);
+  gpu_tracer->MarkFrameStart();
+  return true;
+#else
+  return false;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+void Rasterizer::MarkGpuFrameEnd(std::optional<FrameTiming> timing) {
+#if IMPELLER_SUPPORTS_RENDERING
+  auto context = impeller_context_.lock();
+  auto gpu_tracer = context ? context->GetGPUTracer() : nullptr;
+  if (!gpu_tracer) {
+    if (timing.has_value()) {
+      delegate_.OnFrameRasterized(timing.value());
+    }
+    return;
+  }
+  if (!timing.has_value()) {
+    gpu_tracer->MarkFrameEnd(nullptr);
+    return;
+  }
+  gpu_tracer->MarkFrameEnd(
+      [timing = timing.value(),
+       raster_task_runner = delegate_.GetTaskRunners().GetRasterTaskRunner(),
+       weak_this = weak_factory_.GetWeakPtr()](
+          const impeller::GPUTracer::FrameResult& result) mutable {
+        timing.SetGpuDuration(result.gpu_duration);
+        // The frame may complete on a thread of the GPU driver.
+        raster_task_runner->PostTask([weak_this, timing]() {
+          if (weak_this) {
+            weak_this->delegate_.OnFrameRasterized(timing);
+          }
+        });
+      });
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+FrameTiming Rasterizer::CreateFrameTiming(
+    const FrameTimingsRecorder& frame_timings_recorder) {
+  FrameTiming timing = frame_timings_recorder.GetRecordedTime();
+  if (gpu_backlog_policy_) {
+    timing.SetDroppedFrameCount(gpu_backlog_policy_->TakeDroppedFrameCount());
+  }
+  if (frame_allocation_stats_.has_value()) {
+    timing.SetAllocationStats(frame_allocation_stats_.value());
+  }
+  return timing;
+}
+
 bool Rasterizer::ShouldResubmitFrame(const RasterStatus& raster_status) {
   return raster_status == RasterStatus::kResubmit ||
          raster_status == RasterStatus::kSkipAndRetry;
@@ -379,6 +584,14 @@ sk_sp<DlImage> Rasterizer::MakeRasterSnapshot(sk_sp<DisplayList> display_list,
   return snapshot_controller_->MakeRasterSnapshot(display_list, picture_size);
 }
 
+void Rasterizer::MakeRasterSnapshotAsync(
+    sk_sp<DisplayList> display_list,
+    SkISize picture_size,
+    std::function<void(sk_sp<DlImage>)> callback) {
+  snapshot_controller_->MakeRasterSnapshotAsync(
+      std::move(display_list), picture_size, std::move(callback));
+}
+
 sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   return snapshot_controller_->ConvertToRasterImage(image);
@@ -408,8 +621,31 @@ Rasterizer::DoDrawResult Rasterizer::DoDraw(
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
 
+  const bool measures_gpu_frame = MarkGpuFrameStart();
+  const bool profiles_allocations =
+      delegate_.GetSettings().profile_raster_allocations &&
+      fml::AllocationProfiler::IsSupported();
+  if (profiles_allocations) {
+    fml::AllocationProfiler::EnableForCurrentThread();
+    // Leave out what the raster thread allocated since the last frame.
+    fml::AllocationProfiler::TakeStats();
+  }
   RasterStatus raster_status =
       DrawToSurface(*frame_timings_recorder, *layer_tree, device_pixel_ratio);
+  if (profiles_allocations) {
+    frame_allocation_stats_ = fml::AllocationProfiler::TakeStats();
+    FML_TRACE_COUNTER("flutter", "RasterAllocations",
+                      reinterpret_cast<int64_t>(this), "Count",
+                      frame_allocation_stats_->allocation_count, "Bytes",
+                      frame_allocation_stats_->allocated_bytes);
+  }
+  const bool reports_frame = !ShouldResubmitFrame(raster_status) &&
+                             raster_status != RasterStatus::kDiscarded;
+  if (measures_gpu_frame) {
+    MarkGpuFrameEnd(reports_frame ? std::make_optional(CreateFrameTiming(
+                                        *frame_timings_recorder))
+                                  : std::nullopt);
+  }
   if (raster_status == RasterStatus::kSuccess) {
     last_layer_tree_ = std::move(layer_tree);
     last_device_pixel_ratio_ = device_pixel_ratio;
@@ -435,10 +671,28 @@ Rasterizer::DoDrawResult Rasterizer::DoDraw(
     persistent_cache->DumpSkp(*screenshot.data);
   }
 
+  const auto& settings = delegate_.GetSettings();
+  if (!settings.capture_frames_directory.empty() &&
+      captured_frame_count_ < settings.capture_frames_count) {
+    CaptureLastLayerTree(frame_timings_recorder->GetFrameNumber());
+  }
+
   // TODO(liyuqian): in Fuchsia, the rasterization doesn't finish when
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
-  delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
+  if (!measures_gpu_frame) {
+    delegate_.OnFrameRasterized(CreateFrameTiming(*frame_timings_recorder));
+  }
+  if (pipeline_depth_controller_) {
+    pipeline_depth_controller_->AddFrame(*frame_timings_recorder);
+  }
+  if (performance_hint_session_) {
+    performance_hint_session_->UpdateTargetWorkDuration(
+        fml::TimeDelta::FromMillisecondsF(delegate_.GetFrameBudget().count()));
+    performance_hint_session_->ReportActualWorkDuration(
+        frame_timings_recorder->GetRasterEndTime() -
+        frame_timings_recorder->GetRasterStartTime());
+  }
 
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
@@ -511,6 +765,12 @@ RasterStatus Rasterizer::DrawToSurface(
   TRACE_EVENT0("flutter", "Rasterizer::DrawToSurface");
   FML_DCHECK(surface_);
 
+  // Nothing is recording into the capture context between frames.
+  ApplyPendingImpellerCapture();
+
+  // Apply the newest pointer position as late as possible.
+  layer_tree.LatchPointer();
+
   RasterStatus raster_status;
   if (surface_->AllowsDrawingWhenGpuDisabled()) {
     raster_status = DrawToSurfaceUnsafe(frame_timings_recorder, layer_tree,
@@ -537,6 +797,10 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     float device_pixel_ratio) {
   FML_DCHECK(surface_);
 
+  // Attribute the expensive operations of the frame to it.
+  fml::FrameCostLedger::ScopedCurrent current_cost_ledger(
+      frame_timings_recorder.GetCostLedger());
+
   compositor_context_->ui_time().SetLapTime(
       frame_timings_recorder.GetBuildDuration());
 
@@ -584,6 +848,13 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   );
   if (compositor_frame) {
     compositor_context_->raster_cache().BeginFrame();
+    if (delegate_.GetSettings().enable_raster_cache_warm_up) {
+      // Leaves as much time to the rest of the frame as the last frame took
+      // to rasterize.
+      compositor_context_->raster_cache().SetWarmUpDeadline(
+          frame_timings_recorder.GetVsyncTargetTime() -
+          compositor_context_->raster_time().LastLap());
+    }
 
     std::unique_ptr<FrameDamage> damage;
     // when leaf layer tracing is enabled we wish to repaint the whole frame
@@ -597,6 +868,13 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       bool force_full_repaint =
           external_view_embedder_ &&
           (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
+      // Layers that are late latched move without the layer tree changing,
+      // which the diff of retained layers can't see.
+      force_full_repaint =
+          force_full_repaint ||
+          !layer_tree.pointer_late_latch_offset().isZero() ||
+          (last_layer_tree_ &&
+           !last_layer_tree_->pointer_late_latch_offset().isZero());
 
       damage = std::make_unique<FrameDamage>();
       auto existing_damage = frame->framebuffer_info().existing_damage;
@@ -609,12 +887,21 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       }
     }
 
+    // The Impeller surfaces don't enable the raster cache, which is
+    // experimental there and only used when the settings enable it.
+    const bool enable_raster_cache =
+        surface_->EnableRasterCache() ||
+        (surface_->GetAiksContext() &&
+         delegate_.GetSettings().enable_impeller_raster_cache);
     bool ignore_raster_cache = true;
-    if (surface_->EnableRasterCache() &&
-        !layer_tree.is_leaf_layer_tracing_enabled()) {
+    if (enable_raster_cache && !layer_tree.is_leaf_layer_tracing_enabled()) {
       ignore_raster_cache = false;
     }
 
+    // Ends once the frame is submitted, which is when the Impeller backends
+    // dispatch the display lists.
+    std::optional<fml::ScopedFrameCost> dispatch_cost;
+    dispatch_cost.emplace(fml::FrameCostLedger::Category::kDisplayListDispatch);
     RasterStatus raster_status =
         compositor_frame->Raster(layer_tree,           // layer tree
                                  ignore_raster_cache,  // ignore raster cache
@@ -649,6 +936,8 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     } else {
       frame->Submit();
     }
+    dispatch_cost.reset();
+    TrackGpuCompletion();
 
     // Do not update raster cache metrics for kResubmit because that status
     // indicates that the frame was not actually painted.
@@ -751,6 +1040,41 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
   return snapshot_surface->GetRasterData(compressed);
 }
 
+void Rasterizer::CaptureLastLayerTree(uint64_t frame_number) {
+  TRACE_EVENT0("flutter", "Rasterizer::CaptureLastLayerTree");
+  auto screenshot = ScreenshotLastLayerTree(ScreenshotType::SkiaPicture, false);
+  if (!screenshot.data) {
+    return;
+  }
+  captured_frame_count_++;
+
+  // Leave the disk to the IO thread so that capturing doesn't stall the
+  // next frames any longer than flattening the layer tree does.
+  delegate_.GetTaskRunners().GetIOTaskRunner()->PostTask(
+      [data = std::move(screenshot.data),
+       directory = delegate_.GetSettings().capture_frames_directory,
+       file_name = "frame_" + std::to_string(frame_number) + ".skp"]() {
+        auto directory_fd = fml::OpenDirectory(
+            directory.c_str(), true, fml::FilePermission::kReadWrite);
+        if (!directory_fd.is_valid()) {
+          FML_LOG(ERROR) << "Could not open the frame capture directory "
+                         << directory;
+          return;
+        }
+        fml::NonOwnedMapping mapping(data->bytes(), data->size());
+        if (!fml::WriteAtomically(directory_fd, file_name.c_str(), mapping)) {
+          FML_LOG(ERROR) << "Could not write the frame capture " << file_name;
+        }
+      });
+}
+
+static sk_sp<SkData> EncodeBase64(const sk_sp<SkData>& data) {
+  size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
+  auto b64_data = SkData::MakeUninitialized(b64_size);
+  SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
+  return b64_data;
+}
+
 Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
     Rasterizer::ScreenshotType type,
     bool base64_encode) {
@@ -795,15 +1119,51 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
   }
 
   if (base64_encode) {
-    size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
-    auto b64_data = SkData::MakeUninitialized(b64_size);
-    SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
-    return Rasterizer::Screenshot{b64_data, layer_tree->frame_size(), format};
+    return Rasterizer::Screenshot{EncodeBase64(data), layer_tree->frame_size(),
+                                  format};
   }
 
   return Rasterizer::Screenshot{data, layer_tree->frame_size(), format};
 }
 
+Rasterizer::Screenshot Rasterizer::EncodeScreenshot(
+    const Screenshot& screenshot,
+    ScreenshotType type,
+    bool base64_encode) {
+  TRACE_EVENT0("flutter", "Rasterizer::EncodeScreenshot");
+  FML_DCHECK(type == ScreenshotType::UncompressedImage ||
+             type == ScreenshotType::CompressedImage);
+  if (screenshot.data == nullptr) {
+    return {};
+  }
+
+  sk_sp<SkData> data = screenshot.data;
+  std::string format = screenshot.format;
+  if (type == ScreenshotType::CompressedImage) {
+    // The pixels were read back from an N32 surface, see OffscreenSurface.
+    const auto image_info = SkImageInfo::MakeN32Premul(
+        screenshot.frame_size.width(), screenshot.frame_size.height(),
+        SkColorSpace::MakeSRGB());
+    if (data->size() != image_info.computeMinByteSize()) {
+      FML_LOG(ERROR) << "Screenshot: unexpected size of the image data";
+      return {};
+    }
+    auto image =
+        SkImages::RasterFromData(image_info, data, image_info.minRowBytes());
+    data = image ? SkPngEncoder::Encode(nullptr, image.get(), {}) : nullptr;
+    if (data == nullptr) {
+      FML_LOG(ERROR) << "Screenshot: unable to compress the image";
+      return {};
+    }
+    format = "ScreenshotType::CompressedImage";
+  }
+
+  if (base64_encode) {
+    data = EncodeBase64(data);
+  }
+  return Rasterizer::Screenshot{data, screenshot.frame_size, format};
+}
+
 void Rasterizer::SetNextFrameCallback(const fml::closure& callback) {
   next_frame_callback_ = callback;
 }
@@ -842,6 +1202,9 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   }
 
   max_cache_bytes_ = max_bytes;
+  compositor_context_->raster_cache().SetMaxBytes(
+      max_bytes * delegate_.GetSettings().raster_cache_max_bytes_percentage /
+      100);
   if (!surface_) {
     return;
   }
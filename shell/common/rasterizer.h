@@ -5,6 +5,7 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <functional>
 #include <memory>
 #include <optional>
 
@@ -16,8 +17,10 @@
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
+#include "flutter/fml/allocation_profiler.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/performance_hint.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -30,7 +33,9 @@
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"  // nogncheck
 #endif  // IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/gpu_backlog_policy.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/pipeline_depth_controller.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
 #include "third_party/skia/include/core/SkData.h"
@@ -158,6 +163,33 @@ class Rasterizer final : public SnapshotDelegate,
 
   void SetImpellerContext(std::weak_ptr<impeller::Context> impeller_context);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The Impeller context the rasterizer renders with, or nullptr
+  ///             if Impeller isn't enabled.
+  ///
+  std::shared_ptr<impeller::Context> GetImpellerContext() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start or stop capturing the EntityPass document of each frame
+  ///             rendered with the Impeller context.
+  ///
+  ///             The capture context is only replaced at the start of the
+  ///             next frame, so that it doesn't change while the raster
+  ///             thread is recording into it.
+  ///
+  void SetImpellerCaptureEnabled(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the rasterizer preroll independent subtrees of the layer
+  ///             trees of frames without platform views concurrently, on
+  ///             tasks posted to |task_runner|.
+  ///
+  /// @param[in]  task_runner  The task runner, or nullptr to preroll the
+  ///                          layer trees on the raster thread only.
+  ///
+  void SetConcurrentPrerollTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
   //----------------------------------------------------------------------------
   /// @brief      Rasterizers may be created well before an on-screen surface is
   ///             available for rendering. Shells usually create a rasterizer in
@@ -193,8 +225,10 @@ class Rasterizer final : public SnapshotDelegate,
   //----------------------------------------------------------------------------
   /// @brief      Notifies the rasterizer that there is a low memory situation
   ///             and it must purge as many unnecessary resources as possible.
-  ///             Currently, the Skia context associated with onscreen rendering
-  ///             is told to free GPU resources.
+  ///             The raster cache is cleared first. Then the Skia context
+  ///             associated with onscreen rendering is told to free GPU
+  ///             resources, or with Impeller, the caches of the surface's
+  ///             content context are purged.
   ///
   void NotifyLowMemoryWarning() const;
 
@@ -393,6 +427,26 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Compresses and encodes a screenshot that was taken as a
+  ///             `ScreenshotType::UncompressedImage` without base64 encoding.
+  ///             Unlike taking the screenshot, this may be done on any thread,
+  ///             so that the raster thread only has to render the layer tree
+  ///             and read it back.
+  ///
+  /// @param[in]  screenshot     The uncompressed screenshot.
+  /// @param[in]  type           Either `ScreenshotType::UncompressedImage` or
+  ///                            `ScreenshotType::CompressedImage`.
+  /// @param[in]  base64_encode  If the screenshot data should be base64
+  ///                            encoded.
+  ///
+  /// @return     The encoded screenshot, or an empty screenshot if
+  ///             `screenshot` was empty or could not be compressed.
+  ///
+  static Screenshot EncodeScreenshot(const Screenshot& screenshot,
+                                     ScreenshotType type,
+                                     bool base64_encode);
+
   //----------------------------------------------------------------------------
   /// @brief      Sets a callback that will be executed when the next layer tree
   ///             in rendered to the on-screen surface. This is used by
@@ -534,6 +588,12 @@ class Rasterizer final : public SnapshotDelegate,
   sk_sp<DlImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
                                     SkISize picture_size) override;
 
+  // |SnapshotDelegate|
+  void MakeRasterSnapshotAsync(
+      sk_sp<DisplayList> display_list,
+      SkISize picture_size,
+      std::function<void(sk_sp<DlImage>)> callback) override;
+
   // |SnapshotDelegate|
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
@@ -555,7 +615,7 @@ class Rasterizer final : public SnapshotDelegate,
       return surface_->GetAiksContext();
     }
     if (auto context = impeller_context_.lock()) {
-      return std::make_shared<impeller::AiksContext>(
+      return impeller::AiksContext::MakeShared(
           context, impeller::TypographerContextSkia::Make());
     }
 #endif
@@ -574,6 +634,11 @@ class Rasterizer final : public SnapshotDelegate,
     return delegate_.GetIsGpuDisabledSyncSwitch();
   }
 
+  // |SnapshotController::Delegate|
+  fml::RefPtr<fml::TaskRunner> GetIOTaskRunner() const override {
+    return delegate_.GetTaskRunners().GetIOTaskRunner();
+  }
+
   sk_sp<SkData> ScreenshotLayerTreeAsImage(
       flutter::LayerTree* tree,
       flutter::CompositorContext& compositor_context,
@@ -595,11 +660,34 @@ class Rasterizer final : public SnapshotDelegate,
 
   void FireNextFrameCallbackIfPresent();
 
+  // Writes the last layer tree to the directory set by the --capture-frames
+  // switch, as an SKP named after |frame_number|.
+  void CaptureLastLayerTree(uint64_t frame_number);
+
+  // Lets the GPU backlog policy know when the GPU completes the frame that was
+  // just submitted.
+  void TrackGpuCompletion();
+
+  // Starts measuring the GPU execution time of the frame that is drawn next,
+  // if GPU frame timing is enabled and supported. Returns whether it was
+  // started, in which case |MarkGpuFrameEnd| must be called after the frame.
+  bool MarkGpuFrameStart();
+
+  // Reports |timing| once the GPU has completed the frame, if set.
+  void MarkGpuFrameEnd(std::optional<FrameTiming> timing);
+
+  FrameTiming CreateFrameTiming(
+      const FrameTimingsRecorder& frame_timings_recorder);
+
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
+  void ApplyPendingImpellerCapture();
+
   Delegate& delegate_;
   MakeGpuImageBehavior gpu_image_behavior_;
   std::weak_ptr<impeller::Context> impeller_context_;
+  // Set by |SetImpellerCaptureEnabled| until the next frame applies it.
+  std::optional<bool> pending_impeller_capture_enabled_;
   std::unique_ptr<Surface> surface_;
   std::unique_ptr<SnapshotSurfaceProducer> snapshot_surface_producer_;
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
@@ -612,6 +700,19 @@ class Rasterizer final : public SnapshotDelegate,
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  // Only set if the adaptive frame pipeline depth is enabled.
+  std::unique_ptr<PipelineDepthController> pipeline_depth_controller_;
+  // Only set if frames are dropped while the GPU is backlogged. Shared with
+  // the completion callbacks of the frames on the GPU.
+  std::shared_ptr<GpuBacklogPolicy> gpu_backlog_policy_;
+  // Only set if the thread QoS policy is enabled and the platform supports
+  // performance hints. Reports the raster time of each frame.
+  std::unique_ptr<fml::PerformanceHintSession> performance_hint_session_;
+  bool performance_hint_session_requested_ = false;
+  // The allocations of the last frame, if they are profiled.
+  std::optional<fml::AllocationProfiler::Stats> frame_allocation_stats_;
+  // The number of frames written by |CaptureLastLayerTree|.
+  size_t captured_frame_count_ = 0;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
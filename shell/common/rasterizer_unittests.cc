@@ -9,8 +9,11 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
@@ -116,6 +119,85 @@ TEST(RasterizerTest, create) {
   EXPECT_TRUE(rasterizer != nullptr);
 }
 
+TEST(RasterizerTest, RasterCachePolicyFollowsSettings) {
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.raster_cache_max_unused_frames = 5;
+  settings.raster_cache_max_bytes_percentage = 25;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto& raster_cache = rasterizer->compositor_context()->raster_cache();
+  EXPECT_EQ(raster_cache.max_unused_frames(), 5u);
+  EXPECT_EQ(raster_cache.max_bytes(), 0u);
+
+  rasterizer->SetResourceCacheMaxBytes(10000000, false);
+  EXPECT_EQ(raster_cache.max_bytes(), 2500000u);
+}
+
+TEST(RasterizerTest, RasterCacheCompressionFollowsSettings) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::IO);
+  TaskRunners task_runners("test", nullptr, nullptr, nullptr,
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+  {
+    auto rasterizer = std::make_unique<Rasterizer>(delegate);
+    EXPECT_EQ(rasterizer->compositor_context()
+                  ->raster_cache()
+                  .compress_after_frames(),
+              0u);
+  }
+  settings.raster_cache_compress_after_frames = 120;
+  {
+    auto rasterizer = std::make_unique<Rasterizer>(delegate);
+    EXPECT_EQ(rasterizer->compositor_context()
+                  ->raster_cache()
+                  .compress_after_frames(),
+              120u);
+  }
+}
+
+TEST(RasterizerTest, RasterCacheDiskStoreFollowsSettings) {
+  fml::ScopedTemporaryDirectory cache_dir;
+  PersistentCache::SetCacheDirectoryPath(cache_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::IO);
+  TaskRunners task_runners("test", nullptr, nullptr, nullptr,
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.raster_cache_compress_after_frames = 120;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+  {
+    auto rasterizer = std::make_unique<Rasterizer>(delegate);
+    EXPECT_EQ(rasterizer->compositor_context()->raster_cache().disk_store(),
+              nullptr);
+  }
+  settings.enable_raster_cache_disk_store = true;
+  {
+    auto rasterizer = std::make_unique<Rasterizer>(delegate);
+    EXPECT_NE(rasterizer->compositor_context()->raster_cache().disk_store(),
+              nullptr);
+  }
+
+  // Cleanup, once the saved images have been loaded.
+  fml::AutoResetWaitableEvent latch;
+  task_runners.GetIOTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+  PersistentCache::SetCacheDirectoryPath("");
+  PersistentCache::ResetCacheForProcess();
+  fml::RemoveFilesInDirectory(cache_dir.fd());
+}
+
 static std::unique_ptr<FrameTimingsRecorder> CreateFinishedBuildRecorder(
     fml::TimePoint timestamp) {
   std::unique_ptr<FrameTimingsRecorder> recorder =
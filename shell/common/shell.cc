@@ -23,6 +23,7 @@
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/snapshot_residency_profile.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
@@ -42,6 +43,12 @@
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/core/capture.h"        // nogncheck
+#include "impeller/entity/entity_pass.h"  // nogncheck
+#include "impeller/renderer/context.h"    // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
 constexpr char kSkiaChannel[] = "flutter/skia";
@@ -142,6 +149,54 @@ void PerformInitializationTasks(Settings& settings) {
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
 }
 
+std::unique_ptr<SnapshotResidencyProfile> ReadSnapshotResidencyProfile(
+    const std::string& path) {
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  if (!mapping || mapping->GetMapping() == nullptr) {
+    return nullptr;
+  }
+  return SnapshotResidencyProfile::Parse(
+      {reinterpret_cast<const char*>(mapping->GetMapping()),
+       mapping->GetSize()});
+}
+
+bool WriteSnapshotResidencyProfile(const std::string& path,
+                                   const SnapshotResidencyProfile& profile) {
+  std::string directory = fml::paths::GetDirectoryName(path);
+  if (directory.empty()) {
+    directory = ".";
+  }
+  auto directory_fd = fml::OpenDirectory(directory.c_str(), false,
+                                         fml::FilePermission::kReadWrite);
+  const std::string file_name = path.substr(path.rfind('/') + 1);
+  return directory_fd.is_valid() &&
+         fml::WriteAtomically(directory_fd, file_name.c_str(),
+                              fml::DataMapping(profile.Serialize()));
+}
+
+// Gets the snapshot pages that are needed during startup in flight before the
+// VM touches them, or makes sure that only the touched pages become resident
+// when the profile of those pages is being recorded.
+void PrepareSnapshotResidency(const Settings& settings,
+                              const DartSnapshot* vm_snapshot,
+                              const DartSnapshot* isolate_snapshot) {
+  if (settings.snapshot_residency_profile_path.empty() ||
+      vm_snapshot == nullptr || DartVMRef::IsInstanceRunning()) {
+    return;
+  }
+  const auto regions =
+      SnapshotResidencyProfile::GetRegions(*vm_snapshot, isolate_snapshot);
+  if (settings.record_snapshot_residency_profile) {
+    SnapshotResidencyProfile::DisableReadAhead(regions);
+    return;
+  }
+  auto profile =
+      ReadSnapshotResidencyProfile(settings.snapshot_residency_profile_path);
+  if (profile) {
+    profile->Prefetch(regions);
+  }
+}
+
 }  // namespace
 
 std::unique_ptr<Shell> Shell::Create(
@@ -155,14 +210,18 @@ std::unique_ptr<Shell> Shell::Create(
   PerformInitializationTasks(settings);
 
   TRACE_EVENT0("flutter", "Shell::Create");
+  const auto creation_begin = fml::TimePoint::Now();
 
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
   auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
   auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  PrepareSnapshotResidency(settings, vm_snapshot.get(), isolate_snapshot.get());
+  const auto vm_creation_begin = fml::TimePoint::Now();
   auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
   FML_CHECK(vm) << "Must be able to initialize the VM.";
+  const auto vm_creation_end = fml::TimePoint::Now();
 
   // If the settings did not specify an `isolate_snapshot`, fall back to the
   // one the VM was launched with.
@@ -172,17 +231,28 @@ std::unique_ptr<Shell> Shell::Create(
   auto resource_cache_limit_calculator =
       std::make_shared<ResourceCacheLimitCalculator>(
           settings.resource_cache_max_bytes_threshold);
-  return CreateWithSnapshot(platform_data,                    //
-                            task_runners,                     //
-                            /*parent_merger=*/nullptr,        //
-                            /*parent_io_manager=*/nullptr,    //
-                            resource_cache_limit_calculator,  //
-                            settings,                         //
-                            std::move(vm),                    //
-                            std::move(isolate_snapshot),      //
-                            on_create_platform_view,          //
-                            on_create_rasterizer,             //
-                            CreateEngine, is_gpu_disabled);
+  auto shell = CreateWithSnapshot(platform_data,                    //
+                                  task_runners,                     //
+                                  /*parent_merger=*/nullptr,        //
+                                  /*parent_io_manager=*/nullptr,    //
+                                  resource_cache_limit_calculator,  //
+                                  settings,                         //
+                                  std::move(vm),                    //
+                                  std::move(isolate_snapshot),      //
+                                  on_create_platform_view,          //
+                                  on_create_rasterizer,             //
+                                  CreateEngine, is_gpu_disabled);
+  if (shell) {
+    auto& metrics = *shell->startup_metrics_;
+    metrics.RecordPhaseBegin(StartupMetrics::Phase::kDartVMCreation,
+                             vm_creation_begin);
+    metrics.RecordPhaseEnd(StartupMetrics::Phase::kDartVMCreation,
+                           vm_creation_end);
+    metrics.RecordPhaseBegin(StartupMetrics::Phase::kShellCreation,
+                             creation_begin);
+    metrics.RecordPhaseEnd(StartupMetrics::Phase::kShellCreation);
+  }
+  return shell;
 }
 
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
@@ -235,6 +305,10 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        if (shell->GetSettings().enable_concurrent_preroll) {
+          rasterizer->SetConcurrentPrerollTaskRunner(
+              shell->GetConcurrentWorkerTaskRunner());
+        }
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -314,21 +388,25 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         // from the platform.
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
-
-        engine_promise.set_value(
-            on_create_engine(*shell,                          //
-                             dispatcher_maker,                //
-                             *shell->GetDartVM(),             //
-                             std::move(isolate_snapshot),     //
-                             task_runners,                    //
-                             platform_data,                   //
-                             shell->GetSettings(),            //
-                             std::move(animator),             //
-                             weak_io_manager_future.get(),    //
-                             unref_queue_future.get(),        //
-                             snapshot_delegate_future.get(),  //
-                             shell->volatile_path_tracker_,
-                             shell->is_gpu_disabled_sync_switch_));
+        animator->SetFrameStartPredictor(shell->frame_start_predictor_);
+
+        auto engine = on_create_engine(*shell,                          //
+                                       dispatcher_maker,                //
+                                       *shell->GetDartVM(),             //
+                                       std::move(isolate_snapshot),     //
+                                       task_runners,                    //
+                                       platform_data,                   //
+                                       shell->GetSettings(),            //
+                                       std::move(animator),             //
+                                       weak_io_manager_future.get(),    //
+                                       unref_queue_future.get(),        //
+                                       snapshot_delegate_future.get(),  //
+                                       shell->volatile_path_tracker_,
+                                       shell->is_gpu_disabled_sync_switch_);
+        if (engine) {
+          engine->SetPointerLateLatch(shell->pointer_late_latch_);
+        }
+        engine_promise.set_value(std::move(engine));
       }));
 
   if (!shell->Setup(std::move(platform_view),  //
@@ -427,6 +505,9 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
   display_manager_ = std::make_unique<DisplayManager>();
+  if (settings_.enable_predictive_frame_start) {
+    frame_start_predictor_ = std::make_shared<FrameStartPredictor>();
+  }
   resource_cache_limit_calculator->AddResourceCacheLimitItem(
       weak_factory_.GetWeakPtr());
 
@@ -468,6 +549,21 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetUITaskRunner(),
           std::bind(&Shell::OnServiceProtocolGetDisplayRefreshRate, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetStartupMetricsExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetStartupMetrics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameCostLedgerExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameCostLedger, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameStatisticsExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kGetSkSLsExtensionName] = {
       task_runners_.GetIOTaskRunner(),
       std::bind(&Shell::OnServiceProtocolGetSkSLs, this, std::placeholders::_1,
@@ -477,6 +573,11 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetImpellerCaptureExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetImpellerCapture, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_
       [ServiceProtocol::kRenderFrameWithRasterStatsExtensionName] = {
           task_runners_.GetRasterTaskRunner(),
@@ -500,6 +601,7 @@ Shell::~Shell() {
       task_runners_.GetUITaskRunner(),
       fml::MakeCopyable([this, &ui_latch]() mutable {
         engine_.reset();
+        thread_qos_policy_.reset();
         ui_latch.Signal();
       }));
   ui_latch.Wait();
@@ -545,7 +647,8 @@ std::unique_ptr<Shell> Shell::Spawn(
     RunConfiguration run_configuration,
     const std::string& initial_route,
     const CreateCallback<PlatformView>& on_create_platform_view,
-    const CreateCallback<Rasterizer>& on_create_rasterizer) const {
+    const CreateCallback<Rasterizer>& on_create_rasterizer,
+    const std::function<void(Engine::RunStatus)>& result_callback) const {
   FML_DCHECK(task_runners_.IsValid());
   // It's safe to store this value since it is set on the platform thread.
   bool is_gpu_disabled = false;
@@ -580,7 +683,7 @@ std::unique_ptr<Shell> Shell::Spawn(
             /*gpu_disabled_switch=*/is_gpu_disabled_sync_switch);
       },
       is_gpu_disabled);
-  result->RunEngine(std::move(run_configuration));
+  result->RunEngine(std::move(run_configuration), result_callback);
   return result;
 }
 
@@ -606,6 +709,16 @@ void Shell::NotifyLowMemoryWarning() const {
   // to purge them.
 }
 
+void Shell::PrefetchDartDeferredLibrary(intptr_t loading_unit_id) {
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [engine = weak_engine_, loading_unit_id] {
+        if (engine) {
+          engine->PrefetchDartDeferredLibrary(loading_unit_id);
+        }
+      });
+}
+
 void Shell::RunEngine(RunConfiguration run_configuration) {
   RunEngine(std::move(run_configuration), nullptr);
 }
@@ -628,14 +741,21 @@ void Shell::RunEngine(
       task_runners_.GetUITaskRunner(),
       fml::MakeCopyable(
           [run_configuration = std::move(run_configuration),
-           weak_engine = weak_engine_, result]() mutable {
+           weak_engine = weak_engine_, metrics = startup_metrics_,
+           result]() mutable {
             if (!weak_engine) {
               FML_LOG(ERROR)
                   << "Could not launch engine with configuration - no engine.";
               result(Engine::RunStatus::Failure);
               return;
             }
+            metrics->RecordPhaseBegin(
+                StartupMetrics::Phase::kRootIsolateCreation);
             auto run_result = weak_engine->Run(std::move(run_configuration));
+            if (run_result == flutter::Engine::RunStatus::Success) {
+              metrics->RecordPhaseEnd(
+                  StartupMetrics::Phase::kRootIsolateCreation);
+            }
             if (run_result == flutter::Engine::RunStatus::Failure) {
               FML_LOG(ERROR) << "Could not launch engine with configuration.";
             }
@@ -719,12 +839,15 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   engine_->AddView(kFlutterImplicitViewId, ViewportMetrics{});
   // Setup the time-consuming default font manager right after engine created.
   if (!settings_.prefetched_default_font_manager) {
-    fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                      [engine = weak_engine_] {
-                                        if (engine) {
-                                          engine->SetupDefaultFontManager();
-                                        }
-                                      });
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(),
+        [engine = weak_engine_, metrics = startup_metrics_] {
+          if (engine) {
+            metrics->RecordPhaseBegin(StartupMetrics::Phase::kFontLoading);
+            engine->SetupDefaultFontManager();
+            metrics->RecordPhaseEnd(StartupMetrics::Phase::kFontLoading);
+          }
+        });
   }
 
   is_set_up_ = true;
@@ -746,6 +869,14 @@ const Settings& Shell::GetSettings() const {
   return settings_;
 }
 
+const StartupMetrics& Shell::GetStartupMetrics() const {
+  return *startup_metrics_;
+}
+
+const FrameStatistics& Shell::GetFrameStatistics() const {
+  return frame_statistics_;
+}
+
 const TaskRunners& Shell::GetTaskRunners() const {
   return task_runners_;
 }
@@ -1040,6 +1171,8 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  Engine::AddToPointerLateLatch(*pointer_late_latch_,
+                                PointerLateLatch::Source::kPlatform, *packet);
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
@@ -1183,6 +1316,17 @@ void Shell::OnAnimatorBeginFrame(fml::TimePoint frame_target_time,
     std::scoped_lock time_recorder_lock(time_recorder_mutex_);
     latest_frame_target_time_.emplace(frame_target_time);
   }
+  if (!first_frame_began_) {
+    first_frame_began_ = true;
+    startup_metrics_->RecordPhaseBegin(StartupMetrics::Phase::kFirstFrame);
+  }
+  if (settings_.enable_thread_qos_policy) {
+    if (!thread_qos_policy_) {
+      thread_qos_policy_ = std::make_unique<ThreadQosPolicy>(
+          task_runners_.GetUITaskRunner(), task_runners_.GetRasterTaskRunner());
+    }
+    thread_qos_policy_->OnFrameBegin();
+  }
   if (engine_) {
     engine_->BeginFrame(frame_target_time, frame_number);
   }
@@ -1218,6 +1362,11 @@ void Shell::OnAnimatorUpdateLatestFrameTargetTime(
 void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
   FML_DCHECK(is_set_up_);
 
+  if (thread_qos_policy_) {
+    thread_qos_policy_->OnFrameBuilt(
+        fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count()));
+  }
+
   task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
       [&waiting_for_first_frame = waiting_for_first_frame_,
        &waiting_for_first_frame_condition = waiting_for_first_frame_condition_,
@@ -1508,10 +1657,58 @@ size_t Shell::UnreportedFramesCount() const {
   return unreported_timings_.size() / (FrameTiming::kStatisticsCount);
 }
 
+void Shell::OnFirstFrameRasterizedForSnapshotResidency() {
+  if (settings_.snapshot_residency_profile_path.empty()) {
+    return;
+  }
+  // The VM data keeps the snapshots alive while the task runs.
+  vm_->GetConcurrentWorkerTaskRunner()->PostTask(
+      [vm_data = vm_->GetVMData(),
+       path = settings_.snapshot_residency_profile_path,
+       record = settings_.record_snapshot_residency_profile]() {
+        auto isolate_snapshot = vm_data->GetIsolateSnapshot();
+        const auto regions = SnapshotResidencyProfile::GetRegions(
+            vm_data->GetVMSnapshot(), isolate_snapshot.get());
+        if (record) {
+          auto profile = SnapshotResidencyProfile::Record(regions);
+          if (!WriteSnapshotResidencyProfile(path, *profile)) {
+            FML_LOG(ERROR) << "Could not write the snapshot residency profile "
+                           << path;
+          }
+          return;
+        }
+        if (!vm_data->GetVMSnapshot().IsDontNeedSafe() ||
+            (isolate_snapshot && !isolate_snapshot->IsDontNeedSafe())) {
+          return;
+        }
+        auto profile = ReadSnapshotResidencyProfile(path);
+        if (profile) {
+          profile->ReleaseColdPages(regions);
+        }
+      });
+}
+
 void Shell::OnFrameRasterized(const FrameTiming& timing) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (!first_frame_handled_) {
+    first_frame_handled_ = true;
+    startup_metrics_->RecordPhaseEnd(StartupMetrics::Phase::kFirstFrame);
+    OnFirstFrameRasterizedForSnapshotResidency();
+  }
+
+  if (frame_start_predictor_) {
+    frame_start_predictor_->AddFrame(timing);
+  }
+
+  recent_frame_timings_.push_back(timing);
+  if (recent_frame_timings_.size() > kFrameCostLedgerHistorySize) {
+    recent_frame_timings_.pop_front();
+  }
+  frame_statistics_.AddFrame(
+      timing, fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count()));
+
   // The C++ callback defined in settings.h and set by Flutter runner. This is
   // independent of the timings report to the Dart side.
   if (settings_.frame_rasterized_callback) {
@@ -1533,6 +1730,8 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   unreported_timings_.push_back(timing.GetPictureCacheCount());
   unreported_timings_.push_back(timing.GetPictureCacheBytes());
   unreported_timings_.push_back(timing.GetFrameNumber());
+  unreported_timings_.push_back(timing.GetDroppedFrameCount());
+  unreported_timings_.push_back(timing.GetGpuDuration().ToMicroseconds());
   FML_DCHECK(unreported_timings_.size() ==
              old_count + FrameTiming::kStatisticsCount);
 
@@ -1805,6 +2004,123 @@ bool Shell::OnServiceProtocolGetDisplayRefreshRate(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetStartupMetrics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "StartupMetrics", allocator);
+  // Only the completed phases are reported. The timestamps are in the
+  // timebase of the timeline.
+  rapidjson::Value phases(rapidjson::kArrayType);
+  for (size_t i = 0; i < StartupMetrics::kPhaseCount; i++) {
+    const auto phase = static_cast<StartupMetrics::Phase>(i);
+    const auto timing = startup_metrics_->GetTiming(phase);
+    if (!timing.IsComplete()) {
+      continue;
+    }
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember("name",
+                    rapidjson::StringRef(StartupMetrics::GetPhaseName(phase)),
+                    allocator);
+    value.AddMember("beginMicros",
+                    timing.begin->ToEpochDelta().ToMicroseconds(), allocator);
+    value.AddMember("endMicros", timing.end->ToEpochDelta().ToMicroseconds(),
+                    allocator);
+    phases.PushBack(value, allocator);
+  }
+  response->AddMember("phases", phases, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetFrameCostLedger(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameCostLedger", allocator);
+  rapidjson::Value frames(rapidjson::kArrayType);
+  for (const auto& timing : recent_frame_timings_) {
+    rapidjson::Value frame(rapidjson::kObjectType);
+    frame.AddMember("frameNumber", timing.GetFrameNumber(), allocator);
+    frame.AddMember("vsyncStartMicros",
+                    timing.Get(FrameTiming::kVsyncStart)
+                        .ToEpochDelta()
+                        .ToMicroseconds(),
+                    allocator);
+    frame.AddMember("buildMicros",
+                    (timing.Get(FrameTiming::kBuildFinish) -
+                     timing.Get(FrameTiming::kBuildStart))
+                        .ToMicroseconds(),
+                    allocator);
+    frame.AddMember("rasterMicros",
+                    (timing.Get(FrameTiming::kRasterFinish) -
+                     timing.Get(FrameTiming::kRasterStart))
+                        .ToMicroseconds(),
+                    allocator);
+    rapidjson::Value costs(rapidjson::kObjectType);
+    for (size_t i = 0; i < fml::FrameCostLedger::kCategoryCount; i++) {
+      const auto category = static_cast<fml::FrameCostLedger::Category>(i);
+      costs.AddMember(
+          rapidjson::StringRef(fml::FrameCostLedger::GetCategoryName(category)),
+          timing.GetCost(category).ToMicroseconds(), allocator);
+    }
+    frame.AddMember("costMicros", costs, allocator);
+    if (const auto& stats = timing.GetAllocationStats(); stats.has_value()) {
+      rapidjson::Value allocations(rapidjson::kObjectType);
+      allocations.AddMember("count", stats->allocation_count, allocator);
+      allocations.AddMember("bytes", stats->allocated_bytes, allocator);
+      rapidjson::Value scopes(rapidjson::kArrayType);
+      for (size_t i = 0; i < stats->top_scope_count; i++) {
+        const auto& scope_stats = stats->top_scopes[i];
+        rapidjson::Value scope(rapidjson::kObjectType);
+        scope.AddMember("name", rapidjson::Value(scope_stats.name, allocator),
+                        allocator);
+        scope.AddMember("count", scope_stats.allocation_count, allocator);
+        scope.AddMember("bytes", scope_stats.allocated_bytes, allocator);
+        scopes.PushBack(scope, allocator);
+      }
+      allocations.AddMember("topScopes", scopes, allocator);
+      frame.AddMember("allocations", allocations, allocator);
+    }
+    frames.PushBack(frame, allocator);
+  }
+  response->AddMember("frames", frames, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetFrameStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  const auto snapshot = frame_statistics_.GetSnapshot();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameStatistics", allocator);
+  response->AddMember("frameCount", snapshot.frame_count, allocator);
+  response->AddMember("jankyFrameCount", snapshot.janky_frame_count,
+                      allocator);
+  response->AddMember("droppedFrameCount", snapshot.dropped_frame_count,
+                      allocator);
+  auto add_percentiles = [response, &allocator](
+                             const char* name, size_t sample_count,
+                             const FrameStatistics::Percentiles& percentiles) {
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember("sampleCount", static_cast<uint64_t>(sample_count),
+                    allocator);
+    value.AddMember("p50Micros", percentiles.p50.ToMicroseconds(), allocator);
+    value.AddMember("p90Micros", percentiles.p90.ToMicroseconds(), allocator);
+    value.AddMember("p99Micros", percentiles.p99.ToMicroseconds(), allocator);
+    response->AddMember(rapidjson::StringRef(name), value, allocator);
+  };
+  add_percentiles("build", snapshot.sample_count, snapshot.build);
+  add_percentiles("raster", snapshot.sample_count, snapshot.raster);
+  add_percentiles("gpu", snapshot.gpu_sample_count, snapshot.gpu);
+  return true;
+}
+
 double Shell::GetMainDisplayRefreshRate() {
   return display_manager_->GetMainDisplayRefreshRate();
 }
@@ -1872,6 +2188,124 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+#if IMPELLER_SUPPORTS_RENDERING && IMPELLER_ENABLE_CAPTURE
+static rapidjson::Value CapturePropertyValueToJson(
+    const impeller::CaptureProperty& property,
+    rapidjson::Document::AllocatorType& allocator) {
+  using Type = impeller::CaptureProperty::Type;
+  rapidjson::Value value(rapidjson::kArrayType);
+  switch (property.GetType()) {
+    case Type::kBoolean:
+      return rapidjson::Value(property.AsBoolean().value());
+    case Type::kInteger:
+      return rapidjson::Value(property.AsInteger().value());
+    case Type::kScalar:
+      return rapidjson::Value(property.AsScalar().value());
+    case Type::kString:
+      return rapidjson::Value(property.AsString().value(), allocator);
+    case Type::kPoint: {
+      const impeller::Point point = property.AsPoint().value();
+      value.PushBack(point.x, allocator).PushBack(point.y, allocator);
+      break;
+    }
+    case Type::kVector3: {
+      const impeller::Vector3 vector = property.AsVector3().value();
+      value.PushBack(vector.x, allocator)
+          .PushBack(vector.y, allocator)
+          .PushBack(vector.z, allocator);
+      break;
+    }
+    case Type::kRect: {
+      const impeller::Rect rect = property.AsRect().value();
+      value.PushBack(rect.GetLeft(), allocator)
+          .PushBack(rect.GetTop(), allocator)
+          .PushBack(rect.GetRight(), allocator)
+          .PushBack(rect.GetBottom(), allocator);
+      break;
+    }
+    case Type::kColor: {
+      const impeller::Color color = property.AsColor().value();
+      value.PushBack(color.red, allocator)
+          .PushBack(color.green, allocator)
+          .PushBack(color.blue, allocator)
+          .PushBack(color.alpha, allocator);
+      break;
+    }
+    case Type::kMatrix: {
+      const impeller::Matrix matrix = property.AsMatrix().value();
+      for (impeller::Scalar entry : matrix.m) {
+        value.PushBack(entry, allocator);
+      }
+      break;
+    }
+  }
+  return value;
+}
+
+static rapidjson::Value CaptureElementToJson(
+    const impeller::CaptureElement& element,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value json(rapidjson::kObjectType);
+  json.AddMember("label", rapidjson::Value(element.label, allocator),
+                 allocator);
+  rapidjson::Value properties(rapidjson::kObjectType);
+  element.properties.Iterate([&](impeller::CaptureProperty& property) {
+    properties.AddMember(rapidjson::Value(property.label, allocator),
+                         CapturePropertyValueToJson(property, allocator),
+                         allocator);
+  });
+  json.AddMember("properties", properties, allocator);
+  rapidjson::Value children(rapidjson::kArrayType);
+  element.children.Iterate([&](impeller::CaptureElement& child) {
+    children.PushBack(CaptureElementToJson(child, allocator), allocator);
+  });
+  json.AddMember("children", children, allocator);
+  return json;
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING && IMPELLER_ENABLE_CAPTURE
+
+bool Shell::OnServiceProtocolGetImpellerCapture(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+#if IMPELLER_SUPPORTS_RENDERING && IMPELLER_ENABLE_CAPTURE
+  auto context = rasterizer_->GetImpellerContext();
+  if (!context) {
+    ServiceProtocolFailureError(response, "Impeller is not enabled.");
+    return false;
+  }
+  impeller::CaptureContext& capture = context->capture;
+  bool enabled = capture.IsActive();
+  if (auto enable = params.find("enable"); enable != params.end()) {
+    if (enable->second != "true" && enable->second != "false") {
+      ServiceProtocolParameterError(response,
+                                    "'enable' must be 'true' or 'false'.");
+      return false;
+    }
+    // Takes effect at the start of the next frame.
+    enabled = enable->second == "true";
+    rasterizer_->SetImpellerCaptureEnabled(enabled);
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "ImpellerCapture", allocator);
+  response->AddMember("enabled", enabled, allocator);
+  if (capture.DoesDocumentExist(impeller::EntityPass::kCaptureDocumentName)) {
+    auto document =
+        capture.GetDocument(impeller::EntityPass::kCaptureDocumentName);
+    response->AddMember(
+        "document", CaptureElementToJson(*document.GetElement(), allocator),
+        allocator);
+  }
+  return true;
+#else
+  ServiceProtocolFailureError(
+      response, "Impeller captures are not available in this build.");
+  return false;
+#endif  // IMPELLER_SUPPORTS_RENDERING && IMPELLER_ENABLE_CAPTURE
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -2105,22 +2539,36 @@ Rasterizer::Screenshot Shell::Screenshot(
     Rasterizer::ScreenshotType screenshot_type,
     bool base64_encode) {
   TRACE_EVENT0("flutter", "Shell::Screenshot");
+  // Compressing and encoding an image can take longer than a frame, so leave
+  // them to this thread and only render and read back the image on the
+  // raster thread.
+  const bool is_image =
+      screenshot_type == Rasterizer::ScreenshotType::UncompressedImage ||
+      screenshot_type == Rasterizer::ScreenshotType::CompressedImage;
+  const auto raster_type =
+      is_image ? Rasterizer::ScreenshotType::UncompressedImage
+               : screenshot_type;
+  const bool raster_base64_encode = !is_image && base64_encode;
   fml::AutoResetWaitableEvent latch;
   Rasterizer::Screenshot screenshot;
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetRasterTaskRunner(), [&latch,                        //
                                             rasterizer = GetRasterizer(),  //
                                             &screenshot,                   //
-                                            screenshot_type,               //
-                                            base64_encode                  //
+                                            raster_type,                   //
+                                            raster_base64_encode           //
   ]() {
         if (rasterizer) {
-          screenshot = rasterizer->ScreenshotLastLayerTree(screenshot_type,
-                                                           base64_encode);
+          screenshot = rasterizer->ScreenshotLastLayerTree(
+              raster_type, raster_base64_encode);
         }
         latch.Signal();
       });
   latch.Wait();
+  if (is_image) {
+    return Rasterizer::EncodeScreenshot(screenshot, screenshot_type,
+                                        base64_encode);
+  }
   return screenshot;
 }
 
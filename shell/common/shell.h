@@ -5,6 +5,7 @@
 #ifndef SHELL_COMMON_SHELL_H_
 #define SHELL_COMMON_SHELL_H_
 
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <string_view>
@@ -36,10 +37,14 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_start_predictor.h"
+#include "flutter/shell/common/frame_statistics.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "flutter/shell/common/startup_metrics.h"
+#include "flutter/shell/common/thread_qos_policy.h"
 
 namespace flutter {
 
@@ -194,12 +199,19 @@ class Shell final : public PlatformView::Delegate,
   ///             configuration as the current Shell but it needs to be in the
   ///             same snapshot or AOT.
   ///
+  /// @param[in]  result_callback  Called on the platform thread with the
+  ///             status of running the isolate of the new Shell. May be
+  ///             nullptr.
+  ///
   /// @see        http://flutter.dev/go/multiple-engines
+  /// @see        ShellPool
   std::unique_ptr<Shell> Spawn(
       RunConfiguration run_configuration,
       const std::string& initial_route,
       const CreateCallback<PlatformView>& on_create_platform_view,
-      const CreateCallback<Rasterizer>& on_create_rasterizer) const;
+      const CreateCallback<Rasterizer>& on_create_rasterizer,
+      const std::function<void(Engine::RunStatus)>& result_callback =
+          nullptr) const;
 
   //----------------------------------------------------------------------------
   /// @brief      Starts an isolate for the given RunConfiguration.
@@ -219,6 +231,18 @@ class Shell final : public PlatformView::Delegate,
   ///
   const Settings& GetSettings() const override;
 
+  //------------------------------------------------------------------------------
+  /// @brief      The timestamps of the startup phases of this shell. Can be
+  ///             used on any thread.
+  ///
+  const StartupMetrics& GetStartupMetrics() const;
+
+  //------------------------------------------------------------------------------
+  /// @brief      The rolling statistics of the frames rasterized by this
+  ///             shell. Can be sampled on any thread.
+  ///
+  const FrameStatistics& GetFrameStatistics() const;
+
   //------------------------------------------------------------------------------
   /// @brief      If callers wish to interact directly with any shell
   ///             subcomponents, they must (on the platform thread) obtain a
@@ -286,6 +310,16 @@ class Shell final : public PlatformView::Delegate,
   ///             the rasterizer cache is purged.
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to load a deferred library that the Dart
+  ///             code is likely to need soon, while the UI thread is idle.
+  ///             The loading unit is requested and must be answered like any
+  ///             other request to load a deferred library.
+  ///
+  /// @see        `Engine::PrefetchDartDeferredLibrary`
+  ///
+  void PrefetchDartDeferredLibrary(intptr_t loading_unit_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -463,6 +497,18 @@ class Shell final : public PlatformView::Delegate,
   std::unique_ptr<Rasterizer> rasterizer_;       // on raster task runner
   std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
+  // Shared with the startup tasks that may outlive the shell.
+  std::shared_ptr<StartupMetrics> startup_metrics_ =
+      std::make_shared<StartupMetrics>();
+  // Fed on the raster thread and shared with the animator. Only set if the
+  // predictive frame start is enabled.
+  std::shared_ptr<FrameStartPredictor> frame_start_predictor_;
+  // Created on the UI thread when the first frame begins. Only set if the
+  // thread QoS policy is enabled.
+  std::unique_ptr<ThreadQosPolicy> thread_qos_policy_;
+  // Fed on the platform and UI threads, read on the raster thread.
+  std::shared_ptr<PointerLateLatch> pointer_late_latch_ =
+      std::make_shared<PointerLateLatch>();
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
@@ -484,6 +530,11 @@ class Shell final : public PlatformView::Delegate,
   uint64_t next_pointer_flow_id_ = 0;
 
   bool first_frame_rasterized_ = false;
+  // Whether the first frame began, on the UI thread, and was rasterized, on
+  // the raster thread. Unlike |first_frame_rasterized_|, these are tracked
+  // independently of the frame timings reports.
+  bool first_frame_began_ = false;
+  bool first_frame_handled_ = false;
   std::atomic<bool> waiting_for_first_frame_ = true;
   std::mutex waiting_for_first_frame_mutex_;
   std::condition_variable waiting_for_first_frame_condition_;
@@ -501,6 +552,14 @@ class Shell final : public PlatformView::Delegate,
   // here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // The timings of the last frames, with their costs, for the service
+  // protocol. Only accessed on the raster thread.
+  static constexpr size_t kFrameCostLedgerHistorySize = 120;
+  std::deque<FrameTiming> recent_frame_timings_;
+
+  // Fed on the raster thread, and sampled on any thread.
+  FrameStatistics frame_statistics_;
+
   /// Manages the displays. This class is thread safe, can be accessed from any
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -564,6 +623,10 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Releases the snapshot pages that the residency profile marks as cold, or
+  // records the profile, on a worker thread of the VM.
+  void OnFirstFrameRasterizedForSnapshotResidency();
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -744,6 +807,28 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  bool OnServiceProtocolGetStartupMetrics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the timings of the last frames that were rasterized, with the
+  // time they spent in the operations of |FrameCostLedger|, and their
+  // allocations on the raster thread if they are profiled.
+  bool OnServiceProtocolGetFrameCostLedger(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the rolling percentiles of the durations of the last frames, and
+  // the counts of the janky and dropped frames.
+  bool OnServiceProtocolGetFrameStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // The returned SkSLs are base64 encoded. Decode before storing them to files.
@@ -756,6 +841,16 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the Impeller capture of the last frames, with the pipelines,
+  // render target and encoding time of every entity. Capturing is started and
+  // stopped with the 'enable' parameter, and is only available in debug and
+  // profile builds.
+  bool OnServiceProtocolGetImpellerCapture(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Renders a frame and responds with various statistics pertaining to the
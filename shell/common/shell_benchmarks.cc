@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <vector>
+
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
 #include "flutter/runtime/dart_vm.h"
@@ -13,6 +15,56 @@
 
 namespace flutter {
 
+static Settings CreateBenchmarkSettings(const fml::UniqueFD& assets_dir,
+                                       testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = [&assets_dir]() {
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
+static std::unique_ptr<ThreadHost> CreateBenchmarkThreadHost() {
+  return std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+      "io.flutter.bench.", ThreadHost::Type::Platform |
+                               ThreadHost::Type::RASTER | ThreadHost::Type::IO |
+                               ThreadHost::Type::UI));
+}
+
+static std::unique_ptr<PlatformView> CreateBenchmarkPlatformView(
+    Shell& shell) {
+  return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+}
+
+static std::unique_ptr<Rasterizer> CreateBenchmarkRasterizer(Shell& shell) {
+  return std::make_unique<Rasterizer>(shell);
+}
+
+static std::unique_ptr<Shell> CreateBenchmarkShell(
+    const ThreadHost& thread_host,
+    const Settings& settings) {
+  TaskRunners task_runners("test",
+                           thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  return Shell::Create(flutter::PlatformData(), task_runners, settings,
+                       CreateBenchmarkPlatformView, CreateBenchmarkRasterizer);
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -24,42 +76,9 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
-
-    thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
-        "io.flutter.bench.", ThreadHost::Type::Platform |
-                                 ThreadHost::Type::RASTER |
-                                 ThreadHost::Type::IO | ThreadHost::Type::UI));
-
-    TaskRunners task_runners("test",
-                             thread_host->platform_thread->GetTaskRunner(),
-                             thread_host->raster_thread->GetTaskRunner(),
-                             thread_host->ui_thread->GetTaskRunner(),
-                             thread_host->io_thread->GetTaskRunner());
-
-    shell = Shell::Create(
-        flutter::PlatformData(), task_runners, settings,
-        [](Shell& shell) {
-          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
-        },
-        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+    thread_host = CreateBenchmarkThreadHost();
+    shell = CreateBenchmarkShell(*thread_host, settings);
   }
 
   FML_CHECK(shell);
@@ -120,4 +139,92 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+/// Measures the time it takes |Shell::Spawn| to create a shell and launch its
+/// root isolate while |state.range(0)| other spawned shells are running.
+/// Spawned shells share the threads and isolate group of the spawner, which
+/// is how embedders host many engines or views in one process.
+static void BM_ShellSpawn(benchmark::State& state) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+  auto thread_host = CreateBenchmarkThreadHost();
+  auto platform_task_runner = thread_host->platform_thread->GetTaskRunner();
+  std::unique_ptr<Shell> spawner =
+      CreateBenchmarkShell(*thread_host, settings);
+  FML_CHECK(spawner);
+
+  const auto run_configuration = [&settings]() {
+    auto configuration = RunConfiguration::InferFromSettings(settings);
+    configuration.SetEntrypoint("emptyMain");
+    return configuration;
+  };
+
+  {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        platform_task_runner, [&spawner, &run_configuration, &latch]() {
+          spawner->RunEngine(run_configuration(),
+                             [&latch](Engine::RunStatus run_status) {
+                               FML_CHECK(run_status ==
+                                         Engine::RunStatus::Success);
+                               latch.Signal();
+                             });
+        });
+    latch.Wait();
+  }
+
+  std::vector<std::unique_ptr<Shell>> spawns;
+  // Spawns a shell and waits until its root isolate is running.
+  const auto spawn = [&]() {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+      spawns.push_back(spawner->Spawn(
+          run_configuration(), "/", CreateBenchmarkPlatformView,
+          CreateBenchmarkRasterizer, [&latch](Engine::RunStatus run_status) {
+            FML_CHECK(run_status == Engine::RunStatus::Success);
+            latch.Signal();
+          }));
+      FML_CHECK(spawns.back());
+    });
+    latch.Wait();
+  };
+  // Shuts down the shells spawned after the first |count| ones.
+  const auto shutdown = [&](size_t count) {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_task_runner,
+                                      [&spawns, &latch, count]() {
+                                        spawns.resize(count);
+                                        latch.Signal();
+                                      });
+    latch.Wait();
+  };
+
+  const size_t running_count = state.range(0);
+  for (size_t i = 0; i < running_count; i++) {
+    spawn();
+  }
+
+  while (state.KeepRunning()) {
+    spawn();
+    benchmarking::ScopedPauseTiming pause(state, true);
+    shutdown(running_count);
+  }
+
+  shutdown(0);
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(platform_task_runner,
+                                    [&spawner, &latch]() {
+                                      spawner.reset();
+                                      latch.Signal();
+                                    });
+  latch.Wait();
+  thread_host.reset();
+}
+
+BENCHMARK(BM_ShellSpawn)
+    ->RangeMultiplier(4)
+    ->Range(0, 16)
+    ->Unit(benchmark::kMillisecond);
+
 }  // namespace flutter
@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shell_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ShellPool::ShellPool(
+    const Shell& spawner,
+    size_t capacity,
+    RunConfigurationFactory run_configuration_factory,
+    std::string initial_route,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer)
+    : spawner_(spawner),
+      capacity_(capacity),
+      run_configuration_factory_(std::move(run_configuration_factory)),
+      initial_route_(std::move(initial_route)),
+      on_create_platform_view_(std::move(on_create_platform_view)),
+      on_create_rasterizer_(std::move(on_create_rasterizer)),
+      weak_factory_(this) {
+  FML_DCHECK(run_configuration_factory_);
+  FML_DCHECK(spawner_.GetTaskRunners()
+                 .GetPlatformTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+}
+
+ShellPool::~ShellPool() {
+  FML_DCHECK(spawner_.GetTaskRunners()
+                 .GetPlatformTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+}
+
+void ShellPool::Fill(const fml::closure& on_filled) {
+  if (on_filled) {
+    on_filled_callbacks_.push_back(on_filled);
+  }
+  ScheduleFill();
+}
+
+std::unique_ptr<Shell> ShellPool::Take() {
+  FML_DCHECK(spawner_.GetTaskRunners()
+                 .GetPlatformTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+  std::unique_ptr<Shell> shell;
+  if (!shells_.empty()) {
+    shell = std::move(shells_.front().shell);
+    shells_.pop_front();
+  }
+  ScheduleFill();
+  return shell;
+}
+
+size_t ShellPool::GetShellCount() const {
+  return shells_.size();
+}
+
+size_t ShellPool::GetReadyShellCount() const {
+  return std::count_if(shells_.begin(), shells_.end(),
+                       [](const PooledShell& pooled) { return pooled.ready; });
+}
+
+size_t ShellPool::GetCapacity() const {
+  return capacity_;
+}
+
+void ShellPool::ScheduleFill() {
+  if (fill_scheduled_) {
+    return;
+  }
+  if (shells_.size() >= capacity_) {
+    auto callbacks = std::move(on_filled_callbacks_);
+    on_filled_callbacks_.clear();
+    for (const auto& callback : callbacks) {
+      callback();
+    }
+    return;
+  }
+  fill_scheduled_ = true;
+  spawner_.GetTaskRunners().GetPlatformTaskRunner()->PostTask(
+      [weak_pool = weak_factory_.GetWeakPtr()]() {
+        if (!weak_pool) {
+          return;
+        }
+        weak_pool->fill_scheduled_ = false;
+        if (weak_pool->shells_.size() < weak_pool->capacity_ &&
+            !weak_pool->SpawnShell()) {
+          // Stop filling instead of retrying a spawn that keeps failing.
+          return;
+        }
+        weak_pool->ScheduleFill();
+      });
+}
+
+bool ShellPool::SpawnShell() {
+  TRACE_EVENT0("flutter", "ShellPool::SpawnShell");
+  // The shell is only known once it has been spawned, so it is handed to the
+  // run callback through a shared slot.
+  auto spawned = std::make_shared<const Shell*>(nullptr);
+  auto shell = spawner_.Spawn(
+      run_configuration_factory_(), initial_route_, on_create_platform_view_,
+      on_create_rasterizer_,
+      [weak_pool = weak_factory_.GetWeakPtr(),
+       spawned](Engine::RunStatus status) {
+        if (weak_pool) {
+          weak_pool->OnShellRun(*spawned, status);
+        }
+      });
+  if (!shell) {
+    FML_LOG(ERROR) << "Could not spawn a shell for the pool.";
+    return false;
+  }
+  *spawned = shell.get();
+  shells_.push_back({.shell = std::move(shell)});
+  return true;
+}
+
+void ShellPool::OnShellRun(const Shell* shell, Engine::RunStatus status) {
+  auto found = std::find_if(shells_.begin(), shells_.end(),
+                            [shell](const PooledShell& pooled) {
+                              return pooled.shell.get() == shell;
+                            });
+  if (found == shells_.end()) {
+    // The shell has already been taken.
+    return;
+  }
+  if (status == Engine::RunStatus::Failure) {
+    FML_LOG(ERROR) << "Could not run a pooled shell.";
+    shells_.erase(found);
+    return;
+  }
+  found->ready = true;
+}
+
+}  // namespace flutter
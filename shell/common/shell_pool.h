@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SHELL_POOL_H_
+#define FLUTTER_SHELL_COMMON_SHELL_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/shell/common/run_configuration.h"
+#include "flutter/shell/common/shell.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A pool of shells that are spawned ahead of time from a running
+///             shell, so that creating a new view, for example in an
+///             add-to-app scenario, doesn't have to wait for a shell to be
+///             created and its root isolate to be launched.
+///
+///             The pooled shells are spawned with |Shell::Spawn| and share
+///             the VM, the IO manager, the font collection and the GPU
+///             context of the spawner, like any other spawned shell. They
+///             run the configuration returned by the factory of the pool
+///             with a fixed initial route.
+///
+///             The pool must be created, used and destroyed on the platform
+///             thread of the spawner, which must outlive the pool.
+///
+class ShellPool {
+ public:
+  using RunConfigurationFactory = std::function<RunConfiguration()>;
+
+  ShellPool(const Shell& spawner,
+            size_t capacity,
+            RunConfigurationFactory run_configuration_factory,
+            std::string initial_route,
+            Shell::CreateCallback<PlatformView> on_create_platform_view,
+            Shell::CreateCallback<Rasterizer> on_create_rasterizer);
+
+  ~ShellPool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Spawns shells until the pool is full. One shell is spawned
+  ///             per platform task so that the platform thread stays
+  ///             responsive.
+  ///
+  /// @param[in]  on_filled  Called on the platform thread once the pool is
+  ///                        full. Not called if the pool is destroyed first
+  ///                        or a shell could not be spawned.
+  ///
+  void Fill(const fml::closure& on_filled = nullptr);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the shell that was spawned first out of the pool, and
+  ///             schedules spawning a replacement.
+  ///
+  /// @return     A running shell, or nullptr if the pool is empty, in which
+  ///             case the caller should spawn a shell itself.
+  ///
+  std::unique_ptr<Shell> Take();
+
+  /// The number of shells in the pool.
+  size_t GetShellCount() const;
+
+  /// The number of pooled shells whose root isolate is running.
+  size_t GetReadyShellCount() const;
+
+  size_t GetCapacity() const;
+
+ private:
+  struct PooledShell {
+    std::unique_ptr<Shell> shell;
+    bool ready = false;
+  };
+
+  const Shell& spawner_;
+  const size_t capacity_;
+  const RunConfigurationFactory run_configuration_factory_;
+  const std::string initial_route_;
+  const Shell::CreateCallback<PlatformView> on_create_platform_view_;
+  const Shell::CreateCallback<Rasterizer> on_create_rasterizer_;
+  std::deque<PooledShell> shells_;
+  std::vector<fml::closure> on_filled_callbacks_;
+  bool fill_scheduled_ = false;
+
+  void ScheduleFill();
+
+  bool SpawnShell();
+
+  void OnShellRun(const Shell* shell, Engine::RunStatus status);
+
+  fml::WeakPtrFactory<ShellPool> weak_factory_;  // Must be the last member.
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShellPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SHELL_POOL_H_
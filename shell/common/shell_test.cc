@@ -283,6 +283,15 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kRenderFrameWithRasterStats:
         shell->OnServiceProtocolRenderFrameWithRasterStats(params, response);
         break;
+      case ServiceProtocolEnum::kGetStartupMetrics:
+        shell->OnServiceProtocolGetStartupMetrics(params, response);
+        break;
+      case ServiceProtocolEnum::kGetFrameStatistics:
+        shell->OnServiceProtocolGetFrameStatistics(params, response);
+        break;
+      case ServiceProtocolEnum::kGetImpellerCapture:
+        shell->OnServiceProtocolGetImpellerCapture(params, response);
+        break;
     }
     finished.set_value(true);
   });
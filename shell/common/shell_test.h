@@ -113,6 +113,9 @@ class ShellTest : public FixtureTest {
     kSetAssetBundlePath,
     kRunInView,
     kRenderFrameWithRasterStats,
+    kGetStartupMetrics,
+    kGetFrameStatistics,
+    kGetImpellerCapture,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
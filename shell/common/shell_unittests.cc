@@ -36,6 +36,7 @@
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/shell_pool.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_external_view_embedder.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -48,6 +49,7 @@
 #include "gmock/gmock.h"
 #include "third_party/rapidjson/include/rapidjson/writer.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
+#include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
 #ifdef SHELL_ENABLE_VULKAN
@@ -2195,6 +2197,53 @@ TEST_F(ShellTest, Screenshot) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ShellScreenshotMatchesRasterizerScreenshot) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent firstFrameLatch;
+  settings.frame_rasterized_callback =
+      [&firstFrameLatch](const FrameTiming& t) { firstFrameLatch.Signal(); };
+
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  LayerTreeBuilder builder = [&](const std::shared_ptr<ContainerLayer>& root) {
+    auto display_list_layer = std::make_shared<DisplayListLayer>(
+        SkPoint::Make(10, 10), MakeSizedDisplayList(80, 80), false, false);
+    root->Add(display_list_layer);
+  };
+
+  PumpOneFrame(shell.get(), 100, 100, builder);
+  firstFrameLatch.Wait();
+
+  auto screenshot =
+      shell->Screenshot(Rasterizer::ScreenshotType::CompressedImage, false);
+  EXPECT_EQ(screenshot.format, "ScreenshotType::CompressedImage");
+  EXPECT_EQ(screenshot.frame_size, SkISize::Make(100, 100));
+
+  auto fixtures_dir =
+      fml::OpenDirectory(GetFixturesPath(), false, fml::FilePermission::kRead);
+  auto reference_png = fml::FileMapping::CreateReadOnly(
+      fixtures_dir, "shelltest_screenshot.png");
+  sk_sp<SkData> reference_data = SkData::MakeWithoutCopy(
+      reference_png->GetMapping(), reference_png->GetSize());
+  ASSERT_TRUE(screenshot.data);
+  EXPECT_TRUE(reference_data->equals(screenshot.data.get()));
+
+  auto encoded =
+      shell->Screenshot(Rasterizer::ScreenshotType::CompressedImage, true);
+  ASSERT_TRUE(encoded.data);
+  size_t b64_size = SkBase64::Encode(reference_data->data(),
+                                     reference_data->size(), nullptr);
+  EXPECT_EQ(encoded.data->size(), b64_size);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, CanConvertToAndFromMappings) {
   const size_t buffer_size = 2 << 20;
 
@@ -2441,6 +2490,110 @@ TEST_F(ShellTest, OnServiceProtocolGetSkSLsWorks) {
                                 << expected_json1 << " or " << expected_json2;
 }
 
+TEST_F(ShellTest, RecordsStartupMetrics) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent rasterized_latch;
+  settings.frame_rasterized_callback =
+      [&rasterized_latch](const FrameTiming& timing) {
+        rasterized_latch.Signal();
+      };
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  const StartupMetrics& metrics = shell->GetStartupMetrics();
+  EXPECT_TRUE(
+      metrics.GetTiming(StartupMetrics::Phase::kShellCreation).IsComplete());
+  EXPECT_TRUE(
+      metrics.GetTiming(StartupMetrics::Phase::kDartVMCreation).IsComplete());
+  EXPECT_FALSE(metrics.GetTiming(StartupMetrics::Phase::kRootIsolateCreation)
+                   .begin.has_value());
+
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  rasterized_latch.Wait();
+
+  for (size_t i = 0; i < StartupMetrics::kPhaseCount; i++) {
+    const auto phase = static_cast<StartupMetrics::Phase>(i);
+    const auto timing = metrics.GetTiming(phase);
+    ASSERT_TRUE(timing.IsComplete()) << StartupMetrics::GetPhaseName(phase);
+    EXPECT_LE(timing.begin.value(), timing.end.value());
+  }
+  EXPECT_LE(metrics.GetTiming(StartupMetrics::Phase::kRootIsolateCreation).end,
+            metrics.GetTiming(StartupMetrics::Phase::kFirstFrame).begin);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetStartupMetrics,
+                    shell->GetTaskRunners().GetPlatformTaskRunner(),
+                    empty_params, &document);
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "StartupMetrics");
+  const auto& phases = document["phases"];
+  ASSERT_EQ(phases.Size(), StartupMetrics::kPhaseCount);
+  EXPECT_STREQ(phases[0]["name"].GetString(), "shellCreation");
+  EXPECT_LE(phases[0]["beginMicros"].GetInt64(),
+            phases[0]["endMicros"].GetInt64());
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, ReportsFrameStatistics) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent rasterized_latch;
+  settings.frame_rasterized_callback =
+      [&rasterized_latch](const FrameTiming& timing) {
+        rasterized_latch.Signal();
+      };
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  EXPECT_EQ(shell->GetFrameStatistics().GetSnapshot().frame_count, 0u);
+
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  rasterized_latch.Wait();
+
+  const auto snapshot = shell->GetFrameStatistics().GetSnapshot();
+  EXPECT_EQ(snapshot.frame_count, 1u);
+  EXPECT_EQ(snapshot.sample_count, 1u);
+  EXPECT_LE(snapshot.build.p50, snapshot.build.p99);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameStatistics,
+                    shell->GetTaskRunners().GetPlatformTaskRunner(),
+                    empty_params, &document);
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "FrameStatistics");
+  EXPECT_EQ(document["frameCount"].GetUint64(), 1u);
+  EXPECT_EQ(document["raster"]["sampleCount"].GetUint64(), 1u);
+  EXPECT_EQ(document["raster"]["p99Micros"].GetInt64(),
+            snapshot.raster.p99.ToMicroseconds());
+  EXPECT_TRUE(document.HasMember("gpu"));
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, GetImpellerCaptureRequiresImpeller) {
+  Settings settings = CreateSettingsForFixture();
+  settings.enable_impeller = false;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["enable"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetImpellerCapture,
+                    shell->GetTaskRunners().GetRasterTaskRunner(), params,
+                    &document);
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_TRUE(document.HasMember("code"));
+  EXPECT_FALSE(document.HasMember("type"));
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, RasterizerScreenshot) {
   Settings settings = CreateSettingsForFixture();
   auto configuration = RunConfiguration::InferFromSettings(settings);
@@ -2502,6 +2655,38 @@ TEST_F(ShellTest, RasterizerMakeRasterSnapshot) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(ShellTest, RasterizerMakeRasterSnapshotAsync) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  auto latch = std::make_shared<fml::AutoResetWaitableEvent>();
+
+  PumpOneFrame(shell.get());
+
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(), [&shell, latch]() {
+        SnapshotDelegate* delegate =
+            reinterpret_cast<Rasterizer*>(shell->GetRasterizer().get());
+        delegate->MakeRasterSnapshotAsync(
+            MakeSizedDisplayList(50, 50), SkISize::Make(50, 50),
+            [latch](sk_sp<DlImage> image) {
+              EXPECT_NE(image, nullptr);
+              latch->Signal();
+            });
+      });
+  latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+}
+
 TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   Settings settings = CreateSettingsForFixture();
   std::unique_ptr<Shell> shell = CreateShell(settings);
@@ -3294,6 +3479,68 @@ TEST_F(ShellTest, Spawn) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, ShellPoolHandsOutPreSpawnedShells) {
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  MockPlatformViewDelegate platform_view_delegate;
+  std::unique_ptr<ShellPool> pool;
+  fml::AutoResetWaitableEvent filled_latch;
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [&]() {
+    pool = std::make_unique<ShellPool>(
+        *shell, 2,
+        [&settings]() {
+          auto configuration = RunConfiguration::InferFromSettings(settings);
+          configuration.SetEntrypoint("emptyMain");
+          return configuration;
+        },
+        "/pooled",
+        [&platform_view_delegate](Shell& shell) {
+          auto result = std::make_unique<MockPlatformView>(
+              platform_view_delegate, shell.GetTaskRunners());
+          ON_CALL(*result, CreateRenderingSurface())
+              .WillByDefault(::testing::Invoke(
+                  [] { return std::make_unique<MockSurface>(); }));
+          return result;
+        },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    // Spawning happens on later platform tasks.
+    pool->Fill([&filled_latch]() { filled_latch.Signal(); });
+    EXPECT_EQ(pool->GetShellCount(), 0u);
+  });
+  filled_latch.Wait();
+
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [&]() {
+    ASSERT_EQ(pool->GetShellCount(), 2u);
+    auto first = pool->Take();
+    auto second = pool->Take();
+    ASSERT_TRUE(ValidateShell(first.get()));
+    ASSERT_TRUE(ValidateShell(second.get()));
+    EXPECT_NE(first.get(), second.get());
+    // The replacements are spawned later, so the pool is empty for now.
+    EXPECT_EQ(pool->Take(), nullptr);
+
+    PostSync(first->GetTaskRunners().GetUITaskRunner(), [&first, &shell]() {
+      EXPECT_EQ(first->GetEngine()->InitialRoute(), "/pooled");
+      EXPECT_EQ(
+          first->GetEngine()->GetRuntimeController()->GetRootIsolateGroup(),
+          shell->GetEngine()->GetRuntimeController()->GetRootIsolateGroup());
+    });
+
+    DestroyShell(std::move(first));
+    DestroyShell(std::move(second));
+    pool.reset();
+  });
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, SpawnWithDartEntrypointArgs) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_H_
 #define FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_H_
 
+#include <functional>
+
 #include "flutter/common/settings.h"
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/synchronization/sync_switch.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
 
@@ -29,6 +32,7 @@ class SnapshotController {
     GetSnapshotSurfaceProducer() const = 0;
     virtual std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
         const = 0;
+    virtual fml::RefPtr<fml::TaskRunner> GetIOTaskRunner() const = 0;
   };
 
   static std::unique_ptr<SnapshotController> Make(const Delegate& delegate,
@@ -42,6 +46,18 @@ class SnapshotController {
   virtual sk_sp<DlImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
                                             SkISize size) = 0;
 
+  // Like MakeRasterSnapshot, but calls |callback| with the image once it is
+  // rendered, possibly on another thread and after this returns. Backends that
+  // can render concurrently with the raster thread do so on the IO thread, so
+  // that snapshots don't delay frames. As with MakeRasterSnapshot, the image
+  // is not guaranteed to be UIThreadSafe.
+  //
+  // By default, the snapshot is rendered synchronously.
+  virtual void MakeRasterSnapshotAsync(
+      sk_sp<DisplayList> display_list,
+      SkISize size,
+      std::function<void(sk_sp<DlImage>)> callback);
+
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
 
  protected:
@@ -6,15 +6,25 @@
 
 #include <algorithm>
 
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/display_list/dl_dispatcher.h"
 #include "flutter/impeller/display_list/dl_image_impeller.h"
 #include "flutter/impeller/geometry/size.h"
+#include "flutter/impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "flutter/shell/common/snapshot_controller.h"
 
 namespace flutter {
 
+SnapshotControllerImpeller::~SnapshotControllerImpeller() {
+  if (io_task_runner_) {
+    // Release the IO thread's Aiks context on the thread that used it, after
+    // the snapshots that are still pending.
+    io_task_runner_->PostTask([io_state = std::move(io_state_)]() {});
+  }
+}
+
 sk_sp<DlImage> SnapshotControllerImpeller::MakeRasterSnapshot(
     sk_sp<DisplayList> display_list,
     SkISize size) {
@@ -24,47 +34,90 @@ sk_sp<DlImage> SnapshotControllerImpeller::MakeRasterSnapshot(
           .SetIfTrue([&] {
             // Do nothing.
           })
-          .SetIfFalse(
-              [&] { result = DoMakeRasterSnapshot(display_list, size); }));
+          .SetIfFalse([&] {
+            auto context = GetDelegate().GetAiksContext();
+            if (context) {
+              result = DoMakeRasterSnapshot(display_list, size, *context,
+                                            DlImage::OwningContext::kRaster);
+            }
+          }));
 
   return result;
 }
 
+void SnapshotControllerImpeller::MakeRasterSnapshotAsync(
+    sk_sp<DisplayList> display_list,
+    SkISize size,
+    std::function<void(sk_sp<DlImage>)> callback) {
+  auto aiks_context = GetDelegate().GetAiksContext();
+  auto io_task_runner = GetDelegate().GetIOTaskRunner();
+  // Metal and Vulkan contexts can record and submit commands on any thread,
+  // but a GLES context is only current on the raster thread.
+  if (!aiks_context || !io_task_runner ||
+      aiks_context->GetContext()->GetBackendType() ==
+          impeller::Context::BackendType::kOpenGLES) {
+    callback(MakeRasterSnapshot(std::move(display_list), size));
+    return;
+  }
+  io_task_runner_ = io_task_runner;
+
+  io_task_runner->PostTask(
+      [context = aiks_context->GetContext(), io_state = io_state_,
+       is_gpu_disabled_sync_switch = GetDelegate().GetIsGpuDisabledSyncSwitch(),
+       display_list = std::move(display_list), size,
+       callback = std::move(callback)]() {
+        sk_sp<DlImage> result;
+        is_gpu_disabled_sync_switch->Execute(
+            fml::SyncSwitch::Handlers().SetIfFalse([&] {
+              // Content contexts can't be shared with the raster thread, so
+              // the snapshots get one of their own.
+              if (!io_state->aiks_context ||
+                  io_state->aiks_context->GetContext() != context) {
+                io_state->aiks_context = impeller::AiksContext::MakeShared(
+                    context, impeller::TypographerContextSkia::Make());
+              }
+              if (io_state->aiks_context->IsValid()) {
+                result = DoMakeRasterSnapshot(display_list, size,
+                                              *io_state->aiks_context,
+                                              DlImage::OwningContext::kIO);
+              }
+            }));
+        callback(std::move(result));
+      });
+}
+
 sk_sp<DlImage> SnapshotControllerImpeller::DoMakeRasterSnapshot(
     const sk_sp<DisplayList>& display_list,
-    SkISize size) {
+    SkISize size,
+    impeller::AiksContext& context,
+    DlImage::OwningContext owning_context) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   impeller::DlDispatcher dispatcher;
-  display_list->Dispatch(dispatcher);
+  display_list->DispatchInline(dispatcher);
   impeller::Picture picture = dispatcher.EndRecordingAsPicture();
-  auto context = GetDelegate().GetAiksContext();
-  if (context) {
-    auto max_size = context->GetContext()
-                        ->GetResourceAllocator()
-                        ->GetMaxTextureSizeSupported();
-    double scale_factor_x =
-        static_cast<double>(max_size.width) / static_cast<double>(size.width());
-    double scale_factor_y = static_cast<double>(max_size.height) /
-                            static_cast<double>(size.height());
-    double scale_factor =
-        std::min(1.0, std::min(scale_factor_x, scale_factor_y));
-
-    auto render_target_size = impeller::ISize(size.width(), size.height());
-
-    // Scale down the render target size to the max supported by the
-    // GPU if necessary. Exceeding the max would otherwise cause a
-    // null result.
-    if (scale_factor < 1.0) {
-      render_target_size.width *= scale_factor;
-      render_target_size.height *= scale_factor;
-    }
-
-    std::shared_ptr<impeller::Image> image =
-        picture.ToImage(*context, render_target_size);
-    if (image) {
-      return impeller::DlImageImpeller::Make(image->GetTexture(),
-                                             DlImage::OwningContext::kRaster);
-    }
+  auto max_size = context.GetContext()
+                      ->GetResourceAllocator()
+                      ->GetMaxTextureSizeSupported();
+  double scale_factor_x =
+      static_cast<double>(max_size.width) / static_cast<double>(size.width());
+  double scale_factor_y = static_cast<double>(max_size.height) /
+                          static_cast<double>(size.height());
+  double scale_factor = std::min(1.0, std::min(scale_factor_x, scale_factor_y));
+
+  auto render_target_size = impeller::ISize(size.width(), size.height());
+
+  // Scale down the render target size to the max supported by the
+  // GPU if necessary. Exceeding the max would otherwise cause a
+  // null result.
+  if (scale_factor < 1.0) {
+    render_target_size.width *= scale_factor;
+    render_target_size.height *= scale_factor;
+  }
+
+  std::shared_ptr<impeller::Image> image =
+      picture.ToImage(context, render_target_size);
+  if (image) {
+    return impeller::DlImageImpeller::Make(image->GetTexture(), owning_context);
   }
 
   return nullptr;
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_IMPELLER_H_
 #define FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_IMPELLER_H_
 
+#include <memory>
+
 #include "flutter/shell/common/snapshot_controller.h"
 
 namespace flutter {
@@ -15,14 +17,34 @@ class SnapshotControllerImpeller : public SnapshotController {
       const SnapshotController::Delegate& delegate)
       : SnapshotController(delegate) {}
 
+  ~SnapshotControllerImpeller() override;
+
   sk_sp<DlImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
                                     SkISize size) override;
 
+  void MakeRasterSnapshotAsync(
+      sk_sp<DisplayList> display_list,
+      SkISize size,
+      std::function<void(sk_sp<DlImage>)> callback) override;
+
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
  private:
-  sk_sp<DlImage> DoMakeRasterSnapshot(const sk_sp<DisplayList>& display_list,
-                                      SkISize size);
+  // The Aiks context that snapshots are rendered with on the IO thread. It
+  // is kept between snapshots so that its pipelines aren't created again for
+  // each of them, and is only used and released on the IO thread.
+  struct IOState {
+    std::shared_ptr<impeller::AiksContext> aiks_context;
+  };
+
+  std::shared_ptr<IOState> io_state_ = std::make_shared<IOState>();
+  fml::RefPtr<fml::TaskRunner> io_task_runner_;
+
+  static sk_sp<DlImage> DoMakeRasterSnapshot(
+      const sk_sp<DisplayList>& display_list,
+      SkISize size,
+      impeller::AiksContext& context,
+      DlImage::OwningContext owning_context);
 
   FML_DISALLOW_COPY_AND_ASSIGN(SnapshotControllerImpeller);
 };
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_metrics.h"
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+const char* StartupMetrics::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kShellCreation:
+      return "shellCreation";
+    case Phase::kDartVMCreation:
+      return "dartVMCreation";
+    case Phase::kFontLoading:
+      return "fontLoading";
+    case Phase::kRootIsolateCreation:
+      return "rootIsolateCreation";
+    case Phase::kFirstFrame:
+      return "firstFrame";
+  }
+  FML_UNREACHABLE();
+}
+
+StartupMetrics::StartupMetrics() = default;
+
+StartupMetrics::~StartupMetrics() = default;
+
+void StartupMetrics::RecordPhaseBegin(Phase phase, fml::TimePoint time) {
+  std::scoped_lock lock(mutex_);
+  Timing& timing = timings_[static_cast<size_t>(phase)];
+  if (!timing.begin.has_value()) {
+    timing.begin = time;
+  }
+}
+
+void StartupMetrics::RecordPhaseEnd(Phase phase, fml::TimePoint time) {
+  std::scoped_lock lock(mutex_);
+  Timing& timing = timings_[static_cast<size_t>(phase)];
+  if (timing.begin.has_value() && !timing.end.has_value()) {
+    FML_DCHECK(time >= timing.begin.value());
+    timing.end = time;
+  }
+}
+
+StartupMetrics::Timing StartupMetrics::GetTiming(Phase phase) const {
+  std::scoped_lock lock(mutex_);
+  return timings_[static_cast<size_t>(phase)];
+}
+
+}  // namespace flutter
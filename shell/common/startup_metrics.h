@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_STARTUP_METRICS_H_
+#define FLUTTER_SHELL_COMMON_STARTUP_METRICS_H_
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Monotonic timestamps of the phases of the startup of a shell.
+///
+///             Phases are recorded on the threads that run them and may be
+///             read on any thread. Only the first time a phase begins and ends
+///             is recorded, so that later work of the same kind, for example
+///             a hot restart, does not overwrite the startup metrics.
+///
+class StartupMetrics {
+ public:
+  enum class Phase {
+    /// From the call to |Shell::Create| until the shell is set up. Includes
+    /// the creation of the Dart VM, the platform view, the rasterizer and the
+    /// engine on their threads.
+    kShellCreation,
+    /// The creation of the Dart VM. Close to zero if the VM was already
+    /// running.
+    kDartVMCreation,
+    /// The setup of the default font manager. Not recorded if the embedding
+    /// prefetched the default font manager, in which case it is set up as
+    /// part of the creation of the root isolate.
+    kFontLoading,
+    /// The creation of the running root isolate, until the entrypoint was
+    /// invoked.
+    kRootIsolateCreation,
+    /// From the first |Animator::BeginFrame| until the first frame has been
+    /// rasterized.
+    kFirstFrame,
+  };
+
+  static constexpr size_t kPhaseCount =
+      static_cast<size_t>(Phase::kFirstFrame) + 1;
+
+  struct Timing {
+    std::optional<fml::TimePoint> begin;
+    std::optional<fml::TimePoint> end;
+
+    bool IsComplete() const { return begin.has_value() && end.has_value(); }
+  };
+
+  /// The lower camel case name of |phase|, as used by the service protocol.
+  static const char* GetPhaseName(Phase phase);
+
+  StartupMetrics();
+
+  ~StartupMetrics();
+
+  void RecordPhaseBegin(Phase phase,
+                        fml::TimePoint time = fml::TimePoint::Now());
+
+  /// Ignored if the phase has not begun.
+  void RecordPhaseEnd(Phase phase, fml::TimePoint time = fml::TimePoint::Now());
+
+  Timing GetTiming(Phase phase) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::array<Timing, kPhaseCount> timings_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupMetrics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_STARTUP_METRICS_H_
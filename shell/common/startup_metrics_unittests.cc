@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_metrics.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+using Phase = StartupMetrics::Phase;
+
+TEST(StartupMetricsTest, RecordsTheFirstTimingOfEachPhase) {
+  StartupMetrics metrics;
+  const auto start =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(1));
+  const auto later = start + fml::TimeDelta::FromMilliseconds(10);
+
+  EXPECT_FALSE(metrics.GetTiming(Phase::kDartVMCreation).begin.has_value());
+  // Phases that have not begun can't end.
+  metrics.RecordPhaseEnd(Phase::kDartVMCreation, start);
+  EXPECT_FALSE(metrics.GetTiming(Phase::kDartVMCreation).end.has_value());
+
+  metrics.RecordPhaseBegin(Phase::kDartVMCreation, start);
+  EXPECT_FALSE(metrics.GetTiming(Phase::kDartVMCreation).IsComplete());
+  metrics.RecordPhaseEnd(Phase::kDartVMCreation, later);
+  metrics.RecordPhaseBegin(Phase::kDartVMCreation, later);
+  metrics.RecordPhaseEnd(Phase::kDartVMCreation,
+                         later + fml::TimeDelta::FromSeconds(1));
+
+  const auto timing = metrics.GetTiming(Phase::kDartVMCreation);
+  ASSERT_TRUE(timing.IsComplete());
+  EXPECT_EQ(timing.begin.value(), start);
+  EXPECT_EQ(timing.end.value(), later);
+  EXPECT_FALSE(metrics.GetTiming(Phase::kFirstFrame).begin.has_value());
+}
+
+TEST(StartupMetricsTest, PhasesHaveNames) {
+  EXPECT_STREQ(StartupMetrics::GetPhaseName(Phase::kShellCreation),
+               "shellCreation");
+  EXPECT_STREQ(StartupMetrics::GetPhaseName(Phase::kFirstFrame), "firstFrame");
+}
+
+}  // namespace testing
+}  // namespace flutter
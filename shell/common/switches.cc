@@ -383,6 +383,11 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
 
   command_line.GetOptionValue(FlagForSwitch(Switch::Route), &settings.route);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::SnapshotResidencyProfile),
+                              &settings.snapshot_residency_profile_path);
+  settings.record_snapshot_residency_profile = command_line.HasOption(
+      FlagForSwitch(Switch::RecordSnapshotResidencyProfile));
+
   std::string vm_snapshot_instr_filename;
   command_line.GetOptionValue(FlagForSwitch(Switch::VmSnapshotInstructions),
                               &vm_snapshot_instr_filename);
@@ -465,6 +470,37 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_vulkan_validation =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanValidation));
 
+  {
+    std::string present_mode;
+    if (command_line.GetOptionValue(
+            FlagForSwitch(Switch::ImpellerVulkanPresentMode), &present_mode)) {
+      if (present_mode == "fifo" || present_mode == "fifo-relaxed" ||
+          present_mode == "mailbox") {
+        settings.impeller_vulkan_present_mode = present_mode;
+      } else {
+        FML_LOG(ERROR) << "Invalid value for --impeller-vulkan-present-mode: '"
+                       << present_mode << "'. Using fifo.";
+      }
+    }
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImpellerVulkanSwapchainImageCount))) {
+    std::string image_count;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ImpellerVulkanSwapchainImageCount),
+        &image_count);
+    settings.impeller_vulkan_swapchain_image_count = std::stoi(image_count);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImpellerVulkanAcquireTimeout))) {
+    std::string acquire_timeout;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ImpellerVulkanAcquireTimeout), &acquire_timeout);
+    settings.impeller_vulkan_acquire_timeout_ms = std::stoll(acquire_timeout);
+  }
+
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
 
@@ -491,6 +527,15 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.dump_skp_on_shader_compilation =
       command_line.HasOption(FlagForSwitch(Switch::DumpSkpOnShaderCompilation));
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::CaptureFrames),
+                              &settings.capture_frames_directory);
+  if (command_line.HasOption(FlagForSwitch(Switch::CaptureFramesCount))) {
+    std::string capture_frames_count;
+    command_line.GetOptionValue(FlagForSwitch(Switch::CaptureFramesCount),
+                                &capture_frames_count);
+    settings.capture_frames_count = std::stoi(capture_frames_count);
+  }
+
   settings.cache_sksl =
       command_line.HasOption(FlagForSwitch(Switch::CacheSkSL));
 
@@ -514,6 +559,62 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheMaxUnusedFrames))) {
+    std::string raster_cache_max_unused_frames;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheMaxUnusedFrames),
+        &raster_cache_max_unused_frames);
+    settings.raster_cache_max_unused_frames =
+        std::stoi(raster_cache_max_unused_frames);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheMaxBytesPercentage))) {
+    std::string raster_cache_max_bytes_percentage;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheMaxBytesPercentage),
+        &raster_cache_max_bytes_percentage);
+    settings.raster_cache_max_bytes_percentage =
+        std::stoi(raster_cache_max_bytes_percentage);
+  }
+
+  settings.enable_impeller_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableImpellerRasterCache));
+
+  settings.enable_impeller_frame_arena =
+      command_line.HasOption(FlagForSwitch(Switch::EnableImpellerFrameArena));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheCompressAfterFrames))) {
+    std::string raster_cache_compress_after_frames;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheCompressAfterFrames),
+        &raster_cache_compress_after_frames);
+    settings.raster_cache_compress_after_frames =
+        std::stoi(raster_cache_compress_after_frames);
+  }
+
+  settings.enable_raster_cache_disk_store = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRasterCacheDiskStore));
+  settings.enable_concurrent_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableConcurrentPreroll));
+  settings.enable_raster_cache_warm_up =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRasterCacheWarmUp));
+
+  settings.enable_adaptive_frame_pipeline_depth = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptiveFramePipelineDepth));
+  settings.enable_predictive_frame_start = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePredictiveFrameStart));
+  settings.enable_gpu_backlog_frame_dropping = command_line.HasOption(
+      FlagForSwitch(Switch::EnableGpuBacklogFrameDropping));
+  settings.enable_gpu_frame_timing =
+      command_line.HasOption(FlagForSwitch(Switch::EnableGpuFrameTiming));
+  settings.enable_thread_qos_policy =
+      command_line.HasOption(FlagForSwitch(Switch::EnableThreadQosPolicy));
+  settings.profile_raster_allocations =
+      command_line.HasOption(FlagForSwitch(Switch::ProfileRasterAllocations));
+
   if (command_line.HasOption(FlagForSwitch(Switch::MsaaSamples))) {
     std::string msaa_samples;
     command_line.GetOptionValue(FlagForSwitch(Switch::MsaaSamples),
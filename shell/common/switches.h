@@ -181,6 +181,15 @@ DEF_SWITCH(DumpSkpOnShaderCompilation,
            "Automatically dump the skp that triggers new shader compilations. "
            "This is useful for writing custom ShaderWarmUp to reduce jank. "
            "By default, this is not enabled to reduce the overhead. ")
+DEF_SWITCH(CaptureFrames,
+           "capture-frames",
+           "Write each rasterized frame, including the pictures and images it "
+           "draws, to the given directory as an SKP. The captures can be "
+           "replayed and timed with Skia's nanobench and viewer tools.")
+DEF_SWITCH(CaptureFramesCount,
+           "capture-frames-count",
+           "The number of frames written by --capture-frames. Defaults to "
+           "100.")
 DEF_SWITCH(CacheSkSL,
            "cache-sksl",
            "Only cache the shader in SkSL instead of binary or GLSL. This "
@@ -213,6 +222,17 @@ DEF_SWITCH(PrefetchedDefaultFontManager,
            "prefetched-default-font-manager",
            "Indicates whether the embedding started a prefetch of the "
            "default font manager before creating the engine.")
+DEF_SWITCH(SnapshotResidencyProfile,
+           "snapshot-residency-profile",
+           "Path to a profile of the snapshot pages that are touched during "
+           "startup. The profiled pages are read ahead at launch and the "
+           "others are released after the first frame. Only used on Linux "
+           "and Android.")
+DEF_SWITCH(RecordSnapshotResidencyProfile,
+           "record-snapshot-residency-profile",
+           "Record the profile given by --snapshot-residency-profile after "
+           "the first frame instead of using it. Should be used on a cold "
+           "page cache.")
 DEF_SWITCH(VerboseLogging,
            "verbose-logging",
            "By default, only errors are logged. This flag enabled logging at "
@@ -257,6 +277,76 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(RasterCacheMaxUnusedFrames,
+           "raster-cache-max-unused-frames",
+           "The number of frames that the raster cache keeps an entry for "
+           "after the last frame that used it. Defaults to 0.")
+DEF_SWITCH(RasterCacheMaxBytesPercentage,
+           "raster-cache-max-bytes-percentage",
+           "The percentage of the resource cache limit that raster cache "
+           "images may use, or 0 for unlimited. Defaults to 0.")
+DEF_SWITCH(EnableImpellerRasterCache,
+           "enable-impeller-raster-cache",
+           "Experimental: cache layers and display lists in the raster cache "
+           "when rendering with Impeller.")
+DEF_SWITCH(EnableImpellerFrameArena,
+           "enable-impeller-frame-arena",
+           "Experimental: allocate the contents that Impeller records for "
+           "each frame from a linear allocator that is reused by later "
+           "frames.")
+DEF_SWITCH(RasterCacheCompressAfterFrames,
+           "raster-cache-compress-after-frames",
+           "The number of frames after which the raster cache compresses the "
+           "images of its entries to save memory, or 0 to never compress "
+           "them. Only used by Impeller. Defaults to 0.")
+DEF_SWITCH(EnableRasterCacheDiskStore,
+           "enable-raster-cache-disk-store",
+           "Save the compressed images of static display lists in the "
+           "persistent cache directory, and reuse them on later launches "
+           "instead of rasterizing them again. Only used along with "
+           "--raster-cache-compress-after-frames.")
+DEF_SWITCH(EnableConcurrentPreroll,
+           "enable-concurrent-preroll",
+           "Experimental: preroll the independent subtrees of the layer trees "
+           "of frames without platform views on the concurrent worker "
+           "threads.")
+DEF_SWITCH(EnableRasterCacheWarmUp,
+           "enable-raster-cache-warm-up",
+           "Rasterize the display lists that scrolling is about to bring into "
+           "view into the raster cache before they are visible, when frames "
+           "have time to spare.")
+DEF_SWITCH(EnableAdaptiveFramePipelineDepth,
+           "enable-adaptive-frame-pipeline-depth",
+           "Adapt the number of frames that the UI thread may build ahead of "
+           "the raster thread to the recent frame timings.")
+DEF_SWITCH(EnablePredictiveFrameStart,
+           "enable-predictive-frame-start",
+           "Delay the start of building a frame after vsync by as much as the "
+           "recent frame timings allow, to reduce the latency from input to "
+           "display.")
+DEF_SWITCH(EnableGpuBacklogFrameDropping,
+           "enable-gpu-backlog-frame-dropping",
+           "Skip rendering frames that already have a newer frame queued "
+           "behind them while the GPU is still busy with previous frames. "
+           "Only used with Impeller.")
+DEF_SWITCH(EnableGpuFrameTiming,
+           "enable-gpu-frame-timing",
+           "Measure the GPU execution time of each frame and of each of its "
+           "command buffers with GPU timestamps, and report it in the frame "
+           "timings and the timeline. Only used with Impeller on Metal and "
+           "Vulkan.")
+DEF_SWITCH(EnableThreadQosPolicy,
+           "enable-thread-qos-policy",
+           "Pin the UI and raster threads to the performance cores while "
+           "frames are being produced, and report the raster deadlines to "
+           "the CPU frequency governor with uclamp and the Android "
+           "performance hint API. Only used on Linux and Android.")
+DEF_SWITCH(ProfileRasterAllocations,
+           "profile-raster-allocations",
+           "Count the heap allocations of the raster thread in each frame by "
+           "trace event, and report them with the frame cost ledger of the "
+           "service protocol and on the timeline. Only supported by engines "
+           "built with flutter_enable_allocation_profiler.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -270,6 +360,21 @@ DEF_SWITCH(EnableVulkanValidation,
            "Enable loading Vulkan validation layers. The layers must be "
            "available to the application and loadable. On non-Vulkan backends, "
            "this flag does nothing.")
+DEF_SWITCH(ImpellerVulkanPresentMode,
+           "impeller-vulkan-present-mode",
+           "The present mode of the Vulkan swapchains used by Impeller. One of "
+           "`fifo` (the default), `fifo-relaxed` or `mailbox`. Surfaces that "
+           "don't support the mode use `fifo`.")
+DEF_SWITCH(ImpellerVulkanSwapchainImageCount,
+           "impeller-vulkan-swapchain-image-count",
+           "The number of images of the Vulkan swapchains used by Impeller. "
+           "Clamped to the range supported by the surface. Defaults to one "
+           "more than the minimum of the surface.")
+DEF_SWITCH(ImpellerVulkanAcquireTimeout,
+           "impeller-vulkan-acquire-timeout",
+           "How many milliseconds the raster thread may wait for the next "
+           "Vulkan swapchain image used by Impeller before it drops the "
+           "frame.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
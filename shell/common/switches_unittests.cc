@@ -115,6 +115,159 @@ TEST(SwitchesTest, NoEnableImpeller) {
   }
 }
 
+TEST(SwitchesTest, RasterCacheEvictionPolicy) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_max_unused_frames, 0u);
+    EXPECT_EQ(settings.raster_cache_max_bytes_percentage, 0u);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--raster-cache-max-unused-frames=30",
+         "--raster-cache-max-bytes-percentage=25"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_max_unused_frames, 30u);
+    EXPECT_EQ(settings.raster_cache_max_bytes_percentage, 25u);
+  }
+}
+
+TEST(SwitchesTest, EnableImpellerRasterCache) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.enable_impeller_raster_cache);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--enable-impeller-raster-cache"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.enable_impeller_raster_cache);
+  }
+}
+
+TEST(SwitchesTest, EnableImpellerFrameArena) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.enable_impeller_frame_arena);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--enable-impeller-frame-arena"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.enable_impeller_frame_arena);
+  }
+}
+
+TEST(SwitchesTest, RasterCacheCompressAfterFrames) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_compress_after_frames, 0u);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--raster-cache-compress-after-frames=120"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_compress_after_frames, 120u);
+  }
+}
+
+TEST(SwitchesTest, EnableRasterCacheDiskStore) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.enable_raster_cache_disk_store);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--enable-raster-cache-disk-store"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.enable_raster_cache_disk_store);
+  }
+}
+
+TEST(SwitchesTest, EnableConcurrentPreroll) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.enable_concurrent_preroll);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--enable-concurrent-preroll"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.enable_concurrent_preroll);
+  }
+}
+
+TEST(SwitchesTest, EnableRasterCacheWarmUp) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.enable_raster_cache_warm_up);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--enable-raster-cache-warm-up"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.enable_raster_cache_warm_up);
+  }
+}
+
+TEST(SwitchesTest, CaptureFrames) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.capture_frames_directory.empty());
+    EXPECT_EQ(settings.capture_frames_count, 100u);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--capture-frames=/tmp/frames",
+         "--capture-frames-count=10"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.capture_frames_directory, "/tmp/frames");
+    EXPECT_EQ(settings.capture_frames_count, 10u);
+  }
+}
+
+TEST(SwitchesTest, ImpellerVulkanSwapchain) {
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.impeller_vulkan_present_mode.has_value());
+    EXPECT_EQ(settings.impeller_vulkan_swapchain_image_count, 0u);
+    EXPECT_EQ(settings.impeller_vulkan_acquire_timeout_ms, 0);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--impeller-vulkan-present-mode=mailbox",
+         "--impeller-vulkan-swapchain-image-count=4",
+         "--impeller-vulkan-acquire-timeout=16"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.impeller_vulkan_present_mode, "mailbox");
+    EXPECT_EQ(settings.impeller_vulkan_swapchain_image_count, 4u);
+    EXPECT_EQ(settings.impeller_vulkan_acquire_timeout_ms, 16);
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--impeller-vulkan-present-mode=immediate"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.impeller_vulkan_present_mode.has_value());
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
 
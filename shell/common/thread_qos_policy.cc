@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/thread_qos_policy.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "flutter/fml/cpu_affinity.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// The minimum and maximum utilization out of 1024 the scheduler assumes for
+// an active thread. The minimum selects a frequency of about half the maximum
+// as soon as the thread is runnable.
+constexpr uint32_t kActiveMinUtilization = 512;
+constexpr uint32_t kMaxUtilization = 1024;
+
+// The number of policies that request the active mode for this thread.
+thread_local size_t active_request_count = 0;
+
+}  // namespace
+
+void ThreadQosPolicy::ApplyToCurrentThread(Mode mode) {
+  switch (mode) {
+    case Mode::kActive:
+      if (active_request_count++ > 0) {
+        return;
+      }
+      fml::RequestAffinity(fml::CpuAffinity::kPerformance);
+      fml::RequestUtilizationClamp(kActiveMinUtilization, kMaxUtilization);
+      break;
+    case Mode::kIdle:
+      FML_DCHECK(active_request_count > 0);
+      if (--active_request_count > 0) {
+        return;
+      }
+      fml::RequestAffinity(fml::CpuAffinity::kAll);
+      fml::RequestUtilizationClamp(0, kMaxUtilization);
+      break;
+  }
+}
+
+ThreadQosPolicy::ThreadQosPolicy(
+    fml::RefPtr<fml::TaskRunner> ui_task_runner,
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    fml::TimeDelta idle_timeout,
+    ModeCallback mode_callback)
+    : ui_task_runner_(std::move(ui_task_runner)),
+      raster_task_runner_(std::move(raster_task_runner)),
+      idle_timeout_(idle_timeout),
+      mode_callback_(std::move(mode_callback)),
+      weak_factory_(this) {
+  FML_DCHECK(ui_task_runner_ && raster_task_runner_);
+}
+
+ThreadQosPolicy::~ThreadQosPolicy() {
+  FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
+  SetMode(Mode::kIdle);
+}
+
+void ThreadQosPolicy::OnFrameBegin() {
+  FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
+  last_frame_begin_time_ = fml::TimePoint::Now();
+  is_building_frame_ = true;
+  SetMode(Mode::kActive);
+  if (!idle_check_pending_) {
+    ScheduleIdleCheck(last_frame_begin_time_ + idle_timeout_);
+  }
+}
+
+void ThreadQosPolicy::OnFrameBuilt(fml::TimeDelta frame_budget) {
+  FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
+  // The framework may render scenes outside of frames.
+  if (!is_building_frame_) {
+    return;
+  }
+  is_building_frame_ = false;
+  if (!performance_hint_session_requested_) {
+    // Creating a session may fail on every frame, so it is only tried once.
+    performance_hint_session_requested_ = true;
+    performance_hint_session_ = fml::PerformanceHintSession::Create(
+        {fml::PerformanceHintSession::GetCurrentThreadId()}, frame_budget);
+  }
+  if (performance_hint_session_) {
+    performance_hint_session_->UpdateTargetWorkDuration(frame_budget);
+    performance_hint_session_->ReportActualWorkDuration(
+        fml::TimePoint::Now() - last_frame_begin_time_);
+  }
+}
+
+void ThreadQosPolicy::SetMode(Mode mode) {
+  if (mode == mode_) {
+    return;
+  }
+  TRACE_EVENT1("flutter", "ThreadQosPolicy::SetMode", "active",
+               mode == Mode::kActive ? "true" : "false");
+  mode_ = mode;
+  mode_callback_(mode);
+  // The callback is copied since the policy may be gone by the time the task
+  // runs. The raster thread may be the UI thread, for example in tests.
+  raster_task_runner_->PostTask(
+      [mode, mode_callback = mode_callback_]() { mode_callback(mode); });
+}
+
+void ThreadQosPolicy::ScheduleIdleCheck(fml::TimePoint target_time) {
+  idle_check_pending_ = true;
+  ui_task_runner_->PostTaskForTime(
+      [weak = weak_factory_.GetWeakPtr()]() {
+        if (weak) {
+          weak->OnIdleCheck();
+        }
+      },
+      target_time);
+}
+
+void ThreadQosPolicy::OnIdleCheck() {
+  idle_check_pending_ = false;
+  // The check is not rescheduled on every frame, so frames may have begun
+  // since it was.
+  const fml::TimePoint idle_time = last_frame_begin_time_ + idle_timeout_;
+  if (fml::TimePoint::Now() < idle_time) {
+    ScheduleIdleCheck(idle_time);
+    return;
+  }
+  SetMode(Mode::kIdle);
+}
+
+}  // namespace flutter
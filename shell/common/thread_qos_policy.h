@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_THREAD_QOS_POLICY_H_
+#define FLUTTER_SHELL_COMMON_THREAD_QOS_POLICY_H_
+
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/performance_hint.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Moves the UI and raster threads to the performance cores of
+///             heterogeneous CPUs while frames are being produced, and back
+///             once no frame began for a while.
+///
+///             Thread priorities alone do not keep the raster thread off the
+///             efficiency cores, so an active thread is pinned to the fastest
+///             cores and given a minimum utilization clamp for the frequency
+///             governor to ramp up as soon as it runs. An idle thread may run
+///             on any core again without a clamp, so that idle apps do not
+///             keep the big cores awake.
+///
+///             The policy must be used on the UI thread.
+///
+class ThreadQosPolicy {
+ public:
+  enum class Mode {
+    kIdle,
+    kActive,
+  };
+
+  /// Applies a mode to the calling thread.
+  using ModeCallback = std::function<void(Mode)>;
+
+  /// How long after the last frame began the threads become idle.
+  static constexpr fml::TimeDelta kDefaultIdleTimeout =
+      fml::TimeDelta::FromMilliseconds(100);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Requests |mode| for the calling thread. A thread that is
+  ///             shared by several shells stays active while any of them
+  ///             requests it. Only has an effect on Linux and Android.
+  ///
+  static void ApplyToCurrentThread(Mode mode);
+
+  ThreadQosPolicy(fml::RefPtr<fml::TaskRunner> ui_task_runner,
+                  fml::RefPtr<fml::TaskRunner> raster_task_runner,
+                  fml::TimeDelta idle_timeout = kDefaultIdleTimeout,
+                  ModeCallback mode_callback = &ApplyToCurrentThread);
+
+  /// Returns the threads to the idle mode if they are active.
+  ~ThreadQosPolicy();
+
+  /// Called when the animator begins a frame.
+  void OnFrameBegin();
+
+  /// Called when the animator has produced the layer tree of the frame that
+  /// began last. The time the UI thread spent on it is reported to a
+  /// performance hint session against |frame_budget|, as the rasterizer does
+  /// for the raster thread.
+  void OnFrameBuilt(fml::TimeDelta frame_budget);
+
+  Mode GetMode() const { return mode_; }
+
+ private:
+  const fml::RefPtr<fml::TaskRunner> ui_task_runner_;
+  const fml::RefPtr<fml::TaskRunner> raster_task_runner_;
+  const fml::TimeDelta idle_timeout_;
+  const ModeCallback mode_callback_;
+  Mode mode_ = Mode::kIdle;
+  fml::TimePoint last_frame_begin_time_;
+  bool idle_check_pending_ = false;
+  bool is_building_frame_ = false;
+  std::unique_ptr<fml::PerformanceHintSession> performance_hint_session_;
+  bool performance_hint_session_requested_ = false;
+
+  void SetMode(Mode mode);
+
+  void ScheduleIdleCheck(fml::TimePoint target_time);
+
+  void OnIdleCheck();
+
+  fml::WeakPtrFactory<ThreadQosPolicy> weak_factory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadQosPolicy);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_THREAD_QOS_POLICY_H_
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/thread_qos_policy.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ThreadQosPolicyTest, ThreadsAreActiveUntilFramesStop) {
+  fml::Thread ui_thread("ui");
+  fml::Thread raster_thread("raster");
+  auto ui_task_runner = ui_thread.GetTaskRunner();
+  auto raster_task_runner = raster_thread.GetTaskRunner();
+
+  std::mutex mutex;
+  std::vector<ThreadQosPolicy::Mode> ui_changes;
+  std::vector<ThreadQosPolicy::Mode> raster_changes;
+  // Both threads become active, then idle.
+  fml::CountDownLatch changed(4);
+  auto mode_callback = [&](ThreadQosPolicy::Mode mode) {
+    {
+      std::scoped_lock lock(mutex);
+      if (ui_task_runner->RunsTasksOnCurrentThread()) {
+        ui_changes.push_back(mode);
+      } else if (raster_task_runner->RunsTasksOnCurrentThread()) {
+        raster_changes.push_back(mode);
+      }
+    }
+    changed.CountDown();
+  };
+
+  std::unique_ptr<ThreadQosPolicy> policy;
+  fml::AutoResetWaitableEvent latch;
+  ui_task_runner->PostTask([&]() {
+    policy = std::make_unique<ThreadQosPolicy>(
+        ui_task_runner, raster_task_runner,
+        fml::TimeDelta::FromMilliseconds(10), mode_callback);
+    policy->OnFrameBegin();
+    EXPECT_EQ(policy->GetMode(), ThreadQosPolicy::Mode::kActive);
+    policy->OnFrameBegin();
+    latch.Signal();
+  });
+  latch.Wait();
+  changed.Wait();
+
+  ui_task_runner->PostTask([&]() {
+    EXPECT_EQ(policy->GetMode(), ThreadQosPolicy::Mode::kIdle);
+    policy.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+
+  const std::vector<ThreadQosPolicy::Mode> expected_changes = {
+      ThreadQosPolicy::Mode::kActive,
+      ThreadQosPolicy::Mode::kIdle,
+  };
+  std::scoped_lock lock(mutex);
+  EXPECT_EQ(ui_changes, expected_changes);
+  EXPECT_EQ(raster_changes, expected_changes);
+}
+
+}  // namespace testing
+}  // namespace flutter
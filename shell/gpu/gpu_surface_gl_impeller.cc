@@ -4,6 +4,7 @@
 
 #include "flutter/shell/gpu/gpu_surface_gl_impeller.h"
 
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/fml/make_copyable.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/renderer/backend/gles/surface_gles.h"
@@ -29,7 +30,7 @@ GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(
+  auto aiks_context = impeller::AiksContext::MakeShared(
       context, impeller::TypographerContextSkia::Make());
 
   if (!aiks_context->IsValid()) {
@@ -59,16 +60,19 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
     return nullptr;
   }
 
-  auto swap_callback = [weak = weak_factory_.GetWeakPtr(),
-                        delegate = delegate_]() -> bool {
+  // Filled in by the submit callback, before the surface is presented.
+  auto submit_info = std::make_shared<SurfaceFrame::SubmitInfo>();
+
+  auto swap_callback = [weak = weak_factory_.GetWeakPtr(), delegate = delegate_,
+                        submit_info]() -> bool {
     if (weak) {
       GLPresentInfo present_info = {
           .fbo_id = 0u,
-          .frame_damage = std::nullopt,
+          .frame_damage = submit_info->frame_damage,
           // TODO (https://github.com/flutter/flutter/issues/105597): wire-up
           // presentation time to impeller backend.
           .presentation_time = std::nullopt,
-          .buffer_damage = std::nullopt,
+          .buffer_damage = submit_info->buffer_damage,
       };
       delegate->GLContextPresent(present_info);
     }
@@ -93,9 +97,22 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
       impeller::ISize{size.width(), size.height()}  // fbo_size
   );
 
+  SurfaceFrame::FramebufferInfo framebuffer_info =
+      delegate_->GLContextFramebufferInfo();
+  if (!framebuffer_info.existing_damage.has_value()) {
+    framebuffer_info.existing_damage = fbo_info.existing_damage;
+  }
+  // Partial repaints are rendered offscreen and blitted into the FBO, which
+  // requires glBlitFramebuffer.
+  if (!impeller_context_->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    framebuffer_info.supports_partial_repaint = false;
+  }
+
   SurfaceFrame::SubmitCallback submit_callback =
       fml::MakeCopyable([renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
+                         delegate = delegate_,           //
+                         submit_info,                    //
                          surface = std::move(surface)    //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
@@ -108,11 +125,35 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
           return false;
         }
 
+        *submit_info = surface_frame.submit_info();
+        delegate->GLContextSetDamageRegion(submit_info->buffer_damage);
+
+        std::optional<impeller::IRect> clip_rect;
+        if (submit_info->buffer_damage.has_value()) {
+          const auto& buffer_damage = submit_info->buffer_damage.value();
+          clip_rect = impeller::IRect::MakeXYWH(
+              buffer_damage.x(), buffer_damage.y(), buffer_damage.width(),
+              buffer_damage.height());
+        }
+
+        if (clip_rect && clip_rect->size.IsEmpty()) {
+          return surface->Present();
+        }
+        auto surface_bounds = impeller::IRect::MakeSize(
+            surface->GetTargetRenderPassDescriptor().GetRenderTargetSize());
+        if (clip_rect && clip_rect->Contains(surface_bounds)) {
+          // Rendering the whole surface directly skips the blit.
+          clip_rect = std::nullopt;
+        }
+
+        // The compositor already translated the frame into the space of the
+        // clip.
         auto cull_rect =
-            surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
+            clip_rect.has_value() ? clip_rect->size : surface_bounds.size;
         impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
         impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
-        display_list->Dispatch(
+        impeller_dispatcher.SetFrameArena(aiks_context->GetFrameArena());
+        display_list->DispatchInline(
             impeller_dispatcher,
             SkIRect::MakeWH(cull_rect.width, cull_rect.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
@@ -120,19 +161,23 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
         return renderer->Render(
             std::move(surface),
             fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
+                [aiks_context, picture = std::move(picture), clip_rect](
                     impeller::RenderTarget& render_target) -> bool {
+                  if (clip_rect.has_value()) {
+                    return aiks_context->RenderToRegion(picture, render_target,
+                                                        clip_rect.value());
+                  }
                   return aiks_context->Render(picture, render_target);
                 }));
       });
 
   return std::make_unique<SurfaceFrame>(
-      nullptr,                                // surface
-      delegate_->GLContextFramebufferInfo(),  // framebuffer info
-      submit_callback,                        // submit callback
-      size,                                   // frame size
-      std::move(context_switch),              // context result
-      true                                    // display list fallback
+      nullptr,                    // surface
+      framebuffer_info,           // framebuffer info
+      submit_callback,            // submit callback
+      size,                       // frame size
+      std::move(context_switch),  // context result
+      true                        // display list fallback
   );
 }
 
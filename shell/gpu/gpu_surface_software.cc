@@ -4,14 +4,24 @@
 
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 
+#include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
+// Bands shorter than this aren't worth the cost of handing them to a worker.
+static constexpr int kMinBandHeight = 64;
+
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
                                        bool render_to_surface)
     : delegate_(delegate),
@@ -64,6 +74,41 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
   SkCanvas* canvas = backing_store->getCanvas();
   canvas->resetMatrix();
 
+  if (!band_loop_ && delegate_->AllowsConcurrentRasterization()) {
+    // The raster thread draws one of the bands itself.
+    const unsigned int cores = std::thread::hardware_concurrency();
+    if (cores > 1) {
+      band_loop_ = fml::ConcurrentMessageLoop::Create(cores - 1);
+    }
+  }
+
+  SkPixmap pixmap;
+  const int band_count = GetBandCount(size);
+  if (band_count > 1 && backing_store->peekPixels(&pixmap)) {
+    // Record the frame so that its bands can be played back concurrently
+    // when it is submitted.
+    SurfaceFrame::SubmitCallback on_submit =
+        [self = weak_factory_.GetWeakPtr(), backing_store, band_count](
+            SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+      if (!self || !self->IsValid() || canvas == nullptr) {
+        return false;
+      }
+
+      auto display_list = surface_frame.BuildDisplayList();
+      if (!display_list) {
+        return false;
+      }
+      self->DrawDisplayListInBands(display_list, backing_store.get(),
+                                   band_count);
+
+      return self->delegate_->PresentBackingStore(backing_store);
+    };
+
+    return std::make_unique<SurfaceFrame>(
+        nullptr, framebuffer_info, on_submit, logical_size,
+        /*context_result=*/nullptr, /*display_list_fallback=*/true);
+  }
+
   SurfaceFrame::SubmitCallback on_submit =
       [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
                                           DlCanvas* canvas) -> bool {
@@ -81,6 +126,62 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
                                         on_submit, logical_size);
 }
 
+int GPUSurfaceSoftware::GetBandCount(const SkISize& size) const {
+  if (!band_loop_) {
+    return 1;
+  }
+  const int max_bands = static_cast<int>(band_loop_->GetWorkerCount()) + 1;
+  return std::clamp(size.height() / kMinBandHeight, 1, max_bands);
+}
+
+void GPUSurfaceSoftware::DrawDisplayListInBands(
+    const sk_sp<DisplayList>& display_list,
+    SkSurface* backing_store,
+    int band_count) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::DrawDisplayListInBands");
+  SkPixmap pixmap;
+  // A backdrop filter near the edge of a band would need the pixels of the
+  // neighboring band, which is drawn at the same time.
+  if (display_list->has_backdrop_filter() ||
+      !backing_store->peekPixels(&pixmap)) {
+    DlSkCanvasAdapter(backing_store->getCanvas()).DrawDisplayList(display_list);
+    return;
+  }
+
+  const SkSurfaceProps props = backing_store->props();
+  auto draw_band = [&display_list, &pixmap, &props, band_count](int band) {
+    const int top = pixmap.height() * band / band_count;
+    const int bottom = pixmap.height() * (band + 1) / band_count;
+    SkPixmap band_pixmap;
+    if (!pixmap.extractSubset(&band_pixmap,
+                              SkIRect::MakeLTRB(0, top, pixmap.width(),
+                                                bottom))) {
+      return;
+    }
+    auto canvas = SkCanvas::MakeRasterDirect(band_pixmap.info(),
+                                             band_pixmap.writable_addr(),
+                                             band_pixmap.rowBytes(), &props);
+    if (!canvas) {
+      return;
+    }
+    canvas->translate(0, -top);
+    // The clip of the band culls the ops outside of it through the rtree of
+    // the frame.
+    DlSkCanvasAdapter(canvas.get()).DrawDisplayList(display_list);
+  };
+
+  fml::CountDownLatch latch(band_count - 1);
+  auto task_runner = band_loop_->GetTaskRunner();
+  for (int band = 1; band < band_count; band++) {
+    task_runner->PostTask([&draw_band, &latch, band]() {
+      draw_band(band);
+      latch.CountDown();
+    });
+  }
+  draw_band(0);
+  latch.Wait();
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -5,7 +5,9 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include "flutter/display_list/display_list.h"
 #include "flutter/flow/surface.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
@@ -33,12 +35,22 @@ class GPUSurfaceSoftware : public Surface {
 
  private:
   GPUSurfaceSoftwareDelegate* delegate_;
+  // Rasterizes all but one of the bands of frames that are drawn
+  // concurrently. Created with the first frame if the delegate allows it.
+  std::shared_ptr<fml::ConcurrentMessageLoop> band_loop_;
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
   // external view embedder may want to render to the root surface. This is a
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  int GetBandCount(const SkISize& size) const;
+
+  void DrawDisplayListInBands(const sk_sp<DisplayList>& display_list,
+                              SkSurface* backing_store,
+                              int band_count);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
@@ -8,4 +8,8 @@ namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+bool GPUSurfaceSoftwareDelegate::AllowsConcurrentRasterization() const {
+  return false;
+}
+
 }  // namespace flutter
@@ -48,6 +48,18 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the GPU surface may rasterize horizontal bands of the
+  ///             backing store on worker threads. The bands are all drawn
+  ///             before the backing store is presented, but the delegate must
+  ///             not require the pixels to only be written on the raster
+  ///             thread.
+  ///
+  /// @return     Whether backing stores may be written from other threads.
+  ///             Defaults to false.
+  ///
+  virtual bool AllowsConcurrentRasterization() const;
 };
 
 }  // namespace flutter
@@ -4,7 +4,9 @@
 
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
 
+#include "flutter/display_list/dl_inline_dispatch.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/paths.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "impeller/renderer/renderer.h"
@@ -24,11 +26,12 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(
+  auto aiks_context = impeller::AiksContext::MakeShared(
       context, impeller::TypographerContextSkia::Make());
   if (!aiks_context->IsValid()) {
     return;
   }
+  aiks_context->EnablePipelineVariantManifest(fml::paths::GetCachesDirectory());
 
   impeller_context_ = std::move(context);
   impeller_renderer_ = std::move(renderer);
@@ -60,12 +63,27 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
   auto& context_vk = impeller::SurfaceContextVK::Cast(*impeller_context_);
   std::unique_ptr<impeller::Surface> surface = context_vk.AcquireNextSurface();
 
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  // Partial repaints are rendered offscreen and blitted into the swapchain
+  // image, which keeps the rest of its contents from the last time it was
+  // presented.
+  if (surface &&
+      impeller_context_->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    framebuffer_info.supports_partial_repaint = true;
+    if (auto existing_damage = surface->GetExistingDamage();
+        existing_damage.has_value()) {
+      framebuffer_info.existing_damage = SkIRect::MakeXYWH(
+          existing_damage->origin.x, existing_damage->origin.y,
+          existing_damage->size.width, existing_damage->size.height);
+    }
+  }
+
   SurfaceFrame::SubmitCallback submit_callback =
       fml::MakeCopyable([renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
                          surface = std::move(surface)    //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
-        if (!aiks_context) {
+        if (!aiks_context || !surface) {
           return false;
         }
 
@@ -75,11 +93,40 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
           return false;
         }
 
+        const auto& submit_info = surface_frame.submit_info();
+        if (submit_info.frame_damage.has_value()) {
+          const auto& frame_damage = submit_info.frame_damage.value();
+          surface->SetFrameDamage(impeller::IRect::MakeXYWH(
+              frame_damage.x(), frame_damage.y(), frame_damage.width(),
+              frame_damage.height()));
+        }
+
+        std::optional<impeller::IRect> clip_rect;
+        if (submit_info.buffer_damage.has_value()) {
+          const auto& buffer_damage = submit_info.buffer_damage.value();
+          clip_rect = impeller::IRect::MakeXYWH(
+              buffer_damage.x(), buffer_damage.y(), buffer_damage.width(),
+              buffer_damage.height());
+        }
+
+        if (clip_rect && clip_rect->size.IsEmpty()) {
+          return surface->Present();
+        }
+        auto surface_bounds = impeller::IRect::MakeSize(
+            surface->GetTargetRenderPassDescriptor().GetRenderTargetSize());
+        if (clip_rect && clip_rect->Contains(surface_bounds)) {
+          // Rendering the whole surface directly skips the blit.
+          clip_rect = std::nullopt;
+        }
+
+        // The compositor already translated the frame into the space of the
+        // clip.
         auto cull_rect =
-            surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
+            clip_rect.has_value() ? clip_rect->size : surface_bounds.size;
         impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
         impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
-        display_list->Dispatch(
+        impeller_dispatcher.SetFrameArena(aiks_context->GetFrameArena());
+        display_list->DispatchInline(
             impeller_dispatcher,
             SkIRect::MakeWH(cull_rect.width, cull_rect.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
@@ -87,19 +134,23 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
         return renderer->Render(
             std::move(surface),
             fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
+                [aiks_context, picture = std::move(picture), clip_rect](
                     impeller::RenderTarget& render_target) -> bool {
+                  if (clip_rect.has_value()) {
+                    return aiks_context->RenderToRegion(picture, render_target,
+                                                        clip_rect.value());
+                  }
                   return aiks_context->Render(picture, render_target);
                 }));
       });
 
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
-      submit_callback,                  // submit callback
-      size,                             // frame size
-      nullptr,                          // context result
-      true                              // display list fallback
+      nullptr,           // surface
+      framebuffer_info,  // framebuffer info
+      submit_callback,   // submit callback
+      size,              // frame size
+      nullptr,           // context result
+      true               // display list fallback
   );
 }
 
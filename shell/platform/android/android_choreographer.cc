@@ -17,8 +17,32 @@ typedef void (*AChoreographer_postFrameCallback_FPN)(
     AChoreographer* choreographer,
     AChoreographer_frameCallback callback,
     void* data);
+// Only available on API 33+
+typedef void AChoreographerFrameCallbackData;
+typedef void (*AChoreographer_vsyncCallback)(
+    const AChoreographerFrameCallbackData* callback_data,
+    void* data);
+typedef int (*AChoreographer_postVsyncCallback_FPN)(
+    AChoreographer* choreographer,
+    AChoreographer_vsyncCallback callback,
+    void* data);
+typedef int64_t (*AChoreographerFrameCallbackData_getFrameTimeNanos_FPN)(
+    const AChoreographerFrameCallbackData* callback_data);
+typedef size_t (
+    *AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN)(
+    const AChoreographerFrameCallbackData* callback_data);
+typedef int64_t (*AChoreographerFrameCallbackData_getFrameTimeline_FPN)(
+    const AChoreographerFrameCallbackData* callback_data,
+    size_t index);
 static AChoreographer_getInstance_FPN AChoreographer_getInstance;
 static AChoreographer_postFrameCallback_FPN AChoreographer_postFrameCallback;
+static AChoreographer_postVsyncCallback_FPN AChoreographer_postVsyncCallback;
+static AChoreographerFrameCallbackData_getFrameTimeNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimeNanos;
+static AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN
+    AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex;
+static AChoreographerFrameCallbackData_getFrameTimeline_FPN
+    AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos;
 
 namespace flutter {
 
@@ -58,4 +82,75 @@ void AndroidChoreographer::PostFrameCallback(OnFrameCallback callback,
   AChoreographer_postFrameCallback(choreographer, callback, data);
 }
 
+bool AndroidChoreographer::ShouldUseVsyncCallback() {
+  static std::optional<bool> use_vsync_callback;
+  if (use_vsync_callback) {
+    return use_vsync_callback.value();
+  }
+  use_vsync_callback = false;
+  if (!ShouldUseNDKChoreographer()) {
+    return false;
+  }
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  FML_DCHECK(libandroid);
+  auto post_vsync_callback_fn =
+      libandroid->ResolveFunction<AChoreographer_postVsyncCallback_FPN>(
+          "AChoreographer_postVsyncCallback");
+  auto get_frame_time_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimeNanos_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimeNanos");
+  auto get_preferred_index_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN>(
+      "AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex");
+  auto get_deadline_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimeline_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos");
+  if (post_vsync_callback_fn && get_frame_time_fn && get_preferred_index_fn &&
+      get_deadline_fn) {
+    AChoreographer_postVsyncCallback = post_vsync_callback_fn.value();
+    AChoreographerFrameCallbackData_getFrameTimeNanos =
+        get_frame_time_fn.value();
+    AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex =
+        get_preferred_index_fn.value();
+    AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos =
+        get_deadline_fn.value();
+    use_vsync_callback = true;
+  }
+  return use_vsync_callback.value();
+}
+
+namespace {
+
+struct PendingVsyncCallback {
+  AndroidChoreographer::OnVsyncCallback callback;
+  void* data;
+};
+
+void InvokeVsyncCallback(const AChoreographerFrameCallbackData* callback_data,
+                         void* data) {
+  auto* pending = reinterpret_cast<PendingVsyncCallback*>(data);
+  // The preferred timeline is the one whose deadline the system expects the
+  // app to meet given the current depth of the display pipeline.
+  size_t index = AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex(
+      callback_data);
+  AndroidChoreographer::FrameTimeline timeline = {
+      .frame_time_nanos =
+          AChoreographerFrameCallbackData_getFrameTimeNanos(callback_data),
+      .deadline_nanos =
+          AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos(
+              callback_data, index),
+  };
+  pending->callback(timeline, pending->data);
+  delete pending;
+}
+
+}  // namespace
+
+void AndroidChoreographer::PostVsyncCallback(OnVsyncCallback callback,
+                                             void* data) {
+  AChoreographer* choreographer = AChoreographer_getInstance();
+  AChoreographer_postVsyncCallback(choreographer, &InvokeVsyncCallback,
+                                   new PendingVsyncCallback{callback, data});
+}
+
 }  // namespace flutter
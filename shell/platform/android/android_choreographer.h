@@ -22,6 +22,29 @@ class AndroidChoreographer {
   static bool ShouldUseNDKChoreographer();
   static void PostFrameCallback(OnFrameCallback callback, void* data);
 
+  /// The frame timeline the system prefers for the frame that begins at
+  /// `frame_time_nanos`. All times are in the `CLOCK_MONOTONIC` time base.
+  struct FrameTimeline {
+    int64_t frame_time_nanos;
+    /// The time by which the frame must be submitted to be presented on
+    /// time.
+    int64_t deadline_nanos;
+  };
+
+  typedef void (*OnVsyncCallback)(const FrameTimeline& timeline, void* data);
+
+  //----------------------------------------------------------------------------
+  /// Whether `PostVsyncCallback` is available, which is on API 33+.
+  ///
+  static bool ShouldUseVsyncCallback();
+
+  //----------------------------------------------------------------------------
+  /// Like `PostFrameCallback`, but also reports the deadline of the frame,
+  /// which accounts for the depth of the display pipeline instead of assuming
+  /// a single refresh period.
+  ///
+  static void PostVsyncCallback(OnVsyncCallback callback, void* data);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidChoreographer);
 };
 
@@ -8,6 +8,7 @@
 #include "flutter/impeller/entity/vk/entity_shaders_vk.h"
 #include "flutter/impeller/entity/vk/modern_shaders_vk.h"
 #include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
+#include "flutter/shell/version/version.h"
 
 #if IMPELLER_ENABLE_3D
 #include "flutter/impeller/scene/shaders/vk/scene_shaders_vk.h"
@@ -15,9 +16,27 @@
 
 namespace flutter {
 
+impeller::ContextVK::SwapchainSettings VulkanSwapchainSettingsFromSettings(
+    const Settings& settings) {
+  impeller::ContextVK::SwapchainSettings swapchain_settings;
+  if (settings.impeller_vulkan_present_mode == "fifo-relaxed") {
+    swapchain_settings.present_mode = vk::PresentModeKHR::eFifoRelaxed;
+  } else if (settings.impeller_vulkan_present_mode == "mailbox") {
+    swapchain_settings.present_mode = vk::PresentModeKHR::eMailbox;
+  }
+  swapchain_settings.image_count =
+      settings.impeller_vulkan_swapchain_image_count;
+  if (settings.impeller_vulkan_acquire_timeout_ms > 0) {
+    swapchain_settings.acquire_timeout = fml::TimeDelta::FromMilliseconds(
+        settings.impeller_vulkan_acquire_timeout_ms);
+  }
+  return swapchain_settings;
+}
+
 static std::shared_ptr<impeller::Context> CreateImpellerContext(
     const fml::RefPtr<vulkan::VulkanProcTable>& proc_table,
-    bool enable_vulkan_validation) {
+    bool enable_vulkan_validation,
+    const impeller::ContextVK::SwapchainSettings& swapchain_settings) {
   std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
     std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_vk_data,
                                            impeller_entity_shaders_vk_length),
@@ -36,7 +55,9 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
   settings.proc_address_callback = instance_proc_addr;
   settings.shader_libraries_data = std::move(shader_mappings);
   settings.cache_directory = fml::paths::GetCachesDirectory();
+  settings.engine_version = GetFlutterEngineVersion();
   settings.enable_validation = enable_vulkan_validation;
+  settings.swapchain = swapchain_settings;
 
   if (settings.enable_validation) {
     FML_LOG(ERROR) << "Using the Impeller rendering backend (Vulkan with "
@@ -49,10 +70,12 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
 }
 
 AndroidContextVulkanImpeller::AndroidContextVulkanImpeller(
-    bool enable_validation)
+    bool enable_validation,
+    const impeller::ContextVK::SwapchainSettings& swapchain_settings)
     : AndroidContext(AndroidRenderingAPI::kVulkan),
       proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()) {
-  auto impeller_context = CreateImpellerContext(proc_table_, enable_validation);
+  auto impeller_context =
+      CreateImpellerContext(proc_table_, enable_validation, swapchain_settings);
   SetImpellerContext(impeller_context);
   is_valid_ =
       proc_table_->HasAcquiredMandatoryProcAddresses() && impeller_context;
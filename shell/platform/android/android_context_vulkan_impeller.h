@@ -5,16 +5,25 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_VULKAN_IMPELLER_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_VULKAN_IMPELLER_H_
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
+#include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/vulkan/procs/vulkan_proc_table.h"
 
 namespace flutter {
 
+// The swapchain configuration requested by the Impeller Vulkan switches in
+// |settings|.
+impeller::ContextVK::SwapchainSettings VulkanSwapchainSettingsFromSettings(
+    const Settings& settings);
+
 class AndroidContextVulkanImpeller : public AndroidContext {
  public:
-  AndroidContextVulkanImpeller(bool enable_validation);
+  AndroidContextVulkanImpeller(
+      bool enable_validation,
+      const impeller::ContextVK::SwapchainSettings& swapchain_settings);
 
   ~AndroidContextVulkanImpeller();
 
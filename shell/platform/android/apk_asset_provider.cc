@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/android/apk_asset_provider.h"
 
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -11,9 +12,59 @@
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/unique_fd.h"
 
 namespace flutter {
 
+// Maps an asset that is stored uncompressed in the APK directly from the file
+// descriptor of the APK, without going through the asset manager.
+class APKAssetFileMapping : public fml::Mapping {
+ public:
+  static std::unique_ptr<APKAssetFileMapping> Create(AAsset* asset) {
+    off64_t start = 0;
+    off64_t length = 0;
+    // Only uncompressed assets have a file descriptor.
+    fml::UniqueFD fd(AAsset_openFileDescriptor64(asset, &start, &length));
+    if (!fd.is_valid() || length <= 0) {
+      return nullptr;
+    }
+    // Entries are only page aligned if the APK was aligned with
+    // `zipalign -p`, so the mapping starts at the page before the asset.
+    static const off64_t page_size = ::sysconf(_SC_PAGESIZE);
+    const off64_t map_start = start - start % page_size;
+    const size_t map_size = length + (start - map_start);
+    void* map = ::mmap64(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd.get(),
+                         map_start);
+    if (map == MAP_FAILED) {
+      return nullptr;
+    }
+    return std::unique_ptr<APKAssetFileMapping>(new APKAssetFileMapping(
+        static_cast<uint8_t*>(map), map_size, start - map_start, length));
+  }
+
+  ~APKAssetFileMapping() override { ::munmap(map_, map_size_); }
+
+  size_t GetSize() const override { return size_; }
+
+  const uint8_t* GetMapping() const override { return map_ + offset_; }
+
+  bool IsDontNeedSafe() const override { return true; }
+
+ private:
+  uint8_t* const map_;
+  const size_t map_size_;
+  const size_t offset_;
+  const size_t size_;
+
+  APKAssetFileMapping(uint8_t* map,
+                      size_t map_size,
+                      size_t offset,
+                      size_t size)
+      : map_(map), map_size_(map_size), offset_(offset), size_(size) {}
+
+  FML_DISALLOW_COPY_AND_ASSIGN(APKAssetFileMapping);
+};
+
 class APKAssetMapping : public fml::Mapping {
  public:
   explicit APKAssetMapping(AAsset* asset) : asset_(asset) {}
@@ -50,12 +101,28 @@ class APKAssetProviderImpl : public APKAssetProviderInternal {
       const std::string& asset_name) const override {
     std::stringstream ss;
     ss << directory_.c_str() << "/" << asset_name;
+    // Streaming mode defers reading the asset, which isn't needed at all if
+    // it can be mapped from the APK.
     AAsset* asset = AAssetManager_open(asset_manager_, ss.str().c_str(),
-                                       AASSET_MODE_BUFFER);
+                                       AASSET_MODE_STREAMING);
     if (!asset) {
       return nullptr;
     }
 
+    if (auto mapping = APKAssetFileMapping::Create(asset)) {
+      AAsset_close(asset);
+      return mapping;
+    }
+
+#if FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG
+    if (AAsset_getBuffer(asset) && AAsset_isAllocated(asset)) {
+      FML_LOG(WARNING) << "The asset " << asset_name
+                       << " is compressed in the APK, so it is inflated into "
+                          "memory every time it is loaded. Consider storing "
+                          "it uncompressed.";
+    }
+#endif  // FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG
+
     return std::make_unique<APKAssetMapping>(asset);
   };
 
@@ -201,7 +201,20 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
                                                 rect.width(),  //
                                                 rect.height()  //
   );
+  // The overlay surfaces have the size of the frame so that they can be
+  // recycled, but the overlay view only shows the top left area that has
+  // the size of |rect|. Limit the clear, the drawing and the damage of the
+  // surface to that area, so the cost of an overlay is proportional to the
+  // Flutter UI it contains.
+  const SkIRect visible_rect =
+      SkRect::MakeWH(rect.width(), rect.height()).roundOut();
+  SurfaceFrame::SubmitInfo submit_info;
+  submit_info.frame_damage = visible_rect;
+  submit_info.buffer_damage = visible_rect;
+  frame->set_submit_info(submit_info);
+
   DlCanvas* overlay_canvas = frame->Canvas();
+  overlay_canvas->ClipRect(SkRect::Make(visible_rect));
   overlay_canvas->Clear(DlColor::kTransparent());
   // Offset the picture since its absolute position on the scene is determined
   // by the position of the overlay view.
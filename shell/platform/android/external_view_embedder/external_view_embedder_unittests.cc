@@ -274,6 +274,11 @@ TEST(AndroidExternalViewEmbedder, SubmitFrame) {
         auto surface_frame_2 = std::make_unique<SurfaceFrame>(
             SkSurfaces::Null(1000, 1000), framebuffer_info,
             [](const SurfaceFrame& surface_frame, DlCanvas* canvas) {
+              // Only the area shown by the overlay view is damaged.
+              EXPECT_EQ(surface_frame.submit_info().buffer_damage,
+                        SkIRect::MakeWH(100, 100));
+              EXPECT_EQ(surface_frame.submit_info().frame_damage,
+                        SkIRect::MakeWH(100, 100));
               return true;
             },
             /*frame_size=*/SkISize::Make(800, 600));
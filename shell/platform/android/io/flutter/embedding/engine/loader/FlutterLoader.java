@@ -45,6 +45,12 @@ public class FlutterLoader {
       "io.flutter.embedding.android.EnableVulkanValidation";
   private static final String IMPELLER_BACKEND_META_DATA_KEY =
       "io.flutter.embedding.android.ImpellerBackend";
+  private static final String IMPELLER_VULKAN_PRESENT_MODE_META_DATA_KEY =
+      "io.flutter.embedding.android.ImpellerVulkanPresentMode";
+  private static final String IMPELLER_VULKAN_SWAPCHAIN_IMAGE_COUNT_META_DATA_KEY =
+      "io.flutter.embedding.android.ImpellerVulkanSwapchainImageCount";
+  private static final String IMPELLER_VULKAN_ACQUIRE_TIMEOUT_META_DATA_KEY =
+      "io.flutter.embedding.android.ImpellerVulkanAcquireTimeout";
 
   /**
    * Set whether leave or clean up the VM after the last shell shuts down. It can be set from app's
@@ -339,6 +345,18 @@ public class FlutterLoader {
         if (backend != null) {
           shellArgs.add("--impeller-backend=" + backend);
         }
+        String presentMode = metaData.getString(IMPELLER_VULKAN_PRESENT_MODE_META_DATA_KEY);
+        if (presentMode != null) {
+          shellArgs.add("--impeller-vulkan-present-mode=" + presentMode);
+        }
+        int imageCount = metaData.getInt(IMPELLER_VULKAN_SWAPCHAIN_IMAGE_COUNT_META_DATA_KEY, 0);
+        if (imageCount > 0) {
+          shellArgs.add("--impeller-vulkan-swapchain-image-count=" + imageCount);
+        }
+        int acquireTimeout = metaData.getInt(IMPELLER_VULKAN_ACQUIRE_TIMEOUT_META_DATA_KEY, 0);
+        if (acquireTimeout > 0) {
+          shellArgs.add("--impeller-vulkan-acquire-timeout=" + acquireTimeout);
+        }
       }
 
       final String leakVM = isLeakVM(metaData) ? "true" : "false";
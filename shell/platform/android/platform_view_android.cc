@@ -70,7 +70,8 @@ static std::shared_ptr<flutter::AndroidContext> CreateAndroidContext(
     uint8_t msaa_samples,
     bool enable_impeller,
     const std::optional<std::string>& impeller_backend,
-    bool enable_vulkan_validation) {
+    bool enable_vulkan_validation,
+    const impeller::ContextVK::SwapchainSettings& swapchain_settings) {
   if (use_software_rendering) {
     return std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
   }
@@ -93,10 +94,10 @@ static std::shared_ptr<flutter::AndroidContext> CreateAndroidContext(
             std::make_unique<impeller::egl::Display>());
       case AndroidRenderingAPI::kVulkan:
         return std::make_unique<AndroidContextVulkanImpeller>(
-            enable_vulkan_validation);
+            enable_vulkan_validation, swapchain_settings);
       case AndroidRenderingAPI::kAutoselect: {
         auto vulkan_backend = std::make_unique<AndroidContextVulkanImpeller>(
-            enable_vulkan_validation);
+            enable_vulkan_validation, swapchain_settings);
         if (!vulkan_backend->IsValid()) {
           return std::make_unique<AndroidContextGLImpeller>(
               std::make_unique<impeller::egl::Display>());
@@ -131,7 +132,9 @@ PlatformViewAndroid::PlatformViewAndroid(
               msaa_samples,
               delegate.OnPlatformViewGetSettings().enable_impeller,
               delegate.OnPlatformViewGetSettings().impeller_backend,
-              delegate.OnPlatformViewGetSettings().enable_vulkan_validation)) {}
+              delegate.OnPlatformViewGetSettings().enable_vulkan_validation,
+              VulkanSwapchainSettingsFromSettings(
+                  delegate.OnPlatformViewGetSettings()))) {}
 
 PlatformViewAndroid::PlatformViewAndroid(
     PlatformView::Delegate& delegate,
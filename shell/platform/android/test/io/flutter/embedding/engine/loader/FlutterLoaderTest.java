@@ -215,6 +215,29 @@ public class FlutterLoaderTest {
     assertTrue(arguments.contains(enableImpellerArg));
   }
 
+  @Test
+  public void itSetsImpellerVulkanSwapchainFromMetaData() {
+    FlutterJNI mockFlutterJNI = mock(FlutterJNI.class);
+    FlutterLoader flutterLoader = new FlutterLoader(mockFlutterJNI);
+    Bundle metaData = new Bundle();
+    metaData.putString("io.flutter.embedding.android.ImpellerVulkanPresentMode", "mailbox");
+    metaData.putInt("io.flutter.embedding.android.ImpellerVulkanSwapchainImageCount", 4);
+    ctx.getApplicationInfo().metaData = metaData;
+
+    FlutterLoader.Settings settings = new FlutterLoader.Settings();
+    assertFalse(flutterLoader.initialized());
+    flutterLoader.startInitialization(ctx, settings);
+    flutterLoader.ensureInitializationComplete(ctx, null);
+    shadowOf(getMainLooper()).idle();
+
+    ArgumentCaptor<String[]> shellArgsCaptor = ArgumentCaptor.forClass(String[].class);
+    verify(mockFlutterJNI, times(1))
+        .init(eq(ctx), shellArgsCaptor.capture(), anyString(), anyString(), anyString(), anyLong());
+    List<String> arguments = Arrays.asList(shellArgsCaptor.getValue());
+    assertTrue(arguments.contains("--impeller-vulkan-present-mode=mailbox"));
+    assertTrue(arguments.contains("--impeller-vulkan-swapchain-image-count=4"));
+  }
+
   @Test
   @TargetApi(23)
   @Config(sdk = 23)
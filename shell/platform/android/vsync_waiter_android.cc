@@ -24,13 +24,21 @@ static std::atomic_uint g_refresh_rate_ = 60;
 VsyncWaiterAndroid::VsyncWaiterAndroid(const flutter::TaskRunners& task_runners)
     : VsyncWaiter(task_runners),
       use_ndk_choreographer_(
-          AndroidChoreographer::ShouldUseNDKChoreographer()) {}
+          AndroidChoreographer::ShouldUseNDKChoreographer()),
+      use_vsync_callback_(AndroidChoreographer::ShouldUseVsyncCallback()) {}
 
 VsyncWaiterAndroid::~VsyncWaiterAndroid() = default;
 
 // |VsyncWaiter|
 void VsyncWaiterAndroid::AwaitVSync() {
-  if (use_ndk_choreographer_) {
+  if (use_vsync_callback_) {
+    auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(), [weak_this]() {
+          AndroidChoreographer::PostVsyncCallback(&OnVsyncTimelineFromNDK,
+                                                  weak_this);
+        });
+  } else if (use_ndk_choreographer_) {
     auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
     fml::TaskRunner::RunNowOrPostTask(
         task_runners_.GetUITaskRunner(), [weak_this]() {
@@ -70,6 +78,35 @@ void VsyncWaiterAndroid::OnVsyncFromNDK(int64_t frame_nanos, void* data) {
   ConsumePendingCallback(weak_this, frame_time, target_time);
 }
 
+// static
+void VsyncWaiterAndroid::OnVsyncTimelineFromNDK(
+    const AndroidChoreographer::FrameTimeline& timeline,
+    void* data) {
+  auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(timeline.frame_time_nanos));
+  auto now = fml::TimePoint::Now();
+  if (frame_time > now) {
+    frame_time = now;
+  }
+  // The deadline of the preferred timeline leaves more than a refresh period
+  // when the display pipeline is deep enough, which a fixed period would give
+  // away on high refresh rate displays.
+  auto target_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(timeline.deadline_nanos));
+  if (target_time <= frame_time) {
+    target_time = frame_time + fml::TimeDelta::FromNanoseconds(
+                                   1000000000.0 / g_refresh_rate_);
+  }
+
+  TRACE_EVENT2_INT("flutter", "PlatformVsync", "frame_start_time",
+                   frame_time.ToEpochDelta().ToMicroseconds(),
+                   "frame_target_time",
+                   target_time.ToEpochDelta().ToMicroseconds());
+
+  auto* weak_this = reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(data);
+  ConsumePendingCallback(weak_this, frame_time, target_time);
+}
+
 // static
 void VsyncWaiterAndroid::OnVsyncFromJava(JNIEnv* env,
                                          jclass jcaller,
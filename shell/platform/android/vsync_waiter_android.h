@@ -11,11 +11,10 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/shell/platform/android/android_choreographer.h"
 
 namespace flutter {
 
-class AndroidChoreographer;
-
 class VsyncWaiterAndroid final : public VsyncWaiter {
  public:
   static bool Register(JNIEnv* env);
@@ -30,6 +29,10 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
 
   static void OnVsyncFromNDK(int64_t frame_nanos, void* data);
 
+  static void OnVsyncTimelineFromNDK(
+      const AndroidChoreographer::FrameTimeline& timeline,
+      void* data);
+
   static void OnVsyncFromJava(JNIEnv* env,
                               jclass jcaller,
                               jlong frameDelayNanos,
@@ -45,6 +48,7 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
                                   jfloat refresh_rate);
 
   const bool use_ndk_choreographer_;
+  const bool use_vsync_callback_;
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterAndroid);
 };
 
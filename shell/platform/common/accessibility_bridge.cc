@@ -13,6 +13,28 @@
 
 namespace flutter {  // namespace
 
+namespace {
+
+// Whether applying |new_data| to a node whose data is |old_data| would leave
+// it unchanged. Used to leave unchanged nodes out of ui::AXTree updates.
+bool IsSameNodeData(const ui::AXNodeData& old_data,
+                    const ui::AXNodeData& new_data) {
+  return old_data.id == new_data.id && old_data.role == new_data.role &&
+         old_data.state == new_data.state &&
+         old_data.actions == new_data.actions &&
+         old_data.string_attributes == new_data.string_attributes &&
+         old_data.int_attributes == new_data.int_attributes &&
+         old_data.float_attributes == new_data.float_attributes &&
+         old_data.bool_attributes == new_data.bool_attributes &&
+         old_data.intlist_attributes == new_data.intlist_attributes &&
+         old_data.stringlist_attributes == new_data.stringlist_attributes &&
+         old_data.html_attributes == new_data.html_attributes &&
+         old_data.child_ids == new_data.child_ids &&
+         old_data.relative_bounds == new_data.relative_bounds;
+}
+
+}  // namespace
+
 constexpr int kHasScrollingAction =
     FlutterSemanticsAction::kFlutterSemanticsActionScrollLeft |
     FlutterSemanticsAction::kFlutterSemanticsActionScrollRight |
@@ -83,15 +105,15 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+    for (const SemanticsNode& node : results[i - 1]) {
       ConvertFlutterUpdate(node, update);
     }
   }
@@ -256,15 +278,18 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  // |target| is moved into |result|, which may grow while the children are
+  // visited.
+  const std::vector<int32_t> children = target.children_in_traversal_order;
+  result.push_back(std::move(target));
+  for (int32_t child : children) {
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
     }
   }
 }
@@ -295,7 +320,15 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
     node_data.child_ids.push_back(child);
   }
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+  // The framework sends every node of a dirty subtree, most of which usually
+  // didn't change. Validating and diffing them in ui::AXTree is what makes
+  // updates of large trees slow, so unchanged nodes are left out. A node that
+  // was reparented was removed from the tree and is always sent.
+  const ui::AXNode* existing_node = tree_->GetFromId(node.id);
+  if (existing_node && IsSameNodeData(existing_node->data(), node_data)) {
+    return;
+  }
+  tree_update.nodes.push_back(std::move(node_data));
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -209,7 +209,7 @@ class AccessibilityBridge
   // pending_semantics_updates_. Returns std::nullopt if none are reparented.
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
-  void GetSubTreeList(const SemanticsNode& target,
+  void GetSubTreeList(SemanticsNode target,
                       std::vector<SemanticsNode>& result);
   void ConvertFlutterUpdate(const SemanticsNode& node,
                             ui::AXTreeUpdate& tree_update);
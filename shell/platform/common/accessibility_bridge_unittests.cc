@@ -205,6 +205,48 @@ TEST(AccessibilityBridgeTest, CanFireChildrenChangedCorrectly) {
               Contains(ui::AXEventGenerator::Event::SUBTREE_CREATED));
 }
 
+TEST(AccessibilityBridgeTest, LeavesUnchangedNodesOutOfTreeUpdates) {
+  // Counts the nodes of the ui::AXTree updates.
+  class UpdatedNodeCounter : public ui::AXTreeObserver {
+   public:
+    void OnNodeDataWillChange(ui::AXTree* tree,
+                              const ui::AXNodeData& old_node_data,
+                              const ui::AXNodeData& new_node_data) override {
+      updated_node_ids.push_back(new_node_data.id);
+    }
+
+    std::vector<int32_t> updated_node_ids;
+  };
+
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  UpdatedNodeCounter counter;
+  bridge->GetTree()->AddObserver(&counter);
+
+  // The framework sends the whole subtree though only one label changed.
+  child2.label = "new child 2";
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  bridge->GetTree()->RemoveObserver(&counter);
+
+  EXPECT_EQ(counter.updated_node_ids, std::vector<int32_t>({2}));
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  EXPECT_EQ(child2_node->GetName(), "new child 2");
+  EXPECT_EQ(bridge->GetFlutterPlatformNodeDelegateFromID(1).lock()->GetName(),
+            "child 1");
+}
+
 TEST(AccessibilityBridgeTest, CanHandleSelectionChangeCorrectly) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
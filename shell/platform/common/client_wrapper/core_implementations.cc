@@ -16,13 +16,43 @@
 #include <cassert>
 #include <iostream>
 #include <variant>
+#include <vector>
 
 #include "binary_messenger_impl.h"
 #include "include/flutter/engine_method_result.h"
+#include "include/flutter/task_queue.h"
 #include "texture_registrar_impl.h"
 
 namespace flutter {
 
+// ========== binary_messenger.h ==========
+
+void BinaryMessenger::SetBackgroundMessageHandler(
+    const std::string& channel,
+    BinaryMessageHandler handler,
+    std::shared_ptr<TaskQueue> task_queue) {
+  if (!handler) {
+    SetMessageHandler(channel, nullptr);
+    return;
+  }
+  assert(task_queue);
+  // Shared with the posted tasks, which may outlive the registration.
+  auto shared_handler =
+      std::make_shared<BinaryMessageHandler>(std::move(handler));
+  SetMessageHandler(
+      channel, [shared_handler, task_queue = std::move(task_queue)](
+                   const uint8_t* message, size_t message_size,
+                   BinaryReply reply) {
+        // |message| is only valid during this call.
+        std::vector<uint8_t> copy(message, message + message_size);
+        task_queue->PostTask([shared_handler, copy = std::move(copy),
+                              reply = std::move(reply)]() mutable {
+          (*shared_handler)(copy.empty() ? nullptr : copy.data(),
+                            copy.size(), std::move(reply));
+        });
+      });
+}
+
 // ========== binary_messenger_impl.h ==========
 
 namespace {
@@ -127,6 +157,56 @@ void BinaryMessengerImpl::SetMessageHandler(const std::string& channel,
                                      ForwardToHandler, message_handler);
 }
 
+// ========== task_queue.h ==========
+
+TaskQueue::TaskQueue()
+    : state_(std::make_shared<State>()), thread_(&TaskQueue::Run, state_) {}
+
+TaskQueue::~TaskQueue() {
+  {
+    std::scoped_lock lock(state_->mutex);
+    state_->terminated = true;
+  }
+  state_->tasks_available.notify_one();
+  if (RunsTasksOnCurrentThread()) {
+    thread_.detach();
+  } else {
+    thread_.join();
+  }
+}
+
+void TaskQueue::PostTask(std::function<void()> task) {
+  {
+    std::scoped_lock lock(state_->mutex);
+    state_->tasks.push_back(std::move(task));
+  }
+  state_->tasks_available.notify_one();
+}
+
+bool TaskQueue::RunsTasksOnCurrentThread() const {
+  return std::this_thread::get_id() == thread_.get_id();
+}
+
+// static
+void TaskQueue::Run(std::shared_ptr<State> state) {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock lock(state->mutex);
+      state->tasks_available.wait(lock, [&state]() {
+        return state->terminated || !state->tasks.empty();
+      });
+      if (state->tasks.empty()) {
+        // Terminated, and every task ran.
+        return;
+      }
+      task = std::move(state->tasks.front());
+      state->tasks.pop_front();
+    }
+    task();
+  }
+}
+
 // ========== engine_method_result.h ==========
 
 namespace internal {
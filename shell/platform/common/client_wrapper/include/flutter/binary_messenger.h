@@ -6,10 +6,13 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_BINARY_MESSENGER_H_
 
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace flutter {
 
+class TaskQueue;
+
 // A binary message reply callback.
 //
 // Used for submitting a binary reply back to a Flutter message sender.
@@ -45,6 +48,17 @@ class BinaryMessenger {
   // existing handler.
   virtual void SetMessageHandler(const std::string& channel,
                                  BinaryMessageHandler handler) = 0;
+
+  // Registers a message handler like SetMessageHandler, but calls |handler|
+  // on the background thread of |task_queue| instead of the platform thread,
+  // with a copy of each message. |handler| may reply from any thread.
+  //
+  // Use this for channels whose messages are expensive to handle, so that
+  // they don't delay frames and input events. Provide a null handler to
+  // unregister the existing handler.
+  void SetBackgroundMessageHandler(const std::string& channel,
+                                   BinaryMessageHandler handler,
+                                   std::shared_ptr<TaskQueue> task_queue);
 };
 
 }  // namespace flutter
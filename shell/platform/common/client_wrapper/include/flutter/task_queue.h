@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_TASK_QUEUE_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_TASK_QUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace flutter {
+
+// A queue of tasks that run in order on a background thread owned by the
+// queue.
+//
+// Used with BinaryMessenger::SetBackgroundMessageHandler to handle the
+// messages of a channel without blocking the platform thread. Several
+// channels can share a queue to keep their messages in order relative to
+// each other.
+class TaskQueue {
+ public:
+  // Starts the background thread.
+  TaskQueue();
+
+  // Runs the tasks that were already posted, then stops the background
+  // thread. When the last reference to the queue is dropped by one of its
+  // own tasks, the thread stops after that task instead of being joined.
+  ~TaskQueue();
+
+  // Prevent copying.
+  TaskQueue(TaskQueue const&) = delete;
+  TaskQueue& operator=(TaskQueue const&) = delete;
+
+  // Runs |task| on the background thread after the tasks posted before it.
+  //
+  // Can be called from any thread.
+  void PostTask(std::function<void()> task);
+
+  // Returns whether the caller is running on the background thread.
+  bool RunsTasksOnCurrentThread() const;
+
+ private:
+  // The state shared with the background thread, which may outlive the
+  // queue.
+  struct State {
+    std::mutex mutex;
+    std::condition_variable tasks_available;
+    std::deque<std::function<void()>> tasks;
+    bool terminated = false;
+  };
+
+  // Runs tasks until |state| is terminated and has no tasks left.
+  static void Run(std::shared_ptr<State> state);
+
+  std::shared_ptr<State> state_;
+  std::thread thread_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_TASK_QUEUE_H_
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "byte_buffer_streams.h"
@@ -188,7 +189,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
-      return EncodableValue(string_value);
+      return EncodableValue(std::move(string_value));
     }
     case EncodedType::kUInt8List:
       return ReadVector<uint8_t>(stream);
@@ -205,7 +206,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       for (size_t i = 0; i < length; ++i) {
         list_value.push_back(ReadValue(stream));
       }
-      return EncodableValue(list_value);
+      return EncodableValue(std::move(list_value));
     }
     case EncodedType::kMap: {
       size_t length = ReadSize(stream);
@@ -215,7 +216,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
         EncodableValue value = ReadValue(stream);
         map_value.emplace(std::move(key), std::move(value));
       }
-      return EncodableValue(map_value);
+      return EncodableValue(std::move(map_value));
     }
     case EncodedType::kFloat32List: {
       return ReadVector<float>(stream);
@@ -268,11 +269,11 @@ EncodableValue StandardCodecSerializer::ReadVector(
   }
   stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
                     count * type_size);
-  return EncodableValue(vector);
+  return EncodableValue(std::move(vector));
 }
 
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
+void StandardCodecSerializer::WriteVector(const std::vector<T>& vector,
                                           ByteStreamWriter* stream) const {
   size_t count = vector.size();
   WriteSize(count, stream);
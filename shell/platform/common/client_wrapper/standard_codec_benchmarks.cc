@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// A typed list of |count| elements, like the samples or coordinates a plugin
+// sends in one message.
+template <typename T>
+EncodableValue CreateTypedList(size_t count) {
+  std::vector<T> list(count);
+  for (size_t i = 0; i < count; i++) {
+    list[i] = static_cast<T>(i);
+  }
+  return EncodableValue(std::move(list));
+}
+
+// A list of |count| maps with a few scalar and string entries, like the
+// records a plugin sends for a query.
+EncodableValue CreateListOfMaps(size_t count) {
+  EncodableList list;
+  list.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    list.push_back(EncodableValue(EncodableMap{
+        {EncodableValue("id"), EncodableValue(static_cast<int64_t>(i))},
+        {EncodableValue("name"), EncodableValue("item " + std::to_string(i))},
+        {EncodableValue("score"), EncodableValue(i * 0.5)},
+        {EncodableValue("enabled"), EncodableValue(i % 2 == 0)},
+    }));
+  }
+  return EncodableValue(std::move(list));
+}
+
+// A map of |count| entries whose values are typed lists and nested maps.
+EncodableValue CreateNestedMap(size_t count) {
+  EncodableMap map;
+  for (size_t i = 0; i < count; i++) {
+    map[EncodableValue("key " + std::to_string(i))] = EncodableValue(
+        EncodableMap{{EncodableValue("values"), CreateTypedList<float>(64)},
+                     {EncodableValue("timestamps"),
+                      CreateTypedList<int64_t>(16)}});
+  }
+  return EncodableValue(std::move(map));
+}
+
+void RunEncodeBenchmark(benchmark::State& state, const EncodableValue& value) {
+  const auto& codec = StandardMessageCodec::GetInstance();
+  size_t size = 0;
+  while (state.KeepRunning()) {
+    auto encoded = codec.EncodeMessage(value);
+    size = encoded->size();
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+
+void RunDecodeBenchmark(benchmark::State& state, const EncodableValue& value) {
+  const auto& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(value);
+  while (state.KeepRunning()) {
+    auto decoded = codec.DecodeMessage(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+}  // namespace
+
+static void BM_StandardCodecEncodeFloat32List(benchmark::State& state) {
+  RunEncodeBenchmark(state, CreateTypedList<float>(state.range(0)));
+}
+
+static void BM_StandardCodecDecodeFloat32List(benchmark::State& state) {
+  RunDecodeBenchmark(state, CreateTypedList<float>(state.range(0)));
+}
+
+static void BM_StandardCodecEncodeInt64List(benchmark::State& state) {
+  RunEncodeBenchmark(state, CreateTypedList<int64_t>(state.range(0)));
+}
+
+static void BM_StandardCodecDecodeInt64List(benchmark::State& state) {
+  RunDecodeBenchmark(state, CreateTypedList<int64_t>(state.range(0)));
+}
+
+static void BM_StandardCodecEncodeListOfMaps(benchmark::State& state) {
+  RunEncodeBenchmark(state, CreateListOfMaps(state.range(0)));
+}
+
+static void BM_StandardCodecDecodeListOfMaps(benchmark::State& state) {
+  RunDecodeBenchmark(state, CreateListOfMaps(state.range(0)));
+}
+
+static void BM_StandardCodecEncodeNestedMap(benchmark::State& state) {
+  RunEncodeBenchmark(state, CreateNestedMap(state.range(0)));
+}
+
+static void BM_StandardCodecDecodeNestedMap(benchmark::State& state) {
+  RunDecodeBenchmark(state, CreateNestedMap(state.range(0)));
+}
+
+BENCHMARK(BM_StandardCodecEncodeFloat32List)->Range(16, 1 << 20);
+BENCHMARK(BM_StandardCodecDecodeFloat32List)->Range(16, 1 << 20);
+BENCHMARK(BM_StandardCodecEncodeInt64List)->Range(16, 1 << 20);
+BENCHMARK(BM_StandardCodecDecodeInt64List)->Range(16, 1 << 20);
+BENCHMARK(BM_StandardCodecEncodeListOfMaps)->Range(16, 4096);
+BENCHMARK(BM_StandardCodecDecodeListOfMaps)->Range(16, 4096);
+BENCHMARK(BM_StandardCodecEncodeNestedMap)->Range(16, 1024);
+BENCHMARK(BM_StandardCodecDecodeNestedMap)->Range(16, 1024);
+
+}  // namespace flutter
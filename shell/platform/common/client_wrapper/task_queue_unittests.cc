@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/task_queue.h"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/binary_messenger.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+class TestBinaryMessenger : public BinaryMessenger {
+ public:
+  void Send(const std::string& channel,
+            const uint8_t* message,
+            const size_t message_size,
+            BinaryReply reply) const override {}
+
+  void SetMessageHandler(const std::string& channel,
+                         BinaryMessageHandler handler) override {
+    last_message_handler_ = handler;
+  }
+
+  BinaryMessageHandler last_message_handler() { return last_message_handler_; }
+
+ private:
+  BinaryMessageHandler last_message_handler_;
+};
+
+}  // namespace
+
+// Tests that tasks run in order on the background thread.
+TEST(TaskQueueTest, RunsTasksInOrderOnTheBackgroundThread) {
+  std::vector<int> order;
+  std::thread::id task_thread;
+  {
+    TaskQueue task_queue;
+    EXPECT_FALSE(task_queue.RunsTasksOnCurrentThread());
+    for (int i = 0; i < 3; i++) {
+      task_queue.PostTask([&order, i]() { order.push_back(i); });
+    }
+    task_queue.PostTask([&task_queue, &task_thread]() {
+      EXPECT_TRUE(task_queue.RunsTasksOnCurrentThread());
+      task_thread = std::this_thread::get_id();
+    });
+    // Destroying the queue runs the pending tasks.
+  }
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2}));
+  EXPECT_NE(task_thread, std::thread::id());
+  EXPECT_NE(task_thread, std::this_thread::get_id());
+}
+
+// Tests that a background handler gets a copy of the message on the task
+// queue's thread, and can reply from there.
+TEST(TaskQueueTest, BackgroundMessageHandlerRunsOnTaskQueue) {
+  TestBinaryMessenger messenger;
+  auto task_queue = std::make_shared<TaskQueue>();
+  std::promise<std::vector<uint8_t>> received;
+  messenger.SetBackgroundMessageHandler(
+      "some_channel",
+      [task_queue, &received](const uint8_t* message, size_t message_size,
+                              BinaryReply reply) {
+        EXPECT_TRUE(task_queue->RunsTasksOnCurrentThread());
+        reply(message, message_size);
+        received.set_value(
+            std::vector<uint8_t>(message, message + message_size));
+      },
+      task_queue);
+  ASSERT_NE(messenger.last_message_handler(), nullptr);
+
+  std::vector<uint8_t> reply_data;
+  {
+    // The message is only valid while the handler is called.
+    std::vector<uint8_t> message = {1, 2, 3};
+    messenger.last_message_handler()(
+        message.data(), message.size(),
+        [&reply_data](const uint8_t* reply, size_t reply_size) {
+          reply_data.assign(reply, reply + reply_size);
+        });
+    message.assign(message.size(), 0);
+  }
+
+  auto future = received.get_future();
+  EXPECT_EQ(future.get(), std::vector<uint8_t>({1, 2, 3}));
+  EXPECT_EQ(reply_data, std::vector<uint8_t>({1, 2, 3}));
+
+  messenger.SetBackgroundMessageHandler("some_channel", nullptr, nullptr);
+  EXPECT_EQ(messenger.last_message_handler(), nullptr);
+}
+
+}  // namespace flutter
@@ -6,11 +6,31 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_JSON_MESSAGE_CODEC_H_
 
 #include <rapidjson/document.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+#include <vector>
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/message_codec.h"
 
 namespace flutter {
 
+// A RapidJSON output stream that appends to a byte vector, so that encoded
+// messages are written straight into the buffer that is sent.
+class JsonByteStream {
+ public:
+  typedef char Ch;
+
+  explicit JsonByteStream(std::vector<uint8_t>* bytes) : bytes_(bytes) {}
+
+  void Put(Ch c) { bytes_->push_back(static_cast<uint8_t>(c)); }
+
+  void Flush() {}
+
+ private:
+  std::vector<uint8_t>* bytes_;
+};
+
 // A message encoding/decoding mechanism for communications to/from the
 // Flutter engine via JSON channels.
 class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
@@ -24,6 +44,22 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   JsonMessageCodec(JsonMessageCodec const&) = delete;
   JsonMessageCodec& operator=(JsonMessageCodec const&) = delete;
 
+  // Parses |binary_message| without building a document, passing its values
+  // to |handler| as they are read. |handler| implements the SAX interface of
+  // rapidjson::Reader, such as a subclass of rapidjson::BaseReaderHandler.
+  //
+  // Returns false if the message isn't valid JSON, or if |handler| stops the
+  // parsing by returning false.
+  template <typename Handler>
+  bool ParseMessage(const uint8_t* binary_message,
+                    const size_t message_size,
+                    Handler& handler) const {
+    rapidjson::MemoryStream stream(
+        reinterpret_cast<const char*>(binary_message), message_size);
+    rapidjson::Reader reader;
+    return !reader.Parse(stream, handler).IsError();
+  }
+
  protected:
   // Instances should be obtained via GetInstance.
   JsonMessageCodec() = default;
@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -44,4 +45,41 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+TEST(JsonMessageCodec, EncodesCompactJson) {
+  rapidjson::Document object(rapidjson::kObjectType);
+  auto& allocator = object.GetAllocator();
+  object.AddMember("a", 1, allocator);
+  object.AddMember("b", "c", allocator);
+
+  auto encoded = JsonMessageCodec::GetInstance().EncodeMessage(object);
+  ASSERT_TRUE(encoded);
+  EXPECT_EQ(std::string(encoded->begin(), encoded->end()),
+            "{\"a\":1,\"b\":\"c\"}");
+}
+
+// Collects the keys of a message, in order.
+struct KeyCollector
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, KeyCollector> {
+  bool Key(const char* key, rapidjson::SizeType length, bool copy) {
+    keys.emplace_back(key, length);
+    return true;
+  }
+
+  std::vector<std::string> keys;
+};
+
+TEST(JsonMessageCodec, ParsesMessagesWithHandlers) {
+  const std::string message = "{\"a\":1,\"b\":{\"c\":[true,null]},\"d\":\"e\"}";
+  KeyCollector collector;
+  EXPECT_TRUE(JsonMessageCodec::GetInstance().ParseMessage(
+      reinterpret_cast<const uint8_t*>(message.data()), message.size(),
+      collector));
+  EXPECT_EQ(collector.keys, std::vector<std::string>({"a", "b", "c", "d"}));
+
+  const std::string invalid = "{\"a\":";
+  EXPECT_FALSE(JsonMessageCodec::GetInstance().ParseMessage(
+      reinterpret_cast<const uint8_t*>(invalid.data()), invalid.size(),
+      collector));
+}
+
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/common/json_method_codec.h"
 
 #include "flutter/shell/platform/common/json_message_codec.h"
+#include "rapidjson/writer.h"
 
 namespace flutter {
 
@@ -30,6 +31,17 @@ std::unique_ptr<rapidjson::Document> ExtractElement(
   return extracted;
 }
 
+// Writes |value| to |writer|, or null if there is no value.
+void WriteValueOrNull(const rapidjson::Value* value,
+                      rapidjson::Writer<JsonByteStream>& writer) {
+  if (value) {
+    // NOLINTNEXTLINE(clang-analyzer-core.*)
+    value->Accept(writer);
+  } else {
+    writer.Null();
+  }
+}
+
 }  // namespace
 
 // static
@@ -66,34 +78,32 @@ JsonMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
 
 std::unique_ptr<std::vector<uint8_t>> JsonMethodCodec::EncodeMethodCallInternal(
     const MethodCall<rapidjson::Document>& method_call) const {
-  // TODO(stuartmorgan): Consider revisiting the codec APIs to avoid the need
-  // to copy everything when doing encoding (e.g., by having a version that
-  // takes owership of the object to encode, so that it can be moved instead).
-  rapidjson::Document message(rapidjson::kObjectType);
-  auto& allocator = message.GetAllocator();
-  rapidjson::Value name(method_call.method_name(), allocator);
-  rapidjson::Value arguments;
-  if (method_call.arguments()) {
-    arguments.CopyFrom(*method_call.arguments(), allocator);
-  }
-  message.AddMember(kMessageMethodKey, name, allocator);
-  message.AddMember(kMessageArgumentsKey, arguments, allocator);
-
-  return JsonMessageCodec::GetInstance().EncodeMessage(message);
+  // The message is written directly, rather than copying the arguments into
+  // an envelope document first.
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  JsonByteStream stream(encoded.get());
+  rapidjson::Writer<JsonByteStream> writer(stream);
+  writer.StartObject();
+  writer.Key(kMessageMethodKey);
+  const std::string& method_name = method_call.method_name();
+  writer.String(method_name.c_str(),
+                static_cast<rapidjson::SizeType>(method_name.length()));
+  writer.Key(kMessageArgumentsKey);
+  WriteValueOrNull(method_call.arguments(), writer);
+  writer.EndObject();
+  return encoded;
 }
 
 std::unique_ptr<std::vector<uint8_t>>
 JsonMethodCodec::EncodeSuccessEnvelopeInternal(
     const rapidjson::Document* result) const {
-  rapidjson::Document envelope;
-  envelope.SetArray();
-  rapidjson::Value result_value;
-  if (result) {
-    result_value.CopyFrom(*result, envelope.GetAllocator());
-  }
-  envelope.PushBack(result_value, envelope.GetAllocator());
-
-  return JsonMessageCodec::GetInstance().EncodeMessage(envelope);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  JsonByteStream stream(encoded.get());
+  rapidjson::Writer<JsonByteStream> writer(stream);
+  writer.StartArray();
+  WriteValueOrNull(result, writer);
+  writer.EndArray();
+  return encoded;
 }
 
 std::unique_ptr<std::vector<uint8_t>>
@@ -101,18 +111,17 @@ JsonMethodCodec::EncodeErrorEnvelopeInternal(
     const std::string& error_code,
     const std::string& error_message,
     const rapidjson::Document* error_details) const {
-  // NOLINTNEXTLINE(clang-analyzer-core.NullDereference)
-  rapidjson::Document envelope(rapidjson::kArrayType);
-  auto& allocator = envelope.GetAllocator();
-  envelope.PushBack(rapidjson::Value(error_code, allocator), allocator);
-  envelope.PushBack(rapidjson::Value(error_message, allocator), allocator);
-  rapidjson::Value details_value;
-  if (error_details) {
-    details_value.CopyFrom(*error_details, allocator);
-  }
-  envelope.PushBack(details_value, allocator);
-
-  return JsonMessageCodec::GetInstance().EncodeMessage(envelope);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  JsonByteStream stream(encoded.get());
+  rapidjson::Writer<JsonByteStream> writer(stream);
+  writer.StartArray();
+  writer.String(error_code.c_str(),
+                static_cast<rapidjson::SizeType>(error_code.length()));
+  writer.String(error_message.c_str(),
+                static_cast<rapidjson::SizeType>(error_message.length()));
+  WriteValueOrNull(error_details, writer);
+  writer.EndArray();
+  return encoded;
 }
 
 bool JsonMethodCodec::DecodeAndProcessResponseEnvelopeInternal(
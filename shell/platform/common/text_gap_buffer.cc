@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_gap_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/string_conversion.h"
+
+namespace flutter {
+
+namespace {
+
+// The smallest gap left after the buffer grows.
+constexpr size_t kMinGapLength = 64;
+
+bool IsLeadingSurrogate(char16_t code_unit) {
+  return (code_unit & 0xFC00) == 0xD800;
+}
+
+bool IsTrailingSurrogate(char16_t code_unit) {
+  return (code_unit & 0xFC00) == 0xDC00;
+}
+
+}  // namespace
+
+TextGapBuffer::TextGapBuffer() = default;
+
+TextGapBuffer::TextGapBuffer(std::u16string text)
+    : buffer_(std::move(text)),
+      gap_start_(buffer_.length()),
+      gap_end_(buffer_.length()) {}
+
+TextGapBuffer::~TextGapBuffer() = default;
+
+char16_t TextGapBuffer::at(size_t index) const {
+  FML_DCHECK(index < length());
+  return index < gap_start_ ? buffer_[index] : buffer_[index + gap_length()];
+}
+
+void TextGapBuffer::Replace(size_t position,
+                            size_t count,
+                            std::u16string_view text) {
+  FML_DCHECK(position <= length());
+  // Like std::u16string::replace, only the code units up to the end of the
+  // text are replaced.
+  count = std::min(count, length() - position);
+  if (count == 0 && text.empty()) {
+    return;
+  }
+  utf8_.reset();
+  MoveGap(position);
+  gap_end_ += count;
+  ReserveGap(text.length());
+  std::copy(text.begin(), text.end(), buffer_.begin() + gap_start_);
+  gap_start_ += text.length();
+}
+
+std::u16string TextGapBuffer::ToUtf16() const {
+  std::u16string text;
+  text.reserve(length());
+  text.append(buffer_, 0, gap_start_);
+  text.append(buffer_, gap_end_, std::u16string::npos);
+  return text;
+}
+
+const std::string& TextGapBuffer::ToUtf8() const {
+  if (!utf8_.has_value()) {
+    utf8_ = fml::Utf16ToUtf8(ToUtf16());
+  }
+  return utf8_.value();
+}
+
+size_t TextGapBuffer::Utf8LengthBefore(size_t end) const {
+  FML_DCHECK(end <= length());
+  size_t utf8_length = 0;
+  for (size_t i = 0; i < end; i++) {
+    char16_t code_unit = at(i);
+    if (code_unit < 0x80) {
+      utf8_length += 1;
+    } else if (code_unit < 0x800) {
+      utf8_length += 2;
+    } else if (IsLeadingSurrogate(code_unit) && i + 1 < end &&
+               IsTrailingSurrogate(at(i + 1))) {
+      // A surrogate pair encodes a code point that takes 4 bytes.
+      utf8_length += 4;
+      i++;
+    } else {
+      utf8_length += 3;
+    }
+  }
+  return utf8_length;
+}
+
+void TextGapBuffer::MoveGap(size_t position) {
+  if (position < gap_start_) {
+    size_t moved = gap_start_ - position;
+    std::copy_backward(buffer_.begin() + position,
+                       buffer_.begin() + gap_start_,
+                       buffer_.begin() + gap_end_);
+    gap_start_ -= moved;
+    gap_end_ -= moved;
+  } else if (position > gap_start_) {
+    size_t moved = position - gap_start_;
+    std::copy(buffer_.begin() + gap_end_, buffer_.begin() + gap_end_ + moved,
+              buffer_.begin() + gap_start_);
+    gap_start_ += moved;
+    gap_end_ += moved;
+  }
+}
+
+void TextGapBuffer::ReserveGap(size_t length) {
+  if (gap_length() >= length) {
+    return;
+  }
+  // Growing in proportion to the text keeps the cost of inserting amortized
+  // constant.
+  size_t new_gap_length =
+      std::max(length + kMinGapLength, this->length() + length);
+  std::u16string buffer;
+  buffer.reserve(this->length() + new_gap_length);
+  buffer.append(buffer_, 0, gap_start_);
+  buffer.append(new_gap_length, u'\0');
+  buffer.append(buffer_, gap_end_, std::u16string::npos);
+  buffer_ = std::move(buffer);
+  gap_end_ = gap_start_ + new_gap_length;
+}
+
+}  // namespace flutter
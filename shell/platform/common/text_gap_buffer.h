@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace flutter {
+
+// UTF-16 text stored with a gap at the last edited position.
+//
+// Edits move the gap to where they happen and fill it, so runs of edits near
+// the same position, such as typing or deleting at the cursor, take amortized
+// constant time however long the text is. Only moving the gap costs time, in
+// proportion to the distance it moves.
+//
+// The UTF-8 conversion of the text is cached until the next edit, as platform
+// plugins typically read the text both before and after every edit.
+class TextGapBuffer {
+ public:
+  TextGapBuffer();
+  explicit TextGapBuffer(std::u16string text);
+  ~TextGapBuffer();
+
+  TextGapBuffer(const TextGapBuffer&) = default;
+  TextGapBuffer& operator=(const TextGapBuffer&) = default;
+
+  // The number of UTF-16 code units in the text.
+  size_t length() const { return buffer_.length() - gap_length(); }
+
+  // The UTF-16 code unit at |index|, which must be less than |length|.
+  char16_t at(size_t index) const;
+
+  // Replaces the |count| code units at |position| with |text|. Like
+  // std::u16string::replace, |count| is clamped to the end of the text.
+  void Replace(size_t position, size_t count, std::u16string_view text);
+
+  // Inserts |text| at |position|.
+  void Insert(size_t position, std::u16string_view text) {
+    Replace(position, 0, text);
+  }
+
+  // Removes the |count| code units at |position|.
+  void Erase(size_t position, size_t count) { Replace(position, count, {}); }
+
+  // The text as UTF-16.
+  std::u16string ToUtf16() const;
+
+  // The text as UTF-8.
+  const std::string& ToUtf8() const;
+
+  // The length in UTF-8 bytes of the first |end| code units of the text.
+  size_t Utf8LengthBefore(size_t end) const;
+
+ private:
+  size_t gap_length() const { return gap_end_ - gap_start_; }
+
+  // Moves the gap to |position| of the text.
+  void MoveGap(size_t position);
+
+  // Grows the gap to at least |length| code units.
+  void ReserveGap(size_t length);
+
+  std::u16string buffer_;
+  size_t gap_start_ = 0;
+  size_t gap_end_ = 0;
+  mutable std::optional<std::string> utf8_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_TEXT_GAP_BUFFER_H_
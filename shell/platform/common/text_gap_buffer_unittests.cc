@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_gap_buffer.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+TEST(TextGapBuffer, EditsAnywhere) {
+  TextGapBuffer buffer(u"ACE");
+  buffer.Insert(1, u"B");
+  buffer.Insert(3, u"D");
+  buffer.Insert(0, u"_");
+  buffer.Insert(6, u"F");
+  EXPECT_EQ(buffer.ToUtf16(), u"_ABCDEF");
+  EXPECT_EQ(buffer.length(), 7u);
+
+  buffer.Erase(0, 1);
+  buffer.Replace(2, 3, u"cde");
+  EXPECT_EQ(buffer.ToUtf16(), u"ABcdeF");
+  EXPECT_EQ(buffer.at(0), u'A');
+  EXPECT_EQ(buffer.at(3), u'd');
+  EXPECT_EQ(buffer.at(5), u'F');
+}
+
+TEST(TextGapBuffer, GrowsForLongInsertions) {
+  TextGapBuffer buffer;
+  std::u16string expected;
+  for (int i = 0; i < 500; i++) {
+    // Alternates between the ends to move the gap across the whole text.
+    std::u16string text(i % 7 + 1, static_cast<char16_t>(u'a' + i % 26));
+    if (i % 2 == 0) {
+      buffer.Insert(0, text);
+      expected.insert(0, text);
+    } else {
+      buffer.Insert(buffer.length(), text);
+      expected.append(text);
+    }
+  }
+  EXPECT_EQ(buffer.ToUtf16(), expected);
+  EXPECT_EQ(buffer.length(), expected.length());
+}
+
+TEST(TextGapBuffer, ClampsErasureToTheEnd) {
+  TextGapBuffer buffer(u"ABC");
+  buffer.Erase(1, 10);
+  EXPECT_EQ(buffer.ToUtf16(), u"A");
+}
+
+TEST(TextGapBuffer, CachesUtf8UntilEdited) {
+  TextGapBuffer buffer(u"héllo");
+  EXPECT_EQ(buffer.ToUtf8(), "h\xc3\xa9llo");
+  const std::string* cached = &buffer.ToUtf8();
+  EXPECT_EQ(&buffer.ToUtf8(), cached);
+
+  buffer.Insert(5, u"!");
+  EXPECT_EQ(buffer.ToUtf8(), "h\xc3\xa9llo!");
+}
+
+TEST(TextGapBuffer, MeasuresUtf8Lengths) {
+  // 1, 2 and 3 byte characters, and a surrogate pair for a 4 byte one.
+  TextGapBuffer buffer(u"aé中\U0001F604b");
+  // Leaves the gap in the middle of the text.
+  buffer.Insert(2, u"x");
+  buffer.Erase(2, 1);
+  EXPECT_EQ(buffer.Utf8LengthBefore(0), 0u);
+  EXPECT_EQ(buffer.Utf8LengthBefore(1), 1u);
+  EXPECT_EQ(buffer.Utf8LengthBefore(2), 3u);
+  EXPECT_EQ(buffer.Utf8LengthBefore(3), 6u);
+  EXPECT_EQ(buffer.Utf8LengthBefore(5), 10u);
+  EXPECT_EQ(buffer.Utf8LengthBefore(6), buffer.ToUtf8().length());
+}
+
+}  // namespace flutter
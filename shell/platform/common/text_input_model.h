@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 
+#include "flutter/shell/platform/common/text_gap_buffer.h"
 #include "flutter/shell/platform/common/text_range.h"
 
 namespace flutter {
@@ -218,7 +219,7 @@ class TextInputModel {
     return composing_ ? composing_range_ : text_range();
   }
 
-  std::u16string text_;
+  TextGapBuffer text_;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
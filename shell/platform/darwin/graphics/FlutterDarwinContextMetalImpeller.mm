@@ -19,6 +19,32 @@
 
 FLUTTER_ASSERT_ARC
 
+static NSString* const kBinaryArchiveFileName = @"flutter.impeller.mtlarchive";
+
+// Returns the path of the Metal binary archive that records the pipelines used by the app, or an
+// empty string if there is no caches directory.
+//
+// The archive lives in the caches directory, so that pipelines used in earlier launches are found
+// on the next one. An archive captured on a device can be shipped in the app bundle under the same
+// name to seed the cache on the first launch.
+static std::string GetBinaryArchivePath() {
+  NSFileManager* fileManager = [NSFileManager defaultManager];
+  NSArray<NSURL*>* caches = [fileManager URLsForDirectory:NSCachesDirectory
+                                                inDomains:NSUserDomainMask];
+  if (caches.count == 0) {
+    return {};
+  }
+  NSURL* archiveURL = [caches[0] URLByAppendingPathComponent:kBinaryArchiveFileName];
+  if (![fileManager fileExistsAtPath:archiveURL.path]) {
+    NSURL* bundledURL = [[NSBundle mainBundle] URLForResource:kBinaryArchiveFileName
+                                                withExtension:nil];
+    if (bundledURL != nil) {
+      [fileManager copyItemAtURL:bundledURL toURL:archiveURL error:nil];
+    }
+  }
+  return archiveURL.fileSystemRepresentation;
+}
+
 static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext(
     std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch) {
   std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
@@ -33,8 +59,9 @@ static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext(
     std::make_shared<fml::NonOwnedMapping>(impeller_framebuffer_blend_shaders_data,
                                            impeller_framebuffer_blend_shaders_length),
   };
-  auto context = impeller::ContextMTL::Create(
-      shader_mappings, std::move(is_gpu_disabled_sync_switch), "Impeller Library");
+  auto context = impeller::ContextMTL::Create(shader_mappings,
+                                              std::move(is_gpu_disabled_sync_switch),
+                                              "Impeller Library", GetBinaryArchivePath());
   if (!context) {
     FML_LOG(ERROR) << "Could not create Metal Impeller Context.";
     return nullptr;
@@ -159,6 +159,12 @@ flutter::Settings FLTDefaultSettingsForBundle(NSBundle* bundle, NSProcessInfo* p
   settings.enable_wide_gamut = enableWideGamut;
 #endif
 
+  // Whether save layers and filters keep the wide gamut colors of the surface.
+  NSNumber* nsEnableWideGamutOffscreens =
+      [mainBundle objectForInfoDictionaryKey:@"FLTEnableWideGamutOffscreens"];
+  settings.enable_wide_gamut_offscreens =
+      nsEnableWideGamutOffscreens ? nsEnableWideGamutOffscreens.boolValue : YES;
+
   // TODO(dnfield): We should reverse the order for all these settings so that command line options
   // are preferred to plist settings. https://github.com/flutter/flutter/issues/124049
   // Whether to enable Impeller. If the command line explicitly
@@ -176,6 +182,13 @@ flutter::Settings FLTDefaultSettingsForBundle(NSBundle* bundle, NSProcessInfo* p
     }
   }
 
+  NSNumber* enablePlatformImageDecoder =
+      [mainBundle objectForInfoDictionaryKey:@"FLTEnablePlatformImageDecoder"];
+  // Change the default only if the option is present.
+  if (enablePlatformImageDecoder != nil) {
+    settings.enable_platform_image_decoder = enablePlatformImageDecoder.boolValue;
+  }
+
   NSNumber* enableTraceSystrace = [mainBundle objectForInfoDictionaryKey:@"FLTTraceSystrace"];
   // Change the default only if the option is present.
   if (enableTraceSystrace != nil) {
@@ -232,6 +245,14 @@ flutter::Settings FLTDefaultSettingsForBundle(NSBundle* bundle, NSProcessInfo* p
     settings.enable_embedder_api = enable_embedder_api.boolValue;
   }
 
+  // Whether to composite platform views without merging the raster and platform threads.
+  NSNumber* enableAsyncComposition =
+      [mainBundle objectForInfoDictionaryKey:@"FLTEnableAsyncPlatformViewComposition"];
+  // Change the default only if the option is present.
+  if (enableAsyncComposition) {
+    settings.enable_async_platform_view_composition = enableAsyncComposition.boolValue;
+  }
+
   return settings;
 }
 
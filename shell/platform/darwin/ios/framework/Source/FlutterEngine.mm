@@ -36,6 +36,7 @@
 #import "flutter/shell/platform/darwin/ios/framework/Source/platform_message_response_darwin.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/profiler_metrics_ios.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/vsync_waiter_ios.h"
+#import "flutter/shell/platform/darwin/ios/ios_image_generator.h"
 #import "flutter/shell/platform/darwin/ios/platform_view_ios.h"
 #import "flutter/shell/platform/darwin/ios/rendering_api_selection.h"
 #include "flutter/shell/profiling/sampling_profiler.h"
@@ -766,6 +767,14 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
   _publisher.reset([[FlutterDartVMServicePublisher alloc]
       initWithEnableVMServicePublication:doesVMServicePublication]);
   [self maybeSetupPlatformViewChannels];
+  if (_shell->GetSettings().enable_platform_image_decoder) {
+    // Takes precedence over the builtin decoders for the formats it supports.
+    _shell->RegisterImageDecoder(
+        [](sk_sp<SkData> buffer) {
+          return flutter::IOSImageGenerator::MakeFromData(std::move(buffer));
+        },
+        1);
+  }
   _shell->SetGpuAvailability(_isGpuDisabled ? flutter::GpuAvailability::kUnavailable
                                             : flutter::GpuAvailability::kAvailable);
 }
@@ -863,6 +872,10 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
   flutter::Shell::CreateCallback<flutter::PlatformView> on_create_platform_view =
       [self](flutter::Shell& shell) {
         [self recreatePlatformViewController];
+        if (shell.GetSettings().enable_async_platform_view_composition) {
+          self->_platformViewsController->EnableAsyncComposition(
+              shell.GetTaskRunners().GetPlatformTaskRunner());
+        }
         return std::make_unique<flutter::PlatformViewIOS>(
             shell, self->_renderingApi, self->_platformViewsController, shell.GetTaskRunners(),
             shell.GetConcurrentWorkerTaskRunner(), shell.GetIsGpuDisabledSyncSwitch());
@@ -1442,6 +1455,10 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
   flutter::Shell::CreateCallback<flutter::PlatformView> on_create_platform_view =
       [result, context](flutter::Shell& shell) {
         [result recreatePlatformViewController];
+        if (shell.GetSettings().enable_async_platform_view_composition) {
+          result->_platformViewsController->EnableAsyncComposition(
+              shell.GetTaskRunners().GetPlatformTaskRunner());
+        }
         return std::make_unique<flutter::PlatformViewIOS>(
             shell, context, result->_platformViewsController, shell.GetTaskRunners());
       };
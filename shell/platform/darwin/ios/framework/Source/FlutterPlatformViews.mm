@@ -10,6 +10,7 @@
 #include <string>
 
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterChannels.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterOverlayView.h"
@@ -83,56 +84,61 @@ namespace flutter {
 // Becomes NO if Apple's API changes and blurred backdrop filters cannot be applied.
 BOOL canApplyBlurBackdrop = YES;
 
+void FlutterPlatformViewLayerPool::CreateLayer(GrDirectContext* gr_context,
+                                               const std::shared_ptr<IOSContext>& ios_context) {
+  std::shared_ptr<FlutterPlatformViewLayer> layer;
+  fml::scoped_nsobject<FlutterOverlayView> overlay_view;
+  fml::scoped_nsobject<FlutterOverlayView> overlay_view_wrapper;
+
+  if (!gr_context) {
+    overlay_view.reset([[FlutterOverlayView alloc] init]);
+    overlay_view_wrapper.reset([[FlutterOverlayView alloc] init]);
+
+    auto ca_layer = fml::scoped_nsobject<CALayer>{[[overlay_view.get() layer] retain]};
+    std::unique_ptr<IOSSurface> ios_surface = IOSSurface::Create(ios_context, ca_layer);
+    std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface();
+
+    layer = std::make_shared<FlutterPlatformViewLayer>(
+        std::move(overlay_view), std::move(overlay_view_wrapper), std::move(ios_surface),
+        std::move(surface));
+  } else {
+    CGFloat screenScale = [UIScreen mainScreen].scale;
+    overlay_view.reset([[FlutterOverlayView alloc] initWithContentsScale:screenScale]);
+    overlay_view_wrapper.reset([[FlutterOverlayView alloc] initWithContentsScale:screenScale]);
+
+    auto ca_layer = fml::scoped_nsobject<CALayer>{[[overlay_view.get() layer] retain]};
+    std::unique_ptr<IOSSurface> ios_surface = IOSSurface::Create(ios_context, ca_layer);
+    std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface(gr_context);
+
+    layer = std::make_shared<FlutterPlatformViewLayer>(
+        std::move(overlay_view), std::move(overlay_view_wrapper), std::move(ios_surface),
+        std::move(surface));
+    layer->gr_context = gr_context;
+  }
+  // The overlay view wrapper masks the overlay view.
+  // This is required to keep the backing surface size unchanged between frames.
+  //
+  // Otherwise, changing the size of the overlay would require a new surface,
+  // which can be very expensive.
+  //
+  // This is the case of an animation in which the overlay size is changing in every frame.
+  //
+  // +------------------------+
+  // |   overlay_view         |
+  // |    +--------------+    |              +--------------+
+  // |    |    wrapper   |    |  == mask =>  | overlay_view |
+  // |    +--------------+    |              +--------------+
+  // +------------------------+
+  layer->overlay_view_wrapper.get().clipsToBounds = YES;
+  [layer->overlay_view_wrapper.get() addSubview:layer->overlay_view];
+  layers_.push_back(layer);
+}
+
 std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewLayerPool::GetLayer(
     GrDirectContext* gr_context,
     const std::shared_ptr<IOSContext>& ios_context) {
   if (available_layer_index_ >= layers_.size()) {
-    std::shared_ptr<FlutterPlatformViewLayer> layer;
-    fml::scoped_nsobject<FlutterOverlayView> overlay_view;
-    fml::scoped_nsobject<FlutterOverlayView> overlay_view_wrapper;
-
-    if (!gr_context) {
-      overlay_view.reset([[FlutterOverlayView alloc] init]);
-      overlay_view_wrapper.reset([[FlutterOverlayView alloc] init]);
-
-      auto ca_layer = fml::scoped_nsobject<CALayer>{[[overlay_view.get() layer] retain]};
-      std::unique_ptr<IOSSurface> ios_surface = IOSSurface::Create(ios_context, ca_layer);
-      std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface();
-
-      layer = std::make_shared<FlutterPlatformViewLayer>(
-          std::move(overlay_view), std::move(overlay_view_wrapper), std::move(ios_surface),
-          std::move(surface));
-    } else {
-      CGFloat screenScale = [UIScreen mainScreen].scale;
-      overlay_view.reset([[FlutterOverlayView alloc] initWithContentsScale:screenScale]);
-      overlay_view_wrapper.reset([[FlutterOverlayView alloc] initWithContentsScale:screenScale]);
-
-      auto ca_layer = fml::scoped_nsobject<CALayer>{[[overlay_view.get() layer] retain]};
-      std::unique_ptr<IOSSurface> ios_surface = IOSSurface::Create(ios_context, ca_layer);
-      std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface(gr_context);
-
-      layer = std::make_shared<FlutterPlatformViewLayer>(
-          std::move(overlay_view), std::move(overlay_view_wrapper), std::move(ios_surface),
-          std::move(surface));
-      layer->gr_context = gr_context;
-    }
-    // The overlay view wrapper masks the overlay view.
-    // This is required to keep the backing surface size unchanged between frames.
-    //
-    // Otherwise, changing the size of the overlay would require a new surface,
-    // which can be very expensive.
-    //
-    // This is the case of an animation in which the overlay size is changing in every frame.
-    //
-    // +------------------------+
-    // |   overlay_view         |
-    // |    +--------------+    |              +--------------+
-    // |    |    wrapper   |    |  == mask =>  | overlay_view |
-    // |    +--------------+    |              +--------------+
-    // +------------------------+
-    layer->overlay_view_wrapper.get().clipsToBounds = YES;
-    [layer->overlay_view_wrapper.get() addSubview:layer->overlay_view];
-    layers_.push_back(layer);
+    CreateLayer(gr_context, ios_context);
   }
   std::shared_ptr<FlutterPlatformViewLayer> layer = layers_[available_layer_index_];
   if (gr_context != layer->gr_context) {
@@ -147,6 +153,16 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewLayerPool::GetLayer
   return layer;
 }
 
+void FlutterPlatformViewLayerPool::EnsureLayerCount(
+    size_t count,
+    GrDirectContext* gr_context,
+    const std::shared_ptr<IOSContext>& ios_context) {
+  FML_DCHECK([[NSThread currentThread] isMainThread]);
+  while (layers_.size() < count) {
+    CreateLayer(gr_context, ios_context);
+  }
+}
+
 void FlutterPlatformViewLayerPool::RecycleLayers() {
   available_layer_index_ = 0;
 }
@@ -173,6 +189,12 @@ UIViewController* FlutterPlatformViewsController::getFlutterViewController() {
   return flutter_view_controller_.get();
 }
 
+void FlutterPlatformViewsController::EnableAsyncComposition(
+    fml::RefPtr<fml::TaskRunner> platform_task_runner) {
+  FML_DCHECK([[NSThread currentThread] isMainThread]);
+  platform_task_runner_ = std::move(platform_task_runner);
+}
+
 void FlutterPlatformViewsController::OnMethodCall(FlutterMethodCall* call, FlutterResult& result) {
   if ([[call method] isEqualToString:@"create"]) {
     OnCreate(call, result);
@@ -264,6 +286,11 @@ void FlutterPlatformViewsController::OnDispose(FlutterMethodCall* call, FlutterR
   }
   // We wait for next submitFrame to dispose views.
   views_to_dispose_.insert(viewId);
+  if (IsAsyncCompositionEnabled()) {
+    // Frames without platform views aren't committed on the platform thread, so a view that isn't
+    // shown may not be disposed of for a long time otherwise.
+    DisposeViews(active_composition_order_);
+  }
   result(nil);
 }
 
@@ -334,6 +361,10 @@ const int FlutterPlatformViewsController::kDefaultMergedLeaseDuration;
 
 PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
     const fml::RefPtr<fml::RasterThreadMerger>& raster_thread_merger) {
+  // The UIKit changes are committed on the platform thread by |SubmitFrameAsync|.
+  if (IsAsyncCompositionEnabled()) {
+    return PostPrerollResult::kSuccess;
+  }
   // TODO(cyanglaz): https://github.com/flutter/flutter/issues/56474
   // Rename `has_platform_view` to `view_mutated` when the above issue is resolved.
   if (!HasPlatformViewThisOrNextFrame()) {
@@ -363,7 +394,7 @@ PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
 void FlutterPlatformViewsController::EndFrame(
     bool should_resubmit_frame,
     const fml::RefPtr<fml::RasterThreadMerger>& raster_thread_merger) {
-  if (should_resubmit_frame) {
+  if (should_resubmit_frame && raster_thread_merger) {
     raster_thread_merger->MergeWithLease(kDefaultMergedLeaseDuration);
   }
 }
@@ -615,6 +646,10 @@ void FlutterPlatformViewsController::CompositeWithParams(int64_t view_id,
 }
 
 DlCanvas* FlutterPlatformViewsController::CompositeEmbeddedView(int64_t view_id) {
+  // The view is composited on the platform thread by |CommitFrame| instead.
+  if (IsAsyncCompositionEnabled()) {
+    return slices_[view_id]->canvas();
+  }
   // Any UIKit related code has to run on main thread.
   FML_DCHECK([[NSThread currentThread] isMainThread]);
   // Do nothing if the view doesn't need to be composited.
@@ -656,32 +691,12 @@ SkRect FlutterPlatformViewsController::GetPlatformViewRect(int64_t view_id) {
   );
 }
 
-bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
-                                                 const std::shared_ptr<IOSContext>& ios_context,
-                                                 std::unique_ptr<SurfaceFrame> frame) {
-  TRACE_EVENT0("flutter", "FlutterPlatformViewsController::SubmitFrame");
+std::vector<FlutterPlatformViewsController::Overlay>
+FlutterPlatformViewsController::CollectOverlays(DlCanvas* background_canvas) {
+  std::vector<Overlay> overlays;
+  // The number of overlays of each platform view.
+  std::map<int64_t, int64_t> overlay_counts;
 
-  // Any UIKit related code has to run on main thread.
-  FML_DCHECK([[NSThread currentThread] isMainThread]);
-  if (flutter_view_ == nullptr) {
-    return frame->Submit();
-  }
-
-  DisposeViews();
-
-  DlCanvas* background_canvas = frame->Canvas();
-
-  // Resolve all pending GPU operations before allocating a new surface.
-  background_canvas->Flush();
-
-  // Clipping the background canvas before drawing the picture recorders requires
-  // saving and restoring the clip context.
-  DlAutoCanvasRestore save(background_canvas, /*doSave=*/true);
-
-  // Maps a platform view id to a vector of `FlutterPlatformViewLayer`.
-  LayersMap platform_view_layers;
-
-  auto did_submit = true;
   auto num_platform_views = composition_order_.size();
 
   for (size_t i = 0; i < num_platform_views; i++) {
@@ -693,15 +708,16 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
     // current platform view or any of the previous platform views.
     for (size_t j = i + 1; j > 0; j--) {
       int64_t current_platform_view_id = composition_order_[j - 1];
-      SkRect platform_view_rect = GetPlatformViewRect(current_platform_view_id);
+      // The UIViews can't be read off of the platform thread, but their bounds are the final
+      // bounding rects of their params.
+      SkRect platform_view_rect =
+          IsAsyncCompositionEnabled()
+              ? current_composition_params_[current_platform_view_id].finalBoundingRect()
+              : GetPlatformViewRect(current_platform_view_id);
       std::list<SkRect> intersection_rects =
           slice->searchNonOverlappingDrawnRects(platform_view_rect);
       auto allocation_size = intersection_rects.size();
 
-      // For testing purposes, the overlay id is used to find the overlay view.
-      // This is the index of the layer for the current platform view.
-      auto overlay_id = platform_view_layers[current_platform_view_id].size();
-
       // If the max number of allocations per platform view is exceeded,
       // then join all the rects into a single one.
       //
@@ -729,30 +745,74 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
         // Clip the background canvas, so it doesn't contain any of the pixels drawn
         // on the overlay layer.
         background_canvas->ClipRect(joined_rect, DlCanvas::ClipOp::kDifference);
-        // Get a new host layer.
-        std::shared_ptr<FlutterPlatformViewLayer> layer = GetLayer(gr_context,                //
-                                                                   ios_context,               //
-                                                                   slice,                     //
-                                                                   joined_rect,               //
-                                                                   current_platform_view_id,  //
-                                                                   overlay_id                 //
-        );
-        did_submit &= layer->did_submit_last_frame;
-        platform_view_layers[current_platform_view_id].push_back(layer);
-        overlay_id++;
+        // For testing purposes, the overlay id is used to find the overlay view.
+        // This is the index of the layer for the current platform view.
+        overlays.push_back({
+            .view_id = current_platform_view_id,
+            .overlay_id = overlay_counts[current_platform_view_id]++,
+            .rect = joined_rect,
+            .slice = slice,
+        });
       }
     }
     slice->render_into(background_canvas);
   }
+  return overlays;
+}
+
+bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
+                                                 const std::shared_ptr<IOSContext>& ios_context,
+                                                 std::unique_ptr<SurfaceFrame> frame) {
+  TRACE_EVENT0("flutter", "FlutterPlatformViewsController::SubmitFrame");
+
+  if (IsAsyncCompositionEnabled()) {
+    return SubmitFrameAsync(gr_context, ios_context, std::move(frame));
+  }
+
+  // Any UIKit related code has to run on main thread.
+  FML_DCHECK([[NSThread currentThread] isMainThread]);
+  if (flutter_view_ == nullptr) {
+    return frame->Submit();
+  }
+
+  DisposeViews(composition_order_);
+
+  DlCanvas* background_canvas = frame->Canvas();
+
+  // Resolve all pending GPU operations before allocating a new surface.
+  background_canvas->Flush();
+
+  // Clipping the background canvas before drawing the picture recorders requires
+  // saving and restoring the clip context.
+  DlAutoCanvasRestore save(background_canvas, /*doSave=*/true);
+
+  std::vector<Overlay> overlays = CollectOverlays(background_canvas);
 
   // Manually trigger the SkAutoCanvasRestore before we submit the frame
   save.Restore();
 
+  // Maps a platform view id to a vector of `FlutterPlatformViewLayer`.
+  LayersMap platform_view_layers;
+
+  auto did_submit = true;
+  for (const Overlay& overlay : overlays) {
+    // Get a new host layer.
+    std::shared_ptr<FlutterPlatformViewLayer> layer = GetLayer(gr_context,         //
+                                                               ios_context,        //
+                                                               overlay.slice,      //
+                                                               overlay.rect,       //
+                                                               overlay.view_id,    //
+                                                               overlay.overlay_id  //
+    );
+    did_submit &= layer->did_submit_last_frame;
+    platform_view_layers[overlay.view_id].push_back(layer);
+  }
+
   // If a layer was allocated in the previous frame, but it's not used in the current frame,
   // then it can be removed from the scene.
-  RemoveUnusedLayers();
+  RemoveUnusedLayers(layer_pool_->GetUnusedLayers(), composition_order_);
   // Organize the layers by their z indexes.
-  BringLayersIntoView(platform_view_layers);
+  BringLayersIntoView(platform_view_layers, composition_order_);
   // Mark all layers as available, so they can be used in the next frame.
   layer_pool_->RecycleLayers();
 
@@ -765,16 +825,108 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
   return did_submit;
 }
 
-void FlutterPlatformViewsController::BringLayersIntoView(LayersMap layer_map) {
+bool FlutterPlatformViewsController::SubmitFrameAsync(
+    GrDirectContext* gr_context,
+    const std::shared_ptr<IOSContext>& ios_context,
+    std::unique_ptr<SurfaceFrame> frame) {
+  if (composition_order_.empty() && !did_composite_platform_views_) {
+    // Nothing changes in UIKit.
+    return frame->Submit();
+  }
+  did_composite_platform_views_ = !composition_order_.empty();
+
+  DlCanvas* background_canvas = frame->Canvas();
+
+  // Resolve all pending GPU operations before allocating a new surface.
+  background_canvas->Flush();
+
+  DlAutoCanvasRestore save(background_canvas, /*doSave=*/true);
+  CompositedFrame composited_frame;
+  composited_frame.overlays = CollectOverlays(background_canvas);
+  save.Restore();
+
+  if (layer_pool_->GetLayerCount() < composited_frame.overlays.size()) {
+    // Overlay layers are backed by UIViews, which can only be created on the platform thread. This
+    // is the only time the raster thread waits for it, and it only happens when a frame needs more
+    // overlays than any frame before it since the layers are pooled.
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_task_runner_, [&]() {
+      layer_pool_->EnsureLayerCount(composited_frame.overlays.size(), gr_context, ios_context);
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+
+  auto did_submit = true;
+  for (Overlay& overlay : composited_frame.overlays) {
+    overlay.layer = layer_pool_->GetLayer(gr_context, ios_context);
+    RenderLayer(*overlay.layer, overlay.slice, overlay.rect);
+    did_submit &= overlay.layer->did_submit_last_frame;
+    overlay.slice = nullptr;
+  }
+  composited_frame.unused_layers = layer_pool_->GetUnusedLayers();
+  layer_pool_->RecycleLayers();
+
+  did_submit &= frame->Submit();
+
+  composited_frame.composition_order = composition_order_;
+  for (int64_t view_id : composition_order_) {
+    if (views_to_recomposite_.erase(view_id) > 0) {
+      composited_frame.views_to_composite[view_id] = current_composition_params_[view_id];
+    }
+  }
+  platform_task_runner_->PostTask(
+      [weak_this = GetWeakPtr(), composited_frame = std::move(composited_frame)]() {
+        if (weak_this) {
+          weak_this->CommitFrame(composited_frame);
+        }
+      });
+  return did_submit;
+}
+
+void FlutterPlatformViewsController::CommitFrame(const CompositedFrame& frame) {
+  TRACE_EVENT0("flutter", "FlutterPlatformViewsController::CommitFrame");
+  FML_DCHECK([[NSThread currentThread] isMainThread]);
+  if (flutter_view_ == nullptr) {
+    return;
+  }
+
+  [CATransaction begin];
+  DisposeViews(frame.composition_order);
+
+  for (const auto& [view_id, params] : frame.views_to_composite) {
+    // The view may have been disposed of since the frame was drawn.
+    if (root_views_.count(view_id) != 0) {
+      CompositeWithParams(view_id, params);
+    }
+  }
+
+  LayersMap platform_view_layers;
+  for (const Overlay& overlay : frame.overlays) {
+    PlaceLayer(*overlay.layer, overlay.rect, overlay.view_id, overlay.overlay_id);
+    platform_view_layers[overlay.view_id].push_back(overlay.layer);
+  }
+  RemoveUnusedLayers(frame.unused_layers, frame.composition_order);
+  BringLayersIntoView(platform_view_layers, frame.composition_order);
+  [CATransaction commit];
+}
+
+void FlutterPlatformViewsController::BringLayersIntoView(
+    LayersMap layer_map,
+    const std::vector<int64_t>& composition_order) {
   FML_DCHECK(flutter_view_);
   UIView* flutter_view = flutter_view_.get();
   // Clear the `active_composition_order_`, which will be populated down below.
   active_composition_order_.clear();
   NSMutableArray* desired_platform_subviews = [NSMutableArray array];
-  for (size_t i = 0; i < composition_order_.size(); i++) {
-    int64_t platform_view_id = composition_order_[i];
+  for (size_t i = 0; i < composition_order.size(); i++) {
+    int64_t platform_view_id = composition_order[i];
     std::vector<std::shared_ptr<FlutterPlatformViewLayer>> layers = layer_map[platform_view_id];
     UIView* platform_view_root = root_views_[platform_view_id].get();
+    // With async composition, the view may have been disposed of since the frame was drawn.
+    if (platform_view_root == nil) {
+      continue;
+    }
     [desired_platform_subviews addObject:platform_view_root];
     for (const std::shared_ptr<FlutterPlatformViewLayer>& layer : layers) {
       [desired_platform_subviews addObject:layer->overlay_view_wrapper];
@@ -809,8 +961,16 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
     int64_t overlay_id) {
   FML_DCHECK(flutter_view_);
   std::shared_ptr<FlutterPlatformViewLayer> layer = layer_pool_->GetLayer(gr_context, ios_context);
+  PlaceLayer(*layer, rect, view_id, overlay_id);
+  RenderLayer(*layer, slice, rect);
+  return layer;
+}
 
-  UIView* overlay_view_wrapper = layer->overlay_view_wrapper.get();
+void FlutterPlatformViewsController::PlaceLayer(const FlutterPlatformViewLayer& layer,
+                                                SkRect rect,
+                                                int64_t view_id,
+                                                int64_t overlay_id) {
+  UIView* overlay_view_wrapper = layer.overlay_view_wrapper.get();
   auto screenScale = [UIScreen mainScreen].scale;
   // Set the size of the overlay view wrapper.
   // This wrapper view masks the overlay view.
@@ -820,7 +980,7 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
   overlay_view_wrapper.accessibilityIdentifier =
       [NSString stringWithFormat:@"platform_view[%lld].overlay[%lld]", view_id, overlay_id];
 
-  UIView* overlay_view = layer->overlay_view.get();
+  UIView* overlay_view = layer.overlay_view.get();
   // Set the size of the overlay view.
   // This size is equal to the device screen size.
   overlay_view.frame = [flutter_view_.get() convertRect:flutter_view_.get().bounds
@@ -828,11 +988,15 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
   // Set a unique view identifier, so the overlay_view can be identified in XCUITests.
   overlay_view.accessibilityIdentifier =
       [NSString stringWithFormat:@"platform_view[%lld].overlay_view[%lld]", view_id, overlay_id];
+}
 
-  std::unique_ptr<SurfaceFrame> frame = layer->surface->AcquireFrame(frame_size_);
+void FlutterPlatformViewsController::RenderLayer(FlutterPlatformViewLayer& layer,
+                                                 EmbedderViewSlice* slice,
+                                                 SkRect rect) {
+  std::unique_ptr<SurfaceFrame> frame = layer.surface->AcquireFrame(frame_size_);
   // If frame is null, AcquireFrame already printed out an error message.
   if (!frame) {
-    return layer;
+    return;
   }
   DlCanvas* overlay_canvas = frame->Canvas();
   int restore_count = overlay_canvas->GetSaveCount();
@@ -842,18 +1006,18 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
   slice->render_into(overlay_canvas);
   overlay_canvas->RestoreToCount(restore_count);
 
-  layer->did_submit_last_frame = frame->Submit();
-  return layer;
+  layer.did_submit_last_frame = frame->Submit();
 }
 
-void FlutterPlatformViewsController::RemoveUnusedLayers() {
-  std::vector<std::shared_ptr<FlutterPlatformViewLayer>> layers = layer_pool_->GetUnusedLayers();
+void FlutterPlatformViewsController::RemoveUnusedLayers(
+    const std::vector<std::shared_ptr<FlutterPlatformViewLayer>>& layers,
+    const std::vector<int64_t>& composition_order) {
   for (const std::shared_ptr<FlutterPlatformViewLayer>& layer : layers) {
     [layer->overlay_view_wrapper removeFromSuperview];
   }
 
   std::unordered_set<int64_t> composition_order_set;
-  for (int64_t view_id : composition_order_) {
+  for (int64_t view_id : composition_order) {
     composition_order_set.insert(view_id);
   }
   // Remove unused platform views.
@@ -865,15 +1029,15 @@ void FlutterPlatformViewsController::RemoveUnusedLayers() {
   }
 }
 
-void FlutterPlatformViewsController::DisposeViews() {
+void FlutterPlatformViewsController::DisposeViews(const std::vector<int64_t>& composition_order) {
   if (views_to_dispose_.empty()) {
     return;
   }
 
   FML_DCHECK([[NSThread currentThread] isMainThread]);
 
-  std::unordered_set<int64_t> views_to_composite(composition_order_.begin(),
-                                                 composition_order_.end());
+  std::unordered_set<int64_t> views_to_composite(composition_order.begin(),
+                                                 composition_order.end());
   std::unordered_set<int64_t> views_to_delay_dispose;
   for (int64_t viewId : views_to_dispose_) {
     if (views_to_composite.count(viewId)) {
@@ -885,6 +1049,11 @@ void FlutterPlatformViewsController::DisposeViews() {
     views_.erase(viewId);
     touch_interceptors_.erase(viewId);
     root_views_.erase(viewId);
+    // With async composition, the rest is only accessed on the raster thread. The framework doesn't
+    // reuse view ids, so the stale entries are harmless.
+    if (IsAsyncCompositionEnabled()) {
+      continue;
+    }
     current_composition_params_.erase(viewId);
     clip_count_.erase(viewId);
     views_to_recomposite_.erase(viewId);
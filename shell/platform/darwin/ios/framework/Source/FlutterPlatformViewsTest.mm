@@ -2649,6 +2649,61 @@ fml::RefPtr<fml::TaskRunner> CreateNewThread(std::string name) {
     ;
 }
 
+- (void)testAsyncCompositionDoesNotMergeThreads {
+  flutter::FlutterPlatformViewsTestMockPlatformViewDelegate mock_delegate;
+  auto thread_task_runner_platform = CreateNewThread("FlutterPlatformViewsTest1");
+  auto thread_task_runner_other = CreateNewThread("FlutterPlatformViewsTest2");
+  flutter::TaskRunners runners(/*label=*/self.name.UTF8String,
+                               /*platform=*/thread_task_runner_platform,
+                               /*raster=*/thread_task_runner_other,
+                               /*ui=*/thread_task_runner_other,
+                               /*io=*/thread_task_runner_other);
+  auto flutterPlatformViewsController = std::make_shared<flutter::FlutterPlatformViewsController>();
+  flutterPlatformViewsController->EnableAsyncComposition(thread_task_runner_platform);
+  XCTAssertTrue(flutterPlatformViewsController->IsAsyncCompositionEnabled());
+  auto platform_view = std::make_unique<flutter::PlatformViewIOS>(
+      /*delegate=*/mock_delegate,
+      /*rendering_api=*/flutter::IOSRenderingAPI::kSoftware,
+      /*platform_views_controller=*/flutterPlatformViewsController,
+      /*task_runners=*/runners,
+      /*worker_task_runner=*/nil,
+      /*is_gpu_disabled_sync_switch=*/nil);
+
+  UIView* mockFlutterView = [[[UIView alloc] initWithFrame:CGRectMake(0, 0, 500, 500)] autorelease];
+  flutterPlatformViewsController->SetFlutterView(mockFlutterView);
+
+  FlutterPlatformViewsTestMockFlutterPlatformFactory* factory =
+      [[FlutterPlatformViewsTestMockFlutterPlatformFactory new] autorelease];
+  flutterPlatformViewsController->RegisterViewFactory(
+      factory, @"MockFlutterPlatformView",
+      FlutterPlatformViewGestureRecognizersBlockingPolicyEager);
+  XCTestExpectation* waitForPlatformView =
+      [self expectationWithDescription:@"wait for platform view to be created"];
+  FlutterResult result = ^(id result) {
+    [waitForPlatformView fulfill];
+  };
+
+  flutterPlatformViewsController->OnMethodCall(
+      [FlutterMethodCall
+          methodCallWithMethodName:@"create"
+                         arguments:@{@"id" : @2, @"viewType" : @"MockFlutterPlatformView"}],
+      result);
+  [self waitForExpectations:@[ waitForPlatformView ] timeout:30];
+  XCTAssertNotNil(gMockPlatformView);
+
+  flutterPlatformViewsController->BeginFrame(SkISize::Make(300, 300));
+  SkMatrix finalMatrix;
+  flutter::MutatorsStack stack;
+  auto embeddedViewParams =
+      std::make_unique<flutter::EmbeddedViewParams>(finalMatrix, SkSize::Make(300, 300), stack);
+  flutterPlatformViewsController->PrerollCompositeEmbeddedView(2, std::move(embeddedViewParams));
+
+  // The frame is drawn on the raster thread, so the merger isn't needed.
+  XCTAssertEqual(flutterPlatformViewsController->PostPrerollAction(nullptr),
+                 flutter::PostPrerollResult::kSuccess);
+  flutterPlatformViewsController->EndFrame(false, nullptr);
+}
+
 - (int)alphaOfPoint:(CGPoint)point onView:(UIView*)view {
   unsigned char pixel[4] = {0};
 
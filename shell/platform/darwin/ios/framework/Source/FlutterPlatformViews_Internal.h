@@ -170,6 +170,15 @@ class FlutterPlatformViewLayerPool {
       GrDirectContext* gr_context,
       const std::shared_ptr<IOSContext>& ios_context);
 
+  // Allocates layers until the pool holds at least `count` of them. Must be called on the platform
+  // thread, since the layers are backed by UIViews.
+  void EnsureLayerCount(size_t count,
+                        GrDirectContext* gr_context,
+                        const std::shared_ptr<IOSContext>& ios_context);
+
+  // The number of layers in the pool, used or not.
+  size_t GetLayerCount() const { return layers_.size(); }
+
   // Gets the layers in the pool that aren't currently used.
   // This method doesn't mark the layers as unused.
   std::vector<std::shared_ptr<FlutterPlatformViewLayer>> GetUnusedLayers();
@@ -193,6 +202,9 @@ class FlutterPlatformViewLayerPool {
   size_t available_layer_index_ = 0;
   std::vector<std::shared_ptr<FlutterPlatformViewLayer>> layers_;
 
+  // Appends a new layer to `layers_`.
+  void CreateLayer(GrDirectContext* gr_context, const std::shared_ptr<IOSContext>& ios_context);
+
   FML_DISALLOW_COPY_AND_ASSIGN(FlutterPlatformViewLayerPool);
 };
 
@@ -208,6 +220,18 @@ class FlutterPlatformViewsController {
 
   void SetFlutterViewController(UIViewController* flutter_view_controller);
 
+  // Keeps rasterization on the raster thread when platform views are present, instead of merging
+  // the raster thread with the platform thread. The overlays are drawn on the raster thread, and
+  // only the UIKit changes of each frame are posted to `platform_task_runner`, in a CATransaction.
+  //
+  // The UIKit changes aren't synchronized with the presentation of the Flutter content, so platform
+  // views may trail it by a frame while they move.
+  //
+  // Must be called on the platform thread before the first frame.
+  void EnableAsyncComposition(fml::RefPtr<fml::TaskRunner> platform_task_runner);
+
+  bool IsAsyncCompositionEnabled() const { return platform_task_runner_ != nullptr; }
+
   UIViewController* getFlutterViewController();
 
   void RegisterViewFactory(
@@ -271,12 +295,32 @@ class FlutterPlatformViewsController {
 
   using LayersMap = std::map<int64_t, std::vector<std::shared_ptr<FlutterPlatformViewLayer>>>;
 
+  // An overlay layer showing the part of a slice that is drawn over a platform view.
+  struct Overlay {
+    int64_t view_id;
+    // The index of the overlay among the overlays of the platform view.
+    int64_t overlay_id;
+    // In device pixels.
+    SkRect rect;
+    // Only valid on the raster thread, until the end of the frame.
+    EmbedderViewSlice* slice;
+    std::shared_ptr<FlutterPlatformViewLayer> layer;
+  };
+
+  // The UIKit changes of a frame that was drawn on the raster thread, with async composition.
+  struct CompositedFrame {
+    std::vector<int64_t> composition_order;
+    std::map<int64_t, EmbeddedViewParams> views_to_composite;
+    std::vector<Overlay> overlays;
+    std::vector<std::shared_ptr<FlutterPlatformViewLayer>> unused_layers;
+  };
+
   void OnCreate(FlutterMethodCall* call, FlutterResult& result);
   void OnDispose(FlutterMethodCall* call, FlutterResult& result);
   void OnAcceptGesture(FlutterMethodCall* call, FlutterResult& result);
   void OnRejectGesture(FlutterMethodCall* call, FlutterResult& result);
-  // Dispose the views in `views_to_dispose_`.
-  void DisposeViews();
+  // Dispose the views in `views_to_dispose_` that aren't in `composition_order`.
+  void DisposeViews(const std::vector<int64_t>& composition_order);
 
   // Returns true if there are embedded views in the scene at current frame
   // Or there will be embedded views in the next frame.
@@ -305,6 +349,11 @@ class FlutterPlatformViewsController {
 
   void CompositeWithParams(int64_t view_id, const EmbeddedViewParams& params);
 
+  // Clips the parts of the slices that are drawn over platform views out of `background_canvas`,
+  // and draws the rest of the slices on it. Returns the overlays needed for the clipped parts,
+  // without their layers.
+  std::vector<Overlay> CollectOverlays(DlCanvas* background_canvas);
+
   // Allocates a new FlutterPlatformViewLayer if needed, draws the pixels within the rect from
   // the picture on the layer's canvas.
   std::shared_ptr<FlutterPlatformViewLayer> GetLayer(GrDirectContext* gr_context,
@@ -313,12 +362,28 @@ class FlutterPlatformViewsController {
                                                      SkRect rect,
                                                      int64_t view_id,
                                                      int64_t overlay_id);
+  // Positions the overlay views of `layer` at `rect`. Must run on the platform thread.
+  void PlaceLayer(const FlutterPlatformViewLayer& layer,
+                  SkRect rect,
+                  int64_t view_id,
+                  int64_t overlay_id);
+  // Draws the pixels of `slice` within `rect` on the surface of `layer`.
+  void RenderLayer(FlutterPlatformViewLayer& layer, EmbedderViewSlice* slice, SkRect rect);
   // Removes overlay views and platform views that aren't needed in the current frame.
   // Must run on the platform thread.
-  void RemoveUnusedLayers();
+  void RemoveUnusedLayers(const std::vector<std::shared_ptr<FlutterPlatformViewLayer>>& layers,
+                          const std::vector<int64_t>& composition_order);
   // Appends the overlay views and platform view and sets their z index based on the composition
   // order.
-  void BringLayersIntoView(LayersMap layer_map);
+  void BringLayersIntoView(LayersMap layer_map, const std::vector<int64_t>& composition_order);
+
+  // Draws the frame and posts its UIKit changes to the platform thread, with async composition.
+  bool SubmitFrameAsync(GrDirectContext* gr_context,
+                        const std::shared_ptr<IOSContext>& ios_context,
+                        std::unique_ptr<SurfaceFrame> frame);
+
+  // Applies the UIKit changes of a frame drawn by |SubmitFrameAsync|, on the platform thread.
+  void CommitFrame(const CompositedFrame& frame);
 
   // Begin a CATransaction.
   // This transaction needs to be balanced with |CommitCATransactionIfNeeded|.
@@ -389,6 +454,14 @@ class FlutterPlatformViewsController {
 
   bool catransaction_added_ = false;
 
+  // Set with async composition, in which case the raster thread is never merged with the platform
+  // thread.
+  fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+
+  // Whether the last frame drawn with async composition had platform views. Only accessed on the
+  // raster thread.
+  bool did_composite_platform_views_ = false;
+
   // WeakPtrFactory must be the last member.
   std::unique_ptr<fml::WeakPtrFactory<FlutterPlatformViewsController>> weak_factory_;
 
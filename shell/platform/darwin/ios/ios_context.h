@@ -53,6 +53,9 @@ class IOSContext {
   /// @param[in]  msaa_samples
   ///                       The number of MSAA samples to use. Only supplied to
   ///                       Skia, must be either 0, 1, 2, 4, or 8.
+  /// @param[in]  wide_gamut_offscreens
+  ///                       Whether offscreens match a wide gamut surface, or
+  ///                       use 8-bit sRGB. Only supplied to Impeller.
   ///
   /// @return     A valid context on success. `nullptr` on failure.
   ///
@@ -60,7 +63,8 @@ class IOSContext {
       IOSRenderingAPI api,
       IOSRenderingBackend backend,
       MsaaSampleCount msaa_samples,
-      std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch);
+      std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
+      bool wide_gamut_offscreens = true);
 
   //----------------------------------------------------------------------------
   /// @brief      Collects the context object. This must happen on the thread on
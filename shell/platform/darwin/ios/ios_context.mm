@@ -22,7 +22,8 @@ std::unique_ptr<IOSContext> IOSContext::Create(
     IOSRenderingAPI api,
     IOSRenderingBackend backend,
     MsaaSampleCount msaa_samples,
-    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch) {
+    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
+    bool wide_gamut_offscreens) {
   switch (api) {
     case IOSRenderingAPI::kSoftware:
       return std::make_unique<IOSContextSoftware>();
@@ -32,7 +33,8 @@ std::unique_ptr<IOSContext> IOSContext::Create(
         case IOSRenderingBackend::kSkia:
           return std::make_unique<IOSContextMetalSkia>(msaa_samples);
         case IOSRenderingBackend::kImpeller:
-          return std::make_unique<IOSContextMetalImpeller>(std::move(is_gpu_disabled_sync_switch));
+          return std::make_unique<IOSContextMetalImpeller>(std::move(is_gpu_disabled_sync_switch),
+                                                           wide_gamut_offscreens);
       }
 #endif  // SHELL_ENABLE_METAL
     default:
@@ -9,11 +9,17 @@
 namespace flutter {
 
 IOSContextMetalImpeller::IOSContextMetalImpeller(
-    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch)
+    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
+    bool wide_gamut_offscreens)
     : IOSContext(MsaaSampleCount::kFour),
       darwin_context_metal_impeller_(fml::scoped_nsobject<FlutterDarwinContextMetalImpeller>{
           [[FlutterDarwinContextMetalImpeller alloc]
-              init:std::move(is_gpu_disabled_sync_switch)]}) {}
+              init:std::move(is_gpu_disabled_sync_switch)]}) {
+  if (darwin_context_metal_impeller_.get().context) {
+    darwin_context_metal_impeller_.get().context->SetUseStandardRangeOffscreens(
+        !wide_gamut_offscreens);
+  }
+}
 
 IOSContextMetalImpeller::~IOSContextMetalImpeller() = default;
 
@@ -85,7 +85,7 @@ void IOSExternalViewEmbedder::EndFrame(bool should_resubmit_frame,
 
 // |ExternalViewEmbedder|
 bool IOSExternalViewEmbedder::SupportsDynamicThreadMerging() {
-  return true;
+  return !platform_views_controller_->IsAsyncCompositionEnabled();
 }
 
 // |ExternalViewEmbedder|
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_IMAGE_GENERATOR_H_
+#define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_IMAGE_GENERATOR_H_
+
+#include <ImageIO/ImageIO.h>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/platform/darwin/cf_utils.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An image generator that decodes still JPEG and HEIF images with
+///             ImageIO, which uses the hardware decoder of the device where
+///             one is available.
+///
+///             Images are decoded in the sRGB color space with their EXIF
+///             orientation applied, and scaled down by ImageIO when a smaller
+///             size is requested. Every other format is left to the builtin
+///             decoders.
+///
+class IOSImageGenerator final : public ImageGenerator {
+ public:
+  ~IOSImageGenerator() override;
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  /// @brief  Creates a generator for |data| if it holds a single frame JPEG
+  ///         or HEIF image, and returns nullptr otherwise.
+  static std::shared_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  IOSImageGenerator(sk_sp<SkData> data,
+                    fml::CFRef<CGImageSourceRef> source,
+                    const SkImageInfo& image_info);
+
+  // Keeps the encoded bytes that |source_| reads from alive.
+  sk_sp<SkData> data_;
+  fml::CFRef<CGImageSourceRef> source_;
+  SkImageInfo image_info_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(IOSImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_IMAGE_GENERATOR_H_
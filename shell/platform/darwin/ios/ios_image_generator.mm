@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/ios/ios_image_generator.h"
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// EXIF orientations 5 through 8 rotate the image by 90 degrees.
+bool OrientationSwapsWidthHeight(int orientation) {
+  return orientation >= 5 && orientation <= 8;
+}
+
+int GetIntProperty(CFDictionaryRef properties, CFStringRef key, int default_value) {
+  auto number = static_cast<CFNumberRef>(CFDictionaryGetValue(properties, key));
+  int value = default_value;
+  if (!number || !CFNumberGetValue(number, kCFNumberIntType, &value)) {
+    return default_value;
+  }
+  return value;
+}
+
+bool IsHardwareDecodableType(CFStringRef type) {
+  return CFEqual(type, CFSTR("public.jpeg")) || CFEqual(type, CFSTR("public.heic")) ||
+         CFEqual(type, CFSTR("public.heif"));
+}
+
+}  // namespace
+
+IOSImageGenerator::IOSImageGenerator(sk_sp<SkData> data,
+                                     fml::CFRef<CGImageSourceRef> source,
+                                     const SkImageInfo& image_info)
+    : data_(std::move(data)), source_(std::move(source)), image_info_(image_info) {}
+
+IOSImageGenerator::~IOSImageGenerator() = default;
+
+const SkImageInfo& IOSImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int IOSImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int IOSImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo IOSImageGenerator::GetFrameInfo(unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize IOSImageGenerator::GetScaledDimensions(float desired_scale) {
+  if (desired_scale >= 1.0f) {
+    return image_info_.dimensions();
+  }
+  // ImageIO scales to any size while decoding, unlike the builtin codecs that
+  // only support a few fixed factors.
+  return SkISize::Make(
+      std::max(1, static_cast<int>(std::round(image_info_.width() * desired_scale))),
+      std::max(1, static_cast<int>(std::round(image_info_.height() * desired_scale))));
+}
+
+bool IOSImageGenerator::GetPixels(const SkImageInfo& info,
+                                  void* pixels,
+                                  size_t row_bytes,
+                                  unsigned int frame_index,
+                                  std::optional<unsigned int> prior_frame) {
+  if (frame_index != 0 || info.isEmpty() || info.colorType() != kRGBA_8888_SkColorType) {
+    FML_DLOG(ERROR) << "Unsupported destination for the ImageIO decoder.";
+    return false;
+  }
+  uint32_t bitmap_info = kCGBitmapByteOrder32Big;
+  switch (info.alphaType()) {
+    case kOpaque_SkAlphaType:
+      bitmap_info |= kCGImageAlphaNoneSkipLast;
+      break;
+    case kPremul_SkAlphaType:
+      bitmap_info |= kCGImageAlphaPremultipliedLast;
+      break;
+    default:
+      FML_DLOG(ERROR) << "Unsupported alpha type for the ImageIO decoder.";
+      return false;
+  }
+
+  @autoreleasepool {
+    // Decoding through the thumbnail API applies the EXIF orientation and
+    // lets ImageIO decode straight at the requested size.
+    NSDictionary* options = @{
+      (id)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+      (id)kCGImageSourceCreateThumbnailWithTransform : @YES,
+      (id)kCGImageSourceShouldCacheImmediately : @YES,
+      (id)kCGImageSourceThumbnailMaxPixelSize : @(std::max(info.width(), info.height())),
+    };
+    fml::CFRef<CGImageRef> image(
+        CGImageSourceCreateThumbnailAtIndex(source_, 0, (__bridge CFDictionaryRef)options));
+    if (!image) {
+      FML_DLOG(ERROR) << "ImageIO could not decode the image.";
+      return false;
+    }
+
+    fml::CFRef<CGColorSpaceRef> color_space(CGColorSpaceCreateWithName(kCGColorSpaceSRGB));
+    fml::CFRef<CGContextRef> context(CGBitmapContextCreate(
+        pixels, info.width(), info.height(), 8, row_bytes, color_space, bitmap_info));
+    if (!context) {
+      FML_DLOG(ERROR) << "Could not create a bitmap context for the decoded image.";
+      return false;
+    }
+    CGContextSetBlendMode(context, kCGBlendModeCopy);
+    CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+    CGContextDrawImage(context, CGRectMake(0, 0, info.width(), info.height()), image);
+  }
+  return true;
+}
+
+std::shared_ptr<ImageGenerator> IOSImageGenerator::MakeFromData(sk_sp<SkData> data) {
+  if (!data || data->size() == 0) {
+    return nullptr;
+  }
+  fml::CFRef<CFDataRef> cf_data(CFDataCreateWithBytesNoCopy(
+      kCFAllocatorDefault, data->bytes(), data->size(), kCFAllocatorNull));
+  fml::CFRef<CGImageSourceRef> source(CGImageSourceCreateWithData(cf_data, nullptr));
+  if (!source) {
+    return nullptr;
+  }
+  CFStringRef type = CGImageSourceGetType(source);
+  if (!type || !IsHardwareDecodableType(type) || CGImageSourceGetCount(source) != 1) {
+    return nullptr;
+  }
+
+  fml::CFRef<CFDictionaryRef> properties(CGImageSourceCopyPropertiesAtIndex(source, 0, nullptr));
+  if (!properties) {
+    return nullptr;
+  }
+  int width = GetIntProperty(properties, kCGImagePropertyPixelWidth, 0);
+  int height = GetIntProperty(properties, kCGImagePropertyPixelHeight, 0);
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  if (OrientationSwapsWidthHeight(GetIntProperty(properties, kCGImagePropertyOrientation, 1))) {
+    std::swap(width, height);
+  }
+  auto has_alpha =
+      static_cast<CFBooleanRef>(CFDictionaryGetValue(properties, kCGImagePropertyHasAlpha));
+  SkAlphaType alpha_type = has_alpha && CFBooleanGetValue(has_alpha) ? kPremul_SkAlphaType
+                                                                     : kOpaque_SkAlphaType;
+
+  return std::shared_ptr<IOSImageGenerator>(new IOSImageGenerator(
+      std::move(data), std::move(source),
+      SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, alpha_type)));
+}
+
+}  // namespace flutter
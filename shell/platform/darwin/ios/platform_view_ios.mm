@@ -65,7 +65,8 @@ PlatformViewIOS::PlatformViewIOS(
               delegate.OnPlatformViewGetSettings().enable_impeller ? IOSRenderingBackend::kImpeller
                                                                    : IOSRenderingBackend::kSkia,
               static_cast<MsaaSampleCount>(delegate.OnPlatformViewGetSettings().msaa_samples),
-              std::move(is_gpu_disabled_sync_switch)),
+              std::move(is_gpu_disabled_sync_switch),
+              delegate.OnPlatformViewGetSettings().enable_wide_gamut_offscreens),
           platform_views_controller,
           task_runners) {}
 
@@ -7,7 +7,10 @@
 
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -44,10 +47,12 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/host_allocator.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_flight_recorder.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -103,6 +108,11 @@ const int32_t kFlutterSemanticsCustomActionIdBatchEnd = -1;
 
 static constexpr int64_t kFlutterImplicitViewId = 0;
 
+// Janky frames tend to come in bursts, dumping the flight recorder for each of
+// them wouldn't tell more.
+static constexpr fml::TimeDelta kTraceFlightRecorderJankDumpInterval =
+    fml::TimeDelta::FromSeconds(10);
+
 // A message channel to send platform-independent FlutterKeyData to the
 // framework.
 //
@@ -242,6 +252,83 @@ static bool IsRendererValid(const FlutterRendererConfig* config) {
 }
 
 #if FML_OS_LINUX || FML_OS_WIN
+static_assert(static_cast<size_t>(kFlutterAllocationCategoryCount) ==
+              fml::kHostAllocationCategoryCount);
+static_assert(static_cast<int>(kFlutterAllocationCategoryMapping) ==
+              static_cast<int>(fml::HostAllocationCategory::kMapping));
+static_assert(static_cast<int>(kFlutterAllocationCategoryDisplayList) ==
+              static_cast<int>(fml::HostAllocationCategory::kDisplayList));
+static_assert(static_cast<int>(kFlutterAllocationCategoryImpeller) ==
+              static_cast<int>(fml::HostAllocationCategory::kImpeller));
+static_assert(static_cast<int>(kFlutterAllocationCategoryImageDecode) ==
+              static_cast<int>(fml::HostAllocationCategory::kImageDecode));
+
+static void* EmbedderAllocate(void* user_data,
+                              size_t size,
+                              fml::HostAllocationCategory category) {
+  auto allocator = static_cast<const FlutterCustomAllocator*>(user_data);
+  return allocator->allocate(allocator->user_data, size,
+                             static_cast<FlutterAllocationCategory>(category));
+}
+
+static void* EmbedderReallocate(void* user_data,
+                                void* allocation,
+                                size_t old_size,
+                                size_t new_size,
+                                fml::HostAllocationCategory category) {
+  auto allocator = static_cast<const FlutterCustomAllocator*>(user_data);
+  return allocator->reallocate(
+      allocator->user_data, allocation, old_size, new_size,
+      static_cast<FlutterAllocationCategory>(category));
+}
+
+static void EmbedderFree(void* user_data,
+                         void* allocation,
+                         size_t size,
+                         fml::HostAllocationCategory category) {
+  auto allocator = static_cast<const FlutterCustomAllocator*>(user_data);
+  allocator->free(allocator->user_data, allocation, size,
+                  static_cast<FlutterAllocationCategory>(category));
+}
+
+// Makes the custom allocator the host allocator of the process. The copies of
+// the allocators are leaked, since the host allocator refers to them from any
+// thread.
+static bool SetCustomAllocator(const FlutterCustomAllocator* custom_allocator) {
+  static std::mutex mutex;
+  static const FlutterCustomAllocator* current = nullptr;
+
+  auto copy = std::make_unique<FlutterCustomAllocator>();
+  copy->struct_size = sizeof(FlutterCustomAllocator);
+  copy->user_data = SAFE_ACCESS(custom_allocator, user_data, nullptr);
+  copy->allocate = SAFE_ACCESS(custom_allocator, allocate, nullptr);
+  copy->reallocate = SAFE_ACCESS(custom_allocator, reallocate, nullptr);
+  copy->free = SAFE_ACCESS(custom_allocator, free, nullptr);
+  if (copy->allocate == nullptr || copy->reallocate == nullptr ||
+      copy->free == nullptr) {
+    return false;
+  }
+
+  std::scoped_lock lock(mutex);
+  if (current != nullptr && current->user_data == copy->user_data &&
+      current->allocate == copy->allocate &&
+      current->reallocate == copy->reallocate &&
+      current->free == copy->free) {
+    return true;
+  }
+
+  fml::HostAllocator host_allocator;
+  host_allocator.user_data = copy.get();
+  host_allocator.allocate = EmbedderAllocate;
+  host_allocator.reallocate = EmbedderReallocate;
+  host_allocator.free = EmbedderFree;
+  if (!fml::SetHostAllocator(&host_allocator)) {
+    return false;
+  }
+  current = copy.release();
+  return true;
+}
+
 static void* DefaultGLProcResolver(const char* name) {
   static fml::RefPtr<fml::NativeLibrary> proc_library =
 #if FML_OS_LINUX
@@ -1688,6 +1775,16 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
                               "The renderer configuration was invalid.");
   }
 
+  // Must come first, since the allocator can't be replaced once the engine
+  // allocates with it.
+  if (SAFE_ACCESS(args, custom_allocator, nullptr) != nullptr &&
+      !SetCustomAllocator(args->custom_allocator)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The custom allocator was incomplete, or another allocator still has "
+        "live allocations.");
+  }
+
   std::string icu_data_path;
   if (SAFE_ACCESS(args, icu_data_path, nullptr) != nullptr) {
     icu_data_path = SAFE_ACCESS(args, icu_data_path, nullptr);
@@ -1774,6 +1871,47 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
 
+  if (SAFE_ACCESS(args, trace_flight_recorder_records_per_thread, 0) > 0) {
+    fml::tracing::TraceEnableFlightRecorder(
+        args->trace_flight_recorder_records_per_thread);
+  }
+  if (SAFE_ACCESS(args, trace_flight_recorder_jank_callback, nullptr) !=
+      nullptr) {
+    if (fml::tracing::TraceGetFlightRecorder() == nullptr) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "A trace flight recorder jank callback was specified, but "
+          "trace_flight_recorder_records_per_thread was 0.");
+    }
+    const auto jank_threshold = fml::TimeDelta::FromNanoseconds(
+        SAFE_ACCESS(args, trace_flight_recorder_jank_threshold_nanos, 0));
+    if (jank_threshold <= fml::TimeDelta::Zero()) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "A trace flight recorder jank callback was specified, but "
+          "trace_flight_recorder_jank_threshold_nanos was 0.");
+    }
+    settings.frame_rasterized_callback =
+        [callback = args->trace_flight_recorder_jank_callback, user_data,
+         jank_threshold, last_dump = std::optional<fml::TimePoint>{}](
+            const flutter::FrameTiming& timing) mutable {
+          if (timing.Get(flutter::FrameTiming::kRasterFinish) -
+                  timing.Get(flutter::FrameTiming::kVsyncStart) <
+              jank_threshold) {
+            return;
+          }
+          const auto now = fml::TimePoint::Now();
+          if (last_dump.has_value() &&
+              now - last_dump.value() < kTraceFlightRecorderJankDumpInterval) {
+            return;
+          }
+          last_dump = now;
+          TRACE_EVENT0("flutter", "DumpTraceFlightRecorder");
+          const auto trace = fml::tracing::TraceGetFlightRecorder()->Dump();
+          callback(trace.data(), trace.size(), user_data);
+        };
+  }
+
   bool has_update_semantics_2_callback =
       SAFE_ACCESS(args, update_semantics_callback2, nullptr) != nullptr;
   bool has_update_semantics_callback =
@@ -2047,6 +2185,22 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
         "Could not infer the Flutter project to run from given arguments.");
   }
 
+  std::vector<std::string> prefetch_assets;
+  if (SAFE_ACCESS(args, prefetch_asset_count, 0) > 0) {
+    if (SAFE_ACCESS(args, prefetch_assets, nullptr) == nullptr) {
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Could not determine the assets to prefetch "
+                                "as prefetch_asset_count was set, but "
+                                "prefetch_assets was null.");
+    }
+    prefetch_assets.reserve(args->prefetch_asset_count);
+    for (size_t i = 0; i < args->prefetch_asset_count; ++i) {
+      if (args->prefetch_assets[i] != nullptr) {
+        prefetch_assets.emplace_back(args->prefetch_assets[i]);
+      }
+    }
+  }
+
   // Create the engine but don't launch the shell or run the root isolate.
   auto embedder_engine = std::make_unique<flutter::EmbedderEngine>(
       std::move(thread_host),               //
@@ -2058,6 +2212,10 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
       std::move(external_texture_resolver)  //
   );
 
+  // Start reading the assets while the embedder finishes its setup and runs
+  // the engine.
+  embedder_engine->PrefetchAssets(prefetch_assets);
+
   // Release the ownership of the embedder engine to the caller.
   *engine_out = reinterpret_cast<FLUTTER_API_SYMBOL(FlutterEngine)>(
       embedder_engine.release());
@@ -2786,6 +2944,29 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "Could not run the specified task.");
 }
 
+FlutterEngineResult FlutterEngineRunTasks(FLUTTER_API_SYMBOL(FlutterEngine)
+                                              engine,
+                                          FlutterTaskRunner runner,
+                                          uint64_t deadline_nanos) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  // UINT64_MAX doesn't fit in a time point.
+  constexpr uint64_t kMaxDeadlineNanos = std::numeric_limits<int64_t>::max();
+  const auto deadline = deadline_nanos > kMaxDeadlineNanos
+                            ? fml::TimePoint::Max()
+                            : fml::TimePoint::FromEpochDelta(
+                                  fml::TimeDelta::FromNanoseconds(
+                                      deadline_nanos));
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->RunTasks(runner, deadline)
+                 .has_value()
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                  "The task runner does not batch its tasks.");
+}
+
 static bool DispatchJSONPlatformMessage(FLUTTER_API_SYMBOL(FlutterEngine)
                                             engine,
                                         const rapidjson::Document& document,
@@ -3149,6 +3330,160 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineGetStartupMetrics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineStartupMetrics* metrics) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (metrics == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Startup metrics were null.");
+  }
+
+  flutter::EmbedderEngine* embedder_engine =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (!embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was not running.");
+  }
+
+  const flutter::StartupMetrics& startup_metrics =
+      embedder_engine->GetShell().GetStartupMetrics();
+  auto get_timing = [&startup_metrics](flutter::StartupMetrics::Phase phase,
+                                       uint64_t* begin_nanos,
+                                       uint64_t* end_nanos) {
+    const auto timing = startup_metrics.GetTiming(phase);
+    if (!timing.IsComplete()) {
+      *begin_nanos = 0;
+      *end_nanos = 0;
+      return;
+    }
+    *begin_nanos = timing.begin->ToEpochDelta().ToNanoseconds();
+    *end_nanos = timing.end->ToEpochDelta().ToNanoseconds();
+  };
+
+  if (STRUCT_HAS_MEMBER(metrics, shell_creation_end_nanos)) {
+    get_timing(flutter::StartupMetrics::Phase::kShellCreation,
+               &metrics->shell_creation_begin_nanos,
+               &metrics->shell_creation_end_nanos);
+  }
+  if (STRUCT_HAS_MEMBER(metrics, dart_vm_creation_end_nanos)) {
+    get_timing(flutter::StartupMetrics::Phase::kDartVMCreation,
+               &metrics->dart_vm_creation_begin_nanos,
+               &metrics->dart_vm_creation_end_nanos);
+  }
+  if (STRUCT_HAS_MEMBER(metrics, font_loading_end_nanos)) {
+    get_timing(flutter::StartupMetrics::Phase::kFontLoading,
+               &metrics->font_loading_begin_nanos,
+               &metrics->font_loading_end_nanos);
+  }
+  if (STRUCT_HAS_MEMBER(metrics, root_isolate_creation_end_nanos)) {
+    get_timing(flutter::StartupMetrics::Phase::kRootIsolateCreation,
+               &metrics->root_isolate_creation_begin_nanos,
+               &metrics->root_isolate_creation_end_nanos);
+  }
+  if (STRUCT_HAS_MEMBER(metrics, first_frame_end_nanos)) {
+    get_timing(flutter::StartupMetrics::Phase::kFirstFrame,
+               &metrics->first_frame_begin_nanos,
+               &metrics->first_frame_end_nanos);
+  }
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineGetFrameStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineFrameStatistics* statistics) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (statistics == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Frame statistics were null.");
+  }
+
+  flutter::EmbedderEngine* embedder_engine =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (!embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was not running.");
+  }
+
+  const auto snapshot =
+      embedder_engine->GetShell().GetFrameStatistics().GetSnapshot();
+  auto get_percentiles =
+      [](const flutter::FrameStatistics::Percentiles& percentiles) {
+        return FlutterFrameDurationPercentiles{
+            .p50_nanos = static_cast<uint64_t>(percentiles.p50.ToNanoseconds()),
+            .p90_nanos = static_cast<uint64_t>(percentiles.p90.ToNanoseconds()),
+            .p99_nanos = static_cast<uint64_t>(percentiles.p99.ToNanoseconds()),
+        };
+      };
+
+  if (STRUCT_HAS_MEMBER(statistics, dropped_frame_count)) {
+    statistics->frame_count = snapshot.frame_count;
+    statistics->janky_frame_count = snapshot.janky_frame_count;
+    statistics->dropped_frame_count = snapshot.dropped_frame_count;
+  }
+  if (STRUCT_HAS_MEMBER(statistics, raster)) {
+    statistics->sample_count = snapshot.sample_count;
+    statistics->build = get_percentiles(snapshot.build);
+    statistics->raster = get_percentiles(snapshot.raster);
+  }
+  if (STRUCT_HAS_MEMBER(statistics, gpu)) {
+    statistics->gpu_sample_count = snapshot.gpu_sample_count;
+    statistics->gpu = get_percentiles(snapshot.gpu);
+  }
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineDumpTraceFlightRecorder(
+    FlutterTraceFlightRecorderDumpCallback callback,
+    void* user_data) {
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Trace flight recorder dump callback was null.");
+  }
+
+  fml::tracing::TraceFlightRecorder* recorder =
+      fml::tracing::TraceGetFlightRecorder();
+  if (recorder == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The trace flight recorder was not enabled.");
+  }
+
+  const auto trace = recorder->Dump();
+  callback(trace.data(), trace.size(), user_data);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineGetAllocationStatistics(
+    FlutterAllocationCategory category,
+    FlutterAllocationStatistics* statistics) {
+  if (static_cast<size_t>(category) >= fml::kHostAllocationCategoryCount) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid allocation category.");
+  }
+
+  if (statistics == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Allocation statistics were null.");
+  }
+
+  const fml::HostAllocationStats stats = fml::GetHostAllocationStats(
+      static_cast<fml::HostAllocationCategory>(category));
+  if (STRUCT_HAS_MEMBER(statistics, allocation_count)) {
+    statistics->allocation_count = stats.allocation_count;
+  }
+  if (STRUCT_HAS_MEMBER(statistics, allocated_bytes)) {
+    statistics->allocated_bytes = stats.allocated_bytes;
+  }
+  if (STRUCT_HAS_MEMBER(statistics, peak_allocated_bytes)) {
+    statistics->peak_allocated_bytes = stats.peak_allocated_bytes;
+  }
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -3201,6 +3536,11 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(GetStartupMetrics, FlutterEngineGetStartupMetrics);
+  SET_PROC(DumpTraceFlightRecorder, FlutterEngineDumpTraceFlightRecorder);
+  SET_PROC(GetAllocationStatistics, FlutterEngineGetAllocationStatistics);
+  SET_PROC(RunTasks, FlutterEngineRunTasks);
+  SET_PROC(GetFrameStatistics, FlutterEngineGetFrameStatistics);
 #undef SET_PROC
 
   return kSuccess;
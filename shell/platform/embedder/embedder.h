@@ -1428,6 +1428,11 @@ typedef void (*FlutterTaskRunnerPostTaskCallback)(
     uint64_t /* target time nanos */,
     void* /* user data */);
 
+typedef void (*FlutterTaskRunnerWakeUpCallback)(
+    FlutterTaskRunner /* task runner */,
+    uint64_t /* target time nanos */,
+    void* /* user data */);
+
 /// An interface used by the Flutter engine to execute tasks at the target time
 /// on a specified thread. There should be a 1-1 relationship between a thread
 /// and a task runner. It is undefined behavior to run a task on a thread that
@@ -1450,11 +1455,23 @@ typedef struct {
   /// delta, `FlutterEngineGetCurrentTime` may be called and the difference used
   /// as the delta.
   ///
-  /// @attention     This field is required.
+  /// @attention     This field is required, unless `wake_up_callback` is set.
   FlutterTaskRunnerPostTaskCallback post_task_callback;
   /// A unique identifier for the task runner. If multiple task runners service
   /// tasks on the same thread, their identifiers must match.
   size_t identifier;
+  /// Optional. Batches the tasks of the task runner, which cuts the overhead
+  /// of running many small tasks. If set, `post_task_callback` is not used:
+  /// the engine queues the tasks itself, and calls this callback with the
+  /// earliest target time of the queued tasks instead. The embedder should
+  /// then call `FlutterEngineRunTasks` once on the thread of the task runner
+  /// at that time, to run all the tasks that are due. The engine only calls
+  /// this again when a task is due before the wake up the embedder already
+  /// has, or when tasks are left after `FlutterEngineRunTasks`, so a single
+  /// pending wake up per task runner is enough. May be called from any thread,
+  /// including from within `FlutterEngineRunTasks`. The target time is in the
+  /// timebase of `FlutterEngineGetCurrentTime`.
+  FlutterTaskRunnerWakeUpCallback wake_up_callback;
 } FlutterTaskRunnerDescription;
 
 typedef struct {
@@ -1823,6 +1840,61 @@ typedef enum {
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
+/// The timestamps of the startup phases of an engine, as reported by
+/// `FlutterEngineGetStartupMetrics`. Each phase begins and ends at a time in
+/// the timebase of `FlutterEngineGetCurrentTime`, in nanoseconds.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineStartupMetrics).
+  size_t struct_size;
+  /// From the start of the engine launch until the shell is set up. Includes
+  /// the creation of the Dart VM and the setup of the engine threads.
+  uint64_t shell_creation_begin_nanos;
+  uint64_t shell_creation_end_nanos;
+  /// The creation of the Dart VM. Close to zero if the VM was already running.
+  uint64_t dart_vm_creation_begin_nanos;
+  uint64_t dart_vm_creation_end_nanos;
+  /// The setup of the default font manager.
+  uint64_t font_loading_begin_nanos;
+  uint64_t font_loading_end_nanos;
+  /// The creation of the running root isolate.
+  uint64_t root_isolate_creation_begin_nanos;
+  uint64_t root_isolate_creation_end_nanos;
+  /// From the beginning of the first frame until it has been rasterized.
+  uint64_t first_frame_begin_nanos;
+  uint64_t first_frame_end_nanos;
+} FlutterEngineStartupMetrics;
+
+/// Percentiles of the durations of the last frames, in nanoseconds.
+typedef struct {
+  uint64_t p50_nanos;
+  uint64_t p90_nanos;
+  uint64_t p99_nanos;
+} FlutterFrameDurationPercentiles;
+
+/// The rolling statistics of the frames rasterized by an engine, as reported
+/// by `FlutterEngineGetFrameStatistics`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineFrameStatistics).
+  size_t struct_size;
+  /// The number of frames rasterized since the engine was launched.
+  uint64_t frame_count;
+  /// The number of those frames whose build or raster took longer than the
+  /// frame budget of the display.
+  uint64_t janky_frame_count;
+  /// The number of frames the rasterizer dropped since the engine was
+  /// launched.
+  uint64_t dropped_frame_count;
+  /// The number of the last frames the build and raster percentiles are
+  /// computed over.
+  size_t sample_count;
+  FlutterFrameDurationPercentiles build;
+  FlutterFrameDurationPercentiles raster;
+  /// The number of those frames whose GPU duration was measured, which the
+  /// GPU percentiles are computed over.
+  size_t gpu_sample_count;
+  FlutterFrameDurationPercentiles gpu;
+} FlutterEngineFrameStatistics;
+
 typedef int64_t FlutterEngineDartPort;
 
 typedef enum {
@@ -1947,6 +2019,80 @@ typedef void (*FlutterLogMessageCallback)(const char* /* tag */,
                                           const char* /* message */,
                                           void* /* user_data */);
 
+/// The callback that receives a trace of the most recent trace events of the
+/// engine threads, in the protobuf format of Perfetto
+/// (https://perfetto.dev/docs/reference/trace-packet-proto). The data is only
+/// valid for the duration of the callback.
+typedef void (*FlutterTraceFlightRecorderDumpCallback)(
+    const uint8_t* /* data */,
+    size_t /* size */,
+    void* /* user_data */);
+
+/// The large host memory allocations of the engine, which are made with the
+/// `FlutterCustomAllocator` and accounted for separately.
+typedef enum {
+  /// Buffers holding copies of data, mostly assets and platform messages.
+  kFlutterAllocationCategoryMapping,
+  /// The recorded drawing operations of display lists.
+  kFlutterAllocationCategoryDisplayList,
+  /// The host buffers of the Impeller renderer, such as staged uniform and
+  /// vertex data.
+  kFlutterAllocationCategoryImpeller,
+  /// The pixels of decoded images before they are uploaded to the GPU.
+  kFlutterAllocationCategoryImageDecode,
+  kFlutterAllocationCategoryCount,
+} FlutterAllocationCategory;
+
+/// Returns a new allocation of `size` bytes, aligned like `malloc`, or null on
+/// failure.
+typedef void* (*FlutterAllocateCallback)(
+    void* /* user_data */,
+    size_t /* size */,
+    FlutterAllocationCategory /* category */);
+
+/// Resizes an allocation like `realloc`, keeping its contents. Returns null on
+/// failure, in which case the allocation must be left unchanged.
+typedef void* (*FlutterReallocateCallback)(
+    void* /* user_data */,
+    void* /* allocation */,
+    size_t /* old_size */,
+    size_t /* new_size */,
+    FlutterAllocationCategory /* category */);
+
+/// Frees an allocation, which is never null.
+typedef void (*FlutterFreeCallback)(void* /* user_data */,
+                                    void* /* allocation */,
+                                    size_t /* size */,
+                                    FlutterAllocationCategory /* category */);
+
+/// The allocator the engine makes its large host memory allocations with,
+/// instead of `malloc`. The sizes are passed back on reallocation and free so
+/// that the allocator does not need to track them. The callbacks may be
+/// invoked on any thread, and must stay valid for the lifetime of the process.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterCustomAllocator).
+  size_t struct_size;
+  /// The user data passed to the callbacks.
+  void* user_data;
+  FlutterAllocateCallback allocate;
+  FlutterReallocateCallback reallocate;
+  FlutterFreeCallback free;
+} FlutterCustomAllocator;
+
+/// The allocations of a `FlutterAllocationCategory`, as reported by
+/// `FlutterEngineGetAllocationStatistics`. These are tracked whether or not a
+/// `FlutterCustomAllocator` is in use.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterAllocationStatistics).
+  size_t struct_size;
+  /// The number of live allocations.
+  uint64_t allocation_count;
+  /// The size of the live allocations, in bytes.
+  uint64_t allocated_bytes;
+  /// The most the live allocations have added up to, in bytes.
+  uint64_t peak_allocated_bytes;
+} FlutterAllocationStatistics;
+
 /// An opaque object that describes the AOT data that can be used to launch a
 /// FlutterEngine instance in AOT mode.
 typedef struct _FlutterEngineAOTData* FlutterEngineAOTData;
@@ -2238,6 +2384,44 @@ typedef struct {
   /// being registered on the framework side. The callback is invoked from
   /// a task posted to the platform thread.
   FlutterChannelUpdateCallback channel_update_callback;
+
+  /// The number of asset names in `prefetch_assets`.
+  size_t prefetch_asset_count;
+
+  /// Optional. The names of assets, relative to `assets_path`, that the
+  /// application reads early on, like its fonts, shaders and the images of
+  /// its first screen. The engine starts reading them in parallel on
+  /// background threads during `FlutterEngineInitialize`, before the engine
+  /// is run, and keeps them in a small cache until the application first
+  /// reads them. The names are copied by the engine.
+  const char* const* prefetch_assets;
+
+  /// Optional. The number of trace events that the trace flight recorder keeps
+  /// per thread. If non-zero, the trace events of the engine are recorded in
+  /// memory, even in release mode, so that they can be dumped with
+  /// `FlutterEngineDumpTraceFlightRecorder` or when a frame is janky. Once
+  /// enabled, the flight recorder keeps recording for the lifetime of the
+  /// process, and only the first engine that enables it sets its size.
+  size_t trace_flight_recorder_records_per_thread;
+
+  /// Optional. Called with a dump of the trace flight recorder when a frame
+  /// took longer than `trace_flight_recorder_jank_threshold_nanos` from the
+  /// vsync until it was rasterized, at most once every 10 seconds. The
+  /// callback is invoked on the raster thread with the `user_data` of the
+  /// engine. Requires `trace_flight_recorder_records_per_thread` to be set.
+  FlutterTraceFlightRecorderDumpCallback trace_flight_recorder_jank_callback;
+
+  /// The duration of a frame above which it is considered janky by the trace
+  /// flight recorder. Must be set if `trace_flight_recorder_jank_callback` is.
+  uint64_t trace_flight_recorder_jank_threshold_nanos;
+
+  /// Optional. The allocator for the large host memory allocations of the
+  /// engine, which otherwise uses `malloc`. The allocator is process wide: it
+  /// is set by the first engine that specifies one, and stays in use after
+  /// that engine shuts down. Another allocator can only be specified once all
+  /// the allocations of the previous one have been freed, and engines that do
+  /// not specify an allocator keep using the current one.
+  const FlutterCustomAllocator* custom_allocator;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -2754,6 +2938,29 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                              engine,
                                          const FlutterTask* task);
 
+//------------------------------------------------------------------------------
+/// @brief      Runs the tasks of a task runner with a
+///             `FlutterTaskRunnerDescription.wake_up_callback` that are due,
+///             in order, until none are left or the deadline has passed. At
+///             least one due task is run. Must be called on the thread of the
+///             task runner, once the target time given to the wake up
+///             callback has been reached.
+///
+/// @param[in]  engine          A running engine instance.
+/// @param[in]  runner          The task runner given to the wake up callback.
+/// @param[in]  deadline_nanos  The time in the timebase of
+///                             `FlutterEngineGetCurrentTime` after which no
+///                             more tasks are started. Pass UINT64_MAX to run
+///                             all the tasks that are due.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRunTasks(FLUTTER_API_SYMBOL(FlutterEngine)
+                                              engine,
+                                          FlutterTaskRunner runner,
+                                          uint64_t deadline_nanos);
+
 //------------------------------------------------------------------------------
 /// @brief      Notify a running engine instance that the locale has been
 ///             updated. The preferred locale must be the first item in the list
@@ -2931,6 +3138,74 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the timestamps of the startup phases of the engine. The
+///             timestamps are in the timebase of
+///             `FlutterEngineGetCurrentTime`. Both timestamps of a phase are 0
+///             until the phase has completed. This may be called on any
+///             thread.
+///
+/// @param[in]  engine   A running engine instance.
+/// @param[out] metrics  The metrics to fill. The struct_size must be set by
+///                      the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetStartupMetrics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineStartupMetrics* metrics);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the rolling statistics of the frames rasterized by the
+///             engine. This is cheap enough to be sampled periodically by
+///             production telemetry, and does not need the performance
+///             overlay. This may be called on any thread.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[out] statistics  The statistics to fill. The struct_size must be set
+///                         by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineFrameStatistics* statistics);
+
+//------------------------------------------------------------------------------
+/// @brief      Dumps the trace events recorded by the trace flight recorder,
+///             which must have been enabled with
+///             `trace_flight_recorder_records_per_thread`. The threads of the
+///             engine keep recording while the events are dumped. This may be
+///             called on any thread.
+///
+/// @param[in]  callback   Called with the trace before this call returns.
+/// @param[in]  user_data  The user data passed to the callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineDumpTraceFlightRecorder(
+    FlutterTraceFlightRecorderDumpCallback callback,
+    void* user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the live allocations of a category, across all the engines
+///             in the process. This may be called on any thread, including
+///             before any engine is initialized.
+///
+/// @param[in]  category    The category of allocations.
+/// @param[out] statistics  The statistics to fill. The struct_size must be set
+///                         by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetAllocationStatistics(
+    FlutterAllocationCategory category,
+    FlutterAllocationStatistics* statistics);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -3053,6 +3328,22 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetStartupMetricsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineStartupMetrics* metrics);
+typedef FlutterEngineResult (*FlutterEngineDumpTraceFlightRecorderFnPtr)(
+    FlutterTraceFlightRecorderDumpCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetAllocationStatisticsFnPtr)(
+    FlutterAllocationCategory category,
+    FlutterAllocationStatistics* statistics);
+typedef FlutterEngineResult (*FlutterEngineRunTasksFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner runner,
+    uint64_t deadline_nanos);
+typedef FlutterEngineResult (*FlutterEngineGetFrameStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineFrameStatistics* statistics);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -3099,6 +3390,11 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineGetStartupMetricsFnPtr GetStartupMetrics;
+  FlutterEngineDumpTraceFlightRecorderFnPtr DumpTraceFlightRecorder;
+  FlutterEngineGetAllocationStatisticsFnPtr GetAllocationStatistics;
+  FlutterEngineRunTasksFnPtr RunTasks;
+  FlutterEngineGetFrameStatisticsFnPtr GetFrameStatistics;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
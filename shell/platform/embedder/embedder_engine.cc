@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "flutter/fml/make_copyable.h"
 #include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
 
@@ -60,6 +63,22 @@ bool EmbedderEngine::LaunchShell() {
   return IsValid();
 }
 
+void EmbedderEngine::PrefetchAssets(
+    const std::vector<std::string>& asset_names) {
+  auto asset_manager = run_configuration_.GetAssetManager();
+  if (asset_names.empty() || !asset_manager) {
+    return;
+  }
+  if (!asset_prefetch_loop_) {
+    // Reading assets is bound by storage rather than by the CPU, so a few
+    // workers are enough to keep the reads in flight.
+    const size_t worker_count =
+        std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+    asset_prefetch_loop_ = fml::ConcurrentMessageLoop::Create(worker_count);
+  }
+  asset_manager->Prefetch(asset_names, asset_prefetch_loop_->GetTaskRunner());
+}
+
 bool EmbedderEngine::CollectShell() {
   shell_.reset();
   return IsValid();
@@ -247,6 +266,15 @@ bool EmbedderEngine::RunTask(const FlutterTask* task) {
                                 task->task);
 }
 
+std::optional<size_t> EmbedderEngine::RunTasks(FlutterTaskRunner runner,
+                                               fml::TimePoint deadline) {
+  // Like |RunTask|, this does not need the shell to be running.
+  if (runner == nullptr) {
+    return std::nullopt;
+  }
+  return thread_host_->RunTasks(reinterpret_cast<int64_t>(runner), deadline);
+}
+
 bool EmbedderEngine::PostTaskOnEngineManagedNativeThreads(
     const std::function<void(FlutterNativeThreadType)>& closure) const {
   if (!IsValid() || closure == nullptr) {
@@ -6,8 +6,12 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
@@ -36,6 +40,11 @@ class EmbedderEngine {
 
   bool LaunchShell();
 
+  // Starts reading the given assets on a small pool of worker threads that is
+  // owned by the engine, so that they are cached by the time the application
+  // asks for them.
+  void PrefetchAssets(const std::vector<std::string>& asset_names);
+
   bool CollectShell();
 
   const TaskRunners& GetTaskRunners() const;
@@ -80,6 +89,9 @@ class EmbedderEngine {
 
   bool RunTask(const FlutterTask* task);
 
+  std::optional<size_t> RunTasks(FlutterTaskRunner runner,
+                                 fml::TimePoint deadline);
+
   bool PostTaskOnEngineManagedNativeThreads(
       const std::function<void(FlutterNativeThreadType)>& closure) const;
 
@@ -94,6 +106,7 @@ class EmbedderEngine {
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
+  std::shared_ptr<fml::ConcurrentMessageLoop> asset_prefetch_loop_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
@@ -112,4 +112,11 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
   );
 }
 
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::AllowsConcurrentRasterization() const {
+  // The backing stores are owned by the engine and are only handed to the
+  // embedder once they are presented.
+  return true;
+}
+
 }  // namespace flutter
@@ -16,7 +16,8 @@ EmbedderTaskRunner::EmbedderTaskRunner(DispatchTable table,
       dispatch_table_(std::move(table)),
       placeholder_id_(
           fml::MessageLoopTaskQueues::GetInstance()->CreateTaskQueue()) {
-  FML_DCHECK(dispatch_table_.post_task_callback);
+  FML_DCHECK(dispatch_table_.post_task_callback ||
+             dispatch_table_.wake_up_callback);
   FML_DCHECK(dispatch_table_.runs_task_on_current_thread_callback);
 }
 
@@ -36,6 +37,23 @@ void EmbedderTaskRunner::PostTaskForTime(const fml::closure& task,
     return;
   }
 
+  if (dispatch_table_.wake_up_callback) {
+    bool needs_wake_up = false;
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      queued_tasks_.emplace(target_time, task);
+      if (!requested_wake_up_.has_value() ||
+          target_time < requested_wake_up_.value()) {
+        requested_wake_up_ = target_time;
+        needs_wake_up = true;
+      }
+    }
+    if (needs_wake_up) {
+      dispatch_table_.wake_up_callback(this, target_time);
+    }
+    return;
+  }
+
   uint64_t baton = 0;
 
   {
@@ -78,6 +96,57 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
   return true;
 }
 
+bool EmbedderTaskRunner::UsesWakeUps() const {
+  return static_cast<bool>(dispatch_table_.wake_up_callback);
+}
+
+size_t EmbedderTaskRunner::RunTasks(fml::TimePoint deadline) {
+  FML_DCHECK(UsesWakeUps());
+
+  {
+    // The wake up has happened, tasks posted from here on need another one.
+    std::scoped_lock lock(tasks_mutex_);
+    requested_wake_up_.reset();
+  }
+
+  size_t run_count = 0;
+  while (true) {
+    fml::closure task;
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      if (queued_tasks_.empty()) {
+        break;
+      }
+      const auto now = fml::TimePoint::Now();
+      auto next = queued_tasks_.begin();
+      if (next->first > now || (run_count > 0 && now >= deadline)) {
+        break;
+      }
+      task = std::move(next->second);
+      queued_tasks_.erase(next);
+    }
+    task();
+    run_count++;
+  }
+
+  std::optional<fml::TimePoint> wake_up;
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    if (!queued_tasks_.empty()) {
+      const auto next_target_time = queued_tasks_.begin()->first;
+      if (!requested_wake_up_.has_value() ||
+          next_target_time < requested_wake_up_.value()) {
+        requested_wake_up_ = next_target_time;
+        wake_up = next_target_time;
+      }
+    }
+  }
+  if (wake_up.has_value()) {
+    dispatch_table_.wake_up_callback(this, wake_up.value());
+  }
+  return run_count;
+}
+
 // |fml::TaskRunner|
 fml::TaskQueueId EmbedderTaskRunner::GetTaskQueueId() {
   return placeholder_id_;
@@ -5,7 +5,9 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 
+#include <map>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -39,6 +41,15 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
     /// thread.
     ///
     std::function<bool(void)> runs_task_on_current_thread_callback;
+    //--------------------------------------------------------------------------
+    /// Optional. If set, tasks are queued by the task runner instead of being
+    /// handed to the `post_task_callback` one by one. The embedder is asked to
+    /// call `EmbedderTaskRunner::RunTasks` on the correct thread once
+    /// `target_time` is reached, and is only asked again for an earlier time.
+    ///
+    std::function<void(EmbedderTaskRunner* task_runner,
+                       fml::TimePoint target_time)>
+        wake_up_callback;
   };
 
   //----------------------------------------------------------------------------
@@ -71,12 +82,37 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
 
   bool PostTask(uint64_t baton);
 
+  /// Whether the task runner queues its tasks and asks the embedder for wake
+  /// ups, rather than posting each task to the embedder.
+  bool UsesWakeUps() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the queued tasks whose target time has been reached, in
+  ///             order, until there are none left or the deadline passes. At
+  ///             least one expired task is run, so that the embedder always
+  ///             makes progress. The embedder is then asked for a wake up
+  ///             at the target time of the next task, if there is one.
+  ///
+  ///             Only for task runners that `UsesWakeUps`, and must be called
+  ///             on the thread of the task runner.
+  ///
+  /// @param[in]  deadline  The time after which no further tasks are run.
+  ///
+  /// @return     The number of tasks that were run.
+  ///
+  size_t RunTasks(fml::TimePoint deadline);
+
  private:
   const size_t embedder_identifier_;
   DispatchTable dispatch_table_;
   std::mutex tasks_mutex_;
   uint64_t last_baton_ = 0;
   std::unordered_map<uint64_t, fml::closure> pending_tasks_;
+  // The tasks of a task runner with a `wake_up_callback`. Tasks with the same
+  // target time run in the order they were posted in.
+  std::multimap<fml::TimePoint, fml::closure> queued_tasks_;
+  // The wake up the embedder was last asked for, until it runs the tasks.
+  std::optional<fml::TimePoint> requested_wake_up_;
   fml::TaskQueueId placeholder_id_;
 
   // |fml::TaskRunner|
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 
 #include "flutter/common/task_runners.h"
@@ -38,6 +39,15 @@ class EmbedderThreadHost {
 
   bool PostTask(int64_t runner, uint64_t task) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the expired tasks of a task runner with a wake up
+  ///             callback. See `EmbedderTaskRunner::RunTasks`.
+  ///
+  /// @return     The number of tasks that were run, or std::nullopt if the
+  ///             task runner is unknown or has no wake up callback.
+  ///
+  std::optional<size_t> RunTasks(int64_t runner, fml::TimePoint deadline) const;
+
  private:
   ThreadHost host_;
   flutter::TaskRunners runners_;
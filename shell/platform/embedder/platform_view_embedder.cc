@@ -178,6 +178,19 @@ std::unique_ptr<VsyncWaiter> PlatformViewEmbedder::CreateVSyncWaiter() {
       platform_dispatch_table_.vsync_callback, task_runners_);
 }
 
+// |PlatformView|
+PointerDataDispatcherMaker PlatformViewEmbedder::GetDispatcherMaker() {
+  if (!platform_dispatch_table_.vsync_callback) {
+    return PlatformView::GetDispatcherMaker();
+  }
+  // Pen tablets and high rate mice report hundreds of events per second.
+  // Dispatch them to the framework once per frame of the embedder's display.
+  return [](PointerDataDispatcher::Delegate& delegate) {
+    return std::make_unique<SmoothPointerDataDispatcher>(
+        delegate, /*coalesce_packets=*/true);
+  };
+}
+
 // |PlatformView|
 std::unique_ptr<std::vector<std::string>>
 PlatformViewEmbedder::ComputePlatformResolvedLocales(
@@ -23,6 +23,7 @@
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/platform/embedder/embedder_task_runner.h"
 #include "flutter/shell/platform/embedder/tests/embedder_assertions.h"
 #include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
 #include "flutter/shell/platform/embedder/tests/embedder_test.h"
@@ -75,6 +76,31 @@ TEST_F(EmbedderTest, CanLaunchAndShutdownWithValidProjectArgs) {
   engine.reset();
 }
 
+TEST_F(EmbedderTest, CanLaunchWithAssetsToPrefetch) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  fml::AutoResetWaitableEvent latch;
+  context.AddIsolateCreateCallback([&latch]() { latch.Signal(); });
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  const char* prefetch_assets[] = {"kernel_blob.bin", "missing_asset"};
+  builder.GetProjectArgs().prefetch_asset_count = 2;
+  builder.GetProjectArgs().prefetch_assets = prefetch_assets;
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  latch.Wait();
+  engine.reset();
+}
+
+TEST_F(EmbedderTest, MustPreventEngineLaunchWithoutAssetsToPrefetch) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.GetProjectArgs().prefetch_asset_count = 1;
+  builder.GetProjectArgs().prefetch_assets = nullptr;
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
 // TODO(41999): Disabled because flaky.
 TEST_F(EmbedderTest, DISABLED_CanLaunchAndShutdownMultipleTimes) {
   EmbedderConfigBuilder builder(
@@ -2570,6 +2596,289 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanGetStartupMetrics) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("draw_solid_red");
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterEngineStartupMetrics metrics = {};
+  metrics.struct_size = sizeof(metrics);
+  ASSERT_EQ(FlutterEngineGetStartupMetrics(engine.get(), nullptr),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetStartupMetrics(nullptr, &metrics),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetStartupMetrics(engine.get(), &metrics), kSuccess);
+  EXPECT_GT(metrics.shell_creation_begin_nanos, 0u);
+  EXPECT_LE(metrics.shell_creation_begin_nanos,
+            metrics.shell_creation_end_nanos);
+  EXPECT_LE(metrics.shell_creation_end_nanos, FlutterEngineGetCurrentTime());
+
+  fml::AutoResetWaitableEvent frame_latch;
+  ASSERT_EQ(FlutterEngineSetNextFrameCallback(
+                engine.get(),
+                [](void* user_data) {
+                  static_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &frame_latch),
+            kSuccess);
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  frame_latch.Wait();
+
+  // Wait for the raster task of the first frame to complete.
+  fml::AutoResetWaitableEvent raster_latch;
+  ASSERT_EQ(FlutterEnginePostRenderThreadTask(
+                engine.get(),
+                [](void* user_data) {
+                  static_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &raster_latch),
+            kSuccess);
+  raster_latch.Wait();
+
+  ASSERT_EQ(FlutterEngineGetStartupMetrics(engine.get(), &metrics), kSuccess);
+  EXPECT_GT(metrics.root_isolate_creation_begin_nanos, 0u);
+  EXPECT_LE(metrics.root_isolate_creation_begin_nanos,
+            metrics.root_isolate_creation_end_nanos);
+  EXPECT_GT(metrics.first_frame_begin_nanos, 0u);
+  EXPECT_LE(metrics.root_isolate_creation_end_nanos,
+            metrics.first_frame_begin_nanos);
+  EXPECT_LE(metrics.first_frame_begin_nanos, metrics.first_frame_end_nanos);
+}
+
+TEST_F(EmbedderTest, CanGetFrameStatistics) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("draw_solid_red");
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterEngineFrameStatistics statistics = {};
+  statistics.struct_size = sizeof(statistics);
+  ASSERT_EQ(FlutterEngineGetFrameStatistics(engine.get(), nullptr),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetFrameStatistics(nullptr, &statistics),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetFrameStatistics(engine.get(), &statistics),
+            kSuccess);
+  EXPECT_EQ(statistics.frame_count, 0u);
+  EXPECT_EQ(statistics.sample_count, 0u);
+
+  fml::AutoResetWaitableEvent frame_latch;
+  ASSERT_EQ(FlutterEngineSetNextFrameCallback(
+                engine.get(),
+                [](void* user_data) {
+                  static_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &frame_latch),
+            kSuccess);
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  frame_latch.Wait();
+
+  // Wait for the raster task of the first frame to complete.
+  fml::AutoResetWaitableEvent raster_latch;
+  ASSERT_EQ(FlutterEnginePostRenderThreadTask(
+                engine.get(),
+                [](void* user_data) {
+                  static_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &raster_latch),
+            kSuccess);
+  raster_latch.Wait();
+
+  ASSERT_EQ(FlutterEngineGetFrameStatistics(engine.get(), &statistics),
+            kSuccess);
+  EXPECT_GE(statistics.frame_count, 1u);
+  EXPECT_GE(statistics.sample_count, 1u);
+  EXPECT_LE(statistics.janky_frame_count, statistics.frame_count);
+  EXPECT_LE(statistics.build.p50_nanos, statistics.build.p99_nanos);
+  EXPECT_LE(statistics.raster.p50_nanos, statistics.raster.p99_nanos);
+  EXPECT_LE(statistics.gpu_sample_count, statistics.sample_count);
+}
+
+TEST_F(EmbedderTest, CanDumpTraceFlightRecorder) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("draw_solid_red");
+  builder.GetProjectArgs().trace_flight_recorder_records_per_thread = 256;
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::AutoResetWaitableEvent frame_latch;
+  ASSERT_EQ(FlutterEngineSetNextFrameCallback(
+                engine.get(),
+                [](void* user_data) {
+                  static_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &frame_latch),
+            kSuccess);
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  frame_latch.Wait();
+
+  ASSERT_EQ(FlutterEngineDumpTraceFlightRecorder(nullptr, nullptr),
+            kInvalidArguments);
+  std::vector<uint8_t> trace;
+  ASSERT_EQ(FlutterEngineDumpTraceFlightRecorder(
+                [](const uint8_t* data, size_t size, void* user_data) {
+                  static_cast<std::vector<uint8_t>*>(user_data)->assign(
+                      data, data + size);
+                },
+                &trace),
+            kSuccess);
+  EXPECT_FALSE(trace.empty());
+}
+
+TEST_F(EmbedderTest, TraceFlightRecorderJankCallbackRequiresAThreshold) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.GetProjectArgs().trace_flight_recorder_records_per_thread = 256;
+  builder.GetProjectArgs().trace_flight_recorder_jank_callback =
+      [](const uint8_t* data, size_t size, void* user_data) {};
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
+TEST(EmbedderTaskRunnerTest, BatchesTasksBehindASingleWakeUp) {
+  std::vector<fml::TimePoint> wake_ups;
+  flutter::EmbedderTaskRunner::DispatchTable table;
+  table.runs_task_on_current_thread_callback = []() { return true; };
+  table.wake_up_callback = [&wake_ups](flutter::EmbedderTaskRunner*,
+                                       fml::TimePoint target_time) {
+    wake_ups.push_back(target_time);
+  };
+  auto task_runner =
+      fml::MakeRefCounted<flutter::EmbedderTaskRunner>(std::move(table), 1);
+  ASSERT_TRUE(task_runner->UsesWakeUps());
+  // The overrides of |fml::TaskRunner| are private.
+  fml::TaskRunner& engine_task_runner = *task_runner;
+
+  const auto now = fml::TimePoint::Now();
+  const auto later = now + fml::TimeDelta::FromSeconds(100);
+  std::vector<int> order;
+  engine_task_runner.PostTaskForTime([&order]() { order.push_back(3); }, later);
+  engine_task_runner.PostTaskForTime([&order]() { order.push_back(1); }, now);
+  engine_task_runner.PostTaskForTime([&order]() { order.push_back(2); }, now);
+  // Only the first task and the one that is due earlier need a wake up.
+  ASSERT_EQ(wake_ups.size(), 2u);
+  EXPECT_EQ(wake_ups[0], later);
+  EXPECT_EQ(wake_ups[1], now);
+
+  EXPECT_EQ(task_runner->RunTasks(fml::TimePoint::Max()), 2u);
+  EXPECT_EQ(order, std::vector<int>({1, 2}));
+  // The task that is not due yet needs another wake up.
+  ASSERT_EQ(wake_ups.size(), 3u);
+  EXPECT_EQ(wake_ups[2], later);
+}
+
+TEST(EmbedderTaskRunnerTest, RunsAtLeastOneTaskPastTheDeadline) {
+  flutter::EmbedderTaskRunner::DispatchTable table;
+  table.runs_task_on_current_thread_callback = []() { return true; };
+  table.wake_up_callback = [](flutter::EmbedderTaskRunner*, fml::TimePoint) {};
+  auto task_runner =
+      fml::MakeRefCounted<flutter::EmbedderTaskRunner>(std::move(table), 1);
+
+  fml::TaskRunner& engine_task_runner = *task_runner;
+
+  size_t run_count = 0;
+  for (int i = 0; i < 3; i++) {
+    engine_task_runner.PostTask([&run_count]() { run_count++; });
+  }
+
+  EXPECT_EQ(task_runner->RunTasks(fml::TimePoint::Min()), 1u);
+  EXPECT_EQ(task_runner->RunTasks(fml::TimePoint::Max()), 2u);
+  EXPECT_EQ(run_count, 3u);
+}
+
+TEST_F(EmbedderTest, CanGetAllocationStatistics) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("draw_solid_red");
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::AutoResetWaitableEvent frame_latch;
+  ASSERT_EQ(FlutterEngineSetNextFrameCallback(
+                engine.get(),
+                [](void* user_data) {
+                  static_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &frame_latch),
+            kSuccess);
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  frame_latch.Wait();
+
+  FlutterAllocationStatistics statistics = {};
+  statistics.struct_size = sizeof(statistics);
+  ASSERT_EQ(FlutterEngineGetAllocationStatistics(
+                kFlutterAllocationCategoryDisplayList, nullptr),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetAllocationStatistics(
+                kFlutterAllocationCategoryCount, &statistics),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetAllocationStatistics(
+                kFlutterAllocationCategoryDisplayList, &statistics),
+            kSuccess);
+  EXPECT_GT(statistics.peak_allocated_bytes, 0u);
+  EXPECT_LE(statistics.allocated_bytes, statistics.peak_allocated_bytes);
+}
+
+TEST_F(EmbedderTest, CustomAllocatorMustBeComplete) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  FlutterCustomAllocator allocator = {};
+  allocator.struct_size = sizeof(allocator);
+  allocator.allocate = [](void* user_data, size_t size,
+                          FlutterAllocationCategory category) -> void* {
+    return malloc(size);
+  };
+  builder.GetProjectArgs().custom_allocator = &allocator;
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {
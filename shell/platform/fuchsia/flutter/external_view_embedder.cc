@@ -173,11 +173,21 @@ void ExternalViewEmbedder::SubmitFrame(
         flatland_->flatland()->CreateImage(
             {image_id}, surface->GetBufferCollectionImportToken(), 0,
             std::move(image_properties));
+        // Surfaces keep their size, so the destination size of their image
+        // only needs to be set once.
+        flatland_->flatland()->SetImageDestinationSize(
+            {image_id}, {static_cast<uint32_t>(size.width()),
+                         static_cast<uint32_t>(size.height())});
 
         surface->SetImageId(image_id);
-        surface->SetReleaseImageCallback([flatland = flatland_, image_id]() {
-          flatland->flatland()->ReleaseImage({image_id});
-        });
+        surface->SetReleaseImageCallback(
+            [flatland = flatland_, image_id,
+             image_blend_modes = std::weak_ptr(image_blend_modes_)]() {
+              flatland->flatland()->ReleaseImage({image_id});
+              if (auto blend_modes = image_blend_modes.lock()) {
+                blend_modes->erase(image_id);
+              }
+            });
       }
 
       // Enqueue fences for the next present.
@@ -209,8 +219,15 @@ void ExternalViewEmbedder::SubmitFrame(
 
     // First re-scale everything according to the DPR.
     const float inv_dpr = 1.0f / frame_dpr_;
-    flatland_->flatland()->SetScale(root_transform_id_, {inv_dpr, inv_dpr});
+    if (root_scale_ != inv_dpr) {
+      flatland_->flatland()->SetScale(root_transform_id_, {inv_dpr, inv_dpr});
+      root_scale_ = inv_dpr;
+    }
 
+    // The children of the root for this frame, in composition order. The
+    // children of the last frame stay attached, so only the differences are
+    // sent to Scenic once all of them are known.
+    std::vector<fuchsia::ui::composition::TransformId> child_transforms;
     size_t layer_index = 0;
     for (const auto& layer_id : frame_composition_order_) {
       const auto& layer = frame_layers_.find(layer_id);
@@ -360,9 +377,7 @@ void ExternalViewEmbedder::SubmitFrame(
             viewport.mutators.clips.empty()
                 ? viewport.transform_id
                 : viewport.clip_transforms[0].transform_id;
-        flatland_->flatland()->AddChild(root_transform_id_,
-                                        main_child_transform);
-        child_transforms_.emplace_back(main_child_transform);
+        child_transforms.emplace_back(main_child_transform);
       }
 
       // Acquire the surface associated with the layer.
@@ -393,20 +408,27 @@ void ExternalViewEmbedder::SubmitFrame(
           layers_.emplace_back(std::move(new_layer));
         }
 
-        // Update the image content and set size.
-        flatland_->flatland()->SetContent(layers_[layer_index].transform_id,
-                                          {surface_for_layer->GetImageId()});
-        flatland_->flatland()->SetImageDestinationSize(
-            {surface_for_layer->GetImageId()},
-            {static_cast<uint32_t>(surface_for_layer->GetSize().width()),
-             static_cast<uint32_t>(surface_for_layer->GetSize().height())});
+        // Update the image content.
+        auto& flatland_layer = layers_[layer_index];
+        const uint64_t image_id = surface_for_layer->GetImageId();
+        if (flatland_layer.image_id != image_id) {
+          flatland_->flatland()->SetContent(flatland_layer.transform_id,
+                                            {image_id});
+          flatland_layer.image_id = image_id;
+        }
 
         // Flutter Embedder lacks an API to detect if a layer has alpha or not.
         // For now, we assume any layer beyond the first has alpha.
-        flatland_->flatland()->SetImageBlendingFunction(
-            {surface_for_layer->GetImageId()},
+        const auto blend_mode =
             layer_index == 0 ? fuchsia::ui::composition::BlendMode::SRC
-                             : fuchsia::ui::composition::BlendMode::SRC_OVER);
+                             : fuchsia::ui::composition::BlendMode::SRC_OVER;
+        auto found_blend_mode = image_blend_modes_->find(image_id);
+        if (found_blend_mode == image_blend_modes_->end() ||
+            found_blend_mode->second != blend_mode) {
+          flatland_->flatland()->SetImageBlendingFunction({image_id},
+                                                          blend_mode);
+          (*image_blend_modes_)[image_id] = blend_mode;
+        }
 
         // Set hit regions for this layer; these hit regions correspond to the
         // portions of the layer on which skia drew content.
@@ -415,41 +437,52 @@ void ExternalViewEmbedder::SubmitFrame(
           std::list<SkRect> intersection_rects =
               layer->second.rtree->searchNonOverlappingDrawnRects(
                   SkRect::Make(layer->second.surface_size));
-
-          std::vector<fuchsia::ui::composition::HitRegion> hit_regions;
-          for (const SkRect& rect : intersection_rects) {
-            hit_regions.emplace_back();
-            auto& new_hit_region = hit_regions.back();
-            new_hit_region.region.x = rect.x();
-            new_hit_region.region.y = rect.y();
-            new_hit_region.region.width = rect.width();
-            new_hit_region.region.height = rect.height();
-            new_hit_region.hit_test =
-                fuchsia::ui::composition::HitTestInteraction::DEFAULT;
+          std::vector<SkRect> hit_rects(intersection_rects.begin(),
+                                        intersection_rects.end());
+          if (flatland_layer.hit_rects != hit_rects) {
+            std::vector<fuchsia::ui::composition::HitRegion> hit_regions;
+            for (const SkRect& rect : hit_rects) {
+              hit_regions.emplace_back();
+              auto& new_hit_region = hit_regions.back();
+              new_hit_region.region.x = rect.x();
+              new_hit_region.region.y = rect.y();
+              new_hit_region.region.width = rect.width();
+              new_hit_region.region.height = rect.height();
+              new_hit_region.hit_test =
+                  fuchsia::ui::composition::HitTestInteraction::DEFAULT;
+            }
+
+            flatland_->flatland()->SetHitRegions(flatland_layer.transform_id,
+                                                 std::move(hit_regions));
+            flatland_layer.hit_rects = std::move(hit_rects);
           }
-
-          flatland_->flatland()->SetHitRegions(
-              layers_[layer_index].transform_id, std::move(hit_regions));
         }
 
         // Attach the Layer to the main scene graph.
-        flatland_->flatland()->AddChild(root_transform_id_,
-                                        layers_[layer_index].transform_id);
-        child_transforms_.emplace_back(layers_[layer_index].transform_id);
+        child_transforms.emplace_back(flatland_layer.transform_id);
+      } else if (layer_index < layers_.size()) {
+        // Clear the image of the unused layer so it isn't cached
+        // unnecessarily.
+        ClearContent(&layers_[layer_index]);
       }
 
       // Reset for the next pass:
       layer_index++;
     }
 
+    // Clear images on the layers that are unused in this frame too.
+    for (size_t i = layer_index; i < layers_.size(); i++) {
+      ClearContent(&layers_[i]);
+    }
+
     // Set up the input interceptor at the top of the scene, if applicable. It
     // will capture all input, and any unwanted input will be reinjected into
     // embedded views.
     if (input_interceptor_transform_.has_value()) {
-      flatland_->flatland()->AddChild(root_transform_id_,
-                                      *input_interceptor_transform_);
-      child_transforms_.emplace_back(*input_interceptor_transform_);
+      child_transforms.emplace_back(*input_interceptor_transform_);
     }
+
+    UpdateChildTransforms(std::move(child_transforms));
   }
 
   // Present the session to Scenic, along with surface acquire/release fences.
@@ -588,15 +621,33 @@ void ExternalViewEmbedder::Reset() {
   frame_size_ = SkISize::Make(0, 0);
   frame_dpr_ = 1.f;
 
-  // Clear all children from root.
-  for (const auto& transform : child_transforms_) {
-    flatland_->flatland()->RemoveChild(root_transform_id_, transform);
+}
+
+void ExternalViewEmbedder::UpdateChildTransforms(
+    std::vector<fuchsia::ui::composition::TransformId> child_transforms) {
+  // Children are composited in the order they were added, so the children of
+  // the last frame are kept only up to the first one that differs.
+  size_t unchanged = 0;
+  while (unchanged < child_transforms_.size() &&
+         unchanged < child_transforms.size() &&
+         child_transforms_[unchanged].value ==
+             child_transforms[unchanged].value) {
+    unchanged++;
+  }
+  for (size_t i = unchanged; i < child_transforms_.size(); i++) {
+    flatland_->flatland()->RemoveChild(root_transform_id_,
+                                       child_transforms_[i]);
   }
-  child_transforms_.clear();
+  for (size_t i = unchanged; i < child_transforms.size(); i++) {
+    flatland_->flatland()->AddChild(root_transform_id_, child_transforms[i]);
+  }
+  child_transforms_ = std::move(child_transforms);
+}
 
-  // Clear images on all layers so they aren't cached unnecessarily.
-  for (const auto& layer : layers_) {
-    flatland_->flatland()->SetContent(layer.transform_id, {0});
+void ExternalViewEmbedder::ClearContent(Layer* layer) {
+  if (layer->image_id != 0) {
+    flatland_->flatland()->SetContent(layer->transform_id, {0});
+    layer->image_id = 0;
   }
 }
 
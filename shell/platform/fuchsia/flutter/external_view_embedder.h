@@ -11,6 +11,7 @@
 
 #include <cstdint>  // For uint32_t & uint64_t
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -114,6 +115,11 @@ class ExternalViewEmbedder final : public flutter::ExternalViewEmbedder {
  private:
   void Reset();  // Reset state for a new frame.
 
+  // Attaches |child_transforms| to the root in order, in place of the
+  // children attached for the last frame.
+  void UpdateChildTransforms(
+      std::vector<fuchsia::ui::composition::TransformId> child_transforms);
+
   // This struct represents a transformed clip rect.
   struct TransformedClip {
     SkMatrix transform = SkMatrix::I();
@@ -186,14 +192,22 @@ class ExternalViewEmbedder final : public flutter::ExternalViewEmbedder {
   struct Layer {
     // Transform on which Images are set.
     fuchsia::ui::composition::TransformId transform_id;
+    // The content and hit regions last set on the transform, so that they are
+    // only sent to Scenic when they change.
+    uint64_t image_id = 0;
+    std::vector<SkRect> hit_rects;
   };
 
+  // Removes the image from |layer|, so that it isn't cached unnecessarily.
+  void ClearContent(Layer* layer);
+
   std::shared_ptr<FlatlandConnection> flatland_;
   std::shared_ptr<SurfaceProducer> surface_producer_;
 
   fuchsia::ui::composition::ParentViewportWatcherPtr parent_viewport_watcher_;
 
   fuchsia::ui::composition::TransformId root_transform_id_;
+  std::optional<float> root_scale_;
 
   std::unordered_map<int64_t, View> views_;
   std::vector<Layer> layers_;
@@ -201,6 +215,12 @@ class ExternalViewEmbedder final : public flutter::ExternalViewEmbedder {
   std::unordered_map<EmbedderLayerId, EmbedderLayer> frame_layers_;
   std::vector<EmbedderLayerId> frame_composition_order_;
   std::vector<fuchsia::ui::composition::TransformId> child_transforms_;
+  // The blending function last set on each image. Shared with the callbacks
+  // that release the images.
+  std::shared_ptr<
+      std::unordered_map<uint64_t, fuchsia::ui::composition::BlendMode>>
+      image_blend_modes_ = std::make_shared<
+          std::unordered_map<uint64_t, fuchsia::ui::composition::BlendMode>>();
   SkISize frame_size_ = SkISize::Make(0, 0);
   float frame_dpr_ = 1.f;
 
@@ -1601,6 +1601,94 @@ TEST_F(ExternalViewEmbedderTest, SimpleScene_OverlappingHitRegions) {
                   fuchsia::ui::composition::HitTestInteraction::DEFAULT)})}));
 }
 
+TEST_F(ExternalViewEmbedderTest, SimpleScene_Redrawn) {
+  fuchsia::ui::composition::ParentViewportWatcherPtr parent_viewport_watcher;
+  fuchsia::ui::views::ViewportCreationToken viewport_creation_token;
+  fuchsia::ui::views::ViewCreationToken view_creation_token;
+  fuchsia::ui::views::ViewRef view_ref_clone;
+  auto view_creation_token_status = zx::channel::create(
+      0u, &viewport_creation_token.value, &view_creation_token.value);
+  ASSERT_EQ(view_creation_token_status, ZX_OK);
+
+  fuchsia::ui::views::ViewRefControl view_ref_control;
+  fuchsia::ui::views::ViewRef view_ref;
+  auto status = zx::eventpair::create(
+      /*options*/ 0u, &view_ref_control.reference, &view_ref.reference);
+  ASSERT_EQ(status, ZX_OK);
+  view_ref_control.reference.replace(
+      ZX_DEFAULT_EVENTPAIR_RIGHTS & (~ZX_RIGHT_DUPLICATE),
+      &view_ref_control.reference);
+  view_ref.reference.replace(ZX_RIGHTS_BASIC, &view_ref.reference);
+  view_ref.Clone(&view_ref_clone);
+
+  // Create the `ExternalViewEmbedder` and pump the message loop until
+  // the initial scene graph is setup.
+  ExternalViewEmbedder external_view_embedder(
+      std::move(view_creation_token),
+      fuchsia::ui::views::ViewIdentityOnCreation{
+          .view_ref = std::move(view_ref),
+          .view_ref_control = std::move(view_ref_control),
+      },
+      fuchsia::ui::composition::ViewBoundProtocols{},
+      parent_viewport_watcher.NewRequest(), flatland_connection(),
+      fake_surface_producer());
+  flatland_connection()->Present();
+  loop().RunUntilIdle();
+  fake_flatland().FireOnNextFrameBeginEvent(WithPresentCredits(1u));
+  loop().RunUntilIdle();
+  EXPECT_THAT(fake_flatland().graph(),
+              IsFlutterGraph(parent_viewport_watcher, viewport_creation_token,
+                             view_ref_clone));
+
+  // Draws a rect at |x| in each frame, so that only the hit regions change.
+  const SkISize frame_size_signed = SkISize::Make(512, 512);
+  const fuchsia::math::SizeU frame_size{
+      static_cast<uint32_t>(frame_size_signed.width()),
+      static_cast<uint32_t>(frame_size_signed.height())};
+  auto draw_frame = [&](float x) {
+    DrawSimpleFrame(external_view_embedder, frame_size_signed, 1.f,
+                    [x](flutter::DlCanvas* canvas) {
+                      flutter::DlPaint rect_paint;
+                      rect_paint.setColor(flutter::DlColor::kGreen());
+                      canvas->DrawRect(SkRect::MakeXYWH(x, 256.f, 16.f, 16.f),
+                                       rect_paint);
+                    });
+    loop().RunUntilIdle();
+    fake_flatland().FireOnNextFrameBeginEvent(WithPresentCredits(1u));
+    loop().RunUntilIdle();
+  };
+  auto is_redrawn_graph = [&](float x) {
+    return IsFlutterGraph(
+        parent_viewport_watcher, viewport_creation_token, view_ref_clone,
+        /*layers*/
+        {IsImageLayer(
+            frame_size, kFirstLayerBlendMode,
+            {IsHitRegion(
+                /* x */ x,
+                /* y */ 256.f,
+                /* width */ 16.f,
+                /* height */ 16.f,
+                /* hit_test */
+                fuchsia::ui::composition::HitTestInteraction::DEFAULT)})});
+  };
+
+  // The layers of the last frame are kept, and updated where they changed.
+  draw_frame(128.f);
+  EXPECT_THAT(fake_flatland().graph(), is_redrawn_graph(128.f));
+  draw_frame(128.f);
+  EXPECT_THAT(fake_flatland().graph(), is_redrawn_graph(128.f));
+  draw_frame(64.f);
+  EXPECT_THAT(fake_flatland().graph(), is_redrawn_graph(64.f));
+
+  // The layer is removed once nothing is drawn into it.
+  DrawSimpleFrame(external_view_embedder, frame_size_signed, 1.f,
+                  [](flutter::DlCanvas* canvas) {});
+  loop().RunUntilIdle();
+  EXPECT_THAT(fake_flatland().graph(),
+              IsFlutterGraph(parent_viewport_watcher, viewport_creation_token,
+                             view_ref_clone));
+}
+
 TEST_F(ExternalViewEmbedderTest, ViewportCoveredWithInputInterceptor) {
   fuchsia::ui::composition::ParentViewportWatcherPtr parent_viewport_watcher;
   fuchsia::ui::views::ViewportCreationToken viewport_creation_token;
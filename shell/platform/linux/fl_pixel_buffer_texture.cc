@@ -6,12 +6,26 @@
 
 #include <epoxy/gl.h>
 #include <gmodule.h>
+#include <cstring>
 
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 
+// Number of pixel buffer objects that uploads alternate between, so that
+// copying a frame into one doesn't wait on the upload of the previous frame.
+static constexpr int kPixelUnpackBufferCount = 2;
+
 typedef struct {
   int64_t id;
   GLuint texture_id;
+
+  // Size of the storage allocated for the texture.
+  uint32_t texture_width;
+  uint32_t texture_height;
+
+  // Buffers the pixels are staged in when the context supports pixel buffer
+  // objects.
+  GLuint unpack_buffers[kPixelUnpackBufferCount];
+  int next_unpack_buffer;
 } FlPixelBufferTexturePrivate;
 
 static void fl_pixel_buffer_texture_iface_init(FlTextureInterface* iface);
@@ -57,6 +71,10 @@ static void fl_pixel_buffer_texture_dispose(GObject* object) {
     glDeleteTextures(1, &priv->texture_id);
     priv->texture_id = 0;
   }
+  if (priv->unpack_buffers[0]) {
+    glDeleteBuffers(kPixelUnpackBufferCount, priv->unpack_buffers);
+    memset(priv->unpack_buffers, 0, sizeof(priv->unpack_buffers));
+  }
 
   G_OBJECT_CLASS(fl_pixel_buffer_texture_parent_class)->dispose(object);
 }
@@ -68,6 +86,49 @@ static void check_gl_error(int line) {
   }
 }
 
+// Returns TRUE if the current context can upload pixels from pixel buffer
+// objects.
+static gboolean supports_unpack_buffers() {
+  return epoxy_is_desktop_gl() ? epoxy_gl_version() >= 21
+                               : epoxy_gl_version() >= 30;
+}
+
+// Copies @buffer into the next pixel unpack buffer and leaves that buffer
+// bound, so that a texture upload reads from it and returns without waiting
+// for the GPU to receive the pixels.
+static gboolean stage_pixels(FlPixelBufferTexturePrivate* priv,
+                             const uint8_t* buffer,
+                             size_t size) {
+  if (priv->unpack_buffers[0] == 0) {
+    glGenBuffers(kPixelUnpackBufferCount, priv->unpack_buffers);
+    check_gl_error(__LINE__);
+  }
+  GLuint unpack_buffer = priv->unpack_buffers[priv->next_unpack_buffer];
+  priv->next_unpack_buffer =
+      (priv->next_unpack_buffer + 1) % kPixelUnpackBufferCount;
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpack_buffer);
+  check_gl_error(__LINE__);
+  // Orphan the previous storage in case the GPU still reads from it.
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+  check_gl_error(__LINE__);
+  void* staging = glMapBufferRange(
+      GL_PIXEL_UNPACK_BUFFER, 0, size,
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  if (staging == nullptr) {
+    check_gl_error(__LINE__);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return FALSE;
+  }
+  memcpy(staging, buffer, size);
+  if (!glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+    // The contents of the buffer were lost, upload from memory instead.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return FALSE;
+  }
+  return TRUE;
+}
+
 gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
                                           uint32_t width,
                                           uint32_t height,
@@ -101,10 +162,31 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
     glBindTexture(GL_TEXTURE_2D, priv->texture_id);
     check_gl_error(__LINE__);
   }
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, buffer);
+
+  const uint8_t* pixels = buffer;
+  gboolean staged = supports_unpack_buffers() &&
+                    stage_pixels(priv, buffer, size_t{width} * height * 4);
+  if (staged) {
+    // Read from the start of the bound unpack buffer.
+    pixels = nullptr;
+  }
+
+  // Only reallocate the texture when the size of the buffer changes.
+  if (width == priv->texture_width && height == priv->texture_height) {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                    GL_UNSIGNED_BYTE, pixels);
+  } else {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, pixels);
+    priv->texture_width = width;
+    priv->texture_height = height;
+  }
   check_gl_error(__LINE__);
 
+  if (staged) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+
   opengl_texture->target = GL_TEXTURE_2D;
   opengl_texture->name = priv->texture_id;
   opengl_texture->format = GL_RGBA8;
@@ -85,3 +85,18 @@ TEST(FlPixelBufferTextureTest, PopulateTexture) {
   EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
   EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
 }
+
+// Test that populating an OpenGL texture again with the same size works.
+TEST(FlPixelBufferTextureTest, PopulateTextureAgain) {
+  g_autoptr(FlPixelBufferTexture) texture =
+      FL_PIXEL_BUFFER_TEXTURE(fl_test_pixel_buffer_texture_new());
+  for (int i = 0; i < 2; i++) {
+    FlutterOpenGLTexture opengl_texture = {0};
+    g_autoptr(GError) error = nullptr;
+    EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+        texture, kBufferWidth, kBufferHeight, &opengl_texture, &error));
+    EXPECT_EQ(error, nullptr);
+    EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
+    EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
+  }
+}
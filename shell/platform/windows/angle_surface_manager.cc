@@ -4,10 +4,15 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <cstring>
 #include <vector>
 
 #include "flutter/fml/logging.h"
 
+#ifndef EGL_DIRECT_COMPOSITION_ANGLE
+#define EGL_DIRECT_COMPOSITION_ANGLE 0x33A5
+#endif
+
 // Logs an EGL error to stderr. This automatically calls eglGetError()
 // and logs the error code.
 static void LogEglError(std::string message) {
@@ -21,12 +26,24 @@ namespace flutter {
 int AngleSurfaceManager::instance_count_ = 0;
 
 std::unique_ptr<AngleSurfaceManager> AngleSurfaceManager::Create(
-    bool enable_impeller) {
+    bool enable_impeller,
+    bool enable_direct_composition) {
   std::unique_ptr<AngleSurfaceManager> manager;
   manager.reset(new AngleSurfaceManager(enable_impeller));
   if (!manager->initialize_succeeded_) {
     return nullptr;
   }
+  if (enable_direct_composition) {
+    const char* extensions =
+        eglQueryString(manager->egl_display_, EGL_EXTENSIONS);
+    manager->direct_composition_ =
+        extensions &&
+        strstr(extensions, "EGL_ANGLE_direct_composition") != nullptr;
+    if (!manager->direct_composition_) {
+      FML_LOG(ERROR) << "DirectComposition is not supported by ANGLE, "
+                        "falling back to window swap chains.";
+    }
+  }
   return std::move(manager);
 }
 
@@ -239,14 +256,21 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
 
   EGLSurface surface = EGL_NO_SURFACE;
 
-  const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
+  std::vector<EGLint> surfaceAttributes = {
+      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width, EGL_HEIGHT, height,
+  };
+  // The swap chain of a DirectComposition surface uses the flip model, which
+  // avoids the copy of each frame into the redirection surface of the window.
+  if (direct_composition_) {
+    surfaceAttributes.push_back(EGL_DIRECT_COMPOSITION_ANGLE);
+    surfaceAttributes.push_back(EGL_TRUE);
+  }
+  surfaceAttributes.push_back(EGL_NONE);
 
   surface = eglCreateWindowSurface(
       egl_display_, egl_config_,
       static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
-      surfaceAttributes);
+      surfaceAttributes.data());
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
     return false;
@@ -27,7 +27,13 @@ namespace flutter {
 // destroy surfaces
 class AngleSurfaceManager {
  public:
-  static std::unique_ptr<AngleSurfaceManager> Create(bool enable_impeller);
+  // Creates a surface manager. If |enable_direct_composition| is true and
+  // ANGLE supports it, window surfaces are presented through a flip model
+  // swap chain composited by DirectComposition instead of a blit model swap
+  // chain bound to the window.
+  static std::unique_ptr<AngleSurfaceManager> Create(
+      bool enable_impeller,
+      bool enable_direct_composition);
 
   virtual ~AngleSurfaceManager();
 
@@ -125,6 +131,9 @@ class AngleSurfaceManager {
   EGLint surface_width_ = 0;
   EGLint surface_height_ = 0;
 
+  // Whether window surfaces are presented through DirectComposition.
+  bool direct_composition_ = false;
+
   // The current D3D device.
   Microsoft::WRL::ComPtr<ID3D11Device> resolved_device_;
 
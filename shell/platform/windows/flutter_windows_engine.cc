@@ -206,7 +206,13 @@ FlutterWindowsEngine::FlutterWindowsEngine(const FlutterProjectBundle& project)
   enable_impeller_ = std::find(switches.begin(), switches.end(),
                                "--enable-impeller=true") != switches.end();
 
-  surface_manager_ = AngleSurfaceManager::Create(enable_impeller_);
+  // DirectComposition presentation is opt-in while it's being evaluated.
+  const bool enable_direct_composition =
+      std::find(switches.begin(), switches.end(),
+                "--enable-direct-composition=true") != switches.end();
+
+  surface_manager_ =
+      AngleSurfaceManager::Create(enable_impeller_, enable_direct_composition);
   window_proc_delegate_manager_ = std::make_unique<WindowProcDelegateManager>();
   window_proc_delegate_manager_->RegisterTopLevelWindowProcDelegate(
       [](HWND hwnd, UINT msg, WPARAM wpar, LPARAM lpar, void* user_data,
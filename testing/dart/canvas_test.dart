@@ -92,6 +92,7 @@ void testNoCrashes() {
     testCanvas((Canvas canvas) => canvas.drawPoints(PointMode.points, <Offset>[], paint));
     testCanvas((Canvas canvas) => canvas.drawRawAtlas(image, Float32List(0), Float32List(0), Int32List(0), BlendMode.src, rect, paint));
     testCanvas((Canvas canvas) => canvas.drawRawPoints(PointMode.points, Float32List(0), paint));
+    testCanvas((Canvas canvas) => canvas.drawRawRects(Float32List(0), null, paint));
     testCanvas((Canvas canvas) => canvas.drawRect(rect, paint));
     testCanvas((Canvas canvas) => canvas.drawRRect(rrect, paint));
     testCanvas((Canvas canvas) => canvas.drawShadow(path, color, double.nan, false));
@@ -282,6 +283,44 @@ void main() {
     expectArgumentError(() => canvas.drawRawAtlas(image, Float32List(4), Float32List(4), Int32List(2), BlendMode.src, rect, paint));
   });
 
+  test('Data lengths must match for drawRawRects', () async {
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    final Paint paint = Paint();
+    canvas.drawRawRects(Float32List(0), null, paint);
+    canvas.drawRawRects(Float32List(0), Int32List(0), paint);
+    canvas.drawRawRects(Float32List(8), null, paint);
+    canvas.drawRawRects(Float32List(8), Int32List(2), paint);
+
+    expectArgumentError(() => canvas.drawRawRects(Float32List(3), null, paint));
+    expectArgumentError(() => canvas.drawRawRects(Float32List(4), Int32List(0), paint));
+    expectArgumentError(() => canvas.drawRawRects(Float32List(4), Int32List(2), paint));
+  });
+
+  test('drawRawRects draws each rect with its own color', () async {
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    canvas.drawRawRects(
+      Float32List.fromList(<double>[0, 0, 2, 2, 2, 0, 4, 2]),
+      Int32List.fromList(<int>[0xFF123456, 0xFF654321]),
+      Paint()..color = const Color(0xFFFFFFFF),
+    );
+    canvas.drawRawRects(
+      Float32List.fromList(<double>[0, 2, 4, 4]),
+      null,
+      Paint()..color = const Color(0xFFABCDEF),
+    );
+    final Picture picture = recorder.endRecording();
+    final Image image = picture.toImageSync(4, 4);
+    picture.dispose();
+
+    final ByteData data = (await image.toByteData())!;
+    int getPixel(int x, int y) => data.getUint32((x + y * 4) * 4);
+    expect(getPixel(1, 1), 0x123456FF);
+    expect(getPixel(3, 1), 0x654321FF);
+    expect(getPixel(1, 3), 0xABCDEFFF);
+  });
+
   test('Canvas preserves perspective data in Matrix4', () async {
     const double rotateAroundX = pi / 6;  // 30 degrees
     const double rotateAroundY = pi / 9;  // 20 degrees
@@ -95,6 +95,7 @@ void main() {
       0, 0, 0, 1,
     ]);
     expect(builder.pushTransform(matrix4), isNotNull);
+    expect(builder.pushTransform(matrix4, lateLatchPointer: true), isNotNull);
 
     final Float64List matrix4WrongLength = Float64List.fromList(<double>[
       1, 0, 0, 0,
@@ -282,4 +282,25 @@ void main() {
         expect(metrics, hasLength(1));
     }
   });
+
+  test('layoutBatch lays out every paragraph', () {
+    final List<Paragraph> paragraphs = <Paragraph>[];
+    final List<ParagraphConstraints> constraints = <ParagraphConstraints>[];
+    for (int index = 0; index < 32; index += 1) {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+        fontFamily: 'FlutterTest',
+        fontSize: 10.0,
+      ));
+      builder.addText('Test Test');
+      paragraphs.add(builder.build());
+      // Every other paragraph wraps after the first word.
+      constraints.add(ParagraphConstraints(width: index.isEven ? 400.0 : 60.0));
+    }
+    Paragraph.layoutBatch(paragraphs, constraints);
+
+    for (int index = 0; index < paragraphs.length; index += 1) {
+      expect(paragraphs[index].width, constraints[index].width);
+      expect(paragraphs[index].height, index.isEven ? 10.0 : 20.0);
+    }
+  });
 }
@@ -68,6 +68,45 @@ void main() {
             'frameNumber: 29)');
   });
 
+  test('FrameTiming reports the GPU duration', () {
+    final FrameTiming timing = FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+      frameNumber: 37,
+      gpuDuration: 12000,
+    );
+    expect(timing.gpuDuration, const Duration(milliseconds: 12));
+    expect(timing.frameNumber, 37);
+  });
+
+  test('FrameTiming reports dropped frames', () {
+    final FrameTiming timing = FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+      frameNumber: 31,
+      droppedFrameCount: 2,
+    );
+    expect(timing.frameNumber, 31);
+    expect(timing.droppedFrameCount, 2);
+    expect(timing.gpuDuration, Duration.zero);
+    expect(FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+    ).droppedFrameCount, 0);
+  });
+
   test('computePlatformResolvedLocale basic', () {
     final List<Locale> supportedLocales = <Locale>[
       const Locale.fromSubtags(languageCode: 'zh', scriptCode: 'Hans', countryCode: 'CN'),
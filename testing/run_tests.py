@@ -376,6 +376,7 @@ def run_cc_tests(build_dir, executable_filter, coverage, capture_core_dump):
     return (name, flags, extra_env)
 
   unittests = [
+      make_test('assets_unittests'),
       make_test('client_wrapper_glfw_unittests'),
       make_test('client_wrapper_unittests'),
       make_test('common_cpp_core_unittests'),
@@ -524,6 +525,10 @@ def run_engine_benchmarks(build_dir, executable_filter):
       build_dir, 'fml_benchmarks', executable_filter, icu_flags
   )
 
+  run_engine_executable(
+      build_dir, 'assets_benchmarks', executable_filter, icu_flags
+  )
+
   run_engine_executable(
       build_dir, 'ui_benchmarks', executable_filter, icu_flags
   )
@@ -536,6 +541,14 @@ def run_engine_benchmarks(build_dir, executable_filter):
       build_dir, 'geometry_benchmarks', executable_filter, icu_flags
   )
 
+  run_engine_executable(
+      build_dir, 'pool_benchmarks', executable_filter, icu_flags
+  )
+
+  run_engine_executable(
+      build_dir, 'typographer_benchmarks', executable_filter, icu_flags
+  )
+
   if is_linux():
     run_engine_executable(
         build_dir, 'txt_benchmarks', executable_filter, icu_flags
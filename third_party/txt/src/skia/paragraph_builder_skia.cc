@@ -48,9 +48,26 @@ ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection,
     const bool impeller_enabled)
-    : base_style_(style.GetTextStyle()), impeller_enabled_(impeller_enabled) {
-  builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection());
+    : ParagraphBuilderSkia(style,
+                           font_collection->CreateSktFontCollection(),
+                           font_collection->GetParagraphLayoutCache(),
+                           impeller_enabled) {}
+
+ParagraphBuilderSkia::ParagraphBuilderSkia(
+    const ParagraphStyle& style,
+    sk_sp<skt::FontCollection> font_collection,
+    std::shared_ptr<ParagraphLayoutCache> layout_cache,
+    const bool impeller_enabled)
+    : base_style_(style.GetTextStyle()),
+      impeller_enabled_(impeller_enabled),
+      layout_cache_(std::move(layout_cache)) {
+  if (layout_cache_) {
+    content_ = std::make_shared<ParagraphContent>();
+    content_->font_collection = font_collection;
+    content_->style = style;
+  }
+  builder_ = skt::ParagraphBuilder::make(TxtToSkia(style),
+                                         std::move(font_collection));
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
@@ -58,11 +75,18 @@ ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
   builder_->pushStyle(TxtToSkia(style));
   txt_style_stack_.push(style);
+  if (content_) {
+    content_->ops.push_back(ParagraphContent::Op::kPushStyle);
+    content_->pushed_styles.push_back(style);
+  }
 }
 
 void ParagraphBuilderSkia::Pop() {
   builder_->pop();
   txt_style_stack_.pop();
+  if (content_) {
+    content_->ops.push_back(ParagraphContent::Op::kPop);
+  }
 }
 
 const TextStyle& ParagraphBuilderSkia::PeekStyle() {
@@ -71,6 +95,10 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
   builder_->addText(text);
+  if (content_) {
+    content_->ops.push_back(ParagraphContent::Op::kText);
+    content_->texts.push_back(text);
+  }
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
@@ -83,11 +111,53 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+  if (content_) {
+    content_->ops.push_back(ParagraphContent::Op::kPlaceholder);
+    content_->placeholders.push_back(span);
+  }
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
+  if (content_) {
+    content_->ComputeHash();
+  }
   return std::make_unique<ParagraphSkia>(
-      builder_->Build(), std::move(dl_paints_), impeller_enabled_);
+      builder_->Build(), std::move(dl_paints_), impeller_enabled_,
+      std::move(content_), std::move(layout_cache_));
+}
+
+std::unique_ptr<skt::Paragraph> ParagraphBuilderSkia::BuildSkiaParagraph(
+    const ParagraphContent& content,
+    sk_sp<skt::FontCollection> font_collection) {
+  if (!font_collection) {
+    font_collection = content.font_collection;
+  }
+  // The paints are created in the same order as they were for the original
+  // paragraph, so the paint IDs of the new paragraph are the same.
+  ParagraphBuilderSkia builder(content.style, std::move(font_collection),
+                               nullptr, false);
+  auto pushed_style = content.pushed_styles.begin();
+  auto text = content.texts.begin();
+  auto placeholder = content.placeholders.begin();
+  for (ParagraphContent::Op op : content.ops) {
+    switch (op) {
+      case ParagraphContent::Op::kPushStyle:
+        builder.PushStyle(*pushed_style++);
+        break;
+      case ParagraphContent::Op::kPop:
+        builder.Pop();
+        break;
+      case ParagraphContent::Op::kText:
+        builder.AddText(*text++);
+        break;
+      case ParagraphContent::Op::kPlaceholder: {
+        PlaceholderRun span = *placeholder++;
+        builder.AddPlaceholder(span);
+        break;
+      }
+    }
+  }
+  return builder.builder_->Build();
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
@@ -20,6 +20,7 @@
 #include "txt/paragraph_builder.h"
 
 #include "flutter/display_list/dl_paint.h"
+#include "paragraph_layout_cache.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
@@ -44,7 +45,25 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   virtual void AddPlaceholder(PlaceholderRun& span) override;
   virtual std::unique_ptr<Paragraph> Build() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Builds another Skia paragraph from recorded |content|, for a
+  ///             paragraph whose layout is shared with other paragraphs to
+  ///             be laid out again.
+  ///
+  /// @param[in]  font_collection  The collection to match the fonts with, or
+  ///                              nullptr for the one |content| was recorded
+  ///                              with.
+  ///
+  static std::unique_ptr<skia::textlayout::Paragraph> BuildSkiaParagraph(
+      const ParagraphContent& content,
+      sk_sp<skia::textlayout::FontCollection> font_collection = nullptr);
+
  private:
+  ParagraphBuilderSkia(const ParagraphStyle& style,
+                       sk_sp<skia::textlayout::FontCollection> font_collection,
+                       std::shared_ptr<ParagraphLayoutCache> layout_cache,
+                       const bool impeller_enabled);
+
   skia::textlayout::ParagraphPainter::PaintID CreatePaintID(
       const flutter::DlPaint& dl_paint);
   skia::textlayout::ParagraphStyle TxtToSkia(const ParagraphStyle& txt);
@@ -62,6 +81,10 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   const bool impeller_enabled_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
+  // Only set if the layouts of the paragraphs are cached. |content_| is then
+  // recorded while the paragraph is built.
+  std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+  std::shared_ptr<ParagraphContent> content_;
 };
 
 }  // namespace txt
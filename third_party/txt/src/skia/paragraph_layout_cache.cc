@@ -0,0 +1,247 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "paragraph_layout_cache.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+namespace {
+
+// The statistics are traced at this interval of lookups.
+constexpr size_t kTraceInterval = 64;
+
+bool IsSameTextStyle(const TextStyle& a, const TextStyle& b) {
+  return a.color == b.color &&                                    //
+         a.decoration == b.decoration &&                          //
+         a.decoration_color == b.decoration_color &&              //
+         a.decoration_style == b.decoration_style &&              //
+         a.decoration_thickness_multiplier ==                     //
+             b.decoration_thickness_multiplier &&                 //
+         a.font_weight == b.font_weight &&                        //
+         a.font_style == b.font_style &&                          //
+         a.text_baseline == b.text_baseline &&                    //
+         a.half_leading == b.half_leading &&                      //
+         a.font_families == b.font_families &&                    //
+         a.font_size == b.font_size &&                            //
+         a.letter_spacing == b.letter_spacing &&                  //
+         a.word_spacing == b.word_spacing &&                      //
+         a.height == b.height &&                                  //
+         a.has_height_override == b.has_height_override &&        //
+         a.locale == b.locale &&                                  //
+         a.background.has_value() == b.background.has_value() &&  //
+         a.foreground.has_value() == b.foreground.has_value() &&  //
+         a.text_shadows == b.text_shadows &&                      //
+         a.font_features.GetFontFeatures() ==                     //
+             b.font_features.GetFontFeatures() &&                 //
+         a.font_variations.GetAxisValues() == b.font_variations.GetAxisValues();
+}
+
+bool IsSameParagraphStyle(const ParagraphStyle& a, const ParagraphStyle& b) {
+  return a.font_weight == b.font_weight &&                              //
+         a.font_style == b.font_style &&                                //
+         a.font_family == b.font_family &&                              //
+         a.font_size == b.font_size &&                                  //
+         a.height == b.height &&                                        //
+         a.has_height_override == b.has_height_override &&              //
+         a.text_height_behavior == b.text_height_behavior &&            //
+         a.strut_enabled == b.strut_enabled &&                          //
+         a.strut_font_weight == b.strut_font_weight &&                  //
+         a.strut_font_style == b.strut_font_style &&                    //
+         a.strut_font_families == b.strut_font_families &&              //
+         a.strut_font_size == b.strut_font_size &&                      //
+         a.strut_height == b.strut_height &&                            //
+         a.strut_has_height_override == b.strut_has_height_override &&  //
+         a.strut_half_leading == b.strut_half_leading &&                //
+         a.strut_leading == b.strut_leading &&                          //
+         a.force_strut_height == b.force_strut_height &&                //
+         a.text_align == b.text_align &&                                //
+         a.text_direction == b.text_direction &&                        //
+         a.max_lines == b.max_lines &&                                  //
+         a.ellipsis == b.ellipsis &&                                    //
+         a.locale == b.locale &&                                        //
+         a.apply_rounding_hack == b.apply_rounding_hack;
+}
+
+bool IsSamePlaceholder(const PlaceholderRun& a, const PlaceholderRun& b) {
+  return a.width == b.width &&          //
+         a.height == b.height &&        //
+         a.alignment == b.alignment &&  //
+         a.baseline == b.baseline &&    //
+         a.baseline_offset == b.baseline_offset;
+}
+
+template <typename T, typename Equal>
+bool AreAllSame(const std::vector<T>& a,
+                const std::vector<T>& b,
+                const Equal& equal) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(), equal);
+}
+
+}  // namespace
+
+bool ParagraphContent::operator==(const ParagraphContent& other) const {
+  if (hash != other.hash || font_collection != other.font_collection ||
+      ops != other.ops || texts != other.texts) {
+    return false;
+  }
+  return IsSameParagraphStyle(style, other.style) &&
+         AreAllSame(pushed_styles, other.pushed_styles, IsSameTextStyle) &&
+         AreAllSame(placeholders, other.placeholders, IsSamePlaceholder);
+}
+
+void ParagraphContent::ComputeHash() {
+  // Only the attributes that usually differ between paragraphs are hashed,
+  // the others are compared when the hashes match.
+  hash = fml::HashCombine(font_collection.get(), style.font_size,
+                          std::hash<std::string>{}(style.font_family),
+                          style.max_lines, ops.size());
+  for (Op op : ops) {
+    fml::HashCombineSeed(hash, static_cast<int>(op));
+  }
+  for (const TextStyle& pushed_style : pushed_styles) {
+    fml::HashCombineSeed(
+        hash, pushed_style.font_size,
+        static_cast<int>(pushed_style.font_weight),
+        pushed_style.font_families.empty()
+            ? size_t{0}
+            : std::hash<std::string>{}(pushed_style.font_families.front()));
+  }
+  for (const std::u16string& text : texts) {
+    fml::HashCombineSeed(hash, std::hash<std::u16string>{}(text));
+  }
+  for (const PlaceholderRun& placeholder : placeholders) {
+    fml::HashCombineSeed(hash, placeholder.width, placeholder.height);
+  }
+}
+
+ParagraphLayoutCache::ParagraphLayoutCache(size_t max_entries)
+    : max_entries_(max_entries) {}
+
+ParagraphLayoutCache::~ParagraphLayoutCache() = default;
+
+std::shared_ptr<skia::textlayout::Paragraph> ParagraphLayoutCache::Find(
+    const ParagraphContent& content,
+    double width) {
+  std::scoped_lock lock(mutex_);
+  auto entry = FindEntry(content, width);
+  if (entry == entries_.end()) {
+    miss_count_++;
+    TraceStatsToTimeline();
+    return nullptr;
+  }
+  hit_count_++;
+  TraceStatsToTimeline();
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->paragraph;
+}
+
+void ParagraphLayoutCache::Insert(
+    std::shared_ptr<const ParagraphContent> content,
+    double width,
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph) {
+  FML_DCHECK(content && paragraph);
+  if (max_entries_ == 0) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (FindEntry(*content, width) != entries_.end()) {
+    return;
+  }
+  if (entries_.size() == max_entries_) {
+    EraseEntry(std::prev(entries_.end()));
+  }
+  const size_t hash = content->hash;
+  entries_.push_front({
+      .content = std::move(content),
+      .width = width,
+      .thread_id = std::this_thread::get_id(),
+      .paragraph = std::move(paragraph),
+  });
+  index_.emplace(hash, entries_.begin());
+}
+
+bool ParagraphLayoutCache::Release(
+    const ParagraphContent& content,
+    double width,
+    const std::shared_ptr<skia::textlayout::Paragraph>& paragraph) {
+  std::scoped_lock lock(mutex_);
+  auto entry = FindEntry(content, width);
+  if (entry == entries_.end() || entry->paragraph != paragraph) {
+    // The entry was evicted, the paragraph is only shared if another
+    // paragraph found it before that.
+    return paragraph.use_count() == 1;
+  }
+  // Paragraphs only find the entries of their thread, so no other thread can
+  // start using it while this one lays it out.
+  if (paragraph.use_count() > 2) {
+    return false;
+  }
+  EraseEntry(entry);
+  return true;
+}
+
+void ParagraphLayoutCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  generation_++;
+}
+
+ParagraphLayoutCache::Statistics ParagraphLayoutCache::GetStatistics() const {
+  std::scoped_lock lock(mutex_);
+  return {
+      .hit_count = hit_count_,
+      .miss_count = miss_count_,
+      .entry_count = entries_.size(),
+  };
+}
+
+ParagraphLayoutCache::EntryList::iterator ParagraphLayoutCache::FindEntry(
+    const ParagraphContent& content,
+    double width) {
+  const auto thread_id = std::this_thread::get_id();
+  auto [begin, end] = index_.equal_range(content.hash);
+  for (auto it = begin; it != end; ++it) {
+    const Entry& entry = *it->second;
+    if (entry.width == width && entry.thread_id == thread_id &&
+        *entry.content == content) {
+      return it->second;
+    }
+  }
+  return entries_.end();
+}
+
+void ParagraphLayoutCache::EraseEntry(EntryList::iterator entry) {
+  auto [begin, end] = index_.equal_range(entry->content->hash);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second == entry) {
+      index_.erase(it);
+      break;
+    }
+  }
+  entries_.erase(entry);
+}
+
+void ParagraphLayoutCache::TraceStatsToTimeline() const {
+#if !FLUTTER_RELEASE
+  if ((hit_count_ + miss_count_) % kTraceInterval != 0) {
+    return;
+  }
+  FML_TRACE_COUNTER("flutter",                                       //
+                    "ParagraphLayoutCache",                          //
+                    reinterpret_cast<int64_t>(this),                 //
+                    "HitCount", static_cast<int64_t>(hit_count_),    //
+                    "MissCount", static_cast<int64_t>(miss_count_),  //
+                    "EntryCount", static_cast<int64_t>(entries_.size()));
+#endif  // !FLUTTER_RELEASE
+}
+
+}  // namespace txt
@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+#define LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"
+#include "txt/paragraph_style.h"
+#include "txt/placeholder_run.h"
+#include "txt/text_style.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      Everything a paragraph is built from, as recorded by
+///             |ParagraphBuilderSkia|. Two paragraphs with the same content
+///             are shaped and laid out identically.
+///
+struct ParagraphContent {
+  enum class Op {
+    kPushStyle,
+    kPop,
+    kText,
+    kPlaceholder,
+  };
+
+  sk_sp<skia::textlayout::FontCollection> font_collection;
+  ParagraphStyle style;
+  std::vector<Op> ops;
+  // The arguments of the ops, in order.
+  std::vector<TextStyle> pushed_styles;
+  std::vector<std::u16string> texts;
+  std::vector<PlaceholderRun> placeholders;
+  size_t hash = 0;
+
+  /// Whether the paragraphs lay out the same. Paints are only compared by
+  /// their presence since every paragraph paints with its own paints.
+  bool operator==(const ParagraphContent& other) const;
+
+  /// Computes |hash| once all the ops were added.
+  void ComputeHash();
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A bounded cache of laid out paragraphs, shared by all the
+///             paragraphs built with a font collection.
+///
+///             Identical strings with identical styles, such as the labels of
+///             list items or the headers of a table, are shaped and broken
+///             into lines once for each width they are laid out at instead of
+///             once for each paragraph.
+///
+///             A laid out |skia::textlayout::Paragraph| is not thread safe,
+///             so paragraphs only share the layouts made on their thread.
+///
+class ParagraphLayoutCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 256;
+
+  struct Statistics {
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+    size_t entry_count = 0;
+  };
+
+  explicit ParagraphLayoutCache(size_t max_entries = kDefaultMaxEntries);
+
+  ~ParagraphLayoutCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Finds a paragraph with |content| laid out at |width| on the
+  ///             calling thread, and counts the lookup as a hit or a miss.
+  ///
+  /// @return     The paragraph, or nullptr if there is none. It must not be
+  ///             laid out again.
+  ///
+  std::shared_ptr<skia::textlayout::Paragraph> Find(
+      const ParagraphContent& content,
+      double width);
+
+  /// Adds a paragraph with |content| that was just laid out at |width|.
+  void Insert(std::shared_ptr<const ParagraphContent> content,
+              double width,
+              std::shared_ptr<skia::textlayout::Paragraph> paragraph);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes |paragraph| so that it can be laid out again, unless
+  ///             another paragraph uses it.
+  ///
+  /// @return     Whether the caller is the only user of |paragraph| now.
+  ///
+  bool Release(const ParagraphContent& content,
+               double width,
+               const std::shared_ptr<skia::textlayout::Paragraph>& paragraph);
+
+  /// Removes all the layouts, such as when the fonts change.
+  void Clear();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of times the cache was cleared. Paragraphs that
+  ///             remember their own layouts only use the ones made since.
+  ///
+  size_t GetGeneration() const { return generation_; }
+
+  Statistics GetStatistics() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const ParagraphContent> content;
+    double width;
+    std::thread::id thread_id;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+  };
+  using EntryList = std::list<Entry>;
+
+  const size_t max_entries_;
+  mutable std::mutex mutex_;
+  // The most recently used entry first.
+  EntryList entries_;
+  std::unordered_multimap<size_t, EntryList::iterator> index_;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+  std::atomic<size_t> generation_ = 0;
+
+  EntryList::iterator FindEntry(const ParagraphContent& content, double width);
+
+  void EraseEntry(EntryList::iterator entry);
+
+  void TraceStatsToTimeline() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphLayoutCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
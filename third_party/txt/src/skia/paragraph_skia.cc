@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <numeric>
 #include "fml/logging.h"
+#include "paragraph_builder_skia.h"
 
 namespace txt {
 
@@ -207,12 +208,19 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
 
 }  // anonymous namespace
 
-ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
-                             std::vector<flutter::DlPaint>&& dl_paints,
-                             bool impeller_enabled)
+ParagraphSkia::ParagraphSkia(
+    std::unique_ptr<skt::Paragraph> paragraph,
+    std::vector<flutter::DlPaint>&& dl_paints,
+    bool impeller_enabled,
+    std::shared_ptr<const ParagraphContent> content,
+    std::shared_ptr<ParagraphLayoutCache> layout_cache)
     : paragraph_(std::move(paragraph)),
       dl_paints_(dl_paints),
-      impeller_enabled_(impeller_enabled) {}
+      impeller_enabled_(impeller_enabled),
+      content_(std::move(content)),
+      layout_cache_(std::move(layout_cache)) {
+  FML_DCHECK(!layout_cache_ || content_);
+}
 
 double ParagraphSkia::GetMaxWidth() {
   return SkScalarToDouble(paragraph_->getMaxWidth());
@@ -288,7 +296,92 @@ bool ParagraphSkia::DidExceedMaxLines() {
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
-  paragraph_->layout(width);
+  if (!layout_cache_) {
+    paragraph_->layout(width);
+    return;
+  }
+
+  const size_t generation = layout_cache_->GetGeneration();
+  auto recent = std::find_if(
+      recent_layouts_.begin(), recent_layouts_.end(),
+      [width, generation](const RecentLayout& layout) {
+        return layout.width == width && layout.generation == generation;
+      });
+  if (recent != recent_layouts_.end()) {
+    std::rotate(recent_layouts_.begin(), recent, recent + 1);
+    paragraph_ = recent_layouts_.front().paragraph;
+    return;
+  }
+  if (auto cached = layout_cache_->Find(*content_, width)) {
+    // Neither shaped nor laid out by this paragraph.
+    AddRecentLayout({width, std::move(cached), generation, false});
+    return;
+  }
+  std::shared_ptr<skt::Paragraph> paragraph = TakeParagraphToLayOut();
+  paragraph->layout(width);
+  layout_cache_->Insert(content_, width, paragraph);
+  AddRecentLayout({width, std::move(paragraph), generation, false});
+}
+
+bool ParagraphSkia::LayoutConcurrently(
+    double width,
+    const sk_sp<skt::FontCollection>& font_collection) {
+  // Paragraphs without a layout cache don't record their content.
+  if (!layout_cache_) {
+    return false;
+  }
+  const size_t generation = layout_cache_->GetGeneration();
+  if (!recent_layouts_.empty() && recent_layouts_.front().width == width &&
+      recent_layouts_.front().generation == generation) {
+    return true;
+  }
+
+  line_metrics_.reset();
+  line_metrics_styles_.clear();
+  // The layout cache belongs to the thread the paragraph was built on, so the
+  // layout is neither looked up nor shared. The previous layouts may still be
+  // used by other paragraphs and are left alone.
+  std::shared_ptr<skt::Paragraph> paragraph =
+      ParagraphBuilderSkia::BuildSkiaParagraph(*content_, font_collection);
+  paragraph->layout(width);
+  AddRecentLayout({width, std::move(paragraph), generation, true});
+  return true;
+}
+
+void ParagraphSkia::AddRecentLayout(RecentLayout layout) {
+  const size_t generation = layout.generation;
+  // The layouts shaped with fonts that have since changed are stale.
+  recent_layouts_.erase(
+      std::remove_if(recent_layouts_.begin(), recent_layouts_.end(),
+                     [generation](const RecentLayout& recent) {
+                       return recent.generation != generation;
+                     }),
+      recent_layouts_.end());
+  if (recent_layouts_.size() == kMaxRecentLayouts) {
+    recent_layouts_.pop_back();
+  }
+  recent_layouts_.insert(recent_layouts_.begin(), std::move(layout));
+  paragraph_ = recent_layouts_.front().paragraph;
+}
+
+std::shared_ptr<skt::Paragraph> ParagraphSkia::TakeParagraphToLayOut() {
+  if (recent_layouts_.empty()) {
+    // The paragraph made by the builder, which was never laid out.
+    return paragraph_;
+  }
+  if (recent_layouts_.size() == kMaxRecentLayouts) {
+    // Lays out the least recent layout again rather than shaping the text
+    // anew, unless other paragraphs use it.
+    RecentLayout oldest = std::move(recent_layouts_.back());
+    recent_layouts_.pop_back();
+    if (!oldest.concurrent &&
+        oldest.generation == layout_cache_->GetGeneration() &&
+        layout_cache_->Release(*content_, oldest.width, oldest.paragraph)) {
+      return std::move(oldest.paragraph);
+    }
+  }
+  // Keeps the previous layouts, which are either shared or remembered.
+  return ParagraphBuilderSkia::BuildSkiaParagraph(*content_);
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
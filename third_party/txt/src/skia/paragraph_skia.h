@@ -17,10 +17,13 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 #define LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "txt/paragraph.h"
 
+#include "paragraph_layout_cache.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 
 namespace txt {
@@ -28,9 +31,12 @@ namespace txt {
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
-  ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
-                std::vector<flutter::DlPaint>&& dl_paints,
-                bool impeller_enabled);
+  ParagraphSkia(
+      std::unique_ptr<skia::textlayout::Paragraph> paragraph,
+      std::vector<flutter::DlPaint>&& dl_paints,
+      bool impeller_enabled,
+      std::shared_ptr<const ParagraphContent> content = nullptr,
+      std::shared_ptr<ParagraphLayoutCache> layout_cache = nullptr);
 
   virtual ~ParagraphSkia() = default;
 
@@ -54,6 +60,10 @@ class ParagraphSkia : public Paragraph {
 
   void Layout(double width) override;
 
+  bool LayoutConcurrently(
+      double width,
+      const sk_sp<skia::textlayout::FontCollection>& font_collection) override;
+
   bool Paint(flutter::DisplayListBuilder* builder, double x, double y) override;
 
   std::vector<TextBox> GetRectsForRange(
@@ -72,11 +82,44 @@ class ParagraphSkia : public Paragraph {
  private:
   TextStyle SkiaToTxt(const skia::textlayout::TextStyle& skia);
 
-  std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
+  // The number of widths the layouts of a paragraph are remembered at, such
+  // as the intrinsic and the constrained width it is laid out at every frame.
+  static constexpr size_t kMaxRecentLayouts = 2;
+
+  struct RecentLayout {
+    double width;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+    // The |ParagraphLayoutCache::GetGeneration| of the fonts it was shaped
+    // with.
+    size_t generation;
+    // Whether it was made by LayoutConcurrently. It uses a font collection
+    // that other threads may be laying out with, so it is only read, never
+    // laid out again.
+    bool concurrent;
+  };
+
+  // Makes |layout| the most recent layout and the one |paragraph_| reads.
+  void AddRecentLayout(RecentLayout layout);
+
+  // A paragraph with the content of this one that it may lay out again. It
+  // is a paragraph that was already shaped, whenever there is one, so that
+  // only the lines are broken again.
+  std::shared_ptr<skia::textlayout::Paragraph> TakeParagraphToLayOut();
+
+  // May be shared with other paragraphs with the same content through the
+  // layout cache, in which case it must not be laid out again.
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
   std::vector<flutter::DlPaint> dl_paints_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
   const bool impeller_enabled_;
+  // Only set if layouts are cached.
+  const std::shared_ptr<const ParagraphContent> content_;
+  const std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+  // The layouts at the last widths, most recent first, if layouts are cached.
+  // The first one is |paragraph_|. Laying out again at one of the widths only
+  // switches to its layout, even once the layout cache has evicted it.
+  std::vector<RecentLayout> recent_layouts_;
 };
 
 }  // namespace txt
@@ -0,0 +1,320 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "fallback_caching_font_manager.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace txt {
+
+namespace {
+
+// The fallback fonts are cached for ranges of 2^kBlockShift code points.
+// Unicode allocates scripts in blocks of multiples of 128 code points, and a
+// font that covers a script usually covers the whole block.
+constexpr uint32_t kBlockShift = 7;
+
+// Bounds the memory and the size of the file. Real text seldom needs more
+// than a few dozen ranges.
+constexpr size_t kMaxEntries = 1024;
+
+// How long after the first new fallback font the cache is written, so that
+// the fonts found for a frame are written together.
+constexpr fml::TimeDelta kSaveDelay = fml::TimeDelta::FromSeconds(2);
+
+// Bumped when the format of the file changes.
+constexpr int kFormatVersion = 1;
+
+// The fields of a key and of a line of the file are separated by tabs.
+constexpr char kSeparator = '\t';
+
+std::string StyleToString(const SkFontStyle& style) {
+  return std::to_string(style.weight()) + " " + std::to_string(style.width()) +
+         " " + std::to_string(static_cast<int>(style.slant()));
+}
+
+bool StyleFromString(const std::string& string, SkFontStyle* style) {
+  std::istringstream stream(string);
+  int weight = 0;
+  int width = 0;
+  int slant = 0;
+  if (!(stream >> weight >> width >> slant) ||
+      slant > SkFontStyle::kOblique_Slant || slant < 0) {
+    return false;
+  }
+  *style = SkFontStyle(weight, width, static_cast<SkFontStyle::Slant>(slant));
+  return true;
+}
+
+std::string MakeKey(const char family_name[],
+                    const SkFontStyle& style,
+                    const char* bcp47[],
+                    int bcp47_count,
+                    SkUnichar character) {
+  std::string key = family_name ? family_name : "";
+  key += kSeparator;
+  key += StyleToString(style);
+  key += kSeparator;
+  for (int i = 0; i < bcp47_count; i++) {
+    if (i > 0) {
+      key += ',';
+    }
+    key += bcp47[i];
+  }
+  key += kSeparator;
+  key += std::to_string(static_cast<uint32_t>(character) >> kBlockShift);
+  return key;
+}
+
+std::vector<std::string> Split(const std::string& string) {
+  std::vector<std::string> fields;
+  std::istringstream stream(string);
+  std::string field;
+  while (std::getline(stream, field, kSeparator)) {
+    fields.push_back(field);
+  }
+  return fields;
+}
+
+// Whether a family name or locale in a key would make it ambiguous or span
+// lines in the file.
+bool IsStorable(const std::string& key, const std::string& family_name) {
+  return !family_name.empty() &&
+         family_name.find_first_of("\t\n") == std::string::npos &&
+         key.find('\n') == std::string::npos &&
+         std::count(key.begin(), key.end(), kSeparator) == 3;
+}
+
+}  // namespace
+
+FallbackCachingFontManager::FallbackCachingFontManager(
+    sk_sp<SkFontMgr> delegate)
+    : delegate_(std::move(delegate)) {
+  FML_DCHECK(delegate_);
+}
+
+FallbackCachingFontManager::~FallbackCachingFontManager() = default;
+
+void FallbackCachingFontManager::SetStorage(
+    std::shared_ptr<fml::UniqueFD> directory,
+    fml::RefPtr<fml::TaskRunner> task_runner) {
+  directory_ = std::move(directory);
+  task_runner_ = std::move(task_runner);
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  fonts_fingerprint_ = ComputeFontsFingerprint();
+  Load();
+}
+
+uint64_t FallbackCachingFontManager::ComputeFontsFingerprint() const {
+  // FNV-1a, which unlike std::hash is the same in every run.
+  uint64_t hash = 0xcbf29ce484222325;
+  auto add = [&hash](const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      hash ^= static_cast<uint8_t>(data[i]);
+      hash *= 0x100000001b3;
+    }
+  };
+  const int count = delegate_->countFamilies();
+  add(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (int i = 0; i < count; i++) {
+    SkString family_name;
+    delegate_->getFamilyName(i, &family_name);
+    // Includes the terminator to tell ["ab", "c"] from ["a", "bc"].
+    add(family_name.c_str(), family_name.size() + 1);
+  }
+  return hash;
+}
+
+bool FallbackCachingFontManager::Load() {
+  TRACE_EVENT0("flutter", "FallbackCachingFontManager::Load");
+  auto mapping = fml::FileMapping::CreateReadOnly(*directory_, kFileName);
+  if (!mapping || !mapping->GetMapping()) {
+    return false;
+  }
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                  mapping->GetSize()));
+
+  std::string line;
+  if (!std::getline(stream, line) ||
+      line != std::to_string(kFormatVersion) + " " +
+                  std::to_string(fonts_fingerprint_)) {
+    // Written by another version or for other fonts of the system.
+    return false;
+  }
+
+  std::scoped_lock lock(mutex_);
+  while (std::getline(stream, line) && entries_.size() < kMaxEntries) {
+    // The four fields of the key, the family and the style of the font.
+    std::vector<std::string> fields = Split(line);
+    Entry entry;
+    if (fields.size() != 6 || !StyleFromString(fields[5], &entry.style)) {
+      FML_LOG(WARNING) << "Discarding a malformed font fallback cache.";
+      entries_.clear();
+      break;
+    }
+    entry.family_name = std::move(fields[4]);
+    const std::string key = fields[0] + kSeparator + fields[1] + kSeparator +
+                            fields[2] + kSeparator + fields[3];
+    entries_.emplace(key, std::move(entry));
+  }
+  statistics_.entry_count = entries_.size();
+  return !entries_.empty();
+}
+
+bool FallbackCachingFontManager::Save() const {
+  if (!directory_ || !directory_->is_valid()) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "FallbackCachingFontManager::Save");
+
+  std::string contents = std::to_string(kFormatVersion) + " " +
+                         std::to_string(fonts_fingerprint_) + "\n";
+  {
+    std::scoped_lock lock(mutex_);
+    save_pending_ = false;
+    for (const auto& [key, entry] : entries_) {
+      if (IsStorable(key, entry.family_name)) {
+        contents += key + kSeparator + entry.family_name + kSeparator +
+                    StyleToString(entry.style) + "\n";
+      }
+    }
+  }
+  return fml::WriteAtomically(*directory_, kFileName,
+                              fml::DataMapping(contents));
+}
+
+void FallbackCachingFontManager::ScheduleSave() const {
+  if (!task_runner_ || !directory_ || !directory_->is_valid() ||
+      save_pending_) {
+    return;
+  }
+  save_pending_ = true;
+  task_runner_->PostDelayedTask(
+      [manager = sk_ref_sp(this)]() { manager->Save(); }, kSaveDelay);
+}
+
+FallbackCachingFontManager::Statistics
+FallbackCachingFontManager::GetStatistics() const {
+  std::scoped_lock lock(mutex_);
+  return statistics_;
+}
+
+int FallbackCachingFontManager::onCountFamilies() const {
+  return delegate_->countFamilies();
+}
+
+void FallbackCachingFontManager::onGetFamilyName(int index,
+                                                 SkString* familyName) const {
+  delegate_->getFamilyName(index, familyName);
+}
+
+sk_sp<SkFontStyleSet> FallbackCachingFontManager::onCreateStyleSet(
+    int index) const {
+  return delegate_->createStyleSet(index);
+}
+
+sk_sp<SkFontStyleSet> FallbackCachingFontManager::onMatchFamily(
+    const char familyName[]) const {
+  return delegate_->matchFamily(familyName);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMatchFamilyStyle(
+    const char familyName[],
+    const SkFontStyle& style) const {
+  return delegate_->matchFamilyStyle(familyName, style);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMatchFamilyStyleCharacter(
+    const char familyName[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47Count,
+    SkUnichar character) const {
+  const std::string key =
+      MakeKey(familyName, style, bcp47, bcp47Count, character);
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = entries_.find(key);
+    if (found != entries_.end()) {
+      Entry& entry = found->second;
+      if (!entry.typeface) {
+        // Loaded from the file.
+        entry.typeface =
+            delegate_->matchFamilyStyle(entry.family_name.c_str(), entry.style);
+      }
+      if (entry.typeface && entry.typeface->unicharToGlyph(character) != 0) {
+        statistics_.hit_count++;
+        return entry.typeface;
+      }
+    }
+    statistics_.miss_count++;
+  }
+
+  sk_sp<SkTypeface> typeface = delegate_->matchFamilyStyleCharacter(
+      familyName, style, bcp47, bcp47Count, character);
+  if (!typeface) {
+    return nullptr;
+  }
+
+  SkString family_name;
+  typeface->getFamilyName(&family_name);
+  std::scoped_lock lock(mutex_);
+  if (entries_.size() < kMaxEntries || entries_.count(key) > 0) {
+    // Replaces a font that didn't have the character.
+    entries_[key] = Entry{
+        .family_name = family_name.c_str(),
+        .style = typeface->fontStyle(),
+        .typeface = typeface,
+    };
+    statistics_.entry_count = entries_.size();
+    ScheduleSave();
+  }
+  return typeface;
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromData(
+    sk_sp<SkData> data,
+    int ttcIndex) const {
+  return delegate_->makeFromData(std::move(data), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromStreamIndex(
+    std::unique_ptr<SkStreamAsset> stream,
+    int ttcIndex) const {
+  return delegate_->makeFromStream(std::move(stream), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromStreamArgs(
+    std::unique_ptr<SkStreamAsset> stream,
+    const SkFontArguments& args) const {
+  return delegate_->makeFromStream(std::move(stream), args);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromFile(
+    const char path[],
+    int ttcIndex) const {
+  return delegate_->makeFromFile(path, ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onLegacyMakeTypeface(
+    const char familyName[],
+    SkFontStyle style) const {
+  return delegate_->legacyMakeTypeface(familyName, style);
+}
+
+}  // namespace txt
@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
+#define LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkFontStyle.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      A font manager that forwards to a platform font manager and
+///             remembers the fallback fonts it picks for missing characters.
+///
+///             Looking up the font for a character the requested families
+///             don't have, such as an emoji or a CJK ideograph, walks the
+///             fonts of the system and is expensive. The fonts found are
+///             cached for ranges of 128 code points, keyed by the requested
+///             family, style and locales, and reused for every character of
+///             the range they have a glyph for.
+///
+///             The cache can be stored on disk so that the first frames after
+///             a restart don't pay for the lookups again. It is discarded when
+///             the fonts of the system change.
+///
+class FallbackCachingFontManager : public SkFontMgr {
+ public:
+  struct Statistics {
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+    size_t entry_count = 0;
+  };
+
+  explicit FallbackCachingFontManager(sk_sp<SkFontMgr> delegate);
+
+  ~FallbackCachingFontManager() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the cache stored in |directory| unless the fonts of the
+  ///             system changed since it was written, and stores the fallback
+  ///             fonts found from now on in the same directory. The file is
+  ///             written on |task_runner|, a little after the lookups, so that
+  ///             the lookups of a frame are written together.
+  ///
+  ///             Must be called before the font manager is used.
+  ///
+  void SetStorage(std::shared_ptr<fml::UniqueFD> directory,
+                  fml::RefPtr<fml::TaskRunner> task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the cache to the storage directory now.
+  ///
+  /// @return     Whether there was a directory and the write succeeded.
+  ///
+  bool Save() const;
+
+  Statistics GetStatistics() const;
+
+  static constexpr char kFileName[] = "font_fallback_cache";
+
+ private:
+  struct Entry {
+    // The font as stored on disk, matched with the delegate when it is first
+    // needed after loading.
+    std::string family_name;
+    SkFontStyle style;
+    sk_sp<SkTypeface> typeface;
+  };
+
+  const sk_sp<SkFontMgr> delegate_;
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<std::string, Entry> entries_;
+  mutable Statistics statistics_;
+  std::shared_ptr<fml::UniqueFD> directory_;
+  fml::RefPtr<fml::TaskRunner> task_runner_;
+  uint64_t fonts_fingerprint_ = 0;
+  mutable bool save_pending_ = false;
+
+  // Identifies the fonts of the system, to invalidate the stored cache.
+  uint64_t ComputeFontsFingerprint() const;
+
+  bool Load();
+
+  void ScheduleSave() const;
+
+  // |SkFontMgr|
+  int onCountFamilies() const override;
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onCreateStyleSet(int index) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onMatchFamily(const char familyName[]) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyle(const char familyName[],
+                                       const SkFontStyle&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(std::unique_ptr<SkStreamAsset>,
+                                         const SkFontArguments&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackCachingFontManager);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
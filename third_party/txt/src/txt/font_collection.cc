@@ -26,6 +26,7 @@
 #include <vector>
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "txt/fallback_caching_font_manager.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
@@ -37,6 +38,9 @@ FontCollection::~FontCollection() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  for (const auto& collection : concurrent_collections_) {
+    collection->clearCaches();
+  }
 }
 
 size_t FontCollection::GetFontManagersCount() const {
@@ -46,27 +50,43 @@ size_t FontCollection::GetFontManagersCount() const {
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
   default_font_manager_ = GetDefaultFontManager(font_initialization_data);
-  skt_collection_.reset();
+  if (default_font_manager_) {
+    // The platform font managers are slow to find fonts for the characters
+    // the requested families don't have.
+    auto caching_font_manager = sk_make_sp<FallbackCachingFontManager>(
+        std::move(default_font_manager_));
+    caching_font_manager->SetStorage(fallback_cache_directory_,
+                                     fallback_cache_task_runner_);
+    default_font_manager_ = std::move(caching_font_manager);
+  }
+  ResetSktFontCollection();
+}
+
+void FontCollection::SetFontFallbackCacheStorage(
+    std::shared_ptr<fml::UniqueFD> directory,
+    fml::RefPtr<fml::TaskRunner> task_runner) {
+  fallback_cache_directory_ = std::move(directory);
+  fallback_cache_task_runner_ = std::move(task_runner);
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
   asset_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
   dynamic_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
   test_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -88,34 +108,65 @@ void FontCollection::DisableFontFallback() {
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
+  for (const auto& collection : concurrent_collections_) {
+    collection->disableFontFallback();
+  }
+  paragraph_layout_cache_->Clear();
 }
 
 void FontCollection::ClearFontFamilyCache() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  for (const auto& collection : concurrent_collections_) {
+    collection->clearCaches();
+  }
+  // The fonts the cached layouts were made with may have changed.
+  paragraph_layout_cache_->Clear();
+}
+
+void FontCollection::ResetSktFontCollection() {
+  skt_collection_.reset();
+  concurrent_collections_.clear();
+  paragraph_layout_cache_->Clear();
 }
 
 sk_sp<skia::textlayout::FontCollection>
 FontCollection::CreateSktFontCollection() {
   if (!skt_collection_) {
-    skt_collection_ = sk_make_sp<skia::textlayout::FontCollection>();
-
-    std::vector<SkString> default_font_families;
-    for (const std::string& family : GetDefaultFontFamilies()) {
-      default_font_families.emplace_back(family);
-    }
-    skt_collection_->setDefaultFontManager(default_font_manager_,
-                                           default_font_families);
-    skt_collection_->setAssetFontManager(asset_font_manager_);
-    skt_collection_->setDynamicFontManager(dynamic_font_manager_);
-    skt_collection_->setTestFontManager(test_font_manager_);
-    if (!enable_font_fallback_) {
-      skt_collection_->disableFontFallback();
-    }
+    skt_collection_ = MakeSktFontCollection();
   }
 
   return skt_collection_;
 }
 
+sk_sp<skia::textlayout::FontCollection>
+FontCollection::CreateConcurrentSktFontCollection(size_t index) {
+  while (concurrent_collections_.size() <= index) {
+    concurrent_collections_.push_back(MakeSktFontCollection());
+  }
+
+  return concurrent_collections_[index];
+}
+
+sk_sp<skia::textlayout::FontCollection> FontCollection::MakeSktFontCollection()
+    const {
+  auto collection = sk_make_sp<skia::textlayout::FontCollection>();
+
+  std::vector<SkString> default_font_families;
+  for (const std::string& family : GetDefaultFontFamilies()) {
+    default_font_families.emplace_back(family);
+  }
+  collection->setDefaultFontManager(default_font_manager_,
+                                    default_font_families);
+  collection->setAssetFontManager(asset_font_manager_);
+  collection->setDynamicFontManager(dynamic_font_manager_);
+  collection->setTestFontManager(test_font_manager_);
+  if (!enable_font_fallback_) {
+    collection->disableFontFallback();
+  }
+
+  return collection;
+}
+
 }  // namespace txt
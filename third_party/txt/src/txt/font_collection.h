@@ -21,12 +21,16 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
+#include "skia/paragraph_layout_cache.h"
 #include "txt/asset_font_manager.h"
 #include "txt/text_style.h"
 
@@ -41,6 +45,12 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   size_t GetFontManagersCount() const;
 
   void SetupDefaultFontManager(uint32_t font_initialization_data);
+
+  // Store the fallback fonts found by the default font managers set up from
+  // now on in |directory|, written on |task_runner|, so that they don't have
+  // to be looked up again after a restart.
+  void SetFontFallbackCacheStorage(std::shared_ptr<fml::UniqueFD> directory,
+                                   fml::RefPtr<fml::TaskRunner> task_runner);
   void SetDefaultFontManager(sk_sp<SkFontMgr> font_manager);
   void SetAssetFontManager(sk_sp<SkFontMgr> font_manager);
   void SetDynamicFontManager(sk_sp<SkFontMgr> font_manager);
@@ -56,15 +66,39 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // Construct another Skia text layout FontCollection with the same fonts for
+  // the concurrent layout task at |index|. The Skia collections cache the
+  // fonts they match and are not thread safe, so each task that lays out
+  // paragraphs at the same time as the others uses its own collection.
+  sk_sp<skia::textlayout::FontCollection> CreateConcurrentSktFontCollection(
+      size_t index);
+
+  // The layouts shared by the paragraphs built with this collection.
+  const std::shared_ptr<ParagraphLayoutCache>& GetParagraphLayoutCache() const {
+    return paragraph_layout_cache_;
+  }
+
  private:
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
   bool enable_font_fallback_;
+  std::shared_ptr<fml::UniqueFD> fallback_cache_directory_;
+  fml::RefPtr<fml::TaskRunner> fallback_cache_task_runner_;
 
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
+  // The collections of the concurrent layout tasks, created on demand.
+  std::vector<sk_sp<skia::textlayout::FontCollection>> concurrent_collections_;
+
+  std::shared_ptr<ParagraphLayoutCache> paragraph_layout_cache_ =
+      std::make_shared<ParagraphLayoutCache>();
+
+  // Drops the Skia collection and the layouts that were made with it.
+  void ResetSktFontCollection();
+
+  sk_sp<skia::textlayout::FontCollection> MakeSktFontCollection() const;
 
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
@@ -22,9 +22,14 @@
 #include "line_metrics.h"
 #include "paragraph_style.h"
 #include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
 
 class SkCanvas;
 
+namespace skia::textlayout {
+class FontCollection;
+}  // namespace skia::textlayout
+
 namespace txt {
 
 // Interface for text layout engines.  The current implementation is based on
@@ -143,6 +148,18 @@ class Paragraph {
   // before Painting and getting any statistics from this class.
   virtual void Layout(double width) = 0;
 
+  // Like Layout(), but matches the fonts with |font_collection| instead of the
+  // collection the paragraph was built with, so that it can run on any thread
+  // at the same time as the layouts of other paragraphs that use a different
+  // collection. See FontCollection::CreateConcurrentSktFontCollection. Returns
+  // false, without laying out, if the paragraph can only be laid out with
+  // Layout().
+  virtual bool LayoutConcurrently(
+      double width,
+      const sk_sp<skia::textlayout::FontCollection>& font_collection) {
+    return false;
+  }
+
   // Paints the laid out text onto the supplied DisplayListBuilder at
   // (x, y) offset from the origin. Only valid after Layout() is called.
   virtual bool Paint(flutter::DisplayListBuilder* builder,
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "paragraph_batch_layout.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+namespace {
+
+// A task has to lay out at least this many paragraphs to be worth posting.
+constexpr size_t kMinParagraphsPerTask = 4;
+
+// Shared with the tasks, which may only start after the batch is done. They
+// then find no paragraph left to lay out and don't touch the paragraphs.
+struct BatchLayout {
+  BatchLayout(const std::vector<Paragraph*>& p_paragraphs,
+              const std::vector<double>& p_widths)
+      : paragraphs(p_paragraphs),
+        widths(p_widths),
+        needs_layout(p_paragraphs.size(), false),
+        remaining(p_paragraphs.size()) {}
+
+  const std::vector<Paragraph*> paragraphs;
+  const std::vector<double> widths;
+  std::atomic<size_t> next_index = 0;
+  // The paragraphs a task could not lay out, for the calling thread to lay
+  // out once the tasks are done. Only written by the task that claimed the
+  // paragraph, and not a vector<bool> whose elements would share bytes.
+  std::vector<char> needs_layout;
+  fml::CountDownLatch remaining;
+};
+
+void RunBatchLayoutTask(
+    BatchLayout& batch,
+    const sk_sp<skia::textlayout::FontCollection>& font_collection) {
+  TRACE_EVENT0("flutter", "LayoutParagraphsTask");
+  const size_t count = batch.paragraphs.size();
+  for (size_t i = batch.next_index++; i < count; i = batch.next_index++) {
+    if (!batch.paragraphs[i]->LayoutConcurrently(batch.widths[i],
+                                                 font_collection)) {
+      batch.needs_layout[i] = true;
+    }
+    batch.remaining.CountDown();
+  }
+}
+
+}  // namespace
+
+void LayoutParagraphs(const std::vector<Paragraph*>& paragraphs,
+                      const std::vector<double>& widths,
+                      FontCollection& font_collection,
+                      const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+                      size_t max_tasks) {
+  FML_DCHECK(paragraphs.size() == widths.size());
+  TRACE_EVENT0("flutter", "LayoutParagraphs");
+  const size_t task_count =
+      task_runner
+          ? std::min(max_tasks, paragraphs.size() / kMinParagraphsPerTask)
+          : 0;
+  if (task_count == 0) {
+    for (size_t i = 0; i < paragraphs.size(); i++) {
+      paragraphs[i]->Layout(widths[i]);
+    }
+    return;
+  }
+
+  auto batch = std::make_shared<BatchLayout>(paragraphs, widths);
+  for (size_t i = 0; i < task_count; i++) {
+    // A collection per task, so that no collection is used by two threads at
+    // the same time.
+    task_runner->PostTask(
+        [batch, font_collection =
+                    font_collection.CreateConcurrentSktFontCollection(i)]() {
+          RunBatchLayoutTask(*batch, font_collection);
+        });
+  }
+
+  // The calling thread owns the layout cache and uses the regular layouts.
+  const size_t count = paragraphs.size();
+  for (size_t i = batch->next_index++; i < count; i = batch->next_index++) {
+    paragraphs[i]->Layout(widths[i]);
+    batch->remaining.CountDown();
+  }
+  batch->remaining.Wait();
+
+  for (size_t i = 0; i < count; i++) {
+    if (batch->needs_layout[i]) {
+      paragraphs[i]->Layout(widths[i]);
+    }
+  }
+}
+
+}  // namespace txt
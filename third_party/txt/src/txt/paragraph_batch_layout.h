@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_BATCH_LAYOUT_H_
+#define LIB_TXT_SRC_PARAGRAPH_BATCH_LAYOUT_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/task_runner.h"
+#include "font_collection.h"
+#include "paragraph.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      Lays out each of |paragraphs| at the width at the same index of
+///             |widths|, spreading the layouts over the calling thread and up
+///             to |max_tasks| tasks posted to |task_runner|. Returns once all
+///             the paragraphs are laid out.
+///
+///             The calling thread lays out paragraphs too, with Layout(), so
+///             the batch completes even if the tasks are slow to start. The
+///             tasks use LayoutConcurrently() with a font collection each from
+///             |font_collection|, which must be the collection the paragraphs
+///             were built with and must not change until this returns.
+///
+/// @param[in]  task_runner  The runner of the concurrent tasks, or nullptr to
+///                          lay out every paragraph on the calling thread.
+///
+void LayoutParagraphs(const std::vector<Paragraph*>& paragraphs,
+                      const std::vector<double>& widths,
+                      FontCollection& font_collection,
+                      const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+                      size_t max_tasks);
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_BATCH_LAYOUT_H_
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/fallback_caching_font_manager.h"
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "gtest/gtest.h"
+#include "runtime/test_font_data.h"
+#include "txt/asset_font_manager.h"
+
+namespace txt {
+namespace testing {
+
+namespace {
+
+// Finds the fallback fonts among the test fonts and counts the lookups.
+class CountingFontManager : public AssetFontManager {
+ public:
+  explicit CountingFontManager(std::vector<sk_sp<SkTypeface>> typefaces)
+      : AssetFontManager(std::make_unique<TypefaceFontAssetProvider>()),
+        typefaces_(std::move(typefaces)) {
+    for (const auto& typeface : typefaces_) {
+      static_cast<TypefaceFontAssetProvider&>(*font_provider_)
+          .RegisterTypeface(typeface);
+    }
+  }
+
+  int lookup_count() const { return lookup_count_; }
+
+ private:
+  std::vector<sk_sp<SkTypeface>> typefaces_;
+  mutable int lookup_count_ = 0;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override {
+    lookup_count_++;
+    for (const auto& typeface : typefaces_) {
+      if (typeface->unicharToGlyph(character) != 0) {
+        return typeface;
+      }
+    }
+    return nullptr;
+  }
+};
+
+std::shared_ptr<fml::UniqueFD> OpenDirectory(
+    const fml::ScopedTemporaryDirectory& directory) {
+  return std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      directory.path().c_str(), false, fml::FilePermission::kReadWrite));
+}
+
+sk_sp<SkTypeface> MatchCharacter(const sk_sp<SkFontMgr>& font_manager,
+                                 SkUnichar character) {
+  return font_manager->matchFamilyStyleCharacter("Roboto", SkFontStyle(),
+                                                 nullptr, 0, character);
+}
+
+}  // namespace
+
+TEST(FallbackCachingFontManagerTest, ReusesTheFontOfACodePointRange) {
+  auto delegate = sk_make_sp<CountingFontManager>(flutter::GetTestFontData());
+  auto font_manager = sk_make_sp<FallbackCachingFontManager>(delegate);
+
+  auto first = MatchCharacter(font_manager, 'a');
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(MatchCharacter(font_manager, 'b'), first);
+  EXPECT_EQ(delegate->lookup_count(), 1);
+
+  auto statistics = font_manager->GetStatistics();
+  EXPECT_EQ(statistics.hit_count, 1u);
+  EXPECT_EQ(statistics.miss_count, 1u);
+  EXPECT_EQ(statistics.entry_count, 1u);
+
+  // A character no font has is looked up every time.
+  EXPECT_EQ(MatchCharacter(font_manager, 0x4E00), nullptr);
+  EXPECT_EQ(MatchCharacter(font_manager, 0x4E00), nullptr);
+  EXPECT_EQ(delegate->lookup_count(), 3);
+}
+
+TEST(FallbackCachingFontManagerTest, LoadsTheStoredCache) {
+  fml::ScopedTemporaryDirectory directory;
+  {
+    auto font_manager = sk_make_sp<FallbackCachingFontManager>(
+        sk_make_sp<CountingFontManager>(flutter::GetTestFontData()));
+    font_manager->SetStorage(OpenDirectory(directory), nullptr);
+    ASSERT_NE(MatchCharacter(font_manager, 'a'), nullptr);
+    ASSERT_TRUE(font_manager->Save());
+  }
+
+  auto delegate = sk_make_sp<CountingFontManager>(flutter::GetTestFontData());
+  auto font_manager = sk_make_sp<FallbackCachingFontManager>(delegate);
+  font_manager->SetStorage(OpenDirectory(directory), nullptr);
+  EXPECT_EQ(font_manager->GetStatistics().entry_count, 1u);
+  EXPECT_NE(MatchCharacter(font_manager, 'b'), nullptr);
+  EXPECT_EQ(delegate->lookup_count(), 0);
+}
+
+TEST(FallbackCachingFontManagerTest, DiscardsTheStoredCacheForOtherFonts) {
+  fml::ScopedTemporaryDirectory directory;
+  {
+    auto font_manager = sk_make_sp<FallbackCachingFontManager>(
+        sk_make_sp<CountingFontManager>(flutter::GetTestFontData()));
+    font_manager->SetStorage(OpenDirectory(directory), nullptr);
+    ASSERT_NE(MatchCharacter(font_manager, 'a'), nullptr);
+    ASSERT_TRUE(font_manager->Save());
+  }
+
+  // The fonts of the system changed.
+  auto typefaces = flutter::GetTestFontData();
+  typefaces.pop_back();
+  auto delegate = sk_make_sp<CountingFontManager>(typefaces);
+  auto font_manager = sk_make_sp<FallbackCachingFontManager>(delegate);
+  font_manager->SetStorage(OpenDirectory(directory), nullptr);
+  EXPECT_EQ(font_manager->GetStatistics().entry_count, 0u);
+  EXPECT_NE(MatchCharacter(font_manager, 'a'), nullptr);
+  EXPECT_EQ(delegate->lookup_count(), 1);
+}
+
+}  // namespace testing
+}  // namespace txt
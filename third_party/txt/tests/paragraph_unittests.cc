@@ -4,10 +4,12 @@
 
 #include <memory>
 #include "display_list/utils/dl_receiver_utils.h"
+#include "fml/concurrent_message_loop.h"
 #include "gtest/gtest.h"
 #include "runtime/test_font_data.h"
 #include "skia/paragraph_builder_skia.h"
 #include "testing/canvas_test.h"
+#include "txt/paragraph_batch_layout.h"
 
 namespace flutter {
 namespace testing {
@@ -67,7 +69,7 @@ class PainterTestBase : public CanvasTestBase<T> {
     return builder.Build();
   }
 
- private:
+ protected:
   std::shared_ptr<txt::FontCollection> makeFontCollection() const {
     auto f_collection = std::make_shared<txt::FontCollection>();
     auto font_provider = std::make_unique<txt::TypefaceFontAssetProvider>();
@@ -80,11 +82,25 @@ class PainterTestBase : public CanvasTestBase<T> {
   }
 
   txt::ParagraphBuilderSkia makeParagraphBuilder() const {
+    return makeParagraphBuilder(makeFontCollection());
+  }
+
+  txt::ParagraphBuilderSkia makeParagraphBuilder(
+      const std::shared_ptr<txt::FontCollection>& f_collection) const {
     auto p_style = txt::ParagraphStyle();
-    auto f_collection = makeFontCollection();
     return txt::ParagraphBuilderSkia(p_style, f_collection, impeller_);
   }
 
+  std::unique_ptr<txt::Paragraph> makeParagraph(
+      const std::shared_ptr<txt::FontCollection>& f_collection,
+      const std::u16string& text) const {
+    auto pb_skia = makeParagraphBuilder(f_collection);
+    pb_skia.PushStyle(makeDecoratedStyle(txt::TextDecorationStyle::kSolid));
+    pb_skia.AddText(text);
+    pb_skia.Pop();
+    return pb_skia.Build();
+  }
+
   txt::TextStyle makeDecoratedStyle(txt::TextDecorationStyle style) const {
     auto t_style = txt::TextStyle();
     t_style.color = SK_ColorBLACK;                // default
@@ -148,5 +164,118 @@ TEST_F(PainterTest, DrawDashedLineImpeller) {
   EXPECT_FALSE(recorder.hasPathEffect());
 }
 
+TEST_F(PainterTest, SharesLayoutsOfIdenticalParagraphs) {
+  auto f_collection = makeFontCollection();
+  const auto& cache = f_collection->GetParagraphLayoutCache();
+
+  auto first = makeParagraph(f_collection, u"Hello World!");
+  first->Layout(10000);
+  auto second = makeParagraph(f_collection, u"Hello World!");
+  second->Layout(10000);
+  auto other = makeParagraph(f_collection, u"Goodbye World!");
+  other->Layout(10000);
+
+  auto statistics = cache->GetStatistics();
+  EXPECT_EQ(statistics.hit_count, 1u);
+  EXPECT_EQ(statistics.miss_count, 2u);
+  EXPECT_EQ(statistics.entry_count, 2u);
+  EXPECT_EQ(first->GetMaxIntrinsicWidth(), second->GetMaxIntrinsicWidth());
+  EXPECT_NE(first->GetMaxIntrinsicWidth(), other->GetMaxIntrinsicWidth());
+
+  // Each paragraph still paints with its own paints.
+  auto builder = DisplayListBuilder();
+  second->Paint(&builder, 0, 0);
+  auto recorder = DlOpRecorder();
+  builder.Build()->Dispatch(recorder);
+  EXPECT_EQ(recorder.rectCount(), 1);
+}
+
+TEST_F(PainterTest, RelayingOutASharedParagraphKeepsTheOtherLayout) {
+  auto f_collection = makeFontCollection();
+
+  auto first = makeParagraph(f_collection, u"Hello World!");
+  first->Layout(10000);
+  auto second = makeParagraph(f_collection, u"Hello World!");
+  second->Layout(10000);
+  const double height = first->GetHeight();
+
+  // Wraps every word.
+  second->Layout(1);
+  EXPECT_GT(second->GetHeight(), height);
+  EXPECT_EQ(first->GetHeight(), height);
+
+  // The layout at the first width outlives the paragraph that made it.
+  first.reset();
+  second->Layout(10000);
+  EXPECT_EQ(second->GetHeight(), height);
+}
+
+TEST_F(PainterTest, RemembersLayoutsAtRecentWidths) {
+  auto f_collection = makeFontCollection();
+  const auto& cache = f_collection->GetParagraphLayoutCache();
+
+  auto paragraph = makeParagraph(f_collection, u"Hello World!");
+  paragraph->Layout(10000);
+  const double height = paragraph->GetHeight();
+  paragraph->Layout(1);
+  const double wrapped_height = paragraph->GetHeight();
+  EXPECT_GT(wrapped_height, height);
+
+  for (int i = 0; i < 3; i++) {
+    paragraph->Layout(10000);
+    EXPECT_EQ(paragraph->GetHeight(), height);
+    paragraph->Layout(1);
+    EXPECT_EQ(paragraph->GetHeight(), wrapped_height);
+  }
+  EXPECT_EQ(cache->GetStatistics().miss_count, 2u);
+
+  // Laid out again with the new fonts.
+  f_collection->ClearFontFamilyCache();
+  paragraph->Layout(10000);
+  EXPECT_EQ(paragraph->GetHeight(), height);
+  EXPECT_EQ(cache->GetStatistics().miss_count, 3u);
+}
+
+TEST_F(PainterTest, ClearsLayoutsWhenFontsChange) {
+  auto f_collection = makeFontCollection();
+  const auto& cache = f_collection->GetParagraphLayoutCache();
+  makeParagraph(f_collection, u"Hello World!")->Layout(10000);
+  ASSERT_EQ(cache->GetStatistics().entry_count, 1u);
+
+  f_collection->ClearFontFamilyCache();
+  EXPECT_EQ(cache->GetStatistics().entry_count, 0u);
+}
+
+TEST_F(PainterTest, LaysOutBatchesOfParagraphsConcurrently) {
+  auto f_collection = makeFontCollection();
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+
+  std::vector<std::unique_ptr<txt::Paragraph>> paragraphs;
+  std::vector<txt::Paragraph*> batch;
+  std::vector<double> widths;
+  for (size_t i = 0; i < 32; i++) {
+    paragraphs.push_back(makeParagraph(
+        f_collection, i % 2 ? u"Hello World!" : u"Goodbye World!"));
+    batch.push_back(paragraphs.back().get());
+    widths.push_back(i % 3 ? 10000 : 1);
+  }
+  txt::LayoutParagraphs(batch, widths, *f_collection, loop->GetTaskRunner(),
+                        4);
+
+  for (size_t i = 0; i < paragraphs.size(); i++) {
+    auto expected = makeParagraph(
+        f_collection, i % 2 ? u"Hello World!" : u"Goodbye World!");
+    expected->Layout(widths[i]);
+    EXPECT_EQ(paragraphs[i]->GetHeight(), expected->GetHeight()) << i;
+    EXPECT_EQ(paragraphs[i]->GetLongestLine(), expected->GetLongestLine())
+        << i;
+  }
+
+  // Laid out again on this thread after a concurrent layout.
+  const double height = paragraphs[1]->GetHeight();
+  paragraphs[1]->Layout(1);
+  EXPECT_GT(paragraphs[1]->GetHeight(), height);
+}
+
 }  // namespace testing
 }  // namespace flutter